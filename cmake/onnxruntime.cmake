@@ -43,6 +43,7 @@ target_link_libraries(onnxruntime PRIVATE
     ${onnxruntime_libs}
     ${PROVIDERS_CUDA}
     ${PROVIDERS_MKLDNN}
+    ${PROVIDERS_OPENCL}
     onnxruntime_providers    
     onnxruntime_util
     onnxruntime_framework
@@ -26,6 +26,10 @@ if(onnxruntime_USE_CUDA)
   set(PROVIDERS_CUDA onnxruntime_providers_cuda)
   list(APPEND ONNXRUNTIME_PROVIDER_NAMES cuda)
 endif()
+if(onnxruntime_USE_OPENCL)
+  set(PROVIDERS_OPENCL onnxruntime_providers_opencl)
+  list(APPEND ONNXRUNTIME_PROVIDER_NAMES opencl)
+endif()
 
 source_group(TREE ${ONNXRUNTIME_ROOT}/core FILES ${onnxruntime_providers_common_srcs} ${onnxruntime_providers_srcs})
 # add using ONNXRUNTIME_ROOT so they show up under the 'contrib_ops' folder in Visual Studio
@@ -99,6 +103,22 @@ if (onnxruntime_USE_MKLDNN)
   set_target_properties(onnxruntime_providers_mkldnn PROPERTIES LINKER_LANGUAGE CXX)
 endif()
 
+if (onnxruntime_USE_OPENCL)
+  file(GLOB_RECURSE onnxruntime_providers_opencl_cc_srcs
+    "${ONNXRUNTIME_ROOT}/core/providers/opencl/*.h"
+    "${ONNXRUNTIME_ROOT}/core/providers/opencl/*.cc"
+  )
+
+  source_group(TREE ${ONNXRUNTIME_ROOT}/core FILES ${onnxruntime_providers_opencl_cc_srcs})
+  add_library(onnxruntime_providers_opencl ${onnxruntime_providers_opencl_cc_srcs})
+  onnxruntime_add_include_to_target(onnxruntime_providers_opencl onnx protobuf::libprotobuf)
+  add_dependencies(onnxruntime_providers_opencl eigen ${onnxruntime_EXTERNAL_DEPENDENCIES})
+  set_target_properties(onnxruntime_providers_opencl PROPERTIES FOLDER "ONNXRuntime")
+  target_include_directories(onnxruntime_providers_opencl PRIVATE ${ONNXRUNTIME_ROOT} ${eigen_INCLUDE_DIRS} ${OpenCL_INCLUDE_DIRS})
+  install(DIRECTORY ${PROJECT_SOURCE_DIR}/../include/onnxruntime/core/providers/opencl  DESTINATION ${CMAKE_INSTALL_INCLUDEDIR}/onnxruntime/core/providers)
+  set_target_properties(onnxruntime_providers_opencl PROPERTIES LINKER_LANGUAGE CXX)
+endif()
+
 if (onnxruntime_ENABLE_MICROSOFT_INTERNAL)
   include(onnxruntime_providers_internal.cmake)
 endif()
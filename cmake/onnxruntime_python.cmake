@@ -55,6 +55,7 @@ set(onnxruntime_pybind11_state_libs
     ${onnxruntime_libs}
     ${PROVIDERS_CUDA}
     ${PROVIDERS_MKLDNN}
+    ${PROVIDERS_OPENCL}
     onnxruntime_providers
     onnxruntime_framework
     onnxruntime_util
@@ -199,6 +199,7 @@ endif()
 list(APPEND onnxruntime_test_providers_libs
   ${PROVIDERS_CUDA}
   ${PROVIDERS_MKLDNN}
+  ${PROVIDERS_OPENCL}
   onnxruntime_providers
   onnxruntime_framework
   onnxruntime_util
@@ -514,6 +515,19 @@ if(HAS_FILESYSTEM_H OR HAS_EXPERIMENTAL_FILESYSTEM_H)
   set_target_properties(onnxruntime_perf_test PROPERTIES FOLDER "ONNXRuntimeTest")
 endif()
 
+# per-operator benchmark harness
+set(onnxruntime_opbench_src_dir ${TEST_SRC_DIR}/opbench)
+file(GLOB onnxruntime_opbench_src
+  "${onnxruntime_opbench_src_dir}/*.cc"
+  "${onnxruntime_opbench_src_dir}/*.h"
+  )
+
+add_executable(onnxruntime_op_benchmark ${onnxruntime_opbench_src})
+target_include_directories(onnxruntime_op_benchmark PRIVATE ${ONNXRUNTIME_ROOT} ${onnxruntime_graph_header})
+add_dependencies(onnxruntime_op_benchmark ${onnxruntime_EXTERNAL_DEPENDENCIES})
+target_link_libraries(onnxruntime_op_benchmark PRIVATE ${onnx_test_libs})
+set_target_properties(onnxruntime_op_benchmark PROPERTIES FOLDER "ONNXRuntimeTest")
+
 # shared lib
 if (onnxruntime_BUILD_SHARED_LIB)
   if (UNIX)
@@ -569,3 +583,8 @@ add_executable(onnxruntime_mlas_test ${TEST_SRC_DIR}/mlas/unittest.cpp)
 target_include_directories(onnxruntime_mlas_test PRIVATE ${ONNXRUNTIME_ROOT}/core/mlas/inc)
 target_link_libraries(onnxruntime_mlas_test PRIVATE onnxruntime_mlas)
 set_target_properties(onnxruntime_mlas_test PROPERTIES FOLDER "ONNXRuntimeTest")
+
+add_executable(onnxruntime_mlas_benchmark ${TEST_SRC_DIR}/mlas/benchmark.cpp)
+target_include_directories(onnxruntime_mlas_benchmark PRIVATE ${ONNXRUNTIME_ROOT}/core/mlas/inc)
+target_link_libraries(onnxruntime_mlas_benchmark PRIVATE onnxruntime_mlas ${CMAKE_THREAD_LIBS_INIT})
+set_target_properties(onnxruntime_mlas_benchmark PROPERTIES FOLDER "ONNXRuntimeTest")
@@ -46,21 +46,27 @@
 // Logging with explicit category
 
 // iostream style logging. Capture log info in Message, and push to the logger in ~Message.
+// The constexpr SeverityIsCompiled check folds to a constant, so call sites below the
+// compiled-in threshold disappear entirely from the binary.
 #define LOGS_CATEGORY(logger, severity, category)                       \
-  if ((logger).OutputIsEnabled(::onnxruntime::logging::Severity::k##severity, ::onnxruntime::logging::DataType::SYSTEM)) \
+  if (::onnxruntime::logging::SeverityIsCompiled(::onnxruntime::logging::Severity::k##severity) && \
+      (logger).OutputIsEnabled(::onnxruntime::logging::Severity::k##severity, ::onnxruntime::logging::DataType::SYSTEM)) \
     CREATE_MESSAGE(logger, severity, category, ::onnxruntime::logging::DataType::SYSTEM).Stream()
 
 #define LOGS_USER_CATEGORY(logger, severity, category)                  \
-    if ((logger).OutputIsEnabled(::onnxruntime::logging::Severity::k##severity, ::onnxruntime::logging::DataType::USER)) \
+    if (::onnxruntime::logging::SeverityIsCompiled(::onnxruntime::logging::Severity::k##severity) && \
+        (logger).OutputIsEnabled(::onnxruntime::logging::Severity::k##severity, ::onnxruntime::logging::DataType::USER)) \
       CREATE_MESSAGE(logger, severity, category, ::onnxruntime::logging::DataType::USER).Stream()
 
     // printf style logging. Capture log info in Message, and push to the logger in ~Message.
 #define LOGF_CATEGORY(logger, severity, category, format_str, ...)      \
-    if ((logger).OutputIsEnabled(::onnxruntime::logging::Severity::k##severity, ::onnxruntime::logging::DataType::SYSTEM)) \
+    if (::onnxruntime::logging::SeverityIsCompiled(::onnxruntime::logging::Severity::k##severity) && \
+        (logger).OutputIsEnabled(::onnxruntime::logging::Severity::k##severity, ::onnxruntime::logging::DataType::SYSTEM)) \
       CREATE_MESSAGE(logger, severity, category, ::onnxruntime::logging::DataType::SYSTEM).CapturePrintf(format_str, ##__VA_ARGS__)
 
 #define LOGF_USER_CATEGORY(logger, severity, category, format_str, ...) \
-    if ((logger).OutputIsEnabled(::onnxruntime::logging::Severity::k##severity, ::onnxruntime::logging::DataType::USER)) \
+    if (::onnxruntime::logging::SeverityIsCompiled(::onnxruntime::logging::Severity::k##severity) && \
+        (logger).OutputIsEnabled(::onnxruntime::logging::Severity::k##severity, ::onnxruntime::logging::DataType::USER)) \
       CREATE_MESSAGE(logger, severity, category, ::onnxruntime::logging::DataType::USER).CapturePrintf(format_str, ##__VA_ARGS__)
 
     // Logging with category of "onnxruntime"
@@ -18,5 +18,23 @@ enum class Severity {
 
 constexpr const char* SEVERITY_PREFIX = "VIWEF";
 
+// Lowest severity compiled into the binary. Call sites below the threshold
+// constant-fold away entirely, so e.g. the per-node VERBOSE logging in the
+// executor inner loop costs nothing in release builds, not even the
+// OutputIsEnabled check. Matches the existing vlog_enabled convention of
+// dropping VERBOSE output from NDEBUG builds; define the macro on the
+// compiler command line (0 = kVERBOSE ... 4 = kFATAL) to override.
+#ifndef ONNXRUNTIME_MIN_COMPILED_LOG_SEVERITY
+#ifdef NDEBUG
+#define ONNXRUNTIME_MIN_COMPILED_LOG_SEVERITY 1  // Severity::kINFO
+#else
+#define ONNXRUNTIME_MIN_COMPILED_LOG_SEVERITY 0  // Severity::kVERBOSE
+#endif
+#endif
+
+constexpr bool SeverityIsCompiled(Severity severity) {
+  return static_cast<int>(severity) >= ONNXRUNTIME_MIN_COMPILED_LOG_SEVERITY;
+}
+
 }  // namespace logging
 }  // namespace onnxruntime
@@ -122,6 +122,15 @@ class DataTypeImpl {
 
   static const std::vector<MLDataType>& AllTensorTypes();
   static const std::vector<MLDataType>& AllFixedSizeTensorTypes();
+
+  // Compile-time counterpart of the hand-enumerated constraint vectors:
+  // stamps out one static vector per element-type list, built on first use.
+  //   .TypeConstraint("T", DataTypeImpl::TensorTypesFor<float, double>())
+  template <typename... ElemTypes>
+  static const std::vector<MLDataType>& TensorTypesFor() {
+    static const std::vector<MLDataType> types{GetTensorType<ElemTypes>()...};
+    return types;
+  }
 };
 
 std::ostream& operator<<(std::ostream& out, MLDataType data_type);
@@ -4,11 +4,17 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <string>
+#include <vector>
 #include "core/common/common.h"
 #include "core/common/status.h"
 
 namespace onnxruntime {
+class WorkStealingThreadPool;
+
 /**
    Provides the runtime environment for onnxruntime.
    Create one instance for the duration of execution.
@@ -30,6 +36,42 @@ class Environment {
   */
   static bool IsInitialized() { return is_initialized_; }
 
+  /**
+     Returns the shared thread pool of a session group, creating it on first
+     use. Sessions created with the same SessionOptions.session_group run on
+     this one pool, where per-session priorities decide whose queued tasks
+     workers pick up first. The first call for a group fixes its pool size
+     and worker affinity; later callers get the existing pool unchanged.
+     Group pools live until process exit.
+  */
+  static WorkStealingThreadPool& GetSessionGroupThreadPool(const std::string& group_name,
+                                                           std::size_t pool_size,
+                                                           const std::vector<uint64_t>& affinity_masks);
+
+  /**
+     Registers a handler run by NotifyMemoryPressure. BFC arenas register
+     themselves on construction so one notification reaches every arena in
+     the process; other process-wide caches may add their own handlers.
+     Returns a token to pass to UnregisterMemoryPressureHandler.
+  */
+  static uint64_t RegisterMemoryPressureHandler(std::function<void()> handler);
+
+  /**
+     Removes a handler. Blocks until a NotifyMemoryPressure call that is
+     already running the handler has finished, so the handler's captures may
+     be destroyed as soon as this returns.
+  */
+  static void UnregisterMemoryPressureHandler(uint64_t token);
+
+  /**
+     Runs every registered handler on the calling thread. A host agent should
+     call this when the machine nears its memory budget so arenas can release
+     free regions before the OOM killer picks a victim. Handlers are
+     serialized with registration, so a handler must not register or
+     unregister handlers itself.
+  */
+  static void NotifyMemoryPressure();
+
  private:
   ONNXRUNTIME_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(Environment);
 
@@ -48,6 +48,15 @@ class KernelDef {
     return type_constraints_;
   }
 
+  // Dense view of TypeConstraints() for constraints made up entirely of plain
+  // tensor types: bit i is set when tensor element type i (the
+  // TensorProto_DataType value) is allowed. Constraints holding any
+  // non-tensor type have no entry here and take the MLDataType comparison
+  // path in KernelRegistry::VerifyKernelDef.
+  const std::unordered_map<std::string, uint64_t>& TypeConstraintTensorMasks() const {
+    return tensor_type_masks_;
+  }
+
   const std::vector<std::pair<int, int>>& MayInplace() const {
     return inplace_map_;
   }
@@ -73,6 +82,10 @@ class KernelDef {
     return exec_queue_id_;
   }
 
+  bool FullyOverwritesOutputs() const {
+    return fully_overwrites_outputs_;
+  }
+
   bool IsConflict(const KernelDef& other) const;
 
  private:
@@ -99,6 +112,10 @@ class KernelDef {
   // Key is input/output name defined in op schema, Value are supported types.
   std::unordered_map<std::string, std::vector<MLDataType>> type_constraints_;
 
+  // Element-type bitmasks mirroring type_constraints_; see
+  // TypeConstraintTensorMasks.
+  std::unordered_map<std::string, uint64_t> tensor_type_masks_;
+
   // An element <i, j> means that output j reuses the memory of input i.
   std::vector<std::pair<int, int>> inplace_map_;
 
@@ -111,6 +128,9 @@ class KernelDef {
 
   // execution command queue id, 0 for default queue in execution provider
   int exec_queue_id_ = 0;
+
+  // Whether Compute() writes every element of every output it produces.
+  bool fully_overwrites_outputs_ = false;
 };
 
 class KernelDefBuilder {
@@ -176,6 +196,19 @@ class KernelDefBuilder {
   KernelDefBuilder& MayInplace(const std::vector<std::pair<int, int>>& inplaces);
   KernelDefBuilder& MayInplace(int input_index, int output_index);
 
+  /**
+     Declare that this kernel writes every element of every output it
+     produces, so it is correct for the execution frame to hand it
+     uninitialized output memory. The CPU allocation paths already return
+     uninitialized buffers; allocators that zero-initialize (e.g. for page
+     placement or debugging) may consult this flag to skip the redundant
+     fill.
+  */
+  KernelDefBuilder& FullyOverwritesOutputs() {
+    kernel_def_->fully_overwrites_outputs_ = true;
+    return *this;
+  }
+
   /**
      Alias mapping from inputs to outputs. Different from Inplace that the
      content of the tensor is not changed. This is to take care of operators
@@ -194,6 +227,18 @@ class KernelDefBuilder {
     return *this;
   }
 
+  /**
+     Specify that this kernel requires a contiguous range of input args
+     [input_start_index, input_end_index] in certain memory type
+     (instead of the default, device memory). Useful for variadic kernels.
+  */
+  template <ONNXRuntimeMemType T>
+  KernelDefBuilder& InputMemoryType(int input_start_index, int input_end_index) {
+    for (int i = input_start_index; i <= input_end_index; ++i)
+      kernel_def_->input_memory_type_args_.insert(std::make_pair(i, T));
+    return *this;
+  }
+
   /**
      Specify that this kernel provides an output arg
      in certain memory type (instead of the default, device memory).
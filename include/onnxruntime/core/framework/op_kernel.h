@@ -121,6 +121,49 @@ class OpKernelContext {
    */
   Status GetTempSpaceAllocator(AllocatorPtr* output) const;
 
+  /**
+  Borrow CPU scratch memory that stays valid for the duration of this
+  Compute() call, served from the frame's bump/rewind arena. Returns nullptr
+  when no arena is active for the run (e.g. parallel execution); callers then
+  allocate from GetTempSpaceAllocator as usual.
+  */
+  void* GetScratchBuffer(size_t size) const;
+
+  /**
+  Run fn over subranges of [first, last) on the shared worker pool and wait
+  for them all. cost_per_unit is the approximate cost of one iteration in
+  nanoseconds; it sizes the subranges so each covers enough work to amortize
+  dispatch, and ranges too small to shard run inline on the calling thread.
+  fn may run concurrently on several threads, so it must only touch data it
+  can safely share. Exceptions from any subrange are rethrown here.
+  */
+  void ParallelFor(int64_t first, int64_t last, double cost_per_unit,
+                   const std::function<void(int64_t, int64_t)>& fn) const;
+
+  /**
+  Return the shape state this node recorded during a previous run with the
+  same session input shapes, or nullptr when there is none or this node's
+  current input shapes differ from the ones the state was derived from.
+  Kernels whose output shape is a pure function of their input shapes can
+  use this to skip per-run shape arithmetic (broadcast classification,
+  convolution geometry, validated GEMM dimensions, ...).
+  */
+  std::shared_ptr<void> TryGetShapeState() const;
+
+  /**
+  Returns true when this run is recording shape bindings, i.e. SetShapeState
+  would store the state. Lets kernels skip building the state object on runs
+  that would drop it.
+  */
+  bool IsRecordingShapeState() const;
+
+  /**
+  Record shape state derived from this node's current input shapes, to be
+  returned by TryGetShapeState on later runs with the same session input
+  shapes. A no-op unless this run is recording shape bindings.
+  */
+  void SetShapeState(std::shared_ptr<void> state);
+
   /**
   Return the fence of current node's input.
   @param index The index of the input.
@@ -149,9 +192,39 @@ class OpKernelContext {
   onnxruntime::NodeIndex GetNodeIndex() const;
   const SessionState& GetSessionState() const;
 
-  const MLValue* GetInputMLValue(int index) const;
-  const MLValue* GetImplicitInputMLValue(int index) const;
-  MLValue* GetOutputMLValue(int index);
+  // These read through the bindings finalized at construction, so each
+  // access is two array indexations with no call into the frame.
+  const MLValue* GetInputMLValue(int index) const {
+    if (index < 0 || index >= InputCount())
+      return nullptr;
+
+    const int mlvalue_idx = node_arg_value_indices_[index];
+    return mlvalue_idx >= 0 ? &all_values_[mlvalue_idx] : nullptr;
+  }
+
+  const MLValue* GetImplicitInputMLValue(int index) const {
+    if (index < 0 || index >= ImplicitInputCount())
+      return nullptr;
+
+    const int mlvalue_idx =
+        node_arg_value_indices_[node_implicit_input_start_index_ - node_input_start_index_ + index];
+    return mlvalue_idx >= 0 ? &all_values_[mlvalue_idx] : nullptr;
+  }
+
+  MLValue* GetOutputMLValue(int index) {
+    if (index < 0 || index >= OutputCount())
+      return nullptr;
+
+    const int mlvalue_idx =
+        node_arg_value_indices_[node_output_start_index_ - node_input_start_index_ + index];
+    return mlvalue_idx >= 0 ? &all_values_[mlvalue_idx] : nullptr;
+  }
+
+  // Points this context at the given frame and logger without redoing the
+  // per-node index arithmetic, so a preconstructed context can serve many
+  // runs. Only valid for a frame built from the same session state the
+  // context was constructed against, as the argument layout must match.
+  void RebindExecutionFrame(ExecutionFrame* frame, const logging::Logger& logger);
 
  private:
   Status GetOrCreateOutputMLValue(int index, MLValue*& value);
@@ -168,6 +241,12 @@ class OpKernelContext {
   int node_input_start_index_{-1};
   int node_implicit_input_start_index_{-1};
   int node_output_start_index_{-1};
+
+  // Bindings finalized at construction: this node's slice of the frame's
+  // node-arg slot table and the frame's value table. Both tables keep a
+  // stable size for the lifetime of a run.
+  const int* node_arg_value_indices_{nullptr};
+  MLValue* all_values_{nullptr};
 };
 
 // Fetching output tensor without shape is not allowed except when it already exists
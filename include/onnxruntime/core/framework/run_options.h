@@ -4,11 +4,17 @@
 
 #pragma once
 
+#include <functional>
 #include <string>
+#include <unordered_map>
 #include <atomic>
 #include "core/session/onnxruntime_c_api.h"
 #include "core/framework/onnx_object_cxx.h"
 
+namespace onnxruntime {
+class MLValue;
+}
+
 /**
  * Configuration information for a single Run.
  */
@@ -19,6 +25,51 @@ struct ONNXRuntimeRunOptions : public onnxruntime::ObjectBase<ONNXRuntimeRunOpti
   /// set to 'true' to terminate any currently executing Run() calls that are using this
   /// ONNXRuntimeRunOptions instance. the individual calls will exit gracefully and return an error status.
   bool terminate = false;
+
+  /// Maximum wall clock time a Run() call may spend before it is abandoned, in
+  /// milliseconds; 0 means no limit. The deadline is checked cooperatively at
+  /// the same points as the terminate flag (between nodes, at control flow
+  /// iteration boundaries and inside threaded math kernels), so an expired
+  /// run exits gracefully with an error status instead of completing doomed
+  /// work. The deadline starts when Run() is called.
+  int64_t run_timeout_in_milliseconds = 0;
+
+  /// Caps how many threads of the shared intra-op thread pool this Run() call
+  /// may occupy; 0 means no cap. Parallel sections of a capped run execute on
+  /// at most this many pool lanes (counting the thread driving the run), and
+  /// the cap follows tasks the run schedules onto the pool, so a large
+  /// background run can be held to a few workers while latency-critical runs
+  /// sharing the process keep the rest — without duplicating the session (and
+  /// its weights) per tier. The cap bounds resources, not correctness: the
+  /// same work runs on fewer threads.
+  int max_intra_op_parallelism = 0;
+
+  /// If set, each requested output is handed to this callback as soon as its
+  /// producing node finishes, while the rest of the graph is still executing,
+  /// so a downstream pipeline stage can start on an early output without
+  /// waiting for Run() to return. Values are delivered as produced, before any
+  /// cross-device copy, and the callback may be invoked concurrently from
+  /// worker threads (one call per output). Only honored when the session runs
+  /// with the parallel executor (enable_sequential_execution and
+  /// enable_hybrid_execution both false); the other executors deliver all
+  /// outputs together through the regular fetches when Run() returns.
+  std::function<void(const std::string& output_name, const onnxruntime::MLValue& value)> output_ready_callback;
+
+  /// Placement of a named output when Run() returns.
+  enum FetchLocation {
+    kFetchLocationHost = 0,    ///< copy the output to CPU memory before Run() returns (the default)
+    kFetchLocationDevice = 1,  ///< return the output where the producing provider left it, skipping the copy
+  };
+
+  /// Per-output fetch placement, keyed by output name. Outputs without an
+  /// entry behave as kFetchLocationHost, preserving the existing behavior of
+  /// copying device-resident results back to CPU. kFetchLocationDevice hands
+  /// back the MLValue on whichever device produced it, so chaining the output
+  /// into another session on the same device (or fetching a large output that
+  /// is only occasionally inspected) does not pay the device-to-host transfer
+  /// each request; bring such a fetch to the host on first access with
+  /// InferenceSession::CopyFetchToHost.
+  std::unordered_map<std::string, FetchLocation> fetch_locations;
   ONNXRuntimeRunOptions() = default;
   ~ONNXRuntimeRunOptions() = default;
 
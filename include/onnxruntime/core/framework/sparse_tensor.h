@@ -0,0 +1,77 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/data_types.h"
+
+namespace onnxruntime {
+
+/**
+ * @brief Compressed sparse row (CSR) matrix of floats that flows between
+ *        kernels as a first-class value.
+ *
+ * @details Stores only the non-zero entries of a [rows, cols] matrix:
+ *          values        - the non-zero entries, row by row
+ *          inner indices - the column of each entry in values
+ *          outer indices - rows + 1 offsets; row r owns the entries in
+ *                          [outer[r], outer[r + 1])
+ *          The type is registered as the opaque ONNX type
+ *          opaque(com.microsoft,SparseTensorCSR), so graph edges can carry it
+ *          between a sparse producer (e.g. SparseDictVectorizer) and a sparse
+ *          consumer (e.g. SparseMatMul) without ever materializing the zeros.
+ */
+class SparseTensorCSR final {
+ public:
+  SparseTensorCSR() = default;
+  ~SparseTensorCSR() = default;
+
+  SparseTensorCSR(const SparseTensorCSR&) = default;
+  SparseTensorCSR& operator=(const SparseTensorCSR&) = default;
+  SparseTensorCSR(SparseTensorCSR&&) = default;
+  SparseTensorCSR& operator=(SparseTensorCSR&&) = default;
+
+  int64_t Rows() const { return rows_; }
+  int64_t Cols() const { return cols_; }
+  int64_t NumValues() const { return static_cast<int64_t>(values_.size()); }
+
+  const std::vector<float>& Values() const { return values_; }
+  const std::vector<int64_t>& InnerIndices() const { return inner_indices_; }
+  const std::vector<int64_t>& OuterIndices() const { return outer_indices_; }
+
+  // Clears the matrix and prepares it for row-by-row appends. After Reset,
+  // append the entries of each row in increasing column order with
+  // AppendEntry and close every row (including empty ones) with EndRow.
+  void Reset(int64_t rows, int64_t cols) {
+    rows_ = rows;
+    cols_ = cols;
+    values_.clear();
+    inner_indices_.clear();
+    outer_indices_.assign(1, 0);
+  }
+
+  void AppendEntry(int64_t col, float value) {
+    inner_indices_.push_back(col);
+    values_.push_back(value);
+  }
+
+  void EndRow() {
+    outer_indices_.push_back(static_cast<int64_t>(values_.size()));
+  }
+
+ private:
+  int64_t rows_ = 0;
+  int64_t cols_ = 0;
+  std::vector<float> values_;
+  std::vector<int64_t> inner_indices_;
+  std::vector<int64_t> outer_indices_{0};
+};
+
+template <>
+MLDataType DataTypeImpl::GetType<SparseTensorCSR>();
+
+}  // namespace onnxruntime
@@ -0,0 +1,77 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+
+/*
+  Contiguous storage for the elements of a string tensor: one character pool
+  plus an offset table, so a tensor with a million elements costs two heap
+  allocations instead of one per element. Arena-aware kernels read characters
+  straight out of the pool; everything else keeps using the std::string
+  elements materialized from it (see MaterializeTo).
+*/
+class StringTensorArena {
+ public:
+  StringTensorArena() = default;
+
+  /**
+     Pre-size the pool. The counts do not have to be exact, but passing the
+     final sizes makes arena construction a single pair of allocations.
+  */
+  void Reserve(size_t element_count, size_t total_chars) {
+    offsets_.reserve(element_count + 1);
+    chars_.reserve(total_chars);
+  }
+
+  void Add(const char* data, size_t length) {
+    if (offsets_.empty())
+      offsets_.push_back(0);
+    chars_.append(data, length);
+    offsets_.push_back(chars_.size());
+  }
+
+  void Add(const std::string& str) {
+    Add(str.data(), str.size());
+  }
+
+  size_t Count() const {
+    return offsets_.empty() ? 0 : offsets_.size() - 1;
+  }
+
+  const char* Data(size_t index) const {
+    return chars_.data() + offsets_[index];
+  }
+
+  size_t Length(size_t index) const {
+    return offsets_[index + 1] - offsets_[index];
+  }
+
+  const std::string& CharacterPool() const { return chars_; }
+  const std::vector<size_t>& Offsets() const { return offsets_; }
+
+  /**
+     Compatibility view: fill a pre-constructed std::string element array for
+     kernels that have not been taught to read the arena. Elements short
+     enough for the small-string optimization stay allocation-free, and the
+     source characters are read from one contiguous block.
+  */
+  void MaterializeTo(std::string* dst) const {
+    for (size_t i = 0, n = Count(); i < n; ++i)
+      dst[i].assign(Data(i), Length(i));
+  }
+
+ private:
+  ONNXRUNTIME_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(StringTensorArena);
+
+  std::string chars_;
+  std::vector<size_t> offsets_;
+};
+
+}  // namespace onnxruntime
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <iostream>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -16,6 +17,8 @@
 
 namespace onnxruntime {
 
+class StringTensorArena;
+
 // TODO: Do we need this class or is IAllocator::MakeUniquePtr sufficient/better
 class BufferDeleter {
  public:
@@ -59,9 +62,11 @@ class Tensor final {
  public:
   /**
      Create tensor with given type, shape, pre-allocate memory and allocator info.
+     The shape is taken by value so callers passing an rvalue transfer its
+     dims buffer into the tensor instead of copying it.
   */
   Tensor(MLDataType p_type,
-         const TensorShape& shape,
+         TensorShape shape,
          BufferNakedPtr p_data,
          const ONNXRuntimeAllocatorInfo& alloc,
          AllocatorPtr deleter = nullptr,
@@ -139,20 +144,20 @@ class Tensor final {
 
   void* MutableDataRaw(MLDataType type) {
     ONNXRUNTIME_ENFORCE(type == dtype_, "Tensor type mismatch.", type, "!=", dtype_);
-    return p_data_;
+    return static_cast<char*>(p_data_) + byte_offset_;
   }
 
   const void* DataRaw(MLDataType type) const {
     ONNXRUNTIME_ENFORCE(type == dtype_, "Tensor type mismatch.", type, "!=", dtype_);
-    return p_data_;
+    return static_cast<char*>(p_data_) + byte_offset_;
   }
 
   void* MutableDataRaw() noexcept {
-    return p_data_;
+    return static_cast<char*>(p_data_) + byte_offset_;
   }
 
   const void* DataRaw() const noexcept {
-    return p_data_;
+    return static_cast<char*>(p_data_) + byte_offset_;
   }
 
   /**
@@ -171,10 +176,40 @@ class Tensor final {
     return shape_.Size() * dtype_->Size();
   }
 
+  /**
+     Byte offset from the start of the underlying buffer to the first
+     element. Non-zero for a tensor viewing part of another tensor's buffer.
+  */
+  int64_t ByteOffset() const noexcept {
+    return byte_offset_;
+  }
+
+  /**
+   * Re-points a tensor that shares another tensor's buffer at a different
+   * range of that buffer, making it a view of that range. The caller
+   * guarantees [byte_offset, byte_offset + Size()) stays inside the buffer.
+   * @warning this function is NOT thread-safe.
+   */
+  inline void SetByteOffset(int64_t byte_offset) {
+    byte_offset_ = byte_offset;
+  }
+
+  /**
+     For string tensors backed by a contiguous character pool, returns the
+     arena holding the pooled characters; nullptr otherwise. The std::string
+     elements remain valid either way, so kernels may use whichever view
+     they prefer.
+  */
+  const StringTensorArena* StringArena() const { return string_arena_.get(); }
+
+  void SetStringArena(std::shared_ptr<StringTensorArena> arena) {
+    string_arena_ = std::move(arena);
+  }
+
   // More API methods.
  private:
   void Init(MLDataType p_type,
-            const TensorShape& shape,
+            TensorShape shape,
             void* p_raw_data,
             const ONNXRuntimeAllocatorInfo& alloc,
             AllocatorPtr deleter,
@@ -194,6 +229,9 @@ class Tensor final {
   MLDataType dtype_;
   ONNXRuntimeAllocatorInfo alloc_info_;
   int64_t byte_offset_;
+
+  // set only for string tensors whose characters live in a contiguous pool
+  std::shared_ptr<StringTensorArena> string_arena_;
 };
 #ifdef __GNUC__
 #pragma GCC diagnostic pop
@@ -32,9 +32,21 @@ class TensorShape : private std::vector<int64_t> {
 
   TensorShape(const std::vector<int64_t>& dims);
 
+  /**
+     Adopt the vector's buffer instead of copying it.
+  */
+  TensorShape(std::vector<int64_t>&& dims);
+
   TensorShape(const std::initializer_list<int64_t>& dims);
 
   TensorShape(const TensorShape& /*other*/) = default;
+  TensorShape& operator=(const TensorShape& /*other*/) = default;
+
+  // the user-declared copy constructor suppresses the implicit move
+  // operations; without these every pass-by-value or return of a shape
+  // silently copies the dims onto the heap.
+  TensorShape(TensorShape&& /*other*/) = default;
+  TensorShape& operator=(TensorShape&& /*other*/) = default;
 
   TensorShape(const std::vector<int64_t>& dims, size_t start, size_t end);
 
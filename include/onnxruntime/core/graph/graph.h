@@ -3,12 +3,14 @@
 
 #pragma once
 
+#include <algorithm>
 #include <limits>
 #include <memory>
 #include <string>
 #include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "core/common/common.h"
 #include "core/common/const_pointer_container.h"
@@ -175,7 +177,50 @@ class Node {
     }
   };
 
-  using EdgeSet = std::set<EdgeEnd, EdgeEndCompare>;
+  /**
+  @class EdgeSet
+  Set of EdgeEnd instances ordered by EdgeEndCompare, stored in one contiguous
+  sorted buffer. Building a large graph then costs a handful of buffer growths
+  per node instead of one heap allocation per edge, and adjacency iteration
+  during pattern matching walks sequential memory.
+  @remarks Unlike std::set, inserting or erasing invalidates iterators, so
+  callers that mutate edges while walking them must iterate over a copy.
+  The existing Graph mutation paths already do this.
+  */
+  class EdgeSet {
+   public:
+    using const_iterator = std::vector<EdgeEnd>::const_iterator;
+
+    const_iterator begin() const noexcept { return edges_.begin(); }
+    const_iterator end() const noexcept { return edges_.end(); }
+    const_iterator cbegin() const noexcept { return edges_.cbegin(); }
+    const_iterator cend() const noexcept { return edges_.cend(); }
+
+    size_t size() const noexcept { return edges_.size(); }
+    bool empty() const noexcept { return edges_.empty(); }
+    void clear() noexcept { edges_.clear(); }
+
+    /** Inserts the edge at its sorted position. No-op if an equivalent edge exists. */
+    void insert(const EdgeEnd& edge) {
+      auto it = std::lower_bound(edges_.begin(), edges_.end(), edge, EdgeEndCompare{});
+      if (it != edges_.end() && !EdgeEndCompare{}(edge, *it)) {
+        return;
+      }
+      edges_.insert(it, edge);
+    }
+
+    /** Removes the equivalent edge if present. */
+    void erase(const EdgeEnd& edge) {
+      auto it = std::lower_bound(edges_.begin(), edges_.end(), edge, EdgeEndCompare{});
+      if (it != edges_.end() && !EdgeEndCompare{}(edge, *it)) {
+        edges_.erase(it);
+      }
+    }
+
+   private:
+    std::vector<EdgeEnd> edges_;
+  };
+
   using EdgeConstIterator = EdgeSet::const_iterator;
 
   /** 
@@ -490,6 +535,15 @@ class Graph {
   @remarks Contains no nullptr values.*/
   const std::vector<const NodeArg*>& GetOutputs() const noexcept { return graph_outputs_; }
 
+  /** Replaces the graph output with the given name by one or more existing NodeArgs, keeping the
+  position of the replaced entry in the output order. Each replacement must be produced by a Node
+  in the Graph or be an initializer. Only valid for graphs loaded from a model file, where the
+  outputs are specified explicitly; the outputs of programmatically created graphs are inferred
+  when the Graph is resolved. The Graph must be resolved again for the change to take effect.
+  @returns NOT_FOUND if output_name is not a current graph output. */
+  common::Status ReplaceGraphOutput(const std::string& output_name,
+                                    const std::vector<const NodeArg*>& replacements);
+
   /** Returns true if a Node output is a Graph output. */
   bool IsNodeOutputsInGraphOutputs(const Node& node) {
     for (auto output_def : node.OutputDefs()) {
@@ -627,10 +681,22 @@ class Graph {
   */
   bool AddControlEdge(NodeIndex src_node_index, NodeIndex dst_node_index);
 
-  /** Mark the Graph as needing Resolve() to be called. 
+  /** Mark the Graph as needing Resolve() to be called.
   This should be done after modifying any aspect of the Graph that changes the Nodes or relationships between them. */
   Graph& SetGraphResolveNeeded() noexcept {
     graph_resolve_needed_ = true;
+    resolve_all_nodes_ = true;
+    return *this;
+  }
+
+  /** Mark the Graph as needing Resolve() due to a change scoped to the given Node.
+  Resolve() can then limit the per-node re-verification and type/shape inferencing to the
+  changed nodes and everything downstream of them, instead of re-processing every node. */
+  Graph& SetGraphResolveNeeded(const Node& node) {
+    graph_resolve_needed_ = true;
+    if (!resolve_all_nodes_) {
+      dirty_node_indices_.insert(node.Index());
+    }
     return *this;
   }
 
@@ -679,6 +745,24 @@ class Graph {
     return domain_to_version_;
   }
 
+  /** Record the directory the owning model was loaded from.
+  Initializers whose TensorProto places the payload in an external file reference that file
+  relative to this directory. Set by Model when loading from a file path; empty when the
+  model came from a stream or in-memory proto. */
+  void SetModelFileDirectory(const std::string& dir) {
+    model_file_dir_ = dir;
+  }
+
+  /** Gets the directory the owning model was loaded from, for resolving initializers with
+  externally stored payloads. Subgraphs defer to their parent graph, so the whole graph tree
+  resolves external data against the main model's location. */
+  const std::string& ModelFileDirectory() const noexcept {
+    if (model_file_dir_.empty() && parent_graph_ != nullptr) {
+      return parent_graph_->ModelFileDirectory();
+    }
+    return model_file_dir_;
+  }
+
   /** Gets the GraphProto representation of this Graph. */
   const ONNX_NAMESPACE::GraphProto& ToGraphProto();
 
@@ -929,6 +1013,18 @@ class Graph {
   // A flag indicates whether <*this> graph needs to be resolved.
   bool graph_resolve_needed_ = false;
 
+  // True when a change could not be attributed to specific nodes, so the next
+  // Resolve() must re-verify every node. Node-scoped changes instead record
+  // the affected node in dirty_node_indices_.
+  bool resolve_all_nodes_ = true;
+  std::unordered_set<NodeIndex> dirty_node_indices_;
+
+  // Snapshot of the above taken at the start of a Resolve(), so marks made by
+  // the resolve machinery itself (edge rebuilding etc.) don't widen the set of
+  // nodes the in-flight resolve re-verifies.
+  bool reverify_all_nodes_ = true;
+  std::unordered_set<NodeIndex> nodes_to_reverify_;
+
   bool graph_proto_sync_needed_ = false;
 
   // The topological order of node index used to do node and op match verification temporarily.
@@ -963,6 +1059,11 @@ class Graph {
   // the parent graph if this is a subgraph.
   Graph* parent_graph_;
 
+  // Directory of the model file this graph was loaded from, used to resolve
+  // initializers with externally stored payloads. Empty for subgraphs (they
+  // defer to the parent) and for models not loaded from a file.
+  std::string model_file_dir_;
+
   // NodeArgs that come from outer scope. Used when building a graph so that
   // these don't get recorded as graph inputs in the GraphProto.
   std::unordered_set<std::string> outer_scope_node_arg_names_;
@@ -161,7 +161,25 @@ class SchemaRegistryManager : public onnxruntime::IOnnxRuntimeOpSchemaCollection
       int* earliest_opset_where_unchanged) const override;
 
  private:
+  void GetSchemaAndHistoryImpl(
+      const std::string& key,
+      const int max_inclusive_version,
+      const std::string& domain,
+      const ONNX_NAMESPACE::OpSchema** latest_schema,
+      int* earliest_opset_where_unchanged) const;
+
   std::deque<std::shared_ptr<IOnnxRuntimeOpSchemaCollection>> registries;
+
+  // Lazily hydrated snapshot of resolved lookups, keyed by
+  // "<op>:<domain>:<max version>". Registered schemas are immutable, so a
+  // query keeps resolving to the same schema (or to none) until another
+  // registry is added, at which point RegisterRegistry drops the snapshot.
+  // Graph resolution repeats the same lookup for every node of a given op
+  // type, and each miss walks every registry plus ONNX's string-keyed maps,
+  // so hydrating the flat map once per (op, domain, version) removes most of
+  // the schema lookup cost of loading a large model.
+  mutable std::mutex lookup_cache_mutex_;
+  mutable std::unordered_map<std::string, std::pair<const ONNX_NAMESPACE::OpSchema*, int>> lookup_cache_;
 };
 
 }  // namespace onnxruntime
@@ -0,0 +1,21 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/onnxruntime_c_api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Execution provider offloading data-parallel preprocessing ops (ImageScaler,
+ * Upsample) to an OpenCL device, intended for integrated GPUs that share
+ * physical memory with the CPU so tensors cross over without a copy.
+ * \param use_arena zero: false. non-zero: true.
+ * \param out Call ONNXRuntimeReleaseObject() method when you no longer need to use it.
+ */
+ONNXRUNTIME_API_STATUS(ONNXRuntimeCreateOpenCLExecutionProviderFactory, int use_arena, _Out_ ONNXRuntimeProviderFactoryInterface*** out);
+
+#ifdef __cplusplus
+}
+#endif
@@ -19,6 +19,7 @@ extern "C" {
 #ifndef _WIN32
 #define _In_
 #define _In_opt_
+#define _In_reads_(X)
 #define _Out_
 #define _Out_opt_
 #define _Inout_
@@ -229,6 +230,22 @@ ONNXRUNTIME_API(const char*, ONNXRuntimeRunOptionsGetRunTag, _In_ ONNXRuntimeRun
 // will exit as soon as possible if the flag is true.
 ONNXRUNTIME_API(void, ONNXRuntimeRunOptionsSetTerminate, _In_ ONNXRuntimeRunOptions*, _In_ bool value);
 
+// set a wall clock limit, in milliseconds, on each ONNXRuntimeRunInference* call that uses this instance of
+// ONNXRuntimeRunOptions; a call that exceeds the limit exits as soon as possible with an error status.
+// a value of 0 (the default) means no limit.
+ONNXRUNTIME_API(void, ONNXRuntimeRunOptionsSetRunTimeout, _In_ ONNXRuntimeRunOptions*, _In_ int64_t timeout_in_milliseconds);
+
+// cap the number of intra-op thread pool threads each ONNXRuntimeRunInference* call that uses this
+// instance of ONNXRuntimeRunOptions may occupy, so a background run leaves workers free for
+// latency-critical runs sharing the process. a value of 0 (the default) means no cap.
+ONNXRUNTIME_API(void, ONNXRuntimeRunOptionsSetMaxParallelism, _In_ ONNXRuntimeRunOptions*, _In_ int max_parallelism);
+
+// choose where the named output is placed when the run returns: pass a non-zero
+// device_resident to keep it on the device that produced it (skipping the
+// device-to-host copy, e.g. when chaining into another session on the same
+// device), zero to restore the default behavior of copying it to CPU memory.
+ONNXRUNTIME_API_STATUS(ONNXRuntimeRunOptionsSetOutputLocation, _In_ ONNXRuntimeRunOptions*, _In_ const char* output_name, _In_ int device_resident);
+
 DEFINE_RUNTIME_CLASS(ONNXRuntimeProvider);
 
 /**
@@ -305,6 +322,31 @@ ONNXRUNTIME_API(void, ONNXRuntimeSetSessionLogVerbosityLevel, _In_ ONNXRuntimeSe
 ///How many threads in the session thread pool.
 ONNXRUNTIME_API(int, ONNXRuntimeSetSessionThreadPoolSize, _In_ ONNXRuntimeSessionOptions* options, int session_thread_pool_size);
 
+/**
+  * Pin the session's worker threads to logical processors. affinity_masks[i] is
+  * the bitmask for worker i (bit k set => logical processor k); pools with more
+  * workers than masks reuse them round-robin. Passing num_masks == 0 removes a
+  * previously set binding. Returns -1 when affinity_masks is NULL while
+  * num_masks is non-zero or when a mask is zero, 0 on success.
+  */
+ONNXRUNTIME_API(int, ONNXRuntimeSetSessionThreadAffinityMasks, _In_ ONNXRuntimeSessionOptions* options, _In_reads_(num_masks) const uint64_t* affinity_masks, size_t num_masks);
+
+/**
+  * Confine the session's worker threads to the logical processors of one NUMA
+  * node. Pass -1 to remove the binding. Ignored when affinity masks are also
+  * set via ONNXRuntimeSetSessionThreadAffinityMasks. Returns -1 when numa_node
+  * is below -1, 0 on success.
+  */
+ONNXRUNTIME_API(int, ONNXRuntimeSetSessionNumaNode, _In_ ONNXRuntimeSessionOptions* options, int numa_node);
+
+/**
+  * Replicate large read-only CPU weights onto every NUMA node and serve each
+  * run from the replica local to the thread that starts it. Costs one extra
+  * copy of the replicated weights per node; no effect on single-node hosts.
+  */
+ONNXRUNTIME_API(void, ONNXRuntimeEnableNumaWeightReplication, _In_ ONNXRuntimeSessionOptions* options);
+ONNXRUNTIME_API(void, ONNXRuntimeDisableNumaWeightReplication, _In_ ONNXRuntimeSessionOptions* options);
+
 /**
   * The order of invocation indicates the preference order as well. In other words call this method
   * on your most preferred execution provider first followed by the less preferred ones.
@@ -464,11 +506,45 @@ ONNXRUNTIME_API_STATUS(ONNXRuntimeGetStringTensorContent, _In_ const ONNXValue*
 
 DEFINE_RUNTIME_CLASS(ONNXValueList);
 
+/**
+ * \param output output[i] may be NULL on entry, in which case the runtime
+ *               allocates the value and ownership passes to the caller. A
+ *               non-NULL entry — e.g. a tensor created over a caller-owned
+ *               buffer with ONNXRuntimeCreateTensorWithDataAsONNXValue — is
+ *               written in place, so a caller that pre-binds its outputs
+ *               (see ONNXRuntimeInferenceSessionInferOutputShapes) pays no
+ *               per-call output allocation.
+ */
 ONNXRUNTIME_API_STATUS(ONNXRuntimeRunInference, _Inout_ ONNXSession* sess,
                        _In_ ONNXRuntimeRunOptions* run_options,
                        _In_ const char* const* input_names, _In_ const ONNXValue* const* input, size_t input_len,
                        _In_ const char* const* output_names, size_t output_names_len, _Out_ ONNXValue** output);
 
+/**
+ * Completion callback for ONNXRuntimeRunInferenceAsync. Invoked on a worker
+ * thread owned by the session once the run completes.
+ * \param status NULL on success, else owned by the callback and must be freed
+ *               with ReleaseONNXStatus. output entries are only valid when
+ *               status is NULL.
+ */
+typedef void(ONNXRUNTIME_API_CALL* ONNXRuntimeRunAsyncCallback)(_In_opt_ void* user_data, _Inout_ ONNXValue** output,
+                                                                size_t output_len, _In_opt_ ONNXStatus* status);
+
+/**
+ * Same inputs and outputs as ONNXRuntimeRunInference, but the request is
+ * queued on a worker pool inside the session and this call returns as soon as
+ * it is accepted, so an event-loop thread can drive many concurrent requests.
+ * The inputs are refcounted internally and may be released once this call
+ * returns; the output array must stay valid until the callback fires. As with
+ * the synchronous call, output entries that are NULL on entry are allocated by
+ * the runtime and ownership passes to the callback.
+ */
+ONNXRUNTIME_API_STATUS(ONNXRuntimeRunInferenceAsync, _Inout_ ONNXSession* sess,
+                       _In_ ONNXRuntimeRunOptions* run_options,
+                       _In_ const char* const* input_names, _In_ const ONNXValue* const* input, size_t input_len,
+                       _In_ const char* const* output_names, size_t output_names_len, _Inout_ ONNXValue** output,
+                       _In_ ONNXRuntimeRunAsyncCallback callback, _In_opt_ void* user_data);
+
 ONNXRUNTIME_API_STATUS(ONNXRuntimeInferenceSessionGetInputCount, _In_ const ONNXSession* sess, _Out_ size_t* out);
 ONNXRUNTIME_API_STATUS(ONNXRuntimeInferenceSessionGetOutputCount, _In_ const ONNXSession* sess, _Out_ size_t* out);
 
@@ -487,6 +563,127 @@ ONNXRUNTIME_API_STATUS(ONNXRuntimeInferenceSessionGetInputName, _In_ const ONNXS
 ONNXRUNTIME_API_STATUS(ONNXRuntimeInferenceSessionGetOutputName, _In_ const ONNXSession* sess, size_t index,
                        _Inout_ ONNXRuntimeAllocator* allocator, _Out_ char** value);
 
+/**
+ * Infer the shapes of the named outputs for the given input shapes without
+ * running the model. When a previous run with exactly these input shapes has
+ * populated the session's shape binding cache, the recorded output shapes are
+ * returned and every dimension is concrete; otherwise the statically inferred
+ * shapes are returned, with symbolic dimensions resolved against the given
+ * input shapes where the model names them and reported as -1 where they stay
+ * unknown. Together with ONNXRuntimeCreateTensorWithDataAsONNXValue this lets
+ * a caller size its own output buffers once and pass them to
+ * ONNXRuntimeRunInference, which writes into them directly.
+ * \param input_shapes one entry per model input; only the dimensions of each
+ *                     info object are read, the element type is ignored
+ * \param output_shapes receives one newly created info object per output
+ *                      name; each must be freed with ONNXRuntimeReleaseObject
+ */
+ONNXRUNTIME_API_STATUS(ONNXRuntimeInferenceSessionInferOutputShapes, _In_ ONNXSession* sess,
+                       _In_ const char* const* input_names,
+                       _In_ const struct ONNXRuntimeTensorTypeAndShapeInfo* const* input_shapes, size_t input_len,
+                       _In_ const char* const* output_names, size_t output_names_len,
+                       _Out_ struct ONNXRuntimeTensorTypeAndShapeInfo** output_shapes);
+
+/**
+ * Memory introspection. ONNXRuntimeInferenceSessionGetMemoryStats takes a
+ * snapshot of the session's per-allocator usage and of the allocation sizes
+ * the execution plan assigns to each node; release it with
+ * ReleaseONNXRuntimeMemoryStats. The session must be initialized; the
+ * snapshot may be taken while inference runs are in flight.
+ */
+DEFINE_RUNTIME_CLASS(ONNXRuntimeMemoryStats);
+
+typedef struct ONNXRuntimeAllocatorMemoryStats {
+  int64_t bytes_in_use;              // live allocations
+  int64_t total_allocated_bytes;     // reserved from the device allocator
+  int64_t max_bytes_in_use;          // peak of bytes_in_use
+  int64_t num_allocs;
+  int64_t is_arena;                  // nonzero when the fields below are valid
+  int64_t free_bytes;                // bytes in the arena's free chunks
+  int64_t largest_free_chunk_bytes;  // biggest allocation servable without growing
+  int64_t num_free_chunks;
+} ONNXRuntimeAllocatorMemoryStats;
+
+typedef struct ONNXRuntimeNodeMemoryStats {
+  int64_t planned_bytes;       // statically sized allocations planned for the node's outputs
+  int64_t num_planned_allocs;  // outputs given fresh buffers by the plan
+  int64_t num_reused_buffers;  // outputs reusing another value's buffer
+  int64_t num_dynamic_allocs;  // planned allocations whose size depends on runtime shapes
+} ONNXRuntimeNodeMemoryStats;
+
+ONNXRUNTIME_API_STATUS(ONNXRuntimeInferenceSessionGetMemoryStats, _In_ ONNXSession* sess,
+                       _Out_ ONNXRuntimeMemoryStats** out);
+
+ONNXRUNTIME_API(size_t, ONNXRuntimeMemoryStatsGetAllocatorCount, _In_ const ONNXRuntimeMemoryStats* stats);
+
+/**
+ * \param location optional; receives the allocator's location name, owned by
+ *                 the snapshot and valid until it is released
+ */
+ONNXRUNTIME_API_STATUS(ONNXRuntimeMemoryStatsGetAllocatorStats, _In_ const ONNXRuntimeMemoryStats* stats,
+                       size_t index, _Out_ ONNXRuntimeAllocatorMemoryStats* out,
+                       _Out_opt_ const char** location);
+
+// nodes are indexed in execution order
+ONNXRUNTIME_API(size_t, ONNXRuntimeMemoryStatsGetNodeCount, _In_ const ONNXRuntimeMemoryStats* stats);
+
+/**
+ * \param node_name,op_type optional; owned by the snapshot and valid until it
+ *                          is released
+ */
+ONNXRUNTIME_API_STATUS(ONNXRuntimeMemoryStatsGetNodeStats, _In_ const ONNXRuntimeMemoryStats* stats,
+                       size_t index, _Out_ ONNXRuntimeNodeMemoryStats* out,
+                       _Out_opt_ const char** node_name, _Out_opt_ const char** op_type);
+
+/**
+ * Run telemetry. A caller-allocated, fixed-size snapshot of the session's
+ * rolling run counters: per-phase latency percentiles over a window of
+ * recent runs, run counts and the queue depths of the async and
+ * micro-batching paths. Taking the snapshot reads atomic counters only, so
+ * it can be polled periodically (e.g. at 1Hz by a monitoring agent) with no
+ * cost on the request path and while inference runs are in flight.
+ * Phase indices: 0 = input/output validation, 1 = graph execution,
+ * 2 = fetch copy back to the caller. Counts and averages cover the session
+ * lifetime; the percentiles cover the most recent runs.
+ */
+#define ONNXRUNTIME_TELEMETRY_PHASE_COUNT 3
+
+typedef struct ONNXRuntimeSessionTelemetry {
+  uint64_t run_count;               // completed Run calls, successful or not
+  uint64_t failed_run_count;        // Run calls that returned an error
+  int64_t async_queue_depth;        // async requests accepted but not yet completed
+  int64_t micro_batch_queue_depth;  // requests waiting in the open micro batch
+  uint64_t phase_count[ONNXRUNTIME_TELEMETRY_PHASE_COUNT];
+  int64_t phase_average_microseconds[ONNXRUNTIME_TELEMETRY_PHASE_COUNT];
+  int64_t phase_p50_microseconds[ONNXRUNTIME_TELEMETRY_PHASE_COUNT];
+  int64_t phase_p90_microseconds[ONNXRUNTIME_TELEMETRY_PHASE_COUNT];
+  int64_t phase_p99_microseconds[ONNXRUNTIME_TELEMETRY_PHASE_COUNT];
+} ONNXRuntimeSessionTelemetry;
+
+ONNXRUNTIME_API_STATUS(ONNXRuntimeInferenceSessionGetTelemetry, _In_ ONNXSession* sess,
+                       _Out_ ONNXRuntimeSessionTelemetry* out);
+
+/**
+ * Produce a compact JSON summary of the profile events the session has
+ * recorded so far: per-op-type count, total, mean, approximate P99 and max
+ * kernel time, kernel time share per execution provider, and per-node
+ * invocation counts. Unlike ending the profile this leaves profiling
+ * running, so it can be polled on a live session.
+ * \param out must be freed by the given allocator
+ */
+ONNXRUNTIME_API_STATUS(ONNXRuntimeInferenceSessionGetProfileSummary, _In_ ONNXSession* sess,
+                       _Inout_ ONNXRuntimeAllocator* allocator, _Out_ char** out);
+
+/**
+ * Compare two summaries produced by ONNXRuntimeInferenceSessionGetProfileSummary
+ * and report the ops whose mean kernel time grew by more than the given
+ * fraction (0.2 flags ops that got at least 20% slower) as a JSON string.
+ * \param out must be freed by the given allocator
+ */
+ONNXRUNTIME_API_STATUS(ONNXRuntimeCompareProfileSummaries, _In_ const char* baseline_summary,
+                       _In_ const char* current_summary, double threshold,
+                       _Inout_ ONNXRuntimeAllocator* allocator, _Out_ char** out);
+
 ONNXRUNTIME_API_STATUS(ONNXRuntimeTensorProtoToONNXValue, _Inout_ ONNXRuntimeAllocator* allocator,
                        _In_ const void* input, int input_len, _Out_ ONNXValue** out);
 
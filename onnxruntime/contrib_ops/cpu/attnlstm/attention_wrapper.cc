@@ -8,6 +8,7 @@
 #include <memory>
 
 using onnxruntime::rnn::detail::Allocate;
+using onnxruntime::rnn::detail::ComputeGemm;
 
 namespace onnxruntime {
 namespace contrib {
@@ -37,11 +38,24 @@ template <typename T>
 void AttentionWrapper<T>::ProcessOutput(const gsl::span<const T>& rnn_cell_output) {
   if (has_attn_layer_) {
     // rnn_cell_output * cell_weights, (part of the attention layer above the attention mechanism).
-    math::GemmEx<T, CPUMathUtil>(CblasNoTrans, CblasNoTrans,
-                                 batch_size_, attn_layer_depth_, inner_cell_hidden_size_, T{1.0},
-                                 rnn_cell_output.data(), inner_cell_hidden_size_,
-                                 attn_layer_cell_weights_.data(), attn_layer_depth_, T{0.0},
-                                 attn_states_.data(), attn_layer_depth_, &CPUMathUtil::Instance());
+#if defined(USE_MLAS)
+    if (packed_attn_layer_cell_weights_ != nullptr) {
+      ComputeGemm(batch_size_, attn_layer_depth_, inner_cell_hidden_size_, T{1.0},
+                  rnn_cell_output.cbegin(), rnn_cell_output.cend(),
+                  inner_cell_hidden_size_,
+                  packed_attn_layer_cell_weights_,  // cell weights in MlasSgemmPackB layout
+                  T{0.0},
+                  attn_states_.begin(), attn_states_.end(),
+                  attn_layer_depth_);
+    } else
+#endif
+    {
+      math::GemmEx<T, CPUMathUtil>(CblasNoTrans, CblasNoTrans,
+                                   batch_size_, attn_layer_depth_, inner_cell_hidden_size_, T{1.0},
+                                   rnn_cell_output.data(), inner_cell_hidden_size_,
+                                   attn_layer_cell_weights_.data(), attn_layer_depth_, T{0.0},
+                                   attn_states_.data(), attn_layer_depth_, &CPUMathUtil::Instance());
+    }
   }
 
   // Get the context which is calculated within attention mechanism.
@@ -54,11 +68,24 @@ void AttentionWrapper<T>::ProcessOutput(const gsl::span<const T>& rnn_cell_outpu
     //concat([p_cell_output, context]) * stack([attn_layer_cell_weights_, attn_layer_attn_weights_]) =
     //     p_cell_output * attn_layer_cell_weights_ + context * attn_layer_attn_weights_
     // The first part is calulated above. Here just add the later.
-    math::GemmEx<T, CPUMathUtil>(CblasNoTrans, CblasNoTrans,
-                                 batch_size_, attn_layer_depth_, attn_context_depth_, T{1.0},
-                                 attn_context_.data(), attn_context_depth_,
-                                 attn_layer_attn_weights_.data(), attn_layer_depth_, T{1.0},
-                                 attn_states_.data(), attn_layer_depth_, &CPUMathUtil::Instance());
+#if defined(USE_MLAS)
+    if (packed_attn_layer_attn_weights_ != nullptr) {
+      ComputeGemm(batch_size_, attn_layer_depth_, attn_context_depth_, T{1.0},
+                  attn_context_.cbegin(), attn_context_.cend(),
+                  attn_context_depth_,
+                  packed_attn_layer_attn_weights_,  // attn weights in MlasSgemmPackB layout
+                  T{1.0},
+                  attn_states_.begin(), attn_states_.end(),
+                  attn_layer_depth_);
+    } else
+#endif
+    {
+      math::GemmEx<T, CPUMathUtil>(CblasNoTrans, CblasNoTrans,
+                                   batch_size_, attn_layer_depth_, attn_context_depth_, T{1.0},
+                                   attn_context_.data(), attn_context_depth_,
+                                   attn_layer_attn_weights_.data(), attn_layer_depth_, T{1.0},
+                                   attn_states_.data(), attn_layer_depth_, &CPUMathUtil::Instance());
+    }
   }
 }
 
@@ -68,7 +95,9 @@ gsl::span<const T> AttentionWrapper<T>::GetAttnStates() const {
 }
 
 template <typename T>
-void AttentionWrapper<T>::SetWeights(const gsl::span<const T>& wrapper_weights) {
+void AttentionWrapper<T>::SetWeights(const gsl::span<const T>& wrapper_weights,
+                                     const void* packed_cell_weights,
+                                     const void* packed_attn_weights) {
   has_attn_layer_ = !wrapper_weights.empty();
 
   if (has_attn_layer_) {
@@ -77,6 +106,8 @@ void AttentionWrapper<T>::SetWeights(const gsl::span<const T>& wrapper_weights)
     size_t aws = attn_context_depth_ * attn_layer_depth_;
     attn_layer_cell_weights_ = wrapper_weights.subspan(0, cws);
     attn_layer_attn_weights_ = wrapper_weights.subspan(cws, aws);
+    packed_attn_layer_cell_weights_ = packed_cell_weights;
+    packed_attn_layer_attn_weights_ = packed_attn_weights;
   }
 }
 
@@ -31,7 +31,9 @@ class AttentionWrapper {
 
   gsl::span<const T> GetAttnStates() const;
 
-  void SetWeights(const gsl::span<const T>& wrapper_weights);
+  void SetWeights(const gsl::span<const T>& wrapper_weights,
+                  const void* packed_cell_weights = nullptr,
+                  const void* packed_attn_weights = nullptr);
 
   // the size after attention layer or direct from attention context.
   int GetAttentionSize() const {
@@ -49,6 +51,11 @@ class AttentionWrapper {
   gsl::span<const T> attn_layer_cell_weights_;
   gsl::span<const T> attn_layer_attn_weights_;
 
+  // the two attention layer projections in MlasSgemm packed layout, when the
+  // weights were a constant initializer the kernel could pack up front.
+  const void* packed_attn_layer_cell_weights_ = nullptr;
+  const void* packed_attn_layer_attn_weights_ = nullptr;
+
   IAllocatorUniquePtr<T> attn_context_ptr_;
   gsl::span<T> attn_context_;
 
@@ -8,6 +8,7 @@
 #include <memory.h>
 
 using onnxruntime::rnn::detail::Allocate;
+using onnxruntime::rnn::detail::ComputeGemm;
 
 namespace onnxruntime {
 namespace contrib {
@@ -20,6 +21,9 @@ BahdanauAttention<T>::BahdanauAttention(AllocatorPtr allocator, const logging::L
   values_ = Allocate(allocator_, batch_size_ * max_memory_steps_ * memory_depth_, values_ptr_, true);
   keys_ = Allocate(allocator_, batch_size_ * max_memory_steps_ * attn_depth_, keys_ptr_, true);
   processed_query_ = Allocate(allocator_, batch_size_ * attn_depth_, processed_query_ptr_, true);
+  // zero filled so the rows for padded memory steps, which are never written,
+  // contribute a zero score in Compute.
+  tanh_keys_query_ = Allocate(allocator_, batch_size_ * max_memory_steps_ * attn_depth_, tanh_keys_query_ptr_, true);
   mem_seq_lengths_ = Allocate(allocator_, batch_size_, mem_seq_lengths_ptr_, true);
 
   ONNXRUNTIME_ENFORCE(!normalize_, "not support normalize yet.");
@@ -29,10 +33,12 @@ template <typename T>
 void BahdanauAttention<T>::SetWeights(
     const gsl::span<const T>& attn_weights,
     const gsl::span<const T>& query_layer_weights,
-    const gsl::span<const T>& memory_layer_weights) {
+    const gsl::span<const T>& memory_layer_weights,
+    const void* packed_query_layer_weights) {
   attention_v_ = attn_weights;                   //[attn_depth_]
   query_layer_weights_ = query_layer_weights;    //[query_depth_, attn_depth_]
   memory_layer_weights_ = memory_layer_weights;  //[memory_depth_, attn_depth_]
+  packed_query_layer_weights_ = packed_query_layer_weights;
 }
 
 template <typename T>
@@ -115,31 +121,54 @@ void BahdanauAttention<T>::Compute(
     const gsl::span<T>& output,
     const gsl::span<T>& aligns) const {
   //process query in dense query layer without bias
-  math::GemmEx<T, CPUMathUtil>(CblasNoTrans, CblasNoTrans,
-                               batch_size_, attn_depth_, query_depth_, T{1.0},
-                               queries.data(), query_depth_,
-                               query_layer_weights_.data(), attn_depth_, T{0.0},
-                               processed_query_.data(), attn_depth_, &CPUMathUtil::Instance());
-
-  std::fill(aligns.begin(), aligns.end(), T{});
+#if defined(USE_MLAS)
+  if (packed_query_layer_weights_ != nullptr) {
+    ComputeGemm(batch_size_, attn_depth_, query_depth_, T{1.0},
+                queries.cbegin(), queries.cend(),
+                query_depth_,
+                packed_query_layer_weights_,  // query layer weights in MlasSgemmPackB layout
+                T{0.0},
+                processed_query_.begin(), processed_query_.end(),
+                attn_depth_);
+  } else
+#endif
+  {
+    math::GemmEx<T, CPUMathUtil>(CblasNoTrans, CblasNoTrans,
+                                 batch_size_, attn_depth_, query_depth_, T{1.0},
+                                 queries.data(), query_depth_,
+                                 query_layer_weights_.data(), attn_depth_, T{0.0},
+                                 processed_query_.data(), attn_depth_, &CPUMathUtil::Instance());
+  }
 
-  // return math_ops.reduce_sum(v * math_ops.tanh(keys + processed_query), [2])
+  // tanh(keys + processed_query) for every valid memory position. rows for the
+  // padded steps were zero filled at allocation and are never written, so the
+  // batched score GEMM below gives them a zero score, as before.
   for (int b = 0; b < batch_size_; b++) {
-    T* alignments = aligns.data() + b * max_memory_steps_;
     const T* keys = keys_.data() + b * max_memory_steps_ * attn_depth_;
     const T* query = processed_query_.data() + b * attn_depth_;
+    T* tanh_keys_query = tanh_keys_query_.data() + b * max_memory_steps_ * attn_depth_;
 
-    int mem_steps = mem_seq_lengths_[b];
+    const int mem_steps = mem_seq_lengths_[b];
     for (int step = 0; step < mem_steps; step++) {
       const T* keys_on_step = keys + step * attn_depth_;
-      T* dest = alignments + step;
-
-      // reduce_sum(v * tanh(keys[step] + query)) on last dimension
-      *dest = T(0.0);
+      T* dest = tanh_keys_query + step * attn_depth_;
       for (int i = 0; i < attn_depth_; i++) {
-        *dest += (attention_v_[i] * tanh(keys_on_step[i] + query[i]));
+        dest[i] = tanh(keys_on_step[i] + query[i]);
       }
     }
+  }
+
+  // scores = math_ops.reduce_sum(v * math_ops.tanh(keys + processed_query), [2])
+  // computed for all memory positions of the whole batch in one GEMM.
+  math::GemmEx<T, CPUMathUtil>(CblasNoTrans, CblasNoTrans,
+                               batch_size_ * max_memory_steps_, 1, attn_depth_, T{1.0},
+                               tanh_keys_query_.data(), attn_depth_,
+                               attention_v_.data(), 1, T{0.0},
+                               aligns.data(), 1, &CPUMathUtil::Instance());
+
+  for (int b = 0; b < batch_size_; b++) {
+    T* alignments = aligns.data() + b * max_memory_steps_;
+    const int mem_steps = mem_seq_lengths_[b];
 
     SoftmaxInplace(gsl::span<T>{alignments, mem_steps});
 
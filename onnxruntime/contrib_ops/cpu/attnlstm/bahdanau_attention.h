@@ -28,7 +28,8 @@ class BahdanauAttention : public IAttentionMechanism<T> {
   void SetWeights(
       const gsl::span<const T>& attn_weights,
       const gsl::span<const T>& query_layer_weights,
-      const gsl::span<const T>& memory_layer_weights);
+      const gsl::span<const T>& memory_layer_weights,
+      const void* packed_query_layer_weights = nullptr);
 
   ~BahdanauAttention() override = default;
 
@@ -64,6 +65,10 @@ class BahdanauAttention : public IAttentionMechanism<T> {
   gsl::span<const T> query_layer_weights_;
   gsl::span<const T> memory_layer_weights_;
 
+  // query layer weights in MlasSgemm packed layout, when they were a constant
+  // initializer the kernel could pack up front.
+  const void* packed_query_layer_weights_ = nullptr;
+
   IAllocatorUniquePtr<T> keys_ptr_;
   gsl::span<T> keys_;
 
@@ -73,6 +78,11 @@ class BahdanauAttention : public IAttentionMechanism<T> {
   IAllocatorUniquePtr<T> processed_query_ptr_;
   gsl::span<T> processed_query_;
 
+  // scratch for tanh(keys + processed_query), reused across timesteps so the
+  // score reduction can run as one GEMM over all memory positions.
+  IAllocatorUniquePtr<T> tanh_keys_query_ptr_;
+  gsl::span<T> tanh_keys_query_;
+
   IAllocatorUniquePtr<int> mem_seq_lengths_ptr_;
   gsl::span<int> mem_seq_lengths_;
 
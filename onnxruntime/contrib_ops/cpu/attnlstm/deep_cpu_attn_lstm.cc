@@ -11,6 +11,10 @@
 #include "core/common/task_thread_pool.h"
 #include "core/framework/allocator.h"
 
+#if defined(USE_MLAS)
+#include "core/mlas/inc/mlas.h"
+#endif
+
 namespace onnxruntime {
 namespace contrib {
 
@@ -116,6 +120,42 @@ Status DeepCpuAttnLstmOp::ComputeImpl(OpKernelContext& context) const {
   const gsl::span<const T> attn_layer_weights_span = (has_attention_layer) ? attn_layer_weights->DataAsSpan<T>() : gsl::span<const T>();
   const gsl::span<const int> memory_seq_lens_span = (attn_memory_seq_lens != nullptr) ? attn_memory_seq_lens->DataAsSpan<int>() : gsl::span<const int>();
 
+  // packed weights are only available when the corresponding inputs are constant initializers
+  const void* packed_recurrent_weights_1 = nullptr;
+  const void* packed_recurrent_weights_2 = nullptr;
+  const void* packed_query_layer_weights_1 = nullptr;
+  const void* packed_query_layer_weights_2 = nullptr;
+  const void* packed_attn_layer_cell_weights_1 = nullptr;
+  const void* packed_attn_layer_cell_weights_2 = nullptr;
+  const void* packed_attn_layer_attn_weights_1 = nullptr;
+  const void* packed_attn_layer_attn_weights_2 = nullptr;
+
+#if defined(USE_MLAS)
+  if (packed_recurrent_weights_) {
+    packed_recurrent_weights_1 = packed_recurrent_weights_.get();
+    packed_recurrent_weights_2 =
+        static_cast<const uint8_t*>(packed_recurrent_weights_.get()) + packed_recurrent_weights_stride_;
+  }
+
+  if (packed_query_layer_weights_) {
+    packed_query_layer_weights_1 = packed_query_layer_weights_.get();
+    packed_query_layer_weights_2 =
+        static_cast<const uint8_t*>(packed_query_layer_weights_.get()) + packed_query_layer_weights_stride_;
+  }
+
+  if (packed_attn_layer_cell_weights_) {
+    packed_attn_layer_cell_weights_1 = packed_attn_layer_cell_weights_.get();
+    packed_attn_layer_cell_weights_2 =
+        static_cast<const uint8_t*>(packed_attn_layer_cell_weights_.get()) + packed_attn_layer_cell_weights_stride_;
+  }
+
+  if (packed_attn_layer_attn_weights_) {
+    packed_attn_layer_attn_weights_1 = packed_attn_layer_attn_weights_.get();
+    packed_attn_layer_attn_weights_2 =
+        static_cast<const uint8_t*>(packed_attn_layer_attn_weights_.get()) + packed_attn_layer_attn_weights_stride_;
+  }
+#endif
+
   // LSTM outputs are optional but must be in the same order
   std::vector<int64_t> Y_dims{seq_length, num_directions_, batch_size, hidden_size_};
   Tensor* Y = context.Output(/*index*/ 0, Y_dims);
@@ -234,12 +274,14 @@ Status DeepCpuAttnLstmOp::ComputeImpl(OpKernelContext& context) const {
     fam->SetWeights(
         FirstHalfSpan(am_v_weights.DataAsSpan<T>()),
         FirstHalfSpan(am_query_layer_weights.DataAsSpan<T>()),
-        FirstHalfSpan(am_memory_layer_weights.DataAsSpan<T>()));
+        FirstHalfSpan(am_memory_layer_weights.DataAsSpan<T>()),
+        packed_query_layer_weights_1);
     fam->PrepareMemory(attn_memory.DataAsSpan<T>(), memory_seq_lens_span);
 
     auto faw = std::make_unique<AttentionWrapper<T>>(
         alloc, logger, batch_size, memory_depth, attn_layer_depth, hidden_size_, has_attention_layer, *fam);
-    faw->SetWeights(FirstHalfSpan(attn_layer_weights_span));
+    faw->SetWeights(FirstHalfSpan(attn_layer_weights_span),
+                    packed_attn_layer_cell_weights_1, packed_attn_layer_attn_weights_1);
 
     auto fw = std::make_unique<UniDirectionalAttnLstm<T>>(
         alloc, logger,
@@ -256,12 +298,14 @@ Status DeepCpuAttnLstmOp::ComputeImpl(OpKernelContext& context) const {
     bam->SetWeights(
         SecondHalfSpan(am_v_weights.DataAsSpan<T>()),
         SecondHalfSpan(am_query_layer_weights.DataAsSpan<T>()),
-        SecondHalfSpan(am_memory_layer_weights.DataAsSpan<T>()));
+        SecondHalfSpan(am_memory_layer_weights.DataAsSpan<T>()),
+        packed_query_layer_weights_2);
     bam->PrepareMemory(attn_memory.DataAsSpan<T>(), memory_seq_lens_span);
 
     auto baw = std::make_unique<AttentionWrapper<T>>(
         alloc, logger, batch_size, memory_depth, attn_layer_depth, hidden_size_, has_attention_layer, *bam);
-    baw->SetWeights(SecondHalfSpan(attn_layer_weights_span));
+    baw->SetWeights(SecondHalfSpan(attn_layer_weights_span),
+                    packed_attn_layer_cell_weights_2, packed_attn_layer_attn_weights_2);
 
     auto bw = std::make_unique<UniDirectionalAttnLstm<T>>(
         alloc, logger,
@@ -273,8 +317,10 @@ Status DeepCpuAttnLstmOp::ComputeImpl(OpKernelContext& context) const {
         activation_funcs_.Entries()[5],
         clip_, ttp_);
 
-    fw->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1, last_cell_1);
-    bw->Compute(input, sequence_lens_span, num_directions_, input_weights_2, hidden_weights_2, output_2, hidden_output_2, last_cell_2);
+    fw->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1,
+                packed_recurrent_weights_1, output_1, hidden_output_1, last_cell_1);
+    bw->Compute(input, sequence_lens_span, num_directions_, input_weights_2, hidden_weights_2,
+                packed_recurrent_weights_2, output_2, hidden_output_2, last_cell_2);
 
   } else {
     auto fam = std::make_unique<BahdanauAttention<T>>(
@@ -282,12 +328,14 @@ Status DeepCpuAttnLstmOp::ComputeImpl(OpKernelContext& context) const {
     fam->SetWeights(
         am_v_weights.DataAsSpan<T>(),
         am_query_layer_weights.DataAsSpan<T>(),
-        am_memory_layer_weights.DataAsSpan<T>());
+        am_memory_layer_weights.DataAsSpan<T>(),
+        packed_query_layer_weights_1);
     fam->PrepareMemory(attn_memory.DataAsSpan<T>(), memory_seq_lens_span);
 
     auto faw = std::make_unique<AttentionWrapper<T>>(
         alloc, logger, batch_size, memory_depth, attn_layer_depth, hidden_size_, has_attention_layer, *fam);
-    faw->SetWeights(attn_layer_weights_span);
+    faw->SetWeights(attn_layer_weights_span,
+                    packed_attn_layer_cell_weights_1, packed_attn_layer_attn_weights_1);
 
     auto fw = std::make_unique<UniDirectionalAttnLstm<T>>(
         alloc, logger,
@@ -299,7 +347,8 @@ Status DeepCpuAttnLstmOp::ComputeImpl(OpKernelContext& context) const {
         activation_funcs_.Entries()[2],
         clip_, ttp_);
 
-    fw->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1, last_cell_1);
+    fw->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1,
+                packed_recurrent_weights_1, output_1, hidden_output_1, last_cell_1);
   }
 
   if (!output.empty()) {
@@ -503,5 +552,83 @@ Status DeepCpuAttnLstmOp::ValidateInputs(
   return Status::OK();
 }
 
+#if defined(USE_MLAS)
+// packs num_directions slices of weights into the MlasSgemm layout.
+// weights_data points at the first slice, with the slices weights_size_per_direction
+// values apart. trans/N/K/ldb describe how the GEMMs consume each slice.
+static void PackWeightsForAllDirections(CBLAS_TRANSPOSE trans, size_t N, size_t K,
+                                        const float* weights_data, size_t ldb,
+                                        size_t weights_size_per_direction, int num_directions,
+                                        IAllocatorUniquePtr<void>& packed_weights,
+                                        size_t& packed_weights_stride,
+                                        const OpKernelInfo& info) {
+  packed_weights_stride = MlasSgemmPackBSize(N, K);
+
+  auto alloc = info.GetExecutionProvider()->GetAllocator(0, ONNXRuntimeMemTypeDefault);
+  packed_weights = IAllocator::MakeUniquePtr<void>(alloc, packed_weights_stride * num_directions);
+  if (!packed_weights) {
+    packed_weights_stride = 0;
+    return;
+  }
+
+  auto* packed_weights_data = static_cast<uint8_t*>(packed_weights.get());
+
+  for (int i = 0; i < num_directions; i++) {
+    MlasSgemmPackB(trans, N, K, weights_data, ldb, packed_weights_data);
+    weights_data += weights_size_per_direction;
+    packed_weights_data += packed_weights_stride;
+  }
+}
+
+void DeepCpuAttnLstmOp::PackRecurrentWeights(const Tensor& weights, const OpKernelInfo& info) {
+  const auto& shape = weights.Shape();
+  if (weights.DataType() != DataTypeImpl::GetType<float>() || shape.NumDimensions() != 3)
+    return;
+
+  // R is [num_directions, 4*hidden_size, hidden_size] and is consumed
+  // transposed by ComputeGemm.
+  const size_t N = static_cast<size_t>(shape[1]);
+  const size_t K = static_cast<size_t>(shape[2]);
+  PackWeightsForAllDirections(CblasTrans, N, K, weights.Data<float>(), K, N * K, num_directions_,
+                              packed_recurrent_weights_, packed_recurrent_weights_stride_, info);
+}
+
+void DeepCpuAttnLstmOp::PackQueryLayerWeights(const Tensor& weights, const OpKernelInfo& info) {
+  const auto& shape = weights.Shape();
+  if (weights.DataType() != DataTypeImpl::GetType<float>() || shape.NumDimensions() != 3)
+    return;
+
+  // query layer weights are [num_directions, query_depth, am_attn_size] and
+  // are consumed without transposition.
+  const size_t K = static_cast<size_t>(shape[1]);
+  const size_t N = static_cast<size_t>(shape[2]);
+  PackWeightsForAllDirections(CblasNoTrans, N, K, weights.Data<float>(), N, N * K, num_directions_,
+                              packed_query_layer_weights_, packed_query_layer_weights_stride_, info);
+}
+
+void DeepCpuAttnLstmOp::PackAttentionLayerWeights(const Tensor& weights, const OpKernelInfo& info) {
+  const auto& shape = weights.Shape();
+  if (weights.DataType() != DataTypeImpl::GetType<float>() || shape.NumDimensions() != 3 ||
+      shape[1] <= hidden_size_)
+    return;
+
+  // attention layer weights are [num_directions, cell_hidden_size + memory_depth, aw_attn_size].
+  // the first hidden_size rows project the cell output and the remaining rows
+  // project the attention context. they feed two separate GEMMs per timestep,
+  // so each block is packed on its own.
+  const size_t N = static_cast<size_t>(shape[2]);
+  const size_t cell_rows = static_cast<size_t>(hidden_size_);
+  const size_t attn_rows = static_cast<size_t>(shape[1]) - cell_rows;
+  const size_t weights_size_per_direction = static_cast<size_t>(shape[1]) * N;
+
+  PackWeightsForAllDirections(CblasNoTrans, N, cell_rows, weights.Data<float>(), N,
+                              weights_size_per_direction, num_directions_,
+                              packed_attn_layer_cell_weights_, packed_attn_layer_cell_weights_stride_, info);
+  PackWeightsForAllDirections(CblasNoTrans, N, attn_rows, weights.Data<float>() + cell_rows * N, N,
+                              weights_size_per_direction, num_directions_,
+                              packed_attn_layer_attn_weights_, packed_attn_layer_attn_weights_stride_, info);
+}
+#endif
+
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -58,6 +58,19 @@ class DeepCpuAttnLstmOp final : public OpKernel {
     activation_funcs_ = ActivationFuncs(activation_func_names,
                                         activation_func_alphas,
                                         activation_func_betas);
+
+#if defined(USE_MLAS)
+    // The recurrence weights and the attention projection weights are usually
+    // constant initializers, and each feeds a GEMM on every timestep. Pack
+    // them into the MlasSgemm layout once here instead of repacking per step.
+    const Tensor* weights;
+    if (info.TryGetConstantInput(2, &weights))
+      PackRecurrentWeights(*weights, info);
+    if (info.TryGetConstantInput(8, &weights))
+      PackQueryLayerWeights(*weights, info);
+    if (info.TryGetConstantInput(13, &weights))
+      PackAttentionLayerWeights(*weights, info);
+#endif
   }
 
   Status Compute(OpKernelContext* context) const override;
@@ -84,6 +97,26 @@ class DeepCpuAttnLstmOp final : public OpKernel {
                         const Tensor* attn_memory_seq_lens,
                         const Tensor* attn_layer_weights) const;
 
+#if defined(USE_MLAS)
+  void PackRecurrentWeights(const Tensor& weights, const OpKernelInfo& info);
+  void PackQueryLayerWeights(const Tensor& weights, const OpKernelInfo& info);
+  void PackAttentionLayerWeights(const Tensor& weights, const OpKernelInfo& info);
+
+  // per-direction packed copies of constant initializer weights that feed a
+  // GEMM on every timestep. the attention layer weights hold two stacked
+  // projections that are applied separately, so each block gets its own
+  // buffer. packed_*_stride_ is the offset in bytes between the per-direction
+  // buffers.
+  IAllocatorUniquePtr<void> packed_recurrent_weights_;
+  IAllocatorUniquePtr<void> packed_query_layer_weights_;
+  IAllocatorUniquePtr<void> packed_attn_layer_cell_weights_;
+  IAllocatorUniquePtr<void> packed_attn_layer_attn_weights_;
+  size_t packed_recurrent_weights_stride_ = 0;
+  size_t packed_query_layer_weights_stride_ = 0;
+  size_t packed_attn_layer_cell_weights_stride_ = 0;
+  size_t packed_attn_layer_attn_weights_stride_ = 0;
+#endif
+
   Direction direction_;
   int num_directions_;
 
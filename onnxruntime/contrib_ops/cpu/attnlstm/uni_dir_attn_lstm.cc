@@ -197,9 +197,14 @@ void UniDirectionalAttnLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
                                         const int num_directions,
                                         const gsl::span<const T>& input_weights,
                                         const gsl::span<const T>& recurrent_weights,
+                                        const void* packed_recurrent_weights,
                                         gsl::span<T>& outputs,
                                         gsl::span<T>& final_hidden_state,
                                         gsl::span<T>& final_cell_state) {
+#if !defined(USE_MLAS)
+  ONNXRUNTIME_UNUSED_PARAMETER(packed_recurrent_weights);
+#endif
+
   // copy spans (just T* and size, not data in span) as we may change them
   gsl::span<const T> inputs = inputs_arg;
   gsl::span<const int> sequence_lengths = sequence_lengths_arg;
@@ -299,13 +304,26 @@ void UniDirectionalAttnLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
                   hidden_size_x4);
 
       // calculate Xt*(W[iofc]^T) + Ht-1*R[iofc]
-      ComputeGemm(batch_size_, hidden_size_x4, hidden_size_, T{1.0},
-                  previous_state, previous_state_end,  // Ht-1
-                  hidden_size_,
-                  recurrent_weights.cbegin(), recurrent_weights.cend(),  // R[iofc]
-                  hidden_size_, T{1.0},
-                  step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
-                  hidden_size_x4);
+#if defined(USE_MLAS)
+      if (packed_recurrent_weights != nullptr) {
+        ComputeGemm(batch_size_, hidden_size_x4, hidden_size_, T{1.0},
+                    previous_state, previous_state_end,  // Ht-1
+                    hidden_size_,
+                    packed_recurrent_weights,  // R[iofc] in MlasSgemmPackB layout
+                    T{1.0},
+                    step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
+                    hidden_size_x4);
+      } else
+#endif
+      {
+        ComputeGemm(batch_size_, hidden_size_x4, hidden_size_, T{1.0},
+                    previous_state, previous_state_end,  // Ht-1
+                    hidden_size_,
+                    recurrent_weights.cbegin(), recurrent_weights.cend(),  // R[iofc]
+                    hidden_size_, T{1.0},
+                    step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
+                    hidden_size_x4);
+      }
 
       span_T_iter batched_output, batched_output_end;
       if (output_sequence) {
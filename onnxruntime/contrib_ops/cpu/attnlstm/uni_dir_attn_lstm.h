@@ -60,6 +60,7 @@ class UniDirectionalAttnLstm {
                const int num_directions,
                const gsl::span<const T>& input_weights,
                const gsl::span<const T>& recurrent_weights,
+               const void* packed_recurrent_weights,
                gsl::span<T>& outputs,
                gsl::span<T>& final_hidden_state,
                gsl::span<T>& final_cell_state);
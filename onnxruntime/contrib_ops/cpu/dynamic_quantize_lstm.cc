@@ -0,0 +1,271 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "dynamic_quantize_lstm.h"
+
+#include <cmath>
+
+#include "gsl/gsl_util"
+
+#include "core/mlas/inc/mlas.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_KERNEL_EX(
+    DynamicQuantizeLSTM,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("T2", DataTypeImpl::GetTensorType<int8_t>()),
+    DynamicQuantizeLSTM);
+
+namespace {
+
+// Quantize a row-major fp32 block to uint8 with a symmetric scale and a zero
+// point of 128, returning the scale. MlasQgemm consumes the A matrix as
+// uint8 with an offset, so a fixed midpoint zero point keeps the math exact
+// for both signs without a per-block zero point search.
+float QuantizeBlock(const float* data, int64_t count, uint8_t* quantized) {
+  float amax = 0.0f;
+  for (int64_t i = 0; i < count; ++i) {
+    amax = std::max(amax, std::fabs(data[i]));
+  }
+
+  const float scale = amax > 0.0f ? amax / 127.0f : 1.0f;
+  const float inverse_scale = 1.0f / scale;
+  for (int64_t i = 0; i < count; ++i) {
+    int32_t value = static_cast<int32_t>(std::nearbyintf(data[i] * inverse_scale)) + 128;
+    quantized[i] = static_cast<uint8_t>(std::min(255, std::max(0, value)));
+  }
+  return scale;
+}
+
+// Transpose int8 weights from the ONNX [4*hidden_size, K] layout to the
+// [K, 4*hidden_size] layout MlasQgemm expects for the B matrix.
+void TransposeToGemmLayout(const int8_t* weights, int64_t rows, int64_t cols, int8_t* transposed) {
+  for (int64_t r = 0; r < rows; ++r) {
+    for (int64_t c = 0; c < cols; ++c) {
+      transposed[c * rows + r] = weights[r * cols + c];
+    }
+  }
+}
+
+}  // namespace
+
+DynamicQuantizeLSTM::DynamicQuantizeLSTM(const OpKernelInfo& info) : OpKernel(info) {
+  int64_t int64_value;
+  ONNXRUNTIME_ENFORCE(info.GetAttr("hidden_size", &int64_value).IsOK() && int64_value > 0);
+  hidden_size_ = gsl::narrow<int>(int64_value);
+
+  // W and R come from the offline quantizer as constant initializers, so the
+  // transpose to GEMM layout normally happens once here rather than per Run.
+  const Tensor* W;
+  const Tensor* R;
+  if (info.TryGetConstantInput(1, &W))
+    TransposeWeights(*W, transposed_W_, info);
+  if (info.TryGetConstantInput(2, &R))
+    TransposeWeights(*R, transposed_R_, info);
+}
+
+void DynamicQuantizeLSTM::TransposeWeights(const Tensor& weights, IAllocatorUniquePtr<void>& transposed,
+                                           const OpKernelInfo& info) {
+  const auto& shape = weights.Shape();
+  if (weights.DataType() != DataTypeImpl::GetType<int8_t>() || shape.NumDimensions() != 2)
+    return;
+
+  auto alloc = info.GetExecutionProvider()->GetAllocator(0, ONNXRuntimeMemTypeDefault);
+  transposed = IAllocator::MakeUniquePtr<void>(alloc, static_cast<size_t>(shape.Size()));
+  if (!transposed)
+    return;
+
+  TransposeToGemmLayout(weights.Data<int8_t>(), shape[0], shape[1],
+                        static_cast<int8_t*>(transposed.get()));
+}
+
+Status DynamicQuantizeLSTM::Compute(OpKernelContext* context) const {
+  const Tensor& X = *context->Input<Tensor>(0);        // [seq_length, batch_size, input_size]
+  const Tensor& W = *context->Input<Tensor>(1);        // [4*hidden_size, input_size] int8, iofc
+  const Tensor& R = *context->Input<Tensor>(2);        // [4*hidden_size, hidden_size] int8, iofc
+  const Tensor& W_scale = *context->Input<Tensor>(3);  // [4] per-gate scales, iofc
+  const Tensor& R_scale = *context->Input<Tensor>(4);  // [4] per-gate scales, iofc
+  const Tensor* B = context->Input<Tensor>(5);         // [8*hidden_size] fp32 Wb then Rb, optional
+  const Tensor* initial_h = context->Input<Tensor>(6);  // [batch_size, hidden_size] optional
+  const Tensor* initial_c = context->Input<Tensor>(7);  // [batch_size, hidden_size] optional
+
+  auto& X_shape = X.Shape();
+  ONNXRUNTIME_RETURN_IF_NOT(X_shape.NumDimensions() == 3, "X must be 3 dimensional");
+
+  const int64_t seq_length = X_shape[0];
+  const int64_t batch_size = X_shape[1];
+  const int64_t input_size = X_shape[2];
+  const int64_t hidden_size = hidden_size_;
+  const int64_t hidden_size_x4 = 4 * hidden_size;
+
+  ONNXRUNTIME_RETURN_IF_NOT(W.Shape() == TensorShape({hidden_size_x4, input_size}),
+                            "W must have shape {", hidden_size_x4, ",", input_size, "}");
+  ONNXRUNTIME_RETURN_IF_NOT(R.Shape() == TensorShape({hidden_size_x4, hidden_size}),
+                            "R must have shape {", hidden_size_x4, ",", hidden_size, "}");
+  ONNXRUNTIME_RETURN_IF_NOT(W_scale.Shape().Size() == 4, "W_scale must have 4 per-gate entries");
+  ONNXRUNTIME_RETURN_IF_NOT(R_scale.Shape().Size() == 4, "R_scale must have 4 per-gate entries");
+  if (B != nullptr)
+    ONNXRUNTIME_RETURN_IF_NOT(B->Shape().Size() == 8 * hidden_size,
+                              "B must have ", 8 * hidden_size, " entries");
+
+  Tensor* Y = context->Output(0, TensorShape({seq_length, 1, batch_size, hidden_size}));
+  Tensor* Y_h = context->Output(1, TensorShape({1, batch_size, hidden_size}));
+  Tensor* Y_c = context->Output(2, TensorShape({1, batch_size, hidden_size}));
+
+  AllocatorPtr alloc;
+  ONNXRUNTIME_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+
+  // transpose per call when the weights were not constant initializers
+  IAllocatorUniquePtr<void> local_W;
+  IAllocatorUniquePtr<void> local_R;
+  const int8_t* W_gemm = static_cast<const int8_t*>(transposed_W_.get());
+  const int8_t* R_gemm = static_cast<const int8_t*>(transposed_R_.get());
+  if (W_gemm == nullptr) {
+    local_W = IAllocator::MakeUniquePtr<void>(alloc, static_cast<size_t>(hidden_size_x4 * input_size));
+    TransposeToGemmLayout(W.Data<int8_t>(), hidden_size_x4, input_size,
+                          static_cast<int8_t*>(local_W.get()));
+    W_gemm = static_cast<const int8_t*>(local_W.get());
+  }
+  if (R_gemm == nullptr) {
+    local_R = IAllocator::MakeUniquePtr<void>(alloc, static_cast<size_t>(hidden_size_x4 * hidden_size));
+    TransposeToGemmLayout(R.Data<int8_t>(), hidden_size_x4, hidden_size,
+                          static_cast<int8_t*>(local_R.get()));
+    R_gemm = static_cast<const int8_t*>(local_R.get());
+  }
+
+  const float* w_scales = W_scale.Data<float>();
+  const float* r_scales = R_scale.Data<float>();
+  const float* bias = B != nullptr ? B->Data<float>() : nullptr;
+
+  IAllocatorUniquePtr<uint8_t> quantized_x_ptr = IAllocator::MakeUniquePtr<uint8_t>(
+      alloc, static_cast<size_t>(batch_size * input_size));
+  IAllocatorUniquePtr<uint8_t> quantized_h_ptr = IAllocator::MakeUniquePtr<uint8_t>(
+      alloc, static_cast<size_t>(batch_size * hidden_size));
+  IAllocatorUniquePtr<int32_t> input_accumulator_ptr = IAllocator::MakeUniquePtr<int32_t>(
+      alloc, static_cast<size_t>(batch_size * hidden_size_x4));
+  IAllocatorUniquePtr<int32_t> recurrent_accumulator_ptr = IAllocator::MakeUniquePtr<int32_t>(
+      alloc, static_cast<size_t>(batch_size * hidden_size_x4));
+  IAllocatorUniquePtr<float> gates_ptr = IAllocator::MakeUniquePtr<float>(
+      alloc, static_cast<size_t>(batch_size * hidden_size_x4));
+  IAllocatorUniquePtr<float> hidden_ptr = IAllocator::MakeUniquePtr<float>(
+      alloc, static_cast<size_t>(batch_size * hidden_size));
+  IAllocatorUniquePtr<float> cell_ptr = IAllocator::MakeUniquePtr<float>(
+      alloc, static_cast<size_t>(batch_size * hidden_size));
+  IAllocatorUniquePtr<float> cell_tanh_ptr = IAllocator::MakeUniquePtr<float>(
+      alloc, static_cast<size_t>(hidden_size));
+
+  uint8_t* quantized_x = quantized_x_ptr.get();
+  uint8_t* quantized_h = quantized_h_ptr.get();
+  int32_t* input_accumulator = input_accumulator_ptr.get();
+  int32_t* recurrent_accumulator = recurrent_accumulator_ptr.get();
+  float* gates = gates_ptr.get();
+  float* hidden = hidden_ptr.get();
+  float* cell = cell_ptr.get();
+  float* cell_tanh = cell_tanh_ptr.get();
+
+  if (initial_h != nullptr) {
+    memcpy(hidden, initial_h->Data<float>(), batch_size * hidden_size * sizeof(float));
+  } else {
+    memset(hidden, 0, batch_size * hidden_size * sizeof(float));
+  }
+  if (initial_c != nullptr) {
+    memcpy(cell, initial_c->Data<float>(), batch_size * hidden_size * sizeof(float));
+  } else {
+    memset(cell, 0, batch_size * hidden_size * sizeof(float));
+  }
+
+  const float* x_data = X.Data<float>();
+  float* y_data = Y != nullptr ? Y->MutableData<float>() : nullptr;
+
+  for (int64_t step = 0; step < seq_length; ++step) {
+    // dynamic quantization: one scale per timestep for the input block and
+    // one for the previous hidden state
+    const float x_scale = QuantizeBlock(x_data + step * batch_size * input_size,
+                                        batch_size * input_size, quantized_x);
+    const float h_scale = QuantizeBlock(hidden, batch_size * hidden_size, quantized_h);
+
+    MlasQgemm(static_cast<size_t>(batch_size), static_cast<size_t>(hidden_size_x4),
+              static_cast<size_t>(input_size),
+              quantized_x, static_cast<size_t>(input_size), /* offa */ 128,
+              reinterpret_cast<const uint8_t*>(W_gemm), static_cast<size_t>(hidden_size_x4),
+              /* offb */ 0, /* BIsSigned */ true,
+              input_accumulator, static_cast<size_t>(hidden_size_x4));
+
+    MlasQgemm(static_cast<size_t>(batch_size), static_cast<size_t>(hidden_size_x4),
+              static_cast<size_t>(hidden_size),
+              quantized_h, static_cast<size_t>(hidden_size), /* offa */ 128,
+              reinterpret_cast<const uint8_t*>(R_gemm), static_cast<size_t>(hidden_size_x4),
+              /* offb */ 0, /* BIsSigned */ true,
+              recurrent_accumulator, static_cast<size_t>(hidden_size_x4));
+
+    // dequantize into fp32 gate pre-activations, adding the fp32 bias
+    for (int64_t b = 0; b < batch_size; ++b) {
+      const int32_t* input_row = input_accumulator + b * hidden_size_x4;
+      const int32_t* recurrent_row = recurrent_accumulator + b * hidden_size_x4;
+      float* gate_row = gates + b * hidden_size_x4;
+
+      for (int64_t gate = 0; gate < 4; ++gate) {
+        const float input_scale = x_scale * w_scales[gate];
+        const float recurrent_scale = h_scale * r_scales[gate];
+
+        for (int64_t j = gate * hidden_size; j < (gate + 1) * hidden_size; ++j) {
+          float value = input_row[j] * input_scale + recurrent_row[j] * recurrent_scale;
+          if (bias != nullptr) {
+            value += bias[j] + bias[hidden_size_x4 + j];
+          }
+          gate_row[j] = value;
+        }
+      }
+    }
+
+    // gate nonlinearities in fp32: iofc layout keeps the three sigmoid gates
+    // contiguous ahead of the tanh cell gate
+    for (int64_t b = 0; b < batch_size; ++b) {
+      float* gate_row = gates + b * hidden_size_x4;
+      MlasComputeLogistic(gate_row, gate_row, static_cast<size_t>(3 * hidden_size));
+      MlasComputeTanh(gate_row + 3 * hidden_size, gate_row + 3 * hidden_size,
+                      static_cast<size_t>(hidden_size));
+
+      const float* gate_i = gate_row;
+      const float* gate_o = gate_row + hidden_size;
+      const float* gate_f = gate_row + 2 * hidden_size;
+      const float* gate_c = gate_row + 3 * hidden_size;
+
+      float* cell_row = cell + b * hidden_size;
+      float* hidden_row = hidden + b * hidden_size;
+
+      for (int64_t j = 0; j < hidden_size; ++j) {
+        cell_row[j] = gate_f[j] * cell_row[j] + gate_i[j] * gate_c[j];
+      }
+
+      MlasComputeTanh(cell_row, cell_tanh, static_cast<size_t>(hidden_size));
+
+      for (int64_t j = 0; j < hidden_size; ++j) {
+        hidden_row[j] = gate_o[j] * cell_tanh[j];
+      }
+    }
+
+    if (y_data != nullptr) {
+      memcpy(y_data + step * batch_size * hidden_size, hidden,
+             batch_size * hidden_size * sizeof(float));
+    }
+  }
+
+  if (Y_h != nullptr) {
+    memcpy(Y_h->MutableData<float>(), hidden, batch_size * hidden_size * sizeof(float));
+  }
+  if (Y_c != nullptr) {
+    memcpy(Y_c->MutableData<float>(), cell, batch_size * hidden_size * sizeof(float));
+  }
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,36 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Forward LSTM over int8 weights for edge CPUs where the fp32 DeepCpuLstmOp
+// misses the latency budget. W and R are stored as int8 with per-gate scales;
+// the input and recurrent GEMMs quantize their activations dynamically per
+// timestep, accumulate in int32 through MlasQgemm, and the gate
+// nonlinearities run in fp32 through the MLAS logistic/tanh primitives.
+class DynamicQuantizeLSTM final : public OpKernel {
+ public:
+  DynamicQuantizeLSTM(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  void TransposeWeights(const Tensor& weights, IAllocatorUniquePtr<void>& transposed,
+                        const OpKernelInfo& info);
+
+  int hidden_size_ = 0;
+
+  // W and R transposed once to the [K, 4*hidden_size] layout MlasQgemm
+  // consumes, when they are constant initializers.
+  IAllocatorUniquePtr<void> transposed_W_;
+  IAllocatorUniquePtr<void> transposed_R_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,131 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/embed_bag.h"
+
+
+#include "core/util/math_cpuonly.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_KERNEL_EX(
+    EmbeddingBag,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("Tind", std::vector<MLDataType>{DataTypeImpl::GetTensorType<int32_t>(),
+                                                        DataTypeImpl::GetTensorType<int64_t>()}),
+    EmbedBag);
+
+namespace {
+
+// how many indices ahead of the accumulation the table rows are requested,
+// so a bag of scattered rows streams up the cache hierarchy instead of
+// stalling the adds on every miss
+constexpr int64_t kBagPrefetchDistance = 8;
+
+inline void PrefetchRow(const float* p) {
+#ifdef _MSC_VER
+  _mm_prefetch(reinterpret_cast<const char*>(p), _MM_HINT_T0);
+#else
+  __builtin_prefetch(p, 0 /*read*/, 3 /*high temporal locality*/);
+#endif
+}
+
+// Reduces the bags in [first, last), each accumulating its rows directly
+// from the table into the output slot.
+template <typename Tind>
+void ReduceBags(const float* table, const Tind* indices_data, float* output,
+                int64_t first, int64_t last, int64_t bag, int64_t row_size, bool mean) {
+  for (int64_t b = first; b < last; ++b) {
+    const Tind* bag_indices = indices_data + b * bag;
+    EigenVectorArrayMap<float> y(output + b * row_size, row_size);
+    y.setZero();
+    for (int64_t k = 0; k < bag; ++k) {
+      if (k + kBagPrefetchDistance < bag)
+        PrefetchRow(table + bag_indices[k + kBagPrefetchDistance] * row_size);
+      y += ConstEigenVectorArrayMap<float>(table + bag_indices[k] * row_size, row_size);
+    }
+    if (mean && bag > 0) {
+      y /= static_cast<float>(bag);
+    }
+  }
+}
+
+}  // namespace
+
+Status EmbedBag::Compute(OpKernelContext* context) const {
+  const Tensor* indices_tensor = context->Input<Tensor>(1);
+  if (indices_tensor->DataType() == DataTypeImpl::GetType<int32_t>())
+    return ComputeImpl<int32_t>(context);
+  return ComputeImpl<int64_t>(context);
+}
+
+template <typename Tind>
+Status EmbedBag::ComputeImpl(OpKernelContext* context) const {
+  const Tensor* data_tensor = context->Input<Tensor>(0);
+  const Tensor* indices_tensor = context->Input<Tensor>(1);
+  const TensorShape& data_shape = data_tensor->Shape();
+  const TensorShape& indices_shape = indices_tensor->Shape();
+
+  if (data_shape.NumDimensions() < 1 || indices_shape.NumDimensions() < 1) {
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                                   "data and indices must have rank >= 1");
+  }
+
+  const int64_t num_rows = data_shape[0];
+  const int64_t row_size = data_shape.SizeFromDimension(1);
+  const size_t indices_rank = indices_shape.NumDimensions();
+  const int64_t bag = indices_shape[indices_rank - 1];
+  const int64_t bags = indices_shape.SizeToDimension(indices_rank - 1);
+
+  // output shape is indices.shape[:-1] ++ data.shape[1:], with the reduced
+  // bag axis kept as a 1 when the fused ReduceSum/ReduceMean kept its dims
+  std::vector<int64_t> output_dims(indices_shape.GetDims().begin(),
+                                   indices_shape.GetDims().end() - 1);
+  if (keepdims_ == 1) {
+    output_dims.push_back(1);
+  }
+  output_dims.insert(output_dims.end(), data_shape.GetDims().begin() + 1, data_shape.GetDims().end());
+  Tensor* output_tensor = context->Output(0, TensorShape(output_dims));
+
+  const Tind* indices_data = indices_tensor->template Data<Tind>();
+
+  // validate up front in case of an out of bound index; the workers below
+  // cannot return a status
+  const int64_t num_indices = indices_shape.Size();
+  for (int64_t i = 0; i < num_indices; ++i) {
+    Tind idx = indices_data[i];
+    if (idx < 0 || idx >= num_rows) {
+      return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                                     "indices element out of data bounds, idx=", idx,
+                                     " data_dim=", num_rows);
+    }
+  }
+
+  if (output_tensor->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  const float* table = data_tensor->template Data<float>();
+  float* output = output_tensor->template MutableData<float>();
+  const bool mean = mode_ == "mean";
+
+  // each bag accumulates bag rows of row_size elements
+  context->ParallelFor(0, bags, static_cast<double>(bag * row_size),
+                       [table, indices_data, output, bag, row_size, mean](int64_t first, int64_t last) {
+                         ReduceBags(table, indices_data, output, first, last, bag, row_size, mean);
+                       });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,36 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Fused embedding bag: sums (or averages) the table rows each bag addresses
+// straight out of the table, replacing the Gather + bag-axis ReduceSum or
+// ReduceMean pair recommendation models emit (see EmbedBagFusion) without
+// materializing the gathered intermediate. Bags reduce independently, so
+// large batches split across the task pool.
+class EmbedBag final : public OpKernel {
+ public:
+  explicit EmbedBag(const OpKernelInfo& info) : OpKernel(info) {
+    mode_ = info.GetAttrOrDefault<std::string>("mode", "sum");
+    keepdims_ = info.GetAttrOrDefault<int64_t>("keepdims", 1);
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  template <typename Tind>
+  Status ComputeImpl(OpKernelContext* context) const;
+
+  std::string mode_;
+  int64_t keepdims_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,177 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "fused_elementwise.h"
+
+#include <cmath>
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_KERNEL_EX(
+    FusedElementwise,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    FusedElementwise);
+
+namespace {
+// elements evaluated per pass; the block buffer stays resident in L1/L2
+// while every step of the chain runs over it
+constexpr int64_t kFusedElementwiseBlock = 4096;
+}  // namespace
+
+FusedElementwise::FusedElementwise(const OpKernelInfo& info) : OpKernel(info) {
+  std::vector<std::string> ops;
+  ONNXRUNTIME_ENFORCE(info.GetAttrs<std::string>("ops", ops).IsOK() && !ops.empty(),
+              "Missing/Invalid 'ops' attribute value");
+  std::vector<float> alphas = info.GetAttrsOrDefault<float>("alphas");
+
+  steps_.reserve(ops.size());
+  for (size_t i = 0; i < ops.size(); ++i) {
+    const std::string& op = ops[i];
+    Step step;
+    step.is_binary = false;
+    step.alpha = i < alphas.size() ? alphas[i] : 0.01f;
+
+    if (op == "Add") {
+      step.kind = OpKind::Add;
+      step.is_binary = true;
+    } else if (op == "Sub") {
+      step.kind = OpKind::Sub;
+      step.is_binary = true;
+    } else if (op == "Mul") {
+      step.kind = OpKind::Mul;
+      step.is_binary = true;
+    } else if (op == "Div") {
+      step.kind = OpKind::Div;
+      step.is_binary = true;
+    } else if (op == "Relu") {
+      step.kind = OpKind::Relu;
+    } else if (op == "LeakyRelu") {
+      step.kind = OpKind::LeakyRelu;
+    } else if (op == "Sigmoid") {
+      step.kind = OpKind::Sigmoid;
+    } else if (op == "Tanh") {
+      step.kind = OpKind::Tanh;
+    } else if (op == "Exp") {
+      step.kind = OpKind::Exp;
+    } else if (op == "Log") {
+      step.kind = OpKind::Log;
+    } else if (op == "Sqrt") {
+      step.kind = OpKind::Sqrt;
+    } else if (op == "Neg") {
+      step.kind = OpKind::Neg;
+    } else if (op == "Abs") {
+      step.kind = OpKind::Abs;
+    } else {
+      ONNXRUNTIME_THROW("Unsupported op in fused elementwise chain: ", op);
+    }
+
+    steps_.push_back(step);
+  }
+}
+
+Status FusedElementwise::Compute(OpKernelContext* context) const {
+  auto input_count = Node().InputArgCount().front();
+
+  int expected_inputs = 1;
+  for (const auto& step : steps_) {
+    if (step.is_binary)
+      ++expected_inputs;
+  }
+  ONNXRUNTIME_RETURN_IF_NOT(input_count == expected_inputs,
+                    "Fused chain needs ", expected_inputs, " inputs but got ", input_count);
+
+  const Tensor* first_input = context->Input<Tensor>(0);
+  if (first_input == nullptr) return Status(common::ONNXRUNTIME, common::FAIL, "input count mismatch");
+  const TensorShape& shape = first_input->Shape();
+
+  std::vector<const float*> inputs(input_count);
+  for (int i = 0; i < input_count; ++i) {
+    const Tensor* input_tensor = context->Input<Tensor>(i);
+    if (input_tensor == nullptr) return Status(common::ONNXRUNTIME, common::FAIL, "input count mismatch");
+    ONNXRUNTIME_RETURN_IF_NOT(input_tensor->Shape() == shape,
+                      "All fused chain inputs must have the same shape, mismatch on input ", i);
+    inputs[i] = input_tensor->Data<float>();
+  }
+
+  float* output = context->Output(0, shape)->MutableData<float>();
+  const int64_t size = shape.Size();
+
+  // Evaluates every step of the chain over one block before moving to the
+  // next, with the running value held in a stack buffer.
+  auto run_range = [this, &inputs, output](int64_t first, int64_t last) {
+    float buf[kFusedElementwiseBlock];
+    for (int64_t base = first; base < last; base += kFusedElementwiseBlock) {
+      const int64_t len = std::min(kFusedElementwiseBlock, last - base);
+      memcpy(buf, inputs[0] + base, len * sizeof(float));
+
+      size_t next_input = 1;
+      for (const auto& step : steps_) {
+        const float* rhs = step.is_binary ? inputs[next_input++] + base : nullptr;
+        switch (step.kind) {
+          case OpKind::Add:
+            for (int64_t i = 0; i < len; ++i) buf[i] += rhs[i];
+            break;
+          case OpKind::Sub:
+            for (int64_t i = 0; i < len; ++i) buf[i] -= rhs[i];
+            break;
+          case OpKind::Mul:
+            for (int64_t i = 0; i < len; ++i) buf[i] *= rhs[i];
+            break;
+          case OpKind::Div:
+            for (int64_t i = 0; i < len; ++i) buf[i] /= rhs[i];
+            break;
+          case OpKind::Relu:
+            for (int64_t i = 0; i < len; ++i) buf[i] = buf[i] > 0.0f ? buf[i] : 0.0f;
+            break;
+          case OpKind::LeakyRelu:
+            for (int64_t i = 0; i < len; ++i) buf[i] = buf[i] >= 0.0f ? buf[i] : step.alpha * buf[i];
+            break;
+          case OpKind::Sigmoid:
+            for (int64_t i = 0; i < len; ++i) buf[i] = 1.0f / (1.0f + std::exp(-buf[i]));
+            break;
+          case OpKind::Tanh:
+            for (int64_t i = 0; i < len; ++i) buf[i] = std::tanh(buf[i]);
+            break;
+          case OpKind::Exp:
+            for (int64_t i = 0; i < len; ++i) buf[i] = std::exp(buf[i]);
+            break;
+          case OpKind::Log:
+            for (int64_t i = 0; i < len; ++i) buf[i] = std::log(buf[i]);
+            break;
+          case OpKind::Sqrt:
+            for (int64_t i = 0; i < len; ++i) buf[i] = std::sqrt(buf[i]);
+            break;
+          case OpKind::Neg:
+            for (int64_t i = 0; i < len; ++i) buf[i] = -buf[i];
+            break;
+          case OpKind::Abs:
+            for (int64_t i = 0; i < len; ++i) buf[i] = std::abs(buf[i]);
+            break;
+        }
+      }
+
+      memcpy(output + base, buf, len * sizeof(float));
+    }
+  };
+
+  // shard on block boundaries so shards never share a block; every element
+  // is touched once per step of the chain
+  const int64_t num_blocks = (size + kFusedElementwiseBlock - 1) / kFusedElementwiseBlock;
+  const double cost_per_block =
+      static_cast<double>(kFusedElementwiseBlock) * static_cast<double>(steps_.size());
+
+  context->ParallelFor(0, num_blocks, cost_per_block,
+                       [&run_range, size](int64_t first_block, int64_t last_block) {
+                         run_range(first_block * kFusedElementwiseBlock,
+                                   std::min(last_block * kFusedElementwiseBlock, size));
+                       });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
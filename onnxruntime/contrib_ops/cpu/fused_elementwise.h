@@ -0,0 +1,49 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Interprets the op chain recorded by ElementwiseFusion over one
+// cache-resident block at a time, so no intermediate value ever
+// materializes as a full tensor.
+class FusedElementwise final : public OpKernel {
+ public:
+  FusedElementwise(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  enum class OpKind : uint8_t {
+    Add,
+    Sub,
+    Mul,
+    Div,
+    Relu,
+    LeakyRelu,
+    Sigmoid,
+    Tanh,
+    Exp,
+    Log,
+    Sqrt,
+    Neg,
+    Abs,
+  };
+
+  // one step of the chain; binary steps consume the next unused input
+  struct Step {
+    OpKind kind;
+    bool is_binary;
+    float alpha;  // LeakyRelu slope
+  };
+
+  std::vector<Step> steps_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,24 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/providers/cpu/math/gemm.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+template <typename T>
+class FusedGemm : public Gemm<T, T, T, T> {
+ public:
+  FusedGemm(const OpKernelInfo& info) : Gemm<T, T, T, T>(info) {
+    Gemm<T, T, T, T>::activation_ = info.GetAttrOrDefault<std::string>("activation", "");
+    Gemm<T, T, T, T>::leaky_relu_alpha_ = info.GetAttrOrDefault("leaky_relu_alpha", 0.01f);
+  }
+
+  Status Compute(OpKernelContext* context) const override {
+    return Gemm<T, T, T, T>::Compute(context);
+  }
+};
+}  // namespace contrib
+}  // namespace onnxruntime
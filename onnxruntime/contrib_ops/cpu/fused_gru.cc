@@ -0,0 +1,111 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "fused_gru.h"
+
+#include "core/providers/cpu/rnn/deep_cpu_gru.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_KERNEL_EX(
+    FusedGru,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    FusedGru);
+
+FusedGru::FusedGru(const OpKernelInfo& info) : OpKernel(info) {
+  int64_t int64_value;
+  ONNXRUNTIME_ENFORCE(info.GetAttr("num_layers", &int64_value).IsOK() && int64_value > 0);
+  num_layers_ = gsl::narrow<int>(int64_value);
+
+  linear_before_reset_ = gsl::narrow<int>(info.GetAttrOrDefault<int64_t>("linear_before_reset", 0));
+}
+
+// UniDirectionalGru takes a TaskThreadPool by reference, so give every
+// FusedGru instance the same process-wide pool instead of spawning one per
+// node; a pool per kernel instance leaves a thread set idle for each fused
+// stack in the model.
+static TaskThreadPool& SharedGruPool() {
+  static TaskThreadPool pool{std::thread::hardware_concurrency()};
+  return pool;
+}
+
+Status FusedGru::Compute(OpKernelContext* context) const {
+  auto& logger = context->Logger();
+
+  const Tensor& X = *context->Input<Tensor>(0);  // [seq_length, batch_size, input_size]
+
+  auto& X_shape = X.Shape();
+  const int seq_length = gsl::narrow<int>(X_shape[0]);
+  const int batch_size = gsl::narrow<int>(X_shape[1]);
+
+  AllocatorPtr alloc;
+  ONNXRUNTIME_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+
+  // GruFusion only fuses GRU nodes using the default activations
+  rnn::detail::ActivationFuncs activation_funcs({"sigmoid", "tanh"}, {}, {});
+
+  const Tensor& last_R = *context->Input<Tensor>(2 + 3 * (num_layers_ - 1));
+  const int last_hidden_size = gsl::narrow<int>(last_R.Shape()[2]);
+
+  TensorShape Y_dims{seq_length, 1, batch_size, last_hidden_size};
+  Tensor* Y = context->Output(/*index*/ 0, Y_dims);
+
+  TensorShape Y_h_dims{1, batch_size, last_hidden_size};
+  Tensor* Y_h = context->Output(/*index*/ 1, Y_h_dims);
+
+  gsl::span<const float> layer_input = X.DataAsSpan<float>();
+  int layer_input_size = gsl::narrow<int>(X_shape[2]);
+
+  // ping-pong buffers for the hidden state sequences of the intermediate
+  // layers. a unidirectional Y is laid out [seq_length, 1, batch_size,
+  // hidden_size], which is exactly the X layout the next layer expects,
+  // so the output of one layer is consumed directly as the next input.
+  IAllocatorUniquePtr<float> layer_output_ptrs[2];
+
+  for (int layer = 0; layer < num_layers_; ++layer) {
+    const Tensor& W = *context->Input<Tensor>(1 + 3 * layer);  // [1, 3*hidden_size, layer_input_size]
+    const Tensor& R = *context->Input<Tensor>(2 + 3 * layer);  // [1, 3*hidden_size, hidden_size]
+    const Tensor& B = *context->Input<Tensor>(3 + 3 * layer);  // [1, 6*hidden_size]
+
+    const int hidden_size = gsl::narrow<int>(R.Shape()[2]);
+    const bool is_last = layer == num_layers_ - 1;
+
+    gsl::span<float> outputs;
+    if (is_last) {
+      outputs = Y != nullptr ? Y->MutableDataAsSpan<float>() : gsl::span<float>();
+    } else {
+      outputs = rnn::detail::Allocate(alloc, seq_length * batch_size * hidden_size,
+                                      layer_output_ptrs[layer % 2]);
+    }
+
+    IAllocatorUniquePtr<float> local_final_hidden;
+    gsl::span<float> final_hidden =
+        is_last && Y_h != nullptr
+            ? Y_h->MutableDataAsSpan<float>()
+            : rnn::detail::Allocate(alloc, batch_size * hidden_size, local_final_hidden);
+
+    detail::UniDirectionalGru<float> gru(alloc, logger,
+                                         seq_length, batch_size, layer_input_size, hidden_size,
+                                         linear_before_reset_ != 0, rnn::detail::Direction::kForward,
+                                         B.DataAsSpan<float>(), gsl::span<const float>(),
+                                         activation_funcs.Entries()[0],
+                                         activation_funcs.Entries()[1],
+                                         std::numeric_limits<float>::max(), SharedGruPool());
+
+    gru.Compute(layer_input, gsl::span<const int>(), /*num_directions*/ 1,
+                W.DataAsSpan<float>(), R.DataAsSpan<float>(),
+                nullptr, nullptr, nullptr, outputs, final_hidden);
+
+    layer_input = outputs;
+    layer_input_size = hidden_size;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,28 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Runs the stack of forward GRU layers recorded by GruFusion as one kernel.
+// Each layer's hidden state sequence feeds the next layer through a
+// cache-resident scratch buffer instead of materializing intermediate
+// tensors in the ExecutionFrame.
+class FusedGru final : public OpKernel {
+ public:
+  FusedGru(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  int num_layers_ = 0;
+  int linear_before_reset_ = 0;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
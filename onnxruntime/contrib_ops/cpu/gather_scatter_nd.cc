@@ -0,0 +1,180 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gather_scatter_nd.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_KERNEL_EX(
+    GatherND,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::AllFixedSizeTensorTypes())
+        .TypeConstraint("Tind", DataTypeImpl::GetTensorType<int64_t>()),
+    GatherND);
+
+ONNX_OPERATOR_KERNEL_EX(
+    ScatterND,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .MayInplace(0, 0)
+        .TypeConstraint("T", DataTypeImpl::AllFixedSizeTensorTypes())
+        .TypeConstraint("Tind", DataTypeImpl::GetTensorType<int64_t>()),
+    ScatterND);
+
+common::Status GatherScatterNDBase::BuildSliceCopyPlan(const TensorShape& data_shape,
+                                                       const Tensor& indices_tensor,
+                                                       size_t element_size,
+                                                       CopyPlan& plan,
+                                                       int64_t& slice_size) {
+  const TensorShape& indices_shape = indices_tensor.Shape();
+  if (indices_shape.NumDimensions() < 1) {
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                                   "indices tensor must have at least one dimension");
+  }
+
+  const int64_t index_depth = indices_shape[indices_shape.NumDimensions() - 1];
+  if (index_depth < 1 || static_cast<size_t>(index_depth) > data_shape.NumDimensions()) {
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                                   "last dimension of indices must be in [1, ", data_shape.NumDimensions(),
+                                   "] but is ", index_depth);
+  }
+
+  // each index tuple selects one contiguous slice of the trailing dimensions.
+  slice_size = 1;
+  for (size_t axis = static_cast<size_t>(index_depth); axis < data_shape.NumDimensions(); ++axis) {
+    slice_size *= data_shape[axis];
+  }
+
+  const int64_t num_slices = indices_shape.Size() / index_depth;
+  const int64_t slice_bytes = slice_size * static_cast<int64_t>(element_size);
+  const auto* indices = indices_tensor.template Data<int64_t>();
+
+  plan.spans.reserve(num_slices);
+
+  for (int64_t slice = 0; slice < num_slices; ++slice) {
+    int64_t flat_index = 0;
+    for (int64_t axis = 0; axis < index_depth; ++axis) {
+      const int64_t dim = data_shape[axis];
+      int64_t index = indices[slice * index_depth + axis];
+      if (index < 0) {
+        index += dim;
+      }
+      if (index < 0 || index >= dim) {
+        return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                                       "index ", indices[slice * index_depth + axis],
+                                       " is out of bounds for axis ", axis, " with size ", dim);
+      }
+      flat_index = flat_index * dim + index;
+    }
+
+    const int64_t data_offset = flat_index * slice_bytes;
+    const int64_t ordered_offset = slice * slice_bytes;
+
+    // extend the previous span when this slice is adjacent to it on both
+    // sides, so runs of consecutive indices replay as one memcpy.
+    if (!plan.spans.empty()) {
+      auto& last = plan.spans.back();
+      if (last.shared_offset + last.bytes == data_offset &&
+          last.tensor_offset + last.bytes == ordered_offset) {
+        last.bytes += slice_bytes;
+        continue;
+      }
+    }
+
+    plan.spans.push_back({0, ordered_offset, data_offset, slice_bytes});
+  }
+
+  plan.total_bytes = num_slices * slice_bytes;
+  return Status::OK();
+}
+
+Status GatherND::Compute(OpKernelContext* context) const {
+  const Tensor* data_tensor = context->Input<Tensor>(0);
+  if (data_tensor == nullptr)
+    return Status(common::ONNXRUNTIME, common::FAIL, "data input of GatherND is missing");
+  const Tensor* indices_tensor = context->Input<Tensor>(1);
+  if (indices_tensor == nullptr)
+    return Status(common::ONNXRUNTIME, common::FAIL, "indices input of GatherND is missing");
+
+  const TensorShape& data_shape = data_tensor->Shape();
+  const size_t element_size = data_tensor->DataType()->Size();
+
+  CopyPlan plan;
+  int64_t slice_size;
+  ONNXRUNTIME_RETURN_IF_ERROR(BuildSliceCopyPlan(data_shape, *indices_tensor, element_size,
+                                                 plan, slice_size));
+
+  // output shape: indices shape without the index tuple dimension, followed
+  // by the data dimensions the tuples do not address.
+  const TensorShape& indices_shape = indices_tensor->Shape();
+  const size_t index_depth = static_cast<size_t>(indices_shape[indices_shape.NumDimensions() - 1]);
+  std::vector<int64_t> output_dims(indices_shape.GetDims().begin(), indices_shape.GetDims().end() - 1);
+  output_dims.insert(output_dims.end(), data_shape.GetDims().begin() + index_depth,
+                     data_shape.GetDims().end());
+
+  Tensor* output_tensor = context->Output(0, TensorShape(output_dims));
+  if (plan.total_bytes == 0)
+    return Status::OK();
+
+  std::vector<uint8_t*> ordered_base{static_cast<uint8_t*>(output_tensor->MutableDataRaw())};
+  ExecuteCopyPlan(plan, false /*shared_is_destination*/,
+                  const_cast<uint8_t*>(static_cast<const uint8_t*>(data_tensor->DataRaw())),
+                  ordered_base);
+  return Status::OK();
+}
+
+Status ScatterND::Compute(OpKernelContext* context) const {
+  const Tensor* data_tensor = context->Input<Tensor>(0);
+  if (data_tensor == nullptr)
+    return Status(common::ONNXRUNTIME, common::FAIL, "data input of ScatterND is missing");
+  const Tensor* indices_tensor = context->Input<Tensor>(1);
+  if (indices_tensor == nullptr)
+    return Status(common::ONNXRUNTIME, common::FAIL, "indices input of ScatterND is missing");
+  const Tensor* updates_tensor = context->Input<Tensor>(2);
+  if (updates_tensor == nullptr)
+    return Status(common::ONNXRUNTIME, common::FAIL, "updates input of ScatterND is missing");
+
+  const TensorShape& data_shape = data_tensor->Shape();
+  const size_t element_size = data_tensor->DataType()->Size();
+
+  CopyPlan plan;
+  int64_t slice_size;
+  ONNXRUNTIME_RETURN_IF_ERROR(BuildSliceCopyPlan(data_shape, *indices_tensor, element_size,
+                                                 plan, slice_size));
+
+  const TensorShape& indices_shape = indices_tensor->Shape();
+  const int64_t num_slices = indices_shape.Size() / indices_shape[indices_shape.NumDimensions() - 1];
+  if (updates_tensor->Shape().Size() != num_slices * slice_size) {
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                                   "updates tensor has ", updates_tensor->Shape().Size(),
+                                   " elements but the indices address ", num_slices * slice_size);
+  }
+
+  Tensor* output_tensor = context->Output(0, data_shape);
+
+  // start from the unmodified data, then overlay the updates. the output may
+  // reuse the data buffer in place, in which case the copy is skipped.
+  const void* data = data_tensor->DataRaw();
+  void* output = output_tensor->MutableDataRaw();
+  if (output != data) {
+    memcpy(output, data, data_shape.Size() * element_size);
+  }
+
+  if (plan.total_bytes == 0)
+    return Status::OK();
+
+  std::vector<uint8_t*> ordered_base{
+      const_cast<uint8_t*>(static_cast<const uint8_t*>(updates_tensor->DataRaw()))};
+  ExecuteCopyPlan(plan, true /*shared_is_destination*/,
+                  static_cast<uint8_t*>(output), ordered_base);
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
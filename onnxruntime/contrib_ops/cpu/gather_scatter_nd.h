@@ -0,0 +1,48 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+#include "core/framework/tensor.h"
+#include "core/providers/cpu/tensor/copy_plan.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Shared index handling for GatherND and ScatterND. The trailing dimension
+// of the indices tensor addresses a slice of the data tensor, and every
+// slice is one contiguous byte span, so both kernels reduce to a CopyPlan
+// between the data-shaped buffer (the plan's shared buffer) and the
+// indices-ordered buffer (the plan's tensor buffer 0): GatherND replays the
+// plan out of the data, ScatterND replays it into a copy of the data.
+class GatherScatterNDBase {
+ protected:
+  // Builds the span list for the given indices, folding each index tuple
+  // into a flat slice offset and coalescing runs of adjacent slices into one
+  // span. Negative indices count from the end of the dimension; out of range
+  // indices fail with INVALID_ARGUMENT.
+  static common::Status BuildSliceCopyPlan(const TensorShape& data_shape,
+                                           const Tensor& indices_tensor,
+                                           size_t element_size,
+                                           CopyPlan& plan,
+                                           int64_t& slice_size);
+};
+
+class GatherND final : public OpKernel, protected GatherScatterNDBase {
+ public:
+  explicit GatherND(const OpKernelInfo& info) : OpKernel(info) {}
+
+  Status Compute(OpKernelContext* context) const override;
+};
+
+class ScatterND final : public OpKernel, protected GatherScatterNDBase {
+ public:
+  explicit ScatterND(const OpKernelInfo& info) : OpKernel(info) {}
+
+  Status Compute(OpKernelContext* context) const override;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
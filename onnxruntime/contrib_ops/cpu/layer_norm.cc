@@ -0,0 +1,88 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/layer_norm.h"
+
+#include <cmath>
+
+#include "core/util/math_cpuonly.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_KERNEL_EX(
+    LayerNormalization,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    LayerNorm);
+
+namespace {
+void NormalizeRows(const float* input, const float* scale, const float* bias,
+                   float* output, int64_t first, int64_t last, int64_t row_size,
+                   float epsilon) {
+  for (int64_t row = first; row < last; ++row) {
+    ConstEigenVectorArrayMap<float> x(input + row * row_size, row_size);
+    EigenVectorArrayMap<float> y(output + row * row_size, row_size);
+
+    // both moments from one read of the cache-hot row: var = E[x^2] - mean^2,
+    // clamped so rounding on near-constant rows cannot go negative
+    const float mean = x.mean();
+    const float variance = std::max(x.square().mean() - mean * mean, 0.0f);
+    const float inv_std = 1.0f / std::sqrt(variance + epsilon);
+
+    ConstEigenVectorArrayMap<float> scale_arr(scale, row_size);
+    if (bias != nullptr) {
+      ConstEigenVectorArrayMap<float> bias_arr(bias, row_size);
+      y = (x - mean) * inv_std * scale_arr + bias_arr;
+    } else {
+      y = (x - mean) * inv_std * scale_arr;
+    }
+  }
+}
+}  // namespace
+
+Status LayerNorm::Compute(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(0);
+  const Tensor* scale_tensor = context->Input<Tensor>(1);
+  const bool has_bias = OpKernel::Node().InputDefs().size() == 3;
+  const Tensor* bias_tensor = has_bias ? context->Input<Tensor>(2) : nullptr;
+
+  const TensorShape& shape = X->Shape();
+  const int64_t rank = static_cast<int64_t>(shape.NumDimensions());
+  const int64_t axis = axis_ < 0 ? axis_ + rank : axis_;
+  if (axis < 0 || axis >= rank) {
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                                   "axis ", axis_, " is out of range for rank ", rank);
+  }
+
+  const int64_t rows = shape.SizeToDimension(axis);
+  const int64_t row_size = shape.SizeFromDimension(axis);
+  if (scale_tensor->Shape().Size() != row_size ||
+      (bias_tensor != nullptr && bias_tensor->Shape().Size() != row_size)) {
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                                   "scale and bias must match the normalized span of ", row_size, " elements");
+  }
+
+  Tensor* Y = context->Output(0, shape);
+  const float* input = X->template Data<float>();
+  const float* scale = scale_tensor->template Data<float>();
+  const float* bias = bias_tensor != nullptr ? bias_tensor->template Data<float>() : nullptr;
+  float* output = Y->template MutableData<float>();
+
+  if (shape.Size() == 0) {
+    return Status::OK();
+  }
+
+  const float epsilon = epsilon_;
+  context->ParallelFor(0, rows, static_cast<double>(row_size),
+                       [input, scale, bias, output, row_size, epsilon](int64_t first, int64_t last) {
+                         NormalizeRows(input, scale, bias, output, first, last, row_size, epsilon);
+                       });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,31 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Fused layer normalization: per-row mean, variance, scale and bias in one
+// kernel, replacing the ReduceMean/Sub/Pow/ReduceMean/Add/Sqrt/Div/Mul/Add
+// cluster transformer models emit (see LayerNormFusion). Rows normalize
+// independently, so large inputs split across the task pool.
+class LayerNorm final : public OpKernel {
+ public:
+  explicit LayerNorm(const OpKernelInfo& info) : OpKernel(info) {
+    axis_ = info.GetAttrOrDefault<int64_t>("axis", -1);
+    epsilon_ = info.GetAttrOrDefault<float>("epsilon", 1e-5f);
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  int64_t axis_;
+  float epsilon_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
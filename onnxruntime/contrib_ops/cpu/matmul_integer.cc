@@ -0,0 +1,65 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/matmul_integer.h"
+
+#include "core/mlas/inc/mlas.h"
+#include "core/providers/cpu/math/matmul_helper.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    MatMulInteger,
+    1,
+    uint8_t,
+    KernelDefBuilder()
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<uint8_t>())
+        .TypeConstraint("T2", DataTypeImpl::GetTensorType<uint8_t>())
+        .TypeConstraint("T3", DataTypeImpl::GetTensorType<uint32_t>()),
+    MatMulInteger<uint8_t, uint8_t>);
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    MatMulInteger,
+    1,
+    int8_t,
+    KernelDefBuilder()
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<uint8_t>())
+        .TypeConstraint("T2", DataTypeImpl::GetTensorType<int8_t>())
+        .TypeConstraint("T3", DataTypeImpl::GetTensorType<int32_t>()),
+    MatMulInteger<uint8_t, int8_t>);
+
+template <typename TA, typename TB>
+Status MatMulInteger<TA, TB>::Compute(OpKernelContext* ctx) const {
+  // the output is unsigned only when both inputs are unsigned
+  using TY = typename std::conditional<std::is_signed<TB>::value, int32_t, uint32_t>::type;
+
+  const Tensor* a = ctx->Input<Tensor>(0);
+  const Tensor* b = ctx->Input<Tensor>(1);
+
+  MatMulComputeHelper helper;
+  ONNXRUNTIME_RETURN_IF_ERROR(helper.Compute(a->Shape(), b->Shape()));
+
+  Tensor* y = ctx->Output(0, helper.OutputShape());
+
+  for (int i = 0; i < helper.OutputOffsets().size(); i++) {
+    MlasQgemm(
+        static_cast<size_t>(helper.M()),
+        static_cast<size_t>(helper.N()),
+        static_cast<size_t>(helper.K()),
+        reinterpret_cast<const uint8_t*>(a->template Data<TA>()) + helper.LeftOffsets()[i],
+        static_cast<size_t>(helper.K()),
+        /* offa */ 0,
+        reinterpret_cast<const uint8_t*>(b->template Data<TB>()) + helper.RightOffsets()[i],
+        static_cast<size_t>(helper.N()),
+        /* offb */ 0,
+        std::is_signed<TB>::value,
+        reinterpret_cast<int32_t*>(y->template MutableData<TY>()) + helper.OutputOffsets()[i],
+        static_cast<size_t>(helper.N()));
+  }
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
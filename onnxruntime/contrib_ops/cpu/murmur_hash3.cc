@@ -7,6 +7,8 @@
 
 #include "contrib_ops/cpu/murmur_hash3.h"
 
+#include <utility>
+
 // Platform-specific functions and macros
 
 // Microsoft Visual Studio
@@ -90,6 +92,71 @@ FORCE_INLINE uint64_t fmix(uint64_t k) {
   return k;
 }
 
+namespace {
+
+constexpr int kHashLanes = 4;
+
+// Hashes kHashLanes equal-length keys in interleaved lanes. Each lane carries
+// an independent h state, so the multiply/rotate chains of the four hashes
+// overlap in the pipeline (and vectorize where the compiler finds it
+// profitable) instead of serializing on one hash's loop-carried latency.
+// Produces bit-identical output to MurmurHash3_x86_32 per lane.
+FORCE_INLINE void MurmurHash3_x86_32_Lanes(const uint8_t* const keys[kHashLanes], int len,
+                                           uint32_t seed, uint32_t out[kHashLanes]) {
+  const int nblocks = len / 4;
+  const uint32_t c1 = 0xcc9e2d51;
+  const uint32_t c2 = 0x1b873593;
+
+  uint32_t h[kHashLanes] = {seed, seed, seed, seed};
+
+  //----------
+  // body
+  for (int i = 0; i < nblocks; i++) {
+    for (int lane = 0; lane < kHashLanes; ++lane) {
+      uint32_t k = getblock(reinterpret_cast<const uint32_t*>(keys[lane]), i);
+
+      k *= c1;
+      k = ROTL32(k, 15);
+      k *= c2;
+
+      h[lane] ^= k;
+      h[lane] = ROTL32(h[lane], 13);
+      h[lane] = h[lane] * 5 + 0xe6546b64;
+    }
+  }
+
+  //----------
+  // tail
+  if ((len & 3) != 0) {
+    for (int lane = 0; lane < kHashLanes; ++lane) {
+      const uint8_t* tail = keys[lane] + static_cast<int64_t>(nblocks) * 4;
+
+      uint32_t k = 0;
+
+      switch (len & 3) {
+        case 3:
+          k ^= tail[2] << 16;
+        case 2:
+          k ^= tail[1] << 8;
+        case 1:
+          k ^= tail[0];
+          k *= c1;
+          k = ROTL32(k, 15);
+          k *= c2;
+          h[lane] ^= k;
+      };
+    }
+  }
+
+  //----------
+  // finalization
+  for (int lane = 0; lane < kHashLanes; ++lane) {
+    h[lane] ^= len;
+    out[lane] = fmix(h[lane]);
+  }
+}
+
+}  // namespace
 
 namespace onnxruntime {
 namespace contrib {
@@ -159,6 +226,61 @@ void MurmurHash3::MurmurHash3_x86_32(const void* key, int len, uint32_t seed, vo
   *(uint32_t*)out = h1;
 }
 
+void MurmurHash3::HashFixedWidthRange(const uint8_t* input, int element_bytes, uint32_t* output,
+                                      int64_t first, int64_t last) const {
+  int64_t i = first;
+  for (; i + kHashLanes <= last; i += kHashLanes) {
+    const uint8_t* key_ptrs[kHashLanes];
+    for (int lane = 0; lane < kHashLanes; ++lane) {
+      key_ptrs[lane] = input + (i + lane) * element_bytes;
+    }
+    MurmurHash3_x86_32_Lanes(key_ptrs, element_bytes, seed_, output + i);
+  }
+  for (; i < last; ++i) {
+    MurmurHash3_x86_32(input + i * element_bytes, element_bytes, seed_, output + i);
+  }
+}
+
+void MurmurHash3::HashStringRange(const std::string* strings, uint32_t* output,
+                                  int64_t first, int64_t last) const {
+  // order the range by key length so equal-length keys land in the same
+  // interleaved batch; the lanes require a common length because they share
+  // one block/tail loop
+  std::vector<std::pair<uint32_t, int64_t>> by_length;
+  by_length.reserve(static_cast<size_t>(last - first));
+  for (int64_t i = first; i < last; ++i) {
+    by_length.emplace_back(static_cast<uint32_t>(strings[i].length()), i);
+  }
+  std::sort(by_length.begin(), by_length.end());
+
+  size_t pos = 0;
+  const size_t count = by_length.size();
+  while (pos < count) {
+    const uint32_t len = by_length[pos].first;
+    size_t run_end = pos;
+    while (run_end < count && by_length[run_end].first == len) {
+      ++run_end;
+    }
+
+    for (; pos + kHashLanes <= run_end; pos += kHashLanes) {
+      const uint8_t* key_ptrs[kHashLanes];
+      uint32_t hashes[kHashLanes];
+      for (int lane = 0; lane < kHashLanes; ++lane) {
+        key_ptrs[lane] = reinterpret_cast<const uint8_t*>(strings[by_length[pos + lane].second].c_str());
+      }
+      MurmurHash3_x86_32_Lanes(key_ptrs, static_cast<int>(len), seed_, hashes);
+      for (int lane = 0; lane < kHashLanes; ++lane) {
+        output[by_length[pos + lane].second] = hashes[lane];
+      }
+    }
+    for (; pos < run_end; ++pos) {
+      const std::string& key = strings[by_length[pos].second];
+      MurmurHash3_x86_32(key.c_str(), static_cast<int>(key.length()), seed_,
+                         output + by_length[pos].second);
+    }
+  }
+}
+
 Status MurmurHash3::Compute(OpKernelContext* ctx) const {
   const Tensor* keys = ctx->Input<Tensor>(0);
   ONNXRUNTIME_ENFORCE(keys);
@@ -167,34 +289,35 @@ Status MurmurHash3::Compute(OpKernelContext* ctx) const {
   Tensor* output_tensor = ctx->Output(0, input_shape);
 
   const MLDataType keys_type = keys->DataType();
-  const int input_element_bytes = static_cast<int>(keys->DataType()->Size());
-  const int output_element_bytes = static_cast<int>(output_tensor->DataType()->Size());
+  const bool is_string = DataTypeImpl::GetType<std::string>() == keys_type;
+  const int input_element_bytes = static_cast<int>(keys_type->Size());
   const int64_t input_count = input_shape.Size();
-  for (int i = 0; i < input_count; ++i) {
-    if (DataTypeImpl::GetType<std::string>() == keys_type) {
-      auto input = keys->DataRaw();
-      auto output = output_tensor->MutableDataRaw();
-      auto input_string = reinterpret_cast<const std::string*>(input)[i];
-      MurmurHash3_x86_32(input_string.c_str(),
-                         static_cast<int>(input_string.length()),
-                         seed_,
-                         reinterpret_cast<uint32_t*>(output) + static_cast<int64_t>(i) * output_element_bytes);
-    } else {
-      auto output_type = output_tensor->DataType();
-      if ((DataTypeImpl::GetType<int32_t>() == keys_type || DataTypeImpl::GetType<uint32_t>() == keys_type) &&
-          (DataTypeImpl::GetType<int32_t>() == output_type || DataTypeImpl::GetType<uint32_t>() == output_type)) {
-        auto input = keys->DataRaw();
-        auto output = output_tensor->MutableDataRaw();
-        MurmurHash3_x86_32(reinterpret_cast<const uint8_t*>(input) + static_cast<int64_t>(i) * input_element_bytes,
-                           input_element_bytes,
-                           seed_,
-                           reinterpret_cast<uint8_t*>(output) + static_cast<int64_t>(i) * output_element_bytes);
-      } else {
-        return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "Type not supported.");
-      }
+  if (input_count == 0) {
+    return Status::OK();
+  }
+
+  if (!is_string) {
+    const MLDataType output_type = output_tensor->DataType();
+    if (!((DataTypeImpl::GetType<int32_t>() == keys_type || DataTypeImpl::GetType<uint32_t>() == keys_type) &&
+          (DataTypeImpl::GetType<int32_t>() == output_type || DataTypeImpl::GetType<uint32_t>() == output_type))) {
+      return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "Type not supported.");
     }
   }
 
+  auto* output = reinterpret_cast<uint32_t*>(output_tensor->MutableDataRaw());
+  auto hash_range = [this, keys, output, is_string, input_element_bytes](int64_t first, int64_t last) {
+    if (is_string) {
+      HashStringRange(keys->template Data<std::string>(), output, first, last);
+    } else {
+      HashFixedWidthRange(reinterpret_cast<const uint8_t*>(keys->DataRaw()), input_element_bytes,
+                          output, first, last);
+    }
+  };
+
+  // the keys are independent, so split the range across the shared pool once
+  // the tensor is large enough to cover the dispatch overhead
+  ctx->ParallelFor(0, input_count, static_cast<double>(input_element_bytes), hash_range);
+
   return Status::OK();
 }
 
@@ -17,10 +17,19 @@ class MurmurHash3 final : public OpKernel {
 
   Status Compute(OpKernelContext* context) const override;
 
-private:
+ private:
   void MurmurHash3_x86_32(const void* key, int len, uint32_t seed, void* out) const;
 
-private :
+  // hashes keys [first, last) of a fixed-width key tensor, four keys in
+  // interleaved lanes at a time
+  void HashFixedWidthRange(const uint8_t* input, int element_bytes, uint32_t* output,
+                           int64_t first, int64_t last) const;
+
+  // hashes string keys [first, last), bucketing the range by key length so
+  // equal-length keys batch into the interleaved lanes
+  void HashStringRange(const std::string* strings, uint32_t* output,
+                       int64_t first, int64_t last) const;
+
   uint32_t seed_;
 };
 }  // namespace contrib
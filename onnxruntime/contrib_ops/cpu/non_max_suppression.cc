@@ -2,11 +2,179 @@
 // Licensed under the MIT License.
 
 #include "contrib_ops/cpu/non_max_suppression.h"
-#include <queue>
+#include <algorithm>
+#include <memory>
+#include <vector>
 
 namespace onnxruntime {
 namespace contrib {
 
+namespace {
+
+// IoU tests run in blocks of this many boxes; the block body is branch free
+// so the compiler can vectorize it.
+constexpr size_t kIouBatchSize = 8;
+
+// Below this many scored candidates the simple pairwise loop wins; above
+// kGridPruneCandidates a uniform grid additionally prunes comparisons against
+// selected boxes in distant cells.
+constexpr int64_t kBatchedIouCandidates = 64;
+constexpr int64_t kGridPruneCandidates = 4096;
+constexpr int32_t kGridDim = 16;
+
+// Selected boxes kept structure-of-arrays with canonical corners and
+// precomputed areas, so a batch of IoU tests reads contiguous lanes.
+template <typename T>
+struct SelectedBoxes {
+  std::vector<T> x_min, y_min, x_max, y_max, area;
+
+  size_t Size() const { return x_min.size(); }
+
+  void Add(T box_x_min, T box_y_min, T box_x_max, T box_y_max) {
+    x_min.push_back(box_x_min);
+    y_min.push_back(box_y_min);
+    x_max.push_back(box_x_max);
+    y_max.push_back(box_y_max);
+    area.push_back((box_x_max - box_x_min) * (box_y_max - box_y_min));
+  }
+};
+
+// Whether the candidate box overlaps lane <lane> beyond <iou_threshold>.
+// IoU > threshold is tested as intersection > threshold * union; when the
+// intersection is positive both areas are positive, so the union is too and
+// the forms are equivalent without the division.
+template <typename T>
+inline T IouExceedsThreshold(const SelectedBoxes<T>& selected, size_t lane,
+                             T c_x_min, T c_y_min, T c_x_max, T c_y_max, T c_area,
+                             T iou_threshold) {
+  const T inter_x_min = std::max(c_x_min, selected.x_min[lane]);
+  const T inter_y_min = std::max(c_y_min, selected.y_min[lane]);
+  const T inter_x_max = std::min(c_x_max, selected.x_max[lane]);
+  const T inter_y_max = std::min(c_y_max, selected.y_max[lane]);
+  const T inter_w = std::max(inter_x_max - inter_x_min, static_cast<T>(0));
+  const T inter_h = std::max(inter_y_max - inter_y_min, static_cast<T>(0));
+  const T intersection = inter_w * inter_h;
+  const T union_area = c_area + selected.area[lane] - intersection;
+  return intersection > iou_threshold * union_area ? static_cast<T>(1) : static_cast<T>(0);
+}
+
+// Any-overlap test against all selected boxes, kIouBatchSize lanes at a time.
+template <typename T>
+bool SuppressedByAny(const SelectedBoxes<T>& selected,
+                     T c_x_min, T c_y_min, T c_x_max, T c_y_max, T c_area,
+                     T iou_threshold) {
+  const size_t count = selected.Size();
+  size_t i = 0;
+  for (; i + kIouBatchSize <= count; i += kIouBatchSize) {
+    T hits = 0;
+    for (size_t lane = 0; lane < kIouBatchSize; ++lane) {
+      hits += IouExceedsThreshold(selected, i + lane,
+                                  c_x_min, c_y_min, c_x_max, c_y_max, c_area, iou_threshold);
+    }
+    if (hits > 0) {
+      return true;
+    }
+  }
+  for (; i < count; ++i) {
+    if (IouExceedsThreshold(selected, i,
+                            c_x_min, c_y_min, c_x_max, c_y_max, c_area, iou_threshold) > 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Same test restricted to the lanes named in <lanes>; used by the grid path
+// where the candidate is only compared against nearby selected boxes.
+template <typename T>
+bool SuppressedByAnyOf(const SelectedBoxes<T>& selected, const std::vector<int32_t>& lanes,
+                       T c_x_min, T c_y_min, T c_x_max, T c_y_max, T c_area,
+                       T iou_threshold) {
+  const size_t count = lanes.size();
+  size_t i = 0;
+  for (; i + kIouBatchSize <= count; i += kIouBatchSize) {
+    T hits = 0;
+    for (size_t lane = 0; lane < kIouBatchSize; ++lane) {
+      hits += IouExceedsThreshold(selected, static_cast<size_t>(lanes[i + lane]),
+                                  c_x_min, c_y_min, c_x_max, c_y_max, c_area, iou_threshold);
+    }
+    if (hits > 0) {
+      return true;
+    }
+  }
+  for (; i < count; ++i) {
+    if (IouExceedsThreshold(selected, static_cast<size_t>(lanes[i]),
+                            c_x_min, c_y_min, c_x_max, c_y_max, c_area, iou_threshold) > 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Uniform kGridDim x kGridDim grid over the extent of the scored candidates.
+// Each selected box is registered in every cell it overlaps, so a candidate
+// only has to test the cells its own footprint covers; boxes in distant
+// cells are never compared.
+template <typename T>
+class SuppressionGrid {
+ public:
+  SuppressionGrid(T extent_x_min, T extent_y_min, T extent_x_max, T extent_y_max)
+      : origin_x_(extent_x_min),
+        origin_y_(extent_y_min),
+        cells_(static_cast<size_t>(kGridDim) * kGridDim) {
+    const T width = extent_x_max - extent_x_min;
+    const T height = extent_y_max - extent_y_min;
+    inv_cell_w_ = width > 0 ? kGridDim / width : static_cast<T>(0);
+    inv_cell_h_ = height > 0 ? kGridDim / height : static_cast<T>(0);
+  }
+
+  void CellRange(T box_x_min, T box_y_min, T box_x_max, T box_y_max,
+                 int32_t& col_begin, int32_t& col_end, int32_t& row_begin, int32_t& row_end) const {
+    col_begin = CellIndex((box_x_min - origin_x_) * inv_cell_w_);
+    col_end = CellIndex((box_x_max - origin_x_) * inv_cell_w_);
+    row_begin = CellIndex((box_y_min - origin_y_) * inv_cell_h_);
+    row_end = CellIndex((box_y_max - origin_y_) * inv_cell_h_);
+  }
+
+  void Add(int32_t lane, int32_t col_begin, int32_t col_end, int32_t row_begin, int32_t row_end) {
+    for (int32_t row = row_begin; row <= row_end; ++row) {
+      for (int32_t col = col_begin; col <= col_end; ++col) {
+        cells_[static_cast<size_t>(row) * kGridDim + col].push_back(lane);
+      }
+    }
+  }
+
+  // Gathers the lanes registered in the covered cells. A box spanning several
+  // cells appears once per cell; duplicates only cost a redundant IoU test,
+  // never a wrong answer, so they are not filtered out.
+  void Gather(int32_t col_begin, int32_t col_end, int32_t row_begin, int32_t row_end,
+              std::vector<int32_t>& lanes) const {
+    lanes.clear();
+    for (int32_t row = row_begin; row <= row_end; ++row) {
+      for (int32_t col = col_begin; col <= col_end; ++col) {
+        const auto& cell = cells_[static_cast<size_t>(row) * kGridDim + col];
+        lanes.insert(lanes.end(), cell.begin(), cell.end());
+      }
+    }
+  }
+
+ private:
+  static int32_t CellIndex(T scaled) {
+    if (!(scaled > 0)) {
+      return 0;
+    }
+    return std::min(static_cast<int32_t>(scaled), kGridDim - 1);
+  }
+
+  T origin_x_;
+  T origin_y_;
+  T inv_cell_w_;
+  T inv_cell_h_;
+  std::vector<std::vector<int32_t>> cells_;
+};
+
+}  // namespace
+
 ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
     NonMaxSuppression,
     1,
@@ -92,39 +260,115 @@ Status NonMaxSuppression<T>::Compute(OpKernelContext* ctx) const {
     int32_t index;
   };
 
-  auto LessCompare = [](const ScoreIndexPair& lhs, const ScoreIndexPair& rhs) {
-    return lhs.score < rhs.score;
-  };
-
-  // Filter by score_threshold_
-  std::priority_queue<ScoreIndexPair, std::deque<ScoreIndexPair>, decltype(LessCompare)> sorted_scores_with_index(LessCompare);
+  // Filter by score_threshold_ and sort descending once; walking the sorted
+  // list exits as soon as max_output_size_ boxes are selected without the
+  // per-pop overhead of a priority queue.
+  std::vector<ScoreIndexPair> sorted_scores_with_index;
+  sorted_scores_with_index.reserve(static_cast<size_t>(num_boxes));
   for (int32_t i = 0; i < num_boxes; ++i) {
     if (static_cast<float>(scores_data[i]) > score_threshold_) {
-      sorted_scores_with_index.emplace(ScoreIndexPair({scores_data[i], i}));
+      sorted_scores_with_index.push_back(ScoreIndexPair{scores_data[i], i});
     }
   }
+  std::sort(sorted_scores_with_index.begin(), sorted_scores_with_index.end(),
+            [](const ScoreIndexPair& lhs, const ScoreIndexPair& rhs) {
+              return lhs.score > rhs.score || (lhs.score == rhs.score && lhs.index < rhs.index);
+            });
+
+  const int64_t num_candidates = static_cast<int64_t>(sorted_scores_with_index.size());
 
   int num_of_selected = 0;
   std::vector<int32_t> selected_index(max_output_size_, 0);
-  ScoreIndexPair next_top_score;
-
-  // Get the next box with top score, filter by iou_threshold_
-  while (num_of_selected < max_output_size_ && !sorted_scores_with_index.empty()) {
-    next_top_score = sorted_scores_with_index.top();
-    sorted_scores_with_index.pop();
-
-    bool selected = true;
-    // Check with existing boxes, suppress if exceed the IOU (Intersection Over Union) threshold
-    for (int i = num_of_selected - 1; i >= 0; --i) {
-      if (SuppressByIOU(boxes_data, selected_index[i], next_top_score.index)) {
-        selected = false;
+
+  if (num_candidates < kBatchedIouCandidates) {
+    // Small candidate sets: the plain pairwise loop.
+    for (const auto& candidate : sorted_scores_with_index) {
+      if (num_of_selected >= max_output_size_) {
         break;
       }
+
+      bool selected = true;
+      // Check with existing boxes, suppress if exceed the IOU (Intersection Over Union) threshold
+      for (int i = num_of_selected - 1; i >= 0; --i) {
+        if (SuppressByIOU(boxes_data, selected_index[i], candidate.index)) {
+          selected = false;
+          break;
+        }
+      }
+
+      if (selected) {
+        selected_index[num_of_selected] = candidate.index;
+        ++num_of_selected;
+      }
+    }
+  } else {
+    // Large candidate sets: selected boxes are kept structure-of-arrays and
+    // tested in batches; very large sets additionally bucket the selected
+    // boxes into a grid so distant boxes are never compared at all.
+    SelectedBoxes<T> selected_boxes;
+    selected_boxes.x_min.reserve(static_cast<size_t>(max_output_size_));
+    selected_boxes.y_min.reserve(static_cast<size_t>(max_output_size_));
+    selected_boxes.x_max.reserve(static_cast<size_t>(max_output_size_));
+    selected_boxes.y_max.reserve(static_cast<size_t>(max_output_size_));
+    selected_boxes.area.reserve(static_cast<size_t>(max_output_size_));
+
+    const bool use_grid = num_candidates >= kGridPruneCandidates;
+    std::unique_ptr<SuppressionGrid<T>> grid;
+    std::vector<int32_t> nearby_lanes;
+    if (use_grid) {
+      T extent_x_min = 0, extent_y_min = 0, extent_x_max = 0, extent_y_max = 0;
+      bool first = true;
+      for (const auto& candidate : sorted_scores_with_index) {
+        T c_x_min, c_y_min, c_x_max, c_y_max;
+        MaxMin(boxes_data[4 * candidate.index + 1], boxes_data[4 * candidate.index + 3], c_x_min, c_x_max);
+        MaxMin(boxes_data[4 * candidate.index + 0], boxes_data[4 * candidate.index + 2], c_y_min, c_y_max);
+        if (first) {
+          extent_x_min = c_x_min;
+          extent_y_min = c_y_min;
+          extent_x_max = c_x_max;
+          extent_y_max = c_y_max;
+          first = false;
+        } else {
+          extent_x_min = std::min(extent_x_min, c_x_min);
+          extent_y_min = std::min(extent_y_min, c_y_min);
+          extent_x_max = std::max(extent_x_max, c_x_max);
+          extent_y_max = std::max(extent_y_max, c_y_max);
+        }
+      }
+      grid = std::make_unique<SuppressionGrid<T>>(extent_x_min, extent_y_min, extent_x_max, extent_y_max);
     }
 
-    if (selected) {
-      selected_index[num_of_selected] = next_top_score.index;
-      ++num_of_selected;
+    for (const auto& candidate : sorted_scores_with_index) {
+      if (num_of_selected >= max_output_size_) {
+        break;
+      }
+
+      T c_x_min, c_y_min, c_x_max, c_y_max;
+      MaxMin(boxes_data[4 * candidate.index + 1], boxes_data[4 * candidate.index + 3], c_x_min, c_x_max);
+      MaxMin(boxes_data[4 * candidate.index + 0], boxes_data[4 * candidate.index + 2], c_y_min, c_y_max);
+      const T c_area = (c_x_max - c_x_min) * (c_y_max - c_y_min);
+      const T iou_threshold = static_cast<T>(iou_threshold_);
+
+      bool suppressed;
+      int32_t col_begin, col_end, row_begin, row_end;
+      if (use_grid) {
+        grid->CellRange(c_x_min, c_y_min, c_x_max, c_y_max, col_begin, col_end, row_begin, row_end);
+        grid->Gather(col_begin, col_end, row_begin, row_end, nearby_lanes);
+        suppressed = SuppressedByAnyOf(selected_boxes, nearby_lanes,
+                                       c_x_min, c_y_min, c_x_max, c_y_max, c_area, iou_threshold);
+      } else {
+        suppressed = SuppressedByAny(selected_boxes,
+                                     c_x_min, c_y_min, c_x_max, c_y_max, c_area, iou_threshold);
+      }
+
+      if (!suppressed) {
+        if (use_grid) {
+          grid->Add(static_cast<int32_t>(selected_boxes.Size()), col_begin, col_end, row_begin, row_end);
+        }
+        selected_boxes.Add(c_x_min, c_y_min, c_x_max, c_y_max);
+        selected_index[num_of_selected] = candidate.index;
+        ++num_of_selected;
+      }
     }
   }
 
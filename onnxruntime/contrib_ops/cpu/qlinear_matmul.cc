@@ -0,0 +1,131 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/qlinear_matmul.h"
+
+#include <cmath>
+
+#include "core/mlas/inc/mlas.h"
+#include "core/providers/cpu/math/matmul_helper.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    QLinearMatMul,
+    1,
+    uint8_t,
+    KernelDefBuilder()
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<uint8_t>())
+        .TypeConstraint("T2", DataTypeImpl::GetTensorType<uint8_t>())
+        .TypeConstraint("T3", DataTypeImpl::GetTensorType<uint8_t>()),
+    QLinearMatMul<uint8_t, uint8_t>);
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    QLinearMatMul,
+    1,
+    int8_t,
+    KernelDefBuilder()
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<uint8_t>())
+        .TypeConstraint("T2", DataTypeImpl::GetTensorType<int8_t>())
+        .TypeConstraint("T3", DataTypeImpl::GetTensorType<uint8_t>()),
+    QLinearMatMul<uint8_t, int8_t>);
+
+namespace {
+// clamp doesn't exist in the version of <algorithm> that we're using, so
+// make a local one.
+float clamp(float v, float lo, float hi) {
+  if (v < lo) return lo;
+  if (v > hi) return hi;
+  return v;
+}
+
+bool IsScalarOr1ElementVector(const Tensor& t) {
+  return t.Shape().NumDimensions() <= 1 && t.Shape().Size() == 1;
+}
+}  // namespace
+
+template <typename TA, typename TB>
+Status QLinearMatMul<TA, TB>::Compute(OpKernelContext* ctx) const {
+  const Tensor* a = ctx->Input<Tensor>(0);
+  const Tensor* a_scale = ctx->Input<Tensor>(1);
+  const Tensor* a_zero_point = ctx->Input<Tensor>(2);
+  const Tensor* b = ctx->Input<Tensor>(3);
+  const Tensor* b_scale = ctx->Input<Tensor>(4);
+  const Tensor* b_zero_point = ctx->Input<Tensor>(5);
+  const Tensor* y_scale = ctx->Input<Tensor>(6);
+  const Tensor* y_zero_point = ctx->Input<Tensor>(7);
+
+  MatMulComputeHelper helper;
+  ONNXRUNTIME_RETURN_IF_ERROR(helper.Compute(a->Shape(), b->Shape()));
+
+  const int64_t N = helper.N();
+
+  ONNXRUNTIME_ENFORCE(IsScalarOr1ElementVector(*a_scale),
+                      "QLinearMatMul : input a_scale must be a scalar or 1D tensor of size 1");
+  ONNXRUNTIME_ENFORCE(IsScalarOr1ElementVector(*a_zero_point),
+                      "QLinearMatMul : input a_zero_point must be a scalar or 1D tensor of size 1");
+  ONNXRUNTIME_ENFORCE(IsScalarOr1ElementVector(*b_zero_point),
+                      "QLinearMatMul : input b_zero_point must be a scalar or 1D tensor of size 1");
+  ONNXRUNTIME_ENFORCE(IsScalarOr1ElementVector(*y_scale),
+                      "QLinearMatMul : input y_scale must be a scalar or 1D tensor of size 1");
+  ONNXRUNTIME_ENFORCE(IsScalarOr1ElementVector(*y_zero_point),
+                      "QLinearMatMul : input y_zero_point must be a scalar or 1D tensor of size 1");
+
+  // the scale of b may be given per column of b for per-channel quantized
+  // weights, in which case the output is requantized with a per-column
+  // multiplier.
+  const bool per_column_scale = !IsScalarOr1ElementVector(*b_scale);
+
+  if (per_column_scale) {
+    ONNXRUNTIME_ENFORCE(b_scale->Shape().NumDimensions() == 1 && b_scale->Shape().Size() == N,
+                        "QLinearMatMul : input b_scale must be a scalar or 1D tensor of size ", N);
+  }
+
+  Tensor* y = ctx->Output(0, helper.OutputShape());
+
+  const float a_scale_value = *a_scale->template Data<float>();
+  const float* b_scale_data = b_scale->template Data<float>();
+  const float y_scale_value = *y_scale->template Data<float>();
+  const uint8_t a_zero_point_value = *a_zero_point->template Data<uint8_t>();
+  const uint8_t b_zero_point_value = static_cast<uint8_t>(*b_zero_point->template Data<TB>());
+  const float y_zero_point_value = *y_zero_point->template Data<uint8_t>();
+
+  // accumulate the de-offset products into a temporary 32-bit buffer for one
+  // matrix, then requantize into the output.
+  AllocatorPtr alloc;
+  ONNXRUNTIME_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&alloc));
+  auto accumulator = IAllocator::MakeUniquePtr<int32_t>(alloc, helper.M() * N);
+
+  for (int i = 0; i < helper.OutputOffsets().size(); i++) {
+    MlasQgemm(
+        static_cast<size_t>(helper.M()),
+        static_cast<size_t>(N),
+        static_cast<size_t>(helper.K()),
+        reinterpret_cast<const uint8_t*>(a->template Data<TA>()) + helper.LeftOffsets()[i],
+        static_cast<size_t>(helper.K()),
+        a_zero_point_value,
+        reinterpret_cast<const uint8_t*>(b->template Data<TB>()) + helper.RightOffsets()[i],
+        static_cast<size_t>(N),
+        b_zero_point_value,
+        std::is_signed<TB>::value,
+        accumulator.get(),
+        static_cast<size_t>(N));
+
+    const int32_t* input = accumulator.get();
+    uint8_t* output = y->template MutableData<uint8_t>() + helper.OutputOffsets()[i];
+
+    for (int64_t m = 0; m < helper.M(); m++) {
+      for (int64_t n = 0; n < N; n++) {
+        const float multiplier = a_scale_value * b_scale_data[per_column_scale ? n : 0] / y_scale_value;
+        *output++ = static_cast<uint8_t>(clamp(
+            std::round(static_cast<float>(*input++) * multiplier) + y_zero_point_value, 0.0f, float(UINT8_MAX)));
+      }
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
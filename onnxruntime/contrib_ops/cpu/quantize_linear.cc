@@ -75,9 +75,13 @@ Status DequantizeLinear<T>::Compute(OpKernelContext* ctx) const {
       auto zp = static_cast<const int>(*current_zero_point);
       auto sc = *current_scale;
 
-      for (size_t bs = 0; bs < block_size; bs++) {
-        *output++ = static_cast<float>(static_cast<const int>(*input++) - zp) * sc;
-      }
+      // each block shares one scale and zero point, so let Eigen vectorize
+      // the subtract and scale over the contiguous run
+      ConstEigenVectorArrayMap<T> input_block(input, block_size);
+      EigenVectorArrayMap<float>(output, block_size) =
+          (input_block.template cast<int>() - zp).template cast<float>() * sc;
+      input += block_size;
+      output += block_size;
 
       current_scale += stride;
       current_zero_point += stride;
@@ -99,14 +103,6 @@ ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
         .TypeConstraint("y", DataTypeImpl::GetTensorType<uint8_t>()),
     QuantizeLinear<float>);
 
-// clamp doesn't exist in the version of <algorithm> that we're using, so
-// make a local one.
-static float clamp(float v, float lo, float hi) {
-  if (v < lo) return lo;
-  if (v > hi) return hi;
-  return v;
-}
-
 template <>
 // formula is Y = X / Scale + ZeroPoint
 Status QuantizeLinear<float>::Compute(OpKernelContext* ctx) const {
@@ -149,9 +145,14 @@ Status QuantizeLinear<float>::Compute(OpKernelContext* ctx) const {
       float zp = *current_zero_point;
       auto sc = *current_scale;
 
-      for (size_t bs = 0; bs < block_size; bs++) {
-        *output++ = static_cast<uint8_t>(clamp(std::round(static_cast<float>(*input++) / sc) + zp, 0.0f, float(UINT8_MAX)));
-      }
+      // divide, round and saturate the whole block in one vectorized Eigen
+      // expression; round() matches the round-half-away behavior of
+      // std::round
+      ConstEigenVectorArrayMap<float> input_block(input, block_size);
+      EigenVectorArrayMap<uint8_t>(output, block_size) =
+          ((input_block / sc).round() + zp).max(0.0f).min(float(UINT8_MAX)).template cast<uint8_t>();
+      input += block_size;
+      output += block_size;
 
       current_scale += stride;
       current_zero_point += stride;
@@ -0,0 +1,28 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/sparse_dict_vectorizer.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    SparseDictVectorizer,
+    1,
+    string,
+    KernelDefBuilder()
+        .TypeConstraint("T1", DataTypeImpl::GetType<std::map<std::string, float>>())
+        .TypeConstraint("T2", DataTypeImpl::GetType<SparseTensorCSR>()),
+    SparseDictVectorizerOp<std::string>);
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    SparseDictVectorizer,
+    1,
+    int64_t,
+    KernelDefBuilder()
+        .TypeConstraint("T1", DataTypeImpl::GetType<std::map<int64_t, float>>())
+        .TypeConstraint("T2", DataTypeImpl::GetType<SparseTensorCSR>()),
+    SparseDictVectorizerOp<int64_t>);
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,72 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+#include "core/framework/sparse_tensor.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Sparse counterpart of the ONNX-ML DictVectorizer: instead of writing a
+// dense [1, C] row that is almost entirely zeros, only the vocabulary entries
+// actually present in the input dictionary are emitted, as a one-row CSR
+// matrix. The vocabulary is indexed by a hash map built once at kernel
+// construction, so Compute is O(entries) rather than O(vocabulary).
+template <typename AttrType>
+class SparseDictVectorizerOp final : public OpKernel {
+ public:
+  SparseDictVectorizerOp(const OpKernelInfo& info) : OpKernel(info) {
+    std::vector<AttrType> vocabulary;
+    ONNXRUNTIME_ENFORCE(info.GetAttrs(std::is_same<AttrType, std::string>::value ? "string_vocabulary" : "int64_vocabulary", vocabulary).IsOK());
+    num_features_ = static_cast<int64_t>(vocabulary.size());
+    // the dense DictVectorizer tolerates duplicated vocabulary entries and
+    // writes the value at every position; a multimap preserves that.
+    for (size_t i = 0, end = vocabulary.size(); i < end; ++i) {
+      vocabulary_index_.emplace(vocabulary[i], static_cast<int64_t>(i));
+    }
+  }
+
+  common::Status Compute(OpKernelContext* ctx) const override {
+    const auto* map = ctx->Input<std::map<AttrType, float>>(0);
+    auto* Y = ctx->Output<SparseTensorCSR>(0);
+    ONNXRUNTIME_ENFORCE(Y != nullptr);
+
+    std::vector<std::pair<int64_t, float>> entries;
+    entries.reserve(map->size());
+    for (const auto& pair : *map) {
+      auto range = vocabulary_index_.equal_range(pair.first);
+      for (auto it = range.first; it != range.second; ++it) {
+        entries.emplace_back(it->second, pair.second);
+      }
+    }
+    // CSR wants the row's columns in increasing order.
+    std::sort(entries.begin(), entries.end());
+
+    Y->Reset(1, num_features_);
+    for (const auto& entry : entries) {
+      if (entry.second != 0.f) {
+        Y->AppendEntry(entry.first, entry.second);
+      }
+    }
+    Y->EndRow();
+
+    return Status::OK();
+  }
+
+ private:
+  int64_t num_features_;
+  std::unordered_multimap<AttrType, int64_t> vocabulary_index_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,25 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+#include "core/framework/sparse_tensor.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Multiplies a CSR sparse matrix A with a dense row-major matrix B. Each
+// non-zero entry of A contributes one scaled row of B to the output, so the
+// cost is O(nnz * N) instead of the O(M * K * N) a dense GEMM would spend,
+// which is the point for inputs that are overwhelmingly zeros.
+class SparseMatMul final : public OpKernel {
+ public:
+  SparseMatMul(const OpKernelInfo& info) : OpKernel(info) {}
+
+  Status Compute(OpKernelContext* ctx) const override;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -4,13 +4,17 @@
 #include "string_normalizer.h"
 #include "onnx/defs/schema.h"
 #include "core/common/common.h"
+#include "core/common/utf8_util.h"
 #include "core/framework/tensor.h"
 
 #ifdef _MSC_VER
 #include <locale.h>
 #endif
 
+#include <cctype>
 #include <codecvt>
+#include <cstdint>
+#include <cstring>
 #include <locale>
 #include <functional>
 #include <unordered_set>
@@ -103,9 +107,28 @@ const std::string default_locale("en_US.UTF-8");
 
 #endif
 
+// ASCII helpers. For English locales all-ASCII strings change case in place
+// a block at a time, skipping both the wide-string round trip through codecvt
+// and the per-character C table lookups.
+inline bool IsAscii(const std::string& s) {
+  return utf8_util::utf8_all_ascii(reinterpret_cast<const unsigned char*>(s.data()), s.size());
+}
+
+inline void AsciiChangeCase(StringNormalizer::CaseAction caseaction, std::string& s) {
+  assert(caseaction != StringNormalizer::NONE);
+  if (s.empty()) {
+    return;
+  }
+  if (caseaction == StringNormalizer::LOWER) {
+    utf8_util::utf8_ascii_to_lower(&s[0], s.size());
+  } else {
+    utf8_util::utf8_ascii_to_upper(&s[0], s.size());
+  }
+}
+
 template <class ForwardIter>
 Status CopyCaseAction(ForwardIter first, ForwardIter end, OpKernelContext* ctx,
-                      const Locale& loc,
+                      const Locale& loc, bool ascii_locale,
                       std::wstring_convert<std::codecvt_utf8<wchar_t>>& converter,
                       size_t N, size_t C,
                       StringNormalizer::CaseAction caseaction) {
@@ -134,6 +157,13 @@ Status CopyCaseAction(ForwardIter first, ForwardIter end, OpKernelContext* ctx,
   while (first != end) {
     auto& s = *first;
     if (caseaction == StringNormalizer::LOWER || caseaction == StringNormalizer::UPPER) {
+      if (ascii_locale && IsAscii(s)) {
+        auto* out = new (output_data + output_idx) std::string(s);
+        AsciiChangeCase(caseaction, *out);
+        ++output_idx;
+        ++first;
+        continue;
+      }
       std::wstring wstr = converter.from_bytes(s);
       if (wstr == wconv_error) {
         return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
@@ -184,6 +214,9 @@ StringNormalizer::StringNormalizer(const OpKernelInfo& info) : OpKernel(info),
   }
 
   locale_name_ = info.GetAttrOrDefault("locale", default_locale);
+  // English case rules match the C table on the ASCII range, so all-ASCII
+  // strings can skip the locale machinery entirely.
+  ascii_locale_ = locale_name_.compare(0, 2, "en") == 0;
   Locale locale(locale_name_);
   std::wstring_convert<std::codecvt_utf8<wchar_t>> converter(conv_error, wconv_error);
 
@@ -201,6 +234,22 @@ StringNormalizer::StringNormalizer(const OpKernelInfo& info) : OpKernel(info),
       ONNXRUNTIME_ENFORCE(p.second, "Duplicate stopwords not allowed");
     }
   }
+
+  // When every stopword is ASCII too, ASCII inputs can be compared without
+  // any wide conversion at all.
+  if (!is_case_sensitive_ && ascii_locale_) {
+    ascii_stopwords_ = true;
+    for (const auto& sw : swords) {
+      if (!IsAscii(sw)) {
+        ascii_stopwords_ = false;
+        ascii_folded_stopwords_.clear();
+        break;
+      }
+      std::string folded = sw;
+      AsciiChangeCase(compare_caseaction_, folded);
+      ascii_folded_stopwords_.insert(std::move(folded));
+    }
+  }
 }
 
 Status StringNormalizer::Compute(OpKernelContext* ctx) const {
@@ -248,11 +297,11 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
         }
         ++first;
       }
-      status = CopyCaseAction(filtered_strings.cbegin(), filtered_strings.cend(), ctx, locale, converter,
+      status = CopyCaseAction(filtered_strings.cbegin(), filtered_strings.cend(), ctx, locale, ascii_locale_, converter,
                               N, filtered_strings.size(), casechangeaction_);
     } else {
       // Nothing to filter. Copy input to output and change case if needed
-      status = CopyCaseAction(input_data, input_data + C, ctx, locale, converter, N, C, casechangeaction_);
+      status = CopyCaseAction(input_data, input_data + C, ctx, locale, ascii_locale_, converter, N, C, casechangeaction_);
     }
   } else {
     if (!wstopwords_.empty()) {
@@ -267,6 +316,21 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
       auto const last = input_data + C;
       while (first != last) {
         const std::string& s = *first;
+        if (ascii_stopwords_ && IsAscii(s)) {
+          // folded already carries the final case: the compare action equals
+          // the change action whenever the latter is not NONE.
+          std::string folded = s;
+          AsciiChangeCase(compare_caseaction_, folded);
+          if (0 == ascii_folded_stopwords_.count(folded)) {
+            if (casechangeaction_ == NONE) {
+              filtered_orignal_strings.push_back(std::cref(s));
+            } else {
+              filtered_cased_strings.push_back(std::move(folded));
+            }
+          }
+          ++first;
+          continue;
+        }
         std::wstring wstr = converter.from_bytes(s);
         if (wstr == wconv_error) {
           return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
@@ -283,15 +347,15 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
         ++first;
       }
       if (casechangeaction_ == NONE) {
-        status = CopyCaseAction(filtered_orignal_strings.cbegin(), filtered_orignal_strings.cend(), ctx, locale, converter,
+        status = CopyCaseAction(filtered_orignal_strings.cbegin(), filtered_orignal_strings.cend(), ctx, locale, ascii_locale_, converter,
                                 N, filtered_orignal_strings.size(), NONE);
       } else {
-        status = CopyCaseAction(filtered_cased_strings.begin(), filtered_cased_strings.end(), ctx, locale, converter,
+        status = CopyCaseAction(filtered_cased_strings.begin(), filtered_cased_strings.end(), ctx, locale, ascii_locale_, converter,
                                 N, filtered_cased_strings.size(), NONE);
       }
     } else {
       // Nothing to filter. Copy input to output and change case if needed
-      status = CopyCaseAction(input_data, input_data + C, ctx, locale, converter, N, C, casechangeaction_);
+      status = CopyCaseAction(input_data, input_data + C, ctx, locale, ascii_locale_, converter, N, C, casechangeaction_);
     }
   }
   return status;
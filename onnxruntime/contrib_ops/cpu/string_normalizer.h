@@ -30,9 +30,16 @@ class StringNormalizer : public OpKernel {
   CaseAction casechangeaction_;
   CaseAction compare_caseaction_;  // used for case-insensitive compare
   std::string locale_name_;
+  // set for English locales, where case changes on all-ASCII strings can be
+  // done bytewise without the wide-string round trip.
+  bool ascii_locale_ = false;
+  // set when ascii_locale_ holds and every stopword is ASCII, so ASCII
+  // inputs compare against ascii_folded_stopwords_ without conversion.
+  bool ascii_stopwords_ = false;
   // Either if these are populated but not both
   std::unordered_set<std::string> stopwords_;
   std::unordered_set<std::wstring> wstopwords_;
+  std::unordered_set<std::string> ascii_folded_stopwords_;
 };
 
 }  // namespace contrib
@@ -4,6 +4,7 @@
 #include "tokenizer.h"
 #include "onnx/defs/schema.h"
 #include "core/common/common.h"
+#include "core/framework/string_tensor_arena.h"
 #include "core/framework/tensor.h"
 
 #include "core/common/utf8_util.h"
@@ -220,8 +221,30 @@ Tokenizer::Tokenizer(const OpKernelInfo& info) : OpKernel(info) {
   ONNXRUNTIME_ENFORCE(!char_tokenezation_ || mincharnum_ < 2,
                       "mincharnum is too big for char level tokenezation");
 
-  // Create TST and insert separators
+  // Separators that are all single ASCII bytes tokenize with a byte table
+  // over the utf8 input directly: utf8 continuation bytes are >= 0x80, so an
+  // ASCII byte can never match inside a multi-byte character and no wide
+  // conversion or tree search is needed.
   if (!char_tokenezation_) {
+    ascii_separators_ = true;
+    for (const auto& sep : separators) {
+      if (sep.size() != 1 || static_cast<unsigned char>(sep[0]) >= 0x80) {
+        ascii_separators_ = false;
+        break;
+      }
+    }
+  }
+
+  if (ascii_separators_) {
+    for (const auto& sep : separators) {
+      const auto b = static_cast<unsigned char>(sep[0]);
+      ONNXRUNTIME_ENFORCE(!separator_table_[b], "duplicate separator detected");
+      separator_table_[b] = true;
+    }
+  }
+
+  // Create TST and insert separators
+  if (!char_tokenezation_ && !ascii_separators_) {
     std::unique_ptr<SearchData> sd(std::make_unique<SearchData>());
     std::wstring_convert<std::codecvt_utf8<wchar_t>> converter(conv_error, wconv_error);
     int priority = 0;  // earlier search patterns get priority
@@ -316,6 +339,135 @@ Status Tokenizer::CharTokenize(OpKernelContext* ctx, size_t N, size_t C,
   return Status::OK();
 }
 
+// Number of utf8 characters in a validated byte range; only the leading
+// bytes need decoding.
+static inline size_t Utf8CharCount(const char* data, size_t size) {
+  size_t chars = 0;
+  size_t idx = 0;
+  while (idx < size) {
+    size_t bytes = 0;
+    bool result = utf8_bytes(static_cast<unsigned char>(data[idx]), bytes);
+    assert(result);
+    (void)result;
+    idx += bytes;
+    ++chars;
+  }
+  return chars;
+}
+
+Status Tokenizer::SeparatorTokenizeAscii(OpKernelContext* ctx,
+                                         size_t N, size_t C,
+                                         const std::vector<int64_t>& input_dims) const {
+  struct Span {
+    const char* data_;
+    size_t size_;
+  };
+
+  auto X = ctx->Input<Tensor>(0);
+  auto const input_data = X->template Data<std::string>();
+
+  // Scan pass: record token spans into the input buffers. Nothing is
+  // copied until the output pool is filled below.
+  std::vector<Span> spans;
+  std::vector<size_t> row_ends;  // index one past each row's spans
+  row_ends.reserve(N * C);
+  size_t max_tokens = 0;
+  size_t token_chars = 0;
+
+  auto curr_input = input_data;
+  auto const last = input_data + N * C;
+  while (curr_input != last) {
+    const auto& s = *curr_input;
+    size_t utf8_chars = 0;
+    if (!utf8_validate(reinterpret_cast<const unsigned char*>(s.data()), s.size(), utf8_chars)) {
+      return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                    "Invalid utf8 chars in the input: " + s);
+    }
+
+    const size_t row_begin = spans.size();
+    const char* data = s.data();
+    const size_t size = s.size();
+    size_t start = 0;
+    for (size_t i = 0; i < size; ++i) {
+      if (!separator_table_[static_cast<unsigned char>(data[i])]) {
+        continue;
+      }
+      const size_t sz = i - start;
+      // the byte length bounds the character count, so most short tokens
+      // are rejected without decoding
+      if (sz >= size_t(mincharnum_) &&
+          (mincharnum_ < 2 || Utf8CharCount(data + start, sz) >= size_t(mincharnum_))) {
+        spans.push_back(Span{data + start, sz});
+        token_chars += sz;
+      }
+      start = i + 1;
+    }
+    // as in the general path, a trailing token is kept regardless of
+    // mincharnum
+    if (start < size) {
+      spans.push_back(Span{data + start, size - start});
+      token_chars += size - start;
+    }
+
+    row_ends.push_back(spans.size());
+    size_t tokens = spans.size() - row_begin;
+    if (mark_) {
+      tokens += 2;  // Start/end markers as separate tokens
+    }
+    max_tokens = std::max(max_tokens, tokens);
+    ++curr_input;
+  }
+
+  std::vector<int64_t> output_dims(input_dims);
+  // Check if we have no output due to either empty input
+  // everything is a separator
+  if ((max_tokens - mark_ * 2) == 0) {
+    output_dims.push_back(0);
+    TensorShape output_shape(output_dims);
+    ctx->Output(0, output_shape);
+    return Status::OK();
+  }
+
+  output_dims.push_back(max_tokens);
+  TensorShape output_shape(output_dims);
+
+  auto output_tensor = ctx->Output(0, output_shape);
+  auto const output_data = output_tensor->template MutableData<std::string>();
+
+  // Pool the output characters into one contiguous arena and materialize
+  // the std::string elements from it, instead of building each token as its
+  // own allocation.
+  const size_t rows = N * C;
+  const size_t elements = rows * max_tokens;
+  const size_t marker_chars = mark_ ? 2 * rows : 0;
+  const size_t pad_count = elements - spans.size() - (mark_ ? 2 * rows : 0);
+  auto arena = std::make_shared<StringTensorArena>();
+  arena->Reserve(elements, token_chars + marker_chars + pad_count * pad_value_.size());
+
+  size_t span_idx = 0;
+  for (size_t row = 0; row < rows; ++row) {
+    const size_t row_end = row_ends[row];
+    const size_t row_tokens = row_end - span_idx;
+    if (mark_) {
+      arena->Add(&start_text, 1);
+    }
+    for (; span_idx < row_end; ++span_idx) {
+      arena->Add(spans[span_idx].data_, spans[span_idx].size_);
+    }
+    if (mark_) {
+      arena->Add(&end_text, 1);
+    }
+    const size_t pads = max_tokens - (mark_ * 2) - row_tokens;
+    for (size_t p = 0; p < pads; ++p) {
+      arena->Add(pad_value_);
+    }
+  }
+
+  arena->MaterializeTo(output_data);
+  output_tensor->SetStringArena(std::move(arena));
+  return Status::OK();
+}
+
 Status Tokenizer::SeparatorTokenize(OpKernelContext* ctx,
                                     size_t N, size_t C,
                                     const std::vector<int64_t>& input_dims) const {
@@ -481,6 +633,8 @@ Status Tokenizer::Compute(OpKernelContext* ctx) const {
   Status s;
   if (char_tokenezation_) {
     s = CharTokenize(ctx, N, C, input_dims);
+  } else if (ascii_separators_) {
+    s = SeparatorTokenizeAscii(ctx, N, C, input_dims);
   } else {
     s = SeparatorTokenize(ctx, N, C, input_dims);
   }
@@ -5,6 +5,7 @@
 
 #include "core/framework/op_kernel.h"
 
+#include <array>
 #include <memory>
 
 namespace onnxruntime {
@@ -25,10 +26,21 @@ class Tokenizer final : public OpKernel {
   Status SeparatorTokenize(OpKernelContext* context, size_t N, size_t C,
                            const std::vector<int64_t>& input_dims) const;
 
+  // Fast path for separators that are all single ASCII bytes: tokens are
+  // byte spans into the input buffer and the output characters are pooled
+  // into a StringTensorArena, so no wide-string round trip is made and no
+  // per-token intermediate is allocated.
+  Status SeparatorTokenizeAscii(OpKernelContext* context, size_t N, size_t C,
+                                const std::vector<int64_t>& input_dims) const;
+
   bool mark_;
   std::string pad_value_;
   int64_t mincharnum_;
   bool char_tokenezation_;
+  // set when every separator is one ASCII byte; separator_table_[b] marks
+  // the separator bytes and search_data_ stays empty.
+  bool ascii_separators_ = false;
+  std::array<bool, 256> separator_table_{};
   struct SearchData;
   std::unique_ptr<SearchData> search_data_;
 };
@@ -6,6 +6,16 @@
 #include "core/codegen/tvm/tvm_compiler.h"
 namespace onnxruntime {
 
+static tvm::Type ToTvmType(MLDataType type) {
+  if (DataTypeImpl::GetTensorType<float>() == type) {
+    return tvm::Float(32);
+  }
+  if (DataTypeImpl::GetTensorType<double>() == type) {
+    return tvm::Float(64);
+  }
+  ONNXRUNTIME_NOT_IMPLEMENTED("Only float and double tensors can be lowered to TVM now.");
+}
+
 TVMGraph::TensorDescriptor::TensorDescriptor(MLDataType type, onnxruntime::ProviderType execution_provider_type, tvm::Tensor tvm_tensor) : tvm_tensor_(tvm_tensor) {
   if (execution_provider_type == onnxruntime::kCpuExecutionProvider) {
     ctx_.device_type = DLDeviceType::kDLCPU;
@@ -14,12 +24,14 @@ TVMGraph::TensorDescriptor::TensorDescriptor(MLDataType type, onnxruntime::Provi
     ONNXRUNTIME_NOT_IMPLEMENTED("Non-cpu execution provider not supported on TVM now.");
   }
 
+  dtype_.code = kDLFloat;
+  dtype_.lanes = 1;
   if (DataTypeImpl::GetTensorType<double>() == type) {
-    dtype_.code = kDLFloat;
     dtype_.bits = 64;
-    dtype_.lanes = 1;
+  } else if (DataTypeImpl::GetTensorType<float>() == type) {
+    dtype_.bits = 32;
   } else {
-    ONNXRUNTIME_NOT_IMPLEMENTED("Non-double type not supported on TVM now.");
+    ONNXRUNTIME_NOT_IMPLEMENTED("Only float and double tensors are supported on TVM now.");
   }
 }
 
@@ -34,53 +46,122 @@ class IdGenerator {
   int cur_;
 };
 
-// This is a special compiler step for the test case that sum two 1-D tensors
-static void Compile1DAddToTVM(const onnxruntime::Node& node, std::unordered_map<const onnxruntime::NodeArg*, TVMGraph::TensorDescriptor>& tvm_tensors, onnxruntime::ProviderType execution_provider_type, IdGenerator& generator) {
-  ONNXRUNTIME_ENFORCE(node.OpType() == "Add");
-  tvm::Array<tvm::Expr> shape;
-  shape.push_back(tvm::var("n1"));
-
-  tvm::Tensor t1, t2;
-  auto it = tvm_tensors.find(node.InputDefs()[0]);
-  if (it == tvm_tensors.end()) {
-    tvm_tensors[node.InputDefs()[0]] = TVMGraph::TensorDescriptor(
-        DataTypeImpl::TypeFromProto(*node.InputDefs()[0]->TypeAsProto()),
-        execution_provider_type,
-        tvm::placeholder(shape, tvm::Float(64), "T" + std::to_string(generator.GetNext())));
+// Returns the tvm tensor bound to <def>, creating a placeholder for it on
+// first sight. Static dimensions become constant extents, unknown dimensions
+// become fresh symbolic vars.
+static TVMGraph::TensorDescriptor& GetOrCreateTensor(
+    const onnxruntime::NodeArg* def,
+    std::unordered_map<const onnxruntime::NodeArg*, TVMGraph::TensorDescriptor>& tvm_tensors,
+    onnxruntime::ProviderType execution_provider_type,
+    IdGenerator& generator) {
+  auto it = tvm_tensors.find(def);
+  if (it != tvm_tensors.end()) {
+    return it->second;
   }
-  t1 = tvm_tensors[node.InputDefs()[0]].tvm_tensor_;
-  it = tvm_tensors.find(node.InputDefs()[1]);
-  if (it == tvm_tensors.end()) {
-    tvm_tensors[node.InputDefs()[1]] = TVMGraph::TensorDescriptor(
-        DataTypeImpl::TypeFromProto(*node.InputDefs()[1]->TypeAsProto()),
-        execution_provider_type,
-        tvm::placeholder(shape, tvm::Float(64), "T" + std::to_string(generator.GetNext())));
+
+  int id = generator.GetNext();
+  tvm::Array<tvm::Expr> shape;
+  const auto* shape_proto = def->Shape();
+  if (shape_proto != nullptr && shape_proto->dim_size() > 0) {
+    for (int d = 0; d < shape_proto->dim_size(); ++d) {
+      const auto& dim = shape_proto->dim(d);
+      if (dim.has_dim_value()) {
+        shape.push_back(tvm::Expr(static_cast<int32_t>(dim.dim_value())));
+      } else {
+        shape.push_back(tvm::var("d" + std::to_string(d) + "_" + std::to_string(id)));
+      }
+    }
+  } else {
+    shape.push_back(tvm::var("n" + std::to_string(id)));
   }
-  t2 = tvm_tensors[node.InputDefs()[1]].tvm_tensor_;
+
+  MLDataType type = DataTypeImpl::TypeFromProto(*def->TypeAsProto());
+  tvm_tensors[def] = TVMGraph::TensorDescriptor(
+      type,
+      execution_provider_type,
+      tvm::placeholder(shape, ToTvmType(type), "T" + std::to_string(id)));
+  return tvm_tensors[def];
+}
+
+// Lowers a same-shape binary elementwise node to a tvm compute op over the
+// first operand's shape.
+static void CompileElementwiseToTVM(const onnxruntime::Node& node, std::unordered_map<const onnxruntime::NodeArg*, TVMGraph::TensorDescriptor>& tvm_tensors, onnxruntime::ProviderType execution_provider_type, IdGenerator& generator) {
+  const std::string& op = node.OpType();
+  ONNXRUNTIME_ENFORCE(op == "Add" || op == "Sub" || op == "Mul" || op == "Div",
+                      "Node ", node.Name(), " with op type ", op, " cannot be lowered to TVM.");
+  tvm::Tensor t1 = GetOrCreateTensor(node.InputDefs()[0], tvm_tensors, execution_provider_type, generator).tvm_tensor_;
+  tvm::Tensor t2 = GetOrCreateTensor(node.InputDefs()[1], tvm_tensors, execution_provider_type, generator).tvm_tensor_;
+
+  tvm::Tensor result = tvm::compute(
+      t1->shape,
+      [&t1, &t2, &op](const tvm::Array<tvm::Var>& indices) {
+        tvm::Expr a = t1(indices);
+        tvm::Expr b = t2(indices);
+        if (op == "Add") {
+          return a + b;
+        }
+        if (op == "Sub") {
+          return a - b;
+        }
+        if (op == "Mul") {
+          return a * b;
+        }
+        return a / b;
+      },
+      "T" + std::to_string(generator.GetNext()));
 
   tvm_tensors[node.OutputDefs()[0]] = TVMGraph::TensorDescriptor(
-      DataTypeImpl::TypeFromProto(*node.InputDefs()[1]->TypeAsProto()),
+      DataTypeImpl::TypeFromProto(*node.OutputDefs()[0]->TypeAsProto()),
       execution_provider_type,
-      tvm::compute(t1->shape, [&t1, &t2](tvm::Expr i) {
-        return t1[i] + t2[i];
+      result);
+}
+
+// Lowers a 2-D MatMul node to a tvm compute op with a reduction axis over
+// the shared dimension.
+static void CompileMatMulToTVM(const onnxruntime::Node& node, std::unordered_map<const onnxruntime::NodeArg*, TVMGraph::TensorDescriptor>& tvm_tensors, onnxruntime::ProviderType execution_provider_type, IdGenerator& generator) {
+  tvm::Tensor a = GetOrCreateTensor(node.InputDefs()[0], tvm_tensors, execution_provider_type, generator).tvm_tensor_;
+  tvm::Tensor b = GetOrCreateTensor(node.InputDefs()[1], tvm_tensors, execution_provider_type, generator).tvm_tensor_;
+  ONNXRUNTIME_ENFORCE(a->shape.size() == 2 && b->shape.size() == 2,
+                      "Only 2-D MatMul can be lowered to TVM now.");
+
+  int id = generator.GetNext();
+  tvm::IterVar k = tvm::reduce_axis(tvm::Range(0, a->shape[1]), "k" + std::to_string(id));
+  tvm::Tensor result = tvm::compute(
+      {a->shape[0], b->shape[1]},
+      [&a, &b, &k](tvm::Var i, tvm::Var j) {
+        return tvm::sum(a(i, k) * b(k, j), {k});
       },
-                   "T" + std::to_string(generator.GetNext())));
+      "T" + std::to_string(id));
+
+  tvm_tensors[node.OutputDefs()[0]] = TVMGraph::TensorDescriptor(
+      DataTypeImpl::TypeFromProto(*node.OutputDefs()[0]->TypeAsProto()),
+      execution_provider_type,
+      result);
 }
 
 TVMGraph CompileToTVM(const onnxruntime::Graph& graph, onnxruntime::ProviderType execution_provider_type) {
   TVMGraph result;
   std::unordered_map<const onnxruntime::NodeArg*, TVMGraph::TensorDescriptor> tvm_tensors;
   IdGenerator generator;
-  for (auto& node : graph.Nodes()) {
-    Compile1DAddToTVM(node, tvm_tensors, execution_provider_type, generator);
+  // walk in topological order so every operand is lowered before its uses and
+  // the compute ops chain directly without staging buffers.
+  GraphViewer graph_viewer(graph);
+  for (auto node_index : graph_viewer.GetNodesInTopologicalOrder()) {
+    const auto* node = graph_viewer.GetNode(node_index);
+    if (node->OpType() == "MatMul") {
+      CompileMatMulToTVM(*node, tvm_tensors, execution_provider_type, generator);
+    } else {
+      CompileElementwiseToTVM(*node, tvm_tensors, execution_provider_type, generator);
+    }
   }
 
   for (auto& input : graph.GetInputs()) {
     result.inputs_.push_back(tvm_tensors[input]);
   }
 
-  auto& output = graph.GetOutputs()[0];
-  result.outputs_.push_back(tvm_tensors[output]);
+  for (auto& output : graph.GetOutputs()) {
+    result.outputs_.push_back(tvm_tensors[output]);
+  }
   return result;
 }
 }  // namespace onnxruntime
@@ -31,6 +31,10 @@ struct TVMGraph {
 //TODO: compile a onnxruntime graph to tvm's tensor expression is a common logic for all hardwares
 //onnxruntime framework should provide this functionality to executionp providers.
 //We will need to register how to compiler it for each node. A detail design is needed.
-//Here for testing we just provide the functionality that compile add 1D tensors.
+//
+// Lowers a fused subgraph to a chain of tvm compute ops. Handles float and
+// double tensors, binary elementwise Add/Sub/Mul/Div over same-shape operands
+// and 2-D MatMul; tvm_codegen::IsFusibleNode in tvm_fusion.h is the matching
+// admission check. Anything else throws.
 TVMGraph CompileToTVM(const onnxruntime::Graph& graph, onnxruntime::ProviderType execution_provider_type);
 }  // namespace onnxruntime
@@ -0,0 +1,186 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/codegen/tvm/tvm_fusion.h"
+
+#include <set>
+#include <string>
+#include <unordered_map>
+
+#include "core/framework/data_types.h"
+#include "core/graph/indexed_sub_graph.h"
+
+namespace onnxruntime {
+namespace tvm_codegen {
+
+// Two shapes are compatible for an unbroadcast elementwise op when they have
+// the same rank and every dimension pair is provably equal: matching static
+// values or matching symbolic params. Unknown dimensions are rejected rather
+// than trusted.
+static bool ShapesMatch(const ONNX_NAMESPACE::TensorShapeProto* lhs,
+                        const ONNX_NAMESPACE::TensorShapeProto* rhs) {
+  if (lhs == nullptr || rhs == nullptr || lhs->dim_size() != rhs->dim_size()) {
+    return false;
+  }
+
+  for (int d = 0; d < lhs->dim_size(); ++d) {
+    const auto& dim_l = lhs->dim(d);
+    const auto& dim_r = rhs->dim(d);
+    if (dim_l.has_dim_value() && dim_r.has_dim_value()) {
+      if (dim_l.dim_value() != dim_r.dim_value()) {
+        return false;
+      }
+    } else if (dim_l.has_dim_param() && dim_r.has_dim_param()) {
+      if (dim_l.dim_param().empty() || dim_l.dim_param() != dim_r.dim_param()) {
+        return false;
+      }
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool IsFusibleNode(const onnxruntime::Node& node) {
+  const std::string& op = node.OpType();
+  const bool elementwise = op == "Add" || op == "Sub" || op == "Mul" || op == "Div";
+  if (!elementwise && op != "MatMul") {
+    return false;
+  }
+
+  auto input_defs = node.InputDefs();
+  if (input_defs.size() != 2) {
+    return false;
+  }
+
+  for (auto def : input_defs) {
+    if (def->TypeAsProto() == nullptr) {
+      return false;
+    }
+    MLDataType type = DataTypeImpl::TypeFromProto(*def->TypeAsProto());
+    if (type != DataTypeImpl::GetTensorType<float>() &&
+        type != DataTypeImpl::GetTensorType<double>()) {
+      return false;
+    }
+  }
+
+  if (elementwise) {
+    return ShapesMatch(input_defs[0]->Shape(), input_defs[1]->Shape());
+  }
+
+  // MatMul: CompileToTVM only lowers the 2-D case
+  return input_defs[0]->Shape() != nullptr && input_defs[0]->Shape()->dim_size() == 2 &&
+         input_defs[1]->Shape() != nullptr && input_defs[1]->Shape()->dim_size() == 2;
+}
+
+namespace {
+class UnionSet {
+ public:
+  explicit UnionSet(int n) {
+    for (int i = 0; i < n; ++i) {
+      parents_.push_back(i);
+    }
+  }
+
+  int get(int x) {
+    if (parents_[x] == x) {
+      return x;
+    }
+    return parents_[x] = get(parents_[x]);
+  }
+
+  void merge(int x, int y) {
+    x = get(x);
+    y = get(y);
+    if (x != y) {
+      parents_[y] = x;
+    }
+  }
+
+  std::vector<int> parents_;
+};
+}  // namespace
+
+void FindFusibleSubgraphs(const onnxruntime::GraphViewer& graph,
+                          const KernelCreateFn& kernel_create_fn,
+                          std::vector<std::unique_ptr<ComputeCapability>>& capabilities) {
+  // collect fusible nodes in topological order so each cluster's node list
+  // comes out topologically sorted
+  std::vector<onnxruntime::NodeIndex> fusible_nodes;
+  std::unordered_map<onnxruntime::NodeIndex, int> fusible_index;
+  for (auto node_index : graph.GetNodesInTopologicalOrder()) {
+    const auto* node = graph.GetNode(node_index);
+    if (IsFusibleNode(*node)) {
+      fusible_index[node_index] = static_cast<int>(fusible_nodes.size());
+      fusible_nodes.push_back(node_index);
+    }
+  }
+
+  // cluster nodes connected by a direct edge
+  UnionSet set(static_cast<int>(fusible_nodes.size()));
+  for (int i = 0; i < static_cast<int>(fusible_nodes.size()); ++i) {
+    const auto* node = graph.GetNode(fusible_nodes[i]);
+    for (auto it = node->InputNodesBegin(); it != node->InputNodesEnd(); ++it) {
+      auto producer = fusible_index.find((*it).Index());
+      if (producer != fusible_index.end()) {
+        set.merge(producer->second, i);
+      }
+    }
+  }
+
+  std::vector<std::vector<onnxruntime::NodeIndex>> groups;
+  groups.resize(fusible_nodes.size());
+  for (int i = 0; i < static_cast<int>(fusible_nodes.size()); ++i) {
+    groups[set.get(i)].push_back(fusible_nodes[i]);
+  }
+
+  int fused_count = 0;
+  for (auto& group : groups) {
+    // a single node gains nothing from compilation; leave it to the
+    // provider's regular kernel
+    if (group.size() <= 1) {
+      continue;
+    }
+
+    auto sub_graph = std::make_unique<IndexedSubGraph>();
+    std::set<const onnxruntime::NodeArg*> fused_inputs, fused_outputs;
+    for (auto index : group) {
+      sub_graph->nodes.push_back(index);
+      const auto* node = graph.GetNode(index);
+      for (auto input : node->InputDefs()) {
+        auto it = fused_outputs.find(input);
+        if (it != fused_outputs.end()) {
+          fused_outputs.erase(it);
+        } else {
+          fused_inputs.insert(input);
+        }
+      }
+      for (auto output : node->OutputDefs()) {
+        auto it = fused_inputs.find(output);
+        if (it != fused_inputs.end()) {
+          fused_inputs.erase(it);
+        } else {
+          fused_outputs.insert(output);
+        }
+      }
+    }
+
+    auto meta_def = std::make_unique<::onnxruntime::IndexedSubGraph::MetaDef>();
+    meta_def->name = "TVMFusedSubgraph_" + std::to_string(fused_count++);
+    meta_def->domain = "TVMFusion";
+    for (auto input : fused_inputs) {
+      meta_def->inputs.push_back(input->Name());
+    }
+    for (auto output : fused_outputs) {
+      meta_def->outputs.push_back(output->Name());
+    }
+    meta_def->since_version = 1;
+    meta_def->status = ONNX_NAMESPACE::EXPERIMENTAL;
+    sub_graph->SetMetaDef(meta_def);
+
+    capabilities.push_back(std::make_unique<ComputeCapability>(std::move(sub_graph), kernel_create_fn));
+  }
+}
+
+}  // namespace tvm_codegen
+}  // namespace onnxruntime
@@ -0,0 +1,36 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include <memory>
+#include <vector>
+
+#include "core/framework/op_kernel.h"
+#include "core/framework/compute_capability.h"
+#include "core/graph/graph_viewer.h"
+
+namespace onnxruntime {
+namespace tvm_codegen {
+
+// True when CompileToTVM can lower this node: a binary elementwise
+// Add/Sub/Mul/Div over same-shape float or double tensors, or a 2-D MatMul.
+bool IsFusibleNode(const onnxruntime::Node& node);
+
+// Partitioning rule for TVM-backed providers. Groups maximal connected
+// clusters of fusible nodes and emits a ComputeCapability per cluster of two
+// or more nodes, built with <kernel_create_fn> (typically a TVMKernel
+// subclass bound to the provider's schedule creator and module builder).
+// Single fusible nodes and everything else are left to the provider's
+// regular kernels, so unfused graphs run exactly as before. Intended for
+// CPUExecutionProvider::InsertFusedRules with kernel_create_fn bound:
+//
+//   cpu_provider->InsertFusedRules(
+//       [](const GraphViewer& graph, std::vector<std::unique_ptr<ComputeCapability>>& capabilities) {
+//         tvm_codegen::FindFusibleSubgraphs(graph, create_my_tvm_kernel, capabilities);
+//       });
+void FindFusibleSubgraphs(const onnxruntime::GraphViewer& graph,
+                          const KernelCreateFn& kernel_create_fn,
+                          std::vector<std::unique_ptr<ComputeCapability>>& capabilities);
+
+}  // namespace tvm_codegen
+}  // namespace onnxruntime
@@ -61,6 +61,7 @@ CPUIDInfo::CPUIDInfo() noexcept {
         GetCPUID(7, data);
         has_avx2_ = has_avx && (data[1] & (1 << 5));
         has_avx512f_ = has_avx512 && (data[1] & (1 << 16));
+        has_avx512bw_ = has_avx512 && (data[1] & (1 << 30));
       }
     }
   }
@@ -14,11 +14,13 @@ public:
 
   bool HasAVX2() const { return has_avx2_; }
   bool HasAVX512f() const { return has_avx512f_; }
+  bool HasAVX512bw() const { return has_avx512bw_; }
 
 private:
   CPUIDInfo() noexcept;
   bool has_avx2_{false};
   bool has_avx512f_{false};
+  bool has_avx512bw_{false};
 };
 
 }
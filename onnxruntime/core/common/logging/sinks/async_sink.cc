@@ -0,0 +1,81 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/logging/sinks/async_sink.h"
+
+#include <sstream>
+
+#include "date/date.h"
+
+namespace onnxruntime {
+namespace logging {
+
+AsyncSink::AsyncSink(std::ostream* stream, bool flush, size_t capacity)
+    : stream_{stream}, flush_{flush}, ring_(capacity) {
+  drain_thread_ = std::thread{&AsyncSink::DrainLoop, this};
+}
+
+AsyncSink::~AsyncSink() {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    shutdown_ = true;
+  }
+  data_available_.notify_one();
+  drain_thread_.join();
+
+  if (dropped_count_ > 0) {
+    (*stream_) << "AsyncSink dropped " << dropped_count_ << " messages.\n";
+  }
+  stream_->flush();
+}
+
+void AsyncSink::SendImpl(const Timestamp& timestamp, const std::string& logger_id, const Capture& message) {
+  // operator for formatting of timestamp in ISO8601 format including microseconds
+  using date::operator<<;
+
+  // format here so only the cheap in-memory work runs on the logging thread;
+  // the stream write happens on the drain thread.
+  std::ostringstream msg;
+  msg << timestamp << " [" << message.SeverityPrefix() << ":" << message.Category() << ":" << logger_id << ", "
+      << message.Location().ToString() << "] " << message.Message();
+
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (count_ == ring_.size()) {
+      // never wait for the drain thread; drop instead.
+      ++dropped_count_;
+      return;
+    }
+    ring_[(head_ + count_) % ring_.size()] = msg.str();
+    ++count_;
+  }
+  data_available_.notify_one();
+}
+
+void AsyncSink::DrainLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    data_available_.wait(lock, [this] { return count_ > 0 || shutdown_; });
+    if (count_ == 0 && shutdown_) {
+      return;
+    }
+
+    // take a batch so writers make progress while we do I/O unlocked.
+    while (count_ > 0) {
+      std::string line = std::move(ring_[head_]);
+      head_ = (head_ + 1) % ring_.size();
+      --count_;
+
+      lock.unlock();
+      (*stream_) << line << "\n";
+      lock.lock();
+    }
+
+    if (flush_) {
+      stream_->flush();
+    }
+  }
+}
+
+}  // namespace logging
+}  // namespace onnxruntime
@@ -0,0 +1,58 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/common/logging/isink.h"
+
+namespace onnxruntime {
+namespace logging {
+/// <summary>
+/// A sink that writes formatted log messages to a std::ostream from a
+/// background thread. The logging thread only formats the message and pushes
+/// it into a fixed-capacity ring buffer, so it never blocks on stream I/O;
+/// when the buffer is full the message is dropped and counted instead.
+/// The destructor drains any queued messages before returning.
+/// </summary>
+/// <seealso cref="ISink" />
+class AsyncSink : public ISink {
+ public:
+  /// <summary>
+  /// Initializes a new instance of the <see cref="AsyncSink"/> class.
+  /// </summary>
+  /// <param name="stream">The stream to write to. Must outlive the sink.</param>
+  /// <param name="flush">Flush the stream after each drained batch.</param>
+  /// <param name="capacity">Maximum number of queued messages.</param>
+  explicit AsyncSink(std::ostream* stream, bool flush = false, size_t capacity = 8192);
+
+  ~AsyncSink() override;
+
+ private:
+  void SendImpl(const Timestamp& timestamp, const std::string& logger_id, const Capture& message) override;
+
+  void DrainLoop();
+
+  std::ostream* stream_;
+  const bool flush_;
+
+  // ring buffer of formatted messages, guarded by mutex_. The writer never
+  // waits: a full ring drops the message and bumps dropped_count_.
+  std::vector<std::string> ring_;
+  size_t head_{0};  // next slot to drain
+  size_t count_{0};
+  uint64_t dropped_count_{0};
+  bool shutdown_{false};
+
+  std::mutex mutex_;
+  std::condition_variable data_available_;
+  std::thread drain_thread_;
+};
+}  // namespace logging
+}  // namespace onnxruntime
@@ -3,11 +3,103 @@
 
 #include "profiler.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <unordered_map>
+
+#include "core/platform/env_time.h"
+#include "core/platform/perf_counters.h"
+
 namespace onnxruntime {
 namespace profiling {
 using namespace std::chrono;
 
+std::atomic<uint64_t> Profiler::next_instance_id_{0};
+
+// Request tag installed on this thread by ScopedTraceTag, if any.
+static thread_local const std::string* thread_trace_tag = nullptr;
+
+ScopedTraceTag::ScopedTraceTag(const std::string* tag) : previous_(thread_trace_tag) {
+  if (tag != nullptr && !tag->empty()) {
+    thread_trace_tag = tag;
+  }
+}
+
+ScopedTraceTag::~ScopedTraceTag() {
+  thread_trace_tag = previous_;
+}
+
+const std::string* ScopedTraceTag::GetThreadTraceTag() {
+  return thread_trace_tag;
+}
+
+namespace {
+
+constexpr const char* kKernelTimeSuffix = "_kernel_time";
+
+// Strips "_kernel_time" from an event name, leaving the node name. Returns
+// false for events that don't time a kernel.
+bool GetKernelEventNodeName(const std::string& event_name, std::string& node_name) {
+  const size_t suffix_length = strlen(kKernelTimeSuffix);
+  if (event_name.size() <= suffix_length ||
+      event_name.compare(event_name.size() - suffix_length, suffix_length, kKernelTimeSuffix) != 0) {
+    return false;
+  }
+  node_name = event_name.substr(0, event_name.size() - suffix_length);
+  return true;
+}
+
+struct SummaryOpEntry {
+  uint64_t count;
+  double mean_us;
+};
+
+// Pulls the per-op entries back out of a summary produced by GetSummary.
+// Only the fields the comparison needs are read, so summaries carrying
+// extra fields still parse.
+void ParseSummaryOps(const std::string& summary, std::map<std::string, SummaryOpEntry>& ops) {
+  const std::string op_key = R"({"op":")";
+  const std::string count_key = R"("count":)";
+  const std::string mean_key = R"("mean_us":)";
+  size_t pos = 0;
+  while ((pos = summary.find(op_key, pos)) != std::string::npos) {
+    pos += op_key.size();
+    size_t name_end = summary.find('"', pos);
+    if (name_end == std::string::npos) return;
+    std::string name = summary.substr(pos, name_end - pos);
+    size_t count_pos = summary.find(count_key, name_end);
+    size_t mean_pos = summary.find(mean_key, name_end);
+    size_t entry_end = summary.find('}', name_end);
+    if (count_pos == std::string::npos || mean_pos == std::string::npos ||
+        entry_end == std::string::npos || count_pos > entry_end || mean_pos > entry_end) {
+      return;
+    }
+    SummaryOpEntry entry;
+    entry.count = strtoull(summary.c_str() + count_pos + count_key.size(), nullptr, 10);
+    entry.mean_us = strtod(summary.c_str() + mean_pos + mean_key.size(), nullptr);
+    ops[name] = entry;
+    pos = entry_end;
+  }
+}
+
+}  // namespace
+
+// Counter values captured by the most recent StartTime on this thread,
+// consumed by the matching EndTimeAndRecordEvent. Node spans on one thread
+// never overlap (the fence, kernel and release phases each close their span
+// before the next opens), so a single slot per thread suffices.
+static thread_local PerfCounters::Sample thread_span_start_counters;
+static thread_local bool thread_span_counters_valid = false;
+
 ::onnxruntime::TimePoint profiling::Profiler::StartTime() const {
+  if (hardware_counters_enabled_) {
+    thread_span_counters_valid = PerfCounters::SampleThread(thread_span_start_counters);
+  }
   return std::chrono::high_resolution_clock::now();
 }
 
@@ -16,6 +108,15 @@ void Profiler::Initialize(const logging::Logger* session_logger) {
   session_logger_ = session_logger;
 }
 
+void Profiler::EnableHardwareCounters() {
+  hardware_counters_enabled_ = PerfCounters::IsAvailable();
+  if (!hardware_counters_enabled_ && session_logger_ != nullptr) {
+    LOGS(*session_logger_, WARNING)
+        << "Hardware counter sampling is unavailable on this platform or kernel configuration; "
+        << "profile events will carry wall time only.";
+  }
+}
+
 void Profiler::StartProfiling(const logging::Logger* custom_logger) {
   ONNXRUNTIME_ENFORCE(custom_logger != nullptr);
   profile_with_logger_ = true;
@@ -23,11 +124,24 @@ void Profiler::StartProfiling(const logging::Logger* custom_logger) {
   profiling_start_time_ = StartTime();
 }
 
-void Profiler::StartProfiling(const std::string& file_name) {
-  enabled_ = true;
+void Profiler::StartProfiling(const std::string& file_name, bool use_ring_buffers) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    use_ring_buffers_ = use_ring_buffers;
+    // discard records and aggregates left over from a previous profiling
+    // session. No other thread writes while the profiler is disabled.
+    for (auto& ring : ring_buffers_) {
+      ring->pos.store(0, std::memory_order_relaxed);
+    }
+    op_stats_.clear();
+    provider_time_us_.clear();
+    node_counts_.clear();
+  }
   profile_stream_ = std::ofstream(file_name, std::ios::out | std::ios::trunc);
   profile_stream_file_ = file_name;
   profiling_start_time_ = StartTime();
+  profiling_start_ns_ = GetMonotonicTimeInNanoSeconds();
+  enabled_ = true;
 }
 
 void Profiler::EndTimeAndRecordEvent(EventCategory category,
@@ -37,16 +151,56 @@ void Profiler::EndTimeAndRecordEvent(EventCategory category,
                                      bool /*sync_gpu*/) {
   if (!enabled_ && !profile_with_logger_)
     return;
+  if (enabled_ && use_ring_buffers_) {
+    RecordRingEvent(category, event_name, start_time);
+    return;
+  }
   long long dur = TimeDiffMicroSeconds(start_time);
   long long ts = TimeDiffMicroSeconds(profiling_start_time_, start_time);
 
   EventRecord event(category, logging::GetProcessId(),
                     logging::GetThreadId(), event_name, ts, dur, { event_args.begin(), event_args.end() });
+
+  // correlate the span with the request that produced it.
+  const std::string* trace_tag = ScopedTraceTag::GetThreadTraceTag();
+  if (trace_tag != nullptr) {
+    event.args.emplace("run_tag", *trace_tag);
+  }
+
+  // attribute the hardware counters accumulated over the span. only node
+  // spans carry them; outer session spans enclose other spans on the same
+  // thread, so their start sample has already been overwritten.
+  if (hardware_counters_enabled_ && category == NODE_EVENT && thread_span_counters_valid) {
+    thread_span_counters_valid = false;
+    PerfCounters::Sample end_counters;
+    if (PerfCounters::SampleThread(end_counters)) {
+      const uint64_t cycles = end_counters.cycles - thread_span_start_counters.cycles;
+      event.args.emplace("cycles", std::to_string(cycles));
+      event.args.emplace("instructions",
+                         std::to_string(end_counters.instructions - thread_span_start_counters.instructions));
+      event.args.emplace("llc_misses",
+                         std::to_string(end_counters.llc_misses - thread_span_start_counters.llc_misses));
+      if (cycles > 0) {
+        const uint64_t stalled = end_counters.stalled_cycles - thread_span_start_counters.stalled_cycles;
+        char ratio[16];
+        snprintf(ratio, sizeof(ratio), "%.3f", static_cast<double>(stalled) / static_cast<double>(cycles));
+        event.args.emplace("stall_ratio", ratio);
+      }
+    }
+  }
+
   if (profile_with_logger_) {
     custom_logger_->SendProfileEvent(event);
+    if (category == NODE_EVENT) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      UpdateKernelStats(event_name, static_cast<uint64_t>(dur), event_args);
+    }
   } else {
     //TODO: sync_gpu if needed.
     std::lock_guard<std::mutex> lock(mutex_);
+    if (category == NODE_EVENT) {
+      UpdateKernelStats(event_name, static_cast<uint64_t>(dur), event_args);
+    }
     if (events_.size() < max_num_events_) {
       events_.emplace_back(event);
     } else {
@@ -59,6 +213,98 @@ void Profiler::EndTimeAndRecordEvent(EventCategory category,
   }
 }
 
+Profiler::EventRingBuffer* Profiler::GetThreadRingBuffer() {
+  static thread_local std::unordered_map<uint64_t, std::shared_ptr<EventRingBuffer>> rings_for_thread;
+  auto it = rings_for_thread.find(instance_id_);
+  if (it != rings_for_thread.end()) {
+    return it->second.get();
+  }
+  // drop cached rings whose profiler has been destroyed; the thread local
+  // reference is the only one left in that case.
+  for (auto entry = rings_for_thread.begin(); entry != rings_for_thread.end();) {
+    if (entry->second.use_count() == 1) {
+      entry = rings_for_thread.erase(entry);
+    } else {
+      ++entry;
+    }
+  }
+  auto ring = std::make_shared<EventRingBuffer>();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ring_buffers_.push_back(ring);
+  }
+  rings_for_thread.emplace(instance_id_, ring);
+  return ring.get();
+}
+
+void Profiler::RecordRingEvent(EventCategory category,
+                               const std::string& event_name,
+                               const TimePoint& start_time) {
+  uint64_t end_ns = GetMonotonicTimeInNanoSeconds();
+  uint64_t dur_ns = static_cast<uint64_t>(
+      duration_cast<nanoseconds>(high_resolution_clock::now() - start_time).count());
+
+  EventRingBuffer* ring = GetThreadRingBuffer();
+  uint64_t pos = ring->pos.load(std::memory_order_relaxed);
+  RingEventRecord& record = ring->records[pos % EventRingBuffer::kCapacity];
+  record.cat = category;
+  record.tid = logging::GetThreadId();
+  record.ts_ns = end_ns - dur_ns;
+  record.dur_ns = dur_ns;
+  size_t name_length = event_name.copy(record.name, kMaxEventNameLength - 1);
+  record.name[name_length] = '\0';
+  // publish the record before making it visible through pos.
+  ring->pos.store(pos + 1, std::memory_order_release);
+}
+
+void Profiler::WriteRingEvents() {
+  std::vector<RingEventRecord> events;
+  uint64_t dropped = 0;
+  for (auto& ring : ring_buffers_) {
+    uint64_t pos = ring->pos.load(std::memory_order_acquire);
+    uint64_t count = pos < EventRingBuffer::kCapacity ? pos : EventRingBuffer::kCapacity;
+    dropped += pos - count;
+    for (uint64_t i = pos - count; i < pos; ++i) {
+      events.push_back(ring->records[i % EventRingBuffer::kCapacity]);
+    }
+  }
+  if (dropped > 0 && session_logger_) {
+    LOGS(*session_logger_, WARNING)
+        << "Profiler ring buffers overflowed, dropped " << dropped << " oldest events.";
+  }
+  std::sort(events.begin(), events.end(),
+            [](const RingEventRecord& a, const RingEventRecord& b) { return a.ts_ns < b.ts_ns; });
+
+  // chrome tracing expects ts/dur in microseconds but accepts fractions, so
+  // the nanosecond resolution is preserved.
+  auto write_nanos_as_micros = [this](uint64_t nanos) {
+    profile_stream_ << nanos / 1000 << '.' << std::setw(3) << std::setfill('0') << nanos % 1000;
+  };
+
+  int pid = logging::GetProcessId();
+  for (size_t i = 0; i < events.size(); ++i) {
+    auto& rec = events[i];
+    uint64_t ts_ns = rec.ts_ns > profiling_start_ns_ ? rec.ts_ns - profiling_start_ns_ : 0;
+    profile_stream_ << R"({"cat" : ")" << event_categor_names_[rec.cat] << "\",";
+    profile_stream_ << "\"pid\" :" << pid << ",";
+    profile_stream_ << "\"tid\" :" << rec.tid << ",";
+    profile_stream_ << "\"dur\" :";
+    write_nanos_as_micros(rec.dur_ns);
+    profile_stream_ << ",";
+    profile_stream_ << "\"ts\" :";
+    write_nanos_as_micros(ts_ns);
+    profile_stream_ << ",";
+    profile_stream_ << R"("ph" : "X",)";
+    profile_stream_ << R"("name" :")" << rec.name << "\",";
+    profile_stream_ << "\"args\" : {}";
+    if (i == events.size() - 1) {
+      profile_stream_ << "}\n";
+    } else {
+      profile_stream_ << "},\n";
+    }
+  }
+}
+
 std::string Profiler::EndProfiling() {
   if (!enabled_) {
     return std::string();
@@ -70,6 +316,14 @@ std::string Profiler::EndProfiling() {
   std::lock_guard<std::mutex> lock(mutex_);
   profile_stream_ << "[\n";
 
+  if (use_ring_buffers_) {
+    enabled_ = false;  // stop threads from writing new records before collecting.
+    WriteRingEvents();
+    profile_stream_ << "]\n";
+    profile_stream_.close();
+    return profile_stream_file_;
+  }
+
   for (size_t i = 0; i < events_.size(); ++i) {
     auto& rec = events_[i];
     profile_stream_ << R"({"cat" : ")" << event_categor_names_[rec.cat] << "\",";
@@ -99,6 +353,196 @@ std::string Profiler::EndProfiling() {
   return profile_stream_file_;
 }
 
+void Profiler::TimingStats::Record(uint64_t dur_us) {
+  ++count;
+  total_us += dur_us;
+  if (dur_us > max_us) {
+    max_us = dur_us;
+  }
+  // bucket i covers [2^i, 2^(i+1)); durations of 0 and 1 share bucket 0.
+  size_t bucket = 0;
+  while (bucket + 1 < kNumBuckets && dur_us >= (uint64_t{1} << (bucket + 1))) {
+    ++bucket;
+  }
+  ++buckets[bucket];
+}
+
+uint64_t Profiler::TimingStats::ApproximateP99() const {
+  if (count == 0) {
+    return 0;
+  }
+  uint64_t target = (count * 99 + 99) / 100;
+  uint64_t cumulative = 0;
+  for (size_t i = 0; i < kNumBuckets; ++i) {
+    cumulative += buckets[i];
+    if (cumulative >= target) {
+      // report the bucket's upper bound, clipped to the observed maximum.
+      return std::min(max_us, (uint64_t{1} << (i + 1)) - 1);
+    }
+  }
+  return max_us;
+}
+
+void Profiler::UpdateKernelStats(const std::string& event_name, uint64_t dur_us,
+                                 const std::initializer_list<std::pair<std::string, std::string>>& event_args) {
+  std::string node_name;
+  if (!GetKernelEventNodeName(event_name, node_name)) {
+    return;
+  }
+  ++node_counts_[node_name];
+  for (const auto& arg : event_args) {
+    if (arg.first == "op_name") {
+      op_stats_[arg.second].Record(dur_us);
+    } else if (arg.first == "provider") {
+      provider_time_us_[arg.second] += dur_us;
+    }
+  }
+}
+
+std::string Profiler::GetSummary() {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  const std::unordered_map<std::string, TimingStats>* op_stats = &op_stats_;
+  const std::unordered_map<std::string, uint64_t>* node_counts = &node_counts_;
+  const std::unordered_map<std::string, uint64_t>* provider_time_us = &provider_time_us_;
+
+  // the ring records carry no event arguments, so rebuild the aggregates
+  // from the retained window, keyed by the node name in the event name.
+  std::unordered_map<std::string, TimingStats> ring_op_stats;
+  std::unordered_map<std::string, uint64_t> ring_node_counts;
+  std::unordered_map<std::string, uint64_t> ring_provider_time_us;
+  if (use_ring_buffers_) {
+    for (auto& ring : ring_buffers_) {
+      uint64_t pos = ring->pos.load(std::memory_order_acquire);
+      uint64_t available = pos < EventRingBuffer::kCapacity ? pos : EventRingBuffer::kCapacity;
+      for (uint64_t i = pos - available; i < pos; ++i) {
+        const RingEventRecord& rec = ring->records[i % EventRingBuffer::kCapacity];
+        std::string node_name;
+        if (rec.cat != NODE_EVENT || !GetKernelEventNodeName(rec.name, node_name)) {
+          continue;
+        }
+        ring_op_stats[node_name].Record(rec.dur_ns / 1000);
+        ++ring_node_counts[node_name];
+      }
+    }
+    op_stats = &ring_op_stats;
+    node_counts = &ring_node_counts;
+    provider_time_us = &ring_provider_time_us;
+  }
+
+  uint64_t total_kernel_us = 0;
+  for (const auto& entry : *op_stats) {
+    total_kernel_us += entry.second.total_us;
+  }
+
+  std::vector<std::pair<std::string, const TimingStats*>> ordered_ops;
+  ordered_ops.reserve(op_stats->size());
+  for (const auto& entry : *op_stats) {
+    ordered_ops.emplace_back(entry.first, &entry.second);
+  }
+  std::sort(ordered_ops.begin(), ordered_ops.end(),
+            [](const std::pair<std::string, const TimingStats*>& a,
+               const std::pair<std::string, const TimingStats*>& b) {
+              if (a.second->total_us != b.second->total_us) return a.second->total_us > b.second->total_us;
+              return a.first < b.first;
+            });
+
+  std::ostringstream ss;
+  ss << R"({"total_kernel_time_us":)" << total_kernel_us << R"(,"ops":[)";
+  bool is_first = true;
+  for (const auto& entry : ordered_ops) {
+    const TimingStats& stats = *entry.second;
+    if (!is_first) ss << ",";
+    ss << R"({"op":")" << entry.first << R"(","count":)" << stats.count
+       << R"(,"total_us":)" << stats.total_us
+       << R"(,"mean_us":)" << (stats.count == 0 ? 0.0 : static_cast<double>(stats.total_us) / stats.count)
+       << R"(,"p99_us":)" << stats.ApproximateP99()
+       << R"(,"max_us":)" << stats.max_us
+       << R"(,"share":)" << (total_kernel_us == 0 ? 0.0 : static_cast<double>(stats.total_us) / total_kernel_us)
+       << "}";
+    is_first = false;
+  }
+
+  std::vector<std::pair<std::string, uint64_t>> ordered_providers(provider_time_us->begin(),
+                                                                  provider_time_us->end());
+  std::sort(ordered_providers.begin(), ordered_providers.end(),
+            [](const std::pair<std::string, uint64_t>& a, const std::pair<std::string, uint64_t>& b) {
+              if (a.second != b.second) return a.second > b.second;
+              return a.first < b.first;
+            });
+
+  ss << R"(],"providers":[)";
+  is_first = true;
+  for (const auto& entry : ordered_providers) {
+    if (!is_first) ss << ",";
+    ss << R"({"provider":")" << entry.first << R"(","total_us":)" << entry.second
+       << R"(,"share":)" << (total_kernel_us == 0 ? 0.0 : static_cast<double>(entry.second) / total_kernel_us)
+       << "}";
+    is_first = false;
+  }
+
+  std::vector<std::pair<std::string, uint64_t>> ordered_nodes(node_counts->begin(), node_counts->end());
+  std::sort(ordered_nodes.begin(), ordered_nodes.end(),
+            [](const std::pair<std::string, uint64_t>& a, const std::pair<std::string, uint64_t>& b) {
+              if (a.second != b.second) return a.second > b.second;
+              return a.first < b.first;
+            });
+
+  ss << R"(],"nodes":[)";
+  is_first = true;
+  for (const auto& entry : ordered_nodes) {
+    if (!is_first) ss << ",";
+    ss << R"({"name":")" << entry.first << R"(","count":)" << entry.second << "}";
+    is_first = false;
+  }
+  ss << "]}";
+  return ss.str();
+}
+
+std::string Profiler::CompareSummaries(const std::string& baseline_summary,
+                                       const std::string& current_summary,
+                                       double threshold) {
+  std::map<std::string, SummaryOpEntry> baseline;
+  std::map<std::string, SummaryOpEntry> current;
+  ParseSummaryOps(baseline_summary, baseline);
+  ParseSummaryOps(current_summary, current);
+
+  struct Regression {
+    std::string op;
+    double baseline_mean_us;
+    double mean_us;
+    double ratio;
+  };
+  std::vector<Regression> regressions;
+  for (const auto& entry : current) {
+    auto base = baseline.find(entry.first);
+    if (base == baseline.end() || base->second.mean_us <= 0 || entry.second.count == 0) {
+      continue;
+    }
+    double ratio = entry.second.mean_us / base->second.mean_us;
+    if (ratio > 1.0 + threshold) {
+      regressions.push_back({entry.first, base->second.mean_us, entry.second.mean_us, ratio});
+    }
+  }
+  std::sort(regressions.begin(), regressions.end(),
+            [](const Regression& a, const Regression& b) { return a.ratio > b.ratio; });
+
+  std::ostringstream ss;
+  ss << R"({"threshold":)" << threshold << R"(,"regressions":[)";
+  bool is_first = true;
+  for (const auto& regression : regressions) {
+    if (!is_first) ss << ",";
+    ss << R"({"op":")" << regression.op
+       << R"(","baseline_mean_us":)" << regression.baseline_mean_us
+       << R"(,"mean_us":)" << regression.mean_us
+       << R"(,"ratio":)" << regression.ratio
+       << "}";
+    is_first = false;
+  }
+  ss << "]}";
+  return ss.str();
+}
+
 //
 // Conditionally sync the GPU if the syncGPU flag is set.
 //
@@ -2,23 +2,54 @@
 // Licensed under the MIT License.
 
 #pragma once
+#include <atomic>
 #include <iostream>
 #include <fstream>
+#include <memory>
 #include <tuple>
 #include <initializer_list>
+#include <unordered_map>
 #include "core/common/logging/logging.h"
 
 namespace onnxruntime {
 
 namespace profiling {
 
+/*
+Installs a request tag on the calling thread for the lifetime of the scope.
+Events recorded by a Profiler while a tag is installed carry a "run_tag"
+argument, so the run-level span and the node spans it contains can be
+correlated back to the RunOptions.run_tag of the request that produced
+them in the chrome trace output. Executors install the tag at the start of
+a run and inside tasks that record node events on pool threads; the cost
+when no profile is being collected is two thread local stores per scope.
+*/
+class ScopedTraceTag {
+ public:
+  // The tag must outlive the scope. An empty tag installs nothing, leaving
+  // any enclosing scope's tag visible.
+  explicit ScopedTraceTag(const std::string* tag);
+  ~ScopedTraceTag();
+
+  // Returns the tag installed on the calling thread, or nullptr.
+  static const std::string* GetThreadTraceTag();
+
+ private:
+  ONNXRUNTIME_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ScopedTraceTag);
+
+  const std::string* previous_;
+};
+
 /*
 Main class for profiling. It continues to accumulate events and produce
 a corresponding "complete event (X)" in "chrome tracing" format.
 */
 class Profiler {
  public:
-  Profiler() noexcept {};  // turned off by default.
+  Profiler() noexcept : instance_id_(next_instance_id_.fetch_add(1)) {}  // turned off by default.
+
+  // Event names longer than this are truncated in the ring buffer mode.
+  static constexpr size_t kMaxEventNameLength = 64;
 
   /*
   Initializes Profiler with the session logger to log framework specific messages
@@ -32,8 +63,27 @@ class Profiler {
 
   /*
   Start profiler and record beginning time.
+
+  When use_ring_buffers is true events are written into fixed-size
+  per-thread ring buffers without taking a lock, which keeps the recording
+  overhead low enough to leave profiling enabled on live traffic. In this
+  mode only the most recent events of each thread are kept, event names are
+  truncated to kMaxEventNameLength - 1 characters, event arguments are not
+  recorded and serialization is deferred until EndProfiling.
   */
-  void StartProfiling(const std::string& file_name);
+  void StartProfiling(const std::string& file_name, bool use_ring_buffers = false);
+
+  /*
+  Attribute hardware performance counters to node spans: every node event
+  additionally carries the CPU cycles, retired instructions, last-level
+  cache misses and backend stall ratio measured on the recording thread
+  over the span, so a slow kernel can be classified as memory-bound or
+  FLOP-bound from the trace alone. No-op when counter sampling is
+  unavailable on the platform (see core/platform/perf_counters.h) and in
+  the ring buffer mode, which records no event arguments. Spans of nodes
+  that run asynchronously on a device measure only the host-side launch.
+  */
+  void EnableHardwareCounters();
 
   /*
   Produce current time point for any profiling action.
@@ -56,9 +106,88 @@ class Profiler {
   */
   std::string EndProfiling();
 
+  /*
+  Produce a compact JSON summary of the kernel time events recorded so far:
+  per-op-type count, total, mean, approximate P99 and max, total kernel time
+  per execution provider, and per-node invocation counts. Unlike
+  EndProfiling this leaves profiling running, so it can be polled on live
+  traffic. In the ring buffer mode event arguments are not recorded, so the
+  aggregates are keyed by node name instead of op type, cover only the
+  events still held in the rings, and the provider breakdown is empty.
+  */
+  std::string GetSummary();
+
+  /*
+  Compare two summaries produced by GetSummary and report the ops whose
+  mean kernel time grew by more than the given fraction (0.2 flags ops
+  that got at least 20% slower), as a JSON string sorted by the regression
+  ratio. Ops absent from the baseline are skipped.
+  */
+  static std::string CompareSummaries(const std::string& baseline_summary,
+                                      const std::string& current_summary,
+                                      double threshold);
+
  private:
   ONNXRUNTIME_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(Profiler);
 
+  /*
+  POD timing record used by the ring buffer mode. Unlike EventRecord it
+  owns no heap memory, so a thread can write it into its ring buffer with
+  plain stores. Timestamps are nanoseconds from the monotonic clock in
+  env_time.h.
+  */
+  struct RingEventRecord {
+    EventCategory cat;
+    int tid;
+    uint64_t ts_ns;
+    uint64_t dur_ns;
+    char name[kMaxEventNameLength];
+  };
+
+  /*
+  Fixed-size single-producer ring of event records. Only the owning thread
+  writes records and advances pos; EndProfiling reads pos with acquire
+  semantics and collects the last min(pos, kCapacity) records. Records
+  written while EndProfiling is collecting may be lost, so profiles should
+  be ended when no runs are in flight.
+  */
+  struct EventRingBuffer {
+    static constexpr size_t kCapacity = 8192;
+    std::atomic<uint64_t> pos{0};  // total number of records ever written
+    RingEventRecord records[kCapacity];
+  };
+
+  /*
+  Streaming timing aggregate. Durations land in power-of-two microsecond
+  buckets, so the percentile estimate is accurate to within a factor of two
+  while recording costs a handful of stores per event.
+  */
+  struct TimingStats {
+    static constexpr size_t kNumBuckets = 32;
+    uint64_t count{0};
+    uint64_t total_us{0};
+    uint64_t max_us{0};
+    uint64_t buckets[kNumBuckets]{};
+
+    void Record(uint64_t dur_us);
+    uint64_t ApproximateP99() const;
+  };
+
+  // Folds a kernel time event into the streaming aggregates. Expects
+  // mutex_ to be held.
+  void UpdateKernelStats(const std::string& event_name, uint64_t dur_us,
+                         const std::initializer_list<std::pair<std::string, std::string>>& event_args);
+
+  // Returns the calling thread's ring buffer for this profiler instance,
+  // creating and registering it on first use.
+  EventRingBuffer* GetThreadRingBuffer();
+
+  void RecordRingEvent(EventCategory category,
+                       const std::string& event_name,
+                       const TimePoint& start_time);
+
+  void WriteRingEvents();
+
   // Mutex controlling access to profiler data
   std::mutex mutex_;
   bool enabled_{false};
@@ -71,6 +200,31 @@ class Profiler {
   bool max_events_reached{false};
   static constexpr size_t max_num_events_ = 1000000;
   bool profile_with_logger_{false};
+
+  // Streaming aggregates over the kernel time events, guarded by mutex_.
+  // Keyed by the op type from the "op_name" event argument, the provider
+  // from the "provider" event argument and the node name from the event
+  // name respectively. Not maintained in the ring buffer mode, where
+  // GetSummary aggregates from the ring contents instead.
+  std::unordered_map<std::string, TimingStats> op_stats_;
+  std::unordered_map<std::string, uint64_t> provider_time_us_;
+  std::unordered_map<std::string, uint64_t> node_counts_;
+
+  // attribute hardware counters to node spans; set once before profiling
+  // starts and only when the platform supports sampling.
+  bool hardware_counters_enabled_{false};
+
+  bool use_ring_buffers_{false};
+  uint64_t profiling_start_ns_{0};
+  // All ring buffers ever handed out for this profiler, guarded by mutex_.
+  // shared_ptr so a ring outlives both the thread that owns it and, via the
+  // thread local cache, the profiler itself.
+  std::vector<std::shared_ptr<EventRingBuffer>> ring_buffers_;
+
+  // Distinguishes ring buffers cached in thread local storage across
+  // profiler instances; ids are never reused.
+  const uint64_t instance_id_;
+  static std::atomic<uint64_t> next_instance_id_;
 };
 
 }  // namespace profiling
@@ -46,15 +46,19 @@ Example of that usage:
 #pragma once
 
 #include <condition_variable>
+#include <cstdint>
 #include <functional>
 #include <future>
 #include <mutex>
 #include <queue>
 #include <thread>
 #include <utility>
+#include <vector>
 
 #include "core/common/common.h"
 #include "core/common/logging/logging.h"
+#include "core/platform/denormal.h"
+#include "core/platform/thread_affinity.h"
 
 namespace onnxruntime {
 
@@ -89,11 +93,20 @@ class TaskThreadPool {
   std::size_t total_;
 
  public:
-  /// @brief Constructor.
-  explicit TaskThreadPool(std::size_t pool_size)
+  /// @brief Constructor. When affinity_masks is non-empty, worker i is pinned
+  /// to the logical processors in affinity_masks[i % affinity_masks.size()].
+  explicit TaskThreadPool(std::size_t pool_size,
+                          const std::vector<uint64_t>& affinity_masks = std::vector<uint64_t>())
       : threads_(pool_size), running_(true), complete_(true), available_(pool_size), total_(pool_size) {
     for (std::size_t i = 0; i < pool_size; ++i) {
       threads_[i] = std::thread(std::bind(&TaskThreadPool::MainLoop, this, i));
+      if (!affinity_masks.empty()) {
+        uint64_t mask = affinity_masks[i % affinity_masks.size()];
+        if (!SetThreadAffinity(threads_[i], mask)) {
+          LOGS_DEFAULT(WARNING) << "Failed to set affinity mask 0x" << std::hex << mask << std::dec
+                                << " on TaskThreadPool worker " << i << "; thread left unpinned.";
+        }
+      }
     }
   }
 
@@ -149,7 +162,17 @@ class TaskThreadPool {
 
   /// @brief Entry point for pool threads.
   void MainLoop(std::size_t index) {
+    // The MXCSR is per thread, so a worker does not inherit the denormal
+    // mode of whichever thread created the pool. Opted-in processes flush
+    // denormals here, before any task runs; the flag is rechecked each pass
+    // so pools that outlive the opt-in pick it up too.
+    bool denormal_flush_applied = false;
+
     while (running_) {
+      if (!denormal_flush_applied && DenormalFlushForPoolThreads().load(std::memory_order_relaxed)) {
+        SetDenormalAsZero(true);
+        denormal_flush_applied = true;
+      }
       // Wait on condition variable while the task is empty and
       // the pool is still running.
       std::unique_lock<std::mutex> lock(mutex_);
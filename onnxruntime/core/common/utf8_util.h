@@ -3,8 +3,15 @@
 
 #pragma once
 
+#include <cstdint>
+#include <cstring>
+
 #include "core/common/common.h"
 
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#include <emmintrin.h>
+#endif
+
 namespace onnxruntime {
 namespace utf8_util {
 
@@ -31,99 +38,220 @@ inline bool utf8_bytes(unsigned char ch, size_t& len) {
   return false;
 }
 
-inline bool utf8_validate(const unsigned char* s, size_t len, size_t& utf8_chars) {
-  size_t utf8_len = 0;
-  size_t idx = 0;
-  while (idx < len) {
-    size_t bytes = 0;
-    auto ch = s[idx];
-    if (utf8_bytes(ch, bytes)) {
-      switch (bytes) {
-        case 1:
+// Validates the single utf8 character whose leading byte is s[idx] and
+// advances idx one past its final byte. Returns false when the sequence is
+// truncated or malformed.
+inline bool utf8_validate_char(const unsigned char* s, size_t len, size_t& idx) {
+  size_t bytes = 0;
+  auto ch = s[idx];
+  if (!utf8_bytes(ch, bytes)) {
+    return false;
+  }
+  switch (bytes) {
+    case 1:
+      break;
+    case 2: {
+      if (++idx >= len || s[idx] < 0x80u || s[idx] > 0xBFu) {
+        return false;
+      }
+    } break;  // 2
+    case 3: {
+      auto ch1 = s[idx];
+      switch (ch1) {
+        case 0xE0u:
+          if (++idx >= len || s[idx] < 0xA0u || s[idx] > 0xBFu) {
+            return false;
+          }
           break;
-        case 2: {
-          if (++idx >= len || s[idx] < 0x80u || s[idx] > 0xBFu) {
+        case 0xEDu:
+          if (++idx >= len || s[idx] < 0x80u || s[idx] > 0x9Fu) {
             return false;
           }
-        } break;  // 2
-        case 3: {
-          auto ch1 = s[idx];
-          switch (ch1) {
-            case 0xE0u:
-              if (++idx >= len || s[idx] < 0xA0u || s[idx] > 0xBFu) {
-                return false;
-              }
-              break;
-            case 0xEDu:
-              if (++idx >= len || s[idx] < 0x80u || s[idx] > 0x9Fu) {
-                return false;
-              }
-              break;
-            default: {
-              if ((ch1 >= 0xE1u && ch1 <= 0xECu) ||
-                  (ch1 >= 0xEEu && ch1 <= 0xEFu)) {
-                if (++idx >= len || s[idx] < 0x80u || s[idx] > 0xBFu) {
-                  return false;
-                }
-              } else {
-                return false;
-              }
-            } break;
+          break;
+        default: {
+          if ((ch1 >= 0xE1u && ch1 <= 0xECu) ||
+              (ch1 >= 0xEEu && ch1 <= 0xEFu)) {
+            if (++idx >= len || s[idx] < 0x80u || s[idx] > 0xBFu) {
+              return false;
+            }
+          } else {
+            return false;
           }
-          // validate byte 3
-          if (++idx >= len || s[idx] < 0x80u || s[idx] > 0xBFu) {
+        } break;
+      }
+      // validate byte 3
+      if (++idx >= len || s[idx] < 0x80u || s[idx] > 0xBFu) {
+        return false;
+      }
+    } break;  // 3
+    case 4: {
+      auto ch1 = s[idx];
+      switch (ch1) {
+        case 0xF0u: {
+          if (++idx >= len || s[idx] < 0x90u || s[idx] > 0xBFu) {
             return false;
           }
-        } break;  // 3
-        case 4: {
-          auto ch1 = s[idx];
-          switch (ch1) {
-            case 0xF0u: {
-              if (++idx >= len || s[idx] < 0x90u || s[idx] > 0xBFu) {
-                return false;
-              }
-            } break;
-            case 0xF4u: {
-              if (++idx >= len || s[idx] < 0x80u || s[idx] > 0x8Fu) {
-                return false;
-              }
-            } break;
-            default: {
-              if (ch1 >= 0xF1u && ch1 <= 0xF3u) {
-                if (++idx >= len || s[idx] < 0x80u || s[idx] > 0xBFu) {
-                  return false;
-                }
-              } else {
-                return false;
-              }
-            } break;
+        } break;
+        case 0xF4u: {
+          if (++idx >= len || s[idx] < 0x80u || s[idx] > 0x8Fu) {
+            return false;
           }
-          // validate bytes 3 and 4
-          size_t stop = idx + 2;
-          while (idx < stop) {
+        } break;
+        default: {
+          if (ch1 >= 0xF1u && ch1 <= 0xF3u) {
             if (++idx >= len || s[idx] < 0x80u || s[idx] > 0xBFu) {
               return false;
             }
+          } else {
+            return false;
           }
-        } break;  // 4
-        default:
-          // no chars longer than 4
+        } break;
+      }
+      // validate bytes 3 and 4
+      size_t stop = idx + 2;
+      while (idx < stop) {
+        if (++idx >= len || s[idx] < 0x80u || s[idx] > 0xBFu) {
           return false;
-      }  // switch bytes
+        }
+      }
+    } break;  // 4
+    default:
+      // no chars longer than 4
+      return false;
+  }  // switch bytes
+  ++idx;
+  return true;
+}
+
+// True when every byte of the range is a single-byte (ASCII) character.
+// Folds a whole 16 (or 8) byte block into the accumulator per step; any set
+// high bit means a multi-byte character.
+inline bool utf8_all_ascii(const unsigned char* s, size_t len) {
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+  __m128i block_acc = _mm_setzero_si128();
+  while (len >= 16) {
+    block_acc = _mm_or_si128(block_acc, _mm_loadu_si128(reinterpret_cast<const __m128i*>(s)));
+    s += 16;
+    len -= 16;
+  }
+  if (_mm_movemask_epi8(block_acc) != 0) {
+    return false;
+  }
+#endif
+  uint64_t acc = 0;
+  while (len >= sizeof(uint64_t)) {
+    uint64_t chunk;
+    memcpy(&chunk, s, sizeof(chunk));
+    acc |= chunk;
+    s += sizeof(uint64_t);
+    len -= sizeof(uint64_t);
+  }
+  while (len > 0) {
+    acc |= *s;
+    ++s;
+    --len;
+  }
+  return (acc & 0x8080808080808080ULL) == 0;
+}
+
+// Validates the range as utf8 and counts its characters. ASCII runs - the
+// dominant case for English text - are cleared a 16 (or 8) byte block per
+// step by testing the block's high bits at once; only multi-byte characters
+// drop to the per-byte checks.
+inline bool utf8_validate(const unsigned char* s, size_t len, size_t& utf8_chars) {
+  size_t utf8_len = 0;
+  size_t idx = 0;
+  while (idx < len) {
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+    while (idx + 16 <= len) {
+      __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + idx));
+      if (_mm_movemask_epi8(block) != 0) {
+        break;
+      }
+      idx += 16;
+      utf8_len += 16;
+    }
+#endif
+    while (idx + sizeof(uint64_t) <= len) {
+      uint64_t chunk;
+      memcpy(&chunk, s + idx, sizeof(chunk));
+      if ((chunk & 0x8080808080808080ULL) != 0) {
+        break;
+      }
+      idx += sizeof(uint64_t);
+      utf8_len += sizeof(uint64_t);
+    }
+    if (idx >= len) {
+      break;
+    }
+    if (s[idx] < 0x80u) {
       ++idx;
       ++utf8_len;
-    } else {
+      continue;
+    }
+    if (!utf8_validate_char(s, len, idx)) {
       return false;
     }
-  }
-  // End index must match
-  // the end of the last byte sequence.
-  if (idx != len) {
-    return false;
+    ++utf8_len;
   }
   utf8_chars = utf8_len;
   return true;
 }
 
+// In-place ASCII case conversion over [s, s + len). Every byte of the range
+// must be ASCII (check with utf8_all_ascii); multi-byte characters would be
+// corrupted. A ranged compare selects the letters of a whole block and a
+// single masked flip of the 0x20 case bit converts them.
+inline void utf8_ascii_change_case(char* s, size_t len, char range_first, char range_last,
+                                   bool to_lower) {
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+  // signed compares are exact because ASCII bytes are non-negative
+  const __m128i below_first = _mm_set1_epi8(range_first - 1);
+  const __m128i above_last = _mm_set1_epi8(range_last + 1);
+  const __m128i case_bit = _mm_set1_epi8(0x20);
+  while (len >= 16) {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+    __m128i is_letter = _mm_and_si128(_mm_cmpgt_epi8(block, below_first),
+                                      _mm_cmplt_epi8(block, above_last));
+    __m128i flip = _mm_and_si128(is_letter, case_bit);
+    block = to_lower ? _mm_or_si128(block, flip) : _mm_andnot_si128(flip, block);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(s), block);
+    s += 16;
+    len -= 16;
+  }
+#else
+  // SWAR equivalent: per byte b, adding (0x80 - bound) sets the high bit
+  // exactly when b >= bound, and ASCII input keeps every add within its
+  // byte, so the high bits form the letter mask for eight bytes at once.
+  const uint64_t ones = 0x0101010101010101ULL;
+  const uint64_t high = 0x8080808080808080ULL;
+  const uint64_t ge_first = ones * static_cast<uint64_t>(0x80 - static_cast<unsigned char>(range_first));
+  const uint64_t gt_last = ones * static_cast<uint64_t>(0x80 - (static_cast<unsigned char>(range_last) + 1));
+  while (len >= sizeof(uint64_t)) {
+    uint64_t chunk;
+    memcpy(&chunk, s, sizeof(chunk));
+    const uint64_t letters = ((chunk + ge_first) & ~(chunk + gt_last)) & high;
+    const uint64_t flip = letters >> 2;  // move the mask from bit 7 to the 0x20 case bit
+    chunk = to_lower ? (chunk | flip) : (chunk & ~flip);
+    memcpy(s, &chunk, sizeof(chunk));
+    s += sizeof(uint64_t);
+    len -= sizeof(uint64_t);
+  }
+#endif
+  for (; len > 0; ++s, --len) {
+    if (*s >= range_first && *s <= range_last) {
+      *s = static_cast<char>(*s ^ 0x20);
+    }
+  }
+}
+
+inline void utf8_ascii_to_lower(char* s, size_t len) {
+  utf8_ascii_change_case(s, len, 'A', 'Z', true);
+}
+
+inline void utf8_ascii_to_upper(char* s, size_t len) {
+  utf8_ascii_change_case(s, len, 'a', 'z', false);
+}
+
 }  // namespace utf8_util
 }  // namespace onnxruntime
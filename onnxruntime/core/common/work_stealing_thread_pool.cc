@@ -0,0 +1,462 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/work_stealing_thread_pool.h"
+
+#include <algorithm>
+
+#include "core/common/logging/logging.h"
+#include "core/platform/denormal.h"
+#include "core/platform/thread_affinity.h"
+
+namespace onnxruntime {
+
+namespace {
+// Per-worker queue capacity. Must be a power of two. Submission falls back to
+// other workers' queues (and finally to yielding) when a queue fills up, so
+// this only needs to cover a healthy burst of small tasks.
+constexpr std::size_t kTaskQueueCapacity = 1024;
+
+// Number of failed pop/steal rounds a worker performs before parking.
+constexpr int kSpinCount = 1000;
+
+// Sentinel batch index marking a lane of a capped batch: the task claims
+// iteration indices from the batch state instead of carrying one of its own.
+constexpr std::size_t kBatchLaneIndex = static_cast<std::size_t>(-1);
+
+// Cap installed by the innermost ParallelismCapScope on this thread; workers
+// running a task temporarily adopt the cap of the thread that submitted it.
+thread_local std::size_t t_max_parallelism = 0;
+
+// Set once by MainLoop so ExecuteInParallel can recognize pool workers: a
+// worker must never park waiting on a nested batch, because its lanes sit in
+// queues that may have no free worker left to drain them.
+thread_local bool t_pool_worker = false;
+
+// Set while a thread executes iterations of an ExecuteInParallel batch (a
+// worker lane or the calling thread's inline share); nested parallel work
+// checks it and runs inline.
+thread_local bool t_in_parallel_region = false;
+
+// RAII marker for the scope of one batch's iterations on this thread.
+struct ParallelRegionScope {
+  ParallelRegionScope() noexcept : previous_(t_in_parallel_region) { t_in_parallel_region = true; }
+  ~ParallelRegionScope() { t_in_parallel_region = previous_; }
+
+ private:
+  bool previous_;
+};
+}  // namespace
+
+ParallelismCapScope::ParallelismCapScope(std::size_t max_parallelism) noexcept
+    : previous_(t_max_parallelism) {
+  t_max_parallelism = max_parallelism;
+}
+
+ParallelismCapScope::~ParallelismCapScope() {
+  t_max_parallelism = previous_;
+}
+
+std::size_t CurrentThreadMaxParallelism() noexcept {
+  return t_max_parallelism;
+}
+
+bool CurrentThreadInParallelRegion() noexcept {
+  return t_in_parallel_region;
+}
+
+WorkStealingThreadPool::TaskQueue::TaskQueue(std::size_t capacity)
+    : cells_(std::make_unique<Cell[]>(capacity)), mask_(capacity - 1) {
+  ONNXRUNTIME_ENFORCE((capacity & mask_) == 0, "TaskQueue capacity must be a power of two.");
+  for (std::size_t i = 0; i != capacity; ++i) {
+    cells_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+}
+
+bool WorkStealingThreadPool::TaskQueue::TryPush(TaskElement&& task) {
+  Cell* cell;
+  std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+  for (;;) {
+    cell = &cells_[pos & mask_];
+    std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+    auto dif = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+    if (dif == 0) {
+      if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        break;
+    } else if (dif < 0) {
+      return false;  // full
+    } else {
+      pos = enqueue_pos_.load(std::memory_order_relaxed);
+    }
+  }
+
+  cell->task = std::move(task);
+  cell->sequence.store(pos + 1, std::memory_order_release);
+  return true;
+}
+
+bool WorkStealingThreadPool::TaskQueue::TryPop(TaskElement& task) {
+  Cell* cell;
+  std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+  for (;;) {
+    cell = &cells_[pos & mask_];
+    std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+    auto dif = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+    if (dif == 0) {
+      if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        break;
+    } else if (dif < 0) {
+      return false;  // empty
+    } else {
+      pos = dequeue_pos_.load(std::memory_order_relaxed);
+    }
+  }
+
+  task = std::move(cell->task);
+  cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+  return true;
+}
+
+WorkStealingThreadPool::WorkStealingThreadPool(std::size_t pool_size,
+                                               const std::vector<uint64_t>& affinity_masks) {
+  pool_size = std::max<std::size_t>(1, pool_size);
+
+  queues_.reserve(pool_size);
+  high_queues_.reserve(pool_size);
+  for (std::size_t i = 0; i < pool_size; ++i) {
+    queues_.push_back(std::make_unique<TaskQueue>(kTaskQueueCapacity));
+    high_queues_.push_back(std::make_unique<TaskQueue>(kTaskQueueCapacity));
+  }
+
+  threads_.reserve(pool_size);
+  for (std::size_t i = 0; i < pool_size; ++i) {
+    threads_.emplace_back(&WorkStealingThreadPool::MainLoop, this, i);
+    if (!affinity_masks.empty()) {
+      uint64_t mask = affinity_masks[i % affinity_masks.size()];
+      if (!SetThreadAffinity(threads_.back(), mask)) {
+        LOGS_DEFAULT(WARNING) << "Failed to set affinity mask 0x" << std::hex << mask << std::dec
+                              << " on WorkStealingThreadPool worker " << i << "; thread left unpinned.";
+      }
+    }
+  }
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() {
+  running_.store(false, std::memory_order_release);
+  {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    wake_cv_.notify_all();
+  }
+
+  try {
+    for (auto& t : threads_) {
+      t.join();
+    }
+  } catch (const std::exception& ex) {
+    LOGS_DEFAULT(ERROR) << "Exception joining threads in WorkStealingThreadPool: " << ex.what();
+  }
+}
+
+void WorkStealingThreadPool::RunTask(std::packaged_task<void()>&& task, TaskPriority priority) {
+  Submit(TaskElement{std::move(task)}, priority);
+}
+
+void WorkStealingThreadPool::RunTaskWithID(std::packaged_task<void(std::size_t)>&& task,
+                                           TaskPriority priority) {
+  Submit(TaskElement{std::move(task)}, priority);
+}
+
+void WorkStealingThreadPool::Submit(TaskElement&& task, TaskPriority priority) {
+  // Stamp the submitter's cap onto the task so work a capped run fans out to
+  // the pool carries the cap with it.
+  task.submitter_cap = t_max_parallelism;
+  in_flight_.fetch_add(1, std::memory_order_relaxed);
+  pending_.fetch_add(1, std::memory_order_release);
+
+  auto& queues = priority == TaskPriority::kHigh ? high_queues_ : queues_;
+  const std::size_t num_queues = queues.size();
+  std::size_t start = next_queue_.fetch_add(1, std::memory_order_relaxed);
+  for (;;) {
+    for (std::size_t i = 0; i < num_queues; ++i) {
+      if (queues[(start + i) % num_queues]->TryPush(std::move(task))) {
+        // Wake a parked worker only when one exists; when the pool is busy
+        // this is a single relaxed load.
+        if (num_idle_.load(std::memory_order_acquire) > 0) {
+          std::lock_guard<std::mutex> lock(wake_mutex_);
+          wake_cv_.notify_one();
+        }
+        return;
+      }
+    }
+    // All queues momentarily full: give the workers a chance to drain.
+    std::this_thread::yield();
+  }
+}
+
+bool WorkStealingThreadPool::TryGetTask(std::size_t worker_index, TaskElement& task) {
+  // Every high priority queue is scanned before any normal one, so queued
+  // normal work never delays a high priority task by more than the task a
+  // worker is already running. Within a class: own queue first, then steal
+  // from peers starting at the next worker so steal traffic spreads instead
+  // of converging on worker 0.
+  const std::size_t num_queues = queues_.size();
+  for (std::size_t i = 0; i < num_queues; ++i) {
+    if (high_queues_[(worker_index + i) % num_queues]->TryPop(task)) {
+      pending_.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+  for (std::size_t i = 0; i < num_queues; ++i) {
+    if (queues_[(worker_index + i) % num_queues]->TryPop(task)) {
+      pending_.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+  return false;
+}
+
+void WorkStealingThreadPool::MainLoop(std::size_t index) {
+  t_pool_worker = true;
+
+  TaskElement task;
+
+  // The MXCSR is per thread, so workers do not inherit the denormal mode of
+  // the thread that built the pool. Opted-in processes flush denormals
+  // before any work runs; the flag is rechecked each pass so a shared pool
+  // created before the opt-in picks it up too.
+  bool denormal_flush_applied = false;
+
+  while (running_.load(std::memory_order_acquire)) {
+    if (!denormal_flush_applied && DenormalFlushForPoolThreads().load(std::memory_order_relaxed)) {
+      SetDenormalAsZero(true);
+      denormal_flush_applied = true;
+    }
+    bool found = false;
+    for (int spin = 0; spin < kSpinCount; ++spin) {
+      if (TryGetTask(index, task)) {
+        found = true;
+        break;
+      }
+      std::this_thread::yield();
+    }
+
+    if (!found) {
+      std::unique_lock<std::mutex> lock(wake_mutex_);
+      num_idle_.fetch_add(1, std::memory_order_release);
+      wake_cv_.wait(lock, [this]() {
+        return pending_.load(std::memory_order_acquire) > 0 ||
+               !running_.load(std::memory_order_acquire);
+      });
+      num_idle_.fetch_sub(1, std::memory_order_release);
+      continue;
+    }
+
+    try {
+      const ParallelismCapScope inherited_cap{task.submitter_cap};
+      if (task.batch != nullptr) {
+        RunBatchTask(task);
+      } else if (task.run_with_id) {
+        task.with_id(index);
+      } else {
+        task.no_id();
+      }
+    } catch (const std::exception& ex) {
+      // packaged_task stores the exception in its future; reaching this
+      // point means the task body itself leaked one, which is a bug.
+      LOGS_DEFAULT(ERROR) << "Exception running WorkStealingThreadPool task: " << ex.what();
+    }
+
+    // Drop the task state before signalling completion so captured
+    // resources are released by the time WaitWorkComplete returns.
+    task = TaskElement{};
+
+    if (in_flight_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      std::lock_guard<std::mutex> lock(completed_mutex_);
+      completed_cv_.notify_all();
+    }
+  }
+}
+
+void WorkStealingThreadPool::WaitWorkComplete() {
+  std::unique_lock<std::mutex> lock(completed_mutex_);
+  completed_cv_.wait(lock, [this]() { return in_flight_.load(std::memory_order_acquire) == 0; });
+}
+
+void WorkStealingThreadPool::RunBatchTask(TaskElement& task) {
+  BatchState& state = *task.batch;
+  {
+    const ParallelRegionScope region_scope;
+    if (task.batch_index == kBatchLaneIndex) {
+      // lane of a capped batch: drain iteration indices until none are left,
+      // then report the lane as done.
+      ClaimBatchIterations(state);
+    } else {
+      try {
+        (*state.fn)(task.batch_index);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if (!state.exception)
+          state.exception = std::current_exception();
+      }
+    }
+  }
+
+  // Decrement under the state's mutex. The owner's wait predicate reads
+  // remaining while holding the same mutex, so it cannot observe 0 and
+  // destroy the stack-resident state until this lane has released the lock
+  // after notifying; a decrement outside the lock would leave a window where
+  // the owner returns while this lane is still about to touch the state.
+  {
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (state.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+      state.cv.notify_one();
+  }
+}
+
+void WorkStealingThreadPool::ClaimBatchIterations(BatchState& state) {
+  for (;;) {
+    const std::size_t index = state.next.fetch_add(1, std::memory_order_relaxed);
+    if (index >= state.iterations)
+      return;
+    try {
+      (*state.fn)(index);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(state.mutex);
+      if (!state.exception)
+        state.exception = std::current_exception();
+    }
+  }
+}
+
+void WorkStealingThreadPool::ExecuteInParallel(const std::function<void(std::size_t)>& fn,
+                                               std::size_t iterations) {
+  if (iterations == 0)
+    return;
+
+  // A call that originates on a pool worker, or from inside another batch's
+  // iteration, must not park in the waits below: its lanes would sit in the
+  // queues while every thread able to claim them may itself be parked on a
+  // nested batch, and the pool hangs. Run the whole batch inline instead.
+  // MLAS makes the matching fallback through GetMaximumThreadCount(), so
+  // nested kernels partition their work for one thread to begin with.
+  if (t_pool_worker || t_in_parallel_region) {
+    const ParallelRegionScope region_scope;
+    for (std::size_t i = 0; i < iterations; ++i)
+      fn(i);
+    return;
+  }
+
+  const std::size_t cap = t_max_parallelism;
+  if (iterations == 1 || cap == 1) {
+    for (std::size_t i = 0; i < iterations; ++i)
+      fn(i);
+    return;
+  }
+
+  if (cap > 0 && cap < iterations) {
+    // Capped batch: instead of one queue entry per iteration, submit cap - 1
+    // lanes (the caller is the remaining lane) which claim iteration indices
+    // from the shared state, so this call never occupies more than cap
+    // threads no matter how many iterations it covers.
+    BatchState state;
+    state.fn = &fn;
+    state.iterations = iterations;
+    const std::size_t extra_lanes = std::min(cap - 1, threads_.size());
+    state.remaining.store(extra_lanes, std::memory_order_relaxed);
+
+    for (std::size_t i = 0; i < extra_lanes; ++i) {
+      Submit(TaskElement{&state, kBatchLaneIndex}, TaskPriority::kNormal);
+    }
+
+    {
+      const ParallelRegionScope region_scope;
+      ClaimBatchIterations(state);
+    }
+
+    {
+      std::unique_lock<std::mutex> lock(state.mutex);
+      state.cv.wait(lock, [&state]() { return state.remaining.load(std::memory_order_acquire) == 0; });
+    }
+
+    if (state.exception)
+      std::rethrow_exception(state.exception);
+    return;
+  }
+
+  // The queued iterations only reference this stack-resident state, so
+  // submitting one writes a pointer and an index into a queue cell instead
+  // of allocating a packaged_task/future pair.
+  BatchState state;
+  state.fn = &fn;
+  state.remaining.store(iterations - 1, std::memory_order_relaxed);
+
+  for (std::size_t i = 1; i < iterations; ++i) {
+    Submit(TaskElement{&state, i}, TaskPriority::kNormal);
+  }
+
+  // Run one iteration inline rather than blocking this thread outright.
+  try {
+    const ParallelRegionScope region_scope;
+    fn(0);
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (!state.exception)
+      state.exception = std::current_exception();
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(state.mutex);
+    state.cv.wait(lock, [&state]() { return state.remaining.load(std::memory_order_acquire) == 0; });
+  }
+
+  if (state.exception)
+    std::rethrow_exception(state.exception);
+}
+
+WorkStealingThreadPool& WorkStealingThreadPool::DefaultPool() {
+  static WorkStealingThreadPool default_pool{
+      std::max<std::size_t>(1, std::thread::hardware_concurrency())};
+  return default_pool;
+}
+
+void ParallelFor(int64_t first, int64_t last, double cost_per_unit,
+                 const std::function<void(int64_t, int64_t)>& fn) {
+  if (first >= last)
+    return;
+
+  const int64_t range = last - first;
+  auto& pool = WorkStealingThreadPool::DefaultPool();
+
+  // A shard that runs for less than the submission plus wake-up latency costs
+  // more to dispatch than to execute inline, so shards are sized to cover at
+  // least this much estimated work on the nanosecond scale of cost_per_unit.
+  constexpr double kMinCostPerShard = 20000.0;
+
+  const double total_cost = std::max(cost_per_unit, 1.0) * static_cast<double>(range);
+  int64_t shards = static_cast<int64_t>(pool.NumThreads()) + 1;
+  shards = std::min(shards, static_cast<int64_t>(total_cost / kMinCostPerShard));
+  shards = std::min(shards, range);
+
+  // a per-run parallelism cap gets no benefit from more shards than lanes
+  const auto cap = static_cast<int64_t>(CurrentThreadMaxParallelism());
+  if (cap > 0)
+    shards = std::min(shards, cap);
+
+  if (shards <= 1) {
+    fn(first, last);
+    return;
+  }
+
+  const int64_t per_shard = range / shards;
+  const int64_t remainder = range % shards;
+  pool.ExecuteInParallel(
+      [&](std::size_t shard) {
+        const auto index = static_cast<int64_t>(shard);
+        const int64_t begin = first + index * per_shard + std::min(index, remainder);
+        const int64_t end = begin + per_shard + (index < remainder ? 1 : 0);
+        fn(begin, end);
+      },
+      static_cast<std::size_t>(shards));
+}
+
+}  // namespace onnxruntime
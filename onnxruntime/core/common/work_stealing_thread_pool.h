@@ -0,0 +1,220 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+/*
+A work-stealing replacement for TaskThreadPool.
+
+TaskThreadPool funnels every submission and every dequeue through a single
+std::mutex/condition_variable pair, which becomes the dominant cost when many
+small tasks are scheduled from many cores at once. This pool instead gives
+every worker thread its own lock-free task queue:
+
+  - submission picks a queue round-robin and pushes with a compare-and-swap,
+    so concurrent submitters do not serialize on one lock;
+  - a worker pops from its own queue first and steals from its peers when
+    its queue is empty;
+  - workers spin briefly looking for work before parking on a condition
+    variable, so the futex only comes into play when the pool is idle.
+
+Tasks carry a priority class. Each worker owns one queue per class and always
+drains high priority work (its own and stolen) before touching normal
+priority queues, so when the pool is shared by several sessions a high
+priority submission overtakes queued normal work at the next task boundary.
+A task that is already running is never interrupted.
+
+The task submission interface mirrors TaskThreadPool (packaged_task based so
+exceptions propagate through the returned futures) to allow callers such as
+ParallelExecutor to switch between the two implementations.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+
+/// Scheduling class for submitted tasks. Workers pick up kHigh tasks before
+/// any queued kNormal work; preemption happens between tasks only, a running
+/// task always completes.
+enum class TaskPriority : int {
+  kNormal = 0,
+  kHigh = 1,
+};
+
+/// RAII scope capping how many pool lanes parallel work started from the
+/// current thread may occupy. While the scope is active, ExecuteInParallel
+/// runs its iterations on at most max_parallelism threads (counting the
+/// caller), and tasks submitted to any WorkStealingThreadPool inherit the cap,
+/// so work a capped run fans out to the pool stays capped transitively. A
+/// value of 0 means no cap. Scopes nest; destruction restores the previous
+/// cap.
+class ParallelismCapScope {
+ public:
+  explicit ParallelismCapScope(std::size_t max_parallelism) noexcept;
+  ~ParallelismCapScope();
+
+ private:
+  ONNXRUNTIME_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ParallelismCapScope);
+  std::size_t previous_;
+};
+
+/// The cap installed on the current thread by the innermost active
+/// ParallelismCapScope; 0 when uncapped.
+std::size_t CurrentThreadMaxParallelism() noexcept;
+
+/// True while the current thread is executing an iteration of an
+/// ExecuteInParallel batch (a worker lane or the calling thread's inline
+/// share). Parallel work started in this state runs inline rather than being
+/// dispatched, and the MLAS threading shim uses this to drop to a single
+/// thread inside such a region.
+bool CurrentThreadInParallelRegion() noexcept;
+
+/// Run fn over subranges of [first, last) on the default pool, honoring any
+/// active ParallelismCapScope. cost_per_unit is the approximate cost of one
+/// iteration in nanoseconds; it sizes the subranges so each covers enough work
+/// to amortize dispatch, and ranges too small to shard run inline on the
+/// calling thread. This backs OpKernelContext::ParallelFor; helpers that have
+/// no kernel context at hand call it directly.
+void ParallelFor(int64_t first, int64_t last, double cost_per_unit,
+                 const std::function<void(int64_t, int64_t)>& fn);
+
+class WorkStealingThreadPool {
+ public:
+  /// @brief Construct a pool with the given number of worker threads. When
+  /// affinity_masks is non-empty, worker i is pinned to the logical
+  /// processors in affinity_masks[i % affinity_masks.size()].
+  explicit WorkStealingThreadPool(std::size_t pool_size,
+                                  const std::vector<uint64_t>& affinity_masks = std::vector<uint64_t>());
+
+  ~WorkStealingThreadPool();
+
+  /// @brief Submit a task. Never blocks the caller on a pool-wide lock.
+  void RunTask(std::packaged_task<void()>&& task, TaskPriority priority = TaskPriority::kNormal);
+
+  /// @brief Submit a task which receives the index of the worker running it.
+  void RunTaskWithID(std::packaged_task<void(std::size_t)>&& task,
+                     TaskPriority priority = TaskPriority::kNormal);
+
+  /// @brief Wait until every submitted task has finished running.
+  /// Invalid if the pool is shared and other users may still be submitting.
+  void WaitWorkComplete();
+
+  /// @brief Run fn(0) .. fn(iterations - 1) across the pool, executing one
+  /// iteration inline on the calling thread, and wait for all of them.
+  /// Submission is allocation free: the iterations share one stack-resident
+  /// state block instead of a packaged_task/future pair each. Exceptions from
+  /// any iteration are rethrown on the calling thread once all have finished.
+  void ExecuteInParallel(const std::function<void(std::size_t)>& fn, std::size_t iterations);
+
+  std::size_t NumThreads() const { return threads_.size(); }
+
+  /// @brief Process-wide pool shared by components without a session context,
+  /// e.g. the MLAS threading shim. Sized to the hardware concurrency.
+  static WorkStealingThreadPool& DefaultPool();
+
+ private:
+  ONNXRUNTIME_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(WorkStealingThreadPool);
+
+  // Shared state of one ExecuteInParallel call. It lives on the calling
+  // thread's stack for the duration of the call; queued iterations carry a
+  // pointer to it plus their index, so submitting an iteration allocates
+  // nothing.
+  struct BatchState {
+    const std::function<void(std::size_t)>* fn{nullptr};
+    std::atomic<std::size_t> remaining{0};
+    std::exception_ptr exception;  // first exception raised, guarded by mutex
+    std::mutex mutex;
+    std::condition_variable cv;
+    // capped batches: lanes claim iteration indices from next until all
+    // iterations are taken, so the batch never occupies more than the capped
+    // number of threads. remaining then counts lanes instead of iterations.
+    std::atomic<std::size_t> next{0};
+    std::size_t iterations{0};
+  };
+
+  struct TaskElement {
+    bool run_with_id{false};
+    std::packaged_task<void()> no_id;
+    std::packaged_task<void(std::size_t)> with_id;
+    BatchState* batch{nullptr};
+    std::size_t batch_index{0};
+    std::size_t submitter_cap{0};  // parallelism cap inherited from the submitting thread
+
+    TaskElement() = default;
+    TaskElement(TaskElement&&) = default;
+    TaskElement& operator=(TaskElement&&) = default;
+
+    explicit TaskElement(std::packaged_task<void()>&& f)
+        : run_with_id(false), no_id(std::move(f)) {}
+
+    explicit TaskElement(std::packaged_task<void(std::size_t)>&& f)
+        : run_with_id(true), with_id(std::move(f)) {}
+
+    TaskElement(BatchState* state, std::size_t index)
+        : batch(state), batch_index(index) {}
+  };
+
+  // Bounded multi-producer/multi-consumer lock-free queue (Vyukov style).
+  // Each cell carries a sequence number that encodes whether it is ready to
+  // be written or read, so producers and consumers synchronize with a single
+  // compare-and-swap on their respective cursor.
+  class TaskQueue {
+   public:
+    explicit TaskQueue(std::size_t capacity);
+
+    bool TryPush(TaskElement&& task);
+    bool TryPop(TaskElement& task);
+
+   private:
+    ONNXRUNTIME_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(TaskQueue);
+
+    struct Cell {
+      std::atomic<std::size_t> sequence;
+      TaskElement task;
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    std::size_t mask_;
+    std::atomic<std::size_t> enqueue_pos_{0};
+    std::atomic<std::size_t> dequeue_pos_{0};
+  };
+
+  void Submit(TaskElement&& task, TaskPriority priority);
+  bool TryGetTask(std::size_t worker_index, TaskElement& task);
+  void MainLoop(std::size_t index);
+  static void RunBatchTask(TaskElement& task);
+  static void ClaimBatchIterations(BatchState& state);
+
+  // one queue per worker per priority class; TryGetTask scans
+  // high_queues_ in full before looking at queues_.
+  std::vector<std::unique_ptr<TaskQueue>> queues_;
+  std::vector<std::unique_ptr<TaskQueue>> high_queues_;
+  std::vector<std::thread> threads_;
+
+  std::atomic<std::size_t> next_queue_{0};
+  std::atomic<std::size_t> pending_{0};    // submitted, not yet popped
+  std::atomic<std::size_t> in_flight_{0};  // submitted, not yet finished
+  std::atomic<bool> running_{true};
+
+  // Only touched when a worker has exhausted its spin budget or when the
+  // pool is idle; the hot submit/pop paths stay off these.
+  std::mutex wake_mutex_;
+  std::condition_variable wake_cv_;
+  std::atomic<std::size_t> num_idle_{0};
+
+  std::mutex completed_mutex_;
+  std::condition_variable completed_cv_;
+};
+
+}  // namespace onnxruntime
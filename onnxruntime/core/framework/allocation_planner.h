@@ -23,6 +23,13 @@ class ISequentialPlannerContext {
  public:
   virtual const ONNX_NAMESPACE::TensorShapeProto* GetShape(const onnxruntime::NodeArg& arg) const = 0;
   virtual bool EnableParallelExecution() const { return false; }
+  // byte budget for peak activation memory; when positive the planner may
+  // schedule cheap nodes for recompute to stay under it. 0 disables this.
+  virtual int64_t ActivationMemoryBudget() const { return 0; }
+  // when true the planner reorders the nodes (within dependency constraints)
+  // with a lifetime-aware heuristic that minimizes modeled peak memory,
+  // instead of taking the graph's default topological order.
+  virtual bool ReorderExecutionForMemory() const { return false; }
 };
 
 class SequentialPlannerContext : public ISequentialPlannerContext {
@@ -35,6 +42,18 @@ class SequentialPlannerContext : public ISequentialPlannerContext {
       : m_enable_parallel_execution(p_enable_parallel_execution) {
   }
 
+  SequentialPlannerContext(bool p_enable_parallel_execution, int64_t activation_memory_budget)
+      : m_enable_parallel_execution(p_enable_parallel_execution),
+        m_activation_memory_budget(activation_memory_budget) {
+  }
+
+  SequentialPlannerContext(bool p_enable_parallel_execution, int64_t activation_memory_budget,
+                           bool reorder_execution_for_memory)
+      : m_enable_parallel_execution(p_enable_parallel_execution),
+        m_activation_memory_budget(activation_memory_budget),
+        m_reorder_execution_for_memory(reorder_execution_for_memory) {
+  }
+
   const ONNX_NAMESPACE::TensorShapeProto* GetShape(const onnxruntime::NodeArg& arg) const override {
     return arg.Shape();
   }
@@ -43,8 +62,18 @@ class SequentialPlannerContext : public ISequentialPlannerContext {
     return m_enable_parallel_execution;
   }
 
+  int64_t ActivationMemoryBudget() const override {
+    return m_activation_memory_budget;
+  }
+
+  bool ReorderExecutionForMemory() const override {
+    return m_reorder_execution_for_memory;
+  }
+
  private:
   bool m_enable_parallel_execution;
+  int64_t m_activation_memory_budget{0};
+  bool m_reorder_execution_for_memory{false};
 };
 
 class SequentialPlanner {
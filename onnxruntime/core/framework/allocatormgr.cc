@@ -3,6 +3,9 @@
 
 #include "core/framework/allocatormgr.h"
 #include "core/framework/bfc_arena.h"
+#include "core/platform/thread_affinity.h"
+#include <cstdlib>
+#include <cstring>
 #include <mutex>
 #include <sstream>
 #include <unordered_map>
@@ -26,4 +29,66 @@ DeviceAllocatorRegistry& DeviceAllocatorRegistry::Instance() {
   return s_instance;
 }
 
+void* NumaNodeAllocator::Alloc(size_t size) {
+  if (size == 0)
+    return nullptr;
+
+  uint64_t node_mask = GetNumaNodeAffinityMask(numa_node_);
+  uint64_t previous_mask = node_mask != 0 ? GetCurrentThreadAffinityMask() : 0;
+  bool rebound = previous_mask != 0 && previous_mask != node_mask &&
+                 SetCurrentThreadAffinityMask(node_mask);
+
+  void* p = malloc(size);
+  if (p != nullptr && rebound) {
+    // commit the pages while running on the target node; freshly mapped
+    // pages land on the node that first touches them. one write per page is
+    // enough for placement, so skip the full memset - callers get
+    // uninitialized memory from every other allocator too.
+    constexpr size_t kPageSize = 4096;
+    volatile char* bytes = static_cast<volatile char*>(p);
+    for (size_t offset = 0; offset < size; offset += kPageSize) {
+      bytes[offset] = 0;
+    }
+  }
+
+  if (rebound) {
+    SetCurrentThreadAffinityMask(previous_mask);
+  }
+  return p;
+}
+
+void NumaNodeAllocator::Free(void* p) {
+  free(p);
+}
+
+const ONNXRuntimeAllocatorInfo& NumaNodeAllocator::Info() const {
+  static constexpr ONNXRuntimeAllocatorInfo numa_allocator_info(CPU, ONNXRuntimeAllocatorType::ONNXRuntimeDeviceAllocator);
+  return numa_allocator_info;
+}
+
+ArenaPtr SharedArenaRegistry::GetOrCreateArena(const std::string& name, const DeviceAllocatorRegistrationInfo& info,
+                                               int device_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  auto key = std::make_pair(name, device_id);
+  auto it = shared_arenas_.find(key);
+  if (it != shared_arenas_.end())
+    return it->second;
+
+  auto device_allocator = std::unique_ptr<IDeviceAllocator>(info.factory(device_id));
+  ArenaPtr arena;
+  if (device_allocator->AllowsArena())
+    arena = std::make_shared<BFCArena>(std::move(device_allocator), info.max_mem);
+  else
+    arena = std::make_shared<DummyArena>(std::move(device_allocator));
+
+  shared_arenas_.emplace(std::move(key), arena);
+  return arena;
+}
+
+SharedArenaRegistry& SharedArenaRegistry::Instance() {
+  static SharedArenaRegistry s_instance;
+  return s_instance;
+}
+
 }  // namespace onnxruntime
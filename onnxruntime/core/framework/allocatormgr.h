@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <mutex>
+#include <unordered_map>
+
 #include "core/common/common.h"
 #include "core/framework/arena.h"
 
@@ -39,4 +42,114 @@ class DeviceAllocatorRegistry {
   std::map<std::string, DeviceAllocatorRegistrationInfo> device_allocator_registrations_;
 };
 
+// CPU allocator whose allocations are resident on a chosen NUMA node.
+// Placement relies on the kernel's first-touch policy: Alloc commits the
+// pages while the calling thread is temporarily rebound to the node's
+// processors, so no NUMA library is required. When the node's processors
+// cannot be resolved the result degrades to a plain CPU allocation. Reports
+// the standard CPU allocator info, so tensors on such a buffer look like any
+// other CPU tensor.
+class NumaNodeAllocator : public IAllocator {
+ public:
+  explicit NumaNodeAllocator(int numa_node) : numa_node_(numa_node) {}
+
+  void* Alloc(size_t size) override;
+  void Free(void* p) override;
+  const ONNXRuntimeAllocatorInfo& Info() const override;
+
+ private:
+  int numa_node_;
+};
+
+// Per-session view of an arena shared with other sessions. Every call is
+// forwarded to the underlying arena; on top of that the accountant tracks the
+// bytes currently held through this instance and the peak they have reached,
+// so usage of a shared arena can still be attributed to individual sessions.
+class SessionArenaAccountant : public IArenaAllocator {
+ public:
+  explicit SessionArenaAccountant(ArenaPtr arena) : arena_(std::move(arena)) {}
+
+  void* Alloc(size_t size) override {
+    void* p = arena_->Alloc(size);
+    Record(p, size);
+    return p;
+  }
+
+  void* Reserve(size_t size) override {
+    void* p = arena_->Reserve(size);
+    Record(p, size);
+    return p;
+  }
+
+  void Free(void* p) override {
+    if (p != nullptr) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = outstanding_.find(p);
+      if (it != outstanding_.end()) {
+        session_used_ -= it->second;
+        outstanding_.erase(it);
+      }
+    }
+    arena_->Free(p);
+  }
+
+  size_t Used() const override { return arena_->Used(); }
+  size_t Max() const override { return arena_->Max(); }
+  const ONNXRuntimeAllocatorInfo& Info() const override { return arena_->Info(); }
+
+  // bytes currently held through this session
+  size_t SessionUsed() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return session_used_;
+  }
+
+  // high-water mark of bytes held through this session
+  size_t SessionPeak() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return session_peak_;
+  }
+
+ private:
+  ONNXRUNTIME_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SessionArenaAccountant);
+
+  void Record(void* p, size_t size) {
+    if (p == nullptr)
+      return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    outstanding_[p] = size;
+    session_used_ += size;
+    if (session_used_ > session_peak_)
+      session_peak_ = session_used_;
+  }
+
+  ArenaPtr arena_;
+  mutable std::mutex mutex_;
+  std::unordered_map<void*, size_t> outstanding_;
+  size_t session_used_{0};
+  size_t session_peak_{0};
+};
+
+// Environment-scoped registry of arenas shared across sessions. Execution
+// providers that opt in receive the one arena registered for their
+// (name, device) pair instead of growing a private arena per session, so many
+// sessions on the same device draw from a single size-capped pool. Callers
+// should wrap the result in a SessionArenaAccountant to keep per-session
+// usage visible.
+class SharedArenaRegistry {
+ public:
+  // Returns the shared arena for (name, device_id), creating it from 'info'
+  // on first use. 'info.max_mem' caps the arena only at creation; later
+  // callers share whatever cap the creating session chose.
+  ArenaPtr GetOrCreateArena(const std::string& name, const DeviceAllocatorRegistrationInfo& info, int device_id = 0);
+
+  static SharedArenaRegistry& Instance();
+
+ private:
+  SharedArenaRegistry() = default;
+  ONNXRUNTIME_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SharedArenaRegistry);
+
+  std::mutex mutex_;
+  std::map<std::pair<std::string, int>, ArenaPtr> shared_arenas_;
+};
+
 }  // namespace onnxruntime
@@ -3,13 +3,23 @@
 
 #include "core/framework/bfc_arena.h"
 
+#include <atomic>
+
+#include "core/framework/environment.h"
+
 namespace onnxruntime {
+
+// Source of arena ids for GetThreadCache. Never reused, so thread-local entries
+// of a destroyed arena can not be matched by a newly constructed one.
+static std::atomic<uint64_t> next_arena_id{0};
+
 BFCArena::BFCArena(std::unique_ptr<IDeviceAllocator> resource_allocator,
                    size_t total_memory)
     : device_allocator_(std::move(resource_allocator)),
       free_chunks_list_(kInvalidChunkHandle),
       next_allocation_id_(1),
-      info_(device_allocator_->Info().name, ONNXRuntimeAllocatorType::ONNXRuntimeArenaAllocator, device_allocator_->Info().id, device_allocator_->Info().mem_type) {
+      info_(device_allocator_->Info().name, ONNXRuntimeAllocatorType::ONNXRuntimeArenaAllocator, device_allocator_->Info().id, device_allocator_->Info().mem_type),
+      arena_id_(next_arena_id++) {
   curr_region_allocation_bytes_ = RoundedBytes(std::min(total_memory, size_t{1048576}));
 
   // Allocate the requested amount of memory.
@@ -32,9 +42,18 @@ BFCArena::BFCArena(std::unique_ptr<IDeviceAllocator> resource_allocator,
       ONNXRUNTIME_ENFORCE(BinForSize(bin_size * 2) != BinFromIndex(b));
     }
   }
+
+  // A host agent's pressure notification trims this arena along with every
+  // other one in the process.
+  memory_pressure_token_ =
+      Environment::RegisterMemoryPressureHandler([this]() { ShrinkToFit(); });
 }
 
 BFCArena::~BFCArena() {
+  // Blocks until a notification that is mid-trim has finished, so no handler
+  // can touch the arena once teardown starts.
+  Environment::UnregisterMemoryPressureHandler(memory_pressure_token_);
+
   for (const auto& region : region_manager_.regions()) {
     device_allocator_->Free(region.ptr());
   }
@@ -159,8 +178,64 @@ size_t BFCArena::RoundedBytes(size_t bytes) {
   return rounded_bytes;
 }
 
+BFCArena::ThreadCache& BFCArena::GetThreadCache() {
+  static thread_local std::unordered_map<uint64_t, ThreadCache*> caches;
+  ThreadCache*& cache = caches[arena_id_];
+  if (cache == nullptr) {
+    std::lock_guard<std::mutex> lock(lock_);
+    thread_caches_.push_back(std::make_unique<ThreadCache>());
+    cache = thread_caches_.back().get();
+  }
+  return *cache;
+}
+
+void BFCArena::FlushThreadCache(ThreadCache& cache) {
+  // Detach the free lists first; lock_ must never be taken while holding a cache
+  // mutex.
+  std::array<std::vector<void*>, ThreadCache::kNumSizeClasses> free_lists;
+  {
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    free_lists.swap(cache.free_lists);
+    cache.cached_bytes = 0;
+  }
+
+  std::lock_guard<std::mutex> lock(lock_);
+  for (auto& free_list : free_lists) {
+    for (void* p : free_list) {
+      tracked_allocs_.erase(p);
+      DeallocateRawInternal(p);
+    }
+  }
+}
+
 void* BFCArena::Alloc(size_t size) {
-  return AllocateRawInternal(size, false);
+  if (size == 0) {
+    return AllocateRawInternal(size, false, nullptr, nullptr);
+  }
+
+  size_t rounded_bytes = RoundedBytes(size);
+  ThreadCache& cache = GetThreadCache();
+
+  if (rounded_bytes <= ThreadCache::kMaxCachedChunkSize) {
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    auto& free_list = cache.free_lists[rounded_bytes / kMinAllocationSize - 1];
+    if (!free_list.empty()) {
+      void* p = free_list.back();
+      free_list.pop_back();
+      cache.cached_bytes -= rounded_bytes;
+      cache.outstanding[p] = rounded_bytes;
+      ++cache.num_allocs;
+      return p;
+    }
+  }
+
+  size_t chunk_size = 0;
+  void* p = AllocateRawInternal(size, false, &cache, &chunk_size);
+  if (p != nullptr && chunk_size != 0) {
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.outstanding[p] = chunk_size;
+  }
+  return p;
 }
 
 void* BFCArena::Reserve(size_t size) {
@@ -196,7 +271,9 @@ size_t BFCArena::AllocatedSize(const void* ptr) {
 }
 
 void* BFCArena::AllocateRawInternal(size_t num_bytes,
-                                    bool dump_log_on_failure) {
+                                    bool dump_log_on_failure,
+                                    ThreadCache* thread_cache,
+                                    size_t* chunk_size) {
   if (num_bytes == 0) {
     LOGS_DEFAULT(WARNING) << "tried to allocate 0 bytes";
     return nullptr;
@@ -211,16 +288,21 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
 
   std::lock_guard<std::mutex> lock(lock_);
   void* ptr = FindChunkPtr(bin_num, rounded_bytes, num_bytes);
-  if (ptr != nullptr) {
-    return ptr;
+  if (ptr == nullptr && Extend(rounded_bytes)) {
+    ptr = FindChunkPtr(bin_num, rounded_bytes, num_bytes);
   }
 
-  // Try to extend
-  if (Extend(rounded_bytes)) {
-    ptr = FindChunkPtr(bin_num, rounded_bytes, num_bytes);
-    if (ptr != nullptr) {
-      return ptr;
+  if (ptr != nullptr) {
+    // Let the calling thread's cache track cacheable chunks, so that a free of
+    // this pointer on the same thread can bypass lock_.
+    if (thread_cache != nullptr) {
+      Chunk* chunk = ChunkFromHandle(region_manager_.get_handle(ptr));
+      if (chunk->size <= ThreadCache::kMaxCachedChunkSize) {
+        tracked_allocs_[ptr] = thread_cache;
+        *chunk_size = chunk->size;
+      }
     }
+    return ptr;
   }
 
   // We searched all bins for an existing free chunk to use and
@@ -236,8 +318,40 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
 }
 
 void BFCArena::GetStats(AllocatorStats* stats) {
+  // Flush the calling thread's cache so the in-use numbers reflect everything this
+  // thread has freed. Chunks cached by other threads still count as in use.
+  FlushThreadCache(GetThreadCache());
+
   std::lock_guard<std::mutex> lock(lock_);
   *stats = stats_;
+  for (const auto& cache : thread_caches_) {
+    std::lock_guard<std::mutex> cache_lock(cache->mutex);
+    stats->num_allocs += cache->num_allocs;
+  }
+}
+
+void BFCArena::GetFragmentationStats(ArenaFragmentationStats* stats) {
+  // Chunks held in thread caches count as in use; flush the calling thread's
+  // cache so its holdings show up as free space.
+  FlushThreadCache(GetThreadCache());
+
+  std::lock_guard<std::mutex> lock(lock_);
+  stats->Clear();
+  for (const auto& region : region_manager_.regions()) {
+    stats->reserved_bytes += region.memory_size();
+  }
+  // every free chunk sits in exactly one bin
+  for (BinNum bin_num = 0; bin_num < kNumBins; bin_num++) {
+    Bin* b = BinFromIndex(bin_num);
+    for (const ChunkHandle h : b->free_chunks) {
+      const Chunk* chunk = ChunkFromHandle(h);
+      stats->free_bytes += chunk->size;
+      stats->num_free_chunks++;
+      if (static_cast<int64_t>(chunk->size) > stats->largest_free_chunk_bytes) {
+        stats->largest_free_chunk_bytes = chunk->size;
+      }
+    }
+  }
 }
 
 void* BFCArena::FindChunkPtr(BinNum bin_num, size_t rounded_bytes,
@@ -328,6 +442,32 @@ void BFCArena::Free(void* p) {
   if (p == nullptr) {
     return;
   }
+
+  // If the pointer is one this thread's cache handed out, park the chunk in the
+  // cache's free lists without touching lock_.
+  ThreadCache& cache = GetThreadCache();
+  bool parked_in_cache = false;
+  {
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    auto cached = cache.outstanding.find(p);
+    if (cached != cache.outstanding.end()) {
+      const size_t chunk_size = cached->second;
+      cache.outstanding.erase(cached);
+      cache.free_lists[chunk_size / kMinAllocationSize - 1].push_back(p);
+      cache.cached_bytes += chunk_size;
+      if (cache.cached_bytes <= ThreadCache::kMaxCachedBytes) {
+        return;
+      }
+      parked_in_cache = true;
+    }
+  }
+
+  if (parked_in_cache) {
+    // The cache grew past its limit; hand everything back to the bins.
+    FlushThreadCache(cache);
+    return;
+  }
+
   std::lock_guard<std::mutex> lock(lock_);
   auto it = reserved_chunks_.find(p);
   if (it != reserved_chunks_.end()) {
@@ -336,6 +476,15 @@ void BFCArena::Free(void* p) {
     stats_.total_allocated_bytes -= it->second;
     reserved_chunks_.erase(it);
   } else {
+    // The pointer may have been allocated on another thread; invalidate that
+    // cache's record before handing the chunk back to the bins.
+    auto tracked = tracked_allocs_.find(p);
+    if (tracked != tracked_allocs_.end()) {
+      ThreadCache* owner = tracked->second;
+      tracked_allocs_.erase(tracked);
+      std::lock_guard<std::mutex> owner_lock(owner->mutex);
+      ONNXRUNTIME_ENFORCE(owner->outstanding.erase(p) > 0);
+    }
     DeallocateRawInternal(p);
   }
 }
@@ -347,6 +496,71 @@ void BFCArena::DeallocateRawInternal(void* ptr) {
 
   // Consider coalescing it.
   FreeAndMaybeCoalesce(h);
+
+  if (free_region_trim_threshold_ != 0 &&
+      stats_.total_allocated_bytes - stats_.bytes_in_use >=
+          static_cast<int64_t>(free_region_trim_threshold_)) {
+    ReleaseFreeRegions();
+  }
+}
+
+size_t BFCArena::ShrinkToFit() {
+  // Chunks parked in thread caches look in-use to the arena and would pin
+  // their regions. Snapshot the cache list under lock_, then flush each cache
+  // without holding lock_ (FlushThreadCache takes it per pointer batch).
+  std::vector<ThreadCache*> caches;
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    caches.reserve(thread_caches_.size());
+    for (const auto& cache : thread_caches_) {
+      caches.push_back(cache.get());
+    }
+  }
+  for (ThreadCache* cache : caches) {
+    FlushThreadCache(*cache);
+  }
+
+  std::lock_guard<std::mutex> lock(lock_);
+  return ReleaseFreeRegions();
+}
+
+size_t BFCArena::ReleaseFreeRegions() {
+  // A region whose chunk at the base pointer spans the whole extent has
+  // coalesced back into a single free chunk and nothing in it is live.
+  // Removing a region shifts the vector behind regions(), so collect first.
+  std::vector<void*> free_region_ptrs;
+  size_t released_bytes = 0;
+  for (const auto& region : region_manager_.regions()) {
+    ChunkHandle h = region_manager_.get_handle(region.ptr());
+    if (h == kInvalidChunkHandle) {
+      continue;
+    }
+    const Chunk* c = ChunkFromHandle(h);
+    if (!c->in_use() && c->size == region.memory_size()) {
+      free_region_ptrs.push_back(region.ptr());
+      released_bytes += region.memory_size();
+    }
+  }
+
+  for (void* ptr : free_region_ptrs) {
+    ChunkHandle h = region_manager_.get_handle(ptr);
+    const size_t region_bytes = ChunkFromHandle(h)->size;
+    RemoveFreeChunkFromBin(h);
+    DeleteChunk(h);
+    region_manager_.RemoveAllocationRegion(ptr);
+    device_allocator_->Free(ptr);
+    stats_.total_allocated_bytes -= static_cast<int64_t>(region_bytes);
+  }
+
+  if (released_bytes != 0) {
+    // Restart the doubling schedule so the next Extend reserves a modest
+    // region instead of jumping straight back to the old peak.
+    curr_region_allocation_bytes_ =
+        RoundedBytes(std::min(memory_limit_, size_t{1048576}));
+    LOGS_DEFAULT(INFO) << "BFCArena " << info_.name << " released "
+                       << released_bytes << " bytes back to the device allocator";
+  }
+  return released_bytes;
 }
 
 // Merges h1 and h2 when Chunk(h1)->next is h2 and Chunk(h2)->prev is c1.
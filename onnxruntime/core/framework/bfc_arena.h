@@ -71,6 +71,26 @@ struct AllocatorStats {
   }
 };
 
+// Snapshot of an arena's free space, taken under the arena lock. The gap
+// between reserved_bytes and free_bytes + bytes in use is allocator
+// bookkeeping; a large free_bytes with a small largest_free_chunk_bytes
+// indicates fragmentation.
+struct ArenaFragmentationStats {
+  int64_t reserved_bytes;            // total bytes reserved from the device allocator
+  int64_t free_bytes;                // bytes sitting in free chunks
+  int64_t largest_free_chunk_bytes;  // biggest single allocation currently servable
+  int64_t num_free_chunks;
+
+  ArenaFragmentationStats() { Clear(); }
+
+  void Clear() {
+    this->reserved_bytes = 0;
+    this->free_bytes = 0;
+    this->largest_free_chunk_bytes = 0;
+    this->num_free_chunks = 0;
+  }
+};
+
 // A memory allocator that implements a 'best-fit with coalescing'
 // algorithm.  This is essentially a very simple version of Doug Lea's
 // malloc (dlmalloc).
@@ -114,12 +134,33 @@ class BFCArena : public IArenaAllocator {
 
   void GetStats(AllocatorStats* stats);
 
+  void GetFragmentationStats(ArenaFragmentationStats* stats);
+
+  // Returns every region that has coalesced back into a single free chunk to
+  // the device allocator and reports the number of bytes released. Flushes
+  // every thread's cached chunks first so an idle worker's cache cannot pin a
+  // region. Safe to call concurrently with allocation; runs automatically
+  // when Environment::NotifyMemoryPressure fires.
+  size_t ShrinkToFit();
+
+  // When non-zero, a free that leaves the arena holding at least this many
+  // unused bytes releases fully-free regions back to the device allocator, so
+  // a long-lived worker gives peak-size regions back between large requests.
+  // Zero (the default) keeps the historical grow-only behavior.
+  void SetFreeRegionTrimThreshold(size_t bytes) {
+    std::lock_guard<std::mutex> lock(lock_);
+    free_region_trim_threshold_ = bytes;
+  }
+
   size_t RequestedSize(const void* ptr);
 
   size_t AllocatedSize(const void* ptr);
 
  private:
-  void* AllocateRawInternal(size_t num_bytes, bool dump_log_on_failure);
+  struct ThreadCache;
+
+  void* AllocateRawInternal(size_t num_bytes, bool dump_log_on_failure,
+                            ThreadCache* thread_cache, size_t* chunk_size);
   void DeallocateRawInternal(void* ptr);
 
   // A ChunkHandle is an index into the chunks_ vector in BFCAllocator
@@ -218,6 +259,46 @@ class BFCArena : public IArenaAllocator {
   static const size_t kMinAllocationBits = 8;
   static const size_t kMinAllocationSize = 1 << kMinAllocationBits;
 
+  // A cache of recently freed small chunks, owned by a single executor thread and
+  // layered over the bins in the style of tcmalloc's thread caches. A matching
+  // Alloc/Free pair on one thread is served from the cache's free lists without
+  // taking lock_. Chunks held in a cache stay marked in-use from the arena's point
+  // of view, so stats_ counts them as allocated until the cache is flushed;
+  // GetStats flushes the calling thread's cache so single-threaded statistics
+  // remain exact.
+  struct ThreadCache {
+    // Chunks above this size always go through the bins.
+    static const size_t kMaxCachedChunkSize = 64 * 1024;
+
+    // Flush the free lists back to the bins when they hold more than this.
+    static const size_t kMaxCachedBytes = 4 * 1024 * 1024;
+
+    static const size_t kNumSizeClasses = kMaxCachedChunkSize / kMinAllocationSize;
+
+    // Guards the members below. Uncontended when the owning thread allocates and
+    // frees; taken by another thread only to invalidate an entry when it frees a
+    // pointer that this cache handed out (and by GetStats).
+    std::mutex mutex;
+
+    // Chunk sizes of the cacheable pointers handed out to the owning thread.
+    std::unordered_map<const void*, size_t> outstanding;
+
+    // Free chunks indexed by exact chunk size: size / kMinAllocationSize - 1.
+    std::array<std::vector<void*>, kNumSizeClasses> free_lists;
+
+    size_t cached_bytes = 0;
+
+    // Number of allocations served from free_lists, merged into the arena-wide
+    // num_allocs by GetStats.
+    int64_t num_allocs = 0;
+  };
+
+  // Returns the calling thread's cache for this arena, creating it on first use.
+  ThreadCache& GetThreadCache();
+
+  // Returns all chunks held in the cache's free lists back to the bins.
+  void FlushThreadCache(ThreadCache& cache);
+
   // AllocationRegion maps pointers to ChunkHandles for a single
   // contiguous memory region.
   //
@@ -313,6 +394,14 @@ class BFCArena : public IArenaAllocator {
     }
     void erase(const void* p) { return MutableRegionFor(p)->erase(p); }
 
+    void RemoveAllocationRegion(void* ptr) {
+      auto entry =
+          std::upper_bound(regions_.begin(), regions_.end(), ptr, &Comparator);
+      ONNXRUNTIME_ENFORCE(entry != regions_.end() && entry->ptr() == ptr,
+                          "Could not find region to remove for ", ptr);
+      regions_.erase(entry);
+    }
+
     const std::vector<AllocationRegion>& regions() const { return regions_; }
 
    private:
@@ -379,6 +468,10 @@ class BFCArena : public IArenaAllocator {
   // Removes the chunk metadata represented by 'h'.
   void DeleteChunk(ChunkHandle h);
 
+  // Hands every region that consists of one whole free chunk back to the
+  // device allocator. Caller must hold lock_. Returns the bytes released.
+  size_t ReleaseFreeRegions();
+
   void DumpMemoryLog(size_t num_bytes);
 
   ChunkHandle AllocateChunk();
@@ -478,6 +571,27 @@ class BFCArena : public IArenaAllocator {
 
   std::unordered_map<void*, size_t> reserved_chunks_;
 
+  // Thread caches created for this arena. The cache objects have to outlive any
+  // reference from tracked_allocs_, so the arena owns them; threads only keep a
+  // raw pointer in thread-local storage.
+  std::vector<std::unique_ptr<ThreadCache>> thread_caches_;
+
+  // Maps every pointer currently tracked by some thread cache to that cache, so a
+  // free from a different thread can invalidate the owning cache's record before
+  // the chunk goes back to the bins. Guarded by lock_.
+  std::unordered_map<const void*, ThreadCache*> tracked_allocs_;
+
+  // Distinguishes arenas in thread-local storage. Ids are never reused, so stale
+  // entries of a destroyed arena can not be picked up by a new one.
+  const uint64_t arena_id_;
+
+  // See SetFreeRegionTrimThreshold. Guarded by lock_.
+  size_t free_region_trim_threshold_ = 0;
+
+  // Token for the ShrinkToFit handler this arena keeps registered with
+  // Environment::RegisterMemoryPressureHandler.
+  uint64_t memory_pressure_token_ = 0;
+
   ONNXRUNTIME_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(BFCArena);
 };
 #ifdef __GNUC__
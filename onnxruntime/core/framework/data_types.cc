@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/framework/data_types.h"
+#include "core/framework/sparse_tensor.h"
 #include "core/framework/tensor.h"
 #include "core/graph/onnx_protobuf.h"
 
@@ -499,6 +500,8 @@ void RegisterAllProtos(const std::function<void(MLDataType)>& reg_fn) {
 
   REGISTER_ONNX_PROTO(VectorMapStringToFloat, reg_fn);
   REGISTER_ONNX_PROTO(VectorMapInt64ToFloat, reg_fn);
+
+  REGISTER_ONNX_PROTO(SparseTensorCSR, reg_fn);
 }
 }  // namespace data_types_internal
 
@@ -2,6 +2,11 @@
 // Licensed under the MIT License.
 
 #include "core/framework/environment.h"
+
+#include <map>
+#include <mutex>
+
+#include "core/common/work_stealing_thread_pool.h"
 #include "core/framework/allocatormgr.h"
 #include "core/graph/constants.h"
 #include "core/graph/contrib_ops/contrib_defs.h"
@@ -85,6 +90,25 @@ Internal copy node
         .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
         .SetDoc(R"DOC(
 Internal copy node
+)DOC");
+
+    ONNXRUNTIME_ATTRIBUTE_UNUSED ONNX_OPERATOR_SCHEMA(BatchedMemcpyFromHost)
+        .Input(0, "inputs", "inputs", "T", OpSchema::Variadic)
+        .Output(0, "outputs", "outputs", "T", OpSchema::Variadic)
+        .TypeConstraint(
+            "T",
+            OpSchema::all_tensor_types(),
+            "Constrain to any tensor type. If the dtype attribute is not provided this must be a valid output type.")
+        .TypeAndShapeInferenceFunction([](InferenceContext& ctx) {
+          for (size_t i = 0; i < ctx.getNumInputs(); ++i) {
+            propagateElemTypeFromInputToOutput(ctx, i, i);
+            if (hasInputShape(ctx, static_cast<int>(i)))
+              propagateShapeFromInputToOutput(ctx, static_cast<int>(i), static_cast<int>(i));
+          }
+        })
+        .SetDoc(R"DOC(
+Internal copy node that packs several small host tensors into one staging
+transfer and scatters them on the device
 )DOC");
 
     // Register contributed schemas.
@@ -101,6 +125,65 @@ Internal copy node
   return status;
 }
 
+WorkStealingThreadPool& Environment::GetSessionGroupThreadPool(const std::string& group_name,
+                                                               std::size_t pool_size,
+                                                               const std::vector<uint64_t>& affinity_masks) {
+  // group pools outlive any single session: a group typically hosts sessions
+  // that come and go for the lifetime of the process, so the registry is
+  // process-wide rather than per Environment instance.
+  static std::mutex pools_mutex;
+  static std::map<std::string, std::unique_ptr<WorkStealingThreadPool>> pools;
+
+  std::lock_guard<std::mutex> lock(pools_mutex);
+  auto it = pools.find(group_name);
+  if (it == pools.end()) {
+    it = pools.emplace(group_name,
+                       std::make_unique<WorkStealingThreadPool>(pool_size, affinity_masks))
+             .first;
+  }
+  return *it->second;
+}
+
+namespace {
+// Handlers outlive any Environment instance for the same reason the group
+// pools above do: arenas register in their constructors, which may run
+// before an Environment exists.
+struct MemoryPressureRegistry {
+  std::mutex mutex;
+  std::map<uint64_t, std::function<void()>> handlers;
+  uint64_t next_token = 1;
+};
+
+MemoryPressureRegistry& GetMemoryPressureRegistry() {
+  static MemoryPressureRegistry registry;
+  return registry;
+}
+}  // namespace
+
+uint64_t Environment::RegisterMemoryPressureHandler(std::function<void()> handler) {
+  auto& registry = GetMemoryPressureRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  const uint64_t token = registry.next_token++;
+  registry.handlers.emplace(token, std::move(handler));
+  return token;
+}
+
+void Environment::UnregisterMemoryPressureHandler(uint64_t token) {
+  auto& registry = GetMemoryPressureRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.handlers.erase(token);
+}
+
+void Environment::NotifyMemoryPressure() {
+  auto& registry = GetMemoryPressureRegistry();
+  // The mutex is held across the calls so UnregisterMemoryPressureHandler
+  // blocks until a handler that is mid-run has finished.
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  for (auto& entry : registry.handlers) {
+    entry.second();
+  }
+}
+
 Environment::~Environment() {
   ::google::protobuf::ShutdownProtobufLibrary();
 }
@@ -22,44 +22,243 @@ ExecutionFrame::ExecutionFrame(const std::unordered_map<std::string, MLValue>& f
   auto* graph = session_state.GetGraphViewer();
   ONNXRUNTIME_ENFORCE(graph);
   Init(*graph, feeds, output_names, fetches);
+  SetupMemoryPatterns(feeds);
+  SetupShapeBindings(feeds);
+}
+
+ExecutionFrame::~ExecutionFrame() {
+  // feed the scratch usage of this run back into the session so later runs
+  // (and further reuses of this frame shape) size the arena chunk up front.
+  if (scratch_arena_)
+    session_state_.UpdateScratchBufferHighWaterMark(scratch_arena_->HighWaterMark());
+}
+
+void ExecutionFrame::EnableScratchArena() {
+  if (scratch_arena_)
+    return;
+
+  auto* cpu_provider = session_state_.GetExecutionProviders().Get(kCpuExecutionProvider);
+  if (cpu_provider == nullptr)
+    return;
+
+  AllocatorPtr cpu_allocator = cpu_provider->GetAllocator(0, ONNXRuntimeMemTypeDefault);
+  if (!cpu_allocator)
+    return;
 
+  scratch_arena_ = std::make_unique<ScratchBufferArena>(std::move(cpu_allocator),
+                                                        session_state_.GetScratchBufferHighWaterMark());
+}
+
+void ExecutionFrame::SetupMemoryPatterns(const std::unordered_map<std::string, MLValue>& feeds) {
   // If the session enable memory pattern optimization
   // and we have execution plan generated, try to setup
   // memory pattern optimization.
-  if (session_state.GetEnableMemoryPattern() &&
-      session_state.GetExecutionPlan()) {
-    std::vector<TensorShape> input_shapes;
-    bool all_tensors = true;
-    for (const auto& feed : feeds) {
-      if (!(feed.second.IsTensor())) {
-        all_tensors = false;
-        break;
-      }
-      auto& tensor = feed.second.Get<Tensor>();
-      input_shapes.push_back(tensor.Shape());
+  if (!session_state_.GetEnableMemoryPattern() ||
+      !session_state_.GetExecutionPlan()) {
+    return;
+  }
+
+  std::vector<TensorShape> input_shapes;
+  bool all_tensors = true;
+  for (const auto& feed : feeds) {
+    if (!(feed.second.IsTensor())) {
+      all_tensors = false;
+      break;
     }
-    // if there is some traditional ml value type in inputs
-    // disable the memory pattern optimization.
-    if (all_tensors) {
-      mem_patterns_ = session_state.GetMemoryPatternGroup(input_shapes);
-      // if no existing patterns, generate one in this executionframe
-      if (!mem_patterns_) {
-        planner_ = std::make_unique<MLValuePatternPlanner>(*session_state.GetExecutionPlan());
-      } else {
-        // pre-allocate the big chunk requested in memory pattern.
-        // all the internal kernel's input/output tensors will be allocated on these buffer.
-        for (size_t i = 0; i < mem_patterns_->locations.size(); i++) {
-          ONNXRUNTIME_ENFORCE(buffers_.find(mem_patterns_->locations[i]) == buffers_.end());
-          AllocatorPtr alloc = GetAllocator(mem_patterns_->locations[i]);
-          void* buffer = mem_patterns_->patterns[i].PeakSize() > 0 ? alloc->Alloc(mem_patterns_->patterns[i].PeakSize()) : nullptr;
-          buffers_[mem_patterns_->locations[i]] = BufferUniquePtr(buffer, alloc);
-        }
+    auto& tensor = feed.second.Get<Tensor>();
+    input_shapes.push_back(tensor.Shape());
+  }
+  // if there is some traditional ml value type in inputs
+  // disable the memory pattern optimization.
+  if (!all_tensors)
+    return;
+
+  auto mem_patterns = session_state_.GetMemoryPatternGroup(input_shapes);
+  // if no existing patterns, generate one in this executionframe
+  if (!mem_patterns) {
+    mem_patterns_ = nullptr;
+    buffers_.clear();
+    planner_ = std::make_unique<MLValuePatternPlanner>(*session_state_.GetExecutionPlan());
+    return;
+  }
+
+  // with shape bucketing, keep tracing the allocations so the cached
+  // pattern can grow to cover the largest shapes seen in the bucket.
+  if (session_state_.GetMemoryPatternShapeBucketSize() > 0) {
+    planner_ = std::make_unique<MLValuePatternPlanner>(*session_state_.GetExecutionPlan());
+  } else {
+    planner_ = nullptr;
+  }
+
+  // on reuse the cache entry is usually unchanged, in which case the big
+  // chunk allocated for it is still the right size and is kept as-is.
+  if (mem_patterns == mem_patterns_)
+    return;
+
+  mem_patterns_ = std::move(mem_patterns);
+  buffers_.clear();
+  // pre-allocate the big chunk requested in memory pattern.
+  // all the internal kernel's input/output tensors will be allocated on these buffer.
+  for (size_t i = 0; i < mem_patterns_->locations.size(); i++) {
+    ONNXRUNTIME_ENFORCE(buffers_.find(mem_patterns_->locations[i]) == buffers_.end());
+    AllocatorPtr alloc = GetAllocator(mem_patterns_->locations[i]);
+    void* buffer = mem_patterns_->patterns[i].PeakSize() > 0 ? alloc->Alloc(mem_patterns_->patterns[i].PeakSize()) : nullptr;
+    buffers_[mem_patterns_->locations[i]] = BufferUniquePtr(buffer, alloc);
+  }
+}
+
+void ExecutionFrame::SetupShapeBindings(const std::unordered_map<std::string, MLValue>& feeds) {
+  std::vector<TensorShape> input_shapes;
+  for (const auto& feed : feeds) {
+    // non-tensor inputs carry no shape; the cache only handles all-tensor feeds.
+    if (!(feed.second.IsTensor())) {
+      shape_bindings_ = nullptr;
+      recording_shape_bindings_ = nullptr;
+      return;
+    }
+    input_shapes.push_back(feed.second.Get<Tensor>().Shape());
+  }
+
+  auto bindings = session_state_.GetShapeBindings(input_shapes);
+  if (bindings) {
+    shape_bindings_ = std::move(bindings);
+    recording_shape_bindings_ = nullptr;
+    return;
+  }
+
+  shape_bindings_ = nullptr;
+
+  // unseen shape tuple: record the derived shape state of this run so later
+  // runs with these shapes skip the shape arithmetic. recording is skipped
+  // once the cache is full.
+  if (!session_state_.ShapeBindingCacheAcceptsEntries()) {
+    recording_shape_bindings_ = nullptr;
+    return;
+  }
+
+  auto* graph = session_state_.GetGraphViewer();
+  recording_shape_bindings_ = std::make_unique<ShapeBindings>();
+  recording_shape_bindings_->input_shapes = std::move(input_shapes);
+  for (const auto& feed : feeds) {
+    recording_shape_bindings_->named_input_shapes[feed.first] = feed.second.Get<Tensor>().Shape();
+  }
+  recording_shape_bindings_->nodes.resize(graph ? graph->MaxNodeIndex() : 0);
+}
+
+std::unique_ptr<ShapeBindings> ExecutionFrame::TakeRecordedShapeBindings() {
+  if (recording_shape_bindings_) {
+    // capture the shapes of the fetched outputs so shape queries can answer
+    // exactly for input shape tuples the session has already run.
+    for (const auto& output : output_name_indices_) {
+      const MLValue& value = all_values_[output.second];
+      if (value.IsAllocated() && value.IsTensor()) {
+        recording_shape_bindings_->output_shapes[output.first] = value.Get<Tensor>().Shape();
       }
     }
   }
+  return std::move(recording_shape_bindings_);
+}
+
+Status ExecutionFrame::Reuse(const std::unordered_map<std::string, MLValue>& feeds,
+                             const std::vector<std::string>& output_names,
+                             const std::vector<MLValue>& fetches) {
+  if (feeds.size() != feed_indices_.size()) {
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                                   "Frame was created with ", feed_indices_.size(),
+                                   " feeds but is reused with ", feeds.size());
+  }
+  if (!fetches.empty() && fetches.size() != output_names.size()) {
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                                   "output_names vector size: ", output_names.size(),
+                                   " does not match that of fetches vector: ", fetches.size());
+  }
+
+  // drop the previous run's values. The initializers are restored below and
+  // the planned big chunk lives in buffers_, so this only releases the
+  // per-run tensors that did not land on the planned buffer.
+  std::fill(all_values_.begin(), all_values_.end(), MLValue());
+
+  for (const auto& entry : session_state_.GetInitializedTensors()) {
+    all_values_[entry.first] = entry.second;  // this copy should be cheap
+  }
+
+  // swap in the weight replicas local to this thread's NUMA node, if any.
+  if (const auto* numa_weights = session_state_.GetNumaLocalWeightOverrides()) {
+    for (const auto& entry : *numa_weights) {
+      all_values_[entry.first] = entry.second;
+    }
+  }
+
+  // apply the feeds through the indices resolved during Init.
+  for (const auto& feed_index : feed_indices_) {
+    auto it = feeds.find(feed_index.first);
+    if (it == feeds.end()) {
+      return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                                     "Frame cannot be reused without feed: ", feed_index.first);
+    }
+    all_values_[feed_index.second] = it->second;
+  }
+
+  // output_indices_ was built from the output names at construction, so it
+  // holds the pre-resolved index for each of them. Validate the caller kept
+  // the same names as a reused frame cannot change its output set.
+  auto& mlvalue_idx_map = session_state_.GetMLValueNameIdxMap();
+  for (size_t i = 0; i < output_names.size(); ++i) {
+    int mlvalue_idx;
+    ONNXRUNTIME_RETURN_IF_ERROR(mlvalue_idx_map.GetIdx(output_names[i], mlvalue_idx));
+    if (i >= output_indices_.size() || output_indices_[i] != mlvalue_idx) {
+      return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                                     "Frame cannot be reused with different output names.");
+    }
+    if (!fetches.empty()) {
+      all_values_[mlvalue_idx] = fetches.at(i);
+    }
+  }
+
+  // donations are scoped to a single run; the caller re-applies them when
+  // the next run donates as well.
+  donated_output_allocators_.clear();
+
+  SetupMemoryPatterns(feeds);
+  SetupShapeBindings(feeds);
+  return Status::OK();
 }
 
-ExecutionFrame::~ExecutionFrame() = default;
+Status ExecutionFrame::SetDonatedOutputAllocator(int mlvalue_index, AllocatorPtr allocator) {
+  if (allocator == nullptr) {
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                                   "Cannot donate a null allocator for mlvalue index ", mlvalue_index);
+  }
+
+  const SequentialExecutionPlan* p_seq_exec_plan = session_state_.GetExecutionPlan();
+  if (p_seq_exec_plan == nullptr || mlvalue_index < 0 ||
+      static_cast<size_t>(mlvalue_index) >= p_seq_exec_plan->allocation_plan.size()) {
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                                   "No allocation plan entry for donated output, mlvalue index ", mlvalue_index);
+  }
+
+  const auto& per_alloc_plan = p_seq_exec_plan->allocation_plan[mlvalue_index];
+  if (per_alloc_plan.alloc_kind != AllocKind::kAllocateOutput) {
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                                   "Output with mlvalue index ", mlvalue_index,
+                                   " is not freshly allocated by the plan and cannot take a donated buffer.");
+  }
+
+  // the donation redirects ownership, not placement: the producing kernel
+  // still writes through the planned device, so the donated allocator must
+  // live on it.
+  const auto& planned = per_alloc_plan.location;
+  const auto& donated_info = allocator->Info();
+  if (strcmp(planned.name, donated_info.name) != 0 || planned.id != donated_info.id ||
+      planned.mem_type != donated_info.mem_type) {
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                                   "Donated allocator location ", donated_info.ToString(),
+                                   " does not match the planned output location ", planned.ToString());
+  }
+
+  donated_output_allocators_[mlvalue_index] = allocator;
+  return Status::OK();
+}
 
 Status ExecutionFrame::AllocateMLValueTensorSelfOwnBuffer(int mlvalue_index,
                                                           const DataTypeImpl* element_type,
@@ -83,6 +282,18 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(int mlvalue_inde
     return Status::OK();
   }
   auto alloc = GetAllocator(location);
+
+  // a donated output is carved out of the caller's allocator; the donation
+  // was validated to target the same device, so only the owning allocator
+  // (and the arena/device flavor in the recorded location) changes.
+  ONNXRuntimeAllocatorInfo tensor_location = location;
+  if (!donated_output_allocators_.empty()) {
+    auto donated = donated_output_allocators_.find(mlvalue_index);
+    if (donated != donated_output_allocators_.end()) {
+      alloc = donated->second;
+      tensor_location = alloc->Info();
+    }
+  }
   size_t size;
   {
     int64_t len = shape.Size();
@@ -112,17 +323,27 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(int mlvalue_inde
       // if block not found, fall back to default behavior
       if (block) {
         auto it = buffers_.find(location);
+        // with shape bucketing the pattern is planned for the largest shapes
+        // seen in the bucket, so a smaller tensor may land in a larger block.
+        bool bucketed = session_state_.GetMemoryPatternShapeBucketSize() > 0;
+        bool block_fits = bucketed ? block->size_ >= size : block->size_ == size;
         // if the block is not correct, log message then fall back to default behavior
-        if (it != buffers_.end() && block->size_ == size) {
+        if (it != buffers_.end() && block_fits) {
           void* buffer = it->second.get();
           auto status = AllocateTensorWithPreAllocateBufferHelper(
               p_mlvalue, static_cast<void*>(static_cast<char*>(buffer) + block->offset_),
               element_type, location, shape);
+          // trace the allocation so a regenerated pattern stays complete.
+          TraceAllocate(mlvalue_index, size);
           return status;
         }
-        if (block->size_ != size) {
-          LOGS_DEFAULT(WARNING) << "For mlvalue with index: " << mlvalue_index << ", block in memory pattern size is: "
-                                << block->size_ << " but the actually size is: " << size << ", fall back to default allocation behavior";
+        if (!block_fits) {
+          // expected while a bucketed pattern has not yet grown to the largest
+          // shapes in the bucket, so only warn when matching exact shapes.
+          if (!bucketed) {
+            LOGS_DEFAULT(WARNING) << "For mlvalue with index: " << mlvalue_index << ", block in memory pattern size is: "
+                                  << block->size_ << " but the actually size is: " << size << ", fall back to default allocation behavior";
+          }
         } else if (it == buffers_.end()) {
           LOGS_DEFAULT(WARNING) << "For mlvalue with index: " << mlvalue_index << ", block not found in target loation. "
                                                                                   " fall back to default allocation behavior";
@@ -135,7 +356,7 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(int mlvalue_inde
   std::unique_ptr<Tensor> p_tensor = std::make_unique<Tensor>(element_type,
                                                               shape,
                                                               buffer,
-                                                              location,
+                                                              tensor_location,
                                                               alloc);
 
   p_mlvalue->Init(p_tensor.release(),
@@ -167,8 +388,8 @@ Status ExecutionFrame::AllocateTensorWithSelfOwnBuffer(const int index,
                                                        const ONNXRuntimeAllocatorInfo& location,
                                                        const TensorShape& shape,
                                                        bool create_fence) {
-  ONNXRUNTIME_ENFORCE(index >= 0 && static_cast<size_t>(index) < node_values_.size());
-  return AllocateMLValueTensorSelfOwnBufferHelper(node_values_[index], element_type, location, shape, create_fence);
+  ONNXRUNTIME_ENFORCE(index >= 0 && static_cast<size_t>(index) < node_values_->size());
+  return AllocateMLValueTensorSelfOwnBufferHelper((*node_values_)[index], element_type, location, shape, create_fence);
 }
 
 Status ExecutionFrame::AllocateMLValueTensorPreAllocateBuffer(int mlvalue_index_to_allocate,
@@ -222,18 +443,18 @@ Status ExecutionFrame::AllocateTensorWithPreAllocateBuffer(const int offset,
                                                            const DataTypeImpl* element_type,
                                                            const ONNXRuntimeAllocatorInfo& location,
                                                            const TensorShape& shape) {
-  ONNXRUNTIME_ENFORCE(offset >= 0 && offset < node_values_.size());
-  if (node_values_[offset] < 0)
+  ONNXRUNTIME_ENFORCE(offset >= 0 && static_cast<size_t>(offset) < node_values_->size());
+  if ((*node_values_)[offset] < 0)
     return Status(ONNXRUNTIME, FAIL, "Trying to allocate memory for unused optional inputs/outputs");
-  auto value = &all_values_[node_values_[offset]];
+  auto value = &all_values_[(*node_values_)[offset]];
   return AllocateTensorWithPreAllocateBufferHelper(value, pBuffer, element_type, location, shape);
 }
 
 void ExecutionFrame::Release(const int offset) {
-  ONNXRUNTIME_ENFORCE(offset >= 0 && offset < node_offsets_.size());
-  if (node_values_[offset] >= 0 && node_values_[offset] < all_values_.size()) {
-    all_values_[node_values_[offset]] = MLValue();
-    TraceFree(node_values_[offset]);
+  ONNXRUNTIME_ENFORCE(offset >= 0 && static_cast<size_t>(offset) < node_values_->size());
+  if ((*node_values_)[offset] >= 0 && static_cast<size_t>((*node_values_)[offset]) < all_values_.size()) {
+    all_values_[(*node_values_)[offset]] = MLValue();
+    TraceFree((*node_values_)[offset]);
   }
 }
 
@@ -312,12 +533,7 @@ void ExecutionFrame::Init(const onnxruntime::GraphViewer& graph,
                           const std::unordered_map<std::string, MLValue>& feeds,
                           const std::vector<std::string>& output_names,
                           const std::vector<MLValue>& fetches) {
-  // 1. resize the node_offsets and all_value_ vector
-  // We need to use the max index rather than number of nodes as we use Node.Index()
-  // when inserting into node_offsets_
-  auto max_node_index = graph.MaxNodeIndex();
-  node_offsets_.resize(max_node_index);
-
+  // 1. resize the all_value_ vector
   auto& mlvalue_idx_map = session_state_.GetMLValueNameIdxMap();
 
   all_values_.resize(mlvalue_idx_map.MaxIdx() + 1);
@@ -328,13 +544,23 @@ void ExecutionFrame::Init(const onnxruntime::GraphViewer& graph,
     all_values_[mlvalue_index] = entry.second;  // this copy should be cheap
   }
 
+  // swap in the weight replicas local to this thread's NUMA node, if any.
+  if (const auto* numa_weights = session_state_.GetNumaLocalWeightOverrides()) {
+    for (const auto& entry : *numa_weights) {
+      all_values_[entry.first] = entry.second;
+    }
+  }
+
   // 3. handle feed in values
+  feed_indices_.reserve(feeds.size());
   for (const auto& feed : feeds) {
     int mlvalue_idx;
     Status status = mlvalue_idx_map.GetIdx(feed.first, mlvalue_idx);
     ONNXRUNTIME_ENFORCE(status.IsOK(), status.ErrorMessage());
     // we are sharing the underline tensor/object for MLValue
     all_values_[mlvalue_idx] = feed.second;
+    // remember the resolution so Reuse() doesn't have to redo it.
+    feed_indices_.emplace_back(feed.first, mlvalue_idx);
   }
 
   // 4. Handle non-empty output vector
@@ -344,6 +570,7 @@ void ExecutionFrame::Init(const onnxruntime::GraphViewer& graph,
     Status status = mlvalue_idx_map.GetIdx(oname, mlvalue_idx);
     ONNXRUNTIME_ENFORCE(status.IsOK(), status.ErrorMessage());
     output_indices_.push_back(mlvalue_idx);
+    output_name_indices_.emplace_back(oname, mlvalue_idx);
   }
 
   if (!fetches.empty()) {
@@ -363,21 +590,35 @@ void ExecutionFrame::Init(const onnxruntime::GraphViewer& graph,
   }
 
   // 5. set node args
-  for (auto& node : graph.Nodes()) {
-    ONNXRUNTIME_ENFORCE(node.Index() < node_offsets_.size());
-    node_offsets_[node.Index()] = static_cast<int>(node_values_.size());
+  // these tables are graph-constant, so when the SessionState has finalized
+  // its execution plan info we share its copy instead of rebuilding them for
+  // every frame.
+  node_values_ = session_state_.GetNodeArgValueIndices();
+  node_offsets_ = session_state_.GetNodeArgOffsets();
+  if (node_values_ == nullptr || node_offsets_ == nullptr) {
+    // We need to use the max index rather than number of nodes as we use
+    // Node.Index() when inserting into owned_node_offsets_
+    owned_node_offsets_.resize(graph.MaxNodeIndex());
+
+    for (auto& node : graph.Nodes()) {
+      ONNXRUNTIME_ENFORCE(node.Index() < owned_node_offsets_.size());
+      owned_node_offsets_[node.Index()] = static_cast<int>(owned_node_values_.size());
+
+      for (auto input_def : node.InputDefs()) {
+        SetupNodeArg(input_def);
+      }
 
-    for (auto input_def : node.InputDefs()) {
-      SetupNodeArg(input_def);
-    }
+      for (auto input_def : node.ImplicitInputDefs()) {
+        SetupNodeArg(input_def);
+      }
 
-    for (auto input_def : node.ImplicitInputDefs()) {
-      SetupNodeArg(input_def);
+      for (auto output_def : node.OutputDefs()) {
+        SetupNodeArg(output_def);
+      }
     }
 
-    for (auto output_def : node.OutputDefs()) {
-      SetupNodeArg(output_def);
-    }
+    node_values_ = &owned_node_values_;
+    node_offsets_ = &owned_node_offsets_;
   }
 }
 
@@ -387,12 +628,12 @@ void ExecutionFrame::SetupNodeArg(const onnxruntime::NodeArg* arg) {
   //if the arg's name is empty, it is an not needed optional input/output
   //set index to -1
   if (name.empty()) {
-    node_values_.push_back(-1);
+    owned_node_values_.push_back(-1);
   } else {
     int index;
     Status status = session_state_.GetMLValueNameIdxMap().GetIdx(name, index);
     ONNXRUNTIME_ENFORCE(status.IsOK(), status.ErrorMessage());
-    node_values_.push_back(index);
+    owned_node_values_.push_back(index);
   }
 }
 
@@ -433,8 +674,8 @@ Status ExecutionFrame::GeneratePatterns(MemoryPatternGroup* out) const {
 
 // Return nullptr if index map to an value that is an unused optional input/output
 const MLValue* ExecutionFrame::GetNodeInputOrOutputMLValue(int index) const {
-  ONNXRUNTIME_ENFORCE(index >= 0 && static_cast<size_t>(index) < node_values_.size());
-  return node_values_[index] >= 0 ? &all_values_[node_values_[index]] : nullptr;
+  ONNXRUNTIME_ENFORCE(index >= 0 && static_cast<size_t>(index) < node_values_->size());
+  return (*node_values_)[index] >= 0 ? &all_values_[(*node_values_)[index]] : nullptr;
 }
 
 // Return nullptr if index map to an value that is an unused optional input/output
@@ -462,18 +703,18 @@ static inline void VerifyShape(const MLValue* p_mlvalue,
 Status ExecutionFrame::GetOrCreateNodeOutputMLValue(int index,
                                                     const MLValueAllocationParameters& parameters,
                                                     MLValue*& p_mlvalue) {
-  if (index < 0 || static_cast<size_t>(index) >= node_values_.size()) {
+  if (index < 0 || static_cast<size_t>(index) >= node_values_->size()) {
     return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
                   "Try to access with invalid node value index: " + std::to_string(index));
   }
 
   // return nullptr if it is optional
-  if (node_values_[index] < 0) {
+  if ((*node_values_)[index] < 0) {
     p_mlvalue = nullptr;
     return Status::OK();
   }
 
-  p_mlvalue = &all_values_.at(node_values_[index]);
+  p_mlvalue = &all_values_.at((*node_values_)[index]);
 
   if (p_mlvalue->IsAllocated()) {
     // The ml has already been allocated.
@@ -483,7 +724,7 @@ Status ExecutionFrame::GetOrCreateNodeOutputMLValue(int index,
   }
     // It's not allocated, then allocate it with given shape and return.
     // Perform allocation based on the allocation plan
-    ONNXRUNTIME_RETURN_IF_ERROR(AllocateAsPerAllocationPlan(node_values_[index], parameters));
+    ONNXRUNTIME_RETURN_IF_ERROR(AllocateAsPerAllocationPlan((*node_values_)[index], parameters));
     return Status::OK();
 }
 
@@ -9,7 +9,9 @@
 #include "core/common/logging/logging.h"
 #include "core/common/status.h"
 #include "core/framework/ml_value.h"
+#include "core/framework/scratch_buffer_arena.h"
 #include "core/framework/sequential_execution_plan.h"
+#include "core/framework/shape_bindings.h"
 #include "core/framework/tensor.h"
 #include "core/graph/graph_viewer.h"
 
@@ -81,14 +83,27 @@ class ExecutionFrame {
 
   // Index to the first argument of the given node.
   int GetFirstArgIndex(onnxruntime::NodeIndex index) const {
-    ONNXRUNTIME_ENFORCE(index < node_offsets_.size());
-    return node_offsets_[index];
+    ONNXRUNTIME_ENFORCE(index < node_offsets_->size());
+    return (*node_offsets_)[index];
   }
 
   // Return nullptr if index map to an value that is an unused optional input/output
   const MLValue* GetNodeInputOrOutputMLValue(int index) const;
   MLValue* GetMutableNodeInputOrOutputMLValue(int index);
 
+  // Raw views over the node-arg slot table and the value table, resolved
+  // once by OpKernelContext so each Input/Output access is two array
+  // indexations instead of a call back into the frame. Both tables keep a
+  // stable size for the lifetime of a run; a frame reuse rebuild only
+  // happens between runs, before any context is constructed.
+  const int* GetNodeArgValueIndicesData() const {
+    return node_values_->data();
+  }
+
+  MLValue* GetAllValuesData() {
+    return all_values_.data();
+  }
+
   // TO DO: make it thread safe
   // This method is not thread safe!
   // Return S_OK and nullptr if index map to an value that is an unused optional input/output
@@ -110,6 +125,83 @@ class ExecutionFrame {
     return planner_ != nullptr;
   }
 
+  // Hand over the planner holding the allocations traced by this run, so
+  // pattern generation can happen after the frame is gone (e.g. on a
+  // background task). The frame stops tracing once the planner is taken.
+  std::unique_ptr<MLValuePatternPlanner> TakePlanner() {
+    return std::move(planner_);
+  }
+
+  // Shape binding of the given node from the cached bindings of a previous
+  // run with the same input shapes. Returns nullptr when there is no cached
+  // entry or the node never recorded state.
+  const NodeShapeBinding* GetCachedShapeBinding(onnxruntime::NodeIndex node_index) const {
+    if (!shape_bindings_ || node_index >= shape_bindings_->nodes.size())
+      return nullptr;
+    return &shape_bindings_->nodes[node_index];
+  }
+
+  bool IsRecordingShapeBindings() const {
+    return recording_shape_bindings_ != nullptr;
+  }
+
+  // Record the shape state a kernel derived from its input shapes. Only
+  // valid while recording; concurrent kernels write disjoint slots so no
+  // locking is needed.
+  void RecordShapeBinding(onnxruntime::NodeIndex node_index,
+                          std::vector<TensorShape> input_shapes,
+                          std::shared_ptr<void> state) {
+    if (!recording_shape_bindings_ || node_index >= recording_shape_bindings_->nodes.size())
+      return;
+    auto& binding = recording_shape_bindings_->nodes[node_index];
+    binding.input_shapes = std::move(input_shapes);
+    binding.state = std::move(state);
+  }
+
+  // Hand the recorded bindings to the executor for publication into the
+  // SessionState cache once the run has completed. The shapes of the fetched
+  // outputs are captured into the bindings at this point.
+  std::unique_ptr<ShapeBindings> TakeRecordedShapeBindings();
+
+  // Activate the per-run scratch arena for kernel temporaries, sized from the
+  // high-water mark of previous runs. Only the sequential executor enables
+  // it: the arena is one bump pointer and must not be shared by concurrently
+  // executing kernels.
+  void EnableScratchArena();
+
+  // Borrow CPU scratch memory valid until RewindScratchArena(). Returns
+  // nullptr when the arena is not active; callers then fall back to their
+  // allocator.
+  void* GetScratchBuffer(size_t size) {
+    return scratch_arena_ ? scratch_arena_->Reserve(size) : nullptr;
+  }
+
+  // Reclaim all scratch reservations of the node that just completed.
+  void RewindScratchArena() {
+    if (scratch_arena_)
+      scratch_arena_->Rewind();
+  }
+
+  // Prepare this frame for another run over the same graph with the same
+  // feed and output names it was constructed with. The previous run's values
+  // are dropped and the new feeds/fetches are applied through the mlvalue
+  // indices resolved during construction, so none of the per-run metadata
+  // (node_values_, node_offsets_, the all_values_ vector itself) is rebuilt.
+  // When the cached memory pattern still matches the input shapes, the
+  // pre-allocated big chunk is kept as well, so reuse with fixed shapes does
+  // not allocate.
+  Status Reuse(const std::unordered_map<std::string, MLValue>& feeds,
+               const std::vector<std::string>& output_names,
+               const std::vector<MLValue>& fetches);
+
+  // Donate the buffer of the given fetched value: when the producing node
+  // allocates it, the memory comes from the caller's allocator instead of the
+  // planned one, so the fetch can feed another consumer (e.g. the next
+  // session in a chain) without a copy. The allocator must target the same
+  // device the plan placed the value on; only who owns the memory changes.
+  // Donations are per run — Reuse() drops them.
+  Status SetDonatedOutputAllocator(int mlvalue_index, AllocatorPtr allocator);
+
  private:
   ONNXRUNTIME_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ExecutionFrame);
 
@@ -130,6 +222,17 @@ class ExecutionFrame {
             const std::vector<std::string>& output_names,
             const std::vector<MLValue>& fetches);
 
+  // Look up (or re-validate) the cached memory pattern for the shapes of the
+  // given feeds and set up mem_patterns_ / planner_ / buffers_ accordingly.
+  // Called from the constructor and again on Reuse; the big chunk in
+  // buffers_ survives when the pattern is unchanged.
+  void SetupMemoryPatterns(const std::unordered_map<std::string, MLValue>& feeds);
+
+  // Look up the cached shape bindings for the shapes of the given feeds, or
+  // start recording a new set when this shape tuple has not been seen yet.
+  // Called from the constructor and again on Reuse.
+  void SetupShapeBindings(const std::unordered_map<std::string, MLValue>& feeds);
+
   void SetupNodeArg(const onnxruntime::NodeArg* arg);
 
   Status AllocateTensorWithPreAllocateBufferHelper(MLValue* p_mlvalue,
@@ -148,35 +251,71 @@ class ExecutionFrame {
 
   // The values for the inputs and outputs of the nodes.
   // This vector contains the indices into the all_values_ vector.
-  std::vector<int> node_values_;
+  // The tables are graph-constant; when the SessionState has finalized its
+  // execution plan info they point at its shared copy, otherwise at the
+  // owned_* fallbacks built during Init.
+  const std::vector<int>* node_values_ = nullptr;
 
   // All the intermediate values for the entire graph.
   // Input and Output values are passed in by executors
   std::vector<MLValue> all_values_;
 
   // The start index into node_values_ for all the nodes.
-  std::vector<int> node_offsets_;
+  const std::vector<int>* node_offsets_ = nullptr;
+
+  // fallback tables for a SessionState that hasn't finalized its execution
+  // plan info (e.g. one assembled by hand in tests).
+  std::vector<int> owned_node_values_;
+  std::vector<int> owned_node_offsets_;
 
   // i-th kernel is still waiting for pending_counts_[i] inputs.
   std::vector<int> pending_counts_;  // not used currently
 
   std::unordered_map<std::string, int> value_name_to_index_;
 
+  // Feed name to mlvalue index pairs resolved during Init, so a reused frame
+  // doesn't need to go back to the MLValueNameIdxMap for its feeds.
+  std::vector<std::pair<std::string, int>> feed_indices_;
+
   const ::onnxruntime::SessionState& session_state_;
 
   // If we already have cached memory pattern on these input shapes
   // Use this mem pattern that create a big chunk for all the internal
   // kernel's input/output tensors.
-  const MemoryPatternGroup* mem_patterns_;
+  // Shared ownership as the cache entry may be replaced while this frame
+  // is still executing when shape bucketing is enabled.
+  std::shared_ptr<const MemoryPatternGroup> mem_patterns_;
 
   // If no cached memory pattern, and we enable the memory pattern optimization
   // use this planner_ to trace the memory allocation in current executor.
   std::unique_ptr<MLValuePatternPlanner> planner_;
 
+  // Shape bindings of a previous run with the same input shapes, shared
+  // read-only from the SessionState cache.
+  std::shared_ptr<const ShapeBindings> shape_bindings_;
+
+  // When the input shapes have not been seen yet, kernels record their
+  // derived shape state here and the executor publishes it after the run.
+  std::unique_ptr<ShapeBindings> recording_shape_bindings_;
+
+  // Bump/rewind arena serving kernel scratch requests while this frame runs
+  // under the sequential executor. Its high-water mark is published to the
+  // SessionState on destruction so later runs reserve one right-sized chunk.
+  std::unique_ptr<ScratchBufferArena> scratch_arena_;
+
   // Record the ml value indices for output values. we won't include those
   // values' allocation in memory pattern, as they can't be shared.
   std::vector<int> output_indices_;
 
+  // Output name to mlvalue index pairs resolved during Init, so the recorded
+  // shape bindings can capture the fetched output shapes by name.
+  std::vector<std::pair<std::string, int>> output_name_indices_;
+
+  // Caller-donated allocators for fetched values, keyed by mlvalue index.
+  // Consulted when an output is allocated so the result lands directly in
+  // the donated memory.
+  std::unordered_map<int, AllocatorPtr> donated_output_allocators_;
+
   // Big chunks on different locations that will be used by mem_pattern.
   std::map<ONNXRuntimeAllocatorInfo, BufferUniquePtr> buffers_;
 };
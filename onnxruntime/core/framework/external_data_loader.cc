@@ -0,0 +1,178 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/external_data_loader.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#include "core/platform/env.h"
+
+using namespace ::onnxruntime::common;
+
+namespace onnxruntime {
+namespace utils {
+
+namespace {
+// Payloads at least this large are copied out of the file mapping by several
+// threads. The copy itself is memory bound, but the first touch of each mapped
+// page is a fault the kernel satisfies from disk, and touching disjoint ranges
+// concurrently keeps more of those reads in flight.
+constexpr size_t kParallelCopyThreshold = 64 * 1024 * 1024;
+constexpr size_t kParallelCopyChunk = 32 * 1024 * 1024;
+
+bool PathEscapesModelDirectory(const std::string& path) {
+  if (path.empty())
+    return true;
+  if (path[0] == '/' || path[0] == '\\')
+    return true;
+  if (path.size() > 1 && path[1] == ':')  // windows drive letter
+    return true;
+  for (size_t i = 0; i + 1 < path.size(); ++i) {
+    if (path[i] != '.' || path[i + 1] != '.')
+      continue;
+    const bool starts_segment = i == 0 || path[i - 1] == '/' || path[i - 1] == '\\';
+    const bool ends_segment = i + 2 == path.size() || path[i + 2] == '/' || path[i + 2] == '\\';
+    if (starts_segment && ends_segment)
+      return true;
+  }
+  return false;
+}
+
+bool ParseNonNegativeInt64(const std::string& text, int64_t& out) {
+  if (text.empty())
+    return false;
+  char* end = nullptr;
+  errno = 0;
+  const long long value = strtoll(text.c_str(), &end, 10);
+  if (errno != 0 || end != text.c_str() + text.size() || value < 0)
+    return false;
+  out = static_cast<int64_t>(value);
+  return true;
+}
+
+void ParallelCopy(void* dst, const void* src, size_t num_bytes) {
+  if (num_bytes < kParallelCopyThreshold) {
+    memcpy(dst, src, num_bytes);
+    return;
+  }
+
+  const size_t max_workers = static_cast<size_t>(std::max(1, Env::Default().GetNumCpuCores()));
+  const size_t num_chunks = std::min(max_workers,
+                                     (num_bytes + kParallelCopyChunk - 1) / kParallelCopyChunk);
+  const size_t chunk_size = (num_bytes + num_chunks - 1) / num_chunks;
+
+  std::vector<std::thread> workers;
+  workers.reserve(num_chunks);
+  for (size_t i = 0; i < num_chunks; ++i) {
+    const size_t begin = i * chunk_size;
+    if (begin >= num_bytes)
+      break;
+    const size_t size = std::min(chunk_size, num_bytes - begin);
+    workers.emplace_back([dst, src, begin, size]() {
+      memcpy(static_cast<char*>(dst) + begin, static_cast<const char*>(src) + begin, size);
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+}  // namespace
+
+bool HasExternalData(const ONNX_NAMESPACE::TensorProto& tensor_proto) {
+  return tensor_proto.has_data_location() &&
+         tensor_proto.data_location() == ONNX_NAMESPACE::TensorProto_DataLocation_EXTERNAL;
+}
+
+common::Status ParseExternalDataInfo(const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                                     ExternalDataInfo& info) {
+  info = ExternalDataInfo{};
+  for (const auto& entry : tensor_proto.external_data()) {
+    if (entry.key() == "location") {
+      info.relative_path = entry.value();
+    } else if (entry.key() == "offset") {
+      if (!ParseNonNegativeInt64(entry.value(), info.offset))
+        return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, INVALID_PROTOBUF,
+                                       "Invalid external data offset '", entry.value(),
+                                       "' for tensor ", tensor_proto.name());
+    } else if (entry.key() == "length") {
+      if (!ParseNonNegativeInt64(entry.value(), info.length))
+        return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, INVALID_PROTOBUF,
+                                       "Invalid external data length '", entry.value(),
+                                       "' for tensor ", tensor_proto.name());
+    }
+    // other keys, e.g. "checksum", are ignored
+  }
+
+  if (PathEscapesModelDirectory(info.relative_path)) {
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, INVALID_PROTOBUF,
+                                   "Invalid external data location '", info.relative_path,
+                                   "' for tensor ", tensor_proto.name(),
+                                   ": it must be a relative path within the model directory.");
+  }
+
+  return common::Status::OK();
+}
+
+common::Status ReadExternalDataForTensor(const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                                         const std::string& model_file_dir,
+                                         void* dst, size_t dst_size) {
+  ExternalDataInfo info;
+  ONNXRUNTIME_RETURN_IF_ERROR(ParseExternalDataInfo(tensor_proto, info));
+
+  if (info.length >= 0 && static_cast<size_t>(info.length) != dst_size) {
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, INVALID_PROTOBUF,
+                                   "External data length ", info.length, " for tensor ",
+                                   tensor_proto.name(), " does not match the tensor byte size ",
+                                   dst_size);
+  }
+
+  if (dst_size == 0) {
+    return common::Status::OK();
+  }
+
+  const std::string file_path = model_file_dir.empty()
+                                    ? info.relative_path
+                                    : model_file_dir + "/" + info.relative_path;
+
+  const void* mapped_base = nullptr;
+  size_t mapped_length = 0;
+  if (Env::Default().MapFileIntoMemory(file_path, mapped_base, mapped_length).IsOK()) {
+    if (static_cast<uint64_t>(info.offset) > mapped_length ||
+        mapped_length - static_cast<size_t>(info.offset) < dst_size) {
+      ONNXRUNTIME_IGNORE_RETURN_VALUE(Env::Default().UnmapFileFromMemory(mapped_base, mapped_length));
+      return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, INVALID_PROTOBUF,
+                                     "External data file '", file_path, "' is too small for tensor ",
+                                     tensor_proto.name(), ": needs ", dst_size, " bytes at offset ",
+                                     info.offset);
+    }
+    ParallelCopy(dst, static_cast<const char*>(mapped_base) + info.offset, dst_size);
+    ONNXRUNTIME_IGNORE_RETURN_VALUE(Env::Default().UnmapFileFromMemory(mapped_base, mapped_length));
+    return common::Status::OK();
+  }
+
+  // mapping can fail, e.g. on filesystems without mmap support; read in place instead
+  std::ifstream stream(file_path, std::ios::binary);
+  if (!stream) {
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, NO_SUCHFILE,
+                                   "Failed to open external data file '", file_path,
+                                   "' for tensor ", tensor_proto.name());
+  }
+  stream.seekg(info.offset);
+  stream.read(static_cast<char*>(dst), static_cast<std::streamsize>(dst_size));
+  if (stream.gcount() != static_cast<std::streamsize>(dst_size)) {
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, INVALID_PROTOBUF,
+                                   "External data file '", file_path, "' is too small for tensor ",
+                                   tensor_proto.name(), ": needs ", dst_size, " bytes at offset ",
+                                   info.offset);
+  }
+  return common::Status::OK();
+}
+
+}  // namespace utils
+}  // namespace onnxruntime
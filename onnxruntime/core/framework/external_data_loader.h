@@ -0,0 +1,48 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+
+#include "core/common/common.h"
+#include "core/common/status.h"
+#include "core/graph/onnx_protobuf.h"
+
+namespace onnxruntime {
+namespace utils {
+
+// Returns true if tensor_proto stores its payload in an external file
+// (TensorProto.data_location == EXTERNAL) instead of inline in the proto.
+// Models above protobuf's 2GB serialization limit carry their weights this way.
+bool HasExternalData(const ONNX_NAMESPACE::TensorProto& tensor_proto);
+
+// Reference to an externally stored tensor payload, parsed from the
+// TensorProto.external_data key/value entries.
+struct ExternalDataInfo {
+  std::string relative_path;  // "location": file path relative to the model file's directory
+  int64_t offset{0};          // "offset": byte position of the payload within the file
+  int64_t length{-1};         // "length": payload byte count; -1 when not recorded
+};
+
+// Parses and validates the external_data entries of tensor_proto. Absolute
+// paths and paths containing a '..' segment are rejected so a model cannot
+// reference files outside its own directory. Unrecognized keys (e.g.
+// "checksum") are ignored.
+common::Status ParseExternalDataInfo(const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                                     ExternalDataInfo& info);
+
+// Reads the externally stored payload of tensor_proto into the dst_size bytes
+// at dst, resolving the payload file relative to model_file_dir (the current
+// directory when empty). The file is mapped into memory via Env and large
+// payloads are copied out in parallel chunks, so the page-fault driven reads
+// of a multi-gigabyte weight overlap instead of streaming through one thread;
+// when mapping fails a plain positional read is used instead. dst is typically
+// arena or weight-store memory, so the bytes land in their final location
+// without an intermediate proto-owned copy.
+common::Status ReadExternalDataForTensor(const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                                         const std::string& model_file_dir,
+                                         void* dst, size_t dst_size);
+
+}  // namespace utils
+}  // namespace onnxruntime
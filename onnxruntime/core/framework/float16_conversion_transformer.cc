@@ -0,0 +1,212 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/float16_conversion_transformer.h"
+#include "core/framework/data_types.h"
+#include "core/util/math.h"
+
+#include <unordered_set>
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+bool IsFloatTensor(const onnxruntime::NodeArg* arg) {
+  return arg->Type() != nullptr &&
+         DataTypeImpl::TypeFromProto(*arg->TypeAsProto()) == DataTypeImpl::GetTensorType<float>();
+}
+
+bool IsFloat16Tensor(const onnxruntime::NodeArg* arg) {
+  return arg->Type() != nullptr &&
+         DataTypeImpl::TypeFromProto(*arg->TypeAsProto()) == DataTypeImpl::GetTensorType<MLFloat16>();
+}
+
+// Ops where the limited range/precision of float16 visibly hurts accuracy:
+// exponentials overflow half range easily and long reductions lose low-order
+// bits, so these stay in float32 and get Cast nodes at their boundaries.
+bool KeepsFloat32(const onnxruntime::Node& node) {
+  static const std::unordered_set<std::string> float32_ops{
+      "Softmax", "LogSoftmax", "Exp", "Log",
+      "ReduceSum", "ReduceMean", "ReduceProd", "ReduceLogSum", "ReduceLogSumExp",
+      "ReduceSumSquare", "ReduceL1", "ReduceL2"};
+  return float32_ops.count(node.OpType()) > 0;
+}
+
+// Cast nodes pick their types deliberately and a Constant's value attribute
+// fixes its output type, so neither participates in the conversion; their
+// consumers insert casts as for any other float32 producer.
+bool SkipsConversion(const onnxruntime::Node& node) {
+  return node.OpType() == "Cast" || node.OpType() == "Constant";
+}
+
+void FlipToFloat16(onnxruntime::NodeArg& arg) {
+  TypeProto type(*arg.TypeAsProto());
+  type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT16);
+  arg.SetType(type);
+}
+
+void ConvertInitializerToFloat16(const TensorProto& proto, TensorProto& converted) {
+  converted = proto;
+  converted.set_data_type(TensorProto_DataType_FLOAT16);
+
+  const float* src = nullptr;
+  size_t count = 0;
+  if (proto.has_raw_data()) {
+    src = reinterpret_cast<const float*>(proto.raw_data().data());
+    count = proto.raw_data().size() / sizeof(float);
+  } else {
+    src = proto.float_data().data();
+    count = proto.float_data_size();
+  }
+
+  std::string bytes(count * sizeof(uint16_t), '\0');
+  uint16_t* dst = reinterpret_cast<uint16_t*>(&bytes[0]);
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = math::floatToHalf(src[i]);
+  }
+
+  converted.clear_float_data();
+  converted.set_raw_data(std::move(bytes));
+}
+
+onnxruntime::NodeArg* GetOrAddCast(onnxruntime::Graph& graph,
+                                   onnxruntime::NodeArg* src,
+                                   TypeProto& new_type,
+                                   TensorProto_DataType to_type,
+                                   std::map<onnxruntime::NodeArg*, onnxruntime::NodeArg*>& cache) {
+  auto it = cache.find(src);
+  if (it != cache.end()) {
+    return it->second;
+  }
+
+  std::string name = graph.GenerateNodeName(src->Name() + "_cast");
+  auto* dst = &graph.GetOrCreateNodeArg(name, &new_type);
+  auto& cast_node = graph.AddNode(name, "Cast", "cast inserted by the float16 conversion",
+                                  std::vector<onnxruntime::NodeArg*>{src},
+                                  std::vector<onnxruntime::NodeArg*>{dst});
+  cast_node.AddAttribute("to", static_cast<int64_t>(to_type));
+  cache[src] = dst;
+  return dst;
+}
+}  // namespace
+
+Status Float16ConversionTransformer::Apply(onnxruntime::Graph& graph, bool& modified) const {
+  bool converted_any = false;
+
+  const std::unordered_set<const onnxruntime::NodeArg*> graph_outputs(graph.GetOutputs().cbegin(),
+                                                                      graph.GetOutputs().cend());
+
+  // The producer of a value decides its precision: every float32 output of a
+  // converted node flips to float16. Graph outputs keep their float32 type so
+  // the session's external interface is unchanged; the producing node gets a
+  // Cast back to float32 below.
+  for (auto& node : graph.Nodes()) {
+    if (SkipsConversion(node) || KeepsFloat32(node)) {
+      continue;
+    }
+    for (auto output : node.MutableOutputDefs()) {
+      if (IsFloatTensor(output) && graph_outputs.count(output) == 0) {
+        FlipToFloat16(*output);
+        converted_any = true;
+      }
+    }
+  }
+
+  // Initializers convert to float16 when every consumer computes in float16,
+  // so the weights are stored half-size and no cast runs at inference time.
+  // A weight also feeding a float32 op stays float32 and its float16
+  // consumers cast it instead.
+  std::unordered_set<const onnxruntime::NodeArg*> float16_consumers;
+  std::unordered_set<const onnxruntime::NodeArg*> float32_consumers;
+  for (auto& node : graph.Nodes()) {
+    if (SkipsConversion(node)) {
+      continue;
+    }
+    auto& consumers = KeepsFloat32(node) ? float32_consumers : float16_consumers;
+    for (auto input : node.InputDefs()) {
+      consumers.insert(input);
+    }
+  }
+
+  std::vector<std::string> initializers_to_convert;
+  for (const auto& entry : graph.GetAllInitializedTensors()) {
+    auto* arg = graph.GetNodeArg(entry.first);
+    if (arg == nullptr || !IsFloatTensor(arg) || graph_outputs.count(arg) > 0 ||
+        float32_consumers.count(arg) > 0 || float16_consumers.count(arg) == 0) {
+      continue;
+    }
+    initializers_to_convert.push_back(entry.first);
+  }
+
+  for (const auto& name : initializers_to_convert) {
+    const TensorProto* proto = nullptr;
+    ONNXRUNTIME_ENFORCE(graph.GetInitializedTensor(name, proto));
+    TensorProto converted;
+    ConvertInitializerToFloat16(*proto, converted);
+    graph.RemoveInitializedTensor(name);
+    graph.AddInitializedTensor(converted);
+    FlipToFloat16(*graph.GetNodeArg(name));
+    converted_any = true;
+  }
+
+  // Insert casts wherever a node now sees the wrong precision: float16 nodes
+  // fed by float32 values (graph inputs, kept-float32 producers, shared
+  // initializers) and float32 nodes fed by converted values. One cast per
+  // value per direction is shared by all its consumers.
+  GraphViewer graph_viewer(graph);
+  TypeProto float_16_tensor_proto, float_tensor_proto;
+  float_16_tensor_proto.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT16);
+  float_tensor_proto.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+
+  std::map<onnxruntime::NodeArg*, onnxruntime::NodeArg*> casts_to_float16;
+  std::map<onnxruntime::NodeArg*, onnxruntime::NodeArg*> casts_to_float32;
+
+  for (onnxruntime::NodeIndex i : graph_viewer.GetNodesInTopologicalOrder()) {
+    auto node = graph.GetNode(i);
+    if (node == nullptr || SkipsConversion(*node)) {
+      continue;
+    }
+
+    const bool keep_float32 = KeepsFloat32(*node);
+    std::map<const onnxruntime::NodeArg*, onnxruntime::NodeArg*> replacement_defs;
+
+    for (auto input : node->MutableInputDefs()) {
+      if (!keep_float32 && IsFloatTensor(input)) {
+        replacement_defs[input] = GetOrAddCast(graph, input, float_16_tensor_proto,
+                                               TensorProto_DataType_FLOAT16, casts_to_float16);
+        converted_any = true;
+      } else if (keep_float32 && IsFloat16Tensor(input)) {
+        replacement_defs[input] = GetOrAddCast(graph, input, float_tensor_proto,
+                                               TensorProto_DataType_FLOAT, casts_to_float32);
+        converted_any = true;
+      }
+    }
+
+    if (!keep_float32) {
+      for (auto output : node->MutableOutputDefs()) {
+        if (IsFloatTensor(output) && graph_outputs.count(output) > 0) {
+          // the node computes in float16 now; route its result through a new
+          // float16 value and cast back into the float32 graph output
+          std::string name = graph.GenerateNodeName(output->Name() + "_float16");
+          auto* new_arg = &graph.GetOrCreateNodeArg(name, &float_16_tensor_proto);
+          auto& cast_node = graph.AddNode(name, "Cast", "cast inserted by the float16 conversion",
+                                          std::vector<onnxruntime::NodeArg*>{new_arg},
+                                          std::vector<onnxruntime::NodeArg*>{output});
+          cast_node.AddAttribute("to", static_cast<int64_t>(TensorProto_DataType_FLOAT));
+          replacement_defs[output] = new_arg;
+          converted_any = true;
+        }
+      }
+    }
+
+    node->ReplaceDefs(replacement_defs);
+  }
+
+  if (converted_any) {
+    modified = true;
+    ONNXRUNTIME_RETURN_IF_ERROR(graph.Resolve());
+  }
+  return Status::OK();
+}
+}  // namespace onnxruntime
@@ -0,0 +1,26 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include "core/graph/graph_viewer.h"
+#include "core/graph/graph_transformer.h"
+#include "core/common/common.h"
+
+namespace onnxruntime {
+// Converts a float32 graph to float16 so the model can run on half precision
+// hardware (e.g. Volta tensor cores) without being re-exported. Initializers
+// are converted at load time, value types are flipped in place, and Cast
+// nodes are inserted so the graph inputs/outputs keep their float32 types and
+// numerically sensitive ops (softmax, reductions and friends) keep computing
+// in float32. Nodes that end up in float16 without a kernel are handled by
+// the regular InsertCastTransformer, which moves them back to float32 on CPU.
+class Float16ConversionTransformer : public onnxruntime::GraphTransformer {
+ public:
+  Float16ConversionTransformer()
+      : onnxruntime::GraphTransformer("Float16ConversionTransformer",
+                                      "Transformer to convert a float32 graph to float16") {
+  }
+
+  Status Apply(onnxruntime::Graph& graph, bool& modified) const override;
+};
+}  // namespace onnxruntime
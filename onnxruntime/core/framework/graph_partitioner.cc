@@ -3,6 +3,11 @@
 
 #include "core/framework/graph_partitioner.h"
 
+#include <cstdint>
+#include <fstream>
+#include <utility>
+#include <vector>
+
 #include "core/framework/kernel_registry_manager.h"
 #include "core/graph/function.h"
 #include "core/graph/graph_viewer.h"
@@ -54,6 +59,89 @@ KernelDefBuilder& BuildFusedKernelDef(KernelDefBuilder& builder, const onnxrunti
   return builder;
 }
 
+// FNV-1a over the bytes of <str> plus its terminator, folded into <hash>.
+static uint64_t HashString(const std::string& str, uint64_t hash) {
+  for (size_t i = 0; i <= str.size(); ++i) {
+    hash = (hash ^ static_cast<unsigned char>(str.c_str()[i])) * 1099511628211ULL;
+  }
+  return hash;
+}
+
+// Key identifying a partition result: the graph's node names/op types/domains
+// and the ordered provider list. Any change to either produces a different
+// key, so a cache written against a different model, provider set or provider
+// preference order is ignored.
+static uint64_t ComputePartitionCacheKey(const onnxruntime::Graph& graph,
+                                         const ExecutionProviders& providers) {
+  uint64_t key = 14695981039346656037ULL;
+  for (const auto& node : graph.Nodes()) {
+    key = HashString(node.Name(), key);
+    key = HashString(node.OpType(), key);
+    key = HashString(node.Domain(), key);
+  }
+  for (const auto& provider : providers) {
+    key = HashString(provider->Type(), key);
+  }
+  return key;
+}
+
+// Replays a cached node-to-provider assignment. Returns false (leaving the
+// graph untouched) when the file is missing, keyed against a different
+// model/provider combination, or malformed.
+static bool TryLoadPartitionCache(const std::string& cache_filepath,
+                                  uint64_t key,
+                                  onnxruntime::Graph& graph,
+                                  const ExecutionProviders& providers) {
+  std::ifstream file(cache_filepath);
+  if (!file) {
+    return false;
+  }
+
+  uint64_t stored_key;
+  if (!(file >> stored_key) || stored_key != key) {
+    return false;
+  }
+
+  // validate the whole file before assigning anything so a corrupt entry
+  // cannot leave the graph partially partitioned.
+  std::vector<std::pair<onnxruntime::NodeIndex, std::string>> assignments;
+  onnxruntime::NodeIndex index;
+  std::string provider_type;
+  while (file >> index >> provider_type) {
+    if (nullptr == graph.GetNode(index) || nullptr == providers.Get(provider_type)) {
+      return false;
+    }
+    assignments.emplace_back(index, provider_type);
+  }
+
+  if (assignments.empty()) {
+    return false;
+  }
+
+  for (const auto& assignment : assignments) {
+    graph.GetNode(assignment.first)->SetExecutionProviderType(assignment.second);
+  }
+  return true;
+}
+
+// Best effort: a cache that cannot be written simply means the next load
+// renegotiates capabilities again.
+static void SavePartitionCache(const std::string& cache_filepath,
+                               uint64_t key,
+                               const onnxruntime::Graph& graph) {
+  std::ofstream file(cache_filepath, std::ios::trunc);
+  if (!file) {
+    return;
+  }
+
+  file << key << "\n";
+  for (const auto& node : graph.Nodes()) {
+    if (!node.GetExecutionProviderType().empty()) {
+      file << node.Index() << " " << node.GetExecutionProviderType() << "\n";
+    }
+  }
+}
+
 Status GraphPartitioner::Partition(onnxruntime::Graph& graph) const {
   if (providers_.Empty()) {
     return Status(ONNXRUNTIME, INVALID_ARGUMENT, "No provider specified.");
@@ -61,8 +149,25 @@ Status GraphPartitioner::Partition(onnxruntime::Graph& graph) const {
   //fused_kernel_registry is prepareing the kernels created on the fly for fused sub graph.
   //It is only visiable for current session.
   std::shared_ptr<KernelRegistry> fused_kernel_registry = std::make_shared<KernelRegistry>();
+
+  uint64_t cache_key = 0;
+  if (!cache_filepath_.empty()) {
+    cache_key = ComputePartitionCacheKey(graph, providers_);
+    if (TryLoadPartitionCache(cache_filepath_, cache_key, graph, providers_)) {
+      // warm start: the stored assignment was computed against this exact
+      // graph and provider list, so it can be replayed without consulting
+      // any provider's GetCapability. Cached partitions never contain fused
+      // or inlined nodes (see the save condition below), so the fusion and
+      // inlining passes have nothing to do either.
+      ONNXRUNTIME_ENFORCE(graph.Resolve().IsOK());
+      kernel_registry_mgr_.RegisterKernelRegistry(fused_kernel_registry, KernelRegistryPriority::HighPriority);
+      return Status::OK();
+    }
+  }
+
   // Partitioning <graph> based on provider preference and their capabilities.
   auto kernel_registries = kernel_registry_mgr_.GetAllKernelRegistries();
+  bool fused_node_created = false;
   for (auto& provider : providers_) {
     auto capability_results = provider->GetCapability(GraphViewer(graph), kernel_registries);
     int count = 0;
@@ -88,6 +193,7 @@ Status GraphPartitioner::Partition(onnxruntime::Graph& graph) const {
         std::string node_name = provider->Type() + "_" + capability->sub_graph->GetMetaDef()->name + "_" + std::to_string(count++);
         auto& fused_node = graph.FuseSubGraph(std::move(capability->sub_graph), node_name);
         fused_node.SetExecutionProviderType(provider->Type());
+        fused_node_created = true;
         auto fused_kernel_func = capability->fuse_kernel_function;
         if (fused_kernel_func != nullptr) {
           // build the kernel definition on the fly, and register it to the fused_kernel_regisitry.
@@ -139,6 +245,14 @@ Status GraphPartitioner::Partition(onnxruntime::Graph& graph) const {
   }
 #endif
 
+  // Persist the final assignment so the next load of this model replays it
+  // instead of re-running capability negotiation. Fusion and inlining modify
+  // the graph while the partition is computed, so those results cannot be
+  // replayed onto a freshly loaded model and are not cached.
+  if (!cache_filepath_.empty() && !fused_node_created && !inline_flag) {
+    SavePartitionCache(cache_filepath_, cache_key, graph);
+  }
+
   kernel_registry_mgr_.RegisterKernelRegistry(fused_kernel_registry, KernelRegistryPriority::HighPriority);
 
   return Status::OK();
@@ -15,10 +15,17 @@ class KernelRegistryManager;
 class GraphPartitioner {
  public:
   //The order of providers represents the user preference.
+  // If <cache_filepath> is non-empty, the node-to-provider assignment is
+  // persisted there, keyed on the graph contents and the provider list, and
+  // later loads of the same model replay the stored assignment instead of
+  // re-running every provider's GetCapability negotiation. A file whose key
+  // does not match is ignored.
   GraphPartitioner(KernelRegistryManager& kernel_registry_mgr,
-                   const ExecutionProviders& providers)
+                   const ExecutionProviders& providers,
+                   const std::string& cache_filepath = std::string())
       : kernel_registry_mgr_(kernel_registry_mgr),
-        providers_(providers) {}
+        providers_(providers),
+        cache_filepath_(cache_filepath) {}
 
   Status Partition(onnxruntime::Graph& graph) const;
 
@@ -27,5 +34,6 @@ class GraphPartitioner {
 
   KernelRegistryManager& kernel_registry_mgr_;
   const ExecutionProviders& providers_;
+  const std::string cache_filepath_;
 };
 }  // namespace onnxruntime
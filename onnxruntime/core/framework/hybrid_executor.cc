@@ -0,0 +1,379 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/hybrid_executor.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+#include "core/common/common.h"
+#include "core/common/logging/logging.h"
+#include "core/common/work_stealing_thread_pool.h"
+#include "core/framework/allocation_planner.h"
+#include "core/framework/execution_frame.h"
+#include "core/framework/session_state.h"
+#include "core/framework/op_kernel_context_internal.h"
+
+namespace onnxruntime {
+
+// a parallel region costs a dispatch and a barrier, which two concurrent
+// nodes already cover; single-step regions always run inline.
+constexpr size_t kMinParallelRegionWidth = 2;
+
+static Status FetchOutput(const MLValueNameIdxMap& name_idx_map,
+                          ExecutionFrame& frame,
+                          const std::vector<std::string>& output_names,
+                          std::vector<MLValue>& fetches,
+                          const logging::Logger& logger);
+
+static Status ReleaseNodeMLValues(ExecutionFrame& frame,
+                                  const SequentialExecutionPlan& seq_exec_plan,
+                                  const SequentialExecutionPlan::NodeExecutionPlan& node_exec_plan,
+                                  const logging::Logger& logger);
+
+Status HybridExecutor::Execute(const SessionState& session_state,
+                               const NameMLValMap& feeds,
+                               const std::vector<std::string>& output_names,
+                               std::vector<MLValue>& fetches,
+                               const logging::Logger& logger) {
+  ExecutionFrame frame{feeds, output_names, fetches, session_state};
+
+  return Execute(session_state, frame, feeds, output_names, fetches, logger);
+}
+
+Status HybridExecutor::Execute(const SessionState& session_state,
+                               ExecutionFrame& frame,
+                               const NameMLValMap& feeds,
+                               const std::vector<std::string>& output_names,
+                               std::vector<MLValue>& fetches,
+                               const logging::Logger& logger) {
+  auto tp = session_state.Profiler().StartTime();
+  profiling::ScopedTraceTag trace_tag(&run_tag_);
+
+  LOGS(logger, INFO) << "Begin execution";
+
+  // the frame's bump arena is single threaded, so it stays disabled here;
+  // kernels take their temporaries from the allocator instead.
+
+  const SequentialExecutionPlan& seq_exec_plan = *session_state.GetExecutionPlan();
+  const auto& exec_plan_vec = seq_exec_plan.execution_plan;
+  const auto& regions = session_state.GetExecutionRegions();
+  auto* pool = session_state.GetThreadPool();
+  VLOGS(logger, 1) << "Size of execution plan vector: " << exec_plan_vec.size()
+                   << " in " << regions.size() << " regions";
+
+  // the region partition exists once the session state finalized its plan
+  // info; without it every step is its own region and execution is sequential.
+  std::vector<SessionState::ExecutionRegion> step_regions;
+  if (regions.empty() && !exec_plan_vec.empty()) {
+    step_regions.reserve(exec_plan_vec.size());
+    for (size_t step = 0; step < exec_plan_vec.size(); ++step) {
+      step_regions.push_back(SessionState::ExecutionRegion{step, step + 1});
+    }
+  }
+  const auto& region_list = regions.empty() ? step_regions : regions;
+
+  // a heterogeneous plan with coarse per-provider partitions runs one lane
+  // per provider instead of walking the merged plan order, so a CPU branch
+  // computes while the CUDA branch does; see RunLanes.
+  // every lane must be able to block at a join without starving the others
+  // of a thread, so one lane per pool thread plus the calling thread is the
+  // most that can run.
+  const auto& lanes = session_state.GetExecutionLanes();
+  if (pool != nullptr && lanes.size() >= 2 && lanes.size() <= pool->NumThreads() + 1) {
+    ONNXRUNTIME_RETURN_IF_ERROR(RunLanes(session_state, frame, logger));
+  } else {
+    for (const auto& region : region_list) {
+      if (cancellation_.IsCancelled()) {
+        LOGS(logger, WARNING) << cancellation_.Reason();
+        return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, cancellation_.Reason());
+      }
+
+      if (pool != nullptr && region.Width() >= kMinParallelRegionWidth) {
+        // the steps of the region are mutually independent, so dispatch them
+        // all and meet at the barrier before touching their shared values.
+        std::mutex status_mutex;
+        Status region_status = Status::OK();
+        pool->ExecuteInParallel(
+            [&](size_t index) {
+              auto status = RunStep(session_state, frame, region.begin_step + index, logger);
+              if (!status.IsOK()) {
+                std::lock_guard<std::mutex> lock(status_mutex);
+                if (region_status.IsOK()) {
+                  region_status = status;
+                }
+              }
+            },
+            region.Width());
+        ONNXRUNTIME_RETURN_IF_ERROR(region_status);
+      } else {
+        for (size_t step = region.begin_step; step < region.end_step; ++step) {
+          ONNXRUNTIME_RETURN_IF_ERROR(RunStep(session_state, frame, step, logger));
+        }
+      }
+
+      // free ml-values the region's nodes were the last consumers of. done
+      // after the barrier so no concurrent step still reads them.
+      for (size_t step = region.begin_step; step < region.end_step; ++step) {
+        ONNXRUNTIME_RETURN_IF_ERROR(ReleaseNodeMLValues(frame, seq_exec_plan, exec_plan_vec[step], logger));
+      }
+    }
+  }
+
+  VLOGS(logger, 1) << "Fetching output.";
+  ONNXRUNTIME_RETURN_IF_ERROR(FetchOutput(session_state.GetMLValueNameIdxMap(), frame, output_names, fetches, logger));
+
+  if (frame.HasPlan()) {
+    std::vector<TensorShape> input_shapes;
+    bool all_tensors = true;
+    for (const auto& feed : feeds) {
+      if (!(feed.second.IsTensor())) {
+        all_tensors = false;
+        break;
+      }
+      auto& tensor = feed.second.Get<Tensor>();
+      input_shapes.push_back(tensor.Shape());
+    }
+
+    if (all_tensors) {
+      // pattern generation and installation happen off the critical path;
+      // runs before the pattern lands keep using individual allocations.
+      session_state.UpdateMemoryPatternGroupCacheAsync(std::move(input_shapes), frame.TakePlanner());
+    }
+  }
+
+  // publish the shape state the kernels recorded during this run, so later
+  // runs with the same input shapes skip their shape arithmetic.
+  if (frame.IsRecordingShapeBindings()) {
+    ONNXRUNTIME_RETURN_IF_ERROR(session_state.UpdateShapeBindingCache(frame.TakeRecordedShapeBindings()));
+  }
+
+  session_state.Profiler().EndTimeAndRecordEvent(profiling::SESSION_EVENT, "HybridExecutor::Execute", tp);
+  return Status::OK();
+}
+
+Status HybridExecutor::RunStep(const SessionState& session_state,
+                               ExecutionFrame& frame,
+                               size_t step,
+                               const logging::Logger& logger) {
+  const auto& node_exec_plan = session_state.GetExecutionPlan()->execution_plan[step];
+  auto node_index = node_exec_plan.node_index;
+
+  const auto& plan_steps = session_state.GetFinalizedPlanSteps();
+  const OpKernel* p_op_kernel;
+  int queue_id;
+
+  if (step < plan_steps.size()) {
+    p_op_kernel = plan_steps[step].kernel;
+    queue_id = plan_steps[step].queue_id;
+  } else {
+    p_op_kernel = session_state.GetKernel(node_index);
+
+    // if a kernel has been added in the session state, it better be NON-null.
+    if (p_op_kernel == nullptr)
+      return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, "Got nullptr from GetKernel for node: ",
+                                     session_state.GetGraphViewer()->GetNode(node_index)->Name());
+
+    queue_id = p_op_kernel->KernelDef().ExecQueueId();
+  }
+
+  const std::string& node_name = p_op_kernel->Node().Name();
+  const std::string& op_name = p_op_kernel->KernelDef().OpName();
+
+  // wide regions run their steps on pool threads, so the node events
+  // recorded here need the request tag installed again.
+  profiling::ScopedTraceTag trace_tag(&run_tag_);
+
+  OpKernelContextInternal op_kernel_context(frame, *p_op_kernel, logger, p_op_kernel->Node().ImplicitInputDefs(),
+                                            cancellation_);
+
+  auto sync_time_begin = session_state.Profiler().StartTime();
+  // sync before compute
+  for (int input_index = 0; input_index < op_kernel_context.InputCount(); ++input_index) {
+    Fence_t fence = op_kernel_context.InputFence(input_index);
+    if (fence) {
+      fence->BeforeUsingAsInput(p_op_kernel->Node().GetExecutionProviderType(), queue_id);
+    }
+  }
+
+  for (int input_index = 0; input_index < op_kernel_context.ImplicitInputCount(); ++input_index) {
+    Fence_t fence = op_kernel_context.ImplicitInputFence(input_index);
+    if (fence) {
+      fence->BeforeUsingAsInput(p_op_kernel->Node().GetExecutionProviderType(), queue_id);
+    }
+  }
+
+  for (int output_index = 0; output_index < op_kernel_context.OutputCount(); ++output_index) {
+    Fence_t fence = op_kernel_context.OutputFence(output_index);
+    if (fence) {
+      fence->BeforeUsingAsOutput(p_op_kernel->Node().GetExecutionProviderType(), queue_id);
+    }
+  }
+
+  session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
+                                                 node_name + "_fence_before",
+                                                 sync_time_begin,
+                                                 {{"op_name", op_name}});
+
+  // call compute on the kernel
+  VLOGS(logger, 1) << "Computing kernel: " << p_op_kernel->Node().Name();
+
+  auto kernel_begin_time = session_state.Profiler().StartTime();
+  {
+    OpKernelContextInternal::MlasCancelScope mlas_cancel_scope(op_kernel_context);
+    ONNXRUNTIME_RETURN_IF_ERROR(p_op_kernel->Compute(&op_kernel_context));
+  }
+  session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
+                                                 node_name + "_kernel_time",
+                                                 kernel_begin_time,
+                                                 {{"op_name", op_name}});
+
+  sync_time_begin = session_state.Profiler().StartTime();
+  // sync after compute for outputs
+  for (int input_index = 0; input_index < op_kernel_context.InputCount(); ++input_index) {
+    Fence_t fence = op_kernel_context.InputFence(input_index);
+    if (fence) {
+      fence->AfterUsedAsInput(queue_id);
+    }
+  }
+
+  for (int input_index = 0; input_index < op_kernel_context.ImplicitInputCount(); ++input_index) {
+    Fence_t fence = op_kernel_context.ImplicitInputFence(input_index);
+    if (fence) {
+      fence->AfterUsedAsInput(queue_id);
+    }
+  }
+
+  for (int output_index = 0; output_index < op_kernel_context.OutputCount(); ++output_index) {
+    Fence_t fence = op_kernel_context.OutputFence(output_index);
+    if (fence) {
+      fence->AfterUsedAsOutput(queue_id);
+    }
+  }
+  session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
+                                                 node_name + "_fence_after",
+                                                 sync_time_begin,
+                                                 {{"op_name", op_name}});
+
+  return Status::OK();
+}
+
+Status HybridExecutor::RunLanes(const SessionState& session_state,
+                                ExecutionFrame& frame,
+                                const logging::Logger& logger) {
+  const SequentialExecutionPlan& seq_exec_plan = *session_state.GetExecutionPlan();
+  const auto& exec_plan_vec = seq_exec_plan.execution_plan;
+  const auto& lanes = session_state.GetExecutionLanes();
+  const auto& cross_lane_deps = session_state.GetCrossLaneDeps();
+  auto* pool = session_state.GetThreadPool();
+
+  // per-step completion flags, shared by the lanes. a lane blocks at a join
+  // until the producing step on the other lane has completed; waits only ever
+  // target earlier plan steps and every lane walks its steps in plan order,
+  // so the lanes cannot deadlock.
+  std::vector<char> step_done(exec_plan_vec.size(), 0);
+  std::mutex done_mutex;
+  std::condition_variable done_cv;
+
+  std::mutex status_mutex;
+  Status lanes_status = Status::OK();
+  std::atomic<bool> stopped{false};
+
+  pool->ExecuteInParallel(
+      [&](size_t lane_index) {
+        for (size_t step : lanes[lane_index].steps) {
+          if (cancellation_.IsCancelled()) {
+            stopped = true;
+            done_cv.notify_all();
+            return;
+          }
+
+          for (size_t dep : cross_lane_deps[step]) {
+            std::unique_lock<std::mutex> lock(done_mutex);
+            done_cv.wait(lock, [&] { return step_done[dep] != 0 || stopped.load(); });
+          }
+          if (stopped) {
+            return;
+          }
+
+          auto status = RunStep(session_state, frame, step, logger);
+          if (!status.IsOK()) {
+            {
+              std::lock_guard<std::mutex> lock(status_mutex);
+              if (lanes_status.IsOK()) {
+                lanes_status = status;
+              }
+            }
+            // flag before waking the waiters so nobody consumes the output
+            stopped = true;
+            done_cv.notify_all();
+            return;
+          }
+
+          {
+            std::lock_guard<std::mutex> lock(done_mutex);
+            step_done[step] = 1;
+          }
+          done_cv.notify_all();
+        }
+      },
+      lanes.size());
+
+  ONNXRUNTIME_RETURN_IF_ERROR(lanes_status);
+  if (cancellation_.IsCancelled()) {
+    LOGS(logger, WARNING) << cancellation_.Reason();
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, cancellation_.Reason());
+  }
+
+  // free ml-values in plan order after the lanes joined, so no concurrent
+  // step still reads them.
+  for (size_t step = 0; step < exec_plan_vec.size(); ++step) {
+    ONNXRUNTIME_RETURN_IF_ERROR(ReleaseNodeMLValues(frame, seq_exec_plan, exec_plan_vec[step], logger));
+  }
+
+  return Status::OK();
+}
+
+static Status FetchOutput(const MLValueNameIdxMap& name_idx_map,
+                          ExecutionFrame& frame,
+                          const std::vector<std::string>& output_names,
+                          std::vector<MLValue>& fetches,
+                          const logging::Logger& logger) {
+  if (fetches.empty()) {
+    fetches.resize(output_names.size());
+  } else {
+    // this should've been checked before already
+    ONNXRUNTIME_ENFORCE(output_names.size() == fetches.size(),
+                        "output_names vector size: " + std::to_string(output_names.size()) +
+                            " does not match that of fetches vector: " + std::to_string(fetches.size()));
+  }
+
+  auto idx = 0;
+
+  for (const auto& oname : output_names) {
+    VLOGS(logger, 1) << "Attempting to fetch output with name: " << oname;
+    int mlvalue_index;
+    ONNXRUNTIME_RETURN_IF_ERROR(name_idx_map.GetIdx(oname, mlvalue_index));
+    const MLValue& output_mlvalue = frame.GetMLValue(mlvalue_index);
+    VLOGS(logger, 1) << "Copying fetched MLValue to output vector";
+    fetches[idx++] = output_mlvalue;
+  }
+
+  VLOGS(logger, 1) << "Done with execution.";
+  return Status::OK();
+}
+
+static Status ReleaseNodeMLValues(ExecutionFrame& frame,
+                                  const SequentialExecutionPlan& seq_exec_plan,
+                                  const SequentialExecutionPlan::NodeExecutionPlan& node_exec_plan,
+                                  const logging::Logger& logger) {
+  for (auto i = node_exec_plan.free_from_index; i <= node_exec_plan.free_to_index; ++i) {
+    auto mlvalue_idx = seq_exec_plan.to_be_freed[i];
+    VLOGS(logger, 1) << "Releasing mlvalue with index: " << mlvalue_idx;
+    ONNXRUNTIME_RETURN_IF_ERROR(frame.ReleaseMLValue(mlvalue_idx));
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
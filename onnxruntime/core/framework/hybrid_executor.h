@@ -0,0 +1,72 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <vector>
+#include "core/common/common.h"
+#include "core/common/status.h"
+#include "core/common/logging/logging.h"
+#include "core/framework/iexecutor.h"
+#include "core/framework/framework_common.h"
+#include "core/framework/ml_value.h"
+#include "core/framework/run_cancellation.h"
+#include "core/framework/session_state.h"
+#include "core/graph/graph_viewer.h"
+
+namespace onnxruntime {
+class ExecutionFrame;
+
+// Executes the plan region by region (see SessionState::GetExecutionRegions):
+// regions of mutually independent nodes wide enough to cover the scheduling
+// overhead are dispatched to the session thread pool with a barrier at the
+// region end, narrow regions run inline as SequentialExecutor would. Graphs
+// with a wide parallel section feeding a long sequential tail get the
+// parallel speedup of the head without paying dispatch overhead on the tail.
+class HybridExecutor : public IExecutor {
+ public:
+  HybridExecutor(const RunCancellation& cancellation = {}, const std::string& run_tag = {})
+      : cancellation_{cancellation}, run_tag_{run_tag} {}
+
+  common::Status Execute(const SessionState& session_state,
+                         const NameMLValMap& feeds,
+                         const std::vector<std::string>& output_names,
+                         std::vector<MLValue>& fetches,
+                         const logging::Logger& logger) override;
+
+  // Variant used by InferenceSession: executes on a caller-owned frame that
+  // has already been populated with the feeds and fetches for this run,
+  // instead of building a new frame.
+  common::Status Execute(const SessionState& session_state,
+                         ExecutionFrame& frame,
+                         const NameMLValMap& feeds,
+                         const std::vector<std::string>& output_names,
+                         std::vector<MLValue>& fetches,
+                         const logging::Logger& logger);
+
+ private:
+  ONNXRUNTIME_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(HybridExecutor);
+
+  // runs the fences and the kernel of one plan step. value release and the
+  // scratch arena are handled by the caller, so steps of a parallel region
+  // can run concurrently on the shared frame.
+  common::Status RunStep(const SessionState& session_state,
+                         ExecutionFrame& frame,
+                         size_t step,
+                         const logging::Logger& logger);
+
+  // runs the per-provider lanes of a heterogeneous plan concurrently, one
+  // pool task per lane (see SessionState::GetExecutionLanes). a step that
+  // consumes another lane's output waits until that step has completed, so
+  // independent partitions overlap and only the true joins block.
+  common::Status RunLanes(const SessionState& session_state,
+                          ExecutionFrame& frame,
+                          const logging::Logger& logger);
+
+  RunCancellation cancellation_;
+
+  // request tag from RunOptions.run_tag; profiler events recorded during
+  // this run carry it for cross-layer span correlation
+  std::string run_tag_;
+};
+}  // namespace onnxruntime
@@ -61,7 +61,17 @@ static bool IsInputFloat16(const onnxruntime::Node& node) {
   return false;
 }
 
+// Ops with native float16 CPU kernels that keep their weights in half
+// precision; forcing them to float32 would materialize expanded copies of
+// the weights and lose the bandwidth savings.
+static bool HasNativeFloat16Kernel(const onnxruntime::Node& node) {
+  return node.OpType() == "MatMul" || node.OpType() == "Gemm";
+}
+
 static bool IsSingleInputNodeFloat16Node(const onnxruntime::Node& node) {
+  if (HasNativeFloat16Kernel(node))
+    return false;
+
   if (IsInputFloat16(node) && node.GetExecutionProviderType() == kCpuExecutionProvider) {
     for (auto it = node.InputNodesBegin(); it != node.InputNodesEnd(); ++it) {
       if (IsInputFloat16(*it))
@@ -5,6 +5,8 @@
 #include <unordered_set>
 #include <string>
 
+#include "core/graph/onnx_protobuf.h"
+
 namespace onnxruntime {
 namespace {
 
@@ -115,6 +117,31 @@ KernelDefBuilder& KernelDefBuilder::Provider(const char* provider_type) {
 KernelDefBuilder& KernelDefBuilder::TypeConstraint(const std::string& arg_name,
                                                    const std::vector<MLDataType>& supported_types) {
   kernel_def_->type_constraints_[arg_name] = supported_types;
+
+  // Build the element-type bitmask VerifyKernelDef prefers over scanning
+  // MLDataType comparisons. Any non-tensor entry (maps, sequences, the
+  // elem-less tensor base) disables the mask for this constraint.
+  uint64_t mask = 0;
+  bool all_plain_tensors = !supported_types.empty();
+  for (MLDataType type : supported_types) {
+    const ONNX_NAMESPACE::TypeProto* proto = type->GetTypeProto();
+    if (!type->IsTensorType() || proto == nullptr ||
+        !proto->tensor_type().has_elem_type()) {
+      all_plain_tensors = false;
+      break;
+    }
+    const int elem_type = proto->tensor_type().elem_type();
+    if (elem_type < 0 || elem_type >= 64) {
+      all_plain_tensors = false;
+      break;
+    }
+    mask |= uint64_t{1} << elem_type;
+  }
+  if (all_plain_tensors) {
+    kernel_def_->tensor_type_masks_[arg_name] = mask;
+  } else {
+    kernel_def_->tensor_type_masks_.erase(arg_name);
+  }
   return *this;
 }
 
@@ -125,8 +152,7 @@ KernelDefBuilder& KernelDefBuilder::TypeConstraint(const char* arg_name,
 
 KernelDefBuilder& KernelDefBuilder::TypeConstraint(const std::string& arg_name,
                                                    MLDataType supported_type) {
-  kernel_def_->type_constraints_[arg_name] = std::vector<MLDataType>{supported_type};
-  return *this;
+  return TypeConstraint(arg_name, std::vector<MLDataType>{supported_type});
 }
 
 KernelDefBuilder& KernelDefBuilder::TypeConstraint(const char* arg_name,
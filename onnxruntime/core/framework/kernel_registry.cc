@@ -122,11 +122,30 @@ bool KernelRegistry::VerifyKernelDef(const onnxruntime::Node& node,
 
   // check if type matches
   auto& kernel_type_constraints = kernel_def.TypeConstraints();
+  const auto& tensor_masks = kernel_def.TypeConstraintTensorMasks();
   for (auto& constraint : kernel_type_constraints) {
     const std::string& name = constraint.first;
     const std::vector<MLDataType>& allowed_types = constraint.second;
     const ::ONNX_NAMESPACE::TypeProto* actual_type = FindTypeBinding(node, name);
 
+    // Fast path: a constraint over plain tensor types reduces to one bit test
+    // against the element type (tensor IsCompatible only compares elem_type),
+    // skipping the virtual comparison per allowed type below.
+    if (nullptr != actual_type &&
+        actual_type->value_case() == ::ONNX_NAMESPACE::TypeProto::kTensorType &&
+        actual_type->tensor_type().has_elem_type()) {
+      auto mask_it = tensor_masks.find(name);
+      if (mask_it != tensor_masks.end()) {
+        const int elem_type = actual_type->tensor_type().elem_type();
+        if (elem_type >= 0 && elem_type < 64 &&
+            ((mask_it->second >> elem_type) & 1) != 0) {
+          continue;
+        }
+        error_str = "Op: " + node.OpType() + " Incompatible types.";
+        return false;
+      }
+    }
+
     // If actual_type is null, this represents a type-constraint on a
     // missing optional parameter, which can be skipped.
     // TODO: We should check that names specified in kernel_type_constraints are
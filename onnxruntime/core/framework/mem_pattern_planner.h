@@ -17,6 +17,7 @@ limitations under the License.
 
 #pragma once
 #include "core/framework/mem_pattern.h"
+#include "core/framework/mem_pattern_trace.h"
 #include "core/framework/allocation_planner.h"
 #include <list>
 
@@ -29,6 +30,7 @@ class MemPatternPlanner {
   MemPatternPlanner() = default;
 
   void TraceAllocation(int ml_value_idx, size_t size) {
+    trace_.emplace_back(ml_value_idx, size, /*is_free*/ false);
     if (size == 0) {
       allocs_.emplace_back(ml_value_idx, MemoryBlock(0, 0));
       return;
@@ -61,6 +63,7 @@ class MemPatternPlanner {
   }
 
   void TraceFree(int ml_value_index) {
+    trace_.emplace_back(ml_value_index, 0, /*is_free*/ true);
     for (auto it = blocks_.begin(); it != blocks_.end(); it++) {
       if (allocs_[*it].index_ == ml_value_index) {
         blocks_.erase(it);
@@ -79,6 +82,12 @@ class MemPatternPlanner {
     return pattern;
   }
 
+  // the alloc/free events observed so far, in order. replay against the
+  // generated pattern with ReplayAllocationTrace to vet it offline.
+  const std::vector<AllocationTraceEntry>& GetAllocationTrace() const {
+    return trace_;
+  }
+
  protected:
   struct MLValueAllocationBlock {
     int index_{-1};
@@ -89,6 +98,7 @@ class MemPatternPlanner {
   };
 
   std::vector<MLValueAllocationBlock> allocs_;
+  std::vector<AllocationTraceEntry> trace_;
   // blocks_ the list of currently allocated memory blocks, sorted in order of their offset
   std::list<int> blocks_;
   size_t buffer_size{0};
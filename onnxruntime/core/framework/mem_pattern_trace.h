@@ -0,0 +1,91 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include "core/common/common.h"
+#include "core/framework/mem_pattern.h"
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+namespace onnxruntime {
+// One allocation or free observed by MemPatternPlanner during a traced run,
+// in execution order.
+struct AllocationTraceEntry {
+  int ml_value_idx{-1};
+  size_t size{0};
+  bool is_free{false};
+
+  AllocationTraceEntry() = default;
+  AllocationTraceEntry(int ml_value_idx, size_t size, bool is_free)
+      : ml_value_idx(ml_value_idx), size(size), is_free(is_free) {}
+};
+
+// Result of replaying an allocation trace against the pattern planned for it.
+struct MemPatternValidationReport {
+  // high-water mark of the planned layout over the trace
+  size_t peak_size{0};
+  // what the trace would need if every allocation got fresh memory
+  size_t no_reuse_bytes{0};
+  // no_reuse_bytes - peak_size: what buffer reuse bought
+  size_t saved_bytes{0};
+  // largest byte count live at any point of the trace
+  size_t max_live_bytes{0};
+  // peak_size - max_live_bytes: gaps the layout could not pack away
+  size_t fragmentation_bytes{0};
+  // allocations the pattern places over a block that is still live at that
+  // point of the trace. any nonzero count means the pattern corrupts data.
+  size_t overlap_violations{0};
+};
+
+// Replays a recorded allocation trace against the pattern planned for it,
+// walking the trace in order and checking every allocation's planned block
+// against the blocks still live at that point. Runs offline on the recorded
+// trace, so a pattern can be vetted and its savings measured before it is
+// cached or deployed. Returns INVALID_ARGUMENT when the trace references a
+// value the pattern has no block for.
+inline common::Status ReplayAllocationTrace(const std::vector<AllocationTraceEntry>& trace,
+                                            const MemoryPattern& pattern,
+                                            MemPatternValidationReport& report) {
+  report = MemPatternValidationReport();
+  std::unordered_map<int, MemoryBlock> live;
+  size_t live_bytes = 0;
+
+  for (const auto& entry : trace) {
+    if (entry.is_free) {
+      auto it = live.find(entry.ml_value_idx);
+      if (it != live.end()) {
+        live_bytes -= it->second.size_;
+        live.erase(it);
+      }
+      continue;
+    }
+
+    const MemoryBlock* block = pattern.GetBlock(entry.ml_value_idx);
+    if (block == nullptr) {
+      return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                                     "Trace references ml_value_idx ", entry.ml_value_idx,
+                                     " but the pattern has no block for it.");
+    }
+
+    for (const auto& other : live) {
+      if (block->offset_ < other.second.offset_ + other.second.size_ &&
+          other.second.offset_ < block->offset_ + block->size_) {
+        report.overlap_violations++;
+      }
+    }
+
+    live[entry.ml_value_idx] = *block;
+    live_bytes += block->size_;
+    report.no_reuse_bytes += block->size_;
+    report.peak_size = std::max(report.peak_size, block->offset_ + block->size_);
+    report.max_live_bytes = std::max(report.max_live_bytes, live_bytes);
+  }
+
+  report.saved_bytes =
+      report.no_reuse_bytes > report.peak_size ? report.no_reuse_bytes - report.peak_size : 0;
+  report.fragmentation_bytes =
+      report.peak_size > report.max_live_bytes ? report.peak_size - report.max_live_bytes : 0;
+  return common::Status::OK();
+}
+}  // namespace onnxruntime
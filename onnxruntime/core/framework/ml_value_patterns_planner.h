@@ -53,6 +53,25 @@ class MLValuePatternPlanner {
     return common::Status::OK();
   }
 
+  // replays each location's recorded alloc/free trace against the pattern
+  // planned for it, reporting peak size, reuse savings, fragmentation and
+  // overlap violations per location. a report with overlap_violations > 0
+  // means the pattern would let two live tensors share bytes.
+  common::Status ValidatePatterns(std::map<ONNXRuntimeAllocatorInfo, MemPatternValidationReport>* out) {
+    if (!out)
+      return common::Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT);
+
+    std::lock_guard<std::mutex> lock(lock_);
+    for (auto& it : planner_map_) {
+      MemPatternValidationReport report;
+      ONNXRUNTIME_RETURN_IF_ERROR(ReplayAllocationTrace(it.second->GetAllocationTrace(),
+                                                        it.second->GenerateMemPattern(), report));
+      (*out)[it.first] = report;
+    }
+
+    return common::Status::OK();
+  }
+
  private:
   ONNXRUNTIME_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(MLValuePatternPlanner);
 
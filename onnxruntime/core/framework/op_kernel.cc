@@ -2,10 +2,12 @@
 // Licensed under the MIT License.
 
 #include "core/framework/op_kernel.h"
+#include <algorithm>
 #include "core/framework/execution_frame.h"
 #include "core/framework/session_state.h"
 #include "core/graph/op.h"
 #include "core/common/logging/logging.h"
+#include "core/common/work_stealing_thread_pool.h"
 using namespace ::onnxruntime::common;
 namespace onnxruntime {
 
@@ -21,6 +23,23 @@ OpKernelContext::OpKernelContext(ExecutionFrame* frame,
   node_input_start_index_ = frame->GetFirstArgIndex(kernel->Node().Index());
   node_implicit_input_start_index_ = node_input_start_index_ + InputCount();
   node_output_start_index_ = node_implicit_input_start_index_ + ImplicitInputCount();
+
+  // Finalize the bindings: the accessors then index these two arrays
+  // directly instead of calling back into the frame per access.
+  node_arg_value_indices_ = frame->GetNodeArgValueIndicesData() + node_input_start_index_;
+  all_values_ = frame->GetAllValuesData();
+}
+
+void OpKernelContext::RebindExecutionFrame(ExecutionFrame* frame, const logging::Logger& logger) {
+  ONNXRUNTIME_ENFORCE(frame != nullptr, "Execution frame was null");
+
+  execution_frame_ = frame;
+  logger_ = &logger;
+
+  // the frame's value tables can reallocate between runs, so refresh the
+  // bindings; the per-node start indices come from the plan and stay valid.
+  node_arg_value_indices_ = frame->GetNodeArgValueIndicesData() + node_input_start_index_;
+  all_values_ = frame->GetAllValuesData();
 }
 
 Tensor* OpKernelContext::Output(int index, const TensorShape& shape) {
@@ -49,6 +68,64 @@ int OpKernelContext::NumVariadicInputs(size_t arg_num) const {
   return arg_counts[arg_num];
 }
 
+std::shared_ptr<void> OpKernelContext::TryGetShapeState() const {
+  const NodeShapeBinding* binding = execution_frame_->GetCachedShapeBinding(GetNodeIndex());
+  if (binding == nullptr || binding->state == nullptr)
+    return nullptr;
+
+  // the state is only valid when this node's input shapes match the ones it
+  // was derived from, which guards nodes downstream of any data dependent
+  // shape. missing or non-tensor inputs were recorded as an empty shape.
+  const int input_count = InputCount();
+  if (binding->input_shapes.size() != static_cast<size_t>(input_count))
+    return nullptr;
+
+  for (int i = 0; i < input_count; ++i) {
+    const MLValue* p_ml_value = GetInputMLValue(i);
+    if (p_ml_value == nullptr || !p_ml_value->IsTensor()) {
+      if (binding->input_shapes[i].NumDimensions() != 0)
+        return nullptr;
+      continue;
+    }
+    if (p_ml_value->Get<Tensor>().Shape() != binding->input_shapes[i])
+      return nullptr;
+  }
+
+  return binding->state;
+}
+
+bool OpKernelContext::IsRecordingShapeState() const {
+  return execution_frame_->IsRecordingShapeBindings();
+}
+
+void OpKernelContext::SetShapeState(std::shared_ptr<void> state) {
+  if (!execution_frame_->IsRecordingShapeBindings())
+    return;
+
+  const int input_count = InputCount();
+  std::vector<TensorShape> input_shapes;
+  input_shapes.reserve(input_count);
+  for (int i = 0; i < input_count; ++i) {
+    const MLValue* p_ml_value = GetInputMLValue(i);
+    if (p_ml_value != nullptr && p_ml_value->IsTensor()) {
+      input_shapes.push_back(p_ml_value->Get<Tensor>().Shape());
+    } else {
+      input_shapes.push_back(TensorShape());
+    }
+  }
+
+  execution_frame_->RecordShapeBinding(GetNodeIndex(), std::move(input_shapes), std::move(state));
+}
+
+void OpKernelContext::ParallelFor(int64_t first, int64_t last, double cost_per_unit,
+                                  const std::function<void(int64_t, int64_t)>& fn) const {
+  onnxruntime::ParallelFor(first, last, cost_per_unit, fn);
+}
+
+void* OpKernelContext::GetScratchBuffer(size_t size) const {
+  return execution_frame_->GetScratchBuffer(size);
+}
+
 Status OpKernelContext::GetTempSpaceAllocator(AllocatorPtr* output) const {
   *output = execution_frame_->GetAllocator(kernel_->Allocator(0, ONNXRuntimeMemTypeDefault));
   if (!*output)
@@ -122,28 +199,4 @@ const SessionState& OpKernelContext::GetSessionState() const {
   return execution_frame_->SessionState();
 }
 
-const MLValue* OpKernelContext::GetInputMLValue(int index) const {
-  if (index < 0 || index >= InputCount())
-    return nullptr;
-
-  int input_arg_index = GetInputArgIndex(index);
-  return execution_frame_->GetNodeInputOrOutputMLValue(input_arg_index);
-}
-
-const MLValue* OpKernelContext::GetImplicitInputMLValue(int index) const {
-  if (index < 0 || index >= ImplicitInputCount())
-    return nullptr;
-
-  int input_arg_index = GetImplicitInputArgIndex(index);
-  return execution_frame_->GetNodeInputOrOutputMLValue(input_arg_index);
-}
-
-MLValue* OpKernelContext::GetOutputMLValue(int index) {
-  if (index < 0 || index >= OutputCount())
-    return nullptr;
-
-  auto output_arg_index = GetOutputArgIndex(index);
-  return execution_frame_->GetMutableNodeInputOrOutputMLValue(output_arg_index);
-}
-
 }  // namespace onnxruntime
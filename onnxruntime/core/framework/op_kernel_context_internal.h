@@ -4,8 +4,13 @@
 #pragma once
 
 #include "core/framework/op_kernel.h"
+#include "core/framework/run_cancellation.h"
 #include "core/framework/session_state.h"
 
+#if defined(USE_MLAS)
+#include "core/mlas/inc/mlas.h"
+#endif
+
 // onnxruntime internal OpKernelContext derived class to provide additional
 // APIs that aren't desirable to add to the public OpKernelContext API
 
@@ -18,10 +23,43 @@ class OpKernelContextInternal : public OpKernelContext {
                                    const OpKernel& kernel,
                                    const logging::Logger& logger,
                                    const std::vector<NodeArg*>& implicit_inputs,
-                                   const bool& terminate_flag)
+                                   const RunCancellation& cancellation)
       : OpKernelContext(&frame, &kernel, logger),
         implicit_inputs_{implicit_inputs},
-        terminate_flag_{terminate_flag} {
+        cancellation_{cancellation} {
+  }
+
+  // Installs the owning context's cancellation check as this thread's MLAS
+  // cancel state for the duration of a Compute call, so the MLAS threaded
+  // work loops can abandon a cancelled run's work instead of completing it.
+  // The previous state is restored on destruction to handle nesting (control
+  // flow kernels run subgraph nodes, each with its own context and scope,
+  // inside their own Compute).
+  class MlasCancelScope {
+   public:
+#if defined(USE_MLAS)
+    explicit MlasCancelScope(OpKernelContextInternal& context) {
+      previous_cancel_state_ =
+          MlasSetThreadCancelState({&OpKernelContextInternal::MlasCancelCheck, &context.cancellation_});
+    }
+
+    ~MlasCancelScope() {
+      MlasSetThreadCancelState(previous_cancel_state_);
+    }
+
+   private:
+    MLAS_THREAD_CANCEL_STATE previous_cancel_state_;
+#else
+    explicit MlasCancelScope(OpKernelContextInternal&) {}
+#endif
+  };
+
+  // Re-points a preconstructed context at the state of a new run. The
+  // per-node bindings survive; only the frame tables, logger and
+  // cancellation change between runs.
+  void Rebind(ExecutionFrame& frame, const logging::Logger& logger, const RunCancellation& cancellation) {
+    RebindExecutionFrame(&frame, logger);
+    cancellation_ = cancellation;
   }
 
   const SessionState* SubgraphSessionState(const std::string& attribute_name) {
@@ -48,11 +86,17 @@ class OpKernelContextInternal : public OpKernelContext {
     return implicit_inputs_map;
   }
 
-  const bool& GetTerminateFlag() const noexcept { return terminate_flag_; }
+  const RunCancellation& GetCancellation() const noexcept { return cancellation_; }
 
  private:
+#if defined(USE_MLAS)
+  static bool MlasCancelCheck(void* context) {
+    return static_cast<const RunCancellation*>(context)->IsCancelled();
+  }
+#endif
+
   const std::vector<NodeArg*>& implicit_inputs_;
-  const bool& terminate_flag_;
+  RunCancellation cancellation_;
 };
 
 }  // namespace onnxruntime
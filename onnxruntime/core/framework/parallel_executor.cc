@@ -9,7 +9,7 @@
 #include <vector>
 #include "core/common/common.h"
 #include "core/common/logging/logging.h"
-#include "core/common/task_thread_pool.h"
+#include "core/common/work_stealing_thread_pool.h"
 #include "core/framework/allocation_planner.h"
 #include "core/framework/execution_frame.h"
 #include "core/framework/session_state.h"
@@ -17,12 +17,15 @@
 
 namespace onnxruntime {
 
-ParallelExecutor::ParallelExecutor(const SessionState& session_state, const bool& terminate_flag)
-    : out_standings_(0), terminate_flag_{terminate_flag} {
+ParallelExecutor::ParallelExecutor(const SessionState& session_state, const RunCancellation& cancellation,
+                                   const std::string& run_tag)
+    : out_standings_(0), cancellation_{cancellation}, run_tag_{run_tag} {
   auto graph_viewer = session_state.GetGraphViewer();
-  node_refs_.resize(graph_viewer->MaxNodeIndex());
+  for (size_t i = 0, end = graph_viewer->MaxNodeIndex(); i < end; ++i) {
+    node_refs_.emplace_back(0);
+  }
   for (auto& node : graph_viewer->Nodes()) {
-    node_refs_[node.Index()] = node.GetInputEdgesCount();
+    node_refs_[node.Index()].store(node.GetInputEdgesCount(), std::memory_order_relaxed);
   }
 }
 
@@ -32,8 +35,14 @@ Status ParallelExecutor::Execute(const SessionState& session_state,
                                  std::vector<MLValue>& fetches,
                                  const logging::Logger& logger) {
   auto tp = session_state.Profiler().StartTime();
+  profiling::ScopedTraceTag trace_tag(&run_tag_);
 
   root_frame_ = std::make_unique<ExecutionFrame>(feeds, output_names, fetches, session_state);
+
+  if (output_ready_callback_) {
+    ONNXRUNTIME_RETURN_IF_ERROR(SetupStreamedOutputs(session_state, output_names, logger));
+  }
+
   //std::cout << "start nodes:" << std::endl;
   for (auto node_index : session_state.GetGraphViewer()->GetRootNodes()) {
     auto p_op_kernel = session_state.GetKernel(node_index);
@@ -47,7 +56,7 @@ Status ParallelExecutor::Execute(const SessionState& session_state,
   // Wait for finish.
   {
     std::unique_lock<std::mutex> lock(complete_mutex_);
-    while (out_standings_ > 0) complete_cv_.wait(lock);
+    complete_cv_.wait(lock, [this]() { return out_standings_.load(std::memory_order_acquire) == 0; });
   }
 
   VLOGS(logger, 1) << "Fetching output.";
@@ -66,12 +75,18 @@ Status ParallelExecutor::Execute(const SessionState& session_state,
     }
 
     if (all_tensors) {
-      auto mem_patterns = std::make_unique<MemoryPatternGroup>();
-      ONNXRUNTIME_RETURN_IF_ERROR(root_frame_->GeneratePatterns(mem_patterns.get()));
-      ONNXRUNTIME_RETURN_IF_ERROR(session_state.UpdateMemoryPatternGroupCache(input_shapes, std::move(mem_patterns)));
+      // pattern generation and installation happen off the critical path;
+      // runs before the pattern lands keep using individual allocations.
+      session_state.UpdateMemoryPatternGroupCacheAsync(std::move(input_shapes), root_frame_->TakePlanner());
     }
   }
 
+  // publish the shape state the kernels recorded during this run, so later
+  // runs with the same input shapes skip their shape arithmetic.
+  if (root_frame_->IsRecordingShapeBindings()) {
+    ONNXRUNTIME_RETURN_IF_ERROR(session_state.UpdateShapeBindingCache(root_frame_->TakeRecordedShapeBindings()));
+  }
+
   session_state.Profiler().EndTimeAndRecordEvent(profiling::SESSION_EVENT, "ParallelExecutor::Execute", tp);
   return Status::OK();
 }
@@ -92,6 +107,10 @@ void ParallelExecutor::RunNodeAsyncInternal(size_t p_node_index,
                                             const logging::Logger& logger) {
   LOGS(logger, INFO) << "Begin execution";
 
+  // this runs on a pool thread, so the node events it records need the
+  // request tag installed again here.
+  profiling::ScopedTraceTag trace_tag(&run_tag_);
+
   size_t node_index = p_node_index;
   bool keep_running = true;
   auto graph_viewer = session_state.GetGraphViewer();
@@ -99,9 +118,9 @@ void ParallelExecutor::RunNodeAsyncInternal(size_t p_node_index,
   while (keep_running) {
     // TODO: Convert RunNodeAsync return Status.
     // to also handle exception propagation
-    if (terminate_flag_) {
-      LOGS(logger, WARNING) << "Exiting due to terminate flag being set to true.";
-      ONNXRUNTIME_THROW("Exiting due to terminate flag being set to true.");
+    if (cancellation_.IsCancelled()) {
+      LOGS(logger, WARNING) << cancellation_.Reason();
+      ONNXRUNTIME_THROW(cancellation_.Reason());
     }
 
     auto p_op_kernel = session_state.GetKernel(node_index);
@@ -114,7 +133,7 @@ void ParallelExecutor::RunNodeAsyncInternal(size_t p_node_index,
 
     OpKernelContextInternal op_kernel_context(*root_frame_, *p_op_kernel, logger,
                                               p_op_kernel->Node().ImplicitInputDefs(),
-                                              terminate_flag_);
+                                              cancellation_);
 
     auto sync_time_begin = session_state.Profiler().StartTime();
     // sync before compute
@@ -155,6 +174,7 @@ void ParallelExecutor::RunNodeAsyncInternal(size_t p_node_index,
     auto kernel_begin_time = session_state.Profiler().StartTime();
 
     // Execute the kernel.
+    OpKernelContextInternal::MlasCancelScope mlas_cancel_scope(op_kernel_context);
     auto status = p_op_kernel->Compute(&op_kernel_context);
     if (!status.IsOK()) {
       ONNXRUNTIME_THROW("Compute failed for node: ", graph_viewer->GetNode(node_index)->Name());
@@ -163,7 +183,8 @@ void ParallelExecutor::RunNodeAsyncInternal(size_t p_node_index,
     session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
                                                    node_name + "_kernel_time",
                                                    kernel_begin_time,
-                                                   {{"op_name", op_name}});
+                                                   {{"op_name", op_name},
+                                                    {"provider", p_op_kernel->Node().GetExecutionProviderType()}});
 
     sync_time_begin = session_state.Profiler().StartTime();
     // sync after compute for outputs
@@ -194,17 +215,30 @@ void ParallelExecutor::RunNodeAsyncInternal(size_t p_node_index,
 
     //std::cout << "Run async node finish: " << p_node_index << std::endl;
 
+    // Deliver any requested outputs this node just produced, so a downstream
+    // pipeline stage can start on them while the rest of the graph drains.
+    if (output_ready_callback_) {
+      auto streamed_it = streamed_outputs_.find(node_index);
+      if (streamed_it != streamed_outputs_.end()) {
+        for (const auto& streamed : streamed_it->second) {
+          VLOGS(logger, 1) << "Streaming output: " << streamed.first;
+          output_ready_callback_(streamed.first, root_frame_->GetMLValue(streamed.second));
+        }
+      }
+    }
+
     keep_running = false;
 
-    // Checking which output nodes ready for running.
+    // Checking which output nodes ready for running. The counters are atomic,
+    // so workers self-schedule successors without taking a mutex per node; the
+    // thread that brings a counter to zero owns scheduling that node.
     {
       auto begin = p_op_kernel->Node().OutputEdgesBegin();
       auto end = p_op_kernel->Node().OutputEdgesEnd();
 
-      std::lock_guard<std::mutex> lock(ref_mutex_);
       for (auto it = begin; it != end; it++) {
         auto idx = (*it).GetNode().Index();
-        if ((--node_refs_[idx]) == 0) {
+        if (node_refs_[idx].fetch_sub(1, std::memory_order_acq_rel) == 1) {
           if (!keep_running) {
             node_index = idx;
             keep_running = true;
@@ -212,8 +246,6 @@ void ParallelExecutor::RunNodeAsyncInternal(size_t p_node_index,
             EnqueueNode(idx, session_state, logger);
           }
         }
-
-        //std::cout << "handle output, current name: " << p_op_kernel->Node().Name() << ", current index: " << p_node_index << ", output name: " << (*it)->GetNode().Name() << ", output index: " << (*it)->GetNode().Index() << ", after -- output ref: " << node_refs_[idx] << std::endl;
       }
     }
   }
@@ -222,13 +254,46 @@ void ParallelExecutor::RunNodeAsyncInternal(size_t p_node_index,
 }
 
 void ParallelExecutor::EnqueueNode(size_t p_node_index, const SessionState& session_state, const logging::Logger& logger) {
-  {
-    std::unique_lock<std::mutex> lock(complete_mutex_);
-    out_standings_++;
-  }
-  //std::cout << "Enqueue async node: " << p_node_index << ", out_standings: " << out_standings_ << std::endl;
+  out_standings_.fetch_add(1, std::memory_order_acq_rel);
+
   std::packaged_task<void()> task{std::bind(&ParallelExecutor::RunNodeAsync, this, p_node_index, std::cref(session_state), std::cref(logger))};
-  session_state.GetThreadPool()->RunTask(std::move(task));
+  session_state.GetThreadPool()->RunTask(std::move(task), session_state.GetThreadPoolTaskPriority());
+}
+
+Status ParallelExecutor::SetupStreamedOutputs(const SessionState& session_state,
+                                              const std::vector<std::string>& output_names,
+                                              const logging::Logger& logger) {
+  streamed_outputs_.clear();
+  const auto& name_idx_map = session_state.GetMLValueNameIdxMap();
+  auto graph_viewer = session_state.GetGraphViewer();
+
+  for (const auto& oname : output_names) {
+    int mlvalue_index;
+    ONNXRUNTIME_RETURN_IF_ERROR(name_idx_map.GetIdx(oname, mlvalue_index));
+
+    const onnxruntime::Node* producer = nullptr;
+    for (auto& node : graph_viewer->Nodes()) {
+      for (auto def : node.OutputDefs()) {
+        if (def->Exists() && def->Name() == oname) {
+          producer = &node;
+          break;
+        }
+      }
+      if (producer != nullptr)
+        break;
+    }
+
+    if (producer != nullptr) {
+      streamed_outputs_[producer->Index()].emplace_back(oname, mlvalue_index);
+    } else {
+      // an output fed straight from an initializer or feed has no producing
+      // node and is already in the frame, so deliver it up front
+      VLOGS(logger, 1) << "Streaming output available at start: " << oname;
+      output_ready_callback_(oname, root_frame_->GetMLValue(mlvalue_index));
+    }
+  }
+
+  return Status::OK();
 }
 
 Status ParallelExecutor::FetchOutput(const MLValueNameIdxMap& name_idx_map,
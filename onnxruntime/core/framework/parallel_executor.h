@@ -3,6 +3,11 @@
 
 #pragma once
 
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 #include <condition_variable>
 #include "core/common/common.h"
@@ -11,6 +16,7 @@
 #include "core/framework/iexecutor.h"
 #include "core/framework/framework_common.h"
 #include "core/framework/ml_value.h"
+#include "core/framework/run_cancellation.h"
 #include "core/framework/session_state.h"
 #include "core/graph/graph_viewer.h"
 
@@ -20,8 +26,10 @@ class ExecutionFrame;
 
 class ParallelExecutor : public IExecutor {
  public:
-  ParallelExecutor(const bool& terminate_flag = false) : terminate_flag_{terminate_flag} {}
-  ParallelExecutor(const SessionState& session_state, const bool& terminate_flag = false);
+  ParallelExecutor(const RunCancellation& cancellation = {}, const std::string& run_tag = {})
+      : cancellation_{cancellation}, run_tag_{run_tag} {}
+  ParallelExecutor(const SessionState& session_state, const RunCancellation& cancellation = {},
+                   const std::string& run_tag = {});
 
   common::Status Execute(const SessionState& session_state,
                          const NameMLValMap& feeds,
@@ -29,6 +37,14 @@ class ParallelExecutor : public IExecutor {
                          std::vector<MLValue>& fetches,
                          const logging::Logger& logger) override;
 
+  // Deliver each requested output through the callback as soon as its
+  // producing node finishes, instead of only via the fetches when Execute
+  // returns. Must be set before Execute; the callback can fire concurrently
+  // from worker threads.
+  void SetOutputReadyCallback(const std::function<void(const std::string&, const MLValue&)>& callback) {
+    output_ready_callback_ = callback;
+  }
+
  private:
   ONNXRUNTIME_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ParallelExecutor);
 
@@ -37,6 +53,10 @@ class ParallelExecutor : public IExecutor {
 
   void EnqueueNode(size_t p_node_index, const SessionState& session_state, const logging::Logger& logger);
 
+  Status SetupStreamedOutputs(const SessionState& session_state,
+                              const std::vector<std::string>& output_names,
+                              const logging::Logger& logger);
+
   Status FetchOutput(const MLValueNameIdxMap& name_idx_map,
                      ExecutionFrame& frame,
                      const std::vector<std::string>& output_names,
@@ -44,25 +64,36 @@ class ParallelExecutor : public IExecutor {
                      const logging::Logger& logger);
 
   void FinishNodeRun() {
-    bool finished = false;
-    {
-      //Because we have a mutex here, it's not possible another thread is doing the test("while (out_standings_ > 0)"
-      std::lock_guard<std::mutex> lock(complete_mutex_);
-      finished = --out_standings_ == 0;
-    }
-    if (finished) {
-      //std::cout << "all out standing nodes are completed." << std::endl;
+    // Decrement under the mutex: Execute's wait predicate reads the counter
+    // while holding it, so it cannot observe 0 and let the stack-resident
+    // executor be destroyed before this worker has released the lock after
+    // notifying. A decrement outside the lock leaves a window where a
+    // spurious wakeup sees 0 while the worker is still about to lock the
+    // soon-to-be-destroyed mutex.
+    std::lock_guard<std::mutex> lock(complete_mutex_);
+    if (out_standings_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
       complete_cv_.notify_all();
     }
   }
 
   std::unique_ptr<ExecutionFrame> root_frame_;
-  std::vector<size_t> node_refs_;
-  std::mutex ref_mutex_;
-  int out_standings_;  //protected by complete_mutex_
+  // remaining input edge counts per node; deque because atomics are neither
+  // movable nor copyable.
+  std::deque<std::atomic<std::size_t>> node_refs_;
+  std::atomic<int> out_standings_{0};
   std::mutex complete_mutex_;
   std::condition_variable complete_cv_;
 
-  const bool& terminate_flag_;
+  // requested outputs per producing node index, as (output name, mlvalue
+  // index) pairs. Built once at the start of Execute and read-only while the
+  // workers run, so node completions look up their outputs without a lock.
+  std::unordered_map<size_t, std::vector<std::pair<std::string, int>>> streamed_outputs_;
+  std::function<void(const std::string&, const MLValue&)> output_ready_callback_;
+
+  RunCancellation cancellation_;
+
+  // request tag from RunOptions.run_tag; profiler events recorded during
+  // this run carry it for cross-layer span correlation
+  std::string run_tag_;
 };
 }  // namespace onnxruntime
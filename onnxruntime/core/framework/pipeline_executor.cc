@@ -0,0 +1,275 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/pipeline_executor.h"
+
+#include <mutex>
+#include <vector>
+#include "core/common/common.h"
+#include "core/common/logging/logging.h"
+#include "core/framework/allocation_planner.h"
+#include "core/framework/execution_frame.h"
+#include "core/framework/session_state.h"
+#include "core/framework/op_kernel_context_internal.h"
+
+namespace onnxruntime {
+
+static Status FetchOutput(const MLValueNameIdxMap& name_idx_map,
+                          ExecutionFrame& frame,
+                          const std::vector<std::string>& output_names,
+                          std::vector<MLValue>& fetches,
+                          const logging::Logger& logger);
+
+static Status ReleaseNodeMLValues(ExecutionFrame& frame,
+                                  const SequentialExecutionPlan& seq_exec_plan,
+                                  const SequentialExecutionPlan::NodeExecutionPlan& node_exec_plan,
+                                  const logging::Logger& logger);
+
+Status PipelineExecutor::Execute(const SessionState& session_state,
+                                 const NameMLValMap& feeds,
+                                 const std::vector<std::string>& output_names,
+                                 std::vector<MLValue>& fetches,
+                                 const logging::Logger& logger) {
+  ExecutionFrame frame{feeds, output_names, fetches, session_state};
+
+  return Execute(session_state, frame, feeds, output_names, fetches, logger);
+}
+
+Status PipelineExecutor::Execute(const SessionState& session_state,
+                                 ExecutionFrame& frame,
+                                 const NameMLValMap& feeds,
+                                 const std::vector<std::string>& output_names,
+                                 std::vector<MLValue>& fetches,
+                                 const logging::Logger& logger) {
+  auto tp = session_state.Profiler().StartTime();
+  profiling::ScopedTraceTag trace_tag(&run_tag_);
+
+  LOGS(logger, INFO) << "Begin execution";
+
+  // within one frame the stages still run their nodes one at a time, so
+  // kernel temporaries can come from the frame's bump arena and be reclaimed
+  // wholesale after each node. concurrent frames each carry their own arena.
+  frame.EnableScratchArena();
+
+  const SequentialExecutionPlan& seq_exec_plan = *session_state.GetExecutionPlan();
+  const auto& exec_plan_vec = seq_exec_plan.execution_plan;
+  VLOGS(logger, 1) << "Size of execution plan vector: " << exec_plan_vec.size();
+
+  const auto& plan_steps = session_state.GetFinalizedPlanSteps();
+  const bool use_plan_steps = plan_steps.size() == exec_plan_vec.size();
+
+  // a plan too short to split has no stages; run it as one unlocked span so
+  // the mode degrades to sequential execution instead of failing.
+  const auto& stages = session_state.GetPipelineStages();
+  const bool use_stage_locks = !stages.empty();
+  const SessionState::PipelineStage whole_plan{0, exec_plan_vec.size()};
+  const size_t stage_count = use_stage_locks ? stages.size() : 1;
+
+  std::unique_lock<std::mutex> held_stage_lock;
+
+  for (size_t stage_idx = 0; stage_idx < stage_count; ++stage_idx) {
+    const auto& stage = use_stage_locks ? stages[stage_idx] : whole_plan;
+
+    if (use_stage_locks) {
+      // hand-over-hand: take the next stage's lock before releasing the
+      // previous one, so frames cross every stage boundary in the order they
+      // entered the pipeline and a fast frame can't overtake a slow one.
+      std::unique_lock<std::mutex> next_stage_lock(session_state.GetPipelineStageLock(stage_idx));
+      held_stage_lock = std::move(next_stage_lock);
+    }
+
+    for (size_t step = stage.begin_step; step < stage.end_step; ++step) {
+      const auto& node_exec_plan = exec_plan_vec[step];
+
+      if (cancellation_.IsCancelled()) {
+        LOGS(logger, WARNING) << cancellation_.Reason();
+        return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, cancellation_.Reason());
+      }
+
+      auto node_index = node_exec_plan.node_index;
+      const OpKernel* p_op_kernel;
+      int queue_id;
+      // without finalized plan info assume fences may be present anywhere
+      bool node_has_fence = true;
+
+      if (use_plan_steps) {
+        p_op_kernel = plan_steps[step].kernel;
+        queue_id = plan_steps[step].queue_id;
+        node_has_fence = plan_steps[step].has_fence;
+      } else {
+        p_op_kernel = session_state.GetKernel(node_index);
+
+        if (p_op_kernel == nullptr)
+          return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, "Got nullptr from GetKernel for node: ",
+                                         session_state.GetGraphViewer()->GetNode(node_index)->Name());
+
+        queue_id = p_op_kernel->KernelDef().ExecQueueId();
+      }
+
+      const std::string& node_name = p_op_kernel->Node().Name();
+      const std::string& op_name = p_op_kernel->KernelDef().OpName();
+
+      OpKernelContextInternal op_kernel_context(frame, *p_op_kernel, logger,
+                                                p_op_kernel->Node().ImplicitInputDefs(), cancellation_);
+
+      if (node_has_fence) {
+        auto sync_time_begin = session_state.Profiler().StartTime();
+        for (int input_index = 0; input_index < op_kernel_context.InputCount(); ++input_index) {
+          Fence_t fence = op_kernel_context.InputFence(input_index);
+          if (fence) {
+            fence->BeforeUsingAsInput(p_op_kernel->Node().GetExecutionProviderType(), queue_id);
+          }
+        }
+
+        for (int input_index = 0; input_index < op_kernel_context.ImplicitInputCount(); ++input_index) {
+          Fence_t fence = op_kernel_context.ImplicitInputFence(input_index);
+          if (fence) {
+            fence->BeforeUsingAsInput(p_op_kernel->Node().GetExecutionProviderType(), queue_id);
+          }
+        }
+
+        for (int output_index = 0; output_index < op_kernel_context.OutputCount(); ++output_index) {
+          Fence_t fence = op_kernel_context.OutputFence(output_index);
+          if (fence) {
+            fence->BeforeUsingAsOutput(p_op_kernel->Node().GetExecutionProviderType(), queue_id);
+          }
+        }
+
+        session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
+                                                       node_name + "_fence_before",
+                                                       sync_time_begin,
+                                                       {{"op_name", op_name}});
+      }
+
+      if (use_plan_steps) {
+        session_state.PrefetchStepWeightsAsync(step + 1);
+      }
+
+      VLOGS(logger, 1) << "Computing kernel: " << p_op_kernel->Node().Name();
+
+      auto kernel_begin_time = session_state.Profiler().StartTime();
+      {
+        OpKernelContextInternal::MlasCancelScope mlas_cancel_scope(op_kernel_context);
+        ONNXRUNTIME_RETURN_IF_ERROR(p_op_kernel->Compute(&op_kernel_context));
+      }
+      session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
+                                                     node_name + "_kernel_time",
+                                                     kernel_begin_time,
+                                                     {{"op_name", op_name},
+                                                      {"provider", p_op_kernel->Node().GetExecutionProviderType()}});
+
+      if (node_has_fence) {
+        auto sync_time_begin = session_state.Profiler().StartTime();
+        for (int input_index = 0; input_index < op_kernel_context.InputCount(); ++input_index) {
+          Fence_t fence = op_kernel_context.InputFence(input_index);
+          if (fence) {
+            fence->AfterUsedAsInput(queue_id);
+          }
+        }
+
+        for (int input_index = 0; input_index < op_kernel_context.ImplicitInputCount(); ++input_index) {
+          Fence_t fence = op_kernel_context.ImplicitInputFence(input_index);
+          if (fence) {
+            fence->AfterUsedAsInput(queue_id);
+          }
+        }
+
+        for (int output_index = 0; output_index < op_kernel_context.OutputCount(); ++output_index) {
+          Fence_t fence = op_kernel_context.OutputFence(output_index);
+          if (fence) {
+            fence->AfterUsedAsOutput(queue_id);
+          }
+        }
+        session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
+                                                       node_name + "_fence_after",
+                                                       sync_time_begin,
+                                                       {{"op_name", op_name}});
+      }
+
+      VLOGS(logger, 1) << "Releasing node ML values after computing kernel: " << p_op_kernel->Node().Name();
+      ONNXRUNTIME_RETURN_IF_ERROR(ReleaseNodeMLValues(frame, seq_exec_plan, node_exec_plan, logger));
+
+      frame.RewindScratchArena();
+    }
+  }
+
+  // the last stage's lock is released before the output copies so the next
+  // frame can enter it while this run fetches.
+  if (held_stage_lock.owns_lock()) {
+    held_stage_lock.unlock();
+  }
+
+  VLOGS(logger, 1) << "Fetching output.";
+  ONNXRUNTIME_RETURN_IF_ERROR(FetchOutput(session_state.GetMLValueNameIdxMap(), frame, output_names, fetches, logger));
+
+  if (frame.HasPlan()) {
+    std::vector<TensorShape> input_shapes;
+    bool all_tensors = true;
+    for (const auto& feed : feeds) {
+      if (!(feed.second.IsTensor())) {
+        all_tensors = false;
+        break;
+      }
+      auto& tensor = feed.second.Get<Tensor>();
+      input_shapes.push_back(tensor.Shape());
+    }
+
+    if (all_tensors) {
+      // pattern generation and installation happen off the critical path;
+      // runs before the pattern lands keep using individual allocations.
+      session_state.UpdateMemoryPatternGroupCacheAsync(std::move(input_shapes), frame.TakePlanner());
+    }
+  }
+
+  // publish the shape state the kernels recorded during this run, so later
+  // runs with the same input shapes skip their shape arithmetic.
+  if (frame.IsRecordingShapeBindings()) {
+    ONNXRUNTIME_RETURN_IF_ERROR(session_state.UpdateShapeBindingCache(frame.TakeRecordedShapeBindings()));
+  }
+
+  session_state.Profiler().EndTimeAndRecordEvent(profiling::SESSION_EVENT, "PipelineExecutor::Execute", tp);
+  return Status::OK();
+}
+
+static Status FetchOutput(const MLValueNameIdxMap& name_idx_map,
+                          ExecutionFrame& frame,
+                          const std::vector<std::string>& output_names,
+                          std::vector<MLValue>& fetches,
+                          const logging::Logger& logger) {
+  if (fetches.empty()) {
+    fetches.resize(output_names.size());
+  } else {
+    // this should've been checked before already
+    ONNXRUNTIME_ENFORCE(output_names.size() == fetches.size(),
+                        "output_names vector size: " + std::to_string(output_names.size()) +
+                            " does not match that of fetches vector: " + std::to_string(fetches.size()));
+  }
+
+  auto idx = 0;
+
+  for (const auto& oname : output_names) {
+    VLOGS(logger, 1) << "Attempting to fetch output with name: " << oname;
+    int mlvalue_index;
+    ONNXRUNTIME_RETURN_IF_ERROR(name_idx_map.GetIdx(oname, mlvalue_index));
+    const MLValue& output_mlvalue = frame.GetMLValue(mlvalue_index);
+    VLOGS(logger, 1) << "Copying fetched MLValue to output vector";
+    fetches[idx++] = output_mlvalue;
+  }
+
+  VLOGS(logger, 1) << "Done with execution.";
+  return Status::OK();
+}
+
+static Status ReleaseNodeMLValues(ExecutionFrame& frame,
+                                  const SequentialExecutionPlan& seq_exec_plan,
+                                  const SequentialExecutionPlan::NodeExecutionPlan& node_exec_plan,
+                                  const logging::Logger& logger) {
+  for (auto i = node_exec_plan.free_from_index; i <= node_exec_plan.free_to_index; ++i) {
+    auto mlvalue_idx = seq_exec_plan.to_be_freed[i];
+    VLOGS(logger, 1) << "Releasing mlvalue with index: " << mlvalue_idx;
+    ONNXRUNTIME_RETURN_IF_ERROR(frame.ReleaseMLValue(mlvalue_idx));
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
@@ -0,0 +1,59 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include "core/common/common.h"
+#include "core/common/status.h"
+#include "core/common/logging/logging.h"
+#include "core/framework/iexecutor.h"
+#include "core/framework/framework_common.h"
+#include "core/framework/ml_value.h"
+#include "core/framework/run_cancellation.h"
+#include "core/framework/session_state.h"
+#include "core/graph/graph_viewer.h"
+
+namespace onnxruntime {
+class ExecutionFrame;
+
+// Executes the plan stage by stage (see SessionState::GetPipelineStages):
+// each stage is guarded by its own lock, so when several Run calls are in
+// flight, stage i of one frame overlaps stage i-1 of the next. A stream of
+// frames submitted from two caller threads approaches 2x throughput on a
+// plan split into two cost-balanced stages, while each frame still runs its
+// nodes one at a time with no extra copies, leaving per-frame latency
+// untouched. Falls back to plain sequential execution when the session has
+// no pipeline stages.
+class PipelineExecutor : public IExecutor {
+ public:
+  PipelineExecutor(const RunCancellation& cancellation = {}, const std::string& run_tag = {})
+      : cancellation_{cancellation}, run_tag_{run_tag} {}
+
+  common::Status Execute(const SessionState& session_state,
+                         const NameMLValMap& feeds,
+                         const std::vector<std::string>& output_names,
+                         std::vector<MLValue>& fetches,
+                         const logging::Logger& logger) override;
+
+  // Variant used by InferenceSession: executes on a caller-owned frame that
+  // has already been populated with the feeds and fetches for this run,
+  // instead of building a new frame.
+  common::Status Execute(const SessionState& session_state,
+                         ExecutionFrame& frame,
+                         const NameMLValMap& feeds,
+                         const std::vector<std::string>& output_names,
+                         std::vector<MLValue>& fetches,
+                         const logging::Logger& logger);
+
+ private:
+  ONNXRUNTIME_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PipelineExecutor);
+
+  RunCancellation cancellation_;
+
+  // request tag from RunOptions.run_tag; profiler events recorded during
+  // this run carry it for cross-layer span correlation
+  std::string run_tag_;
+};
+}  // namespace onnxruntime
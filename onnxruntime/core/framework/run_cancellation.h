@@ -0,0 +1,60 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+
+#include "core/framework/run_options.h"
+
+namespace onnxruntime {
+
+// Cooperative cancellation state for a single Run() call: the caller's
+// terminate flag from the RunOptions plus an optional deadline derived from
+// the run timeout. Copyable so executors and kernel contexts can hold it by
+// value; the referenced terminate flag lives in the RunOptions instance,
+// which must outlive the run (the RunOptions contract already requires this
+// for the terminate mechanism).
+class RunCancellation {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  RunCancellation() = default;
+
+  RunCancellation(const bool& terminate_flag, Clock::time_point deadline = Clock::time_point::max())
+      : terminate_flag_{&terminate_flag}, deadline_{deadline} {}
+
+  // Builds the cancellation state for a run starting now, converting the
+  // relative timeout in the run options into an absolute deadline.
+  static RunCancellation FromRunOptions(const RunOptions& run_options) {
+    auto deadline = run_options.run_timeout_in_milliseconds > 0
+                        ? Clock::now() + std::chrono::milliseconds(run_options.run_timeout_in_milliseconds)
+                        : Clock::time_point::max();
+    return RunCancellation{run_options.terminate, deadline};
+  }
+
+  bool TerminateRequested() const noexcept {
+    return terminate_flag_ != nullptr && *terminate_flag_;
+  }
+
+  bool DeadlineExceeded() const noexcept {
+    return deadline_ != Clock::time_point::max() && Clock::now() >= deadline_;
+  }
+
+  bool IsCancelled() const noexcept {
+    return TerminateRequested() || DeadlineExceeded();
+  }
+
+  // Message used when aborting a cancelled run, distinct per cause so a
+  // client-side terminate can be told apart from an expired deadline.
+  const char* Reason() const noexcept {
+    return TerminateRequested() ? "Exiting due to terminate flag being set to true."
+                                : "Exiting due to the run deadline being exceeded.";
+  }
+
+ private:
+  const bool* terminate_flag_ = nullptr;
+  Clock::time_point deadline_ = Clock::time_point::max();
+};
+
+}  // namespace onnxruntime
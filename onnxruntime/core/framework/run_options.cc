@@ -32,3 +32,20 @@ ONNXRUNTIME_API(const char*, ONNXRuntimeRunOptionsGetRunTag, _In_ ONNXRuntimeRun
 ONNXRUNTIME_API(void, ONNXRuntimeRunOptionsSetTerminate, _In_ ONNXRuntimeRunOptions* options, bool value) {
   options->terminate = value;
 }
+
+ONNXRUNTIME_API(void, ONNXRuntimeRunOptionsSetRunTimeout, _In_ ONNXRuntimeRunOptions* options, int64_t timeout_in_milliseconds) {
+  options->run_timeout_in_milliseconds = timeout_in_milliseconds < 0 ? 0 : timeout_in_milliseconds;
+}
+
+ONNXRUNTIME_API(void, ONNXRuntimeRunOptionsSetMaxParallelism, _In_ ONNXRuntimeRunOptions* options, int max_parallelism) {
+  options->max_intra_op_parallelism = max_parallelism < 0 ? 0 : max_parallelism;
+}
+
+ONNXRUNTIME_API_STATUS_IMPL(ONNXRuntimeRunOptionsSetOutputLocation, _In_ ONNXRuntimeRunOptions* options, _In_ const char* output_name, int device_resident) {
+  if (!output_name)
+    return CreateONNXStatus(ONNXRUNTIME_INVALID_ARGUMENT, "output_name is null");
+  options->fetch_locations[output_name] = device_resident != 0
+                                              ? ONNXRuntimeRunOptions::kFetchLocationDevice
+                                              : ONNXRuntimeRunOptions::kFetchLocationHost;
+  return nullptr;
+}
@@ -0,0 +1,85 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/allocator.h"
+#include "core/framework/tensor.h"
+
+namespace onnxruntime {
+
+/**
+   Per-run bump allocator for kernel temporaries.
+
+   Kernels that need scratch space for the duration of one Compute() call
+   (im2col buffers, transposed copies, softmax intermediates) borrow it here
+   with a pointer bump instead of a full allocator round trip, and the
+   executor rewinds the arena after every node so the space is reclaimed
+   wholesale. Requests that do not fit the current chunk fall back to direct
+   allocations that are freed on rewind; either way the total is tracked, so
+   the high-water mark of a run can size the chunk of later runs up front.
+
+   Not thread safe: one arena serves one sequentially executing frame.
+*/
+class ScratchBufferArena {
+ public:
+  ScratchBufferArena(AllocatorPtr allocator, size_t initial_capacity)
+      : allocator_(std::move(allocator)) {
+    if (initial_capacity > 0) {
+      chunk_ = BufferUniquePtr(allocator_->Alloc(initial_capacity), BufferDeleter(allocator_));
+      capacity_ = initial_capacity;
+    }
+  }
+
+  // Borrow size bytes, valid until the next Rewind(). The bump offset is kept
+  // aligned to kAlignment, which matches what the allocators return.
+  void* Reserve(size_t size) {
+    size_t aligned_size = (size + kAlignment - 1) & ~(kAlignment - 1);
+    used_ += aligned_size;
+    if (offset_ + aligned_size <= capacity_) {
+      void* p = static_cast<uint8_t*>(chunk_.get()) + offset_;
+      offset_ += aligned_size;
+      return p;
+    }
+
+    // chunk exhausted (or this run's shapes outgrew the last high-water
+    // mark): fall back to a direct allocation that lives until rewind. it
+    // still counts towards used_, so the next run's chunk covers it.
+    overflow_.emplace_back(allocator_->Alloc(aligned_size), BufferDeleter(allocator_));
+    return overflow_.back().get();
+  }
+
+  // Reclaim everything reserved since the last rewind. Called by the executor
+  // once the current node has completed.
+  void Rewind() {
+    if (used_ > high_water_mark_)
+      high_water_mark_ = used_;
+    used_ = 0;
+    offset_ = 0;
+    overflow_.clear();
+  }
+
+  // Largest per-node usage seen so far, including any pending (un-rewound)
+  // reservations.
+  size_t HighWaterMark() const {
+    return used_ > high_water_mark_ ? used_ : high_water_mark_;
+  }
+
+ private:
+  ONNXRUNTIME_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ScratchBufferArena);
+
+  static constexpr size_t kAlignment = 64;
+
+  AllocatorPtr allocator_;
+  BufferUniquePtr chunk_;
+  size_t capacity_ = 0;
+  size_t offset_ = 0;
+  size_t used_ = 0;
+  size_t high_water_mark_ = 0;
+  std::vector<BufferUniquePtr> overflow_;
+};
+
+}  // namespace onnxruntime
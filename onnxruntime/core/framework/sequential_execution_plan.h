@@ -66,6 +66,18 @@ struct SequentialExecutionPlan {
 
   // to_be_freed: vector elements represent indices of ml-values to be freed (as described above)
   std::vector<MLValueIndex> to_be_freed;
+
+  // RecomputeStep: a node to re-execute immediately before the execution-plan
+  // step at program_counter, because its output was freed early to keep peak
+  // activation memory under a configured budget. The same ml-value may be
+  // freed and recomputed several times over the plan; to_be_freed carries the
+  // extra frees. Entries are sorted by program_counter and only honored by
+  // the SequentialExecutor.
+  struct RecomputeStep {
+    size_t program_counter;
+    onnxruntime::NodeIndex node_index;
+  };
+  std::vector<RecomputeStep> recompute_plan;
 };
 
 // Output details of an execution plan:
@@ -31,109 +31,215 @@ Status SequentialExecutor::Execute(const SessionState& session_state,
                                    const std::vector<std::string>& output_names,
                                    std::vector<MLValue>& fetches,
                                    const logging::Logger& logger) {
-  auto tp = session_state.Profiler().StartTime();
-
   ExecutionFrame frame{feeds, output_names, fetches, session_state};
 
+  return Execute(session_state, frame, feeds, output_names, fetches, logger);
+}
+
+Status SequentialExecutor::Execute(const SessionState& session_state,
+                                   ExecutionFrame& frame,
+                                   const NameMLValMap& feeds,
+                                   const std::vector<std::string>& output_names,
+                                   std::vector<MLValue>& fetches,
+                                   const logging::Logger& logger,
+                                   std::vector<std::unique_ptr<OpKernelContextInternal>>* node_contexts) {
+  auto tp = session_state.Profiler().StartTime();
+  profiling::ScopedTraceTag trace_tag(&run_tag_);
+
   LOGS(logger, INFO) << "Begin execution";
+
+  // nodes run one at a time here, so kernel temporaries can come from the
+  // frame's bump arena and be reclaimed wholesale after each node.
+  frame.EnableScratchArena();
+
   const SequentialExecutionPlan& seq_exec_plan = *session_state.GetExecutionPlan();
   const auto& exec_plan_vec = seq_exec_plan.execution_plan;
   VLOGS(logger, 1) << "Size of execution plan vector: " << exec_plan_vec.size();
 
+  // when the session state finalized its execution plan info, the kernel and
+  // queue id per step are in a flat array and the inner loop does no hashing.
+  const auto& plan_steps = session_state.GetFinalizedPlanSteps();
+  const bool use_plan_steps = plan_steps.size() == exec_plan_vec.size();
+
   // uncomment the line below to dump execution plan
   //std::cout << std::make_pair(p_seq_exec_plan, &session_state) << "\n";
 
-  for (const auto& node_exec_plan : exec_plan_vec) {
-    if (terminate_flag_) {
-      LOGS(logger, WARNING) << "Exiting due to terminate flag being set to true.";
-      return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exiting due to terminate flag being set to true.");
-    }
+  // cursor into the (program-counter sorted) recompute plan, if any.
+  size_t recompute_cursor = 0;
 
-    auto node_index = node_exec_plan.node_index;
-    auto p_op_kernel = session_state.GetKernel(node_index);
+  for (size_t step = 0; step < exec_plan_vec.size(); ++step) {
+    const auto& node_exec_plan = exec_plan_vec[step];
 
-    // if a kernel has been added in the session state, it better be NON-null.
-    if (p_op_kernel == nullptr)
-      return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, "Got nullptr from GetKernel for node: ",
-                                     session_state.GetGraphViewer()->GetNode(node_index)->Name());
+    if (cancellation_.IsCancelled()) {
+      LOGS(logger, WARNING) << cancellation_.Reason();
+      return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, cancellation_.Reason());
+    }
 
-    const std::string& node_name = p_op_kernel->Node().Name();
-    const std::string& op_name = p_op_kernel->KernelDef().OpName();
-    // construct OpKernelContext
-    // TODO: log kernel inputs?
-    OpKernelContextInternal op_kernel_context(frame, *p_op_kernel, logger, p_op_kernel->Node().ImplicitInputDefs(),
-                                              terminate_flag_);
-    // TODO: log kernel outputs?
-
-    auto sync_time_begin = session_state.Profiler().StartTime();
-    // sync before compute
-    int queue_id = p_op_kernel->KernelDef().ExecQueueId();
-    for (int input_index = 0; input_index < op_kernel_context.InputCount(); ++input_index) {
-      Fence_t fence = op_kernel_context.InputFence(input_index);
-      if (fence) {
-        fence->BeforeUsingAsInput(p_op_kernel->Node().GetExecutionProviderType(), queue_id);
+    // re-run nodes whose outputs were freed early under the activation memory
+    // budget and are needed again from this step on. the planner only picks
+    // fence-free CPU nodes, so a plain Compute suffices; the frame allocates
+    // the released output afresh per the allocation plan.
+    while (recompute_cursor < seq_exec_plan.recompute_plan.size() &&
+           seq_exec_plan.recompute_plan[recompute_cursor].program_counter == step) {
+      const auto recompute_node_index = seq_exec_plan.recompute_plan[recompute_cursor].node_index;
+      const auto* p_recompute_kernel = session_state.GetKernel(recompute_node_index);
+      if (p_recompute_kernel == nullptr)
+        return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, "Got nullptr from GetKernel for recompute node: ",
+                                       session_state.GetGraphViewer()->GetNode(recompute_node_index)->Name());
+
+      VLOGS(logger, 1) << "Recomputing kernel: " << p_recompute_kernel->Node().Name();
+
+      auto recompute_begin_time = session_state.Profiler().StartTime();
+      OpKernelContextInternal recompute_context(frame, *p_recompute_kernel, logger,
+                                                p_recompute_kernel->Node().ImplicitInputDefs(), cancellation_);
+      {
+        OpKernelContextInternal::MlasCancelScope mlas_cancel_scope(recompute_context);
+        ONNXRUNTIME_RETURN_IF_ERROR(p_recompute_kernel->Compute(&recompute_context));
       }
+      session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
+                                                     p_recompute_kernel->Node().Name() + "_recompute_kernel_time",
+                                                     recompute_begin_time,
+                                                     {{"op_name", p_recompute_kernel->KernelDef().OpName()}});
+
+      frame.RewindScratchArena();
+      ++recompute_cursor;
     }
 
-    for (int input_index = 0; input_index < op_kernel_context.ImplicitInputCount(); ++input_index) {
-      Fence_t fence = op_kernel_context.ImplicitInputFence(input_index);
-      if (fence) {
-        fence->BeforeUsingAsInput(p_op_kernel->Node().GetExecutionProviderType(), queue_id);
-      }
+    auto node_index = node_exec_plan.node_index;
+    const OpKernel* p_op_kernel;
+    int queue_id;
+    // without finalized plan info assume fences may be present anywhere
+    bool node_has_fence = true;
+
+    if (use_plan_steps) {
+      p_op_kernel = plan_steps[step].kernel;
+      queue_id = plan_steps[step].queue_id;
+      node_has_fence = plan_steps[step].has_fence;
+    } else {
+      p_op_kernel = session_state.GetKernel(node_index);
+
+      // if a kernel has been added in the session state, it better be NON-null.
+      if (p_op_kernel == nullptr)
+        return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, "Got nullptr from GetKernel for node: ",
+                                       session_state.GetGraphViewer()->GetNode(node_index)->Name());
+
+      queue_id = p_op_kernel->KernelDef().ExecQueueId();
     }
 
-    for (int output_index = 0; output_index < op_kernel_context.OutputCount(); ++output_index) {
-      Fence_t fence = op_kernel_context.OutputFence(output_index);
-      if (fence) {
-        fence->BeforeUsingAsOutput(p_op_kernel->Node().GetExecutionProviderType(), queue_id);
+    const std::string& node_name = p_op_kernel->Node().Name();
+    const std::string& op_name = p_op_kernel->KernelDef().OpName();
+
+    // runs the fence walks, compute and value release with whichever context
+    // serves this step: a stack context for one-shot runs, or the caller's
+    // preconstructed context when a reusable run context is in play.
+    auto run_step = [&](OpKernelContextInternal& op_kernel_context) -> Status {
+      // the per-value fence walks (and their profiler events) only run for
+      // nodes the plan flagged as fence-carrying; everything else dispatches
+      // straight into Compute so async device kernels queue back-to-back
+      if (node_has_fence) {
+        auto sync_time_begin = session_state.Profiler().StartTime();
+        // sync before compute
+        for (int input_index = 0; input_index < op_kernel_context.InputCount(); ++input_index) {
+          Fence_t fence = op_kernel_context.InputFence(input_index);
+          if (fence) {
+            fence->BeforeUsingAsInput(p_op_kernel->Node().GetExecutionProviderType(), queue_id);
+          }
+        }
+
+        for (int input_index = 0; input_index < op_kernel_context.ImplicitInputCount(); ++input_index) {
+          Fence_t fence = op_kernel_context.ImplicitInputFence(input_index);
+          if (fence) {
+            fence->BeforeUsingAsInput(p_op_kernel->Node().GetExecutionProviderType(), queue_id);
+          }
+        }
+
+        for (int output_index = 0; output_index < op_kernel_context.OutputCount(); ++output_index) {
+          Fence_t fence = op_kernel_context.OutputFence(output_index);
+          if (fence) {
+            fence->BeforeUsingAsOutput(p_op_kernel->Node().GetExecutionProviderType(), queue_id);
+          }
+        }
+
+        session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
+                                                       node_name + "_fence_before",
+                                                       sync_time_begin,
+                                                       {{"op_name", op_name}});
       }
-    }
 
-    session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
-                                                   node_name + "_fence_before",
-                                                   sync_time_begin,
-                                                   {{"op_name", op_name}});
-
-    // call compute on the kernel
-    VLOGS(logger, 1) << "Computing kernel: " << p_op_kernel->Node().Name();
-
-    auto kernel_begin_time = session_state.Profiler().StartTime();
-    ONNXRUNTIME_RETURN_IF_ERROR(p_op_kernel->Compute(&op_kernel_context));
-    session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
-                                                   node_name + "_kernel_time",
-                                                   kernel_begin_time,
-                                                   {{"op_name", op_name}});
-
-    sync_time_begin = session_state.Profiler().StartTime();
-    // sync after compute for outputs
-    for (int input_index = 0; input_index < op_kernel_context.InputCount(); ++input_index) {
-      Fence_t fence = op_kernel_context.InputFence(input_index);
-      if (fence) {
-        fence->AfterUsedAsInput(queue_id);
+      // pull the next node's weights toward the cache while this node computes,
+      // so its first weight touch doesn't stall on DRAM.
+      if (use_plan_steps) {
+        session_state.PrefetchStepWeightsAsync(step + 1);
       }
-    }
 
-    for (int input_index = 0; input_index < op_kernel_context.ImplicitInputCount(); ++input_index) {
-      Fence_t fence = op_kernel_context.ImplicitInputFence(input_index);
-      if (fence) {
-        fence->AfterUsedAsInput(queue_id);
+      // call compute on the kernel
+      VLOGS(logger, 1) << "Computing kernel: " << p_op_kernel->Node().Name();
+
+      auto kernel_begin_time = session_state.Profiler().StartTime();
+      {
+        OpKernelContextInternal::MlasCancelScope mlas_cancel_scope(op_kernel_context);
+        ONNXRUNTIME_RETURN_IF_ERROR(p_op_kernel->Compute(&op_kernel_context));
+      }
+      session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
+                                                     node_name + "_kernel_time",
+                                                     kernel_begin_time,
+                                                     {{"op_name", op_name},
+                                                      {"provider", p_op_kernel->Node().GetExecutionProviderType()}});
+
+      if (node_has_fence) {
+        auto sync_time_begin = session_state.Profiler().StartTime();
+        // sync after compute for outputs
+        for (int input_index = 0; input_index < op_kernel_context.InputCount(); ++input_index) {
+          Fence_t fence = op_kernel_context.InputFence(input_index);
+          if (fence) {
+            fence->AfterUsedAsInput(queue_id);
+          }
+        }
+
+        for (int input_index = 0; input_index < op_kernel_context.ImplicitInputCount(); ++input_index) {
+          Fence_t fence = op_kernel_context.ImplicitInputFence(input_index);
+          if (fence) {
+            fence->AfterUsedAsInput(queue_id);
+          }
+        }
+
+        for (int output_index = 0; output_index < op_kernel_context.OutputCount(); ++output_index) {
+          Fence_t fence = op_kernel_context.OutputFence(output_index);
+          if (fence) {
+            fence->AfterUsedAsOutput(queue_id);
+          }
+        }
+        session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
+                                                       node_name + "_fence_after",
+                                                       sync_time_begin,
+                                                       {{"op_name", op_name}});
       }
-    }
 
-    for (int output_index = 0; output_index < op_kernel_context.OutputCount(); ++output_index) {
-      Fence_t fence = op_kernel_context.OutputFence(output_index);
-      if (fence) {
-        fence->AfterUsedAsOutput(queue_id);
+      // free ml-values corresponding to this node
+      VLOGS(logger, 1) << "Releasing node ML values after computing kernel: " << p_op_kernel->Node().Name();
+      ONNXRUNTIME_RETURN_IF_ERROR(ReleaseNodeMLValues(frame, seq_exec_plan, node_exec_plan, logger));
+
+      // reclaim any scratch memory the kernel borrowed for this node
+      frame.RewindScratchArena();
+      return Status::OK();
+    };
+
+    if (node_contexts != nullptr) {
+      // contexts owned by the caller's run context: constructed once on the
+      // first run through the plan, re-pointed at this run's frame by
+      // pointer swap on every later run.
+      if (step == node_contexts->size()) {
+        node_contexts->push_back(std::make_unique<OpKernelContextInternal>(
+            frame, *p_op_kernel, logger, p_op_kernel->Node().ImplicitInputDefs(), cancellation_));
+      } else {
+        (*node_contexts)[step]->Rebind(frame, logger, cancellation_);
       }
+      ONNXRUNTIME_RETURN_IF_ERROR(run_step(*(*node_contexts)[step]));
+    } else {
+      OpKernelContextInternal op_kernel_context(frame, *p_op_kernel, logger,
+                                                p_op_kernel->Node().ImplicitInputDefs(), cancellation_);
+      ONNXRUNTIME_RETURN_IF_ERROR(run_step(op_kernel_context));
     }
-    session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
-                                                   node_name + "_fence_after",
-                                                   sync_time_begin,
-                                                   {{"op_name", op_name}});
-
-    // free ml-values corresponding to this node
-    VLOGS(logger, 1) << "Releasing node ML values after computing kernel: " << p_op_kernel->Node().Name();
-    ONNXRUNTIME_RETURN_IF_ERROR(ReleaseNodeMLValues(frame, seq_exec_plan, node_exec_plan, logger));
   }
 
   VLOGS(logger, 1) << "Fetching output.";
@@ -152,12 +258,18 @@ Status SequentialExecutor::Execute(const SessionState& session_state,
     }
 
     if (all_tensors) {
-      auto mem_patterns = std::make_unique<MemoryPatternGroup>();
-      ONNXRUNTIME_RETURN_IF_ERROR(frame.GeneratePatterns(mem_patterns.get()));
-      ONNXRUNTIME_RETURN_IF_ERROR(session_state.UpdateMemoryPatternGroupCache(input_shapes, std::move(mem_patterns)));
+      // pattern generation and installation happen off the critical path;
+      // runs before the pattern lands keep using individual allocations.
+      session_state.UpdateMemoryPatternGroupCacheAsync(std::move(input_shapes), frame.TakePlanner());
     }
   }
 
+  // publish the shape state the kernels recorded during this run, so later
+  // runs with the same input shapes skip their shape arithmetic.
+  if (frame.IsRecordingShapeBindings()) {
+    ONNXRUNTIME_RETURN_IF_ERROR(session_state.UpdateShapeBindingCache(frame.TakeRecordedShapeBindings()));
+  }
+
   session_state.Profiler().EndTimeAndRecordEvent(profiling::SESSION_EVENT, "SequentialExecutor::Execute", tp);
   return Status::OK();
 }
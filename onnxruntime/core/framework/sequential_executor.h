@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 #include "core/common/common.h"
 #include "core/common/status.h"
@@ -10,13 +11,18 @@
 #include "core/framework/iexecutor.h"
 #include "core/framework/framework_common.h"
 #include "core/framework/ml_value.h"
+#include "core/framework/run_cancellation.h"
 #include "core/framework/session_state.h"
 #include "core/graph/graph_viewer.h"
 
 namespace onnxruntime {
+class ExecutionFrame;
+class OpKernelContextInternal;
+
 class SequentialExecutor : public IExecutor {
  public:
-  SequentialExecutor(const bool& terminate_flag = false) : terminate_flag_{terminate_flag} {}
+  SequentialExecutor(const RunCancellation& cancellation = {}, const std::string& run_tag = {})
+      : cancellation_{cancellation}, run_tag_{run_tag} {}
 
   common::Status Execute(const SessionState& session_state,
                          const NameMLValMap& feeds,
@@ -24,8 +30,26 @@ class SequentialExecutor : public IExecutor {
                          std::vector<MLValue>& fetches,
                          const logging::Logger& logger) override;
 
+  // Variant used by RunContext: executes on a caller-owned frame that has
+  // already been populated with the feeds and fetches for this run, instead
+  // of building a new frame. When node_contexts is given the per-node kernel
+  // contexts live there too: the first run through the plan constructs them,
+  // later runs re-point them at the frame by pointer swap instead of
+  // rebuilding them per node.
+  common::Status Execute(const SessionState& session_state,
+                         ExecutionFrame& frame,
+                         const NameMLValMap& feeds,
+                         const std::vector<std::string>& output_names,
+                         std::vector<MLValue>& fetches,
+                         const logging::Logger& logger,
+                         std::vector<std::unique_ptr<OpKernelContextInternal>>* node_contexts = nullptr);
+
  private:
   ONNXRUNTIME_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SequentialExecutor);
-  const bool& terminate_flag_;
+  RunCancellation cancellation_;
+
+  // request tag from RunOptions.run_tag; profiler events recorded during
+  // this run carry it for cross-layer span correlation
+  std::string run_tag_;
 };
 }  // namespace onnxruntime
@@ -3,14 +3,38 @@
 
 #include "core/framework/session_state.h"
 
+#include <algorithm>
+#include <chrono>
 #include <sstream>
 
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
 #include "core/common/logging/logging.h"
+#include "core/common/work_stealing_thread_pool.h"
+#include "core/framework/allocatormgr.h"
+#include "core/framework/ml_value_patterns_planner.h"
 #include "core/framework/op_kernel.h"
+#include "core/framework/shape_bindings.h"
+#include "core/framework/utils.h"
+#include "core/platform/thread_affinity.h"
 
 using namespace ::onnxruntime::common;
 namespace onnxruntime {
 
+SessionState::~SessionState() {
+  std::vector<std::future<void>> tasks;
+  {
+    std::lock_guard<std::mutex> lock(background_tasks_lock_);
+    tasks.swap(background_tasks_);
+  }
+
+  for (auto& task : tasks) {
+    task.wait();
+  }
+}
+
 void SessionState::SetGraphViewer(std::unique_ptr<onnxruntime::GraphViewer> graph_viewer) {
   ONNXRUNTIME_ENFORCE(nullptr != graph_viewer);
   graph_viewer_ = std::move(graph_viewer);
@@ -41,6 +65,275 @@ const SequentialExecutionPlan* SessionState::GetExecutionPlan() const {
   return p_seq_exec_plan_.get();
 }
 
+static Status AddNodeArgValueIndex(const MLValueNameIdxMap& mlvalue_name_idx_map,
+                                   const onnxruntime::NodeArg* arg,
+                                   std::vector<int>& node_arg_value_indices) {
+  ONNXRUNTIME_ENFORCE(arg);
+  // an arg with an empty name is an unused optional input/output. use -1 so
+  // the execution frame can tell it apart from a real mlvalue index.
+  if (arg->Name().empty()) {
+    node_arg_value_indices.push_back(-1);
+    return Status::OK();
+  }
+
+  int index;
+  ONNXRUNTIME_RETURN_IF_ERROR(mlvalue_name_idx_map.GetIdx(arg->Name(), index));
+  node_arg_value_indices.push_back(index);
+  return Status::OK();
+}
+
+Status SessionState::FinalizeExecutionPlanInfo() {
+  ONNXRUNTIME_ENFORCE(graph_viewer_, "Graph viewer was not found in SessionState.");
+  ONNXRUNTIME_ENFORCE(p_seq_exec_plan_, "Execution plan was not found in SessionState.");
+
+  // 1. kernel and exec queue id per plan step so the executor inner loop
+  // doesn't hash into session_kernels_ per node per run.
+  const auto& exec_plan_vec = p_seq_exec_plan_->execution_plan;
+  finalized_plan_steps_.clear();
+  finalized_plan_steps_.reserve(exec_plan_vec.size());
+  for (const auto& node_exec_plan : exec_plan_vec) {
+    PlanStepInfo step_info;
+    step_info.kernel = GetKernel(node_exec_plan.node_index);
+    if (step_info.kernel == nullptr) {
+      return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, "Got nullptr from GetKernel for node: ",
+                                     graph_viewer_->GetNode(node_exec_plan.node_index)->Name());
+    }
+    step_info.queue_id = step_info.kernel->KernelDef().ExecQueueId();
+
+    // fences only exist on values the allocation plan flagged for async
+    // sync, so a node whose defs have no such value can never see one.
+    // along the way record the CPU weight buffers the node reads, so an
+    // executor can prefetch them ahead of the node's dispatch.
+    const auto* node = graph_viewer_->GetNode(node_exec_plan.node_index);
+    node->ForEachDef([this, &step_info](const onnxruntime::NodeArg& arg, bool is_input) {
+      int value_idx;
+      if (!arg.Exists() || !mlvalue_name_idx_map_.GetIdx(arg.Name(), value_idx).IsOK())
+        return;
+
+      if (p_seq_exec_plan_->allocation_plan[value_idx].create_fence_if_async) {
+        step_info.has_fence = true;
+      }
+
+      if (is_input) {
+        auto it = initialized_tensors_.find(value_idx);
+        if (it != initialized_tensors_.end() && it->second.IsTensor()) {
+          const Tensor& weight = it->second.Get<Tensor>();
+          if (strcmp(weight.Location().name, CPU) == 0 &&
+              weight.DataType() != DataTypeImpl::GetType<std::string>()) {
+            step_info.weight_buffers.emplace_back(weight.DataRaw(),
+                                                  weight.DataType()->Size() * static_cast<size_t>(weight.Shape().Size()));
+          }
+        }
+      }
+    });
+
+    finalized_plan_steps_.push_back(step_info);
+  }
+
+  // 2. group the plan order into regions of mutually independent nodes. a
+  // step joins the open region when none of its input edges come from inside
+  // it, so every node in a region may run concurrently with its neighbours.
+  execution_regions_.clear();
+  std::vector<int> node_region(graph_viewer_->MaxNodeIndex(), -1);
+  for (size_t step = 0; step < exec_plan_vec.size(); ++step) {
+    const auto node_index = exec_plan_vec[step].node_index;
+    const auto* node = graph_viewer_->GetNode(node_index);
+
+    bool depends_on_open_region = false;
+    if (!execution_regions_.empty()) {
+      const int open_region = static_cast<int>(execution_regions_.size()) - 1;
+      for (auto it = node->InputEdgesBegin(), end = node->InputEdgesEnd(); it != end; ++it) {
+        if (node_region[(*it).GetNode().Index()] == open_region) {
+          depends_on_open_region = true;
+          break;
+        }
+      }
+    }
+
+    if (execution_regions_.empty() || depends_on_open_region) {
+      execution_regions_.push_back(ExecutionRegion{step, step + 1});
+    } else {
+      ++execution_regions_.back().end_step;
+    }
+
+    node_region[node_index] = static_cast<int>(execution_regions_.size()) - 1;
+  }
+
+  // 2b. group the plan steps into per-provider lanes. a heterogeneous plan
+  // whose partitions only meet at a few join points (a CPU tower beside a
+  // CUDA tower) runs its lanes concurrently; each step records the earlier
+  // steps on other lanes it consumes so the executor can wait at the joins.
+  execution_lanes_.clear();
+  cross_lane_deps_.clear();
+  std::vector<int> node_step(graph_viewer_->MaxNodeIndex(), -1);
+  std::vector<size_t> step_lane(exec_plan_vec.size(), 0);
+  for (size_t step = 0; step < exec_plan_vec.size(); ++step) {
+    const auto node_index = exec_plan_vec[step].node_index;
+    const auto& provider_type = graph_viewer_->GetNode(node_index)->GetExecutionProviderType();
+
+    size_t lane = execution_lanes_.size();
+    for (size_t i = 0; i < execution_lanes_.size(); ++i) {
+      if (execution_lanes_[i].provider_type == provider_type) {
+        lane = i;
+        break;
+      }
+    }
+    if (lane == execution_lanes_.size()) {
+      execution_lanes_.push_back(ExecutionLane{{}, provider_type});
+    }
+
+    execution_lanes_[lane].steps.push_back(step);
+    step_lane[step] = lane;
+    node_step[node_index] = static_cast<int>(step);
+  }
+
+  if (execution_lanes_.size() >= 2) {
+    size_t total_cross_deps = 0;
+    cross_lane_deps_.resize(exec_plan_vec.size());
+    for (size_t step = 0; step < exec_plan_vec.size(); ++step) {
+      const auto* node = graph_viewer_->GetNode(exec_plan_vec[step].node_index);
+      for (auto it = node->InputEdgesBegin(), end = node->InputEdgesEnd(); it != end; ++it) {
+        const int producer_step = node_step[(*it).GetNode().Index()];
+        if (producer_step >= 0 && step_lane[producer_step] != step_lane[step]) {
+          cross_lane_deps_[step].push_back(static_cast<size_t>(producer_step));
+          ++total_cross_deps;
+        }
+      }
+    }
+
+    // a single-node lane or partitions that ping-pong every other step spend
+    // more time at joins than they overlap; run those plans serially.
+    bool lanes_pay_off = total_cross_deps * 2 <= exec_plan_vec.size();
+    for (const auto& lane : execution_lanes_) {
+      if (lane.steps.size() < 2) {
+        lanes_pay_off = false;
+      }
+    }
+    if (!lanes_pay_off) {
+      execution_lanes_.clear();
+      cross_lane_deps_.clear();
+    }
+  } else {
+    execution_lanes_.clear();
+  }
+
+  // 3. node arg to mlvalue index tables. these are graph-constant, so build
+  // them once here instead of in every execution frame.
+  // sized by the max node index as that is what node_arg_offsets_ is indexed by.
+  node_arg_offsets_.clear();
+  node_arg_offsets_.resize(graph_viewer_->MaxNodeIndex());
+  node_arg_value_indices_.clear();
+
+  for (auto& node : graph_viewer_->Nodes()) {
+    ONNXRUNTIME_ENFORCE(node.Index() < node_arg_offsets_.size());
+    node_arg_offsets_[node.Index()] = static_cast<int>(node_arg_value_indices_.size());
+
+    for (auto input_def : node.InputDefs()) {
+      ONNXRUNTIME_RETURN_IF_ERROR(AddNodeArgValueIndex(mlvalue_name_idx_map_, input_def, node_arg_value_indices_));
+    }
+
+    for (auto input_def : node.ImplicitInputDefs()) {
+      ONNXRUNTIME_RETURN_IF_ERROR(AddNodeArgValueIndex(mlvalue_name_idx_map_, input_def, node_arg_value_indices_));
+    }
+
+    for (auto output_def : node.OutputDefs()) {
+      ONNXRUNTIME_RETURN_IF_ERROR(AddNodeArgValueIndex(mlvalue_name_idx_map_, output_def, node_arg_value_indices_));
+    }
+  }
+
+  // 4. resolve the allocator for each distinct location in the allocation
+  // plan once, so per-tensor allocation doesn't go through the provider maps.
+  cached_allocators_.clear();
+  for (const auto& per_value_plan : p_seq_exec_plan_->allocation_plan) {
+    const auto& location = per_value_plan.location;
+    bool cached = false;
+    for (const auto& entry : cached_allocators_) {
+      if (entry.first == location) {
+        cached = true;
+        break;
+      }
+    }
+
+    if (!cached) {
+      auto allocator = utils::GetAllocator(execution_providers_, location);
+      if (allocator == nullptr) {
+        return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL,
+                                       "Failed to get allocator for location: ", location.ToString());
+      }
+      cached_allocators_.emplace_back(location, std::move(allocator));
+    }
+  }
+
+  plan_info_finalized_ = true;
+  return Status::OK();
+}
+
+void SessionState::BuildPipelineStages(int stage_count) {
+  pipeline_stages_.clear();
+  pipeline_stage_locks_.clear();
+
+  if (!plan_info_finalized_ || stage_count < 2)
+    return;
+
+  const size_t num_steps = finalized_plan_steps_.size();
+  if (num_steps < static_cast<size_t>(stage_count))
+    stage_count = static_cast<int>(num_steps);
+  if (stage_count < 2)
+    return;
+
+  // per-step cost proxy: the bytes of weights the node reads plus a base
+  // unit for the dispatch itself. the runtime of the conv/gemm nodes that
+  // dominate these plans tracks the weight bytes they stream.
+  constexpr uint64_t kBaseStepCost = 4096;
+  std::vector<uint64_t> step_cost(num_steps);
+  uint64_t total_cost = 0;
+  for (size_t i = 0; i < num_steps; ++i) {
+    uint64_t cost = kBaseStepCost;
+    for (const auto& weight : finalized_plan_steps_[i].weight_buffers) {
+      cost += weight.second;
+    }
+    step_cost[i] = cost;
+    total_cost += cost;
+  }
+
+  // close a stage once its cumulative cost reaches the next multiple of
+  // total / stage_count, keeping a step in reserve for every stage still to
+  // be closed; the final stage takes whatever is left.
+  size_t begin = 0;
+  uint64_t accumulated = 0;
+  for (size_t i = 0; i < num_steps; ++i) {
+    accumulated += step_cost[i];
+    const size_t stages_closed = pipeline_stages_.size();
+    if (stages_closed + 1 == static_cast<size_t>(stage_count))
+      break;
+
+    const bool quota_met = accumulated * static_cast<uint64_t>(stage_count) >=
+                           total_cost * static_cast<uint64_t>(stages_closed + 1);
+    const bool must_close = num_steps - (i + 1) ==
+                            static_cast<size_t>(stage_count) - stages_closed - 1;
+    if (quota_met || must_close) {
+      pipeline_stages_.push_back({begin, i + 1});
+      begin = i + 1;
+    }
+  }
+  pipeline_stages_.push_back({begin, num_steps});
+
+  // the locks are constructed in place and never move; frames may block on
+  // them for the lifetime of the session.
+  pipeline_stage_locks_.resize(pipeline_stages_.size());
+}
+
+AllocatorPtr SessionState::GetAllocator(const ONNXRuntimeAllocatorInfo& info) const {
+  // the handful of locations the plan uses were resolved up front, so a
+  // linear scan is cheaper than the provider map lookups it replaces.
+  for (const auto& entry : cached_allocators_) {
+    if (entry.first == info)
+      return entry.second;
+  }
+
+  return utils::GetAllocator(execution_providers_, info);
+}
+
 void SessionState::AddInitializedTensor(int mlvalue_index, const MLValue& mlvalue) {
   ONNXRUNTIME_ENFORCE(mlvalue_index >= 0 && mlvalue_index <= mlvalue_name_idx_map_.MaxIdx());
   initialized_tensors_.insert({mlvalue_index, mlvalue});
@@ -50,6 +343,73 @@ const std::unordered_map<int, MLValue>& SessionState::GetInitializedTensors() co
   return initialized_tensors_;
 }
 
+namespace {
+// weights below this size are served from the original copy; the pages of a
+// small weight mostly live in cache anyway and replicas would multiply the
+// bookkeeping, not the bandwidth.
+constexpr size_t kMinNumaReplicaBytes = 1024 * 1024;
+}  // namespace
+
+Status SessionState::ReplicateInitializersAcrossNumaNodes(const logging::Logger& logger) {
+  int node_count = GetNumaNodeCount();
+  if (node_count <= 1)
+    return Status::OK();
+
+  size_t replicated = 0;
+  std::vector<std::unordered_map<int, MLValue>> replicas(node_count);
+  for (int node = 0; node < node_count; ++node) {
+    AllocatorPtr allocator = std::make_shared<NumaNodeAllocator>(node);
+    for (const auto& entry : initialized_tensors_) {
+      if (!entry.second.IsTensor())
+        continue;
+
+      const Tensor& weight = entry.second.Get<Tensor>();
+      if (strcmp(weight.Location().name, CPU) != 0 ||
+          weight.DataType() == DataTypeImpl::GetType<std::string>())
+        continue;
+
+      size_t num_bytes = weight.DataType()->Size() * static_cast<size_t>(weight.Shape().Size());
+      if (num_bytes < kMinNumaReplicaBytes)
+        continue;
+
+      void* buffer = allocator->Alloc(num_bytes);
+      if (buffer == nullptr)
+        return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL,
+                                       "Failed to allocate a ", num_bytes,
+                                       " byte weight replica on NUMA node ", node);
+      memcpy(buffer, weight.DataRaw(), num_bytes);
+
+      auto replica = std::make_unique<Tensor>(weight.DataType(), weight.Shape(), buffer,
+                                              allocator->Info(), allocator);
+      MLValue value;
+      value.Init(replica.release(),
+                 DataTypeImpl::GetType<Tensor>(),
+                 DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+      replicas[node][entry.first] = value;
+      ++replicated;
+    }
+  }
+
+  if (replicated == 0)
+    return Status::OK();
+
+  numa_replica_tensors_ = std::move(replicas);
+  LOGS(logger, INFO) << "Replicated " << replicated / node_count << " weights onto each of "
+                     << node_count << " NUMA nodes.";
+  return Status::OK();
+}
+
+const std::unordered_map<int, MLValue>* SessionState::GetNumaLocalWeightOverrides() const {
+  if (numa_replica_tensors_.empty())
+    return nullptr;
+
+  int node = GetCurrentThreadNumaNode();
+  if (node < 0 || static_cast<size_t>(node) >= numa_replica_tensors_.size())
+    return nullptr;
+
+  return &numa_replica_tensors_[node];
+}
+
 SessionState& SessionState::SetLogger(const logging::Logger& logger) {
   logger_ = &logger;
   return *this;
@@ -69,38 +429,241 @@ void SessionState::SetProfiler(profiling::Profiler& profiler) {
   return *profiler_;
 }
 
-static int64_t CalculateMemoryPatternsKey(const std::vector<TensorShape>& shapes) {
+static int64_t CalculateMemoryPatternsKey(const std::vector<TensorShape>& shapes, int64_t bucket_size) {
   int64_t key = 0;
   for (auto& shape : shapes) {
-    for (auto dim : shape.GetDims())
+    for (auto dim : shape.GetDims()) {
+      // round dynamic dimensions up to the bucket boundary so all shapes in
+      // a bucket share one memory pattern.
+      if (bucket_size > 0 && dim > 0)
+        dim = (dim + bucket_size - 1) / bucket_size * bucket_size;
       key ^= dim;
+    }
   }
   return key;
 }
 
-const MemoryPatternGroup* SessionState::GetMemoryPatternGroup(const std::vector<TensorShape>& input_shapes) const {
+static size_t CalculateTotalPeakSize(const MemoryPatternGroup& mem_patterns) {
+  size_t total = 0;
+  for (auto& pattern : mem_patterns.patterns)
+    total += pattern.PeakSize();
+  return total;
+}
+
+// sized like the shape binding cache below: well above the shape variety a
+// normal serving workload produces, small enough that pathological traffic
+// can't hold patterns for thousands of dead shapes.
+constexpr size_t kMemoryPatternCacheCapacity = 64;
+
+std::shared_ptr<const MemoryPatternGroup> SessionState::GetMemoryPatternGroup(const std::vector<TensorShape>& input_shapes) const {
   std::lock_guard<std::mutex> lock(mem_patterns_lock_);
-  int64_t key = CalculateMemoryPatternsKey(input_shapes);
+  int64_t key = CalculateMemoryPatternsKey(input_shapes, mem_pattern_bucket_size_);
   auto it = mem_patterns_.find(key);
   if (it == mem_patterns_.end())
     return nullptr;
 
-  return it->second.get();
+  // move the entry to the front of the LRU list.
+  mem_patterns_lru_.splice(mem_patterns_lru_.begin(), mem_patterns_lru_, it->second.lru_position);
+
+  return it->second.patterns;
 }
 
 Status SessionState::UpdateMemoryPatternGroupCache(const std::vector<TensorShape>& input_shape,
                                                    std::unique_ptr<MemoryPatternGroup> mem_patterns) const {
-  int64_t key = CalculateMemoryPatternsKey(input_shape);
+  int64_t key = CalculateMemoryPatternsKey(input_shape, mem_pattern_bucket_size_);
 
   std::lock_guard<std::mutex> lock(mem_patterns_lock_);
   auto it = mem_patterns_.find(key);
   if (it == mem_patterns_.end()) {
-    mem_patterns_[key] = std::move(mem_patterns);
+    if (mem_patterns_.size() >= kMemoryPatternCacheCapacity) {
+      // evict the least recently used pattern. in-flight execution frames
+      // keep the evicted group alive through their shared_ptr.
+      mem_patterns_.erase(mem_patterns_lru_.back());
+      mem_patterns_lru_.pop_back();
+    }
+    mem_patterns_lru_.push_front(key);
+    mem_patterns_[key] = {std::move(mem_patterns), mem_patterns_lru_.begin()};
+  } else if (mem_pattern_bucket_size_ > 0 &&
+             CalculateTotalPeakSize(*mem_patterns) > CalculateTotalPeakSize(*it->second.patterns)) {
+    // the new pattern was planned for larger shapes in this bucket. replace
+    // the cached entry; in-flight execution frames keep the old group alive.
+    it->second.patterns = std::move(mem_patterns);
+    mem_patterns_lru_.splice(mem_patterns_lru_.begin(), mem_patterns_lru_, it->second.lru_position);
+  }
+
+  return Status::OK();
+}
+
+void SessionState::UpdateMemoryPatternGroupCacheAsync(std::vector<TensorShape> input_shapes,
+                                                      std::unique_ptr<MLValuePatternPlanner> planner) const {
+  if (planner == nullptr)
+    return;
+
+  auto generate_and_install = [this](const std::vector<TensorShape>& shapes, MLValuePatternPlanner& pattern_planner) {
+    auto mem_patterns = std::make_unique<MemoryPatternGroup>();
+    if (pattern_planner.GeneratePatterns(mem_patterns.get()).IsOK()) {
+      // replay the recorded trace against the generated pattern before
+      // caching it: a pattern that places an allocation over a still-live
+      // block must never be installed, and the replay quantifies what
+      // reuse bought for this shape.
+      std::map<ONNXRuntimeAllocatorInfo, MemPatternValidationReport> reports;
+      if (pattern_planner.ValidatePatterns(&reports).IsOK()) {
+        for (const auto& entry : reports) {
+          if (entry.second.overlap_violations > 0) {
+            LOGS(Logger(), ERROR) << "Memory pattern for location " << entry.first.name
+                                  << " places " << entry.second.overlap_violations
+                                  << " allocation(s) over still-live blocks; pattern not cached.";
+            return;
+          }
+          VLOGS(Logger(), 1) << "Memory pattern for location " << entry.first.name
+                             << ": peak " << entry.second.peak_size
+                             << " bytes, reuse saved " << entry.second.saved_bytes
+                             << " bytes, fragmentation " << entry.second.fragmentation_bytes
+                             << " bytes.";
+        }
+      }
+      GSL_SUPPRESS(es .84)
+      ONNXRUNTIME_IGNORE_RETURN_VALUE(UpdateMemoryPatternGroupCache(shapes, std::move(mem_patterns)));
+    }
+  };
+
+  if (thread_pool_ == nullptr) {
+    generate_and_install(input_shapes, *planner);
+    return;
+  }
+
+  std::packaged_task<void()> task{
+      [generate_and_install, shapes = std::move(input_shapes), pattern_planner = std::move(planner)]() {
+        generate_and_install(shapes, *pattern_planner);
+      }};
+
+  {
+    std::lock_guard<std::mutex> lock(background_tasks_lock_);
+    // drop futures of tasks that have already finished to keep the list small.
+    auto done = [](const std::future<void>& f) {
+      return f.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    };
+    background_tasks_.erase(
+        std::remove_if(background_tasks_.begin(), background_tasks_.end(), done),
+        background_tasks_.end());
+    background_tasks_.push_back(task.get_future());
+  }
+
+  // housekeeping for later runs; never ahead of queued inference work.
+  thread_pool_->RunTask(std::move(task), TaskPriority::kNormal);
+}
+
+namespace {
+// byte distance between the lines the weight prefetch walk touches.
+constexpr size_t kPrefetchLineSize = 64;
+// prefetching far past what the cache can hold only wastes memory bandwidth,
+// so a node's weight prefetch stops after this many bytes.
+constexpr size_t kMaxWeightPrefetchBytes = 8 * 1024 * 1024;
+
+inline void PrefetchLine(const char* p) {
+#ifdef _MSC_VER
+  _mm_prefetch(p, _MM_HINT_T2);
+#else
+  __builtin_prefetch(p, 0 /*read*/, 2 /*moderate temporal locality*/);
+#endif
+}
+}  // namespace
+
+void SessionState::PrefetchStepWeightsAsync(size_t step) const {
+  if (thread_pool_ == nullptr || step >= finalized_plan_steps_.size())
+    return;
+
+  // the recorded buffers point at the original weights; when NUMA replicas
+  // are active the kernels read those instead, so prefetching would warm the
+  // wrong copy.
+  if (!numa_replica_tensors_.empty())
+    return;
+
+  const auto& weight_buffers = finalized_plan_steps_[step].weight_buffers;
+  if (weight_buffers.empty())
+    return;
+
+  // finalized_plan_steps_ is immutable once built, so the task may reference
+  // it directly. its future is tracked so the destructor waits for it.
+  std::packaged_task<void()> task{[&weight_buffers]() {
+    size_t budget = kMaxWeightPrefetchBytes;
+    for (const auto& buffer : weight_buffers) {
+      const char* base = static_cast<const char*>(buffer.first);
+      const size_t length = std::min(buffer.second, budget);
+      for (size_t offset = 0; offset < length; offset += kPrefetchLineSize) {
+        PrefetchLine(base + offset);
+      }
+      budget -= length;
+      if (budget == 0)
+        break;
+    }
+  }};
+
+  {
+    std::lock_guard<std::mutex> lock(background_tasks_lock_);
+    auto done = [](const std::future<void>& f) {
+      return f.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    };
+    background_tasks_.erase(
+        std::remove_if(background_tasks_.begin(), background_tasks_.end(), done),
+        background_tasks_.end());
+    background_tasks_.push_back(task.get_future());
+  }
+
+  thread_pool_->RunTask(std::move(task), thread_pool_task_priority_);
+}
+
+// the requester workloads see a few dozen distinct input shape tuples per
+// session; the cap only guards against traffic with unbounded distinct shapes.
+constexpr size_t kShapeBindingCacheCapacity = 64;
+
+std::shared_ptr<const ShapeBindings> SessionState::GetShapeBindings(const std::vector<TensorShape>& input_shapes) const {
+  std::lock_guard<std::mutex> lock(shape_bindings_lock_);
+  int64_t key = CalculateMemoryPatternsKey(input_shapes, /*bucket_size*/ 0);
+  auto it = shape_bindings_.find(key);
+  if (it == shape_bindings_.end())
+    return nullptr;
+
+  // the key folds all dimensions together, so verify the entry was recorded
+  // for exactly these shapes. a collision is treated as a miss.
+  if (it->second->input_shapes != input_shapes)
+    return nullptr;
+
+  return it->second;
+}
+
+std::shared_ptr<const ShapeBindings> SessionState::FindShapeBindingsByNamedInputs(
+    const std::map<std::string, TensorShape>& named_input_shapes) const {
+  std::lock_guard<std::mutex> lock(shape_bindings_lock_);
+  // no key can be derived without the positional feed order, so scan; the
+  // cache holds at most kShapeBindingCacheCapacity entries.
+  for (const auto& entry : shape_bindings_) {
+    if (entry.second->named_input_shapes == named_input_shapes)
+      return entry.second;
+  }
+  return nullptr;
+}
+
+Status SessionState::UpdateShapeBindingCache(std::unique_ptr<ShapeBindings> bindings) const {
+  int64_t key = CalculateMemoryPatternsKey(bindings->input_shapes, /*bucket_size*/ 0);
+
+  std::lock_guard<std::mutex> lock(shape_bindings_lock_);
+  if (shape_bindings_.size() >= kShapeBindingCacheCapacity)
+    return Status::OK();
+
+  auto it = shape_bindings_.find(key);
+  if (it == shape_bindings_.end()) {
+    shape_bindings_[key] = std::move(bindings);
   }
 
   return Status::OK();
 }
 
+bool SessionState::ShapeBindingCacheAcceptsEntries() const {
+  std::lock_guard<std::mutex> lock(shape_bindings_lock_);
+  return shape_bindings_.size() < kShapeBindingCacheCapacity;
+}
+
 void SessionState::SetEnableMemoryPattern(bool flag) {
   enable_mem_pattern_ = flag;
 }
@@ -109,6 +672,22 @@ bool SessionState::GetEnableMemoryPattern() const {
   return enable_mem_pattern_;
 }
 
+void SessionState::SetEnableSubgraphMemoization(bool flag) {
+  enable_subgraph_memoization_ = flag;
+}
+
+bool SessionState::GetEnableSubgraphMemoization() const {
+  return enable_subgraph_memoization_;
+}
+
+void SessionState::SetMemoryPatternShapeBucketSize(int64_t bucket_size) {
+  mem_pattern_bucket_size_ = bucket_size;
+}
+
+int64_t SessionState::GetMemoryPatternShapeBucketSize() const {
+  return mem_pattern_bucket_size_;
+}
+
 void SessionState::AddInputNameToNodeInfoMapping(const std::string& input_name, const NodeInfo& node_info) {
   input_names_to_nodeinfo_mapping_[input_name].push_back(node_info);
 }
@@ -3,6 +3,11 @@
 
 #pragma once
 
+#include <atomic>
+#include <deque>
+#include <future>
+#include <list>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <unordered_map>
@@ -24,10 +29,13 @@ namespace onnxruntime {
 
 class ExecutionProviders;
 class KernelDef;
+class MLValuePatternPlanner;
 class OpKernel;
-class TaskThreadPool;
+class WorkStealingThreadPool;
+enum class TaskPriority : int;  // defined in core/common/work_stealing_thread_pool.h
 struct SequentialExecutionPlan;
 struct MemoryPatternGroup;
+struct ShapeBindings;
 
 // SessionState should be modified by the inference session class only.
 // It is supposed to be passed by const-ref only to all the executors.
@@ -37,6 +45,10 @@ class SessionState {
       : execution_providers_{execution_providers} {
   }
 
+  // Waits for any in-flight background tasks, which hold a reference to
+  // this instance.
+  ~SessionState();
+
   // Graph viewer.
   void SetGraphViewer(std::unique_ptr<onnxruntime::GraphViewer> graph_viewer);
   const onnxruntime::GraphViewer* GetGraphViewer() const;
@@ -66,10 +78,156 @@ class SessionState {
   */
   const std::unordered_map<int, MLValue>& GetInitializedTensors() const;
 
+  /**
+  * Copies the large CPU initializers onto every NUMA node, so multi-socket
+  * hosts read weights through their own memory controllers instead of the
+  * socket interconnect. Execution frames substitute the replica local to
+  * the thread that starts a run. No-op on single-node machines. Call after
+  * all initialized tensors have been added.
+  */
+  common::Status ReplicateInitializersAcrossNumaNodes(const logging::Logger& logger);
+
+  /**
+  * Gets the weight replicas resident on the calling thread's NUMA node,
+  * keyed by mlvalue_index, or nullptr when no replicas exist. Contains only
+  * the weights large enough to have been replicated; the remaining weights
+  * come from GetInitializedTensors.
+  */
+  const std::unordered_map<int, MLValue>* GetNumaLocalWeightOverrides() const;
+
   // execution plan
   void SetExecutionPlan(std::unique_ptr<SequentialExecutionPlan> p_seq_exec_plan);
   const SequentialExecutionPlan* GetExecutionPlan() const;
 
+  // Per-step info for the finalized execution plan.
+  struct PlanStepInfo {
+    const OpKernel* kernel = nullptr;
+    int queue_id = 0;
+    // true when any of the node's values can carry a fence. fence-free nodes
+    // skip the per-value fence walks entirely, so back-to-back device kernel
+    // launches aren't separated by host-side fence bookkeeping.
+    bool has_fence = false;
+    // buffer and byte count of each CPU-resident initializer (weight) the
+    // node reads, so an executor can prefetch the next node's weights while
+    // the current node computes.
+    std::vector<std::pair<const void*, size_t>> weight_buffers;
+  };
+
+  /**
+  Bake the lookups the executors repeat per node per run into flat arrays:
+  the kernel pointer and exec queue id per execution plan step, the
+  graph-constant node arg to mlvalue index tables, and the allocators for the
+  locations the allocation plan uses. Called once by the InferenceSession
+  after the kernels, the execution plan and the mlvalue name/idx map have all
+  been saved.
+  */
+  common::Status FinalizeExecutionPlanInfo();
+
+  /**
+  Kernel and exec queue id per execution plan step, in plan order.
+  Empty until FinalizeExecutionPlanInfo has run.
+  */
+  const std::vector<PlanStepInfo>& GetFinalizedPlanSteps() const { return finalized_plan_steps_; }
+
+  /**
+  Issue software prefetches for the weight buffers of the given plan step on
+  the session thread pool, so they migrate toward the cache while an earlier
+  node computes. No-op without a thread pool, without finalized plan info, or
+  for steps that read no weights.
+  Const as it touches no session state, it only warms the cache.
+  */
+  void PrefetchStepWeightsAsync(size_t step) const;
+
+  // A maximal run of consecutive plan steps whose nodes are mutually
+  // independent: every input edge of a node in the region comes from an
+  // earlier region, so the steps may execute concurrently.
+  struct ExecutionRegion {
+    size_t begin_step;  // into execution_plan, inclusive
+    size_t end_step;    // exclusive
+    size_t Width() const { return end_step - begin_step; }
+  };
+
+  /**
+  The plan steps grouped into regions of mutually independent nodes, in plan
+  order. HybridExecutor dispatches regions wide enough to cover the
+  scheduling overhead to the thread pool and runs the rest inline.
+  Empty until FinalizeExecutionPlanInfo has run.
+  */
+  const std::vector<ExecutionRegion>& GetExecutionRegions() const { return execution_regions_; }
+
+  // The plan steps of one provider partition, in plan order. Lanes exist when
+  // the graph splits into per-provider partitions that are independent enough
+  // to run concurrently (a CPU tower beside a CUDA tower); steps that consume
+  // another lane's output wait on that step at the join.
+  struct ExecutionLane {
+    std::vector<size_t> steps;   // into execution_plan, in plan order
+    std::string provider_type;   // every step in the lane runs on this provider
+  };
+
+  /**
+  The plan steps grouped into per-provider lanes, one lane per provider type.
+  Empty unless the plan is heterogeneous and the partitions are coarse enough
+  that concurrent lanes pay off; see FinalizeExecutionPlanInfo for the
+  heuristic. HybridExecutor runs non-empty lanes concurrently with
+  GetCrossLaneDeps joins.
+  */
+  const std::vector<ExecutionLane>& GetExecutionLanes() const { return execution_lanes_; }
+
+  /**
+  For each plan step, the earlier steps on other lanes whose outputs it
+  consumes. Sized like the execution plan when lanes exist, empty otherwise.
+  */
+  const std::vector<std::vector<size_t>>& GetCrossLaneDeps() const { return cross_lane_deps_; }
+
+  // A contiguous span of plan steps executed as one pipeline stage.
+  struct PipelineStage {
+    size_t begin_step;  // into execution_plan, inclusive
+    size_t end_step;    // exclusive
+  };
+
+  /**
+  Partition the finalized plan steps into stage_count contiguous stages of
+  roughly equal estimated cost, with one lock per stage so concurrent runs
+  stream through them (see PipelineExecutor). The per-step cost proxy is the
+  bytes of weights the node reads plus a fixed base cost, which tracks the
+  compute of the weight-bound nodes dominating the plans this targets.
+  Called by the InferenceSession after FinalizeExecutionPlanInfo when
+  pipeline execution is enabled; leaves GetPipelineStages empty when the
+  plan is too short to split.
+  */
+  void BuildPipelineStages(int stage_count);
+
+  /**
+  The plan steps grouped into pipeline stages, in plan order. Empty unless
+  BuildPipelineStages has run and produced at least two stages.
+  */
+  const std::vector<PipelineStage>& GetPipelineStages() const { return pipeline_stages_; }
+
+  /**
+  The lock serializing frames through the given pipeline stage. Only valid
+  for stage indices below GetPipelineStages().size().
+  */
+  std::mutex& GetPipelineStageLock(size_t stage) const { return pipeline_stage_locks_[stage]; }
+
+  /**
+  Graph-constant tables mapping each node's args to mlvalue indices, in the
+  layout ExecutionFrame uses (see ExecutionFrame::GetFirstArgIndex).
+  Return nullptr until FinalizeExecutionPlanInfo has run.
+  */
+  const std::vector<int>* GetNodeArgValueIndices() const {
+    return plan_info_finalized_ ? &node_arg_value_indices_ : nullptr;
+  }
+  const std::vector<int>* GetNodeArgOffsets() const {
+    return plan_info_finalized_ ? &node_arg_offsets_ : nullptr;
+  }
+
+  /**
+  Get the allocator for the given location. The locations used by the
+  allocation plan are resolved once during FinalizeExecutionPlanInfo; any
+  other location falls back to looking the provider up.
+  */
+  AllocatorPtr GetAllocator(const ONNXRuntimeAllocatorInfo& info) const;
+
   /**
   Set the logger to use for this session. 
   */
@@ -93,17 +251,32 @@ class SessionState {
   profiling::Profiler& Profiler() const;
 
   /**
-  Get cached memory pattern based on input shapes
+  Get cached memory pattern based on input shapes.
+  The returned group stays valid even if the cache entry is later replaced,
+  as callers share ownership of it.
   */
-  const MemoryPatternGroup* GetMemoryPatternGroup(const std::vector<TensorShape>& input_shapes) const;
+  std::shared_ptr<const MemoryPatternGroup> GetMemoryPatternGroup(const std::vector<TensorShape>& input_shapes) const;
 
   /**
-  Set generated memory pattern with a given input shapes. 
+  Set generated memory pattern with a given input shapes.
   Const as it's an internal cache update only.
+  With shape bucketing enabled an existing entry is replaced when the new
+  pattern requires more memory, so the bucket's pattern grows to cover the
+  largest shapes seen so far.
   */
   Status UpdateMemoryPatternGroupCache(const std::vector<TensorShape>& input_shape,
                                        std::unique_ptr<MemoryPatternGroup> mem_patterns) const;
 
+  /**
+  Generate a memory pattern from the allocations <planner> traced during a
+  run and install it in the cache, on the session thread pool when one is
+  set so the run that traced the allocations does not pay for pattern
+  generation. Falls back to generating inline when there is no thread pool.
+  Const as it's an internal cache update only.
+  */
+  void UpdateMemoryPatternGroupCacheAsync(std::vector<TensorShape> input_shapes,
+                                          std::unique_ptr<MLValuePatternPlanner> planner) const;
+
   /**
   Set enable memory pattern flag
   */
@@ -114,6 +287,80 @@ class SessionState {
   */
   bool GetEnableMemoryPattern() const;
 
+  /**
+  Set whether control flow kernels executing this (sub)graph may memoize
+  branch results across runs.
+  */
+  void SetEnableSubgraphMemoization(bool flag);
+
+  /**
+  Get enable subgraph memoization flag
+  */
+  bool GetEnableSubgraphMemoization() const;
+
+  /**
+  Set the bucket granularity used when matching input shapes to cached memory
+  patterns. Zero matches on exact shapes only.
+  */
+  void SetMemoryPatternShapeBucketSize(int64_t bucket_size);
+
+  /**
+  Get the bucket granularity used when matching input shapes to cached memory
+  patterns.
+  */
+  int64_t GetMemoryPatternShapeBucketSize() const;
+
+  /**
+  Get the shape bindings recorded by a previous run with the given input
+  shapes, or nullptr when no run with these shapes has completed yet.
+  The returned object is read-only and stays valid as callers share
+  ownership of it.
+  */
+  std::shared_ptr<const ShapeBindings> GetShapeBindings(const std::vector<TensorShape>& input_shapes) const;
+
+  /**
+  Scan the cache for the bindings recorded under exactly the given input
+  shapes keyed by feed name, for callers that cannot reproduce the
+  positional feed order GetShapeBindings matches on. Returns nullptr when no
+  run with these shapes has completed yet.
+  */
+  std::shared_ptr<const ShapeBindings> FindShapeBindingsByNamedInputs(
+      const std::map<std::string, TensorShape>& named_input_shapes) const;
+
+  /**
+  Publish the shape bindings recorded during a completed run. The first run
+  with a given input shape tuple wins; later recordings for the same shapes
+  are dropped.
+  Const as it's an internal cache update only.
+  */
+  Status UpdateShapeBindingCache(std::unique_ptr<ShapeBindings> bindings) const;
+
+  /**
+  Returns true while the shape binding cache accepts new entries. Recording
+  is skipped once the cache is at capacity, so traffic with unbounded
+  distinct shapes does not grow the cache forever.
+  */
+  bool ShapeBindingCacheAcceptsEntries() const;
+
+  /**
+  Largest per-node kernel scratch usage observed across completed runs, used
+  to size the scratch arena of later runs in one allocation.
+  */
+  size_t GetScratchBufferHighWaterMark() const {
+    return scratch_high_water_mark_.load(std::memory_order_relaxed);
+  }
+
+  /**
+  Raise the scratch high-water mark to the usage observed by a completed run.
+  Const as it's an internal cache update only.
+  */
+  void UpdateScratchBufferHighWaterMark(size_t used) const {
+    size_t current = scratch_high_water_mark_.load(std::memory_order_relaxed);
+    while (used > current &&
+           !scratch_high_water_mark_.compare_exchange_weak(current, used, std::memory_order_relaxed)) {
+    }
+  }
+
   struct NodeInfo {
     NodeInfo(size_t index0, const onnxruntime::Node* p_node0, const KernelCreateInfo* kci0)
         : index(index0),
@@ -145,8 +392,13 @@ class SessionState {
   /// Return SessionState for the given Node index and attribute name if found.
   const SessionState* GetSubgraphSessionState(onnxruntime::NodeIndex index, const std::string& attribute_name) const;
 
-  TaskThreadPool* GetThreadPool() const { return thread_pool_; }
-  void SetThreadPool(TaskThreadPool* p_pool) { thread_pool_ = p_pool; }
+  WorkStealingThreadPool* GetThreadPool() const { return thread_pool_; }
+  void SetThreadPool(WorkStealingThreadPool* p_pool) { thread_pool_ = p_pool; }
+
+  /// Priority the executors use when submitting this session's tasks to the
+  /// thread pool. Only meaningful when the pool is shared across sessions.
+  TaskPriority GetThreadPoolTaskPriority() const { return thread_pool_task_priority_; }
+  void SetThreadPoolTaskPriority(TaskPriority priority) { thread_pool_task_priority_ = priority; }
 
  private:
   ONNXRUNTIME_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SessionState);
@@ -161,17 +413,68 @@ class SessionState {
 
   // initialized tensorset
   std::unordered_map<int, MLValue> initialized_tensors_;  // key is mlvalue_index
+  // per-NUMA-node copies of the large CPU weights, indexed by node and keyed
+  // by mlvalue_index; empty unless ReplicateInitializersAcrossNumaNodes ran
+  // on a multi-node host.
+  std::vector<std::unordered_map<int, MLValue>> numa_replica_tensors_;
   std::unique_ptr<SequentialExecutionPlan> p_seq_exec_plan_ = nullptr;
 
+  // built by FinalizeExecutionPlanInfo so the executor inner loop and the
+  // execution frames index flat arrays instead of hashing per node per run.
+  bool plan_info_finalized_ = false;
+  std::vector<PlanStepInfo> finalized_plan_steps_;
+  std::vector<ExecutionRegion> execution_regions_;
+  std::vector<ExecutionLane> execution_lanes_;
+  std::vector<std::vector<size_t>> cross_lane_deps_;
+  std::vector<PipelineStage> pipeline_stages_;
+  // one lock per pipeline stage; mutable because executors lock stages of a
+  // const session state, deque because mutexes can be neither moved nor
+  // copied once other frames may be blocked on them.
+  mutable std::deque<std::mutex> pipeline_stage_locks_;
+  std::vector<int> node_arg_value_indices_;
+  std::vector<int> node_arg_offsets_;
+  std::vector<std::pair<ONNXRuntimeAllocatorInfo, AllocatorPtr>> cached_allocators_;
+
   const logging::Logger* logger_;
   profiling::Profiler* profiler_;
 
   // switch for enable memory pattern optimization or not.
   bool enable_mem_pattern_ = true;
+  // bucket granularity for the mem_patterns_ lookup. zero matches exact shapes.
+  int64_t mem_pattern_bucket_size_ = 0;
+  // switch for memoizing control flow branch results across runs.
+  bool enable_subgraph_memoization_ = false;
   // lock for the mem_patterns_
   mutable std::mutex mem_patterns_lock_;
+  struct MemPatternCacheEntry {
+    std::shared_ptr<MemoryPatternGroup> patterns;
+    // position of this entry's key in mem_patterns_lru_.
+    std::list<int64_t>::iterator lru_position;
+  };
   // cache for the generated mem_patterns. key is calculated based on input shapes.
-  mutable std::map<int64_t, std::unique_ptr<MemoryPatternGroup>> mem_patterns_;
+  // shared_ptr as in-flight execution frames may still reference a replaced or
+  // evicted entry. bounded: the least recently used entry is evicted once the
+  // cache is full, so traffic with unbounded distinct shapes can't grow it
+  // without limit.
+  mutable std::map<int64_t, MemPatternCacheEntry> mem_patterns_;
+  // keys of mem_patterns_, most recently used first.
+  mutable std::list<int64_t> mem_patterns_lru_;
+
+  // futures of background tasks (pattern generation, weight prefetch) handed
+  // to the thread pool, so the destructor can wait for tasks that still
+  // reference this instance.
+  mutable std::mutex background_tasks_lock_;
+  mutable std::vector<std::future<void>> background_tasks_;
+
+  // lock for the shape_bindings_
+  mutable std::mutex shape_bindings_lock_;
+  // cache for the recorded shape bindings. keyed like mem_patterns_ but on
+  // exact shapes; the entry's stored input shapes are verified on lookup as
+  // the key is a lossy hash.
+  mutable std::map<int64_t, std::shared_ptr<const ShapeBindings>> shape_bindings_;
+
+  // largest per-node kernel scratch usage seen across completed runs.
+  mutable std::atomic<size_t> scratch_high_water_mark_{0};
 
   NameNodeInfoMapType input_names_to_nodeinfo_mapping_;
   NameNodeInfoMapType output_names_to_nodeinfo_mapping_;
@@ -182,6 +485,9 @@ class SessionState {
       std::unordered_map<onnxruntime::NodeIndex,
                          std::unordered_map<std::string, gsl::not_null<const SessionState*>>>;
   SubgraphSessionStateMap subgraph_session_states_;
-  TaskThreadPool* thread_pool_ = nullptr;
+  WorkStealingThreadPool* thread_pool_ = nullptr;
+  // value-initialized to TaskPriority::kNormal; the enum is opaque here so
+  // the enumerator name cannot be spelled out.
+  TaskPriority thread_pool_task_priority_{};
 };
 }  // namespace onnxruntime
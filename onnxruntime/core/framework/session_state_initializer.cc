@@ -4,9 +4,13 @@
 #include "core/framework/session_state_initializer.h"
 
 #include <functional>
+#include <future>
+#include <sstream>
+#include <vector>
 
 #include "core/common/common.h"
 #include "core/common/logging/logging.h"
+#include "core/common/work_stealing_thread_pool.h"
 
 #include "core/graph/graph_viewer.h"
 #include "core/graph/graph_transformer.h"
@@ -23,6 +27,7 @@
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/transformer_memcpy.h"
 #include "core/framework/utils.h"
+#include "core/framework/weights_cache.h"
 
 namespace onnxruntime {
 
@@ -30,7 +35,9 @@ static common::Status TransformGraph(onnxruntime::Graph& graph,
                                      const onnxruntime::GraphTransformerManager& graph_transformer_mgr,
                                      const ExecutionProviders& exec_providers,
                                      KernelRegistryManager& kernel_registry_manager,
-                                     const InsertCastTransformer& insert_cast_transformer);
+                                     const InsertCastTransformer& insert_cast_transformer,
+                                     bool skip_graph_transformations,
+                                     const std::string& partition_cache_filepath);
 
 static common::Status SaveMLValueNameIndexMapping(const onnxruntime::Graph& graph,
                                                   MLValueNameIdxMap& mlvalue_name_idx_map,
@@ -40,11 +47,14 @@ using SaveTensorFunc = std::function<void(int idx, const onnxruntime::MLValue&)>
 
 static common::Status SaveInitializedTensors(const onnxruntime::Graph& graph,
                                              bool enable_memory_pattern,
+                                             bool enable_zero_copy_weights,
+                                             const std::string& shared_weights_key,
                                              const SequentialExecutionPlan& execution_plan,
                                              const ExecutionProviders& exec_providers,
                                              const MLValueNameIdxMap& mlvalue_name_idx_map,
                                              std::map<ONNXRuntimeAllocatorInfo, BufferUniquePtr>& weights_buffers,
                                              const SaveTensorFunc& save_tensor_func,
+                                             WorkStealingThreadPool* thread_pool,
                                              const logging::Logger& logger);
 
 static common::Status SaveKernels(const ExecutionProviders& execution_providers,
@@ -71,10 +81,15 @@ SessionStateInitializer::SessionStateInitializer(onnxruntime::Graph& graph,
 common::Status SessionStateInitializer::CreatePlan(const onnxruntime::GraphTransformerManager& graph_transformation_manager,
                                                    const InsertCastTransformer& insert_cast_transformer,
                                                    const std::vector<NodeArg*>& outer_scope_node_args,
-                                                   bool enable_sequential_execution) {
+                                                   bool enable_sequential_execution,
+                                                   bool skip_graph_transformations,
+                                                   const std::string& partition_cache_filepath,
+                                                   int64_t activation_memory_budget,
+                                                   bool memory_aware_scheduling) {
   ONNXRUNTIME_RETURN_IF_ERROR(TransformGraph(graph_, graph_transformation_manager,
                                              execution_providers_, kernel_registry_manager_,
-                                             insert_cast_transformer));
+                                             insert_cast_transformer, skip_graph_transformations,
+                                             partition_cache_filepath));
 
   // After transformation/partitioning, the graph now is fixed and graph viewer is created and set for execution.
   session_state_.SetGraphViewer(std::make_unique<onnxruntime::GraphViewer>(graph_));
@@ -99,14 +114,17 @@ common::Status SessionStateInitializer::CreatePlan(const onnxruntime::GraphTrans
   if (enable_sequential_execution) {
     // CreatePlan will create a new SequentialExecutionPlan instance that we will
     // save into the session state.
+    SequentialPlannerContext context(false /* enable parallel execution */, activation_memory_budget,
+                                     memory_aware_scheduling);
     ONNXRUNTIME_RETURN_IF_ERROR(
         SequentialPlanner::CreatePlan(graph_, valid_outer_scope_node_args, execution_providers_,
-                                      kernel_registry_manager_, mlvalue_name_idx_map, exec_plan));
+                                      kernel_registry_manager_, mlvalue_name_idx_map, context, exec_plan));
 
     session_state_.SetExecutionPlan(std::move(exec_plan));
   } else {
     // Parallel execution still uses same allocation plan, but has limitation of memory buffer reuse.
-    SequentialPlannerContext context(true /* enable parallel execution */);
+    SequentialPlannerContext context(true /* enable parallel execution */, 0 /* no recompute budget */,
+                                     memory_aware_scheduling);
     ONNXRUNTIME_RETURN_IF_ERROR(
         SequentialPlanner::CreatePlan(graph_, valid_outer_scope_node_args, execution_providers_,
                                       kernel_registry_manager_, mlvalue_name_idx_map, context, exec_plan));
@@ -118,6 +136,9 @@ common::Status SessionStateInitializer::CreatePlan(const onnxruntime::GraphTrans
 }
 
 common::Status SessionStateInitializer::InitializeAndSave(bool enable_memory_pattern,
+                                                          bool enable_zero_copy_weights,
+                                                          const std::string& shared_weights_key,
+                                                          bool enable_numa_weight_replication,
                                                           std::map<ONNXRuntimeAllocatorInfo, BufferUniquePtr>& weights_buffers) {
   const auto* exec_plan_ptr = session_state_.GetExecutionPlan();
   ONNXRUNTIME_ENFORCE(exec_plan_ptr, "Execution plan was not found in SessionState. CreatePlan must be called first.");
@@ -130,15 +151,26 @@ common::Status SessionStateInitializer::InitializeAndSave(bool enable_memory_pat
     session_state_.AddInitializedTensor(idx, value);
   };
 
-  ONNXRUNTIME_RETURN_IF_ERROR(SaveInitializedTensors(graph_, enable_memory_pattern, exec_plan,
-                                                     execution_providers_, mlvalue_name_idx_map, weights_buffers,
-                                                     add_initialized_tensor, logger_));
+  ONNXRUNTIME_RETURN_IF_ERROR(SaveInitializedTensors(graph_, enable_memory_pattern, enable_zero_copy_weights,
+                                                     shared_weights_key, exec_plan, execution_providers_,
+                                                     mlvalue_name_idx_map, weights_buffers,
+                                                     add_initialized_tensor, session_state_.GetThreadPool(), logger_));
+
+  if (!enable_zero_copy_weights) {
+    graph_.CleanAllInitializedTensors();  // remove weights from the graph now to save memory
+  }
 
-  graph_.CleanAllInitializedTensors();  // remove weights from the graph now to save memory
+  if (enable_numa_weight_replication) {
+    ONNXRUNTIME_RETURN_IF_ERROR(session_state_.ReplicateInitializersAcrossNumaNodes(logger_));
+  }
 
   ONNXRUNTIME_RETURN_IF_ERROR(SaveKernels(execution_providers_, session_state_, kernel_registry_manager_, logger_));
   ONNXRUNTIME_RETURN_IF_ERROR(SaveInputOutputNamesToNodeMapping(graph_, kernel_registry_manager_, session_state_));
 
+  // everything the executors look up per node per run is in place now, so
+  // bake it into the flat arrays they walk instead.
+  ONNXRUNTIME_RETURN_IF_ERROR(session_state_.FinalizeExecutionPlanInfo());
+
   return Status::OK();
 }
 
@@ -146,7 +178,9 @@ common::Status TransformGraph(onnxruntime::Graph& graph,
                               const onnxruntime::GraphTransformerManager& graph_transformer_mgr,
                               const ExecutionProviders& providers,
                               KernelRegistryManager& kernel_registry_manager,
-                              const InsertCastTransformer& insert_cast_transformer) {
+                              const InsertCastTransformer& insert_cast_transformer,
+                              bool skip_graph_transformations,
+                              const std::string& partition_cache_filepath) {
   // The transformer order:
   // 1. built-in graph rewriter
   // 2. each execution provider's transformer
@@ -155,12 +189,14 @@ common::Status TransformGraph(onnxruntime::Graph& graph,
   // 5. insert cast nodes.
 
   // first apply the default/system/basic graph to graph optimizations.
-  ONNXRUNTIME_RETURN_IF_ERROR(graph_transformer_mgr.ApplyAll(graph));
+  if (!skip_graph_transformations) {
+    ONNXRUNTIME_RETURN_IF_ERROR(graph_transformer_mgr.ApplyAll(graph));
+  }
 
   auto kernels{kernel_registry_manager.GetAllKernelRegistries()};
 
   // Do partitioning based on execution providers' capability.
-  GraphPartitioner partitioner(kernel_registry_manager, providers);
+  GraphPartitioner partitioner(kernel_registry_manager, providers, partition_cache_filepath);
   ONNXRUNTIME_RETURN_IF_ERROR(partitioner.Partition(graph));
 
   // Insert copy nodes.
@@ -239,15 +275,23 @@ common::Status SaveMLValueNameIndexMapping(const onnxruntime::Graph& graph,
 common::Status DeserializeTensorProto(const ONNX_NAMESPACE::TensorProto& tensor_proto,
                                       const ONNXRuntimeAllocatorInfo& alloc_info,
                                       const ExecutionProviders& exec_providers,
-                                      MLValue& mlvalue, void* preallocated, size_t preallocated_size) {
+                                      MLValue& mlvalue, void* preallocated, size_t preallocated_size,
+                                      bool enable_zero_copy_weights,
+                                      const std::string& external_data_dir) {
   auto alloc_ptr = utils::GetAllocator(exec_providers, alloc_info);
   if (!alloc_ptr) {
     return Status(common::ONNXRUNTIME, common::FAIL, "Failed to get allocator for alloc_info: " + alloc_info.ToString());
   }
 
   if (strcmp(alloc_info.name, CPU) == 0 || alloc_info.mem_type == ONNXRuntimeMemTypeCPUOutput) {
+    // alias the initializer bytes held by the graph rather than copying when possible
+    if (enable_zero_copy_weights && utils::TensorProtoCanAliasRawData(tensor_proto)) {
+      return utils::TensorProtoToMLValueNoCopy(tensor_proto, alloc_ptr->Info(), mlvalue);
+    }
+
     // deserialize directly to CPU tensor
-    return utils::TensorProtoToMLValue(tensor_proto, alloc_ptr, preallocated, preallocated_size, mlvalue);
+    return utils::TensorProtoToMLValue(tensor_proto, alloc_ptr, preallocated, preallocated_size, mlvalue,
+                                       external_data_dir);
   }
 
   std::unique_ptr<Tensor> p_tensor;
@@ -256,7 +300,8 @@ common::Status DeserializeTensorProto(const ONNX_NAMESPACE::TensorProto& tensor_
   std::unique_ptr<Tensor> p_deserialize_tensor;
   deserialize_alloc_ptr = exec_providers.Get(kCpuExecutionProvider)->GetAllocator(0, ONNXRuntimeMemTypeDefault);
   ONNXRUNTIME_RETURN_IF_ERROR(utils::GetTensorFromTensorProto(tensor_proto, &p_deserialize_tensor,
-                                                              deserialize_alloc_ptr));
+                                                              deserialize_alloc_ptr, nullptr, 0,
+                                                              external_data_dir));
   const IExecutionProvider* provider = exec_providers.Get(alloc_info);
   ONNXRUNTIME_ENFORCE(provider != nullptr);
   p_tensor = std::make_unique<Tensor>(
@@ -285,6 +330,7 @@ common::Status DeserializeTensorProto(const ONNX_NAMESPACE::TensorProto& tensor_
 }
 
 static common::Status PlanTensor(MLValuePatternPlanner& planner, const MLValueNameIdxMap& mlvalue_name_idx_map, const std::string& name, const ONNX_NAMESPACE::TensorProto& tensor_proto) {
+
   int mlvalue_index;
   ONNXRUNTIME_RETURN_IF_ERROR(mlvalue_name_idx_map.GetIdx(name, mlvalue_index));
   size_t len;
@@ -294,12 +340,47 @@ static common::Status PlanTensor(MLValuePatternPlanner& planner, const MLValueNa
   return planner.TraceAllocation(mlvalue_index, len);
 }
 
+// Run the per-initializer deserialization closures across the inter-op thread
+// pool when one is available. Each closure writes only its own output slot, so
+// the tasks are independent; all of them run to completion and the first
+// failure (in task order) is reported.
+static common::Status RunDeserializeTasks(const std::vector<std::function<common::Status()>>& tasks,
+                                          WorkStealingThreadPool* thread_pool) {
+  if (thread_pool == nullptr || tasks.size() < 2) {
+    for (const auto& task : tasks) {
+      ONNXRUNTIME_RETURN_IF_ERROR(task());
+    }
+    return common::Status::OK();
+  }
+
+  std::vector<common::Status> statuses(tasks.size());
+  std::vector<std::future<void>> task_results;
+  task_results.reserve(tasks.size());
+  for (size_t i = 0; i < tasks.size(); ++i) {
+    std::packaged_task<void()> task{[&tasks, &statuses, i] { statuses[i] = tasks[i](); }};
+    task_results.emplace_back(task.get_future());
+    thread_pool->RunTask(std::move(task));
+  }
+
+  // wait for all and propagate any exceptions
+  for (auto& future : task_results) {
+    future.get();
+  }
+
+  for (const auto& status : statuses) {
+    ONNXRUNTIME_RETURN_IF_ERROR(status);
+  }
+  return common::Status::OK();
+}
+
 common::Status SaveInitializedTensorsWithMemPattern(const Graph& graph,
+                                                    bool enable_zero_copy_weights,
                                                     const SequentialExecutionPlan& execution_plan,
                                                     const ExecutionProviders& exec_providers,
                                                     const MLValueNameIdxMap& mlvalue_name_idx_map,
                                                     std::map<ONNXRuntimeAllocatorInfo, BufferUniquePtr>& weights_buffers,
                                                     const SaveTensorFunc& save_tensor_func,
+                                                    WorkStealingThreadPool* thread_pool,
                                                     const logging::Logger& logger) {
   LOGS(logger, INFO) << "Saving initialized tensors.";
 
@@ -310,6 +391,10 @@ common::Status SaveInitializedTensorsWithMemPattern(const Graph& graph,
   //1. first plan the memory
   const onnxruntime::InitializedTensorSet& initialized_tensor_set = graph.GetAllInitializedTensors();
   for (const auto& entry : initialized_tensor_set) {
+    // tensors that will alias the graph held initializer bytes need no buffer space
+    if (enable_zero_copy_weights && utils::TensorProtoCanAliasRawData(*entry.second)) {
+      continue;
+    }
     //string/complex64/complex128 tensors will be skipped
     ONNXRUNTIME_RETURN_IF_ERROR(PlanTensor(planner, mlvalue_name_idx_map, entry.first, *entry.second));
   }
@@ -331,7 +416,17 @@ common::Status SaveInitializedTensorsWithMemPattern(const Graph& graph,
     weights_buffers[location] = BufferUniquePtr(buffer, alloc);
   }
 
-  //3. create weight tensors based on weights buffer
+  //3. create weight tensors based on weights buffer. the initializers are
+  //   independent and each task writes its own slot, so deserialize them
+  //   concurrently across the thread pool.
+  const size_t num_tensors = initialized_tensor_set.size();
+  std::vector<MLValue> mlvalues(num_tensors);
+  std::vector<int> mlvalue_indexes(num_tensors);
+  std::vector<const std::string*> names(num_tensors);
+  std::vector<std::function<Status()>> deserialize_tasks;
+  deserialize_tasks.reserve(num_tensors);
+
+  size_t task_index = 0;
   for (const auto& entry : initialized_tensor_set) {
     const std::string& name = entry.first;
     int mlvalue_index;
@@ -347,7 +442,6 @@ common::Status SaveInitializedTensorsWithMemPattern(const Graph& graph,
     if (pattern == nullptr)
       return Status(common::ONNXRUNTIME, common::FAIL, "mem pattern not found");
     auto block = pattern->GetBlock(mlvalue_index);
-    MLValue mlvalue;
     // if block is not found, means this mlvalue is not traced
     // fall back to allocate separate buffer.
 
@@ -355,49 +449,149 @@ common::Status SaveInitializedTensorsWithMemPattern(const Graph& graph,
     if (it->second == nullptr) {
       block = nullptr;
     }
-    Status st;
-    if (!block) {
-      st = DeserializeTensorProto(tensor_proto, location, exec_providers, mlvalue, nullptr, 0);
-    } else {
-      st = DeserializeTensorProto(tensor_proto, location, exec_providers, mlvalue,
-                                  (uint8_t*)it->second.get() + block->offset_, block->size_);
-    }
-    if (!st.IsOK()) {
-      std::ostringstream oss;
-      oss << "Deserialize tensor " << name << " failed." << st.ErrorMessage();
-      return Status(st.Category(), st.Code(), oss.str());
-    }
 
-    save_tensor_func(mlvalue_index, mlvalue);
+    void* preallocated = block ? static_cast<void*>((uint8_t*)it->second.get() + block->offset_) : nullptr;
+    size_t preallocated_size = block ? block->size_ : 0;
+
+    mlvalue_indexes[task_index] = mlvalue_index;
+    names[task_index] = &name;
+    MLValue* target = &mlvalues[task_index];
+    const ONNX_NAMESPACE::TensorProto* p_tensor_proto = &tensor_proto;
+    const ONNXRuntimeAllocatorInfo* p_location = &location;
+    const std::string* p_name = &name;
+    const std::string* p_external_data_dir = &graph.ModelFileDirectory();
+    deserialize_tasks.emplace_back(
+        [p_tensor_proto, p_location, &exec_providers, target, preallocated, preallocated_size,
+         enable_zero_copy_weights, p_name, p_external_data_dir]() {
+          Status st = DeserializeTensorProto(*p_tensor_proto, *p_location, exec_providers, *target,
+                                             preallocated, preallocated_size, enable_zero_copy_weights,
+                                             *p_external_data_dir);
+          if (!st.IsOK()) {
+            std::ostringstream oss;
+            oss << "Deserialize tensor " << *p_name << " failed." << st.ErrorMessage();
+            return Status(st.Category(), st.Code(), oss.str());
+          }
+          return st;
+        });
+    ++task_index;
+  }
+
+  ONNXRUNTIME_RETURN_IF_ERROR(RunDeserializeTasks(deserialize_tasks, thread_pool));
 
-    VLOGS(logger, 1) << "Added weight with name : " << name << " with index: " << mlvalue_index;
+  for (size_t i = 0; i < num_tensors; ++i) {
+    save_tensor_func(mlvalue_indexes[i], mlvalues[i]);
+    VLOGS(logger, 1) << "Added weight with name : " << *names[i] << " with index: " << mlvalue_indexes[i];
   }
 
   LOGS(logger, INFO) << "Done saving initialized tensors";
   return common::Status::OK();
 }
 
+// Identity of a weight in the process-wide cache: its name plus an FNV-1a
+// hash of the tensor content. Two model versions published under one cache
+// key then share exactly the weights whose bytes match, while a retrained
+// weight with the same name gets its own entry.
+static std::string SharedWeightIdentity(const std::string& name,
+                                        const ONNX_NAMESPACE::TensorProto& tensor_proto) {
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  auto mix_bytes = [&hash](const void* data, size_t num_bytes) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < num_bytes; ++i) {
+      hash = (hash ^ bytes[i]) * 0x100000001b3ULL;
+    }
+  };
+
+  if (tensor_proto.has_raw_data()) {
+    const int32_t data_type = tensor_proto.data_type();
+    mix_bytes(&data_type, sizeof(data_type));
+    for (int64_t dim : tensor_proto.dims()) {
+      mix_bytes(&dim, sizeof(dim));
+    }
+    mix_bytes(tensor_proto.raw_data().data(), tensor_proto.raw_data().size());
+  } else {
+    // typed-field encodings are rare and small; hashing the serialized proto
+    // covers every field without spelling each encoding out here.
+    const std::string serialized = tensor_proto.SerializeAsString();
+    mix_bytes(serialized.data(), serialized.size());
+  }
+
+  std::ostringstream identity;
+  identity << name << '@' << std::hex << hash;
+  return identity.str();
+}
+
 common::Status SaveInitializedTensorsWithSeperateBuffer(const onnxruntime::Graph& graph,
+                                                        bool enable_zero_copy_weights,
+                                                        const std::string& shared_weights_key,
                                                         const SequentialExecutionPlan& execution_plan,
                                                         const ExecutionProviders& exec_providers,
                                                         const MLValueNameIdxMap& mlvalue_name_idx_map,
                                                         const SaveTensorFunc& save_tensor_func,
+                                                        WorkStealingThreadPool* thread_pool,
                                                         const logging::Logger& logger) {
   LOGS(logger, INFO) << "Saving initialized tensors.";
 
   ONNXRUNTIME_ENFORCE(mlvalue_name_idx_map.MaxIdx() > 0, "MLValue indexes should have been populated.");
 
   const onnxruntime::InitializedTensorSet& initialized_tensor_set = graph.GetAllInitializedTensors();
+  const size_t num_tensors = initialized_tensor_set.size();
+  std::vector<MLValue> mlvalues(num_tensors);
+  std::vector<int> mlvalue_indexes(num_tensors);
+  std::vector<const std::string*> names(num_tensors);
+  std::vector<std::function<Status()>> deserialize_tasks;
+  deserialize_tasks.reserve(num_tensors);
+
+  size_t task_index = 0;
   for (const auto& entry : initialized_tensor_set) {
     const std::string& name = entry.first;
     int mlvalue_index;
     ONNXRUNTIME_RETURN_IF_ERROR(mlvalue_name_idx_map.GetIdx(name, mlvalue_index));
     VLOGS(logger, 1) << "About to add weight with name: " << name << " and index: " << mlvalue_index;
     auto& location = execution_plan.allocation_plan[mlvalue_index].location;
-    MLValue mlvalue;
-    ONNXRUNTIME_RETURN_IF_ERROR(DeserializeTensorProto(*(entry.second), location, exec_providers, mlvalue, nullptr, 0));
-    save_tensor_func(mlvalue_index, mlvalue);
-    VLOGS(logger, 1) << "Added weight with name : " << name << " with index: " << mlvalue_index;
+
+    mlvalue_indexes[task_index] = mlvalue_index;
+    names[task_index] = &name;
+    MLValue* target = &mlvalues[task_index];
+    const ONNX_NAMESPACE::TensorProto* p_tensor_proto = entry.second;
+    const ONNXRuntimeAllocatorInfo* p_location = &location;
+    if (!shared_weights_key.empty() &&
+        (strcmp(location.name, CPU) == 0 || location.mem_type == ONNXRuntimeMemTypeCPUOutput)) {
+      // share one copy of the immutable CPU weight across sessions using the same key.
+      // never alias the graph held bytes here: the cached tensor can outlive the
+      // session (and model) that created it, so it must own its buffer.
+      // WeightsCache::GetOrCreate is thread safe, so these tasks run in parallel too.
+      const std::string* p_name = &name;
+      const std::string* p_external_data_dir = &graph.ModelFileDirectory();
+      deserialize_tasks.emplace_back(
+          [p_tensor_proto, p_location, &exec_providers, target, p_name, &shared_weights_key,
+           p_external_data_dir]() {
+            // content-hashed identity, computed inside the task so the
+            // hashing of large weights parallelizes with deserialization.
+            return WeightsCache::Instance().GetOrCreate(
+                shared_weights_key, SharedWeightIdentity(*p_name, *p_tensor_proto),
+                [&](MLValue& created) {
+                  return DeserializeTensorProto(*p_tensor_proto, *p_location, exec_providers, created, nullptr, 0,
+                                                /*enable_zero_copy_weights*/ false, *p_external_data_dir);
+                },
+                *target);
+          });
+    } else {
+      const std::string* p_external_data_dir = &graph.ModelFileDirectory();
+      deserialize_tasks.emplace_back(
+          [p_tensor_proto, p_location, &exec_providers, target, enable_zero_copy_weights,
+           p_external_data_dir]() {
+            return DeserializeTensorProto(*p_tensor_proto, *p_location, exec_providers, *target, nullptr, 0,
+                                          enable_zero_copy_weights, *p_external_data_dir);
+          });
+    }
+    ++task_index;
+  }
+
+  ONNXRUNTIME_RETURN_IF_ERROR(RunDeserializeTasks(deserialize_tasks, thread_pool));
+
+  for (size_t i = 0; i < num_tensors; ++i) {
+    save_tensor_func(mlvalue_indexes[i], mlvalues[i]);
+    VLOGS(logger, 1) << "Added weight with name : " << *names[i] << " with index: " << mlvalue_indexes[i];
   }
 
   LOGS(logger, INFO) << "Done saving initialized tensors";
@@ -406,21 +600,34 @@ common::Status SaveInitializedTensorsWithSeperateBuffer(const onnxruntime::Graph
 
 common::Status SaveInitializedTensors(const onnxruntime::Graph& graph,
                                       bool enable_memory_pattern,
+                                      bool enable_zero_copy_weights,
+                                      const std::string& shared_weights_key,
                                       const SequentialExecutionPlan& execution_plan,
                                       const ExecutionProviders& exec_providers,
                                       const MLValueNameIdxMap& mlvalue_name_idx_map,
                                       std::map<ONNXRuntimeAllocatorInfo, BufferUniquePtr>& weights_buffers,
                                       const SaveTensorFunc& save_tensor_func,
+                                      WorkStealingThreadPool* thread_pool,
                                       const logging::Logger& logger) {
+  // weight sharing requires each tensor to own a standalone buffer whose
+  // lifetime can extend across sessions, so it bypasses the mem pattern slab.
+  if (!shared_weights_key.empty()) {
+    return SaveInitializedTensorsWithSeperateBuffer(graph, enable_zero_copy_weights, shared_weights_key,
+                                                    execution_plan, exec_providers,
+                                                    mlvalue_name_idx_map, save_tensor_func, thread_pool, logger);
+  }
+
   // if we enable the memory pattern and already have the execution plan
   // go with mem pattern approach, which will allocate a big chunk for all
   // the weights.
   if (enable_memory_pattern) {
-    return SaveInitializedTensorsWithMemPattern(graph, execution_plan, exec_providers,
-                                                mlvalue_name_idx_map, weights_buffers, save_tensor_func, logger);
+    return SaveInitializedTensorsWithMemPattern(graph, enable_zero_copy_weights, execution_plan, exec_providers,
+                                                mlvalue_name_idx_map, weights_buffers, save_tensor_func,
+                                                thread_pool, logger);
   }
-  return SaveInitializedTensorsWithSeperateBuffer(graph, execution_plan, exec_providers,
-                                                  mlvalue_name_idx_map, save_tensor_func, logger);
+  return SaveInitializedTensorsWithSeperateBuffer(graph, enable_zero_copy_weights, std::string(), execution_plan,
+                                                  exec_providers, mlvalue_name_idx_map, save_tensor_func,
+                                                  thread_pool, logger);
 }
 
 static common::Status CreateOpKernelInternal(const onnxruntime::Node& node,
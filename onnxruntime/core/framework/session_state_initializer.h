@@ -28,15 +28,47 @@ class SessionStateInitializer {
                           KernelRegistryManager& kernel_registry_manager,
                           const logging::Logger& logger);
 
-  // First perform any transformations and create the execution plan
+  // First perform any transformations and create the execution plan.
+  // @param skip_graph_transformations skip the graph transformer passes, e.g. when the
+  //        model was saved after transformation via SessionOptions.optimized_model_filepath.
+  // @param partition_cache_filepath if non-empty, the graph partitioner persists its
+  //        node-to-provider assignment to this file and replays it on later loads of the
+  //        same model instead of re-running capability negotiation. Subgraphs pass the
+  //        default so only the main graph participates.
+  // @param activation_memory_budget if positive, the planner schedules cheap nodes
+  //        for recompute until modeled peak activation memory fits this byte budget
+  //        (see SessionOptions.activation_memory_budget). Only meaningful when
+  //        enable_sequential_execution is true; the schedule is honored by the
+  //        sequential executor alone.
+  // @param memory_aware_scheduling if true, the planner reorders the execution
+  //        plan (within dependency constraints) with a lifetime-aware heuristic
+  //        minimizing modeled peak memory instead of taking the graph's default
+  //        topological order (see SessionOptions.enable_memory_aware_scheduling).
   common::Status CreatePlan(const onnxruntime::GraphTransformerManager& graph_transformation_manager,
                             const InsertCastTransformer& insert_cast_transformer,
                             const std::vector<NodeArg*>& outer_scope_node_args,
-                            bool enable_sequential_execution);
+                            bool enable_sequential_execution,
+                            bool skip_graph_transformations = false,
+                            const std::string& partition_cache_filepath = std::string(),
+                            int64_t activation_memory_budget = 0,
+                            bool memory_aware_scheduling = false);
 
   // initialize tensors, and save. save kernels and input/output node mappings
   // @param enable_memory_pattern
+  // @param enable_zero_copy_weights if true, CPU weight tensors alias the initializer
+  //        bytes held by the Graph instead of copying them out. The Graph keeps its
+  //        initialized tensors in that case, so it must outlive the session state.
+  // @param shared_weights_key if non-empty, CPU weight tensors are published to /
+  //        fetched from the process-wide WeightsCache under this key so sessions
+  //        loading the same model share one copy. The caller must hold a session
+  //        reference on the key (WeightsCache::AddSessionRef).
+  // @param enable_numa_weight_replication if true, large CPU weight tensors are
+  //        additionally copied onto every NUMA node so each run reads the replica
+  //        local to its thread. No effect on single-node hosts.
   common::Status InitializeAndSave(bool enable_memory_pattern,
+                                   bool enable_zero_copy_weights,
+                                   const std::string& shared_weights_key,
+                                   bool enable_numa_weight_replication,
                                    std::map<ONNXRuntimeAllocatorInfo, BufferUniquePtr>& weights_buffers);
 
  private:
@@ -0,0 +1,79 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/session_telemetry.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace onnxruntime {
+
+static_assert((SessionTelemetry::kWindowSize & (SessionTelemetry::kWindowSize - 1)) == 0,
+              "kWindowSize must be a power of two");
+
+constexpr size_t SessionTelemetry::kWindowSize;
+
+void SessionTelemetry::RecordPhase(Phase phase, int64_t microseconds) noexcept {
+  auto& counters = phases_[phase];
+  counters.total_microseconds.fetch_add(microseconds, std::memory_order_relaxed);
+  // count doubles as the ring write cursor; a torn sample under a concurrent
+  // writer only perturbs the window percentiles, never the counters.
+  const uint64_t slot = counters.count.fetch_add(1, std::memory_order_relaxed);
+  counters.samples[slot & (kWindowSize - 1)].store(microseconds, std::memory_order_relaxed);
+}
+
+void SessionTelemetry::RecordRunEnd(bool succeeded) noexcept {
+  run_count_.fetch_add(1, std::memory_order_relaxed);
+  if (!succeeded) {
+    failed_run_count_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void SessionTelemetry::OnAsyncRunQueued() noexcept {
+  async_queue_depth_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void SessionTelemetry::OnAsyncRunCompleted() noexcept {
+  async_queue_depth_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void SessionTelemetry::AddMicroBatchDepth(int64_t delta) noexcept {
+  micro_batch_queue_depth_.fetch_add(delta, std::memory_order_relaxed);
+}
+
+SessionTelemetry::Snapshot SessionTelemetry::GetSnapshot() const {
+  Snapshot snapshot;
+  std::vector<int64_t> window;
+  window.reserve(kWindowSize);
+  for (int phase = 0; phase < kPhaseCount; ++phase) {
+    const auto& counters = phases_[phase];
+    auto& out = snapshot.phases[phase];
+    out.count = counters.count.load(std::memory_order_relaxed);
+    if (out.count == 0) {
+      continue;
+    }
+    out.average_microseconds =
+        counters.total_microseconds.load(std::memory_order_relaxed) / static_cast<int64_t>(out.count);
+
+    const size_t filled = std::min<uint64_t>(out.count, kWindowSize);
+    window.clear();
+    for (size_t i = 0; i < filled; ++i) {
+      window.push_back(counters.samples[i].load(std::memory_order_relaxed));
+    }
+    std::sort(window.begin(), window.end());
+    auto percentile = [&window, filled](size_t p) {
+      return window[std::min(filled - 1, filled * p / 100)];
+    };
+    out.p50_microseconds = percentile(50);
+    out.p90_microseconds = percentile(90);
+    out.p99_microseconds = percentile(99);
+  }
+
+  snapshot.run_count = run_count_.load(std::memory_order_relaxed);
+  snapshot.failed_run_count = failed_run_count_.load(std::memory_order_relaxed);
+  snapshot.async_queue_depth = async_queue_depth_.load(std::memory_order_relaxed);
+  snapshot.micro_batch_queue_depth = micro_batch_queue_depth_.load(std::memory_order_relaxed);
+  return snapshot;
+}
+
+}  // namespace onnxruntime
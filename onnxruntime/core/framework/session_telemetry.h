@@ -0,0 +1,90 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+
+/**
+Rolling per-session run telemetry.
+
+Each Run records the wall time spent in its main phases - feed/fetch
+validation, graph execution and the fetch copy back to the caller - into a
+fixed size ring of recent samples per phase, plus overall run counters and
+queue depth gauges for the async and micro-batching paths. Recording is a
+handful of relaxed atomic operations per run and GetSnapshot only reads the
+atomics, so an external agent polling the snapshot (e.g. once a second)
+costs nothing on the request path and needs no locks against in-flight
+runs. Percentiles are computed over the rolling window at snapshot time;
+counts and averages cover the whole session lifetime.
+*/
+class SessionTelemetry {
+ public:
+  enum Phase : int {
+    kValidation = 0,  // feed and fetch name/type validation
+    kExecution,       // executor dispatch through plan completion
+    kFetchCopy,       // copying fetches back across devices
+    kPhaseCount
+  };
+
+  // samples kept per phase; a power of two so the ring index wraps by mask
+  static constexpr size_t kWindowSize = 128;
+
+  SessionTelemetry() = default;
+
+  // records one phase duration into the phase's rolling window.
+  void RecordPhase(Phase phase, int64_t microseconds) noexcept;
+
+  // records the completion of one Run call.
+  void RecordRunEnd(bool succeeded) noexcept;
+
+  // gauge of RunAsync requests accepted but not yet completed.
+  void OnAsyncRunQueued() noexcept;
+  void OnAsyncRunCompleted() noexcept;
+
+  // gauge of requests gathered in the currently open micro batch.
+  void AddMicroBatchDepth(int64_t delta) noexcept;
+
+  struct PhaseSnapshot {
+    uint64_t count = 0;                // phases recorded over the session lifetime
+    int64_t average_microseconds = 0;  // over the session lifetime
+    int64_t p50_microseconds = 0;      // percentiles over the rolling window
+    int64_t p90_microseconds = 0;
+    int64_t p99_microseconds = 0;
+  };
+
+  struct Snapshot {
+    PhaseSnapshot phases[kPhaseCount];
+    uint64_t run_count = 0;
+    uint64_t failed_run_count = 0;
+    int64_t async_queue_depth = 0;
+    int64_t micro_batch_queue_depth = 0;
+  };
+
+  // safe to call concurrently with runs; reads the counters with relaxed
+  // atomic loads only.
+  Snapshot GetSnapshot() const;
+
+ private:
+  ONNXRUNTIME_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SessionTelemetry);
+
+  struct PhaseCounters {
+    std::atomic<uint64_t> count{0};
+    std::atomic<int64_t> total_microseconds{0};
+    std::atomic<int64_t> samples[kWindowSize] = {};
+  };
+
+  PhaseCounters phases_[kPhaseCount];
+  std::atomic<uint64_t> run_count_{0};
+  std::atomic<uint64_t> failed_run_count_{0};
+  std::atomic<int64_t> async_queue_depth_{0};
+  std::atomic<int64_t> micro_batch_queue_depth_{0};
+};
+
+}  // namespace onnxruntime
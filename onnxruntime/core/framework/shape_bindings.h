@@ -0,0 +1,50 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/framework/tensor_shape.h"
+#include "core/graph/basic_types.h"
+
+namespace onnxruntime {
+
+// Derived shape state one kernel recorded for one node: whatever the kernel
+// computed from its input shapes (broadcast classification, convolution
+// geometry, validated GEMM dimensions, ...) behind a type erased pointer,
+// together with the input shapes it was computed from. The recorded input
+// shapes guard against nodes whose inputs are not a pure function of the
+// session input shapes; on a mismatch the kernel recomputes.
+struct NodeShapeBinding {
+  std::vector<TensorShape> input_shapes;
+  std::shared_ptr<void> state;
+};
+
+// All the shape state recorded during one run, keyed in the SessionState
+// cache by the shapes of the session inputs. Entries are recorded by the
+// kernels of the single frame that owns this object and published to the
+// cache only after the run completes, after which the object is read-only.
+struct ShapeBindings {
+  // the session input shapes this binding was recorded under. verified on
+  // cache lookup as the cache key is a lossy hash of the shapes.
+  std::vector<TensorShape> input_shapes;
+
+  // the same input shapes keyed by feed name, for shape queries that cannot
+  // reproduce the positional feed order of input_shapes.
+  std::map<std::string, TensorShape> named_input_shapes;
+
+  // shapes of the fetched session outputs produced under these input shapes,
+  // keyed by output name. Filled when the recording run completes, so shape
+  // queries can answer exactly for shape tuples the session has already run.
+  std::map<std::string, TensorShape> output_shapes;
+
+  // per node slots, indexed by NodeIndex. slots stay empty for nodes whose
+  // kernels do not record shape state.
+  std::vector<NodeShapeBinding> nodes;
+};
+
+}  // namespace onnxruntime
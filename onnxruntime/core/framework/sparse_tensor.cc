@@ -0,0 +1,15 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/sparse_tensor.h"
+
+namespace onnxruntime {
+
+// the opaque type template takes the domain and name as char arrays with
+// external linkage.
+extern const char kSparseTensorCSRDomain[] = "com.microsoft";
+extern const char kSparseTensorCSRName[] = "SparseTensorCSR";
+
+ONNXRUNTIME_REGISTER_OPAQUE_TYPE(SparseTensorCSR, kSparseTensorCSRDomain, kSparseTensorCSRName);
+
+}  // namespace onnxruntime
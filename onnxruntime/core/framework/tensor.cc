@@ -9,18 +9,18 @@ using namespace std;
 namespace onnxruntime {
 
 Tensor::Tensor(MLDataType p_type,
-               const TensorShape& shape,
+               TensorShape shape,
                BufferNakedPtr p_data,
                const ONNXRuntimeAllocatorInfo& alloc,
                AllocatorPtr deleter,
                const int64_t offset)
     : alloc_info_(alloc) {
   ONNXRUNTIME_ENFORCE(p_type != nullptr);
-  Init(p_type, shape, p_data, alloc, std::move(deleter), offset);
+  Init(p_type, std::move(shape), p_data, alloc, std::move(deleter), offset);
 }
 
 void Tensor::Init(MLDataType p_type,
-                  const TensorShape& shape,
+                  TensorShape shape,
                   void* p_raw_data,
                   const ONNXRuntimeAllocatorInfo& alloc,
                   AllocatorPtr deleter,
@@ -28,7 +28,7 @@ void Tensor::Init(MLDataType p_type,
   if (shape.Size() < 0)
     throw std::runtime_error("shape.Size() must >=0");
   dtype_ = p_type;
-  shape_ = shape;
+  shape_ = std::move(shape);
   p_data_ = p_raw_data;
   // if caller passed in a deleter, that means this tensor own this buffer
   // we will release the buffer when this tensor is deconstructed.
@@ -37,7 +37,7 @@ void Tensor::Init(MLDataType p_type,
   // do the placement new for strings on pre-allocated buffer.
   if (buffer_deleter_ && dtype_ == DataTypeImpl::GetType<string>()) {
     auto* ptr = static_cast<string*>(p_data_);
-    for (int64_t i = 0, n = shape.Size(); i < n; ++i) {
+    for (int64_t i = 0, n = shape_.Size(); i < n; ++i) {
       new (ptr + i) string();
     }
   }
@@ -48,10 +48,11 @@ void Tensor::Init(MLDataType p_type,
 Tensor::Tensor(Tensor&& other)
     : p_data_(other.p_data_),
       buffer_deleter_(other.buffer_deleter_),
-      shape_(other.shape_),
+      shape_(std::move(other.shape_)),
       dtype_(other.dtype_),
       alloc_info_(other.alloc_info_),
-      byte_offset_(other.byte_offset_) {
+      byte_offset_(other.byte_offset_),
+      string_arena_(std::move(other.string_arena_)) {
   other.dtype_ = DataTypeImpl::GetType<float>();
   other.shape_ = TensorShape(vector<int64_t>(1, 0));
   other.p_data_ = nullptr;
@@ -64,11 +65,12 @@ Tensor& Tensor::operator=(Tensor&& other) {
     ReleaseBuffer();
 
     dtype_ = other.dtype_;
-    shape_ = other.shape_;
+    shape_ = std::move(other.shape_);
     alloc_info_ = other.alloc_info_;
     byte_offset_ = other.byte_offset_;
     p_data_ = other.p_data_;
     buffer_deleter_ = other.buffer_deleter_;
+    string_arena_ = std::move(other.string_arena_);
 
     other.dtype_ = DataTypeImpl::GetType<float>();
     other.shape_ = TensorShape(vector<int64_t>(1, 0));
@@ -88,6 +90,7 @@ Tensor::Tensor(const Tensor& src)
 
   p_data_ = src.p_data_;
   buffer_deleter_ = nullptr;
+  string_arena_ = src.string_arena_;
 }
 
 Tensor::~Tensor() {
@@ -106,6 +109,7 @@ Tensor& Tensor::ShallowCopy(const Tensor& other) {
     byte_offset_ = other.byte_offset_;
     p_data_ = other.p_data_;
     buffer_deleter_ = nullptr;
+    string_arena_ = other.string_arena_;
   }
   return *this;
 }
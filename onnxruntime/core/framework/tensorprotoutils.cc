@@ -4,11 +4,13 @@
 #include "core/framework/tensorprotoutils.h"
 
 #include <memory>
+#include "core/framework/external_data_loader.h"
 #include "core/graph/onnx_protobuf.h"
 #include "core/common/logging/logging.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/tensorutils.h"
 #include "core/framework/tensor.h"
+#include "core/framework/string_tensor_arena.h"
 #include "core/framework/ml_value_patterns_planner.h"
 
 using namespace ONNX_NAMESPACE;
@@ -87,6 +89,10 @@ common::Status GetTensorByTypeFromTensorProto<std::string>(const TensorProto& te
   if (preallocated && preallocated_size != size_to_allocate)
     return Status(ONNXRUNTIME, FAIL, "The buffer planner is not consistent with tensor buffer size");
 
+  if (tensor_proto.string_data_size() != tensor_size)
+    return Status(common::ONNXRUNTIME, common::FAIL,
+                  "GetTensorByTypeFromTensorProto: the tensor shape does not match the size in proto");
+
   std::string* p_data = static_cast<std::string*>(preallocated ? preallocated : alloc->Alloc(size_to_allocate));
   *p_tensor = std::make_unique<Tensor>(DataTypeImpl::GetType<std::string>(),
                                        tensor_shape,
@@ -96,13 +102,25 @@ common::Status GetTensorByTypeFromTensorProto<std::string>(const TensorProto& te
 
   /*
   In the case of string tensors, the strings need to be constructed in the pre-allocated memory (placement
-  new) before calling Unpack (which copies the strings from the proto). Placement new happens inside the
-  Tensor's constructor. Hence the order of invocation of Tensor construction and Unpack needs to be reversed
-  in comparison to other types. This has the disadvantage of alloc/deallocing a Tensor if Unpack fails;
-  however restricting it to string types only alleviates this concern for other types at least. Hence the template
-  specialization for string.
+  new) before they can be assigned to. Placement new happens inside the Tensor's constructor, so the Tensor
+  is constructed before the elements are filled in, the reverse of the order used for other types. Hence the
+  template specialization for string.
+
+  The characters are pooled into a contiguous arena (one allocation for the pool plus one for the offset
+  table) and the std::string elements are materialized from it as a compatibility view; arena-aware callers
+  read the pool through Tensor::StringArena and skip the per-element strings entirely.
   */
-  ONNXRUNTIME_RETURN_IF_ERROR(::onnxruntime::utils::TensorUtils::UnpackTensor(tensor_proto, p_data, tensor_size));
+  auto arena = std::make_shared<StringTensorArena>();
+  const auto& string_data = tensor_proto.string_data();
+  size_t total_chars = 0;
+  for (const auto& str : string_data)
+    total_chars += str.size();
+  arena->Reserve(string_data.size(), total_chars);
+  for (const auto& str : string_data)
+    arena->Add(str);
+
+  arena->MaterializeTo(p_data);
+  (*p_tensor)->SetStringArena(std::move(arena));
 
   return common::Status::OK();
 }
@@ -138,10 +156,113 @@ common::Status GetTensorByTypeFromTensorProto<MLFloat16>(const TensorProto& tens
   return common::Status::OK();
 }
 
+namespace {
+bool IsLittleEndianOrder() {
+  static const int32_t endian_check = 1;
+  return *reinterpret_cast<const char*>(&endian_check) == 1;
+}
+
+// Returns the MLDataType for fixed-size element types whose raw_data bytes match
+// the in-memory Tensor layout, or nullptr for types that need conversion (strings)
+// or are unknown.
+MLDataType GetFixedSizeElementType(int32_t proto_data_type, size_t& element_size) {
+  switch (proto_data_type) {
+    case TensorProto_DataType_FLOAT:
+      element_size = sizeof(float);
+      return DataTypeImpl::GetType<float>();
+    case TensorProto_DataType_DOUBLE:
+      element_size = sizeof(double);
+      return DataTypeImpl::GetType<double>();
+    case TensorProto_DataType_BOOL:
+      element_size = sizeof(bool);
+      return DataTypeImpl::GetType<bool>();
+    case TensorProto_DataType_INT8:
+      element_size = sizeof(int8_t);
+      return DataTypeImpl::GetType<int8_t>();
+    case TensorProto_DataType_INT16:
+      element_size = sizeof(int16_t);
+      return DataTypeImpl::GetType<int16_t>();
+    case TensorProto_DataType_INT32:
+      element_size = sizeof(int32_t);
+      return DataTypeImpl::GetType<int32_t>();
+    case TensorProto_DataType_INT64:
+      element_size = sizeof(int64_t);
+      return DataTypeImpl::GetType<int64_t>();
+    case TensorProto_DataType_UINT8:
+      element_size = sizeof(uint8_t);
+      return DataTypeImpl::GetType<uint8_t>();
+    case TensorProto_DataType_UINT16:
+      element_size = sizeof(uint16_t);
+      return DataTypeImpl::GetType<uint16_t>();
+    case TensorProto_DataType_UINT32:
+      element_size = sizeof(uint32_t);
+      return DataTypeImpl::GetType<uint32_t>();
+    case TensorProto_DataType_UINT64:
+      element_size = sizeof(uint64_t);
+      return DataTypeImpl::GetType<uint64_t>();
+    case TensorProto_DataType_FLOAT16:
+      element_size = sizeof(MLFloat16);
+      return DataTypeImpl::GetType<MLFloat16>();
+    default:
+      element_size = 0;
+      return nullptr;
+  }
+}
+
+// Builds the tensor from an externally stored payload, reading the bytes
+// straight into the destination buffer (preallocated arena memory or a fresh
+// allocation). External payloads are raw little-endian bytes with the
+// in-memory layout of the tensor, so no per-type unpacking is needed.
+common::Status GetTensorWithExternalData(const TensorProto& tensor_proto,
+                                         const TensorShape& tensor_shape,
+                                         const std::string& external_data_dir,
+                                         std::unique_ptr<Tensor>* p_tensor,
+                                         AllocatorPtr alloc,
+                                         void* preallocated,
+                                         size_t preallocated_size) {
+  size_t element_size;
+  MLDataType ml_type = GetFixedSizeElementType(tensor_proto.data_type(), element_size);
+  if (ml_type == nullptr) {
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED,
+                                   "External data is not supported for tensors of type ",
+                                   tensor_proto.data_type());
+  }
+  if (!IsLittleEndianOrder()) {
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED,
+                                   "External data payloads are little-endian and cannot be loaded on a big-endian host.");
+  }
+
+  int64_t tensor_size = tensor_shape.Size();
+  if (tensor_size < 0) {
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid shape ", tensor_shape);
+  }
+
+  size_t size_to_allocate;
+  if (!IAllocator::CalcMemSizeForArrayWithAlignment<256>(static_cast<size_t>(tensor_size), element_size, &size_to_allocate)) {
+    return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "size overflow");
+  }
+
+  if (preallocated && preallocated_size != size_to_allocate)
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, "The buffer planner is not consistent with tensor buffer size, expected ", size_to_allocate, ", got ", preallocated_size);
+
+  void* p_data = preallocated ? preallocated : alloc->Alloc(size_to_allocate);
+  ONNXRUNTIME_RETURN_IF_ERROR(ReadExternalDataForTensor(tensor_proto, external_data_dir, p_data,
+                                                        static_cast<size_t>(tensor_size) * element_size));
+  *p_tensor = std::make_unique<Tensor>(ml_type,
+                                       tensor_shape,
+                                       p_data,
+                                       alloc->Info(),
+                                       preallocated ? nullptr : alloc);  // no deleter for preallocated
+
+  return common::Status::OK();
+}
+}  // namespace
+
 Status TensorProtoToMLValue(const ONNX_NAMESPACE::TensorProto& input, AllocatorPtr allocator, void* preallocated,
-                            size_t preallocated_size, MLValue& value) {
+                            size_t preallocated_size, MLValue& value, const std::string& external_data_dir) {
   std::unique_ptr<Tensor> p_tensor;
-  ONNXRUNTIME_RETURN_IF_ERROR(GetTensorFromTensorProto(input, &p_tensor, allocator, preallocated, preallocated_size));
+  ONNXRUNTIME_RETURN_IF_ERROR(GetTensorFromTensorProto(input, &p_tensor, allocator, preallocated, preallocated_size,
+                                                       external_data_dir));
   value.Init(p_tensor.release(),
              DataTypeImpl::GetType<Tensor>(),
              DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
@@ -156,10 +277,17 @@ common::Status GetTensorFromTensorProto(const TensorProto& tensor_proto,
                                         std::unique_ptr<Tensor>* p_tensor,
                                         AllocatorPtr allocator,
                                         void* preallocated,
-                                        size_t preallocated_size) {
+                                        size_t preallocated_size,
+                                        const std::string& external_data_dir) {
   std::vector<int64_t> tensor_shape_vec = GetTensorShapeFromTensorProto(tensor_proto);
   // Note: We permit an empty tensor_shape_vec, and treat it as a scalar (a tensor of size 1).
   TensorShape tensor_shape{tensor_shape_vec};
+
+  if (HasExternalData(tensor_proto)) {
+    return GetTensorWithExternalData(tensor_proto, tensor_shape, external_data_dir, p_tensor, allocator,
+                                     preallocated, preallocated_size);
+  }
+
   switch (tensor_proto.data_type()) {
     CASE_PROTO(FLOAT, float);
     CASE_PROTO(DOUBLE, double);
@@ -182,6 +310,48 @@ common::Status GetTensorFromTensorProto(const TensorProto& tensor_proto,
   }
 }
 
+bool TensorProtoCanAliasRawData(const ONNX_NAMESPACE::TensorProto& tensor_proto) {
+  if (!tensor_proto.has_raw_data())
+    return false;
+
+  // raw_data is serialized little-endian; on a big-endian host a byte-swapping
+  // copy is required.
+  if (!IsLittleEndianOrder())
+    return false;
+
+  size_t element_size;
+  if (GetFixedSizeElementType(tensor_proto.data_type(), element_size) == nullptr)
+    return false;
+
+  TensorShape tensor_shape{GetTensorShapeFromTensorProto(tensor_proto)};
+  int64_t tensor_size = tensor_shape.Size();
+  if (tensor_size < 0)
+    return false;
+
+  return tensor_proto.raw_data().size() == static_cast<size_t>(tensor_size) * element_size;
+}
+
+common::Status TensorProtoToMLValueNoCopy(const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                                          const ONNXRuntimeAllocatorInfo& alloc_info, MLValue& value) {
+  if (!TensorProtoCanAliasRawData(tensor_proto))
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                                   "TensorProto raw data cannot back a Tensor directly.");
+
+  size_t element_size;
+  MLDataType ml_type = GetFixedSizeElementType(tensor_proto.data_type(), element_size);
+  TensorShape tensor_shape{GetTensorShapeFromTensorProto(tensor_proto)};
+
+  // No deleter: the bytes stay owned by the TensorProto, which the caller keeps alive.
+  auto p_tensor = std::make_unique<Tensor>(ml_type, tensor_shape,
+                                           const_cast<char*>(tensor_proto.raw_data().data()),
+                                           alloc_info,
+                                           nullptr);
+  value.Init(p_tensor.release(),
+             DataTypeImpl::GetType<Tensor>(),
+             DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+  return common::Status::OK();
+}
+
 TensorProto::DataType GetTensorProtoType(const Tensor& tensor) {
   auto tensor_type = tensor.DataType();
   TensorProto::DataType dtype = TensorProto_DataType_UNDEFINED;
@@ -19,11 +19,23 @@ class TensorShapeProto;
 namespace onnxruntime {
 class Tensor;
 namespace utils {
-common::Status GetTensorFromTensorProto(const ONNX_NAMESPACE::TensorProto& tensor_proto, std::unique_ptr<Tensor>* p_tensor, AllocatorPtr allocator, void* preallocated = nullptr, size_t preallocated_size = 0);
+// external_data_dir is the directory tensors with externally stored payloads resolve their
+// payload file against (see Graph::ModelFileDirectory); the current directory when empty.
+common::Status GetTensorFromTensorProto(const ONNX_NAMESPACE::TensorProto& tensor_proto, std::unique_ptr<Tensor>* p_tensor, AllocatorPtr allocator, void* preallocated = nullptr, size_t preallocated_size = 0, const std::string& external_data_dir = std::string());
 std::vector<int64_t> GetTensorShapeFromTensorProto(const ONNX_NAMESPACE::TensorProto& tensor_proto);
 std::vector<int64_t> GetTensorShapeFromTensorShapeProto(const ONNX_NAMESPACE::TensorShapeProto& tensor_shape_proto);
 common::Status TensorProtoToMLValue(const ONNX_NAMESPACE::TensorProto& input, AllocatorPtr allocator, void* preallocated,
-                                    size_t preallocated_size, MLValue& value);
+                                    size_t preallocated_size, MLValue& value,
+                                    const std::string& external_data_dir = std::string());
+// Returns true if the payload in tensor_proto.raw_data() can back a Tensor directly
+// on this platform: a fixed-size little-endian element type with a byte count that
+// matches the tensor shape.
+bool TensorProtoCanAliasRawData(const ONNX_NAMESPACE::TensorProto& tensor_proto);
+// Creates 'value' as a Tensor that aliases tensor_proto.raw_data() instead of copying
+// it into a freshly allocated buffer. The caller must guarantee tensor_proto outlives
+// 'value'. Only valid when TensorProtoCanAliasRawData returns true.
+common::Status TensorProtoToMLValueNoCopy(const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                                          const ONNXRuntimeAllocatorInfo& alloc_info, MLValue& value);
 ONNX_NAMESPACE::TensorProto::DataType GetTensorProtoType(const Tensor& tensor);
 }  // namespace utils
 }  // namespace onnxruntime
@@ -4,6 +4,7 @@
 #include "core/framework/tensorutils.h"
 #include "core/framework/allocator.h"
 #include "core/framework/data_types.h"
+#include "core/framework/weight_compression.h"
 
 #include <algorithm>
 #include <limits>
@@ -43,9 +44,25 @@ static void UnpackTensorWithRawData(const ONNX_NAMESPACE::TensorProto& tensor, /
   }
 }
 
+// protobuf stores repeated numeric fields contiguously, so unpack them in
+// bulk instead of walking an iterator per element: a field whose element type
+// already matches T is a straight memcpy, and a widening/narrowing field is a
+// flat conversion loop the compiler can vectorize.
+template <typename FieldType, typename T>
+static void UnpackRepeatedField(const FieldType* source, /*out*/ T* p_data, int64_t count) {
+  for (int64_t i = 0; i < count; ++i) {
+    p_data[i] = static_cast<T>(source[i]);
+  }
+}
+
+template <typename T>
+static void UnpackRepeatedField(const T* source, /*out*/ T* p_data, int64_t count) {
+  memcpy(p_data, source, count * sizeof(T));
+}
+
 namespace onnxruntime {
 namespace utils {
-#define DEFINE_UNPACK_TENSOR(T, Type, field_name, field_size)                                                              \
+#define DEFINE_UNPACK_TENSOR(T, Type, field_name, field_size)                                                            \
   template <>                                                                                                              \
   Status TensorUtils::UnpackTensor(const ONNX_NAMESPACE::TensorProto& tensor, /*out*/ T* p_data, int64_t expected_size) {  \
     if (nullptr == p_data) {                                                                                               \
@@ -63,6 +80,8 @@ namespace utils {
       if (!IAllocator::CalcMemSizeForArray(expected_size, sizeof(T), &expected_size_in_bytes)) {                           \
         return Status(common::ONNXRUNTIME, common::FAIL, "size overflow");                                                 \
       }                                                                                                                    \
+      if (HasCompressedWeightPayload(tensor.raw_data()))                                                                   \
+        return DecompressWeightPayload(tensor.raw_data(), p_data, expected_size_in_bytes);                                 \
       if (tensor.raw_data().size() != expected_size_in_bytes)                                                              \
         return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL,                                                                  \
                                        "UnpackTensor: the pre-allocated size does not match the raw data size, expected ", \
@@ -74,8 +93,7 @@ namespace utils {
       return Status(common::ONNXRUNTIME, common::FAIL,                                                                     \
                     "UnpackTensor: the pre-allocated size does not match the size in proto");                              \
     auto& data = tensor.field_name();                                                                                      \
-    for (auto data_iter = data.cbegin(); data_iter != data.cend(); ++data_iter)                                            \
-      *p_data++ = *reinterpret_cast<const T*>(data_iter);                                                                  \
+    UnpackRepeatedField(data.data(), p_data, expected_size);                                                               \
     return Status::OK();                                                                                                   \
   }
 
@@ -133,6 +151,9 @@ Status TensorUtils::UnpackTensor(const ONNX_NAMESPACE::TensorProto& tensor,
   }
 
   if (tensor.has_raw_data()) {
+    if (HasCompressedWeightPayload(tensor.raw_data()))
+      return DecompressWeightPayload(tensor.raw_data(), p_data, expected_size * sizeof(bool));
+
     if (tensor.raw_data().size() != (expected_size) * sizeof(bool))
       return Status(common::ONNXRUNTIME, common::FAIL,
                     "UnpackTensor: the pre-allocate size does not match the raw data size");
@@ -144,9 +165,7 @@ Status TensorUtils::UnpackTensor(const ONNX_NAMESPACE::TensorProto& tensor,
   if (tensor.int32_data_size() != expected_size)
     return Status(common::ONNXRUNTIME, common::FAIL,
                   "UnpackTensor: the pre-allocate size does not match the size in proto");
-  for (auto iter = tensor.int32_data().cbegin(); iter != tensor.int32_data().cend(); ++iter) {
-    *p_data++ = *iter;
-  }
+  UnpackRepeatedField(tensor.int32_data().data(), p_data, expected_size);
 
   return Status::OK();
 }
@@ -166,6 +185,9 @@ Status TensorUtils::UnpackTensor(const ONNX_NAMESPACE::TensorProto& tensor,
   }
 
   if (tensor.has_raw_data()) {
+    if (HasCompressedWeightPayload(tensor.raw_data()))
+      return DecompressWeightPayload(tensor.raw_data(), p_data, expected_size * sizeof(uint16_t));
+
     if (tensor.raw_data().size() != (expected_size) * sizeof(uint16_t))
       return Status(common::ONNXRUNTIME, common::FAIL,
                     "UnpackTensor: the pre-allocate size does not match the raw data size");
@@ -32,6 +32,32 @@ This transformer does not currently optimize copies between, e.g., two different
 
 */
 
+// A def qualifies for a batched copy when its element type and shape are known
+// at transform time and it is small enough that per-copy launch overhead
+// dominates the transfer itself.
+static bool IsSmallStaticTensor(const onnxruntime::NodeArg& arg, int32_t& elem_type) {
+  const auto* type_proto = arg.TypeAsProto();
+  if (type_proto == nullptr || type_proto->value_case() != TypeProto::kTensorType)
+    return false;
+
+  const auto& tensor_type = type_proto->tensor_type();
+  if (!tensor_type.has_elem_type() || !tensor_type.has_shape())
+    return false;
+
+  int64_t num_elements = 1;
+  for (const auto& dim : tensor_type.shape().dim()) {
+    if (!dim.has_dim_value())
+      return false;
+    num_elements *= dim.dim_value();
+  }
+
+  if (num_elements > kBatchedMemcpyMaxElements)
+    return false;
+
+  elem_type = tensor_type.elem_type();
+  return true;
+}
+
 bool TransformerMemcpyImpl::ModifyGraph(const KernelRegistryManager& kernel_registries) {
   bool modified = false;
   // find defs that require copy
@@ -43,12 +69,32 @@ bool TransformerMemcpyImpl::ModifyGraph(const KernelRegistryManager& kernel_regi
   // for initializers shared by different providers, create dups
   ProcessInitializers();
 
+  // Coalesce small statically-shaped tensors headed to the provider so one
+  // packed staging transfer replaces many tiny ones. The batched node is
+  // homogeneous-variadic, so tensors are grouped by element type; everything
+  // else keeps the one-copy-per-tensor path.
+  std::map<int32_t, std::vector<onnxruntime::NodeArg*>> batchable_args;
   for (auto arg : non_provider_output_defs_)
     if (provider_input_defs_.count(arg)) {
-      AddCopyNode(arg, true);
+      int32_t elem_type;
+      if (IsSmallStaticTensor(*arg, elem_type))
+        batchable_args[elem_type].push_back(arg);
+      else
+        AddCopyNode(arg, true);
       modified = true;
     }
 
+  for (auto& pair : batchable_args) {
+    auto& args = pair.second;
+    for (size_t start = 0; start < args.size(); start += kBatchedMemcpyMaxTensors) {
+      size_t count = std::min(args.size() - start, static_cast<size_t>(kBatchedMemcpyMaxTensors));
+      if (count == 1)
+        AddCopyNode(args[start], true);
+      else
+        AddBatchedCopyNode(std::vector<onnxruntime::NodeArg*>(args.begin() + start, args.begin() + start + count));
+    }
+  }
+
   for (auto arg : provider_output_defs_)
     if (non_provider_input_defs_.count(arg)) {
       AddCopyNode(arg, false);
@@ -135,6 +181,28 @@ void TransformerMemcpyImpl::AddCopyNode(onnxruntime::NodeArg* arg, bool is_input
   replacements_.insert(std::make_pair(arg, new_arg));
 }
 
+void TransformerMemcpyImpl::AddBatchedCopyNode(const std::vector<onnxruntime::NodeArg*>& args) {
+  std::vector<onnxruntime::NodeArg*> src_args;
+  std::vector<onnxruntime::NodeArg*> dst_args;
+  for (auto arg : args) {
+    // create unique name for new def
+    std::string new_def_name = graph_.GenerateNodeArgName(arg->Name() + "_" + provider_);
+    auto* new_arg = &graph_.GetOrCreateNodeArg(new_def_name, arg->TypeAsProto());
+    src_args.push_back(arg);
+    dst_args.push_back(new_arg);
+
+    // only add copy-node here; renaming references happens later
+    replacements_.insert(std::make_pair(arg, new_arg));
+  }
+
+  // create unique name for copy node
+  std::string new_node_name = graph_.GenerateNodeName("BatchedMemcpy");
+
+  auto& new_node = graph_.AddNode(new_node_name, "BatchedMemcpyFromHost", "Batched copy from host memory",
+                                  src_args, dst_args);
+  new_node.SetExecutionProviderType(provider_);
+}
+
 template <typename NodeArgSetType>
 static const onnxruntime::NodeArg* FindNodeArg(const NodeArgSetType& def_set, const std::string& name) {
   NodeArg def(name, nullptr);
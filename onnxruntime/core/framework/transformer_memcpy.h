@@ -9,6 +9,14 @@
 
 namespace onnxruntime {
 
+// Small statically-shaped tensors headed to one provider are coalesced into a
+// single BatchedMemcpyFromHost node so one packed staging transfer replaces
+// many tiny ones. These bound how large a tensor may be to qualify and how
+// many tensors one batched node may carry; provider kernels registered for
+// BatchedMemcpyFromHost must accept up to kBatchedMemcpyMaxTensors inputs.
+constexpr int64_t kBatchedMemcpyMaxElements = 4096;
+constexpr int kBatchedMemcpyMaxTensors = 32;
+
 // implements MemCpy node insertion in graph transform
 // note that GraphTransformer::Apply() is supposed to be stateless, so this cannot derive from GraphTranformer
 class TransformerMemcpyImpl {
@@ -21,6 +29,7 @@ class TransformerMemcpyImpl {
  private:
   void ProcessDefs(onnxruntime::Node& node, const KernelRegistryManager& kernel_registries);
   void AddCopyNode(onnxruntime::NodeArg* arg, bool is_input);
+  void AddBatchedCopyNode(const std::vector<onnxruntime::NodeArg*>& args);
   void ProcessInitializers();
 
  private:
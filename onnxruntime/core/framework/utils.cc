@@ -36,7 +36,9 @@ AllocatorPtr GetAllocator(const ExecutionProviders& exec_providers, const ONNXRu
 }
 
 AllocatorPtr GetAllocator(const SessionState& session_state, const ONNXRuntimeAllocatorInfo& allocator_info) {
-  return GetAllocator(session_state.GetExecutionProviders(), allocator_info);
+  // goes through the allocators the session resolved when it finalized its
+  // execution plan info, falling back to the provider lookup.
+  return session_state.GetAllocator(allocator_info);
 }
 
 }  // namespace utils
@@ -0,0 +1,286 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/weight_compression.h"
+
+#include <cstring>
+#include <vector>
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+namespace utils {
+
+namespace {
+
+constexpr char kMagic[4] = {'O', 'R', 'T', 'Z'};
+constexpr uint8_t kFormatVersion = 1;
+constexpr uint8_t kCodecLz77 = 1;
+constexpr size_t kHeaderBytes = 20;
+
+// uncompressed bytes per chunk; bounds the compressor's working state and
+// gives loaders a parallelizable unit for large tensors
+constexpr uint32_t kChunkBytes = 1 << 18;
+
+// LZ77 block codec parameters: 4-byte minimum match found through a small
+// hash table, 16-bit offsets. A sequence is a token byte (high nibble
+// literal count, low nibble match length - 4, 15 meaning "continued in
+// 255-valued extension bytes"), the literals, a 2-byte offset and any match
+// extension bytes; a block ends with a literals-only sequence.
+constexpr size_t kMinMatch = 4;
+constexpr size_t kMaxOffset = 0xFFFF;
+constexpr int kHashBits = 13;
+
+bool IsLittleEndianHost() {
+  int n = 1;
+  return *reinterpret_cast<char*>(&n) == 1;
+}
+
+uint32_t ReadU32(const uint8_t* p) {
+  uint32_t value;
+  memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+uint64_t ReadU64(const uint8_t* p) {
+  uint64_t value;
+  memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+uint32_t HashSequence(uint32_t sequence) {
+  return (sequence * 2654435761u) >> (32 - kHashBits);
+}
+
+void AppendLength(std::string& out, size_t length) {
+  while (length >= 255) {
+    out.push_back(static_cast<char>(255));
+    length -= 255;
+  }
+  out.push_back(static_cast<char>(length));
+}
+
+void AppendSequence(std::string& out, const uint8_t* literals, size_t literal_count,
+                    size_t offset, size_t match_length) {
+  const size_t literal_nibble = literal_count < 15 ? literal_count : 15;
+  const size_t match_nibble = match_length == 0 ? 0 : (match_length - kMinMatch < 15 ? match_length - kMinMatch : 15);
+  out.push_back(static_cast<char>((literal_nibble << 4) | match_nibble));
+  if (literal_nibble == 15) {
+    AppendLength(out, literal_count - 15);
+  }
+  out.append(reinterpret_cast<const char*>(literals), literal_count);
+
+  if (match_length == 0) {
+    return;  // closing literals-only sequence
+  }
+
+  out.push_back(static_cast<char>(offset & 0xFF));
+  out.push_back(static_cast<char>((offset >> 8) & 0xFF));
+  if (match_nibble == 15) {
+    AppendLength(out, match_length - kMinMatch - 15);
+  }
+}
+
+void CompressBlock(const uint8_t* src, size_t size, std::string& out) {
+  std::vector<int64_t> table(size_t{1} << kHashBits, -1);
+
+  size_t pos = 0;
+  size_t anchor = 0;
+  while (pos + kMinMatch <= size) {
+    const uint32_t head = ReadU32(src + pos);
+    const uint32_t hash = HashSequence(head);
+    const int64_t candidate = table[hash];
+    table[hash] = static_cast<int64_t>(pos);
+
+    if (candidate >= 0 && pos - static_cast<size_t>(candidate) <= kMaxOffset &&
+        ReadU32(src + candidate) == head) {
+      size_t match_length = kMinMatch;
+      while (pos + match_length < size && src[candidate + match_length] == src[pos + match_length]) {
+        ++match_length;
+      }
+
+      AppendSequence(out, src + anchor, pos - anchor, pos - candidate, match_length);
+      pos += match_length;
+      anchor = pos;
+    } else {
+      ++pos;
+    }
+  }
+
+  AppendSequence(out, src + anchor, size - anchor, 0, 0);
+}
+
+common::Status ReadLength(const uint8_t* in, size_t in_size, size_t& ip, size_t& length) {
+  uint8_t byte;
+  do {
+    if (ip >= in_size) {
+      return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, "compressed weight payload is truncated");
+    }
+    byte = in[ip++];
+    length += byte;
+  } while (byte == 255);
+  return common::Status::OK();
+}
+
+common::Status DecompressBlock(const uint8_t* in, size_t in_size, uint8_t* dst, size_t dst_size) {
+  size_t ip = 0;
+  size_t op = 0;
+
+  while (ip < in_size) {
+    const uint8_t token = in[ip++];
+
+    size_t literal_count = token >> 4;
+    if (literal_count == 15) {
+      ONNXRUNTIME_RETURN_IF_ERROR(ReadLength(in, in_size, ip, literal_count));
+    }
+    if (ip + literal_count > in_size || op + literal_count > dst_size) {
+      return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, "compressed weight payload is corrupt");
+    }
+    memcpy(dst + op, in + ip, literal_count);
+    ip += literal_count;
+    op += literal_count;
+
+    if (ip == in_size) {
+      break;  // closing literals-only sequence
+    }
+
+    if (ip + 2 > in_size) {
+      return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, "compressed weight payload is truncated");
+    }
+    const size_t offset = static_cast<size_t>(in[ip]) | (static_cast<size_t>(in[ip + 1]) << 8);
+    ip += 2;
+
+    size_t match_length = (token & 0xF) + kMinMatch;
+    if ((token & 0xF) == 15) {
+      ONNXRUNTIME_RETURN_IF_ERROR(ReadLength(in, in_size, ip, match_length));
+    }
+    if (offset == 0 || offset > op || op + match_length > dst_size) {
+      return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, "compressed weight payload is corrupt");
+    }
+
+    // byte-wise copy on purpose: a match may overlap its own output when the
+    // offset is smaller than the length (run-length style references)
+    const uint8_t* match = dst + op - offset;
+    for (size_t i = 0; i < match_length; ++i) {
+      dst[op + i] = match[i];
+    }
+    op += match_length;
+  }
+
+  if (op != dst_size) {
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL,
+                                   "compressed weight chunk decoded to ", op, " bytes, expected ", dst_size);
+  }
+  return common::Status::OK();
+}
+
+}  // namespace
+
+bool HasCompressedWeightPayload(const std::string& raw_data) {
+  return raw_data.size() >= kHeaderBytes &&
+         memcmp(raw_data.data(), kMagic, sizeof(kMagic)) == 0 &&
+         static_cast<uint8_t>(raw_data[4]) == kFormatVersion;
+}
+
+common::Status DecompressWeightPayload(const std::string& raw_data, void* dst, size_t dst_size) {
+  if (!HasCompressedWeightPayload(raw_data)) {
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "raw_data is not a compressed weight payload");
+  }
+  if (!IsLittleEndianHost()) {
+    // the payload stores the little-endian raw_data bytes; decompressing and
+    // byte-swapping per element type is not supported
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED,
+                                   "compressed weight payloads require a little-endian host");
+  }
+
+  const auto* in = reinterpret_cast<const uint8_t*>(raw_data.data());
+  const size_t in_size = raw_data.size();
+  if (static_cast<uint8_t>(in[5]) != kCodecLz77) {
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED,
+                                   "unknown weight compression codec ", static_cast<int>(in[5]));
+  }
+
+  const uint64_t uncompressed_bytes = ReadU64(in + 8);
+  const uint32_t chunk_bytes = ReadU32(in + 16);
+  if (uncompressed_bytes != dst_size || chunk_bytes == 0) {
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL,
+                                   "compressed weight payload holds ", uncompressed_bytes,
+                                   " bytes, destination expects ", dst_size);
+  }
+
+  auto* out = static_cast<uint8_t*>(dst);
+  size_t ip = kHeaderBytes;
+  size_t op = 0;
+  while (op < dst_size) {
+    const size_t chunk_size = dst_size - op < chunk_bytes ? dst_size - op : chunk_bytes;
+    if (ip + sizeof(uint32_t) > in_size) {
+      return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, "compressed weight payload is truncated");
+    }
+    const uint32_t compressed_size = ReadU32(in + ip);
+    ip += sizeof(uint32_t);
+
+    if (compressed_size == 0) {
+      // stored chunk, copied verbatim
+      if (ip + chunk_size > in_size) {
+        return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, "compressed weight payload is truncated");
+      }
+      memcpy(out + op, in + ip, chunk_size);
+      ip += chunk_size;
+    } else {
+      if (ip + compressed_size > in_size) {
+        return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, "compressed weight payload is truncated");
+      }
+      ONNXRUNTIME_RETURN_IF_ERROR(DecompressBlock(in + ip, compressed_size, out + op, chunk_size));
+      ip += compressed_size;
+    }
+    op += chunk_size;
+  }
+
+  if (ip != in_size) {
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL,
+                                   "compressed weight payload has ", in_size - ip, " trailing bytes");
+  }
+  return common::Status::OK();
+}
+
+common::Status CompressWeightPayload(const void* src, size_t size, std::string& out) {
+  if (!IsLittleEndianHost()) {
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED,
+                                   "compressed weight payloads require a little-endian host");
+  }
+
+  out.clear();
+  out.append(kMagic, sizeof(kMagic));
+  out.push_back(static_cast<char>(kFormatVersion));
+  out.push_back(static_cast<char>(kCodecLz77));
+  out.push_back(0);
+  out.push_back(0);
+  const uint64_t uncompressed_bytes = size;
+  out.append(reinterpret_cast<const char*>(&uncompressed_bytes), sizeof(uncompressed_bytes));
+  out.append(reinterpret_cast<const char*>(&kChunkBytes), sizeof(kChunkBytes));
+
+  const auto* in = static_cast<const uint8_t*>(src);
+  std::string compressed_chunk;
+  for (size_t pos = 0; pos < size; pos += kChunkBytes) {
+    const size_t chunk_size = size - pos < kChunkBytes ? size - pos : kChunkBytes;
+
+    compressed_chunk.clear();
+    CompressBlock(in + pos, chunk_size, compressed_chunk);
+
+    if (compressed_chunk.size() < chunk_size) {
+      const uint32_t compressed_size = static_cast<uint32_t>(compressed_chunk.size());
+      out.append(reinterpret_cast<const char*>(&compressed_size), sizeof(compressed_size));
+      out.append(compressed_chunk);
+    } else {
+      // incompressible chunk, store it verbatim
+      const uint32_t stored_marker = 0;
+      out.append(reinterpret_cast<const char*>(&stored_marker), sizeof(stored_marker));
+      out.append(reinterpret_cast<const char*>(in + pos), chunk_size);
+    }
+  }
+
+  return common::Status::OK();
+}
+
+}  // namespace utils
+}  // namespace onnxruntime
@@ -0,0 +1,49 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+
+#include "core/common/status.h"
+
+namespace onnxruntime {
+namespace utils {
+
+// Compressed initializer payloads. A producer may replace the raw_data bytes
+// of a TensorProto with a self-describing compressed payload; the unpack
+// routines detect the payload by its magic header and decompress straight
+// into the destination weight buffer. The codec is a self-contained
+// byte-oriented LZ77 with a 64KB window, chosen over an external
+// zstd/LZ4 dependency so models stay loadable everywhere the runtime
+// builds. The payload is chunked so producers can compress and loaders can
+// decompress large tensors piecewise; tensors deserialize on the session
+// init thread pool, so chunked tensors across a model decompress in
+// parallel.
+//
+// Payload layout (all integers little-endian):
+//   offset 0:  4-byte magic "ORTZ"
+//   offset 4:  uint8  format version (1)
+//   offset 5:  uint8  codec (1 = LZ77 block)
+//   offset 6:  uint16 reserved, must be 0
+//   offset 8:  uint64 uncompressed byte count
+//   offset 16: uint32 uncompressed bytes per chunk (last chunk may be short)
+//   offset 20: per chunk, a uint32 compressed byte count followed by the
+//              chunk payload. A zero count marks a stored chunk whose bytes
+//              follow verbatim, used when compression does not shrink it.
+
+// True when raw_data carries a compressed payload rather than plain weight
+// bytes.
+bool HasCompressedWeightPayload(const std::string& raw_data);
+
+// Decompresses a payload into dst, which must hold exactly the tensor's
+// uncompressed byte count. The payload stores the little-endian weight bytes,
+// so decompression is only supported on little-endian hosts.
+common::Status DecompressWeightPayload(const std::string& raw_data, void* dst, size_t dst_size);
+
+// Builds the compressed payload for size bytes of weight data. Used by model
+// producers and tests; the runtime itself only decompresses.
+common::Status CompressWeightPayload(const void* src, size_t size, std::string& out);
+
+}  // namespace utils
+}  // namespace onnxruntime
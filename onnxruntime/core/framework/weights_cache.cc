@@ -0,0 +1,81 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/weights_cache.h"
+
+namespace onnxruntime {
+
+WeightsCache& WeightsCache::Instance() {
+  static WeightsCache instance;
+  return instance;
+}
+
+common::Status WeightsCache::GetOrCreate(const std::string& model_key,
+                                         const std::string& tensor_name,
+                                         const std::function<common::Status(MLValue&)>& create_fn,
+                                         MLValue& value) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto model_it = cache_.find(model_key);
+    if (model_it != cache_.end()) {
+      auto weight_it = model_it->second.weights.find(tensor_name);
+      if (weight_it != model_it->second.weights.end()) {
+        weight_it->second.generation = model_it->second.generation;
+        value = weight_it->second.value;
+        return common::Status::OK();
+      }
+    }
+  }
+
+  // Materialize outside the lock; deserialization can be slow and other
+  // weights should not have to wait on it.
+  MLValue created;
+  ONNXRUNTIME_RETURN_IF_ERROR(create_fn(created));
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& model_weights = cache_[model_key];
+  auto result = model_weights.weights.emplace(tensor_name, WeightEntry{created, model_weights.generation});
+  // if another session inserted first, use its copy and drop ours.
+  result.first->second.generation = model_weights.generation;
+  value = result.first->second.value;
+  return common::Status::OK();
+}
+
+void WeightsCache::AddSessionRef(const std::string& model_key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  cache_[model_key].session_refs++;
+}
+
+void WeightsCache::BeginSwap(const std::string& model_key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  cache_[model_key].generation++;
+}
+
+void WeightsCache::EndSwap(const std::string& model_key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = cache_.find(model_key);
+  if (it == cache_.end())
+    return;
+
+  auto& weights = it->second.weights;
+  for (auto weight_it = weights.begin(); weight_it != weights.end();) {
+    if (weight_it->second.generation < it->second.generation) {
+      weight_it = weights.erase(weight_it);
+    } else {
+      ++weight_it;
+    }
+  }
+}
+
+void WeightsCache::ReleaseSession(const std::string& model_key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = cache_.find(model_key);
+  if (it == cache_.end())
+    return;
+
+  if (--it->second.session_refs <= 0) {
+    cache_.erase(it);
+  }
+}
+
+}  // namespace onnxruntime
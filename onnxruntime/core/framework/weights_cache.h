@@ -0,0 +1,82 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "core/common/common.h"
+#include "core/common/status.h"
+#include "core/framework/ml_value.h"
+
+namespace onnxruntime {
+
+/**
+   Process-wide cache of immutable weight tensors.
+
+   Deployments that create one InferenceSession per worker thread otherwise pay
+   for a private copy of every initializer in every session. Sessions that set
+   SessionOptions.shared_weights_key publish the CPU weight tensors they
+   materialize here, and later sessions using the same key pick up the shared
+   Tensors instead of deserializing their own copies. The cached MLValues hold
+   the underlying buffers via shared_ptr, so per-session state stays separate
+   while the bytes are shared.
+
+   Entries are reference counted by session: the cache drops a model's weights
+   once the last session registered against its key is destroyed.
+*/
+class WeightsCache {
+ public:
+  static WeightsCache& Instance();
+
+  /// @brief Look up the weight for (model_key, tensor_name); on a miss invoke
+  /// create_fn to materialize it and cache the result. Thread safe. If two
+  /// sessions race to create the same weight the first insert wins and the
+  /// other copy is discarded.
+  common::Status GetOrCreate(const std::string& model_key,
+                             const std::string& tensor_name,
+                             const std::function<common::Status(MLValue&)>& create_fn,
+                             MLValue& value);
+
+  /// @brief Record that a session uses model_key. Call before GetOrCreate.
+  void AddSessionRef(const std::string& model_key);
+
+  /// @brief Drop a session's reference; the weights for model_key are released
+  /// when the last session goes away.
+  void ReleaseSession(const std::string& model_key);
+
+  /// @brief Open a new publication generation for model_key. Entries a later
+  /// GetOrCreate touches (hit or insert) are stamped with the new generation;
+  /// use with EndSwap to drop the weights only a replaced model version used.
+  void BeginSwap(const std::string& model_key);
+
+  /// @brief Drop the entries for model_key that no GetOrCreate has touched
+  /// since the matching BeginSwap, i.e. the weights unique to the old version.
+  /// Sessions still holding those tensors keep them alive through their own
+  /// MLValue references; only the cache's reference is released here.
+  void EndSwap(const std::string& model_key);
+
+ private:
+  ONNXRUNTIME_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(WeightsCache);
+  WeightsCache() = default;
+
+  struct WeightEntry {
+    MLValue value;
+    uint64_t generation{0};
+  };
+
+  struct ModelWeights {
+    int session_refs{0};
+    uint64_t generation{0};
+    std::unordered_map<std::string, WeightEntry> weights;
+  };
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, ModelWeights> cache_;
+};
+
+}  // namespace onnxruntime
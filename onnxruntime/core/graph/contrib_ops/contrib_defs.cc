@@ -89,6 +89,328 @@ activation.)DOC")
         ONNX_NAMESPACE::convPoolTypeAndShapeInference(ctx, false, true);
       });
 
+  ONNX_CONTRIB_OPERATOR_SCHEMA(FusedGemm)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(R"DOC(
+The fused gemm operator schema is the same as Gemm besides it includes attributes
+activation and leaky_relu_alpha.)DOC")
+      .Attr(
+          "transA",
+          "",
+          AttributeProto::INT,
+          static_cast<int64_t>(0))
+      .Attr(
+          "transB",
+          "",
+          AttributeProto::INT,
+          static_cast<int64_t>(0))
+      .Attr(
+          "alpha",
+          "",
+          AttributeProto::FLOAT,
+          1.0f)
+      .Attr(
+          "beta",
+          "",
+          AttributeProto::FLOAT,
+          1.0f)
+      .Attr(
+          "activation",
+          "",
+          AttributeProto::STRING,
+          OPTIONAL)
+      .Attr(
+          "leaky_relu_alpha",
+          "",
+          AttributeProto::FLOAT,
+          OPTIONAL)
+      .Input(
+          0,
+          "A",
+          "",
+          "T")
+      .Input(
+          1,
+          "B",
+          "",
+          "T")
+      .Input(2, "C", "", "T")
+      .Output(
+          0,
+          "Y",
+          "",
+          "T")
+      .TypeConstraint("T", {"tensor(float16)", "tensor(float)", "tensor(double)"}, "Constrain input and output types to float tensors")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        ONNX_NAMESPACE::propagateElemTypeFromInputToOutput(ctx, 0, 0);
+      });
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(FusedElementwise)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(R"DOC(
+Evaluates a chain of elementwise ops as a single kernel. The 'ops' attribute
+lists the chain in execution order; each binary op consumes the running value
+and the next unused input. All inputs must share one shape - the fused kernel
+performs no broadcasting.)DOC")
+      .Attr(
+          "ops",
+          "",
+          AttributeProto::STRINGS)
+      .Attr(
+          "alphas",
+          "",
+          AttributeProto::FLOATS,
+          OPTIONAL)
+      .Input(0, "inputs", "", "T", OpSchema::Variadic)
+      .Output(
+          0,
+          "Y",
+          "",
+          "T")
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors")
+      .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput);
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(FusedGru)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(R"DOC(
+Runs a stack of unidirectional forward GRU layers as a single kernel. The
+hidden state sequence of each layer feeds the next layer directly through a
+scratch buffer instead of materializing the intermediate `Y` tensors. The
+inputs are `X` followed by the `W`, `R` and `B` tensors of each layer in
+order; the outputs are the `Y` and `Y_h` of the final layer. All layers use
+the default sigmoid/tanh activations with no clipping.)DOC")
+      .Attr(
+          "num_layers",
+          "Number of stacked GRU layers",
+          AttributeProto::INT)
+      .Attr(
+          "linear_before_reset",
+          "",
+          AttributeProto::INT,
+          static_cast<int64_t>(0))
+      .Input(0, "inputs", "", "T", OpSchema::Variadic)
+      .Output(
+          0,
+          "Y",
+          "",
+          "T")
+      .Output(
+          1,
+          "Y_h",
+          "",
+          "T",
+          OpSchema::Optional)
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        ONNX_NAMESPACE::propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        if (ctx.getNumOutputs() > 1) {
+          ONNX_NAMESPACE::propagateElemTypeFromInputToOutput(ctx, 0, 1);
+        }
+      });
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(DynamicQuantizeLSTM)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(R"DOC(
+Forward LSTM with int8 weights for latency-constrained CPUs. W and R are
+stored as int8 in the ONNX iofc gate order with one scale per gate; the
+input and recurrent GEMMs quantize their fp32 activations dynamically per
+timestep, accumulate in int32, and the gate nonlinearities run in fp32.
+Uses the default sigmoid/tanh/tanh activations with no peepholes or
+clipping.)DOC")
+      .Attr(
+          "hidden_size",
+          "Number of neurons in the hidden layer",
+          AttributeProto::INT)
+      .Input(0, "X", "Input sequence, shape [seq_length, batch_size, input_size]", "T")
+      .Input(1, "W", "Quantized input weights, shape [4*hidden_size, input_size]", "T2")
+      .Input(2, "R", "Quantized recurrent weights, shape [4*hidden_size, hidden_size]", "T2")
+      .Input(3, "W_scale", "Per-gate scales for W, shape [4]", "T")
+      .Input(4, "R_scale", "Per-gate scales for R, shape [4]", "T")
+      .Input(5, "B", "Concatenated Wb and Rb biases, shape [8*hidden_size]", "T", OpSchema::Optional)
+      .Input(6, "initial_h", "Initial hidden state, shape [batch_size, hidden_size]", "T", OpSchema::Optional)
+      .Input(7, "initial_c", "Initial cell state, shape [batch_size, hidden_size]", "T", OpSchema::Optional)
+      .Output(0, "Y", "Hidden state sequence, shape [seq_length, 1, batch_size, hidden_size]", "T", OpSchema::Optional)
+      .Output(1, "Y_h", "Final hidden state, shape [1, batch_size, hidden_size]", "T", OpSchema::Optional)
+      .Output(2, "Y_c", "Final cell state, shape [1, batch_size, hidden_size]", "T", OpSchema::Optional)
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain activations and scales to float tensors")
+      .TypeConstraint("T2", {"tensor(int8)"}, "Constrain weights to int8 tensors")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        for (size_t i = 0; i < ctx.getNumOutputs(); ++i) {
+          ONNX_NAMESPACE::propagateElemTypeFromInputToOutput(ctx, 0, i);
+        }
+      });
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(SparseDictVectorizer)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(R"DOC(
+Sparse counterpart of the ONNX-ML DictVectorizer. Uses the provided
+vocabulary to map an input dictionary to a one-row sparse matrix containing
+only the entries that are actually present, instead of a dense row that is
+almost entirely zeros. Exactly one of string_vocabulary and int64_vocabulary
+must be set, matching the key type of the input map.)DOC")
+      .Attr(
+          "string_vocabulary",
+          "The vocabulary vector of strings",
+          AttributeProto::STRINGS,
+          OPTIONAL)
+      .Attr(
+          "int64_vocabulary",
+          "The vocabulary vector of int64s",
+          AttributeProto::INTS,
+          OPTIONAL)
+      .Input(0, "X", "The input dictionary", "T1")
+      .Output(0, "Y", "The one-row sparse matrix", "T2")
+      .TypeConstraint(
+          "T1",
+          {"map(string,tensor(float))", "map(int64,tensor(float))"},
+          "The input must be a map from strings or int64s to floats")
+      .TypeConstraint(
+          "T2",
+          {"opaque(com.microsoft,SparseTensorCSR)"},
+          "The output is a sparse CSR matrix");
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(SparseMatMul)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(R"DOC(
+Matrix product of a sparse CSR matrix A with a dense 2D matrix B. Only the
+non-zero entries of A are visited, so the cost scales with the number of
+non-zeros rather than the full dense dimensions.)DOC")
+      .Input(0, "A", "The sparse left-hand matrix", "T1")
+      .Input(1, "B", "The dense right-hand matrix", "T2")
+      .Output(0, "Y", "The dense product matrix", "T2")
+      .TypeConstraint(
+          "T1",
+          {"opaque(com.microsoft,SparseTensorCSR)"},
+          "The left-hand input is a sparse CSR matrix")
+      .TypeConstraint("T2", {"tensor(float)"}, "Constrain dense input and output to float tensors")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        updateOutputElemType(ctx, 0, ONNX_NAMESPACE::TensorProto::FLOAT);
+      });
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(GatherND)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(R"DOC(
+Gathers slices of data addressed by multi-dimensional indices. The last
+dimension of indices holds index tuples of length q; each tuple addresses the
+slice of data obtained by fixing its first q dimensions, so the output has
+shape indices.shape[:-1] ++ data.shape[q:]. Negative index values count from
+the end of the corresponding dimension.)DOC")
+      .Input(0, "data", "Tensor to gather slices from", "T")
+      .Input(1, "indices", "Tensor of index tuples; the last dimension is the tuple length", "Tind")
+      .Output(0, "output", "The gathered slices", "T")
+      .TypeConstraint(
+          "T",
+          ONNX_NAMESPACE::OpSchema::all_tensor_types(),
+          "Constrain input and output to any tensor type")
+      .TypeConstraint("Tind", {"tensor(int64)"}, "Constrain indices to int64")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+      });
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(ScatterND)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(R"DOC(
+Copies data and overwrites the slices addressed by multi-dimensional indices
+with the corresponding slices of updates. The last dimension of indices holds
+index tuples of length q; each tuple addresses the slice of data obtained by
+fixing its first q dimensions, so updates must have shape
+indices.shape[:-1] ++ data.shape[q:]. Negative index values count from the
+end of the corresponding dimension. When tuples repeat, the last update in
+indices order wins.)DOC")
+      .Input(0, "data", "Tensor to copy and update", "T")
+      .Input(1, "indices", "Tensor of index tuples; the last dimension is the tuple length", "Tind")
+      .Input(2, "updates", "Replacement slices, one per index tuple", "T")
+      .Output(0, "output", "Copy of data with the addressed slices replaced", "T")
+      .TypeConstraint(
+          "T",
+          ONNX_NAMESPACE::OpSchema::all_tensor_types(),
+          "Constrain input and output to any tensor type")
+      .TypeConstraint("Tind", {"tensor(int64)"}, "Constrain indices to int64")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        if (hasInputShape(ctx, 0)) {
+          propagateShapeFromInputToOutput(ctx, 0, 0);
+        }
+      });
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(LayerNormalization)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(R"DOC(
+Layer normalization fused into one kernel. For every row spanned by the
+dimensions from axis to the end, the output is
+(X - mean) / sqrt(variance + epsilon) * scale + B, with mean and variance
+computed over the row. Equivalent to the
+ReduceMean/Sub/Pow/ReduceMean/Add/Sqrt/Div/Mul/Add subgraph transformer
+models emit; see LayerNormFusion.)DOC")
+      .Attr("axis",
+            "First dimension of the normalized span; statistics are computed over dimensions axis..rank-1. Negative values count from the end.",
+            AttributeProto::INT, static_cast<int64_t>(-1))
+      .Attr("epsilon",
+            "Value added to the variance before taking the square root.",
+            AttributeProto::FLOAT, 1e-5f)
+      .Input(0, "X", "Input tensor", "T")
+      .Input(1, "scale", "Per-element scale, one value per element of the normalized span", "T")
+      .Input(2, "B", "Per-element bias, one value per element of the normalized span", "T", OpSchema::Optional)
+      .Output(0, "Y", "Normalized tensor with the same shape as X", "T")
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output to float tensors")
+      .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput);
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(EmbeddingBag)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(R"DOC(
+Embedding lookup with the reduction fused in. Every bag — one span of the
+innermost indices axis — sums (or averages, per mode) the addressed rows of
+data directly, producing what ReduceSum/ReduceMean over the gathered axis of
+Gather(data, indices) would, without materializing the gathered intermediate;
+see EmbedBagFusion.)DOC")
+      .Attr("mode",
+            "Reduction applied over each bag: 'sum' or 'mean'.",
+            AttributeProto::STRING, std::string("sum"))
+      .Attr("keepdims",
+            "Keep the reduced bag axis as a dimension of size 1, matching the ReduceSum/ReduceMean attribute.",
+            AttributeProto::INT, static_cast<int64_t>(1))
+      .Input(0, "data", "Embedding table; rows are indexed by the first dimension", "T")
+      .Input(1, "indices", "Row indices; the innermost dimension spans one bag", "Tind")
+      .Output(0, "output", "Reduced rows, shaped indices.shape[:-1] ++ data.shape[1:], with the bag axis kept when keepdims is 1", "T")
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output to float tensors")
+      .TypeConstraint("Tind", {"tensor(int32)", "tensor(int64)"}, "Constrain indices to integral tensors")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        if (!hasInputShape(ctx, 0) || !hasInputShape(ctx, 1)) {
+          return;
+        }
+        auto& data_shape = getInputShape(ctx, 0);
+        auto& indices_shape = getInputShape(ctx, 1);
+        if (indices_shape.dim_size() < 1 || data_shape.dim_size() < 1) {
+          fail_shape_inference("data and indices must have rank >= 1");
+        }
+        int64_t keepdims = 1;
+        auto* keepdims_attr = ctx.getAttribute("keepdims");
+        if (keepdims_attr != nullptr) {
+          keepdims = keepdims_attr->i();
+        }
+        auto* output_shape = ctx.getOutputType(0)->mutable_tensor_type()->mutable_shape();
+        for (int i = 0; i < indices_shape.dim_size() - 1; ++i) {
+          *output_shape->add_dim() = indices_shape.dim(i);
+        }
+        if (keepdims == 1) {
+          output_shape->add_dim()->set_dim_value(1);
+        }
+        for (int i = 1; i < data_shape.dim_size(); ++i) {
+          *output_shape->add_dim() = data_shape.dim(i);
+        }
+      });
+
   ONNX_CONTRIB_OPERATOR_SCHEMA(ExpandDims)
       .SetDomain(kMSDomain)
       .SinceVersion(1)
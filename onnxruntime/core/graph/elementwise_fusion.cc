@@ -0,0 +1,177 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/graph/elementwise_fusion.h"
+#include "core/graph/graph_utils.h"
+#include "core/graph/graph_viewer.h"
+
+#include <unordered_set>
+
+using namespace onnx;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+bool IsFusableUnary(const Node& node) {
+  return utils::IsSupportedOptypeVersionAndDomain(node, "Relu", 6) ||
+         utils::IsSupportedOptypeVersionAndDomain(node, "LeakyRelu", 6) ||
+         utils::IsSupportedOptypeVersionAndDomain(node, "Sigmoid", 6) ||
+         utils::IsSupportedOptypeVersionAndDomain(node, "Tanh", 6) ||
+         utils::IsSupportedOptypeVersionAndDomain(node, "Exp", 6) ||
+         utils::IsSupportedOptypeVersionAndDomain(node, "Log", 6) ||
+         utils::IsSupportedOptypeVersionAndDomain(node, "Sqrt", 6) ||
+         utils::IsSupportedOptypeVersionAndDomain(node, "Neg", 6) ||
+         utils::IsSupportedOptypeVersionAndDomain(node, "Abs", 6);
+}
+
+bool IsFusableBinary(const Node& node) {
+  return utils::IsSupportedOptypeVersionAndDomain(node, "Add", 7) ||
+         utils::IsSupportedOptypeVersionAndDomain(node, "Sub", 7) ||
+         utils::IsSupportedOptypeVersionAndDomain(node, "Mul", 7) ||
+         utils::IsSupportedOptypeVersionAndDomain(node, "Div", 7);
+}
+
+bool IsFloatTensor(const NodeArg& arg) {
+  const auto* type = arg.TypeAsProto();
+  return type != nullptr &&
+         type->tensor_type().has_elem_type() &&
+         type->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_FLOAT;
+}
+
+// The fused kernel performs no broadcasting, so both operands of every binary
+// step must have the same fully-known shape.
+bool HasKnownEqualShape(const NodeArg& a, const NodeArg& b) {
+  const auto* shape_a = a.Shape();
+  const auto* shape_b = b.Shape();
+  if (shape_a == nullptr || shape_b == nullptr ||
+      shape_a->dim_size() != shape_b->dim_size()) {
+    return false;
+  }
+  for (int i = 0; i < shape_a->dim_size(); ++i) {
+    if (!shape_a->dim(i).has_dim_value() || !shape_b->dim(i).has_dim_value() ||
+        shape_a->dim(i).dim_value() != shape_b->dim(i).dim_value()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+float LeakyReluAlpha(const Node& node) {
+  const NodeAttributes& attrs = node.GetAttributes();
+  auto it = attrs.find("alpha");
+  return it == attrs.end() ? 0.01f : it->second.f();
+}
+}  // namespace
+
+Status ElementwiseFusion::Apply(Graph& graph, bool& modified) const {
+  GraphViewer graph_viewer(graph);
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder();
+
+  std::unordered_set<NodeIndex> fused_nodes;
+  std::vector<onnxruntime::NodeIndex> removed_nodes;
+
+  for (auto index : order) {
+    auto node = graph.GetNode(index);
+    if (node == nullptr || fused_nodes.count(index) > 0) {
+      continue;
+    }
+
+    const bool starts_binary = IsFusableBinary(*node);
+    if ((!starts_binary && !IsFusableUnary(*node)) || node->OutputDefs().size() != 1) {
+      continue;
+    }
+
+    auto& input_defs = node->MutableInputDefs();
+    std::vector<NodeArg*> external_inputs;
+    if (starts_binary) {
+      if (input_defs.size() != 2 || !IsFloatTensor(*input_defs[0]) ||
+          !HasKnownEqualShape(*input_defs[0], *input_defs[1])) {
+        continue;
+      }
+      external_inputs.push_back(input_defs[0]);
+      external_inputs.push_back(input_defs[1]);
+    } else {
+      if (input_defs.size() != 1 || !IsFloatTensor(*input_defs[0])) {
+        continue;
+      }
+      external_inputs.push_back(input_defs[0]);
+    }
+
+    // every value in the chain has this shape, so binary extensions only need
+    // to check their external operand against it
+    const NodeArg* shape_ref = input_defs[0];
+
+    std::vector<Node*> chain{node};
+    std::vector<std::string> ops{node->OpType()};
+    std::vector<float> alphas{node->OpType() == "LeakyRelu" ? LeakyReluAlpha(*node) : 0.0f};
+
+    // Grow the chain while the running value has exactly one consumer and that
+    // consumer is another fusable elementwise op.
+    Node* last = node;
+    while (last->GetOutputEdgesCount() == 1 && !graph.IsNodeOutputsInGraphOutputs(*last)) {
+      Node* next = graph.GetNode((*last->OutputNodesBegin()).Index());
+      if (next == nullptr || next->OutputDefs().size() != 1) {
+        break;
+      }
+
+      NodeArg* chain_def = last->MutableOutputDefs()[0];
+      if (IsFusableUnary(*next)) {
+        if (next->InputDefs().size() != 1) {
+          break;
+        }
+      } else if (IsFusableBinary(*next)) {
+        auto& next_inputs = next->MutableInputDefs();
+        if (next_inputs.size() != 2) {
+          break;
+        }
+        const int chain_pos = next_inputs[0] == chain_def ? 0 : 1;
+        // the running value must be the left operand of Sub/Div; Add and Mul commute
+        if (chain_pos == 1 && next->OpType() != "Add" && next->OpType() != "Mul") {
+          break;
+        }
+        NodeArg* other = next_inputs[chain_pos == 0 ? 1 : 0];
+        if (other == chain_def || !HasKnownEqualShape(*shape_ref, *other)) {
+          break;
+        }
+        external_inputs.push_back(other);
+      } else {
+        break;
+      }
+
+      chain.push_back(next);
+      ops.push_back(next->OpType());
+      alphas.push_back(next->OpType() == "LeakyRelu" ? LeakyReluAlpha(*next) : 0.0f);
+      last = next;
+    }
+
+    // a single node gains nothing from fusion
+    if (chain.size() < 2) {
+      continue;
+    }
+
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName("fused " + node->Name()), "FusedElementwise",
+                                     "fused elementwise chain starting at " + node->Name(),
+                                     external_inputs,
+                                     last->MutableOutputDefs(),
+                                     nullptr,
+                                     "com.microsoft");
+    fused_node.AddAttribute("ops", ops);
+    fused_node.AddAttribute("alphas", alphas);
+
+    for (auto chain_node : chain) {
+      fused_nodes.insert(chain_node->Index());
+      removed_nodes.push_back(chain_node->Index());
+    }
+  }
+
+  for (auto i : removed_nodes) {
+    graph.RemoveNode(i);
+  }
+
+  if (!removed_nodes.empty()) {
+    modified = true;
+    ONNXRUNTIME_RETURN_IF_ERROR(graph.Resolve());
+  }
+  return Status::OK();
+}
+}  // namespace onnxruntime
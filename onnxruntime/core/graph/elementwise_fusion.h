@@ -0,0 +1,16 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/graph/graph_transformer.h"
+
+namespace onnxruntime {
+
+class ElementwiseFusion : public onnxruntime::GraphTransformer {
+ public:
+  ElementwiseFusion() noexcept : onnxruntime::GraphTransformer("ElementwiseFusion", "Fusing chains of elementwise ops into FusedElementwise") {}
+  Status Apply(onnxruntime::Graph& graph, bool& modified) const override;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,114 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/graph/embed_bag_fusion.h"
+#include "core/graph/graph_utils.h"
+#include "core/graph/graph_viewer.h"
+
+using namespace onnx;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+// The single consumer of node's output when it has the given op type;
+// nullptr when the output fans out, feeds a graph output, or the consumer is
+// a different op.
+Node* SingleConsumer(Graph& graph, const Node& node, const std::string& op_type) {
+  if (node.GetOutputEdgesCount() != 1 || graph.IsNodeOutputsInGraphOutputs(node)) {
+    return nullptr;
+  }
+  Node* consumer = graph.GetNode((*node.OutputNodesBegin()).Index());
+  if (consumer == nullptr || consumer->OpType() != op_type) {
+    return nullptr;
+  }
+  return consumer;
+}
+
+// True when the reduction runs over exactly the innermost gathered axis —
+// the bag axis — which is what makes the pair an embedding bag. Fills in the
+// keepdims the fused node has to reproduce.
+bool ReducesBagAxis(const Node& reduce, int64_t indices_rank, int64_t gather_output_rank,
+                    int64_t& keepdims) {
+  const auto& attributes = reduce.GetAttributes();
+  auto keepdims_it = attributes.find("keepdims");
+  keepdims = keepdims_it != attributes.end() ? keepdims_it->second.i() : 1;
+
+  auto axes_it = attributes.find("axes");
+  if (axes_it == attributes.end() || axes_it->second.ints_size() != 1) {
+    return false;
+  }
+  int64_t axis = axes_it->second.ints(0);
+  if (axis < 0) {
+    axis += gather_output_rank;
+  }
+  return axis == indices_rank - 1;
+}
+}  // namespace
+
+Status EmbedBagFusion::Apply(Graph& graph, bool& modified) const {
+  GraphViewer graph_viewer(graph);
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder();
+
+  std::vector<onnxruntime::NodeIndex> removed_nodes;
+  for (auto index : order) {
+    auto node = graph.GetNode(index);
+    if (node == nullptr ||
+        !utils::IsSupportedOptypeVersionAndDomain(*node, "Gather", 1)) {
+      continue;
+    }
+
+    // the kernel only handles gathering whole table rows of floats
+    const auto& gather_attributes = node->GetAttributes();
+    auto axis_it = gather_attributes.find("axis");
+    if (axis_it != gather_attributes.end() && axis_it->second.i() != 0) {
+      continue;
+    }
+    const auto* data_type = node->InputDefs()[0]->Type();
+    if (data_type == nullptr || *data_type != "tensor(float)") {
+      continue;
+    }
+
+    // the bag axis is the innermost indices axis, so both ranks must be known
+    const auto* data_shape = node->InputDefs()[0]->Shape();
+    const auto* indices_shape = node->InputDefs()[1]->Shape();
+    if (data_shape == nullptr || indices_shape == nullptr || indices_shape->dim_size() < 1) {
+      continue;
+    }
+    const int64_t indices_rank = indices_shape->dim_size();
+    const int64_t gather_output_rank = indices_rank + data_shape->dim_size() - 1;
+
+    Node* reduce = SingleConsumer(graph, *node, "ReduceSum");
+    std::string mode = "sum";
+    if (reduce == nullptr) {
+      reduce = SingleConsumer(graph, *node, "ReduceMean");
+      mode = "mean";
+    }
+    int64_t keepdims = 1;
+    if (reduce == nullptr ||
+        !ReducesBagAxis(*reduce, indices_rank, gather_output_rank, keepdims)) {
+      continue;
+    }
+
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName("embed_bag_" + node->Name()), "EmbeddingBag",
+                                     "fused embedding bag rooted at " + node->Name(),
+                                     {node->MutableInputDefs()[0], node->MutableInputDefs()[1]},
+                                     reduce->MutableOutputDefs(),
+                                     nullptr, kMSDomain);
+    fused_node.AddAttribute("mode", mode);
+    fused_node.AddAttribute("keepdims", keepdims);
+
+    removed_nodes.push_back(node->Index());
+    removed_nodes.push_back(reduce->Index());
+  }
+
+  for (auto i : removed_nodes) {
+    graph.RemoveNode(i);
+  }
+
+  if (!removed_nodes.empty()) {
+    modified = true;
+    ONNXRUNTIME_RETURN_IF_ERROR(graph.Resolve());
+  }
+  return Status::OK();
+}
+}  // namespace onnxruntime
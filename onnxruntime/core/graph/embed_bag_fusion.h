@@ -0,0 +1,22 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/graph/graph_transformer.h"
+
+namespace onnxruntime {
+
+// Fuses the embedding-bag pattern recommendation models emit — Gather over a
+// large table followed by ReduceSum/ReduceMean over the gathered axis — into
+// one EmbeddingBag node, so the rows accumulate straight from the table
+// without materializing the batch x bag x dim intermediate.
+class EmbedBagFusion : public onnxruntime::GraphTransformer {
+ public:
+  EmbedBagFusion() noexcept
+      : onnxruntime::GraphTransformer("EmbedBagFusion",
+                                      "Fusing Gather followed by a bag-axis ReduceSum/ReduceMean into EmbeddingBag") {}
+  Status Apply(onnxruntime::Graph& graph, bool& modified) const override;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,89 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/graph/gemm_activation_fusion.h"
+#include "core/graph/graph_utils.h"
+#include "core/graph/graph_viewer.h"
+
+using namespace onnx;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+bool IsFusableActivation(const Node& node) {
+  return utils::IsSupportedOptypeVersionAndDomain(node, "LeakyRelu", 6) || utils::IsSupportedOptypeVersionAndDomain(node, "Relu", 6) || utils::IsSupportedOptypeVersionAndDomain(node, "Sigmoid", 6) || utils::IsSupportedOptypeVersionAndDomain(node, "Tanh", 6);
+}
+}  // namespace
+
+Status GemmActivationFusion::Apply(Graph& graph, bool& modified) const {
+  GraphViewer graph_viewer(graph);
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder();
+
+  std::vector<onnxruntime::NodeIndex> removed_nodes;
+  for (auto index : order) {
+    auto node = graph.GetNode(index);
+    if ((!utils::IsSupportedOptypeVersionAndDomain(*node, "Gemm", 7) &&
+         !utils::IsSupportedOptypeVersionAndDomain(*node, "Gemm", 9)) ||
+        node->GetOutputEdgesCount() != 1) {
+      continue;
+    }
+    const Node& next_node = *(node->OutputNodesBegin());
+    if (!IsFusableActivation(next_node) || graph.IsNodeOutputsInGraphOutputs(next_node)) {
+      continue;
+    }
+
+    Node* gemm_node = node;
+    const Node& act_node = next_node;
+
+    Node& fused_gemm = graph.AddNode(graph.GenerateNodeName("fused " + gemm_node->Name()), "FusedGemm",
+                                     "fused Gemm " + gemm_node->Name() + "with activation " + act_node.OpType(),
+                                     gemm_node->MutableInputDefs(),
+                                     gemm_node->MutableOutputDefs(),
+                                     &gemm_node->GetAttributes(),
+                                     "com.microsoft");
+
+    //Add a new attribute to specify the activation type
+    fused_gemm.AddAttribute("activation", act_node.OpType());
+
+    //LeakyRelu's alpha is stored under a different name because Gemm already
+    //has an alpha attribute of its own
+    if (act_node.OpType() == "LeakyRelu") {
+      const NodeAttributes& attrs = act_node.GetAttributes();
+      auto it = attrs.find("alpha");
+      if (it != attrs.end()) {
+        fused_gemm.AddAttribute("leaky_relu_alpha", it->second.f());
+      }
+    }
+
+    // Replace the input of the node following activation node
+    const NodeArg* act_output_def = act_node.OutputDefs()[0];
+    NodeArg* fused_gemm_output_def = fused_gemm.MutableOutputDefs()[0];
+    for (auto it = act_node.OutputNodesBegin(); it != act_node.OutputNodesEnd(); ++it) {
+      auto output_node = graph.GetNode((*it).Index());
+      if (!output_node) {
+        return Status(ONNXRUNTIME, INVALID_ARGUMENT);
+      }
+
+      auto& input_defs = output_node->MutableInputDefs();
+      for (auto& def : input_defs) {
+        if (def == act_output_def) {
+          def = fused_gemm_output_def;
+        }
+      }
+    }
+
+    removed_nodes.push_back(act_node.Index());
+    removed_nodes.push_back(gemm_node->Index());
+  }
+
+  for (auto i : removed_nodes) {
+    graph.RemoveNode(i);
+  }
+
+  if (!removed_nodes.empty()) {
+    modified = true;
+    ONNXRUNTIME_RETURN_IF_ERROR(graph.Resolve());
+  }
+  return Status::OK();
+}
+}  // namespace onnxruntime
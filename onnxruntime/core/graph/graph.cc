@@ -17,6 +17,7 @@
 #include "core/graph/graph_viewer.h"
 #include "core/graph/indexed_sub_graph.h"
 #include "core/graph/op.h"
+#include "core/graph/shape_functions.h"
 #include "core/common/logging/logging.h"
 #include "onnx/checker.h"
 #include "core/graph/schema_registry.h"
@@ -383,14 +384,14 @@ void Node::Init(const std::string& name,
 
 Node::Definitions& Node::MutableDefinitions() noexcept {
   // someone fetching these is going to change something
-  graph_->SetGraphResolveNeeded();
+  graph_->SetGraphResolveNeeded(*this);
   graph_->SetGraphProtoSyncNeeded();
   return definitions_;
 }
 
 Node::Relationships& Node::MutableRelationships() noexcept {
   // someone fetching these is going to change something
-  graph_->SetGraphResolveNeeded();
+  graph_->SetGraphResolveNeeded(*this);
   graph_->SetGraphProtoSyncNeeded();
   return relationships_;
 }
@@ -407,14 +408,14 @@ void Node::CreateSubgraph(const std::string& attr_name) {
 }
 
 void Node::AddAttribute(const std::string& attr_name, const AttributeProto& value) {
-  graph_->SetGraphResolveNeeded();
+  graph_->SetGraphResolveNeeded(*this);
   graph_->SetGraphProtoSyncNeeded();
   attributes_[attr_name] = value;
 }
 
 #define ADD_BASIC_ATTR_IMPL(type, enumType, field)                           \
   void Node::AddAttribute(const std::string& attr_name, const type& value) { \
-    graph_->SetGraphResolveNeeded();                                         \
+    graph_->SetGraphResolveNeeded(*this);                                         \
     graph_->SetGraphProtoSyncNeeded();                                       \
     AttributeProto a;                                                        \
     a.set_name(attr_name);                                                   \
@@ -425,7 +426,7 @@ void Node::AddAttribute(const std::string& attr_name, const AttributeProto& valu
 
 #define ADD_ATTR_IMPL(type, enumType, field)                                 \
   void Node::AddAttribute(const std::string& attr_name, const type& value) { \
-    graph_->SetGraphResolveNeeded();                                         \
+    graph_->SetGraphResolveNeeded(*this);                                         \
     graph_->SetGraphProtoSyncNeeded();                                       \
     AttributeProto a;                                                        \
     a.set_name(attr_name);                                                   \
@@ -437,7 +438,7 @@ void Node::AddAttribute(const std::string& attr_name, const AttributeProto& valu
 #define ADD_LIST_ATTR_IMPL(type, enumType, field)            \
   void Node::AddAttribute(const std::string& attr_name,      \
                           const std::vector<type>& values) { \
-    graph_->SetGraphResolveNeeded();                         \
+    graph_->SetGraphResolveNeeded(*this);                         \
     graph_->SetGraphProtoSyncNeeded();                       \
     AttributeProto a;                                        \
     a.set_name(attr_name);                                   \
@@ -449,7 +450,7 @@ void Node::AddAttribute(const std::string& attr_name, const AttributeProto& valu
   };
 
 void Node::AddAttribute(const std::string& attr_name, const GraphProto& value) {
-  graph_->SetGraphResolveNeeded();
+  graph_->SetGraphResolveNeeded(*this);
   graph_->SetGraphProtoSyncNeeded();
   AttributeProto a;
   a.set_name(attr_name);
@@ -471,7 +472,7 @@ ADD_LIST_ATTR_IMPL(TensorProto, AttributeProto_AttributeType::AttributeProto_Att
 ADD_LIST_ATTR_IMPL(GraphProto, AttributeProto_AttributeType::AttributeProto_AttributeType_GRAPHS, graphs)
 
 bool Node::ClearAttribute(const std::string& attr_name) {
-  graph_->SetGraphResolveNeeded();
+  graph_->SetGraphResolveNeeded(*this);
   graph_->SetGraphProtoSyncNeeded();
   return attributes_.erase(attr_name) > 0;
 }
@@ -524,7 +525,7 @@ Status Node::UpdateInputArgCount() {
     // of the operator.
     input_arg_count.push_back(arg_count_left);
 
-    graph_->SetGraphResolveNeeded();
+    graph_->SetGraphResolveNeeded(*this);
     graph_->SetGraphProtoSyncNeeded();
   }
 
@@ -1234,12 +1235,75 @@ class InferenceContextImpl : public ONNX_NAMESPACE::InferenceContext {
   }
 
   void RunInferencing() {
+    // a registered proto-free shape function covers the node when every
+    // input shape is fully known, skipping the schema inference machinery
+    if (TryRunRegisteredShapeFunction()) {
+      return;
+    }
     auto schema = node_.Op();
     if (nullptr != schema) {
       schema->GetTypeAndShapeInferenceFunction()(*this);
     }
   }
 
+  // Computes the node's output types with the op's registered shape function
+  // (see core/graph/shape_functions.h), reading and writing plain int64 dims
+  // instead of running the ONNX schema inference over TensorShapeProto.
+  // Returns false - falling back to the schema path - when no function is
+  // registered, an input shape is missing or symbolic, or the function
+  // rejects the inputs (the schema path then reports its usual error).
+  bool TryRunRegisteredShapeFunction() {
+    auto shape_function = shape_functions::Find(node_.OpType(), node_.Domain());
+    if (shape_function == nullptr) {
+      return false;
+    }
+
+    const auto& input_defs = node_.InputDefs();
+    std::vector<std::vector<int64_t>> input_shapes;
+    input_shapes.reserve(input_defs.size());
+    ONNX_NAMESPACE::TensorProto_DataType elem_type = ONNX_NAMESPACE::TensorProto_DataType_UNDEFINED;
+    for (const auto* input_def : input_defs) {
+      if (input_def == nullptr || !input_def->Exists()) {
+        return false;
+      }
+      const TypeProto* type = input_def->TypeAsProto();
+      if (type == nullptr || !type->has_tensor_type() || !type->tensor_type().has_shape()) {
+        return false;
+      }
+      std::vector<int64_t> dims;
+      dims.reserve(type->tensor_type().shape().dim_size());
+      for (const auto& dim : type->tensor_type().shape().dim()) {
+        if (!dim.has_dim_value()) {
+          return false;
+        }
+        dims.push_back(dim.dim_value());
+      }
+      if (elem_type == ONNX_NAMESPACE::TensorProto_DataType_UNDEFINED) {
+        elem_type = type->tensor_type().elem_type();
+      }
+      input_shapes.push_back(std::move(dims));
+    }
+    if (elem_type == ONNX_NAMESPACE::TensorProto_DataType_UNDEFINED) {
+      return false;
+    }
+
+    std::vector<std::vector<int64_t>> output_shapes;
+    if (!shape_function(input_shapes, node_.GetAttributes(), output_shapes).IsOK() ||
+        output_shapes.size() != node_output_types_.size()) {
+      return false;
+    }
+
+    for (size_t i = 0; i < output_shapes.size(); ++i) {
+      auto* tensor_type = node_output_types_[i].mutable_tensor_type();
+      tensor_type->set_elem_type(elem_type);
+      auto* shape = tensor_type->mutable_shape();
+      for (int64_t dim : output_shapes[i]) {
+        shape->add_dim()->set_dim_value(dim);
+      }
+    }
+    return true;
+  }
+
   const std::vector<TypeProto> InferredOutputTypes() const { return node_output_types_; }
 
   const AttributeProto* getAttribute(const std::string& name) const override {
@@ -1364,7 +1428,9 @@ Status Graph::InferAndVerifySubgraphTypes(const Node& node, Graph& subgraph,
   }
 
   // now that we have handled the input types, do the type/shape inferencing for the subgraph
-  // to flow the type/shape info through it
+  // to flow the type/shape info through it. the input updates above are applied directly to
+  // NodeArgs without node-level dirty marks, so the subgraph always re-verifies in full.
+  subgraph.reverify_all_nodes_ = true;
   status = subgraph.PerformTypeAndShapeInferencing();
   ONNXRUNTIME_RETURN_IF_ERROR(status);
 
@@ -1623,10 +1689,52 @@ Status Graph::VerifyNodeAndOpMatch() {
   lsc.output_names.insert(resolve_context_.outer_scope_node_args.cbegin(),
                           resolve_context_.outer_scope_node_args.cend());
 
+  // When every change since the last resolve was scoped to specific nodes, the
+  // expensive per-node work below (proto round trip, ONNX checker, type and
+  // shape inferencing) only needs to cover those nodes and everything
+  // downstream of them: inferred types flow forwards, so untouched upstream
+  // nodes cannot be affected.
+  std::unordered_set<NodeIndex> nodes_to_process;
+  if (!reverify_all_nodes_) {
+    std::stack<NodeIndex> to_visit;
+    for (auto index : nodes_to_reverify_) {
+      to_visit.push(index);
+    }
+
+    while (!to_visit.empty()) {
+      const NodeIndex current = to_visit.top();
+      to_visit.pop();
+
+      if (!nodes_to_process.insert(current).second) {
+        continue;
+      }
+
+      const Node* current_node = GetNode(current);
+      if (current_node == nullptr) {
+        continue;
+      }
+
+      for (auto it = current_node->OutputEdgesBegin(), end = current_node->OutputEdgesEnd(); it != end; ++it) {
+        to_visit.push((*it).GetNode().Index());
+      }
+    }
+  }
+
   for (auto node_index : nodes_in_topological_order_) {
     // Node verification.
     auto& node = *GetNode(node_index);
 
+    if (!reverify_all_nodes_ && node.Op() != nullptr && nodes_to_process.count(node_index) == 0) {
+      // verified by an earlier resolve and unaffected by the recorded changes;
+      // only its output names are needed for downstream lexical scoping.
+      for (const auto* output_def : node.OutputDefs()) {
+        if (output_def->Exists()) {
+          lsc.output_names.insert(output_def->Name());
+        }
+      }
+      continue;
+    }
+
     NodeProto node_proto;
     node.ToProto(node_proto);
     auto& node_name = node.Name();
@@ -1739,6 +1847,14 @@ Status Graph::VerifyInputAndInitializerNames() {
 }
 
 Status Graph::InitInputsInitializersOutputs() {
+  // snapshot the dirt recorded since the last resolve before the resolve
+  // machinery below touches any nodes, then reset the live set so the marks
+  // made while rebuilding relationships don't widen this resolve's scope.
+  reverify_all_nodes_ = resolve_all_nodes_;
+  nodes_to_reverify_ = std::move(dirty_node_indices_);
+  resolve_all_nodes_ = false;
+  dirty_node_indices_.clear();
+
   resolve_context_.Clear();
 
   // clear the previous relationships, as we re-create them when resolving.
@@ -1848,6 +1964,11 @@ Status Graph::Resolve(bool no_proto_sync_required) {
             graph.CleanUnusedInitializers();
             graph.GraphResolveNeeded(false);
 
+            // everything is verified now, so marks made during the resolve
+            // itself (edge rebuilding etc.) are no longer relevant.
+            graph.resolve_all_nodes_ = false;
+            graph.dirty_node_indices_.clear();
+
             // if we are resolving immediately after loading from a GraphProto, we don't need to
             // do a proto sync
             if (no_proto_sync_required) {
@@ -2197,6 +2318,43 @@ void Graph::CleanUnusedInitializers() {
                 [this](const std::string& name) { name_to_initial_tensor_.erase(name); });
 }
 
+Status Graph::ReplaceGraphOutput(const std::string& output_name,
+                                 const std::vector<const NodeArg*>& replacements) {
+  auto* outputs = graph_proto_->mutable_output();
+
+  int existing = -1;
+  for (int i = 0; i < outputs->size(); ++i) {
+    if (outputs->Get(i).name() == output_name) {
+      existing = i;
+      break;
+    }
+  }
+
+  if (existing < 0) {
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, NOT_FOUND, "Graph output (", output_name, ") was not found.");
+  }
+
+  // rebuild the output list with the replacements spliced in at the position
+  // of the entry being replaced, so the surrounding output order is kept.
+  ::google::protobuf::RepeatedPtrField<ValueInfoProto> new_outputs;
+
+  for (int i = 0; i < outputs->size(); ++i) {
+    if (i == existing) {
+      for (const auto* replacement : replacements) {
+        *new_outputs.Add() = replacement->ToProto();
+      }
+    } else {
+      *new_outputs.Add() = outputs->Get(i);
+    }
+  }
+
+  outputs->Swap(&new_outputs);
+
+  SetGraphResolveNeeded();
+
+  return Status::OK();
+}
+
 GSL_SUPPRESS(es .84)  // warning about ignoring return value from insert(...)
 Status Graph::SetGraphInputsOutputs() {
   // Reset graph inputs/outputs/value info state.
@@ -2429,6 +2587,9 @@ gsl::not_null<Node*> Graph::AllocateNode() {
   nodes_.push_back(std::move(new_node));
   ++num_of_nodes_;
   graph_resolve_needed_ = true;
+  if (!resolve_all_nodes_) {
+    dirty_node_indices_.insert(node->Index());
+  }
 
   return gsl::not_null<Node*>{node};
 }
@@ -2445,6 +2606,12 @@ bool Graph::ReleaseNode(NodeIndex index) {
     --num_of_nodes_;
     graph_proto_sync_needed_ = true;
     graph_resolve_needed_ = true;
+    // the removal itself only affects the neighbours, which were marked when
+    // their edges to this node were removed. record the index anyway so a
+    // stale entry never widens what the next resolve re-verifies.
+    if (!resolve_all_nodes_) {
+      dirty_node_indices_.insert(index);
+    }
   }
 
   return true;
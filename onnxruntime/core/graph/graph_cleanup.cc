@@ -0,0 +1,135 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/graph/graph_cleanup.h"
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "core/graph/graph_viewer.h"
+
+using namespace onnx;
+using namespace ::onnxruntime::common;
+
+namespace onnxruntime {
+
+namespace {
+
+// Removes nodes that cannot reach a graph output. A reverse sweep over the
+// topological order marks a node live when any of its outputs is a graph
+// output or feeds an already-live node; everything else is unreachable.
+Status RemoveDeadNodes(Graph& graph, bool& modified) {
+  std::unordered_set<std::string> live_names;
+  for (const NodeArg* output : graph.GetOutputs()) {
+    live_names.insert(output->Name());
+  }
+
+  GraphViewer graph_viewer(graph);
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder();
+
+  std::vector<NodeIndex> dead_nodes;
+  for (auto it = order.rbegin(); it != order.rend(); ++it) {
+    Node* node = graph.GetNode(*it);
+    if (node == nullptr) continue;
+
+    bool live = false;
+    for (const NodeArg* def : node->OutputDefs()) {
+      if (def->Exists() && live_names.count(def->Name()) > 0) {
+        live = true;
+        break;
+      }
+    }
+
+    if (!live) {
+      dead_nodes.push_back(node->Index());
+      continue;
+    }
+
+    for (const NodeArg* def : node->InputDefs()) {
+      if (def->Exists()) live_names.insert(def->Name());
+    }
+    // implicit inputs keep alive the values a nested subgraph captures
+    for (const NodeArg* def : node->ImplicitInputDefs()) {
+      if (def->Exists()) live_names.insert(def->Name());
+    }
+  }
+
+  for (NodeIndex index : dead_nodes) {
+    graph.RemoveNode(index);
+  }
+
+  modified = modified || !dead_nodes.empty();
+  return Status::OK();
+}
+
+// Collapses initializers carrying identical payloads onto one tensor. The
+// content key is the serialized TensorProto with the name cleared, which
+// covers data type, dims and every data encoding in one comparison.
+Status DeduplicateInitializers(Graph& graph, bool& modified) {
+  std::unordered_set<std::string> exempt_names;
+  for (const NodeArg* input : graph.GetInputsIncludingInitializers()) {
+    exempt_names.insert(input->Name());
+  }
+  for (const NodeArg* output : graph.GetOutputs()) {
+    exempt_names.insert(output->Name());
+  }
+  // a subgraph refers to captured values by their outer-scope name, so an
+  // initializer consumed through an implicit input cannot be renamed here.
+  for (const auto& node : graph.Nodes()) {
+    for (const NodeArg* def : node.ImplicitInputDefs()) {
+      exempt_names.insert(def->Name());
+    }
+  }
+
+  std::unordered_map<std::string, std::string> payload_to_name;
+  std::unordered_map<std::string, std::string> rename;  // duplicate -> canonical
+
+  for (const auto& pv : graph.GetAllInitializedTensors()) {
+    const std::string& name = pv.first;
+    if (exempt_names.count(name) > 0) continue;
+
+    ONNX_NAMESPACE::TensorProto content(*pv.second);
+    content.clear_name();
+    auto result = payload_to_name.insert({content.SerializeAsString(), name});
+    if (!result.second) {
+      rename.insert({name, result.first->second});
+    }
+  }
+
+  if (rename.empty()) return Status::OK();
+
+  for (auto& node : graph.Nodes()) {
+    for (auto& def : node.MutableInputDefs()) {
+      auto hit = rename.find(def->Name());
+      if (hit != rename.end()) {
+        NodeArg* canonical = graph.GetNodeArg(hit->second);
+        ONNXRUNTIME_ENFORCE(canonical != nullptr, "Missing NodeArg for initializer ", hit->second);
+        def = canonical;
+      }
+    }
+  }
+
+  for (const auto& pv : rename) {
+    graph.RemoveInitializedTensor(pv.first);
+  }
+
+  modified = true;
+  return Status::OK();
+}
+
+}  // namespace
+
+Status GraphCleanup::Apply(onnxruntime::Graph& graph, bool& modified) const {
+  bool cleaned = false;
+  ONNXRUNTIME_RETURN_IF_ERROR(RemoveDeadNodes(graph, cleaned));
+  ONNXRUNTIME_RETURN_IF_ERROR(DeduplicateInitializers(graph, cleaned));
+
+  if (cleaned) {
+    modified = true;
+    ONNXRUNTIME_RETURN_IF_ERROR(graph.Resolve());
+  }
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
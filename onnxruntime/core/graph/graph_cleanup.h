@@ -0,0 +1,20 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/graph/graph_transformer.h"
+
+namespace onnxruntime {
+
+// Load-time cleanup of exported models: removes nodes whose outputs cannot
+// reach a graph output, and collapses initializers with identical payloads
+// onto a single tensor. Initializers that are also graph inputs are left
+// alone since a caller may override them by name at Run time.
+class GraphCleanup : public onnxruntime::GraphTransformer {
+ public:
+  GraphCleanup() noexcept : onnxruntime::GraphTransformer("GraphCleanup", "Eliminate dead nodes and duplicate initializers") {}
+  Status Apply(onnxruntime::Graph& graph, bool& modified) const override;
+};
+
+}  // namespace onnxruntime
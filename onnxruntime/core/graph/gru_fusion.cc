@@ -0,0 +1,156 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/graph/gru_fusion.h"
+#include "core/graph/graph_utils.h"
+#include "core/graph/graph_viewer.h"
+
+#include <unordered_set>
+
+using namespace onnx;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+bool HasAttribute(const Node& node, const std::string& name) {
+  return node.GetAttributes().find(name) != node.GetAttributes().end();
+}
+
+int64_t LinearBeforeReset(const Node& node) {
+  const auto& attrs = node.GetAttributes();
+  auto it = attrs.find("linear_before_reset");
+  return it == attrs.end() ? 0 : it->second.i();
+}
+
+// A GRU node can be folded into a FusedGru stack if it is a single forward
+// layer using the default activations with no clipping, has a bias but no
+// sequence_lens or initial_h input, and produces the Y output.
+bool IsFusableGru(const Node& node) {
+  if (!utils::IsSupportedOptypeVersionAndDomain(node, "GRU", 7)) {
+    return false;
+  }
+
+  const auto& attrs = node.GetAttributes();
+  auto direction = attrs.find("direction");
+  if (direction != attrs.end() && direction->second.s() != "forward") {
+    return false;
+  }
+
+  if (HasAttribute(node, "activations") || HasAttribute(node, "activation_alpha") ||
+      HasAttribute(node, "activation_beta") || HasAttribute(node, "clip")) {
+    return false;
+  }
+
+  const auto& input_defs = node.InputDefs();
+  if (input_defs.size() < 4 || !input_defs[3]->Exists()) {  // B is required
+    return false;
+  }
+  if (input_defs.size() > 4 && input_defs[4]->Exists()) {  // no sequence_lens
+    return false;
+  }
+  if (input_defs.size() > 5 && input_defs[5]->Exists()) {  // no initial_h
+    return false;
+  }
+
+  const auto& output_defs = node.OutputDefs();
+  return !output_defs.empty() && output_defs[0]->Exists();
+}
+
+// stacked GRU layers are connected through a Squeeze that drops the
+// num_directions axis from Y before it becomes the next layer's X
+bool IsSqueezeOfAxis1(const Node& node) {
+  if (!utils::IsSupportedOptypeVersionAndDomain(node, "Squeeze", 1)) {
+    return false;
+  }
+
+  const auto& attrs = node.GetAttributes();
+  auto axes = attrs.find("axes");
+  return axes != attrs.end() && axes->second.ints_size() == 1 && axes->second.ints(0) == 1;
+}
+}  // namespace
+
+Status GruFusion::Apply(Graph& graph, bool& modified) const {
+  GraphViewer graph_viewer(graph);
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder();
+
+  std::unordered_set<NodeIndex> fused_nodes;
+  std::vector<onnxruntime::NodeIndex> removed_nodes;
+
+  for (auto index : order) {
+    auto node = graph.GetNode(index);
+    if (node == nullptr || fused_nodes.count(index) > 0 || !IsFusableGru(*node)) {
+      continue;
+    }
+
+    const int64_t linear_before_reset = LinearBeforeReset(*node);
+
+    std::vector<Node*> layers{node};
+    std::vector<Node*> squeezes;
+
+    // Grow the stack while Y is consumed only by a Squeeze of the
+    // num_directions axis feeding another fusable GRU, and Y_h is unused.
+    Node* last = node;
+    while (last->GetOutputEdgesCount() == 1 && !graph.IsNodeOutputsInGraphOutputs(*last)) {
+      Node* squeeze = graph.GetNode((*last->OutputNodesBegin()).Index());
+      if (squeeze == nullptr || !IsSqueezeOfAxis1(*squeeze) ||
+          squeeze->InputDefs()[0] != last->OutputDefs()[0] ||
+          squeeze->GetOutputEdgesCount() != 1 ||
+          graph.IsNodeOutputsInGraphOutputs(*squeeze)) {
+        break;
+      }
+
+      Node* next = graph.GetNode((*squeeze->OutputNodesBegin()).Index());
+      if (next == nullptr || !IsFusableGru(*next) ||
+          LinearBeforeReset(*next) != linear_before_reset ||
+          next->InputDefs()[0] != squeeze->OutputDefs()[0]) {
+        break;
+      }
+
+      squeezes.push_back(squeeze);
+      layers.push_back(next);
+      last = next;
+    }
+
+    // a single layer gains nothing from fusion
+    if (layers.size() < 2) {
+      continue;
+    }
+
+    std::vector<NodeArg*> fused_inputs{layers[0]->MutableInputDefs()[0]};
+    for (auto layer : layers) {
+      auto& layer_inputs = layer->MutableInputDefs();
+      fused_inputs.push_back(layer_inputs[1]);  // W
+      fused_inputs.push_back(layer_inputs[2]);  // R
+      fused_inputs.push_back(layer_inputs[3]);  // B
+    }
+
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName("fused " + node->Name()), "FusedGru",
+                                     "fused GRU stack starting at " + node->Name(),
+                                     fused_inputs,
+                                     last->MutableOutputDefs(),
+                                     nullptr,
+                                     "com.microsoft");
+    fused_node.AddAttribute("num_layers", static_cast<int64_t>(layers.size()));
+    fused_node.AddAttribute("linear_before_reset", linear_before_reset);
+
+    for (auto layer : layers) {
+      fused_nodes.insert(layer->Index());
+      removed_nodes.push_back(layer->Index());
+    }
+    for (auto squeeze : squeezes) {
+      fused_nodes.insert(squeeze->Index());
+      removed_nodes.push_back(squeeze->Index());
+    }
+  }
+
+  for (auto i : removed_nodes) {
+    graph.RemoveNode(i);
+  }
+
+  if (!removed_nodes.empty()) {
+    modified = true;
+    ONNXRUNTIME_RETURN_IF_ERROR(graph.Resolve());
+  }
+  return Status::OK();
+}
+}  // namespace onnxruntime
@@ -0,0 +1,16 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/graph/graph_transformer.h"
+
+namespace onnxruntime {
+
+class GruFusion : public onnxruntime::GraphTransformer {
+ public:
+  GruFusion() noexcept : onnxruntime::GraphTransformer("GruFusion", "Fusing stacks of GRU layers into FusedGru") {}
+  Status Apply(onnxruntime::Graph& graph, bool& modified) const override;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,160 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/graph/index_narrowing.h"
+
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+
+#include "core/graph/graph_utils.h"
+
+using namespace onnx;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+bool IsInt32Tensor(const NodeArg& node_arg) {
+  const ONNX_NAMESPACE::TypeProto* type = node_arg.TypeAsProto();
+  return type != nullptr && type->has_tensor_type() &&
+         type->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_INT32;
+}
+
+// Reads the values of an int64 initializer into values. Returns false when
+// the proto stores its data in a form other than raw_data or int64_data.
+bool ReadInt64Initializer(const ONNX_NAMESPACE::TensorProto& tensor_proto, std::vector<int64_t>& values) {
+  int64_t num_elements = 1;
+  for (int i = 0; i < tensor_proto.dims_size(); ++i) {
+    num_elements *= tensor_proto.dims(i);
+  }
+  values.clear();
+  values.reserve(num_elements);
+  if (tensor_proto.has_raw_data()) {
+    if (tensor_proto.raw_data().size() != static_cast<size_t>(num_elements) * sizeof(int64_t)) {
+      return false;
+    }
+    values.resize(num_elements);
+    std::memcpy(values.data(), tensor_proto.raw_data().data(), tensor_proto.raw_data().size());
+    return true;
+  }
+  if (tensor_proto.int64_data_size() != num_elements) {
+    return false;
+  }
+  values.assign(tensor_proto.int64_data().begin(), tensor_proto.int64_data().end());
+  return true;
+}
+
+bool AllFitInt32(const std::vector<int64_t>& values) {
+  for (const auto value : values) {
+    if (value < std::numeric_limits<int32_t>::min() || value > std::numeric_limits<int32_t>::max()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+Status IndexNarrowing::Apply(onnxruntime::Graph& graph, bool& modified) const {
+  std::vector<onnxruntime::NodeIndex> removed_nodes;
+  // int64 initializers already narrowed this pass, so Gathers sharing one
+  // indices tensor share the int32 copy.
+  std::unordered_map<std::string, NodeArg*> narrowed_initializers;
+
+  for (auto& node : graph.Nodes()) {
+    if (!utils::IsSupportedOptypeVersionAndDomain(node, "Gather", 1)) {
+      continue;
+    }
+
+    auto& gather_node = node;
+    const auto& gather_inputs = gather_node.InputDefs();
+    if (gather_inputs.size() < 2) {
+      continue;
+    }
+    const NodeArg* indices_arg = gather_inputs[1];
+
+    // case 1: the indices come through a Cast from int32, so the values fit
+    // by construction and the Gather can read the Cast's input directly.
+    const Node* producer = nullptr;
+    for (auto it = gather_node.InputNodesBegin(); it != gather_node.InputNodesEnd(); ++it) {
+      const Node& candidate = *it;
+      for (const auto* output_def : candidate.OutputDefs()) {
+        if (output_def->Name() == indices_arg->Name()) {
+          producer = &candidate;
+          break;
+        }
+      }
+    }
+    if (producer != nullptr &&
+        utils::IsSupportedOptypeVersionAndDomain(*producer, "Cast", 6) &&
+        producer->GetOutputEdgesCount() == 1 &&
+        !graph.IsNodeOutputsInGraphOutputs(*producer) &&
+        IsInt32Tensor(*producer->InputDefs()[0]) &&
+        gather_inputs[0]->Name() != indices_arg->Name()) {
+      const onnxruntime::NodeAttributes& cast_attributes = producer->GetAttributes();
+      auto to_attr = cast_attributes.find("to");
+      if (to_attr != cast_attributes.end() &&
+          to_attr->second.type() == AttributeProto_AttributeType_INT &&
+          to_attr->second.i() == ONNX_NAMESPACE::TensorProto_DataType_INT64) {
+        auto& mutable_cast_node = *graph.GetNode(producer->Index());
+        gather_node.MutableInputDefs()[1] = mutable_cast_node.MutableInputDefs()[0];
+        removed_nodes.push_back(mutable_cast_node.Index());
+        continue;
+      }
+    }
+
+    // case 2: constant indices; narrow the initializer when the values fit.
+    const ONNX_NAMESPACE::TensorProto* indices_tensor_proto = nullptr;
+    if (!graph.GetInitializedTensor(indices_arg->Name(), indices_tensor_proto) ||
+        indices_tensor_proto->data_type() != ONNX_NAMESPACE::TensorProto_DataType_INT64) {
+      continue;
+    }
+
+    auto narrowed_it = narrowed_initializers.find(indices_arg->Name());
+    if (narrowed_it == narrowed_initializers.end()) {
+      std::vector<int64_t> values;
+      if (!ReadInt64Initializer(*indices_tensor_proto, values) || !AllFitInt32(values)) {
+        continue;
+      }
+
+      // the original keeps its name: other, non-index consumers (and graphs
+      // feeding the initializer as an input) keep reading the int64 tensor.
+      const std::string narrowed_name = graph.GenerateNodeArgName(indices_arg->Name() + "_int32");
+      ONNX_NAMESPACE::TensorProto narrowed_tensor_proto;
+      narrowed_tensor_proto.set_name(narrowed_name);
+      narrowed_tensor_proto.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_INT32);
+      for (int i = 0; i < indices_tensor_proto->dims_size(); ++i) {
+        narrowed_tensor_proto.add_dims(indices_tensor_proto->dims(i));
+      }
+      for (const auto value : values) {
+        narrowed_tensor_proto.add_int32_data(static_cast<int32_t>(value));
+      }
+      graph.AddInitializedTensor(narrowed_tensor_proto);
+
+      ONNX_NAMESPACE::TypeProto narrowed_type;
+      narrowed_type.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_INT32);
+      auto* narrowed_shape = narrowed_type.mutable_tensor_type()->mutable_shape();
+      for (int i = 0; i < indices_tensor_proto->dims_size(); ++i) {
+        narrowed_shape->add_dim()->set_dim_value(indices_tensor_proto->dims(i));
+      }
+      NodeArg& narrowed_arg = graph.GetOrCreateNodeArg(narrowed_name, &narrowed_type);
+      narrowed_it = narrowed_initializers.insert({indices_arg->Name(), &narrowed_arg}).first;
+    }
+
+    gather_node.MutableInputDefs()[1] = narrowed_it->second;
+    modified = true;
+  }
+
+  for (auto i : removed_nodes) {
+    graph.RemoveNode(i);
+  }
+
+  if (!removed_nodes.empty() || !narrowed_initializers.empty()) {
+    modified = true;
+    ONNXRUNTIME_RETURN_IF_ERROR(graph.Resolve());
+  }
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
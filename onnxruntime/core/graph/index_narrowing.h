@@ -0,0 +1,32 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/graph/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+  Narrows the int64 index dataflow feeding Gather to int32 where the values
+  provably fit. ONNX only specifies int64 indices, so exported graphs carry
+  int32 -> int64 Casts in front of every Gather and 8-byte index tensors;
+  the Gather kernel itself accepts both index widths. Two rewrites apply:
+
+  - a Cast to int64 whose int32 output of a producer feeds only a Gather
+    indices input is dropped and the Gather reads the int32 values directly;
+  - an int64 indices initializer whose values all fit in int32 is replaced
+    by an int32 copy.
+
+  Both halve the memory traffic on the index path, which adds up in
+  embedding-heavy models where Gather dominates.
+*/
+class IndexNarrowing : public onnxruntime::GraphTransformer {
+ public:
+  IndexNarrowing() noexcept
+      : onnxruntime::GraphTransformer("IndexNarrowing",
+                                      "Narrowing int64 index dataflow feeding Gather to int32") {}
+  Status Apply(onnxruntime::Graph& graph, bool& modified) const override;
+};
+
+}  // namespace onnxruntime
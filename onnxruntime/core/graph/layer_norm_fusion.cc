@@ -0,0 +1,179 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/graph/layer_norm_fusion.h"
+#include "core/graph/graph_utils.h"
+#include "core/graph/graph_viewer.h"
+#include "core/graph/initializer.h"
+
+using namespace onnx;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+// The single consumer of node's output when it has the given op type; nullptr
+// when the output fans out, feeds a graph output, or the consumer differs.
+Node* SingleConsumer(Graph& graph, const Node& node, const std::string& op_type) {
+  if (node.GetOutputEdgesCount() != 1 || graph.IsNodeOutputsInGraphOutputs(node)) {
+    return nullptr;
+  }
+  Node* consumer = graph.GetNode((*node.OutputNodesBegin()).Index());
+  if (consumer == nullptr || consumer->OpType() != op_type) {
+    return nullptr;
+  }
+  return consumer;
+}
+
+// Reads a scalar float initializer; false when def is not a constant scalar.
+bool GetScalarInitializer(const Graph& graph, const NodeArg* def, float& value) {
+  const ONNX_NAMESPACE::TensorProto* tensor_proto = nullptr;
+  graph.GetInitializedTensor(def->Name(), tensor_proto);
+  if (tensor_proto == nullptr ||
+      tensor_proto->data_type() != ONNX_NAMESPACE::TensorProto_DataType_FLOAT) {
+    return false;
+  }
+  Initializer initializer{tensor_proto};
+  if (initializer.size() != 1) {
+    return false;
+  }
+  value = *initializer.data<float>();
+  return true;
+}
+
+// True when the ReduceMean keeps dims and reduces exactly the last axis of
+// its input, which makes the normalized span the trailing dimension.
+bool ReducesLastAxisKeepingDims(const Node& node, int64_t& axis) {
+  const auto& attributes = node.GetAttributes();
+  auto keepdims_it = attributes.find("keepdims");
+  if (keepdims_it != attributes.end() && keepdims_it->second.i() != 1) {
+    return false;
+  }
+  auto axes_it = attributes.find("axes");
+  if (axes_it == attributes.end() || axes_it->second.ints_size() != 1) {
+    return false;
+  }
+  axis = axes_it->second.ints(0);
+  const auto* shape = node.InputDefs()[0]->Shape();
+  const int64_t rank = shape != nullptr ? shape->dim_size() : 0;
+  return axis == -1 || (rank > 0 && axis == rank - 1);
+}
+}  // namespace
+
+Status LayerNormFusion::Apply(Graph& graph, bool& modified) const {
+  GraphViewer graph_viewer(graph);
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder();
+
+  std::vector<onnxruntime::NodeIndex> removed_nodes;
+  for (auto index : order) {
+    auto node = graph.GetNode(index);
+    int64_t axis = 0;
+    if (node == nullptr ||
+        !utils::IsSupportedOptypeVersionAndDomain(*node, "ReduceMean", 1) ||
+        !ReducesLastAxisKeepingDims(*node, axis)) {
+      continue;
+    }
+
+    // mean = ReduceMean(X); d = Sub(X, mean)
+    Node* sub = SingleConsumer(graph, *node, "Sub");
+    if (sub == nullptr ||
+        sub->InputDefs()[0] != node->InputDefs()[0] ||
+        sub->InputDefs()[1] != node->OutputDefs()[0]) {
+      continue;
+    }
+
+    // the centered difference feeds both the variance branch (Pow) and the
+    // final division
+    if (sub->GetOutputEdgesCount() != 2 || graph.IsNodeOutputsInGraphOutputs(*sub)) {
+      continue;
+    }
+    Node* pow_node = nullptr;
+    Node* div = nullptr;
+    for (auto it = sub->OutputNodesBegin(); it != sub->OutputNodesEnd(); ++it) {
+      Node* consumer = graph.GetNode((*it).Index());
+      if (consumer->OpType() == "Pow") {
+        pow_node = consumer;
+      } else if (consumer->OpType() == "Div") {
+        div = consumer;
+      }
+    }
+    if (pow_node == nullptr || div == nullptr) {
+      continue;
+    }
+
+    // var = ReduceMean(Pow(d, 2)) over the same axis
+    float exponent = 0.0f;
+    if (pow_node->InputDefs()[0] != sub->OutputDefs()[0] ||
+        !GetScalarInitializer(graph, pow_node->InputDefs()[1], exponent) ||
+        exponent != 2.0f) {
+      continue;
+    }
+    Node* reduce_var = SingleConsumer(graph, *pow_node, "ReduceMean");
+    int64_t var_axis = 0;
+    if (reduce_var == nullptr ||
+        !ReducesLastAxisKeepingDims(*reduce_var, var_axis) ||
+        var_axis != axis) {
+      continue;
+    }
+
+    // y = Div(d, Sqrt(Add(var, epsilon))) * scale + bias
+    Node* add_eps = SingleConsumer(graph, *reduce_var, "Add");
+    if (add_eps == nullptr) {
+      continue;
+    }
+    const NodeArg* eps_def = add_eps->InputDefs()[0] == reduce_var->OutputDefs()[0]
+                                 ? add_eps->InputDefs()[1]
+                                 : add_eps->InputDefs()[0];
+    float epsilon = 0.0f;
+    if (!GetScalarInitializer(graph, eps_def, epsilon)) {
+      continue;
+    }
+
+    Node* sqrt_node = SingleConsumer(graph, *add_eps, "Sqrt");
+    if (sqrt_node == nullptr || SingleConsumer(graph, *sqrt_node, "Div") != div ||
+        div->InputDefs()[0] != sub->OutputDefs()[0] ||
+        div->InputDefs()[1] != sqrt_node->OutputDefs()[0]) {
+      continue;
+    }
+
+    Node* mul = SingleConsumer(graph, *div, "Mul");
+    if (mul == nullptr) {
+      continue;
+    }
+    NodeArg* scale_def = mul->MutableInputDefs()[mul->InputDefs()[0] == div->OutputDefs()[0] ? 1 : 0];
+
+    Node* add_bias = SingleConsumer(graph, *mul, "Add");
+    if (add_bias == nullptr) {
+      continue;
+    }
+    NodeArg* bias_def = add_bias->MutableInputDefs()[add_bias->InputDefs()[0] == mul->OutputDefs()[0] ? 1 : 0];
+
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName("layer_norm_" + node->Name()), "LayerNormalization",
+                                     "fused layer normalization subgraph rooted at " + node->Name(),
+                                     {node->MutableInputDefs()[0], scale_def, bias_def},
+                                     add_bias->MutableOutputDefs(),
+                                     nullptr, kMSDomain);
+    fused_node.AddAttribute("axis", axis);
+    fused_node.AddAttribute("epsilon", epsilon);
+
+    removed_nodes.push_back(node->Index());
+    removed_nodes.push_back(sub->Index());
+    removed_nodes.push_back(pow_node->Index());
+    removed_nodes.push_back(reduce_var->Index());
+    removed_nodes.push_back(add_eps->Index());
+    removed_nodes.push_back(sqrt_node->Index());
+    removed_nodes.push_back(div->Index());
+    removed_nodes.push_back(mul->Index());
+    removed_nodes.push_back(add_bias->Index());
+  }
+
+  for (auto i : removed_nodes) {
+    graph.RemoveNode(i);
+  }
+
+  if (!removed_nodes.empty()) {
+    modified = true;
+    ONNXRUNTIME_RETURN_IF_ERROR(graph.Resolve());
+  }
+  return Status::OK();
+}
+}  // namespace onnxruntime
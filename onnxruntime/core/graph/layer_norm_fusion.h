@@ -0,0 +1,22 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/graph/graph_transformer.h"
+
+namespace onnxruntime {
+
+// Fuses the primitive layer-normalization cluster transformer models emit —
+// ReduceMean, Sub, Pow, ReduceMean, Add(epsilon), Sqrt, Div, Mul(scale),
+// Add(bias) — into one LayerNormalization node, so the statistics and the
+// scale/bias epilogue run in a single kernel without intermediate tensors.
+class LayerNormFusion : public onnxruntime::GraphTransformer {
+ public:
+  LayerNormFusion() noexcept
+      : onnxruntime::GraphTransformer("LayerNormFusion",
+                                      "Fusing the primitive layer normalization subgraph into LayerNormalization") {}
+  Status Apply(onnxruntime::Graph& graph, bool& modified) const override;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,82 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/graph/matmul_add_fusion.h"
+#include "core/graph/graph_utils.h"
+#include "core/graph/graph_viewer.h"
+
+using namespace onnx;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+// Gemm only supports 2-D A and B, and a bias that is unidirectionally
+// broadcastable to (M, N). Anything without a static rank stays unfused.
+bool IsRankedWithRankAtMost(const NodeArg& node_arg, int max_rank) {
+  auto shape = node_arg.Shape();
+  return shape != nullptr && shape->dim_size() <= max_rank;
+}
+}  // namespace
+
+Status MatMulAddFusion::Apply(Graph& graph, bool& modified) const {
+  GraphViewer graph_viewer(graph);
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder();
+
+  std::vector<onnxruntime::NodeIndex> removed_nodes;
+  for (auto index : order) {
+    auto node = graph.GetNode(index);
+    if ((!utils::IsSupportedOptypeVersionAndDomain(*node, "MatMul", 1) &&
+         !utils::IsSupportedOptypeVersionAndDomain(*node, "MatMul", 9)) ||
+        node->GetOutputEdgesCount() != 1 ||
+        graph.IsNodeOutputsInGraphOutputs(*node)) {
+      continue;
+    }
+
+    auto next_node = graph.GetNode((*node->OutputNodesBegin()).Index());
+    if (next_node == nullptr || !utils::IsSupportedOptypeVersionAndDomain(*next_node, "Add", 7)) {
+      continue;
+    }
+
+    Node* matmul_node = node;
+    Node& add_node = *next_node;
+
+    auto& matmul_input_defs = matmul_node->MutableInputDefs();
+    auto matmul_a = matmul_input_defs[0];
+    auto matmul_b = matmul_input_defs[1];
+    if (!IsRankedWithRankAtMost(*matmul_a, 2) || matmul_a->Shape()->dim_size() != 2 ||
+        !IsRankedWithRankAtMost(*matmul_b, 2) || matmul_b->Shape()->dim_size() != 2) {
+      continue;
+    }
+
+    // the Add input that is not the MatMul output becomes the Gemm bias
+    const NodeArg* matmul_output_def = matmul_node->OutputDefs()[0];
+    auto& add_input_defs = add_node.MutableInputDefs();
+    NodeArg* bias = add_input_defs[0] == matmul_output_def ? add_input_defs[1] : add_input_defs[0];
+    if (!IsRankedWithRankAtMost(*bias, 2)) {
+      continue;
+    }
+
+    Node& gemm_node = graph.AddNode(graph.GenerateNodeName("gemm_" + matmul_node->Name()), "Gemm",
+                                    "fused MatMul " + matmul_node->Name() + " with Add " + add_node.Name(),
+                                    {matmul_a, matmul_b, bias},
+                                    add_node.MutableOutputDefs());
+    gemm_node.AddAttribute("transA", static_cast<int64_t>(0));
+    gemm_node.AddAttribute("transB", static_cast<int64_t>(0));
+    gemm_node.AddAttribute("alpha", 1.0f);
+    gemm_node.AddAttribute("beta", 1.0f);
+
+    removed_nodes.push_back(matmul_node->Index());
+    removed_nodes.push_back(add_node.Index());
+  }
+
+  for (auto i : removed_nodes) {
+    graph.RemoveNode(i);
+  }
+
+  if (!removed_nodes.empty()) {
+    modified = true;
+    ONNXRUNTIME_RETURN_IF_ERROR(graph.Resolve());
+  }
+  return Status::OK();
+}
+}  // namespace onnxruntime
@@ -3,6 +3,10 @@
 
 #include "core/graph/model.h"
 #include <memory>
+#ifdef _WIN32
+#include <codecvt>
+#include <locale>
+#endif
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -13,6 +17,7 @@
 #ifdef _MSC_VER
 #pragma warning(pop)
 #endif
+#include <google/protobuf/arena.h>
 #include <google/protobuf/io/zero_copy_stream_impl.h>
 
 #include "gsl/pointers"
@@ -31,7 +36,8 @@ Model::Model(const std::string& graph_name,
              const IOnnxRuntimeOpSchemaRegistryList& local_registries,
              const std::unordered_map<std::string, int>& domain_to_version,
              const std::vector<ONNX_NAMESPACE::FunctionProto>& model_functions) {
-  model_proto_ = std::make_unique<ModelProto>();
+  owned_model_proto_ = std::make_unique<ModelProto>();
+  model_proto_ = owned_model_proto_.get();
   model_proto_->set_ir_version(ONNX_NAMESPACE::Version::IR_VERSION);
   model_proto_->mutable_graph()->set_name(graph_name);
   model_metadata_ = model_metadata;
@@ -80,17 +86,35 @@ Model::Model(std::unique_ptr<ModelProto> model_proto, const IOnnxRuntimeOpSchema
     throw std::invalid_argument("ModelProto was null.");
   }
 
-  if (!model_proto->has_graph()) {
+  owned_model_proto_ = std::move(model_proto);
+  model_proto_ = owned_model_proto_.get();
+  Init(local_registries);
+}
+
+Model::Model(ModelProto* model_proto, std::unique_ptr<google::protobuf::Arena> arena,
+             const IOnnxRuntimeOpSchemaRegistryList* local_registries) {
+  if (!model_proto) {
+    throw std::invalid_argument("ModelProto was null.");
+  }
+
+  arena_ = std::move(arena);
+  model_proto_ = model_proto;
+  Init(local_registries);
+}
+
+Model::~Model() = default;
+
+void Model::Init(const IOnnxRuntimeOpSchemaRegistryList* local_registries) {
+  if (!model_proto_->has_graph()) {
     throw std::invalid_argument("ModelProto does not have a graph.");
   }
 
-  if (model_proto->opset_import_size() == 0) {
+  if (model_proto_->opset_import_size() == 0) {
     throw std::invalid_argument(
         "Missing opset in the model. All ModelProtos MUST have at least one entry that"
         " specifies which version of the ONNX OperatorSet is being imported.");
   }
 
-  model_proto_.reset(std::move(model_proto.release()));
   for (auto& prop : model_proto_->metadata_props()) {
     model_metadata_[prop.key()] = prop.value();
   }
@@ -252,8 +276,53 @@ Status Model::Load(std::unique_ptr<ModelProto> p_model_proto, std::shared_ptr<Mo
   return Status::OK();
 }
 
+static std::string DirectoryOfFilePath(const std::string& file_path) {
+  const size_t pos = file_path.find_last_of("/\\");
+  return pos == std::string::npos ? std::string(".") : file_path.substr(0, pos);
+}
+
+#ifdef _WIN32
+static std::string DirectoryOfFilePath(const std::wstring& file_path) {
+  const size_t pos = file_path.find_last_of(L"/\\");
+  const std::wstring dir = pos == std::wstring::npos ? std::wstring(L".") : file_path.substr(0, pos);
+  return std::wstring_convert<std::codecvt_utf8<wchar_t>>().to_bytes(dir);
+}
+#endif
+
 template <typename T>
 static Status LoadModel(const T& file_path, std::shared_ptr<Model>& p_model, const IOnnxRuntimeOpSchemaRegistryList* local_registries) {
+  // Prefer parsing straight out of a file mapping: it avoids allocating and
+  // filling a read buffer for the whole model, and the OS can drop the pages
+  // once parsing is done. Fall back to the descriptor based path when the
+  // file cannot be mapped (or is too large for ParseFromArray).
+  {
+    const void* mapped_base = nullptr;
+    size_t mapped_length = 0;
+    if (Env::Default().MapFileIntoMemory(file_path, mapped_base, mapped_length).IsOK()) {
+      if (mapped_length <= static_cast<size_t>(INT_MAX)) {
+        Status status;
+        try {
+          status = Model::LoadFromBytes(static_cast<int>(mapped_length), const_cast<void*>(mapped_base),
+                                        p_model, local_registries);
+        } catch (std::exception& ex) {
+          GSL_SUPPRESS(es .84)
+          ONNXRUNTIME_IGNORE_RETURN_VALUE(Env::Default().UnmapFileFromMemory(mapped_base, mapped_length));
+          return Status(ONNXRUNTIME, FAIL, ex.what());
+        }
+        GSL_SUPPRESS(es .84)
+        ONNXRUNTIME_IGNORE_RETURN_VALUE(Env::Default().UnmapFileFromMemory(mapped_base, mapped_length));
+        if (status.IsOK()) {
+          // initializers with externally stored payloads resolve relative to the model file
+          p_model->MainGraph().SetModelFileDirectory(DirectoryOfFilePath(file_path));
+        }
+        return status;
+      }
+
+      GSL_SUPPRESS(es .84)
+      ONNXRUNTIME_IGNORE_RETURN_VALUE(Env::Default().UnmapFileFromMemory(mapped_base, mapped_length));
+    }
+  }
+
   int fd;
   Status status = Env::Default().FileOpenRd(file_path, fd);
   if (!status.IsOK()) {
@@ -280,6 +349,8 @@ static Status LoadModel(const T& file_path, std::shared_ptr<Model>& p_model, con
     ONNXRUNTIME_IGNORE_RETURN_VALUE(Env::Default().FileClose(fd));
     return status;
   }
+  // initializers with externally stored payloads resolve relative to the model file
+  p_model->MainGraph().SetModelFileDirectory(DirectoryOfFilePath(file_path));
   return Env::Default().FileClose(fd);
 }
 
@@ -327,13 +398,19 @@ Status Model::Save(Model& model, const std::string& file_path) {
 }
 
 Status Model::LoadFromBytes(int count, void* p_bytes, /*out*/ std::shared_ptr<Model>& p_model, const IOnnxRuntimeOpSchemaRegistryList* local_registries) {
-  std::unique_ptr<ModelProto> modelProto = std::make_unique<ModelProto>();
-  const bool result = modelProto->ParseFromArray(p_bytes, count);
+  // Parse into an arena owned by the model so the many small sub-messages a
+  // large ModelProto contains come out of a handful of arena blocks instead of
+  // individual heap allocations.
+  auto arena = std::make_unique<google::protobuf::Arena>();
+  const gsl::not_null<ModelProto*> model_proto{google::protobuf::Arena::CreateMessage<ModelProto>(arena.get())};
+  const bool result = model_proto->ParseFromArray(p_bytes, count);
   if (!result) {
     return Status(ONNXRUNTIME, INVALID_PROTOBUF, "Protobuf parsing failed.");
   }
 
-  p_model = std::make_shared<Model>(std::move(modelProto), local_registries);
+  // need to call private ctor so can't use make_shared
+  GSL_SUPPRESS(r .11)
+  p_model.reset(new Model(model_proto, std::move(arena), local_registries));
 
   ONNXRUNTIME_RETURN_IF_ERROR(p_model->MainGraph().Resolve(true));
 
@@ -355,7 +432,8 @@ Status Model::Load(int fd, std::shared_ptr<Model>& p_model, const IOnnxRuntimeOp
   // Allows protobuf library versions < 3.2.0 to parse messages greater than 64MB.
   coded_input->SetTotalBytesLimit(INT_MAX, INT_MAX);
 
-  std::unique_ptr<ModelProto> model_proto = std::make_unique<ModelProto>();
+  auto arena = std::make_unique<google::protobuf::Arena>();
+  const gsl::not_null<ModelProto*> model_proto{google::protobuf::Arena::CreateMessage<ModelProto>(arena.get())};
   const bool result = model_proto->ParseFromCodedStream(coded_input.get());
   coded_input.reset();
   raw_input.reset();
@@ -364,7 +442,9 @@ Status Model::Load(int fd, std::shared_ptr<Model>& p_model, const IOnnxRuntimeOp
     return Status(ONNXRUNTIME, INVALID_PROTOBUF, "Protobuf parsing failed.");
   }
 
-  p_model = std::make_shared<Model>(std::move(model_proto), local_registries);
+  // need to call private ctor so can't use make_shared
+  GSL_SUPPRESS(r .11)
+  p_model.reset(new Model(model_proto, std::move(arena), local_registries));
 
   ONNXRUNTIME_RETURN_IF_ERROR(p_model->MainGraph().Resolve(true));
 
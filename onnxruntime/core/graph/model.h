@@ -11,6 +11,12 @@
 
 #include "gsl/pointers"
 
+namespace google {
+namespace protobuf {
+class Arena;
+}
+}  // namespace google
+
 namespace onnxruntime {
 typedef std::unordered_map<std::string, std::string> ModelMetaData;
 using IOnnxRuntimeOpSchemaRegistryList = std::list<std::shared_ptr<IOnnxRuntimeOpSchemaCollection>>;
@@ -40,6 +46,8 @@ class Model {
   explicit Model(std::unique_ptr<ONNX_NAMESPACE::ModelProto> model_proto,
                  const IOnnxRuntimeOpSchemaRegistryList* local_registries = nullptr);
 
+  ~Model();
+
   // Get model's IR version.
   // Return <kNoVersion> if not specified.
   Version IrVersion() const;
@@ -118,8 +126,22 @@ class Model {
                              const IOnnxRuntimeOpSchemaRegistryList* local_registries = nullptr);
 
  private:
-  // Model data.
-  std::unique_ptr<ONNX_NAMESPACE::ModelProto> model_proto_;
+  // NOTE: after calling this constructor, <*this> model will own <arena>,
+  // which must be the arena <model_proto> was allocated on. Parsing into an
+  // arena batches the many small allocations a large ModelProto makes, so the
+  // deserialization paths (file/fd/bytes) construct models this way.
+  Model(ONNX_NAMESPACE::ModelProto* model_proto,
+        std::unique_ptr<google::protobuf::Arena> arena,
+        const IOnnxRuntimeOpSchemaRegistryList* local_registries);
+
+  // Shared portion of the ModelProto based constructors.
+  // Requires model_proto_ to be set.
+  void Init(const IOnnxRuntimeOpSchemaRegistryList* local_registries);
+
+  // Model data. Points into either <owned_model_proto_> or <arena_>.
+  ONNX_NAMESPACE::ModelProto* model_proto_{nullptr};
+  std::unique_ptr<ONNX_NAMESPACE::ModelProto> owned_model_proto_;
+  std::unique_ptr<google::protobuf::Arena> arena_;
 
   // This is a duplication of <model_proto_.metadata_props()>.
   // It gives better accessibility.
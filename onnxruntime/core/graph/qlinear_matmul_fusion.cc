@@ -0,0 +1,111 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/graph/qlinear_matmul_fusion.h"
+#include "core/graph/graph_utils.h"
+#include "core/graph/graph_viewer.h"
+
+using namespace onnx;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+// The QLinearMatMul kernel requantizes with per-tensor scales, so only
+// DequantizeLinear/QuantizeLinear nodes without a per-channel axis fuse.
+bool HasAxisAttribute(const Node& node) {
+  return node.GetAttributes().find("axis") != node.GetAttributes().end();
+}
+
+// Finds the node among consumer's input nodes that produces the given def.
+Node* FindProducer(Graph& graph, const Node& consumer, const NodeArg* def) {
+  for (auto it = consumer.InputNodesBegin(); it != consumer.InputNodesEnd(); ++it) {
+    Node* candidate = graph.GetNode((*it).Index());
+    for (const auto* output_def : candidate->OutputDefs()) {
+      if (output_def == def) {
+        return candidate;
+      }
+    }
+  }
+  return nullptr;
+}
+
+// A DequantizeLinear feeding a MatMul input is fusable when the MatMul is
+// its only consumer and its output is not needed elsewhere.
+bool IsFusableDequantize(const Graph& graph, const Node* node) {
+  return node != nullptr &&
+         utils::IsSupportedOptypeVersionAndDomain(*node, "DequantizeLinear", 1, kMSDomain) &&
+         !HasAxisAttribute(*node) &&
+         node->GetOutputEdgesCount() == 1 &&
+         !graph.IsNodeOutputsInGraphOutputs(*node);
+}
+}  // namespace
+
+Status QLinearMatMulFusion::Apply(Graph& graph, bool& modified) const {
+  GraphViewer graph_viewer(graph);
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder();
+
+  std::vector<onnxruntime::NodeIndex> removed_nodes;
+  for (auto index : order) {
+    auto node = graph.GetNode(index);
+    if ((!utils::IsSupportedOptypeVersionAndDomain(*node, "MatMul", 1) &&
+         !utils::IsSupportedOptypeVersionAndDomain(*node, "MatMul", 9)) ||
+        node->GetOutputEdgesCount() != 1 ||
+        graph.IsNodeOutputsInGraphOutputs(*node)) {
+      continue;
+    }
+
+    auto next_node = graph.GetNode((*node->OutputNodesBegin()).Index());
+    if (next_node == nullptr ||
+        !utils::IsSupportedOptypeVersionAndDomain(*next_node, "QuantizeLinear", 1, kMSDomain) ||
+        HasAxisAttribute(*next_node)) {
+      continue;
+    }
+
+    Node& matmul_node = *node;
+    Node& quantize_node = *next_node;
+
+    auto& matmul_input_defs = matmul_node.MutableInputDefs();
+    Node* dequantize_a = FindProducer(graph, matmul_node, matmul_input_defs[0]);
+    Node* dequantize_b = FindProducer(graph, matmul_node, matmul_input_defs[1]);
+    if (!IsFusableDequantize(graph, dequantize_a) ||
+        !IsFusableDequantize(graph, dequantize_b) ||
+        dequantize_a == dequantize_b) {
+      continue;
+    }
+
+    // the kernel multiplies a uint8 left-hand side with a uint8 or int8
+    // right-hand side.
+    const auto& a_defs = dequantize_a->MutableInputDefs();
+    if (a_defs[0]->Type() == nullptr || *a_defs[0]->Type() != "tensor(uint8)") {
+      continue;
+    }
+
+    auto& b_defs = dequantize_b->MutableInputDefs();
+    auto& quantize_input_defs = quantize_node.MutableInputDefs();
+
+    graph.AddNode(graph.GenerateNodeName("qlinear_" + matmul_node.Name()), "QLinearMatMul",
+                  "fused " + dequantize_a->Name() + ", " + dequantize_b->Name() + ", " +
+                      matmul_node.Name() + " and " + quantize_node.Name(),
+                  {a_defs[0], a_defs[1], a_defs[2],
+                   b_defs[0], b_defs[1], b_defs[2],
+                   quantize_input_defs[1], quantize_input_defs[2]},
+                  quantize_node.MutableOutputDefs(),
+                  nullptr, kMSDomain);
+
+    removed_nodes.push_back(dequantize_a->Index());
+    removed_nodes.push_back(dequantize_b->Index());
+    removed_nodes.push_back(matmul_node.Index());
+    removed_nodes.push_back(quantize_node.Index());
+  }
+
+  for (auto i : removed_nodes) {
+    graph.RemoveNode(i);
+  }
+
+  if (!removed_nodes.empty()) {
+    modified = true;
+    ONNXRUNTIME_RETURN_IF_ERROR(graph.Resolve());
+  }
+  return Status::OK();
+}
+}  // namespace onnxruntime
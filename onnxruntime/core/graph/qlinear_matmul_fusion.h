@@ -0,0 +1,21 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/graph/graph_transformer.h"
+
+namespace onnxruntime {
+
+// Fuses DequantizeLinear -> MatMul -> QuantizeLinear sandwiches into a single
+// QLinearMatMul node so the matrix product runs on the quantized data
+// directly and the float intermediates never materialize.
+class QLinearMatMulFusion : public onnxruntime::GraphTransformer {
+ public:
+  QLinearMatMulFusion() noexcept
+      : onnxruntime::GraphTransformer("QLinearMatMulFusion",
+                                      "Fusing DequantizeLinear, MatMul and QuantizeLinear into QLinearMatMul") {}
+  Status Apply(onnxruntime::Graph& graph, bool& modified) const override;
+};
+
+}  // namespace onnxruntime
@@ -151,6 +151,10 @@ void OnnxRuntimeOpSchemaRegistry::GetSchemaAndHistory(
 }
 
 void SchemaRegistryManager::RegisterRegistry(std::shared_ptr<IOnnxRuntimeOpSchemaCollection> registry) {
+  // A new registry takes priority over everything resolved so far, so cached
+  // lookups may no longer be correct.
+  std::lock_guard<std::mutex> lock(lookup_cache_mutex_);
+  lookup_cache_.clear();
   registries.push_front(registry);
 }
 
@@ -204,6 +208,38 @@ void SchemaRegistryManager::GetSchemaAndHistory(
     const std::string& domain,
     const ONNX_NAMESPACE::OpSchema** latest_schema,
     int* earliest_opset_where_unchanged) const {
+  std::string cache_key = key + ':' + domain + ':' + std::to_string(op_set_version);
+  {
+    std::lock_guard<std::mutex> lock(lookup_cache_mutex_);
+    auto hit = lookup_cache_.find(cache_key);
+    if (hit != lookup_cache_.end()) {
+      *latest_schema = hit->second.first;
+      *earliest_opset_where_unchanged = hit->second.second;
+      return;
+    }
+  }
+
+  const ONNX_NAMESPACE::OpSchema* resolved_schema = nullptr;
+  int resolved_earliest = std::numeric_limits<int>::max();
+  GetSchemaAndHistoryImpl(key, op_set_version, domain, &resolved_schema, &resolved_earliest);
+
+  // Misses are cached too: resolution of an unknown op walks every registry
+  // and is just as expensive as a successful one.
+  {
+    std::lock_guard<std::mutex> lock(lookup_cache_mutex_);
+    lookup_cache_.emplace(std::move(cache_key), std::make_pair(resolved_schema, resolved_earliest));
+  }
+
+  *latest_schema = resolved_schema;
+  *earliest_opset_where_unchanged = resolved_earliest;
+}
+
+void SchemaRegistryManager::GetSchemaAndHistoryImpl(
+    const std::string& key,
+    const int op_set_version,
+    const std::string& domain,
+    const ONNX_NAMESPACE::OpSchema** latest_schema,
+    int* earliest_opset_where_unchanged) const {
   // A greedy algorithm is used to search for a schema registration in some registry,
   // while potentially inferring from other registries the allowed schema version
   // given the op-set version.  Each time a registry fails to locate the schema
@@ -0,0 +1,228 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/graph/shape_functions.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+#include "core/common/common.h"
+
+using namespace ::onnxruntime::common;
+
+namespace onnxruntime {
+namespace shape_functions {
+
+namespace {
+
+int64_t GetIntAttr(const NodeAttributes& attributes, const std::string& name, int64_t default_value) {
+  auto it = attributes.find(name);
+  if (it == attributes.end() || it->second.type() != ONNX_NAMESPACE::AttributeProto_AttributeType_INT) {
+    return default_value;
+  }
+  return it->second.i();
+}
+
+bool GetIntsAttr(const NodeAttributes& attributes, const std::string& name, std::vector<int64_t>& values) {
+  auto it = attributes.find(name);
+  if (it == attributes.end() || it->second.type() != ONNX_NAMESPACE::AttributeProto_AttributeType_INTS) {
+    return false;
+  }
+  values.assign(it->second.ints().begin(), it->second.ints().end());
+  return true;
+}
+
+std::string GetStringAttr(const NodeAttributes& attributes, const std::string& name,
+                          const std::string& default_value) {
+  auto it = attributes.find(name);
+  if (it == attributes.end() || it->second.type() != ONNX_NAMESPACE::AttributeProto_AttributeType_STRING) {
+    return default_value;
+  }
+  return it->second.s();
+}
+
+// Same math as GemmHelper: two 2D operands, either one transposed by
+// attribute, output (M, N).
+Status InferGemmShape(const std::vector<std::vector<int64_t>>& input_shapes,
+                      const NodeAttributes& attributes,
+                      std::vector<std::vector<int64_t>>& output_shapes) {
+  if (input_shapes.size() < 2 || input_shapes[0].size() != 2 || input_shapes[1].size() != 2) {
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Gemm requires two 2D inputs.");
+  }
+  const bool trans_a = GetIntAttr(attributes, "transA", 0) != 0;
+  const bool trans_b = GetIntAttr(attributes, "transB", 0) != 0;
+  const auto& a = input_shapes[0];
+  const auto& b = input_shapes[1];
+
+  const int64_t M = trans_a ? a[1] : a[0];
+  const int64_t K = trans_a ? a[0] : a[1];
+  const int64_t N = trans_b ? b[0] : b[1];
+  const int64_t K_b = trans_b ? b[1] : b[0];
+  if (K != K_b) {
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                                   "Gemm: K dimension mismatch: ", K, " vs ", K_b);
+  }
+
+  output_shapes.resize(1);
+  output_shapes[0] = {M, N};
+  return Status::OK();
+}
+
+// Same shape rules as MatMulComputeHelper (numpy.matmul): 1D operands are
+// promoted to matrices and the promoted dimension is squeezed from the
+// output, batch dimensions broadcast.
+Status InferMatMulShape(const std::vector<std::vector<int64_t>>& input_shapes,
+                        const NodeAttributes& /*attributes*/,
+                        std::vector<std::vector<int64_t>>& output_shapes) {
+  if (input_shapes.size() < 2 || input_shapes[0].empty() || input_shapes[1].empty()) {
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "MatMul requires two inputs of rank >= 1.");
+  }
+  std::vector<int64_t> left = input_shapes[0];
+  std::vector<int64_t> right = input_shapes[1];
+
+  const bool left_is_1d = left.size() == 1;
+  const bool right_is_1d = right.size() == 1;
+  if (left_is_1d) {
+    left.insert(left.begin(), 1);
+  }
+  if (right_is_1d) {
+    right.push_back(1);
+  }
+
+  if (left.back() != right[right.size() - 2]) {
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                                   "MatMul: K dimension mismatch: ", left.back(),
+                                   " vs ", right[right.size() - 2]);
+  }
+
+  // broadcast the batch dimensions
+  const size_t left_batch = left.size() - 2;
+  const size_t right_batch = right.size() - 2;
+  const size_t num_batch = std::max(left_batch, right_batch);
+  std::vector<int64_t> output;
+  output.reserve(num_batch + 2);
+  for (size_t i = 0; i < num_batch; ++i) {
+    const int64_t l = i < num_batch - left_batch ? 1 : left[i - (num_batch - left_batch)];
+    const int64_t r = i < num_batch - right_batch ? 1 : right[i - (num_batch - right_batch)];
+    if (l != r && l != 1 && r != 1) {
+      return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                                     "MatMul: batch dimension mismatch: ", l, " vs ", r);
+    }
+    output.push_back(std::max(l, r));
+  }
+  if (!left_is_1d) {
+    output.push_back(left[left.size() - 2]);
+  }
+  if (!right_is_1d) {
+    output.push_back(right.back());
+  }
+
+  output_shapes.resize(1);
+  output_shapes[0] = std::move(output);
+  return Status::OK();
+}
+
+// Same math as ConvBase::InferOutputShape / ComputePadAndOutputShape, minus
+// the pad bookkeeping the kernel needs: X (N, C, d...), W (M, C/group, k...),
+// output (N, M, out...).
+Status InferConvShape(const std::vector<std::vector<int64_t>>& input_shapes,
+                      const NodeAttributes& attributes,
+                      std::vector<std::vector<int64_t>>& output_shapes) {
+  if (input_shapes.size() < 2 || input_shapes[0].size() < 3 || input_shapes[1].size() < 3 ||
+      input_shapes[0].size() != input_shapes[1].size()) {
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                                   "Conv requires X and W of equal rank >= 3.");
+  }
+  const auto& X = input_shapes[0];
+  const auto& W = input_shapes[1];
+  const size_t num_spatial = X.size() - 2;
+
+  const int64_t group = GetIntAttr(attributes, "group", 1);
+  if (group < 1 || X[1] != W[1] * group) {
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                                   "Conv: channel count ", X[1], " does not match weight shape.");
+  }
+
+  std::vector<int64_t> kernel_shape;
+  if (!GetIntsAttr(attributes, "kernel_shape", kernel_shape)) {
+    kernel_shape.assign(W.begin() + 2, W.end());
+  }
+  std::vector<int64_t> strides;
+  if (!GetIntsAttr(attributes, "strides", strides)) {
+    strides.assign(num_spatial, 1);
+  }
+  std::vector<int64_t> dilations;
+  if (!GetIntsAttr(attributes, "dilations", dilations)) {
+    dilations.assign(num_spatial, 1);
+  }
+  std::vector<int64_t> pads;
+  if (!GetIntsAttr(attributes, "pads", pads)) {
+    pads.assign(num_spatial * 2, 0);
+  }
+  const std::string auto_pad = GetStringAttr(attributes, "auto_pad", "NOTSET");
+
+  if (kernel_shape.size() != num_spatial || strides.size() != num_spatial ||
+      dilations.size() != num_spatial || pads.size() != num_spatial * 2) {
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                                   "Conv: attribute rank does not match the spatial rank.");
+  }
+
+  std::vector<int64_t> output;
+  output.reserve(X.size());
+  output.push_back(X[0]);
+  output.push_back(W[0]);
+  for (size_t i = 0; i < num_spatial; ++i) {
+    const int64_t in_dim = X[2 + i];
+    const int64_t stride = strides[i];
+    const int64_t kernel = kernel_shape[i];
+    const int64_t dilation = dilations[i];
+    const int64_t dkernel = dilation * (kernel - 1) + 1;
+    if (stride < 1 || kernel < 1 || dilation < 1) {
+      return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Conv: invalid attribute values.");
+    }
+
+    int64_t out_dim;
+    if (auto_pad == "VALID") {
+      out_dim = (in_dim - dkernel) / stride + 1;
+    } else if (auto_pad == "SAME_UPPER" || auto_pad == "SAME_LOWER") {
+      if (dilation != 1) {
+        return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                                       "Conv: dilation is not supported with SAME_* auto_pad.");
+      }
+      const int64_t legacy_target_size = (in_dim + stride - 1) / stride;
+      const int64_t pad_needed = (legacy_target_size - 1) * stride + kernel - in_dim;
+      out_dim = (in_dim + pad_needed - dkernel) / stride + 1;
+    } else {  // NOTSET uses the explicit pads
+      out_dim = (in_dim + pads[i] + pads[num_spatial + i] - dkernel) / stride + 1;
+    }
+
+    if (out_dim < 1) {
+      return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                                     "Conv: non-positive output dimension ", out_dim,
+                                     " for spatial axis ", i);
+    }
+    output.push_back(out_dim);
+  }
+
+  output_shapes.resize(1);
+  output_shapes[0] = std::move(output);
+  return Status::OK();
+}
+
+}  // namespace
+
+ShapeFunction Find(const std::string& op_type, const std::string& domain) {
+  if (!domain.empty() && domain != "ai.onnx") {
+    return nullptr;
+  }
+  static const std::unordered_map<std::string, ShapeFunction> registry{
+      {"Gemm", InferGemmShape},
+      {"MatMul", InferMatMulShape},
+      {"Conv", InferConvShape},
+  };
+  auto it = registry.find(op_type);
+  return it == registry.end() ? nullptr : it->second;
+}
+
+}  // namespace shape_functions
+}  // namespace onnxruntime
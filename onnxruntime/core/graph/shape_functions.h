@@ -0,0 +1,41 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "core/common/status.h"
+#include "core/graph/basic_types.h"
+
+namespace onnxruntime {
+namespace shape_functions {
+
+/**
+Lightweight per-operator output shape computation over plain int64 dims.
+
+The same shape math exists twice today: once inside the kernels
+(GemmHelper, MatMulComputeHelper, ConvBase::InferOutputShape) on
+TensorShape, and once at load time behind the ONNX schema inference
+functions on TensorShapeProto. The functions here are the proto-free
+middle ground: Graph::Resolve uses them to skip the schema machinery for
+nodes whose input shapes are fully known, and run-time callers can feed
+them dims straight off tensors.
+
+A shape function fills output_shapes (one dim vector per output; an empty
+vector is a scalar) from fully known input shapes and the node's
+attributes, and returns non-OK when the inputs do not compose. Callers
+fall back to the ONNX proto based inference when no function is registered
+for an op or its inputs are not fully known.
+*/
+using ShapeFunction = common::Status (*)(const std::vector<std::vector<int64_t>>& input_shapes,
+                                         const NodeAttributes& attributes,
+                                         std::vector<std::vector<int64_t>>& output_shapes);
+
+/// Returns the shape function for the op type, or nullptr when none is
+/// registered. Only ONNX-domain ops are covered.
+ShapeFunction Find(const std::string& op_type, const std::string& domain);
+
+}  // namespace shape_functions
+}  // namespace onnxruntime
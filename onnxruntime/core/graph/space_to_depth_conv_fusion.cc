@@ -0,0 +1,178 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/graph/initializer.h"
+#include "core/graph/graph_utils.h"
+#include "core/graph/space_to_depth_conv_fusion.h"
+
+using namespace onnx;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+// True when the INTS attribute is absent (defaulted) or every element equals expected.
+bool IntsAttributeAllEqual(const onnxruntime::NodeAttributes& attributes,
+                           const std::string& name, int64_t expected) {
+  auto it = attributes.find(name);
+  if (it == attributes.end()) {
+    return true;
+  }
+  if (it->second.type() != AttributeProto_AttributeType_INTS) {
+    return false;
+  }
+  for (const auto value : it->second.ints()) {
+    if (value != expected) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// W[m][(by * bs + bx) * C + c][kh][kw] applied to the SpaceToDepth output reads
+// input pixel (kh * bs + by, kw * bs + bx) of channel c within the stride
+// window, so the folded weight is W2[m][c][kh * bs + by][kw * bs + bx].
+template <typename T>
+void FoldWeightsIntoStride(const Initializer& weights, Initializer& folded,
+                           int64_t num_filters, int64_t channels,
+                           int64_t kernel_h, int64_t kernel_w, int64_t bs) {
+  const T* src = weights.data<T>();
+  T* dst = folded.data<T>();
+  const int64_t folded_kernel_h = kernel_h * bs;
+  const int64_t folded_kernel_w = kernel_w * bs;
+  for (int64_t m = 0; m < num_filters; ++m) {
+    for (int64_t by = 0; by < bs; ++by) {
+      for (int64_t bx = 0; bx < bs; ++bx) {
+        for (int64_t c = 0; c < channels; ++c) {
+          const T* src_kernel = src + (((m * bs * bs * channels) +
+                                        (by * bs + bx) * channels + c) *
+                                       kernel_h * kernel_w);
+          T* dst_kernel = dst + ((m * channels + c) * folded_kernel_h + by) * folded_kernel_w + bx;
+          for (int64_t kh = 0; kh < kernel_h; ++kh) {
+            for (int64_t kw = 0; kw < kernel_w; ++kw) {
+              dst_kernel[kh * bs * folded_kernel_w + kw * bs] = src_kernel[kh * kernel_w + kw];
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
+
+Status SpaceToDepthConvFusion::Apply(onnxruntime::Graph& graph, bool& modified) const {
+  std::vector<onnxruntime::NodeIndex> removed_nodes;
+  for (auto& node : graph.Nodes()) {
+    if (!utils::IsSupportedOptypeVersionAndDomain(node, "SpaceToDepth", 1) ||
+        node.GetOutputEdgesCount() != 1 ||
+        graph.IsNodeOutputsInGraphOutputs(node)) {
+      continue;
+    }
+
+    const Node& next_node = *node.OutputNodesBegin();
+    if (!utils::IsSupportedOptypeVersionAndDomain(next_node, "Conv", 1) ||
+        next_node.GetInputEdgesCount() != 1) {
+      continue;
+    }
+
+    auto& s2d_node = node;
+    const Node& conv_node = next_node;
+
+    const onnxruntime::NodeAttributes& s2d_attributes = s2d_node.GetAttributes();
+    auto blocksize_attr = s2d_attributes.find("blocksize");
+    if (blocksize_attr == s2d_attributes.end() ||
+        blocksize_attr->second.type() != AttributeProto_AttributeType_INT ||
+        blocksize_attr->second.i() < 1) {
+      continue;
+    }
+    const int64_t bs = blocksize_attr->second.i();
+    if (bs == 1) {
+      continue;
+    }
+
+    // the folding only commutes with a Conv that reads the SpaceToDepth output
+    // densely: unit strides/dilations, no padding, a single group.
+    const onnxruntime::NodeAttributes& conv_attributes = conv_node.GetAttributes();
+    auto group_attr = conv_attributes.find("group");
+    if (group_attr != conv_attributes.end() &&
+        (group_attr->second.type() != AttributeProto_AttributeType_INT ||
+         group_attr->second.i() != 1)) {
+      continue;
+    }
+    auto auto_pad_attr = conv_attributes.find("auto_pad");
+    if (auto_pad_attr != conv_attributes.end() &&
+        (auto_pad_attr->second.type() != AttributeProto_AttributeType_STRING ||
+         auto_pad_attr->second.s() != "NOTSET")) {
+      continue;
+    }
+    if (!IntsAttributeAllEqual(conv_attributes, "strides", 1) ||
+        !IntsAttributeAllEqual(conv_attributes, "dilations", 1) ||
+        !IntsAttributeAllEqual(conv_attributes, "pads", 0)) {
+      continue;
+    }
+
+    const auto& conv_inputs = conv_node.InputDefs();
+    const ONNX_NAMESPACE::TensorProto* conv_W_tensor_proto = nullptr;
+    if (!graph.GetInitializedTensor(conv_inputs[1]->Name(), conv_W_tensor_proto)) {
+      continue;
+    }
+    if (!Initializer::IsSupportedDataType(conv_W_tensor_proto) ||
+        conv_W_tensor_proto->dims_size() != 4 ||
+        conv_W_tensor_proto->dims(1) % (bs * bs) != 0) {
+      continue;
+    }
+
+    const int64_t num_filters = conv_W_tensor_proto->dims(0);
+    const int64_t channels = conv_W_tensor_proto->dims(1) / (bs * bs);
+    const int64_t kernel_h = conv_W_tensor_proto->dims(2);
+    const int64_t kernel_w = conv_W_tensor_proto->dims(3);
+    const std::vector<int64_t> folded_dims{num_filters, channels, kernel_h * bs, kernel_w * bs};
+
+    // re-lay-out the weights. the folded tensor gets a fresh name: the original
+    // may feed other Convs, which keep reading the untouched initializer.
+    Initializer conv_W{conv_W_tensor_proto};
+    const std::string folded_name = graph.GenerateNodeArgName(conv_W_tensor_proto->name() + "_stride_folded");
+    Initializer folded_W{conv_W_tensor_proto->data_type(), folded_name, folded_dims};
+    if (conv_W_tensor_proto->data_type() == ONNX_NAMESPACE::TensorProto_DataType_FLOAT) {
+      FoldWeightsIntoStride<float>(conv_W, folded_W, num_filters, channels, kernel_h, kernel_w, bs);
+    } else {
+      FoldWeightsIntoStride<double>(conv_W, folded_W, num_filters, channels, kernel_h, kernel_w, bs);
+    }
+
+    ONNX_NAMESPACE::TensorProto folded_W_tensor_proto;
+    folded_W.ToProto(&folded_W_tensor_proto);
+    graph.AddInitializedTensor(folded_W_tensor_proto);
+
+    ONNX_NAMESPACE::TypeProto folded_W_type;
+    folded_W_type.mutable_tensor_type()->set_elem_type(conv_W_tensor_proto->data_type());
+    auto* folded_W_shape = folded_W_type.mutable_tensor_type()->mutable_shape();
+    for (const auto dim : folded_dims) {
+      folded_W_shape->add_dim()->set_dim_value(dim);
+    }
+
+    // the Conv now reads the original input with the block rearrangement baked
+    // into its stride and kernel.
+    auto& mutable_conv_node = *graph.GetNode(conv_node.Index());
+    mutable_conv_node.MutableInputDefs()[0] = s2d_node.MutableInputDefs()[0];
+    mutable_conv_node.MutableInputDefs()[1] = &graph.GetOrCreateNodeArg(folded_name, &folded_W_type);
+    mutable_conv_node.AddAttribute("strides", std::vector<int64_t>{bs, bs});
+    if (conv_attributes.find("kernel_shape") != conv_attributes.end()) {
+      mutable_conv_node.AddAttribute("kernel_shape", std::vector<int64_t>{kernel_h * bs, kernel_w * bs});
+    }
+
+    removed_nodes.push_back(s2d_node.Index());
+  }
+
+  for (auto i : removed_nodes) {
+    graph.RemoveNode(i);
+  }
+
+  if (!removed_nodes.empty()) {
+    modified = true;
+    ONNXRUNTIME_RETURN_IF_ERROR(graph.Resolve());
+  }
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,29 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/graph/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+  Folds a SpaceToDepth node into the Conv that consumes it by moving the block
+  rearrangement into the Conv's stride. A stride-1 Conv over the
+  SpaceToDepth(blocksize = s) output reads exactly the same input pixels as a
+  stride-s Conv with an s-times larger kernel over the original input, so the
+  weights are re-laid-out once at initialization and the runtime rearrangement
+  disappears entirely.
+
+  Applies when the Conv has unit strides and dilations, no padding, a single
+  group, and a constant 4D weight initializer.
+*/
+class SpaceToDepthConvFusion : public onnxruntime::GraphTransformer {
+ public:
+  SpaceToDepthConvFusion() noexcept
+      : onnxruntime::GraphTransformer("SpaceToDepthConvFusion",
+                                      "Folding SpaceToDepth into the following Conv's stride") {}
+  Status Apply(onnxruntime::Graph& graph, bool& modified) const override;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,98 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/graph/zipmap_elision.h"
+#include "core/graph/graph_viewer.h"
+
+using namespace onnx;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+Status ZipMapElision::Apply(Graph& graph, bool& modified) const {
+  // collect candidates first; the elision edits the graph output list and
+  // removes nodes.
+  std::vector<NodeIndex> candidates;
+
+  for (auto& node : graph.Nodes()) {
+    if (node.OpType() != "ZipMap" || node.Domain() != kMLDomain) {
+      continue;
+    }
+
+    // only elide maps that go straight out of the graph; a map consumed by
+    // another node must stay a map.
+    if (node.GetOutputEdgesCount() != 0 || !graph.IsNodeOutputsInGraphOutputs(node)) {
+      continue;
+    }
+
+    candidates.push_back(node.Index());
+  }
+
+  for (auto index : candidates) {
+    auto* node = graph.GetNode(index);
+    const auto& attrs = node->GetAttributes();
+
+    NodeArg* scores_input = node->MutableInputDefs()[0];
+    const std::string output_name = node->OutputDefs()[0]->Name();
+
+    // the class labels come out of the ZipMap attributes as an initializer,
+    // served as a graph output straight from the weights with no kernel run.
+    ONNX_NAMESPACE::TensorProto labels_tensor;
+    labels_tensor.set_name(output_name + "_labels");
+
+    TypeProto labels_type;
+    int64_t num_labels;
+
+    auto string_labels = attrs.find("classlabels_strings");
+    if (string_labels != attrs.end() && string_labels->second.strings_size() > 0) {
+      labels_tensor.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_STRING);
+      for (const auto& label : string_labels->second.strings()) {
+        labels_tensor.add_string_data(label);
+      }
+      num_labels = string_labels->second.strings_size();
+      labels_type.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_STRING);
+    } else {
+      auto int64_labels = attrs.find("classlabels_int64s");
+      if (int64_labels == attrs.end() || int64_labels->second.ints_size() == 0) {
+        // malformed node; leave it for the kernel to report.
+        continue;
+      }
+      labels_tensor.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_INT64);
+      for (auto label : int64_labels->second.ints()) {
+        labels_tensor.add_int64_data(label);
+      }
+      num_labels = int64_labels->second.ints_size();
+      labels_type.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_INT64);
+    }
+
+    labels_tensor.add_dims(num_labels);
+    labels_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(num_labels);
+
+    graph.AddInitializedTensor(labels_tensor);
+    auto& labels_arg = graph.GetOrCreateNodeArg(labels_tensor.name(), &labels_type);
+
+    // the scores pass through an Identity so the tensor output has a
+    // predictable name derived from the original map output.
+    TypeProto scores_type;
+    if (scores_input->TypeAsProto() != nullptr) {
+      scores_type = *scores_input->TypeAsProto();
+    } else {
+      scores_type.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+    }
+
+    auto& scores_arg = graph.GetOrCreateNodeArg(output_name + "_scores", &scores_type);
+
+    graph.AddNode(output_name + "_scores", "Identity",
+                  "Score passthrough for elided ZipMap output " + output_name,
+                  {scores_input}, {&scores_arg});
+
+    graph.RemoveNode(index);
+
+    ONNXRUNTIME_RETURN_IF_ERROR(graph.ReplaceGraphOutput(output_name, {&labels_arg, &scores_arg}));
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
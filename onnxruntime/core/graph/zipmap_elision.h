@@ -0,0 +1,25 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/graph/graph_transformer.h"
+
+namespace onnxruntime {
+
+// Replaces each ZipMap node whose output goes straight out of the graph with
+// plain parallel arrays: a "<name>_labels" tensor holding the class labels
+// from the ZipMap attributes and a "<name>_scores" float tensor passing the
+// input scores through. Fetching a map output materializes one std::map per
+// sample only to be flattened again by most callers; the elided form skips
+// the dictionary construction entirely. Enabled via
+// SessionOptions.elide_zipmap_outputs.
+class ZipMapElision : public onnxruntime::GraphTransformer {
+ public:
+  ZipMapElision() noexcept
+      : onnxruntime::GraphTransformer("ZipMapElision",
+                                      "Replace graph output ZipMap nodes with label and score tensors") {}
+  Status Apply(onnxruntime::Graph& graph, bool& modified) const override;
+};
+
+}  // namespace onnxruntime
@@ -65,6 +65,232 @@ MlasSgemm(
     size_t ldc
     );
 
+//
+// Single precision matrix/matrix multiply routine with matrix B stored as
+// half-precision floats. Panels of B are converted to single precision on
+// the fly while they are packed for the kernels, so B is read from memory
+// at half the bandwidth of the single precision variant.
+//
+
+void
+MLASCALL
+MlasSgemm(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const unsigned short* B,
+    size_t ldb,
+    float beta,
+    float* C,
+    size_t ldc
+    );
+
+//
+// Single precision matrix/matrix multiply routines using a pre-packed copy
+// of matrix B. The packed buffer is opaque and may only be consumed by the
+// matching MlasSgemm overload below.
+//
+
+size_t
+MLASCALL
+MlasSgemmPackBSize(
+    size_t N,
+    size_t K
+    );
+
+void
+MLASCALL
+MlasSgemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    void* PackedB
+    );
+
+void
+MLASCALL
+MlasSgemm(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const void* PackedB,
+    float beta,
+    float* C,
+    size_t ldc
+    );
+
+//
+// Batched single precision matrix/matrix multiply routines. All operations
+// in a batch share the same dimensions and the worker threads are
+// partitioned across the whole batch, so many small operations pay the
+// thread dispatch cost once instead of once per call. The second overload
+// shares one pre-packed copy of matrix B (see MlasSgemmPackB) across the
+// batch, so the packing cost is also paid once.
+//
+
+void
+MLASCALL
+MlasSgemmBatch(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* const* AArray,
+    size_t lda,
+    const float* const* BArray,
+    size_t ldb,
+    float beta,
+    float* const* CArray,
+    size_t ldc,
+    size_t BatchN
+    );
+
+void
+MLASCALL
+MlasSgemmBatch(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* const* AArray,
+    size_t lda,
+    const void* PackedB,
+    float beta,
+    float* const* CArray,
+    size_t ldc,
+    size_t BatchN
+    );
+
+//
+// Strided batched single precision matrix/matrix multiply routine. The
+// matrices of the batch live at uniform element strides from the base
+// addresses, as produced by a stacked 3-D or 4-D matrix multiplication, and
+// a zero stride broadcasts one matrix to every operation. The worker
+// threads are partitioned across the flattened row space of the whole
+// batch, so a batch of a few short matrices can still occupy every thread.
+//
+
+void
+MLASCALL
+MlasSgemmStridedBatched(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    size_t StrideA,
+    const float* B,
+    size_t ldb,
+    size_t StrideB,
+    float beta,
+    float* C,
+    size_t ldc,
+    size_t StrideC,
+    size_t BatchN
+    );
+
+//
+// Block-sparse single precision matrix/matrix multiply routines.
+//
+// A constant B matrix that was pruned to block sparsity can be packed once
+// into a block-CSR layout over 4x4 blocks and then multiplied touching only
+// the stored blocks. Neither matrix may be transposed.
+//
+
+float
+MLASCALL
+MlasSgemmBlockSparseDensity(
+    size_t K,
+    size_t N,
+    const float* B,
+    size_t ldb
+    );
+
+size_t
+MLASCALL
+MlasSgemmPackBlockSparseBSize(
+    size_t K,
+    size_t N,
+    const float* B,
+    size_t ldb
+    );
+
+void
+MLASCALL
+MlasSgemmPackBlockSparseB(
+    size_t K,
+    size_t N,
+    const float* B,
+    size_t ldb,
+    void* PackedB
+    );
+
+void
+MLASCALL
+MlasSgemmBlockSparse(
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const void* PackedB,
+    float beta,
+    float* C,
+    size_t ldc
+    );
+
+//
+// Single precision matrix transpose routine.
+//
+
+void
+MLASCALL
+MlasTranspose(
+    const float* Input,
+    float* Output,
+    size_t M,
+    size_t N
+    );
+
+//
+// Quantized integer matrix/matrix multiply routine.
+//
+
+void
+MLASCALL
+MlasQgemm(
+    size_t M,
+    size_t N,
+    size_t K,
+    const uint8_t* A,
+    size_t lda,
+    uint8_t offa,
+    const uint8_t* B,
+    size_t ldb,
+    uint8_t offb,
+    bool BIsSigned,
+    int32_t* C,
+    size_t ldc
+    );
+
 //
 // Convolution routines.
 //
@@ -73,6 +299,8 @@ enum MLAS_CONV_ALGORITHM {
     MlasConvAlgorithmGemmDirect,
     MlasConvAlgorithmExpandThenGemm,
     MlasConvAlgorithmExpandThenGemmSegmented,
+    MlasConvAlgorithmDepthwise,
+    MlasConvAlgorithmWinograd,
 };
 
 struct MLAS_CONV_PARAMETERS {
@@ -99,6 +327,10 @@ struct MLAS_CONV_PARAMETERS {
         struct {
             size_t ThreadStrideN;
         } ExpandThenGemmSegmented;
+        struct {
+            size_t TransformedFilterSize;
+            size_t PerThreadWorkSize;
+        } Winograd;
     } u;
 };
 
@@ -189,6 +421,156 @@ MlasComputeTanh(
     size_t N
     );
 
+void
+MLASCALL
+MlasComputeErf(
+    const float* Input,
+    float* Output,
+    size_t N
+    );
+
+void
+MLASCALL
+MlasComputeExp(
+    const float* Input,
+    float* Output,
+    size_t N
+    );
+
+void
+MLASCALL
+MlasComputeSoftmax(
+    const float* Input,
+    float* Output,
+    size_t N,
+    size_t D,
+    bool LogSoftmax
+    );
+
+//
+// Activation routines.
+//
+
+typedef enum {
+    MlasIdentityActivation,
+    MlasReluActivation,
+    MlasLeakyReluActivation,
+    MlasEluActivation,
+    MlasSoftplusActivation,
+    MlasHardSigmoidActivation,
+    MlasTanhActivation,
+    MlasLogisticActivation,
+    MlasActivationKindCount,
+} MLAS_ACTIVATION_KIND;
+
+typedef struct {
+    MLAS_ACTIVATION_KIND ActivationKind;
+    union {
+        struct {
+            float alpha;
+        } LeakyRelu;
+        struct {
+            float alpha;
+        } Elu;
+        struct {
+            float alpha;
+            float beta;
+        } Softplus;
+        struct {
+            float alpha;
+            float beta;
+        } HardSigmoid;
+        float Values[2];
+    } Parameters;
+} MLAS_ACTIVATION;
+
+void
+MLASCALL
+MlasComputeActivation(
+    const MLAS_ACTIVATION* Activation,
+    const float* Input,
+    float* Output,
+    size_t N
+    );
+
+//
+// Threading support.
+//
+// By default MLAS threads its work using OpenMP or the Windows thread pool.
+// A host application can instead supply its own executor, so MLAS kernels
+// share the application's worker threads rather than competing with them.
+// The executor must invoke ThreadedRoutine(Context, Index) for every Index
+// in [0, Iterations) and return only once all iterations have completed.
+//
+
+typedef
+void
+(MLAS_THREADED_ROUTINE)(
+    void* Context,
+    int32_t Index
+    );
+
+typedef
+void
+(MLAS_PARALLEL_EXECUTOR)(
+    MLAS_THREADED_ROUTINE* ThreadedRoutine,
+    void* Context,
+    int32_t Iterations
+    );
+
+void
+MLASCALL
+MlasSetParallelExecutor(
+    MLAS_PARALLEL_EXECUTOR* Executor,
+    int32_t MaximumThreadCount
+    );
+
+//
+// The application can also supply a query reporting whether the calling
+// thread is already inside a parallel region run by the executor. MLAS then
+// falls back to single threaded execution for work dispatched from that
+// thread, mirroring the nested-region behavior of the OpenMP path.
+//
+
+typedef
+bool
+(MLAS_PARALLEL_REGION_QUERY)(
+    void
+    );
+
+void
+MLASCALL
+MlasSetParallelRegionQuery(
+    MLAS_PARALLEL_REGION_QUERY* Query
+    );
+
+//
+// Cooperative cancellation support.
+//
+// The application can install a per-thread cancellation check that is polled
+// before threaded work is dispatched and before each work chunk executes.
+// When the check reports cancellation the remaining work is skipped and the
+// output of the operation is undefined, so the caller must abandon the
+// results once it observes the cancellation itself.
+//
+
+typedef
+bool
+(MLAS_CANCEL_ROUTINE)(
+    void* Context
+    );
+
+struct MLAS_THREAD_CANCEL_STATE {
+    MLAS_CANCEL_ROUTINE* Routine;
+    void* Context;
+};
+
+MLAS_THREAD_CANCEL_STATE
+MLASCALL
+MlasSetThreadCancelState(
+    MLAS_THREAD_CANCEL_STATE State
+    );
+
 //
 // Half-precision floating-point routines.
 //
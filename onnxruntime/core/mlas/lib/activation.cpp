@@ -0,0 +1,549 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    activation.cpp
+
+Abstract:
+
+    This module implements the activation routines.
+
+    The rectifier family of activations is computed branch-free from minimum
+    and maximum operations. The softplus activation decomposes as
+    softplus(x) = max(x, 0) + log1p(exp(-abs(x))), which keeps the logarithm
+    argument inside (1, 2] where a short inverse hyperbolic tangent series
+    converges to single precision accuracy. Large buffers are split across
+    the available worker threads.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Bundles the floating point constants used by the softplus activation.
+//
+// log1p(u) is computed as 2*atanh(u / (2 + u)). The series argument is
+// bounded by 1/3 for u inside (0, 1], so terms through the eleventh power
+// are sufficient for single precision.
+//
+
+extern "C" const struct {
+    float atanh_11;
+    float atanh_9;
+    float atanh_7;
+    float atanh_5;
+    float atanh_3;
+    float One;
+    float Two;
+} MlasSoftplusConstants = {
+    1.0f / 11.0f,
+    1.0f / 9.0f,
+    1.0f / 7.0f,
+    1.0f / 5.0f,
+    1.0f / 3.0f,
+    1.0f,
+    2.0f,
+};
+
+inline
+MLAS_FLOAT32X4
+MlasLog1pExpNegativeAbsFloat32x4(
+    MLAS_FLOAT32X4 NegativeAbsValue
+    )
+/*++
+
+Routine Description:
+
+    This routine computes log1p(exp(x)) for a non-positive vector, which is
+    the softplus remainder after the linear part max(x, 0) is split off.
+
+Arguments:
+
+    NegativeAbsValue - Supplies the non-positive input vector.
+
+Return Value:
+
+    Returns log1p(exp(x)) of the input vector.
+
+--*/
+{
+    MLAS_FLOAT32X4 u = MlasExpFloat32x4(NegativeAbsValue);
+
+    MLAS_FLOAT32X4 t = MlasDivideFloat32x4(u,
+        MlasAddFloat32x4(u, MlasBroadcastFloat32x4(MlasSoftplusConstants.Two)));
+    MLAS_FLOAT32X4 TSquared = MlasMultiplyFloat32x4(t, t);
+
+    MLAS_FLOAT32X4 p;
+    p = MlasMultiplyAddFloat32x4(TSquared, MlasBroadcastFloat32x4(MlasSoftplusConstants.atanh_11),
+        MlasBroadcastFloat32x4(MlasSoftplusConstants.atanh_9));
+    p = MlasMultiplyAddFloat32x4(p, TSquared, MlasBroadcastFloat32x4(MlasSoftplusConstants.atanh_7));
+    p = MlasMultiplyAddFloat32x4(p, TSquared, MlasBroadcastFloat32x4(MlasSoftplusConstants.atanh_5));
+    p = MlasMultiplyAddFloat32x4(p, TSquared, MlasBroadcastFloat32x4(MlasSoftplusConstants.atanh_3));
+    p = MlasMultiplyAddFloat32x4(p, TSquared, MlasBroadcastFloat32x4(MlasSoftplusConstants.One));
+
+    return MlasMultiplyFloat32x4(MlasAddFloat32x4(t, t), p);
+}
+
+inline
+float
+MlasLog1pExpNegativeAbsScalar(
+    float NegativeAbsValue
+    )
+/*++
+
+Routine Description:
+
+    This routine computes log1p(exp(x)) for a non-positive scalar using the
+    same decomposition as the vector path.
+
+Arguments:
+
+    NegativeAbsValue - Supplies the non-positive input value.
+
+Return Value:
+
+    Returns log1p(exp(x)) of the input value.
+
+--*/
+{
+    float u = MlasExpScalar(NegativeAbsValue);
+
+    float t = u / (u + MlasSoftplusConstants.Two);
+    float TSquared = t * t;
+
+    float p;
+    p = TSquared * MlasSoftplusConstants.atanh_11 + MlasSoftplusConstants.atanh_9;
+    p = p * TSquared + MlasSoftplusConstants.atanh_7;
+    p = p * TSquared + MlasSoftplusConstants.atanh_5;
+    p = p * TSquared + MlasSoftplusConstants.atanh_3;
+    p = p * TSquared + MlasSoftplusConstants.One;
+
+    return (t + t) * p;
+}
+
+void
+MlasReluKernel(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+{
+    MLAS_FLOAT32X4 ZeroVector = MlasZeroFloat32x4();
+
+    while (N >= 4) {
+
+        MlasStoreFloat32x4(Output, MlasMaximumFloat32x4(ZeroVector, MlasLoadFloat32x4(Input)));
+
+        Input += 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+
+        *Output++ = (std::max)(0.0f, *Input++);
+
+        N -= 1;
+    }
+}
+
+void
+MlasLeakyReluKernel(
+    const float* Input,
+    float* Output,
+    size_t N,
+    float alpha
+    )
+{
+    MLAS_FLOAT32X4 ZeroVector = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 AlphaVector = MlasBroadcastFloat32x4(alpha);
+
+    while (N >= 4) {
+
+        MLAS_FLOAT32X4 Value = MlasLoadFloat32x4(Input);
+
+        MLAS_FLOAT32X4 PositivePart = MlasMaximumFloat32x4(ZeroVector, Value);
+        MLAS_FLOAT32X4 NegativePart = MlasMinimumFloat32x4(ZeroVector, Value);
+
+        MlasStoreFloat32x4(Output, MlasMultiplyAddFloat32x4(AlphaVector, NegativePart, PositivePart));
+
+        Input += 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+
+        float Value = *Input++;
+
+        *Output++ = (std::max)(0.0f, Value) + alpha * (std::min)(0.0f, Value);
+
+        N -= 1;
+    }
+}
+
+void
+MlasEluKernel(
+    const float* Input,
+    float* Output,
+    size_t N,
+    float alpha
+    )
+{
+    MLAS_FLOAT32X4 ZeroVector = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 AlphaVector = MlasBroadcastFloat32x4(alpha);
+    MLAS_FLOAT32X4 OneVector = MlasBroadcastFloat32x4(1.0f);
+
+    while (N >= 4) {
+
+        MLAS_FLOAT32X4 Value = MlasLoadFloat32x4(Input);
+
+        MLAS_FLOAT32X4 PositivePart = MlasMaximumFloat32x4(ZeroVector, Value);
+        MLAS_FLOAT32X4 NegativePart = MlasMinimumFloat32x4(ZeroVector, Value);
+
+        //
+        // exp(0) - 1 is exactly zero, so the negative branch contributes
+        // nothing for non-negative inputs.
+        //
+
+        MLAS_FLOAT32X4 ExpMinusOne = MlasSubtractFloat32x4(MlasExpFloat32x4(NegativePart), OneVector);
+
+        MlasStoreFloat32x4(Output, MlasMultiplyAddFloat32x4(AlphaVector, ExpMinusOne, PositivePart));
+
+        Input += 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+
+        float Value = *Input++;
+
+        *Output++ = (std::max)(0.0f, Value) +
+            alpha * (MlasExpScalar((std::min)(0.0f, Value)) - 1.0f);
+
+        N -= 1;
+    }
+}
+
+void
+MlasSoftplusKernel(
+    const float* Input,
+    float* Output,
+    size_t N,
+    float alpha,
+    float beta
+    )
+{
+    MLAS_FLOAT32X4 ZeroVector = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 AlphaVector = MlasBroadcastFloat32x4(alpha);
+    MLAS_FLOAT32X4 BetaVector = MlasBroadcastFloat32x4(beta);
+
+    while (N >= 4) {
+
+        MLAS_FLOAT32X4 Value = MlasMultiplyFloat32x4(BetaVector, MlasLoadFloat32x4(Input));
+
+        MLAS_FLOAT32X4 PositivePart = MlasMaximumFloat32x4(ZeroVector, Value);
+        MLAS_FLOAT32X4 NegativeAbsValue =
+            MlasMinimumFloat32x4(Value, MlasSubtractFloat32x4(ZeroVector, Value));
+
+        MLAS_FLOAT32X4 Softplus =
+            MlasAddFloat32x4(PositivePart, MlasLog1pExpNegativeAbsFloat32x4(NegativeAbsValue));
+
+        MlasStoreFloat32x4(Output, MlasMultiplyFloat32x4(AlphaVector, Softplus));
+
+        Input += 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+
+        float Value = beta * *Input++;
+
+        *Output++ = alpha * ((std::max)(0.0f, Value) +
+            MlasLog1pExpNegativeAbsScalar((std::min)(Value, -Value)));
+
+        N -= 1;
+    }
+}
+
+void
+MlasHardSigmoidKernel(
+    const float* Input,
+    float* Output,
+    size_t N,
+    float alpha,
+    float beta
+    )
+{
+    MLAS_FLOAT32X4 ZeroVector = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 OneVector = MlasBroadcastFloat32x4(1.0f);
+    MLAS_FLOAT32X4 AlphaVector = MlasBroadcastFloat32x4(alpha);
+    MLAS_FLOAT32X4 BetaVector = MlasBroadcastFloat32x4(beta);
+
+    while (N >= 4) {
+
+        MLAS_FLOAT32X4 Value = MlasMultiplyAddFloat32x4(AlphaVector, MlasLoadFloat32x4(Input), BetaVector);
+
+        Value = MlasMinimumFloat32x4(OneVector, Value);
+        Value = MlasMaximumFloat32x4(ZeroVector, Value);
+
+        MlasStoreFloat32x4(Output, Value);
+
+        Input += 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+
+        float Value = alpha * *Input++ + beta;
+
+        *Output++ = (std::max)(0.0f, (std::min)(1.0f, Value));
+
+        N -= 1;
+    }
+}
+
+void
+MlasActivationKernel(
+    const MLAS_ACTIVATION* Activation,
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine applies an activation function to a buffer on the calling
+    thread.
+
+Arguments:
+
+    Activation - Supplies the parameters for the activation.
+
+    Input - Supplies the input buffer. The input buffer may be the same as
+        the output buffer for an inplace operation.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    switch (Activation->ActivationKind) {
+
+        case MlasIdentityActivation:
+        {
+            if (Input != Output) {
+                memcpy(Output, Input, N * sizeof(float));
+            }
+
+            break;
+        }
+
+        case MlasReluActivation:
+        {
+            MlasReluKernel(Input, Output, N);
+            break;
+        }
+
+        case MlasLeakyReluActivation:
+        {
+            MlasLeakyReluKernel(Input, Output, N, Activation->Parameters.LeakyRelu.alpha);
+            break;
+        }
+
+        case MlasEluActivation:
+        {
+            MlasEluKernel(Input, Output, N, Activation->Parameters.Elu.alpha);
+            break;
+        }
+
+        case MlasSoftplusActivation:
+        {
+            MlasSoftplusKernel(Input, Output, N, Activation->Parameters.Softplus.alpha,
+                Activation->Parameters.Softplus.beta);
+            break;
+        }
+
+        case MlasHardSigmoidActivation:
+        {
+            MlasHardSigmoidKernel(Input, Output, N, Activation->Parameters.HardSigmoid.alpha,
+                Activation->Parameters.HardSigmoid.beta);
+            break;
+        }
+
+        case MlasTanhActivation:
+        {
+            MlasComputeTanh(Input, Output, N);
+            break;
+        }
+
+        case MlasLogisticActivation:
+        {
+            MlasComputeLogistic(Input, Output, N);
+            break;
+        }
+
+        default:
+        {
+#if defined(_MSC_VER)
+            __assume(0);
+#else
+            __builtin_unreachable();
+#endif
+        }
+    }
+}
+
+#if defined(MLAS_HAS_THREADING_SUPPORT)
+
+//
+// Define the number of per-thread elements before using another thread to
+// perform additional work. The activations are memory bound, so the number
+// is sized such that each worker touches at least a few hundred kilobytes.
+//
+
+#define MLAS_ACTIVATION_THREAD_COMPLEXITY           (64 * 1024)
+
+struct MLAS_ACTIVATION_WORK_BLOCK {
+    const MLAS_ACTIVATION* Activation;
+    const float* Input;
+    float* Output;
+    size_t N;
+    size_t StrideN;
+};
+
+void
+MlasActivationThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of an
+    activation operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_ACTIVATION_WORK_BLOCK* WorkBlock = (MLAS_ACTIVATION_WORK_BLOCK*)Context;
+
+    size_t n = size_t(Index) * WorkBlock->StrideN;
+    size_t CountN = (std::min)(WorkBlock->StrideN, WorkBlock->N - n);
+
+    MlasActivationKernel(WorkBlock->Activation, WorkBlock->Input + n,
+        WorkBlock->Output + n, CountN);
+}
+
+#endif
+
+void
+MLASCALL
+MlasComputeActivation(
+    const MLAS_ACTIVATION* Activation,
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine applies an activation function to a buffer, splitting the
+    buffer across multiple threads for large requests.
+
+Arguments:
+
+    Activation - Supplies the parameters for the activation.
+
+    Input - Supplies the input buffer. The input buffer may be the same as
+        the output buffer for an inplace operation.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_HAS_THREADING_SUPPORT)
+
+    //
+    // Compute the number of target threads given the size of the buffer.
+    // Small requests should run using the single threaded path.
+    //
+
+    int32_t TargetThreadCount = int32_t(N / MLAS_ACTIVATION_THREAD_COMPLEXITY) + 1;
+
+    if (TargetThreadCount > MLAS_MAXIMUM_THREAD_COUNT) {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    int32_t MaximumThreadCount = MlasPlatform.GetMaximumThreadCount();
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    if (TargetThreadCount > 1) {
+
+        MLAS_ACTIVATION_WORK_BLOCK WorkBlock;
+
+        WorkBlock.Activation = Activation;
+        WorkBlock.Input = Input;
+        WorkBlock.Output = Output;
+        WorkBlock.N = N;
+
+        //
+        // Segment the operation across multiple threads, keeping the stride
+        // a multiple of the vector width so only the last segment takes the
+        // scalar tail.
+        //
+
+        size_t StrideN = N / TargetThreadCount;
+
+        if ((StrideN * TargetThreadCount) != N) {
+            StrideN++;
+        }
+
+        StrideN = (StrideN + 3) & ~size_t(3);
+
+        WorkBlock.StrideN = StrideN;
+
+        int32_t Iterations = int32_t((N + StrideN - 1) / StrideN);
+
+        MlasExecuteThreaded(MlasActivationThreaded, &WorkBlock, Iterations);
+
+        return;
+    }
+
+#endif
+
+    MlasActivationKernel(Activation, Input, Output, N);
+}
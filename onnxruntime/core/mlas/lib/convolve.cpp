@@ -23,6 +23,13 @@ Abstract:
 #define MLAS_CONV_WORKING_BUFFER_SIZE_PER_THREAD \
     (MLAS_SGEMM_STRIDEN * MLAS_SGEMM_STRIDEK)
 
+//
+// Define the number of output tiles processed per block of the Winograd
+// F(2x2,3x3) algorithm. Each tile covers a 2x2 region of the output.
+//
+
+#define MLAS_CONV_WINOGRAD_TILE_BLOCK               32
+
 //
 // Define the parameters to execute segments of a convolution operation on
 // worker threads.
@@ -42,6 +49,24 @@ struct MLAS_CONV_WORK_BLOCK {
     int32_t TargetThreadCount;
 };
 
+//
+// Define the parameters to execute segments of a Winograd convolution
+// operation on worker threads.
+//
+
+struct MLAS_CONV_WINOGRAD_WORK_BLOCK {
+    const MLAS_CONV_PARAMETERS* Parameters;
+    const float* TransformedFilter;
+    const float* Input;
+    const float* Bias;
+    float* WorkingBuffer;
+    float* Output;
+    struct SEGMENT {
+        size_t StartTile;
+        size_t CountTile;
+    } Segments[MLAS_MAXIMUM_THREAD_COUNT];
+};
+
 void
 MlasConvIm2Col(
     const MLAS_CONV_PARAMETERS* Parameters,
@@ -592,7 +617,7 @@ Return Value:
 
             MlasSgemmOperation(CblasNoTrans, CblasNoTrans, FilterCount, CountN,
                 CountK, 1.0f, Filter + k, K, ColumnBuffer, CountN, beta,
-                SegmentOutput, OutputSize);
+                SegmentOutput, OutputSize, false);
 
             beta = 1.0f;
         }
@@ -643,6 +668,617 @@ Return Value:
         Segment->CountN);
 }
 
+void
+MlasConvDepthwiseKernel(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    float* Output
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a direct 2D convolution of a single input channel
+    with a single filter channel.
+
+    Depthwise convolutions degenerate to a dot product of the kernel size per
+    output element under the GEMM formulation, so expanding the input tensor
+    only adds memory traffic. This routine instead walks the input tensor in
+    place, applying each kernel tap across a whole output row with vector
+    arithmetic when the column stride is one.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input tensor of the channel.
+
+    Filter - Supplies the filter tensor of the channel.
+
+    Output - Supplies the output tensor of the channel.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t InputHeight = Parameters->InputShape[0];
+    const size_t InputWidth = Parameters->InputShape[1];
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+
+    const size_t KernelHeight = Parameters->KernelShape[0];
+    const size_t KernelWidth = Parameters->KernelShape[1];
+    const size_t PaddingTop = Parameters->Padding[0];
+    const size_t PaddingLeft = Parameters->Padding[1];
+    const size_t DilationHeight = Parameters->DilationShape[0];
+    const size_t DilationWidth = Parameters->DilationShape[1];
+    const size_t StrideHeight = Parameters->StrideShape[0];
+    const size_t StrideWidth = Parameters->StrideShape[1];
+
+    if (StrideWidth == 1) {
+
+        //
+        // Stride-1 convolutions read consecutive input elements for
+        // consecutive output columns, so each kernel tap can be applied to a
+        // whole output row with vector arithmetic and without the per-element
+        // bounds checks of the general path below.
+        //
+
+        for (size_t oh = 0; oh < OutputHeight; oh++) {
+
+            //
+            // Zero the output row before accumulating the kernel taps.
+            //
+
+            size_t ow = 0;
+
+            while (ow + 4 <= OutputWidth) {
+                MlasStoreFloat32x4(&Output[ow], MlasZeroFloat32x4());
+                ow += 4;
+            }
+
+            while (ow < OutputWidth) {
+                Output[ow++] = 0.0f;
+            }
+
+            for (size_t kh = 0; kh < KernelHeight; kh++) {
+
+                size_t ih = oh * StrideHeight + kh * DilationHeight - PaddingTop;
+
+                if (ih >= InputHeight) {
+                    continue;
+                }
+
+                const float* InputRow = &Input[ih * InputWidth];
+
+                for (size_t kw = 0; kw < KernelWidth; kw++) {
+
+                    //
+                    // Clip the output range so the input column stays inside
+                    // the row for every element that is touched.
+                    //
+
+                    ptrdiff_t InputBase = ptrdiff_t(kw * DilationWidth) - ptrdiff_t(PaddingLeft);
+
+                    ptrdiff_t OutputStart = (InputBase < 0) ? -InputBase : 0;
+                    ptrdiff_t OutputEnd = ptrdiff_t(OutputWidth);
+
+                    if (OutputEnd > ptrdiff_t(InputWidth) - InputBase) {
+                        OutputEnd = ptrdiff_t(InputWidth) - InputBase;
+                    }
+
+                    if (OutputStart >= OutputEnd) {
+                        continue;
+                    }
+
+                    const float FilterValue = Filter[kh * KernelWidth + kw];
+                    const MLAS_FLOAT32X4 FilterBroadcast = MlasBroadcastFloat32x4(FilterValue);
+
+                    const float* InputColumn = &InputRow[InputBase + OutputStart];
+                    float* OutputColumn = &Output[OutputStart];
+                    size_t Count = size_t(OutputEnd - OutputStart);
+
+                    while (Count >= 4) {
+
+                        MlasStoreFloat32x4(OutputColumn,
+                            MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(InputColumn),
+                                FilterBroadcast, MlasLoadFloat32x4(OutputColumn)));
+
+                        InputColumn += 4;
+                        OutputColumn += 4;
+                        Count -= 4;
+                    }
+
+                    while (Count > 0) {
+                        *OutputColumn++ += *InputColumn++ * FilterValue;
+                        Count--;
+                    }
+                }
+            }
+
+            Output += OutputWidth;
+        }
+
+        return;
+    }
+
+    for (size_t oh = 0; oh < OutputHeight; oh++) {
+
+        for (size_t ow = 0; ow < OutputWidth; ow++) {
+
+            float Accumulator = 0.0f;
+
+            for (size_t kh = 0; kh < KernelHeight; kh++) {
+
+                //
+                // N.B. Inputs covered by the padding region wrap around to
+                // large indices and fail the bounds checks below.
+                //
+
+                size_t ih = oh * StrideHeight + kh * DilationHeight - PaddingTop;
+
+                if (ih < InputHeight) {
+
+                    for (size_t kw = 0; kw < KernelWidth; kw++) {
+
+                        size_t iw = ow * StrideWidth + kw * DilationWidth - PaddingLeft;
+
+                        if (iw < InputWidth) {
+                            Accumulator += Input[ih * InputWidth + iw] *
+                                Filter[kh * KernelWidth + kw];
+                        }
+                    }
+                }
+            }
+
+            *Output++ = Accumulator;
+        }
+    }
+}
+
+void
+MlasConvWinogradTransformFilter(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Filter,
+    float* TransformedFilter
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms a 3x3 filter tensor to the Winograd F(2x2,3x3)
+    domain by computing U=G*g*G' for every filter/channel pair.
+
+    The transformed filter is stored as sixteen [FilterCount,InputChannels]
+    matrices, one per element of the 4x4 transform, so each transform element
+    can be multiplied with the matching input transform matrix using a plain
+    GEMM.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Filter - Supplies the filter tensor of the group.
+
+    TransformedFilter - Supplies the buffer to receive the transformed filter
+        tensor.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterStride = Parameters->FilterCount * InputChannels;
+
+    const size_t FilterChannelCount = FilterStride;
+
+    for (size_t fc = 0; fc < FilterChannelCount; fc++) {
+
+        const float* g = &Filter[fc * 9];
+
+        //
+        // Compute G*g, where G is the 4x3 filter transform matrix:
+        //
+        //      [ 1.0  0.0  0.0 ]
+        //      [ 0.5  0.5  0.5 ]
+        //      [ 0.5 -0.5  0.5 ]
+        //      [ 0.0  0.0  1.0 ]
+        //
+
+        float Gg[4][3];
+
+        for (size_t j = 0; j < 3; j++) {
+            Gg[0][j] = g[0 * 3 + j];
+            Gg[1][j] = 0.5f * (g[0 * 3 + j] + g[1 * 3 + j] + g[2 * 3 + j]);
+            Gg[2][j] = 0.5f * (g[0 * 3 + j] - g[1 * 3 + j] + g[2 * 3 + j]);
+            Gg[3][j] = g[2 * 3 + j];
+        }
+
+        //
+        // Compute (G*g)*G' and scatter the sixteen elements to the per-element
+        // matrices.
+        //
+
+        float* u = &TransformedFilter[fc];
+
+        for (size_t i = 0; i < 4; i++) {
+            u[(i * 4 + 0) * FilterStride] = Gg[i][0];
+            u[(i * 4 + 1) * FilterStride] = 0.5f * (Gg[i][0] + Gg[i][1] + Gg[i][2]);
+            u[(i * 4 + 2) * FilterStride] = 0.5f * (Gg[i][0] - Gg[i][1] + Gg[i][2]);
+            u[(i * 4 + 3) * FilterStride] = Gg[i][2];
+        }
+    }
+}
+
+void
+MlasConvWinogradKernel(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* TransformedFilter,
+    const float* Input,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output,
+    size_t StartTile,
+    size_t CountTile
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a range of output tiles of a convolution using the
+    Winograd F(2x2,3x3) algorithm.
+
+    Tiles are processed in blocks: the input transform of a block is gathered
+    to a [InputChannels,TileBlock] matrix per transform element, multiplied
+    with the transformed filter using sixteen GEMMs, and the inverse transform
+    of the products yields a 2x2 output patch per filter and tile.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    TransformedFilter - Supplies the transformed filter tensor of the group.
+
+    Input - Supplies the input tensor of the image and group.
+
+    Bias - Optionally supplies the bias vector of the group.
+
+    WorkingBuffer - Supplies a per-thread working buffer to store the
+        transformed input and product matrices of a tile block.
+
+    Output - Supplies the output tensor of the image and group.
+
+    StartTile - Supplies the starting tile index to compute.
+
+    CountTile - Supplies the number of tiles to compute.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterCount = Parameters->FilterCount;
+
+    const size_t InputHeight = Parameters->InputShape[0];
+    const size_t InputWidth = Parameters->InputShape[1];
+    const size_t InputSize = Parameters->InputSize;
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+    const size_t OutputSize = Parameters->OutputSize;
+
+    const size_t PaddingTop = Parameters->Padding[0];
+    const size_t PaddingLeft = Parameters->Padding[1];
+
+    const size_t TilesX = (OutputWidth + 1) / 2;
+
+    while (CountTile > 0) {
+
+        const size_t TileBlock = (CountTile < MLAS_CONV_WINOGRAD_TILE_BLOCK) ?
+            CountTile : MLAS_CONV_WINOGRAD_TILE_BLOCK;
+
+        float* V = WorkingBuffer;
+        float* M = WorkingBuffer + 16 * InputChannels * TileBlock;
+
+        //
+        // Gather the input patches of the tile block and transform each patch
+        // with the input transform B'*d*B, where B' is:
+        //
+        //      [ 1  0 -1  0 ]
+        //      [ 0  1  1  0 ]
+        //      [ 0 -1  1  0 ]
+        //      [ 0  1  0 -1 ]
+        //
+
+        for (size_t c = 0; c < InputChannels; c++) {
+
+            const float* InputChannel = &Input[c * InputSize];
+
+            for (size_t p = 0; p < TileBlock; p++) {
+
+                const size_t Tile = StartTile + p;
+
+                const size_t ty = (Tile / TilesX) * 2;
+                const size_t tx = (Tile % TilesX) * 2;
+
+                //
+                // N.B. Inputs covered by the padding region wrap around to
+                // large indices and fail the bounds checks below.
+                //
+
+                float d[4][4];
+
+                for (size_t i = 0; i < 4; i++) {
+
+                    const size_t iy = ty + i - PaddingTop;
+
+                    for (size_t j = 0; j < 4; j++) {
+
+                        const size_t ix = tx + j - PaddingLeft;
+
+                        d[i][j] = (iy < InputHeight && ix < InputWidth) ?
+                            InputChannel[iy * InputWidth + ix] : 0.0f;
+                    }
+                }
+
+                float t[4][4];
+
+                for (size_t j = 0; j < 4; j++) {
+                    t[0][j] = d[0][j] - d[2][j];
+                    t[1][j] = d[1][j] + d[2][j];
+                    t[2][j] = d[2][j] - d[1][j];
+                    t[3][j] = d[1][j] - d[3][j];
+                }
+
+                float* v = &V[c * TileBlock + p];
+
+                for (size_t i = 0; i < 4; i++) {
+                    v[(i * 4 + 0) * InputChannels * TileBlock] = t[i][0] - t[i][2];
+                    v[(i * 4 + 1) * InputChannels * TileBlock] = t[i][1] + t[i][2];
+                    v[(i * 4 + 2) * InputChannels * TileBlock] = t[i][2] - t[i][1];
+                    v[(i * 4 + 3) * InputChannels * TileBlock] = t[i][1] - t[i][3];
+                }
+            }
+        }
+
+        //
+        // Multiply the transformed filter with the transformed input, one
+        // GEMM per element of the 4x4 transform.
+        //
+
+        for (size_t xi = 0; xi < 16; xi++) {
+
+            MlasSgemmOperation(CblasNoTrans, CblasNoTrans, FilterCount, TileBlock,
+                InputChannels, 1.0f, &TransformedFilter[xi * FilterCount * InputChannels],
+                InputChannels, &V[xi * InputChannels * TileBlock], TileBlock, 0.0f,
+                &M[xi * FilterCount * TileBlock], TileBlock, false);
+        }
+
+        //
+        // Apply the inverse transform A'*m*A to each product and store the
+        // 2x2 output patches, where A' is:
+        //
+        //      [ 1  1  1  0 ]
+        //      [ 0  1 -1 -1 ]
+        //
+
+        for (size_t f = 0; f < FilterCount; f++) {
+
+            const float BiasValue = (Bias != nullptr) ? Bias[f] : 0.0f;
+
+            float* OutputChannel = &Output[f * OutputSize];
+
+            for (size_t p = 0; p < TileBlock; p++) {
+
+                const size_t Tile = StartTile + p;
+
+                const size_t ty = (Tile / TilesX) * 2;
+                const size_t tx = (Tile % TilesX) * 2;
+
+                const float* m = &M[f * TileBlock + p];
+
+                float t[2][4];
+
+                for (size_t j = 0; j < 4; j++) {
+
+                    const float m0 = m[(0 * 4 + j) * FilterCount * TileBlock];
+                    const float m1 = m[(1 * 4 + j) * FilterCount * TileBlock];
+                    const float m2 = m[(2 * 4 + j) * FilterCount * TileBlock];
+                    const float m3 = m[(3 * 4 + j) * FilterCount * TileBlock];
+
+                    t[0][j] = m0 + m1 + m2;
+                    t[1][j] = m1 - m2 - m3;
+                }
+
+                for (size_t i = 0; i < 2; i++) {
+
+                    if (ty + i >= OutputHeight) {
+                        break;
+                    }
+
+                    float y0 = t[i][0] + t[i][1] + t[i][2] + BiasValue;
+                    float y1 = t[i][1] - t[i][2] - t[i][3] + BiasValue;
+
+                    float* OutputRow = &OutputChannel[(ty + i) * OutputWidth + tx];
+
+                    OutputRow[0] = y0;
+
+                    if (tx + 1 < OutputWidth) {
+                        OutputRow[1] = y1;
+                    }
+                }
+            }
+        }
+
+        StartTile += TileBlock;
+        CountTile -= TileBlock;
+    }
+}
+
+void
+MlasConvWinogradThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    Winograd convolution operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_CONV_WINOGRAD_WORK_BLOCK* WorkBlock = (MLAS_CONV_WINOGRAD_WORK_BLOCK*)Context;
+
+    MLAS_CONV_WINOGRAD_WORK_BLOCK::SEGMENT* Segment = &WorkBlock->Segments[Index];
+
+    float* WorkingBuffer = WorkBlock->WorkingBuffer +
+        Index * WorkBlock->Parameters->u.Winograd.PerThreadWorkSize;
+
+    MlasConvWinogradKernel(WorkBlock->Parameters, WorkBlock->TransformedFilter,
+        WorkBlock->Input, WorkBlock->Bias, WorkingBuffer, WorkBlock->Output,
+        Segment->StartTile, Segment->CountTile);
+}
+
+void
+MlasConvWinograd(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the convolution operation using the Winograd
+    F(2x2,3x3) algorithm.
+
+    The filter of each group is transformed once and reused across the batch.
+    The output tiles of each image are then partitioned across the available
+    threads, with the input and output transforms of each partition running on
+    the worker thread alongside its GEMMs.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input tensor.
+
+    Filter - Supplies the filter tensor.
+
+    Bias - Optionally supplies the bias vector.
+
+    WorkingBuffer - Supplies a working buffer sized to the number of elements
+        returned by MlasConvPrepare.
+
+    Output - Supplies the output tensor.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t GroupCount = Parameters->GroupCount;
+    const size_t BatchCount = Parameters->BatchCount;
+    const size_t FilterCount = Parameters->FilterCount;
+
+    const size_t InputGroupSize = Parameters->InputChannels * Parameters->InputSize;
+    const size_t OutputGroupSize = FilterCount * Parameters->OutputSize;
+    const size_t FilterGroupSize = FilterCount * Parameters->K;
+
+    const size_t TilesX = (Parameters->OutputShape[1] + 1) / 2;
+    const size_t TilesY = (Parameters->OutputShape[0] + 1) / 2;
+    const size_t TileCount = TilesX * TilesY;
+
+    float* TransformedFilter = WorkingBuffer;
+    float* ThreadWorkingBuffer = WorkingBuffer + Parameters->u.Winograd.TransformedFilterSize;
+
+    //
+    // Compute the number of target threads given the number of tiles. Each
+    // thread should process at least one full tile block.
+    //
+
+    int32_t TargetThreadCount = MlasPlatform.GetMaximumThreadCount();
+
+    if (TargetThreadCount > MLAS_MAXIMUM_THREAD_COUNT) {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    const size_t MaximumSegmentCount = (TileCount + MLAS_CONV_WINOGRAD_TILE_BLOCK - 1) /
+        MLAS_CONV_WINOGRAD_TILE_BLOCK;
+
+    if (size_t(TargetThreadCount) > MaximumSegmentCount) {
+        TargetThreadCount = int32_t(MaximumSegmentCount);
+    }
+
+    for (size_t group = 0; group < GroupCount; group++) {
+
+        MlasConvWinogradTransformFilter(Parameters, &Filter[group * FilterGroupSize],
+            TransformedFilter);
+
+        for (size_t batch = 0; batch < BatchCount; batch++) {
+
+            const size_t bg = batch * GroupCount + group;
+
+            MLAS_CONV_WINOGRAD_WORK_BLOCK WorkBlock;
+
+            WorkBlock.Parameters = Parameters;
+            WorkBlock.TransformedFilter = TransformedFilter;
+            WorkBlock.Input = &Input[bg * InputGroupSize];
+            WorkBlock.Bias = (Bias != nullptr) ? &Bias[group * FilterCount] : nullptr;
+            WorkBlock.WorkingBuffer = ThreadWorkingBuffer;
+            WorkBlock.Output = &Output[bg * OutputGroupSize];
+
+            //
+            // Segment the tiles of the image across multiple threads.
+            //
+
+            const size_t TileCountPerThread = TileCount / TargetThreadCount;
+            const size_t TileCountExtra = TileCount % TargetThreadCount;
+
+            size_t StartTile = 0;
+
+            for (int32_t Index = 0; Index < TargetThreadCount; Index++) {
+
+                const size_t CountTile = TileCountPerThread +
+                    ((size_t(Index) < TileCountExtra) ? 1 : 0);
+
+                WorkBlock.Segments[Index].StartTile = StartTile;
+                WorkBlock.Segments[Index].CountTile = CountTile;
+
+                StartTile += CountTile;
+            }
+
+            MlasExecuteThreaded(MlasConvWinogradThreaded, &WorkBlock, TargetThreadCount);
+        }
+    }
+}
+
 void
 MlasConvGemmDirectThreaded(
     void* Context,
@@ -715,12 +1351,17 @@ Return Value:
         float* output = WorkBlock->Output + bg * OutputGroupSize;
 
         //
-        // Invoke the non-threaded GEMM directly with the input tensor.
+        // Invoke the direct convolution kernel or the non-threaded GEMM
+        // directly with the input tensor.
         //
 
-        MlasSgemmOperation(CblasNoTrans, Parameters->u.GemmDirect.TransB, FilterCount,
-            OutputSize, K, 1.0f, filter, K, input, Parameters->u.GemmDirect.ldb, 0.0f,
-            output, OutputSize);
+        if (Parameters->Algorithm == MlasConvAlgorithmDepthwise) {
+            MlasConvDepthwiseKernel(Parameters, input, filter, output);
+        } else {
+            MlasSgemmOperation(CblasNoTrans, Parameters->u.GemmDirect.TransB, FilterCount,
+                OutputSize, K, 1.0f, filter, K, input, Parameters->u.GemmDirect.ldb, 0.0f,
+                output, OutputSize, false);
+        }
 
         //
         // Add the optional bias vector.
@@ -890,13 +1531,24 @@ Return Value:
 
     const MLAS_CONV_ALGORITHM Algorithm = Parameters->Algorithm;
 
+    //
+    // Dispatch the Winograd algorithm, which handles the batch and group
+    // iteration and threading itself.
+    //
+
+    if (Algorithm == MlasConvAlgorithmWinograd) {
+        MlasConvWinograd(Parameters, Input, Filter, Bias, WorkingBuffer, Output);
+        return;
+    }
+
 #if defined(MLAS_HAS_THREADING_SUPPORT)
 
     //
     // Schedule batches of GEMMs across multiple threads.
     //
 
-    if (Algorithm == MlasConvAlgorithmGemmDirect && ((BatchCount > 1) || (GroupCount > 1))) {
+    if ((Algorithm == MlasConvAlgorithmGemmDirect || Algorithm == MlasConvAlgorithmDepthwise) &&
+        ((BatchCount > 1) || (GroupCount > 1))) {
 
         const size_t BatchGroupCount = BatchCount * GroupCount;
 
@@ -906,6 +1558,19 @@ Return Value:
             TargetThreadCount = int32_t(BatchGroupCount);
         }
 
+        //
+        // Partition the batches and groups finer than the thread count so the
+        // work rebalances itself across heterogeneous cores. The threaded
+        // routine partitions using the count stored in the work block, so the
+        // worker index ranges over partitions rather than threads.
+        //
+
+        int32_t PartitionCount = TargetThreadCount * MlasPlatform.GetWorkSubdivisionFactor();
+
+        if (size_t(PartitionCount) > BatchGroupCount) {
+            PartitionCount = int32_t(BatchGroupCount);
+        }
+
         MLAS_CONV_WORK_BLOCK WorkBlock;
 
         WorkBlock.Parameters = Parameters;
@@ -914,9 +1579,9 @@ Return Value:
         WorkBlock.Bias = Bias;
         WorkBlock.WorkingBuffer = nullptr;
         WorkBlock.Output = Output;
-        WorkBlock.TargetThreadCount = TargetThreadCount;
+        WorkBlock.TargetThreadCount = PartitionCount;
 
-        MlasExecuteThreaded(MlasConvGemmDirectThreaded, &WorkBlock, TargetThreadCount);
+        MlasExecuteThreadedBalanced(MlasConvGemmDirectThreaded, &WorkBlock, PartitionCount, TargetThreadCount);
 
         return;
     }
@@ -961,6 +1626,26 @@ Return Value:
                     break;
                 }
 
+                case MlasConvAlgorithmDepthwise:
+                {
+                    //
+                    // Invoke the direct convolution kernel with the input
+                    // tensor.
+                    //
+
+                    MlasConvDepthwiseKernel(Parameters, Input, filter, Output);
+
+                    //
+                    // Add the optional bias vector.
+                    //
+
+                    if (bias != nullptr) {
+                        MlasBiasAdd(bias, FilterCount, Output, OutputSize, OutputSize);
+                    }
+
+                    break;
+                }
+
                 case MlasConvAlgorithmExpandThenGemm:
                 {
                     //
@@ -988,6 +1673,15 @@ Return Value:
                     break;
                 }
 
+                case MlasConvAlgorithmWinograd:
+                {
+                    //
+                    // N.B. Handled before the batch and group iteration above.
+                    //
+
+                    break;
+                }
+
                 case MlasConvAlgorithmExpandThenGemmSegmented:
                 {
                     //
@@ -1129,6 +1823,52 @@ Return Value:
 
     *WorkingBufferSize = 0;
 
+    //
+    // Detect a depthwise convolution, where each group convolves a single
+    // input channel with a single filter. The matrix expansion would be
+    // larger than the input itself, so use a direct kernel instead.
+    //
+
+    if (Dimensions == 2 && GroupCount > 1 && InputChannels == 1 && FilterCount == 1) {
+
+        Parameters->Algorithm = MlasConvAlgorithmDepthwise;
+
+        return;
+    }
+
+    //
+    // Detect a 3x3 stride-1 convolution that can use the Winograd F(2x2,3x3)
+    // algorithm, which needs ~2.25x fewer multiplies than the GEMM
+    // formulation. The transform overhead only pays off when there are enough
+    // channels and filters to amortize it.
+    //
+
+    if (Dimensions == 2 && AllStridesAreOne && AllDilationsAreOne &&
+        Parameters->KernelShape[0] == 3 && Parameters->KernelShape[1] == 3 &&
+        InputChannels >= 8 && FilterCount >= 8 &&
+        Parameters->OutputShape[0] >= 2 && Parameters->OutputShape[1] >= 2) {
+
+        Parameters->Algorithm = MlasConvAlgorithmWinograd;
+
+        const size_t TransformedFilterSize = 16 * FilterCount * InputChannels;
+        const size_t PerThreadWorkSize = 16 * MLAS_CONV_WINOGRAD_TILE_BLOCK *
+            (InputChannels + FilterCount);
+
+        Parameters->u.Winograd.TransformedFilterSize = TransformedFilterSize;
+        Parameters->u.Winograd.PerThreadWorkSize = PerThreadWorkSize;
+
+        //
+        // N.B. The working buffer is sized for the maximum thread count so
+        // the buffer remains valid if the thread count is raised between
+        // preparing and executing the convolution.
+        //
+
+        *WorkingBufferSize = TransformedFilterSize +
+            MLAS_MAXIMUM_THREAD_COUNT * PerThreadWorkSize;
+
+        return;
+    }
+
     if (AllStridesAreOne && AllPaddingIsZero) {
 
         //
@@ -0,0 +1,187 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    erf.cpp
+
+Abstract:
+
+    This module implements routines to compute the error function, which is
+    the building block for GELU style activations.
+
+    This implementation uses the rational approximation 7.1.26 from
+    Abramowitz and Stegun, which has a maximum absolute error of 1.5e-7. The
+    implementation below targets the base instruction set (typically SSE2)
+    using the portable vector intrinsic wrappers, so the same code also
+    covers the NEON targets.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Bundles the floating point constants for use by kernels written in assembly.
+//
+
+extern "C" const struct {
+    float ScaleReciprocal;
+    float alpha_5;
+    float alpha_4;
+    float alpha_3;
+    float alpha_2;
+    float alpha_1;
+    float One;
+} MlasErfConstants = {
+    3.275911e-1f,
+    1.061405429f,
+    -1.453152027f,
+    1.421413741f,
+    -2.84496736e-1f,
+    2.54829592e-1f,
+    1.0f,
+};
+
+MLAS_FLOAT32X4
+MlasAbsFloat32x4(
+    MLAS_FLOAT32X4 Vector
+    )
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vabsq_f32(Vector);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_and_ps(Vector, _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF)));
+#endif
+}
+
+MLAS_FLOAT32X4
+MlasCopySignFloat32x4(
+    MLAS_FLOAT32X4 Magnitude,
+    MLAS_FLOAT32X4 Sign
+    )
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    uint32x4_t SignMask = vdupq_n_u32(0x80000000);
+    return vreinterpretq_f32_u32(vbslq_u32(SignMask, vreinterpretq_u32_f32(Sign),
+        vreinterpretq_u32_f32(Magnitude)));
+#elif defined(MLAS_SSE2_INTRINSICS)
+    __m128 SignMask = _mm_castsi128_ps(_mm_set1_epi32(int32_t(0x80000000)));
+    return _mm_or_ps(_mm_andnot_ps(SignMask, Magnitude), _mm_and_ps(SignMask, Sign));
+#endif
+}
+
+void
+MLASCALL
+MlasErfKernel(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel for the error function.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (N >= 4) {
+
+        MLAS_FLOAT32X4 Value = MlasLoadFloat32x4(Input);
+        MLAS_FLOAT32X4 One = MlasBroadcastFloat32x4(MlasErfConstants.One);
+
+        MLAS_FLOAT32X4 AbsValue = MlasAbsFloat32x4(Value);
+
+        MLAS_FLOAT32X4 t = MlasDivideFloat32x4(One,
+            MlasMultiplyAddFloat32x4(AbsValue,
+                MlasBroadcastFloat32x4(MlasErfConstants.ScaleReciprocal), One));
+
+        MLAS_FLOAT32X4 p;
+        p = MlasMultiplyAddFloat32x4(MlasBroadcastFloat32x4(MlasErfConstants.alpha_5), t,
+            MlasBroadcastFloat32x4(MlasErfConstants.alpha_4));
+        p = MlasMultiplyAddFloat32x4(p, t, MlasBroadcastFloat32x4(MlasErfConstants.alpha_3));
+        p = MlasMultiplyAddFloat32x4(p, t, MlasBroadcastFloat32x4(MlasErfConstants.alpha_2));
+        p = MlasMultiplyAddFloat32x4(p, t, MlasBroadcastFloat32x4(MlasErfConstants.alpha_1));
+        p = MlasMultiplyFloat32x4(p, t);
+
+        MLAS_FLOAT32X4 NegativeValueSquared =
+            MlasSubtractFloat32x4(MlasZeroFloat32x4(), MlasMultiplyFloat32x4(AbsValue, AbsValue));
+
+        p = MlasSubtractFloat32x4(One,
+            MlasMultiplyFloat32x4(p, MlasExpFloat32x4(NegativeValueSquared)));
+
+        MlasStoreFloat32x4(Output, MlasCopySignFloat32x4(p, Value));
+
+        Input += 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+
+        float Value = *Input++;
+
+        float AbsValue = fabsf(Value);
+
+        float t = MlasErfConstants.One /
+            (AbsValue * MlasErfConstants.ScaleReciprocal + MlasErfConstants.One);
+
+        float p;
+        p = MlasErfConstants.alpha_5 * t + MlasErfConstants.alpha_4;
+        p = p * t + MlasErfConstants.alpha_3;
+        p = p * t + MlasErfConstants.alpha_2;
+        p = p * t + MlasErfConstants.alpha_1;
+        p = p * t;
+
+        p = MlasErfConstants.One - p * MlasExpScalar(-AbsValue * AbsValue);
+
+        *Output++ = copysignf(p, Value);
+
+        N -= 1;
+    }
+}
+
+void
+MLASCALL
+MlasComputeErf(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the error function.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasErfKernel(Input, Output, N);
+}
@@ -0,0 +1,260 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    exp.cpp
+
+Abstract:
+
+    This module implements routines to compute the exponential function.
+
+    This implementation uses the same polynomial coefficients and algorithm as
+    found in Eigen. The implementation below targets the base instruction set
+    (typically SSE2) using the portable vector intrinsic wrappers, so the same
+    code also covers the NEON targets.
+
+    The input range is clamped to [-126*ln2, 127*ln2] so the scale factor
+    described below stays inside the exponent field of a normal single
+    precision value. Inputs beyond the upper bound saturate near FLT_MAX
+    rather than producing infinity.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Bundles the floating point constants for use by kernels written in assembly.
+//
+
+extern "C" const struct {
+    float LowerRange;
+    float UpperRange;
+    float Log2Reciprocal;
+    float MinusLn2High;
+    float MinusLn2Low;
+    float RoundingBias;
+    float poly_0;
+    float poly_1;
+    float poly_2;
+    float poly_3;
+    float poly_4;
+    float poly_5;
+    float One;
+} MlasExpConstants = {
+    -87.3365478515625f,
+    88.0296936035156f,
+    1.44269504088896341f,
+    -6.93359375e-1f,
+    2.12194440e-4f,
+    12582912.0f,
+    1.9875691500e-4f,
+    1.3981999507e-3f,
+    8.3334519073e-3f,
+    4.1665795894e-2f,
+    1.6666665459e-1f,
+    5.0000001201e-1f,
+    1.0f,
+};
+
+MLAS_FLOAT32X4
+MlasPowerOf2Float32x4(
+    MLAS_FLOAT32X4 Vector
+    )
+/*++
+
+Routine Description:
+
+    This routine computes two raised to the supplied integral valued vector
+    by constructing the exponent field of the floating point result.
+
+Arguments:
+
+    Vector - Supplies the integral valued vector.
+
+Return Value:
+
+    Returns two raised to the supplied vector.
+
+--*/
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    int32x4_t Exponent = vaddq_s32(vcvtq_s32_f32(Vector), vdupq_n_s32(127));
+    return vreinterpretq_f32_s32(vshlq_n_s32(Exponent, 23));
+#elif defined(MLAS_SSE2_INTRINSICS)
+    __m128i Exponent = _mm_add_epi32(_mm_cvttps_epi32(Vector), _mm_set1_epi32(127));
+    return _mm_castsi128_ps(_mm_slli_epi32(Exponent, 23));
+#endif
+}
+
+MLAS_FLOAT32X4
+MLASCALL
+MlasExpFloat32x4(
+    MLAS_FLOAT32X4 Value
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the exponential function for the supplied vector.
+
+    The exponent is decomposed as e^x = 2^m * e^r, where m is the rounded
+    quotient of x divided by ln2 and r is the remainder, which is small
+    enough for a low degree polynomial. The rounding is performed by adding
+    a large bias so the remainder of the addition is the rounded integer.
+
+Arguments:
+
+    Value - Supplies the input vector.
+
+Return Value:
+
+    Returns the exponential function of the input vector.
+
+--*/
+{
+    Value = MlasMaximumFloat32x4(MlasBroadcastFloat32x4(MlasExpConstants.LowerRange), Value);
+    Value = MlasMinimumFloat32x4(MlasBroadcastFloat32x4(MlasExpConstants.UpperRange), Value);
+
+    MLAS_FLOAT32X4 RoundingBias = MlasBroadcastFloat32x4(MlasExpConstants.RoundingBias);
+
+    MLAS_FLOAT32X4 m = MlasMultiplyAddFloat32x4(Value,
+        MlasBroadcastFloat32x4(MlasExpConstants.Log2Reciprocal), RoundingBias);
+    m = MlasSubtractFloat32x4(m, RoundingBias);
+
+    Value = MlasMultiplyAddFloat32x4(m, MlasBroadcastFloat32x4(MlasExpConstants.MinusLn2High), Value);
+    Value = MlasMultiplyAddFloat32x4(m, MlasBroadcastFloat32x4(MlasExpConstants.MinusLn2Low), Value);
+
+    MLAS_FLOAT32X4 p;
+    p = MlasMultiplyAddFloat32x4(MlasBroadcastFloat32x4(MlasExpConstants.poly_0), Value,
+        MlasBroadcastFloat32x4(MlasExpConstants.poly_1));
+    p = MlasMultiplyAddFloat32x4(p, Value, MlasBroadcastFloat32x4(MlasExpConstants.poly_2));
+    p = MlasMultiplyAddFloat32x4(p, Value, MlasBroadcastFloat32x4(MlasExpConstants.poly_3));
+    p = MlasMultiplyAddFloat32x4(p, Value, MlasBroadcastFloat32x4(MlasExpConstants.poly_4));
+    p = MlasMultiplyAddFloat32x4(p, Value, MlasBroadcastFloat32x4(MlasExpConstants.poly_5));
+
+    MLAS_FLOAT32X4 ValueSquared = MlasMultiplyFloat32x4(Value, Value);
+
+    p = MlasMultiplyAddFloat32x4(p, ValueSquared,
+        MlasAddFloat32x4(Value, MlasBroadcastFloat32x4(MlasExpConstants.One)));
+
+    return MlasMultiplyFloat32x4(p, MlasPowerOf2Float32x4(m));
+}
+
+float
+MLASCALL
+MlasExpScalar(
+    float Value
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the exponential function for the supplied scalar
+    using the same decomposition as the vector path.
+
+Arguments:
+
+    Value - Supplies the input value.
+
+Return Value:
+
+    Returns the exponential function of the input value.
+
+--*/
+{
+    Value = (std::min)(MlasExpConstants.UpperRange, (std::max)(MlasExpConstants.LowerRange, Value));
+
+    float m = Value * MlasExpConstants.Log2Reciprocal + MlasExpConstants.RoundingBias;
+    m -= MlasExpConstants.RoundingBias;
+
+    Value = m * MlasExpConstants.MinusLn2High + Value;
+    Value = m * MlasExpConstants.MinusLn2Low + Value;
+
+    float p;
+    p = MlasExpConstants.poly_0 * Value + MlasExpConstants.poly_1;
+    p = p * Value + MlasExpConstants.poly_2;
+    p = p * Value + MlasExpConstants.poly_3;
+    p = p * Value + MlasExpConstants.poly_4;
+    p = p * Value + MlasExpConstants.poly_5;
+    p = p * (Value * Value) + Value + MlasExpConstants.One;
+
+    return ldexpf(p, int32_t(m));
+}
+
+void
+MLASCALL
+MlasExpKernel(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel for the exponential function.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (N >= 4) {
+
+        MlasStoreFloat32x4(Output, MlasExpFloat32x4(MlasLoadFloat32x4(Input)));
+
+        Input += 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+
+        *Output++ = MlasExpScalar(*Input++);
+
+        N -= 1;
+    }
+}
+
+void
+MLASCALL
+MlasComputeExp(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the exponential function.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasExpKernel(Input, Output, N);
+}
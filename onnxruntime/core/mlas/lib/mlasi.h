@@ -20,6 +20,7 @@ Abstract:
 
 #include <mlas.h>
 #include <memory.h>
+#include <math.h>
 #include <algorithm>
 #include <limits>
 
@@ -94,6 +95,17 @@ Abstract:
 
 #define MLAS_MAXIMUM_THREAD_COUNT                   16
 
+//
+// Define the maximum factor by which threaded work may be subdivided beyond
+// the thread count for dynamic load balancing, and the resulting bound on the
+// number of work segments (see MlasExecuteThreadedBalanced).
+//
+
+#define MLAS_MAXIMUM_WORK_SUBDIVISION               4
+
+#define MLAS_MAXIMUM_SEGMENT_COUNT \
+    (MLAS_MAXIMUM_THREAD_COUNT * MLAS_MAXIMUM_WORK_SUBDIVISION)
+
 //
 // Define the default strides to step through slices of the input matrices.
 //
@@ -112,6 +124,15 @@ Abstract:
 
 #define MLAS_SGEMM_STRIDEN_THREAD_ALIGN             16
 
+//
+// Define the threshold (in elements of M * N * K) below which the narrower
+// 256-bit kernels are preferred over the AVX512F kernels. Executing 512-bit
+// instructions can lower the core frequency and a small multiplication
+// completes before the wider vectors pay for the transition.
+//
+
+#define MLAS_SGEMM_AVX512F_SMALL_THRESHOLD          (64 * 64 * 64)
+
 //
 // Define the prototypes of the platform optimized routines.
 //
@@ -205,6 +226,8 @@ extern "C" {
 
     MLAS_TANH_KERNEL_ROUTINE MlasLogisticKernel;
     MLAS_TANH_KERNEL_ROUTINE MlasTanhKernel;
+    MLAS_TANH_KERNEL_ROUTINE MlasErfKernel;
+    MLAS_TANH_KERNEL_ROUTINE MlasExpKernel;
 #if defined(MLAS_TARGET_AMD64)
     MLAS_TANH_KERNEL_ROUTINE MlasLogisticKernelFma3;
     MLAS_TANH_KERNEL_ROUTINE MlasTanhKernelFma3;
@@ -231,6 +254,17 @@ extern "C" {
 #endif
 #endif
 
+//
+// Define the minimum number of multiplications per worker thread for a
+// threaded QGEMM operation.
+//
+
+#if defined(MLAS_USE_OPENMP)
+#define MLAS_QGEMM_THREAD_COMPLEXITY                (64 * 1024)
+#else
+#define MLAS_QGEMM_THREAD_COMPLEXITY                (1 * 1024 * 1024)
+#endif
+
 //
 // Single-threaded single precision matrix/matrix multiply operation.
 //
@@ -249,9 +283,18 @@ MlasSgemmOperation(
     size_t ldb,
     float beta,
     float* C,
-    size_t ldc
+    size_t ldc,
+    bool BIsHalf
     );
 
+//
+// Application supplied threading executor (see MlasSetParallelExecutor).
+//
+
+extern MLAS_PARALLEL_EXECUTOR* MlasParallelExecutor;
+extern int32_t MlasParallelExecutorThreadCount;
+extern MLAS_PARALLEL_REGION_QUERY* MlasParallelRegionQuery;
+
 //
 // Environment information class.
 //
@@ -266,6 +309,8 @@ struct MLAS_PLATFORM {
 #endif
 
 #if defined(MLAS_TARGET_AMD64)
+    PMLAS_SGEMM_KERNEL_ROUTINE KernelZeroRoutineSmall;
+    PMLAS_SGEMM_KERNEL_ROUTINE KernelAddRoutineSmall;
     PMLAS_SGEMM_KERNEL_M1_ROUTINE KernelM1Routine;
     PMLAS_SGEMM_KERNEL_M1_ROUTINE KernelM1TransposeBRoutine;
     PMLAS_SGEMM_TRANSPOSE_PACKB_BLOCK_ROUTINE TransposePackB16x4Routine;
@@ -277,11 +322,37 @@ struct MLAS_PLATFORM {
     int32_t MaximumThreadCount;
 #endif
 
+    int32_t WorkSubdivisionFactor;
+
+    int32_t
+    GetWorkSubdivisionFactor(
+        void
+        )
+    {
+        return WorkSubdivisionFactor;
+    }
+
     int32_t
     GetMaximumThreadCount(
         void
         )
     {
+        if (MlasParallelExecutor != nullptr) {
+
+            //
+            // Fall back to a single thread inside a parallel region the
+            // executor is already running, matching the OpenMP check below;
+            // nested work would otherwise wait on workers the enclosing
+            // region occupies.
+            //
+
+            if (MlasParallelRegionQuery != nullptr && MlasParallelRegionQuery()) {
+                return 1;
+            }
+
+            return MlasParallelExecutorThreadCount;
+        }
+
 #if defined(MLAS_USE_OPENMP)
         return (omp_get_num_threads() == 1) ? omp_get_max_threads() : 1;
 #elif defined(MLAS_USE_WIN32_THREADPOOL)
@@ -297,13 +368,10 @@ extern MLAS_PLATFORM MlasPlatform;
 //
 // Threading support.
 //
-
-typedef
-void
-(MLAS_THREADED_ROUTINE)(
-    void* Context,
-    int32_t Index
-    );
+// The typedefs for MLAS_THREADED_ROUTINE and MLAS_PARALLEL_EXECUTOR live in
+// the public header so that a host application can register its own executor
+// via MlasSetParallelExecutor.
+//
 
 typedef MLAS_THREADED_ROUTINE* PMLAS_THREADED_ROUTINE;
 
@@ -314,6 +382,14 @@ MlasExecuteThreaded(
     int32_t Iterations
     );
 
+void
+MlasExecuteThreadedBalanced(
+    PMLAS_THREADED_ROUTINE ThreadedRoutine,
+    void* Context,
+    int32_t Iterations,
+    int32_t ThreadCount
+    );
+
 //
 // Define the missing ARM64 NEON intrinsic macros from arm64_neon.h that enable
 // cross-compiler support.
@@ -575,6 +651,23 @@ MlasMinimumFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
 #endif
 }
 
+//
+// Exponential function helpers implemented in exp.cpp and shared with the
+// error function and softmax kernels.
+//
+
+MLAS_FLOAT32X4
+MLASCALL
+MlasExpFloat32x4(
+    MLAS_FLOAT32X4 Value
+    );
+
+float
+MLASCALL
+MlasExpScalar(
+    float Value
+    );
+
 //
 // Reads a platform specific time stamp counter.
 //
@@ -17,6 +17,10 @@ Abstract:
 
 #include "mlasi.h"
 
+#if defined(__linux__)
+#include <stdio.h>
+#endif
+
 //
 // Stores the platform information.
 //
@@ -52,6 +56,8 @@ Return Value:
     this->KernelZeroRoutine = MlasSgemmKernelZeroSse;
     this->KernelAddRoutine = MlasSgemmKernelAddSse;
 #if defined(MLAS_TARGET_AMD64)
+    this->KernelZeroRoutineSmall = nullptr;
+    this->KernelAddRoutineSmall = nullptr;
     this->TransposePackB16x4Routine = MlasSgemmTransposePackB16x4Sse;
     this->LogisticKernelRoutine = MlasLogisticKernel;
     this->TanhKernelRoutine = MlasTanhKernel;
@@ -106,6 +112,14 @@ Return Value:
                 if (((Cpuid7[1] & 0x10000) != 0) && ((xcr0 & 0xE0) == 0xE0)) {
                     this->KernelZeroRoutine = MlasSgemmKernelZeroAvx512F;
                     this->KernelAddRoutine = MlasSgemmKernelAddAvx512F;
+
+                    //
+                    // Keep the FMA3 kernels on hand for small problems that
+                    // would be slowed by the AVX512F frequency transition.
+                    //
+
+                    this->KernelZeroRoutineSmall = MlasSgemmKernelZeroFma3;
+                    this->KernelAddRoutineSmall = MlasSgemmKernelAddFma3;
                 } else {
                     this->KernelZeroRoutine = MlasSgemmKernelZeroFma3;
                     this->KernelAddRoutine = MlasSgemmKernelAddFma3;
@@ -147,6 +161,60 @@ Return Value:
         this->MaximumThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
     }
 
+#endif
+
+    //
+    // Size the dynamic load balancing factor for this machine (see
+    // MlasExecuteThreadedBalanced). Worker threads are not bound to cores, so
+    // a factor above one lets a thread that lands on a fast core claim work a
+    // thread on a slow core or a loaded SMT sibling would otherwise finish
+    // last.
+    //
+
+    this->WorkSubdivisionFactor = 2;
+
+#if defined(__linux__)
+
+    //
+    // Probe the per-core maximum frequencies as a relative throughput weight.
+    // A wide spread marks heterogeneous (big.LITTLE style) cores, which need
+    // finer subdivision to keep the fast cores fed.
+    //
+
+    uint64_t MinimumFrequency = ~0ull;
+    uint64_t MaximumFrequency = 0;
+
+    for (int cpu = 0; cpu < MLAS_MAXIMUM_THREAD_COUNT; cpu++) {
+
+        char Path[80];
+        snprintf(Path, sizeof(Path), "/sys/devices/system/cpu/cpu%d/cpufreq/cpuinfo_max_freq", cpu);
+
+        FILE* File = fopen(Path, "r");
+
+        if (File == nullptr) {
+            break;
+        }
+
+        unsigned long long Frequency = 0;
+
+        if (fscanf(File, "%llu", &Frequency) == 1 && Frequency != 0) {
+
+            if (Frequency < MinimumFrequency) {
+                MinimumFrequency = Frequency;
+            }
+
+            if (Frequency > MaximumFrequency) {
+                MaximumFrequency = Frequency;
+            }
+        }
+
+        fclose(File);
+    }
+
+    if (MaximumFrequency >= MinimumFrequency + MinimumFrequency / 4) {
+        this->WorkSubdivisionFactor = MLAS_MAXIMUM_WORK_SUBDIVISION;
+    }
+
 #endif
 
 }
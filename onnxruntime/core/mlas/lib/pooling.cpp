@@ -16,6 +16,23 @@ Abstract:
 
 #include "mlasi.h"
 
+struct MLAS_WORK_BLOCK;
+
+//
+// Define the prototype of the pooling kernel routine.
+//
+
+typedef
+void
+(MLAS_POOL_KERNEL_ROUTINE)(
+    const MLAS_WORK_BLOCK* WorkBlock,
+    size_t ChannelCount,
+    const float* Input,
+    float* Output
+    );
+
+typedef MLAS_POOL_KERNEL_ROUTINE* PMLAS_POOL_KERNEL_ROUTINE;
+
 //
 // Define the parameters to execute segments of a pooling operation on worker
 // threads.
@@ -26,25 +43,24 @@ struct MLAS_WORK_BLOCK {
     size_t InputShape[3];
     size_t InputSize;
     size_t OutputShape[3];
+    size_t OutputSize;
     int64_t KernelShape[3];
     int64_t Padding[6];
     int64_t StrideShape[3];
+    PMLAS_POOL_KERNEL_ROUTINE PoolKernelRoutine;
+    const float* Input;
+    float* Output;
+    size_t TotalChannelCount;
+    int32_t TargetThreadCount;
 };
 
 //
-// Define the prototype of the pooling kernel routine.
+// Define the minimum number of input elements each worker thread should
+// process. Pooling is memory bound, so smaller tensors are not worth the
+// cost of waking the worker threads.
 //
 
-typedef
-void
-(MLAS_POOL_KERNEL_ROUTINE)(
-    const MLAS_WORK_BLOCK* WorkBlock,
-    size_t ChannelCount,
-    const float* Input,
-    float* Output
-    );
-
-typedef MLAS_POOL_KERNEL_ROUTINE* PMLAS_POOL_KERNEL_ROUTINE;
+#define MLAS_POOL_THREAD_COMPLEXITY         (size_t(16384))
 
 //
 // Define the number of elements to allocate on the stack for the reduction
@@ -1171,6 +1187,64 @@ static const PMLAS_POOL_KERNEL_ROUTINE MlasPoolVectorKernels[][2] =
     },
 };
 
+void
+MlasPoolThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    pooling operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_WORK_BLOCK* WorkBlock = (const MLAS_WORK_BLOCK*)Context;
+
+    //
+    // Compute the range of channels to use for this thread.
+    //
+
+    const size_t TotalChannelCount = WorkBlock->TotalChannelCount;
+    const size_t TargetThreadCount = WorkBlock->TargetThreadCount;
+
+    const size_t ChannelCountPerThread = TotalChannelCount / TargetThreadCount;
+    const size_t ChannelCountExtra = TotalChannelCount % TargetThreadCount;
+
+    size_t ChannelStart;
+    size_t ChannelCount;
+
+    if (uint32_t(Index) < ChannelCountExtra) {
+        ChannelStart = (ChannelCountPerThread + 1) * Index;
+        ChannelCount = ChannelCountPerThread + 1;
+    } else {
+        ChannelStart = ChannelCountPerThread * Index + ChannelCountExtra;
+        ChannelCount = ChannelCountPerThread;
+    }
+
+    //
+    // Invoke the pooling kernel with the slab of channels allocated to this
+    // thread.
+    //
+
+    WorkBlock->PoolKernelRoutine(WorkBlock,
+                                 ChannelCount,
+                                 WorkBlock->Input + ChannelStart * WorkBlock->InputSize,
+                                 WorkBlock->Output + ChannelStart * WorkBlock->OutputSize);
+}
+
 void
 MLASCALL
 MlasPool(
@@ -1278,6 +1352,7 @@ Return Value:
     }
 
     WorkBlock.InputSize = InputSize;
+    WorkBlock.OutputSize = OutputSize;
 
     //
     // Determine which pooling kernel routine to use.
@@ -1328,7 +1403,38 @@ Return Value:
 
 #else
 
-    PoolKernelRoutine(&WorkBlock, TotalChannelCount, Input, Output);
+    //
+    // Partition the batch and channel slabs of the input tensor across the
+    // worker threads. Cap the thread count when the tensor is too small to
+    // cover the cost of waking the worker threads.
+    //
+
+    int32_t TargetThreadCount = MlasPlatform.GetMaximumThreadCount();
+
+    const size_t MaximumThreadsForWork = (TotalChannelCount * InputSize) / MLAS_POOL_THREAD_COMPLEXITY + 1;
+
+    if (size_t(TargetThreadCount) > MaximumThreadsForWork) {
+        TargetThreadCount = int32_t(MaximumThreadsForWork);
+    }
+
+    if (size_t(TargetThreadCount) > TotalChannelCount) {
+        TargetThreadCount = int32_t(TotalChannelCount);
+    }
+
+    if (TargetThreadCount <= 1) {
+
+        PoolKernelRoutine(&WorkBlock, TotalChannelCount, Input, Output);
+
+    } else {
+
+        WorkBlock.PoolKernelRoutine = PoolKernelRoutine;
+        WorkBlock.Input = Input;
+        WorkBlock.Output = Output;
+        WorkBlock.TotalChannelCount = TotalChannelCount;
+        WorkBlock.TargetThreadCount = TargetThreadCount;
+
+        MlasExecuteThreaded(MlasPoolThreaded, &WorkBlock, TargetThreadCount);
+    }
 
 #endif
 
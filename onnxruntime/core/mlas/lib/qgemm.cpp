@@ -0,0 +1,489 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    qgemm.cpp
+
+Abstract:
+
+    This module implements the quantized integer matrix/matrix multiply
+    operation (QGEMM).
+
+    The inputs are 8-bit integer matrices with zero point offsets and the
+    output is a 32-bit integer matrix of the de-offset products:
+
+        C = (A - offa) * (B - offb)
+
+    The implementation expands the product using precomputed row and column
+    sums, so the inner loop multiplies the raw matrix data without applying
+    the zero point offsets:
+
+        C = A * B - offb * rowsum(A) - offa * colsum(B) + K * offa * offb
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the stride to step through slices of the input matrices.
+//
+
+#define MLAS_QGEMM_STRIDEN                  128
+
+//
+// Define the parameters to execute segments of a QGEMM operation on worker
+// threads.
+//
+
+struct MLAS_QGEMM_WORK_BLOCK {
+    size_t K;
+    size_t lda;
+    size_t ldb;
+    size_t ldc;
+    uint8_t offa;
+    uint8_t offb;
+    bool BIsSigned;
+    struct SEGMENT {
+        size_t M;
+        size_t N;
+        const uint8_t* A;
+        const uint8_t* B;
+        int32_t* C;
+    } Segments[MLAS_MAXIMUM_THREAD_COUNT];
+};
+
+template<typename BElementType>
+void
+MlasQgemmOperation(
+    size_t M,
+    size_t N,
+    size_t K,
+    const uint8_t* A,
+    size_t lda,
+    int32_t offa,
+    const BElementType* B,
+    size_t ldb,
+    int32_t offb,
+    int32_t* C,
+    size_t ldc
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the quantized integer matrix/matrix multiply
+    operation (QGEMM).
+
+Arguments:
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    offa - Supplies the zero point offset of matrix A.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    offb - Supplies the zero point offset of matrix B.
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    int32_t Accumulators[MLAS_QGEMM_STRIDEN];
+    int32_t ColumnSums[MLAS_QGEMM_STRIDEN];
+
+    //
+    // Step through each strip of the input matrices along the N dimension.
+    //
+
+    size_t CountN;
+
+    for (size_t n = 0; n < N; n += CountN) {
+
+        CountN = MLAS_QGEMM_STRIDEN;
+
+        if (CountN > (N - n)) {
+            CountN = N - n;
+        }
+
+        //
+        // Compute the column sums of the raw data from matrix B used by the
+        // zero point offset expansion.
+        //
+
+        for (size_t j = 0; j < CountN; j++) {
+            ColumnSums[j] = 0;
+        }
+
+        for (size_t k = 0; k < K; k++) {
+
+            const BElementType* b = B + k * ldb + n;
+
+            for (size_t j = 0; j < CountN; j++) {
+                ColumnSums[j] += b[j];
+            }
+        }
+
+        int32_t KTimesOffaOffb = int32_t(K) * offa * offb;
+
+        //
+        // Step through each row of matrix A and accumulate a row of products
+        // into the local buffer, then apply the zero point offset expansion
+        // and store the results to matrix C.
+        //
+
+        for (size_t m = 0; m < M; m++) {
+
+            for (size_t j = 0; j < CountN; j++) {
+                Accumulators[j] = 0;
+            }
+
+            const uint8_t* a = A + m * lda;
+            int32_t RowSum = 0;
+
+            for (size_t k = 0; k < K; k++) {
+
+                int32_t AValue = a[k];
+                RowSum += AValue;
+
+                const BElementType* b = B + k * ldb + n;
+
+                for (size_t j = 0; j < CountN; j++) {
+                    Accumulators[j] += AValue * b[j];
+                }
+            }
+
+            int32_t* c = C + m * ldc + n;
+
+            for (size_t j = 0; j < CountN; j++) {
+                c[j] = Accumulators[j] - offb * RowSum - offa * ColumnSums[j] +
+                    KTimesOffaOffb;
+            }
+        }
+    }
+}
+
+inline
+void
+MlasQgemmOperationDispatch(
+    size_t M,
+    size_t N,
+    size_t K,
+    const uint8_t* A,
+    size_t lda,
+    uint8_t offa,
+    const uint8_t* B,
+    size_t ldb,
+    uint8_t offb,
+    bool BIsSigned,
+    int32_t* C,
+    size_t ldc
+    )
+/*++
+
+Routine Description:
+
+    This routine dispatches a QGEMM operation based on the signedness of the
+    data from matrix B.
+
+Arguments:
+
+    Same as MlasQgemm.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (BIsSigned) {
+        MlasQgemmOperation<int8_t>(M, N, K, A, lda, offa, (const int8_t*)B,
+            ldb, int32_t(int8_t(offb)), C, ldc);
+    } else {
+        MlasQgemmOperation<uint8_t>(M, N, K, A, lda, offa, B, ldb, offb, C,
+            ldc);
+    }
+}
+
+void
+MlasQgemmOperationThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    QGEMM operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_QGEMM_WORK_BLOCK* WorkBlock = (MLAS_QGEMM_WORK_BLOCK*)Context;
+
+    MLAS_QGEMM_WORK_BLOCK::SEGMENT* Segment = &WorkBlock->Segments[Index];
+
+    MlasQgemmOperationDispatch(Segment->M, Segment->N, WorkBlock->K,
+        Segment->A, WorkBlock->lda, WorkBlock->offa, Segment->B,
+        WorkBlock->ldb, WorkBlock->offb, WorkBlock->BIsSigned, Segment->C,
+        WorkBlock->ldc);
+}
+
+inline
+bool
+MlasQgemmTryMultithread(
+    size_t M,
+    size_t N,
+    size_t K,
+    const uint8_t* A,
+    size_t lda,
+    uint8_t offa,
+    const uint8_t* B,
+    size_t ldb,
+    uint8_t offb,
+    bool BIsSigned,
+    int32_t* C,
+    size_t ldc
+    )
+/*++
+
+Routine Description:
+
+    This routine attempts to launch a quantized integer matrix/matrix
+    multiply operation (QGEMM) across multiple threads.
+
+Arguments:
+
+    Same as MlasQgemm.
+
+Return Value:
+
+    Returns true if the operation was completed across multiple threads, else
+    false if the operation should fall back to a single thread.
+
+--*/
+{
+
+#if defined(MLAS_HAS_THREADING_SUPPORT)
+
+    MLAS_QGEMM_WORK_BLOCK WorkBlock;
+    int32_t TargetThreadCount;
+
+    //
+    // Compute the number of target threads given the complexity of the QGEMM
+    // operation. Small requests should run using the single threaded path.
+    //
+
+    double Complexity = double(M) * double(N) * double(K);
+
+    if (Complexity < double(MLAS_QGEMM_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
+        TargetThreadCount = int32_t(Complexity / double(MLAS_QGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    int32_t MaximumThreadCount = MlasPlatform.GetMaximumThreadCount();
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    if (TargetThreadCount == 1) {
+        return false;
+    }
+
+    //
+    // Initialize the common fields of the work block.
+    //
+
+    WorkBlock.K = K;
+    WorkBlock.lda = lda;
+    WorkBlock.ldb = ldb;
+    WorkBlock.ldc = ldc;
+    WorkBlock.offa = offa;
+    WorkBlock.offb = offb;
+    WorkBlock.BIsSigned = BIsSigned;
+
+    //
+    // Segment the operation across multiple threads.
+    //
+
+    int32_t Index = 0;
+
+    if (N > M) {
+
+        size_t StrideN = N / TargetThreadCount;
+
+        if ((StrideN * TargetThreadCount) != N) {
+            StrideN++;
+        }
+
+        for (size_t CountN, n = 0; n < N; n += CountN) {
+
+            CountN = StrideN;
+
+            if (CountN > (N - n)) {
+                CountN = N - n;
+            }
+
+            WorkBlock.Segments[Index].M = M;
+            WorkBlock.Segments[Index].N = CountN;
+            WorkBlock.Segments[Index].A = A;
+            WorkBlock.Segments[Index].B = B + n;
+            WorkBlock.Segments[Index].C = C + n;
+
+            Index++;
+        }
+
+    } else {
+
+        size_t StrideM = M / TargetThreadCount;
+
+        if ((StrideM * TargetThreadCount) != M) {
+            StrideM++;
+        }
+
+        for (size_t CountM, m = 0; m < M; m += CountM) {
+
+            CountM = StrideM;
+
+            if (CountM > (M - m)) {
+                CountM = M - m;
+            }
+
+            WorkBlock.Segments[Index].M = CountM;
+            WorkBlock.Segments[Index].N = N;
+            WorkBlock.Segments[Index].A = A + m * lda;
+            WorkBlock.Segments[Index].B = B;
+            WorkBlock.Segments[Index].C = C + m * ldc;
+
+            Index++;
+        }
+    }
+
+    MlasExecuteThreaded(MlasQgemmOperationThreaded, &WorkBlock, Index);
+
+    return true;
+
+#else
+
+    //
+    // No threading implementation is available.
+    //
+
+    MLAS_UNREFERENCED_PARAMETER(M);
+    MLAS_UNREFERENCED_PARAMETER(N);
+    MLAS_UNREFERENCED_PARAMETER(K);
+    MLAS_UNREFERENCED_PARAMETER(A);
+    MLAS_UNREFERENCED_PARAMETER(lda);
+    MLAS_UNREFERENCED_PARAMETER(offa);
+    MLAS_UNREFERENCED_PARAMETER(B);
+    MLAS_UNREFERENCED_PARAMETER(ldb);
+    MLAS_UNREFERENCED_PARAMETER(offb);
+    MLAS_UNREFERENCED_PARAMETER(BIsSigned);
+    MLAS_UNREFERENCED_PARAMETER(C);
+    MLAS_UNREFERENCED_PARAMETER(ldc);
+
+    return false;
+
+#endif
+
+}
+
+void
+MLASCALL
+MlasQgemm(
+    size_t M,
+    size_t N,
+    size_t K,
+    const uint8_t* A,
+    size_t lda,
+    uint8_t offa,
+    const uint8_t* B,
+    size_t ldb,
+    uint8_t offb,
+    bool BIsSigned,
+    int32_t* C,
+    size_t ldc
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the quantized integer matrix/matrix multiply
+    operation (QGEMM).
+
+Arguments:
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    offa - Supplies the zero point offset of matrix A.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    offb - Supplies the zero point offset of matrix B. The value is
+        reinterpreted as a signed integer when BIsSigned is true.
+
+    BIsSigned - Supplies true if matrix B contains signed data, else false if
+        matrix B contains unsigned data.
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    //
+    // Try to run the operation across multiple threads or fall back to a
+    // single thread based on the QGEMM parameters and system configuration.
+    //
+
+    if (!MlasQgemmTryMultithread(M, N, K, A, lda, offa, B, ldb, offb, BIsSigned, C, ldc)) {
+        MlasQgemmOperationDispatch(M, N, K, A, lda, offa, B, ldb, offb, BIsSigned, C, ldc);
+    }
+}
@@ -26,6 +26,15 @@ Abstract:
 
 #define MLAS_SGEMM_TRANSA_ROWS              12
 
+//
+// Define the alignment of the packed copy of matrix B built by
+// MlasSgemmPackB. The kernels use aligned vector loads from the packed
+// buffer, so the buffer is aligned to the same boundary as the local
+// packed buffer used by MlasSgemmOperation.
+//
+
+#define MLAS_SGEMM_PACKED_B_ALIGNMENT       (16 * sizeof(float))
+
 //
 // Define the parameters to execute segments of a SGEMM operation on worker
 // threads.
@@ -40,13 +49,15 @@ struct MLAS_SGEMM_WORK_BLOCK {
     size_t ldc;
     float alpha;
     float beta;
+    bool BIsPacked;
+    bool BIsHalf;
     struct SEGMENT {
         size_t M;
         size_t N;
         const float* A;
         const float* B;
         float* C;
-    } Segments[MLAS_MAXIMUM_THREAD_COUNT];
+    } Segments[MLAS_MAXIMUM_SEGMENT_COUNT];
 };
 
 #if defined(MLAS_TARGET_AMD64_IX86)
@@ -384,6 +395,233 @@ Return Value:
     }
 }
 
+inline
+float
+MlasSgemmHalfToFloat(
+    uint16_t Value
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a half-precision float to a single precision float.
+
+    The algorithm mirrors the vectorized sequence used by the routines below
+    and by amd64/cvtfp16a.asm, including the handling of infinities, NaNs and
+    denormals.
+
+Arguments:
+
+    Value - Supplies the half-precision float encoded as an unsigned short.
+
+Return Value:
+
+    Returns the converted single precision float.
+
+--*/
+{
+    uint32_t Sign = (uint32_t(Value) & 0x8000) << 16;
+    uint32_t ExponentMantissa = uint32_t(Value) & 0x7FFF;
+    uint32_t Bits;
+
+    if (ExponentMantissa >= 0x7C00) {
+
+        //
+        // Infinity/NaN: force the single precision exponent to all ones.
+        //
+
+        Bits = (ExponentMantissa << 13) + 0x70000000;
+
+    } else if (ExponentMantissa >= 0x0400) {
+
+        //
+        // Normal value: rebias the exponent from 15 to 127.
+        //
+
+        Bits = (ExponentMantissa << 13) + 0x38000000;
+
+    } else {
+
+        //
+        // Zero/denormal: scale the mantissa into the normal range using
+        // float arithmetic.
+        //
+
+        float Denormal;
+        Bits = (ExponentMantissa << 13) + 0x38800000;
+        memcpy(&Denormal, &Bits, sizeof(Bits));
+        Denormal -= 6.103515625e-05f;
+        memcpy(&Bits, &Denormal, sizeof(Bits));
+    }
+
+    Bits |= Sign;
+
+    float Result;
+    memcpy(&Result, &Bits, sizeof(Result));
+    return Result;
+}
+
+inline
+void
+MlasSgemmConvertHalfToFloat4(
+    const uint16_t* Source,
+    float* Destination
+    )
+/*++
+
+Routine Description:
+
+    This routine converts four half-precision floats to single precision
+    floats.
+
+Arguments:
+
+    Source - Supplies the address of four half-precision floats.
+
+    Destination - Supplies the address to store four single precision floats.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_SSE2_INTRINSICS)
+
+    //
+    // This sequence matches amd64/cvtfp16a.asm.
+    //
+
+    __m128i V = _mm_loadl_epi64((const __m128i*)Source);
+    V = _mm_unpacklo_epi16(V, V);
+
+    __m128i ExponentMantissa = _mm_and_si128(V, _mm_set1_epi32(0x00007FFF));
+    __m128i Sign = _mm_slli_epi32(_mm_xor_si128(V, ExponentMantissa), 16);
+
+    __m128i InfinityNaNAdjust =
+        _mm_andnot_si128(_mm_cmpgt_epi32(_mm_set1_epi32(0x00007C00), ExponentMantissa),
+            _mm_set1_epi32(0x38000000));
+    __m128i DenormalMask = _mm_cmpgt_epi32(_mm_set1_epi32(0x00000400), ExponentMantissa);
+
+    __m128i Shifted = _mm_slli_epi32(ExponentMantissa, 13);
+    __m128i Normal = _mm_add_epi32(_mm_add_epi32(Shifted, _mm_set1_epi32(0x38000000)),
+        InfinityNaNAdjust);
+    __m128 MagicDenormal = _mm_castsi128_ps(_mm_set1_epi32(0x38800000));
+    __m128i Denormal = _mm_castps_si128(
+        _mm_sub_ps(_mm_castsi128_ps(_mm_add_epi32(Shifted, _mm_set1_epi32(0x38800000))),
+            MagicDenormal));
+
+    __m128i Blended = _mm_or_si128(_mm_and_si128(DenormalMask, Denormal),
+        _mm_andnot_si128(DenormalMask, Normal));
+
+    _mm_storeu_ps(Destination, _mm_castsi128_ps(_mm_or_si128(Blended, Sign)));
+
+#elif defined(MLAS_NEON_INTRINSICS) && defined(MLAS_TARGET_ARM64)
+
+    vst1q_f32(Destination, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(Source))));
+
+#else
+
+    for (unsigned i = 0; i < 4; i++) {
+        Destination[i] = MlasSgemmHalfToFloat(Source[i]);
+    }
+
+#endif
+}
+
+void
+MlasSgemmCopyPackBHalf(
+    float* D,
+    const uint16_t* B,
+    size_t ldb,
+    size_t CountX,
+    size_t CountY
+    )
+/*++
+
+Routine Description:
+
+    This routine copies elements from a half-precision source matrix to the
+    destination packed buffer, converting them to single precision on the
+    fly, so matrix B is read from memory at half the bandwidth of
+    MlasSgemmCopyPackB.
+
+    Columns of 16 elements from the source matrix are unrolled to be physically
+    contiguous for better locality inside the SGEMM kernels. Any remaining
+    columns less than 16 elements wide are zero-padded.
+
+Arguments:
+
+    D - Supplies the address of the destination packed buffer.
+
+    B - Supplies the address of the half-precision source matrix.
+
+    ldb - Supplies the number of elements per row of the source matrix.
+
+    CountX - Supplies the number of columns of the source matrix to copy.
+
+    CountY - Supplies the number of rows of the source matrix to copy.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    //
+    // Convert data from matrix B into the destination buffer 16 columns at a
+    // time.
+    //
+
+    while (CountX >= 16) {
+
+        const uint16_t* b = B;
+        size_t y = CountY;
+
+        do {
+
+            MlasSgemmConvertHalfToFloat4(&b[0], &D[0]);
+            MlasSgemmConvertHalfToFloat4(&b[4], &D[4]);
+            MlasSgemmConvertHalfToFloat4(&b[8], &D[8]);
+            MlasSgemmConvertHalfToFloat4(&b[12], &D[12]);
+
+            D += 16;
+            b += ldb;
+            y--;
+
+        } while (y > 0);
+
+        B += 16;
+        CountX -= 16;
+    }
+
+    //
+    // Special case the handling of the remaining columns less than 16 elements
+    // wide.
+    //
+
+    if (CountX > 0) {
+
+        size_t y = CountY;
+
+        do {
+
+            for (unsigned i = 0; i < 16; i++) {
+                D[i] = 0.0f;
+            }
+
+            for (size_t x = 0; x < CountX; x++) {
+                D[x] = MlasSgemmHalfToFloat(B[x]);
+            }
+
+            D += 16;
+            B += ldb;
+            y--;
+
+        } while (y > 0);
+    }
+}
+
 template<unsigned N>
 inline
 void
@@ -773,56 +1011,40 @@ Return Value:
 }
 
 void
-MlasSgemmOperation(
-    CBLAS_TRANSPOSE TransA,
-    CBLAS_TRANSPOSE TransB,
-    size_t M,
-    size_t N,
-    size_t K,
-    float alpha,
-    const float* A,
-    size_t lda,
-    const float* B,
+MlasSgemmTransposePackBHalf(
+    float* D,
+    const uint16_t* B,
     size_t ldb,
-    float beta,
-    float* C,
-    size_t ldc
+    size_t CountY,
+    size_t CountX
     )
 /*++
 
 Routine Description:
 
-    This routine implements the single precision matrix/matrix multiply
-    operation (SGEMM).
-
-Arguments:
-
-    TransA - Supplies the transpose operation for matrix A.
-
-    TransB - Supplies the transpose operation for matrix B.
-
-    M - Supplies the number of rows of matrix A and matrix C.
-
-    N - Supplies the number of columns of matrix B and matrix C.
-
-    K - Supplies the number of columns of matrix A and the number of rows of
-        matrix B.
+    This routine transposes elements from a half-precision source matrix to
+    the destination packed buffer, converting them to single precision on the
+    fly, so matrix B is read from memory at half the bandwidth of
+    MlasSgemmTransposePackB.
 
-    alpha - Supplies the scaler alpha multiplier (see SGEMM definition).
+    Columns of 16 elements from the source matrix are unrolled to be physically
+    contiguous for better locality inside the SGEMM kernels. Any remaining
+    columns less than 16 elements wide are zero-padded.
 
-    A - Supplies the address of matrix A.
+    The element conversions are scalar; the packed panels are small enough to
+    stay cache resident, so the savings in memory bandwidth dominate.
 
-    lda - Supplies the first dimension of matrix A.
+Arguments:
 
-    B - Supplies the address of matrix B.
+    D - Supplies the address of the destination packed buffer.
 
-    ldb - Supplies the first dimension of matrix B.
+    B - Supplies the address of the half-precision source matrix.
 
-    beta - Supplies the scaler beta multiplier (see SGEMM definition).
+    ldb - Supplies the number of elements per row of the source matrix.
 
-    C - Supplies the address of matrix C.
+    CountY - Supplies the number of rows of the source matrix to transpose.
 
-    ldc - Supplies the first dimension of matrix C.
+    CountX - Supplies the number of columns of the source matrix to transpose.
 
 Return Value:
 
@@ -830,57 +1052,351 @@ Return Value:
 
 --*/
 {
-    float PanelA[MLAS_SGEMM_TRANSA_ROWS * MLAS_SGEMM_STRIDEK];
-    MLAS_DECLSPEC_ALIGN(float PanelB[MLAS_SGEMM_STRIDEN * MLAS_SGEMM_STRIDEK], 16 * sizeof(float));
+    while (CountY > 0) {
 
-    //
-    // Handle the special case of a small M. The data from matrix B is not
-    // referenced multiple times, so using a local packed buffer is a wasted
-    // memory copy.
-    //
+        size_t Rows = (CountY >= 16) ? 16 : CountY;
 
-    if (M == 1 && TransA == CblasNoTrans && alpha == 1.0f && (beta == 0.0f || beta == 1.0f)) {
+        //
+        // Zero the entire column chunk first when it cannot be filled, so
+        // the trailing columns are zero-padded.
+        //
 
-#if defined(MLAS_TARGET_AMD64)
+        if (Rows < 16) {
 
-        PMLAS_SGEMM_KERNEL_M1_ROUTINE SgemmKernelM1Routine;
+            MLAS_FLOAT32X4 ZeroFloat32x4 = MlasZeroFloat32x4();
 
-        if (TransB == CblasNoTrans) {
-            SgemmKernelM1Routine = MlasPlatform.KernelM1Routine;
-        } else {
-            SgemmKernelM1Routine = MlasPlatform.KernelM1TransposeBRoutine;
+            for (size_t x = 0; x < CountX * 16; x += 4) {
+                MlasStoreAlignedFloat32x4(&D[x], ZeroFloat32x4);
+            }
         }
 
-        if (SgemmKernelM1Routine != nullptr) {
-            SgemmKernelM1Routine(A, B, C, K, N, ldb, beta);
-            return;
-        }
+        for (size_t y = 0; y < Rows; y++) {
 
-#endif
+            const uint16_t* b = B + y * ldb;
+            float* d = D + y;
+
+            for (size_t x = 0; x < CountX; x++) {
+                d[x * 16] = MlasSgemmHalfToFloat(b[x]);
+            }
+        }
 
+        D += CountX * 16;
+        B += ldb * 16;
+        CountY -= Rows;
     }
+}
 
-    //
-    // Compute the strides to step through slices of the input matrices.
-    //
-    // Expand the N stride if K is small or expand the K stride if N is small
-    // for better utilization of the B panel. Avoid changing the K stride if
-    // the A panel needs to be used for transposing.
-    //
+template<size_t RowCount>
+void
+MlasSgemmKernelSmallM(
+    const float* A,
+    const float* B,
+    float* C,
+    size_t CountK,
+    size_t CountN,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    float beta
+    )
+/*++
 
-    uint32_t StrideN = MLAS_SGEMM_STRIDEN;
-    uint32_t StrideK = MLAS_SGEMM_STRIDEK;
+Routine Description:
 
-    if (N >= K) {
+    This routine is an inner kernel to compute matrix multiplication for a
+    small fixed number of rows of matrix A.
 
-        while (StrideK / 2 >= K) {
-            StrideN *= 2;
-            StrideK /= 2;
-        }
+    Matrix B is consumed directly from memory: each row is read exactly once
+    per output block, so copying to a local packed buffer is a wasted memory
+    copy for these shapes. The row count is a template parameter so the
+    accumulators for every row stay resident in registers across the K loop.
 
-    } else if (TransA == CblasNoTrans) {
+Arguments:
 
-        while (StrideN > 16 && StrideN / 2 >= N) {
+    A - Supplies the address of matrix A.
+
+    B - Supplies the address of matrix B.
+
+    C - Supplies the address of matrix C.
+
+    CountK - Supplies the number of columns from matrix A and the number of
+        rows from matrix B to iterate over.
+
+    CountN - Supplies the number of columns from matrix B and matrix C to
+        iterate over.
+
+    lda - Supplies the first dimension of matrix A.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    beta - Supplies the scaler beta multiplier (see SGEMM definition). The
+        value must be zero or one.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (CountN >= 4) {
+
+        MLAS_FLOAT32X4 Accumulators[RowCount];
+
+        for (size_t row = 0; row < RowCount; row++) {
+            Accumulators[row] = MlasZeroFloat32x4();
+        }
+
+        const float* b = B;
+
+        for (size_t k = 0; k < CountK; k++) {
+
+            MLAS_FLOAT32X4 BElements = MlasLoadFloat32x4(b);
+
+            for (size_t row = 0; row < RowCount; row++) {
+                Accumulators[row] = MlasMultiplyAddFloat32x4(MlasBroadcastFloat32x4(A[row * lda + k]),
+                    BElements, Accumulators[row]);
+            }
+
+            b += ldb;
+        }
+
+        for (size_t row = 0; row < RowCount; row++) {
+
+            if (beta != 0.0f) {
+                Accumulators[row] = MlasAddFloat32x4(Accumulators[row], MlasLoadFloat32x4(&C[row * ldc]));
+            }
+
+            MlasStoreFloat32x4(&C[row * ldc], Accumulators[row]);
+        }
+
+        B += 4;
+        C += 4;
+        CountN -= 4;
+    }
+
+    //
+    // Handle the remaining 1-3 columns of the output block.
+    //
+
+    for (size_t n = 0; n < CountN; n++) {
+
+        for (size_t row = 0; row < RowCount; row++) {
+
+            float Accumulator = 0.0f;
+            const float* a = A + row * lda;
+            const float* b = B + n;
+
+            for (size_t k = 0; k < CountK; k++) {
+                Accumulator += a[k] * b[0];
+                b += ldb;
+            }
+
+            if (beta != 0.0f) {
+                Accumulator += C[row * ldc + n];
+            }
+
+            C[row * ldc + n] = Accumulator;
+        }
+    }
+}
+
+#if defined(MLAS_TARGET_AMD64_IX86)
+
+PMLAS_SGEMM_KERNEL_ROUTINE
+MlasSgemmSelectKernelRoutine(
+    bool ZeroMode,
+    size_t M,
+    size_t N,
+    size_t K
+    )
+/*++
+
+Routine Description:
+
+    This routine selects the kernel routine to use for the current panel.
+
+    Processors that dispatch to the AVX512F kernels fall back to the
+    narrower FMA3 kernels for small problems: executing 512-bit
+    instructions can lower the core frequency and a small multiplication
+    completes before the wider vectors pay for the transition.
+
+Arguments:
+
+    ZeroMode - Supplies true if the output matrix is zeroed before use,
+        else false if the output matrix is accumulated into.
+
+    M, N, K - Supplies the dimensions of the operation.
+
+Return Value:
+
+    Returns the address of the kernel routine.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+
+    if ((M * N * K) < MLAS_SGEMM_AVX512F_SMALL_THRESHOLD &&
+        MlasPlatform.KernelZeroRoutineSmall != nullptr) {
+        return ZeroMode ? MlasPlatform.KernelZeroRoutineSmall : MlasPlatform.KernelAddRoutineSmall;
+    }
+
+#else
+
+    MLAS_UNREFERENCED_PARAMETER(M);
+    MLAS_UNREFERENCED_PARAMETER(N);
+    MLAS_UNREFERENCED_PARAMETER(K);
+
+#endif
+
+    return ZeroMode ? MlasPlatform.KernelZeroRoutine : MlasPlatform.KernelAddRoutine;
+}
+
+#endif
+
+void
+MlasSgemmOperation(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const float* B,
+    size_t ldb,
+    float beta,
+    float* C,
+    size_t ldc,
+    bool BIsHalf
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision matrix/matrix multiply
+    operation (SGEMM).
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    alpha - Supplies the scaler alpha multiplier (see SGEMM definition).
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    beta - Supplies the scaler beta multiplier (see SGEMM definition).
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    BIsHalf - Supplies true if matrix B stores half-precision floats that are
+        converted to single precision while packing panels.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    float PanelA[MLAS_SGEMM_TRANSA_ROWS * MLAS_SGEMM_STRIDEK];
+    MLAS_DECLSPEC_ALIGN(float PanelB[MLAS_SGEMM_STRIDEN * MLAS_SGEMM_STRIDEK], 16 * sizeof(float));
+
+    //
+    // Handle the special case of a small M. The data from matrix B is not
+    // referenced multiple times, so using a local packed buffer is a wasted
+    // memory copy. The small M kernels consume matrix B directly, so this
+    // path cannot be used when matrix B needs conversion.
+    //
+
+    if (M == 1 && !BIsHalf && TransA == CblasNoTrans && alpha == 1.0f && (beta == 0.0f || beta == 1.0f)) {
+
+#if defined(MLAS_TARGET_AMD64)
+
+        PMLAS_SGEMM_KERNEL_M1_ROUTINE SgemmKernelM1Routine;
+
+        if (TransB == CblasNoTrans) {
+            SgemmKernelM1Routine = MlasPlatform.KernelM1Routine;
+        } else {
+            SgemmKernelM1Routine = MlasPlatform.KernelM1TransposeBRoutine;
+        }
+
+        if (SgemmKernelM1Routine != nullptr) {
+            SgemmKernelM1Routine(A, B, C, K, N, ldb, beta);
+            return;
+        }
+
+#endif
+
+    }
+
+    //
+    // Handle the remaining small M shapes that the platform single row
+    // kernels above do not cover. Recurrent cells produce a steady stream of
+    // these tall-and-skinny multiplies, where the cost of packing matrix B
+    // exceeds the arithmetic.
+    //
+
+    if (M <= 4 && !BIsHalf && TransA == CblasNoTrans && TransB == CblasNoTrans &&
+        alpha == 1.0f && (beta == 0.0f || beta == 1.0f)) {
+
+        switch (M) {
+            case 1:
+                MlasSgemmKernelSmallM<1>(A, B, C, K, N, lda, ldb, ldc, beta);
+                break;
+            case 2:
+                MlasSgemmKernelSmallM<2>(A, B, C, K, N, lda, ldb, ldc, beta);
+                break;
+            case 3:
+                MlasSgemmKernelSmallM<3>(A, B, C, K, N, lda, ldb, ldc, beta);
+                break;
+            case 4:
+                MlasSgemmKernelSmallM<4>(A, B, C, K, N, lda, ldb, ldc, beta);
+                break;
+        }
+
+        return;
+    }
+
+    //
+    // Compute the strides to step through slices of the input matrices.
+    //
+    // Expand the N stride if K is small or expand the K stride if N is small
+    // for better utilization of the B panel. Avoid changing the K stride if
+    // the A panel needs to be used for transposing.
+    //
+
+    uint32_t StrideN = MLAS_SGEMM_STRIDEN;
+    uint32_t StrideK = MLAS_SGEMM_STRIDEK;
+
+    if (N >= K) {
+
+        while (StrideK / 2 >= K) {
+            StrideN *= 2;
+            StrideK /= 2;
+        }
+
+    } else if (TransA == CblasNoTrans) {
+
+        while (StrideN > 16 && StrideN / 2 >= N) {
             StrideK *= 2;
             StrideN /= 2;
         }
@@ -922,13 +1438,23 @@ Return Value:
             }
 
             //
-            // Copy or transpose a panel of matrix B to a local packed buffer.
+            // Copy or transpose a panel of matrix B to a local packed buffer,
+            // converting half-precision storage to single precision on the
+            // fly as needed.
             //
 
             if (TransB == CblasNoTrans) {
-                MlasSgemmCopyPackB(PanelB, B + n + k * ldb, ldb, CountN, CountK);
+                if (BIsHalf) {
+                    MlasSgemmCopyPackBHalf(PanelB, (const uint16_t*)B + n + k * ldb, ldb, CountN, CountK);
+                } else {
+                    MlasSgemmCopyPackB(PanelB, B + n + k * ldb, ldb, CountN, CountK);
+                }
             } else {
-                MlasSgemmTransposePackB(PanelB, B + k + n * ldb, ldb, CountN, CountK);
+                if (BIsHalf) {
+                    MlasSgemmTransposePackBHalf(PanelB, (const uint16_t*)B + k + n * ldb, ldb, CountN, CountK);
+                } else {
+                    MlasSgemmTransposePackB(PanelB, B + k + n * ldb, ldb, CountN, CountK);
+                }
             }
 
             //
@@ -939,7 +1465,7 @@ Return Value:
 
 #if defined(MLAS_TARGET_AMD64_IX86)
             PMLAS_SGEMM_KERNEL_ROUTINE SgemmKernelRoutine =
-                UseKernelZeroRoutine ? MlasPlatform.KernelZeroRoutine : MlasPlatform.KernelAddRoutine;
+                MlasSgemmSelectKernelRoutine(UseKernelZeroRoutine, M, N, K);
 #endif
 
             //
@@ -1032,52 +1558,15 @@ Return Value:
 }
 
 void
-MlasSgemmOperationThreaded(
-    void* Context,
-    int32_t Index
-    )
-/*++
-
-Routine Description:
-
-    This routine is invoked from a worker thread to execute a segment of a
-    SGEMM operation.
-
-Arguments:
-
-    Context - Supplies the pointer to the context for the threaded operation.
-
-    Index - Supplies the current index of the threaded operation.
-
-Return Value:
-
-    None.
-
---*/
-{
-    MLAS_SGEMM_WORK_BLOCK* WorkBlock = (MLAS_SGEMM_WORK_BLOCK*)Context;
-
-    MLAS_SGEMM_WORK_BLOCK::SEGMENT* Segment = &WorkBlock->Segments[Index];
-
-    MlasSgemmOperation(WorkBlock->TransA, WorkBlock->TransB, Segment->M,
-        Segment->N, WorkBlock->K, WorkBlock->alpha, Segment->A, WorkBlock->lda,
-        Segment->B, WorkBlock->ldb, WorkBlock->beta, Segment->C,
-        WorkBlock->ldc);
-}
-
-inline
-bool
-MlasSgemmTryMultithread(
+MlasSgemmPackedOperation(
     CBLAS_TRANSPOSE TransA,
-    CBLAS_TRANSPOSE TransB,
     size_t M,
     size_t N,
     size_t K,
     float alpha,
     const float* A,
     size_t lda,
-    const float* B,
-    size_t ldb,
+    const float* PackedB,
     float beta,
     float* C,
     size_t ldc
@@ -1086,18 +1575,20 @@ MlasSgemmTryMultithread(
 
 Routine Description:
 
-    This routine attempts to launch a single precision matrix/matrix multiply
-    operation (SGEMM) across multiple threads.
+    This routine implements the single precision matrix/matrix multiply
+    operation (SGEMM) using a pre-packed copy of matrix B built by
+    MlasSgemmPackB.
 
 Arguments:
 
     TransA - Supplies the transpose operation for matrix A.
 
-    TransB - Supplies the transpose operation for matrix B.
-
     M - Supplies the number of rows of matrix A and matrix C.
 
-    N - Supplies the number of columns of matrix B and matrix C.
+    N - Supplies the number of columns of matrix B and matrix C covered by
+        this operation. When the operation is segmented across threads, the
+        segments must be aligned to a boundary of MLAS_SGEMM_STRIDEN columns
+        to match the packed format.
 
     K - Supplies the number of columns of matrix A and the number of rows of
         matrix B.
@@ -1108,9 +1599,8 @@ Arguments:
 
     lda - Supplies the first dimension of matrix A.
 
-    B - Supplies the address of matrix B.
-
-    ldb - Supplies the first dimension of matrix B.
+    PackedB - Supplies the address of the first column strip of the packed
+        copy of matrix B covered by this operation.
 
     beta - Supplies the scaler beta multiplier (see SGEMM definition).
 
@@ -1120,14 +1610,274 @@ Arguments:
 
 Return Value:
 
-    Returns true if the operation was completed across multiple threads, else
-    false if the operation should fall back to a single thread.
+    None.
 
 --*/
 {
+    float PanelA[MLAS_SGEMM_TRANSA_ROWS * MLAS_SGEMM_STRIDEK];
+
+    //
+    // Step through each strip of the packed matrix B along the N dimension.
+    //
+    // The packed format always uses the default strides, so the stride
+    // adjustment performed by MlasSgemmOperation is not replicated here.
+    //
+
+    size_t CountN;
+    size_t CountK;
+
+    for (size_t n = 0; n < N; n += CountN) {
+
+        CountN = MLAS_SGEMM_STRIDEN;
+
+        if (CountN > (N - n)) {
+            CountN = N - n;
+        }
+
+        //
+        // Compute the number of columns stored for this strip, which is the
+        // column count rounded up to a multiple of the kernel column block.
+        //
+
+        size_t AlignedCountN =
+            (CountN + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+        const float* StripB = PackedB + n * K;
+
+        //
+        // Multiply the output matrix by beta as needed.
+        //
+
+        if (beta != 0.0f && beta != 1.0f) {
+            MlasSgemmMultiplyBeta(C + n, M, CountN, ldc, beta);
+        }
+
+        //
+        // Step through each slice of the packed matrix B along the K
+        // dimension.
+        //
+
+        for (size_t k = 0; k < K; k += CountK) {
+
+            CountK = MLAS_SGEMM_STRIDEK;
+
+            if (CountK > (K - k)) {
+                CountK = K - k;
+            }
+
+            //
+            // Address the panel of matrix B that was packed for this slice.
+            //
+
+            const float* PanelB = StripB + k * AlignedCountN;
+
+            //
+            // Select the kernel routine to use for this panel.
+            //
+
+            bool UseKernelZeroRoutine = (k == 0 && beta == 0.0f);
+
+#if defined(MLAS_TARGET_AMD64_IX86)
+            PMLAS_SGEMM_KERNEL_ROUTINE SgemmKernelRoutine =
+                MlasSgemmSelectKernelRoutine(UseKernelZeroRoutine, M, N, K);
+#endif
+
+            //
+            // Step through each slice of matrix A along the M dimension.
+            //
+
+            float* c = C + n;
+
+            size_t RowsRemaining = M;
+            size_t RowsHandled;
+
+            if (TransA == CblasNoTrans) {
+
+                const float* a = A + k;
+
+                //
+                // Step through the rows of matrix A.
+                //
+
+                do {
+
+#if defined(MLAS_TARGET_AMD64_IX86)
+                    RowsHandled = SgemmKernelRoutine(a, PanelB, c, CountK, RowsRemaining, CountN, lda, ldc, alpha);
+#else
+                    if (UseKernelZeroRoutine) {
+                        RowsHandled = MlasSgemmKernelZero(a, PanelB, c, CountK, RowsRemaining, CountN, lda, ldc, alpha);
+                    } else {
+                        RowsHandled = MlasSgemmKernelAdd(a, PanelB, c, CountK, RowsRemaining, CountN, lda, ldc, alpha);
+                    }
+#endif
+
+                    c += ldc * RowsHandled;
+                    a += lda * RowsHandled;
+
+                    RowsRemaining -= RowsHandled;
+
+                } while (RowsRemaining > 0);
+
+            } else {
+
+                const float* a = A + k * lda;
+
+                do {
+
+                    //
+                    // Transpose elements from matrix A into a local buffer.
+                    //
+
+                    size_t RowsTransposed = RowsRemaining;
+
+                    if (RowsTransposed > MLAS_SGEMM_TRANSA_ROWS) {
+                        RowsTransposed = MLAS_SGEMM_TRANSA_ROWS;
+                    }
+
+                    RowsRemaining -= RowsTransposed;
+
+                    MlasSgemmTransposeA(PanelA, a, lda, RowsTransposed, CountK);
+
+                    a += RowsTransposed;
+
+                    //
+                    // Step through the rows of the local buffer.
+                    //
+
+                    const float* pa = PanelA;
+
+                    do {
+
+#if defined(MLAS_TARGET_AMD64_IX86)
+                        RowsHandled = SgemmKernelRoutine(pa, PanelB, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha);
+#else
+                        if (UseKernelZeroRoutine) {
+                            RowsHandled = MlasSgemmKernelZero(pa, PanelB, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha);
+                        } else {
+                            RowsHandled = MlasSgemmKernelAdd(pa, PanelB, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha);
+                        }
+#endif
+
+                        c += ldc * RowsHandled;
+                        pa += CountK * RowsHandled;
+
+                        RowsTransposed -= RowsHandled;
+
+                    } while (RowsTransposed > 0);
+
+                } while (RowsRemaining > 0);
+            }
+        }
+    }
+}
+
+void
+MlasSgemmOperationThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    SGEMM operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_SGEMM_WORK_BLOCK* WorkBlock = (MLAS_SGEMM_WORK_BLOCK*)Context;
+
+    MLAS_SGEMM_WORK_BLOCK::SEGMENT* Segment = &WorkBlock->Segments[Index];
+
+    if (WorkBlock->BIsPacked) {
+
+        MlasSgemmPackedOperation(WorkBlock->TransA, Segment->M, Segment->N,
+            WorkBlock->K, WorkBlock->alpha, Segment->A, WorkBlock->lda,
+            Segment->B, WorkBlock->beta, Segment->C, WorkBlock->ldc);
+
+    } else {
+
+        MlasSgemmOperation(WorkBlock->TransA, WorkBlock->TransB, Segment->M,
+            Segment->N, WorkBlock->K, WorkBlock->alpha, Segment->A, WorkBlock->lda,
+            Segment->B, WorkBlock->ldb, WorkBlock->beta, Segment->C,
+            WorkBlock->ldc, WorkBlock->BIsHalf);
+    }
+}
+
+inline
+bool
+MlasSgemmTryMultithread(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const float* B,
+    size_t ldb,
+    float beta,
+    float* C,
+    size_t ldc,
+    bool BIsHalf
+    )
+/*++
+
+Routine Description:
+
+    This routine attempts to launch a single precision matrix/matrix multiply
+    operation (SGEMM) across multiple threads.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    alpha - Supplies the scaler alpha multiplier (see SGEMM definition).
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    beta - Supplies the scaler beta multiplier (see SGEMM definition).
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+Return Value:
+
+    Returns true if the operation was completed across multiple threads, else
+    false if the operation should fall back to a single thread.
+
+--*/
+{
+
+#if defined(MLAS_HAS_THREADING_SUPPORT)
 
-#if defined(MLAS_HAS_THREADING_SUPPORT)
-
     MLAS_SGEMM_WORK_BLOCK WorkBlock;
     int32_t TargetThreadCount;
 
@@ -1154,6 +1904,18 @@ Return Value:
         return false;
     }
 
+    //
+    // Subdivide the work beyond the thread count so threads scheduled on
+    // faster cores can pick up segments a slower core would otherwise leave
+    // running after the rest of the system has gone idle.
+    //
+
+    int32_t SegmentCount = TargetThreadCount * MlasPlatform.GetWorkSubdivisionFactor();
+
+    if (SegmentCount > MLAS_MAXIMUM_SEGMENT_COUNT) {
+        SegmentCount = MLAS_MAXIMUM_SEGMENT_COUNT;
+    }
+
     //
     // Initialize the common fields of the work block.
     //
@@ -1166,6 +1928,8 @@ Return Value:
     WorkBlock.ldc = ldc;
     WorkBlock.alpha = alpha;
     WorkBlock.beta = beta;
+    WorkBlock.BIsPacked = false;
+    WorkBlock.BIsHalf = BIsHalf;
 
     //
     // Segment the operation across multiple threads.
@@ -1175,9 +1939,9 @@ Return Value:
 
     if (N > M) {
 
-        size_t StrideN = N / TargetThreadCount;
+        size_t StrideN = N / size_t(SegmentCount);
 
-        if ((StrideN * TargetThreadCount) != N) {
+        if ((StrideN * size_t(SegmentCount)) != N) {
             StrideN++;
         }
 
@@ -1197,7 +1961,18 @@ Return Value:
             WorkBlock.Segments[Index].M = M;
             WorkBlock.Segments[Index].N = CountN;
             WorkBlock.Segments[Index].A = A;
-            WorkBlock.Segments[Index].B = B + n * pldb;
+
+            //
+            // N.B. The offset must be applied at the storage element size
+            // when matrix B holds half-precision floats.
+            //
+
+            if (BIsHalf) {
+                WorkBlock.Segments[Index].B = (const float*)((const uint16_t*)B + n * pldb);
+            } else {
+                WorkBlock.Segments[Index].B = B + n * pldb;
+            }
+
             WorkBlock.Segments[Index].C = C + n;
 
             Index++;
@@ -1205,9 +1980,9 @@ Return Value:
 
     } else {
 
-        size_t StrideM = M / TargetThreadCount;
+        size_t StrideM = M / size_t(SegmentCount);
 
-        if ((StrideM * TargetThreadCount) != M) {
+        if ((StrideM * size_t(SegmentCount)) != M) {
             StrideM++;
         }
 
@@ -1231,7 +2006,7 @@ Return Value:
         }
     }
 
-    MlasExecuteThreaded(MlasSgemmOperationThreaded, &WorkBlock, Index);
+    MlasExecuteThreadedBalanced(MlasSgemmOperationThreaded, &WorkBlock, Index, TargetThreadCount);
 
     return true;
 
@@ -1254,6 +2029,7 @@ Return Value:
     MLAS_UNREFERENCED_PARAMETER(beta);
     MLAS_UNREFERENCED_PARAMETER(C);
     MLAS_UNREFERENCED_PARAMETER(ldc);
+    MLAS_UNREFERENCED_PARAMETER(BIsHalf);
 
     return false;
 
@@ -1325,7 +2101,1089 @@ Return Value:
     // single thread based on the GEMM parameters and system configuration.
     //
 
-    if (!MlasSgemmTryMultithread(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc)) {
-        MlasSgemmOperation(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
+    if (!MlasSgemmTryMultithread(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc, false)) {
+        MlasSgemmOperation(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc, false);
     }
 }
+
+void
+MLASCALL
+MlasSgemm(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const unsigned short* B,
+    size_t ldb,
+    float beta,
+    float* C,
+    size_t ldc
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision matrix/matrix multiply
+    operation (SGEMM) with matrix B stored as half-precision floats.
+
+    Panels of matrix B are converted to single precision on the fly while
+    they are packed for the kernels, so matrix B is read from memory at half
+    the bandwidth of the single precision variant and no expanded copy of
+    the matrix is ever materialized.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    alpha - Supplies the scaler alpha multiplier (see SGEMM definition).
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    B - Supplies the address of matrix B as half-precision floats.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    beta - Supplies the scaler beta multiplier (see SGEMM definition).
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const float* b = (const float*)B;
+
+    if (!MlasSgemmTryMultithread(TransA, TransB, M, N, K, alpha, A, lda, b, ldb, beta, C, ldc, true)) {
+        MlasSgemmOperation(TransA, TransB, M, N, K, alpha, A, lda, b, ldb, beta, C, ldc, true);
+    }
+}
+
+inline
+const float*
+MlasSgemmPackedBufferAlign(
+    const void* PackedB
+    )
+/*++
+
+Routine Description:
+
+    This routine aligns the caller supplied packed buffer to the alignment
+    required by the kernels. MlasSgemmPackBSize reserves space for this
+    adjustment, so the same aligned address is computed by the pack and
+    compute routines.
+
+Arguments:
+
+    PackedB - Supplies the address of the caller supplied packed buffer.
+
+Return Value:
+
+    Returns the aligned address of the packed buffer.
+
+--*/
+{
+    return (const float*)(((uintptr_t)PackedB + MLAS_SGEMM_PACKED_B_ALIGNMENT - 1) &
+        ~(MLAS_SGEMM_PACKED_B_ALIGNMENT - 1));
+}
+
+size_t
+MLASCALL
+MlasSgemmPackBSize(
+    size_t N,
+    size_t K
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the length in bytes of the buffer required to pack
+    a matrix with the supplied dimensions using MlasSgemmPackB.
+
+Arguments:
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+Return Value:
+
+    Returns the size in bytes of the packed buffer.
+
+--*/
+{
+    //
+    // Compute the row length of the packed matrix, which is the number of
+    // columns rounded up to a multiple of the kernel column block, plus
+    // space to align the buffer.
+    //
+
+    size_t AlignedN =
+        (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+    return AlignedN * K * sizeof(float) + MLAS_SGEMM_PACKED_B_ALIGNMENT;
+}
+
+void
+MLASCALL
+MlasSgemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    void* PackedB
+    )
+/*++
+
+Routine Description:
+
+    This routine packs the contents of matrix B to the format expected by
+    the matching MlasSgemm overload. The matrix is copied to the same panel
+    format that MlasSgemmOperation builds on the fly, so the per-call packing
+    cost is paid once for matrices that are reused across many calls.
+
+Arguments:
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    PackedB - Supplies the address of the packed buffer. The buffer must be
+        at least the length computed by MlasSgemmPackBSize.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    float* PackedBase = (float*)MlasSgemmPackedBufferAlign(PackedB);
+
+    //
+    // Step through each strip of matrix B along the N dimension, then pack
+    // each slice of the strip along the K dimension using the default
+    // strides of the compute path.
+    //
+
+    size_t CountN;
+    size_t CountK;
+
+    for (size_t n = 0; n < N; n += CountN) {
+
+        CountN = MLAS_SGEMM_STRIDEN;
+
+        if (CountN > (N - n)) {
+            CountN = N - n;
+        }
+
+        size_t AlignedCountN =
+            (CountN + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+        float* StripB = PackedBase + n * K;
+
+        for (size_t k = 0; k < K; k += CountK) {
+
+            CountK = MLAS_SGEMM_STRIDEK;
+
+            if (CountK > (K - k)) {
+                CountK = K - k;
+            }
+
+            if (TransB == CblasNoTrans) {
+                MlasSgemmCopyPackB(StripB + k * AlignedCountN, B + n + k * ldb, ldb, CountN, CountK);
+            } else {
+                MlasSgemmTransposePackB(StripB + k * AlignedCountN, B + k + n * ldb, ldb, CountN, CountK);
+            }
+        }
+    }
+}
+
+inline
+bool
+MlasSgemmPackedTryMultithread(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const float* PackedB,
+    float beta,
+    float* C,
+    size_t ldc
+    )
+/*++
+
+Routine Description:
+
+    This routine attempts to launch a single precision matrix/matrix multiply
+    operation (SGEMM) using a pre-packed copy of matrix B across multiple
+    threads.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    alpha - Supplies the scaler alpha multiplier (see SGEMM definition).
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    PackedB - Supplies the aligned address of the packed copy of matrix B.
+
+    beta - Supplies the scaler beta multiplier (see SGEMM definition).
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+Return Value:
+
+    Returns true if the operation was completed across multiple threads, else
+    false if the operation should fall back to a single thread.
+
+--*/
+{
+
+#if defined(MLAS_HAS_THREADING_SUPPORT)
+
+    MLAS_SGEMM_WORK_BLOCK WorkBlock;
+    int32_t TargetThreadCount;
+
+    //
+    // Compute the number of target threads given the complexity of the SGEMM
+    // operation. Small requests should run using the single threaded path.
+    //
+
+    double Complexity = double(M) * double(N) * double(K);
+
+    if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
+        TargetThreadCount = int32_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    int32_t MaximumThreadCount = MlasPlatform.GetMaximumThreadCount();
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    if (TargetThreadCount == 1) {
+        return false;
+    }
+
+    //
+    // Subdivide the work beyond the thread count so threads scheduled on
+    // faster cores can pick up segments a slower core would otherwise leave
+    // running after the rest of the system has gone idle.
+    //
+
+    int32_t SegmentCount = TargetThreadCount * MlasPlatform.GetWorkSubdivisionFactor();
+
+    if (SegmentCount > MLAS_MAXIMUM_SEGMENT_COUNT) {
+        SegmentCount = MLAS_MAXIMUM_SEGMENT_COUNT;
+    }
+
+    //
+    // Initialize the common fields of the work block.
+    //
+
+    WorkBlock.TransA = TransA;
+    WorkBlock.TransB = CblasNoTrans;
+    WorkBlock.K = K;
+    WorkBlock.lda = lda;
+    WorkBlock.ldb = 0;
+    WorkBlock.ldc = ldc;
+    WorkBlock.alpha = alpha;
+    WorkBlock.beta = beta;
+    WorkBlock.BIsPacked = true;
+    WorkBlock.BIsHalf = false;
+
+    //
+    // Segment the operation across multiple threads.
+    //
+    // N.B. Unlike the unpacked path, segments along the N dimension must be
+    // aligned to a boundary of the default N stride to match the column
+    // strips of the packed format.
+    //
+
+    int32_t Index = 0;
+
+    if (N > M) {
+
+        size_t StrideN = N / size_t(SegmentCount);
+
+        if ((StrideN * size_t(SegmentCount)) != N) {
+            StrideN++;
+        }
+
+        StrideN = (StrideN + MLAS_SGEMM_STRIDEN - 1) & ~(MLAS_SGEMM_STRIDEN - 1);
+
+        for (size_t CountN, n = 0; n < N; n += CountN) {
+
+            CountN = StrideN;
+
+            if (CountN > (N - n)) {
+                CountN = N - n;
+            }
+
+            WorkBlock.Segments[Index].M = M;
+            WorkBlock.Segments[Index].N = CountN;
+            WorkBlock.Segments[Index].A = A;
+            WorkBlock.Segments[Index].B = PackedB + n * K;
+            WorkBlock.Segments[Index].C = C + n;
+
+            Index++;
+        }
+
+    } else {
+
+        size_t StrideM = M / size_t(SegmentCount);
+
+        if ((StrideM * size_t(SegmentCount)) != M) {
+            StrideM++;
+        }
+
+        size_t plda = (TransA == CblasNoTrans) ? lda : 1;
+
+        for (size_t CountM, m = 0; m < M; m += CountM) {
+
+            CountM = StrideM;
+
+            if (CountM > (M - m)) {
+                CountM = M - m;
+            }
+
+            WorkBlock.Segments[Index].M = CountM;
+            WorkBlock.Segments[Index].N = N;
+            WorkBlock.Segments[Index].A = A + m * plda;
+            WorkBlock.Segments[Index].B = PackedB;
+            WorkBlock.Segments[Index].C = C + m * ldc;
+
+            Index++;
+        }
+    }
+
+    if (Index == 1) {
+        return false;
+    }
+
+    MlasExecuteThreadedBalanced(MlasSgemmOperationThreaded, &WorkBlock, Index, TargetThreadCount);
+
+    return true;
+
+#else
+
+    //
+    // No threading implementation is available.
+    //
+
+    MLAS_UNREFERENCED_PARAMETER(TransA);
+    MLAS_UNREFERENCED_PARAMETER(M);
+    MLAS_UNREFERENCED_PARAMETER(N);
+    MLAS_UNREFERENCED_PARAMETER(K);
+    MLAS_UNREFERENCED_PARAMETER(alpha);
+    MLAS_UNREFERENCED_PARAMETER(A);
+    MLAS_UNREFERENCED_PARAMETER(lda);
+    MLAS_UNREFERENCED_PARAMETER(PackedB);
+    MLAS_UNREFERENCED_PARAMETER(beta);
+    MLAS_UNREFERENCED_PARAMETER(C);
+    MLAS_UNREFERENCED_PARAMETER(ldc);
+
+    return false;
+
+#endif
+
+}
+
+void
+MLASCALL
+MlasSgemm(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const void* PackedB,
+    float beta,
+    float* C,
+    size_t ldc
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision matrix/matrix multiply
+    operation (SGEMM) using a pre-packed copy of matrix B built by
+    MlasSgemmPackB.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    alpha - Supplies the scaler alpha multiplier (see SGEMM definition).
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    PackedB - Supplies the address of the packed copy of matrix B.
+
+    beta - Supplies the scaler beta multiplier (see SGEMM definition).
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const float* PackedBase = MlasSgemmPackedBufferAlign(PackedB);
+
+    //
+    // Try to run the operation across multiple threads or fall back to a
+    // single thread based on the GEMM parameters and system configuration.
+    //
+
+    if (!MlasSgemmPackedTryMultithread(TransA, M, N, K, alpha, A, lda, PackedBase, beta, C, ldc)) {
+        MlasSgemmPackedOperation(TransA, M, N, K, alpha, A, lda, PackedBase, beta, C, ldc);
+    }
+}
+
+//
+// Define the parameters to execute a batch of independent SGEMM operations
+// with shared dimensions on worker threads.
+//
+
+struct MLAS_SGEMM_BATCH_WORK_BLOCK {
+    CBLAS_TRANSPOSE TransA;
+    CBLAS_TRANSPOSE TransB;
+    size_t M;
+    size_t N;
+    size_t K;
+    size_t lda;
+    size_t ldb;
+    size_t ldc;
+    float alpha;
+    float beta;
+    const float* const* AArray;
+    const float* const* BArray;
+    float* const* CArray;
+    const float* PackedB;
+    size_t BatchN;
+    int32_t ThreadCount;
+};
+
+void
+MlasSgemmBatchThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a contiguous
+    range of GEMM operations from a batch. Each operation runs single
+    threaded inside its worker, so the batch pays the thread dispatch cost
+    once rather than once per operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_SGEMM_BATCH_WORK_BLOCK* WorkBlock = (MLAS_SGEMM_BATCH_WORK_BLOCK*)Context;
+
+    //
+    // Compute the range of operations owned by this thread, spreading the
+    // remainder across the leading threads.
+    //
+
+    size_t ThreadCount = size_t(WorkBlock->ThreadCount);
+
+    size_t GemmsPerThread = WorkBlock->BatchN / ThreadCount;
+    size_t Remainder = WorkBlock->BatchN % ThreadCount;
+
+    size_t GemmStart = size_t(Index) * GemmsPerThread +
+        ((size_t(Index) < Remainder) ? size_t(Index) : Remainder);
+    size_t GemmCount = GemmsPerThread + ((size_t(Index) < Remainder) ? 1 : 0);
+
+    for (size_t gemm = GemmStart; gemm < GemmStart + GemmCount; gemm++) {
+
+        if (WorkBlock->PackedB != nullptr) {
+
+            MlasSgemmPackedOperation(WorkBlock->TransA, WorkBlock->M,
+                WorkBlock->N, WorkBlock->K, WorkBlock->alpha,
+                WorkBlock->AArray[gemm], WorkBlock->lda, WorkBlock->PackedB,
+                WorkBlock->beta, WorkBlock->CArray[gemm], WorkBlock->ldc);
+
+        } else {
+
+            MlasSgemmOperation(WorkBlock->TransA, WorkBlock->TransB,
+                WorkBlock->M, WorkBlock->N, WorkBlock->K, WorkBlock->alpha,
+                WorkBlock->AArray[gemm], WorkBlock->lda,
+                WorkBlock->BArray[gemm], WorkBlock->ldb, WorkBlock->beta,
+                WorkBlock->CArray[gemm], WorkBlock->ldc, false);
+        }
+    }
+}
+
+void
+MlasSgemmBatchDispatch(
+    MLAS_SGEMM_BATCH_WORK_BLOCK& WorkBlock
+    )
+/*++
+
+Routine Description:
+
+    This routine partitions the worker threads across a batch of GEMM
+    operations and executes the batch.
+
+Arguments:
+
+    WorkBlock - Supplies the batch work block with the thread count not yet
+        computed.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    //
+    // Compute the number of target threads given the complexity of the whole
+    // batch. Small batches should run using the single threaded path.
+    //
+
+    double Complexity = double(WorkBlock.M) * double(WorkBlock.N) *
+        double(WorkBlock.K) * double(WorkBlock.BatchN);
+
+    int32_t TargetThreadCount;
+
+    if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
+        TargetThreadCount = int32_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    int32_t MaximumThreadCount = MlasPlatform.GetMaximumThreadCount();
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    if (size_t(TargetThreadCount) > WorkBlock.BatchN) {
+        TargetThreadCount = int32_t(WorkBlock.BatchN);
+    }
+
+    WorkBlock.ThreadCount = TargetThreadCount;
+
+    MlasExecuteThreaded(MlasSgemmBatchThreaded, &WorkBlock, TargetThreadCount);
+}
+
+void
+MLASCALL
+MlasSgemmBatch(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* const* AArray,
+    size_t lda,
+    const float* const* BArray,
+    size_t ldb,
+    float beta,
+    float* const* CArray,
+    size_t ldc,
+    size_t BatchN
+    )
+/*++
+
+Routine Description:
+
+    This routine implements a batch of independent single precision
+    matrix/matrix multiply operations (SGEMM) sharing the same dimensions.
+    The worker threads are partitioned across the whole batch, so many small
+    operations pay the thread dispatch cost once instead of once per call.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for the A matrices.
+
+    TransB - Supplies the transpose operation for the B matrices.
+
+    M - Supplies the number of rows of the A matrices and the C matrices.
+
+    N - Supplies the number of columns of the B matrices and the C matrices.
+
+    K - Supplies the number of columns of the A matrices and the number of
+        rows of the B matrices.
+
+    alpha - Supplies the scaler alpha multiplier (see SGEMM definition).
+
+    AArray - Supplies the addresses of the A matrices.
+
+    lda - Supplies the first dimension of the A matrices.
+
+    BArray - Supplies the addresses of the B matrices.
+
+    ldb - Supplies the first dimension of the B matrices.
+
+    beta - Supplies the scaler beta multiplier (see SGEMM definition).
+
+    CArray - Supplies the addresses of the C matrices.
+
+    ldc - Supplies the first dimension of the C matrices.
+
+    BatchN - Supplies the number of operations in the batch.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (BatchN == 0) {
+        return;
+    }
+
+    //
+    // Operations large enough to split across most of the threads on their
+    // own do not suffer per-call dispatch overhead, so run them through the
+    // single operation path which can also partition the K-sized packing
+    // work.
+    //
+
+    double OperationComplexity = double(M) * double(N) * double(K);
+
+    if (BatchN == 1 ||
+        (size_t(MlasPlatform.GetMaximumThreadCount()) > BatchN &&
+         OperationComplexity >= double(MLAS_SGEMM_THREAD_COMPLEXITY))) {
+
+        for (size_t gemm = 0; gemm < BatchN; gemm++) {
+            MlasSgemm(TransA, TransB, M, N, K, alpha, AArray[gemm], lda,
+                BArray[gemm], ldb, beta, CArray[gemm], ldc);
+        }
+
+        return;
+    }
+
+    MLAS_SGEMM_BATCH_WORK_BLOCK WorkBlock;
+
+    WorkBlock.TransA = TransA;
+    WorkBlock.TransB = TransB;
+    WorkBlock.M = M;
+    WorkBlock.N = N;
+    WorkBlock.K = K;
+    WorkBlock.lda = lda;
+    WorkBlock.ldb = ldb;
+    WorkBlock.ldc = ldc;
+    WorkBlock.alpha = alpha;
+    WorkBlock.beta = beta;
+    WorkBlock.AArray = AArray;
+    WorkBlock.BArray = BArray;
+    WorkBlock.CArray = CArray;
+    WorkBlock.PackedB = nullptr;
+    WorkBlock.BatchN = BatchN;
+
+    MlasSgemmBatchDispatch(WorkBlock);
+}
+
+void
+MLASCALL
+MlasSgemmBatch(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* const* AArray,
+    size_t lda,
+    const void* PackedB,
+    float beta,
+    float* const* CArray,
+    size_t ldc,
+    size_t BatchN
+    )
+/*++
+
+Routine Description:
+
+    This routine implements a batch of independent single precision
+    matrix/matrix multiply operations (SGEMM) sharing the same dimensions
+    and a single pre-packed copy of matrix B built by MlasSgemmPackB. The
+    packing cost is paid once for the whole batch and the worker threads
+    are partitioned across all of the operations.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for the A matrices.
+
+    M - Supplies the number of rows of the A matrices and the C matrices.
+
+    N - Supplies the number of columns of matrix B and the C matrices.
+
+    K - Supplies the number of columns of the A matrices and the number of
+        rows of matrix B.
+
+    alpha - Supplies the scaler alpha multiplier (see SGEMM definition).
+
+    AArray - Supplies the addresses of the A matrices.
+
+    lda - Supplies the first dimension of the A matrices.
+
+    PackedB - Supplies the address of the packed copy of matrix B shared by
+        every operation in the batch.
+
+    beta - Supplies the scaler beta multiplier (see SGEMM definition).
+
+    CArray - Supplies the addresses of the C matrices.
+
+    ldc - Supplies the first dimension of the C matrices.
+
+    BatchN - Supplies the number of operations in the batch.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (BatchN == 0) {
+        return;
+    }
+
+    const float* PackedBase = MlasSgemmPackedBufferAlign(PackedB);
+
+    double OperationComplexity = double(M) * double(N) * double(K);
+
+    if (BatchN == 1 ||
+        (size_t(MlasPlatform.GetMaximumThreadCount()) > BatchN &&
+         OperationComplexity >= double(MLAS_SGEMM_THREAD_COMPLEXITY))) {
+
+        for (size_t gemm = 0; gemm < BatchN; gemm++) {
+            MlasSgemm(TransA, M, N, K, alpha, AArray[gemm], lda, PackedB,
+                beta, CArray[gemm], ldc);
+        }
+
+        return;
+    }
+
+    MLAS_SGEMM_BATCH_WORK_BLOCK WorkBlock;
+
+    WorkBlock.TransA = TransA;
+    WorkBlock.TransB = CblasNoTrans;
+    WorkBlock.M = M;
+    WorkBlock.N = N;
+    WorkBlock.K = K;
+    WorkBlock.lda = lda;
+    WorkBlock.ldb = 0;
+    WorkBlock.ldc = ldc;
+    WorkBlock.alpha = alpha;
+    WorkBlock.beta = beta;
+    WorkBlock.AArray = AArray;
+    WorkBlock.BArray = nullptr;
+    WorkBlock.CArray = CArray;
+    WorkBlock.PackedB = PackedBase;
+    WorkBlock.BatchN = BatchN;
+
+    MlasSgemmBatchDispatch(WorkBlock);
+}
+
+//
+// Define the parameters to execute a strided batch of independent SGEMM
+// operations on worker threads. The matrices of the batch live at uniform
+// element strides from the base addresses, so the work block carries three
+// pointers instead of per-operation pointer arrays, and the flattened row
+// space of the batch is partitioned across the threads so that batches of
+// short matrices can still occupy every thread.
+//
+
+struct MLAS_SGEMM_STRIDED_BATCH_WORK_BLOCK {
+    CBLAS_TRANSPOSE TransA;
+    CBLAS_TRANSPOSE TransB;
+    size_t M;
+    size_t N;
+    size_t K;
+    size_t lda;
+    size_t ldb;
+    size_t ldc;
+    float alpha;
+    float beta;
+    const float* A;
+    size_t StrideA;
+    const float* B;
+    size_t StrideB;
+    float* C;
+    size_t StrideC;
+    size_t BatchN;
+    int32_t ThreadCount;
+};
+
+void
+MlasSgemmStridedBatchThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a contiguous
+    range of rows from the flattened row space of a strided batch. Spans of
+    rows that live inside a single matrix of the batch are issued as one
+    operation, so a thread may finish the tail rows of one matrix and then
+    start the head rows of the next.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_SGEMM_STRIDED_BATCH_WORK_BLOCK* WorkBlock = (MLAS_SGEMM_STRIDED_BATCH_WORK_BLOCK*)Context;
+
+    //
+    // Compute the range of rows owned by this thread, spreading the
+    // remainder across the leading threads.
+    //
+
+    size_t ThreadCount = size_t(WorkBlock->ThreadCount);
+    size_t TotalRows = WorkBlock->BatchN * WorkBlock->M;
+
+    size_t RowsPerThread = TotalRows / ThreadCount;
+    size_t Remainder = TotalRows % ThreadCount;
+
+    size_t RowStart = size_t(Index) * RowsPerThread +
+        ((size_t(Index) < Remainder) ? size_t(Index) : Remainder);
+    size_t RowCount = RowsPerThread + ((size_t(Index) < Remainder) ? 1 : 0);
+
+    while (RowCount > 0) {
+
+        size_t Gemm = RowStart / WorkBlock->M;
+        size_t RowOffset = RowStart % WorkBlock->M;
+        size_t SpanRows = WorkBlock->M - RowOffset;
+
+        if (SpanRows > RowCount) {
+            SpanRows = RowCount;
+        }
+
+        //
+        // When A is transposed, rows of the output correspond to columns of
+        // the stored matrix, so the row offset advances by single elements
+        // instead of whole rows.
+        //
+
+        const float* a = WorkBlock->A + Gemm * WorkBlock->StrideA +
+            ((WorkBlock->TransA == CblasNoTrans) ? RowOffset * WorkBlock->lda : RowOffset);
+        const float* b = WorkBlock->B + Gemm * WorkBlock->StrideB;
+        float* c = WorkBlock->C + Gemm * WorkBlock->StrideC + RowOffset * WorkBlock->ldc;
+
+        MlasSgemmOperation(WorkBlock->TransA, WorkBlock->TransB, SpanRows,
+            WorkBlock->N, WorkBlock->K, WorkBlock->alpha, a, WorkBlock->lda,
+            b, WorkBlock->ldb, WorkBlock->beta, c, WorkBlock->ldc, false);
+
+        RowStart += SpanRows;
+        RowCount -= SpanRows;
+    }
+}
+
+void
+MLASCALL
+MlasSgemmStridedBatched(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    size_t StrideA,
+    const float* B,
+    size_t ldb,
+    size_t StrideB,
+    float beta,
+    float* C,
+    size_t ldc,
+    size_t StrideC,
+    size_t BatchN
+    )
+/*++
+
+Routine Description:
+
+    This routine implements a batch of independent single precision
+    matrix/matrix multiply operations (SGEMM) whose matrices live at uniform
+    element strides from the base addresses, as produced by a stacked 3-D or
+    4-D matrix multiplication. The worker threads are partitioned across the
+    flattened row space of the whole batch rather than across operations, so
+    a batch of a few short matrices can still be spread over every thread.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for the A matrices.
+
+    TransB - Supplies the transpose operation for the B matrices.
+
+    M - Supplies the number of rows of the A matrices and the C matrices.
+
+    N - Supplies the number of columns of the B matrices and the C matrices.
+
+    K - Supplies the number of columns of the A matrices and the number of
+        rows of the B matrices.
+
+    alpha - Supplies the scaler alpha multiplier (see SGEMM definition).
+
+    A - Supplies the address of the first A matrix.
+
+    lda - Supplies the first dimension of the A matrices.
+
+    StrideA - Supplies the element spacing between consecutive A matrices.
+        A zero stride broadcasts the first matrix to every operation.
+
+    B - Supplies the address of the first B matrix.
+
+    ldb - Supplies the first dimension of the B matrices.
+
+    StrideB - Supplies the element spacing between consecutive B matrices.
+        A zero stride broadcasts the first matrix to every operation.
+
+    beta - Supplies the scaler beta multiplier (see SGEMM definition).
+
+    C - Supplies the address of the first C matrix.
+
+    ldc - Supplies the first dimension of the C matrices.
+
+    StrideC - Supplies the element spacing between consecutive C matrices.
+
+    BatchN - Supplies the number of operations in the batch.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (BatchN == 0 || M == 0) {
+        return;
+    }
+
+    //
+    // Compute the number of target threads given the complexity of the whole
+    // batch. Small batches should run using the single threaded path.
+    //
+
+    double Complexity = double(M) * double(N) * double(K) * double(BatchN);
+
+    int32_t TargetThreadCount;
+
+    if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
+        TargetThreadCount = int32_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    int32_t MaximumThreadCount = MlasPlatform.GetMaximumThreadCount();
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    //
+    // Unlike the pointer array batch, the thread count is bounded by the
+    // row space of the whole batch rather than the operation count.
+    //
+
+    size_t TotalRows = BatchN * M;
+
+    if (size_t(TargetThreadCount) > TotalRows) {
+        TargetThreadCount = int32_t(TotalRows);
+    }
+
+    MLAS_SGEMM_STRIDED_BATCH_WORK_BLOCK WorkBlock;
+
+    WorkBlock.TransA = TransA;
+    WorkBlock.TransB = TransB;
+    WorkBlock.M = M;
+    WorkBlock.N = N;
+    WorkBlock.K = K;
+    WorkBlock.lda = lda;
+    WorkBlock.ldb = ldb;
+    WorkBlock.ldc = ldc;
+    WorkBlock.alpha = alpha;
+    WorkBlock.beta = beta;
+    WorkBlock.A = A;
+    WorkBlock.StrideA = StrideA;
+    WorkBlock.B = B;
+    WorkBlock.StrideB = StrideB;
+    WorkBlock.C = C;
+    WorkBlock.StrideC = StrideC;
+    WorkBlock.BatchN = BatchN;
+    WorkBlock.ThreadCount = TargetThreadCount;
+
+    MlasExecuteThreaded(MlasSgemmStridedBatchThreaded, &WorkBlock, TargetThreadCount);
+}
@@ -0,0 +1,205 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    softmax.cpp
+
+Abstract:
+
+    This module implements routines to compute the softmax function.
+
+    Each row is processed in a fused sequence of passes: the row maximum is
+    found, the shifted exponentials are computed and summed in a single
+    pass, and the results are normalized. This avoids the intermediate
+    buffers and extra sweeps over memory that composing the operation from
+    generic primitives would require.
+
+--*/
+
+#include "mlasi.h"
+
+float
+MlasReduceMaximumFloat32x4(
+    MLAS_FLOAT32X4 Vector
+    )
+{
+    float Maximum = MlasExtractLaneFloat32x4<0>(Vector);
+    Maximum = (std::max)(Maximum, MlasExtractLaneFloat32x4<1>(Vector));
+    Maximum = (std::max)(Maximum, MlasExtractLaneFloat32x4<2>(Vector));
+    Maximum = (std::max)(Maximum, MlasExtractLaneFloat32x4<3>(Vector));
+    return Maximum;
+}
+
+float
+MlasReduceAddFloat32x4(
+    MLAS_FLOAT32X4 Vector
+    )
+{
+    return MlasExtractLaneFloat32x4<0>(Vector) + MlasExtractLaneFloat32x4<1>(Vector) +
+        MlasExtractLaneFloat32x4<2>(Vector) + MlasExtractLaneFloat32x4<3>(Vector);
+}
+
+void
+MLASCALL
+MlasComputeSoftmax(
+    const float* Input,
+    float* Output,
+    size_t N,
+    size_t D,
+    bool LogSoftmax
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the softmax or log softmax function over a matrix
+    of N rows of D elements each.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of rows to process.
+
+    D - Supplies the number of elements in each row.
+
+    LogSoftmax - Supplies true to compute the log softmax function instead
+        of the softmax function.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    for (size_t i = 0; i < N; i++) {
+
+        //
+        // Find the maximum value of the row, which is subtracted from the
+        // inputs below to avoid overflowing the exponential function.
+        //
+
+        const float* RowInput = Input;
+        size_t n = D;
+
+        float Maximum = (std::numeric_limits<float>::lowest)();
+
+        if (n >= 4) {
+
+            MLAS_FLOAT32X4 MaximumVector = MlasBroadcastFloat32x4(Maximum);
+
+            do {
+                MaximumVector = MlasMaximumFloat32x4(MaximumVector, MlasLoadFloat32x4(RowInput));
+                RowInput += 4;
+                n -= 4;
+            } while (n >= 4);
+
+            Maximum = MlasReduceMaximumFloat32x4(MaximumVector);
+        }
+
+        while (n > 0) {
+            Maximum = (std::max)(Maximum, *RowInput++);
+            n -= 1;
+        }
+
+        //
+        // Compute the shifted exponentials and accumulate their sum. The
+        // log softmax variant only needs the sum, so the stores are skipped
+        // and the output is produced from the inputs below.
+        //
+
+        MLAS_FLOAT32X4 MaximumVector = MlasBroadcastFloat32x4(Maximum);
+        MLAS_FLOAT32X4 SumVector = MlasZeroFloat32x4();
+
+        RowInput = Input;
+        float* RowOutput = Output;
+        n = D;
+
+        float Sum = 0.0f;
+
+        while (n >= 4) {
+
+            MLAS_FLOAT32X4 Value =
+                MlasExpFloat32x4(MlasSubtractFloat32x4(MlasLoadFloat32x4(RowInput), MaximumVector));
+
+            if (!LogSoftmax) {
+                MlasStoreFloat32x4(RowOutput, Value);
+                RowOutput += 4;
+            }
+
+            SumVector = MlasAddFloat32x4(SumVector, Value);
+
+            RowInput += 4;
+            n -= 4;
+        }
+
+        Sum = MlasReduceAddFloat32x4(SumVector);
+
+        while (n > 0) {
+
+            float Value = MlasExpScalar(*RowInput++ - Maximum);
+
+            if (!LogSoftmax) {
+                *RowOutput++ = Value;
+            }
+
+            Sum += Value;
+
+            n -= 1;
+        }
+
+        //
+        // Normalize the row.
+        //
+
+        if (!LogSoftmax) {
+
+            MLAS_FLOAT32X4 ScaleVector = MlasBroadcastFloat32x4(1.0f / Sum);
+
+            RowOutput = Output;
+            n = D;
+
+            while (n >= 4) {
+                MlasStoreFloat32x4(RowOutput,
+                    MlasMultiplyFloat32x4(MlasLoadFloat32x4(RowOutput), ScaleVector));
+                RowOutput += 4;
+                n -= 4;
+            }
+
+            while (n > 0) {
+                *RowOutput++ *= MlasExtractLaneFloat32x4<0>(ScaleVector);
+                n -= 1;
+            }
+
+        } else {
+
+            MLAS_FLOAT32X4 OffsetVector = MlasBroadcastFloat32x4(Maximum + logf(Sum));
+
+            RowInput = Input;
+            RowOutput = Output;
+            n = D;
+
+            while (n >= 4) {
+                MlasStoreFloat32x4(RowOutput,
+                    MlasSubtractFloat32x4(MlasLoadFloat32x4(RowInput), OffsetVector));
+                RowInput += 4;
+                RowOutput += 4;
+                n -= 4;
+            }
+
+            while (n > 0) {
+                *RowOutput++ = *RowInput++ - MlasExtractLaneFloat32x4<0>(OffsetVector);
+                n -= 1;
+            }
+        }
+
+        Input += D;
+        Output += D;
+    }
+}
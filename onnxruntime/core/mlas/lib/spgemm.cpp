@@ -0,0 +1,603 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    spgemm.cpp
+
+Abstract:
+
+    This module implements the block-sparse single precision matrix/matrix
+    multiply operation.
+
+    A constant matrix B that was pruned to block sparsity is packed once into
+    a block-CSR layout over 4x4 blocks: per block row, the column indices and
+    the dense values of the blocks that contain any non-zero element. The
+    multiply then touches only the stored blocks, so the work scales with the
+    density of the matrix rather than its dimensions.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the edge length of the square blocks of the sparse layout.
+//
+
+#define MLAS_SPGEMM_BLOCK_SIZE 4
+
+//
+// Define the header of the packed block-sparse representation. The header is
+// followed by the block row offsets (BlockRows + 1 entries), the block column
+// indices (NonzeroBlocks entries), and the zero-padded dense values of the
+// stored blocks (NonzeroBlocks * 16 floats).
+//
+
+struct MLAS_SPGEMM_HEADER {
+    size_t K;
+    size_t N;
+    size_t BlockRows;
+    size_t NonzeroBlocks;
+};
+
+//
+// Define the parameters to execute a block-sparse SGEMM on worker threads.
+//
+
+struct MLAS_SPGEMM_WORK_BLOCK {
+    size_t M;
+    size_t lda;
+    size_t ldc;
+    float alpha;
+    float beta;
+    const float* A;
+    const MLAS_SPGEMM_HEADER* PackedB;
+    float* C;
+    int32_t ThreadCount;
+};
+
+static
+const uint32_t*
+MlasSgemmBlockSparseRowOffsets(
+    const MLAS_SPGEMM_HEADER* Header
+    )
+{
+    return (const uint32_t*)(Header + 1);
+}
+
+static
+const uint32_t*
+MlasSgemmBlockSparseColumns(
+    const MLAS_SPGEMM_HEADER* Header
+    )
+{
+    return MlasSgemmBlockSparseRowOffsets(Header) + Header->BlockRows + 1;
+}
+
+static
+const float*
+MlasSgemmBlockSparseValues(
+    const MLAS_SPGEMM_HEADER* Header
+    )
+{
+    //
+    // The values follow the two index arrays, aligned up to a 16 byte
+    // boundary so the 4-wide column loads of a block stay aligned.
+    //
+
+    uintptr_t Values = (uintptr_t)(MlasSgemmBlockSparseColumns(Header) + Header->NonzeroBlocks);
+    Values = (Values + 15) & ~uintptr_t(15);
+
+    return (const float*)Values;
+}
+
+static
+bool
+MlasSgemmBlockIsNonzero(
+    const float* B,
+    size_t ldb,
+    size_t RowCount,
+    size_t ColumnCount
+    )
+/*++
+
+Routine Description:
+
+    This routine tests if any element of a (possibly partial) block of the
+    matrix is non-zero.
+
+Arguments:
+
+    B - Supplies the address of the top left element of the block.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    RowCount - Supplies the number of valid rows of the block.
+
+    ColumnCount - Supplies the number of valid columns of the block.
+
+Return Value:
+
+    Returns true if the block contains a non-zero element.
+
+--*/
+{
+    for (size_t row = 0; row < RowCount; row++) {
+        for (size_t col = 0; col < ColumnCount; col++) {
+            if (B[row * ldb + col] != 0.0f) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+float
+MLASCALL
+MlasSgemmBlockSparseDensity(
+    size_t K,
+    size_t N,
+    const float* B,
+    size_t ldb
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the fraction of 4x4 blocks of the supplied matrix
+    that contain at least one non-zero element, so callers can decide if the
+    block-sparse path is profitable before packing.
+
+Arguments:
+
+    K - Supplies the number of rows of matrix B.
+
+    N - Supplies the number of columns of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+Return Value:
+
+    Returns the fraction of blocks that are not entirely zero.
+
+--*/
+{
+    if (K == 0 || N == 0) {
+        return 0.0f;
+    }
+
+    const size_t BlockRows = (K + MLAS_SPGEMM_BLOCK_SIZE - 1) / MLAS_SPGEMM_BLOCK_SIZE;
+    const size_t BlockColumns = (N + MLAS_SPGEMM_BLOCK_SIZE - 1) / MLAS_SPGEMM_BLOCK_SIZE;
+
+    size_t NonzeroBlocks = 0;
+
+    for (size_t kb = 0; kb < BlockRows; kb++) {
+
+        const size_t RowCount = (std::min)(size_t(MLAS_SPGEMM_BLOCK_SIZE), K - kb * MLAS_SPGEMM_BLOCK_SIZE);
+
+        for (size_t nb = 0; nb < BlockColumns; nb++) {
+
+            const size_t ColumnCount = (std::min)(size_t(MLAS_SPGEMM_BLOCK_SIZE), N - nb * MLAS_SPGEMM_BLOCK_SIZE);
+
+            if (MlasSgemmBlockIsNonzero(B + kb * MLAS_SPGEMM_BLOCK_SIZE * ldb + nb * MLAS_SPGEMM_BLOCK_SIZE,
+                                        ldb, RowCount, ColumnCount)) {
+                NonzeroBlocks++;
+            }
+        }
+    }
+
+    return float(double(NonzeroBlocks) / double(BlockRows * BlockColumns));
+}
+
+size_t
+MLASCALL
+MlasSgemmPackBlockSparseBSize(
+    size_t K,
+    size_t N,
+    const float* B,
+    size_t ldb
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the number of bytes required to pack the supplied
+    matrix into the block-CSR layout.
+
+Arguments:
+
+    K - Supplies the number of rows of matrix B.
+
+    N - Supplies the number of columns of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+Return Value:
+
+    Returns the number of bytes required to pack the matrix.
+
+--*/
+{
+    const size_t BlockRows = (K + MLAS_SPGEMM_BLOCK_SIZE - 1) / MLAS_SPGEMM_BLOCK_SIZE;
+    const size_t BlockColumns = (N + MLAS_SPGEMM_BLOCK_SIZE - 1) / MLAS_SPGEMM_BLOCK_SIZE;
+
+    size_t NonzeroBlocks = 0;
+
+    for (size_t kb = 0; kb < BlockRows; kb++) {
+
+        const size_t RowCount = (std::min)(size_t(MLAS_SPGEMM_BLOCK_SIZE), K - kb * MLAS_SPGEMM_BLOCK_SIZE);
+
+        for (size_t nb = 0; nb < BlockColumns; nb++) {
+
+            const size_t ColumnCount = (std::min)(size_t(MLAS_SPGEMM_BLOCK_SIZE), N - nb * MLAS_SPGEMM_BLOCK_SIZE);
+
+            if (MlasSgemmBlockIsNonzero(B + kb * MLAS_SPGEMM_BLOCK_SIZE * ldb + nb * MLAS_SPGEMM_BLOCK_SIZE,
+                                        ldb, RowCount, ColumnCount)) {
+                NonzeroBlocks++;
+            }
+        }
+    }
+
+    size_t BytesRequired = sizeof(MLAS_SPGEMM_HEADER);
+    BytesRequired += (BlockRows + 1 + NonzeroBlocks) * sizeof(uint32_t);
+    BytesRequired = (BytesRequired + 15) & ~size_t(15);
+    BytesRequired += NonzeroBlocks * MLAS_SPGEMM_BLOCK_SIZE * MLAS_SPGEMM_BLOCK_SIZE * sizeof(float);
+
+    return BytesRequired;
+}
+
+void
+MLASCALL
+MlasSgemmPackBlockSparseB(
+    size_t K,
+    size_t N,
+    const float* B,
+    size_t ldb,
+    void* PackedB
+    )
+/*++
+
+Routine Description:
+
+    This routine packs the supplied matrix into the block-CSR layout. The
+    buffer must have been sized with MlasSgemmPackBlockSparseBSize for the
+    same matrix contents.
+
+Arguments:
+
+    K - Supplies the number of rows of matrix B.
+
+    N - Supplies the number of columns of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    PackedB - Supplies the address of the destination buffer.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t BlockRows = (K + MLAS_SPGEMM_BLOCK_SIZE - 1) / MLAS_SPGEMM_BLOCK_SIZE;
+    const size_t BlockColumns = (N + MLAS_SPGEMM_BLOCK_SIZE - 1) / MLAS_SPGEMM_BLOCK_SIZE;
+
+    MLAS_SPGEMM_HEADER* Header = (MLAS_SPGEMM_HEADER*)PackedB;
+
+    Header->K = K;
+    Header->N = N;
+    Header->BlockRows = BlockRows;
+
+    //
+    // Count the stored blocks first so the value array offset is known
+    // before the values are written.
+    //
+
+    size_t NonzeroBlocks = 0;
+
+    for (size_t kb = 0; kb < BlockRows; kb++) {
+
+        const size_t RowCount = (std::min)(size_t(MLAS_SPGEMM_BLOCK_SIZE), K - kb * MLAS_SPGEMM_BLOCK_SIZE);
+
+        for (size_t nb = 0; nb < BlockColumns; nb++) {
+
+            const size_t ColumnCount = (std::min)(size_t(MLAS_SPGEMM_BLOCK_SIZE), N - nb * MLAS_SPGEMM_BLOCK_SIZE);
+
+            if (MlasSgemmBlockIsNonzero(B + kb * MLAS_SPGEMM_BLOCK_SIZE * ldb + nb * MLAS_SPGEMM_BLOCK_SIZE,
+                                        ldb, RowCount, ColumnCount)) {
+                NonzeroBlocks++;
+            }
+        }
+    }
+
+    Header->NonzeroBlocks = NonzeroBlocks;
+
+    uint32_t* RowOffsets = (uint32_t*)MlasSgemmBlockSparseRowOffsets(Header);
+    uint32_t* Columns = (uint32_t*)MlasSgemmBlockSparseColumns(Header);
+    float* Values = (float*)MlasSgemmBlockSparseValues(Header);
+
+    size_t BlockIndex = 0;
+
+    for (size_t kb = 0; kb < BlockRows; kb++) {
+
+        RowOffsets[kb] = uint32_t(BlockIndex);
+
+        const size_t RowCount = (std::min)(size_t(MLAS_SPGEMM_BLOCK_SIZE), K - kb * MLAS_SPGEMM_BLOCK_SIZE);
+
+        for (size_t nb = 0; nb < BlockColumns; nb++) {
+
+            const size_t ColumnCount = (std::min)(size_t(MLAS_SPGEMM_BLOCK_SIZE), N - nb * MLAS_SPGEMM_BLOCK_SIZE);
+            const float* b = B + kb * MLAS_SPGEMM_BLOCK_SIZE * ldb + nb * MLAS_SPGEMM_BLOCK_SIZE;
+
+            if (!MlasSgemmBlockIsNonzero(b, ldb, RowCount, ColumnCount)) {
+                continue;
+            }
+
+            Columns[BlockIndex] = uint32_t(nb);
+
+            //
+            // Store the block densely, padding partial edge blocks with
+            // zeroes so the multiply kernel never needs a bounds check on
+            // the K dimension.
+            //
+
+            float* block = Values + BlockIndex * MLAS_SPGEMM_BLOCK_SIZE * MLAS_SPGEMM_BLOCK_SIZE;
+
+            for (size_t row = 0; row < MLAS_SPGEMM_BLOCK_SIZE; row++) {
+                for (size_t col = 0; col < MLAS_SPGEMM_BLOCK_SIZE; col++) {
+                    block[row * MLAS_SPGEMM_BLOCK_SIZE + col] =
+                        (row < RowCount && col < ColumnCount) ? b[row * ldb + col] : 0.0f;
+                }
+            }
+
+            BlockIndex++;
+        }
+    }
+
+    RowOffsets[BlockRows] = uint32_t(BlockIndex);
+}
+
+static
+void
+MlasSgemmBlockSparseOperation(
+    const MLAS_SPGEMM_WORK_BLOCK* WorkBlock,
+    size_t RowStart,
+    size_t RowCount
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a range of output rows of the block-sparse matrix
+    multiplication C = beta * C + alpha * A * B.
+
+Arguments:
+
+    WorkBlock - Supplies the work block describing the operation.
+
+    RowStart - Supplies the first output row to compute.
+
+    RowCount - Supplies the number of output rows to compute.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_SPGEMM_HEADER* Header = WorkBlock->PackedB;
+
+    const uint32_t* RowOffsets = MlasSgemmBlockSparseRowOffsets(Header);
+    const uint32_t* Columns = MlasSgemmBlockSparseColumns(Header);
+    const float* Values = MlasSgemmBlockSparseValues(Header);
+
+    const size_t K = Header->K;
+    const size_t N = Header->N;
+    const size_t BlockRows = Header->BlockRows;
+
+    const float alpha = WorkBlock->alpha;
+    const float beta = WorkBlock->beta;
+
+    for (size_t m = RowStart; m < RowStart + RowCount; m++) {
+
+        const float* a = WorkBlock->A + m * WorkBlock->lda;
+        float* c = WorkBlock->C + m * WorkBlock->ldc;
+
+        if (beta == 0.0f) {
+            for (size_t n = 0; n < N; n++) {
+                c[n] = 0.0f;
+            }
+        } else if (beta != 1.0f) {
+            for (size_t n = 0; n < N; n++) {
+                c[n] *= beta;
+            }
+        }
+
+        for (size_t kb = 0; kb < BlockRows; kb++) {
+
+            const size_t ks = kb * MLAS_SPGEMM_BLOCK_SIZE;
+            const size_t RowsInBlock = (std::min)(size_t(MLAS_SPGEMM_BLOCK_SIZE), K - ks);
+
+            //
+            // Fold alpha into the row of A; edge rows of a partial block
+            // multiply the zero padding stored with the block.
+            //
+
+            float a0 = alpha * a[ks];
+            float a1 = (RowsInBlock > 1) ? alpha * a[ks + 1] : 0.0f;
+            float a2 = (RowsInBlock > 2) ? alpha * a[ks + 2] : 0.0f;
+            float a3 = (RowsInBlock > 3) ? alpha * a[ks + 3] : 0.0f;
+
+            if (a0 == 0.0f && a1 == 0.0f && a2 == 0.0f && a3 == 0.0f) {
+                continue;
+            }
+
+            for (size_t idx = RowOffsets[kb]; idx < RowOffsets[kb + 1]; idx++) {
+
+                const size_t ns = size_t(Columns[idx]) * MLAS_SPGEMM_BLOCK_SIZE;
+                const size_t ColumnsInBlock = (std::min)(size_t(MLAS_SPGEMM_BLOCK_SIZE), N - ns);
+                const float* v = Values + idx * MLAS_SPGEMM_BLOCK_SIZE * MLAS_SPGEMM_BLOCK_SIZE;
+
+                for (size_t j = 0; j < ColumnsInBlock; j++) {
+                    c[ns + j] += a0 * v[j] +
+                                 a1 * v[MLAS_SPGEMM_BLOCK_SIZE + j] +
+                                 a2 * v[2 * MLAS_SPGEMM_BLOCK_SIZE + j] +
+                                 a3 * v[3 * MLAS_SPGEMM_BLOCK_SIZE + j];
+                }
+            }
+        }
+    }
+}
+
+static
+void
+MlasSgemmBlockSparseThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a range of output
+    rows of a block-sparse SGEMM.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_SPGEMM_WORK_BLOCK* WorkBlock = (MLAS_SPGEMM_WORK_BLOCK*)Context;
+
+    const size_t ThreadCount = size_t(WorkBlock->ThreadCount);
+
+    const size_t RowsPerThread = WorkBlock->M / ThreadCount;
+    const size_t Remainder = WorkBlock->M % ThreadCount;
+
+    const size_t RowStart = size_t(Index) * RowsPerThread +
+        ((size_t(Index) < Remainder) ? size_t(Index) : Remainder);
+    const size_t RowCount = RowsPerThread + ((size_t(Index) < Remainder) ? 1 : 0);
+
+    MlasSgemmBlockSparseOperation(WorkBlock, RowStart, RowCount);
+}
+
+void
+MLASCALL
+MlasSgemmBlockSparse(
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const void* PackedB,
+    float beta,
+    float* C,
+    size_t ldc
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision matrix/matrix multiply
+    operation C = beta * C + alpha * A * B, where B was packed into the
+    block-CSR layout by MlasSgemmPackBlockSparseB. Only the stored blocks of
+    B are touched, so the cost scales with the density of the matrix. Neither
+    matrix may be transposed.
+
+Arguments:
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix C. Must match the column
+        count the matrix was packed with.
+
+    K - Supplies the number of columns of matrix A. Must match the row count
+        the matrix was packed with.
+
+    alpha - Supplies the scaler alpha multiplier (see SGEMM definition).
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    PackedB - Supplies the address of the packed block-sparse matrix.
+
+    beta - Supplies the scaler beta multiplier (see SGEMM definition).
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_SPGEMM_HEADER* Header = (const MLAS_SPGEMM_HEADER*)PackedB;
+
+    if (M == 0 || N == 0) {
+        return;
+    }
+
+    MLAS_SPGEMM_WORK_BLOCK WorkBlock;
+
+    WorkBlock.M = M;
+    WorkBlock.lda = lda;
+    WorkBlock.ldc = ldc;
+    WorkBlock.alpha = alpha;
+    WorkBlock.beta = beta;
+    WorkBlock.A = A;
+    WorkBlock.PackedB = Header;
+    WorkBlock.C = C;
+
+    //
+    // Compute the number of target threads from the work actually stored,
+    // which is the dense complexity scaled by the block density.
+    //
+
+    double Complexity = double(M) * double(Header->NonzeroBlocks) *
+        double(MLAS_SPGEMM_BLOCK_SIZE * MLAS_SPGEMM_BLOCK_SIZE);
+
+    int32_t TargetThreadCount;
+
+    if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
+        TargetThreadCount = int32_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    int32_t MaximumThreadCount = MlasPlatform.GetMaximumThreadCount();
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    if (size_t(TargetThreadCount) > M) {
+        TargetThreadCount = int32_t(M);
+    }
+
+    WorkBlock.ThreadCount = TargetThreadCount;
+
+    MlasExecuteThreaded(MlasSgemmBlockSparseThreaded, &WorkBlock, TargetThreadCount);
+
+    MLAS_UNREFERENCED_PARAMETER(K);
+}
@@ -16,6 +16,165 @@ Abstract:
 
 #include "mlasi.h"
 
+#include <atomic>
+
+//
+// Stores the application supplied executor, if any. When set, all threaded
+// work is dispatched through the executor instead of OpenMP or the Windows
+// thread pool, so MLAS shares the application's worker threads.
+//
+
+MLAS_PARALLEL_EXECUTOR* MlasParallelExecutor = nullptr;
+int32_t MlasParallelExecutorThreadCount = 1;
+MLAS_PARALLEL_REGION_QUERY* MlasParallelRegionQuery = nullptr;
+
+//
+// Stores the cancellation check installed by the current thread, if any.
+// Thread local so concurrent runs on different threads each poll their own
+// run's state.
+//
+
+thread_local MLAS_THREAD_CANCEL_STATE MlasThreadCancelState = { nullptr, nullptr };
+
+MLAS_THREAD_CANCEL_STATE
+MLASCALL
+MlasSetThreadCancelState(
+    MLAS_THREAD_CANCEL_STATE State
+    )
+/*++
+
+Routine Description:
+
+    This routine installs a cancellation check for threaded work dispatched
+    from the current thread. The check is polled before the work is dispatched
+    and before each work chunk executes; once it reports cancellation the
+    remaining work is skipped and the output of the operation is undefined.
+
+Arguments:
+
+    State - Supplies the cancellation routine and its context, or a null
+        routine to remove the check.
+
+Return Value:
+
+    Returns the previously installed state, so callers can save and restore
+    around a nested scope.
+
+--*/
+{
+    MLAS_THREAD_CANCEL_STATE PreviousState = MlasThreadCancelState;
+
+    MlasThreadCancelState = State;
+
+    return PreviousState;
+}
+
+//
+// Define the parameters to execute threaded work with a cancellation check
+// wrapped around each work chunk.
+//
+
+struct MLAS_CANCELABLE_WORK_BLOCK {
+    MLAS_THREADED_ROUTINE* ThreadedRoutine;
+    void* Context;
+    MLAS_THREAD_CANCEL_STATE CancelState;
+};
+
+static
+void
+MlasCancelableThreadedRoutine(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked in place of the caller's threaded routine when a
+    cancellation check is installed, and skips the work chunk once the check
+    reports cancellation.
+
+Arguments:
+
+    Context - Supplies the pointer to the parameters for the operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_CANCELABLE_WORK_BLOCK* WorkBlock = (MLAS_CANCELABLE_WORK_BLOCK*)Context;
+
+    if (WorkBlock->CancelState.Routine(WorkBlock->CancelState.Context)) {
+        return;
+    }
+
+    WorkBlock->ThreadedRoutine(WorkBlock->Context, Index);
+}
+
+void
+MLASCALL
+MlasSetParallelExecutor(
+    MLAS_PARALLEL_EXECUTOR* Executor,
+    int32_t MaximumThreadCount
+    )
+/*++
+
+Routine Description:
+
+    This routine registers an application supplied executor used to dispatch
+    threaded work. Call before any other MLAS routine; the registration is
+    not synchronized against concurrent MLAS usage.
+
+Arguments:
+
+    Executor - Supplies the executor routine, or nullptr to restore the
+        default threading behavior.
+
+    MaximumThreadCount - Supplies the number of threads the executor can run
+        concurrently, used to partition work.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasParallelExecutor = Executor;
+    MlasParallelExecutorThreadCount = (MaximumThreadCount < 1) ? 1 : MaximumThreadCount;
+}
+
+void
+MLASCALL
+MlasSetParallelRegionQuery(
+    MLAS_PARALLEL_REGION_QUERY* Query
+    )
+/*++
+
+Routine Description:
+
+    This routine registers a query used alongside the application supplied
+    executor to detect that the calling thread is already inside a parallel
+    region. While the query reports true, MLAS partitions work for a single
+    thread. Subject to the same registration caveats as the executor.
+
+Arguments:
+
+    Query - Supplies the query routine, or nullptr to treat every thread as
+        outside any parallel region.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasParallelRegionQuery = Query;
+}
+
 #if defined(MLAS_USE_WIN32_THREADPOOL)
 
 //
@@ -76,6 +235,28 @@ MlasExecuteThreaded(
     int32_t Iterations
     )
 {
+    //
+    // Skip the work entirely if the calling thread's run has already been
+    // cancelled, and otherwise wrap the routine so each work chunk rechecks
+    // before it starts.
+    //
+
+    MLAS_CANCELABLE_WORK_BLOCK CancelableWorkBlock;
+
+    if (MlasThreadCancelState.Routine != nullptr) {
+
+        if (MlasThreadCancelState.Routine(MlasThreadCancelState.Context)) {
+            return;
+        }
+
+        CancelableWorkBlock.ThreadedRoutine = ThreadedRoutine;
+        CancelableWorkBlock.Context = Context;
+        CancelableWorkBlock.CancelState = MlasThreadCancelState;
+
+        ThreadedRoutine = MlasCancelableThreadedRoutine;
+        Context = &CancelableWorkBlock;
+    }
+
     //
     // Execute the routine directly if only one iteration is specified.
     //
@@ -85,6 +266,15 @@ MlasExecuteThreaded(
         return;
     }
 
+    //
+    // Dispatch through the application supplied executor if one is set.
+    //
+
+    if (MlasParallelExecutor != nullptr) {
+        MlasParallelExecutor(ThreadedRoutine, Context, Iterations);
+        return;
+    }
+
 #if defined(MLAS_USE_WIN32_THREADPOOL)
 
     //
@@ -136,3 +326,108 @@ MlasExecuteThreaded(
         ThreadedRoutine(Context, tid);
     }
 }
+
+//
+// Define the parameters to execute threaded work with dynamic load balancing,
+// where each worker thread pulls the next unstarted iteration from a shared
+// counter instead of being assigned exactly one iteration.
+//
+
+struct MLAS_BALANCED_WORK_BLOCK {
+    std::atomic<int32_t> Counter;
+    PMLAS_THREADED_ROUTINE ThreadedRoutine;
+    void* Context;
+    int32_t Iterations;
+};
+
+static
+void
+MlasBalancedThreadedRoutine(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked once per worker thread and repeatedly claims the
+    next unstarted iteration until all iterations have been claimed. Faster
+    cores naturally execute more iterations than slower ones.
+
+Arguments:
+
+    Context - Supplies the pointer to the parameters for the operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_UNREFERENCED_PARAMETER(Index);
+
+    MLAS_BALANCED_WORK_BLOCK* WorkBlock = (MLAS_BALANCED_WORK_BLOCK*)Context;
+
+    for (;;) {
+
+        int32_t Iteration = WorkBlock->Counter.fetch_add(1, std::memory_order_relaxed);
+
+        if (Iteration >= WorkBlock->Iterations) {
+            break;
+        }
+
+        WorkBlock->ThreadedRoutine(WorkBlock->Context, Iteration);
+    }
+}
+
+void
+MlasExecuteThreadedBalanced(
+    PMLAS_THREADED_ROUTINE ThreadedRoutine,
+    void* Context,
+    int32_t Iterations,
+    int32_t ThreadCount
+    )
+/*++
+
+Routine Description:
+
+    This routine executes the threaded routine for the specified number of
+    iterations using at most the specified number of worker threads. When the
+    iteration count exceeds the thread count, workers claim iterations from a
+    shared counter, so the work rebalances itself across heterogeneous cores
+    (big.LITTLE) and SMT siblings that share execution ports. Callers size
+    Iterations a small multiple of ThreadCount via the platform work
+    subdivision factor.
+
+Arguments:
+
+    ThreadedRoutine - Supplies the routine to execute for each iteration.
+
+    Context - Supplies the pointer to the parameters for the operation.
+
+    Iterations - Supplies the number of iterations to execute.
+
+    ThreadCount - Supplies the maximum number of worker threads to use.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (Iterations <= ThreadCount || ThreadCount < 2) {
+        MlasExecuteThreaded(ThreadedRoutine, Context, Iterations);
+        return;
+    }
+
+    MLAS_BALANCED_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Counter.store(0, std::memory_order_relaxed);
+    WorkBlock.ThreadedRoutine = ThreadedRoutine;
+    WorkBlock.Context = Context;
+    WorkBlock.Iterations = Iterations;
+
+    MlasExecuteThreaded(MlasBalancedThreadedRoutine, &WorkBlock, ThreadCount);
+}
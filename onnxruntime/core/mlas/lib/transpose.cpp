@@ -0,0 +1,154 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    transpose.cpp
+
+Abstract:
+
+    This module implements routines to transpose a matrix.
+
+    The implementation walks the matrix in square tiles so the working set of
+    both the source rows and the destination rows stays inside the cache, and
+    transposes each tile with an in-register 4x4 kernel.
+
+--*/
+
+#include "mlasi.h"
+
+void
+MlasTranspose4x4Kernel(
+    const float* Input,
+    size_t InputStride,
+    float* Output,
+    size_t OutputStride
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes a 4x4 tile of the matrix using vector register
+    shuffles.
+
+Arguments:
+
+    Input - Supplies the address of the tile to transpose.
+
+    InputStride - Supplies the number of elements per row of the input matrix.
+
+    Output - Supplies the address to write the transposed tile to.
+
+    OutputStride - Supplies the number of elements per row of the output
+        matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    float32x4_t a0 = vld1q_f32(&Input[0]);
+    float32x4_t a1 = vld1q_f32(&Input[InputStride]);
+    float32x4_t a2 = vld1q_f32(&Input[InputStride * 2]);
+    float32x4_t a3 = vld1q_f32(&Input[InputStride * 3]);
+
+    float32x4x2_t t01 = vtrnq_f32(a0, a1);
+    float32x4x2_t t23 = vtrnq_f32(a2, a3);
+
+    vst1q_f32(&Output[0], vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0])));
+    vst1q_f32(&Output[OutputStride], vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1])));
+    vst1q_f32(&Output[OutputStride * 2], vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0])));
+    vst1q_f32(&Output[OutputStride * 3], vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1])));
+#elif defined(MLAS_SSE2_INTRINSICS)
+    __m128 a0 = _mm_loadu_ps(&Input[0]);
+    __m128 a1 = _mm_loadu_ps(&Input[InputStride]);
+    __m128 a2 = _mm_loadu_ps(&Input[InputStride * 2]);
+    __m128 a3 = _mm_loadu_ps(&Input[InputStride * 3]);
+
+    __m128 t0 = _mm_unpacklo_ps(a0, a1);
+    __m128 t1 = _mm_unpackhi_ps(a0, a1);
+    __m128 t2 = _mm_unpacklo_ps(a2, a3);
+    __m128 t3 = _mm_unpackhi_ps(a2, a3);
+
+    _mm_storeu_ps(&Output[0], _mm_movelh_ps(t0, t2));
+    _mm_storeu_ps(&Output[OutputStride], _mm_movehl_ps(t2, t0));
+    _mm_storeu_ps(&Output[OutputStride * 2], _mm_movelh_ps(t1, t3));
+    _mm_storeu_ps(&Output[OutputStride * 3], _mm_movehl_ps(t3, t1));
+#endif
+}
+
+void
+MLASCALL
+MlasTranspose(
+    const float* Input,
+    float* Output,
+    size_t M,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes the M by N row-major matrix Input into the N by M
+    row-major matrix Output.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer. The buffer must not alias the input
+        buffer.
+
+    M - Supplies the number of rows of the input matrix.
+
+    N - Supplies the number of columns of the input matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t BlockSize = 32;
+
+    for (size_t mb = 0; mb < M; mb += BlockSize) {
+
+        size_t CountM = (std::min)(BlockSize, M - mb);
+
+        for (size_t nb = 0; nb < N; nb += BlockSize) {
+
+            size_t CountN = (std::min)(BlockSize, N - nb);
+
+            const float* a = Input + mb * N + nb;
+            float* b = Output + nb * M + mb;
+
+            size_t m = 0;
+
+            for (; m + 4 <= CountM; m += 4) {
+
+                size_t n = 0;
+
+                for (; n + 4 <= CountN; n += 4) {
+                    MlasTranspose4x4Kernel(a + m * N + n, N, b + n * M + m, M);
+                }
+
+                for (; n < CountN; n++) {
+                    for (size_t i = 0; i < 4; i++) {
+                        b[n * M + m + i] = a[(m + i) * N + n];
+                    }
+                }
+            }
+
+            for (; m < CountM; m++) {
+                for (size_t n = 0; n < CountN; n++) {
+                    b[n * M + m] = a[m * N + n];
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,48 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#include <xmmintrin.h>
+#endif
+
+namespace onnxruntime {
+
+// Turns flush-to-zero and denormals-are-zero on (or off) for the calling
+// thread. Denormal operands drop the SSE units into a microcoded assist path
+// that can cost 10-100x a normal multiply, which decaying RNN states hit
+// reliably; with FTZ/DAZ set they round to zero instead. Returns true when
+// the mode was applied; architectures without the control return false.
+inline bool SetDenormalAsZero(bool on) {
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+  // MXCSR bit 15 is flush-to-zero (results), bit 6 is denormals-are-zero
+  // (operands); both are needed to keep denormals out of a kernel entirely.
+  constexpr unsigned int kFlushToZero = 0x8000;
+  constexpr unsigned int kDenormalsAreZero = 0x0040;
+  unsigned int csr = _mm_getcsr();
+  if (on) {
+    csr |= kFlushToZero | kDenormalsAreZero;
+  } else {
+    csr &= ~(kFlushToZero | kDenormalsAreZero);
+  }
+  _mm_setcsr(csr);
+  return true;
+#else
+  (void)on;
+  return false;
+#endif
+}
+
+// Process-wide opt-in consulted by the thread pools: when set, every pool
+// worker flushes denormals before running tasks. The MXCSR is per thread and
+// workers do not inherit the creator's register, so the pools apply the mode
+// themselves. Set through SessionOptions.enable_denormal_as_zero.
+inline std::atomic<bool>& DenormalFlushForPoolThreads() {
+  static std::atomic<bool> enabled{false};
+  return enabled;
+}
+
+}  // namespace onnxruntime
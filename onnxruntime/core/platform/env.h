@@ -109,6 +109,24 @@ class Env {
   virtual common::Status FileOpenWr(const std::string& path, /*out*/ int& fd) const = 0;
   //Mainly for use with protobuf library
   virtual common::Status FileClose(int fd) const = 0;
+
+#ifdef _WIN32
+  // \brief Map the entire file at 'path' into the process address space read-only.
+  virtual common::Status MapFileIntoMemory(const std::wstring& path,
+                                           /*out*/ const void*& mapped_base,
+                                           /*out*/ size_t& mapped_length) const = 0;
+#endif
+  // \brief Map the entire file at 'path' into the process address space read-only.
+  //
+  // On success returns the base address and length of the mapping. Release it
+  // with UnmapFileFromMemory. Returns an error for files that cannot be mapped
+  // (e.g. zero length); callers should fall back to regular file reads.
+  virtual common::Status MapFileIntoMemory(const std::string& path,
+                                           /*out*/ const void*& mapped_base,
+                                           /*out*/ size_t& mapped_length) const = 0;
+
+  // \brief Release a mapping created by MapFileIntoMemory.
+  virtual common::Status UnmapFileFromMemory(const void* mapped_base, size_t mapped_length) const = 0;
   //This functions is always successful. It can't fail.
   virtual PIDType GetSelfPid() const = 0;
 
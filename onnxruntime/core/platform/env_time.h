@@ -38,6 +38,10 @@ void AccumulateTimeSpec(TIME_SPEC* base, TIME_SPEC* start, TIME_SPEC* end);
 //If the function fails, the return value is zero
 double TimeSpecToSeconds(TIME_SPEC* value);
 
+//Return the value of a monotonic clock in nanoseconds.
+//If the function fails, the return value is zero
+uint64_t GetMonotonicTimeInNanoSeconds();
+
 /// \brief An interface used by the onnxruntime implementation to
 /// access timer related operations.
 class EnvTime {
@@ -0,0 +1,47 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+
+namespace onnxruntime {
+
+/**
+Per-thread hardware performance counter sampling.
+
+A thread's counters accumulate from the moment the thread first samples;
+callers attribute a span by sampling at its start and end and differencing.
+The per-platform implementations live in platform/posix and
+platform/windows; on Linux the counters come from a per-thread perf_event
+group, elsewhere sampling reports itself unavailable and callers fall back
+to wall time only.
+*/
+class PerfCounters {
+ public:
+  struct Sample {
+    uint64_t cycles = 0;
+    uint64_t instructions = 0;
+    uint64_t llc_misses = 0;
+    // cycles in which the backend could not retire work (memory or execution
+    // port stalls); stalled / cycles separates memory-bound from FLOP-bound.
+    uint64_t stalled_cycles = 0;
+  };
+
+  /**
+  True when counter sampling works for the calling process. On Linux this
+  requires perf_event support and a kernel.perf_event_paranoid setting that
+  admits unprivileged self-monitoring.
+  */
+  static bool IsAvailable();
+
+  /**
+  Reads the calling thread's accumulated counter values, opening the
+  per-thread counter group on first use. Counters the PMU cannot provide
+  (e.g. backend stalls on some microarchitectures) read as zero. Returns
+  false when sampling is unavailable, leaving the sample untouched.
+  */
+  static bool SampleThread(Sample& sample);
+};
+
+}  // namespace onnxruntime
@@ -16,6 +16,7 @@ limitations under the License.
 
 #include <unistd.h>
 #include <sys/types.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <dlfcn.h>
@@ -119,6 +120,49 @@ class PosixEnv : public Env {
     return Status::OK();
   }
 
+  common::Status MapFileIntoMemory(const std::string& path,
+                                   /*out*/ const void*& mapped_base,
+                                   /*out*/ size_t& mapped_length) const override {
+    mapped_base = nullptr;
+    mapped_length = 0;
+
+    int fd = open(path.c_str(), O_RDONLY);
+    if (0 > fd) {
+      return common::Status(common::SYSTEM, errno);
+    }
+
+    struct stat stat_buf;
+    if (0 != fstat(fd, &stat_buf)) {
+      int err = errno;
+      close(fd);
+      return common::Status(common::SYSTEM, err);
+    }
+
+    if (stat_buf.st_size <= 0) {
+      close(fd);
+      return common::Status(common::SYSTEM, EINVAL);
+    }
+
+    void* base = mmap(nullptr, static_cast<size_t>(stat_buf.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    int err = errno;
+    // The mapping keeps its own reference to the file; the descriptor can go.
+    close(fd);
+    if (MAP_FAILED == base) {
+      return common::Status(common::SYSTEM, err);
+    }
+
+    mapped_base = base;
+    mapped_length = static_cast<size_t>(stat_buf.st_size);
+    return Status::OK();
+  }
+
+  common::Status UnmapFileFromMemory(const void* mapped_base, size_t mapped_length) const override {
+    if (0 != munmap(const_cast<void*>(mapped_base), mapped_length)) {
+      return common::Status(common::SYSTEM, errno);
+    }
+    return Status::OK();
+  }
+
   virtual common::Status LoadDynamicLibrary(const std::string& library_filename, void** handle) const override {
     char* error_str = dlerror();  // clear any old error_str
     *handle = dlopen(library_filename.c_str(), RTLD_NOW | RTLD_LOCAL);
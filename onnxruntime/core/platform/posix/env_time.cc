@@ -80,4 +80,10 @@ double TimeSpecToSeconds(TIME_SPEC* value) {
   return value->tv_sec + value->tv_nsec / (double)1000000000;
 }
 
+uint64_t GetMonotonicTimeInNanoSeconds() {
+  TIME_SPEC value;
+  if (!GetMonotonicTimeCounter(&value)) return 0;
+  return static_cast<uint64_t>(value.tv_sec) * 1000000000 + value.tv_nsec;
+}
+
 }  // namespace onnxruntime
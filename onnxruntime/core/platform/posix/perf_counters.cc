@@ -0,0 +1,151 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/platform/perf_counters.h"
+
+#if defined(__linux__)
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <utility>
+
+namespace onnxruntime {
+
+namespace {
+
+// Counter slots, in the order they are added to the perf_event group.
+enum CounterSlot {
+  kCycles = 0,
+  kInstructions = 1,
+  kLlcMisses = 2,
+  kStalledCycles = 3,
+  kNumCounters = 4
+};
+
+static int OpenCounter(uint32_t type, uint64_t config, int group_fd) {
+  perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.type = type;
+  attr.size = sizeof(attr);
+  attr.config = config;
+  // the leader starts disabled so the group begins counting atomically once
+  // every member has been added.
+  attr.disabled = group_fd == -1 ? 1 : 0;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  if (group_fd == -1) {
+    attr.read_format = PERF_FORMAT_GROUP;
+  }
+  return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0));
+}
+
+// One perf_event group per thread, scheduled on and off the PMU as a unit
+// so the four counters always cover the same cycles. Counters the PMU
+// cannot provide are simply absent from the group and read as zero.
+struct ThreadCounterGroup {
+  int fds[kNumCounters] = {-1, -1, -1, -1};
+  // position of each slot in the group read buffer, -1 when not opened.
+  int read_positions[kNumCounters] = {-1, -1, -1, -1};
+  int opened_count = 0;
+  bool open_attempted = false;
+
+  bool Open() {
+    open_attempted = true;
+
+    fds[kCycles] = OpenCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, -1);
+    if (fds[kCycles] < 0) {
+      fds[kCycles] = -1;
+      return false;  // no leader, typically perf_event_paranoid forbids it
+    }
+    read_positions[kCycles] = opened_count++;
+
+    const std::pair<CounterSlot, uint64_t> members[] = {
+        {kInstructions, PERF_COUNT_HW_INSTRUCTIONS},
+        {kLlcMisses, PERF_COUNT_HW_CACHE_MISSES},
+        {kStalledCycles, PERF_COUNT_HW_STALLED_CYCLES_BACKEND}};
+    for (const auto& member : members) {
+      fds[member.first] = OpenCounter(PERF_TYPE_HARDWARE, member.second, fds[kCycles]);
+      if (fds[member.first] >= 0) {
+        read_positions[member.first] = opened_count++;
+      } else {
+        fds[member.first] = -1;
+      }
+    }
+
+    ioctl(fds[kCycles], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(fds[kCycles], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return true;
+  }
+
+  bool Read(PerfCounters::Sample& sample) {
+    // PERF_FORMAT_GROUP layout: { u64 nr; u64 values[nr]; } in the order
+    // the members were added to the group.
+    uint64_t buffer[1 + kNumCounters];
+    const ssize_t wanted = static_cast<ssize_t>((1 + opened_count) * sizeof(uint64_t));
+    if (read(fds[kCycles], buffer, sizeof(buffer)) < wanted) {
+      return false;
+    }
+
+    uint64_t values[kNumCounters] = {0, 0, 0, 0};
+    for (int slot = 0; slot < kNumCounters; ++slot) {
+      if (read_positions[slot] >= 0) {
+        values[slot] = buffer[1 + read_positions[slot]];
+      }
+    }
+    sample.cycles = values[kCycles];
+    sample.instructions = values[kInstructions];
+    sample.llc_misses = values[kLlcMisses];
+    sample.stalled_cycles = values[kStalledCycles];
+    return true;
+  }
+
+  ~ThreadCounterGroup() {
+    for (int slot = kNumCounters - 1; slot >= 0; --slot) {
+      if (fds[slot] != -1) {
+        close(fds[slot]);
+      }
+    }
+  }
+};
+
+}  // namespace
+
+bool PerfCounters::IsAvailable() {
+  Sample sample;
+  return SampleThread(sample);
+}
+
+bool PerfCounters::SampleThread(Sample& sample) {
+  static thread_local ThreadCounterGroup group;
+  if (!group.open_attempted && !group.Open()) {
+    return false;
+  }
+  if (group.fds[kCycles] == -1) {
+    return false;
+  }
+  return group.Read(sample);
+}
+
+}  // namespace onnxruntime
+
+#else  // !defined(__linux__)
+
+namespace onnxruntime {
+
+// No perf_event equivalent is wired up for other POSIX systems; callers
+// fall back to wall time only.
+bool PerfCounters::IsAvailable() {
+  return false;
+}
+
+bool PerfCounters::SampleThread(Sample& /*sample*/) {
+  return false;
+}
+
+}  // namespace onnxruntime
+
+#endif  // defined(__linux__)
@@ -0,0 +1,169 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/platform/thread_affinity.h"
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <cstdio>
+#include <vector>
+#endif
+
+namespace onnxruntime {
+
+#if defined(__linux__)
+
+bool SetThreadAffinity(std::thread& thread, uint64_t affinity_mask) {
+  if (affinity_mask == 0) {
+    return false;
+  }
+
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  for (unsigned cpu = 0; cpu < 64; ++cpu) {
+    if (affinity_mask & (uint64_t{1} << cpu)) {
+      CPU_SET(cpu, &cpuset);
+    }
+  }
+
+  return pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &cpuset) == 0;
+}
+
+uint64_t GetNumaNodeAffinityMask(int numa_node) {
+  if (numa_node < 0) {
+    return 0;
+  }
+
+  // The kernel publishes each node's processors as a range list, e.g.
+  // "0-17,36-53". Parsing it here avoids a libnuma dependency.
+  char path[64];
+  snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", numa_node);
+  FILE* file = fopen(path, "r");
+  if (file == nullptr) {
+    return 0;
+  }
+
+  uint64_t mask = 0;
+  int lo;
+  while (fscanf(file, "%d", &lo) == 1) {
+    int hi = lo;
+    int separator = fgetc(file);
+    if (separator == '-' && fscanf(file, "%d", &hi) == 1) {
+      separator = fgetc(file);
+    }
+    for (int cpu = lo; cpu <= hi; ++cpu) {
+      if (cpu >= 0 && cpu < 64) {
+        mask |= uint64_t{1} << cpu;
+      }
+    }
+    if (separator != ',') {
+      break;
+    }
+  }
+
+  fclose(file);
+  return mask;
+}
+
+namespace {
+
+// The node masks never change while the process runs, so read sysfs once.
+const std::vector<uint64_t>& NodeAffinityMasks() {
+  static const std::vector<uint64_t> masks = [] {
+    std::vector<uint64_t> node_masks;
+    for (int node = 0;; ++node) {
+      uint64_t mask = GetNumaNodeAffinityMask(node);
+      if (mask == 0) {
+        break;
+      }
+      node_masks.push_back(mask);
+    }
+    return node_masks;
+  }();
+  return masks;
+}
+
+}  // namespace
+
+int GetNumaNodeCount() {
+  size_t nodes = NodeAffinityMasks().size();
+  return nodes > 0 ? static_cast<int>(nodes) : 1;
+}
+
+int GetCurrentThreadNumaNode() {
+  int cpu = sched_getcpu();
+  if (cpu < 0 || cpu >= 64) {
+    return 0;
+  }
+  const auto& masks = NodeAffinityMasks();
+  for (size_t node = 0; node < masks.size(); ++node) {
+    if (masks[node] & (uint64_t{1} << cpu)) {
+      return static_cast<int>(node);
+    }
+  }
+  return 0;
+}
+
+uint64_t GetCurrentThreadAffinityMask() {
+  cpu_set_t cpuset;
+  if (pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset) != 0) {
+    return 0;
+  }
+
+  uint64_t mask = 0;
+  for (unsigned cpu = 0; cpu < 64; ++cpu) {
+    if (CPU_ISSET(cpu, &cpuset)) {
+      mask |= uint64_t{1} << cpu;
+    }
+  }
+  return mask;
+}
+
+bool SetCurrentThreadAffinityMask(uint64_t affinity_mask) {
+  if (affinity_mask == 0) {
+    return false;
+  }
+
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  for (unsigned cpu = 0; cpu < 64; ++cpu) {
+    if (affinity_mask & (uint64_t{1} << cpu)) {
+      CPU_SET(cpu, &cpuset);
+    }
+  }
+
+  return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset) == 0;
+}
+
+#else  // !defined(__linux__)
+
+// pthread_setaffinity_np is a Linux extension; other POSIX platforms run
+// unpinned.
+bool SetThreadAffinity(std::thread& /*thread*/, uint64_t /*affinity_mask*/) {
+  return false;
+}
+
+uint64_t GetNumaNodeAffinityMask(int /*numa_node*/) {
+  return 0;
+}
+
+int GetNumaNodeCount() {
+  return 1;
+}
+
+int GetCurrentThreadNumaNode() {
+  return 0;
+}
+
+uint64_t GetCurrentThreadAffinityMask() {
+  return 0;
+}
+
+bool SetCurrentThreadAffinityMask(uint64_t /*affinity_mask*/) {
+  return false;
+}
+
+#endif
+
+}  // namespace onnxruntime
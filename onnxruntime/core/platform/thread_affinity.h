@@ -0,0 +1,41 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <thread>
+
+namespace onnxruntime {
+
+// Pins a thread to the logical processors selected by an affinity bitmask
+// (bit k set => the thread may run on logical processor k). A zero mask is
+// rejected. Returns true when the affinity was applied; platforms without
+// affinity support return false.
+bool SetThreadAffinity(std::thread& thread, uint64_t affinity_mask);
+
+// Returns the affinity bitmask covering the logical processors of the given
+// NUMA node, or 0 when the node is unknown or the platform cannot resolve the
+// topology. Logical processors beyond the first 64 are not representable in
+// the mask and are left out.
+uint64_t GetNumaNodeAffinityMask(int numa_node);
+
+// Returns the number of NUMA nodes with resolvable processors, at least 1.
+// Platforms without topology information report a single node.
+int GetNumaNodeCount();
+
+// Returns the NUMA node of the processor the calling thread is currently
+// running on, or 0 when it cannot be determined.
+int GetCurrentThreadNumaNode();
+
+// Returns the affinity bitmask the calling thread currently runs under, or 0
+// when it cannot be read.
+uint64_t GetCurrentThreadAffinityMask();
+
+// Rebinds the calling thread to the processors selected by the bitmask. Pair
+// with GetCurrentThreadAffinityMask to run a short section on chosen
+// processors and restore the previous binding afterwards. A zero mask is
+// rejected.
+bool SetCurrentThreadAffinityMask(uint64_t affinity_mask);
+
+}  // namespace onnxruntime
@@ -134,6 +134,30 @@ class WindowsEnv : public Env {
     return Status::OK();
   }
 
+  common::Status MapFileIntoMemory(const std::wstring& path,
+                                   /*out*/ const void*& mapped_base,
+                                   /*out*/ size_t& mapped_length) const override {
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    return MapOpenedFileIntoMemory(file, mapped_base, mapped_length);
+  }
+
+  common::Status MapFileIntoMemory(const std::string& path,
+                                   /*out*/ const void*& mapped_base,
+                                   /*out*/ size_t& mapped_length) const override {
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    return MapOpenedFileIntoMemory(file, mapped_base, mapped_length);
+  }
+
+  common::Status UnmapFileFromMemory(const void* mapped_base, size_t mapped_length) const override {
+    ONNXRUNTIME_UNUSED_PARAMETER(mapped_length);
+    if (!UnmapViewOfFile(mapped_base)) {
+      return common::Status(common::SYSTEM, GetLastError());
+    }
+    return Status::OK();
+  }
+
   virtual Status LoadDynamicLibrary(const std::string& library_filename, void** handle) const override {
     ONNXRUNTIME_UNUSED_PARAMETER(library_filename);
     ONNXRUNTIME_UNUSED_PARAMETER(handle);
@@ -159,6 +183,44 @@ class WindowsEnv : public Env {
   }
 
  private:
+  // Maps an already opened file read-only and closes the file handle;
+  // the view keeps its own reference on the file.
+  static common::Status MapOpenedFileIntoMemory(HANDLE file,
+                                                /*out*/ const void*& mapped_base,
+                                                /*out*/ size_t& mapped_length) {
+    mapped_base = nullptr;
+    mapped_length = 0;
+
+    if (file == INVALID_HANDLE_VALUE) {
+      return common::Status(common::SYSTEM, GetLastError());
+    }
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart <= 0) {
+      DWORD err = GetLastError();
+      CloseHandle(file);
+      return common::Status(common::SYSTEM, err != 0 ? err : ERROR_INVALID_DATA);
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    DWORD err = GetLastError();
+    CloseHandle(file);
+    if (mapping == nullptr) {
+      return common::Status(common::SYSTEM, err);
+    }
+
+    void* base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    err = GetLastError();
+    CloseHandle(mapping);
+    if (base == nullptr) {
+      return common::Status(common::SYSTEM, err);
+    }
+
+    mapped_base = base;
+    mapped_length = static_cast<size_t>(file_size.QuadPart);
+    return Status::OK();
+  }
+
   WindowsEnv()
       : GetSystemTimePreciseAsFileTime_(nullptr) {
     // GetSystemTimePreciseAsFileTime function is only available in the latest
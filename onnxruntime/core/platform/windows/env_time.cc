@@ -115,4 +115,14 @@ double TimeSpecToSeconds(TIME_SPEC* value) {
   return *value / (double)freq.QuadPart;
 }
 
+uint64_t GetMonotonicTimeInNanoSeconds() {
+  BOOL initState = InitOnceExecuteOnce(&g_InitOnce, InitHandleFunction, nullptr, nullptr);
+  if (!initState) return 0;
+  TIME_SPEC value;
+  if (!GetMonotonicTimeCounter(&value)) return 0;
+  // split the conversion to avoid overflowing the counter * 10^9 product
+  return static_cast<uint64_t>(value / freq.QuadPart) * 1000000000 +
+         static_cast<uint64_t>(value % freq.QuadPart) * 1000000000 / freq.QuadPart;
+}
+
 }  // namespace onnxruntime
@@ -0,0 +1,21 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/platform/perf_counters.h"
+
+namespace onnxruntime {
+
+// Self-monitoring PMU access on Windows requires an ETW kernel trace
+// session with PMC profile sources, which cannot be attributed to
+// individual threads from user mode the way a perf_event group can.
+// Until that is wired up, sampling reports itself unavailable and the
+// profiler records wall time only.
+bool PerfCounters::IsAvailable() {
+  return false;
+}
+
+bool PerfCounters::SampleThread(Sample& /*sample*/) {
+  return false;
+}
+
+}  // namespace onnxruntime
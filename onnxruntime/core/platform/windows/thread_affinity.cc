@@ -0,0 +1,74 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <Windows.h>
+
+#include "core/platform/thread_affinity.h"
+
+namespace onnxruntime {
+
+bool SetThreadAffinity(std::thread& thread, uint64_t affinity_mask) {
+  if (affinity_mask == 0) {
+    return false;
+  }
+
+  return ::SetThreadAffinityMask(thread.native_handle(), static_cast<DWORD_PTR>(affinity_mask)) != 0;
+}
+
+uint64_t GetNumaNodeAffinityMask(int numa_node) {
+  if (numa_node < 0 || numa_node > MAXUCHAR) {
+    return 0;
+  }
+
+  ULONGLONG processor_mask;
+  if (!GetNumaNodeProcessorMask(static_cast<UCHAR>(numa_node), &processor_mask)) {
+    return 0;
+  }
+
+  return static_cast<uint64_t>(processor_mask);
+}
+
+int GetNumaNodeCount() {
+  ULONG highest_node;
+  if (!GetNumaHighestNodeNumber(&highest_node)) {
+    return 1;
+  }
+  return static_cast<int>(highest_node) + 1;
+}
+
+int GetCurrentThreadNumaNode() {
+  PROCESSOR_NUMBER processor;
+  GetCurrentProcessorNumberEx(&processor);
+
+  USHORT node;
+  if (!GetNumaProcessorNodeEx(&processor, &node) || node == 0xffff) {
+    return 0;
+  }
+  return static_cast<int>(node);
+}
+
+uint64_t GetCurrentThreadAffinityMask() {
+  // There is no query API; rebind to the process mask and restore to learn
+  // the previous binding.
+  DWORD_PTR process_mask;
+  DWORD_PTR system_mask;
+  if (!GetProcessAffinityMask(GetCurrentProcess(), &process_mask, &system_mask) || process_mask == 0) {
+    return 0;
+  }
+
+  DWORD_PTR previous = ::SetThreadAffinityMask(GetCurrentThread(), process_mask);
+  if (previous != 0 && previous != process_mask) {
+    ::SetThreadAffinityMask(GetCurrentThread(), previous);
+  }
+  return static_cast<uint64_t>(previous);
+}
+
+bool SetCurrentThreadAffinityMask(uint64_t affinity_mask) {
+  if (affinity_mask == 0) {
+    return false;
+  }
+
+  return ::SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(affinity_mask)) != 0;
+}
+
+}  // namespace onnxruntime
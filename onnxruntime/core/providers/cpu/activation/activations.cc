@@ -30,6 +30,67 @@ REGISTER_UNARY_ELEMENTWISE_KERNEL(Softsign, 1);
 REGISTER_UNARY_ELEMENTWISE_KERNEL(Tanh, 6);
 REGISTER_UNARY_ELEMENTWISE_KERNEL(ThresholdedRelu, 1);
 
+template <>
+Status Elu<float>::Compute(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(0);
+  const auto& x_shape = X->Shape();
+  Tensor* Y = context->Output(0, x_shape);
+  MLAS_ACTIVATION activation;
+  activation.ActivationKind = MlasEluActivation;
+  activation.Parameters.Elu.alpha = alpha_;
+  MlasComputeActivation(&activation, X->template Data<float>(), Y->template MutableData<float>(), x_shape.Size());
+  return Status::OK();
+}
+
+template <>
+Status HardSigmoid<float>::Compute(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(0);
+  const auto& x_shape = X->Shape();
+  Tensor* Y = context->Output(0, x_shape);
+  MLAS_ACTIVATION activation;
+  activation.ActivationKind = MlasHardSigmoidActivation;
+  activation.Parameters.HardSigmoid.alpha = alpha_;
+  activation.Parameters.HardSigmoid.beta = beta_;
+  MlasComputeActivation(&activation, X->template Data<float>(), Y->template MutableData<float>(), x_shape.Size());
+  return Status::OK();
+}
+
+template <>
+Status LeakyRelu<float>::Compute(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(0);
+  const auto& x_shape = X->Shape();
+  Tensor* Y = context->Output(0, x_shape);
+  MLAS_ACTIVATION activation;
+  activation.ActivationKind = MlasLeakyReluActivation;
+  activation.Parameters.LeakyRelu.alpha = alpha_;
+  MlasComputeActivation(&activation, X->template Data<float>(), Y->template MutableData<float>(), x_shape.Size());
+  return Status::OK();
+}
+
+template <>
+Status ParametricSoftplus<float>::Compute(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(0);
+  const auto& x_shape = X->Shape();
+  Tensor* Y = context->Output(0, x_shape);
+  MLAS_ACTIVATION activation;
+  activation.ActivationKind = MlasSoftplusActivation;
+  activation.Parameters.Softplus.alpha = alpha_;
+  activation.Parameters.Softplus.beta = beta_;
+  MlasComputeActivation(&activation, X->template Data<float>(), Y->template MutableData<float>(), x_shape.Size());
+  return Status::OK();
+}
+
+template <>
+Status Relu<float>::Compute(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(0);
+  const auto& x_shape = X->Shape();
+  Tensor* Y = context->Output(0, x_shape);
+  MLAS_ACTIVATION activation;
+  activation.ActivationKind = MlasReluActivation;
+  MlasComputeActivation(&activation, X->template Data<float>(), Y->template MutableData<float>(), x_shape.Size());
+  return Status::OK();
+}
+
 template <>
 Status Sigmoid<float>::Compute(OpKernelContext* context) const {
   const Tensor* X = context->Input<Tensor>(0);
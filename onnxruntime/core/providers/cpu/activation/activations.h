@@ -31,6 +31,9 @@ class Elu final : public OpKernel {
   const float alpha_;
 };
 
+template <>
+Status Elu<float>::Compute(OpKernelContext* context) const;
+
 template <typename T>
 class HardSigmoid final : public OpKernel {
  public:
@@ -51,6 +54,9 @@ class HardSigmoid final : public OpKernel {
   const float beta_;
 };
 
+template <>
+Status HardSigmoid<float>::Compute(OpKernelContext* context) const;
+
 template <typename T>
 class LeakyRelu final : public OpKernel {
  public:
@@ -68,6 +74,9 @@ class LeakyRelu final : public OpKernel {
   const float alpha_;
 };
 
+template <>
+Status LeakyRelu<float>::Compute(OpKernelContext* context) const;
+
 template <typename T>
 class ParametricSoftplus final : public OpKernel {
  public:
@@ -89,6 +98,9 @@ class ParametricSoftplus final : public OpKernel {
   const float beta_;
 };
 
+template <>
+Status ParametricSoftplus<float>::Compute(OpKernelContext* context) const;
+
 template <typename T>
 class Relu final : public OpKernel {
  public:
@@ -102,6 +114,9 @@ class Relu final : public OpKernel {
   }
 };
 
+template <>
+Status Relu<float>::Compute(OpKernelContext* context) const;
+
 template <typename T>
 class ScaledTanh final : public OpKernel {
  public:
@@ -3,6 +3,8 @@
 
 #include "core/providers/cpu/controlflow/if.h"
 
+#include <algorithm>
+
 #include "core/framework/framework_common.h"
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/sequential_executor.h"
@@ -54,10 +56,98 @@ ONNX_CPU_OPERATOR_KERNEL(If,
                              .TypeConstraint("V", DataTypeImpl::AllTensorTypes()),
                          If);
 
+namespace {
+
+// FNV-1a over raw bytes. Cheap relative to re-executing a branch. The hash is
+// only a filter: a match is confirmed byte-for-byte against the saved feeds
+// (see FeedsMatchMemo) before the memo is trusted.
+constexpr uint64_t kFnvOffsetBasis = 0xcbf29ce484222325ULL;
+constexpr uint64_t kFnvPrime = 0x100000001b3ULL;
+
+uint64_t HashBytes(const void* data, size_t length, uint64_t hash) {
+  auto* bytes = static_cast<const unsigned char*>(data);
+  for (size_t i = 0; i < length; ++i) {
+    hash = (hash ^ bytes[i]) * kFnvPrime;
+  }
+  return hash;
+}
+
+using SortedFeedEntries = std::vector<const std::pair<const std::string, MLValue>*>;
+
+// view of the feeds in name order, so neither the hash nor the saved feed
+// order depends on the unordered_map iteration order.
+SortedFeedEntries SortFeeds(const NameMLValMap& feeds) {
+  SortedFeedEntries entries;
+  entries.reserve(feeds.size());
+  for (const auto& entry : feeds) {
+    entries.push_back(&entry);
+  }
+
+  std::sort(entries.begin(), entries.end(),
+            [](const std::pair<const std::string, MLValue>* a,
+               const std::pair<const std::string, MLValue>* b) { return a->first < b->first; });
+  return entries;
+}
+
+// hash the name, shape and contents of every feed. returns false when a feed
+// can't be byte-compared (non-tensor, string tensor or non-CPU data), which
+// disables memoization for this execution.
+bool TryHashFeeds(const SortedFeedEntries& entries, uint64_t* hash_out) {
+  uint64_t hash = kFnvOffsetBasis;
+  for (const auto* entry : entries) {
+    if (!entry->second.IsTensor())
+      return false;
+
+    const auto& tensor = entry->second.Get<Tensor>();
+    if (tensor.DataType() == DataTypeImpl::GetType<std::string>() ||
+        strcmp(tensor.Location().name, CPU) != 0)
+      return false;
+
+    hash = HashBytes(entry->first.data(), entry->first.size(), hash);
+
+    const auto& dims = tensor.Shape().GetDims();
+    hash = HashBytes(dims.data(), dims.size() * sizeof(int64_t), hash);
+
+    if (tensor.Size() > 0)
+      hash = HashBytes(tensor.DataRaw(), tensor.Size(), hash);
+  }
+
+  *hash_out = hash;
+  return true;
+}
+
+// byte-for-byte confirmation of a hash match against the feeds saved with the
+// memo. the hash already covers names, shapes and contents, so a mismatch
+// here is a genuine 64-bit collision; it falls through to normal execution.
+bool FeedsMatchMemo(const SortedFeedEntries& entries, const If::BranchMemo& memo) {
+  if (entries.size() != memo.feeds.size())
+    return false;
+
+  for (size_t i = 0; i < entries.size(); ++i) {
+    const auto& saved = memo.feeds[i];
+    if (entries[i]->first != saved.first)
+      return false;
+
+    const auto& tensor = entries[i]->second.Get<Tensor>();
+    const auto& saved_tensor = saved.second.Get<Tensor>();
+    if (tensor.Shape() != saved_tensor.Shape())
+      return false;
+
+    if (tensor.Size() > 0 &&
+        memcmp(tensor.DataRaw(), saved_tensor.DataRaw(), tensor.Size()) != 0)
+      return false;
+  }
+
+  return true;
+}
+
+}  // namespace
+
 class IfImpl {
  public:
   IfImpl(OpKernelContextInternal& context,
-         const SessionState& session_state);
+         const SessionState& session_state,
+         If::BranchMemo* memo);
 
   // Initialize by validating all the inputs, and allocating the output tensors
   Status Initialize();
@@ -69,9 +159,23 @@ class IfImpl {
  private:
   Status AllocateOutputTensors();
 
+  // copy the memoized branch outputs into the If outputs. returns false when
+  // the memo can't serve this execution (e.g. output shape mismatch), in
+  // which case the branch executes normally.
+  bool TryReuseMemoizedOutputs();
+
+  // deep-copy the fetches into the memo. returns false when a fetch can't be
+  // cached, leaving the memo invalid.
+  bool SaveMemoizedOutputs(const std::vector<MLValue>& fetches);
+
+  // deep-copy the feeds into the memo so later hash matches can be confirmed
+  // byte-for-byte. TryHashFeeds already proved every feed copyable.
+  bool SaveMemoizedFeeds(const SortedFeedEntries& entries);
+
   OpKernelContextInternal& context_;
   const SessionState& session_state_;
   const GraphViewer& subgraph_;
+  If::BranchMemo* memo_;
 
   int num_outputs_;
   std::vector<std::string> subgraph_output_names_;
@@ -95,7 +199,16 @@ Status If::Compute(OpKernelContext* ctx) const {
   auto* session_state = ctx_internal->SubgraphSessionState(attribute);
   ONNXRUNTIME_ENFORCE(session_state, "Subgraph SessionState was not found for '", attribute, "' attribute.");
 
-  IfImpl impl{*ctx_internal, *session_state};
+  // serialize executions of this node while memoizing so concurrent Run calls
+  // can't interleave reads and updates of a branch memo.
+  std::unique_lock<std::mutex> memo_lock;
+  If::BranchMemo* memo = nullptr;
+  if (session_state->GetEnableSubgraphMemoization()) {
+    memo_lock = std::unique_lock<std::mutex>{memo_lock_};
+    memo = &memos_[condition ? 1 : 0];
+  }
+
+  IfImpl impl{*ctx_internal, *session_state, memo};
 
   auto status = impl.Initialize();
   ONNXRUNTIME_RETURN_IF_ERROR(status);
@@ -106,10 +219,12 @@ Status If::Compute(OpKernelContext* ctx) const {
 }
 
 IfImpl::IfImpl(OpKernelContextInternal& context,
-               const SessionState& session_state)
+               const SessionState& session_state,
+               If::BranchMemo* memo)
     : context_{context},
       session_state_{session_state},
       subgraph_{*session_state.GetGraphViewer()},
+      memo_{memo},
       implicit_inputs_{context_.GetImplicitInputs()} {
   num_outputs_ = context_.OutputCount();
 }
@@ -193,6 +308,16 @@ Status IfImpl::Execute() {
     }
   }
 
+  uint64_t feeds_hash = 0;
+  const auto feed_entries = SortFeeds(feeds);
+  const bool can_memoize = memo_ != nullptr && TryHashFeeds(feed_entries, &feeds_hash);
+
+  if (can_memoize && memo_->valid && memo_->feeds_hash == feeds_hash &&
+      FeedsMatchMemo(feed_entries, *memo_)) {
+    if (TryReuseMemoizedOutputs())
+      return Status::OK();
+  }
+
   std::vector<MLValue> fetches;
   fetches.reserve(num_outputs_);
 
@@ -200,7 +325,7 @@ Status IfImpl::Execute() {
     fetches.push_back(outputs_[i].second);
   }
 
-  SequentialExecutor executor{context_.GetTerminateFlag()};
+  SequentialExecutor executor{context_.GetCancellation()};
   status = executor.Execute(session_state_, feeds, subgraph_output_names_, fetches, context_.Logger());
   ONNXRUNTIME_RETURN_IF_ERROR(status);
 
@@ -215,7 +340,102 @@ Status IfImpl::Execute() {
     }
   }
 
+  if (can_memoize) {
+    // best effort: a fetch that can't be copied just leaves the memo invalid.
+    memo_->valid = SaveMemoizedOutputs(fetches) && SaveMemoizedFeeds(feed_entries);
+    memo_->feeds_hash = feeds_hash;
+  }
+
   return status;
 }
 
+bool IfImpl::TryReuseMemoizedOutputs() {
+  if (memo_->fetches.size() != static_cast<size_t>(num_outputs_))
+    return false;
+
+  // validate before touching the If outputs: a statically shaped output was
+  // already allocated by AllocateOutputTensors and must match the cached
+  // shape exactly.
+  for (int i = 0; i < num_outputs_; ++i) {
+    const auto& cached = memo_->fetches[i].Get<Tensor>();
+
+    if (outputs_[i].first == AllocationType::IfOutput &&
+        outputs_[i].second.Get<Tensor>().Shape() != cached.Shape())
+      return false;
+  }
+
+  for (int i = 0; i < num_outputs_; ++i) {
+    const auto& cached = memo_->fetches[i].Get<Tensor>();
+
+    Tensor* output = context_.Output(i, cached.Shape());
+    if (!output)
+      return false;
+
+    if (cached.Size() > 0)
+      memcpy(output->MutableDataRaw(), cached.DataRaw(), cached.Size());
+  }
+
+  return true;
+}
+
+bool IfImpl::SaveMemoizedOutputs(const std::vector<MLValue>& fetches) {
+  AllocatorPtr allocator;
+  if (!context_.GetTempSpaceAllocator(&allocator).IsOK())
+    return false;
+
+  std::vector<MLValue> copies;
+  copies.reserve(fetches.size());
+
+  for (const auto& fetch : fetches) {
+    if (!fetch.IsTensor())
+      return false;
+
+    const auto& tensor = fetch.Get<Tensor>();
+    if (tensor.DataType() == DataTypeImpl::GetType<std::string>() ||
+        strcmp(tensor.Location().name, CPU) != 0)
+      return false;
+
+    void* buffer = tensor.Size() > 0 ? allocator->Alloc(tensor.Size()) : nullptr;
+    auto copy = std::make_unique<Tensor>(tensor.DataType(), tensor.Shape(), buffer,
+                                         allocator->Info(), allocator);
+    if (tensor.Size() > 0)
+      memcpy(copy->MutableDataRaw(), tensor.DataRaw(), tensor.Size());
+
+    MLValue value;
+    value.Init(copy.release(), DataTypeImpl::GetType<Tensor>(),
+               DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+    copies.push_back(value);
+  }
+
+  memo_->fetches = std::move(copies);
+  return true;
+}
+
+bool IfImpl::SaveMemoizedFeeds(const SortedFeedEntries& entries) {
+  AllocatorPtr allocator;
+  if (!context_.GetTempSpaceAllocator(&allocator).IsOK())
+    return false;
+
+  std::vector<std::pair<std::string, MLValue>> copies;
+  copies.reserve(entries.size());
+
+  for (const auto* entry : entries) {
+    const auto& tensor = entry->second.Get<Tensor>();
+
+    void* buffer = tensor.Size() > 0 ? allocator->Alloc(tensor.Size()) : nullptr;
+    auto copy = std::make_unique<Tensor>(tensor.DataType(), tensor.Shape(), buffer,
+                                         allocator->Info(), allocator);
+    if (tensor.Size() > 0)
+      memcpy(copy->MutableDataRaw(), tensor.DataRaw(), tensor.Size());
+
+    MLValue value;
+    value.Init(copy.release(), DataTypeImpl::GetType<Tensor>(),
+               DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+    copies.emplace_back(entry->first, value);
+  }
+
+  memo_->feeds = std::move(copies);
+  return true;
+}
+
 }  // namespace onnxruntime
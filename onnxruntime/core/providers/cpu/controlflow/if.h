@@ -2,7 +2,10 @@
 // Licensed under the MIT License.
 
 #pragma once
+#include <cstdint>
 #include <functional>
+#include <mutex>
+#include <vector>
 #include "gsl/gsl_util"
 
 #include "core/common/common.h"
@@ -26,6 +29,24 @@ class If final : public OpKernel {
 
   Status Compute(OpKernelContext* ctx) const override;
 
+  // Result of a branch's most recent execution, reused across Run calls when
+  // the branch sees byte-identical feeds again. Only populated when the
+  // session enables subgraph memoization. The fetches hold private copies of
+  // the branch outputs so a cache hit never aliases a buffer a downstream
+  // kernel may write to.
+  struct BranchMemo {
+    bool valid = false;
+    uint64_t feeds_hash = 0;
+    // private copies of the feeds that produced the fetches, in name order. a
+    // hash match is confirmed byte-for-byte against these before reuse, so a
+    // 64-bit collision can't serve stale outputs; the feeds are small CPU
+    // tensors, so the copies and the compare are cheap next to a branch run.
+    std::vector<std::pair<std::string, MLValue>> feeds;
+    std::vector<MLValue> fetches;
+  };
+
  private:
+  mutable std::mutex memo_lock_;
+  mutable BranchMemo memos_[2];  // [0] else_branch, [1] then_branch
 };
 }  // namespace onnxruntime
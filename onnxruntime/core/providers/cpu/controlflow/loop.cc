@@ -13,10 +13,10 @@
 
 #include "core/framework/framework_common.h"
 #include "core/framework/op_kernel_context_internal.h"
-#include "core/framework/sequential_executor.h"
 #include "core/framework/session_state.h"
 #include "core/framework/tensorprotoutils.h"
 
+#include "core/providers/cpu/controlflow/subgraph_execution_context.h"
 #include "core/providers/cpu/tensor/utils.h"
 
 #include "gsl/gsl_algorithm"
@@ -121,6 +121,9 @@ class LoopImpl {
   MLValue iter_num_mlvalue_;
   MLValue condition_mlvalue_;
 
+  // executes the subgraph, reusing one execution frame across iterations
+  SubgraphExecutionContext subgraph_context_;
+
   std::vector<std::string> subgraph_input_names_;
   std::vector<std::string> subgraph_output_names_;
 
@@ -149,7 +152,8 @@ LoopImpl::LoopImpl(OpKernelContextInternal& context,
     : context_{context},
       session_state_{session_state},
       subgraph_{*session_state.GetGraphViewer()},
-      implicit_inputs_{context_.GetImplicitInputs()} {
+      implicit_inputs_{context_.GetImplicitInputs()},
+      subgraph_context_{session_state, context.GetCancellation()} {
   auto* max_trip_count_tensor = context.Input<Tensor>(0);
   max_trip_count_ = max_trip_count_tensor ? *max_trip_count_tensor->Data<int64_t>() : INT64_MAX;
 
@@ -311,13 +315,20 @@ Status LoopImpl::Execute() {
   auto& iter_num_value = *iter_num_mlvalue_.GetMutable<Tensor>()->MutableData<int64_t>();
 
   while (iter_num_value < max_trip_count_ && *condition_mlvalue_.GetMutable<Tensor>()->MutableData<bool>()) {
+    // check at the iteration boundary as well as inside the subgraph executor,
+    // so a run that is terminated or past its deadline stops issuing iterations.
+    if (context_.GetCancellation().IsCancelled()) {
+      return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, context_.GetCancellation().Reason());
+    }
+
     if (iter_num_value != 0) {
       UpdateFeeds(fetches, feeds);
       fetches.clear();
     }
 
-    SequentialExecutor executor{context_.GetTerminateFlag()};
-    status = executor.Execute(session_state_, feeds, subgraph_output_names_, fetches, context_.Logger());
+    // run the subgraph. the first iteration builds the execution frame, later
+    // iterations reuse it with the new feeds/fetches swapped in by index.
+    status = subgraph_context_.Execute(feeds, subgraph_output_names_, fetches, context_.Logger());
     ONNXRUNTIME_RETURN_IF_ERROR(status);
 
     condition_mlvalue_ = fetches[0];
@@ -10,13 +10,15 @@
 #endif
 #include "core/providers/cpu/controlflow/scan.h"
 
+#include <mutex>
+
 #include "core/framework/framework_common.h"
 #include "core/framework/mlvalue_tensor_slicer.h"
 #include "core/framework/op_kernel_context_internal.h"
-#include "core/framework/sequential_executor.h"
 #include "core/framework/session_state.h"
 #include "core/framework/tensorprotoutils.h"
 
+#include "core/providers/cpu/controlflow/subgraph_execution_context.h"
 #include "core/providers/cpu/tensor/utils.h"
 
 #ifdef _MSC_VER
@@ -155,6 +157,10 @@ class OutputIterator {
     memset(tensor->MutableDataRaw(), 0, tensor->Size());
   }
 
+  // false while the final shape has a symbolic dimension that needs the first
+  // subgraph execution to be resolved
+  bool IsConcreteShape() const { return is_concrete_shape_; }
+
  private:
   OutputIterator(OpKernelContextInternal& context,
                  int output_index,
@@ -214,10 +220,24 @@ class ScanImpl {
   using ConstTensorSlicerIterators = std::vector<MLValueTensorSlicer<const MLValue>::Iterator>;
   using MutableTensorSlicerIterators = std::vector<MLValueTensorSlicer<MLValue>::Iterator>;
 
+  // create the per-lane sliced input iterators for batch entry 'b'
+  void CreateScanInputStreamIterators(int64_t b, ConstTensorSlicerIterators& iterators);
+
+  // iterate one batch entry through the shared OutputIterators. used when an
+  // output has a symbolic dimension that the first execution must resolve,
+  // which forces the lanes to run in batch order.
   Status IterateSequence(std::vector<LoopStateVariable>& loop_state_variables,
                          ConstTensorSlicerIterators& scan_input_stream_iterators,
                          int64_t seq_length);
 
+  // iterate one batch entry writing through its own output slicers, so lanes
+  // can run concurrently. requires all output shapes to be concrete.
+  Status IterateSequenceForLane(std::vector<LoopStateVariable>& loop_state_variables,
+                                ConstTensorSlicerIterators& scan_input_stream_iterators,
+                                MutableTensorSlicerIterators& scan_output_stream_iterators,
+                                int64_t seq_length,
+                                SubgraphExecutionContext& subgraph_context);
+
   OpKernelContextInternal& context_;
   const SessionState& session_state_;
   const GraphViewer& subgraph_;
@@ -237,6 +257,11 @@ class ScanImpl {
   std::vector<std::unique_ptr<OutputIterator>> output_iterators_;
 
   std::unordered_map<std::string, const MLValue*> implicit_inputs_;
+
+  // executes the subgraph, reusing one execution frame across all the
+  // iterations of every sequence in the batch. used by the sequential path;
+  // concurrent lanes each create their own context.
+  SubgraphExecutionContext subgraph_context_;
 };
 
 Status Scan::Compute(OpKernelContext* ctx) const {
@@ -244,10 +269,6 @@ Status Scan::Compute(OpKernelContext* ctx) const {
   auto* session_state = ctx_internal->SubgraphSessionState("body");
   ONNXRUNTIME_ENFORCE(session_state, "Subgraph SessionState was not found for 'body' attribute.");
 
-  // TODO:
-  //       Consider how usage of ExecutionFrame and SequentialExecutor can be optimized
-  //         - initial implementation is focused on making it work, rather than optimizing.
-
   ScanImpl scan_impl{*ctx_internal, *session_state, num_scan_inputs_, directions_};
 
   auto status = scan_impl.Initialize();
@@ -470,7 +491,8 @@ ScanImpl::ScanImpl(OpKernelContextInternal& context,
       session_state_{session_state},
       subgraph_{*session_state.GetGraphViewer()},
       directions_{directions},
-      implicit_inputs_{context_.GetImplicitInputs()} {
+      implicit_inputs_{context_.GetImplicitInputs()},
+      subgraph_context_{session_state, context.GetCancellation()} {
   // optional first input so may be nullptr
   sequence_lens_tensor_ = context.Input<Tensor>(0);
 
@@ -703,6 +725,28 @@ Status ScanImpl::CreateLoopStateVariables(std::vector<std::vector<LoopStateVaria
   return status;
 }
 
+void ScanImpl::CreateScanInputStreamIterators(int64_t b, ConstTensorSlicerIterators& iterators) {
+  iterators.reserve(num_variadic_inputs_ - num_loop_state_variables_);
+
+  for (int i = num_loop_state_variables_, end = num_variadic_inputs_; i < end; ++i) {
+    const auto& mlvalue = GetSubgraphInputMLValue(context_, i);
+
+    // forward
+    if (directions_[i - num_loop_state_variables_] == static_cast<int64_t>(Scan::Direction::kForward)) {
+      // the iterator is self contained, so we don't need to keep the MLValueTensorSlicer instance around
+      iterators.push_back(MLValueTensorSlicer<const MLValue>::Create(mlvalue, 1, b).begin());
+    } else {  // reverse
+      iterators.push_back(MLValueTensorSlicer<const MLValue>::Create(mlvalue, 1, b).rbegin());
+      // need to skip past the empty entries at the end of the input if sequence length is short
+      auto offset = max_sequence_len_ - sequence_lens_[b];
+      if (offset > 0) {
+        // reverse iterator so += moves backwards through the input
+        iterators.back() += offset;
+      }
+    }
+  }
+}
+
 Status ScanImpl::Execute() {
   Status status = Status::OK();
 
@@ -711,37 +755,82 @@ Status ScanImpl::Execute() {
   status = CreateLoopStateVariables(batch_loop_state_variables);
   ONNXRUNTIME_RETURN_IF_ERROR(status);
 
-  for (int64_t b = 0; b < batch_size_; ++b) {
-    // Setup input MLValue streams
-    std::vector<MLValueTensorSlicer<const MLValue>::Iterator> scan_input_stream_iterators;
-    scan_input_stream_iterators.reserve(num_variadic_inputs_ - num_loop_state_variables_);
-
-    for (int i = num_loop_state_variables_, end = num_variadic_inputs_; i < end; ++i) {
-      const auto& mlvalue = GetSubgraphInputMLValue(context_, i);
-
-      // forward
-      if (directions_[i - num_loop_state_variables_] == static_cast<int64_t>(Scan::Direction::kForward)) {
-        // the iterator is self contained, so we don't need to keep the MLValueTensorSlicer instance around
-        scan_input_stream_iterators.push_back(MLValueTensorSlicer<const MLValue>::Create(mlvalue, 1, b).begin());
-      } else {  // reverse
-        scan_input_stream_iterators.push_back(MLValueTensorSlicer<const MLValue>::Create(mlvalue, 1, b).rbegin());
-        // need to skip past the empty entries at the end of the input if sequence length is short
-        auto offset = max_sequence_len_ - sequence_lens_[b];
-        if (offset > 0) {
-          // reverse iterator so += moves backwards through the input
-          scan_input_stream_iterators.back() += offset;
-        }
+  // an output with a symbolic dimension needs its first execution to discover
+  // the real shape, which the shared OutputIterators handle. that forces the
+  // lanes to run one after the other in batch order.
+  const bool all_outputs_concrete =
+      std::all_of(output_iterators_.cbegin(), output_iterators_.cend(),
+                  [](const std::unique_ptr<OutputIterator>& iter) { return iter->IsConcreteShape(); });
+
+  if (!all_outputs_concrete) {
+    for (int64_t b = 0; b < batch_size_; ++b) {
+      ConstTensorSlicerIterators scan_input_stream_iterators;
+      CreateScanInputStreamIterators(b, scan_input_stream_iterators);
+
+      // Call the subgraph for each item in the sequence
+      status = IterateSequence(batch_loop_state_variables[b],
+                               scan_input_stream_iterators,
+                               sequence_lens_[b]);
+
+      ONNXRUNTIME_RETURN_IF_ERROR(status);
+    }
+
+    return status;
+  }
+
+  // all output buffers exist up front, so each lane can write its own slices
+  // of them and the lanes are independent of each other.
+  auto run_lanes = [this, &batch_loop_state_variables](int64_t first, int64_t last,
+                                                       SubgraphExecutionContext& subgraph_context) -> Status {
+    for (int64_t b = first; b < last; ++b) {
+      ConstTensorSlicerIterators scan_input_stream_iterators;
+      CreateScanInputStreamIterators(b, scan_input_stream_iterators);
+
+      MutableTensorSlicerIterators scan_output_stream_iterators;
+      scan_output_stream_iterators.reserve(num_variadic_outputs_ - num_loop_state_variables_);
+
+      for (int i = num_loop_state_variables_, end = num_variadic_outputs_; i < end; ++i) {
+        MLValue* output = context_.GetOutputMLValue(i);
+        ONNXRUNTIME_ENFORCE(output, "Output MLValue has not been created for scan output ", i);
+        // the slicer handles the sequence dimension (dim 1) for this batch entry
+        scan_output_stream_iterators.push_back(MLValueTensorSlicer<MLValue>::Create(*output, 1, b).begin());
       }
+
+      ONNXRUNTIME_RETURN_IF_ERROR(IterateSequenceForLane(batch_loop_state_variables[b],
+                                                         scan_input_stream_iterators,
+                                                         scan_output_stream_iterators,
+                                                         sequence_lens_[b],
+                                                         subgraph_context));
     }
 
-    // Call the subgraph for each item in the sequence
-    status = IterateSequence(batch_loop_state_variables[b],
-                             scan_input_stream_iterators,
-                             sequence_lens_[b]);
+    return Status::OK();
+  };
 
-    ONNXRUNTIME_RETURN_IF_ERROR(status);
+  if (batch_size_ <= 1) {
+    return run_lanes(0, batch_size_, subgraph_context_);
   }
 
+  // a lane runs a whole subgraph sequence, so any nontrivial batch is worth
+  // sharding. parallelism inside the lanes collapses to the lane's thread:
+  // nested pool batches run inline and MLAS partitions for one thread inside
+  // a batch iteration, so a subgraph GEMM can never re-enter the pool and
+  // wait on lanes it is itself occupying. the first failure wins, matching
+  // the previous in-order check.
+  std::mutex status_mutex;
+  Status batch_status = Status::OK();
+  context_.ParallelFor(0, batch_size_, 1.0e6,
+                       [&](int64_t first, int64_t last) {
+                         // each shard runs its lanes through its own execution frame
+                         SubgraphExecutionContext subgraph_context{session_state_, context_.GetCancellation()};
+                         Status lane_status = run_lanes(first, last, subgraph_context);
+                         if (!lane_status.IsOK()) {
+                           std::lock_guard<std::mutex> lock(status_mutex);
+                           if (batch_status.IsOK())
+                             batch_status = lane_status;
+                         }
+                       });
+  ONNXRUNTIME_RETURN_IF_ERROR(batch_status);
+
   return status;
 }
 
@@ -765,6 +854,12 @@ Status ScanImpl::IterateSequence(std::vector<LoopStateVariable>& loop_state_vari
 
   int64_t seq_no = 0;
   for (; seq_no < seq_length; ++seq_no) {
+    // check at the iteration boundary as well as inside the subgraph executor,
+    // so a run that is terminated or past its deadline stops issuing iterations.
+    if (context_.GetCancellation().IsCancelled()) {
+      return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, context_.GetCancellation().Reason());
+    }
+
     for (int input = 0; input < num_variadic_inputs_; ++input) {
       // the ordering of the Scan inputs should match the ordering of the subgraph inputs
       auto name = graph_inputs[input]->Name();
@@ -804,14 +899,9 @@ Status ScanImpl::IterateSequence(std::vector<LoopStateVariable>& loop_state_vari
       }
     }
 
-    // Create Executor and run graph.
-    // TODO: Consider pulling ExecutionFrame up from within SequentialExecutor
-    // and separating it out a bit so we can maybe just update the feeds/fetches in the frame on each iteration.
-    // Many of the other pieces are constant across usages.
-    // Not sure how best to handle the memory pattern side of things though.
-    // For now just making it work. Optimization and refinement will follow.
-    SequentialExecutor executor{context_.GetTerminateFlag()};
-    status = executor.Execute(session_state_, feeds, subgraph_output_names_, fetches, context_.Logger());
+    // run the subgraph. the first iteration builds the execution frame, later
+    // iterations reuse it with the new feeds/fetches swapped in by index.
+    status = subgraph_context_.Execute(feeds, subgraph_output_names_, fetches, context_.Logger());
     ONNXRUNTIME_RETURN_IF_ERROR(status);
 
     // cycle the LoopStateVariable input/output in preparation for the next iteration
@@ -843,4 +933,86 @@ Status ScanImpl::IterateSequence(std::vector<LoopStateVariable>& loop_state_vari
   return status;
 }
 
+Status ScanImpl::IterateSequenceForLane(std::vector<LoopStateVariable>& loop_state_variables,
+                                        ConstTensorSlicerIterators& scan_input_stream_iterators,
+                                        MutableTensorSlicerIterators& scan_output_stream_iterators,
+                                        int64_t seq_length,
+                                        SubgraphExecutionContext& subgraph_context) {
+  Status status = Status::OK();
+  auto& graph_inputs = subgraph_.GetInputs();
+  NameMLValMap feeds;
+  std::vector<MLValue> fetches;
+
+  feeds.reserve(num_variadic_inputs_ + implicit_inputs_.size());
+  fetches.reserve(num_variadic_outputs_);
+
+  // pass in implicit inputs as feeds.
+  for (auto& entry : implicit_inputs_) {
+    ONNXRUNTIME_ENFORCE(entry.second, "All implicit inputs should have MLValue instances by now. ",
+                        entry.first, " did not.");
+    feeds[entry.first] = *entry.second;
+  }
+
+  int64_t seq_no = 0;
+  for (; seq_no < seq_length; ++seq_no) {
+    // check at the iteration boundary as well as inside the subgraph executor,
+    // so a run that is terminated or past its deadline stops issuing iterations.
+    if (context_.GetCancellation().IsCancelled()) {
+      return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, context_.GetCancellation().Reason());
+    }
+
+    for (int input = 0; input < num_variadic_inputs_; ++input) {
+      // the ordering of the Scan inputs should match the ordering of the subgraph inputs
+      auto name = graph_inputs[input]->Name();
+
+      if (input < num_loop_state_variables_) {
+        // add loop state variable input
+        feeds[name] = loop_state_variables[input].Input();
+      } else {
+        // add sliced input
+        auto& iterator = scan_input_stream_iterators[input - num_loop_state_variables_];
+        feeds[name] = *iterator;
+
+        ++iterator;
+      }
+    }
+
+    fetches.clear();
+
+    for (int output = 0, end = num_variadic_outputs_; output < end; ++output) {
+      if (output < num_loop_state_variables_) {
+        // add loop state variable output
+        fetches.push_back(loop_state_variables[output].Output());
+      } else {
+        // add this lane's slice of the overall output buffer
+        fetches.push_back(*scan_output_stream_iterators[output - num_loop_state_variables_]);
+      }
+    }
+
+    // run the subgraph. the first iteration builds the execution frame, later
+    // iterations reuse it with the new feeds/fetches swapped in by index.
+    status = subgraph_context.Execute(feeds, subgraph_output_names_, fetches, context_.Logger());
+    ONNXRUNTIME_RETURN_IF_ERROR(status);
+
+    // cycle the LoopStateVariable input/output in preparation for the next iteration
+    std::for_each(loop_state_variables.begin(), loop_state_variables.end(), [](LoopStateVariable& v) { v.Next(); });
+
+    // and move the output iterators.
+    for (auto& iterator : scan_output_stream_iterators) {
+      ++iterator;
+    }
+  }
+
+  // zero out this lane's remaining values in the sequence
+  for (; seq_no < max_sequence_len_; ++seq_no) {
+    for (auto& iterator : scan_output_stream_iterators) {
+      auto* tensor = (*iterator).GetMutable<Tensor>();
+      memset(tensor->MutableDataRaw(), 0, tensor->Size());
+      ++iterator;
+    }
+  }
+
+  return status;
+}
+
 }  // namespace onnxruntime
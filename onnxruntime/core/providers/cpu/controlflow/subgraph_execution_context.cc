@@ -0,0 +1,24 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cpu/controlflow/subgraph_execution_context.h"
+
+#include "core/framework/execution_frame.h"
+#include "core/framework/session_state.h"
+
+namespace onnxruntime {
+SubgraphExecutionContext::~SubgraphExecutionContext() = default;
+
+common::Status SubgraphExecutionContext::Execute(const NameMLValMap& feeds,
+                                                 const std::vector<std::string>& output_names,
+                                                 std::vector<MLValue>& fetches,
+                                                 const logging::Logger& logger) {
+  if (!frame_) {
+    frame_ = std::make_unique<ExecutionFrame>(feeds, output_names, fetches, session_state_);
+  } else {
+    ONNXRUNTIME_RETURN_IF_ERROR(frame_->Reuse(feeds, output_names, fetches));
+  }
+
+  return executor_.Execute(session_state_, *frame_, feeds, output_names, fetches, logger);
+}
+}  // namespace onnxruntime
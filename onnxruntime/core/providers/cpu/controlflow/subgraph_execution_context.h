@@ -0,0 +1,54 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/logging/logging.h"
+#include "core/common/status.h"
+#include "core/framework/framework_common.h"
+#include "core/framework/ml_value.h"
+#include "core/framework/sequential_executor.h"
+
+namespace onnxruntime {
+class ExecutionFrame;
+class SessionState;
+
+/**
+Drives repeated executions of a control flow node's subgraph over one
+persistent ExecutionFrame. Scan and Loop call the subgraph once per
+sequence item/iteration with the same feed and output names every time,
+so the frame built for the first iteration can be reused: the feed/fetch
+mlvalue indices, the per-node value tables and the planned memory chunk
+all carry over, and a steady-state iteration only swaps the loop-carried
+values in by index. See ExecutionFrame::Reuse for the details.
+
+Not thread safe; a context belongs to a single Compute call.
+*/
+class SubgraphExecutionContext {
+ public:
+  SubgraphExecutionContext(const SessionState& session_state, const RunCancellation& cancellation)
+      : session_state_(session_state), executor_(cancellation) {}
+
+  ~SubgraphExecutionContext();
+
+  // Runs one iteration of the subgraph. The first call builds the execution
+  // frame as usual; later calls must use the same feed and output names.
+  common::Status Execute(const NameMLValMap& feeds,
+                         const std::vector<std::string>& output_names,
+                         std::vector<MLValue>& fetches,
+                         const logging::Logger& logger);
+
+ private:
+  ONNXRUNTIME_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SubgraphExecutionContext);
+
+  const SessionState& session_state_;
+  SequentialExecutor executor_;
+
+  // frame kept warm across iterations
+  std::unique_ptr<ExecutionFrame> frame_;
+};
+}  // namespace onnxruntime
@@ -2,7 +2,10 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/cpu_execution_provider.h"
+#include <mutex>
+#include "core/common/work_stealing_thread_pool.h"
 #include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/framework/kernel_registry.h"
 #include "contrib_ops/contrib_kernels.h"
 #include "core/framework/compute_capability.h"
@@ -87,9 +90,11 @@ class ONNX_OPERATOR_KERNEL_CLASS_NAME(kCpuExecutionProvider, kOnnxDomain, 7, Asi
 class ONNX_OPERATOR_KERNEL_CLASS_NAME(kCpuExecutionProvider, kOnnxDomain, 7, Acos);
 class ONNX_OPERATOR_KERNEL_CLASS_NAME(kCpuExecutionProvider, kOnnxDomain, 7, Atan);
 class ONNX_OPERATOR_VERSIONED_KERNEL_CLASS_NAME(kCpuExecutionProvider, kOnnxDomain, 7, 9, Gemm);
+class ONNX_OPERATOR_VERSIONED_TYPED_KERNEL_CLASS_NAME(kCpuExecutionProvider, kOnnxDomain, 7, 9, MLFloat16, Gemm);
 class ONNX_OPERATOR_KERNEL_CLASS_NAME(kCpuExecutionProvider, kOnnxDomain, 1, Hardmax);
 class ONNX_OPERATOR_KERNEL_CLASS_NAME(kCpuExecutionProvider, kOnnxDomain, 1, LogSoftmax);
 class ONNX_OPERATOR_VERSIONED_KERNEL_CLASS_NAME(kCpuExecutionProvider, kOnnxDomain, 1, 9, MatMul);
+class ONNX_OPERATOR_VERSIONED_TYPED_KERNEL_CLASS_NAME(kCpuExecutionProvider, kOnnxDomain, 1, 9, MLFloat16, MatMul);
 class ONNX_OPERATOR_KERNEL_CLASS_NAME(kCpuExecutionProvider, kOnnxDomain, 1, Softmax);
 class ONNX_OPERATOR_KERNEL_CLASS_NAME(kCpuExecutionProvider, kOnnxDomain, 1, TopK);
 class ONNX_OPERATOR_KERNEL_CLASS_NAME(kCpuExecutionProvider, kOnnxDomain, 7, BatchNormalization);
@@ -275,9 +280,11 @@ void RegisterOnnxOperatorKernels(std::function<void(KernelCreateInfo&&)> fn) {
   fn(BuildKernel<ONNX_OPERATOR_KERNEL_CLASS_NAME(kCpuExecutionProvider, kOnnxDomain, 7, Acos)>());
   fn(BuildKernel<ONNX_OPERATOR_KERNEL_CLASS_NAME(kCpuExecutionProvider, kOnnxDomain, 7, Atan)>());
   fn(BuildKernel<ONNX_OPERATOR_VERSIONED_KERNEL_CLASS_NAME(kCpuExecutionProvider, kOnnxDomain, 7, 9, Gemm)>());
+  fn(BuildKernel<ONNX_OPERATOR_VERSIONED_TYPED_KERNEL_CLASS_NAME(kCpuExecutionProvider, kOnnxDomain, 7, 9, MLFloat16, Gemm)>());
   fn(BuildKernel<ONNX_OPERATOR_KERNEL_CLASS_NAME(kCpuExecutionProvider, kOnnxDomain, 1, Hardmax)>());
   fn(BuildKernel<ONNX_OPERATOR_KERNEL_CLASS_NAME(kCpuExecutionProvider, kOnnxDomain, 1, LogSoftmax)>());
   fn(BuildKernel<ONNX_OPERATOR_VERSIONED_KERNEL_CLASS_NAME(kCpuExecutionProvider, kOnnxDomain, 1, 9, MatMul)>());
+  fn(BuildKernel<ONNX_OPERATOR_VERSIONED_TYPED_KERNEL_CLASS_NAME(kCpuExecutionProvider, kOnnxDomain, 1, 9, MLFloat16, MatMul)>());
   fn(BuildKernel<ONNX_OPERATOR_KERNEL_CLASS_NAME(kCpuExecutionProvider, kOnnxDomain, 1, Softmax)>());
   fn(BuildKernel<ONNX_OPERATOR_KERNEL_CLASS_NAME(kCpuExecutionProvider, kOnnxDomain, 1, TopK)>());
   fn(BuildKernel<ONNX_OPERATOR_KERNEL_CLASS_NAME(kCpuExecutionProvider, kOnnxDomain, 7, BatchNormalization)>());
@@ -478,12 +485,33 @@ void RegisterOnnxMLOperatorKernels(std::function<void(KernelCreateInfo&&)> fn) {
 }  // namespace ml
 
 static void RegisterCPUKernels(std::function<void(KernelCreateInfo&&)> create_fn) {
-  RegisterOnnxOperatorKernels(create_fn);
-  ::onnxruntime::ml::RegisterOnnxMLOperatorKernels(create_fn);
-  ::onnxruntime::contrib::RegisterContribKernels(create_fn);
+  // Each group spends most of its time in KernelDefBuilder::Build for its
+  // kernels, so run the groups concurrently and serialize only the inserts
+  // into the registry's map.
+  std::mutex create_mutex;
+  std::function<void(KernelCreateInfo&&)> locked_create_fn =
+      [&create_mutex, &create_fn](KernelCreateInfo&& info) {
+        std::lock_guard<std::mutex> lock(create_mutex);
+        create_fn(std::move(info));
+      };
+
+  using RegisterGroupFn = void (*)(std::function<void(KernelCreateInfo&&)>);
+  static constexpr RegisterGroupFn kRegisterGroups[] = {
+      RegisterOnnxOperatorKernels,
+      ::onnxruntime::ml::RegisterOnnxMLOperatorKernels,
+      ::onnxruntime::contrib::RegisterContribKernels,
+  };
+
+  WorkStealingThreadPool::DefaultPool().ExecuteInParallel(
+      [&locked_create_fn](std::size_t index) {
+        kRegisterGroups[index](locked_create_fn);
+      },
+      sizeof(kRegisterGroups) / sizeof(kRegisterGroups[0]));
 }
 
 std::shared_ptr<KernelRegistry> CPUExecutionProvider::GetKernelRegistry() const {
+  // Process-wide immutable singleton: the registry is built once on first use
+  // and shared by every session. Thread-safe via static initialization.
   static std::shared_ptr<KernelRegistry>
     kernel_registry = std::make_shared<KernelRegistry>(RegisterCPUKernels);
   return kernel_registry;
@@ -504,4 +532,28 @@ CPUExecutionProvider::GetCapability(const onnxruntime::GraphViewer& graph,
 void CPUExecutionProvider::InsertFusedRules(FuseRuleFn rule) {
   fuse_rules_.push_back(rule);
 }
+
+static void MlasExecuteOnDefaultPool(MLAS_THREADED_ROUTINE* threaded_routine, void* context,
+                                     int32_t iterations) {
+  WorkStealingThreadPool::DefaultPool().ExecuteInParallel(
+      [threaded_routine, context](std::size_t index) {
+        threaded_routine(context, static_cast<int32_t>(index));
+      },
+      static_cast<std::size_t>(iterations));
+}
+
+static bool MlasDefaultPoolInParallelRegion() {
+  return CurrentThreadInParallelRegion();
+}
+
+void CPUExecutionProvider::SetupMlasThreading() {
+  static std::once_flag setup_flag;
+  std::call_once(setup_flag, []() {
+    auto& pool = WorkStealingThreadPool::DefaultPool();
+    MlasSetParallelExecutor(MlasExecuteOnDefaultPool, static_cast<int32_t>(pool.NumThreads()));
+    // keeps MLAS single threaded when its caller already runs inside a pool
+    // batch, the same fallback the OpenMP build gets from omp_get_num_threads
+    MlasSetParallelRegionQuery(MlasDefaultPoolInParallelRegion);
+  });
+}
 }  // namespace onnxruntime
@@ -14,6 +14,15 @@ namespace onnxruntime {
 struct CPUExecutionProviderInfo {
   bool create_arena{true};
 
+  // Draw from the environment-wide CPU arena shared with other sessions that
+  // opt in, instead of growing a private arena. Per-session usage stays
+  // visible through the SessionArenaAccountant the session receives.
+  bool use_shared_arena{false};
+
+  // Cap on the shared arena's total size. Only honored by the session that
+  // creates the arena; later sessions inherit the existing cap.
+  size_t shared_arena_max_mem{std::numeric_limits<size_t>::max()};
+
   explicit CPUExecutionProviderInfo(bool use_arena)
       : create_arena(use_arena) {}
   CPUExecutionProviderInfo() = default;
@@ -25,6 +34,8 @@ using FuseRuleFn = std::function<void(const onnxruntime::GraphViewer&, std::vect
 class CPUExecutionProvider : public IExecutionProvider {
  public:
   explicit CPUExecutionProvider(const CPUExecutionProviderInfo& info) {
+    SetupMlasThreading();
+
     DeviceAllocatorRegistrationInfo device_info({ONNXRuntimeMemTypeDefault, [](int) {
           return std::make_unique<CPUAllocator>(); }, std::numeric_limits<size_t>::max()});
 #ifdef USE_JEMALLOC
@@ -34,7 +45,12 @@ class CPUExecutionProvider : public IExecutionProvider {
         std::shared_ptr<IArenaAllocator>(
             std::make_unique<DummyArena>(device_info.factory(0))));
 #else
-    if (info.create_arena)
+    if (info.use_shared_arena) {
+      DeviceAllocatorRegistrationInfo shared_info = device_info;
+      shared_info.max_mem = info.shared_arena_max_mem;
+      InsertAllocator(std::make_shared<SessionArenaAccountant>(
+          SharedArenaRegistry::Instance().GetOrCreateArena(CPU, shared_info)));
+    } else if (info.create_arena)
       InsertAllocator(CreateAllocator(device_info));
     else
       InsertAllocator(
@@ -75,6 +91,12 @@ class CPUExecutionProvider : public IExecutionProvider {
 
   void InsertFusedRules(FuseRuleFn rule);
 
+ private:
+  // Points MLAS at the process-wide work-stealing pool so its threaded
+  // kernels share worker threads with the rest of the runtime. Only the
+  // first call has any effect.
+  static void SetupMlasThreading();
+
  protected:
   std::vector<FuseRuleFn> fuse_rules_;
 };
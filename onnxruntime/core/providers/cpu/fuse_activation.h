@@ -0,0 +1,55 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/util/math_cpuonly.h"
+
+namespace onnxruntime {
+
+// Applies an activation in place to the output of a fused kernel while the
+// output tile is still in cache. Shared by the fused Conv and Gemm kernels.
+// The float overload below routes to the vectorized MLAS activation kernels.
+template <typename T>
+void fuse_activation(const std::string& activation, T* y_data, size_t size, float alpha) {
+  EigenVectorArrayMap<T> y_vec(y_data, size);
+  if (activation.empty()) {
+    return;
+  } else if (activation == "Relu") {
+    y_vec = y_vec.cwiseMax(0);
+  } else if (activation == "Sigmoid") {
+    y_vec = (y_vec >= 0).select(1 / (1. + (-y_vec.abs()).exp()), 1 - 1 / (1. + (-y_vec.abs()).exp()));
+  } else if (activation == "Tanh") {
+    y_vec = y_vec.tanh();
+  } else if (activation == "LeakyRelu") {
+    y_vec = (y_vec >= 0).select(y_vec, (T)alpha * y_vec);
+  } else {
+    ONNXRUNTIME_NOT_IMPLEMENTED("Not implemented fused activation: ", activation);
+  }
+}
+
+inline void fuse_activation(const std::string& activation, float* y_data, size_t size, float alpha) {
+  if (activation.empty()) {
+    return;
+  }
+
+  MLAS_ACTIVATION mlas_activation;
+  if (activation == "Relu") {
+    mlas_activation.ActivationKind = MlasReluActivation;
+  } else if (activation == "Sigmoid") {
+    mlas_activation.ActivationKind = MlasLogisticActivation;
+  } else if (activation == "Tanh") {
+    mlas_activation.ActivationKind = MlasTanhActivation;
+  } else if (activation == "LeakyRelu") {
+    mlas_activation.ActivationKind = MlasLeakyReluActivation;
+    mlas_activation.Parameters.LeakyRelu.alpha = alpha;
+  } else {
+    ONNXRUNTIME_NOT_IMPLEMENTED("Not implemented fused activation: ", activation);
+  }
+
+  MlasComputeActivation(&mlas_activation, y_data, y_data, size);
+}
+
+}  // namespace onnxruntime
@@ -27,7 +27,9 @@ limitations under the License.
 
 #include <algorithm>
 #include <chrono>
-#include <random>
+#include <cmath>
+#include <cstdint>
+#include "core/common/work_stealing_thread_pool.h"
 #include "core/util/math_cpuonly.h"
 #include "core/util/eigen_common_wrapper.h"
 #include "gsl/span"
@@ -38,43 +40,36 @@ namespace onnxruntime {
 ONNX_CPU_OPERATOR_KERNEL(
     RandomNormal,
     1,
-    KernelDefBuilder().TypeConstraint("T", std::vector<MLDataType>{
-                                               DataTypeImpl::GetTensorType<float>(),
-                                               DataTypeImpl::GetTensorType<double>()}),
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::TensorTypesFor<float, double>()),
     RandomNormal);
 
 ONNX_CPU_OPERATOR_KERNEL(
     RandomUniform,
     1,
-    KernelDefBuilder().TypeConstraint("T", std::vector<MLDataType>{
-                                               DataTypeImpl::GetTensorType<float>(),
-                                               DataTypeImpl::GetTensorType<double>()}),
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::TensorTypesFor<float, double>()),
     RandomUniform);
 
 ONNX_CPU_OPERATOR_KERNEL(
     RandomNormalLike,
     1,
-    KernelDefBuilder().TypeConstraint("T1", DataTypeImpl::AllTensorTypes()).TypeConstraint("T2", std::vector<MLDataType>{DataTypeImpl::GetTensorType<float>(), DataTypeImpl::GetTensorType<double>()}),
+    KernelDefBuilder().TypeConstraint("T1", DataTypeImpl::AllTensorTypes()).TypeConstraint("T2", DataTypeImpl::TensorTypesFor<float, double>()),
     RandomNormalLike);
 
 ONNX_CPU_OPERATOR_KERNEL(
     RandomUniformLike,
     1,
-    KernelDefBuilder().TypeConstraint("T1", DataTypeImpl::AllTensorTypes()).TypeConstraint("T2", std::vector<MLDataType>{DataTypeImpl::GetTensorType<float>(), DataTypeImpl::GetTensorType<double>()}),
+    KernelDefBuilder().TypeConstraint("T1", DataTypeImpl::AllTensorTypes()).TypeConstraint("T2", DataTypeImpl::TensorTypesFor<float, double>()),
     RandomUniformLike);
 
 // https://github.com/onnx/onnx/blob/master/docs/Operators.md#multinomial
 ONNX_CPU_OPERATOR_KERNEL(
     Multinomial,
     7,
-    KernelDefBuilder().TypeConstraint("T1", DataTypeImpl::GetTensorType<float>()).TypeConstraint("T2", std::vector<MLDataType>{DataTypeImpl::GetTensorType<int32_t>(), DataTypeImpl::GetTensorType<int64_t>()}),
+    KernelDefBuilder().TypeConstraint("T1", DataTypeImpl::GetTensorType<float>()).TypeConstraint("T2", DataTypeImpl::TensorTypesFor<int32_t, int64_t>()),
     Multinomial);
 
-template <typename T, typename TDistribution>
-void GenerateData(std::default_random_engine generator, TDistribution distribution, Tensor& tensor);
-
-static Status RandomNormalCompute(float mean, float scale, std::default_random_engine generator, TensorProto::DataType dtype, Tensor& Y);
-static Status RandomUniformCompute(float high, float low, std::default_random_engine generator, TensorProto::DataType dtype, Tensor& Y);
+static Status RandomNormalCompute(float mean, float scale, PhiloxGenerator& generator, TensorProto::DataType dtype, Tensor& Y);
+static Status RandomUniformCompute(float high, float low, PhiloxGenerator& generator, TensorProto::DataType dtype, Tensor& Y);
 
 // Leaving in case we need to change to this approach
 //static Status CreateOutputTensorFromTensorValues(OpKernelContext* ctx, const Tensor& X,Tensor** Y);
@@ -148,27 +143,136 @@ using ConstMatrix = Eigen::TensorMap<Eigen::Tensor<const T, 2, Eigen::RowMajor,
 template <typename T, typename IndexType = int64_t>
 using EigenVector = Eigen::TensorMap<Eigen::Tensor<T, 1, Eigen::RowMajor, IndexType>>;
 
+// Unit-interval conversions using the full explicit mantissa: 24 bits for
+// float, 53 bits for double. Both land in [0, 1).
+static inline float ToUnitFloat(uint32_t value) {
+  return static_cast<float>(value >> 8) * (1.0f / 16777216.0f);
+}
+
+static inline double ToUnitDouble(uint32_t hi, uint32_t lo) {
+  const uint64_t bits = ((static_cast<uint64_t>(hi) << 32) | lo) >> 11;
+  return static_cast<double>(bits) * (1.0 / 9007199254740992.0);
+}
+
+// Splits <blocks> counter values into contiguous shards and runs <fill> over
+// them on the default pool. Small outputs stay on the calling thread; the
+// generated sequence is the same either way because each block is a pure
+// function of its counter value.
+static void ParallelFill(uint64_t blocks, const std::function<void(uint64_t, uint64_t)>& fill) {
+  constexpr uint64_t kMinBlocksPerShard = 1024;
+  auto& pool = WorkStealingThreadPool::DefaultPool();
+  const uint64_t shards = std::min<uint64_t>(pool.NumThreads() + 1, blocks / kMinBlocksPerShard);
+  if (shards <= 1) {
+    fill(0, blocks);
+    return;
+  }
+
+  const uint64_t per_shard = blocks / shards;
+  const uint64_t remainder = blocks % shards;
+  pool.ExecuteInParallel(
+      [&](std::size_t shard) {
+        const uint64_t begin = shard * per_shard + std::min<uint64_t>(shard, remainder);
+        const uint64_t end = begin + per_shard + (shard < remainder ? 1 : 0);
+        fill(begin, end);
+      },
+      static_cast<std::size_t>(shards));
+}
+
+// Each counter block carries four float lanes.
+static void UniformFillFloat(const PhiloxGenerator& generator, uint64_t base, float low, float range,
+                             float* out, int64_t size, uint64_t block_begin, uint64_t block_end) {
+  for (uint64_t b = block_begin; b < block_end; ++b) {
+    const auto block = generator.Evaluate(base + b);
+    const int64_t idx = static_cast<int64_t>(b) * 4;
+    const int64_t lanes = std::min<int64_t>(4, size - idx);
+    for (int64_t lane = 0; lane < lanes; ++lane) {
+      out[idx + lane] = low + range * ToUnitFloat(block.v[lane]);
+    }
+  }
+}
+
+// Each counter block carries two double lanes.
+static void UniformFillDouble(const PhiloxGenerator& generator, uint64_t base, double low, double range,
+                              double* out, int64_t size, uint64_t block_begin, uint64_t block_end) {
+  for (uint64_t b = block_begin; b < block_end; ++b) {
+    const auto block = generator.Evaluate(base + b);
+    const int64_t idx = static_cast<int64_t>(b) * 2;
+    out[idx] = low + range * ToUnitDouble(block.v[0], block.v[1]);
+    if (idx + 1 < size) {
+      out[idx + 1] = low + range * ToUnitDouble(block.v[2], block.v[3]);
+    }
+  }
+}
+
+// Box-Muller on uniform pairs; u1 is mapped to (0, 1] so the log stays
+// finite. Four float lanes make two normal pairs per block.
+static void NormalFillFloat(const PhiloxGenerator& generator, uint64_t base, float mean, float scale,
+                            float* out, int64_t size, uint64_t block_begin, uint64_t block_end) {
+  constexpr float kTwoPi = 6.2831853071795864769f;
+  for (uint64_t b = block_begin; b < block_end; ++b) {
+    const auto block = generator.Evaluate(base + b);
+    const int64_t idx = static_cast<int64_t>(b) * 4;
+
+    float z[4];
+    for (int pair = 0; pair < 2; ++pair) {
+      const float u1 = 1.0f - ToUnitFloat(block.v[2 * pair]);
+      const float u2 = ToUnitFloat(block.v[2 * pair + 1]);
+      const float radius = std::sqrt(-2.0f * std::log(u1));
+      const float angle = kTwoPi * u2;
+      z[2 * pair] = radius * std::cos(angle);
+      z[2 * pair + 1] = radius * std::sin(angle);
+    }
+
+    const int64_t lanes = std::min<int64_t>(4, size - idx);
+    for (int64_t lane = 0; lane < lanes; ++lane) {
+      out[idx + lane] = mean + scale * z[lane];
+    }
+  }
+}
+
+// Two double lanes make one normal pair per block.
+static void NormalFillDouble(const PhiloxGenerator& generator, uint64_t base, double mean, double scale,
+                             double* out, int64_t size, uint64_t block_begin, uint64_t block_end) {
+  constexpr double kTwoPi = 6.2831853071795864769;
+  for (uint64_t b = block_begin; b < block_end; ++b) {
+    const auto block = generator.Evaluate(base + b);
+    const int64_t idx = static_cast<int64_t>(b) * 2;
+
+    const double u1 = 1.0 - ToUnitDouble(block.v[0], block.v[1]);
+    const double u2 = ToUnitDouble(block.v[2], block.v[3]);
+    const double radius = std::sqrt(-2.0 * std::log(u1));
+    const double angle = kTwoPi * u2;
+
+    out[idx] = mean + scale * radius * std::cos(angle);
+    if (idx + 1 < size) {
+      out[idx + 1] = mean + scale * radius * std::sin(angle);
+    }
+  }
+}
+
 template <typename OutputType>
 static Status MultinomialCompute(OpKernelContext* ctx,
                                  const Tensor& X,
                                  const int64_t batch_size,
                                  const int64_t num_classes,
                                  const int64_t num_samples,
-                                 std::default_random_engine generator,
+                                 PhiloxGenerator& generator,
                                  Tensor& Y) {
-  // implementation copied from Tensorflow with some changes such as using the std::uniform_real_distribution
-  // instead of the Philox RNG.
+  // implementation copied from Tensorflow with some changes such as using the counter-based
+  // Philox generator directly instead of std::uniform_real_distribution.
   Eigen::array<int64_t, 2> X_dims = {{batch_size, num_classes}};
   ConstMatrix<float> logits = ConstMatrix<float>(X.template Data<float>(), X_dims);
 
   Eigen::array<int64_t, 2> Y_dims = {{batch_size, num_samples}};
   Matrix<OutputType> output = Matrix<OutputType>(Y.template MutableData<OutputType>(), Y_dims);
 
-  // TODO (perf optimization) - the idea behind making this a lambda is so that we can parallelize across batches.
-  // When we do that this lamdba will act as one task given to a thread
-  auto DoWork = [ctx, num_samples, num_classes, &generator, &logits, &output](int64_t start_row,
-                                                                              int64_t limit_row) {
-    std::default_random_engine generator_copy = generator;
+  // every row draws its doubles from its own disjoint counter range, so rows
+  // produce the same samples no matter how they are sharded across threads.
+  const uint64_t blocks_per_row = (static_cast<uint64_t>(num_samples) + 1) / 2;
+  const uint64_t base = generator.Reserve(static_cast<uint64_t>(batch_size) * blocks_per_row);
+
+  auto DoWork = [ctx, num_samples, num_classes, base, blocks_per_row, &generator, &logits, &output](
+                    int64_t start_row, int64_t limit_row) {
     // BEGIN create temporary tensor
     AllocatorPtr alloc;
     ctx->GetTempSpaceAllocator(&alloc);
@@ -178,7 +282,6 @@ static Status MultinomialCompute(OpKernelContext* ctx,
     auto cdf = EigenVector<double>(cdf_data, cdf_dims);
     // END create temporary tensor
 
-    std::uniform_real_distribution<double> dist(0.0, 1.0);  // TODO: should this be initialized per batch?
     for (int64_t b = start_row; b < limit_row; ++b) {
       const float* logits_row = &(logits(b, 0));
       // Takes an along-class maximum (for numerical stability).
@@ -203,14 +306,37 @@ static Status MultinomialCompute(OpKernelContext* ctx,
       // Generate each sample.
       const double* cdf_begin = cdf.data();
       const double* cdf_end = cdf.data() + num_classes;
+      const uint64_t row_base = base + static_cast<uint64_t>(b) * blocks_per_row;
+      PhiloxGenerator::Block block{};
       for (int64_t j = 0; j < num_samples; ++j) {
-        const double to_find = dist(generator_copy) * running_total;
+        if ((j & 1) == 0) {
+          block = generator.Evaluate(row_base + static_cast<uint64_t>(j) / 2);
+        }
+        const double uniform = (j & 1) == 0 ? ToUnitDouble(block.v[0], block.v[1])
+                                            : ToUnitDouble(block.v[2], block.v[3]);
+        const double to_find = uniform * running_total;
         auto found_iter = std::upper_bound(cdf_begin, cdf_end, to_find);
         output(b, j) = static_cast<OutputType>(std::distance(cdf_begin, found_iter));
       }
     }
   };
-  DoWork(0, batch_size);
+
+  auto& pool = WorkStealingThreadPool::DefaultPool();
+  const int64_t shards = std::min<int64_t>(static_cast<int64_t>(pool.NumThreads()) + 1, batch_size);
+  if (shards <= 1) {
+    DoWork(0, batch_size);
+  } else {
+    const int64_t rows_per_shard = batch_size / shards;
+    const int64_t remainder = batch_size % shards;
+    pool.ExecuteInParallel(
+        [&](std::size_t shard) {
+          const int64_t signed_shard = static_cast<int64_t>(shard);
+          const int64_t start_row = signed_shard * rows_per_shard + std::min(signed_shard, remainder);
+          const int64_t limit_row = start_row + rows_per_shard + (signed_shard < remainder ? 1 : 0);
+          DoWork(start_row, limit_row);
+        },
+        static_cast<std::size_t>(shards));
+  }
   return Status::OK();
 }
 
@@ -308,20 +434,29 @@ static TensorProto::DataType InferDataType(const Tensor& tensor) {
 }
 
 static Status RandomNormalCompute(float mean, float scale,
-                                  std::default_random_engine generator,
+                                  PhiloxGenerator& generator,
                                   TensorProto::DataType dtype, Tensor& Y) {
+  const int64_t size = Y.Shape().Size();
   switch (dtype) {
     case TensorProto::FLOAT: {
-      GenerateData<float, std::normal_distribution<float>>(
-          generator, std::normal_distribution<float>{mean, scale}, Y);
+      const uint64_t blocks = (static_cast<uint64_t>(size) + 3) / 4;
+      const uint64_t base = generator.Reserve(blocks);
+      float* out = Y.MutableData<float>();
+      ParallelFill(blocks, [&generator, base, mean, scale, out, size](uint64_t block_begin, uint64_t block_end) {
+        NormalFillFloat(generator, base, mean, scale, out, size, block_begin, block_end);
+      });
       break;
     }
     case TensorProto::FLOAT16: {
       ONNXRUNTIME_NOT_IMPLEMENTED("FLOAT16 is not supported");
     }
     case TensorProto::DOUBLE: {
-      GenerateData<double, std::normal_distribution<double>>(
-          generator, std::normal_distribution<double>{mean, scale}, Y);
+      const uint64_t blocks = (static_cast<uint64_t>(size) + 1) / 2;
+      const uint64_t base = generator.Reserve(blocks);
+      double* out = Y.MutableData<double>();
+      ParallelFill(blocks, [&generator, base, mean, scale, out, size](uint64_t block_begin, uint64_t block_end) {
+        NormalFillDouble(generator, base, mean, scale, out, size, block_begin, block_end);
+      });
       break;
     }
     default:
@@ -332,21 +467,32 @@ static Status RandomNormalCompute(float mean, float scale,
 }
 
 static Status RandomUniformCompute(float low, float high,
-                                   std::default_random_engine generator,
+                                   PhiloxGenerator& generator,
                                    TensorProto::DataType dtype,
                                    Tensor& Y) {
+  const int64_t size = Y.Shape().Size();
   switch (dtype) {
     case TensorProto::FLOAT: {
-      GenerateData<float, std::uniform_real_distribution<float>>(
-          generator, std::uniform_real_distribution<float>{low, high}, Y);
+      const uint64_t blocks = (static_cast<uint64_t>(size) + 3) / 4;
+      const uint64_t base = generator.Reserve(blocks);
+      float* out = Y.MutableData<float>();
+      const float range = high - low;
+      ParallelFill(blocks, [&generator, base, low, range, out, size](uint64_t block_begin, uint64_t block_end) {
+        UniformFillFloat(generator, base, low, range, out, size, block_begin, block_end);
+      });
       break;
     }
     case TensorProto::FLOAT16: {
       ONNXRUNTIME_NOT_IMPLEMENTED("FLOAT16 is not supported");
     }
     case TensorProto::DOUBLE: {
-      GenerateData<double, std::uniform_real_distribution<double>>(
-          generator, std::uniform_real_distribution<double>{low, high}, Y);
+      const uint64_t blocks = (static_cast<uint64_t>(size) + 1) / 2;
+      const uint64_t base = generator.Reserve(blocks);
+      double* out = Y.MutableData<double>();
+      const double range = static_cast<double>(high) - low;
+      ParallelFill(blocks, [&generator, base, low, range, out, size](uint64_t block_begin, uint64_t block_end) {
+        UniformFillDouble(generator, base, low, range, out, size, block_begin, block_end);
+      });
       break;
     }
     default:
@@ -356,11 +502,4 @@ static Status RandomUniformCompute(float low, float high,
   return Status::OK();
 }
 
-template <typename T, typename TDistribution>
-void GenerateData(std::default_random_engine generator, TDistribution distribution, Tensor& tensor) {
-  auto out = gsl::make_span(tensor.template MutableData<T>(), tensor.Shape().Size());
-
-  std::for_each(out.begin(), out.end(), [&generator, &distribution](T& value) { value = distribution(generator); });
-}
-
 }  // namespace onnxruntime
@@ -3,7 +3,9 @@
 
 #pragma once
 
-#include <random>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include "gsl/gsl_util"
 
 #include "core/common/common.h"
@@ -11,6 +13,68 @@
 
 namespace onnxruntime {
 
+// Counter-based Philox 4x32-10 generator (Salmon et al., "Parallel Random
+// Numbers: As Easy As 1, 2, 3"). The block at any counter value is a pure
+// function of (key, counter), so a Run reserves a disjoint counter range up
+// front and worker threads evaluate their slices independently: no lock, no
+// shared mutable state, and the produced sequence does not depend on how the
+// work was sharded across threads.
+class PhiloxGenerator {
+ public:
+  PhiloxGenerator() = default;
+
+  // Resets the stream. Called once by the kernel constructors after the seed
+  // attribute is resolved.
+  void Seed(uint64_t seed) {
+    key_ = seed;
+    counter_.store(0, std::memory_order_relaxed);
+  }
+
+  // Four 32-bit lanes produced per counter value.
+  struct Block {
+    uint32_t v[4];
+  };
+
+  // Reserves <count> consecutive counter values and returns the first one,
+  // advancing the stream past them for the next caller.
+  uint64_t Reserve(uint64_t count) {
+    return counter_.fetch_add(count, std::memory_order_relaxed);
+  }
+
+  Block Evaluate(uint64_t counter) const {
+    uint32_t c0 = static_cast<uint32_t>(counter);
+    uint32_t c1 = static_cast<uint32_t>(counter >> 32);
+    uint32_t c2 = 0;
+    uint32_t c3 = 0;
+    uint32_t k0 = static_cast<uint32_t>(key_);
+    uint32_t k1 = static_cast<uint32_t>(key_ >> 32);
+
+    for (int round = 0; round < 10; ++round) {
+      const uint64_t product0 = static_cast<uint64_t>(0xD2511F53u) * c0;
+      const uint64_t product1 = static_cast<uint64_t>(0xCD9E8D57u) * c2;
+      const uint32_t prev_c1 = c1;
+      const uint32_t prev_c3 = c3;
+      c0 = static_cast<uint32_t>(product1 >> 32) ^ prev_c1 ^ k0;
+      c1 = static_cast<uint32_t>(product1);
+      c2 = static_cast<uint32_t>(product0 >> 32) ^ prev_c3 ^ k1;
+      c3 = static_cast<uint32_t>(product0);
+      k0 += 0x9E3779B9u;  // Weyl sequence constants from the paper
+      k1 += 0xBB67AE85u;
+    }
+
+    Block block;
+    block.v[0] = c0;
+    block.v[1] = c1;
+    block.v[2] = c2;
+    block.v[3] = c3;
+    return block;
+  }
+
+ private:
+  uint64_t key_{0};
+  std::atomic<uint64_t> counter_{0};
+};
+
 class RandomNormal final : public OpKernel {
  public:
   RandomNormal(const OpKernelInfo& info) : OpKernel(info) {
@@ -23,7 +87,7 @@ class RandomNormal final : public OpKernel {
       seed = gsl::narrow_cast<float>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
     }
 
-    generator_ = std::default_random_engine{gsl::narrow_cast<uint32_t>(seed)};
+    generator_.Seed(gsl::narrow_cast<uint32_t>(seed));
 
     int64_t dtype;
     ONNXRUNTIME_ENFORCE(info.GetAttr<int64_t>("dtype", &dtype).IsOK());
@@ -41,7 +105,7 @@ class RandomNormal final : public OpKernel {
  private:
   float mean_;
   float scale_;
-  std::default_random_engine generator_;
+  mutable PhiloxGenerator generator_;
   ONNX_NAMESPACE::TensorProto::DataType dtype_;
   TensorShape shape_;
 };
@@ -58,7 +122,7 @@ class RandomNormalLike final : public OpKernel {
       seed = gsl::narrow_cast<float>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
     }
 
-    generator_ = std::default_random_engine{gsl::narrow_cast<uint32_t>(seed)};
+    generator_.Seed(gsl::narrow_cast<uint32_t>(seed));
 
     int64_t dtype;
     if (info.GetAttr<int64_t>("dtype", &dtype).IsOK()) {
@@ -73,7 +137,7 @@ class RandomNormalLike final : public OpKernel {
  private:
   float mean_;
   float scale_;
-  std::default_random_engine generator_;
+  mutable PhiloxGenerator generator_;
   ONNX_NAMESPACE::TensorProto::DataType dtype_ = ONNX_NAMESPACE::TensorProto::DataType::TensorProto_DataType_UNDEFINED;  //optional and may be inferred
 };
 
@@ -89,7 +153,7 @@ class RandomUniform final : public OpKernel {
       seed = gsl::narrow_cast<float>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
     }
 
-    generator_ = std::default_random_engine{gsl::narrow_cast<uint32_t>(seed)};
+    generator_.Seed(gsl::narrow_cast<uint32_t>(seed));
 
     int64_t dtype;
     ONNXRUNTIME_ENFORCE(info.GetAttr<int64_t>("dtype", &dtype).IsOK());
@@ -107,7 +171,7 @@ class RandomUniform final : public OpKernel {
  private:
   float high_;
   float low_;
-  std::default_random_engine generator_;
+  mutable PhiloxGenerator generator_;
   ONNX_NAMESPACE::TensorProto::DataType dtype_;
   TensorShape shape_;
 };
@@ -123,7 +187,7 @@ class RandomUniformLike final : public OpKernel {
       seed = gsl::narrow_cast<float>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
     }
 
-    generator_ = std::default_random_engine{gsl::narrow_cast<uint32_t>(seed)};
+    generator_.Seed(gsl::narrow_cast<uint32_t>(seed));
 
     int64_t dtype;
     if (info.GetAttr<int64_t>("dtype", &dtype).IsOK()) {
@@ -138,7 +202,7 @@ class RandomUniformLike final : public OpKernel {
  private:
   float high_;
   float low_;
-  std::default_random_engine generator_;
+  mutable PhiloxGenerator generator_;
   ONNX_NAMESPACE::TensorProto::DataType dtype_ = ONNX_NAMESPACE::TensorProto::DataType::TensorProto_DataType_UNDEFINED;  //optional and may be inferred
 };
 
@@ -152,7 +216,7 @@ class Multinomial final : public OpKernel {
       seed = gsl::narrow_cast<float>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
     }
 
-    generator_ = std::default_random_engine{gsl::narrow_cast<uint32_t>(seed)};
+    generator_.Seed(gsl::narrow_cast<uint32_t>(seed));
 
     int64_t output_dtype_tmp;
     if (!info.GetAttr<int64_t>("dtype", &output_dtype_tmp).IsOK()) {
@@ -168,7 +232,7 @@ class Multinomial final : public OpKernel {
 
  private:
   int64_t num_samples_;
-  std::default_random_engine generator_;
+  mutable PhiloxGenerator generator_;
   ONNX_NAMESPACE::TensorProto::DataType output_dtype_;
 };
 }  // namespace onnxruntime
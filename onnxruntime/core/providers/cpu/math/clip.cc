@@ -3,6 +3,12 @@
 
 #include "core/providers/cpu/math/clip.h"
 
+#include <algorithm>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#include <xmmintrin.h>
+#endif
+
 namespace onnxruntime {
 
 ONNX_CPU_OPERATOR_KERNEL(
@@ -11,4 +17,52 @@ ONNX_CPU_OPERATOR_KERNEL(
     KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Clip<float>);
 
+namespace {
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+// single pass over the block: each lane is clamped to [min, max] with one
+// packed max and one packed min while the data is in registers.
+void ClampRange(const float* input, float* output, int64_t count, float min_value, float max_value) {
+  const __m128 range_min = _mm_set1_ps(min_value);
+  const __m128 range_max = _mm_set1_ps(max_value);
+
+  int64_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    _mm_storeu_ps(output + i, _mm_min_ps(_mm_max_ps(_mm_loadu_ps(input + i), range_min), range_max));
+  }
+
+  for (; i < count; i++) {
+    output[i] = std::min(std::max(input[i], min_value), max_value);
+  }
+}
+
+#else
+
+void ClampRange(const float* input, float* output, int64_t count, float min_value, float max_value) {
+  EigenVectorMap<float>(output, count) =
+      ConstEigenVectorMap<float>(input, count).cwiseMax(min_value).cwiseMin(max_value);
+}
+
+#endif
+
+}  // namespace
+
+template <>
+Status Clip<float>::Compute(OpKernelContext* ctx) const {
+  const Tensor* X = ctx->Input<Tensor>(0);
+  Tensor* Y = ctx->Output(0, X->Shape());
+  const float* input = X->Data<float>();
+  float* output = Y->MutableData<float>();
+  const int64_t size = X->Shape().Size();
+  const float min_value = min_;
+  const float max_value = max_;
+
+  ctx->ParallelFor(0, size, 1.0, [=](int64_t first, int64_t last) {
+    ClampRange(input + first, output + first, last - first, min_value, max_value);
+  });
+
+  return Status::OK();
+}
+
 }  // namespace onnxruntime
@@ -32,4 +32,9 @@ class Clip final : public OpKernel {
   T min_;
 };
 
+// float runs a single-pass SIMD range clamp (one packed max plus one packed
+// min per block) in place of the generic Eigen expression.
+template <>
+Status Clip<float>::Compute(OpKernelContext* ctx) const;
+
 }  // namespace onnxruntime
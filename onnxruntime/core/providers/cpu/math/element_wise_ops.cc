@@ -2,8 +2,13 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/math/element_wise_ops.h"
+#include <algorithm>
 #include <unsupported/Eigen/SpecialFunctions>
 
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#include <xmmintrin.h>
+#endif
+
 namespace onnxruntime {
 
 ONNX_CPU_OPERATOR_TYPED_KERNEL(
@@ -102,7 +107,7 @@ ONNX_CPU_OPERATOR_TYPED_KERNEL(
       Abs,                                                                         \
       6,                                                                           \
       TYPE,                                                                        \
-      KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>()), \
+      KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>()), \
       Abs<TYPE>);
 
 REG_ABS_KERNEL(float)
@@ -120,45 +125,45 @@ ONNX_CPU_OPERATOR_TYPED_KERNEL(
     Neg,
     6,
     float,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Neg<float>);
 
 ONNX_CPU_OPERATOR_TYPED_KERNEL(
     Neg,
     6,
     int8_t,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<int8_t>()),
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<int8_t>()),
     Neg<int8_t>);
 
 ONNX_CPU_OPERATOR_TYPED_KERNEL(
     Neg,
     6,
     int32_t,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<int32_t>()),
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<int32_t>()),
     Neg<int32_t>);
 
 ONNX_CPU_OPERATOR_KERNEL(
     Floor,
     6,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Floor<float>);
 
 ONNX_CPU_OPERATOR_KERNEL(
     Ceil,
     6,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Ceil<float>);
 
 ONNX_CPU_OPERATOR_KERNEL(
     Reciprocal,
     6,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Reciprocal<float>);
 
 ONNX_CPU_OPERATOR_KERNEL(
     Sqrt,
     6,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Sqrt<float>);
 
 ONNX_CPU_OPERATOR_KERNEL(
@@ -170,13 +175,13 @@ ONNX_CPU_OPERATOR_KERNEL(
 ONNX_CPU_OPERATOR_KERNEL(
     Exp,
     6,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Exp<float>);
 
 ONNX_CPU_OPERATOR_KERNEL(
     Log,
     6,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Log<float>);
 
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
@@ -218,7 +223,7 @@ ONNX_CPU_OPERATOR_KERNEL(
 ONNX_CPU_OPERATOR_KERNEL(
     Not,
     1,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<bool>()),
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<bool>()),
     Not);
 
 ONNX_CPU_OPERATOR_KERNEL(
@@ -303,21 +308,218 @@ ONNX_CPU_OPERATOR_KERNEL(
 ONNX_CPU_OPERATOR_KERNEL(
     Affine,
     1,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Affine<float>);
 
 ONNX_CPU_OPERATOR_KERNEL(
     Scale,
     1,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Scale<float>);
 
 ONNX_CPU_OPERATOR_KERNEL(
     Erf,
     9,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Erf<float>);
 
+namespace {
+
+// Same-shape float adds and muls above this size are pure bandwidth: the
+// result cannot stay resident in any last level cache, so writing it through
+// the cache only evicts the weights the following nodes need. Past the
+// threshold the stores go around the cache instead.
+constexpr int64_t kStreamingStoreThresholdBytes = 64 * 1024 * 1024;
+
+enum class StreamingBinaryOp {
+  kAdd,
+  kMul,
+};
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+void StreamingBinaryRange(const float* input0, const float* input1, float* output,
+                          int64_t count, StreamingBinaryOp op) {
+  int64_t i = 0;
+
+  // scalar head until the output pointer is 16 byte aligned; movntps faults
+  // on unaligned addresses.
+  while (i < count && (reinterpret_cast<uintptr_t>(output + i) & 0xF) != 0) {
+    output[i] = op == StreamingBinaryOp::kAdd ? input0[i] + input1[i] : input0[i] * input1[i];
+    i++;
+  }
+
+  if (op == StreamingBinaryOp::kAdd) {
+    for (; i + 4 <= count; i += 4) {
+      _mm_stream_ps(output + i, _mm_add_ps(_mm_loadu_ps(input0 + i), _mm_loadu_ps(input1 + i)));
+    }
+  } else {
+    for (; i + 4 <= count; i += 4) {
+      _mm_stream_ps(output + i, _mm_mul_ps(_mm_loadu_ps(input0 + i), _mm_loadu_ps(input1 + i)));
+    }
+  }
+
+  for (; i < count; i++) {
+    output[i] = op == StreamingBinaryOp::kAdd ? input0[i] + input1[i] : input0[i] * input1[i];
+  }
+
+  // drain the write combining buffers so the stores are visible once the
+  // parallel loop joins.
+  _mm_sfence();
+}
+
+#else
+
+void StreamingBinaryRange(const float* input0, const float* input1, float* output,
+                          int64_t count, StreamingBinaryOp op) {
+  ConstEigenVectorMap<float> in0(input0, count);
+  ConstEigenVectorMap<float> in1(input1, count);
+  EigenVectorMap<float> out(output, count);
+  if (op == StreamingBinaryOp::kAdd) {
+    out = in0 + in1;
+  } else {
+    out = in0.cwiseProduct(in1);
+  }
+}
+
+#endif
+
+// Dense same-shape binary op written with non-temporal stores, parallelized
+// like the classified broadcast paths.
+Status StreamingSameShapeBinary(OpKernelContext& context, StreamingBinaryOp op) {
+  const Tensor& input_tensor0 = *context.Input<Tensor>(0);
+  const float* input0 = input_tensor0.Data<float>();
+  const float* input1 = context.Input<Tensor>(1)->Data<float>();
+  Tensor& output_tensor = *context.Output(0, input_tensor0.Shape());
+  float* output = output_tensor.MutableData<float>();
+  const int64_t size = output_tensor.Shape().Size();
+
+  context.ParallelFor(0, size, 1.0, [=](int64_t first, int64_t last) {
+    StreamingBinaryRange(input0 + first, input1 + first, output + first, last - first, op);
+  });
+
+  return Status::OK();
+}
+
+// True when the output of a same-shape float add/mul is big enough that
+// streaming it past the cache wins.
+bool ShouldStreamBinaryOutput(const OpKernelContext& context) {
+  const Tensor* input0 = context.Input<Tensor>(0);
+  const Tensor* input1 = context.Input<Tensor>(1);
+  return input0->Shape() == input1->Shape() &&
+         input0->Shape().Size() * static_cast<int64_t>(sizeof(float)) >= kStreamingStoreThresholdBytes;
+}
+
+// Gather the data pointers of a float variadic node's inputs. Returns false
+// when the shapes differ, in which case the caller falls back to its
+// broadcast handling.
+bool GatherSameShapeVariadicInputs(OpKernelContext& context, int input_count,
+                                   std::vector<const float*>& inputs) {
+  const Tensor& input_tensor0 = *context.Input<Tensor>(0);
+  const auto& shape = input_tensor0.Shape();
+  inputs.reserve(input_count);
+  inputs.push_back(input_tensor0.Data<float>());
+  for (int index = 1; index < input_count; index++) {
+    const Tensor& input_tensor = *context.Input<Tensor>(index);
+    if (input_tensor.Shape() != shape)
+      return false;
+    inputs.push_back(input_tensor.Data<float>());
+  }
+  return true;
+}
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+// One sweep per output block: the running extreme stays in a register while
+// every input contributes its lanes, instead of n-1 full passes re-reading
+// and re-writing the output.
+void VariadicExtremumRange(const std::vector<const float*>& inputs, float* output,
+                           int64_t first, int64_t last, bool is_min) {
+  const size_t num_inputs = inputs.size();
+
+  int64_t i = first;
+  for (; i + 4 <= last; i += 4) {
+    __m128 extreme = _mm_loadu_ps(inputs[0] + i);
+    if (is_min) {
+      for (size_t n = 1; n < num_inputs; n++) {
+        extreme = _mm_min_ps(extreme, _mm_loadu_ps(inputs[n] + i));
+      }
+    } else {
+      for (size_t n = 1; n < num_inputs; n++) {
+        extreme = _mm_max_ps(extreme, _mm_loadu_ps(inputs[n] + i));
+      }
+    }
+    _mm_storeu_ps(output + i, extreme);
+  }
+
+  for (; i < last; i++) {
+    float extreme = inputs[0][i];
+    for (size_t n = 1; n < num_inputs; n++) {
+      extreme = is_min ? std::min(extreme, inputs[n][i]) : std::max(extreme, inputs[n][i]);
+    }
+    output[i] = extreme;
+  }
+}
+
+#else
+
+void VariadicExtremumRange(const std::vector<const float*>& inputs, float* output,
+                           int64_t first, int64_t last, bool is_min) {
+  const size_t num_inputs = inputs.size();
+  for (int64_t i = first; i < last; i++) {
+    float extreme = inputs[0][i];
+    for (size_t n = 1; n < num_inputs; n++) {
+      extreme = is_min ? std::min(extreme, inputs[n][i]) : std::max(extreme, inputs[n][i]);
+    }
+    output[i] = extreme;
+  }
+}
+
+#endif
+
+// Same-shape variadic float Min/Max over one sweep per output block.
+Status SameShapeVariadicExtremum(OpKernelContext& context, const std::vector<const float*>& inputs,
+                                 bool is_min) {
+  Tensor& output_tensor = *context.Output(0, context.Input<Tensor>(0)->Shape());
+  float* output = output_tensor.MutableData<float>();
+  const int64_t size = output_tensor.Shape().Size();
+
+  context.ParallelFor(0, size, static_cast<double>(inputs.size()),
+                      [&inputs, output, is_min](int64_t first, int64_t last) {
+                        VariadicExtremumRange(inputs, output, first, last, is_min);
+                      });
+
+  return Status::OK();
+}
+
+}  // namespace
+
+template <>
+Status Add<float>::Compute(OpKernelContext* context) const {
+  if (ShouldStreamBinaryOutput(*context)) {
+    return StreamingSameShapeBinary(*context, StreamingBinaryOp::kAdd);
+  }
+
+  return BroadcastTwo<float, float>(
+      *context,
+      [](EigenVectorMap<float> output, float input0, ConstEigenVectorMap<float> input1) { output = input0 + input1.array(); },
+      [](EigenVectorMap<float> output, ConstEigenVectorMap<float> input0, float input1) { output = input0.array() + input1; },
+      [](EigenVectorMap<float> output, ConstEigenVectorMap<float> input0, ConstEigenVectorMap<float> input1) { output = input0 + input1; });
+}
+
+template <>
+Status Mul<float>::Compute(OpKernelContext* context) const {
+  if (ShouldStreamBinaryOutput(*context)) {
+    return StreamingSameShapeBinary(*context, StreamingBinaryOp::kMul);
+  }
+
+  return BroadcastTwo<float, float>(
+      *context,
+      [](EigenVectorMap<float> output, float input0, ConstEigenVectorMap<float> input1) { output = input0 * input1.array(); },
+      [](EigenVectorMap<float> output, ConstEigenVectorMap<float> input0, float input1) { output = input0.array() * input1; },
+      [](EigenVectorMap<float> output, ConstEigenVectorMap<float> input0, ConstEigenVectorMap<float> input1) { output = input0.cwiseProduct(input1); });
+}
+
 template <typename T>
 Status Add<T>::Compute(OpKernelContext* context) const {
   return BroadcastTwo<T, T>(
@@ -384,18 +586,74 @@ Status Reciprocal<float>::Compute(OpKernelContext* ctx) const {
   return Status::OK();
 }
 
+namespace {
+
+// rough per-element costs on the nanosecond scale ParallelFor expects; the
+// transcendentals bottom out in libm-grade polynomial evaluation while the
+// cheap unaries are a handful of vector instructions.
+constexpr double kTranscendentalCostPerElement = 10.0;
+constexpr double kCheapUnaryCostPerElement = 2.0;
+
+// Applies op to contiguous chunks of a flat float array through the shared
+// worker pool; arrays too small to cover the dispatch cost run inline.
+template <typename Op>
+void ParallelUnaryMap(OpKernelContext& context, const float* input, float* output,
+                      int64_t size, double cost_per_element, const Op& op) {
+  context.ParallelFor(0, size, cost_per_element, [=](int64_t first, int64_t last) {
+    op(EigenVectorArrayMap<float>(output + first, last - first),
+       ConstEigenVectorArrayMap<float>(input + first, last - first));
+  });
+}
+
+}  // namespace
+
 template <>
 Status Sqrt<float>::Compute(OpKernelContext* ctx) const {
   auto& X = *ctx->Input<Tensor>(0);
   auto& Y = *ctx->Output(0, X.Shape());
 
-  EigenMap<float>(Y) = EigenMap<float>(X).cwiseSqrt();
+  ParallelUnaryMap(*ctx, X.Data<float>(), Y.MutableData<float>(), X.Shape().Size(),
+                   kCheapUnaryCostPerElement,
+                   [](EigenVectorArrayMap<float> y, ConstEigenVectorArrayMap<float> x) { y = x.sqrt(); });
 
   return Status::OK();
 }
 
 template <>
 Status Pow<float>::Compute(OpKernelContext* context) const {
+  // exponent captured from a constant initializer at construction: skip the
+  // broadcast machinery entirely and map the specialized kernel over the
+  // flat input. These exponents cover the x^2 and 1/sqrt(x) of normalization
+  // layers, where the generic pow call dominated the node's cost.
+  if (has_constant_exponent_) {
+    const Tensor& X = *context->Input<Tensor>(0);
+    const float* input = X.Data<float>();
+    float* output = context->Output(0, X.Shape())->MutableData<float>();
+    int64_t size = X.Shape().Size();
+    float exponent = constant_exponent_;
+
+    if (exponent == 2.0f) {
+      ParallelUnaryMap(*context, input, output, size, kCheapUnaryCostPerElement,
+                       [](EigenVectorArrayMap<float> y, ConstEigenVectorArrayMap<float> x) { y = x.square(); });
+    } else if (exponent == 3.0f) {
+      ParallelUnaryMap(*context, input, output, size, kCheapUnaryCostPerElement,
+                       [](EigenVectorArrayMap<float> y, ConstEigenVectorArrayMap<float> x) { y = x.cube(); });
+    } else if (exponent == 0.5f) {
+      ParallelUnaryMap(*context, input, output, size, kCheapUnaryCostPerElement,
+                       [](EigenVectorArrayMap<float> y, ConstEigenVectorArrayMap<float> x) { y = x.sqrt(); });
+    } else if (exponent == -0.5f) {
+      ParallelUnaryMap(*context, input, output, size, kCheapUnaryCostPerElement,
+                       [](EigenVectorArrayMap<float> y, ConstEigenVectorArrayMap<float> x) { y = x.rsqrt(); });
+    } else if (exponent == -1.0f) {
+      ParallelUnaryMap(*context, input, output, size, kCheapUnaryCostPerElement,
+                       [](EigenVectorArrayMap<float> y, ConstEigenVectorArrayMap<float> x) { y = x.inverse(); });
+    } else {
+      ParallelUnaryMap(*context, input, output, size, kTranscendentalCostPerElement,
+                       [exponent](EigenVectorArrayMap<float> y, ConstEigenVectorArrayMap<float> x) { y = x.pow(exponent); });
+    }
+    return Status::OK();
+  }
+
   const Tensor& Y = *context->Input<Tensor>(1);
   std::function<void(EigenVectorMap<float>, ConstEigenVectorMap<float>, float)> input1scalar =
       [](EigenVectorMap<float> output, ConstEigenVectorMap<float> input0, float input1) { output = Eigen::pow(input0.array(), input1); };
@@ -421,7 +679,9 @@ Status Exp<float>::Compute(OpKernelContext* ctx) const {
   auto& X = *ctx->Input<Tensor>(0);
   auto& Y = *ctx->Output(0, X.Shape());
 
-  EigenMap<float>(Y) = EigenMap<float>(X).array().exp();
+  ParallelUnaryMap(*ctx, X.Data<float>(), Y.MutableData<float>(), X.Shape().Size(),
+                   kTranscendentalCostPerElement,
+                   [](EigenVectorArrayMap<float> y, ConstEigenVectorArrayMap<float> x) { y = x.exp(); });
 
   return Status::OK();
 }
@@ -431,7 +691,9 @@ Status Log<float>::Compute(OpKernelContext* ctx) const {
   auto& X = *ctx->Input<Tensor>(0);
   auto& Y = *ctx->Output(0, X.Shape());
 
-  EigenMap<float>(Y) = EigenMap<float>(X).array().log();
+  ParallelUnaryMap(*ctx, X.Data<float>(), Y.MutableData<float>(), X.Shape().Size(),
+                   kTranscendentalCostPerElement,
+                   [](EigenVectorArrayMap<float> y, ConstEigenVectorArrayMap<float> x) { y = x.log(); });
 
   return Status::OK();
 }
@@ -474,22 +736,22 @@ template <>
 Status Min_6<float>::Compute(OpKernelContext* ctx) const {
   auto inputCount = Node().InputArgCount().front();
   ONNXRUNTIME_ENFORCE(inputCount >= 1, "Must have 1 or more inputs");
-  auto& data_0 = *ctx->Input<Tensor>(0);
-  auto& shape = data_0.Shape();
-  auto min = EigenMap<float>(*ctx->Output(0, shape));
 
-  min = EigenMap<float>(data_0);
-  for (int index = 1; index < inputCount; index++) {
-    auto& data_n = *ctx->Input<Tensor>(index);
-    ONNXRUNTIME_ENFORCE(data_n.Shape() == shape, "All inputs must have the same shape");
-    min = min.array().min(EigenMap<float>(data_n).array());
-  }
+  std::vector<const float*> inputs;
+  ONNXRUNTIME_ENFORCE(GatherSameShapeVariadicInputs(*ctx, inputCount, inputs),
+                      "All inputs must have the same shape");
 
-  return Status::OK();
+  return SameShapeVariadicExtremum(*ctx, inputs, true /* is_min */);
 }
 
 template <>
 Status Min_8<float>::Compute(OpKernelContext* context) const {
+  // same-shape inputs take the one-sweep path; mixed shapes fall back to the
+  // pairwise broadcast handling.
+  std::vector<const float*> inputs;
+  if (GatherSameShapeVariadicInputs(*context, Node().InputArgCount().front(), inputs))
+    return SameShapeVariadicExtremum(*context, inputs, true /* is_min */);
+
   return BroadcastVariadic<float, float>(
       Node(), *context,
       [](EigenVectorMap<float> output, float input0, ConstEigenVectorMap<float> input1) { output = input1.array().min(input0); },
@@ -501,22 +763,22 @@ template <>
 Status Max_6<float>::Compute(OpKernelContext* ctx) const {
   auto inputCount = Node().InputArgCount().front();
   ONNXRUNTIME_ENFORCE(inputCount >= 1, "Must have 1 or more inputs");
-  auto& data_0 = *ctx->Input<Tensor>(0);
-  auto& shape = data_0.Shape();
-  auto max = EigenMap<float>(*ctx->Output(0, shape));
 
-  max = EigenMap<float>(data_0);
-  for (int index = 1; index < inputCount; index++) {
-    auto& data_n = *ctx->Input<Tensor>(index);
-    ONNXRUNTIME_ENFORCE(data_n.Shape() == shape, "All inputs must have the same shape");
-    max = max.array().max(EigenMap<float>(data_n).array());
-  }
+  std::vector<const float*> inputs;
+  ONNXRUNTIME_ENFORCE(GatherSameShapeVariadicInputs(*ctx, inputCount, inputs),
+                      "All inputs must have the same shape");
 
-  return Status::OK();
+  return SameShapeVariadicExtremum(*ctx, inputs, false /* is_min */);
 }
 
 template <>
 Status Max_8<float>::Compute(OpKernelContext* context) const {
+  // same-shape inputs take the one-sweep path; mixed shapes fall back to the
+  // pairwise broadcast handling.
+  std::vector<const float*> inputs;
+  if (GatherSameShapeVariadicInputs(*context, Node().InputArgCount().front(), inputs))
+    return SameShapeVariadicExtremum(*context, inputs, false /* is_min */);
+
   return BroadcastVariadic<float, float>(
       Node(), *context,
       [](EigenVectorMap<float> output, float input0, ConstEigenVectorMap<float> input1) { output = input1.array().max(input0); },
@@ -686,7 +948,7 @@ class Sin final : public OpKernel {
 ONNX_CPU_OPERATOR_KERNEL(
     Sin,
     7,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Sin<float>);
 
 template <typename T>
@@ -706,7 +968,7 @@ class Cos final : public OpKernel {
 ONNX_CPU_OPERATOR_KERNEL(
     Cos,
     7,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Cos<float>);
 
 template <typename T>
@@ -726,7 +988,7 @@ class Tan final : public OpKernel {
 ONNX_CPU_OPERATOR_KERNEL(
     Tan,
     7,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Tan<float>);
 
 template <typename T>
@@ -746,7 +1008,7 @@ class Asin final : public OpKernel {
 ONNX_CPU_OPERATOR_KERNEL(
     Asin,
     7,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Asin<float>);
 
 template <typename T>
@@ -766,7 +1028,7 @@ class Acos final : public OpKernel {
 ONNX_CPU_OPERATOR_KERNEL(
     Acos,
     7,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Acos<float>);
 
 template <typename T>
@@ -786,7 +1048,7 @@ class Atan final : public OpKernel {
 ONNX_CPU_OPERATOR_KERNEL(
     Atan,
     7,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Atan<float>);
 
 template <>
@@ -115,9 +115,23 @@ template <typename T>
 class Pow final : public OpKernel {
  public:
   Pow(const OpKernelInfo& info) : OpKernel(info) {
+    // a scalar exponent that is a constant initializer (the common case for
+    // the x^2 / sqrt(x) in normalization layers) selects an
+    // exponent-specialized kernel once here instead of per run.
+    const Tensor* exponent;
+    if (info.TryGetConstantInput(1, &exponent) &&
+        exponent->Shape().Size() == 1 &&
+        exponent->DataType() == DataTypeImpl::GetType<T>()) {
+      constant_exponent_ = *exponent->template Data<T>();
+      has_constant_exponent_ = true;
+    }
   }
 
   Status Compute(OpKernelContext* context) const override;
+
+ private:
+  bool has_constant_exponent_{false};
+  T constant_exponent_{};
 };
 
 template <typename T>
@@ -585,9 +599,211 @@ void BroadcastLoop(TBroadcaster& bc, Output& output, Input0Scalar input0scalar,
   }
 }
 
+// Classification of a binary broadcast into one of the stride patterns that
+// cover the common cases (identical shapes, one scalar operand, and the
+// NxCxHxW against 1xCx1x1 bias-add/residual-add shape). These patterns can
+// run as a few large contiguous operations split across worker threads,
+// instead of one small Eigen expression per span through BroadcastLoop.
+struct BroadcastPattern {
+  enum Kind {
+    kNone,        // no fast path, use the span based BroadcastLoop
+    kSameShape,   // both inputs are dense with the same element count
+    kScalar0,     // input0 is a single element
+    kScalar1,     // input1 is a single element
+    kPerChannel0, // input0 reduces to [C] against a dense [outer, C, inner]
+    kPerChannel1, // input1 reduces to [C] against a dense [outer, C, inner]
+  };
+
+  Kind kind{kNone};
+  int64_t outer{1};
+  int64_t channel{1};
+  int64_t inner{1};
+  std::vector<int64_t> output_dims;
+
+  static BroadcastPattern Classify(const std::vector<int64_t>& shape0, const std::vector<int64_t>& shape1) {
+    BroadcastPattern pattern;
+
+    size_t rank = std::max(shape0.size(), shape1.size());
+
+    // Pad both shapes with leading ones to a common rank and validate the
+    // output dimensions while counting the broadcast axes of each input.
+    std::vector<int64_t> dims0(rank, 1);
+    std::vector<int64_t> dims1(rank, 1);
+    std::copy(shape0.begin(), shape0.end(), dims0.begin() + (rank - shape0.size()));
+    std::copy(shape1.begin(), shape1.end(), dims1.begin() + (rank - shape1.size()));
+
+    pattern.output_dims.resize(rank);
+
+    int64_t numel0 = 1;
+    int64_t numel1 = 1;
+
+    for (size_t dim = 0; dim < rank; dim++) {
+      if (dims0[dim] != dims1[dim] && dims0[dim] != 1 && dims1[dim] != 1)
+        return pattern;  // invalid broadcast, let the generic path report it
+
+      pattern.output_dims[dim] = std::max(dims0[dim], dims1[dim]);
+      numel0 *= dims0[dim];
+      numel1 *= dims1[dim];
+    }
+
+    if (dims0 == dims1) {
+      pattern.kind = kSameShape;
+      return pattern;
+    }
+
+    if (numel0 == 1) {
+      pattern.kind = kScalar0;
+      return pattern;
+    }
+
+    if (numel1 == 1) {
+      pattern.kind = kScalar1;
+      return pattern;
+    }
+
+    // Check for the per-channel pattern: one input has a single axis larger
+    // than one, and the other input is dense along the full output shape.
+    auto classify_per_channel = [&](const std::vector<int64_t>& small, const std::vector<int64_t>& dense, Kind kind) {
+      size_t channel_axis = rank;
+      for (size_t dim = 0; dim < rank; dim++) {
+        if (small[dim] != 1) {
+          if (channel_axis != rank)
+            return false;  // more than one broadcast axis
+          channel_axis = dim;
+        }
+      }
+      if (channel_axis == rank || dense != pattern.output_dims)
+        return false;
+
+      pattern.kind = kind;
+      pattern.channel = small[channel_axis];
+      for (size_t dim = 0; dim < channel_axis; dim++)
+        pattern.outer *= dense[dim];
+      for (size_t dim = channel_axis + 1; dim < rank; dim++)
+        pattern.inner *= dense[dim];
+      return true;
+    };
+
+    if (classify_per_channel(dims0, dims1, kPerChannel0))
+      return pattern;
+    classify_per_channel(dims1, dims0, kPerChannel1);
+    return pattern;
+  }
+};
+
+// Runs fn(first, last) over [0, count) through the shared worker pool,
+// sizing chunks by how many output elements each unit covers. Counts too
+// small to cover the dispatch cost run inline.
+template <typename Fn>
+void BroadcastParallelFor(OpKernelContext& context, int64_t count, int64_t elements_per_unit, Fn fn) {
+  context.ParallelFor(0, count, static_cast<double>(elements_per_unit), fn);
+}
+
+// Executes a classified broadcast as a handful of large contiguous
+// operations, parallelized over the outer dimensions of the pattern.
+template <typename TInput, typename TOutput, typename Input0Scalar, typename Input1Scalar, typename General>
+Status BroadcastTwoByPattern(OpKernelContext& context, const BroadcastPattern& pattern,
+                             Input0Scalar input0scalar, Input1Scalar input1scalar, General general) {
+  const TInput* input0 = context.Input<Tensor>(0)->template Data<TInput>();
+  const TInput* input1 = context.Input<Tensor>(1)->template Data<TInput>();
+  Tensor& output_tensor = *context.Output(0, TensorShape(pattern.output_dims));
+  TOutput* output = output_tensor.template MutableData<TOutput>();
+  const int64_t size = output_tensor.Shape().Size();
+
+  switch (pattern.kind) {
+    case BroadcastPattern::kSameShape:
+      BroadcastParallelFor(context, size, 1, [=](int64_t first, int64_t last) {
+        general(EigenVectorMap<TOutput>(output + first, last - first),
+                ConstEigenVectorMap<TInput>(input0 + first, last - first),
+                ConstEigenVectorMap<TInput>(input1 + first, last - first));
+      });
+      break;
+    case BroadcastPattern::kScalar0:
+      BroadcastParallelFor(context, size, 1, [=](int64_t first, int64_t last) {
+        input0scalar(EigenVectorMap<TOutput>(output + first, last - first),
+                     *input0,
+                     ConstEigenVectorMap<TInput>(input1 + first, last - first));
+      });
+      break;
+    case BroadcastPattern::kScalar1:
+      BroadcastParallelFor(context, size, 1, [=](int64_t first, int64_t last) {
+        input1scalar(EigenVectorMap<TOutput>(output + first, last - first),
+                     ConstEigenVectorMap<TInput>(input0 + first, last - first),
+                     *input1);
+      });
+      break;
+    case BroadcastPattern::kPerChannel0:
+    case BroadcastPattern::kPerChannel1: {
+      // Each (outer, channel) pair owns a contiguous run of inner elements of
+      // the dense input, matched against one element of the [C] input.
+      const bool input0_is_dense = pattern.kind == BroadcastPattern::kPerChannel1;
+      const TInput* dense = input0_is_dense ? input0 : input1;
+      const TInput* channels = input0_is_dense ? input1 : input0;
+      const int64_t channel = pattern.channel;
+      const int64_t inner = pattern.inner;
+
+      if (inner == 1) {
+        // [outer, C] against [C]: each outer row is a dense run of C elements
+        // matched against the whole channel vector.
+        BroadcastParallelFor(context, pattern.outer, channel, [=](int64_t first, int64_t last) {
+          for (int64_t row = first; row < last; row++) {
+            ConstEigenVectorMap<TInput> dense_row(dense + row * channel, channel);
+            ConstEigenVectorMap<TInput> channel_row(channels, channel);
+            general(EigenVectorMap<TOutput>(output + row * channel, channel),
+                    input0_is_dense ? dense_row : channel_row,
+                    input0_is_dense ? channel_row : dense_row);
+          }
+        });
+        break;
+      }
+
+      BroadcastParallelFor(context, pattern.outer * channel, inner, [=](int64_t first, int64_t last) {
+        for (int64_t row = first; row < last; row++) {
+          const TInput channel_value = channels[row % channel];
+          const TInput* dense_row = dense + row * inner;
+          TOutput* output_row = output + row * inner;
+
+          if (input0_is_dense) {
+            input1scalar(EigenVectorMap<TOutput>(output_row, inner),
+                         ConstEigenVectorMap<TInput>(dense_row, inner),
+                         channel_value);
+          } else {
+            input0scalar(EigenVectorMap<TOutput>(output_row, inner),
+                         channel_value,
+                         ConstEigenVectorMap<TInput>(dense_row, inner));
+          }
+        }
+      });
+      break;
+    }
+    default:
+      return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, "Unexpected broadcast pattern.");
+  }
+
+  return Status::OK();
+}
+
 template <typename TInput, typename TOutput, typename Input0Scalar, typename Input1Scalar, typename General>
 Status BroadcastTwo(OpKernelContext& context, Input0Scalar input0scalar, Input1Scalar input1scalar, General general) {
-  TBroadcaster<TInput> bc(*context.Input<Tensor>(0), *context.Input<Tensor>(1));
+  const Tensor& input0 = *context.Input<Tensor>(0);
+  const Tensor& input1 = *context.Input<Tensor>(1);
+
+  // reuse the classification from a previous run with the same shapes.
+  std::shared_ptr<void> cached_pattern = context.TryGetShapeState();
+
+  BroadcastPattern pattern;
+  if (cached_pattern) {
+    pattern = *static_cast<const BroadcastPattern*>(cached_pattern.get());
+  } else {
+    pattern = BroadcastPattern::Classify(input0.Shape().GetDims(), input1.Shape().GetDims());
+    if (context.IsRecordingShapeState())
+      context.SetShapeState(std::make_shared<BroadcastPattern>(pattern));
+  }
+
+  if (pattern.kind != BroadcastPattern::kNone)
+    return BroadcastTwoByPattern<TInput, TOutput>(context, pattern, input0scalar, input1scalar, general);
+
+  TBroadcaster<TInput> bc(input0, input1);
   TBroadcastOutput<TOutput> output(bc.GetSpanSize(), *context.Output(0, bc.GetOutputShape()));
   BroadcastLoop(bc, output, input0scalar, input1scalar, general);
 
@@ -3,12 +3,121 @@
 
 #include "core/providers/cpu/math/gemm.h"
 
+#include "core/mlas/inc/mlas.h"
+#include "Eigen/src/Core/arch/CUDA/Half.h"
+
 namespace onnxruntime {
 
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Gemm,
     7,
     9,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()).FullyOverwritesOutputs(),
     Gemm<float, float, float, float>);
+
+template <>
+Status Gemm<MLFloat16, MLFloat16, MLFloat16, MLFloat16>::Compute(OpKernelContext* context) const {
+  const auto X = context->Input<Tensor>(0);
+  const auto W = context->Input<Tensor>(1);
+  const auto B = context->Input<Tensor>(2);
+  GemmHelper helper(X->Shape(), trans_A_ != CblasNoTrans, W->Shape(), trans_B_ != CblasNoTrans, B->Shape());
+
+  if (!helper.State().IsOK())
+    return helper.State();
+
+  int64_t M = helper.M();
+  int64_t N = helper.N();
+  int64_t K = helper.K();
+  auto Y = context->Output(0, TensorShape({M, N}));
+
+  AllocatorPtr alloc;
+  ONNXRUNTIME_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+
+  // The weight matrix stays in half precision: MlasSgemm converts its panels
+  // to single precision while packing them, so only the input and the output
+  // are staged as single precision buffers. The block is borrowed from the
+  // per-run scratch arena when one is active.
+  const size_t x_size = static_cast<size_t>(X->Shape().Size());
+  const size_t y_size = static_cast<size_t>(M * N);
+  const size_t staging_bytes = sizeof(float) * (x_size + y_size);
+
+  BufferUniquePtr staging_fallback;
+  float* x_data = static_cast<float*>(context->GetScratchBuffer(staging_bytes));
+  if (x_data == nullptr) {
+    staging_fallback = BufferUniquePtr(alloc->Alloc(staging_bytes), BufferDeleter(alloc));
+    x_data = static_cast<float*>(staging_fallback.get());
+  }
+  float* y_data = x_data + x_size;
+
+  EigenVectorMap<float>(x_data, x_size) =
+      ConstEigenVectorMap<Eigen::half>(
+          reinterpret_cast<const Eigen::half*>(X->template Data<MLFloat16>()), x_size)
+          .cast<float>();
+
+  // bias, mirroring the generic path: the staged output is seeded with the
+  // unscaled bias and MlasSgemm applies beta to it below.
+  if (beta_ != 0) {
+    auto output_mat = EigenMatrixMapRowMajor<float>(y_data, M, N);
+    output_mat.setZero();
+
+    const auto* b_data = reinterpret_cast<const Eigen::half*>(B->template Data<MLFloat16>());
+    auto& b_shape = B->Shape();
+    // if B is (), (1,) or (1, 1), add the scalar
+    if (b_shape.Size() == 1) {
+      output_mat.array() += static_cast<float>(*b_data);
+    }
+    // B is (N,)
+    else if (b_shape.NumDimensions() == 1) {
+      auto bias_vec = ConstEigenVectorMap<Eigen::half>(b_data, N);
+      output_mat.rowwise() += bias_vec.cast<float>().transpose();
+    } else if (b_shape.NumDimensions() == 2) {
+      // B is (M, 1)
+      if (b_shape[1] == 1) {
+        auto bias_vec = ConstEigenVectorMap<Eigen::half>(b_data, M);
+        output_mat.colwise() += bias_vec.cast<float>();
+      }
+      // B is (1, N)
+      else if (b_shape[0] == 1) {
+        auto bias_vec = ConstEigenVectorMap<Eigen::half>(b_data, N);
+        output_mat.rowwise() += bias_vec.cast<float>().transpose();
+      }
+      // B is (M, N), no broadcast needed.
+      else {
+        auto bias_mat = ConstEigenMatrixMapRowMajor<Eigen::half>(b_data, M, N);
+        output_mat += bias_mat.cast<float>();
+      }
+    }
+  }
+
+  MlasSgemm(
+      trans_A_,
+      trans_B_,
+      static_cast<size_t>(M),
+      static_cast<size_t>(N),
+      static_cast<size_t>(K),
+      alpha_,
+      x_data,
+      trans_A_ == CblasNoTrans ? static_cast<size_t>(K) : static_cast<size_t>(M),
+      &W->template Data<MLFloat16>()[0].val,
+      trans_B_ == CblasNoTrans ? static_cast<size_t>(N) : static_cast<size_t>(K),
+      beta_,
+      y_data,
+      static_cast<size_t>(N));
+
+  fuse_activation<float>(activation_, y_data, M * N, leaky_relu_alpha_);
+
+  EigenVectorMap<Eigen::half>(
+      reinterpret_cast<Eigen::half*>(Y->template MutableData<MLFloat16>()), y_size) =
+      ConstEigenVectorMap<float>(y_data, y_size).cast<Eigen::half>();
+
+  return Status::OK();
+}
+
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    Gemm,
+    7,
+    9,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Gemm<MLFloat16, MLFloat16, MLFloat16, MLFloat16>);
 }
\ No newline at end of file
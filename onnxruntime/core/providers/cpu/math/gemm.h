@@ -5,17 +5,22 @@
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/providers/cpu/fuse_activation.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 #include "gemm_helper.h"
 
+#if defined(USE_MLAS)
+#include "core/mlas/inc/mlas.h"
+#endif
+
 namespace onnxruntime {
 
 template <typename T_X,
           typename T_W,
           typename T_B,
           typename T_Y>
-class Gemm final : public OpKernel {
+class Gemm : public OpKernel {
  public:
   Gemm(const OpKernelInfo& info) : OpKernel(info) {
     int64_t temp;
@@ -27,6 +32,39 @@ class Gemm final : public OpKernel {
 
     ONNXRUNTIME_ENFORCE(info.GetAttr<float>("alpha", &alpha_).IsOK());
     ONNXRUNTIME_ENFORCE(info.GetAttr<float>("beta", &beta_).IsOK());
+
+#if defined(USE_MLAS)
+    // The weight matrix is usually a constant initializer, so pack it into
+    // the MlasSgemm layout once here instead of repacking it on every call.
+    const Tensor* W;
+    if (std::is_same<T_W, float>::value &&
+        info.TryGetConstantInput(1, &W) &&
+        W->Shape().NumDimensions() == 2) {
+      size_t K = trans_B_ == CblasNoTrans ? W->Shape()[0] : W->Shape()[1];
+      size_t N = trans_B_ == CblasNoTrans ? W->Shape()[1] : W->Shape()[0];
+      size_t ldb = trans_B_ == CblasNoTrans ? N : K;
+      auto alloc = info.GetExecutionProvider()->GetAllocator(0, ONNXRuntimeMemTypeDefault);
+      const float* w_data = W->template Data<float>();
+      // Weights pruned to block sparsity pay off in a block-CSR layout once
+      // enough 4x4 blocks are entirely zero. The block-sparse multiply does
+      // not handle transposed operands, so it only applies to the plain
+      // no-transpose case.
+      if (trans_A_ == CblasNoTrans && trans_B_ == CblasNoTrans &&
+          MlasSgemmBlockSparseDensity(K, N, w_data, ldb) <= kSparseDensityThreshold) {
+        sparse_packed_w_ = IAllocator::MakeUniquePtr<void>(
+            alloc, MlasSgemmPackBlockSparseBSize(K, N, w_data, ldb));
+        if (sparse_packed_w_) {
+          MlasSgemmPackBlockSparseB(K, N, w_data, ldb, sparse_packed_w_.get());
+        }
+      }
+      if (!sparse_packed_w_) {
+        packed_w_ = IAllocator::MakeUniquePtr<void>(alloc, MlasSgemmPackBSize(N, K));
+        if (packed_w_) {
+          MlasSgemmPackB(trans_B_, N, K, w_data, ldb, packed_w_.get());
+        }
+      }
+    }
+#endif
   }
 
   Status Compute(OpKernelContext* context) const override {
@@ -90,6 +128,43 @@ class Gemm final : public OpKernel {
       }
     }
 
+#if defined(USE_MLAS)
+    if (sparse_packed_w_) {
+      MlasSgemmBlockSparse(
+          static_cast<size_t>(M),
+          static_cast<size_t>(N),
+          static_cast<size_t>(K),
+          alpha_,
+          X->template Data<float>(),
+          static_cast<size_t>(K),
+          sparse_packed_w_.get(),
+          beta_,
+          Y->template MutableData<float>(),
+          static_cast<size_t>(N));
+
+      fuse_activation<T_Y>(activation_, Y->template MutableData<T_Y>(), M * N, leaky_relu_alpha_);
+      return Status::OK();
+    }
+
+    if (packed_w_) {
+      MlasSgemm(
+          trans_A_,
+          static_cast<size_t>(M),
+          static_cast<size_t>(N),
+          static_cast<size_t>(K),
+          alpha_,
+          X->template Data<float>(),
+          trans_A_ == CblasNoTrans ? static_cast<size_t>(K) : static_cast<size_t>(M),
+          packed_w_.get(),
+          beta_,
+          Y->template MutableData<float>(),
+          static_cast<size_t>(N));
+
+      fuse_activation<T_Y>(activation_, Y->template MutableData<T_Y>(), M * N, leaky_relu_alpha_);
+      return Status::OK();
+    }
+#endif
+
     // W * x
     math::Gemm<T_X, CPUMathUtil>(
         trans_A_,
@@ -104,14 +179,34 @@ class Gemm final : public OpKernel {
         Y->template MutableData<T_Y>(),
         &CPUMathUtil::Instance());
 
+    fuse_activation<T_Y>(activation_, Y->template MutableData<T_Y>(), M * N, leaky_relu_alpha_);
     return Status::OK();
   }
 
+ protected:
+  // Activation epilogue applied while the output is still in cache; set by
+  // the FusedGemm contrib kernel, empty for the plain Gemm op.
+  std::string activation_;
+  float leaky_relu_alpha_ = 0.01f;
+
  private:
   CBLAS_TRANSPOSE trans_A_;
   CBLAS_TRANSPOSE trans_B_;
   float alpha_;
   float beta_;
+
+#if defined(USE_MLAS)
+  // Fraction of non-zero 4x4 blocks below which a constant weight matrix is
+  // stored block-sparse instead of dense packed.
+  static constexpr float kSparseDensityThreshold = 0.4f;
+
+  // Pre-packed copy of the weight matrix, built at construction when the
+  // weight is a constant initializer. At most one of the two is set:
+  // block-CSR when the weights are sparse enough, the dense MlasSgemm layout
+  // otherwise.
+  IAllocatorUniquePtr<void> packed_w_;
+  IAllocatorUniquePtr<void> sparse_packed_w_;
+#endif
 };
 
 }  // namespace onnxruntime
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/math/hardmax.h"
+#include "core/providers/cpu/reduction/row_arg_minmax.h"
 #include "core/util/math_cpuonly.h"
 #include "core/util/math.h"
 
@@ -16,7 +17,6 @@ Status Hardmax<float>::Compute(OpKernelContext* ctx) const {
   size_t tmpN = input_shape.SizeToDimension(axis_);
   size_t tmpD = input_shape.SizeFromDimension(axis_);
 
-  // Math::RowwiseMax expects int N and D.
   if (tmpN * tmpD > INT32_MAX || tmpN > INT32_MAX || tmpD > INT32_MAX) {
     std::ostringstream ss;
     ss << "Hardmax inputs N, D and N * D must be < " << INT32_MAX << ". N=" << tmpN << ", D=" << tmpD;
@@ -25,25 +25,23 @@ Status Hardmax<float>::Compute(OpKernelContext* ctx) const {
     return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, msg);
   }
 
-  const int N = gsl::narrow_cast<int>(tmpN);
-  const int D = gsl::narrow_cast<int>(tmpD);
-
-  std::vector<float> rowmax_(N);
-  float* rowmax_data = rowmax_.data();
-  math::RowwiseMax<float, CPUMathUtil>(N, D, Xdata, rowmax_data, nullptr);
+  const int64_t N = gsl::narrow_cast<int64_t>(tmpN);
+  const int64_t D = gsl::narrow_cast<int64_t>(tmpD);
 
   Tensor* Y = ctx->Output(0, input_shape);
   float* Ydata = Y->template MutableData<float>();
+
+  // Each output row is all zeros except for a single one at the row argmax, so
+  // instead of materializing the row maxima and rescanning the input for them,
+  // bulk zero the output and make one store per row. The rows split across
+  // threads when there are enough of them to amortize the dispatch.
   math::Set<float, CPUMathUtil>(input_shape.Size(), 0.f, Ydata, &CPUMathUtil::Instance());
 
-  for (int i = 0; i < N; ++i) {
-    for (int j = 0; j < D; ++j) {
-      if (Xdata[i * D + j] == rowmax_data[i]) {
-        Ydata[i * D + j] = 1;
-        break;
-      }
-    }
-  }
+  ctx->ParallelFor(0, N, static_cast<double>(D),
+                   [Xdata, Ydata, D](int64_t first, int64_t last) {
+                     for (int64_t i = first; i < last; ++i)
+                       Ydata[i * D + RowArgMax(Xdata + i * D, D)] = 1.0f;
+                   });
 
   return Status::OK();
 }
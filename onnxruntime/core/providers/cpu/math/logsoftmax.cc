@@ -26,15 +26,8 @@ Status LogSoftmax<float>::Compute(OpKernelContext* ctx) const {
 
   float* Ydata = Y->template MutableData<float>();
 
-  std::vector<float> scale_(N);
-  std::vector<float> rowmax_(N);
-  std::vector<float> sum_multiplier_(D, 1.f);  // initialize all multiplier values to 1.0
-
   const bool logarithmic = true;
-  auto status = SoftmaxCPU(N, D, X.template Data<float>(), Ydata,
-                           scale_.data(), sum_multiplier_.data(), logarithmic, rowmax_.data());
-
-  return status;
+  return SoftmaxCPU(N, D, X.template Data<float>(), Ydata, logarithmic);
 }
 
 ONNX_CPU_OPERATOR_KERNEL(
@@ -3,8 +3,10 @@
 
 #include "core/providers/cpu/math/matmul.h"
 
+#include "core/mlas/inc/mlas.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
+#include "Eigen/src/Core/arch/CUDA/Half.h"
 #include "matmul_helper.h"
 
 namespace onnxruntime {
@@ -13,9 +15,23 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
   MatMul,
   1,
   9,
-  KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+  KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()).FullyOverwritesOutputs(),
   MatMul<float>);
 
+// Returns true when the slice offsets advance by a constant amount, so the
+// batch can be described by a base pointer and a stride. A zero stride (a
+// broadcast operand) qualifies; broadcast patterns that revisit earlier
+// slices out of order do not.
+static bool HasUniformStride(const std::vector<size_t>& offsets, size_t& stride) {
+  stride = offsets.size() > 1 ? offsets[1] - offsets[0] : 0;
+  for (size_t i = 1; i < offsets.size(); i++) {
+    if (offsets[i] < offsets[i - 1] || offsets[i] - offsets[i - 1] != stride) {
+      return false;
+    }
+  }
+  return true;
+}
+
 template <>
 Status MatMul<float>::Compute(OpKernelContext* ctx) const {
   const Tensor* left_X = ctx->Input<Tensor>(0);
@@ -26,22 +42,178 @@ Status MatMul<float>::Compute(OpKernelContext* ctx) const {
 
   Tensor* Y = ctx->Output(0, helper.OutputShape());
 
-  // TODO: replace it with GemmBatch for performance, it's OK for now as GemmBatch unrolls as well
+  const size_t batch = helper.OutputOffsets().size();
+
+#if defined(USE_MLAS)
+  if (sparse_packed_right_) {
+    // The constant right operand was stored block-sparse at construction;
+    // multiply each stacked slice against the shared block-CSR copy, which
+    // only touches the non-zero blocks of the weights.
+    for (size_t i = 0; i < batch; i++) {
+      MlasSgemmBlockSparse(
+          static_cast<size_t>(helper.M()),
+          static_cast<size_t>(helper.N()),
+          static_cast<size_t>(helper.K()),
+          /* alpha */ 1.0f,
+          left_X->template Data<float>() + helper.LeftOffsets()[i],
+          static_cast<size_t>(helper.K()),
+          sparse_packed_right_.get(),
+          /* beta */ 0.0f,
+          Y->template MutableData<float>() + helper.OutputOffsets()[i],
+          static_cast<size_t>(helper.N()));
+    }
+
+    return Status::OK();
+  }
+
+  if (packed_right_) {
+    // A constant 2-D right operand was packed at construction; every batch
+    // reuses the same right matrix, so one batched call shares the packed
+    // copy across all of the stacked products.
+    std::vector<const float*> left_ptrs(batch);
+    std::vector<float*> output_ptrs(batch);
+    for (size_t i = 0; i < batch; i++) {
+      left_ptrs[i] = left_X->template Data<float>() + helper.LeftOffsets()[i];
+      output_ptrs[i] = Y->template MutableData<float>() + helper.OutputOffsets()[i];
+    }
+
+    MlasSgemmBatch(
+        CblasNoTrans,
+        static_cast<size_t>(helper.M()),
+        static_cast<size_t>(helper.N()),
+        static_cast<size_t>(helper.K()),
+        /* alpha */ 1.0f,
+        left_ptrs.data(),
+        static_cast<size_t>(helper.K()),
+        packed_right_.get(),
+        /* beta */ 0.0f,
+        output_ptrs.data(),
+        static_cast<size_t>(helper.N()),
+        batch);
+
+    return Status::OK();
+  }
+
+  // Stacked 3-D/4-D matmuls place every slice at a uniform spacing, so the
+  // batch collapses to a single strided call with the threads partitioned
+  // over the whole batch's rows rather than capped at the slice count.
+  size_t left_stride, right_stride, output_stride;
+  if (HasUniformStride(helper.LeftOffsets(), left_stride) &&
+      HasUniformStride(helper.RightOffsets(), right_stride) &&
+      HasUniformStride(helper.OutputOffsets(), output_stride)) {
+    MlasSgemmStridedBatched(
+        CblasNoTrans,
+        CblasNoTrans,
+        static_cast<size_t>(helper.M()),
+        static_cast<size_t>(helper.N()),
+        static_cast<size_t>(helper.K()),
+        /* alpha */ 1.0f,
+        left_X->template Data<float>(),
+        static_cast<size_t>(helper.K()),
+        left_stride,
+        right_X->template Data<float>(),
+        static_cast<size_t>(helper.N()),
+        right_stride,
+        /* beta */ 0.0f,
+        Y->template MutableData<float>(),
+        static_cast<size_t>(helper.N()),
+        output_stride,
+        batch);
+
+    return Status::OK();
+  }
+#endif
+
+  std::vector<const float*> left_ptrs(batch);
+  std::vector<const float*> right_ptrs(batch);
+  std::vector<float*> output_ptrs(batch);
+  for (size_t i = 0; i < batch; i++) {
+    left_ptrs[i] = left_X->template Data<float>() + helper.LeftOffsets()[i];
+    right_ptrs[i] = right_X->template Data<float>() + helper.RightOffsets()[i];
+    output_ptrs[i] = Y->template MutableData<float>() + helper.OutputOffsets()[i];
+  }
+
+  // one batched call so the stacked products share a single thread dispatch
+  math::GemmBatch<float, CPUMathUtil>(
+      CblasNoTrans,
+      CblasNoTrans,
+      helper.M(),
+      helper.N(),
+      helper.K(),
+      /* alpha */ 1.0f,
+      left_ptrs.data(),
+      right_ptrs.data(),
+      /* beta */ 0.0f,
+      output_ptrs.data(),
+      static_cast<int64_t>(batch),
+      &CPUMathUtil::Instance());
+
+  return Status::OK();
+}
+
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+  MatMul,
+  1,
+  9,
+  MLFloat16,
+  KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+  MatMul<MLFloat16>);
+
+template <>
+Status MatMul<MLFloat16>::Compute(OpKernelContext* ctx) const {
+  const Tensor* left_X = ctx->Input<Tensor>(0);
+  const Tensor* right_X = ctx->Input<Tensor>(1);
+
+  MatMulComputeHelper helper;
+  ONNXRUNTIME_RETURN_IF_ERROR(helper.Compute(left_X->Shape(), right_X->Shape()));
+
+  Tensor* Y = ctx->Output(0, helper.OutputShape());
+
+  AllocatorPtr alloc;
+  ONNXRUNTIME_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&alloc));
+
+  // The right operand stays in half precision: MlasSgemm converts its panels
+  // to single precision while packing them, so only the left operand and the
+  // output are staged as single precision buffers. The block is borrowed from
+  // the per-run scratch arena when one is active.
+  const size_t left_size = static_cast<size_t>(left_X->Shape().Size());
+  const size_t output_size = static_cast<size_t>(Y->Shape().Size());
+  const size_t staging_bytes = sizeof(float) * (left_size + output_size);
+
+  BufferUniquePtr staging_fallback;
+  float* left_data = static_cast<float*>(ctx->GetScratchBuffer(staging_bytes));
+  if (left_data == nullptr) {
+    staging_fallback = BufferUniquePtr(alloc->Alloc(staging_bytes), BufferDeleter(alloc));
+    left_data = static_cast<float*>(staging_fallback.get());
+  }
+  float* output_data = left_data + left_size;
+
+  EigenVectorMap<float>(left_data, left_size) =
+      ConstEigenVectorMap<Eigen::half>(
+          reinterpret_cast<const Eigen::half*>(left_X->template Data<MLFloat16>()), left_size)
+          .cast<float>();
+
   for (int i = 0; i < helper.OutputOffsets().size(); i++) {
-    math::Gemm<float, CPUMathUtil>(
+    MlasSgemm(
         CblasNoTrans,
         CblasNoTrans,
-        static_cast<int>(helper.M()),
-        static_cast<int>(helper.N()),
-        static_cast<int>(helper.K()),
+        static_cast<size_t>(helper.M()),
+        static_cast<size_t>(helper.N()),
+        static_cast<size_t>(helper.K()),
         /* alpha */ 1.0f,
-        left_X->template Data<float>() + helper.LeftOffsets()[i],
-        right_X->template Data<float>() + helper.RightOffsets()[i],
+        left_data + helper.LeftOffsets()[i],
+        static_cast<size_t>(helper.K()),
+        &right_X->template Data<MLFloat16>()[helper.RightOffsets()[i]].val,
+        static_cast<size_t>(helper.N()),
         /* beta */ 0.0f,
-        Y->template MutableData<float>() + helper.OutputOffsets()[i],
-        &CPUMathUtil::Instance());
+        output_data + helper.OutputOffsets()[i],
+        static_cast<size_t>(helper.N()));
   }
 
+  EigenVectorMap<Eigen::half>(
+      reinterpret_cast<Eigen::half*>(Y->template MutableData<MLFloat16>()), output_size) =
+      ConstEigenVectorMap<float>(output_data, output_size).cast<Eigen::half>();
+
   return Status::OK();
 }
 
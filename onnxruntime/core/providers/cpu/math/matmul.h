@@ -6,6 +6,10 @@
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 
+#if defined(USE_MLAS)
+#include "core/mlas/inc/mlas.h"
+#endif
+
 namespace onnxruntime {
 
 template <typename T>
@@ -13,9 +17,54 @@ class MatMul final : public OpKernel {
  public:
   MatMul(const OpKernelInfo& info)
       : OpKernel(info) {
+#if defined(USE_MLAS)
+    // The right operand is usually a constant initializer holding the layer
+    // weights, so pack it into the MlasSgemm layout once here instead of
+    // repacking it on every call. Only the common 2-D weight case is packed;
+    // stacked (N-D) weights fall back to the unpacked path.
+    const Tensor* right;
+    if (std::is_same<T, float>::value &&
+        info.TryGetConstantInput(1, &right) &&
+        right->Shape().NumDimensions() == 2) {
+      size_t K = right->Shape()[0];
+      size_t N = right->Shape()[1];
+      auto alloc = info.GetExecutionProvider()->GetAllocator(0, ONNXRuntimeMemTypeDefault);
+      const float* right_data = right->template Data<float>();
+      // Weights pruned to block sparsity pay off in a block-CSR layout once
+      // enough 4x4 blocks are entirely zero; the threshold is conservative so
+      // merely-sparse-ish weights keep the dense packed path.
+      if (MlasSgemmBlockSparseDensity(K, N, right_data, N) <= kSparseDensityThreshold) {
+        sparse_packed_right_ = IAllocator::MakeUniquePtr<void>(
+            alloc, MlasSgemmPackBlockSparseBSize(K, N, right_data, N));
+        if (sparse_packed_right_) {
+          MlasSgemmPackBlockSparseB(K, N, right_data, N, sparse_packed_right_.get());
+        }
+      }
+      if (!sparse_packed_right_) {
+        packed_right_ = IAllocator::MakeUniquePtr<void>(alloc, MlasSgemmPackBSize(N, K));
+        if (packed_right_) {
+          MlasSgemmPackB(CblasNoTrans, N, K, right_data, N, packed_right_.get());
+        }
+      }
+    }
+#endif
   }
 
   Status Compute(OpKernelContext* context) const override;
+
+#if defined(USE_MLAS)
+ private:
+  // Fraction of non-zero 4x4 blocks below which a constant right operand is
+  // stored block-sparse instead of dense packed.
+  static constexpr float kSparseDensityThreshold = 0.4f;
+
+  // Pre-packed copy of the right operand, built at construction when the
+  // operand is a constant 2-D initializer. At most one of the two is set:
+  // block-CSR when the weights are sparse enough, the dense MlasSgemm layout
+  // otherwise.
+  IAllocatorUniquePtr<void> packed_right_;
+  IAllocatorUniquePtr<void> sparse_packed_right_;
+#endif
 };
 
 }  // namespace onnxruntime
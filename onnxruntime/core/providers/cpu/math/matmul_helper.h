@@ -31,7 +31,7 @@ class MatMulComputeHelper {
       N_ = right_shape[right_num_dims - 1];
       std::vector<int64_t> output_dims = left_shape.GetDims();
       output_dims[left_num_dims - 1] = N_;
-      output_shape_ = TensorShape(output_dims);
+      output_shape_ = TensorShape(std::move(output_dims));
       output_offsets_ = {0};
       left_offsets_ = {0};
       right_offsets_ = {0};
@@ -112,7 +112,7 @@ class MatMulComputeHelper {
     }
 
     // assign shape
-    output_shape_ = TensorShape(output_dims);
+    output_shape_ = TensorShape(std::move(output_dims));
 
     // compute broadcast offsets
     ComputeBroadcastOffsets();
@@ -6,23 +6,21 @@
 #include "core/common/status.h"
 
 namespace onnxruntime {
+
 /**
 Calculate Softmax using CPU memory.
 @param N Number of rows
 @param D Number of elements in each row
 @param Xdata Source data
 @param Ydata Output data
-@param scale Storage for scale calculation. Size must be >= N.
-@param sum_multiplier Weights for each element. Size must be >= D.
 @param logarithmic If true, compute LogSoftmax. If false compute Softmax.
-@param rowmax Storage for calculation of maximum in each row. Size must be >= N.
+When the matrix is large enough to cover the dispatch overhead, blocks of rows
+are processed on the shared pool; rows are independent so the result is
+identical.
 */
-common::Status SoftmaxCPU(const int64_t N,
-                          const int64_t D,
+common::Status SoftmaxCPU(int64_t N,
+                          int64_t D,
                           const float* Xdata,
                           float* Ydata,
-                          float* scale,
-                          const float* sum_multiplier,
-                          bool logarithmic,
-                          float* rowmax);
+                          bool logarithmic);
 }  // namespace onnxruntime
@@ -20,7 +20,7 @@
 #include "core/framework/op_kernel.h"
 #include "core/framework/tensor.h"
 #include "core/util/math_cpuonly.h"
-#include <queue>
+#include <algorithm>
 using namespace std;
 namespace onnxruntime {
 // spec https://github.com/onnx/onnx/blob/master/docs/Operators.md#TopK
@@ -95,34 +95,54 @@ Status TopK<float>::Compute(OpKernelContext* p_op_kernel_context) const {
   auto Indices_map = EigenMatrixMapRowMajor<int64_t>(
       Indices->template MutableData<int64_t>(), linear_shape[0], k_);
 
-  // Sort preserving Indices
-  for (int64_t i = 0; i < linear_shape[0]; ++i) {
-    // Build a min-heap, the heap element is pair of (value, idx)
-    // the top of the heap is the smallest value
-    priority_queue<
-        pair<float, int64_t>,
-        vector<pair<float, int64_t>>,
-        ValueCmp<float>>
-        min_heap;
-
-    // Maintain the size of heap to be less or equal to k_, so the
-    // heap will hold the k_ largest Values
-    for (int64_t j = 0; j < linear_shape[1]; ++j) {
-      const auto value = input_map(i, j);
-      if (min_heap.size() < k_ || value > min_heap.top().first) {
-        min_heap.push({value, j});
+  const int64_t rows = linear_shape[0];
+  const int64_t cols = linear_shape[1];
+  const int64_t k = static_cast<int64_t>(k_);
+
+  // When k is a small fraction of the row, a bounded min-heap touches the
+  // heap only for the entries that displace its minimum, O(n + m*log(k));
+  // as k approaches n the heap degrades towards sorting everything through
+  // it one push at a time, and a partial sort over the whole row is cheaper.
+  const bool use_heap = k * 4 <= cols;
+
+  // Selects the top k entries of rows [first, last), sorted by descending
+  // value with ties broken by ascending index. The scratch vector is reused
+  // across rows so steady-state rows cost no allocations.
+  auto select_rows = [&](int64_t first, int64_t last) {
+    vector<pair<float, int64_t>> scratch;
+    for (int64_t i = first; i < last; ++i) {
+      scratch.clear();
+      if (use_heap) {
+        // Build a min-heap of the first k entries (the front is the smallest
+        // value), then let only larger values displace the minimum.
+        scratch.reserve(k);
+        for (int64_t j = 0; j < k; ++j)
+          scratch.emplace_back(input_map(i, j), j);
+        make_heap(scratch.begin(), scratch.end(), ValueCmp<float>());
+        for (int64_t j = k; j < cols; ++j) {
+          const auto value = input_map(i, j);
+          if (value > scratch.front().first) {
+            pop_heap(scratch.begin(), scratch.end(), ValueCmp<float>());
+            scratch.back() = {value, j};
+            push_heap(scratch.begin(), scratch.end(), ValueCmp<float>());
+          }
+        }
+        sort(scratch.begin(), scratch.end(), ValueCmp<float>());
+      } else {
+        scratch.reserve(cols);
+        for (int64_t j = 0; j < cols; ++j)
+          scratch.emplace_back(input_map(i, j), j);
+        partial_sort(scratch.begin(), scratch.begin() + k, scratch.end(), ValueCmp<float>());
       }
-      if (min_heap.size() > k_) {
-        min_heap.pop();
+
+      for (int64_t j = 0; j < k; ++j) {
+        Values_map(i, j) = scratch[j].first;
+        Indices_map(i, j) = scratch[j].second;
       }
     }
-    for (int64_t j = 0; j < k_; ++j) {
-      auto& pqElem = min_heap.top();
-      Values_map(i, k_ - j - 1) = pqElem.first;
-      Indices_map(i, k_ - j - 1) = pqElem.second;
-      min_heap.pop();
-    }
-  }
+  };
+
+  p_op_kernel_context->ParallelFor(0, rows, static_cast<double>(cols), select_rows);
 
   // Reshape output tensors to [a_1, a_2, ..., a_n, k]
   auto out_dims = in_dims;
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/ml/linearclassifier.h"
+#include "core/util/math.h"
 
 namespace onnxruntime {
 namespace ml {
@@ -50,6 +51,23 @@ LinearClassifier<T>::LinearClassifier(const OpKernelInfo& info) : OpKernel(info)
 
   using_strings_ = !classlabels_strings_.empty();
   class_count_ = static_cast<int64_t>(intercepts_.size());
+
+#if defined(USE_MLAS)
+  // The coefficients form a (class_count x feature_count) attribute matrix
+  // fixed at session load, so pack its transpose for MlasSgemm once here
+  // instead of repacking it on every call.
+  if (class_count_ > 0 && coefficients_.size() % class_count_ == 0) {
+    const size_t feature_count = coefficients_.size() / class_count_;
+    auto alloc = info.GetExecutionProvider()->GetAllocator(0, ONNXRuntimeMemTypeDefault);
+    packed_coefficients_ = IAllocator::MakeUniquePtr<void>(
+        alloc, MlasSgemmPackBSize(static_cast<size_t>(class_count_), feature_count));
+    if (packed_coefficients_) {
+      MlasSgemmPackB(CblasTrans, static_cast<size_t>(class_count_), feature_count,
+                     coefficients_.data(), feature_count, packed_coefficients_.get());
+      packed_feature_count_ = static_cast<int64_t>(feature_count);
+    }
+  }
+#endif
 }
 
 template <typename T>
@@ -73,78 +91,112 @@ Status LinearClassifier<T>::Compute(OpKernelContext* ctx) const {
   }
   Tensor* Z = ctx->Output(1, TensorShape({N, output_classes}));
 
-  int64_t zindex = 0;
   const auto* x_data = X->template Data<T>();
+  const int64_t class_count = class_count_;
 
-  size_t class_count = static_cast<size_t>(class_count_);
-  std::vector<float> scores;
-  scores.reserve(class_count);
-  for (int64_t i = 0; i < N; i++)  //for each point
-  {
-    scores.clear();
-    size_t current_weight_0 = i * stride;
-    int maxclass = -1;
-    float maxweight = 0.f;
-    for (int j = 0; j < class_count; j++)  //for each class
-    {
-      size_t current_coeff_0 = j * stride;
-      float weight = 0.f;
-      for (int64_t k = 0; k < stride; k++)  //for each weight
-      {
-        weight += static_cast<float>(x_data[current_weight_0 + k] * coefficients_[current_coeff_0 + k]);
-      }
-      if (intercepts_.size() == class_count) {
-        weight += intercepts_[j];
-      }
-      scores.push_back(weight);
-      if (weight > maxweight || maxclass == -1) {
-        maxweight = weight;
-        maxclass = j;
+  // Score the whole batch with one GEMM instead of per-sample dot products:
+  //   batch_scores(N x class_count) = X(N x stride) * coefficients^T
+  std::vector<float> converted;
+  const float* x_float = ToFloatView(x_data, N * stride, converted);
+  std::vector<float> batch_scores(static_cast<size_t>(N * class_count));
+  bool scored = false;
+#if defined(USE_MLAS)
+  if (packed_coefficients_ && packed_feature_count_ == stride) {
+    MlasSgemm(CblasNoTrans, static_cast<size_t>(N), static_cast<size_t>(class_count),
+              static_cast<size_t>(stride), 1.0f, x_float, static_cast<size_t>(stride),
+              packed_coefficients_.get(), 0.0f, batch_scores.data(),
+              static_cast<size_t>(class_count));
+    scored = true;
+  }
+#endif
+  if (!scored && coefficients_.size() == static_cast<size_t>(class_count * stride)) {
+    math::GemmEx<float, CPUMathUtil>(CblasNoTrans, CblasTrans,
+                                     N, class_count, stride,
+                                     1.0f, x_float, stride, coefficients_.data(), stride,
+                                     0.0f, batch_scores.data(), class_count,
+                                     &CPUMathUtil::Instance());
+    scored = true;
+  }
+  if (!scored) {
+    // The coefficients do not form a class_count x stride matrix; keep the
+    // original indexing for this unusual layout.
+    for (int64_t i = 0; i < N; ++i) {
+      for (int64_t j = 0; j < class_count; ++j) {
+        float weight = 0.f;
+        for (int64_t k = 0; k < stride; ++k) {
+          weight += static_cast<float>(x_data[i * stride + k] * coefficients_[j * stride + k]);
+        }
+        batch_scores[static_cast<size_t>(i * class_count + j)] = weight;
       }
     }
-    //write top class
-    if (intercepts_.size() == 1)  //binary
+  }
+
+  // Each sample writes a disjoint slice of Y and Z, so the label selection
+  // and post transform shard over the batch.
+  const bool add_intercepts = intercepts_.size() == static_cast<size_t>(class_count);
+  const float* scores_base = batch_scores.data();
+  ctx->ParallelFor(0, N, 5.0 * output_classes, [&](int64_t first, int64_t last) {
+    std::vector<float> scores;
+    scores.reserve(static_cast<size_t>(output_classes));
+    for (int64_t i = first; i < last; i++)  //for each point
     {
-      if (using_strings_) {
-        if (classlabels_strings_.size() == 2 && maxweight > 0) {
-          Y->template MutableData<std::string>()[i] = classlabels_strings_[1];  //positive label
-        } else if (classlabels_strings_.size() == 2) {
-          Y->template MutableData<std::string>()[i] = classlabels_strings_[0];  //negative label
-        } else if (maxweight > 0) {
-          Y->template MutableData<std::string>()[i] = "1";  //positive label
-        } else {
-          Y->template MutableData<std::string>()[i] = "0";  //negative label
+      scores.assign(scores_base + i * class_count, scores_base + (i + 1) * class_count);
+      int maxclass = -1;
+      float maxweight = 0.f;
+      for (int64_t j = 0; j < class_count; j++)  //for each class
+      {
+        if (add_intercepts) {
+          scores[static_cast<size_t>(j)] += intercepts_[static_cast<size_t>(j)];
+        }
+        if (scores[static_cast<size_t>(j)] > maxweight || maxclass == -1) {
+          maxweight = scores[static_cast<size_t>(j)];
+          maxclass = static_cast<int>(j);
+        }
+      }
+      //write top class
+      if (intercepts_.size() == 1)  //binary
+      {
+        if (using_strings_) {
+          if (classlabels_strings_.size() == 2 && maxweight > 0) {
+            Y->template MutableData<std::string>()[i] = classlabels_strings_[1];  //positive label
+          } else if (classlabels_strings_.size() == 2) {
+            Y->template MutableData<std::string>()[i] = classlabels_strings_[0];  //negative label
+          } else if (maxweight > 0) {
+            Y->template MutableData<std::string>()[i] = "1";  //positive label
+          } else {
+            Y->template MutableData<std::string>()[i] = "0";  //negative label
+          }
+        } else  //no strings
+        {
+          if (classlabels_ints_.size() == 2 && maxweight > 0) {
+            Y->template MutableData<int64_t>()[i] = classlabels_ints_[1];  //positive label
+          } else if (classlabels_ints_.size() == 2) {
+            Y->template MutableData<int64_t>()[i] = classlabels_ints_[0];  //negative label
+          } else if (maxweight > 0) {
+            Y->template MutableData<int64_t>()[i] = 1;  //positive label
+          } else {
+            Y->template MutableData<int64_t>()[i] = 0;  //negative label
+          }
         }
-      } else  //no strings
+      } else  //multiclass
       {
-        if (classlabels_ints_.size() == 2 && maxweight > 0) {
-          Y->template MutableData<int64_t>()[i] = classlabels_ints_[1];  //positive label
-        } else if (classlabels_ints_.size() == 2) {
-          Y->template MutableData<int64_t>()[i] = classlabels_ints_[0];  //negative label
-        } else if (maxweight > 0) {
-          Y->template MutableData<int64_t>()[i] = 1;  //positive label
+        if (using_strings_) {
+          Y->template MutableData<std::string>()[i] = classlabels_strings_[maxclass];
         } else {
-          Y->template MutableData<int64_t>()[i] = 0;  //negative label
+          Y->template MutableData<int64_t>()[i] = classlabels_ints_[maxclass];
         }
       }
-    } else  //multiclass
-    {
-      if (using_strings_) {
-        Y->template MutableData<std::string>()[i] = classlabels_strings_[maxclass];
+      //write float values; each sample writes exactly output_classes of them
+      int64_t zindex = i * output_classes;
+      if (add_second_class && maxweight > 0) {
+        ::onnxruntime::ml::write_scores(scores, post_transform_, zindex, Z, 0);
+      } else if (add_second_class) {
+        ::onnxruntime::ml::write_scores(scores, post_transform_, zindex, Z, 1);
       } else {
-        Y->template MutableData<int64_t>()[i] = classlabels_ints_[maxclass];
+        ::onnxruntime::ml::write_scores(scores, post_transform_, zindex, Z, -1);
       }
-    }
-    //write float values
-    if (add_second_class && maxweight > 0) {
-      ::onnxruntime::ml::write_scores(scores, post_transform_, zindex, Z, 0);
-    } else if (add_second_class) {
-      ::onnxruntime::ml::write_scores(scores, post_transform_, zindex, Z, 1);
-    } else {
-      ::onnxruntime::ml::write_scores(scores, post_transform_, zindex, Z, -1);
-    }
-    zindex += scores.size();
-  }  //for each point
+    }  //for each point
+  });
   return Status::OK();
 }
 
@@ -8,6 +8,10 @@
 #include "core/util/math_cpuonly.h"
 #include "ml_common.h"
 
+#if defined(USE_MLAS)
+#include "core/mlas/inc/mlas.h"
+#endif
+
 namespace onnxruntime {
 namespace ml {
 
@@ -26,6 +30,12 @@ class LinearClassifier final : public OpKernel {
   std::vector<float> intercepts_;
   std::vector<std::string> classlabels_strings_;
   std::vector<int64_t> classlabels_ints_;
+#if defined(USE_MLAS)
+  // Coefficients pre-packed for MlasSgemm at construction. The packing assumes
+  // a fixed feature count; the runtime stride has to match for it to be used.
+  IAllocatorUniquePtr<void> packed_coefficients_;
+  int64_t packed_feature_count_{0};
+#endif
 };
 
 }  // namespace ml
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/ml/linearregressor.h"
+#include "core/util/math.h"
 
 namespace onnxruntime {
 namespace ml {
@@ -18,6 +19,23 @@ LinearRegressor<T>::LinearRegressor(const OpKernelInfo& info) : OpKernel(info),
                                                                 post_transform_(MakeTransform(info.GetAttrOrDefault<std::string>("post_transform", "NONE"))) {
   ONNXRUNTIME_ENFORCE(info.GetAttr<int64_t>("targets", &targets_).IsOK());
   ONNXRUNTIME_ENFORCE(info.GetAttrs<float>("coefficients", coefficients_).IsOK());
+
+#if defined(USE_MLAS)
+  // The coefficients form a (targets x feature_count) attribute matrix fixed
+  // at session load, so pack its transpose for MlasSgemm once here instead of
+  // repacking it on every call.
+  if (targets_ > 0 && coefficients_.size() % targets_ == 0) {
+    const size_t feature_count = coefficients_.size() / targets_;
+    auto alloc = info.GetExecutionProvider()->GetAllocator(0, ONNXRuntimeMemTypeDefault);
+    packed_coefficients_ = IAllocator::MakeUniquePtr<void>(
+        alloc, MlasSgemmPackBSize(static_cast<size_t>(targets_), feature_count));
+    if (packed_coefficients_) {
+      MlasSgemmPackB(CblasTrans, static_cast<size_t>(targets_), feature_count,
+                     coefficients_.data(), feature_count, packed_coefficients_.get());
+      packed_feature_count_ = static_cast<int64_t>(feature_count);
+    }
+  }
+#endif
 }
 
 template <>
@@ -32,29 +50,61 @@ Status LinearRegressor<float>::Compute(OpKernelContext* ctx) const {
   int64_t N = X->Shape().NumDimensions() == 1 ? 1 : X->Shape()[0];
   Tensor* Y = ctx->Output(0, TensorShape({N, targets_}));
   const auto* Xdata = X->template Data<float>();
-  int64_t yindex = 0;
+  const int64_t targets = targets_;
 
-  bool useIntercepts = intercepts_.size() == static_cast<size_t>(targets_) ? true : false;
-  for (int64_t i = 0; i < N; i++)  //for each point
-  {
+  // Score the whole batch with one GEMM instead of per-sample dot products:
+  //   batch_scores(N x targets) = X(N x stride) * coefficients^T
+  std::vector<float> batch_scores(static_cast<size_t>(N * targets));
+  bool scored = false;
+#if defined(USE_MLAS)
+  if (packed_coefficients_ && packed_feature_count_ == stride) {
+    MlasSgemm(CblasNoTrans, static_cast<size_t>(N), static_cast<size_t>(targets),
+              static_cast<size_t>(stride), 1.0f, Xdata, static_cast<size_t>(stride),
+              packed_coefficients_.get(), 0.0f, batch_scores.data(),
+              static_cast<size_t>(targets));
+    scored = true;
+  }
+#endif
+  if (!scored && coefficients_.size() == static_cast<size_t>(targets * stride)) {
+    math::GemmEx<float, CPUMathUtil>(CblasNoTrans, CblasTrans,
+                                     N, targets, stride,
+                                     1.0f, Xdata, stride, coefficients_.data(), stride,
+                                     0.0f, batch_scores.data(), targets,
+                                     &CPUMathUtil::Instance());
+    scored = true;
+  }
+  if (!scored) {
+    // The coefficients do not form a targets x stride matrix; keep the
+    // original indexing for this unusual layout.
+    for (int64_t i = 0; i < N; ++i) {
+      for (int64_t j = 0; j < targets; ++j) {
+        float weight = 0.f;
+        for (int64_t k = 0; k < stride; ++k) {
+          weight += Xdata[i * stride + k] * coefficients_[j * stride + k];
+        }
+        batch_scores[static_cast<size_t>(i * targets + j)] = weight;
+      }
+    }
+  }
+
+  // Each sample writes a disjoint row of Y, so the intercept addition and
+  // post transform shard over the batch.
+  const bool useIntercepts = intercepts_.size() == static_cast<size_t>(targets);
+  const float* scores_base = batch_scores.data();
+  ctx->ParallelFor(0, N, 5.0 * targets, [&](int64_t first, int64_t last) {
     std::vector<float> scores;
-    int64_t current_weight_0 = i * stride;
-    for (int j = 0; j < targets_; j++)  //for each target
+    scores.reserve(static_cast<size_t>(targets));
+    for (int64_t i = first; i < last; i++)  //for each point
     {
-      int64_t current_coeff_0 = j * stride;
-      float weight = 0.f;
-      for (int64_t k = 0; k < stride; k++)  //for each weight
-      {
-        weight = weight + Xdata[current_weight_0 + k] * coefficients_[current_coeff_0 + k];
-      }
+      scores.assign(scores_base + i * targets, scores_base + (i + 1) * targets);
       if (useIntercepts) {
-        weight = weight + intercepts_[j];
+        for (int64_t j = 0; j < targets; j++) {
+          scores[static_cast<size_t>(j)] += intercepts_[static_cast<size_t>(j)];
+        }
       }
-      scores.push_back(weight);
+      ::onnxruntime::ml::write_scores(scores, post_transform_, i * targets, Y, -1);
     }
-    ::onnxruntime::ml::write_scores(scores, post_transform_, yindex, Y, -1);
-    yindex += scores.size();
-  }
+  });
   return Status::OK();
 }
 
@@ -8,6 +8,10 @@
 #include "core/util/math_cpuonly.h"
 #include "ml_common.h"
 
+#if defined(USE_MLAS)
+#include "core/mlas/inc/mlas.h"
+#endif
+
 namespace onnxruntime {
 namespace ml {
 
@@ -22,6 +26,12 @@ class LinearRegressor final : public OpKernel {
   std::vector<float> coefficients_;
   std::vector<float> intercepts_;
   POST_EVAL_TRANSFORM post_transform_;
+#if defined(USE_MLAS)
+  // Coefficients pre-packed for MlasSgemm at construction. The packing assumes
+  // a fixed feature count; the runtime stride has to match for it to be used.
+  IAllocatorUniquePtr<void> packed_coefficients_;
+  int64_t packed_feature_count_{0};
+#endif
 };
 
 }  // namespace ml
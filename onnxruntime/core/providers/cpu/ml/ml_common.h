@@ -280,6 +280,22 @@ static inline void compute_softmax_zero(std::vector<float>& values) {
   }
 }
 
+// Returns a float view of 'count' elements of 'data', converting through
+// 'buffer' when the element type is not already float.
+template <typename T>
+inline const float* ToFloatView(const T* data, int64_t count, std::vector<float>& buffer) {
+  buffer.resize(static_cast<size_t>(count));
+  for (int64_t i = 0; i < count; ++i) {
+    buffer[static_cast<size_t>(i)] = static_cast<float>(data[i]);
+  }
+  return buffer.data();
+}
+
+template <>
+inline const float* ToFloatView<float>(const float* data, int64_t, std::vector<float>&) {
+  return data;
+}
+
 static inline void write_scores(std::vector<float>& scores, POST_EVAL_TRANSFORM post_transform, int64_t write_index, Tensor* Z, int add_second_class) {
   if (post_transform == POST_EVAL_TRANSFORM::PROBIT && scores.size() == 1) {
     scores[0] = ml_sqrt2 * ml_inv_erf(2 * scores[0] - 1);
@@ -58,6 +58,16 @@ SVMClassifier<T>::SVMClassifier(const OpKernelInfo& info)
   if (vector_count_ > 0) {
     feature_count_ = support_vectors_.size() / vector_count_;  //length of each support vector
     mode_ = SVM_TYPE::SVM_SVC;
+    if (get_kernel_type() == KERNEL::RBF) {
+      //the support vectors are fixed attributes, so their squared norms for
+      //the batched RBF expansion only need computing once
+      sv_norms_.resize(vector_count_);
+      for (int64_t i = 0; i < vector_count_; i++) {
+        sv_norms_[i] = ConstEigenVectorMap<float>(support_vectors_.data() + i * feature_count_,
+                                                  feature_count_)
+                           .squaredNorm();
+      }
+    }
   } else {
     feature_count_ = coefficients_.size() / class_count_;  //liblinear mode
     mode_ = SVM_TYPE::SVM_LINEAR;
@@ -95,21 +105,33 @@ Status SVMClassifier<T>::Compute(OpKernelContext* ctx) const {
   const auto* x_data = X->template Data<T>();
   int64_t zindex = 0;
 
+  // Evaluate the sample-by-support-vector kernel matrix (or the per-class
+  // decision values in liblinear mode) for the whole batch up front; it
+  // dominates the cost and shards across the thread pool in sample blocks.
+  // The loop below only tallies votes and writes labels and scores.
+  std::vector<float> converted;
+  const float* x_float = ToFloatView(x_data, N * stride, converted);
+  std::vector<float> kernel_matrix;
+  if (mode_ == SVM_TYPE::SVM_SVC) {
+    kernel_matrix.resize(static_cast<size_t>(N * vector_count_));
+    batched_kernel_dot(ctx, x_float, N, stride, support_vectors_, vector_count_, feature_count_,
+                       sv_norms_.data(), kernel_matrix.data(), get_kernel_type());
+  } else {
+    kernel_matrix.resize(static_cast<size_t>(N * class_count_));
+    batched_kernel_dot(ctx, x_float, N, stride, coefficients_, class_count_, feature_count_,
+                       nullptr, kernel_matrix.data(), get_kernel_type());
+  }
+
   for (int64_t n = 0; n < N; n++)  //for each example
   {
-    int64_t current_weight_0 = n * stride;
     int64_t maxclass = -1;
     double maxweight = 0.f;
     std::vector<float> decisions;
     std::vector<float> scores;
-    std::vector<float> kernels;
     std::vector<int64_t> votes;
 
     if (mode_ == SVM_TYPE::SVM_SVC) {
-      for (int64_t j = 0; j < vector_count_; j++) {
-        float val = kernel_dot(x_data, current_weight_0, support_vectors_, feature_count_ * j, feature_count_, get_kernel_type());
-        kernels.push_back(val);
-      }
+      const float* kernels = kernel_matrix.data() + n * vector_count_;
       for (int64_t j = 0; j < class_count_; j++) {
         votes.push_back(0);
       }
@@ -146,11 +168,10 @@ Status SVMClassifier<T>::Compute(OpKernelContext* ctx) const {
           evals++;  //index into rho
         }
       }
-    } else if (mode_ == SVM_TYPE::SVM_LINEAR) {     //liblinear
+    } else if (mode_ == SVM_TYPE::SVM_LINEAR) {  //liblinear
+      const float* vals = kernel_matrix.data() + n * class_count_;
       for (int64_t j = 0; j < class_count_; j++) {  //for each class
-        float val = kernel_dot(x_data, current_weight_0, coefficients_, feature_count_ * j, feature_count_, get_kernel_type());
-        val += rho_[0];
-        scores.push_back(val);
+        scores.push_back(vals[j] + rho_[0]);
       }
     }
     if (proba_.size() > 0 && mode_ == SVM_TYPE::SVM_SVC) {
@@ -5,9 +5,14 @@
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 #include "ml_common.h"
 
+#if defined(USE_MLAS)
+#include "core/mlas/inc/mlas.h"
+#endif
+
 namespace onnxruntime {
 namespace ml {
 
@@ -57,6 +62,50 @@ class SVMCommon {
     return sum;
   }
 
+  // Evaluates the kernel between every row of A (m x len, row stride lda) and
+  // every row of B (n x len, contiguous), writing the m x n kernel matrix to
+  // 'out'. The rows shard across the session thread pool; each block is one
+  // GEMM for the dot products followed by a vectorized kernel transform. For
+  // RBF the squared distance expands to |a|^2 - 2*a.b + |b|^2, with the
+  // per-row |b|^2 supplied in b_norms.
+  void batched_kernel_dot(OpKernelContext* ctx, const float* A, int64_t m, int64_t lda,
+                          const std::vector<float>& B, int64_t n, int64_t len,
+                          const float* b_norms, float* out, KERNEL k) const {
+    const float* b_data = B.data();
+    ctx->ParallelFor(0, m, 2.0 * n * len, [=](int64_t first, int64_t last) {
+      const int64_t rows = last - first;
+      float* block = out + first * n;
+      math::GemmEx<float, CPUMathUtil>(CblasNoTrans, CblasTrans,
+                                       rows, n, len,
+                                       k == KERNEL::RBF ? -2.0f : 1.0f,
+                                       A + first * lda, lda, b_data, len,
+                                       0.0f, block, n, &CPUMathUtil::Instance());
+      const int64_t total = rows * n;
+      EigenVectorArrayMap<float> block_map(block, total);
+      if (k == KERNEL::POLY) {
+        block_map = (gamma_ * block_map + coef0_).pow(degree_);
+      } else if (k == KERNEL::SIGMOID) {
+        block_map = gamma_ * block_map + coef0_;
+#if defined(USE_MLAS)
+        MlasComputeTanh(block, block, static_cast<size_t>(total));
+#else
+        block_map = block_map.tanh();
+#endif
+      } else if (k == KERNEL::RBF) {
+        for (int64_t i = 0; i < rows; ++i) {
+          const float a_norm = ConstEigenVectorMap<float>(A + (first + i) * lda, len).squaredNorm();
+          EigenVectorArrayMap<float> row(block + i * n, n);
+          row = -gamma_ * (row + a_norm + ConstEigenVectorArrayMap<float>(b_norms, n));
+        }
+#if defined(USE_MLAS)
+        MlasComputeExp(block, block, static_cast<size_t>(total));
+#else
+        block_map = block_map.exp();
+#endif
+      }
+    });
+  }
+
  private:
   KERNEL kernel_type_;
   float gamma_;
@@ -67,6 +116,7 @@ class SVMCommon {
 template <typename T>
 class SVMClassifier final : public OpKernel, private SVMCommon<T> {
   using SVMCommon<T>::kernel_dot;
+  using SVMCommon<T>::batched_kernel_dot;
   using SVMCommon<T>::set_kernel_type;
   using SVMCommon<T>::get_kernel_type;
 
@@ -87,6 +137,7 @@ class SVMClassifier final : public OpKernel, private SVMCommon<T> {
   std::vector<float> probb_;
   std::vector<float> coefficients_;
   std::vector<float> support_vectors_;
+  std::vector<float> sv_norms_;  //squared norm per support vector, for the batched RBF expansion
   std::vector<int64_t> classlabels_ints_;
   std::vector<std::string> classlabels_strings_;
   POST_EVAL_TRANSFORM post_transform_;
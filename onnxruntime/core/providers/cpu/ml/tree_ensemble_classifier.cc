@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/ml/tree_ensemble_classifier.h"
+#include "core/common/work_stealing_thread_pool.h"
 
 /**
 https://github.com/onnx/onnx/blob/master/onnx/defs/traditionalml/defs.cc
@@ -225,22 +226,6 @@ void TreeEnsembleClassifier<T>::Initialize() {
     else
       return std::get<1>(t1) < std::get<1>(t2);
   });
-  // make an index so we can find the leafnode data quickly when evaluating
-  int64_t field0 = -1;
-  int64_t field1 = -1;
-  for (size_t i = 0, end = leafnodedata_.size(); i < end; ++i) {
-    int64_t id0 = std::get<0>(leafnodedata_[i]);
-    int64_t id1 = std::get<1>(leafnodedata_[i]);
-    if (id0 != field0 || id1 != field1) {
-      int64_t id = id0 * kOffset_ + id1;
-      int64_t position = static_cast<int64_t>(i);
-      auto p3 = std::make_pair(id, position);
-      leafdata_map_.insert(p3);
-      field0 = id;
-      field1 = position;
-    }
-  }
-
   // treenode ids, some are roots_, and roots_ have no parents
   std::unordered_map<int64_t, int64_t> parents;  // holds count of all who point to you
   std::unordered_map<int64_t, int64_t> indices;
@@ -291,6 +276,16 @@ void TreeEnsembleClassifier<T>::Initialize() {
   ONNXRUNTIME_ENFORCE(base_values_.empty() ||
               base_values_.size() == static_cast<size_t>(class_count_) ||
               base_values_.size() == weights_classes_.size());
+
+  // the compiled walk accumulates into a dense per-class vector, so every
+  // class id must be a valid index into the label list
+  for (int64_t class_id : class_ids_) {
+    ONNXRUNTIME_ENFORCE(class_id >= 0 && class_id < class_count_, "Invalid class id ", class_id);
+  }
+
+  // flatten everything into the compiled form the hot loop walks
+  compiled_.Build(nodes_treeids_, nodes_nodeids_, nodes_featureids_, nodes_values_, nodes_modes_,
+                  nodes_truenodeids_, nodes_falsenodeids_, missing_tracks_true_, roots_, leafnodedata_);
 }
 
 template <typename T>
@@ -307,34 +302,37 @@ common::Status TreeEnsembleClassifier<T>::Compute(OpKernelContext* context) cons
   Tensor* Y = context->Output(0, TensorShape({N}));
   auto* Z = context->Output(1, TensorShape({N, class_count_}));
 
-  int64_t zindex = 0;
   const T* x_data = X.template Data<T>();
+  const auto& roots = compiled_.Roots();
 
-  // for each class
-  std::vector<float> scores;
-  scores.reserve(class_count_);
-  for (int64_t i = 0; i < N; ++i) {
-    scores.clear();
+  // Scores one sample through the compiled ensemble and writes its label and
+  // scores; 'zindex' is where the row's scores start in Z. Returns the number
+  // of scores written, which write_scores may have grown past the number of
+  // classes the leaves touched.
+  auto process_row = [&](int64_t i, int64_t zindex, std::vector<float>& scores,
+                         std::vector<char>& has_score, std::vector<float>& out_scores) -> int64_t {
+    std::fill(scores.begin(), scores.end(), 0.f);
+    std::fill(has_score.begin(), has_score.end(), 0);
     int64_t current_weight_0 = i * stride;
-    std::map<int64_t, float> classes;
     // fill in base values, this might be empty but that is ok
     for (int64_t k = 0, end = static_cast<int64_t>(base_values_.size()); k < end; ++k) {
-      auto p1 = std::make_pair<int64_t&, const float&>(k, base_values_[k]);
-      classes.insert(p1);
+      scores[k] = base_values_[k];
+      has_score[k] = 1;
     }
     // walk each tree from its root
-    for (size_t j = 0, end = roots_.size(); j < end; ++j) {
-      ONNXRUNTIME_RETURN_IF_ERROR(ProcessTreeNode(classes, roots_[j], x_data, current_weight_0));
+    for (int32_t root : roots) {
+      compiled_.WalkTree(root, x_data + current_weight_0, scores, has_score);
     }
     float maxweight = 0.f;
     int64_t maxclass = -1;
     // write top class
     int write_additional_scores = -1;
     if (class_count_ > 2) {
-      for (auto& classe : classes) {
-        if (maxclass == -1 || classe.second > maxweight) {
-          maxclass = classe.first;
-          maxweight = classe.second;
+      for (int64_t k = 0; k < class_count_; ++k) {
+        if (!has_score[k]) continue;
+        if (maxclass == -1 || scores[k] > maxweight) {
+          maxclass = k;
+          maxweight = scores[k];
         }
       }
       if (using_strings_) {
@@ -344,7 +342,15 @@ common::Status TreeEnsembleClassifier<T>::Compute(OpKernelContext* context) cons
       }
     } else  // binary case
     {
-      maxweight = classes.size() > 0 ? classes[0] : 0.f;  // only 1 class
+      bool any_score = false;
+      for (int64_t k = 0; k < class_count_ && !any_score; ++k) {
+        any_score = has_score[k] != 0;
+      }
+      maxweight = any_score ? scores[0] : 0.f;  // only 1 class
+      // the old std::map lookup inserted class 0 on the fly; keep that entry
+      if (any_score) {
+        has_score[0] = 1;
+      }
       if (using_strings_) {
         auto* y_data = Y->template MutableData<std::string>();
         if (classlabels_strings_.size() == 2 &&
@@ -410,103 +416,53 @@ common::Status TreeEnsembleClassifier<T>::Compute(OpKernelContext* context) cons
     }
     // write float values, might not have all the classes in the output yet
     // for example a 10 class case where we only found 2 classes in the leaves
+    out_scores.clear();
     if (weights_classes_.size() == static_cast<size_t>(class_count_)) {
       for (int64_t k = 0; k < class_count_; ++k) {
-        auto it_classes = classes.find(k);
-        if (it_classes != classes.end()) {
-          scores.push_back(it_classes->second);
-        } else {
-          scores.push_back(0.f);
-        }
+        out_scores.push_back(has_score[k] ? scores[k] : 0.f);
       }
     } else {
-      for (auto& classe : classes) {
-        scores.push_back(classe.second);
+      for (int64_t k = 0; k < class_count_; ++k) {
+        if (has_score[k]) {
+          out_scores.push_back(scores[k]);
+        }
       }
     }
-    write_scores(scores, post_transform_, zindex, Z, write_additional_scores);
-    zindex += scores.size();
-  }  // for every batch
-  return Status::OK();
-}
+    write_scores(out_scores, post_transform_, zindex, Z, write_additional_scores);
+    return static_cast<int64_t>(out_scores.size());
+  };
 
-template <typename T>
-common::Status TreeEnsembleClassifier<T>::ProcessTreeNode(std::map<int64_t, float>& classes,
-                                                          int64_t treeindex,
-                                                          const T* x_data,
-                                                          int64_t feature_base) const {
-  // walk down tree to the leaf
-  NODE_MODE mode = static_cast<NODE_MODE>(nodes_modes_[treeindex]);
-  int64_t loopcount = 0;
-  int64_t root = treeindex;
-  while (mode != NODE_MODE::LEAF) {
-    T val = x_data[feature_base + nodes_featureids_[treeindex]];
-    bool tracktrue = true;
-    if (missing_tracks_true_.size() != nodes_truenodeids_.size()) {
-      tracktrue = false;
-    } else {
-      tracktrue = missing_tracks_true_[treeindex] && std::isnan(static_cast<float>(val));
-    }
-    float threshold = nodes_values_[treeindex];
-    switch (mode) {
-      case NODE_MODE::BRANCH_LEQ:
-        treeindex = val <= threshold || tracktrue ? nodes_truenodeids_[treeindex] : nodes_falsenodeids_[treeindex];
-        break;
-      case NODE_MODE::BRANCH_LT:
-        treeindex = val < threshold || tracktrue ? nodes_truenodeids_[treeindex] : nodes_falsenodeids_[treeindex];
-        break;
-      case NODE_MODE::BRANCH_GTE:
-        treeindex = val >= threshold || tracktrue ? nodes_truenodeids_[treeindex] : nodes_falsenodeids_[treeindex];
-        break;
-      case NODE_MODE::BRANCH_GT:
-        treeindex = val > threshold || tracktrue ? nodes_truenodeids_[treeindex] : nodes_falsenodeids_[treeindex];
-        break;
-      case NODE_MODE::BRANCH_EQ:
-        treeindex = val == threshold || tracktrue ? nodes_truenodeids_[treeindex] : nodes_falsenodeids_[treeindex];
-        break;
-      case NODE_MODE::BRANCH_NEQ:
-        treeindex = val != threshold || tracktrue ? nodes_truenodeids_[treeindex] : nodes_falsenodeids_[treeindex];
-        break;
-      default: {
-        std::ostringstream err_msg;
-        err_msg << "Invalid mode of value: " << static_cast<std::underlying_type<NODE_MODE>::type>(mode);
-        return Status(ONNXRUNTIME, INVALID_ARGUMENT, err_msg.str());
-      }
+  // Rows only land at predictable offsets in Z when every class gets a score
+  // and write_scores never appends a complementary one; otherwise each row's
+  // width depends on its scores and the batch has to be written in order.
+  const bool fixed_score_width =
+      weights_classes_.size() == static_cast<size_t>(class_count_) && class_count_ > 2;
+
+  if (!fixed_score_width) {
+    std::vector<float> scores(class_count_);
+    std::vector<char> has_score(class_count_);
+    std::vector<float> out_scores;
+    out_scores.reserve(class_count_);
+    int64_t zindex = 0;
+    for (int64_t i = 0; i < N; ++i) {
+      zindex += process_row(i, zindex, scores, has_score, out_scores);
     }
-    ONNXRUNTIME_ENFORCE(treeindex >= 0);
-    treeindex = treeindex + root;
-    mode = static_cast<NODE_MODE>(nodes_modes_[treeindex]);
-    loopcount++;
-    if (loopcount > kMaxTreeDepth_) break;
-  }
-  // should be at leaf
-  int64_t id = nodes_treeids_[treeindex] * kOffset_ + nodes_nodeids_[treeindex];
-  auto it_lp = leafdata_map_.find(id);
-  if (it_lp == leafdata_map_.end()) {  // if not found, simply return
     return Status::OK();
   }
-  int64_t index = it_lp->second;
-  int64_t treeid = std::get<0>(leafnodedata_[index]);
-  int64_t nodeid = std::get<1>(leafnodedata_[index]);
-  while (treeid == nodes_treeids_[treeindex] && nodeid == nodes_nodeids_[treeindex]) {
-    int64_t classid = std::get<2>(leafnodedata_[index]);
-    float weight = std::get<3>(leafnodedata_[index]);
-    std::map<int64_t, float>::iterator it_classes;
-    it_classes = classes.find(classid);
-    if (it_classes != classes.end()) {
-      it_classes->second += weight;
-    } else {
-      auto p1 = std::make_pair(classid, weight);
-      classes.insert(p1);
-    }
-    ++index;
-    // some tree node will be last
-    if (index >= static_cast<int64_t>(leafnodedata_.size())) {
-      break;
+
+  auto process_rows = [&](int64_t first, int64_t last) {
+    std::vector<float> scores(class_count_);
+    std::vector<char> has_score(class_count_);
+    std::vector<float> out_scores;
+    out_scores.reserve(class_count_);
+    for (int64_t i = first; i < last; ++i) {
+      process_row(i, i * class_count_, scores, has_score, out_scores);
     }
-    treeid = std::get<0>(leafnodedata_[index]);
-    nodeid = std::get<1>(leafnodedata_[index]);
-  }
+  };
+
+  // each row walks every tree
+  ParallelFor(0, N, static_cast<double>(roots.size()), process_rows);
+
   return Status::OK();
 }
 }  // namespace ml
@@ -0,0 +1,171 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include <cmath>
+#include <tuple>
+#include <unordered_map>
+
+#include "core/common/common.h"
+#include "ml_common.h"
+
+namespace onnxruntime {
+namespace ml {
+
+// One flattened tree node. Branch nodes hold absolute indices into the node
+// array; leaf nodes reuse the child fields as the [begin, end) range of their
+// entries in the weight arrays, so leaf payouts need no map lookup.
+struct CompiledTreeNode {
+  float threshold;
+  int32_t feature_id;
+  int32_t true_id;   // leaf: index of its first weight entry
+  int32_t false_id;  // leaf: one past its last weight entry
+  uint8_t mode;      // NODE_MODE
+  uint8_t missing_tracks_true;
+};
+
+// Compact form of a tree ensemble, compiled once at kernel construction so
+// Compute never chases the scattered attribute vectors. The walk for one
+// sample touches only the node array and, at the leaf, the weight arrays.
+class CompiledTreeEnsemble {
+ public:
+  // All vectors follow the normalized layout the tree ensemble kernels build
+  // in their constructors: node ids start at 0 within each tree, child ids are
+  // tree-relative, and 'leaf_data' is (tree id, node id, target id, weight)
+  // sorted by (tree id, node id).
+  void Build(const std::vector<int64_t>& nodes_treeids,
+             const std::vector<int64_t>& nodes_nodeids,
+             const std::vector<int64_t>& nodes_featureids,
+             const std::vector<float>& nodes_values,
+             const std::vector<NODE_MODE>& nodes_modes,
+             const std::vector<int64_t>& nodes_truenodeids,
+             const std::vector<int64_t>& nodes_falsenodeids,
+             const std::vector<int64_t>& missing_tracks_true,
+             const std::vector<int64_t>& root_indices,
+             const std::vector<std::tuple<int64_t, int64_t, int64_t, float>>& leaf_data) {
+    const size_t num_nodes = nodes_nodeids.size();
+    const bool has_missing = missing_tracks_true.size() == nodes_truenodeids.size();
+
+    // map each tree id to the index of its root so tree-relative child ids
+    // can be made absolute
+    std::unordered_map<int64_t, int64_t> tree_roots;
+    roots_.reserve(root_indices.size());
+    for (int64_t root : root_indices) {
+      tree_roots[nodes_treeids[root]] = root;
+      roots_.push_back(static_cast<int32_t>(root));
+    }
+
+    weight_target_ids_.reserve(leaf_data.size());
+    weight_values_.reserve(leaf_data.size());
+    for (const auto& entry : leaf_data) {
+      weight_target_ids_.push_back(static_cast<int32_t>(std::get<2>(entry)));
+      weight_values_.push_back(std::get<3>(entry));
+    }
+
+    // leaf_data is sorted by (tree id, node id), so each leaf's weights form
+    // one contiguous run; record where every run begins and ends
+    std::unordered_map<int64_t, std::pair<int32_t, int32_t>> leaf_ranges;
+    for (size_t i = 0; i < leaf_data.size();) {
+      size_t run_end = i + 1;
+      while (run_end < leaf_data.size() &&
+             std::get<0>(leaf_data[run_end]) == std::get<0>(leaf_data[i]) &&
+             std::get<1>(leaf_data[run_end]) == std::get<1>(leaf_data[i])) {
+        ++run_end;
+      }
+      int64_t id = std::get<0>(leaf_data[i]) * kIdOffset_ + std::get<1>(leaf_data[i]);
+      leaf_ranges[id] = std::make_pair(static_cast<int32_t>(i), static_cast<int32_t>(run_end));
+      i = run_end;
+    }
+
+    nodes_.resize(num_nodes);
+    for (size_t i = 0; i < num_nodes; ++i) {
+      CompiledTreeNode& node = nodes_[i];
+      node.mode = static_cast<uint8_t>(nodes_modes[i]);
+      node.missing_tracks_true = has_missing && missing_tracks_true[i] != 0 ? 1 : 0;
+      node.threshold = nodes_values[i];
+      node.feature_id = static_cast<int32_t>(nodes_featureids[i]);
+
+      if (nodes_modes[i] == NODE_MODE::LEAF) {
+        auto it = leaf_ranges.find(nodes_treeids[i] * kIdOffset_ + nodes_nodeids[i]);
+        if (it != leaf_ranges.end()) {
+          node.true_id = it->second.first;
+          node.false_id = it->second.second;
+        } else {
+          // a leaf with no weights pays out nothing
+          node.true_id = 0;
+          node.false_id = 0;
+        }
+      } else {
+        auto root_it = tree_roots.find(nodes_treeids[i]);
+        ONNXRUNTIME_ENFORCE(root_it != tree_roots.end(), "Node belongs to a tree with no root");
+        const int64_t true_id = root_it->second + nodes_truenodeids[i];
+        const int64_t false_id = root_it->second + nodes_falsenodeids[i];
+        ONNXRUNTIME_ENFORCE(true_id >= 0 && static_cast<size_t>(true_id) < num_nodes,
+                    "true branch target out of range: ", true_id);
+        ONNXRUNTIME_ENFORCE(false_id >= 0 && static_cast<size_t>(false_id) < num_nodes,
+                    "false branch target out of range: ", false_id);
+        node.true_id = static_cast<int32_t>(true_id);
+        node.false_id = static_cast<int32_t>(false_id);
+      }
+    }
+  }
+
+  // Walks one tree for one sample and accumulates its leaf weights into
+  // 'scores', marking every target a leaf touched in 'has_score'.
+  template <typename T>
+  void WalkTree(int32_t root, const T* x, std::vector<float>& scores, std::vector<char>& has_score) const {
+    int32_t index = root;
+    int64_t depth = 0;
+    while (static_cast<NODE_MODE>(nodes_[index].mode) != NODE_MODE::LEAF) {
+      const CompiledTreeNode& node = nodes_[index];
+      const T val = x[node.feature_id];
+      const bool tracktrue = node.missing_tracks_true != 0 && std::isnan(static_cast<float>(val));
+      bool take_true;
+      switch (static_cast<NODE_MODE>(node.mode)) {
+        case NODE_MODE::BRANCH_LEQ:
+          take_true = val <= node.threshold;
+          break;
+        case NODE_MODE::BRANCH_LT:
+          take_true = val < node.threshold;
+          break;
+        case NODE_MODE::BRANCH_GTE:
+          take_true = val >= node.threshold;
+          break;
+        case NODE_MODE::BRANCH_GT:
+          take_true = val > node.threshold;
+          break;
+        case NODE_MODE::BRANCH_EQ:
+          take_true = val == node.threshold;
+          break;
+        default:  // BRANCH_NEQ
+          take_true = val != node.threshold;
+          break;
+      }
+      index = take_true || tracktrue ? node.true_id : node.false_id;
+      // guard against malformed ensembles, mirroring the old depth cap
+      if (++depth > kMaxTreeDepth_)
+        return;
+    }
+
+    const CompiledTreeNode& leaf = nodes_[index];
+    for (int32_t k = leaf.true_id; k < leaf.false_id; ++k) {
+      scores[weight_target_ids_[k]] += weight_values_[k];
+      has_score[weight_target_ids_[k]] = 1;
+    }
+  }
+
+  const std::vector<int32_t>& Roots() const { return roots_; }
+
+ private:
+  std::vector<CompiledTreeNode> nodes_;
+  std::vector<int32_t> roots_;
+  // leaf weight entries, grouped so each leaf's weights are contiguous
+  std::vector<int32_t> weight_target_ids_;
+  std::vector<float> weight_values_;
+
+  static const int64_t kIdOffset_ = 4000000000L;
+  static const int64_t kMaxTreeDepth_ = 1000;
+};
+
+}  // namespace ml
+}  // namespace onnxruntime
@@ -2,6 +2,9 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/ml/treeregressor.h"
+#include "core/common/work_stealing_thread_pool.h"
+
+#include <algorithm>
 
 namespace onnxruntime {
 namespace ml {
@@ -84,20 +87,6 @@ TreeEnsembleRegressor<T>::TreeEnsembleRegressor(const OpKernelInfo& info)
     else
       return std::get<1>(t1) < std::get<1>(t2);
   });
-  //make an index so we can find the leafnode data quickly when evaluating
-  int64_t field0 = -1;
-  int64_t field1 = -1;
-  for (size_t i = 0; i < leafnode_data_.size(); i++) {
-    int64_t id0 = std::get<0>(leafnode_data_[i]);
-    int64_t id1 = std::get<1>(leafnode_data_[i]);
-    if (id0 != field0 || id1 != field1) {
-      int64_t id = id0 * four_billion_ + id1;
-      auto p3 = std::make_pair(id, i);  // position is i
-      leafdata_map_.insert(p3);
-      field0 = id;
-      field1 = static_cast<int64_t>(i);
-    }
-  }
   //treenode ids, some are roots, and roots have no parents
   std::unordered_map<int64_t, size_t> parents;  //holds count of all who point to you
   std::unordered_map<int64_t, size_t> indices;
@@ -144,73 +133,16 @@ TreeEnsembleRegressor<T>::TreeEnsembleRegressor(const OpKernelInfo& info)
     }
   }
   ONNXRUNTIME_ENFORCE(base_values_.empty() || base_values_.size() == static_cast<size_t>(n_targets_));
-}
-
-template <typename T>
-common::Status TreeEnsembleRegressor<T>::ProcessTreeNode(std::unordered_map<int64_t, float>& classes, int64_t treeindex, const T* Xdata, int64_t feature_base) const {
-  //walk down tree to the leaf
-  ::onnxruntime::ml::NODE_MODE mode = static_cast<::onnxruntime::ml::NODE_MODE>(nodes_modes_[treeindex]);
-  int64_t loopcount = 0;
-  int64_t root = treeindex;
-  while (mode != ::onnxruntime::ml::NODE_MODE::LEAF) {
-    T val = Xdata[feature_base + nodes_featureids_[treeindex]];
-    bool tracktrue = true;
-    if (missing_tracks_true_.size() != nodes_truenodeids_.size()) {
-      tracktrue = false;
-    } else {
-      tracktrue = (missing_tracks_true_[treeindex] != 0) && std::isnan(val);
-    }
-    float threshold = nodes_values_[treeindex];
-    if (mode == ::onnxruntime::ml::NODE_MODE::BRANCH_LEQ) {
-      treeindex = val <= threshold || tracktrue ? nodes_truenodeids_[treeindex] : nodes_falsenodeids_[treeindex];
-    } else if (mode == ::onnxruntime::ml::NODE_MODE::BRANCH_LT) {
-      treeindex = val < threshold || tracktrue ? nodes_truenodeids_[treeindex] : nodes_falsenodeids_[treeindex];
-    } else if (mode == ::onnxruntime::ml::NODE_MODE::BRANCH_GTE) {
-      treeindex = val >= threshold || tracktrue ? nodes_truenodeids_[treeindex] : nodes_falsenodeids_[treeindex];
-    } else if (mode == ::onnxruntime::ml::NODE_MODE::BRANCH_GT) {
-      treeindex = val > threshold || tracktrue ? nodes_truenodeids_[treeindex] : nodes_falsenodeids_[treeindex];
-    } else if (mode == ::onnxruntime::ml::NODE_MODE::BRANCH_EQ) {
-      treeindex = val == threshold || tracktrue ? nodes_truenodeids_[treeindex] : nodes_falsenodeids_[treeindex];
-    } else if (mode == ::onnxruntime::ml::NODE_MODE::BRANCH_NEQ) {
-      treeindex = val != threshold || tracktrue ? nodes_truenodeids_[treeindex] : nodes_falsenodeids_[treeindex];
-    }
 
-    if (treeindex < 0) {
-      return common::Status(common::ONNXRUNTIME, common::RUNTIME_EXCEPTION,
-                            "treeindex evaluated to a negative value, which should not happen.");
-    }
-    treeindex = treeindex + root;
-    mode = (::onnxruntime::ml::NODE_MODE)nodes_modes_[treeindex];
-    loopcount++;
-    if (loopcount > max_tree_depth_) break;
+  // the compiled walk accumulates into a dense per-target vector, so every
+  // target id must be a valid index into it
+  for (int64_t target_id : target_ids_) {
+    ONNXRUNTIME_ENFORCE(target_id >= 0 && target_id < n_targets_, "Invalid target id ", target_id);
   }
-  //should be at leaf
-  int64_t id = nodes_treeids_[treeindex] * four_billion_ + nodes_nodeids_[treeindex];
-  //auto it_lp = leafdata_map.find(id);
-  auto it_lp = leafdata_map_.find(id);
-  if (it_lp != leafdata_map_.end()) {
-    size_t index = it_lp->second;
-    int64_t treeid = std::get<0>(leafnode_data_[index]);
-    int64_t nodeid = std::get<1>(leafnode_data_[index]);
-    while (treeid == nodes_treeids_[treeindex] && nodeid == nodes_nodeids_[treeindex]) {
-      int64_t classid = std::get<2>(leafnode_data_[index]);
-      float weight = std::get<3>(leafnode_data_[index]);
-      auto it_classes = classes.find(classid);
-      if (it_classes != classes.end()) {
-        it_classes->second += weight;
-      } else {
-        auto p1 = std::make_pair(classid, weight);
-        classes.insert(p1);
-      }
-      index++;
-      if (index >= leafnode_data_.size()) {
-        break;
-      }
-      treeid = std::get<0>(leafnode_data_[index]);
-      nodeid = std::get<1>(leafnode_data_[index]);
-    }
-  }
-  return common::Status::OK();
+
+  // flatten everything into the compiled form the hot loop walks
+  compiled_.Build(nodes_treeids_, nodes_nodeids_, nodes_featureids_, nodes_values_, nodes_modes_,
+                  nodes_truenodeids_, nodes_falsenodeids_, missing_tracks_true_, roots_, leafnode_data_);
 }
 
 template <typename T>
@@ -226,51 +158,63 @@ common::Status TreeEnsembleRegressor<T>::Compute(OpKernelContext* context) const
   int64_t N = X->Shape().NumDimensions() == 1 ? 1 : X->Shape()[0];
   Tensor* Y = context->Output(0, TensorShape({N, n_targets_}));
 
-  int64_t write_index = 0;
   const auto* x_data = X->template Data<T>();
+  auto* y_data = Y->template MutableData<float>();
+  const auto& roots = compiled_.Roots();
+
+  // Scores each sample in [first, last) through the compiled ensemble; each
+  // sample writes its own rows of Y so ranges can run concurrently.
+  auto process_rows = [this, x_data, y_data, stride, &roots](int64_t first, int64_t last) {
+    std::vector<float> scores(n_targets_);
+    std::vector<char> has_score(n_targets_);
+    std::vector<float> outputs;
+    outputs.reserve(n_targets_);
+
+    for (int64_t i = first; i < last; i++) {
+      std::fill(scores.begin(), scores.end(), 0.f);
+      std::fill(has_score.begin(), has_score.end(), 0);
+      const T* x_row = x_data + i * stride;
 
-  for (int64_t i = 0; i < N; i++)  //for each class
-  {
-    int64_t current_weight_0 = i * stride;
-    std::unordered_map<int64_t, float> scores;
-    //for each tree
-    for (size_t j = 0; j < roots_.size(); j++) {
       //walk each tree from its root
-      ONNXRUNTIME_RETURN_IF_ERROR(ProcessTreeNode(scores, roots_[j], x_data, current_weight_0));
-    }
-    //find aggregate, could use a heap here if there are many classes
-    std::vector<float> outputs;
-    for (int64_t j = 0; j < n_targets_; j++) {
-      //reweight scores based on number of voters
-      auto it_scores = scores.find(j);
-      float val = base_values_.size() == (size_t)n_targets_ ? base_values_[j] : 0.f;
-      if (it_scores != scores.end()) {
-        if (aggregate_function_ == ::onnxruntime::ml::AGGREGATE_FUNCTION::AVERAGE) {
-          val += scores[j] / roots_.size();
-        } else if (aggregate_function_ == ::onnxruntime::ml::AGGREGATE_FUNCTION::SUM) {
-          val += scores[j];
-        } else if (aggregate_function_ == ::onnxruntime::ml::AGGREGATE_FUNCTION::MIN) {
-          if (scores[j] < val) val = scores[j];
-        } else if (aggregate_function_ == ::onnxruntime::ml::AGGREGATE_FUNCTION::MAX) {
-          if (scores[j] > val) val = scores[j];
+      for (int32_t root : roots) {
+        compiled_.WalkTree(root, x_row, scores, has_score);
+      }
+
+      outputs.clear();
+      for (int64_t j = 0; j < n_targets_; j++) {
+        //reweight scores based on number of voters
+        float val = base_values_.size() == (size_t)n_targets_ ? base_values_[j] : 0.f;
+        if (has_score[j]) {
+          if (aggregate_function_ == ::onnxruntime::ml::AGGREGATE_FUNCTION::AVERAGE) {
+            val += scores[j] / roots.size();
+          } else if (aggregate_function_ == ::onnxruntime::ml::AGGREGATE_FUNCTION::SUM) {
+            val += scores[j];
+          } else if (aggregate_function_ == ::onnxruntime::ml::AGGREGATE_FUNCTION::MIN) {
+            if (scores[j] < val) val = scores[j];
+          } else if (aggregate_function_ == ::onnxruntime::ml::AGGREGATE_FUNCTION::MAX) {
+            if (scores[j] > val) val = scores[j];
+          }
         }
+        outputs.push_back(val);
       }
-      outputs.push_back(val);
-    }
-    if (transform_ == ::onnxruntime::ml::POST_EVAL_TRANSFORM::LOGISTIC) {
-      for (float& output : outputs) {
-        output = ::onnxruntime::ml::ml_logit(output);
+      if (transform_ == ::onnxruntime::ml::POST_EVAL_TRANSFORM::LOGISTIC) {
+        for (float& output : outputs) {
+          output = ::onnxruntime::ml::ml_logit(output);
+        }
+      } else if (transform_ == ::onnxruntime::ml::POST_EVAL_TRANSFORM::SOFTMAX) {
+        ::onnxruntime::ml::compute_softmax(outputs);
+      } else if (transform_ == ::onnxruntime::ml::POST_EVAL_TRANSFORM::SOFTMAX_ZERO) {
+        ::onnxruntime::ml::compute_softmax_zero(outputs);
+      }
+      for (int64_t j = 0; j < n_targets_; j++) {
+        y_data[i * n_targets_ + j] = outputs[j];
       }
-    } else if (transform_ == ::onnxruntime::ml::POST_EVAL_TRANSFORM::SOFTMAX) {
-      ::onnxruntime::ml::compute_softmax(outputs);
-    } else if (transform_ == ::onnxruntime::ml::POST_EVAL_TRANSFORM::SOFTMAX_ZERO) {
-      ::onnxruntime::ml::compute_softmax_zero(outputs);
-    }
-    for (float output : outputs) {
-      Y->template MutableData<float>()[write_index] = output;
-      write_index++;
     }
-  }
+  };
+
+  // each row walks every tree
+  ParallelFor(0, N, static_cast<double>(roots.size()), process_rows);
+
   return Status::OK();
 }
 
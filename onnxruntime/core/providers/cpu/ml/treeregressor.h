@@ -5,6 +5,7 @@
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 #include "ml_common.h"
+#include "tree_ensemble_compiled.h"
 
 namespace onnxruntime {
 namespace ml {
@@ -15,8 +16,6 @@ class TreeEnsembleRegressor final : public OpKernel {
   common::Status Compute(OpKernelContext* context) const override;
 
  private:
-  common::Status ProcessTreeNode(std::unordered_map<int64_t, float>& classes, int64_t treeindex, const T* Xdata, int64_t feature_base) const;
-
   std::vector<int64_t> nodes_treeids_;
   std::vector<int64_t> nodes_nodeids_;
   std::vector<int64_t> nodes_featureids_;
@@ -37,11 +36,13 @@ class TreeEnsembleRegressor final : public OpKernel {
   ::onnxruntime::ml::POST_EVAL_TRANSFORM transform_;
   ::onnxruntime::ml::AGGREGATE_FUNCTION aggregate_function_;
   std::vector<std::tuple<int64_t, int64_t, int64_t, float>> leafnode_data_;
-  std::unordered_map<int64_t, size_t> leafdata_map_;
   std::vector<int64_t> roots_;
   int64_t offset_;
   int64_t max_tree_depth_;
   const int64_t four_billion_ = 4000000000L;
+
+  // flattened ensemble the hot loop walks instead of the attribute vectors
+  CompiledTreeEnsemble compiled_;
 };
 }  // namespace ml
 }  // namespace onnxruntime
@@ -17,6 +17,7 @@
 
 #include "core/providers/cpu/nn/batch_norm.h"
 #include "core/providers/cpu/nn/batch_norm_helper.h"
+#include "core/providers/cpu/nn/fused_scale_bias.h"
 
 namespace onnxruntime {
 // spec: https://github.com/onnx/onnx/blob/master/docs/Operators.md#BatchNormalization
@@ -49,29 +50,39 @@ Status BatchNorm<float>::Compute(OpKernelContext* p_op_kernel_context) const {
     sample_size *= dims_vec[i];
   }
 
-  ConstEigenVectorArrayMap<float> scale_arr(scale->template Data<float>(), C);
-  ConstEigenVectorArrayMap<float> bias_arr(B->template Data<float>(), C);
-
   // Regardless of training or testing, we will apply the estimated mean
   // and standard deviation to the input. For testing, they are
   // specified directly by the input, and for training, they are computed
   // by the op.
-  Eigen::Array<float, Eigen::Dynamic, 1> inv_std(C);
-  ConstEigenVectorArrayMap<float> var_arr(var->template Data<float>(), C);
-  inv_std = (var_arr + epsilon_).sqrt().inverse();
-  ConstEigenVectorArrayMap<float> mean_arr(mean->template Data<float>(), C);
+  //
   // We can fuse the output computation as follows:
   //   ((x - est_mean) * (inv_var) * scale + bias
   // to
   //   (x * inv_var * scale) + (bias - est_mean * inv_var * scale)
-  Eigen::Array<float, Eigen::Dynamic, 1> new_scale = inv_std * scale_arr;
-  Eigen::Array<float, Eigen::Dynamic, 1> new_bias = bias_arr - mean_arr * new_scale;
-  EigenArrayMap<float> Y_arr(Y->template MutableData<float>(), sample_size, N * C);
-  ConstEigenArrayMap<float> X_arr(X->template Data<float>(), sample_size, N * C);
-  for (size_t nc = 0; nc < N * C; ++nc) {
-    Y_arr.col(nc) = X_arr.col(nc) * new_scale(nc % C) + new_bias(nc % C);
+  // When all four parameters are constant initializers the fold was already
+  // done at construction; otherwise redo it from this call's inputs.
+  const float* multiplier;
+  const float* addend;
+  Eigen::Array<float, Eigen::Dynamic, 1> new_scale;
+  Eigen::Array<float, Eigen::Dynamic, 1> new_bias;
+  if (folded_multiplier_.size() == C) {
+    multiplier = folded_multiplier_.data();
+    addend = folded_addend_.data();
+  } else {
+    ConstEigenVectorArrayMap<float> scale_arr(scale->template Data<float>(), C);
+    ConstEigenVectorArrayMap<float> bias_arr(B->template Data<float>(), C);
+    ConstEigenVectorArrayMap<float> var_arr(var->template Data<float>(), C);
+    ConstEigenVectorArrayMap<float> mean_arr(mean->template Data<float>(), C);
+    Eigen::Array<float, Eigen::Dynamic, 1> inv_std = (var_arr + epsilon_).sqrt().inverse();
+    new_scale = inv_std * scale_arr;
+    new_bias = bias_arr - mean_arr * new_scale;
+    multiplier = new_scale.data();
+    addend = new_bias.data();
   }
 
+  ApplyFusedScaleBias(p_op_kernel_context, X->template Data<float>(), Y->template MutableData<float>(),
+                      N * C, sample_size, C, multiplier, addend);
+
   return Status::OK();
 }
 }  // namespace onnxruntime
@@ -17,6 +17,9 @@
 
 #pragma once
 
+#include <cmath>
+#include <vector>
+
 #include "core/common/common.h"
 #include "core/common/exceptions.h"
 #include "core/framework/op_kernel.h"
@@ -34,6 +37,37 @@ class BatchNorm final : public OpKernel {
     if (op_kernel_info.GetAttr<float>("epsilon", &tmp_eplison).IsOK()) {
       epsilon_ = tmp_eplison;
     }
+
+    // For inference graphs scale/B/mean/var are almost always constant
+    // initializers, so fold them once here into the per-channel
+    // multiplier/addend of
+    //   y = x * multiplier + addend
+    // instead of redoing the fold on every call.
+    const Tensor* scale;
+    const Tensor* B;
+    const Tensor* mean;
+    const Tensor* var;
+    if (std::is_same<T, float>::value &&
+        op_kernel_info.TryGetConstantInput(1, &scale) &&
+        op_kernel_info.TryGetConstantInput(2, &B) &&
+        op_kernel_info.TryGetConstantInput(3, &mean) &&
+        op_kernel_info.TryGetConstantInput(4, &var) &&
+        scale->Shape().NumDimensions() == 1 &&
+        B->Shape() == scale->Shape() &&
+        mean->Shape() == scale->Shape() &&
+        var->Shape() == scale->Shape()) {
+      const int64_t C = scale->Shape()[0];
+      const float* scale_data = scale->template Data<float>();
+      const float* b_data = B->template Data<float>();
+      const float* mean_data = mean->template Data<float>();
+      const float* var_data = var->template Data<float>();
+      folded_multiplier_.resize(C);
+      folded_addend_.resize(C);
+      for (int64_t c = 0; c < C; ++c) {
+        folded_multiplier_[c] = scale_data[c] / std::sqrt(var_data[c] + epsilon_);
+        folded_addend_[c] = b_data[c] - mean_data[c] * folded_multiplier_[c];
+      }
+    }
   }
 
   Status Compute(OpKernelContext* p_op_kernel_context) const override;
@@ -41,5 +75,10 @@ class BatchNorm final : public OpKernel {
  private:
   float epsilon_ = 1e-5f;
   int64_t is_test_;  // ignored in this implementation since we're doing inferencing only.
+
+  // Per-channel fold of scale/B/mean/var, built at construction when all four
+  // are constant initializers; empty otherwise.
+  std::vector<float> folded_multiplier_;
+  std::vector<float> folded_addend_;
 };
 }  // namespace onnxruntime
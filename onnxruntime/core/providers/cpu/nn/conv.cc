@@ -14,42 +14,106 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
   const int64_t N = X->Shape()[0];
   const int64_t C = X->Shape()[1];
   const int64_t M = W->Shape()[0];
-  ONNXRUNTIME_RETURN_IF_ERROR(ValidateInputShape(X, W));
 
-  std::vector<int64_t> kernel_shape = ComputeKernelShape(W->Shape());
+  // everything derived from the input shapes — attribute validation, output
+  // shape inference and the prepared MLAS plan — is a pure function of the
+  // shapes, so reuse the plan built by a previous run with these shapes and
+  // jump straight to the compute path.
+  struct ConvPlan {
+    std::vector<int64_t> kernel_shape;
+    std::vector<int64_t> pads;
+    std::vector<int64_t> dilations;
+    std::vector<int64_t> strides;
+    std::vector<int64_t> Y_dims;
+    MLAS_CONV_PARAMETERS mlas_parameters;
+    size_t working_buffer_size = 0;
+    bool use_mlas = false;
+    bool is_pointwise = false;
+  };
 
-  if (kernel_shape.size() + 2 != W->Shape().NumDimensions()) {
-    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, "kernel_shape num_dims is not compatible with W num_dims.",
-                                   " kernel_shape: ", TensorShape(kernel_shape).ToString().c_str(),
-                                   " W: ", W->Shape().ToString().c_str());
-  }
+  std::shared_ptr<ConvPlan> plan;
+  std::shared_ptr<void> cached_plan = context->TryGetShapeState();
+  if (cached_plan) {
+    plan = std::static_pointer_cast<ConvPlan>(cached_plan);
+  } else {
+    ONNXRUNTIME_RETURN_IF_ERROR(ValidateInputShape(X, W));
+
+    plan = std::make_shared<ConvPlan>();
+    plan->kernel_shape = ComputeKernelShape(W->Shape());
+    std::vector<int64_t>& kernel_shape = plan->kernel_shape;
 
-  for (size_t i = 0; i < kernel_shape.size(); ++i) {
-    if (kernel_shape[i] != W->Shape()[i + 2]) {
-      return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, "kernel_shape is not compatible with W shape.",
+    if (kernel_shape.size() + 2 != W->Shape().NumDimensions()) {
+      return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, "kernel_shape num_dims is not compatible with W num_dims.",
                                      " kernel_shape: ", TensorShape(kernel_shape).ToString().c_str(),
                                      " W: ", W->Shape().ToString().c_str());
     }
-  }
 
-  std::vector<int64_t> pads(pads_);
-  if (pads.empty()) {
-    pads.resize(kernel_shape.size() * 2, 0);
-  }
-  std::vector<int64_t> dilations(dilations_);
-  if (dilations.empty()) {
-    dilations.resize(kernel_shape.size(), 1);
-  }
-  std::vector<int64_t> strides(strides_);
-  if (strides.empty()) {
-    strides.resize(kernel_shape.size(), 1);
+    for (size_t i = 0; i < kernel_shape.size(); ++i) {
+      if (kernel_shape[i] != W->Shape()[i + 2]) {
+        return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, "kernel_shape is not compatible with W shape.",
+                                       " kernel_shape: ", TensorShape(kernel_shape).ToString().c_str(),
+                                       " W: ", W->Shape().ToString().c_str());
+      }
+    }
+
+    plan->pads = pads_;
+    if (plan->pads.empty()) {
+      plan->pads.resize(kernel_shape.size() * 2, 0);
+    }
+    plan->dilations = dilations_;
+    if (plan->dilations.empty()) {
+      plan->dilations.resize(kernel_shape.size(), 1);
+    }
+    plan->strides = strides_;
+    if (plan->strides.empty()) {
+      plan->strides.resize(kernel_shape.size(), 1);
+    }
+
+    plan->Y_dims.insert(plan->Y_dims.begin(), {N, M});
+    TensorShape inferred_input_shape = X->Shape().Slice(2);
+    ONNXRUNTIME_RETURN_IF_ERROR(InferOutputShape(inferred_input_shape, kernel_shape, plan->strides,
+                                                 plan->dilations, &plan->pads, &plan->Y_dims));
+
+    const size_t rank = kernel_shape.size();
+    plan->use_mlas = rank == 2 || rank == 3;
+    if (plan->use_mlas) {
+      TensorShape inferred_output_shape = TensorShape(plan->Y_dims).Slice(2);
+      MlasConvPrepare(&plan->mlas_parameters,
+                      rank,
+                      static_cast<size_t>(N),
+                      static_cast<size_t>(group_),
+                      static_cast<size_t>(C / group_),
+                      inferred_input_shape.GetDims().data(),
+                      kernel_shape.data(),
+                      plan->dilations.data(),
+                      plan->pads.data(),
+                      plan->strides.data(),
+                      inferred_output_shape.GetDims().data(),
+                      static_cast<size_t>(M / group_),
+                      &plan->working_buffer_size);
+    } else {
+      // a 1x1 kernel with unit stride and dilation and no padding makes
+      // im2col an identity copy of the input block, so the gemm reads X
+      // directly and the col buffer is never allocated.
+      bool is_pointwise = TensorShape(kernel_shape).Size() == 1;
+      for (size_t dim = 0; dim < rank && is_pointwise; ++dim) {
+        is_pointwise = plan->strides[dim] == 1 && plan->dilations[dim] == 1 &&
+                       plan->pads[dim] == 0 && plan->pads[dim + rank] == 0;
+      }
+      plan->is_pointwise = is_pointwise;
+    }
+
+    if (context->IsRecordingShapeState())
+      context->SetShapeState(plan);
   }
 
-  std::vector<int64_t> Y_dims;
-  Y_dims.insert(Y_dims.begin(), {N, M});
+  const std::vector<int64_t>& kernel_shape = plan->kernel_shape;
+  const std::vector<int64_t>& pads = plan->pads;
+  const std::vector<int64_t>& dilations = plan->dilations;
+  const std::vector<int64_t>& strides = plan->strides;
+
   TensorShape input_shape = X->Shape().Slice(2);
-  ONNXRUNTIME_RETURN_IF_ERROR(InferOutputShape(input_shape, kernel_shape, strides, dilations, &pads, &Y_dims));
-  Tensor* Y = context->Output(0, TensorShape(Y_dims));
+  Tensor* Y = context->Output(0, TensorShape(plan->Y_dims));
   TensorShape output_shape = Y->Shape().Slice(2);
 
   AllocatorPtr alloc;
@@ -58,33 +122,24 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
   const float* Xdata = X->template Data<float>();
   float* Ydata = Y->template MutableData<float>();
 
-  const size_t kernel_rank = kernel_shape.size();
-
-  if (kernel_rank == 2 || kernel_rank == 3) {
-    MLAS_CONV_PARAMETERS Parameters;
-    size_t WorkingBufferSize;
-    MlasConvPrepare(&Parameters,
-                    kernel_rank,
-                    static_cast<size_t>(N),
-                    static_cast<size_t>(group_),
-                    static_cast<size_t>(C / group_),
-                    input_shape.GetDims().data(),
-                    kernel_shape.data(),
-                    dilations.data(),
-                    pads.data(),
-                    strides.data(),
-                    output_shape.GetDims().data(),
-                    static_cast<size_t>(M / group_),
-                    &WorkingBufferSize);
-
-    auto working_data = WorkingBufferSize > 0 ? alloc->Alloc(sizeof(float) * WorkingBufferSize) : nullptr;
-    BufferUniquePtr working_buffer(working_data, BufferDeleter(alloc));
-
-    MlasConv(&Parameters,
+  if (plan->use_mlas) {
+    // borrow the MLAS working buffer from the per-run scratch arena when one
+    // is active, falling back to a direct allocation otherwise
+    BufferUniquePtr working_buffer;
+    void* working_data = nullptr;
+    if (plan->working_buffer_size > 0) {
+      working_data = context->GetScratchBuffer(sizeof(float) * plan->working_buffer_size);
+      if (working_data == nullptr) {
+        working_buffer = BufferUniquePtr(alloc->Alloc(sizeof(float) * plan->working_buffer_size), BufferDeleter(alloc));
+        working_data = working_buffer.get();
+      }
+    }
+
+    MlasConv(&plan->mlas_parameters,
              Xdata,
              W->template Data<float>(),
              B != nullptr ? B->template Data<float>() : nullptr,
-             static_cast<float*>(working_buffer.get()),
+             static_cast<float*>(working_data),
              Ydata);
 
     //TODO: this will be replaced with Tracy's changes.
@@ -100,55 +155,156 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
     const int64_t kernel_dim = C / group_ * kernel_size;
     const int64_t col_buffer_size = kernel_dim * output_image_size;
 
-    auto col_data = alloc->Alloc(sizeof(float) * col_buffer_size);
-    BufferUniquePtr col_buffer(col_data, BufferDeleter(alloc));
-    float* col_buffer_data = static_cast<float*>(col_buffer.get());
-
     TensorShape image_shape = X->Shape().Slice(1);
     std::vector<int64_t> col_buffer_shape{kernel_dim};
     col_buffer_shape.insert(col_buffer_shape.end(), output_shape.GetDims().begin(),
                             output_shape.GetDims().end());
 
-    for (int image_id = 0; image_id < N; ++image_id) {
-      for (int group_id = 0; group_id < group_; ++group_id) {
-        math::Im2colNd<float, CPUMathUtil, StorageOrder::NCHW>(
-            Xdata + group_id * X_offset,
-            image_shape.GetDims().data(),
-            col_buffer_shape.data(),
-            C * input_image_size,
-            col_buffer_size,
-            kernel_shape.data(),
-            strides.data(),
-            dilations.data(),
-            pads.data(),
-            static_cast<int>(kernel_shape.size()),
-            col_buffer_data,
-            &CPUMathUtil::Instance());
-        math::Gemm<float, CPUMathUtil>(
+    const bool is_pointwise = plan->is_pointwise;
+
+    // the weight pointers do not vary per image, so build them once for the
+    // batched gemm over the groups.
+    std::vector<const float*> w_ptrs(group_);
+    for (int group_id = 0; group_id < group_; ++group_id) {
+      w_ptrs[group_id] = W->template Data<float>() + group_id * W_offset;
+    }
+
+    auto compute_image_range = [&](int64_t first, int64_t last, float* col_buffer_data) {
+      const float* Xdata_image = Xdata + first * X_offset * group_;
+      float* Ydata_image = Ydata + first * Y_offset * group_;
+
+      if (is_pointwise) {
+        // every [C/group, image] block of X feeds the gemm in place, so the
+        // whole image range collapses into one batched gemm call.
+        const int64_t image_count = last - first;
+        const int64_t batch = image_count * group_;
+        std::vector<const float*> w_batch(batch);
+        std::vector<const float*> x_batch(batch);
+        std::vector<float*> y_batch(batch);
+        for (int64_t image_id = 0; image_id < image_count; ++image_id) {
+          for (int group_id = 0; group_id < group_; ++group_id) {
+            const int64_t idx = image_id * group_ + group_id;
+            w_batch[idx] = w_ptrs[group_id];
+            x_batch[idx] = Xdata_image + image_id * X_offset * group_ + group_id * X_offset;
+            y_batch[idx] = Ydata_image + image_id * Y_offset * group_ + group_id * Y_offset;
+          }
+        }
+
+        math::GemmBatch<float, CPUMathUtil>(
             CblasNoTrans,
             CblasNoTrans,
             M / group_,
             output_image_size,
             kernel_dim,
             1,
-            W->template Data<float>() + group_id * W_offset,
-            col_buffer_data,
+            w_batch.data(),
+            x_batch.data(),
             0,
-            Ydata + group_id * Y_offset,
+            y_batch.data(),
+            batch,
             &CPUMathUtil::Instance());
+
+        for (int64_t image_id = 0; image_id < image_count; ++image_id) {
+          if (B != nullptr) {
+            auto Ymatrix = EigenMatrixMap<float>(Ydata_image, output_image_size, M);
+            auto Bvec = ConstEigenVectorMap<float>(B->template Data<float>(), M);
+            Ymatrix.rowwise() += Bvec.transpose();
+          }
+          fuse_activation(activation_, Ydata_image, Y_offset * group_, alpha_);
+          Ydata_image += Y_offset * group_;
+        }
+        return;
       }
 
-      if (B != nullptr) {
-        auto Ymatrix = EigenMatrixMap<float>(Ydata, output_image_size, M);
-        auto Bvec = ConstEigenVectorMap<float>(B->template Data<float>(), M);
-        Ymatrix.rowwise() += Bvec.transpose();
+      std::vector<const float*> col_ptrs(group_);
+      std::vector<float*> y_ptrs(group_);
+      for (int group_id = 0; group_id < group_; ++group_id) {
+        col_ptrs[group_id] = col_buffer_data + group_id * col_buffer_size;
       }
 
-      fuse_activation(activation_, Ydata, Y_offset * group_, alpha_);
+      for (int64_t image_id = first; image_id < last; ++image_id) {
+        for (int group_id = 0; group_id < group_; ++group_id) {
+          math::Im2colNd<float, CPUMathUtil, StorageOrder::NCHW>(
+              Xdata_image + group_id * X_offset,
+              image_shape.GetDims().data(),
+              col_buffer_shape.data(),
+              C * input_image_size,
+              col_buffer_size,
+              kernel_shape.data(),
+              strides.data(),
+              dilations.data(),
+              pads.data(),
+              static_cast<int>(kernel_shape.size()),
+              col_buffer_data + group_id * col_buffer_size,
+              &CPUMathUtil::Instance());
+          y_ptrs[group_id] = Ydata_image + group_id * Y_offset;
+        }
 
-      Xdata += X_offset * group_;
-      Ydata += Y_offset * group_;
+        // one batched gemm across the groups instead of a serial call each
+        math::GemmBatch<float, CPUMathUtil>(
+            CblasNoTrans,
+            CblasNoTrans,
+            M / group_,
+            output_image_size,
+            kernel_dim,
+            1,
+            w_ptrs.data(),
+            col_ptrs.data(),
+            0,
+            y_ptrs.data(),
+            group_,
+            &CPUMathUtil::Instance());
+
+        if (B != nullptr) {
+          auto Ymatrix = EigenMatrixMap<float>(Ydata_image, output_image_size, M);
+          auto Bvec = ConstEigenVectorMap<float>(B->template Data<float>(), M);
+          Ymatrix.rowwise() += Bvec.transpose();
+        }
+
+        fuse_activation(activation_, Ydata_image, Y_offset * group_, alpha_);
+
+        Xdata_image += X_offset * group_;
+        Ydata_image += Y_offset * group_;
+      }
+    };
+
+    // one scratch col buffer per group per shard so the workers never share an
+    // im2col buffer and the groups of one image can be multiplied as a batch;
+    // the block is borrowed from the per-run scratch arena when one is active.
+    // the pointwise path never materializes columns, so it allocates nothing.
+    // ParallelFor never creates more shards than pool lanes plus the caller,
+    // which bounds the number of buffers; each shard claims its own slot.
+    const int64_t max_shards =
+        std::min(N, static_cast<int64_t>(WorkStealingThreadPool::DefaultPool().NumThreads()) + 1);
+    BufferUniquePtr col_buffers_fallback;
+    float* col_buffers_data = nullptr;
+    if (!is_pointwise) {
+      const size_t col_buffers_bytes = sizeof(float) * col_buffer_size * group_ * max_shards;
+      col_buffers_data = static_cast<float*>(context->GetScratchBuffer(col_buffers_bytes));
+      if (col_buffers_data == nullptr) {
+        col_buffers_fallback = BufferUniquePtr(alloc->Alloc(col_buffers_bytes), BufferDeleter(alloc));
+        col_buffers_data = static_cast<float*>(col_buffers_fallback.get());
+      }
     }
+
+    // per-image cost is dominated by the [M/group, kernel_dim] x [kernel_dim,
+    // output_image_size] gemm over the groups. those gemms run single
+    // threaded inside the shards (MLAS drops to one thread within a pool
+    // batch rather than re-entering the occupied pool), so sharding over
+    // images is the only level of parallelism here
+    const double cost_per_image =
+        static_cast<double>(M) * static_cast<double>(kernel_dim) * static_cast<double>(output_image_size);
+
+    std::atomic<int64_t> next_buffer_slot{0};
+    context->ParallelFor(0, N, cost_per_image,
+                         [&](int64_t first, int64_t last) {
+                           float* col_buffer_data = nullptr;
+                           if (!is_pointwise) {
+                             const int64_t slot = next_buffer_slot.fetch_add(1);
+                             col_buffer_data = col_buffers_data + slot * col_buffer_size * group_;
+                           }
+                           compute_image_range(first, last, col_buffer_data);
+                         });
   }
 
   return Status::OK();
@@ -157,6 +313,6 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
 ONNX_CPU_OPERATOR_KERNEL(
     Conv,
     1,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()).FullyOverwritesOutputs(),
     Conv<float>);
 }  // namespace onnxruntime
@@ -17,30 +17,16 @@
 
 #pragma once
 
+#include <atomic>
+
+#include "core/common/work_stealing_thread_pool.h"
+#include "core/providers/cpu/fuse_activation.h"
 #include "core/providers/cpu/nn/conv.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 #include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
-template <typename T>
-void fuse_activation(const std::string& activation, T* y_data, size_t size, float alpha) {
-  EigenVectorArrayMap<T> y_vec(y_data, size);
-  if (activation.empty()) {
-    return;
-  } else if (activation == "Relu") {
-    y_vec = y_vec.cwiseMax(0);
-  } else if (activation == "Sigmoid") {
-    y_vec = (y_vec >= 0).select(1 / (1. + (-y_vec.abs()).exp()), 1 - 1 / (1. + (-y_vec.abs()).exp()));
-  } else if (activation == "Tanh") {
-    y_vec = y_vec.tanh();
-  } else if (activation == "LeakyRelu") {
-    y_vec = (y_vec >= 0).select(y_vec, (T)alpha * y_vec);
-  } else {
-    ONNXRUNTIME_NOT_IMPLEMENTED("Not implemented fused activation: ", activation);
-  }
-}
-
 template <typename T>
 Status Conv<T>::Compute(OpKernelContext* context) const {
   size_t num_inputs = OpKernel::Node().InputDefs().size();
@@ -51,43 +37,72 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
   const int64_t N = X->Shape()[0];
   const int64_t C = X->Shape()[1];
   const int64_t M = W->Shape()[0];
-  ONNXRUNTIME_RETURN_IF_ERROR(ValidateInputShape(X, W));
 
-  std::vector<int64_t> kernel_shape = ComputeKernelShape(W->Shape());
+  // the im2col geometry is a pure function of the input shapes and the conv
+  // attributes, so reuse the one derived by a previous run with these shapes.
+  struct ConvGeometry {
+    std::vector<int64_t> kernel_shape;
+    std::vector<int64_t> pads;
+    std::vector<int64_t> dilations;
+    std::vector<int64_t> strides;
+    std::vector<int64_t> Y_dims;
+  };
+
+  std::shared_ptr<ConvGeometry> geometry;
+  std::shared_ptr<void> cached_geometry = context->TryGetShapeState();
+  if (cached_geometry) {
+    geometry = std::static_pointer_cast<ConvGeometry>(cached_geometry);
+  } else {
+    ONNXRUNTIME_RETURN_IF_ERROR(ValidateInputShape(X, W));
 
-  if (kernel_shape.size() + 2 != W->Shape().NumDimensions()) {
-    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, "kernel_shape num_dims is not compatible with W num_dims.",
-                                   " kernel_shape: ", TensorShape(kernel_shape).ToString().c_str(),
-                                   " W: ", W->Shape().ToString().c_str());
-  }
+    geometry = std::make_shared<ConvGeometry>();
+    geometry->kernel_shape = ComputeKernelShape(W->Shape());
+    std::vector<int64_t>& kernel_shape = geometry->kernel_shape;
 
-  for (size_t i = 0; i < kernel_shape.size(); ++i) {
-    if (kernel_shape[i] != W->Shape()[i + 2]) {
-      return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, "kernel_shape is not compatible with W shape.",
+    if (kernel_shape.size() + 2 != W->Shape().NumDimensions()) {
+      return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, "kernel_shape num_dims is not compatible with W num_dims.",
                                      " kernel_shape: ", TensorShape(kernel_shape).ToString().c_str(),
                                      " W: ", W->Shape().ToString().c_str());
     }
+
+    for (size_t i = 0; i < kernel_shape.size(); ++i) {
+      if (kernel_shape[i] != W->Shape()[i + 2]) {
+        return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, "kernel_shape is not compatible with W shape.",
+                                       " kernel_shape: ", TensorShape(kernel_shape).ToString().c_str(),
+                                       " W: ", W->Shape().ToString().c_str());
+      }
+    }
+
+    geometry->pads = pads_;
+    if (geometry->pads.empty()) {
+      geometry->pads.resize(kernel_shape.size() * 2, 0);
+    }
+    geometry->dilations = dilations_;
+    if (geometry->dilations.empty()) {
+      geometry->dilations.resize(kernel_shape.size(), 1);
+    }
+    geometry->strides = strides_;
+    if (geometry->strides.empty()) {
+      geometry->strides.resize(kernel_shape.size(), 1);
+    }
+
+    geometry->Y_dims.insert(geometry->Y_dims.begin(), {N, M});
+    TensorShape inferred_input_shape = X->Shape().Slice(2);
+    ONNXRUNTIME_RETURN_IF_ERROR(InferOutputShape(inferred_input_shape, kernel_shape, geometry->strides,
+                                                 geometry->dilations, &geometry->pads, &geometry->Y_dims));
+
+    if (context->IsRecordingShapeState())
+      context->SetShapeState(geometry);
   }
 
+  const std::vector<int64_t>& kernel_shape = geometry->kernel_shape;
+  const std::vector<int64_t>& pads = geometry->pads;
+  const std::vector<int64_t>& dilations = geometry->dilations;
+  const std::vector<int64_t>& strides = geometry->strides;
   bool Is2DKernel = kernel_shape.size() == 2;
-  std::vector<int64_t> pads(pads_);
-  if (pads.empty()) {
-    pads.resize(kernel_shape.size() * 2, 0);
-  }
-  std::vector<int64_t> dilations(dilations_);
-  if (dilations.empty()) {
-    dilations.resize(kernel_shape.size(), 1);
-  }
-  std::vector<int64_t> strides(strides_);
-  if (strides.empty()) {
-    strides.resize(kernel_shape.size(), 1);
-  }
 
-  std::vector<int64_t> Y_dims;
-  Y_dims.insert(Y_dims.begin(), {N, M});
   TensorShape input_shape = X->Shape().Slice(2);
-  ONNXRUNTIME_RETURN_IF_ERROR(InferOutputShape(input_shape, kernel_shape, strides, dilations, &pads, &Y_dims));
-  Tensor* Y = context->Output(0, TensorShape(Y_dims));
+  Tensor* Y = context->Output(0, TensorShape(geometry->Y_dims));
   TensorShape output_shape = Y->Shape().Slice(2);
 
   const int64_t input_image_size = input_shape.Size();
@@ -102,78 +117,123 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
   AllocatorPtr alloc;
   ONNXRUNTIME_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
 
-  auto col_data = alloc->Alloc(sizeof(T) * col_buffer_size);
-  BufferUniquePtr col_buffer(col_data, BufferDeleter(alloc));
-  T* col_buffer_data = static_cast<T*>(col_buffer.get());
-
-  const T* Xdata = X->template Data<T>();
-  T* Ydata = Y->template MutableData<T>();
-
   TensorShape image_shape = X->Shape().Slice(1);
   std::vector<int64_t> col_buffer_shape{kernel_dim};
   col_buffer_shape.insert(col_buffer_shape.end(), output_shape.GetDims().begin(),
                           output_shape.GetDims().end());
 
-  for (int image_id = 0; image_id < N; ++image_id) {
-    for (int group_id = 0; group_id < group_; ++group_id) {
-      if (Is2DKernel) {
-        math::Im2col<T, CPUMathUtil, StorageOrder::NCHW>(
-            Xdata + group_id * X_offset,
-            C / group_,
-            input_shape[0],
-            input_shape[1],
-            kernel_shape[0],
-            kernel_shape[1],
-            dilations[0],
-            dilations[1],
-            pads[0],
-            pads[1],
-            pads[2],
-            pads[3],
-            strides[0],
-            strides[1],
-            col_buffer_data,
-            &CPUMathUtil::Instance());
-      } else {
-        math::Im2colNd<T, CPUMathUtil, StorageOrder::NCHW>(
-            Xdata + group_id * X_offset,
-            image_shape.GetDims().data(),
-            col_buffer_shape.data(),
-            C * input_image_size,
-            col_buffer_size,
-            kernel_shape.data(),
-            strides.data(),
-            dilations.data(),
-            pads.data(),
-            static_cast<int>(kernel_shape.size()),
-            col_buffer_data,
+  // a 1x1 kernel with unit stride and dilation and no padding makes im2col
+  // an identity copy of the input block, so the gemm reads X directly and
+  // the col buffer is never allocated.
+  bool is_pointwise = kernel_size == 1;
+  for (size_t dim = 0; dim < kernel_shape.size() && is_pointwise; ++dim) {
+    is_pointwise = strides[dim] == 1 && dilations[dim] == 1 &&
+                   pads[dim] == 0 && pads[dim + kernel_shape.size()] == 0;
+  }
+
+  auto compute_image_range = [&](int64_t first, int64_t last, T* col_buffer_data) {
+    const T* Xdata = X->template Data<T>() + first * X_offset * group_;
+    T* Ydata = Y->template MutableData<T>() + first * Y_offset * group_;
+
+    for (int64_t image_id = first; image_id < last; ++image_id) {
+      for (int group_id = 0; group_id < group_; ++group_id) {
+        const T* gemm_input = is_pointwise ? Xdata + group_id * X_offset : col_buffer_data;
+        if (is_pointwise) {
+          // im2col is an identity copy here; the gemm reads the
+          // [C/group, image] block of X directly.
+        } else if (Is2DKernel) {
+          math::Im2col<T, CPUMathUtil, StorageOrder::NCHW>(
+              Xdata + group_id * X_offset,
+              C / group_,
+              input_shape[0],
+              input_shape[1],
+              kernel_shape[0],
+              kernel_shape[1],
+              dilations[0],
+              dilations[1],
+              pads[0],
+              pads[1],
+              pads[2],
+              pads[3],
+              strides[0],
+              strides[1],
+              col_buffer_data,
+              &CPUMathUtil::Instance());
+        } else {
+          math::Im2colNd<T, CPUMathUtil, StorageOrder::NCHW>(
+              Xdata + group_id * X_offset,
+              image_shape.GetDims().data(),
+              col_buffer_shape.data(),
+              C * input_image_size,
+              col_buffer_size,
+              kernel_shape.data(),
+              strides.data(),
+              dilations.data(),
+              pads.data(),
+              static_cast<int>(kernel_shape.size()),
+              col_buffer_data,
+              &CPUMathUtil::Instance());
+        }
+        math::Gemm<T, CPUMathUtil>(
+            CblasNoTrans,
+            CblasNoTrans,
+            M / group_,
+            output_image_size,
+            kernel_dim,
+            1,
+            W->template Data<T>() + group_id * W_offset,
+            gemm_input,
+            0,
+            Ydata + group_id * Y_offset,
             &CPUMathUtil::Instance());
       }
-      math::Gemm<T, CPUMathUtil>(
-          CblasNoTrans,
-          CblasNoTrans,
-          M / group_,
-          output_image_size,
-          kernel_dim,
-          1,
-          W->template Data<T>() + group_id * W_offset,
-          col_buffer_data,
-          0,
-          Ydata + group_id * Y_offset,
-          &CPUMathUtil::Instance());
-    }
 
-    if (B != nullptr) {
-      auto Ymatrix = EigenMatrixMap<T>(Ydata, output_image_size, M);
-      auto Bvec = ConstEigenVectorMap<T>(B->template Data<T>(), M);
-      Ymatrix.rowwise() += Bvec.transpose();
-    }
-    fuse_activation(activation_, Ydata, Y_offset * group_, alpha_);
+      if (B != nullptr) {
+        auto Ymatrix = EigenMatrixMap<T>(Ydata, output_image_size, M);
+        auto Bvec = ConstEigenVectorMap<T>(B->template Data<T>(), M);
+        Ymatrix.rowwise() += Bvec.transpose();
+      }
+      fuse_activation(activation_, Ydata, Y_offset * group_, alpha_);
 
-    Xdata += X_offset * group_;
-    Ydata += Y_offset * group_;
+      Xdata += X_offset * group_;
+      Ydata += Y_offset * group_;
+    }
+  };
+
+  // one scratch col buffer per shard so the workers never share an im2col
+  // buffer; the block is borrowed from the per-run scratch arena when one is
+  // active. the pointwise path never materializes columns, so it allocates
+  // nothing. ParallelFor never creates more shards than pool lanes plus the
+  // caller, which bounds the number of buffers; each shard claims its own
+  // slot.
+  const int64_t max_shards =
+      std::min(N, static_cast<int64_t>(WorkStealingThreadPool::DefaultPool().NumThreads()) + 1);
+  BufferUniquePtr col_buffers_fallback;
+  T* col_buffers_data = nullptr;
+  if (!is_pointwise) {
+    const size_t col_buffers_bytes = sizeof(T) * col_buffer_size * max_shards;
+    col_buffers_data = static_cast<T*>(context->GetScratchBuffer(col_buffers_bytes));
+    if (col_buffers_data == nullptr) {
+      col_buffers_fallback = BufferUniquePtr(alloc->Alloc(col_buffers_bytes), BufferDeleter(alloc));
+      col_buffers_data = static_cast<T*>(col_buffers_fallback.get());
+    }
   }
 
+  // per-image cost is dominated by the group gemms
+  const double cost_per_image =
+      static_cast<double>(M) * static_cast<double>(kernel_dim) * static_cast<double>(output_image_size);
+
+  std::atomic<int64_t> next_buffer_slot{0};
+  context->ParallelFor(0, N, cost_per_image,
+                       [&](int64_t first, int64_t last) {
+                         T* col_buffer_data = nullptr;
+                         if (!is_pointwise) {
+                           const int64_t slot = next_buffer_slot.fetch_add(1);
+                           col_buffer_data = col_buffers_data + slot * col_buffer_size;
+                         }
+                         compute_image_range(first, last, col_buffer_data);
+                       });
+
   return Status::OK();
 }
 
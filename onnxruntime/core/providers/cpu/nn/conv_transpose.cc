@@ -235,34 +235,71 @@ Status ConvTranspose<T>::Compute(OpKernelContext* context) const {
   AllocatorPtr alloc;
   ONNXRUNTIME_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
 
-  auto col_data = alloc->Alloc(sizeof(T) * kernel_dim * p.H * p.W);
-  BufferUniquePtr col_buffer(col_data, BufferDeleter(alloc));
-  T* col_buffer_data = static_cast<T*>(col_buffer.get());
-
   const T* Xdata = p.X->template Data<T>();
   const T* filter_data = p.F->template Data<T>();
   T* Ydata = p.Y->template MutableData<T>();
 
-  for (auto image_id = 0; image_id < p.N; ++image_id) {
-    for (int group_id = 0; group_id < group_; ++group_id) {
-      // Weight term
-      math::Gemm<T, CPUMathUtil>(
-          CblasTrans,
-          CblasNoTrans,
-          kernel_dim,
-          input_image_size,
-          p.num_input_channels / group_,
-          1,
-          filter_data + group_id * W_offset,
-          Xdata + group_id * X_offset,
-          0,
-          col_buffer_data,
-          &CPUMathUtil::Instance());
+  const int64_t group_input_channels = p.num_input_channels / group_;
+  const int64_t group_output_channels = p.num_output_channels / group_;
+  const int64_t kernel_size = p.kernel_shape[0] * p.kernel_shape[1];
+  const float* transposed_filter_data = static_cast<const float*>(transposed_filter_.get());
+
+  // every output channel of every image is an independent GEMM row block and
+  // col2im scatter, so shard the work at output channel granularity. this
+  // keeps all cores busy for the common batch-of-one image upscaling case,
+  // not just when the batch is large.
+  const int64_t total_channels = p.N * group_ * group_output_channels;
+  const double cost_per_channel =
+      2.0 * kernel_size * input_image_size * group_input_channels;
+  context->ParallelFor(0, total_channels, cost_per_channel, [&](int64_t first, int64_t last) {
+    // per shard col buffer covering the largest channel run the shard can see
+    const int64_t max_run = std::min(last - first, group_output_channels);
+    BufferUniquePtr col_buffer(alloc->Alloc(sizeof(T) * max_run * kernel_size * input_image_size),
+                               BufferDeleter(alloc));
+    T* col_buffer_data = static_cast<T*>(col_buffer.get());
+
+    int64_t unit = first;
+    while (unit < last) {
+      const int64_t image_id = unit / (group_ * group_output_channels);
+      const int64_t rem = unit % (group_ * group_output_channels);
+      const int64_t group_id = rem / group_output_channels;
+      const int64_t channel_begin = rem % group_output_channels;
+      // consecutive channels in the same image and group share one GEMM and
+      // one col2im call
+      const int64_t run = std::min(last - unit, group_output_channels - channel_begin);
+
+      const T* group_X = Xdata + (image_id * group_ + group_id) * X_offset;
+      T* run_Y = Ydata + (image_id * group_ + group_id) * Y_offset + channel_begin * output_image_size;
+
+      // Weight term. the run's rows are a contiguous block of the transposed
+      // filter, or a column slice of the original when there is no prepack.
+      if (transposed_filter_data != nullptr) {
+        math::GemmEx<float, CPUMathUtil>(
+            CblasNoTrans, CblasNoTrans,
+            run * kernel_size, input_image_size, group_input_channels,
+            1.0f,
+            transposed_filter_data + group_id * W_offset + channel_begin * kernel_size * group_input_channels,
+            group_input_channels,
+            group_X, input_image_size,
+            0.0f,
+            col_buffer_data, input_image_size,
+            &CPUMathUtil::Instance());
+      } else {
+        math::GemmEx<T, CPUMathUtil>(
+            CblasTrans, CblasNoTrans,
+            run * kernel_size, input_image_size, group_input_channels,
+            1,
+            filter_data + group_id * W_offset + channel_begin * kernel_size, kernel_dim,
+            group_X, input_image_size,
+            0,
+            col_buffer_data, input_image_size,
+            &CPUMathUtil::Instance());
+      }
 
-      // Col2im
+      // Col2im over the run's channels only
       math::Col2im<T, CPUMathUtil, StorageOrder::NCHW>(
           col_buffer_data,
-          p.num_output_channels / group_,
+          run,
           p.Y->Shape()[2],
           p.Y->Shape()[3],
           p.kernel_shape[0],
@@ -275,19 +312,20 @@ Status ConvTranspose<T>::Compute(OpKernelContext* context) const {
           p.pads[3],
           p.strides[0],
           p.strides[1],
-          Ydata + group_id * Y_offset,
+          run_Y,
           &CPUMathUtil::Instance());
-    }
 
-    if (p.B != nullptr) {
-      auto Ymatrix = EigenMatrixMap<T>(Ydata, output_image_size, p.num_output_channels);
-      auto Bvec = ConstEigenVectorMap<T>(p.B->template Data<T>(), p.num_output_channels);
-      Ymatrix.rowwise() += Bvec.transpose();
-    }
+      if (p.B != nullptr) {
+        // add the bias while the scattered planes are still in cache
+        auto Ymatrix = EigenMatrixMap<T>(run_Y, output_image_size, run);
+        auto Bvec = ConstEigenVectorMap<T>(
+            p.B->template Data<T>() + group_id * group_output_channels + channel_begin, run);
+        Ymatrix.rowwise() += Bvec.transpose();
+      }
 
-    Xdata += X_offset * group_;
-    Ydata += Y_offset * group_;
-  }
+      unit += run;
+    }
+  });
 
   return Status::OK();
 }
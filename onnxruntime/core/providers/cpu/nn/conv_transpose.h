@@ -63,9 +63,44 @@ class ConvTransposeBase : public ConvBase {
 template <typename T>
 class ConvTranspose : public OpKernel, public ConvTransposeBase {
  public:
-  ConvTranspose(const OpKernelInfo& info) : OpKernel(info), ConvTransposeBase(info) {}
+  ConvTranspose(const OpKernelInfo& info) : OpKernel(info), ConvTransposeBase(info) {
+    // The filter is usually a constant initializer, so transpose each group's
+    // (input channels x kernel_dim) block into row-major kernel_dim x K form
+    // once here. The per-image GEMM then reads contiguous filter rows instead
+    // of performing a strided transpose on every call, and output-channel
+    // blocks of it can be sliced off cheaply for the sharded path.
+    const Tensor* filter;
+    if (std::is_same<T, float>::value &&
+        info.TryGetConstantInput(1, &filter) &&
+        filter->Shape().NumDimensions() == 4 &&
+        group_ > 0 && filter->Shape()[0] % group_ == 0) {
+      const auto& filter_shape = filter->Shape();
+      const int64_t kernel_dim = filter_shape[1] * filter_shape[2] * filter_shape[3];
+      const int64_t group_input_channels = filter_shape[0] / group_;
+      auto alloc = info.GetExecutionProvider()->GetAllocator(0, ONNXRuntimeMemTypeDefault);
+      transposed_filter_ = IAllocator::MakeUniquePtr<void>(alloc, sizeof(float) * filter_shape.Size());
+      if (transposed_filter_) {
+        const float* src = filter->template Data<float>();
+        float* dst = static_cast<float*>(transposed_filter_.get());
+        for (int64_t group_id = 0; group_id < group_; ++group_id) {
+          const float* group_src = src + group_id * group_input_channels * kernel_dim;
+          float* group_dst = dst + group_id * group_input_channels * kernel_dim;
+          for (int64_t k = 0; k < group_input_channels; ++k) {
+            for (int64_t m = 0; m < kernel_dim; ++m) {
+              group_dst[m * group_input_channels + k] = group_src[k * kernel_dim + m];
+            }
+          }
+        }
+      }
+    }
+  }
 
   Status Compute(OpKernelContext* context) const override;
+
+ private:
+  // Transposed copy of the filter, built at construction when the filter is
+  // a constant initializer.
+  IAllocatorUniquePtr<void> transposed_filter_;
 };
 
 }  // namespace onnxruntime
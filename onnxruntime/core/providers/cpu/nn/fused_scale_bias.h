@@ -0,0 +1,31 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/framework/op_kernel.h"
+#include "core/util/math_cpuonly.h"
+
+namespace onnxruntime {
+
+// Applies y[:, p] = x[:, p] * multiplier[p % C] + addend[p % C] for every
+// spatial plane p in [0, num_planes). This is the folded form shared by the
+// inference normalization ops:
+//   (x - mean) / sqrt(var + epsilon) * gamma + beta == x * multiplier + addend
+// Planes are sharded across the session thread pool, and Eigen lowers the
+// per-plane expression to fused multiply-adds over the spatial extent.
+inline void ApplyFusedScaleBias(OpKernelContext* context,
+                                const float* x, float* y,
+                                int64_t num_planes, int64_t plane_size, int64_t C,
+                                const float* multiplier, const float* addend) {
+  context->ParallelFor(0, num_planes, static_cast<double>(plane_size),
+                       [=](int64_t first, int64_t last) {
+                         for (int64_t p = first; p < last; ++p) {
+                           ConstEigenVectorArrayMap<float> x_plane(x + p * plane_size, plane_size);
+                           EigenVectorArrayMap<float> y_plane(y + p * plane_size, plane_size);
+                           y_plane = x_plane * multiplier[p % C] + addend[p % C];
+                         }
+                       });
+}
+
+}  // namespace onnxruntime
@@ -16,6 +16,7 @@
 /* Modifications Copyright (c) Microsoft. */
 
 #include "core/providers/cpu/nn/lrn.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 
@@ -43,49 +44,69 @@ Status LRN<float>::Compute(OpKernelContext* context) const {
   AllocatorPtr alloc;
   ONNXRUNTIME_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
 
+  // borrow the scale buffer from the per-run scratch arena when one is
+  // active, falling back to a direct allocation otherwise
   const int Xsize = gsl::narrow_cast<int>(X->Shape().Size());
-  auto sdata = alloc->Alloc(sizeof(float) * Xsize);
-  BufferUniquePtr scale_buffer(sdata, BufferDeleter(alloc));
-  float* scale_data = static_cast<float*>(scale_buffer.get());
-  math::Set<float, CPUMathUtil>(Xsize, bias_, scale_data, &CPUMathUtil::Instance());
+  BufferUniquePtr scale_buffer;
+  void* sdata = context->GetScratchBuffer(sizeof(float) * Xsize);
+  if (sdata == nullptr) {
+    scale_buffer = BufferUniquePtr(alloc->Alloc(sizeof(float) * Xsize), BufferDeleter(alloc));
+    sdata = scale_buffer.get();
+  }
+  float* scale_data = static_cast<float*>(sdata);
 
   const size_t padded_square_size = (C + size_ - 1) * H * W;
-  auto psdata = alloc->Alloc(sizeof(float) * padded_square_size);
-  BufferUniquePtr padded_square_buffer(psdata, BufferDeleter(alloc));
-  float* padded_square_data = static_cast<float*>(padded_square_buffer.get());
-  math::Set<float, CPUMathUtil>(padded_square_size, 0.0f, padded_square_data, &CPUMathUtil::Instance());
-
   const float alpha_over_size = alpha_ / size_;
-  // go through the images
-  for (int n = 0; n < N; ++n) {
-    // compute the padded square
-    math::Sqr<float, CPUMathUtil>(image_size, Xdata + image_size * n,
-                                  padded_square_data + pre_pad * H * W,
-                                  &CPUMathUtil::Instance());
-    // Create the first channel scale
-    for (int c = 0; c < size_; ++c) {
-      math::Axpy<float, CPUMathUtil>(
-          H * W, alpha_over_size, padded_square_data + c * H * W,
-          scale_data + image_size * n, &CPUMathUtil::Instance());
-    }
 
-    for (int c = 1; c < C; ++c) {
-      float* this_scale_slice = scale_data + n * image_size + c * H * W;
-      // copy previous scale
-      memcpy(this_scale_slice, this_scale_slice - H * W, H * W * sizeof(float));
-      // add head
-      math::Axpy<float, CPUMathUtil>(
-          H * W, alpha_over_size, padded_square_data + (c + size_ - 1) * H * W,
-          this_scale_slice, &CPUMathUtil::Instance());
-      // subtract tail
-      math::Axpy<float, CPUMathUtil>(
-          H * W, -alpha_over_size, padded_square_data + (c - 1) * H * W,
-          this_scale_slice, &CPUMathUtil::Instance());
-    }
-  }
+  // the images are independent, so shard the batch over the worker pool.
+  // each shard squares, slides the window and normalizes a subrange of it.
+  context->ParallelFor(0, N, 30.0 * image_size, [&](int64_t first, int64_t last) {
+    // per shard padded square buffer; the scratch arena isn't usable off the
+    // calling thread
+    BufferUniquePtr padded_square_buffer(alloc->Alloc(sizeof(float) * padded_square_size),
+                                         BufferDeleter(alloc));
+    float* padded_square_data = static_cast<float*>(padded_square_buffer.get());
+    math::Set<float, CPUMathUtil>(padded_square_size, 0.0f, padded_square_data, &CPUMathUtil::Instance());
+
+    for (int64_t n = first; n < last; ++n) {
+      float* this_scale = scale_data + image_size * n;
+      math::Set<float, CPUMathUtil>(image_size, bias_, this_scale, &CPUMathUtil::Instance());
+      // compute the padded square
+      math::Sqr<float, CPUMathUtil>(image_size, Xdata + image_size * n,
+                                    padded_square_data + pre_pad * H * W,
+                                    &CPUMathUtil::Instance());
+      // Create the first channel scale
+      for (int c = 0; c < size_; ++c) {
+        math::Axpy<float, CPUMathUtil>(
+            H * W, alpha_over_size, padded_square_data + c * H * W,
+            this_scale, &CPUMathUtil::Instance());
+      }
 
-  math::Powx<float, CPUMathUtil>(Xsize, scale_data, -beta_, Ydata, &CPUMathUtil::Instance());
-  math::Mul<float, CPUMathUtil>(Xsize, Ydata, Xdata, Ydata, &CPUMathUtil::Instance());
+      for (int c = 1; c < C; ++c) {
+        float* this_scale_slice = this_scale + c * H * W;
+        // copy previous scale
+        memcpy(this_scale_slice, this_scale_slice - H * W, H * W * sizeof(float));
+        // add head
+        math::Axpy<float, CPUMathUtil>(
+            H * W, alpha_over_size, padded_square_data + (c + size_ - 1) * H * W,
+            this_scale_slice, &CPUMathUtil::Instance());
+        // subtract tail
+        math::Axpy<float, CPUMathUtil>(
+            H * W, -alpha_over_size, padded_square_data + (c - 1) * H * W,
+            this_scale_slice, &CPUMathUtil::Instance());
+      }
+
+      // Y = X * scale^(-beta). math::Powx is a scalar powf per element;
+      // scale^(-beta) = exp(-beta * log(scale)) keeps the whole image in
+      // vector code (Eigen for the log, MLAS for the exp).
+      float* this_Y = Ydata + image_size * n;
+      EigenVectorArrayMap<float>(this_Y, image_size) =
+          ConstEigenVectorArrayMap<float>(this_scale, image_size).log() * -beta_;
+      MlasComputeExp(this_Y, this_Y, image_size);
+      EigenVectorArrayMap<float>(this_Y, image_size) *=
+          ConstEigenVectorArrayMap<float>(Xdata + image_size * n, image_size);
+    }
+  });
 
   return Status::OK();
 }
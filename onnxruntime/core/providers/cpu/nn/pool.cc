@@ -44,27 +44,30 @@ Status Pool<T, PoolType>::Compute(OpKernelContext* context) const {
       int64_t y_step = pooled_height;
       const int64_t total_channels = x_shape[0] * channels;
 
-#pragma omp parallel for
-      for (int64_t c = 0; c < total_channels; ++c) {
-        const float* x_d = X_data + c * x_step;
-        float* y_d = Y_data + c * y_step;
-
-        for (int64_t ph = 0; ph < pooled_height; ++ph) {
-          int64_t hstart = ph * stride_h() - pads[0];
-          int64_t hend = std::min(hstart + kernel_shape[0], height);
-          hstart = std::max(hstart, static_cast<int64_t>(0));
-          T Yh = PoolType::Initialize();
-          for (int64_t h = hstart; h < hend; ++h) {
-            PoolType::Process(x_d[h], Yh, pool_context_);
-          }
-          if (count_include_pad_) {
-            PoolType::Finalize(kernel_shape[0], Yh, pool_context_);
-          } else {
-            PoolType::Finalize(hend - hstart, Yh, pool_context_);
+      context->ParallelFor(
+          0, total_channels, static_cast<double>(pooled_height * kernel_shape[0]),
+          [&](int64_t first_channel, int64_t last_channel) {
+        for (int64_t c = first_channel; c < last_channel; ++c) {
+          const float* x_d = X_data + c * x_step;
+          float* y_d = Y_data + c * y_step;
+
+          for (int64_t ph = 0; ph < pooled_height; ++ph) {
+            int64_t hstart = ph * stride_h() - pads[0];
+            int64_t hend = std::min(hstart + kernel_shape[0], height);
+            hstart = std::max(hstart, static_cast<int64_t>(0));
+            T Yh = PoolType::Initialize();
+            for (int64_t h = hstart; h < hend; ++h) {
+              PoolType::Process(x_d[h], Yh, pool_context_);
+            }
+            if (count_include_pad_) {
+              PoolType::Finalize(kernel_shape[0], Yh, pool_context_);
+            } else {
+              PoolType::Finalize(hend - hstart, Yh, pool_context_);
+            }
+            y_d[ph] = Yh;
           }
-          y_d[ph] = Yh;
         }
-      }
+      });
 
       break;
     }
@@ -74,36 +77,39 @@ Status Pool<T, PoolType>::Compute(OpKernelContext* context) const {
       int64_t y_step = pooled_height * pooled_width;
       const int64_t total_channels = x_shape[0] * channels;
 
-#pragma omp parallel for
-      for (int64_t c = 0; c < total_channels; ++c) {
-        const float* x_d = X_data + c * x_step;
-        float* y_d = Y_data + c * y_step;
-
-        for (int64_t ph = 0; ph < pooled_height; ++ph) {
-          int64_t hstart = ph * stride_h() - pads[0];
-          int64_t hend = std::min(hstart + kernel_shape[0], height);
-          hstart = std::max(hstart, static_cast<int64_t>(0));
-          for (int64_t pw = 0; pw < pooled_width; ++pw) {
-            int64_t wstart = pw * stride_w() - pads[1];
-            int64_t wend = std::min(wstart + kernel_shape[1], width);
-            wstart = std::max(wstart, static_cast<int64_t>(0));
-            const int64_t pool_index = ph * pooled_width + pw;
-            T Yh = PoolType::Initialize();
-            for (int64_t h = hstart; h < hend; ++h) {
-              for (int64_t w = wstart; w < wend; ++w) {
-                const int64_t input_index = h * width + w;
-                PoolType::Process(x_d[input_index], Yh, pool_context_);
+      context->ParallelFor(
+          0, total_channels, static_cast<double>(pooled_height * pooled_width * kernel_shape[0] * kernel_shape[1]),
+          [&](int64_t first_channel, int64_t last_channel) {
+        for (int64_t c = first_channel; c < last_channel; ++c) {
+          const float* x_d = X_data + c * x_step;
+          float* y_d = Y_data + c * y_step;
+
+          for (int64_t ph = 0; ph < pooled_height; ++ph) {
+            int64_t hstart = ph * stride_h() - pads[0];
+            int64_t hend = std::min(hstart + kernel_shape[0], height);
+            hstart = std::max(hstart, static_cast<int64_t>(0));
+            for (int64_t pw = 0; pw < pooled_width; ++pw) {
+              int64_t wstart = pw * stride_w() - pads[1];
+              int64_t wend = std::min(wstart + kernel_shape[1], width);
+              wstart = std::max(wstart, static_cast<int64_t>(0));
+              const int64_t pool_index = ph * pooled_width + pw;
+              T Yh = PoolType::Initialize();
+              for (int64_t h = hstart; h < hend; ++h) {
+                for (int64_t w = wstart; w < wend; ++w) {
+                  const int64_t input_index = h * width + w;
+                  PoolType::Process(x_d[input_index], Yh, pool_context_);
+                }
               }
+              if (count_include_pad_) {
+                PoolType::Finalize(kernel_shape[0] * kernel_shape[1], Yh, pool_context_);
+              } else {
+                PoolType::Finalize((hend - hstart) * (wend - wstart), Yh, pool_context_);
+              }
+              y_d[pool_index] = Yh;
             }
-            if (count_include_pad_) {
-              PoolType::Finalize(kernel_shape[0] * kernel_shape[1], Yh, pool_context_);
-            } else {
-              PoolType::Finalize((hend - hstart) * (wend - wstart), Yh, pool_context_);
-            }
-            y_d[pool_index] = Yh;
           }
         }
-      }
+      });
 
       break;
     }
@@ -112,45 +118,48 @@ Status Pool<T, PoolType>::Compute(OpKernelContext* context) const {
       int64_t y_step = pooled_height * pooled_width * pooled_depth;
       const int64_t total_channels = x_shape[0] * channels;
 
-#pragma omp parallel for
-      for (int64_t c = 0; c < total_channels; ++c) {
-        const float* x_d = X_data + c * x_step;
-        float* y_d = Y_data + c * y_step;
-
-        for (int64_t ph = 0; ph < pooled_height; ++ph) {
-          int64_t hstart = ph * stride_h() - pads[0];
-          int64_t hend = std::min(hstart + kernel_shape[0], height);
-          hstart = std::max(hstart, static_cast<int64_t>(0));
-          for (int64_t pw = 0; pw < pooled_width; ++pw) {
-            int64_t wstart = pw * stride_w() - pads[1];
-            int64_t wend = std::min(wstart + kernel_shape[1], width);
-            wstart = std::max(wstart, static_cast<int64_t>(0));
-            for (int64_t pd = 0; pd < pooled_depth; ++pd) {
-              int64_t dstart = pd * stride_d() - pads[2];
-              int64_t dend = std::min(dstart + kernel_shape[2], depth);
-              dstart = std::max(dstart, static_cast<int64_t>(0));
-              const int64_t pool_index =
-                  ph * pooled_width * pooled_depth + pw * pooled_depth + pd;
-              T Yh = PoolType::Initialize();
-              for (int64_t h = hstart; h < hend; ++h) {
-                for (int64_t w = wstart; w < wend; ++w) {
-                  for (int64_t d = dstart; d < dend; ++d) {
-                    const int64_t input_index = h * width * depth + w * depth + d;
-                    PoolType::Process(x_d[input_index], Yh, pool_context_);
+      context->ParallelFor(
+          0, total_channels, static_cast<double>(pooled_height * pooled_width * pooled_depth * kernel_shape[0] * kernel_shape[1] * kernel_shape[2]),
+          [&](int64_t first_channel, int64_t last_channel) {
+        for (int64_t c = first_channel; c < last_channel; ++c) {
+          const float* x_d = X_data + c * x_step;
+          float* y_d = Y_data + c * y_step;
+
+          for (int64_t ph = 0; ph < pooled_height; ++ph) {
+            int64_t hstart = ph * stride_h() - pads[0];
+            int64_t hend = std::min(hstart + kernel_shape[0], height);
+            hstart = std::max(hstart, static_cast<int64_t>(0));
+            for (int64_t pw = 0; pw < pooled_width; ++pw) {
+              int64_t wstart = pw * stride_w() - pads[1];
+              int64_t wend = std::min(wstart + kernel_shape[1], width);
+              wstart = std::max(wstart, static_cast<int64_t>(0));
+              for (int64_t pd = 0; pd < pooled_depth; ++pd) {
+                int64_t dstart = pd * stride_d() - pads[2];
+                int64_t dend = std::min(dstart + kernel_shape[2], depth);
+                dstart = std::max(dstart, static_cast<int64_t>(0));
+                const int64_t pool_index =
+                    ph * pooled_width * pooled_depth + pw * pooled_depth + pd;
+                T Yh = PoolType::Initialize();
+                for (int64_t h = hstart; h < hend; ++h) {
+                  for (int64_t w = wstart; w < wend; ++w) {
+                    for (int64_t d = dstart; d < dend; ++d) {
+                      const int64_t input_index = h * width * depth + w * depth + d;
+                      PoolType::Process(x_d[input_index], Yh, pool_context_);
+                    }
                   }
                 }
+                if (count_include_pad_) {
+                  PoolType::Finalize(kernel_shape[0] * kernel_shape[1] * kernel_shape[2], Yh, pool_context_);
+                } else {
+                  PoolType::Finalize(
+                      (hend - hstart) * (wend - wstart) * (dend - dstart), Yh, pool_context_);
+                }
+                y_d[pool_index] = Yh;
               }
-              if (count_include_pad_) {
-                PoolType::Finalize(kernel_shape[0] * kernel_shape[1] * kernel_shape[2], Yh, pool_context_);
-              } else {
-                PoolType::Finalize(
-                    (hend - hstart) * (wend - wstart) * (dend - dstart), Yh, pool_context_);
-              }
-              y_d[pool_index] = Yh;
             }
           }
         }
-      }
+      });
 
       break;
     }
@@ -241,27 +250,30 @@ Status Pool<float, MaxPool<8 /*VERSION*/>>::Compute(OpKernelContext* context) co
       int64_t y_step = pooled_height;
       const int64_t total_channels = x_shape[0] * channels;
 
-#pragma omp parallel for
-      for (int64_t c = 0; c < total_channels; ++c) {
-        const float* x_d = X_data + c * x_step;
-        float* y_d = Y_data + c * y_step;
-        int64_t* i_d = I_data ? I_data + c * y_step : nullptr;
-        for (int64_t ph = 0; ph < pooled_height; ++ph) {
-          int64_t hstart = ph * stride_h() - pads[0];
-          int64_t hend = std::min(hstart + kernel_shape[0], height);
-          hstart = std::max(hstart, static_cast<int64_t>(0));
-          float Yh = std::numeric_limits<float>::lowest();
-          int64_t h_index = -1;
-          for (int64_t h = hstart; h < hend; ++h) {
-            if (x_d[h] > Yh) {
-              Yh = x_d[h];
-              h_index = h;
+      context->ParallelFor(
+          0, total_channels, static_cast<double>(pooled_height * kernel_shape[0]),
+          [&](int64_t first_channel, int64_t last_channel) {
+        for (int64_t c = first_channel; c < last_channel; ++c) {
+          const float* x_d = X_data + c * x_step;
+          float* y_d = Y_data + c * y_step;
+          int64_t* i_d = I_data ? I_data + c * y_step : nullptr;
+          for (int64_t ph = 0; ph < pooled_height; ++ph) {
+            int64_t hstart = ph * stride_h() - pads[0];
+            int64_t hend = std::min(hstart + kernel_shape[0], height);
+            hstart = std::max(hstart, static_cast<int64_t>(0));
+            float Yh = std::numeric_limits<float>::lowest();
+            int64_t h_index = -1;
+            for (int64_t h = hstart; h < hend; ++h) {
+              if (x_d[h] > Yh) {
+                Yh = x_d[h];
+                h_index = h;
+              }
             }
+            y_d[ph] = Yh;
+            if (i_d != nullptr) i_d[ph] = c * x_step + h_index;
           }
-          y_d[ph] = Yh;
-          if (i_d != nullptr) i_d[ph] = c * x_step + h_index;
         }
-      }
+      });
 
       break;
     }
@@ -271,41 +283,44 @@ Status Pool<float, MaxPool<8 /*VERSION*/>>::Compute(OpKernelContext* context) co
       int64_t y_step = pooled_height * pooled_width;
       const int64_t total_channels = x_shape[0] * channels;
 
-#pragma omp parallel for
-      for (int64_t c = 0; c < total_channels; ++c) {
-        const float* x_d = X_data + c * x_step;
-        float* y_d = Y_data + c * y_step;
-        int64_t* i_d = I_data ? I_data + c * y_step : nullptr;
-
-        for (int64_t ph = 0; ph < pooled_height; ++ph) {
-          int64_t hstart = ph * stride_h() - pads[0];
-          int64_t hend = std::min(hstart + kernel_shape[0], height);
-          hstart = std::max(hstart, static_cast<int64_t>(0));
-          for (int64_t pw = 0; pw < pooled_width; ++pw) {
-            int64_t wstart = pw * stride_w() - pads[1];
-            int64_t wend = std::min(wstart + kernel_shape[1], width);
-            wstart = std::max(wstart, static_cast<int64_t>(0));
-            const int64_t pool_index = ph * pooled_width + pw;
-            float Yh = std::numeric_limits<float>::lowest();
-            int64_t h_index = -1;
-            int64_t w_index = -1;
-            for (int64_t h = hstart; h < hend; ++h) {
-              for (int64_t w = wstart; w < wend; ++w) {
-                const int64_t input_index = h * width + w;
-                if (x_d[input_index] > Yh) {
-                  Yh = x_d[input_index];
-                  h_index = h;
-                  w_index = w;
+      context->ParallelFor(
+          0, total_channels, static_cast<double>(pooled_height * pooled_width * kernel_shape[0] * kernel_shape[1]),
+          [&](int64_t first_channel, int64_t last_channel) {
+        for (int64_t c = first_channel; c < last_channel; ++c) {
+          const float* x_d = X_data + c * x_step;
+          float* y_d = Y_data + c * y_step;
+          int64_t* i_d = I_data ? I_data + c * y_step : nullptr;
+
+          for (int64_t ph = 0; ph < pooled_height; ++ph) {
+            int64_t hstart = ph * stride_h() - pads[0];
+            int64_t hend = std::min(hstart + kernel_shape[0], height);
+            hstart = std::max(hstart, static_cast<int64_t>(0));
+            for (int64_t pw = 0; pw < pooled_width; ++pw) {
+              int64_t wstart = pw * stride_w() - pads[1];
+              int64_t wend = std::min(wstart + kernel_shape[1], width);
+              wstart = std::max(wstart, static_cast<int64_t>(0));
+              const int64_t pool_index = ph * pooled_width + pw;
+              float Yh = std::numeric_limits<float>::lowest();
+              int64_t h_index = -1;
+              int64_t w_index = -1;
+              for (int64_t h = hstart; h < hend; ++h) {
+                for (int64_t w = wstart; w < wend; ++w) {
+                  const int64_t input_index = h * width + w;
+                  if (x_d[input_index] > Yh) {
+                    Yh = x_d[input_index];
+                    h_index = h;
+                    w_index = w;
+                  }
                 }
               }
+              y_d[pool_index] = Yh;
+              if (i_d != nullptr)
+                i_d[pool_index] = storage_order_ == 0 ? c * x_step + h_index * width + w_index
+                                                      : c * x_step + h_index + w_index * height;
             }
-            y_d[pool_index] = Yh;
-            if (i_d != nullptr)
-              i_d[pool_index] = storage_order_ == 0 ? c * x_step + h_index * width + w_index
-                                                    : c * x_step + h_index + w_index * height;
           }
         }
-      }
+      });
       break;
     }
     case 3: {
@@ -313,51 +328,54 @@ Status Pool<float, MaxPool<8 /*VERSION*/>>::Compute(OpKernelContext* context) co
       int64_t y_step = pooled_height * pooled_width * pooled_depth;
       const int64_t total_channels = x_shape[0] * channels;
 
-#pragma omp parallel for
-      for (int64_t c = 0; c < total_channels; ++c) {
-        const float* x_d = X_data + c * x_step;
-        float* y_d = Y_data + c * y_step;
-        int64_t* i_d = I_data ? I_data + c * y_step : nullptr;
-
-        for (int64_t ph = 0; ph < pooled_height; ++ph) {
-          int64_t hstart = ph * stride_h() - pads[0];
-          int64_t hend = std::min(hstart + kernel_shape[0], height);
-          hstart = std::max(hstart, static_cast<int64_t>(0));
-          for (int64_t pw = 0; pw < pooled_width; ++pw) {
-            int64_t wstart = pw * stride_w() - pads[1];
-            int64_t wend = std::min(wstart + kernel_shape[1], width);
-            wstart = std::max(wstart, static_cast<int64_t>(0));
-            for (int64_t pd = 0; pd < pooled_depth; ++pd) {
-              int64_t dstart = pd * stride_d() - pads[2];
-              int64_t dend = std::min(dstart + kernel_shape[2], depth);
-              dstart = std::max(dstart, static_cast<int64_t>(0));
-              const int64_t pool_index =
-                  ph * pooled_width * pooled_depth + pw * pooled_depth + pd;
-              float Yh = std::numeric_limits<float>::lowest();
-              int64_t h_index = -1;
-              int64_t w_index = -1;
-              int64_t d_index = -1;
-              for (int64_t h = hstart; h < hend; ++h) {
-                for (int64_t w = wstart; w < wend; ++w) {
-                  for (int64_t d = dstart; d < dend; ++d) {
-                    const int64_t input_index = h * width * depth + w * depth + d;
-                    if (x_d[input_index] > Yh) {
-                      Yh = x_d[input_index];
-                      h_index = h;
-                      w_index = w;
-                      d_index = d;
+      context->ParallelFor(
+          0, total_channels, static_cast<double>(pooled_height * pooled_width * pooled_depth * kernel_shape[0] * kernel_shape[1] * kernel_shape[2]),
+          [&](int64_t first_channel, int64_t last_channel) {
+        for (int64_t c = first_channel; c < last_channel; ++c) {
+          const float* x_d = X_data + c * x_step;
+          float* y_d = Y_data + c * y_step;
+          int64_t* i_d = I_data ? I_data + c * y_step : nullptr;
+
+          for (int64_t ph = 0; ph < pooled_height; ++ph) {
+            int64_t hstart = ph * stride_h() - pads[0];
+            int64_t hend = std::min(hstart + kernel_shape[0], height);
+            hstart = std::max(hstart, static_cast<int64_t>(0));
+            for (int64_t pw = 0; pw < pooled_width; ++pw) {
+              int64_t wstart = pw * stride_w() - pads[1];
+              int64_t wend = std::min(wstart + kernel_shape[1], width);
+              wstart = std::max(wstart, static_cast<int64_t>(0));
+              for (int64_t pd = 0; pd < pooled_depth; ++pd) {
+                int64_t dstart = pd * stride_d() - pads[2];
+                int64_t dend = std::min(dstart + kernel_shape[2], depth);
+                dstart = std::max(dstart, static_cast<int64_t>(0));
+                const int64_t pool_index =
+                    ph * pooled_width * pooled_depth + pw * pooled_depth + pd;
+                float Yh = std::numeric_limits<float>::lowest();
+                int64_t h_index = -1;
+                int64_t w_index = -1;
+                int64_t d_index = -1;
+                for (int64_t h = hstart; h < hend; ++h) {
+                  for (int64_t w = wstart; w < wend; ++w) {
+                    for (int64_t d = dstart; d < dend; ++d) {
+                      const int64_t input_index = h * width * depth + w * depth + d;
+                      if (x_d[input_index] > Yh) {
+                        Yh = x_d[input_index];
+                        h_index = h;
+                        w_index = w;
+                        d_index = d;
+                      }
                     }
                   }
                 }
+                y_d[pool_index] = Yh;
+                if (i_d != nullptr)
+                  i_d[pool_index] = storage_order_ == 0 ? c * x_step + h_index * width * depth + w_index * depth + d_index
+                                                        : c * x_step + h_index + w_index * height + d_index * height * width;
               }
-              y_d[pool_index] = Yh;
-              if (i_d != nullptr)
-                i_d[pool_index] = storage_order_ == 0 ? c * x_step + h_index * width * depth + w_index * depth + d_index
-                                                      : c * x_step + h_index + w_index * height + d_index * height * width;
             }
           }
         }
-      }
+      });
       break;
     }
     default:
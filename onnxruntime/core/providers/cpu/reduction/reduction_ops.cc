@@ -2,6 +2,8 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/reduction/reduction_ops.h"
+#include "core/common/work_stealing_thread_pool.h"
+#include "core/providers/cpu/reduction/row_arg_minmax.h"
 #include "core/util/math_cpuonly.h"
 using namespace std;
 namespace onnxruntime {
@@ -42,6 +44,7 @@ REGISTER_UNARY_ELEMENTWISE_KERNEL(ArgMin, 1);
 template <typename T>
 bool PrepareForReduce(OpKernelContext* ctx,
                       std::vector<T>& transposedInputData,
+                      T*& transposed_data,
                       Tensor** reducedTensor,
                       int64_t& block_size,
                       int64_t& blocks,
@@ -131,8 +134,15 @@ bool PrepareForReduce(OpKernelContext* ctx,
     return true;
   }
 
-  transposedInputData.resize(input.Shape().Size(), 0);
-  T* to_data = &transposedInputData[0];
+  // the transposed copy only lives for this Compute() call, so borrow it
+  // from the per-run scratch arena when one is active; the vector is the
+  // fallback storage otherwise.
+  T* to_data = static_cast<T*>(ctx->GetScratchBuffer(sizeof(T) * count));
+  if (to_data == nullptr) {
+    transposedInputData.resize(count);
+    to_data = transposedInputData.data();
+  }
+  transposed_data = to_data;
   if (num_axes < 2 || n_shared_idxs == num_axes) {
     memcpy(to_data, from_data, count * sizeof(T));
     return false;
@@ -197,50 +207,216 @@ bool PrepareForReduce(OpKernelContext* ctx,
   return false;
 }
 
+// Describes a reduction evaluated directly over the strided input data, without
+// materializing the transposed copy built by PrepareForReduce. The input is viewed
+// as [outer, reduce, inner]:
+//   - inner_count is the contiguous run of kept dimensions at the tail of the shape,
+//   - reduce_inner_count is the contiguous run of reduced dimensions at the tail and
+//     is only > 1 when the last dimension is reduced (so inner_count is 1),
+//   - outer_offsets/reduce_offsets hold the input offsets of every index combination
+//     of the remaining kept and reduced dimensions.
+struct StridedReductionPlan {
+  int64_t inner_count = 1;
+  int64_t reduce_inner_count = 1;
+  std::vector<int64_t> outer_offsets;
+  std::vector<int64_t> reduce_offsets;
+
+  int64_t ReduceSize() const {
+    return reduce_inner_count * static_cast<int64_t>(reduce_offsets.size());
+  }
+};
+
+// Enumerates, in row major order, the input offsets of every index combination of
+// the dimensions in [0, last_dim] for which keep_axis[dim] == keep.
+static void EnumerateOffsets(const std::vector<int64_t>& dims,
+                             const std::vector<int64_t>& strides,
+                             const vector<bool>& keep_axis,
+                             int last_dim,
+                             bool keep,
+                             std::vector<int64_t>& offsets) {
+  offsets.assign(1, 0);
+
+  for (int dim = 0; dim <= last_dim; ++dim) {
+    if (keep_axis[dim] != keep) {
+      continue;
+    }
+
+    std::vector<int64_t> expanded;
+    expanded.reserve(offsets.size() * dims[dim]);
+    for (int64_t offset : offsets) {
+      for (int64_t i = 0; i < dims[dim]; ++i) {
+        expanded.push_back(offset + i * strides[dim]);
+      }
+    }
+
+    offsets.swap(expanded);
+  }
+}
+
+// Validates the axes, creates the output tensor and builds the plan for reducing
+// the input in-place. Unlike PrepareForReduce no copy of the input is made for
+// non-contiguous reduce axes.
+template <typename T>
+void PrepareForStridedReduce(OpKernelContext* ctx,
+                             Tensor** reducedTensor,
+                             StridedReductionPlan& plan,
+                             const std::vector<int64_t>& axes_,
+                             bool keepdims_) {
+  const Tensor* input_tensor_ptr = ctx->Input<Tensor>(0);
+  ONNXRUNTIME_ENFORCE(input_tensor_ptr != nullptr);
+  const Tensor& input = *input_tensor_ptr;
+
+  size_t ndim = input.Shape().GetDims().size();
+  for (int64_t axe : axes_) {
+    ONNXRUNTIME_ENFORCE(axe >= 0 && axe < (int64_t)ndim, "Axis attribute out of range");
+  }
+
+  std::vector<int64_t> axes = axes_;
+  if (axes.empty()) {
+    // This is the default case for non-arg kind reductions. Reduce on all dimensions.
+    for (int i = 0; i < ndim; i++)
+      axes.push_back(i);
+  }
+
+  std::sort(axes.begin(), axes.end());
+
+  vector<bool> keep_axis(ndim, true);
+  for (auto i : axes) {
+    keep_axis[i] = false;
+  }
+
+  auto in_dims = input.Shape().GetDims();
+
+  //set to-be-reduced axes to one. squeeze if keepdims_ is false
+  std::vector<int64_t> reduced_dims;
+  for (int i = 0; i < in_dims.size(); i++) {
+    if (keep_axis[i]) {
+      reduced_dims.push_back(in_dims[i]);
+    } else if (keepdims_) {
+      reduced_dims.push_back(1);
+    }
+  }
+
+  *reducedTensor = ctx->Output(0, reduced_dims);
+
+  // strides of the input in row major order
+  std::vector<int64_t> strides(ndim, 1);
+  for (int i = static_cast<int>(ndim) - 2; i >= 0; --i) {
+    strides[i] = strides[i + 1] * in_dims[i + 1];
+  }
+
+  // fold the contiguous run at the tail of the shape into inner_count (kept) or
+  // reduce_inner_count (reduced) so the innermost loops run over contiguous memory
+  int dim = static_cast<int>(ndim) - 1;
+  if (dim >= 0 && keep_axis[dim]) {
+    for (; dim >= 0 && keep_axis[dim]; --dim)
+      plan.inner_count *= in_dims[dim];
+  } else {
+    for (; dim >= 0 && !keep_axis[dim]; --dim)
+      plan.reduce_inner_count *= in_dims[dim];
+  }
+
+  EnumerateOffsets(in_dims, strides, keep_axis, dim, true, plan.outer_offsets);
+  EnumerateOffsets(in_dims, strides, keep_axis, dim, false, plan.reduce_offsets);
+}
+
+// Reduces 'input' into 'output' following the plan. 'accumulate' combines an
+// accumulator value with one input element. The output is partitioned across the
+// task pool when there is enough work to amortize the task overhead, and the
+// innermost loops run over contiguous memory so the compiler can vectorize them.
+template <typename T, typename TAccumulateFn>
+void ReduceStrided(const T* input,
+                   T* output,
+                   const StridedReductionPlan& plan,
+                   T init,
+                   TAccumulateFn accumulate) {
+  const int64_t inner = plan.inner_count;
+  const int64_t num_outer = static_cast<int64_t>(plan.outer_offsets.size());
+  const int64_t output_count = num_outer * inner;
+
+  auto reduce_range = [&](int64_t first, int64_t last) {
+    for (int64_t index = first; index < last;) {
+      const int64_t outer = index / inner;
+      const int64_t inner_start = index % inner;
+      const int64_t inner_size = std::min(inner - inner_start, last - index);
+      const T* base = input + plan.outer_offsets[outer] + inner_start;
+      T* out = output + index;
+
+      if (inner > 1) {
+        std::fill_n(out, inner_size, init);
+        for (int64_t reduce_offset : plan.reduce_offsets) {
+          const T* in = base + reduce_offset;
+          for (int64_t i = 0; i < inner_size; ++i)
+            out[i] = accumulate(out[i], in[i]);
+        }
+      } else {
+        T accumulator = init;
+        for (int64_t reduce_offset : plan.reduce_offsets) {
+          const T* in = base + reduce_offset;
+          for (int64_t i = 0; i < plan.reduce_inner_count; ++i)
+            accumulator = accumulate(accumulator, in[i]);
+        }
+        *out = accumulator;
+      }
+
+      index += inner_size;
+    }
+  };
+
+  // each output element costs one accumulate per reduced input element
+  ParallelFor(0, output_count, static_cast<double>(plan.ReduceSize()), reduce_range);
+}
+
 template <typename T>
 Status ReduceL1<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
+  StridedReductionPlan plan;
   Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
+  PrepareForStridedReduce<T>(ctx, &reduced, plan, axes_, keepdims_);
 
+  const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
   T* output_data = reduced->template MutableData<T>();
 
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).cwiseAbs().rowwise().sum();
+  ReduceStrided<T>(input_data, output_data, plan, static_cast<T>(0),
+                   [](T acc, T x) { return acc + static_cast<T>(std::abs(x)); });
 
   return Status::OK();
 }
 
 template <typename T>
 Status ReduceL2<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
+  StridedReductionPlan plan;
   Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
+  PrepareForStridedReduce<T>(ctx, &reduced, plan, axes_, keepdims_);
 
+  const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
   T* output_data = reduced->template MutableData<T>();
 
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().norm();
+  ReduceStrided<T>(input_data, output_data, plan, static_cast<T>(0),
+                   [](T acc, T x) { return acc + x * x; });
+
+  const int64_t output_count = reduced->Shape().Size();
+  for (int64_t j = 0; j < output_count; ++j) {
+    output_data[j] = static_cast<T>(std::sqrt(output_data[j]));
+  }
 
   return Status::OK();
 }
 
 template <typename T>
 Status ReduceLogSum<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
+  StridedReductionPlan plan;
   Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
+  PrepareForStridedReduce<T>(ctx, &reduced, plan, axes_, keepdims_);
 
+  const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
   T* output_data = reduced->template MutableData<T>();
 
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().sum();
-  for (int j = 0; j < block_size; ++j) {
-    *(output_data) = static_cast<T>(std::log(*(output_data)));
-    ++output_data;
+  ReduceStrided<T>(input_data, output_data, plan, static_cast<T>(0),
+                   [](T acc, T x) { return acc + x; });
+
+  const int64_t output_count = reduced->Shape().Size();
+  for (int64_t j = 0; j < output_count; ++j) {
+    output_data[j] = static_cast<T>(std::log(output_data[j]));
   }
 
   return Status::OK();
@@ -249,20 +425,21 @@ Status ReduceLogSum<T>::Compute(OpKernelContext* ctx) const {
 template <typename T>
 Status ReduceLogSumExp<T>::Compute(OpKernelContext* ctx) const {
   std::vector<T> transposedInputData;
+  T* transposed_data = nullptr;
   int64_t block_size, blocks;
   Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
+  PrepareForReduce<T>(ctx, transposedInputData, transposed_data, &reduced, block_size, blocks, axes_, keepdims_);
 
   T* output_data = reduced->template MutableData<T>();
 
   for (int j = 0; j < block_size; ++j) {
     T max_value = std::numeric_limits<T>::lowest();
     for (int i = 0; i < blocks; ++i) {
-      max_value = std::max(max_value, transposedInputData[i * block_size + j]);
+      max_value = std::max(max_value, transposed_data[i * block_size + j]);
     }
     T scaled_exp_sum = 0;
     for (int i = 0; i < blocks; ++i) {
-      scaled_exp_sum += static_cast<T>(std::exp(transposedInputData[i * block_size + j] - max_value));
+      scaled_exp_sum += static_cast<T>(std::exp(transposed_data[i * block_size + j] - max_value));
     }
     *(output_data++) = static_cast<T>(std::log(scaled_exp_sum) + max_value);
   }
@@ -271,39 +448,35 @@ Status ReduceLogSumExp<T>::Compute(OpKernelContext* ctx) const {
 
 template <typename T>
 Status ReduceMax<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
+  StridedReductionPlan plan;
   Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
+  PrepareForStridedReduce<T>(ctx, &reduced, plan, axes_, keepdims_);
 
+  const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
   T* output_data = reduced->template MutableData<T>();
 
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().maxCoeff();
+  ReduceStrided<T>(input_data, output_data, plan, std::numeric_limits<T>::lowest(),
+                   [](T acc, T x) { return std::max(acc, x); });
 
   return Status::OK();
 }
 
 template <typename T>
 Status ReduceMean<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
+  StridedReductionPlan plan;
   Tensor* reduced;
-  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_, true);
+  PrepareForStridedReduce<T>(ctx, &reduced, plan, axes_, keepdims_);
 
+  const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
   T* output_data = reduced->template MutableData<T>();
 
-  if (no_transpose) {
-    const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
+  ReduceStrided<T>(input_data, output_data, plan, static_cast<T>(0),
+                   [](T acc, T x) { return acc + x; });
 
-    #pragma omp parallel for
-    for (int64_t i = 0; i < block_size; ++i) {
-      output_data[i] = ConstEigenVectorMap<T>(input_data + (i * blocks), blocks).mean();
-    }
-  }
-  else {
-    EigenVectorMap<T> out_vec(output_data, block_size);
-    out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().mean();
+  const T reduce_size = static_cast<T>(plan.ReduceSize());
+  const int64_t output_count = reduced->Shape().Size();
+  for (int64_t j = 0; j < output_count; ++j) {
+    output_data[j] = output_data[j] / reduce_size;
   }
 
   return Status::OK();
@@ -311,70 +484,60 @@ Status ReduceMean<T>::Compute(OpKernelContext* ctx) const {
 
 template <typename T>
 Status ReduceMin<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
+  StridedReductionPlan plan;
   Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
+  PrepareForStridedReduce<T>(ctx, &reduced, plan, axes_, keepdims_);
 
+  const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
   T* output_data = reduced->template MutableData<T>();
 
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().minCoeff();
+  ReduceStrided<T>(input_data, output_data, plan, std::numeric_limits<T>::max(),
+                   [](T acc, T x) { return std::min(acc, x); });
 
   return Status::OK();
 }
 
 template <typename T>
 Status ReduceProd<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
+  StridedReductionPlan plan;
   Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
+  PrepareForStridedReduce<T>(ctx, &reduced, plan, axes_, keepdims_);
 
+  const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
   T* output_data = reduced->template MutableData<T>();
 
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().prod();
+  ReduceStrided<T>(input_data, output_data, plan, static_cast<T>(1),
+                   [](T acc, T x) { return acc * x; });
 
   return Status::OK();
 }
 
 template <typename T>
 Status ReduceSum<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
+  StridedReductionPlan plan;
   Tensor* reduced;
-  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_, true);
+  PrepareForStridedReduce<T>(ctx, &reduced, plan, axes_, keepdims_);
 
+  const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
   T* output_data = reduced->template MutableData<T>();
 
-  if (no_transpose) {
-    const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
-    
-    #pragma omp parallel for
-    for (int64_t i = 0; i < block_size; ++i) {
-      output_data[i] = ConstEigenVectorMap<T>(input_data + (i * blocks), blocks).sum();
-    }
-  }
-  else {
-    EigenVectorMap<T> out_vec(output_data, block_size);
-    out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().sum();
-  }
+  ReduceStrided<T>(input_data, output_data, plan, static_cast<T>(0),
+                   [](T acc, T x) { return acc + x; });
 
   return Status::OK();
 }
 
 template <typename T>
 Status ReduceSumSquare<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
+  StridedReductionPlan plan;
   Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
+  PrepareForStridedReduce<T>(ctx, &reduced, plan, axes_, keepdims_);
 
+  const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
   T* output_data = reduced->template MutableData<T>();
 
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().squaredNorm();
+  ReduceStrided<T>(input_data, output_data, plan, static_cast<T>(0),
+                   [](T acc, T x) { return acc + x * x; });
 
   return Status::OK();
 }
@@ -382,14 +545,29 @@ Status ReduceSumSquare<T>::Compute(OpKernelContext* ctx) const {
 template <typename T>
 Status ArgMax<T>::Compute(OpKernelContext* ctx) const {
   std::vector<T> transposedInputData;
+  T* transposed_data = nullptr;
   int64_t block_size, blocks;
   Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
+  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, transposed_data, &reduced, block_size, blocks,
+                                          axes_, keepdims_, true);
 
   int64_t* output_data = reduced->template MutableData<int64_t>();
 
+  if (no_transpose) {
+    // The reduced axis is the innermost one, so the input is directly a row major
+    // [block_size, blocks] matrix: take the argmax of each contiguous row, splitting
+    // the rows across threads when there is enough work to amortize the dispatch.
+    const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
+    ctx->ParallelFor(0, block_size, static_cast<double>(blocks),
+                     [input_data, output_data, blocks](int64_t first, int64_t last) {
+                       for (int64_t i = first; i < last; ++i)
+                         output_data[i] = RowArgMax(input_data + i * blocks, blocks);
+                     });
+    return Status::OK();
+  }
+
   Eigen::MatrixXf::Index maxIndex;
-  auto matrixData = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks);
+  auto matrixData = ConstEigenMatrixMap<T>(transposed_data, block_size, blocks);
   for (int i = 0; i < block_size; ++i) {
     matrixData.row(i).maxCoeff(&maxIndex);
     *(output_data++) = maxIndex;
@@ -401,14 +579,26 @@ Status ArgMax<T>::Compute(OpKernelContext* ctx) const {
 template <typename T>
 Status ArgMin<T>::Compute(OpKernelContext* ctx) const {
   std::vector<T> transposedInputData;
+  T* transposed_data = nullptr;
   int64_t block_size, blocks;
   Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
+  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, transposed_data, &reduced, block_size, blocks,
+                                          axes_, keepdims_, true);
 
   int64_t* output_data = reduced->template MutableData<int64_t>();
 
+  if (no_transpose) {
+    const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
+    ctx->ParallelFor(0, block_size, static_cast<double>(blocks),
+                     [input_data, output_data, blocks](int64_t first, int64_t last) {
+                       for (int64_t i = first; i < last; ++i)
+                         output_data[i] = RowArgMin(input_data + i * blocks, blocks);
+                     });
+    return Status::OK();
+  }
+
   Eigen::MatrixXf::Index minIndex;
-  auto matrixData = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks);
+  auto matrixData = ConstEigenMatrixMap<T>(transposed_data, block_size, blocks);
   for (int i = 0; i < block_size; ++i) {
     matrixData.row(i).minCoeff(&minIndex);
     *(output_data++) = minIndex;
@@ -0,0 +1,147 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define ONNXRUNTIME_ROW_ARG_MINMAX_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace onnxruntime {
+
+// Argmax/argmin over one contiguous row [data, data + n). The first occurrence
+// wins on ties, matching the element by element '>'/'<' scans the arg
+// reductions and Hardmax previously performed.
+template <typename T>
+int64_t RowArgMax(const T* data, int64_t n) {
+  int64_t best = 0;
+  for (int64_t i = 1; i < n; ++i) {
+    if (data[i] > data[best])
+      best = i;
+  }
+  return best;
+}
+
+template <typename T>
+int64_t RowArgMin(const T* data, int64_t n) {
+  int64_t best = 0;
+  for (int64_t i = 1; i < n; ++i) {
+    if (data[i] < data[best])
+      best = i;
+  }
+  return best;
+}
+
+#ifdef ONNXRUNTIME_ROW_ARG_MINMAX_SSE2
+// Float specializations. Four lanes race down the row, each keeping the best
+// value and index seen at its stride-4 offsets, and the lanes are reduced once
+// at the row end. Updates use a strict compare so every lane holds the first
+// occurrence of its value; cross-lane ties pick the smallest index, preserving
+// the scalar first-occurrence semantics. Lane indices are int32, so rows too
+// long for them take the scalar loop.
+template <>
+inline int64_t RowArgMax<float>(const float* data, int64_t n) {
+  if (n < 8 || n > std::numeric_limits<int32_t>::max()) {
+    int64_t best = 0;
+    for (int64_t i = 1; i < n; ++i) {
+      if (data[i] > data[best])
+        best = i;
+    }
+    return best;
+  }
+
+  __m128 best_val = _mm_loadu_ps(data);
+  __m128i best_idx = _mm_setr_epi32(0, 1, 2, 3);
+  __m128i idx = _mm_setr_epi32(4, 5, 6, 7);
+  const __m128i idx_step = _mm_set1_epi32(4);
+
+  int64_t i = 4;
+  for (; i + 4 <= n; i += 4) {
+    const __m128 val = _mm_loadu_ps(data + i);
+    const __m128 gt = _mm_cmpgt_ps(val, best_val);
+    best_val = _mm_or_ps(_mm_and_ps(gt, val), _mm_andnot_ps(gt, best_val));
+    const __m128i gt_i = _mm_castps_si128(gt);
+    best_idx = _mm_or_si128(_mm_and_si128(gt_i, idx), _mm_andnot_si128(gt_i, best_idx));
+    idx = _mm_add_epi32(idx, idx_step);
+  }
+
+  float lane_vals[4];
+  int32_t lane_idxs[4];
+  _mm_storeu_ps(lane_vals, best_val);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(lane_idxs), best_idx);
+
+  float value = lane_vals[0];
+  int64_t best = lane_idxs[0];
+  for (int lane = 1; lane < 4; ++lane) {
+    if (lane_vals[lane] > value || (lane_vals[lane] == value && lane_idxs[lane] < best)) {
+      value = lane_vals[lane];
+      best = lane_idxs[lane];
+    }
+  }
+
+  for (; i < n; ++i) {
+    if (data[i] > value) {
+      value = data[i];
+      best = i;
+    }
+  }
+
+  return best;
+}
+
+template <>
+inline int64_t RowArgMin<float>(const float* data, int64_t n) {
+  if (n < 8 || n > std::numeric_limits<int32_t>::max()) {
+    int64_t best = 0;
+    for (int64_t i = 1; i < n; ++i) {
+      if (data[i] < data[best])
+        best = i;
+    }
+    return best;
+  }
+
+  __m128 best_val = _mm_loadu_ps(data);
+  __m128i best_idx = _mm_setr_epi32(0, 1, 2, 3);
+  __m128i idx = _mm_setr_epi32(4, 5, 6, 7);
+  const __m128i idx_step = _mm_set1_epi32(4);
+
+  int64_t i = 4;
+  for (; i + 4 <= n; i += 4) {
+    const __m128 val = _mm_loadu_ps(data + i);
+    const __m128 lt = _mm_cmplt_ps(val, best_val);
+    best_val = _mm_or_ps(_mm_and_ps(lt, val), _mm_andnot_ps(lt, best_val));
+    const __m128i lt_i = _mm_castps_si128(lt);
+    best_idx = _mm_or_si128(_mm_and_si128(lt_i, idx), _mm_andnot_si128(lt_i, best_idx));
+    idx = _mm_add_epi32(idx, idx_step);
+  }
+
+  float lane_vals[4];
+  int32_t lane_idxs[4];
+  _mm_storeu_ps(lane_vals, best_val);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(lane_idxs), best_idx);
+
+  float value = lane_vals[0];
+  int64_t best = lane_idxs[0];
+  for (int lane = 1; lane < 4; ++lane) {
+    if (lane_vals[lane] < value || (lane_vals[lane] == value && lane_idxs[lane] < best)) {
+      value = lane_vals[lane];
+      best = lane_idxs[lane];
+    }
+  }
+
+  for (; i < n; ++i) {
+    if (data[i] < value) {
+      value = data[i];
+      best = i;
+    }
+  }
+
+  return best;
+}
+#endif  // ONNXRUNTIME_ROW_ARG_MINMAX_SSE2
+
+}  // namespace onnxruntime
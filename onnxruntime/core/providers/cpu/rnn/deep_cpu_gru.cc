@@ -156,104 +156,6 @@ ONNX_CPU_OPERATOR_KERNEL(
 
 using namespace rnn::detail;
 
-// internal helper code
-namespace detail {
-
-/// The class represents DeepCPU implementation of a gated recurrent unit (GRU) operator.
-/// For details, refer to http://aka.ms/dl-optimization/.
-template <typename T>
-class UniDirectionalGru {
- public:
-  UniDirectionalGru(AllocatorPtr allocator,
-                    const logging::Logger& logger,
-                    const int seq_length,
-                    const int batch_size,
-                    const int input_size,
-                    const int hidden_size,
-                    const bool linear_before_reset,
-                    Direction direction,
-                    const gsl::span<const T>& bias,
-                    const gsl::span<const T>& initial_hidden_state,
-                    const ActivationFuncs::Entry& activation_func_f,
-                    const ActivationFuncs::Entry& activation_func_g,
-                    const float clip,
-                    TaskThreadPool& ttp);
-
-  void Compute(const gsl::span<const T>& inputs,
-               const gsl::span<const int>& sequence_lengths,
-               const int num_directions,
-               const gsl::span<const T>& input_weights,
-               const gsl::span<const T>& recurrent_weights,
-               gsl::span<T>& outputs,
-               gsl::span<T>& final_hidden_state);
-
-  ~UniDirectionalGru() = default;
-
- private:
-  AllocatorPtr allocator_;
-  const logging::Logger& logger_;
-  TaskThreadPool& ttp_;
-
-  int seq_length_;
-  int batch_size_;
-  int input_size_;
-  int hidden_size_;
-  bool linear_before_reset_;
-
-  const float clip_;
-
-  Direction direction_;
-  bool use_bias_;
-  bool batch_parallel_;
-
-  int hidden_num_threads_ = -1;
-
-  IAllocatorUniquePtr<T> outputZRH_ptr_;
-  gsl::span<T> outputZRH_;
-
-  IAllocatorUniquePtr<T> cur_h_ptr_;
-  IAllocatorUniquePtr<T> batched_hidden0_ptr_;
-  IAllocatorUniquePtr<int> sequence_lengths_ptr_;
-  gsl::span<T> cur_h_;
-  gsl::span<T> batched_hidden0_;
-  gsl::span<int> sequence_lengths_;
-
-  // Wb[zr] and Rb[zr] can always be added together upfront, and repeated to match the batch size for
-  // faster GEMM calculations, so these two members are all the
-  // Wb[z] + Rb[z] values added together, repeated batch_size_ times
-  IAllocatorUniquePtr<T> batched_bias_WRz_ptr_, batched_bias_WRr_ptr_;
-  gsl::span<T> batched_bias_WRz_, batched_bias_WRr_;
-
-  // Wbh and Rbh can only be combined upfront if linear_before_reset_ is false
-  IAllocatorUniquePtr<T> batched_bias_WRh_ptr_;
-  gsl::span<T> batched_bias_WRh_;
-
-  // if linear_before_reset_ is true, we need to setup Wbh and Rbh separately
-  IAllocatorUniquePtr<T> batched_bias_Wh_ptr_, batched_bias_Rh_ptr_;
-  gsl::span<T> batched_bias_Wh_, batched_bias_Rh_;
-
-  IAllocatorUniquePtr<T> linear_output_ptr_;
-  gsl::span<T> linear_output_;
-
-  IAllocatorUniquePtr<T> inputs_reverse_ptr_;
-  IAllocatorUniquePtr<T> outputs_reverse_ptr_;
-  gsl::span<T> inputs_reverse_;
-  gsl::span<T> outputs_reverse_;
-
-  deepcpu::ClipWithBiasFuncPtr clip_with_bias_ptr_ = nullptr;
-
-  float zr_alpha_ = 0.f, zr_beta_ = 0.f;
-  float h_alpha_ = 0.f, h_beta_ = 0.f;
-
-  deepcpu::GruResetGateFuncPtr reset_gate_ = nullptr;
-  deepcpu::ActivationFuncPtr update_gate_ = nullptr;
-  deepcpu::GruOutputGateFuncPtr output_gate_ = nullptr;
-
-  void AllocateBuffers();
-  void SetNumThreads();
-};
-}  // namespace detail
-
 // #define DUMP_MATRIXES to provide lots of diagnostic output
 #if defined(DUMP_MATRIXES)
 #define DumpMatrix(...) ::onnxruntime::rnn::detail::DumpMatrixImpl(__VA_ARGS__)
@@ -280,6 +182,76 @@ Status DeepCpuGruOp::Compute(OpKernelContext* context) const {
   return status;
 }
 
+#if defined(USE_MLAS)
+void DeepCpuGruOp::PackInputWeights(const Tensor& weights, const OpKernelInfo& info) {
+  const auto& shape = weights.Shape();
+  if (weights.DataType() != DataTypeImpl::GetType<float>() || shape.NumDimensions() != 3)
+    return;
+
+  // W is [num_directions, 3*hidden_size, input_size] and is consumed transposed
+  // by ComputeGemm, which is the layout MlasSgemmPackB expects for a CblasTrans B matrix
+  const size_t N = static_cast<size_t>(shape[1]);
+  const size_t K = static_cast<size_t>(shape[2]);
+
+  packed_input_weights_stride_ = MlasSgemmPackBSize(N, K);
+
+  auto alloc = info.GetExecutionProvider()->GetAllocator(0, ONNXRuntimeMemTypeDefault);
+  packed_input_weights_ = IAllocator::MakeUniquePtr<void>(alloc, packed_input_weights_stride_ * num_directions_);
+  if (!packed_input_weights_) {
+    packed_input_weights_stride_ = 0;
+    return;
+  }
+
+  const float* weights_data = weights.Data<float>();
+  auto* packed_weights_data = static_cast<uint8_t*>(packed_input_weights_.get());
+
+  for (int i = 0; i < num_directions_; i++) {
+    MlasSgemmPackB(CblasTrans, N, K, weights_data, K, packed_weights_data);
+    weights_data += N * K;
+    packed_weights_data += packed_input_weights_stride_;
+  }
+}
+
+void DeepCpuGruOp::PackRecurrentWeights(const Tensor& weights, const OpKernelInfo& info) {
+  const auto& shape = weights.Shape();
+  if (weights.DataType() != DataTypeImpl::GetType<float>() || shape.NumDimensions() != 3)
+    return;
+
+  // R is [num_directions, 3*hidden_size, hidden_size], but the per-step GEMMs
+  // multiply against the R[zr] and Rh sub-matrices separately so each is packed
+  // as its own CblasTrans B matrix.
+  const size_t K = static_cast<size_t>(shape[2]);
+  const size_t N_ZR = 2 * K;
+  const size_t N_H = K;
+
+  packed_recurrent_ZR_stride_ = MlasSgemmPackBSize(N_ZR, K);
+  packed_recurrent_H_stride_ = MlasSgemmPackBSize(N_H, K);
+
+  auto alloc = info.GetExecutionProvider()->GetAllocator(0, ONNXRuntimeMemTypeDefault);
+  packed_recurrent_ZR_ = IAllocator::MakeUniquePtr<void>(alloc, packed_recurrent_ZR_stride_ * num_directions_);
+  packed_recurrent_H_ = IAllocator::MakeUniquePtr<void>(alloc, packed_recurrent_H_stride_ * num_directions_);
+  if (!packed_recurrent_ZR_ || !packed_recurrent_H_) {
+    packed_recurrent_ZR_.reset();
+    packed_recurrent_H_.reset();
+    packed_recurrent_ZR_stride_ = 0;
+    packed_recurrent_H_stride_ = 0;
+    return;
+  }
+
+  const float* weights_data = weights.Data<float>();
+  auto* packed_ZR_data = static_cast<uint8_t*>(packed_recurrent_ZR_.get());
+  auto* packed_H_data = static_cast<uint8_t*>(packed_recurrent_H_.get());
+
+  for (int i = 0; i < num_directions_; i++) {
+    MlasSgemmPackB(CblasTrans, N_ZR, K, weights_data, K, packed_ZR_data);
+    MlasSgemmPackB(CblasTrans, N_H, K, weights_data + N_ZR * K, K, packed_H_data);
+    weights_data += 3 * K * K;
+    packed_ZR_data += packed_recurrent_ZR_stride_;
+    packed_H_data += packed_recurrent_H_stride_;
+  }
+}
+#endif
+
 template <typename T>
 Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
   auto& logger = context.Logger();
@@ -355,6 +327,34 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
 
   gsl::span<T> hidden_output_1 = hidden_output.subspan(0, hidden_output_size_per_direction);
 
+  // packed weights are only available when W and R are constant initializers
+  const void* packed_input_weights_1 = nullptr;
+  const void* packed_recurrent_ZR_1 = nullptr;
+  const void* packed_recurrent_H_1 = nullptr;
+  const void* packed_input_weights_2 = nullptr;
+  const void* packed_recurrent_ZR_2 = nullptr;
+  const void* packed_recurrent_H_2 = nullptr;
+
+#if defined(USE_MLAS)
+  if (packed_input_weights_) {
+    packed_input_weights_1 = packed_input_weights_.get();
+    packed_input_weights_2 =
+        static_cast<const uint8_t*>(packed_input_weights_.get()) + packed_input_weights_stride_;
+  }
+
+  if (packed_recurrent_ZR_) {
+    packed_recurrent_ZR_1 = packed_recurrent_ZR_.get();
+    packed_recurrent_ZR_2 =
+        static_cast<const uint8_t*>(packed_recurrent_ZR_.get()) + packed_recurrent_ZR_stride_;
+  }
+
+  if (packed_recurrent_H_) {
+    packed_recurrent_H_1 = packed_recurrent_H_.get();
+    packed_recurrent_H_2 =
+        static_cast<const uint8_t*>(packed_recurrent_H_.get()) + packed_recurrent_H_stride_;
+  }
+#endif
+
   if (direction_ == Direction::kBidirectional) {
     // spans for second direction
     gsl::span<const T> input_weights_2 = input_weights.subspan(input_weights_size_per_direction,
@@ -383,7 +383,8 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
               activation_funcs_.Entries()[0],
               activation_funcs_.Entries()[1],
               clip_, ttp_);
-          fw->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1);
+          fw->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1,
+                      packed_input_weights_1, packed_recurrent_ZR_1, packed_recurrent_H_1, output_1, hidden_output_1);
         }};
     auto task_results_fw = task_fw.get_future();
     ttp_.RunTask(std::move(task_fw));
@@ -395,7 +396,8 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
         activation_funcs_.Entries()[2],
         activation_funcs_.Entries()[3],
         clip_, ttp_);
-    bw->Compute(input, sequence_lens_span, num_directions_, input_weights_2, recurrent_weights_2, output_2, hidden_output_2);
+    bw->Compute(input, sequence_lens_span, num_directions_, input_weights_2, recurrent_weights_2,
+                packed_input_weights_2, packed_recurrent_ZR_2, packed_recurrent_H_2, output_2, hidden_output_2);
 
     task_results_fw.get();
   } else {
@@ -407,7 +409,8 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
         activation_funcs_.Entries()[1],
         clip_, ttp_);
 
-    gru_p->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1);
+    gru_p->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1,
+                   packed_input_weights_1, packed_recurrent_ZR_1, packed_recurrent_H_1, output_1, hidden_output_1);
   }
 
   if (!output.empty())
@@ -461,6 +464,15 @@ UniDirectionalGru<T>::UniDirectionalGru(AllocatorPtr allocator,
   h_alpha_ = activation_func_g.alpha;
   h_beta_ = activation_func_g.beta;
 
+#if defined(USE_MLAS)
+  // the default sigmoid/tanh activation set with no clipping can be applied
+  // with fused vectorized passes over the [z|r|h] gate rows
+  use_fused_gates_ = clip_ == std::numeric_limits<float>::max() &&
+                     reset_gate_ == &deepcpu::gru_reset_gate_sigmoid &&
+                     update_gate_ == &deepcpu::sigmoid &&
+                     output_gate_ == &deepcpu::gru_output_gate_tanh;
+#endif
+
   SetNumThreads();
   AllocateBuffers();
 
@@ -500,6 +512,19 @@ UniDirectionalGru<T>::UniDirectionalGru(AllocatorPtr allocator,
     } else {
       combine_and_replicate(bias_Wo, bias_Ro, batched_bias_WRh_);
     }
+
+#if defined(USE_MLAS)
+    if (use_fused_gates_) {
+      // concatenate the combined z and r biases to match the [z|r] layout of an
+      // outputZRH_ row. when linear_before_reset_ is set Rbh is applied through
+      // linear_output_, so only Wbh is added in the fused pass.
+      for (int i = 0; i < hidden_size_; ++i) {
+        fused_bias_WRzr_[i] = bias_Wz[i] + bias_Rz[i];
+        fused_bias_WRzr_[hidden_size_ + i] = bias_Wr[i] + bias_Rr[i];
+        fused_bias_h_[i] = linear_before_reset_ ? bias_Wo[i] : bias_Wo[i] + bias_Ro[i];
+      }
+    }
+#endif
   }
 
   if (!initial_hidden_state.empty()) {
@@ -513,8 +538,17 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
                                    const int num_directions,
                                    const gsl::span<const T>& input_weights,
                                    const gsl::span<const T>& recurrent_weights,
+                                   const void* packed_input_weights,
+                                   const void* packed_recurrent_ZR,
+                                   const void* packed_recurrent_H,
                                    gsl::span<T>& outputs,
                                    gsl::span<T>& final_hidden_state) {
+#if !defined(USE_MLAS)
+  ONNXRUNTIME_UNUSED_PARAMETER(packed_input_weights);
+  ONNXRUNTIME_UNUSED_PARAMETER(packed_recurrent_ZR);
+  ONNXRUNTIME_UNUSED_PARAMETER(packed_recurrent_H);
+#endif
+
   using span_T_const_iter = typename gsl::span<T>::const_iterator;
   using span_T_iter = typename gsl::span<T>::iterator;
 
@@ -562,13 +596,26 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
   float beta = 0.0f;  // zero out outputZRH_ when calling ComputeGemm.
 
   // apply weights to all the inputs
-  ComputeGemm(total_rows, hidden_size_x3, input_size_, alpha,
-              inputs.cbegin(), inputs.cend(),
-              input_size_,
-              input_weights.cbegin(), input_weights.cend(),
-              input_size_, beta,
-              outputZRH_.begin(), outputZRH_.end(),
-              hidden_size_x3);
+#if defined(USE_MLAS)
+  if (packed_input_weights != nullptr) {
+    ComputeGemm(total_rows, hidden_size_x3, input_size_, alpha,
+                inputs.cbegin(), inputs.cend(),
+                input_size_,
+                packed_input_weights,  // W[zrh] in MlasSgemmPackB layout
+                beta,
+                outputZRH_.begin(), outputZRH_.end(),
+                hidden_size_x3);
+  } else
+#endif
+  {
+    ComputeGemm(total_rows, hidden_size_x3, input_size_, alpha,
+                inputs.cbegin(), inputs.cend(),
+                input_size_,
+                input_weights.cbegin(), input_weights.cend(),
+                input_size_, beta,
+                outputZRH_.begin(), outputZRH_.end(),
+                hidden_size_x3);
+  }
 
   DumpMatrix("inputs with weights applied", outputZRH_.data(), seq_length_ * batch_size_ * 3, hidden_size_);
 
@@ -640,13 +687,26 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
         out_added_offset = (step * batch_size_ + row) * hidden_size_x3;
 
         // calculate Ht-1*R[zr], and add to the weighted inputs that are in outputZRH_
-        ComputeGemm(local_fused_hidden_rows, hidden_size_x2, hidden_size_, alpha,
-                    prev_Ht, prev_Ht_end,
-                    hidden_size_,
-                    recurrent_weightsZR.cbegin(), recurrent_weightsZR.cend(),
-                    hidden_size_, beta,
-                    outputZRH_.begin() + out_added_offset, outputZRH_.end(),
-                    hidden_size_x3);
+#if defined(USE_MLAS)
+        if (packed_recurrent_ZR != nullptr) {
+          ComputeGemm(local_fused_hidden_rows, hidden_size_x2, hidden_size_, alpha,
+                      prev_Ht, prev_Ht_end,
+                      hidden_size_,
+                      packed_recurrent_ZR,  // R[zr] in MlasSgemmPackB layout
+                      beta,
+                      outputZRH_.begin() + out_added_offset, outputZRH_.end(),
+                      hidden_size_x3);
+        } else
+#endif
+        {
+          ComputeGemm(local_fused_hidden_rows, hidden_size_x2, hidden_size_, alpha,
+                      prev_Ht, prev_Ht_end,
+                      hidden_size_,
+                      recurrent_weightsZR.cbegin(), recurrent_weightsZR.cend(),
+                      hidden_size_, beta,
+                      outputZRH_.begin() + out_added_offset, outputZRH_.end(),
+                      hidden_size_x3);
+        }
 
         DumpMatrix("Xt*(W[zr]^T) + Ht-1 * R[zr]" + row_str,
                    outputZRH_.data() + out_added_offset, local_fused_hidden_rows, hidden_size_x2, 0, hidden_size_x3);
@@ -657,19 +717,57 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
                     linear_output_.subspan(linear_output_local - linear_output_.begin(), linear_output_local_end - linear_output_local));
 
           // compute Ht-1 * (Rh^T) + Rbh
-          ComputeGemm(local_fused_hidden_rows, hidden_size_, hidden_size_, alpha,
-                      prev_Ht, prev_Ht_end,  // Ht-1
-                      hidden_size_,
-                      recurrent_weightsH.cbegin(), recurrent_weightsH.cend(),  // Rh^T
-                      hidden_size_, beta,
-                      linear_output_local, linear_output_.end(),  // pre: Rbh, post:output
-                      hidden_size_);
+#if defined(USE_MLAS)
+          if (packed_recurrent_H != nullptr) {
+            ComputeGemm(local_fused_hidden_rows, hidden_size_, hidden_size_, alpha,
+                        prev_Ht, prev_Ht_end,  // Ht-1
+                        hidden_size_,
+                        packed_recurrent_H,  // Rh in MlasSgemmPackB layout
+                        beta,
+                        linear_output_local, linear_output_.end(),  // pre: Rbh, post:output
+                        hidden_size_);
+          } else
+#endif
+          {
+            ComputeGemm(local_fused_hidden_rows, hidden_size_, hidden_size_, alpha,
+                        prev_Ht, prev_Ht_end,  // Ht-1
+                        hidden_size_,
+                        recurrent_weightsH.cbegin(), recurrent_weightsH.cend(),  // Rh^T
+                        hidden_size_, beta,
+                        linear_output_local, linear_output_.end(),  // pre: Rbh, post:output
+                        hidden_size_);
+          }
 
           DumpMatrix("Ht-1 * (Rh^T) + Rbh " + row_str, &*linear_output_local, batch_size_, hidden_size_);
         }
 
         // 1st Set Of Activations
         for (int r = 0; r < local_fused_hidden_rows; r++) {
+#if defined(USE_MLAS)
+          if (use_fused_gates_) {
+            // apply the bias and both sigmoid gates in one vectorized pass.
+            // the row layout is [z|r|h] so the z and r entries are contiguous.
+            T* p_zr = SafeRawPointer<T>(outputZRH_, out_added_offset + r * hidden_size_x3, hidden_size_x2);
+            if (use_bias_)
+              deepcpu::elementwise_sum1(SafeRawConstPointer<T>(fused_bias_WRzr_, 0, hidden_size_x2),
+                                        p_zr, hidden_size_x2);
+            MlasComputeLogistic(p_zr, p_zr, hidden_size_x2);
+
+            const T* p_rt = p_zr + hidden_size_;
+            const T* p_src = linear_before_reset_
+                                 ? SafeRawConstPointer<T>(linear_output_local + r * hidden_size_,
+                                                          linear_output_local_end, hidden_size_)
+                                 : SafeRawConstPointer<T>(prev_Ht + r * hidden_size_, prev_Ht_end, hidden_size_);
+            T* p_cur_h = SafeRawPointer<T>(cur_h_local + r * hidden_size_, cur_h_local_end, hidden_size_);
+
+            // rt (.) Ht-1, or rt (.) (Ht-1*(Rh^T) + Rbh) when linear_before_reset_
+            for (int i = 0; i < hidden_size_; i++)
+              p_cur_h[i] = p_rt[i] * p_src[i];
+
+            continue;
+          }
+#endif
+
           const T* p_bias_r = use_bias_ ? SafeRawConstPointer<T>(batched_bias_WRr_local + r * hidden_size_,
                                                                  batched_bias_WRr_local_end, hidden_size_)
                                         : nullptr;
@@ -720,13 +818,26 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
           }
         } else {
           label += " * Rh^T";
-          ComputeGemm(local_fused_hidden_rows, hidden_size_, hidden_size_, alpha,
-                      cur_h_local, cur_h_local_end,
-                      hidden_size_,
-                      recurrent_weightsH.cbegin(), recurrent_weightsH.cend(),
-                      hidden_size_, beta,
-                      outputZRH_.begin() + out_added_offset + hidden_size_x2, outputZRH_.end(),
-                      hidden_size_x3);
+#if defined(USE_MLAS)
+          if (packed_recurrent_H != nullptr) {
+            ComputeGemm(local_fused_hidden_rows, hidden_size_, hidden_size_, alpha,
+                        cur_h_local, cur_h_local_end,
+                        hidden_size_,
+                        packed_recurrent_H,  // Rh in MlasSgemmPackB layout
+                        beta,
+                        outputZRH_.begin() + out_added_offset + hidden_size_x2, outputZRH_.end(),
+                        hidden_size_x3);
+          } else
+#endif
+          {
+            ComputeGemm(local_fused_hidden_rows, hidden_size_, hidden_size_, alpha,
+                        cur_h_local, cur_h_local_end,
+                        hidden_size_,
+                        recurrent_weightsH.cbegin(), recurrent_weightsH.cend(),
+                        hidden_size_, beta,
+                        outputZRH_.begin() + out_added_offset + hidden_size_x2, outputZRH_.end(),
+                        hidden_size_x3);
+          }
         }
 
         DumpMatrix("Xt*(Wh^T) + (" + label + ")" + row_str,
@@ -755,6 +866,28 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
             continue;
           }
 
+#if defined(USE_MLAS)
+          if (use_fused_gates_) {
+            // zt was already computed with the fused pass over [z|r] above
+            const T* p_zt = SafeRawPointer<T>(outputZRH_, out_added_offset + r * hidden_size_x3, hidden_size_);
+            T* p_ht = SafeRawPointer<T>(outputZRH_, out_added_offset + r * hidden_size_x3 + hidden_size_x2,
+                                        hidden_size_);
+            if (use_bias_)
+              deepcpu::elementwise_sum1(SafeRawConstPointer<T>(fused_bias_h_, 0, hidden_size_),
+                                        p_ht, hidden_size_);
+            MlasComputeTanh(p_ht, p_ht, hidden_size_);
+
+            const T* p_prev_Ht = SafeRawConstPointer<T>(prev_Ht + r * hidden_size_, prev_Ht_end, hidden_size_);
+            T* p_Ht = SafeRawPointer<T>(output + r * hidden_size_, output_end, hidden_size_);
+
+            // Ht = (1 - zt) (.) ht + zt (.) Ht-1
+            for (int i = 0; i < hidden_size_; i++)
+              p_Ht[i] = p_ht[i] + p_zt[i] * (p_prev_Ht[i] - p_ht[i]);
+
+            continue;
+          }
+#endif
+
           const T* p_bias_z = use_bias_ ? SafeRawConstPointer<T>(batched_bias_WRz_local, batched_bias_WRz_local_end,
                                                                  hidden_size_)
                                         : nullptr;
@@ -847,13 +980,26 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
 
       // calculate Ht-1*R[zr], and add to the weighted inputs that are in outputZRH_
       // Ht-1 * R[zr] + Xt*(W[zr]^T)
-      ComputeGemm(batch_size_, hidden_size_x2, hidden_size_, alpha,
-                  prev_Ht, prev_Ht_end,
-                  hidden_size_,
-                  recurrent_weightsZR.cbegin(), recurrent_weightsZR.cend(),
-                  hidden_size_, beta,
-                  outputZRH_.begin() + out_added_offset, outputZRH_.end(),
-                  hidden_size_x3);
+#if defined(USE_MLAS)
+      if (packed_recurrent_ZR != nullptr) {
+        ComputeGemm(batch_size_, hidden_size_x2, hidden_size_, alpha,
+                    prev_Ht, prev_Ht_end,
+                    hidden_size_,
+                    packed_recurrent_ZR,  // R[zr] in MlasSgemmPackB layout
+                    beta,
+                    outputZRH_.begin() + out_added_offset, outputZRH_.end(),
+                    hidden_size_x3);
+      } else
+#endif
+      {
+        ComputeGemm(batch_size_, hidden_size_x2, hidden_size_, alpha,
+                    prev_Ht, prev_Ht_end,
+                    hidden_size_,
+                    recurrent_weightsZR.cbegin(), recurrent_weightsZR.cend(),
+                    hidden_size_, beta,
+                    outputZRH_.begin() + out_added_offset, outputZRH_.end(),
+                    hidden_size_x3);
+      }
 
       DumpMatrix("Ht-1 * R[zr] + Xt*(W[zr]^T)" + seqno_str,
                  outputZRH_.data() + out_added_offset, batch_size_, hidden_size_x2, 0, hidden_size_x3);
@@ -863,19 +1009,56 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
         gsl::copy(batched_bias_Rh_.subspan(batched_bias_Rh_local - batched_bias_Rh_.begin(), batched_bias_Rh_local_end - batched_bias_Rh_local), linear_output_);
 
         // compute Ht-1 * (Rh^T) + Rbh
-        ComputeGemm(batch_size_, hidden_size_, hidden_size_, alpha,
-                    prev_Ht, prev_Ht_end,  // Ht-1
-                    hidden_size_,
-                    recurrent_weightsH.cbegin(), recurrent_weightsH.cend(),  // Rh^T
-                    hidden_size_, beta,
-                    linear_output_.begin(), linear_output_.end(),  // pre: Rbh, post:output
-                    hidden_size_);
+#if defined(USE_MLAS)
+        if (packed_recurrent_H != nullptr) {
+          ComputeGemm(batch_size_, hidden_size_, hidden_size_, alpha,
+                      prev_Ht, prev_Ht_end,  // Ht-1
+                      hidden_size_,
+                      packed_recurrent_H,  // Rh in MlasSgemmPackB layout
+                      beta,
+                      linear_output_.begin(), linear_output_.end(),  // pre: Rbh, post:output
+                      hidden_size_);
+        } else
+#endif
+        {
+          ComputeGemm(batch_size_, hidden_size_, hidden_size_, alpha,
+                      prev_Ht, prev_Ht_end,  // Ht-1
+                      hidden_size_,
+                      recurrent_weightsH.cbegin(), recurrent_weightsH.cend(),  // Rh^T
+                      hidden_size_, beta,
+                      linear_output_.begin(), linear_output_.end(),  // pre: Rbh, post:output
+                      hidden_size_);
+        }
 
         DumpMatrix("Ht-1 * (Rh^T) + Rbh " + seqno_str, linear_output_.data(), batch_size_, hidden_size_);
       }
 
       // 1st Set Of Activations
       for (int r = 0; r < batch_size_; r++) {
+#if defined(USE_MLAS)
+        if (use_fused_gates_) {
+          // apply the bias and both sigmoid gates in one vectorized pass.
+          // the row layout is [z|r|h] so the z and r entries are contiguous.
+          T* p_zr = SafeRawPointer<T>(outputZRH_, out_added_offset + r * hidden_size_x3, hidden_size_x2);
+          if (use_bias_)
+            deepcpu::elementwise_sum1(SafeRawConstPointer<T>(fused_bias_WRzr_, 0, hidden_size_x2),
+                                      p_zr, hidden_size_x2);
+          MlasComputeLogistic(p_zr, p_zr, hidden_size_x2);
+
+          const T* p_rt = p_zr + hidden_size_;
+          const T* p_src = linear_before_reset_
+                               ? SafeRawConstPointer<T>(linear_output_, r * hidden_size_, hidden_size_)
+                               : SafeRawConstPointer<T>(prev_Ht + r * hidden_size_, prev_Ht_end, hidden_size_);
+          T* p_cur_h = SafeRawPointer<T>(cur_h_local + r * hidden_size_, cur_h_local_end, hidden_size_);
+
+          // rt (.) Ht-1, or rt (.) (Ht-1*(Rh^T) + Rbh) when linear_before_reset_
+          for (int i = 0; i < hidden_size_; i++)
+            p_cur_h[i] = p_rt[i] * p_src[i];
+
+          continue;
+        }
+#endif
+
         const T* p_bias_r = use_bias_ ? SafeRawConstPointer<T>(batched_bias_WRr_local + r * hidden_size_,
                                                                batched_bias_WRr_local_end, hidden_size_)
                                       : nullptr;
@@ -930,13 +1113,26 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
         auto out_H = outputZRH_.begin() + out_added_offset + hidden_size_x2;
 
         // Calculate Xt*(Wh^T) + rt (.) Ht-1 * Rh
-        ComputeGemm(batch_size_, hidden_size_, hidden_size_, alpha,
-                    cur_h_local, cur_h_local_end,  // rt (.) Ht-1
-                    hidden_size_,
-                    recurrent_weightsH.cbegin(), recurrent_weightsH.cend(),  // Rh^T
-                    hidden_size_, beta,
-                    out_H, outputZRH_.end(),
-                    hidden_size_x3);
+#if defined(USE_MLAS)
+        if (packed_recurrent_H != nullptr) {
+          ComputeGemm(batch_size_, hidden_size_, hidden_size_, alpha,
+                      cur_h_local, cur_h_local_end,  // rt (.) Ht-1
+                      hidden_size_,
+                      packed_recurrent_H,  // Rh in MlasSgemmPackB layout
+                      beta,
+                      out_H, outputZRH_.end(),
+                      hidden_size_x3);
+        } else
+#endif
+        {
+          ComputeGemm(batch_size_, hidden_size_, hidden_size_, alpha,
+                      cur_h_local, cur_h_local_end,  // rt (.) Ht-1
+                      hidden_size_,
+                      recurrent_weightsH.cbegin(), recurrent_weightsH.cend(),  // Rh^T
+                      hidden_size_, beta,
+                      out_H, outputZRH_.end(),
+                      hidden_size_x3);
+        }
       }
 
       DumpMatrix("Xt*(Wh^T) + (" + label + ")" + seqno_str, outputZRH_.data() + out_added_offset,
@@ -964,6 +1160,28 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
           continue;
         }
 
+#if defined(USE_MLAS)
+        if (use_fused_gates_) {
+          // zt was already computed with the fused pass over [z|r] above
+          const T* p_zt = SafeRawPointer<T>(outputZRH_, out_added_offset + r * hidden_size_x3, hidden_size_);
+          T* p_ht = SafeRawPointer<T>(outputZRH_, out_added_offset + r * hidden_size_x3 + hidden_size_x2,
+                                      hidden_size_);
+          if (use_bias_)
+            deepcpu::elementwise_sum1(SafeRawConstPointer<T>(fused_bias_h_, 0, hidden_size_),
+                                      p_ht, hidden_size_);
+          MlasComputeTanh(p_ht, p_ht, hidden_size_);
+
+          const T* p_prev_Ht = SafeRawConstPointer<T>(prev_Ht + r * hidden_size_, prev_Ht_end, hidden_size_);
+          T* p_Ht = SafeRawPointer<T>(output + r * hidden_size_, output_end, hidden_size_);
+
+          // Ht = (1 - zt) (.) ht + zt (.) Ht-1
+          for (int i = 0; i < hidden_size_; i++)
+            p_Ht[i] = p_ht[i] + p_zt[i] * (p_prev_Ht[i] - p_ht[i]);
+
+          continue;
+        }
+#endif
+
         const T* p_bias_z = use_bias_ ? SafeRawConstPointer<T>(batched_bias_WRz_local,
                                                                batched_bias_WRz_local_end, hidden_size_)
                                       : nullptr;
@@ -1051,6 +1269,13 @@ void UniDirectionalGru<T>::AllocateBuffers() {
     } else {
       batched_bias_WRh_ = Allocate(allocator_, batch_size_ * hidden_size_, batched_bias_WRh_ptr_);
     }
+
+#if defined(USE_MLAS)
+    if (use_fused_gates_) {
+      fused_bias_WRzr_ = Allocate(allocator_, 2 * hidden_size_, fused_bias_WRzr_ptr_);
+      fused_bias_h_ = Allocate(allocator_, hidden_size_, fused_bias_h_ptr_);
+    }
+#endif
   }
 
   auto batch_times_seq_length = batch_size_ * seq_length_;
@@ -1087,5 +1312,8 @@ void UniDirectionalGru<T>::SetNumThreads() {
 
   ONNXRUNTIME_ENFORCE(hidden_num_threads_ >= 1);
 }
+
+template class UniDirectionalGru<float>;
+
 }  // namespace detail
 }  // namespace onnxruntime
@@ -12,6 +12,118 @@
 
 namespace onnxruntime {
 
+// internal helper code
+namespace detail {
+
+/// The class represents DeepCPU implementation of a gated recurrent unit (GRU) operator.
+/// For details, refer to http://aka.ms/dl-optimization/.
+/// Declared here so the fused multi-layer GRU kernel can stream hidden states from
+/// one layer to the next without materializing intermediate tensors between nodes.
+template <typename T>
+class UniDirectionalGru {
+ public:
+  UniDirectionalGru(AllocatorPtr allocator,
+                    const logging::Logger& logger,
+                    const int seq_length,
+                    const int batch_size,
+                    const int input_size,
+                    const int hidden_size,
+                    const bool linear_before_reset,
+                    rnn::detail::Direction direction,
+                    const gsl::span<const T>& bias,
+                    const gsl::span<const T>& initial_hidden_state,
+                    const rnn::detail::ActivationFuncs::Entry& activation_func_f,
+                    const rnn::detail::ActivationFuncs::Entry& activation_func_g,
+                    const float clip,
+                    TaskThreadPool& ttp);
+
+  void Compute(const gsl::span<const T>& inputs,
+               const gsl::span<const int>& sequence_lengths,
+               const int num_directions,
+               const gsl::span<const T>& input_weights,
+               const gsl::span<const T>& recurrent_weights,
+               const void* packed_input_weights,
+               const void* packed_recurrent_ZR,
+               const void* packed_recurrent_H,
+               gsl::span<T>& outputs,
+               gsl::span<T>& final_hidden_state);
+
+  ~UniDirectionalGru() = default;
+
+ private:
+  AllocatorPtr allocator_;
+  const logging::Logger& logger_;
+  TaskThreadPool& ttp_;
+
+  int seq_length_;
+  int batch_size_;
+  int input_size_;
+  int hidden_size_;
+  bool linear_before_reset_;
+
+  const float clip_;
+
+  rnn::detail::Direction direction_;
+  bool use_bias_;
+  bool batch_parallel_;
+
+  int hidden_num_threads_ = -1;
+
+  IAllocatorUniquePtr<T> outputZRH_ptr_;
+  gsl::span<T> outputZRH_;
+
+  IAllocatorUniquePtr<T> cur_h_ptr_;
+  IAllocatorUniquePtr<T> batched_hidden0_ptr_;
+  IAllocatorUniquePtr<int> sequence_lengths_ptr_;
+  gsl::span<T> cur_h_;
+  gsl::span<T> batched_hidden0_;
+  gsl::span<int> sequence_lengths_;
+
+  // Wb[zr] and Rb[zr] can always be added together upfront, and repeated to match the batch size for
+  // faster GEMM calculations, so these two members are all the
+  // Wb[z] + Rb[z] values added together, repeated batch_size_ times
+  IAllocatorUniquePtr<T> batched_bias_WRz_ptr_, batched_bias_WRr_ptr_;
+  gsl::span<T> batched_bias_WRz_, batched_bias_WRr_;
+
+  // Wbh and Rbh can only be combined upfront if linear_before_reset_ is false
+  IAllocatorUniquePtr<T> batched_bias_WRh_ptr_;
+  gsl::span<T> batched_bias_WRh_;
+
+  // if linear_before_reset_ is true, we need to setup Wbh and Rbh separately
+  IAllocatorUniquePtr<T> batched_bias_Wh_ptr_, batched_bias_Rh_ptr_;
+  gsl::span<T> batched_bias_Wh_, batched_bias_Rh_;
+
+  IAllocatorUniquePtr<T> linear_output_ptr_;
+  gsl::span<T> linear_output_;
+
+  IAllocatorUniquePtr<T> inputs_reverse_ptr_;
+  IAllocatorUniquePtr<T> outputs_reverse_ptr_;
+  gsl::span<T> inputs_reverse_;
+  gsl::span<T> outputs_reverse_;
+
+#if defined(USE_MLAS)
+  // Wb+Rb for the z and r gates concatenated to match the [z|r] layout of an
+  // outputZRH_ row, plus the W [and R] bias for the h gate, for the fused gate path
+  IAllocatorUniquePtr<T> fused_bias_WRzr_ptr_, fused_bias_h_ptr_;
+  gsl::span<T> fused_bias_WRzr_, fused_bias_h_;
+
+  bool use_fused_gates_ = false;
+#endif
+
+  rnn::detail::deepcpu::ClipWithBiasFuncPtr clip_with_bias_ptr_ = nullptr;
+
+  float zr_alpha_ = 0.f, zr_beta_ = 0.f;
+  float h_alpha_ = 0.f, h_beta_ = 0.f;
+
+  rnn::detail::deepcpu::GruResetGateFuncPtr reset_gate_ = nullptr;
+  rnn::detail::deepcpu::ActivationFuncPtr update_gate_ = nullptr;
+  rnn::detail::deepcpu::GruOutputGateFuncPtr output_gate_ = nullptr;
+
+  void AllocateBuffers();
+  void SetNumThreads();
+};
+}  // namespace detail
+
 /// The class represents GRU operator using DeepCPU implementation for
 /// fast inference computation on CPU machines.
 class DeepCpuGruOp final : public OpKernel {
@@ -51,6 +163,17 @@ class DeepCpuGruOp final : public OpKernel {
     activation_funcs_ = rnn::detail::ActivationFuncs(activation_func_names,
                                                      activation_func_alphas,
                                                      activation_func_betas);
+
+#if defined(USE_MLAS)
+    // W and R are usually constant initializers, so pack them into the MlasSgemm
+    // layout once here instead of repacking them on every call to Compute.
+    const Tensor* W;
+    const Tensor* R;
+    if (info.TryGetConstantInput(1, &W))
+      PackInputWeights(*W, info);
+    if (info.TryGetConstantInput(2, &R))
+      PackRecurrentWeights(*R, info);
+#endif
   }
 
   Status Compute(OpKernelContext* context) const override;
@@ -58,6 +181,22 @@ class DeepCpuGruOp final : public OpKernel {
   ~DeepCpuGruOp() override = default;
 
  private:
+#if defined(USE_MLAS)
+  void PackInputWeights(const Tensor& weights, const OpKernelInfo& info);
+  void PackRecurrentWeights(const Tensor& weights, const OpKernelInfo& info);
+
+  // per-direction packed copies of the W and R inputs when they are constant
+  // initializers. the per-step GEMMs consume the R[zr] and Rh sub-matrices
+  // separately so R is packed as two buffers rather than one.
+  // packed_*_stride_ is the offset in bytes between the per-direction buffers.
+  IAllocatorUniquePtr<void> packed_input_weights_;
+  IAllocatorUniquePtr<void> packed_recurrent_ZR_;
+  IAllocatorUniquePtr<void> packed_recurrent_H_;
+  size_t packed_input_weights_stride_ = 0;
+  size_t packed_recurrent_ZR_stride_ = 0;
+  size_t packed_recurrent_H_stride_ = 0;
+#endif
+
   rnn::detail::Direction direction_;
   int num_directions_;
 
@@ -16,6 +16,10 @@
 #include "core/common/task_thread_pool.h"
 #include "core/framework/allocator.h"
 
+#if defined(USE_MLAS)
+#include "core/mlas/inc/mlas.h"
+#endif
+
 #ifdef _MSC_VER
 #pragma warning(pop)
 #endif
@@ -211,6 +215,8 @@ class UniDirectionalLstm {
                const int num_directions,
                const gsl::span<const T>& input_weights,
                const gsl::span<const T>& recurrent_weights,
+               const void* packed_input_weights,
+               const void* packed_recurrent_weights,
                gsl::span<T>& outputs,
                gsl::span<T>& final_hidden_state,
                gsl::span<T>& final_cell_state);
@@ -273,6 +279,15 @@ class UniDirectionalLstm {
   gsl::span<T> internal_memory_cur_, batched_internal_memory_cur_;
   gsl::span<T> batched_internal_memory_clipped_;
 
+#if defined(USE_MLAS)
+  // bias for all four gates concatenated in the order of an output_iofc_ row,
+  // so the fused gate path can add it in a single pass
+  IAllocatorUniquePtr<T> bias_WRiofc_ptr_;
+  gsl::span<T> bias_WRiofc_;
+
+  bool use_fused_gates_ = false;
+#endif
+
   IAllocatorUniquePtr<T> bias_WRi_ptr_, bias_WRf_ptr_, bias_WRo_ptr_, bias_WRc_ptr_;
   IAllocatorUniquePtr<T> batched_bias_WRi_ptr_, batched_bias_WRf_ptr_, batched_bias_WRo_ptr_, batched_bias_WRc_ptr_;
   IAllocatorUniquePtr<T> peephole_i_ptr_, peephole_f_ptr_, peephole_o_ptr_;
@@ -379,6 +394,27 @@ Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
 
   gsl::span<const T> input_weights_1 = input_weights.subspan(0, input_weights_size_per_direction);
   gsl::span<const T> recurrent_weights_1 = recurrent_weights.subspan(0, hidden_weights_size_per_direction);
+
+  // packed weights are only available when W and R are constant initializers
+  const void* packed_input_weights_1 = nullptr;
+  const void* packed_recurrent_weights_1 = nullptr;
+  const void* packed_input_weights_2 = nullptr;
+  const void* packed_recurrent_weights_2 = nullptr;
+
+#if defined(USE_MLAS)
+  if (packed_input_weights_) {
+    packed_input_weights_1 = packed_input_weights_.get();
+    packed_input_weights_2 =
+        static_cast<const uint8_t*>(packed_input_weights_.get()) + packed_input_weights_stride_;
+  }
+
+  if (packed_recurrent_weights_) {
+    packed_recurrent_weights_1 = packed_recurrent_weights_.get();
+    packed_recurrent_weights_2 =
+        static_cast<const uint8_t*>(packed_recurrent_weights_.get()) + packed_recurrent_weights_stride_;
+  }
+#endif
+
   gsl::span<const T> bias_1 = bias.empty() ? bias : bias.subspan(0, bias_size_per_direction);
   gsl::span<const T> peephole_weights_1 =
       peephole_weights.empty() ? peephole_weights
@@ -477,8 +513,10 @@ Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
                                                          activation_funcs_.Entries()[5],
                                                          clip_, ttp_);
 
-    fw->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1, last_cell_1);
-    bw->Compute(input, sequence_lens_span, num_directions_, input_weights_2, hidden_weights_2, output_2, hidden_output_2, last_cell_2);
+    fw->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1,
+                packed_input_weights_1, packed_recurrent_weights_1, output_1, hidden_output_1, last_cell_1);
+    bw->Compute(input, sequence_lens_span, num_directions_, input_weights_2, hidden_weights_2,
+                packed_input_weights_2, packed_recurrent_weights_2, output_2, hidden_output_2, last_cell_2);
   } else {
     fw = std::make_unique<detail::UniDirectionalLstm<T>>(alloc, logger,
                                                          seq_length, batch_size, input_size,
@@ -489,7 +527,8 @@ Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
                                                          activation_funcs_.Entries()[2],
                                                          clip_, ttp_);
 
-    fw->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1, last_cell_1);
+    fw->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1,
+                packed_input_weights_1, packed_recurrent_weights_1, output_1, hidden_output_1, last_cell_1);
   }
 
   if (!output.empty())
@@ -535,6 +574,39 @@ Status DeepCpuLstmOp::ValidateInputs(const Tensor& X, const Tensor& W, const Ten
   return Status::OK();
 }
 
+#if defined(USE_MLAS)
+void DeepCpuLstmOp::PackWeights(const Tensor& weights, IAllocatorUniquePtr<void>& packed_weights,
+                                size_t& packed_weights_stride, const OpKernelInfo& info) {
+  const auto& shape = weights.Shape();
+  if (weights.DataType() != DataTypeImpl::GetType<float>() || shape.NumDimensions() != 3)
+    return;
+
+  // weights are [num_directions, 4*hidden_size, input_size or hidden_size] and
+  // are consumed transposed by ComputeGemm, which is the layout MlasSgemmPackB
+  // expects for a CblasTrans B matrix
+  const size_t N = static_cast<size_t>(shape[1]);
+  const size_t K = static_cast<size_t>(shape[2]);
+
+  packed_weights_stride = MlasSgemmPackBSize(N, K);
+
+  auto alloc = info.GetExecutionProvider()->GetAllocator(0, ONNXRuntimeMemTypeDefault);
+  packed_weights = IAllocator::MakeUniquePtr<void>(alloc, packed_weights_stride * num_directions_);
+  if (!packed_weights) {
+    packed_weights_stride = 0;
+    return;
+  }
+
+  const float* weights_data = weights.Data<float>();
+  auto* packed_weights_data = static_cast<uint8_t*>(packed_weights.get());
+
+  for (int i = 0; i < num_directions_; i++) {
+    MlasSgemmPackB(CblasTrans, N, K, weights_data, K, packed_weights_data);
+    weights_data += N * K;
+    packed_weights_data += packed_weights_stride;
+  }
+}
+#endif
+
 /*************************************
 *
 * Implementation of UniDirectionalLstm
@@ -586,6 +658,16 @@ UniDirectionalLstm<T>::UniDirectionalLstm(AllocatorPtr allocator,
 
   clip_with_bias_ptr_ = use_bias_ ? deepcpu::clip_add_bias : deepcpu::clip_ignore_bias;
 
+#if defined(USE_MLAS)
+  // the default activation set with no peepholes, gate coupling or clipping can
+  // be applied with a single fused pass over the gate outputs for each row
+  use_fused_gates_ = !use_peepholes_ && !input_forget_ &&
+                     clip_ == std::numeric_limits<float>::max() &&
+                     activation_f_.func == &deepcpu::sigmoid &&
+                     activation_g_.func == &deepcpu::tanh &&
+                     activation_h_.func == &deepcpu::tanh_m;
+#endif
+
   SetNumThreads();
   AllocateBuffers();
   InitializeBuffers(initial_hidden_state, initial_cell_state);
@@ -619,6 +701,11 @@ void UniDirectionalLstm<T>::AllocateBuffers() {
     bias_WRf_ = Allocate(allocator_, hidden_size_, bias_WRf_ptr_);
     bias_WRo_ = Allocate(allocator_, hidden_size_, bias_WRo_ptr_);
     bias_WRc_ = Allocate(allocator_, hidden_size_, bias_WRc_ptr_);
+
+#if defined(USE_MLAS)
+    if (use_fused_gates_)
+      bias_WRiofc_ = Allocate(allocator_, 4 * hidden_size_, bias_WRiofc_ptr_);
+#endif
   }
 
   if (direction_ == kReverse) {
@@ -701,6 +788,15 @@ void UniDirectionalLstm<T>::LoadBias(const gsl::span<const T>& WbRb_values) {
   copy_fused_bias((i++) * hidden_size_, bias_WRf_);
   copy_fused_bias((i++) * hidden_size_, bias_WRc_);
 
+#if defined(USE_MLAS)
+  if (use_fused_gates_) {
+    // concatenate the per-gate values matching the [i|o|f|c] row layout of output_iofc_
+    i = 0;
+    for (const auto& gate_bias : {bias_WRi_, bias_WRo_, bias_WRf_, bias_WRc_})
+      std::copy_n(gate_bias.data(), hidden_size_, bias_WRiofc_.data() + (i++) * hidden_size_);
+  }
+#endif
+
   /*
   i = 0;
   DumpMatrix("Wb[i]", WbRb_values.data() + (i++ * hidden_size_), 1, hidden_size_);
@@ -725,9 +821,16 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
                                     const int num_directions,
                                     const gsl::span<const T>& input_weights,
                                     const gsl::span<const T>& recurrent_weights,
+                                    const void* packed_input_weights,
+                                    const void* packed_recurrent_weights,
                                     gsl::span<T>& outputs,
                                     gsl::span<T>& final_hidden_state,
                                     gsl::span<T>& final_cell_state) {
+#if !defined(USE_MLAS)
+  ONNXRUNTIME_UNUSED_PARAMETER(packed_input_weights);
+  ONNXRUNTIME_UNUSED_PARAMETER(packed_recurrent_weights);
+#endif
+
   // copy spans (just T* and size, not data in span) as we may change them
   gsl::span<const T> inputs = inputs_arg;
   gsl::span<const int> sequence_lengths = sequence_lengths_arg;
@@ -781,13 +884,26 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
   const int total_rows = max_sequence_length * batch_size_;
 
   // apply the weights to all the inputs and save to output_IOFC
-  ComputeGemm(total_rows, hidden_size_x4, input_size_, alpha,
-              inputs.cbegin(), inputs.cend(),
-              input_size_,
-              input_weights.cbegin(), input_weights.cend(),  // W[iofc]
-              input_size_, beta,
-              output_iofc_.begin(), output_iofc_.end(),
-              hidden_size_x4);
+#if defined(USE_MLAS)
+  if (packed_input_weights != nullptr) {
+    ComputeGemm(total_rows, hidden_size_x4, input_size_, alpha,
+                inputs.cbegin(), inputs.cend(),
+                input_size_,
+                packed_input_weights,  // W[iofc] in MlasSgemmPackB layout
+                beta,
+                output_iofc_.begin(), output_iofc_.end(),
+                hidden_size_x4);
+  } else
+#endif
+  {
+    ComputeGemm(total_rows, hidden_size_x4, input_size_, alpha,
+                inputs.cbegin(), inputs.cend(),
+                input_size_,
+                input_weights.cbegin(), input_weights.cend(),  // W[iofc]
+                input_size_, beta,
+                output_iofc_.begin(), output_iofc_.end(),
+                hidden_size_x4);
+  }
 
   DumpMatrix("Xt*(W[iofc]^T)", output_iofc_.data(), total_rows, hidden_size_x4);
 
@@ -830,13 +946,26 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
         span_T_iter step_out_IOFC = output_iofc_.begin() + (step * batch_size_ + row) * hidden_size_x4;
 
         // calculate Xt*(W[iofc]^T) + Ht-t*R[iofc]
-        ComputeGemm(local_fused_hidden_rows, hidden_size_x4, hidden_size_, alpha,
-                    previous_state, previous_state_end,  // Ht-1
-                    hidden_size_,
-                    recurrent_weights.cbegin(), recurrent_weights.cend(),  // R[iofc]
-                    hidden_size_, beta,
-                    step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
-                    hidden_size_x4);
+#if defined(USE_MLAS)
+        if (packed_recurrent_weights != nullptr) {
+          ComputeGemm(local_fused_hidden_rows, hidden_size_x4, hidden_size_, alpha,
+                      previous_state, previous_state_end,  // Ht-1
+                      hidden_size_,
+                      packed_recurrent_weights,  // R[iofc] in MlasSgemmPackB layout
+                      beta,
+                      step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
+                      hidden_size_x4);
+        } else
+#endif
+        {
+          ComputeGemm(local_fused_hidden_rows, hidden_size_x4, hidden_size_, alpha,
+                      previous_state, previous_state_end,  // Ht-1
+                      hidden_size_,
+                      recurrent_weights.cbegin(), recurrent_weights.cend(),  // R[iofc]
+                      hidden_size_, beta,
+                      step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
+                      hidden_size_x4);
+        }
 
         DumpMatrix("Xt*(W[iofc]^T) + Ht-t*R[iofc]" + row_str,
                    &*step_out_IOFC, local_fused_hidden_rows, hidden_size_x4);
@@ -904,13 +1033,26 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
       span_T_iter step_out_IOFC = output_iofc_.begin() + (step * batch_size_) * hidden_size_x4;
 
       // calculate Xt*(W[iofc]^T) + Ht-t*R[iofc]
-      ComputeGemm(batch_size_, hidden_size_x4, hidden_size_, alpha,
-                  previous_state, previous_state_end,  // Ht-1
-                  hidden_size_,
-                  recurrent_weights.cbegin(), recurrent_weights.cend(),  // R[iofc]
-                  hidden_size_, beta,
-                  step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
-                  hidden_size_x4);
+#if defined(USE_MLAS)
+      if (packed_recurrent_weights != nullptr) {
+        ComputeGemm(batch_size_, hidden_size_x4, hidden_size_, alpha,
+                    previous_state, previous_state_end,  // Ht-1
+                    hidden_size_,
+                    packed_recurrent_weights,  // R[iofc] in MlasSgemmPackB layout
+                    beta,
+                    step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
+                    hidden_size_x4);
+      } else
+#endif
+      {
+        ComputeGemm(batch_size_, hidden_size_x4, hidden_size_, alpha,
+                    previous_state, previous_state_end,  // Ht-1
+                    hidden_size_,
+                    recurrent_weights.cbegin(), recurrent_weights.cend(),  // R[iofc]
+                    hidden_size_, beta,
+                    step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
+                    hidden_size_x4);
+      }
 
       span_T_iter batched_output, batched_output_end;
       if (output_sequence) {
@@ -1009,6 +1151,35 @@ void UniDirectionalLstm<T>::GateComputations(span_T_iter& out, span_T_iter& out_
 
     // DumpMatrix("C_prev" + row_str, pCprev_hidden_size, 1, hidden_size_);
 
+#if defined(USE_MLAS)
+    if (use_fused_gates_) {
+      // apply the bias and activations to all four gates in one vectorized pass.
+      // the row layout is [i|o|f|c], so the three sigmoid gates are contiguous.
+      if (use_bias_) {
+        deepcpu::elementwise_sum1(SafeRawConstPointer<T>(bias_WRiofc_, 0, hidden_size_x4),
+                                  pi, hidden_size_x4);
+      }
+
+      MlasComputeLogistic(pi, pi, 3 * hidden_size_);
+      MlasComputeTanh(pc, pc, hidden_size_);
+
+      // C_current. use previous C value as input, and update in-place
+      deepcpu::merge_lstm_gates_to_memory(pCprev_hidden_size, pi, pf, pc, pCprev_hidden_size, hidden_size_);
+
+      float* pH = SafeRawPointer<T>(batched_output + row * hidden_size_ + b * hidden_size_,
+                                    batched_output_end, hidden_size_);
+      float* pC_prev_clipped = SafeRawPointer<T>(C_prev_clipped + b * hidden_size_,
+                                                 C_prev_clipped_end, hidden_size_);
+
+      // Ht = ot (.) h(Ct)
+      MlasComputeTanh(pCprev_hidden_size, pC_prev_clipped, hidden_size_);
+      for (int i = 0; i < hidden_size_; i++)
+        pH[i] = po[i] * pC_prev_clipped[i];
+
+      continue;
+    }
+#endif
+
     // Input Gate
     if (use_peepholes_) {
       deepcpu::elementwise_product(pCprev_hidden_size, SafeRawConstPointer<const T>(peephole_i_, 0, hidden_size_),
@@ -49,6 +49,17 @@ class DeepCpuLstmOp final : public OpKernel {
     activation_funcs_ = rnn::detail::ActivationFuncs(activation_func_names,
                                                      activation_func_alphas,
                                                      activation_func_betas);
+
+#if defined(USE_MLAS)
+    // W and R are usually constant initializers, so pack them into the MlasSgemm
+    // layout once here instead of repacking them on every call to Compute.
+    const Tensor* W;
+    const Tensor* R;
+    if (info.TryGetConstantInput(1, &W))
+      PackWeights(*W, packed_input_weights_, packed_input_weights_stride_, info);
+    if (info.TryGetConstantInput(2, &R))
+      PackWeights(*R, packed_recurrent_weights_, packed_recurrent_weights_stride_, info);
+#endif
   }
 
   Status Compute(OpKernelContext* context) const override;
@@ -69,6 +80,18 @@ class DeepCpuLstmOp final : public OpKernel {
                         const Tensor* P,
                         int batch_size) const;
 
+#if defined(USE_MLAS)
+  void PackWeights(const Tensor& weights, IAllocatorUniquePtr<void>& packed_weights,
+                   size_t& packed_weights_stride, const OpKernelInfo& info);
+
+  // per-direction packed copies of the W and R inputs when they are constant initializers.
+  // packed_*_stride_ is the offset in bytes between the per-direction buffers.
+  IAllocatorUniquePtr<void> packed_input_weights_;
+  IAllocatorUniquePtr<void> packed_recurrent_weights_;
+  size_t packed_input_weights_stride_ = 0;
+  size_t packed_recurrent_weights_stride_ = 0;
+#endif
+
   rnn::detail::Direction direction_;
   int num_directions_;
 
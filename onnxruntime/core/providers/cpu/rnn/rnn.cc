@@ -151,12 +151,14 @@ Status RNN<float>::Compute(OpKernelContext* ctx) const {
     auto activation_func = GetFuncByName<float>(activations_[direction], "Tanh");
     bool isReverse = direction_ == "reverse" || direction == 1;
 
+    // without a bias the gemm below overwrites the buffer (beta 0), so there
+    // is no need to zero-fill it first.
+    float x_matmul_beta = 0.0f;
     if (B != nullptr) {
       EigenMatrixMapRowMajor<float>(x_matmul_w_buffer_data, seq_length * batch_size, hidden_size_).rowwise() =
           ConstEigenVectorMap<float>(B->template Data<float>() + direction * 2 * hidden_size_, hidden_size_).transpose() +
           ConstEigenVectorMap<float>(B->template Data<float>() + direction * 2 * hidden_size_ + hidden_size_, hidden_size_).transpose();
-    } else {
-      math::Set<float, CPUMathUtil>(seq_length * batch_size * hidden_size_, 0, x_matmul_w_buffer_data, &CPUMathUtil::Instance());
+      x_matmul_beta = 1.0f;
     }
 
     // X * W[direction]^t + B
@@ -169,7 +171,7 @@ Status RNN<float>::Compute(OpKernelContext* ctx) const {
         1,
         X.template Data<float>(),
         W.template Data<float>() + direction * hidden_size_ * input_size,
-        1,
+        x_matmul_beta,
         x_matmul_w_buffer_data,
         &CPUMathUtil::Instance());
 
@@ -204,13 +206,15 @@ Status RNN<float>::Compute(OpKernelContext* ctx) const {
             0,
             Y_buffer_data_current_frame,
             &CPUMathUtil::Instance());
+
+        // X[time_step] * W^t + H_t_1 * R^t
+        y_frame_mat += EigenMatrixMapRowMajor<float>(&x_matmul_w_buffer_data[time_step * Y_frame_size], batch_size, hidden_size_);
       } else {
-        math::Set<float, CPUMathUtil>(batch_size * hidden_size_, 0, Y_buffer_data_current_frame, &CPUMathUtil::Instance());
+        // no hidden state contribution; copy X[time_step] * W^t straight in
+        // rather than zero-filling the frame and adding to it.
+        y_frame_mat = EigenMatrixMapRowMajor<float>(&x_matmul_w_buffer_data[time_step * Y_frame_size], batch_size, hidden_size_);
       }
 
-      // X[time_step] * W^t + H_t_1 * R^t
-      y_frame_mat += EigenMatrixMapRowMajor<float>(&x_matmul_w_buffer_data[time_step * Y_frame_size], batch_size, hidden_size_);
-
       // apply activation
       ApplyActivationToBatches<float>(sequence_lens, h_prev, Y_buffer_data_current_frame,
                                       time_step, batch_size, hidden_size_,
@@ -19,6 +19,10 @@
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 
+#if defined(USE_MLAS)
+#include "core/mlas/inc/mlas.h"
+#endif
+
 namespace onnxruntime {
 class Tensor;
 class OpKernelContext;
@@ -167,6 +171,35 @@ void ComputeGemm(const int M,
       &*C, ldc, &CPUMathUtil::Instance());
 }
 
+#if defined(USE_MLAS)
+// As above, but taking a B matrix that was packed ahead of time with MlasSgemmPackB.
+// The packed buffer must have been created with the same N and K used in this call.
+template <typename TSpanAIter, typename TSpanCIter>
+void ComputeGemm(const int M,
+                 const int N,
+                 const int K,
+                 const float alpha,
+                 TSpanAIter A,
+                 TSpanAIter A_end,
+                 const int lda,
+                 const void* packed_B,
+                 const float beta,
+                 TSpanCIter C,
+                 TSpanCIter C_end,
+                 const int ldc) {
+  // validate all the inputs
+  // need to use the lda/ldc strides which should be >= the columns for the span
+  ONNXRUNTIME_ENFORCE(lda >= K && ldc >= N);
+  ONNXRUNTIME_ENFORCE(A + (M * lda - (lda - K)) <= A_end);
+  ONNXRUNTIME_ENFORCE(C + (M * ldc - (ldc - N)) <= C_end);
+
+  MlasSgemm(CblasNoTrans, M, N, K, alpha,
+            &*A, lda,
+            packed_B, beta,
+            &*C, ldc);
+}
+#endif
+
 // helper to convert a span to a raw pointer
 // after validating the memory covered by the span supports the size required
 template <typename T>
@@ -8,19 +8,11 @@
 using namespace ONNX_NAMESPACE;
 namespace onnxruntime {
 
-const std::vector<MLDataType> castOpTypeConstraints{
-    DataTypeImpl::GetTensorType<bool>(),
-    DataTypeImpl::GetTensorType<float>(),
-    DataTypeImpl::GetTensorType<double>(),
-    DataTypeImpl::GetTensorType<uint8_t>(),
-    DataTypeImpl::GetTensorType<uint16_t>(),
-    DataTypeImpl::GetTensorType<uint32_t>(),
-    DataTypeImpl::GetTensorType<uint64_t>(),
-    DataTypeImpl::GetTensorType<int8_t>(),
-    DataTypeImpl::GetTensorType<int16_t>(),
-    DataTypeImpl::GetTensorType<int32_t>(),
-    DataTypeImpl::GetTensorType<int64_t>(),
-    DataTypeImpl::GetTensorType<MLFloat16>()};
+const std::vector<MLDataType>& castOpTypeConstraints =
+    DataTypeImpl::TensorTypesFor<bool, float, double,
+                                 uint8_t, uint16_t, uint32_t, uint64_t,
+                                 int8_t, int16_t, int32_t, int64_t,
+                                 MLFloat16>();
 
 #define ADD_FROM_CAST_OP(in_type)                                                                                                  \
   ONNX_CPU_OPERATOR_TYPED_KERNEL(                                                                                                  \
@@ -39,41 +31,41 @@ const std::vector<MLDataType> castOpTypeConstraints{
                                                                                                                                    \
     switch (to_) {                                                                                                                 \
       case TensorProto_DataType_BOOL:                                                                                              \
-        CastData<in_type, bool>(X, Y, shape);                                                                                      \
+        CastData<in_type, bool>(context, X, Y, shape);                                                                                      \
         break;                                                                                                                     \
       case TensorProto_DataType_INT16:                                                                                             \
-        CastData<in_type, int16_t>(X, Y, shape);                                                                                   \
+        CastData<in_type, int16_t>(context, X, Y, shape);                                                                                   \
         break;                                                                                                                     \
       case TensorProto_DataType_INT32:                                                                                             \
-        CastData<in_type, int32_t>(X, Y, shape);                                                                                   \
+        CastData<in_type, int32_t>(context, X, Y, shape);                                                                                   \
         break;                                                                                                                     \
       case TensorProto_DataType_INT64:                                                                                             \
-        CastData<in_type, int64_t>(X, Y, shape);                                                                                   \
+        CastData<in_type, int64_t>(context, X, Y, shape);                                                                                   \
         break;                                                                                                                     \
       case TensorProto_DataType_UINT8:                                                                                             \
-        CastData<in_type, uint8_t>(X, Y, shape);                                                                                   \
+        CastData<in_type, uint8_t>(context, X, Y, shape);                                                                                   \
         break;                                                                                                                     \
       case TensorProto_DataType_UINT16:                                                                                            \
-        CastData<in_type, uint16_t>(X, Y, shape);                                                                                  \
+        CastData<in_type, uint16_t>(context, X, Y, shape);                                                                                  \
         break;                                                                                                                     \
       case TensorProto_DataType_UINT32:                                                                                            \
-        CastData<in_type, uint32_t>(X, Y, shape);                                                                                  \
+        CastData<in_type, uint32_t>(context, X, Y, shape);                                                                                  \
         break;                                                                                                                     \
       case TensorProto_DataType_UINT64:                                                                                            \
-        CastData<in_type, uint64_t>(X, Y, shape);                                                                                  \
+        CastData<in_type, uint64_t>(context, X, Y, shape);                                                                                  \
         break;                                                                                                                     \
       case TensorProto_DataType_FLOAT:                                                                                             \
-        CastData<in_type, float>(X, Y, shape);                                                                                     \
+        CastData<in_type, float>(context, X, Y, shape);                                                                                     \
         break;                                                                                                                     \
       case TensorProto_DataType_DOUBLE:                                                                                            \
-        CastData<in_type, double>(X, Y, shape);                                                                                    \
+        CastData<in_type, double>(context, X, Y, shape);                                                                                    \
         break;                                                                                                                     \
       case TensorProto_DataType_INT8:                                                                                              \
-        CastData<in_type, int8_t>(X, Y, shape);                                                                                    \
+        CastData<in_type, int8_t>(context, X, Y, shape);                                                                                    \
         break;                                                                                                                     \
       case TensorProto_DataType_FLOAT16:                                                                                           \
         if (std::is_same<in_type, float>::value) {                                                                                 \
-          CastData<float, MLFloat16>(X, Y, shape);                                                                                 \
+          CastData<float, MLFloat16>(context, X, Y, shape);                                                                                 \
         } else {                                                                                                                   \
           auto st = CastFloat16Data<in_type, MLFloat16>(X, Y, shape, context);                                                     \
           if (!st.IsOK()) return st;                                                                                               \
@@ -141,7 +133,7 @@ Status Cast<MLFloat16>::Compute(OpKernelContext* context) const {
       st = CastFloat16Data<MLFloat16, uint64_t>(X, Y, shape, context);
       break;
     case TensorProto_DataType_FLOAT:
-      CastData<MLFloat16, float>(X, Y, shape);
+      CastData<MLFloat16, float>(context, X, Y, shape);
       break;
     case TensorProto_DataType_FLOAT16: {
         auto X_type = X->DataType();
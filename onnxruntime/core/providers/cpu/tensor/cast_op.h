@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <algorithm>
+#include <type_traits>
+
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 #include "core/util/math_cpuonly.h"
@@ -15,55 +18,95 @@
 
 namespace onnxruntime {
 
+// Convert n half-precision values to float. On x64 builds with MLAS this is
+// the F16C-accelerated buffer conversion; elsewhere Eigen converts.
+inline void ConvertHalfToFloat(const MLFloat16* src, float* dst, int64_t n) {
+#if defined(USE_MLAS) && defined(_M_AMD64)
+  MlasConvertHalfToFloatBuffer(&src[0].val, dst, n);
+#else
+  EigenVectorMap<float>(dst, n) =
+      ConstEigenVectorMap<Eigen::half>(static_cast<const Eigen::half*>(static_cast<const void*>(src)), n)
+          .template cast<float>();
+#endif
+}
+
+inline void ConvertFloatToHalf(const float* src, MLFloat16* dst, int64_t n) {
+  EigenVectorMap<Eigen::half>(static_cast<Eigen::half*>(static_cast<void*>(dst)), n) =
+      ConstEigenVectorMap<float>(src, n).template cast<Eigen::half>();
+}
+
+// The subrange overloads cast elements [first, last) only, so callers can
+// shard one cast across threads; the whole-tensor overloads below keep the
+// original single-call interface.
 template <typename SrcType,
           typename DstType>
-inline void CastData(const Tensor* in, Tensor* out, const TensorShape& shape) {
-  auto shape_size = shape.Size();
-  auto in_vector = ConstEigenVectorMap<SrcType>(in->template Data<SrcType>(), shape_size);
-  auto output_vector = EigenVectorMap<DstType>(out->template MutableData<DstType>(), shape_size);
+inline void CastData(const Tensor* in, Tensor* out, int64_t first, int64_t last) {
+  auto in_vector = ConstEigenVectorMap<SrcType>(in->template Data<SrcType>() + first, last - first);
+  auto output_vector = EigenVectorMap<DstType>(out->template MutableData<DstType>() + first, last - first);
   output_vector = in_vector.template cast<DstType>();
 }
 
 template <>
-inline void CastData<float, MLFloat16>(const Tensor* in, Tensor* out, const TensorShape& shape) {
-  auto out_data = out->template MutableData<MLFloat16>();
-  auto shape_size = shape.Size();
-  auto in_vector = ConstEigenVectorMap<float>(in->template Data<float>(), shape_size);
-  auto output_vector = EigenVectorMap<Eigen::half>(static_cast<Eigen::half*>(static_cast<void*>(out_data)), shape_size);
-  output_vector = in_vector.template cast<Eigen::half>();
+inline void CastData<float, MLFloat16>(const Tensor* in, Tensor* out, int64_t first, int64_t last) {
+  ConvertFloatToHalf(in->template Data<float>() + first,
+                     out->template MutableData<MLFloat16>() + first, last - first);
 }
 
 template <>
-inline void CastData<MLFloat16, float>(const Tensor* in, Tensor* out, const TensorShape& shape) {
-  auto out_data = out->template MutableData<float>();
-  auto in_data = in->template Data<MLFloat16>();
-  auto shape_size = shape.Size();
-#if defined(USE_MLAS) && defined(_M_AMD64)
-  MlasConvertHalfToFloatBuffer(&in_data[0].val, out_data, shape_size);
-#else
-  auto in_vector = ConstEigenVectorMap<Eigen::half>(static_cast<const Eigen::half*>(static_cast<const void*>(in_data)), shape_size);
-  auto output_vector = EigenVectorMap<float>(out_data, shape_size);
-  output_vector = in_vector.template cast<float>();
-#endif
+inline void CastData<MLFloat16, float>(const Tensor* in, Tensor* out, int64_t first, int64_t last) {
+  ConvertHalfToFloat(in->template Data<MLFloat16>() + first,
+                     out->template MutableData<float>() + first, last - first);
 }
 
 template <typename SrcType,
           typename DstType>
-inline void CastFloat16Data(const Tensor* in, Tensor* out, const TensorShape& shape, const AllocatorPtr& allocator) {
-  ONNXRUNTIME_ENFORCE(allocator != nullptr);
-  const int64_t len = shape.Size();
-  ONNXRUNTIME_ENFORCE(len > 0);
-  void* buffer = allocator->AllocArray(sizeof(float), len);
-  ONNXRUNTIME_ENFORCE(buffer);
-  Tensor tmp_tensor(DataTypeImpl::GetType<float>(), shape, buffer, allocator->Info(), nullptr);
-  if (std::is_same<SrcType, MLFloat16>::value) {
-    CastData<MLFloat16, float>(in, &tmp_tensor, shape);  // first cast to float
-    CastData<float, DstType>(&tmp_tensor, out, shape);   // then cast to the destination type.
-  } else if (std::is_same<DstType, MLFloat16>::value) {
-    CastData<SrcType, float>(in, &tmp_tensor, shape);
-    CastData<float, MLFloat16>(&tmp_tensor, out, shape);
+inline void CastData(const Tensor* in, Tensor* out, const TensorShape& shape) {
+  CastData<SrcType, DstType>(in, out, 0, shape.Size());
+}
+
+// Half casts without a direct conversion go through float in fixed-size
+// chunks held on the stack, so no tensor-sized temporary is allocated and
+// the subranges shard across threads like any other cast.
+constexpr int64_t kCastFloat16ChunkSize = 2048;
+
+template <typename DstType>
+inline void CastFromFloat16Data(const Tensor* in, Tensor* out, int64_t first, int64_t last) {
+  float scratch[kCastFloat16ChunkSize];
+  const MLFloat16* src = in->template Data<MLFloat16>();
+  DstType* dst = out->template MutableData<DstType>();
+  for (int64_t base = first; base < last; base += kCastFloat16ChunkSize) {
+    const int64_t n = std::min(kCastFloat16ChunkSize, last - base);
+    ConvertHalfToFloat(src + base, scratch, n);
+    EigenVectorMap<DstType>(dst + base, n) =
+        ConstEigenVectorMap<float>(scratch, n).template cast<DstType>();
   }
-  allocator->Free(buffer);
+}
+
+template <typename SrcType>
+inline void CastToFloat16Data(const Tensor* in, Tensor* out, int64_t first, int64_t last) {
+  float scratch[kCastFloat16ChunkSize];
+  const SrcType* src = in->template Data<SrcType>();
+  MLFloat16* dst = out->template MutableData<MLFloat16>();
+  for (int64_t base = first; base < last; base += kCastFloat16ChunkSize) {
+    const int64_t n = std::min(kCastFloat16ChunkSize, last - base);
+    EigenVectorMap<float>(scratch, n) =
+        ConstEigenVectorMap<SrcType>(src + base, n).template cast<float>();
+    ConvertFloatToHalf(scratch, dst + base, n);
+  }
+}
+
+// Tag dispatch: only the taken branch may instantiate an Eigen map over the
+// half type, so the selection has to happen at compile time.
+template <typename SrcType, typename DstType>
+inline void CastFloat16Data(const Tensor* in, Tensor* out, int64_t first, int64_t last,
+                            std::true_type /*src_is_half*/) {
+  CastFromFloat16Data<DstType>(in, out, first, last);
+}
+
+template <typename SrcType, typename DstType>
+inline void CastFloat16Data(const Tensor* in, Tensor* out, int64_t first, int64_t last,
+                            std::false_type /*src_is_half*/) {
+  CastToFloat16Data<SrcType>(in, out, first, last);
 }
 
 template <typename T>
@@ -81,16 +124,23 @@ class Cast final : public OpKernel {
  private:
   template <typename SrcType,
             typename DstType>
-  void CastData(const Tensor* in, Tensor* out, const TensorShape& shape) const {
-    ::onnxruntime::CastData<SrcType, DstType>(in, out, shape);
+  void CastData(OpKernelContext* context, const Tensor* in, Tensor* out, const TensorShape& shape) const {
+    // a cast touches each element once, so only large tensors shard.
+    context->ParallelFor(0, shape.Size(), 1.0,
+                         [in, out](int64_t first, int64_t last) {
+                           ::onnxruntime::CastData<SrcType, DstType>(in, out, first, last);
+                         });
   }
 
   template <typename SrcType,
             typename DstType>
   Status CastFloat16Data(const Tensor* in, Tensor* out, const TensorShape& shape, OpKernelContext* context) const {
-    AllocatorPtr allocator;
-    ONNXRUNTIME_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
-    ::onnxruntime::CastFloat16Data<SrcType, DstType>(in, out, shape, allocator);
+    // two conversions per element via the per-chunk stack buffer.
+    context->ParallelFor(0, shape.Size(), 2.0,
+                         [in, out](int64_t first, int64_t last) {
+                           ::onnxruntime::CastFloat16Data<SrcType, DstType>(
+                               in, out, first, last, std::is_same<SrcType, MLFloat16>());
+                         });
     return Status::OK();
   }
 
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/tensor/compress.h"
+#include "core/providers/cpu/tensor/mask_selection.h"
 using namespace ::onnxruntime::common;
 
 namespace onnxruntime {
@@ -24,17 +25,14 @@ Status Compress::Compute(OpKernelContext* ctx) const {
   auto condition_length = condition->Shape().Size();
   auto condition_data = condition->template Data<bool>();
 
-  int64_t positive_condition_count = 0;
   // if has axis, we need to compress on dimension[axis], otherwise compress on the flattened input data
   int64_t compress_input_length = has_axis_ ? input_dimensions[axis_] : input_tensor->Shape().Size();
   int64_t valid_condition_length = compress_input_length < condition_length ? compress_input_length : condition_length;
 
-  // Figure out output shape
-  for (int i = 0; i < valid_condition_length; ++i) {
-    if (condition_data[i]) {
-      ++positive_condition_count;
-    }
-  }
+  // Figure out output shape; the per-block offsets feed the compaction below.
+  std::vector<int64_t> block_offsets;
+  int64_t positive_condition_count =
+      mask_selection::BuildBlockOffsets(condition_data, valid_condition_length, block_offsets);
 
   std::vector<int64_t> output_dims(input_dimensions);
   if (has_axis_) {
@@ -70,34 +68,48 @@ Status Compress::Compute(OpKernelContext* ctx) const {
     int64_t axes_included_right_stride_bytes = axes_included_right_stride * element_bytes;
     int64_t axes_right_stride_bytes = axes_right_stride * element_bytes;
 
-    for (int i = 0; i < axes_left_stride; ++i) {
-      for (int j = 0; j < valid_condition_length; ++j) {
-        if (!condition_data[j]) {
-          continue;
-        }
-        if (is_string_type) {
+    if (is_string_type) {
+      for (int i = 0; i < axes_left_stride; ++i) {
+        for (int j = 0; j < valid_condition_length; ++j) {
+          if (!condition_data[j]) {
+            continue;
+          }
           for (int idxItem = 0; idxItem < axes_right_stride; ++idxItem) {
             reinterpret_cast<std::string*>(output_data)[output_index + idxItem] =
               reinterpret_cast<const std::string*>(input_data)[i * axes_included_right_stride + j * axes_right_stride + idxItem];
           }
           output_index += axes_right_stride;
-        } else {
-          memcpy(output_data + output_index, input_data + i * axes_included_right_stride_bytes + j * axes_right_stride_bytes, axes_right_stride_bytes);
-          output_index += axes_right_stride_bytes;
         }
       }
+    } else {
+      // gather the selected slices in parallel: output row r maps to outer
+      // block r / count and selected axis index selected[r % count]
+      std::vector<int64_t> selected;
+      mask_selection::BuildSelectedIndices(condition_data, valid_condition_length, block_offsets, selected);
+      int64_t total_rows = axes_left_stride * positive_condition_count;
+      ctx->ParallelFor(0, total_rows, static_cast<double>(axes_right_stride_bytes),
+                       [&](int64_t first, int64_t last) {
+                         for (int64_t row = first; row < last; ++row) {
+                           int64_t i = row / positive_condition_count;
+                           int64_t j = selected[row % positive_condition_count];
+                           memcpy(output_data + row * axes_right_stride_bytes,
+                                  input_data + i * axes_included_right_stride_bytes + j * axes_right_stride_bytes,
+                                  axes_right_stride_bytes);
+                         }
+                       });
     }
   } else {
-    for (int i = 0; i < valid_condition_length; ++i) {
-      if (!condition_data[i]) {
-        continue;
-      }
-      if (is_string_type) {
+    if (is_string_type) {
+      for (int i = 0; i < valid_condition_length; ++i) {
+        if (!condition_data[i]) {
+          continue;
+        }
         reinterpret_cast<std::string*>(output_data)[output_index] = reinterpret_cast<const std::string*>(input_data)[i];
-      } else {
-        memcpy(output_data + output_index * element_bytes, input_data + i * element_bytes, element_bytes);
+        ++output_index;
       }
-      ++output_index;
+    } else {
+      mask_selection::CompactRows(*ctx, condition_data, valid_condition_length,
+                                  input_data, output_data, element_bytes, block_offsets);
     }
   }
 
@@ -3,10 +3,12 @@
 
 #pragma once
 
+#include <mutex>
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 #include "core/util/math_cpuonly.h"
 #include "core/framework/tensor.h"
+#include "core/providers/cpu/tensor/copy_plan.h"
 
 namespace onnxruntime {
 
@@ -39,6 +41,12 @@ class Concat final : public OpKernel, public ConcatBase {
   Concat(const OpKernelInfo& info) : OpKernel(info), ConcatBase(info) {}
 
   Status Compute(OpKernelContext* context) const override;
+
+ private:
+  // copy plan cached across Runs, rebuilt only when the input shapes change
+  mutable std::mutex plan_mutex_;
+  mutable std::vector<TensorShape> planned_shapes_;
+  mutable std::shared_ptr<const CopyPlan> plan_;
 };
 
 }  // namespace onnxruntime
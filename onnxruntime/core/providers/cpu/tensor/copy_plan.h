@@ -0,0 +1,61 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/work_stealing_thread_pool.h"
+
+namespace onnxruntime {
+
+/*
+  A copy plan is a flat list of contiguous byte spans connecting several
+  per-tensor buffers to one shared buffer: the inputs of a Concat feeding its
+  output, or the input of a Split feeding its outputs. The plan depends only
+  on shapes, so kernels compute it once and replay it with bulk memcpy on
+  every Run. Spans are stored as offsets rather than pointers so a cached
+  plan stays valid when the tensors land at different addresses later.
+*/
+struct CopyPlan {
+  struct Span {
+    int tensor_index;       // which per-tensor buffer the span belongs to
+    int64_t tensor_offset;  // byte offset within that buffer
+    int64_t shared_offset;  // byte offset within the shared buffer
+    int64_t bytes;
+  };
+
+  std::vector<Span> spans;
+  int64_t total_bytes = 0;
+};
+
+/*
+  Executes every span of the plan, splitting the span list across the pool
+  when there is enough work to amortize the dispatch. shared_is_destination
+  selects the copy direction: tensor buffers into the shared buffer (Concat)
+  or the shared buffer into the tensor buffers (Split).
+*/
+inline void ExecuteCopyPlan(const CopyPlan& plan, bool shared_is_destination,
+                            uint8_t* shared_base, const std::vector<uint8_t*>& tensor_bases) {
+  const auto num_spans = static_cast<int64_t>(plan.spans.size());
+  const double bytes_per_span =
+      num_spans == 0 ? 0.0 : static_cast<double>(plan.total_bytes) / static_cast<double>(num_spans);
+
+  ParallelFor(0, num_spans, bytes_per_span,
+              [&](int64_t first, int64_t last) {
+                for (int64_t i = first; i < last; ++i) {
+                  const auto& span = plan.spans[i];
+                  uint8_t* tensor_ptr = tensor_bases[span.tensor_index] + span.tensor_offset;
+                  uint8_t* shared_ptr = shared_base + span.shared_offset;
+                  if (shared_is_destination)
+                    memcpy(shared_ptr, tensor_ptr, span.bytes);
+                  else
+                    memcpy(tensor_ptr, shared_ptr, span.bytes);
+                }
+              });
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,133 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "core/framework/op_kernel.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace onnxruntime {
+namespace mask_selection {
+
+// Shared helpers for boolean-mask selection: counting a mask with 64-bit
+// popcounts, turning per-block counts into output offsets, and compacting the
+// selected rows across the thread pool. Compress is the first user; NonZero
+// and boolean indexing can build on the same offsets.
+
+// mask elements per compaction block; each block writes a disjoint output
+// range computed from the block offset prefix, so blocks run in parallel.
+constexpr int64_t kMaskBlockElements = 32 * 1024;
+
+inline int64_t PopCount64(uint64_t value) {
+#if defined(_MSC_VER) && defined(_M_X64)
+  return static_cast<int64_t>(__popcnt64(value));
+#elif defined(__GNUC__) || defined(__clang__)
+  return __builtin_popcountll(value);
+#else
+  int64_t count = 0;
+  while (value != 0) {
+    value &= value - 1;
+    count++;
+  }
+  return count;
+#endif
+}
+
+// Count the set entries of a byte-per-element bool mask, eight lanes per
+// popcount instead of one branch per element.
+inline int64_t CountMask(const bool* mask, int64_t length) {
+  const unsigned char* bytes = reinterpret_cast<const unsigned char*>(mask);
+  int64_t count = 0;
+  int64_t i = 0;
+  for (; i + 8 <= length; i += 8) {
+    uint64_t lanes;
+    memcpy(&lanes, bytes + i, sizeof(lanes));
+    // a stored bool reads back as 0 or 1, so the low bit of each lane is the
+    // whole truth value.
+    count += PopCount64(lanes & 0x0101010101010101ULL);
+  }
+  for (; i < length; ++i) {
+    count += bytes[i] ? 1 : 0;
+  }
+  return count;
+}
+
+// Exclusive prefix sum of per-block mask counts. offsets gets one entry per
+// block plus a final total, so offsets[b] is where block b's selected rows
+// start in the compacted output. Returns the total selected count.
+inline int64_t BuildBlockOffsets(const bool* mask, int64_t length, std::vector<int64_t>& offsets) {
+  const int64_t blocks = length == 0 ? 0 : (length + kMaskBlockElements - 1) / kMaskBlockElements;
+  offsets.resize(blocks + 1);
+
+  int64_t running = 0;
+  for (int64_t b = 0; b < blocks; ++b) {
+    offsets[b] = running;
+    const int64_t begin = b * kMaskBlockElements;
+    const int64_t end = std::min(begin + kMaskBlockElements, length);
+    running += CountMask(mask + begin, end - begin);
+  }
+  offsets[blocks] = running;
+  return running;
+}
+
+// Indices of the set mask entries, laid out per block from the offsets so the
+// fill could also run block parallel if it ever shows up in profiles.
+inline void BuildSelectedIndices(const bool* mask, int64_t length,
+                                 const std::vector<int64_t>& block_offsets,
+                                 std::vector<int64_t>& indices) {
+  const int64_t blocks = static_cast<int64_t>(block_offsets.size()) - 1;
+  indices.resize(block_offsets[blocks]);
+  for (int64_t b = 0; b < blocks; ++b) {
+    const int64_t begin = b * kMaskBlockElements;
+    const int64_t end = std::min(begin + kMaskBlockElements, length);
+    int64_t out = block_offsets[b];
+    for (int64_t i = begin; i < end; ++i) {
+      if (mask[i]) {
+        indices[out++] = i;
+      }
+    }
+  }
+}
+
+// Compact the rows selected by the mask into a dense output, block parallel.
+// Row i occupies row_bytes at input + i * row_bytes; runs of consecutive
+// selected rows collapse into a single memcpy.
+inline void CompactRows(OpKernelContext& context, const bool* mask, int64_t length,
+                        const uint8_t* input, uint8_t* output, int64_t row_bytes,
+                        const std::vector<int64_t>& block_offsets) {
+  const int64_t blocks = static_cast<int64_t>(block_offsets.size()) - 1;
+  context.ParallelFor(0, blocks, static_cast<double>(kMaskBlockElements * row_bytes),
+                      [&](int64_t first, int64_t last) {
+                        for (int64_t b = first; b < last; ++b) {
+                          const int64_t begin = b * kMaskBlockElements;
+                          const int64_t end = std::min(begin + kMaskBlockElements, length);
+                          uint8_t* out = output + block_offsets[b] * row_bytes;
+
+                          int64_t i = begin;
+                          while (i < end) {
+                            if (!mask[i]) {
+                              ++i;
+                              continue;
+                            }
+                            int64_t run = i + 1;
+                            while (run < end && mask[run]) {
+                              ++run;
+                            }
+                            memcpy(out, input + i * row_bytes, (run - i) * row_bytes);
+                            out += (run - i) * row_bytes;
+                            i = run;
+                          }
+                        }
+                      });
+}
+
+}  // namespace mask_selection
+}  // namespace onnxruntime
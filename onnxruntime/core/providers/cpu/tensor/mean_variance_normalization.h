@@ -5,6 +5,7 @@
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/providers/cpu/nn/fused_scale_bias.h"
 #include "core/util/math_cpuonly.h"
 
 #include "gsl/gsl_util"
@@ -46,16 +47,17 @@ class MeanVarianceNormalization_0 : public OpKernel {
     var.setZero();
 
     ConstEigenArrayMap<T> X_arr(Xdata, sample_size, N * C);
-    for (int nc = 0; nc < N * C; ++nc) {
-      mean(nc % C) += X_arr.col(nc).sum();
-    }
-    mean /= gsl::narrow_cast<T>(N * sample_size);
+    // both moments from one pass over the input: accumulate the per-channel
+    // sum and sum of squares, then var = E[x^2] - mean^2, clamped so rounding
+    // on near-constant channels cannot go negative
     for (int64_t nc = 0; nc < N * C; ++nc) {
-      var(nc % C) += (X_arr.col(nc) - mean(nc % C)).matrix().squaredNorm();
+      const auto col = X_arr.col(nc);
+      mean(nc % C) += col.sum();
+      var(nc % C) += col.matrix().squaredNorm();
     }
-    var /= gsl::narrow_cast<T>(N * sample_size);
+    mean /= gsl::narrow_cast<T>(N * sample_size);
+    var = (var / gsl::narrow_cast<T>(N * sample_size) - mean.square()).max(0.0f);
 
-    Eigen::Array<T, Eigen::Dynamic, 1> inv_std;
     EigenArrayMap<T> Y_arr(Ydata, sample_size, N * C);
 
     if (across_channels_) {
@@ -75,19 +77,19 @@ class MeanVarianceNormalization_0 : public OpKernel {
         Y_arr = (X_arr - global_mean) * inv_std_scalar;
       }
     } else {
+      // y = (x - mean) * inv_std folds to the per-channel multiplier/addend
+      // form shared with the other normalization ops:
+      //   y = x * inv_std + (-mean * inv_std)
+      Eigen::Array<float, Eigen::Dynamic, 1> multiplier;
       if (!normalize_variance_) {
         // inv_std = 1
-        for (int64_t nc = 0; nc < N * C; ++nc) {
-          // y = (x - mean)
-          Y_arr.col(nc) = (X_arr.col(nc) - mean(nc % C));
-        }
+        multiplier = Eigen::Array<float, Eigen::Dynamic, 1>::Ones(C);
       } else {
-        inv_std = var.sqrt().inverse();
-        for (int64_t nc = 0; nc < N * C; ++nc) {
-          // y = (x - mean) * (inv_std)
-          Y_arr.col(nc) = (X_arr.col(nc) - mean(nc % C)) * inv_std(nc % C);
-        }
+        multiplier = var.sqrt().inverse();
       }
+      Eigen::Array<float, Eigen::Dynamic, 1> addend = -mean * multiplier;
+      ApplyFusedScaleBias(context, Xdata, Ydata, N * C, sample_size, C,
+                          multiplier.data(), addend.data());
     }
     return Status::OK();
   }
@@ -10,6 +10,9 @@
 #include "core/providers/cpu/tensor/pad.h"
 #include "core/providers/cpu/tensor/utils.h"
 
+#include <algorithm>
+#include <cstring>
+
 namespace onnxruntime {
 
 ONNX_CPU_OPERATOR_KERNEL(
@@ -21,6 +24,16 @@ ONNX_CPU_OPERATOR_KERNEL(
 // This is the general padding method to n-dimensionally do edge or reflection padding (based on the inputDelta values)
 template <typename T>
 static void PadAxis(T* output, T* input, ptrdiff_t input_delta, ptrdiff_t input_pitch, size_t block_size, size_t block_count) {
+  if (input_delta == 1) {
+    // Each block is a contiguous run (the outer-axis edge/reflect cases), so
+    // the whole row copies in bulk instead of element by element.
+    for (size_t block_index = 0; block_index < block_count; block_index++) {
+      memcpy(output, input, block_size * sizeof(T));
+      output += block_size;
+      input += block_size + input_pitch;
+    }
+    return;
+  }
   for (size_t block_index = 0; block_index < block_count; block_index++) {
     for (size_t i = 0; i < block_size; i++) {
       *output++ = *input;
@@ -43,8 +56,7 @@ static void PadInnermostAxis(T* output, T* input, ptrdiff_t input_delta, size_t
 // For constant padding, there is no input, just a size to write the constant to
 template <typename T>
 static void PadAxisConstant(T* output, T constant, size_t size) {
-  for (size_t i = 0; i < size; i++)
-    *output++ = constant;
+  std::fill_n(output, size, constant);
 }
 
 template <>
@@ -38,6 +38,25 @@ const T& clamp(const T& v, const T& lo, const T& hi) {
   if (v > hi) return hi;
   return v;
 }
+
+// A slice selects one contiguous run of the input when the leading axes are
+// pinned to a single element, at most one axis takes a partial range, and
+// every later axis is taken whole. Must match the planner's test in
+// FindAliasableContiguousSlice (allocation_planner.cc).
+bool IsContiguousSlice(const std::vector<int64_t>& input_dims,
+                       const std::vector<int64_t>& starts,
+                       const std::vector<int64_t>& output_dims) {
+  bool partial_seen = false;
+  for (size_t i = 0; i < input_dims.size(); ++i) {
+    if (partial_seen) {
+      if (starts[i] != 0 || output_dims[i] != input_dims[i])
+        return false;
+    } else if (output_dims[i] > 1) {
+      partial_seen = true;  // the one axis allowed a partial range
+    }
+  }
+  return true;
+}
 }  // namespace
 Status SliceBase::PrepareForCompute(const size_t dimension_count, const std::vector<int64_t>& input_dimensions,
                                     std::vector<int64_t>& starts, std::vector<int64_t>& output_dims) const {
@@ -92,12 +111,37 @@ Status Slice<T>::Compute(OpKernelContext* ctx) const {
 
   TensorShape output_shape(output_dims);
   auto& output_tensor = *ctx->Output(0, output_shape);
+
+  // When the planner proved the slice contiguous and aliased the input's
+  // buffer (see FindAliasableContiguousSlice in allocation_planner.cc), the
+  // output is a view: move its byte offset to the first selected element
+  // and no data moves. Compare the underlying buffers rather than the
+  // offset-adjusted data pointers: the input may itself be a slice view with
+  // a nonzero byte offset, and falling through to the copy here would write
+  // into the shared buffer both views live in.
+  const auto* input_base = static_cast<const char*>(input_tensor.DataRaw()) - input_tensor.ByteOffset();
+  const auto* output_base = static_cast<const char*>(output_tensor.MutableDataRaw()) - output_tensor.ByteOffset();
+  if (output_base == input_base &&
+      IsContiguousSlice(input_dimensions, starts, output_dims)) {
+    int64_t element_offset = 0;
+    int64_t stride = 1;
+    for (size_t i = dimension_count; i > 0; --i) {
+      element_offset += starts[i - 1] * stride;
+      stride *= input_dimensions[i - 1];
+    }
+    // compose with the input's offset so a chain of views stays zero-copy
+    output_tensor.SetByteOffset(input_tensor.ByteOffset() +
+                                element_offset * static_cast<int64_t>(sizeof(T)));
+    return Status::OK();
+  }
+
   auto* output = output_tensor.template MutableData<T>();
   const auto* output_end = output + output_shape.Size();
 
-  SliceIterator<T> input_iterator(input_tensor, starts, output_dims);
-  while (output != output_end)
-    *output++ = *input_iterator++;
+  // Safe even if the planner handed us a buffer overlapping the input: every
+  // source element lies at or after its destination, so the forward copy
+  // never reads an element it has already written.
+  SliceCopy<T>(input_tensor, starts, output_dims, output, output_end);
 
   return Status::OK();
 }
@@ -3,12 +3,9 @@
 
 #include "core/providers/cpu/tensor/space_depth_ops.h"
 
-// warning raised from Eigen Tensor code.
-#ifdef _MSC_VER
-#pragma warning(disable : 4554)
-#endif
-#include "core/util/eigen_common_wrapper.h"
-#include <array>
+#include <functional>
+
+#include "core/common/work_stealing_thread_pool.h"
 
 namespace onnxruntime {
 
@@ -25,13 +22,18 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     DepthToSpace<float>);
 
-// intemediate tensor shapes are:
-// (batch, blocksize, blocksize, input_depth / (blocksize * blocksize), input_height, input_width) for DepthToSpace
-// (batch, input_depth, input_height / blocksize, blocksize, input_width / blocksize, blocksize) for SpaceToDepth
-const int IntermediateTensorRank = 6;
-typedef Eigen::TensorMap<Eigen::Tensor<float, IntermediateTensorRank, Eigen::RowMajor, int64_t>,
-                         Eigen::Aligned>
-    EigenTensorMap;
+namespace {
+
+// Run process_slabs over [0, num_slabs) on the shared pool, splitting the slab
+// range into contiguous chunks. Small tensors run inline.
+void DispatchSlabs(int64_t num_slabs, int64_t total_elements,
+                   const std::function<void(int64_t, int64_t)>& process_slabs) {
+  const double cost_per_slab =
+      num_slabs == 0 ? 0.0 : static_cast<double>(total_elements) / static_cast<double>(num_slabs);
+  ParallelFor(0, num_slabs, cost_per_slab, process_slabs);
+}
+
+}  // namespace
 
 template <>
 Status SpaceToDepth<float>::Compute(OpKernelContext* context) const {
@@ -51,13 +53,37 @@ Status SpaceToDepth<float>::Compute(OpKernelContext* context) const {
   const int64_t output_width = input_width / blocksize_;
   Tensor& output = *context->Output(0, {batch, output_depth, output_height, output_width});
 
-  std::array<int64_t, IntermediateTensorRank> permutation{{0, 3, 5, 1, 2, 4}};
-  EigenTensorMap(output.template MutableData<float>(), batch, blocksize_, blocksize_,
-                 input_depth, input_height / blocksize_, input_width / blocksize_) =
-      EigenTensorMap(const_cast<float*>(input.template Data<float>()), batch,
-                     input_depth, input_height / blocksize_, blocksize_,
-                     input_width / blocksize_, blocksize_)
-          .shuffle(permutation);
+  const float* input_data = input.Data<float>();
+  float* output_data = output.MutableData<float>();
+
+  // Each output plane (b, oc) with oc = (by * blocksize + bx) * input_depth + c
+  // is a strided gather from input plane (b, c): rows step by blocksize rows,
+  // elements step by blocksize columns, starting at (by, bx). The writes are
+  // contiguous per output row, so the inner loop vectorizes, and each slab is
+  // an independent plane we spread across the pool.
+  const int64_t bs = blocksize_;
+  const int64_t num_slabs = batch * output_depth;
+  auto process_slabs = [=](int64_t first, int64_t last) {
+    for (int64_t slab = first; slab < last; ++slab) {
+      const int64_t b = slab / output_depth;
+      const int64_t oc = slab % output_depth;
+      const int64_t c = oc % input_depth;
+      const int64_t bx = (oc / input_depth) % bs;
+      const int64_t by = oc / input_depth / bs;
+
+      const float* src = input_data + ((b * input_depth + c) * input_height + by) * input_width + bx;
+      float* dst = output_data + slab * output_height * output_width;
+      for (int64_t h = 0; h < output_height; ++h) {
+        const float* src_row = src + h * bs * input_width;
+        for (int64_t w = 0; w < output_width; ++w) {
+          dst[w] = src_row[w * bs];
+        }
+        dst += output_width;
+      }
+    }
+  };
+
+  DispatchSlabs(num_slabs, output.Shape().Size(), process_slabs);
 
   return Status::OK();
 }
@@ -81,13 +107,37 @@ Status DepthToSpace<float>::Compute(OpKernelContext* context) const {
 
   Tensor& output = *context->Output(0, {batch, output_depth, output_height, output_width});
 
-  std::array<int64_t, IntermediateTensorRank> permutation{{0, 3, 4, 1, 5, 2}};
-  EigenTensorMap(output.template MutableData<float>(), batch, input_depth / blocksize_ / blocksize_,
-                 input_height, blocksize_, input_width, blocksize_) =
-      EigenTensorMap(const_cast<float*>(input.template Data<float>()), batch,
-                     blocksize_, blocksize_, input_depth / blocksize_ / blocksize_,
-                     input_height, input_width)
-          .shuffle(permutation);
+  const float* input_data = input.Data<float>();
+  float* output_data = output.MutableData<float>();
+
+  // output[b][c][h * blocksize + by][w * blocksize + bx] comes from input plane
+  // (by * blocksize + bx) * output_depth + c of batch b at (h, w). A slab is one
+  // input-height row of one output plane: it interleaves blocksize contiguous
+  // input rows (one per bx) into one output row group, so the reads stream and
+  // the stores land in a single hot output row.
+  const int64_t bs = blocksize_;
+  const int64_t num_slabs = batch * output_depth * input_height;
+  auto process_slabs = [=](int64_t first, int64_t last) {
+    for (int64_t slab = first; slab < last; ++slab) {
+      const int64_t h = slab % input_height;
+      const int64_t c = (slab / input_height) % output_depth;
+      const int64_t b = slab / input_height / output_depth;
+
+      for (int64_t by = 0; by < bs; ++by) {
+        float* dst = output_data +
+                     ((b * output_depth + c) * output_height + h * bs + by) * output_width;
+        for (int64_t bx = 0; bx < bs; ++bx) {
+          const int64_t ic = (by * bs + bx) * output_depth + c;
+          const float* src = input_data + ((b * input_depth + ic) * input_height + h) * input_width;
+          for (int64_t w = 0; w < input_width; ++w) {
+            dst[w * bs + bx] = src[w];
+          }
+        }
+      }
+    }
+  };
+
+  DispatchSlabs(num_slabs, output.Shape().Size(), process_slabs);
 
   return Status::OK();
 }
@@ -3,8 +3,6 @@
 
 #include "core/providers/cpu/tensor/split.h"
 #include "core/providers/common.h"
-#include "core/util/math.h"
-#include "core/util/math_cpuonly.h"
 
 #include "gsl/gsl_util"
 
@@ -26,19 +24,16 @@ Status Split::Compute(OpKernelContext* context) const {
   Status status;
   auto data_type = input.DataType();
 
-  if (data_type == DataTypeImpl::GetType<float>())
-    status = ComputeImpl<float>(*context, input);
-  else if (data_type == DataTypeImpl::GetType<double>()) {
-    /* Need to update CopyMatrix to support double...
-    status = ComputeImpl<double>(*context, input); */
-    ONNXRUNTIME_NOT_IMPLEMENTED("Split operator does not support double yet");
-  } else
+  // the copy plan works on raw bytes, so any fixed-size element type goes
+  // through the same implementation
+  if (data_type == DataTypeImpl::GetType<float>() || data_type == DataTypeImpl::GetType<double>())
+    status = ComputeImpl(*context, input);
+  else
     ONNXRUNTIME_THROW("Invalid data type for Split operator of ", data_type);
 
   return status;
 }
 
-template <typename T>
 Status Split::ComputeImpl(OpKernelContext& context, const Tensor& input) const {
   auto& input_shape = input.Shape();
   auto& input_dims = input_shape.GetDims();
@@ -82,30 +77,50 @@ Status Split::ComputeImpl(OpKernelContext& context, const Tensor& input) const {
   // copy dimensions so we can update the selected axis in place
   std::vector<int64_t> output_dimensions{input_dims};
 
-  int64_t input_offset = 0;
-  const T* input_data = input.template Data<T>();
+  const int64_t element_bytes = static_cast<int64_t>(input.DataType()->Size());
 
+  std::vector<uint8_t*> output_bases(num_outputs);
   for (int i = 0; i < num_outputs; ++i) {
     // update size of dimension for axis we're splitting on
-    auto split_size = gsl::narrow<int>(split_sizes[i]);
-    output_dimensions[axis] = split_size;
+    output_dimensions[axis] = split_sizes[i];
 
     Tensor* output = context.Output(i, TensorShape{output_dimensions});
-    T* output_data = output->template MutableData<T>();
-
-    ::onnxruntime::math::CopyMatrix<CPUMathUtil>(
-        sizeof(T),
-        before_dims,                                          // M
-        split_size * after_dims_excluding_split,              // N
-        static_cast<const void*>(input_data + input_offset),  // A
-        after_dims_including_split_axis,                      // lda
-        static_cast<void*>(output_data),                      // B
-        split_size * after_dims_excluding_split,              // ldb
-        &CPUMathUtil::Instance());
-
-    input_offset += split_size * after_dims_excluding_split;  // offset by the N data we used in this iteration
+    output_bases[i] = static_cast<uint8_t*>(output->MutableDataRaw());
   }
 
+  // Build the copy plan, or replay the cached one if the input shape is
+  // unchanged since the previous Run.
+  std::shared_ptr<const CopyPlan> plan;
+  {
+    std::lock_guard<std::mutex> lock(plan_mutex_);
+    if (!plan_ || planned_shape_ != input_shape) {
+      auto new_plan = std::make_shared<CopyPlan>();
+      int64_t input_offset = 0;
+      for (int i = 0; i < num_outputs; ++i) {
+        const int64_t output_row_size = split_sizes[i] * after_dims_excluding_split;
+
+        // One span per outer row; splitting on the outermost axis collapses
+        // to a single span covering the whole output.
+        for (int64_t row = 0; row < before_dims; ++row) {
+          new_plan->spans.push_back({i,
+                                     row * output_row_size * element_bytes,
+                                     (row * after_dims_including_split_axis + input_offset) * element_bytes,
+                                     output_row_size * element_bytes});
+        }
+        new_plan->total_bytes += before_dims * output_row_size * element_bytes;
+
+        input_offset += output_row_size;  // offset by the data we used in this iteration
+      }
+
+      planned_shape_ = input_shape;
+      plan_ = std::move(new_plan);
+    }
+    plan = plan_;
+  }
+
+  uint8_t* input_base = const_cast<uint8_t*>(static_cast<const uint8_t*>(input.DataRaw()));
+  ExecuteCopyPlan(*plan, false /*shared_is_destination*/, input_base, output_bases);
+
   return Status::OK();
 }
 
@@ -3,10 +3,12 @@
 
 #pragma once
 
+#include <mutex>
 #include <numeric>
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/providers/cpu/tensor/copy_plan.h"
 
 namespace onnxruntime {
 
@@ -28,12 +30,16 @@ class Split final : public OpKernel {
   Status Compute(OpKernelContext* context) const override;
 
  private:
-  template <typename T>
   Status ComputeImpl(OpKernelContext& context, const Tensor& input) const;
 
   int64_t axis_;
   std::vector<int64_t> split_sizes_;
   int64_t split_size_sum_ = 0;
+
+  // copy plan cached across Runs, rebuilt only when the input shape changes
+  mutable std::mutex plan_mutex_;
+  mutable TensorShape planned_shape_;
+  mutable std::shared_ptr<const CopyPlan> plan_;
 };
 
 }  // namespace onnxruntime
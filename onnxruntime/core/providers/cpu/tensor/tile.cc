@@ -1,21 +1,10 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
-// there's no way to use a raw pointer as the copy destination with std::copy_n
-// (which gsl::copy uses with span::data() which returns a raw pointer) with the 14.11 toolset
-// without generating a 4996 warning. going through an iterator is way too much overhead so turn off the warning.
-#ifdef _MSC_VER
-#pragma warning(push)
-#pragma warning(disable : 4996)
-#endif
-
-#include "gsl/gsl_algorithm"
 #include "core/providers/cpu/tensor/tile.h"
 #include "core/providers/cpu/tensor/utils.h"
 
-#ifdef _MSC_VER
-#pragma warning(pop)
-#endif
+#include <cstring>
 
 using namespace ::onnxruntime::common;
 
@@ -27,6 +16,19 @@ ONNX_CPU_OPERATOR_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Tile<float>);
 
+// Extends the already materialized leading block across the rest of the
+// region, doubling the copied span each pass so large repeat counts run as a
+// handful of big memcpys instead of per-element index arithmetic.
+static void TileDoubleRegion(float* region, int64_t block, int64_t repeat) {
+  int64_t copied = block;
+  const int64_t total = block * repeat;
+  while (copied < total) {
+    const int64_t to_copy = std::min(copied, total - copied);
+    memcpy(region + copied, region, to_copy * sizeof(float));
+    copied += to_copy;
+  }
+}
+
 template <>
 Status Tile<float>::Compute(OpKernelContext* ctx) const {
   const Tensor* tensor_pointer = ctx->Input<Tensor>(0);
@@ -51,32 +53,89 @@ Status Tile<float>::Compute(OpKernelContext* ctx) const {
   TensorShape outputShape(output_dims);
   auto& output_tensor = *ctx->Output(0, outputShape);
 
+  const int64_t input_size = input_tensor.Shape().Size();
+  const int64_t output_size = outputShape.Size();
+  if (output_size == 0)
+    return Status::OK();
+
   auto* output = output_tensor.template MutableData<float>();
-  auto* input = input_tensor.template Data<float>();
+  const auto* input = input_tensor.template Data<float>();
+
+  // every repeat is 1 (this also covers scalars): one flat copy
+  if (output_size == input_size) {
+    memcpy(output, input, input_size * sizeof(float));
+    return Status::OK();
+  }
 
+  const std::vector<int64_t>& input_dims = input_tensor.Shape().GetDims();
   TensorPitches output_pitches(output_tensor);
-  TensorAxisCounters input_counters(input_tensor);
-
-  while (input_counters) {
-    // Copy the input data over
-    size_t input_pitch = input_tensor.Shape().GetDims().back();
-    for (size_t i = 0; i < input_pitch; i++)
-      *output++ = *input++;
-
-    // Tile it for the innermost axis
-    const auto* copy = output - input_tensor.Shape()[dimension_count - 1];
-    for (int64_t repeat = (repeats[dimension_count - 1] - 1) * input_pitch; repeat-- > 0;)
-      *output++ = *copy++;
-
-    // Tile it in the other axes
-    while (input_counters.Increment()) {
-      ptrdiff_t pitch = output_pitches[input_counters.Axis()] * input_tensor.Shape()[input_counters.Axis()];
-      copy = output - pitch;
-      for (int64_t repeat = (repeats[input_counters.Axis()] - 1) * pitch; repeat-- > 0;) {
-        *output++ = *copy++;
+
+  // drop each innermost input row into its output slot, then tile the last
+  // axis by doubling within the row. after this pass the region each outer
+  // axis tiles over is contiguous and fully materialized.
+  const int64_t inner = input_dims[dimension_count - 1];
+  const int64_t num_rows = input_size / inner;
+  std::vector<int64_t> row_indices(dimension_count - 1, 0);
+  const float* input_row = input;
+  for (int64_t row = 0; row < num_rows; ++row) {
+    int64_t output_offset = 0;
+    for (size_t axis = 0; axis + 1 < dimension_count; ++axis)
+      output_offset += row_indices[axis] * output_pitches[axis];
+
+    memcpy(output + output_offset, input_row, inner * sizeof(float));
+    TileDoubleRegion(output + output_offset, inner, repeats[dimension_count - 1]);
+
+    input_row += inner;
+    for (size_t axis = dimension_count - 1; axis-- > 0;) {
+      if (++row_indices[axis] < input_dims[axis])
+        break;
+      row_indices[axis] = 0;
+    }
+  }
+
+  // tile the remaining axes from innermost to outermost; each axis doubles
+  // contiguous regions that the previous passes finished.
+  for (size_t axis_plus_one = dimension_count - 1; axis_plus_one > 1; --axis_plus_one) {
+    const size_t axis = axis_plus_one - 1;
+    if (repeats[axis] == 1)
+      continue;
+
+    const int64_t block = output_pitches[axis] * input_dims[axis];
+    int64_t num_regions = 1;
+    for (size_t k = 0; k < axis; ++k)
+      num_regions *= input_dims[k];
+
+    std::vector<int64_t> prefix_indices(axis, 0);
+    for (int64_t region = 0; region < num_regions; ++region) {
+      int64_t output_offset = 0;
+      for (size_t k = 0; k < axis; ++k)
+        output_offset += prefix_indices[k] * output_pitches[k];
+
+      TileDoubleRegion(output + output_offset, block, repeats[axis]);
+
+      for (size_t k = axis; k-- > 0;) {
+        if (++prefix_indices[k] < input_dims[k])
+          break;
+        prefix_indices[k] = 0;
       }
     }
   }
+
+  if (dimension_count < 2 || repeats[0] == 1)
+    return Status::OK();
+
+  // the outermost axis repeats are independent copies of the fully tiled
+  // region below it, so spread them across the pool when the output is big
+  // enough to pay for the dispatch.
+  const int64_t block = output_pitches[0] * input_dims[0];
+  const int64_t outer_repeats = repeats[0] - 1;  // the first copy already exists
+
+  ctx->ParallelFor(0, outer_repeats, static_cast<double>(block * sizeof(float)),
+                   [output, block](int64_t first, int64_t last) {
+                     for (int64_t repeat = first; repeat < last; ++repeat)
+                       memcpy(output + (repeat + 1) * block, output, block * sizeof(float));
+                   });
+
   return Status::OK();
 }
 }  // namespace onnxruntime
@@ -13,8 +13,6 @@ struct Tile final : OpKernel {
   }
 
   Status Compute(OpKernelContext* context) const override;
-
- private:
 };
 
 }  // namespace onnxruntime
@@ -3,6 +3,15 @@
 
 #include "core/providers/cpu/tensor/transpose.h"
 
+#include <algorithm>
+#include <numeric>
+
+#include "core/common/work_stealing_thread_pool.h"
+
+#if defined(USE_MLAS)
+#include "core/mlas/inc/mlas.h"
+#endif
+
 namespace onnxruntime {
 
 /* A permutation [a,b,c,...] indicates that 
@@ -85,6 +94,138 @@ void DoTransposeSingleBlock(size_t num_elts_in_block, float* target, const float
   memcpy(target, source, blocksize);
 }
 
+#if defined(USE_MLAS)
+
+// CoalesceDims: drop dimensions of size 1 and merge runs of input dimensions that
+// stay adjacent and in order under the permutation. Many transposes become a rank-2,
+// rank-3 or rank-4 problem after coalescing, e.g. a [0,3,1,2] permutation of
+// [N,H,W,C] coalesces to a [0,2,1] permutation of [N,H*W,C].
+static void CoalesceDims(std::vector<int64_t>& dims, std::vector<int64_t>& perm) {
+  size_t rank = dims.size();
+
+  // drop the size-1 dimensions
+  std::vector<int64_t> axis_map(rank, -1);
+  std::vector<int64_t> kept_dims;
+  for (size_t i = 0; i < rank; ++i) {
+    if (dims[i] != 1) {
+      axis_map[i] = kept_dims.size();
+      kept_dims.push_back(dims[i]);
+    }
+  }
+
+  std::vector<int64_t> kept_perm;
+  for (int64_t axis : perm) {
+    if (axis_map[axis] != -1)
+      kept_perm.push_back(axis_map[axis]);
+  }
+
+  // group input axes that the permutation keeps adjacent and in order into runs
+  std::vector<std::pair<int64_t, int64_t>> runs;  // (first input axis of run, merged size)
+  for (size_t i = 0; i < kept_perm.size();) {
+    int64_t size = kept_dims[kept_perm[i]];
+    size_t j = i + 1;
+    while (j < kept_perm.size() && kept_perm[j] == kept_perm[j - 1] + 1) {
+      size *= kept_dims[kept_perm[j]];
+      ++j;
+    }
+    runs.emplace_back(kept_perm[i], size);
+    i = j;
+  }
+
+  // renumber the merged axes in input order
+  std::vector<size_t> by_input(runs.size());
+  std::iota(by_input.begin(), by_input.end(), 0);
+  std::sort(by_input.begin(), by_input.end(),
+            [&runs](size_t a, size_t b) { return runs[a].first < runs[b].first; });
+
+  dims.resize(runs.size());
+  perm.resize(runs.size());
+  for (size_t i = 0; i < by_input.size(); ++i) {
+    dims[i] = runs[by_input[i]].second;
+    perm[by_input[i]] = i;
+  }
+}
+
+// TransposeBlocks: transpose an M x N array of contiguous blocks of block_size
+// elements each, walking the array in square tiles so the scattered writes stay
+// cache resident.
+static void TransposeBlocks(const float* source, float* target,
+                            int64_t M, int64_t N, int64_t block_size) {
+  const int64_t kTileSize = 32;
+  const size_t block_bytes = block_size * sizeof(float);
+  for (int64_t mb = 0; mb < M; mb += kTileSize) {
+    const int64_t m_end = std::min(mb + kTileSize, M);
+    for (int64_t nb = 0; nb < N; nb += kTileSize) {
+      const int64_t n_end = std::min(nb + kTileSize, N);
+      for (int64_t m = mb; m < m_end; ++m) {
+        for (int64_t n = nb; n < n_end; ++n) {
+          memcpy(target + (n * M + m) * block_size,
+                 source + (m * N + n) * block_size, block_bytes);
+        }
+      }
+    }
+  }
+}
+
+// TryTransposeUsingMlas: recognize permutations that coalesce to a rank-2 transpose,
+// a batch of rank-2 transposes ([0,2,1]) or a batch of block transposes ([0,2,1,3],
+// the permutation inserted around attention blocks), run the 2-D cases through the
+// blocked MlasTranspose kernel and parallelize over the batch. Returns false if the
+// permutation does not match, in which case the caller uses the generic path.
+static bool TryTransposeUsingMlas(const std::vector<int64_t>& input_dims,
+                                  const std::vector<int64_t>& perm,
+                                  float* target, const float* source) {
+  std::vector<int64_t> dims = input_dims;
+  std::vector<int64_t> coalesced_perm = perm;
+  CoalesceDims(dims, coalesced_perm);
+
+  // anything that coalesced below rank 2 is a plain copy
+  if (dims.size() < 2) {
+    memcpy(target, source, (dims.empty() ? 1 : dims[0]) * sizeof(float));
+    return true;
+  }
+
+  // a rank-2 result is necessarily the permutation [1,0]
+  if (dims.size() == 2) {
+    MlasTranspose(source, target, dims[0], dims[1]);
+    return true;
+  }
+
+  // view a [1,0,2] permutation as a single-batch [0,2,1,3]
+  if (dims.size() == 3 && coalesced_perm == std::vector<int64_t>{1, 0, 2}) {
+    dims.insert(dims.begin(), 1);
+    coalesced_perm = {0, 2, 1, 3};
+  }
+
+  const bool batch_of_2d = dims.size() == 3 && coalesced_perm == std::vector<int64_t>{0, 2, 1};
+  const bool batch_of_blocks = dims.size() == 4 && coalesced_perm == std::vector<int64_t>{0, 2, 1, 3};
+  if (!batch_of_2d && !batch_of_blocks)
+    return false;
+
+  const int64_t num_batches = dims[0];
+  const int64_t M = dims[1];
+  const int64_t N = dims[2];
+  const int64_t block_size = batch_of_blocks ? dims[3] : 1;
+  const int64_t batch_size = M * N * block_size;
+
+  auto transpose_batches = [&](int64_t first, int64_t last) {
+    for (int64_t batch = first; batch < last; ++batch) {
+      const float* batch_source = source + batch * batch_size;
+      float* batch_target = target + batch * batch_size;
+      if (batch_of_2d)
+        MlasTranspose(batch_source, batch_target, M, N);
+      else
+        TransposeBlocks(batch_source, batch_target, M, N, block_size);
+    }
+  };
+
+  ParallelFor(0, num_batches, static_cast<double>(batch_size), transpose_batches);
+
+  return true;
+}
+
+#endif
+
 template <>
 Status Transpose<float>::Compute(OpKernelContext* ctx) const {
   // Get input and output:
@@ -114,6 +255,11 @@ Status Transpose<float>::Compute(OpKernelContext* ctx) const {
   const float* Xdata = X.template Data<float>();
   float* Ydata = Y->template MutableData<float>();
 
+#if defined(USE_MLAS)
+  if (TryTransposeUsingMlas(input_dims, *p_perm, Ydata, Xdata))
+    return Status::OK();
+#endif
+
   // Partition the permutation into a prefix and the largest suffix such that
   // every axis i in the suffix is mapped to i.
   int64_t num_axes_in_prefix = 0;  // number of axes in prefix
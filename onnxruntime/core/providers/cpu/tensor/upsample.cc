@@ -3,6 +3,7 @@
 
 #include "core/providers/cpu/tensor/upsample.h"
 #include <math.h>  //for fabs
+#include <cstring>
 
 using namespace ::onnxruntime::common;
 using namespace std;
@@ -22,57 +23,88 @@ ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<int32_t>()),
     Upsample<int32_t>);
 
-void upsampleNearest2x(
-    int64_t batch_size,
-    int64_t num_channels,
-    int64_t input_height,
-    int64_t input_width,
-    const float* input,
-    float* output) {
-  const int64_t output_height = input_height * 2;
-  const int64_t output_width = input_width * 2;
-  for (int64_t n = 0; n < batch_size; ++n) {
-    for (int64_t c = 0; c < num_channels; ++c) {
-      for (int64_t y = 0; y < output_height; ++y) {
-        const int64_t in_y = y / 2;
-        for (int64_t x = 0; x < input_width; ++x) {
-          const float v = input[in_y * input_width + x];
-          const int64_t oidx = output_width * y + x * 2;
-          output[oidx + 0] = v;
-          output[oidx + 1] = v;
-        }
-      }
-      input += input_height * input_width;
-      output += output_height * output_width;
+// Nearest mode reduced to per-row work at fixed shapes: every output row
+// (innermost axis) reads one input row, and within the row every output
+// element reads one input column. Both mappings are precomputed here so
+// execution is memcpy/gather per row; the plan is built once per shape
+// binding and reused across runs through the kernel's shape state.
+struct UpsampleNearestPlan {
+  std::vector<int64_t> row_source;     // per output row: element offset of its input row
+  std::vector<int64_t> column_source;  // per output column: input column; empty when rows copy whole
+  int64_t output_row_size;
+  int64_t num_rows;
+};
+
+static std::shared_ptr<UpsampleNearestPlan> BuildUpsampleNearestPlan(const TensorShape& input_shape,
+                                                                     const TensorShape& output_shape,
+                                                                     const vector<float>& scales) {
+  auto plan = std::make_shared<UpsampleNearestPlan>();
+  const auto n_dim = input_shape.NumDimensions();
+  if (n_dim == 0) {  // scalar: one element copied through
+    plan->output_row_size = 1;
+    plan->num_rows = 1;
+    plan->row_source.assign(1, 0);
+    return plan;
+  }
+  const int64_t input_row_size = input_shape[n_dim - 1];
+  plan->output_row_size = output_shape[n_dim - 1];
+  plan->num_rows = plan->output_row_size > 0 ? output_shape.Size() / plan->output_row_size : 0;
+
+  if (plan->output_row_size != input_row_size) {
+    plan->column_source.resize(plan->output_row_size);
+    for (int64_t x = 0; x < plan->output_row_size; ++x) {
+      plan->column_source[x] = std::min(static_cast<int64_t>(x / scales[n_dim - 1]), input_row_size - 1);
+    }
+  }
+
+  // input strides of the outer axes, in elements
+  std::vector<int64_t> input_strides(n_dim, input_row_size);
+  for (size_t j = n_dim - 1; j-- > 1;) {
+    input_strides[j - 1] = input_strides[j] * input_shape[j];
+  }
+
+  plan->row_source.resize(plan->num_rows);
+  std::vector<int64_t> counters(n_dim, 0);  // output coordinates of the outer axes
+  for (int64_t r = 0; r < plan->num_rows; ++r) {
+    int64_t offset = 0;
+    for (size_t j = 0; j + 1 < n_dim; ++j) {
+      offset += std::min(static_cast<int64_t>(counters[j] / scales[j]), input_shape[j] - 1) * input_strides[j];
+    }
+    plan->row_source[r] = offset;
+    for (size_t j = n_dim - 1; j-- > 0;) {
+      if (++counters[j] < output_shape[j]) break;
+      counters[j] = 0;
     }
   }
+  return plan;
 }
 
 template <typename T>
-Status upsampleNearest(const T* input,
-                       T* output,
-                       const TensorShape& input_shape,
-                       const TensorShape& output_shape,
-                       const vector<float>& scales) {
+Status upsampleNearest(OpKernelContext* context, const T* input, T* output, const UpsampleNearestPlan& plan) {
   if (!input || !output)
     return Status(ONNXRUNTIME, FAIL, "Upsample: input/output value is nullptr");
-  if (input_shape.NumDimensions() != output_shape.NumDimensions())
-    return Status(ONNXRUNTIME, FAIL, "Upsample: input/output value's dimension mismatch");
-  auto n_dim = input_shape.NumDimensions();
-  for (size_t i = 0, size = output_shape.Size(); i < size; i++) {
-    size_t old_idx = 0;
-    size_t cur_idx = i;
-
-    int64_t base = 1;
-    for (int64_t j = static_cast<int64_t>(n_dim - 1); j >= 0; j--) {
-      auto tmp = cur_idx % output_shape[j];
-      old_idx += (std::min(static_cast<int64_t>(tmp / scales[j]), input_shape[j] - 1)) * base;
-      base *= input_shape[j];
-      cur_idx /= output_shape[j];
-    }
 
-    output[i] = input[old_idx];
-  }
+  const int64_t row_size = plan.output_row_size;
+  context->ParallelFor(0, plan.num_rows, static_cast<double>(row_size),
+                       [input, output, &plan, row_size](int64_t first, int64_t last) {
+                         for (int64_t r = first; r < last; ++r) {
+                           T* dst = output + r * row_size;
+                           // a row repeated along an outer axis duplicates the row just built
+                           if (r > first && plan.row_source[r] == plan.row_source[r - 1]) {
+                             memcpy(dst, dst - row_size, row_size * sizeof(T));
+                             continue;
+                           }
+                           const T* src = input + plan.row_source[r];
+                           if (plan.column_source.empty()) {
+                             memcpy(dst, src, row_size * sizeof(T));
+                           } else {
+                             const int64_t* cols = plan.column_source.data();
+                             for (int64_t x = 0; x < row_size; ++x) {
+                               dst[x] = src[cols[x]];
+                             }
+                           }
+                         }
+                       });
   return Status::OK();
 }
 
@@ -207,8 +239,23 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context, const std::vector<floa
   Tensor* Y = context->Output(0, Y_dims);
 
   switch (mode_) {
-    case UpsampleMode::NN:
-      return upsampleNearest<T>(X->template Data<T>(), Y->template MutableData<T>(), X->Shape(), Y->Shape(), scales);
+    case UpsampleMode::NN: {
+      // The row plan is keyed on the input shapes, so it can only be reused
+      // across runs when the scales are static; a scales tensor fed at run
+      // time may change the mapping without changing any input shape.
+      const bool scales_are_static = OpKernel::Node().InputDefs().size() == 1 || scales_cached_;
+      std::shared_ptr<UpsampleNearestPlan> plan;
+      std::shared_ptr<void> cached_plan = scales_are_static ? context->TryGetShapeState() : nullptr;
+      if (cached_plan) {
+        plan = std::static_pointer_cast<UpsampleNearestPlan>(cached_plan);
+      } else {
+        plan = BuildUpsampleNearestPlan(X->Shape(), Y->Shape(), scales);
+        if (scales_are_static) {
+          context->SetShapeState(plan);
+        }
+      }
+      return upsampleNearest<T>(context, X->template Data<T>(), Y->template MutableData<T>(), *plan);
+    }
     case UpsampleMode::LINEAR: {
       //What's the correct behavior of linear mode is not clear right now,
       //Only support bilinear with 4D tensor to keep consistent with previous behavior
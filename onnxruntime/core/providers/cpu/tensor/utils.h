@@ -3,6 +3,7 @@
 
 #pragma once
 #include "gsl/gsl_algorithm"
+#include <array>
 namespace onnxruntime {
 
 struct TensorPitches : std::vector<int64_t> {
@@ -189,6 +190,121 @@ struct SliceIterator {
   std::vector<int64_t> indices_;  // There is no index for innermost axis since it's a special case
 };
 
+// Ranks for which SliceCopy gets a compile-time specialization. With Rank a
+// template parameter the counters live in fixed arrays and the per-run carry
+// loop below has a constant bound, so it unrolls into plain adds instead of
+// iterating a runtime-rank vector per element.
+constexpr size_t kSliceCopyMaxUnrolledRank = 5;
+
+// Copies a slice as `total_runs` contiguous runs of `inner_extent` elements.
+// skips[Rank - 1] moves past the unselected tail of the innermost axis after
+// each run; skips[axis] is the extra skip when axis carries (same layout as
+// SliceSkips).
+template <typename T, size_t Rank>
+void SliceCopyRuns(const T* input, T* output, int64_t total_runs, int64_t inner_extent,
+                   const int64_t* extents, const int64_t* skips) {
+  std::array<int64_t, Rank> indices{};
+  for (int64_t run = 0; run < total_runs; ++run) {
+    std::copy(input, input + inner_extent, output);
+    output += inner_extent;
+    input += inner_extent + skips[Rank - 1];
+    for (size_t axis = Rank - 1; axis-- > 0;) {
+      if (++indices[axis] != extents[axis])
+        break;
+      indices[axis] = 0;
+      input += skips[axis];
+    }
+  }
+}
+
+// Copies the slice of `tensor` given by starts/extents into `output`. Trailing
+// axes the slice takes whole are folded into one contiguous inner run lifted
+// into a single std::copy, and the remaining outer rank is dispatched once to
+// a compile-time specialization (up to kSliceCopyMaxUnrolledRank); deeper
+// shapes fall back to the generic SliceIterator. The copy walks forward, so
+// it stays safe when the output buffer overlaps the input at a lower address.
+template <typename T>
+void SliceCopy(const Tensor& tensor, gsl::span<const int64_t> starts,
+               gsl::span<const int64_t> extents, T* output, const T* output_end) {
+  auto& dims = tensor.Shape().GetDims();
+  const size_t rank = dims.size();
+  ONNXRUNTIME_ENFORCE(static_cast<ptrdiff_t>(rank) == starts.size() &&
+                      static_cast<ptrdiff_t>(rank) == extents.size());
+  if (output == output_end)
+    return;
+
+  // position input at the first selected element
+  const T* input = tensor.template Data<T>();
+  size_t pitch = 1;
+  for (size_t i = rank; i-- > 0;) {
+    input += pitch * starts[i];
+    pitch *= dims[i];
+  }
+
+  // fold trailing full axes into the inner run: when every axis inside
+  // inner_axis is taken whole, the run over [inner_axis, rank) is contiguous
+  size_t inner_axis = rank - 1;
+  while (inner_axis > 0 && extents[inner_axis] == dims[inner_axis])
+    --inner_axis;
+
+  const size_t effective_rank = inner_axis + 1;
+  if (effective_rank > kSliceCopyMaxUnrolledRank) {
+    SliceIterator<T> input_iterator(tensor, starts, extents);
+    while (output != output_end)
+      *output++ = *input_iterator++;
+    return;
+  }
+
+  int64_t inner_extent = 1;
+  int64_t inner_pitch = 1;
+  for (size_t i = inner_axis; i < rank; ++i) {
+    inner_extent *= extents[i];
+    inner_pitch *= dims[i];
+  }
+
+  // effective shape: dims/extents of the outer axes plus the folded inner run
+  std::array<int64_t, kSliceCopyMaxUnrolledRank> effective_dims;
+  std::array<int64_t, kSliceCopyMaxUnrolledRank> effective_extents;
+  for (size_t i = 0; i < inner_axis; ++i) {
+    effective_dims[i] = dims[i];
+    effective_extents[i] = extents[i];
+  }
+  effective_dims[inner_axis] = inner_pitch;
+  effective_extents[inner_axis] = inner_extent;
+
+  // skips over the effective shape, same math as SliceSkips
+  std::array<int64_t, kSliceCopyMaxUnrolledRank> skips;
+  int64_t skip_pitch = effective_dims[effective_rank - 1];
+  skips[effective_rank - 1] = skip_pitch - effective_extents[effective_rank - 1];
+  for (size_t i = effective_rank - 1; i-- > 0;) {
+    auto prev_pitch = skip_pitch;
+    skip_pitch *= effective_dims[i];
+    skips[i] = skip_pitch - prev_pitch * effective_extents[i];
+  }
+
+  int64_t total_runs = 1;
+  for (size_t i = 0; i < effective_rank - 1; ++i)
+    total_runs *= effective_extents[i];
+
+  switch (effective_rank) {
+    case 1:
+      SliceCopyRuns<T, 1>(input, output, total_runs, inner_extent, effective_extents.data(), skips.data());
+      break;
+    case 2:
+      SliceCopyRuns<T, 2>(input, output, total_runs, inner_extent, effective_extents.data(), skips.data());
+      break;
+    case 3:
+      SliceCopyRuns<T, 3>(input, output, total_runs, inner_extent, effective_extents.data(), skips.data());
+      break;
+    case 4:
+      SliceCopyRuns<T, 4>(input, output, total_runs, inner_extent, effective_extents.data(), skips.data());
+      break;
+    default:
+      SliceCopyRuns<T, 5>(input, output, total_runs, inner_extent, effective_extents.data(), skips.data());
+      break;
+  }
+}
+
 inline void CopyCpuTensor(const Tensor* src, Tensor* tgt) {
   void* target = tgt->MutableDataRaw();
   const void* source = src->DataRaw();
@@ -119,6 +119,10 @@ class CudaKernel : public OpKernel {
   };
 
  protected:
+  inline cudaStream_t GetStream(int queue_id) const {
+    return provider_->GetStream(queue_id);
+  }
+
   inline cublasHandle_t CublasHandle() const {
     return provider_->PerThreadCublasHandle();
   }
@@ -127,6 +131,14 @@ class CudaKernel : public OpKernel {
     return provider_->PerThreadCudnnHandle();
   }
 
+  // Checks out this thread's persistent workspace, valid until the next
+  // GetWorkspace call on the thread. Use for cublas/cudnn scratch that dies
+  // with the invocation; unlike GetScratchBuffer this does not allocate once
+  // the buffer has grown to the model's high-water requirement.
+  inline void* GetWorkspace(size_t bytes) const {
+    return provider_->PerThreadWorkspace(bytes);
+  }
+
   template <typename T>
   inline const T* GetConstOnes(size_t count) const {
     return provider_->template GetConstOnes<T>(count);
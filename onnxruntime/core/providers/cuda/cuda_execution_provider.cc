@@ -5,8 +5,10 @@
 #include "cuda_execution_provider.h"
 #include "core/framework/transformer_memcpy.h"
 #include "core/framework/memcpy.h"
+#include "core/providers/cuda/tensor/batched_memcpy.h"
 #include "cuda_fence.h"
 #include "cuda_allocator.h"
+#include "core/providers/cuda/nn/conv_algo_cache.h"
 #include "core/framework/kernel_registry.h"
 #include "core/framework/compute_capability.h"
 
@@ -38,10 +40,33 @@ ONNX_OPERATOR_KERNEL_EX(
         .TypeConstraint("T", DataTypeImpl::AllFixedSizeTensorTypes()),
     Memcpy);
 
+ONNX_OPERATOR_KERNEL_EX(
+    BatchedMemcpyFromHost,
+    kOnnxDomain,
+    1,
+    kCudaExecutionProvider,
+    KernelDefBuilder()
+        .InputMemoryType<ONNXRuntimeMemTypeCPUInput>(0, kBatchedMemcpyMaxTensors - 1)
+        .ExecQueueId(kCudaStreamCopyIn)
+        .TypeConstraint("T", DataTypeImpl::AllFixedSizeTensorTypes()),
+    BatchedMemcpyFromHost);
+
 }  // namespace cuda
 
 thread_local std::shared_ptr<CUDAExecutionProvider::PerThreadContext> CUDAExecutionProvider::per_thread_context_;
 thread_local AllocatorPtr CUDAExecutionProvider::per_thread_default_allocator_;
+thread_local std::shared_ptr<CUDAExecutionProvider::StreamSet> CUDAExecutionProvider::per_thread_streams_;
+
+CUDAExecutionProvider::StreamSet::StreamSet() {
+  streams[kCudaStreamDefault] = cudaStreamPerThread;
+  CUDA_CALL_THROW(cudaStreamCreateWithFlags(&streams[kCudaStreamCopyIn], cudaStreamNonBlocking));
+  CUDA_CALL_THROW(cudaStreamCreateWithFlags(&streams[kCudaStreamCopyOut], cudaStreamNonBlocking));
+}
+
+CUDAExecutionProvider::StreamSet::~StreamSet() {
+  CUDA_CALL_THROW(cudaStreamDestroy(streams[kCudaStreamCopyIn]));
+  CUDA_CALL_THROW(cudaStreamDestroy(streams[kCudaStreamCopyOut]));
+}
 
 CUDAExecutionProvider::PerThreadContext::PerThreadContext(int device_id) {
   CUDA_CALL_THROW(cudaSetDevice(device_id));
@@ -55,7 +80,15 @@ CUDAExecutionProvider::PerThreadContext::~PerThreadContext() {
 }
 
 CUDAExecutionProvider::CUDAExecutionProvider(const CUDAExecutionProviderInfo& info)
-    : device_id_(info.device_id) {
+    : device_id_(info.device_id), conv_algo_cache_path_(info.conv_algo_cache_path) {
+  if (!conv_algo_cache_path_.empty()) {
+    auto status = cuda::CudnnConvAlgoCache::Instance().Load(conv_algo_cache_path_);
+    if (!status.IsOK()) {
+      LOGS_DEFAULT(WARNING) << "Failed to load cudnn conv algo cache from " << conv_algo_cache_path_
+                            << ": " << status.ErrorMessage();
+    }
+  }
+
   CUDA_CALL_THROW(cudaSetDevice(device_id_));
   // create streams, default is nullptr
   streams_[kCudaStreamDefault] = nullptr;
@@ -64,7 +97,13 @@ CUDAExecutionProvider::CUDAExecutionProvider(const CUDAExecutionProviderInfo& in
 
   DeviceAllocatorRegistrationInfo default_allocator_info(
     {ONNXRuntimeMemTypeDefault, [](int id) { return std::make_unique<CUDAAllocator>(id); }, std::numeric_limits<size_t>::max()});
-  InsertAllocator(CreateAllocator(default_allocator_info, device_id_));
+  if (info.use_shared_arena) {
+    default_allocator_info.max_mem = info.shared_arena_max_mem;
+    InsertAllocator(std::make_shared<SessionArenaAccountant>(
+        SharedArenaRegistry::Instance().GetOrCreateArena(CUDA, default_allocator_info, device_id_)));
+  } else {
+    InsertAllocator(CreateAllocator(default_allocator_info, device_id_));
+  }
 
   DeviceAllocatorRegistrationInfo pinned_allocator_info(
     {ONNXRuntimeMemTypeCPUOutput, [](int) { return std::make_unique<CUDAPinnedAllocator>(); }, std::numeric_limits<size_t>::max()});
@@ -72,6 +111,14 @@ CUDAExecutionProvider::CUDAExecutionProvider(const CUDAExecutionProviderInfo& in
 }
 
 CUDAExecutionProvider::~CUDAExecutionProvider() {
+  if (!conv_algo_cache_path_.empty()) {
+    auto status = cuda::CudnnConvAlgoCache::Instance().Save(conv_algo_cache_path_);
+    if (!status.IsOK()) {
+      LOGS_DEFAULT(WARNING) << "Failed to save cudnn conv algo cache to " << conv_algo_cache_path_
+                            << ": " << status.ErrorMessage();
+    }
+  }
+
   auto cpu_alloc = GetAllocator(0, ONNXRuntimeMemTypeCPU);
   std::lock_guard<std::mutex> lock(deferred_release_cpu_ptr_mutex_);
   auto it = deferred_release_cpu_ptr_.begin();
@@ -103,6 +150,11 @@ void CUDAExecutionProvider::ReleasePerThreadStuffs() const {
     context_pool_.push_back(per_thread_context_);
     per_thread_context_.reset();
   }
+  if (per_thread_streams_) {
+    std::lock_guard<std::mutex> lock(stream_pool_mutex_);
+    stream_pool_.push_back(per_thread_streams_);
+    per_thread_streams_.reset();
+  }
 }
 
 AllocatorPtr CUDAExecutionProvider::GetAllocator(int id, ONNXRuntimeMemType mem_type) const {
@@ -177,6 +229,23 @@ Status CUDAExecutionProvider::OnRunStart() {
       context_pool_.pop_back();
     }
   }
+  // acquire a stream set for this run, store in TLS
+  {
+    std::lock_guard<std::mutex> stream_lock(stream_pool_mutex_);
+    if (stream_pool_.empty()) {
+      per_thread_streams_ = std::make_shared<StreamSet>();
+    } else {
+      per_thread_streams_ = stream_pool_.back();
+      stream_pool_.pop_back();
+    }
+  }
+  // route the library handles onto this run's compute stream so cublas and
+  // cudnn work interleaves with other runs instead of serializing on the
+  // legacy default stream
+  cudaStream_t compute_stream = per_thread_streams_->streams[kCudaStreamDefault];
+  CUBLAS_RETURN_IF_ERROR(cublasSetStream(per_thread_context_->CublasHandle(), compute_stream));
+  CUDNN_RETURN_IF_ERROR(cudnnSetStream(per_thread_context_->CudnnHandle(), compute_stream));
+
   auto& current_deferred_release_event = per_thread_context_->GetCurrentDeferredReleaseEvent();
   CUDA_RETURN_IF_ERROR(cudaEventCreate(&current_deferred_release_event, cudaEventDisableTiming));
   deferred_release_cpu_ptr_.emplace(current_deferred_release_event, DeferredReleaseCPUPtrs());
@@ -185,9 +254,9 @@ Status CUDAExecutionProvider::OnRunStart() {
 
 Status CUDAExecutionProvider::OnRunEnd() {
   ONNXRUNTIME_RETURN_IF_NOT(per_thread_context_ != nullptr);
-  // record deferred release event on default stream, and release per_thread_context
+  // record deferred release event on this run's compute stream, and release per_thread_context
   auto current_deferred_release_event = per_thread_context_->GetCurrentDeferredReleaseEvent();
-  CUDA_RETURN_IF_ERROR(cudaEventRecord(current_deferred_release_event, nullptr));
+  CUDA_RETURN_IF_ERROR(cudaEventRecord(current_deferred_release_event, GetStream(kCudaStreamDefault)));
   ReleasePerThreadStuffs();
   std::lock_guard<std::mutex> lock(deferred_release_cpu_ptr_mutex_);
   deferred_release_cpu_ptr_[current_deferred_release_event].recorded = true;
@@ -216,10 +285,10 @@ Status CUDAExecutionProvider::CopyTensor(const Tensor& src, Tensor& dst, int exe
   if (strcmp(dst.Location().name, CUDA) == 0) {
     if (strcmp(src.Location().name, CUDA_PINNED) == 0) {
       // copy from pinned memory to GPU, this is non-blocking
-      CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst_data, src_data, bytes, cudaMemcpyHostToDevice, streams_[exec_queue_id]));
+      CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst_data, src_data, bytes, cudaMemcpyHostToDevice, GetStream(exec_queue_id)));
     } else if (strcmp(src.Location().name, CUDA) == 0) {
       // copying between GPU, this is non-blocking
-      CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst_data, src_data, bytes, cudaMemcpyDeviceToDevice, streams_[kCudaStreamDefault]));
+      CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst_data, src_data, bytes, cudaMemcpyDeviceToDevice, GetStream(kCudaStreamDefault)));
     } else {
       // copy from other CPU memory to GPU, this is blocking
       CUDA_RETURN_IF_ERROR(cudaMemcpy(dst_data, src_data, bytes, cudaMemcpyHostToDevice));
@@ -227,7 +296,7 @@ Status CUDAExecutionProvider::CopyTensor(const Tensor& src, Tensor& dst, int exe
   } else if (strcmp(src.Location().name, CUDA) == 0) {
     if (strcmp(dst.Location().name, CUDA_PINNED) == 0) {
       // copying from GPU to pinned memory, this is non-blocking
-      CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst_data, src_data, bytes, cudaMemcpyDeviceToHost, streams_[exec_queue_id]));
+      CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst_data, src_data, bytes, cudaMemcpyDeviceToHost, GetStream(exec_queue_id)));
     } else {
       // copying from GPU to CPU memory, this is blocking
       CUDA_RETURN_IF_ERROR(cudaMemcpy(dst_data, src_data, bytes, cudaMemcpyDeviceToHost));
@@ -243,6 +312,7 @@ Status CUDAExecutionProvider::CopyTensor(const Tensor& src, Tensor& dst, int exe
 namespace cuda {
 class ONNX_OPERATOR_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 1, MemcpyFromHost);
 class ONNX_OPERATOR_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 1, MemcpyToHost);
+class ONNX_OPERATOR_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 1, BatchedMemcpyFromHost);
 class ONNX_OPERATOR_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 4, Concat);
 class ONNX_OPERATOR_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 1, Unsqueeze);
 class ONNX_OPERATOR_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 1, Flatten);
@@ -499,10 +569,12 @@ class ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain,
 class ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 7, double, Upsample);
 class ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 7, MLFloat16, Upsample);
 class ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 7, int32_t, Upsample);
+class ONNX_OPERATOR_KERNEL_CLASS_NAME(kCudaExecutionProvider, kMSDomain, 1, FusedElementwise);
 
 static void RegisterCudaKernels(std::function<void(KernelCreateInfo&&)> fn) {
   fn(BuildKernel<ONNX_OPERATOR_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 1, MemcpyFromHost)>());
   fn(BuildKernel<ONNX_OPERATOR_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 1, MemcpyToHost)>());
+  fn(BuildKernel<ONNX_OPERATOR_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 1, BatchedMemcpyFromHost)>());
   fn(BuildKernel<ONNX_OPERATOR_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 4, Concat)>());
   fn(BuildKernel<ONNX_OPERATOR_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 1, Unsqueeze)>());
   fn(BuildKernel<ONNX_OPERATOR_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 1, Flatten)>());
@@ -759,6 +831,7 @@ static void RegisterCudaKernels(std::function<void(KernelCreateInfo&&)> fn) {
   fn(BuildKernel<ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 7, double, Upsample)>());
   fn(BuildKernel<ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 7, MLFloat16, Upsample)>());
   fn(BuildKernel<ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 7, int32_t, Upsample)>());
+  fn(BuildKernel<ONNX_OPERATOR_KERNEL_CLASS_NAME(kCudaExecutionProvider, kMSDomain, 1, FusedElementwise)>());
 }
 
 }  // namespace cuda
@@ -8,12 +8,26 @@
 #include "core/framework/execution_provider.h"
 #include "shared_inc/cuda_utils.h"
 #include <deque>
+#include <limits>
 
 namespace onnxruntime {
 
 // Information needed to construct CUDA execution providers.
 struct CUDAExecutionProviderInfo {
   int device_id{0};
+
+  // Draw from the environment-wide CUDA arena for this device, shared with
+  // other sessions that opt in, instead of growing a private arena.
+  // See SharedArenaRegistry; the cap only applies if this session creates
+  // the arena.
+  bool use_shared_arena{false};
+  size_t shared_arena_max_mem{std::numeric_limits<size_t>::max()};
+
+  // When non-empty, the cudnn convolution algorithm cache is loaded from
+  // this file at provider construction and saved back at destruction, so
+  // later startups skip the exhaustive algorithm search.
+  // See CudnnConvAlgoCache.
+  std::string conv_algo_cache_path;
 };
 
 enum CUDAStreamType : int {
@@ -65,8 +79,20 @@ class CUDAExecutionProvider : public IExecutionProvider {
     return per_thread_context_->CudnnHandle();
   }
 
+  void* PerThreadWorkspace(size_t bytes) {
+    // Assure each thread has its TLS context.
+    if (!per_thread_context_)
+      per_thread_context_ = std::make_shared<PerThreadContext>(device_id_);
+    return per_thread_context_->GetWorkspace(bytes, GetAllocator(ONNXRuntimeMemTypeDefault));
+  }
+
   cudaStream_t GetStream(int queue_id) const {
     ONNXRUNTIME_ENFORCE(queue_id >= 0 && queue_id < kTotalCudaStreams);
+    // Inside a Run() each thread works on a stream set acquired from the
+    // pool, so concurrent runs overlap kernels with copies instead of
+    // serializing on the shared streams.
+    if (per_thread_streams_)
+      return per_thread_streams_->streams[queue_id];
     return streams_[queue_id];
   }
 
@@ -94,8 +120,21 @@ class CUDAExecutionProvider : public IExecutionProvider {
   GetCapability(const onnxruntime::GraphViewer& graph,
                 const std::vector<const KernelRegistry*>& kernel_registries) const override;
  private:
+  // Streams acquired by one Run(). The compute entry is the per-thread
+  // default stream (the kernels are compiled with --default-stream
+  // per-thread), and the copy entries are dedicated transfer streams that
+  // the fences synchronize against the compute stream with events. Pooling
+  // a set per Run() lets concurrent runs on one device overlap.
+  struct StreamSet {
+    StreamSet();
+    ~StreamSet();
+
+    cudaStream_t streams[kTotalCudaStreams];
+  };
+
   cudaStream_t streams_[kTotalCudaStreams];
   int device_id_;
+  const std::string conv_algo_cache_path_;
 
   struct DeferredReleaseCPUPtrs {
     bool recorded = false;
@@ -143,10 +182,30 @@ class CUDAExecutionProvider : public IExecutionProvider {
       }
     }
 
+    // Persistent cublas/cudnn workspace for this thread. Kernels on one
+    // thread run one at a time, so the buffer is free between invocations;
+    // it grows to the high-water requirement seen so far and is then handed
+    // out by pointer, so warmed-up runs do no device allocation for
+    // workspaces. Contexts are pooled across runs, which keeps the buffer
+    // alive for the lifetime of the provider.
+    void* GetWorkspace(size_t bytes, const AllocatorPtr& allocator) {
+      if (bytes > workspace_bytes_) {
+        // release before growing so the device never holds both buffers
+        workspace_ = nullptr;
+        workspace_bytes_ = 0;
+        workspace_ = IAllocator::MakeUniquePtr<void>(allocator, bytes);
+        workspace_bytes_ = bytes;
+      }
+      return workspace_.get();
+    }
+
    private:
     cublasHandle_t cublas_handle_ = nullptr;
     cudnnHandle_t cudnn_handle_ = nullptr;
 
+    IAllocatorUniquePtr<void> workspace_;
+    size_t workspace_bytes_ = 0;
+
     // deferred release for temporary CPU pinned memory used in cudaMemcpyAsync
     // note that cudaEvent will be assigned at OnRunEnd() when PerThreadContext destory
     // so the ownership is passed to deferred_release_cpu_ptr_
@@ -160,6 +219,9 @@ class CUDAExecutionProvider : public IExecutionProvider {
   // thread local context during execution
   static thread_local std::shared_ptr<PerThreadContext> per_thread_context_;
 
+  // thread local stream set during execution
+  static thread_local std::shared_ptr<StreamSet> per_thread_streams_;
+
   // thread local GPU memory allocator. could be used before execution
   static thread_local AllocatorPtr per_thread_default_allocator_;
 
@@ -171,6 +233,10 @@ class CUDAExecutionProvider : public IExecutionProvider {
   mutable std::deque<std::shared_ptr<PerThreadContext>> context_pool_;
   mutable std::mutex context_pool_mutex_;
 
+  // reuse thread local stream sets
+  mutable std::deque<std::shared_ptr<StreamSet>> stream_pool_;
+  mutable std::mutex stream_pool_mutex_;
+
   void ReleasePerThreadStuffs() const;
 
   bool RNNNeedFallbackToCPU(const onnxruntime::Node& node, const std::vector<std::string> activations_supported, const std::string& op_type) const;
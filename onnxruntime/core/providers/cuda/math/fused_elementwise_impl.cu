@@ -0,0 +1,81 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "fused_elementwise_impl.h"
+#include "core/providers/cuda/cu_inc/common.cuh"
+
+namespace onnxruntime {
+namespace cuda {
+
+__global__ void _FusedElementwise(
+    FusedElementwiseArgs args,
+    float* output_data,
+    CUDA_LONG N) {
+  CALCULATE_ELEMENTWISE_INDEX_OR_EXIT(id, N);
+
+  // walk the chain with the running value in a register; binary steps pull
+  // their second operand from the next unused input
+  float value = args.inputs[0][id];
+  int32_t next_input = 1;
+  for (int32_t s = 0; s < args.step_count; ++s) {
+    const FusedElementwiseStep& step = args.steps[s];
+    float operand = 0.0f;
+    if (step.is_binary != 0)
+      operand = args.inputs[next_input++][id];
+
+    switch (step.kind) {
+      case FusedElementwiseOpKind::Add:
+        value += operand;
+        break;
+      case FusedElementwiseOpKind::Sub:
+        value -= operand;
+        break;
+      case FusedElementwiseOpKind::Mul:
+        value *= operand;
+        break;
+      case FusedElementwiseOpKind::Div:
+        value /= operand;
+        break;
+      case FusedElementwiseOpKind::Relu:
+        value = value > 0.0f ? value : 0.0f;
+        break;
+      case FusedElementwiseOpKind::LeakyRelu:
+        value = value >= 0.0f ? value : step.alpha * value;
+        break;
+      case FusedElementwiseOpKind::Sigmoid:
+        value = 1.0f / (1.0f + _Exp(-value));
+        break;
+      case FusedElementwiseOpKind::Tanh:
+        value = _Tanh(value);
+        break;
+      case FusedElementwiseOpKind::Exp:
+        value = _Exp(value);
+        break;
+      case FusedElementwiseOpKind::Log:
+        value = _Log(value);
+        break;
+      case FusedElementwiseOpKind::Sqrt:
+        value = _Sqrt(value);
+        break;
+      case FusedElementwiseOpKind::Neg:
+        value = -value;
+        break;
+      case FusedElementwiseOpKind::Abs:
+        value = fabsf(value);
+        break;
+    }
+  }
+
+  output_data[id] = value;
+}
+
+void FusedElementwiseImpl(const FusedElementwiseArgs& args, float* output_data, size_t count) {
+  if (count == 0)
+    return;
+  int blocksPerGrid = (int)(ceil(static_cast<float>(count) / GridDim::maxThreadsPerBlock));
+  CUDA_LONG N = static_cast<CUDA_LONG>(count);
+  _FusedElementwise<<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0>>>(args, output_data, N);
+}
+
+}  // namespace cuda
+}  // namespace onnxruntime
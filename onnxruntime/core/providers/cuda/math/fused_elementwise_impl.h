@@ -0,0 +1,52 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include <stdint.h>
+#include "core/providers/cuda/shared_inc/cuda_utils.h"
+
+namespace onnxruntime {
+namespace cuda {
+
+// Chain encoding shared by the host kernel and the .cu implementation. The
+// whole argument block goes to the launch by value, so a fused chain of any
+// length up to the cap costs exactly one kernel launch and no staging
+// buffers on either side.
+constexpr int32_t kFusedElementwiseMaxSteps = 15;
+constexpr int32_t kFusedElementwiseMaxInputs = kFusedElementwiseMaxSteps + 1;
+
+// mirrors the op set ElementwiseFusion is allowed to fold
+enum class FusedElementwiseOpKind : int32_t {
+  Add,
+  Sub,
+  Mul,
+  Div,
+  Relu,
+  LeakyRelu,
+  Sigmoid,
+  Tanh,
+  Exp,
+  Log,
+  Sqrt,
+  Neg,
+  Abs,
+};
+
+// one step of the chain; binary steps consume the next unused input
+struct FusedElementwiseStep {
+  FusedElementwiseOpKind kind;
+  int32_t is_binary;
+  float alpha;  // LeakyRelu slope
+};
+
+struct FusedElementwiseArgs {
+  FusedElementwiseStep steps[kFusedElementwiseMaxSteps];
+  const float* inputs[kFusedElementwiseMaxInputs];
+  int32_t step_count;
+  int32_t input_count;
+};
+
+void FusedElementwiseImpl(const FusedElementwiseArgs& args, float* output_data, size_t count);
+
+}  // namespace cuda
+}  // namespace onnxruntime
@@ -4,6 +4,7 @@
 #include "core/providers/common.h"
 #include "core/providers/cuda/cuda_common.h"
 #include "core/providers/cuda/nn/conv.h"
+#include "core/providers/cuda/nn/conv_algo_cache.h"
 #include "core/providers/cuda/shared_inc/fpgeneric.h"
 
 namespace onnxruntime {
@@ -102,8 +103,6 @@ Status Conv<T>::ComputeInternal(OpKernelContext* context) const {
       ONNXRUNTIME_RETURN_IF_ERROR(s_.conv_desc.Set(kernel_shape.size(), pads, strides, dilations, mode, CudnnTensor::GetDataType<CudaT>()));
       CUDNN_RETURN_IF_ERROR(cudnnSetConvolutionGroupCount(s_.conv_desc, gsl::narrow_cast<int>(group_)));
 
-      IAllocatorUniquePtr<void> algo_search_workspace = GetScratchBuffer<void>(AlgoSearchWorkspaceSize);
-
       if (has_bias) {
         const Tensor* B = context->Input<Tensor>(2);
         const auto& b_shape = B->Shape();
@@ -120,29 +119,45 @@ Status Conv<T>::ComputeInternal(OpKernelContext* context) const {
       Tensor* Y = context->Output(0, TensorShape(s_.y_dims));
       y_data = reinterpret_cast<CudaT*>(Y->template MutableData<T>());
 
-      // set math type to tensor core before algorithm search
-      if (std::is_same<T, MLFloat16>::value)
-        CUDNN_RETURN_IF_ERROR(cudnnSetConvolutionMathType(s_.conv_desc, CUDNN_TENSOR_OP_MATH));
-
-      cudnnConvolutionFwdAlgoPerf_t perf;
-      int algo_count = 1;
-      CUDNN_RETURN_IF_ERROR(cudnnFindConvolutionForwardAlgorithmEx(
-          CudnnHandle(),
-          s_.x_tensor,
-          x_data,
-          s_.filter_desc,
-          w_data,
-          s_.conv_desc,
-          s_.y_tensor,
-          y_data,
-          1,
-          &algo_count,
-          &perf,
-          algo_search_workspace.get(),
-          AlgoSearchWorkspaceSize));
-      CUDNN_RETURN_IF_ERROR(cudnnSetConvolutionMathType(s_.conv_desc, perf.mathType));
-      s_.algo = perf.algo;
-      s_.workspace_bytes = perf.memory;
+      const std::string algo_key = CudnnConvAlgoCache::MakeKey(
+          "fwd", CudnnTensor::GetDataType<CudaT>(), group_, x_dims_cudnn, w_dims, pads, strides, dilations);
+      CudnnConvAlgoCache::Entry algo_entry;
+      if (CudnnConvAlgoCache::Instance().Lookup(algo_key, algo_entry)) {
+        // this configuration was already benchmarked, either by another
+        // kernel in this process or by a loaded cache file; reuse the winner
+        // and skip the exhaustive search.
+        CUDNN_RETURN_IF_ERROR(cudnnSetConvolutionMathType(s_.conv_desc, static_cast<cudnnMathType_t>(algo_entry.math_type)));
+        s_.algo = static_cast<cudnnConvolutionFwdAlgo_t>(algo_entry.algo);
+        s_.workspace_bytes = algo_entry.workspace_bytes;
+      } else {
+        void* algo_search_workspace = GetWorkspace(AlgoSearchWorkspaceSize);
+
+        // set math type to tensor core before algorithm search
+        if (std::is_same<T, MLFloat16>::value)
+          CUDNN_RETURN_IF_ERROR(cudnnSetConvolutionMathType(s_.conv_desc, CUDNN_TENSOR_OP_MATH));
+
+        cudnnConvolutionFwdAlgoPerf_t perf;
+        int algo_count = 1;
+        CUDNN_RETURN_IF_ERROR(cudnnFindConvolutionForwardAlgorithmEx(
+            CudnnHandle(),
+            s_.x_tensor,
+            x_data,
+            s_.filter_desc,
+            w_data,
+            s_.conv_desc,
+            s_.y_tensor,
+            y_data,
+            1,
+            &algo_count,
+            &perf,
+            algo_search_workspace,
+            AlgoSearchWorkspaceSize));
+        CUDNN_RETURN_IF_ERROR(cudnnSetConvolutionMathType(s_.conv_desc, perf.mathType));
+        s_.algo = perf.algo;
+        s_.workspace_bytes = perf.memory;
+        CudnnConvAlgoCache::Instance().Insert(
+            algo_key, {static_cast<int>(perf.algo), static_cast<int>(perf.mathType), perf.memory});
+      }
     }
   }
 
@@ -154,7 +169,7 @@ Status Conv<T>::ComputeInternal(OpKernelContext* context) const {
   const auto alpha = Consts<CudaT>::One;
   const auto beta = Consts<CudaT>::Zero;
 
-  IAllocatorUniquePtr<void> workspace = GetScratchBuffer<void>(s_.workspace_bytes);
+  void* workspace = GetWorkspace(s_.workspace_bytes);
 
   CUDNN_RETURN_IF_ERROR(cudnnConvolutionForward(CudnnHandle(),
                                                 &alpha,
@@ -164,7 +179,7 @@ Status Conv<T>::ComputeInternal(OpKernelContext* context) const {
                                                 w_data,
                                                 s_.conv_desc,
                                                 s_.algo,
-                                                workspace.get(),
+                                                workspace,
                                                 s_.workspace_bytes,
                                                 &beta,
                                                 s_.y_tensor,
@@ -0,0 +1,99 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cuda/nn/conv_algo_cache.h"
+
+#include <fstream>
+#include <sstream>
+
+namespace onnxruntime {
+namespace cuda {
+
+CudnnConvAlgoCache& CudnnConvAlgoCache::Instance() {
+  static CudnnConvAlgoCache instance;
+  return instance;
+}
+
+static void AppendDims(std::ostringstream& oss, char tag, const std::vector<int64_t>& dims) {
+  oss << '|' << tag << '=';
+  for (size_t i = 0; i < dims.size(); i++) {
+    if (i > 0)
+      oss << ',';
+    oss << dims[i];
+  }
+}
+
+std::string CudnnConvAlgoCache::MakeKey(const char* kind,
+                                        int data_type,
+                                        int64_t group,
+                                        const std::vector<int64_t>& x_dims,
+                                        const std::vector<int64_t>& w_dims,
+                                        const std::vector<int64_t>& pads,
+                                        const std::vector<int64_t>& strides,
+                                        const std::vector<int64_t>& dilations) {
+  std::ostringstream oss;
+  oss << kind << "|dt=" << data_type << "|g=" << group;
+  AppendDims(oss, 'x', x_dims);
+  AppendDims(oss, 'w', w_dims);
+  AppendDims(oss, 'p', pads);
+  AppendDims(oss, 's', strides);
+  AppendDims(oss, 'd', dilations);
+  return oss.str();
+}
+
+bool CudnnConvAlgoCache::Lookup(const std::string& key, Entry& entry) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = entries_.find(key);
+  if (it == entries_.end())
+    return false;
+  entry = it->second;
+  return true;
+}
+
+void CudnnConvAlgoCache::Insert(const std::string& key, const Entry& entry) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_[key] = entry;
+  dirty_ = true;
+}
+
+common::Status CudnnConvAlgoCache::Load(const std::string& path) {
+  std::ifstream file(path);
+  if (!file) {
+    // no cache has been saved yet; it will be written on shutdown.
+    return Status::OK();
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::string key;
+  Entry entry;
+  while (file >> key >> entry.algo >> entry.math_type >> entry.workspace_bytes) {
+    entries_[key] = entry;
+  }
+  if (!file.eof()) {
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, "Malformed cudnn conv algo cache file: ", path);
+  }
+  return Status::OK();
+}
+
+common::Status CudnnConvAlgoCache::Save(const std::string& path) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!dirty_)
+    return Status::OK();
+
+  std::ofstream file(path, std::ios::trunc);
+  if (!file) {
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, "Could not open cudnn conv algo cache file for writing: ", path);
+  }
+  for (const auto& entry : entries_) {
+    file << entry.first << ' ' << entry.second.algo << ' '
+         << entry.second.math_type << ' ' << entry.second.workspace_bytes << '\n';
+  }
+  if (!file) {
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed writing cudnn conv algo cache file: ", path);
+  }
+  dirty_ = false;
+  return Status::OK();
+}
+
+}  // namespace cuda
+}  // namespace onnxruntime
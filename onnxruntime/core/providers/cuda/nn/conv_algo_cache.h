@@ -0,0 +1,72 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/status.h"
+
+namespace onnxruntime {
+namespace cuda {
+
+// Process-wide cache of the winners of the exhaustive cudnn convolution
+// algorithm searches. Conv kernels consult it before running
+// cudnnFindConvolution*AlgorithmEx, so a configuration is only ever
+// benchmarked once per process regardless of how many kernels or sessions
+// hit it. The cache can be serialized to a file and loaded back on the next
+// startup (see CUDAExecutionProviderInfo::conv_algo_cache_path), which makes
+// cold starts skip the search entirely.
+//
+// Algorithms and math types are stored as plain ints so forward and
+// backward-data searches can share one cache; the textual key encodes the
+// search kind along with the shapes and convolution parameters.
+class CudnnConvAlgoCache {
+ public:
+  struct Entry {
+    int algo;
+    int math_type;
+    size_t workspace_bytes;
+  };
+
+  static CudnnConvAlgoCache& Instance();
+
+  // Builds the lookup key for one convolution configuration. kind
+  // distinguishes the search direction ("fwd", "bwddata"); data_type is the
+  // cudnnDataType_t of the operands.
+  static std::string MakeKey(const char* kind,
+                             int data_type,
+                             int64_t group,
+                             const std::vector<int64_t>& x_dims,
+                             const std::vector<int64_t>& w_dims,
+                             const std::vector<int64_t>& pads,
+                             const std::vector<int64_t>& strides,
+                             const std::vector<int64_t>& dilations);
+
+  bool Lookup(const std::string& key, Entry& entry) const;
+
+  void Insert(const std::string& key, const Entry& entry);
+
+  // Merges the entries from a previously saved cache file. A missing file is
+  // not an error, as the file is only created once a cache has been saved.
+  common::Status Load(const std::string& path);
+
+  // Writes the cache out if any entries were added since the last Load/Save.
+  common::Status Save(const std::string& path);
+
+ private:
+  CudnnConvAlgoCache() = default;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, Entry> entries_;
+  bool dirty_ = false;
+
+  ONNXRUNTIME_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CudnnConvAlgoCache);
+};
+
+}  // namespace cuda
+}  // namespace onnxruntime
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "conv_transpose.h"
+#include "core/providers/cuda/nn/conv_algo_cache.h"
 
 namespace onnxruntime {
 namespace cuda {
@@ -67,8 +68,6 @@ Status ConvTranspose<T>::ComputeInternal(OpKernelContext* context) const {
       ONNXRUNTIME_RETURN_IF_ERROR(s_.conv_desc.Set(p.kernel_shape.size(), p.pads, p.strides, p.dilations, mode, CudnnTensor::GetDataType<CudaT>()));
       CUDNN_RETURN_IF_ERROR(cudnnSetConvolutionGroupCount(s_.conv_desc, gsl::narrow_cast<int>(group_)));
 
-      IAllocatorUniquePtr<void> algo_search_workspace = GetScratchBuffer<void>(AlgoSearchWorkspaceSize);
-
       if (has_bias) {
         const auto& b_shape = p.B->Shape();
         ONNXRUNTIME_RETURN_IF_NOT(b_shape.NumDimensions() == 1, "bias should be 1D");
@@ -83,29 +82,45 @@ Status ConvTranspose<T>::ComputeInternal(OpKernelContext* context) const {
 
       y_data = reinterpret_cast<CudaT*>(p.Y->template MutableData<T>());
 
-      // set math type to tensor core before algorithm search
-      if (std::is_same<T, MLFloat16>::value)
-        CUDNN_RETURN_IF_ERROR(cudnnSetConvolutionMathType(s_.conv_desc, CUDNN_TENSOR_OP_MATH));
-
-      cudnnConvolutionBwdDataAlgoPerf_t perf;
-      int algo_count = 1;
-      CUDNN_RETURN_IF_ERROR(cudnnFindConvolutionBackwardDataAlgorithmEx(
-          CudnnHandle(),
-          s_.filter_desc,
-          w_data,
-          s_.x_tensor,
-          x_data,
-          s_.conv_desc,
-          s_.y_tensor,
-          y_data,
-          1,
-          &algo_count,
-          &perf,
-          algo_search_workspace.get(),
-          AlgoSearchWorkspaceSize));
-      CUDNN_RETURN_IF_ERROR(cudnnSetConvolutionMathType(s_.conv_desc, perf.mathType));
-      s_.algo = perf.algo;
-      s_.workspace_bytes = perf.memory;
+      const std::string algo_key = CudnnConvAlgoCache::MakeKey(
+          "bwddata", CudnnTensor::GetDataType<CudaT>(), group_, x_dims, w_dims, p.pads, p.strides, p.dilations);
+      CudnnConvAlgoCache::Entry algo_entry;
+      if (CudnnConvAlgoCache::Instance().Lookup(algo_key, algo_entry)) {
+        // this configuration was already benchmarked, either by another
+        // kernel in this process or by a loaded cache file; reuse the winner
+        // and skip the exhaustive search.
+        CUDNN_RETURN_IF_ERROR(cudnnSetConvolutionMathType(s_.conv_desc, static_cast<cudnnMathType_t>(algo_entry.math_type)));
+        s_.algo = static_cast<cudnnConvolutionBwdDataAlgo_t>(algo_entry.algo);
+        s_.workspace_bytes = algo_entry.workspace_bytes;
+      } else {
+        void* algo_search_workspace = GetWorkspace(AlgoSearchWorkspaceSize);
+
+        // set math type to tensor core before algorithm search
+        if (std::is_same<T, MLFloat16>::value)
+          CUDNN_RETURN_IF_ERROR(cudnnSetConvolutionMathType(s_.conv_desc, CUDNN_TENSOR_OP_MATH));
+
+        cudnnConvolutionBwdDataAlgoPerf_t perf;
+        int algo_count = 1;
+        CUDNN_RETURN_IF_ERROR(cudnnFindConvolutionBackwardDataAlgorithmEx(
+            CudnnHandle(),
+            s_.filter_desc,
+            w_data,
+            s_.x_tensor,
+            x_data,
+            s_.conv_desc,
+            s_.y_tensor,
+            y_data,
+            1,
+            &algo_count,
+            &perf,
+            algo_search_workspace,
+            AlgoSearchWorkspaceSize));
+        CUDNN_RETURN_IF_ERROR(cudnnSetConvolutionMathType(s_.conv_desc, perf.mathType));
+        s_.algo = perf.algo;
+        s_.workspace_bytes = perf.memory;
+        CudnnConvAlgoCache::Instance().Insert(
+            algo_key, {static_cast<int>(perf.algo), static_cast<int>(perf.mathType), perf.memory});
+      }
     }
   }
 
@@ -117,7 +132,7 @@ Status ConvTranspose<T>::ComputeInternal(OpKernelContext* context) const {
   const auto alpha = Consts<CudaT>::One;
   const auto beta = Consts<CudaT>::Zero;
 
-  IAllocatorUniquePtr<void> workspace = GetScratchBuffer<void>(s_.workspace_bytes);
+  void* workspace = GetWorkspace(s_.workspace_bytes);
 
   CUDNN_RETURN_IF_ERROR(
       cudnnConvolutionBackwardData(
@@ -129,7 +144,7 @@ Status ConvTranspose<T>::ComputeInternal(OpKernelContext* context) const {
           x_data,
           s_.conv_desc,
           s_.algo,
-          workspace.get(),
+          workspace,
           s_.workspace_bytes,
           &beta,
           s_.y_tensor,
@@ -236,7 +236,7 @@ Status CudnnRnnBase<T>::ComputeInternal(OpKernelContext* ctx) const {
   size_t workspace_bytes;
   CUDNN_RETURN_IF_ERROR(cudnnGetRNNWorkspaceSize(CudnnHandle(), rnn_desc_, gsl::narrow_cast<int>(seq_length), x_desc.data(), &workspace_bytes));
   workspace_bytes *= num_directions_;
-  auto workspace_cuda = GetScratchBuffer<void>(workspace_bytes);
+  void* workspace_cuda = GetWorkspace(workspace_bytes);
 
   CUDNN_RETURN_IF_ERROR(cudnnRNNForwardInference(CudnnHandle(),
                                                  rnn_desc_,
@@ -255,7 +255,7 @@ Status CudnnRnnBase<T>::ComputeInternal(OpKernelContext* ctx) const {
                                                  y_h_data,
                                                  y_c_desc,
                                                  y_c_data,
-                                                 workspace_cuda.get(),
+                                                 workspace_cuda,
                                                  workspace_bytes));
   IAllocatorUniquePtr<T> y_reorganized_data;
   if (reverse_ || num_directions_ == 2) {
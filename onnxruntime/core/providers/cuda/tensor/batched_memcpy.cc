@@ -0,0 +1,62 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "batched_memcpy.h"
+
+namespace onnxruntime {
+namespace cuda {
+
+// Pad each tensor's slot in the packed buffer so the device-side scatter
+// always reads naturally aligned addresses.
+constexpr size_t kBatchedMemcpyAlignment = 256;
+
+Status BatchedMemcpyFromHost::ComputeInternal(OpKernelContext* context) const {
+  int input_count = context->InputCount();
+
+  std::vector<size_t> byte_offsets(input_count);
+  std::vector<size_t> byte_sizes(input_count);
+  size_t total_bytes = 0;
+  for (int i = 0; i < input_count; ++i) {
+    const Tensor* X = context->Input<Tensor>(i);
+    ONNXRUNTIME_ENFORCE(X != nullptr);
+    byte_sizes[i] = X->Size();
+    byte_offsets[i] = total_bytes;
+    total_bytes += (byte_sizes[i] + kBatchedMemcpyAlignment - 1) & ~(kBatchedMemcpyAlignment - 1);
+  }
+
+  auto staging_buffer = AllocateBufferOnCPUPinned<char>(0, total_bytes);
+  if (!staging_buffer) {
+    // no pinned allocator is registered, fall back to one copy per tensor
+    for (int i = 0; i < input_count; ++i) {
+      const Tensor* X = context->Input<Tensor>(i);
+      Tensor* Y = context->Output(i, X->Shape());
+      ONNXRUNTIME_RETURN_IF_ERROR(CopyTensor(*X, *Y));
+    }
+    return Status::OK();
+  }
+
+  for (int i = 0; i < input_count; ++i) {
+    const Tensor* X = context->Input<Tensor>(i);
+    memcpy(staging_buffer.get() + byte_offsets[i], X->DataRaw(), byte_sizes[i]);
+  }
+
+  auto packed_gpu_buffer = GetScratchBuffer<char>(total_bytes);
+  cudaStream_t stream = GetStream(Info().GetKernelDef().ExecQueueId());
+  CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(packed_gpu_buffer.get(), staging_buffer.get(), total_bytes,
+                                       cudaMemcpyHostToDevice, stream));
+  AddDeferredReleaseCPUPtr(staging_buffer.release());
+
+  // Scatter the packed buffer into the individual outputs. These are cheap
+  // device-to-device copies issued on the same stream as the upload.
+  for (int i = 0; i < input_count; ++i) {
+    const Tensor* X = context->Input<Tensor>(i);
+    Tensor* Y = context->Output(i, X->Shape());
+    CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(Y->MutableDataRaw(), packed_gpu_buffer.get() + byte_offsets[i],
+                                         byte_sizes[i], cudaMemcpyDeviceToDevice, stream));
+  }
+
+  return Status::OK();
+}
+
+}  // namespace cuda
+}  // namespace onnxruntime
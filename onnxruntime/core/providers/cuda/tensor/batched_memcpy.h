@@ -0,0 +1,22 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+#include "core/providers/cuda/cuda_common.h"
+
+namespace onnxruntime {
+namespace cuda {
+
+// Kernel for the internal BatchedMemcpyFromHost node emitted by the memcpy
+// transformer. All inputs arrive in host memory; they are packed into one
+// pinned staging buffer, uploaded with a single transfer and scattered into
+// the individual outputs on the device.
+class BatchedMemcpyFromHost final : public CudaKernel {
+ public:
+  BatchedMemcpyFromHost(const OpKernelInfo& info) : CudaKernel(info) {}
+  Status ComputeInternal(OpKernelContext* context) const override;
+};
+
+}  // namespace cuda
+}  // namespace onnxruntime
@@ -404,18 +404,42 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
 
     // Reorder filter memory layout if necessary.
     if (filter_format != conv_primitive->GetFilterMemoryFormat()) {
-      auto pd = mkldnn::memory::primitive_desc(mkldnn::memory::desc(filter_dims_mkl,
-                                                                    MklDnnType<T>(),
-                                                                    filter_format),
-                                               cpu_engine);
-      mkldnn::memory src = mkldnn::memory(pd, (void*)filter_data);
-      // allocate the size queried from memory primitive desc. it may not match tensor logical size due to
-      // mkldnn using padding to allow use of blocked format.
-      filter_reorder_buffer = IAllocator::MakeUniquePtr<void>(alloc, conv_primitive->GetFilterSize());
-      mkldnn::memory dst = mkldnn::memory(conv_fwd_pd->weights_primitive_desc(), filter_reorder_buffer.get());
-      MemoryReorderParams params(src, dst);
-      DoReorder<T>(params);
-      filter_data = static_cast<T*>(dst.get_data_handle());
+      const int preferred_format = static_cast<int>(conv_primitive->GetFilterMemoryFormat());
+      bool have_cached_filter = false;
+      if (filter_is_constant_) {
+        std::lock_guard<std::mutex> lock(reordered_filters_mutex_);
+        auto iter = reordered_filters_.find(preferred_format);
+        if (iter != reordered_filters_.end()) {
+          filter_data = static_cast<T*>(iter->second.get());
+          have_cached_filter = true;
+        }
+      }
+
+      if (!have_cached_filter) {
+        auto pd = mkldnn::memory::primitive_desc(mkldnn::memory::desc(filter_dims_mkl,
+                                                                      MklDnnType<T>(),
+                                                                      filter_format),
+                                                 cpu_engine);
+        mkldnn::memory src = mkldnn::memory(pd, (void*)filter_data);
+        // allocate the size queried from memory primitive desc. it may not match tensor logical size due to
+        // mkldnn using padding to allow use of blocked format.
+        IAllocatorUniquePtr<void> buffer = IAllocator::MakeUniquePtr<void>(alloc, conv_primitive->GetFilterSize());
+        mkldnn::memory dst = mkldnn::memory(conv_fwd_pd->weights_primitive_desc(), buffer.get());
+        MemoryReorderParams params(src, dst);
+        DoReorder<T>(params);
+
+        if (filter_is_constant_) {
+          // the filter is a constant initializer, so keep the reordered copy
+          // for the lifetime of the kernel and skip the reorder on later Runs.
+          // emplace keeps the existing entry if another thread won the race.
+          std::lock_guard<std::mutex> lock(reordered_filters_mutex_);
+          auto result = reordered_filters_.emplace(preferred_format, std::move(buffer));
+          filter_data = static_cast<T*>(result.first->second.get());
+        } else {
+          filter_reorder_buffer = std::move(buffer);
+          filter_data = static_cast<T*>(filter_reorder_buffer.get());
+        }
+      }
     }
 
     // Allocate dst buffer if reorder is necessary
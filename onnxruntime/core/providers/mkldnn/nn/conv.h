@@ -2,6 +2,8 @@
 // Licensed under the MIT License.
 
 #pragma once
+#include <map>
+#include <mutex>
 #include "core/framework/op_kernel.h"
 #include "core/providers/cpu/nn/conv.h"
 
@@ -11,11 +13,23 @@ template <typename T>
 class Conv final : public onnxruntime::Conv<T> {
  public:
   Conv(const OpKernelInfo& info) : onnxruntime::Conv<T>(info) {
+    // when the filter is a constant initializer, its reorder into the
+    // primitive's preferred format can be done once and cached for the
+    // session lifetime instead of on every Run.
+    const Tensor* W;
+    filter_is_constant_ = info.TryGetConstantInput(1, &W);
   }
 
   Status Compute(OpKernelContext* context) const override;
 
  private:
+  bool filter_is_constant_;
+
+  // Reordered copies of a constant filter, keyed by the mkldnn memory format
+  // the convolution primitive prefers (different input shapes may select
+  // different formats). Filled on first use, reused by every later Run.
+  mutable std::mutex reordered_filters_mutex_;
+  mutable std::map<int, IAllocatorUniquePtr<void>> reordered_filters_;
 };
 }  // namespace mkl_dnn
 }  // namespace onnxruntime
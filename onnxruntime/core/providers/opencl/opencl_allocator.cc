@@ -0,0 +1,53 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "opencl_allocator.h"
+
+#include <cstdlib>
+#include <new>
+
+#include "core/framework/allocatormgr.h"
+
+namespace onnxruntime {
+
+namespace {
+// zero-copy adoption via CL_MEM_USE_HOST_PTR wants page aligned buffers whose
+// size is a multiple of a cache line; anything else makes the runtime fall
+// back to a shadow copy.
+constexpr size_t kOpenCLHostAlignment = 4096;
+constexpr size_t kOpenCLSizeGranularity = 64;
+}  // namespace
+
+void* OpenCLAllocator::Alloc(size_t size) {
+  if (size == 0) return nullptr;
+
+  size = (size + kOpenCLSizeGranularity - 1) & ~(kOpenCLSizeGranularity - 1);
+
+  void* p = nullptr;
+#ifdef _WIN32
+  p = _aligned_malloc(size, kOpenCLHostAlignment);
+  if (p == nullptr) throw std::bad_alloc();
+#else
+  if (posix_memalign(&p, kOpenCLHostAlignment, size) != 0) throw std::bad_alloc();
+#endif
+  return p;
+}
+
+void OpenCLAllocator::Free(void* p) {
+#ifdef _WIN32
+  _aligned_free(p);
+#else
+  free(p);
+#endif
+}
+
+const ONNXRuntimeAllocatorInfo& OpenCLAllocator::Info() const {
+  static constexpr ONNXRuntimeAllocatorInfo opencl_allocator_info(OPENCL, ONNXRuntimeAllocatorType::ONNXRuntimeDeviceAllocator, 0, ONNXRuntimeMemTypeDefault);
+  return opencl_allocator_info;
+}
+
+const ONNXRuntimeAllocatorInfo& OpenCLCPUAllocator::Info() const {
+  static constexpr ONNXRuntimeAllocatorInfo opencl_cpu_allocator_info(OPENCL_CPU, ONNXRuntimeAllocatorType::ONNXRuntimeDeviceAllocator, 0, ONNXRuntimeMemTypeCPUOutput);
+  return opencl_cpu_allocator_info;
+}
+}  // namespace onnxruntime
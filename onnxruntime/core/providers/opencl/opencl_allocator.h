@@ -0,0 +1,26 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include "core/framework/allocator.h"
+
+namespace onnxruntime {
+constexpr const char* OPENCL = "OpenCL";
+constexpr const char* OPENCL_CPU = "OpenCLCpu";
+
+// Host allocator whose buffers the OpenCL runtime can adopt via
+// CL_MEM_USE_HOST_PTR without a shadow copy: on integrated GPUs sharing
+// physical memory with the CPU, 4096 byte alignment and a 64 byte size
+// granularity are what the runtimes require for true zero-copy access.
+class OpenCLAllocator : public CPUAllocator {
+ public:
+  void* Alloc(size_t size) override;
+  void Free(void* p) override;
+  const ONNXRuntimeAllocatorInfo& Info() const override;
+};
+
+class OpenCLCPUAllocator : public CPUAllocator {
+ public:
+  const ONNXRuntimeAllocatorInfo& Info() const override;
+};
+}  // namespace onnxruntime
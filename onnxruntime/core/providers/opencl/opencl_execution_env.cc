@@ -0,0 +1,151 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "opencl_execution_env.h"
+
+#include <string>
+#include <vector>
+
+namespace onnxruntime {
+namespace opencl {
+
+namespace {
+// Preprocessing kernels. Both work on flat float buffers; the host side
+// passes the NCHW geometry as scalar arguments.
+const char* kProgramSource = R"CLC(
+__kernel void image_scaler(__global const float* input,
+                           __global float* output,
+                           __global const float* bias,
+                           const float scale,
+                           const int channels,
+                           const int hw) {
+  const size_t i = get_global_id(0);
+  output[i] = input[i] * scale + bias[(i / hw) % channels];
+}
+
+__kernel void upsample_nearest_4d(__global const float* input,
+                                  __global float* output,
+                                  const float scale_n, const float scale_c,
+                                  const float scale_h, const float scale_w,
+                                  const int in_n, const int in_c,
+                                  const int in_h, const int in_w,
+                                  const int out_c, const int out_h,
+                                  const int out_w) {
+  size_t id = get_global_id(0);
+  const int x = id % out_w;
+  id /= out_w;
+  const int y = id % out_h;
+  id /= out_h;
+  const int c = id % out_c;
+  const int n = id / out_c;
+  const int in_x = min((int)(x / scale_w), in_w - 1);
+  const int in_y = min((int)(y / scale_h), in_h - 1);
+  const int in_ch = min((int)(c / scale_c), in_c - 1);
+  const int in_b = min((int)(n / scale_n), in_n - 1);
+  output[get_global_id(0)] =
+      input[((in_b * in_c + in_ch) * in_h + in_y) * in_w + in_x];
+}
+)CLC";
+}  // namespace
+
+common::Status OpenCLError(cl_int error, const char* what) {
+  return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, "OpenCL error ", error, " in ", what);
+}
+
+OpenCLExecutionEnv& OpenCLExecutionEnv::Instance() {
+  static OpenCLExecutionEnv instance;
+  return instance;
+}
+
+OpenCLExecutionEnv::~OpenCLExecutionEnv() {
+  if (image_scaler_kernel_) clReleaseKernel(image_scaler_kernel_);
+  if (upsample_nearest_kernel_) clReleaseKernel(upsample_nearest_kernel_);
+  if (program_) clReleaseProgram(program_);
+  if (queue_) clReleaseCommandQueue(queue_);
+  if (context_) clReleaseContext(context_);
+}
+
+common::Status OpenCLExecutionEnv::EnsureInitialized() {
+  std::lock_guard<std::mutex> lock(init_mutex_);
+  if (!initialized_) {
+    init_status_ = Initialize();
+    initialized_ = true;
+  }
+  return init_status_;
+}
+
+common::Status OpenCLExecutionEnv::Initialize() {
+  cl_uint num_platforms = 0;
+  OPENCL_RETURN_IF_ERROR(clGetPlatformIDs(0, nullptr, &num_platforms), "clGetPlatformIDs");
+  if (num_platforms == 0)
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, "No OpenCL platform available");
+
+  std::vector<cl_platform_id> platforms(num_platforms);
+  OPENCL_RETURN_IF_ERROR(clGetPlatformIDs(num_platforms, platforms.data(), nullptr), "clGetPlatformIDs");
+
+  // Prefer a GPU sharing physical memory with the host (integrated graphics);
+  // fall back to any GPU, then to any device so the provider still functions,
+  // just without the zero-copy benefit.
+  cl_device_id fallback_device = nullptr;
+  for (cl_platform_id platform : platforms) {
+    cl_uint num_devices = 0;
+    if (clGetDeviceIDs(platform, CL_DEVICE_TYPE_GPU, 0, nullptr, &num_devices) != CL_SUCCESS ||
+        num_devices == 0)
+      continue;
+    std::vector<cl_device_id> devices(num_devices);
+    if (clGetDeviceIDs(platform, CL_DEVICE_TYPE_GPU, num_devices, devices.data(), nullptr) != CL_SUCCESS)
+      continue;
+    for (cl_device_id device : devices) {
+      cl_bool unified = CL_FALSE;
+      if (clGetDeviceInfo(device, CL_DEVICE_HOST_UNIFIED_MEMORY, sizeof(unified), &unified, nullptr) == CL_SUCCESS &&
+          unified == CL_TRUE) {
+        device_ = device;
+        has_unified_memory_ = true;
+        break;
+      }
+      if (fallback_device == nullptr) fallback_device = device;
+    }
+    if (device_) break;
+  }
+  if (device_ == nullptr) device_ = fallback_device;
+  if (device_ == nullptr) {
+    for (cl_platform_id platform : platforms) {
+      cl_uint num_devices = 0;
+      if (clGetDeviceIDs(platform, CL_DEVICE_TYPE_ALL, 1, &device_, &num_devices) == CL_SUCCESS &&
+          num_devices > 0)
+        break;
+      device_ = nullptr;
+    }
+  }
+  if (device_ == nullptr)
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, "No OpenCL device available");
+
+  cl_int err = CL_SUCCESS;
+  context_ = clCreateContext(nullptr, 1, &device_, nullptr, nullptr, &err);
+  OPENCL_RETURN_IF_ERROR(err, "clCreateContext");
+
+  queue_ = clCreateCommandQueue(context_, device_, 0, &err);
+  OPENCL_RETURN_IF_ERROR(err, "clCreateCommandQueue");
+
+  program_ = clCreateProgramWithSource(context_, 1, &kProgramSource, nullptr, &err);
+  OPENCL_RETURN_IF_ERROR(err, "clCreateProgramWithSource");
+
+  err = clBuildProgram(program_, 1, &device_, nullptr, nullptr, nullptr);
+  if (err != CL_SUCCESS) {
+    size_t log_size = 0;
+    clGetProgramBuildInfo(program_, device_, CL_PROGRAM_BUILD_LOG, 0, nullptr, &log_size);
+    std::string log(log_size, '\0');
+    clGetProgramBuildInfo(program_, device_, CL_PROGRAM_BUILD_LOG, log_size, &log[0], nullptr);
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, "OpenCL program build failed: ", log);
+  }
+
+  image_scaler_kernel_ = clCreateKernel(program_, "image_scaler", &err);
+  OPENCL_RETURN_IF_ERROR(err, "clCreateKernel(image_scaler)");
+  upsample_nearest_kernel_ = clCreateKernel(program_, "upsample_nearest_4d", &err);
+  OPENCL_RETURN_IF_ERROR(err, "clCreateKernel(upsample_nearest_4d)");
+
+  return common::Status::OK();
+}
+
+}  // namespace opencl
+}  // namespace onnxruntime
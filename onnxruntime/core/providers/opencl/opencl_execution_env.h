@@ -0,0 +1,74 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <mutex>
+
+#ifdef __APPLE__
+#include <OpenCL/cl.h>
+#else
+#include <CL/cl.h>
+#endif
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+namespace opencl {
+
+// Build a Status from a failed OpenCL call.
+common::Status OpenCLError(cl_int error, const char* what);
+
+#define OPENCL_RETURN_IF_ERROR(error, what)                               \
+  do {                                                                    \
+    cl_int _status = (error);                                             \
+    if (_status != CL_SUCCESS) return ::onnxruntime::opencl::OpenCLError(_status, (what)); \
+  } while (0)
+
+// Process-wide OpenCL state shared by the provider's kernels: the selected
+// device (a GPU with host-unified memory when one exists, so that
+// CL_MEM_USE_HOST_PTR buffers are true zero-copy), its context and in-order
+// queue, and the prebuilt program holding the preprocessing kernels.
+class OpenCLExecutionEnv {
+ public:
+  static OpenCLExecutionEnv& Instance();
+
+  // Idempotent; the first call selects the device and builds the program,
+  // later calls return the cached status.
+  common::Status EnsureInitialized();
+
+  cl_context Context() const { return context_; }
+  cl_command_queue Queue() const { return queue_; }
+  cl_kernel ImageScalerKernel() const { return image_scaler_kernel_; }
+  cl_kernel UpsampleNearest4DKernel() const { return upsample_nearest_kernel_; }
+
+  // true when the device reads host memory directly, making the
+  // CL_MEM_USE_HOST_PTR wrapping below copy-free.
+  bool HasUnifiedMemory() const { return has_unified_memory_; }
+
+  // clSetKernelArg mutates the kernel object, so each enqueue of a shared
+  // kernel happens under this lock.
+  std::mutex& DispatchMutex() { return dispatch_mutex_; }
+
+ private:
+  OpenCLExecutionEnv() = default;
+  ~OpenCLExecutionEnv();
+
+  common::Status Initialize();
+
+  std::mutex init_mutex_;
+  std::mutex dispatch_mutex_;
+  bool initialized_{false};
+  common::Status init_status_;
+
+  cl_device_id device_{nullptr};
+  cl_context context_{nullptr};
+  cl_command_queue queue_{nullptr};
+  cl_program program_{nullptr};
+  cl_kernel image_scaler_kernel_{nullptr};
+  cl_kernel upsample_nearest_kernel_{nullptr};
+  bool has_unified_memory_{false};
+};
+
+}  // namespace opencl
+}  // namespace onnxruntime
@@ -0,0 +1,80 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "opencl_allocator.h"
+#include "opencl_execution_provider.h"
+#include "core/framework/allocator.h"
+#include "core/framework/memcpy.h"
+#include "core/framework/kernel_registry.h"
+
+namespace onnxruntime {
+namespace opencl {
+
+ONNX_OPERATOR_KERNEL_EX(
+    MemcpyFromHost,
+    kOnnxDomain,
+    1,
+    kOpenCLExecutionProvider,
+    KernelDefBuilder().InputMemoryType<ONNXRuntimeMemTypeCPUInput>(0).TypeConstraint("T", DataTypeImpl::AllTensorTypes()),
+    Memcpy);
+
+ONNX_OPERATOR_KERNEL_EX(
+    MemcpyToHost,
+    kOnnxDomain,
+    1,
+    kOpenCLExecutionProvider,
+    KernelDefBuilder().OutputMemoryType<ONNXRuntimeMemTypeCPUOutput>(0).TypeConstraint("T", DataTypeImpl::AllTensorTypes()),
+    Memcpy);
+
+}  // namespace opencl
+
+OpenCLExecutionProvider::OpenCLExecutionProvider(const OpenCLExecutionProviderInfo& /*info*/) {
+  DeviceAllocatorRegistrationInfo default_allocator_info({ONNXRuntimeMemTypeDefault,
+                                                          [](int) { return std::make_unique<OpenCLAllocator>(); }, std::numeric_limits<size_t>::max()});
+  InsertAllocator(CreateAllocator(default_allocator_info));
+
+  DeviceAllocatorRegistrationInfo cpu_allocator_info({ONNXRuntimeMemTypeCPUOutput,
+                                                      [](int) { return std::make_unique<OpenCLCPUAllocator>(); }, std::numeric_limits<size_t>::max()});
+  InsertAllocator(CreateAllocator(cpu_allocator_info));
+}
+
+OpenCLExecutionProvider::~OpenCLExecutionProvider() {
+}
+
+Status OpenCLExecutionProvider::CopyTensor(const Tensor& src, Tensor& dst) const {
+  // Support CPU <-> OpenCL for now
+  if (!(strcmp(src.Location().name, OPENCL) == 0 && strcmp(dst.Location().name, CPU) == 0) &&
+      !(strcmp(src.Location().name, CPU) == 0 && strcmp(dst.Location().name, OPENCL) == 0) &&
+      !(strcmp(src.Location().name, OPENCL) == 0 && strcmp(dst.Location().name, OPENCL_CPU) == 0)) {
+    ONNXRUNTIME_NOT_IMPLEMENTED(src.Location().name, " copy to ", dst.Location().name, " is not implemented");
+  }
+
+  // Both sides are host memory (the device adopts it in place), so a plain
+  // copy is all that is needed.
+  size_t bytes = src.DataType()->Size() * src.Shape().Size();
+  const void* src_data = src.DataRaw();
+  void* dst_data = dst.MutableDataRaw();
+  memcpy(dst_data, src_data, bytes);
+
+  return Status::OK();
+}
+
+namespace opencl {
+class ONNX_OPERATOR_KERNEL_CLASS_NAME(kOpenCLExecutionProvider, kOnnxDomain, 1, MemcpyFromHost);
+class ONNX_OPERATOR_KERNEL_CLASS_NAME(kOpenCLExecutionProvider, kOnnxDomain, 1, MemcpyToHost);
+class ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kOpenCLExecutionProvider, kOnnxDomain, 1, float, ImageScaler);
+class ONNX_OPERATOR_VERSIONED_TYPED_KERNEL_CLASS_NAME(kOpenCLExecutionProvider, kOnnxDomain, 7, 9, float, Upsample);
+
+void RegisterOpenCLKernels(std::function<void(KernelCreateInfo&&)> fn) {
+  fn(BuildKernel<ONNX_OPERATOR_KERNEL_CLASS_NAME(kOpenCLExecutionProvider, kOnnxDomain, 1, MemcpyFromHost)>());
+  fn(BuildKernel<ONNX_OPERATOR_KERNEL_CLASS_NAME(kOpenCLExecutionProvider, kOnnxDomain, 1, MemcpyToHost)>());
+  fn(BuildKernel<ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kOpenCLExecutionProvider, kOnnxDomain, 1, float, ImageScaler)>());
+  fn(BuildKernel<ONNX_OPERATOR_VERSIONED_TYPED_KERNEL_CLASS_NAME(kOpenCLExecutionProvider, kOnnxDomain, 7, 9, float, Upsample)>());
+}
+}  // namespace opencl
+
+std::shared_ptr<KernelRegistry> OpenCLExecutionProvider::GetKernelRegistry() const {
+  static std::shared_ptr<KernelRegistry> kernel_registry = std::make_shared<KernelRegistry>(onnxruntime::opencl::RegisterOpenCLKernels);
+  return kernel_registry;
+}
+}  // namespace onnxruntime
@@ -0,0 +1,44 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+
+#include "core/framework/allocatormgr.h"
+#include "core/framework/execution_provider.h"
+#include "core/graph/graph_transformer.h"
+
+namespace onnxruntime {
+
+// Information needed to construct OpenCL execution providers.
+struct OpenCLExecutionProviderInfo {
+  bool create_arena{true};
+
+  explicit OpenCLExecutionProviderInfo(bool use_arena)
+      : create_arena(use_arena) {}
+  OpenCLExecutionProviderInfo() = default;
+};
+
+// Logical device representation. Scoped to data-parallel preprocessing ops
+// (ImageScaler, Upsample); tensors live in host memory that the device adopts
+// without a copy, so integrated GPUs run these ops with no transfer cost.
+class OpenCLExecutionProvider : public IExecutionProvider {
+ public:
+  explicit OpenCLExecutionProvider(const OpenCLExecutionProviderInfo& info);
+  virtual ~OpenCLExecutionProvider();
+
+  std::string Type() const override {
+    return onnxruntime::kOpenCLExecutionProvider;
+  }
+
+  Status CopyTensor(const Tensor& src, Tensor& dst) const override;
+
+  const void* GetExecutionHandle() const noexcept override {
+    return nullptr;
+  }
+
+  virtual std::shared_ptr<KernelRegistry> GetKernelRegistry() const override;
+};
+
+}  // namespace onnxruntime
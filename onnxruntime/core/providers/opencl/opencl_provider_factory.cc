@@ -0,0 +1,54 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/opencl/opencl_provider_factory.h"
+#include <atomic>
+#include "opencl_execution_provider.h"
+
+using namespace onnxruntime;
+
+namespace {
+struct OpenCLProviderFactory {
+  const ONNXRuntimeProviderFactoryInterface* const cls;
+  std::atomic_int ref_count;
+  bool create_arena;
+  OpenCLProviderFactory();
+};
+
+ONNXStatus* ONNXRUNTIME_API_CALL CreateOpenCL(void* this_, ONNXRuntimeProvider** out) {
+  OpenCLExecutionProviderInfo info;
+  OpenCLProviderFactory* this_ptr = (OpenCLProviderFactory*)this_;
+  info.create_arena = this_ptr->create_arena;
+  OpenCLExecutionProvider* ret = new OpenCLExecutionProvider(info);
+  *out = (ONNXRuntimeProvider*)ret;
+  return nullptr;
+}
+
+uint32_t ONNXRUNTIME_API_CALL ReleaseOpenCL(void* this_) {
+  OpenCLProviderFactory* this_ptr = (OpenCLProviderFactory*)this_;
+  if (--this_ptr->ref_count == 0)
+    delete this_ptr;
+  return 0;
+}
+
+uint32_t ONNXRUNTIME_API_CALL AddRefOpenCL(void* this_) {
+  OpenCLProviderFactory* this_ptr = (OpenCLProviderFactory*)this_;
+  ++this_ptr->ref_count;
+  return 0;
+}
+
+constexpr ONNXRuntimeProviderFactoryInterface opencl_cls = {
+    {AddRefOpenCL,
+     ReleaseOpenCL},
+    CreateOpenCL,
+};
+
+OpenCLProviderFactory::OpenCLProviderFactory() : cls(&opencl_cls), ref_count(1), create_arena(true) {}
+}  // namespace
+
+ONNXRUNTIME_API_STATUS_IMPL(ONNXRuntimeCreateOpenCLExecutionProviderFactory, int use_arena, _Out_ ONNXRuntimeProviderFactoryInterface*** out) {
+  OpenCLProviderFactory* ret = new OpenCLProviderFactory();
+  ret->create_arena = (use_arena != 0);
+  *out = (ONNXRuntimeProviderFactoryInterface**)ret;
+  return nullptr;
+}
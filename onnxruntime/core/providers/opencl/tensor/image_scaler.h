@@ -0,0 +1,28 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+#include "core/providers/opencl/opencl_execution_env.h"
+
+namespace onnxruntime {
+namespace opencl {
+
+template <typename T>
+class ImageScaler final : public OpKernel {
+ public:
+  ImageScaler(const OpKernelInfo& info);
+  ~ImageScaler();
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  float scale_;
+  std::vector<float> bias_;
+  cl_mem bias_buffer_{nullptr};
+};
+
+}  // namespace opencl
+}  // namespace onnxruntime
@@ -0,0 +1,112 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "upsample.h"
+
+namespace onnxruntime {
+namespace opencl {
+
+ONNX_OPERATOR_VERSIONED_TYPED_KERNEL_EX(
+    Upsample,
+    kOnnxDomain,
+    7,
+    9,
+    float,
+    kOpenCLExecutionProvider,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    Upsample<float>);
+
+template <typename T>
+Status Upsample<T>::Compute(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(0);
+  if (X == nullptr) return Status(common::ONNXRUNTIME, common::FAIL, "input count mismatch");
+
+  std::vector<float> scales(scales_);
+  if (scales.empty()) {
+    const Tensor* scale = context->Input<Tensor>(1);
+    if (scale == nullptr)
+      return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Upsample: no scales attribute and no scales input");
+    scales.resize(scale->Shape().Size());
+    memcpy(scales.data(), scale->Data<float>(), scales.size() * sizeof(float));
+    ScalesValidation(scales, mode_);
+  }
+
+  const auto& input_dims = X->Shape().GetDims();
+  if (input_dims.size() != 4 || scales.size() != 4) {
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                                   "The OpenCL Upsample kernel only supports 4D [N,C,H,W] inputs, got rank ", input_dims.size());
+  }
+
+  std::vector<int64_t> output_dims(4);
+  for (size_t i = 0; i < 4; ++i) {
+    output_dims[i] = static_cast<int64_t>(input_dims[i] * scales[i]);
+  }
+  Tensor* Y = context->Output(0, TensorShape(output_dims));
+
+  const size_t count = Y->Shape().Size();
+  if (count == 0) return Status::OK();
+
+  auto& env = OpenCLExecutionEnv::Instance();
+
+  cl_int err = CL_SUCCESS;
+  cl_mem input_buffer = clCreateBuffer(env.Context(), CL_MEM_READ_ONLY | CL_MEM_USE_HOST_PTR,
+                                       X->Shape().Size() * sizeof(float),
+                                       const_cast<float*>(X->Data<float>()), &err);
+  OPENCL_RETURN_IF_ERROR(err, "clCreateBuffer(input)");
+  const size_t output_bytes = count * sizeof(float);
+  cl_mem output_buffer = clCreateBuffer(env.Context(), CL_MEM_WRITE_ONLY | CL_MEM_USE_HOST_PTR,
+                                        output_bytes, Y->MutableData<float>(), &err);
+  if (err != CL_SUCCESS) {
+    clReleaseMemObject(input_buffer);
+    return OpenCLError(err, "clCreateBuffer(output)");
+  }
+
+  const cl_int in_n = static_cast<cl_int>(input_dims[0]);
+  const cl_int in_c = static_cast<cl_int>(input_dims[1]);
+  const cl_int in_h = static_cast<cl_int>(input_dims[2]);
+  const cl_int in_w = static_cast<cl_int>(input_dims[3]);
+  const cl_int out_c = static_cast<cl_int>(output_dims[1]);
+  const cl_int out_h = static_cast<cl_int>(output_dims[2]);
+  const cl_int out_w = static_cast<cl_int>(output_dims[3]);
+
+  Status status = Status::OK();
+  {
+    std::lock_guard<std::mutex> lock(env.DispatchMutex());
+    cl_kernel kernel = env.UpsampleNearest4DKernel();
+    err = clSetKernelArg(kernel, 0, sizeof(cl_mem), &input_buffer);
+    if (err == CL_SUCCESS) err = clSetKernelArg(kernel, 1, sizeof(cl_mem), &output_buffer);
+    for (cl_uint i = 0; err == CL_SUCCESS && i < 4; ++i) {
+      err = clSetKernelArg(kernel, 2 + i, sizeof(cl_float), &scales[i]);
+    }
+    if (err == CL_SUCCESS) err = clSetKernelArg(kernel, 6, sizeof(cl_int), &in_n);
+    if (err == CL_SUCCESS) err = clSetKernelArg(kernel, 7, sizeof(cl_int), &in_c);
+    if (err == CL_SUCCESS) err = clSetKernelArg(kernel, 8, sizeof(cl_int), &in_h);
+    if (err == CL_SUCCESS) err = clSetKernelArg(kernel, 9, sizeof(cl_int), &in_w);
+    if (err == CL_SUCCESS) err = clSetKernelArg(kernel, 10, sizeof(cl_int), &out_c);
+    if (err == CL_SUCCESS) err = clSetKernelArg(kernel, 11, sizeof(cl_int), &out_h);
+    if (err == CL_SUCCESS) err = clSetKernelArg(kernel, 12, sizeof(cl_int), &out_w);
+    if (err != CL_SUCCESS) {
+      status = OpenCLError(err, "clSetKernelArg(upsample_nearest_4d)");
+    } else {
+      const size_t global_size = count;
+      err = clEnqueueNDRangeKernel(env.Queue(), kernel, 1, nullptr, &global_size, nullptr, 0, nullptr, nullptr);
+      if (err != CL_SUCCESS) status = OpenCLError(err, "clEnqueueNDRangeKernel(upsample_nearest_4d)");
+    }
+    if (status.IsOK()) {
+      void* mapped = clEnqueueMapBuffer(env.Queue(), output_buffer, CL_TRUE, CL_MAP_READ, 0, output_bytes, 0, nullptr, nullptr, &err);
+      if (err != CL_SUCCESS) {
+        status = OpenCLError(err, "clEnqueueMapBuffer(output)");
+      } else {
+        clEnqueueUnmapMemObject(env.Queue(), output_buffer, mapped, 0, nullptr, nullptr);
+        clFinish(env.Queue());
+      }
+    }
+  }
+
+  clReleaseMemObject(input_buffer);
+  clReleaseMemObject(output_buffer);
+  return status;
+}
+
+}  // namespace opencl
+}  // namespace onnxruntime
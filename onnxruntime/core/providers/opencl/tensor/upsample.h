@@ -0,0 +1,37 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+#include "core/providers/cpu/tensor/upsample.h"
+#include "core/providers/opencl/opencl_execution_env.h"
+
+namespace onnxruntime {
+namespace opencl {
+
+// Nearest-neighbour 4D upsampling on the OpenCL device; the linear mode and
+// other ranks stay on the CPU kernel.
+template <typename T>
+class Upsample final : public UpsampleBase, public OpKernel {
+ public:
+  Upsample(OpKernelInfo info) : UpsampleBase(info), OpKernel(info) {
+    ONNXRUNTIME_ENFORCE(mode_ == UpsampleMode::NN, "The OpenCL Upsample kernel only supports the nearest mode");
+    ONNXRUNTIME_ENFORCE(OpenCLExecutionEnv::Instance().EnsureInitialized().IsOK());
+
+    if (info.GetInputCount() > 1) {
+      const Tensor* scale;
+      if (info.TryGetConstantInput(1, &scale)) {
+        scales_.resize(scale->Shape().Size());
+        memcpy(scales_.data(), scale->Data<float>(), scales_.size() * sizeof(float));
+        ScalesValidation(scales_, mode_);
+      }
+    }
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+};
+
+}  // namespace opencl
+}  // namespace onnxruntime
@@ -7,6 +7,13 @@
 #include "core/framework/op_kernel.h"
 
 namespace onnxruntime {
+namespace {
+// Exec queue prefetched uploads are scheduled on. Matches the dedicated
+// copy-in stream convention of async providers (CUDA's kCudaStreamCopyIn);
+// a provider without per-queue copies just runs the copy synchronously.
+constexpr int kCopyInQueueId = 1;
+}  // namespace
+
 IOBinding::IOBinding(const SessionState& session_state) : session_state_(session_state) {
 }
 
@@ -22,6 +29,39 @@ common::Status IOBinding::BindInput(const std::string& name, const MLValue& ml_v
   return Status::OK();
 }
 
+static void WrapExternalBuffer(MLDataType element_type, const TensorShape& shape, void* data,
+                               const ONNXRuntimeAllocatorInfo& location, MLValue& ml_value) {
+  // The tensor is created without a deleter, so the buffer stays owned by the
+  // caller and is never freed by the runtime.
+  std::unique_ptr<Tensor> p_tensor = std::make_unique<Tensor>(element_type, shape, data, location);
+  ml_value.Init(p_tensor.release(),
+                DataTypeImpl::GetType<Tensor>(),
+                DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+}
+
+common::Status IOBinding::BindExternalInput(const std::string& name, MLDataType element_type,
+                                            const TensorShape& shape, void* data,
+                                            const ONNXRuntimeAllocatorInfo& location, size_t* index) {
+  ONNXRUNTIME_RETURN_IF_NOT(data != nullptr || shape.Size() == 0, "data must not be null.");
+  ONNXRUNTIME_RETURN_IF_NOT(index != nullptr, "index must not be null.");
+
+  MLValue ml_value;
+  WrapExternalBuffer(element_type, shape, data, location, ml_value);
+  MLValue& feed = feeds_[name] = ml_value;
+
+  external_inputs_.push_back({&feed, element_type, shape, location});
+  *index = external_inputs_.size() - 1;
+  return Status::OK();
+}
+
+common::Status IOBinding::RebindInput(size_t index, void* data) {
+  ONNXRUNTIME_RETURN_IF_NOT(index < external_inputs_.size(), "Invalid external input index: ", index);
+
+  ExternalInputBinding& binding = external_inputs_[index];
+  WrapExternalBuffer(binding.element_type, binding.shape, data, binding.location, *binding.feed);
+  return Status::OK();
+}
+
 static common::Status AllocateHelper(const SessionState& session_state,
                                      int id, onnxruntime::ProviderType provider_type,
                                      const MLValue& fetched_mlvalue,
@@ -101,6 +141,21 @@ common::Status IOBinding::CopyOneInputAcrossDevices(const SessionState& session_
 
     // our CPU exec provider doesn't support copy from GPU->CPU
     if (required_provider_type != onnxruntime::kCpuExecutionProvider) {
+      if (prefetch_inputs_) {
+        // Queue the upload on the provider's copy-in queue and fence the
+        // value: the first consuming node waits on the copy event from its
+        // own queue, so the host returns from BindInput while the transfer
+        // overlaps compute still draining on the device.
+        FencePtr fence = node_exec_provider->GetAllocator(target_device_id, ONNXRuntimeMemTypeDefault)
+                             ->CreateFence(&session_state);
+        if (fence) {
+          new_mlvalue.SetFence(fence);
+          fence->BeforeUsingAsOutput(required_provider_type, kCopyInQueueId);
+          ONNXRUNTIME_RETURN_IF_ERROR(node_exec_provider->CopyTensor(input_tensor, *new_tensor, kCopyInQueueId));
+          fence->AfterUsedAsOutput(kCopyInQueueId);
+          continue;
+        }
+      }
       ONNXRUNTIME_RETURN_IF_ERROR(node_exec_provider->CopyTensor(input_tensor, *new_tensor));
     } else {
       ONNXRUNTIME_RETURN_IF_ERROR(p_input_provider->CopyTensor(input_tensor, *new_tensor));
@@ -150,6 +205,9 @@ static std::pair<bool, size_t> Contains(const std::vector<std::string>& output_n
 }
 
 common::Status IOBinding::BindOutput(const std::string& name, const MLValue& ml_value) {
+  // a concrete value supersedes any earlier donation for this name.
+  donated_output_allocators_.erase(name);
+
   auto rc = Contains(output_names_, name);
   if (rc.first) {
     outputs_[rc.second] = ml_value;
@@ -161,6 +219,26 @@ common::Status IOBinding::BindOutput(const std::string& name, const MLValue& ml_
   return Status::OK();
 }
 
+common::Status IOBinding::BindOutput(const std::string& name, AllocatorPtr allocator) {
+  if (allocator == nullptr) {
+    return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                                   "Cannot donate a null allocator for output: ", name);
+  }
+
+  // register the name with an empty value; the frame fills it in from the
+  // donated allocator when the producing node runs.
+  auto rc = Contains(output_names_, name);
+  if (rc.first) {
+    outputs_[rc.second] = MLValue();
+  } else {
+    output_names_.push_back(name);
+    outputs_.push_back(MLValue());
+  }
+
+  donated_output_allocators_[name] = allocator;
+  return Status::OK();
+}
+
 const std::vector<std::string>& IOBinding::GetOutputNames() const {
   return output_names_;
 }
@@ -48,6 +48,41 @@ class IOBinding {
     */
   common::Status BindInput(const std::string& name, const MLValue& ml_value);
 
+  /**
+    * When enabled, BindInput schedules any cross-device copy on the target
+    * provider's dedicated copy-in queue and attaches a fence to the bound
+    * value instead of blocking until the upload completes. The first node
+    * consuming the input waits on the copy event from its own queue, so the
+    * upload of the next request's inputs overlaps whatever the device is
+    * still computing. Bind source buffers obtained from GetCPUAllocator
+    * (pinned memory on GPU providers) to keep the copy truly asynchronous.
+    * Providers whose allocators do not create fences (e.g. CPU) fall back to
+    * the plain synchronous copy, so enabling this is always safe.
+    */
+  void EnableInputPrefetch(bool enable) {
+    prefetch_inputs_ = enable;
+  }
+
+  /**
+    * Bind an input directly to caller-owned memory. The buffer is wrapped as
+    * a Tensor with a no-op deleter: no copy is made and no ownership is
+    * taken, so the caller guarantees the buffer stays alive and unchanged
+    * until the last Run() that uses the binding has completed. Unlike
+    * BindInput no cross-device copy is performed; the memory must already be
+    * at the location described by @param location (use GetCPUAllocator to
+    * obtain the location for host memory).
+    * On success @param index receives a handle for RebindInput.
+    */
+  common::Status BindExternalInput(const std::string& name, MLDataType element_type, const TensorShape& shape,
+                                   void* data, const ONNXRuntimeAllocatorInfo& location, size_t* index);
+
+  /**
+    * Replace the buffer of a binding created by BindExternalInput with
+    * another buffer of the same shape and type. This is a pointer swap with
+    * no name lookup or copy, so it is cheap enough to call per frame.
+    */
+  common::Status RebindInput(size_t index, void* data);
+
   /**
     * If the BindInput calls are async this function acts as a barrier to ensure all inputs are fully copied
     * before you call the Run() method. There is no point calling Run() if you're inputs are not ready at the 
@@ -62,6 +97,17 @@ class IOBinding {
     */
   common::Status BindOutput(const std::string& name, const MLValue& ml_value);
 
+  /**
+    * Donate the output's memory instead of binding a pre-allocated value: the
+    * session constructs the fetched value directly in @param allocator when
+    * the producing node allocates its output, so handing the fetch to another
+    * consumer on the same device (e.g. the next session in a chain bound over
+    * that allocator) is zero-copy. The allocator must target the device the
+    * output is planned on; Run() fails otherwise. Binding a value for the
+    * same name afterwards cancels the donation.
+    */
+  common::Status BindOutput(const std::string& name, AllocatorPtr allocator);
+
   /**
     * This simply collects the outputs obtained after calling Run() inside the @param outputs.
     */
@@ -80,16 +126,31 @@ class IOBinding {
  private:
   friend InferenceSession;
 
+  // Bookkeeping for an input bound over caller-owned memory. The feed pointer
+  // references the slot in feeds_, which is stable across rehashing, so a
+  // rebind never goes back through the name map.
+  struct ExternalInputBinding {
+    MLValue* feed;
+    MLDataType element_type;
+    TensorShape shape;
+    ONNXRuntimeAllocatorInfo location;
+  };
+
   IOBinding(const SessionState& session_state);
   const SessionState& session_state_;
   std::unordered_map<std::string, MLValue> feeds_;
+  std::vector<ExternalInputBinding> external_inputs_;
   std::vector<std::string> output_names_;
   std::vector<MLValue> outputs_;
+  // outputs whose memory the caller donates: Run() allocates these fetches
+  // from the bound allocator instead of the planned one.
+  std::unordered_map<std::string, AllocatorPtr> donated_output_allocators_;
+  bool prefetch_inputs_ = false;
 
-  static common::Status CopyOneInputAcrossDevices(const SessionState& session_state,
-                                                  const std::string& input_name,
-                                                  const MLValue& orig_mlvalue,
-                                                  MLValue& new_mlvalue);
+  common::Status CopyOneInputAcrossDevices(const SessionState& session_state,
+                                           const std::string& input_name,
+                                           const MLValue& orig_mlvalue,
+                                           MLValue& new_mlvalue);
 
   ONNXRUNTIME_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(IOBinding);
 };
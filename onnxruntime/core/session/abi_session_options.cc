@@ -97,6 +97,32 @@ ONNXRUNTIME_API(int, ONNXRuntimeSetSessionThreadPoolSize, _In_ ONNXRuntimeSessio
   return 0;
 }
 
+///Pin the session's worker threads to logical processors.
+ONNXRUNTIME_API(int, ONNXRuntimeSetSessionThreadAffinityMasks, _In_ ONNXRuntimeSessionOptions* options, _In_reads_(num_masks) const uint64_t* affinity_masks, size_t num_masks) {
+  if (affinity_masks == nullptr && num_masks != 0) return -1;
+  for (size_t i = 0; i != num_masks; ++i) {
+    if (affinity_masks[i] == 0) return -1;
+  }
+  options->value.thread_pool_affinity_masks.assign(affinity_masks, affinity_masks + num_masks);
+  return 0;
+}
+
+///Confine the session's worker threads to one NUMA node.
+ONNXRUNTIME_API(int, ONNXRuntimeSetSessionNumaNode, _In_ ONNXRuntimeSessionOptions* options, int numa_node) {
+  if (numa_node < -1) return -1;
+  options->value.thread_pool_numa_node = numa_node;
+  return 0;
+}
+
+///Replicate large CPU weights onto every NUMA node.
+ONNXRUNTIME_API(void, ONNXRuntimeEnableNumaWeightReplication, _In_ ONNXRuntimeSessionOptions* options) {
+  options->value.enable_numa_weight_replication = true;
+}
+
+ONNXRUNTIME_API(void, ONNXRuntimeDisableNumaWeightReplication, _In_ ONNXRuntimeSessionOptions* options) {
+  options->value.enable_numa_weight_replication = false;
+}
+
 ONNXRUNTIME_API(void, ONNXRuntimeAddCustomOp, _In_ ONNXRuntimeSessionOptions* options, const char* custom_op_path) {
   options->custom_op_paths.emplace_back(custom_op_path);
 }
@@ -0,0 +1,188 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/constant_folding.h"
+
+#include <unordered_set>
+
+#include "core/framework/execution_providers.h"
+#include "core/framework/insert_cast_transformer.h"
+#include "core/framework/kernel_registry_manager.h"
+#include "core/framework/sequential_executor.h"
+#include "core/framework/session_state.h"
+#include "core/framework/session_state_initializer.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_transformer_mgr.h"
+#include "core/graph/graph_viewer.h"
+#include "core/graph/model.h"
+#include "core/providers/cpu/cpu_execution_provider.h"
+
+using namespace onnx;
+using namespace ::onnxruntime::common;
+
+namespace onnxruntime {
+
+// Ops whose output is not a pure function of their inputs, so replacing them
+// with one recorded output value would change the model.
+static const std::unordered_set<std::string> non_deterministic_ops = {
+    "RandomNormal", "RandomNormalLike", "RandomUniform", "RandomUniformLike", "Multinomial"};
+
+Status ConstantFolding::Apply(onnxruntime::Graph& graph, bool& modified) const {
+  // initializers that appear in the graph inputs can be overridden by a feed
+  // at Run time, so nodes consuming them are not really constant.
+  std::unordered_set<std::string> overridable_initializers;
+  for (const auto* input_def : graph.GetInputs()) {
+    overridable_initializers.insert(input_def->Name());
+  }
+
+  std::vector<onnxruntime::NodeIndex> removed_nodes;
+
+  // walk in topological order so outputs folded earlier in the pass make
+  // their downstream consumers foldable in the same pass.
+  GraphViewer graph_viewer(graph);
+  for (onnxruntime::NodeIndex index : graph_viewer.GetNodesInTopologicalOrder()) {
+    auto* node = graph.GetNode(index);
+    if (node == nullptr) {
+      continue;
+    }
+
+    if (non_deterministic_ops.count(node->OpType()) > 0 ||
+        !node->ImplicitInputDefs().empty() ||
+        graph.IsNodeOutputsInGraphOutputs(*node)) {
+      continue;
+    }
+
+    bool all_inputs_constant = !node->InputDefs().empty();
+    for (const auto* input_def : node->InputDefs()) {
+      if (!input_def->Exists()) {
+        continue;  // missing optional input
+      }
+      const ONNX_NAMESPACE::TensorProto* tensor_proto = nullptr;
+      if (!graph.GetInitializedTensor(input_def->Name(), tensor_proto) ||
+          overridable_initializers.count(input_def->Name()) > 0) {
+        all_inputs_constant = false;
+        break;
+      }
+    }
+
+    if (!all_inputs_constant) {
+      continue;
+    }
+
+    // evaluation can legitimately fail, e.g. for ops with no CPU kernel or
+    // with non-tensor outputs; leave such nodes in place.
+    std::vector<ONNX_NAMESPACE::TensorProto> folded_outputs;
+    if (!EvaluateNode(graph, *node, folded_outputs).IsOK()) {
+      continue;
+    }
+
+    // the node's output defs keep their names, so downstream consumers now
+    // resolve them against the new initializers without any rewiring.
+    for (auto& folded_output : folded_outputs) {
+      graph.AddInitializedTensor(folded_output);
+    }
+
+    removed_nodes.push_back(node->Index());
+  }
+
+  for (auto i : removed_nodes) {
+    graph.RemoveNode(i);
+  }
+
+  if (!removed_nodes.empty()) {
+    modified = true;
+    ONNXRUNTIME_RETURN_IF_ERROR(graph.Resolve());
+  }
+  return Status::OK();
+}
+
+Status ConstantFolding::EvaluateNode(const onnxruntime::Graph& graph, const onnxruntime::Node& node,
+                                     std::vector<ONNX_NAMESPACE::TensorProto>& folded_outputs) const {
+  // Build a model holding only the node and its initializer inputs, so the
+  // regular session initialization machinery can plan and run it.
+  Model model{"ConstantFoldingEvaluation", false, ModelMetaData(), IOnnxRuntimeOpSchemaRegistryList(),
+              graph.DomainToVersionMap()};
+  onnxruntime::Graph& eval_graph = model.MainGraph();
+  // initializers copied below may reference externally stored payloads, which
+  // resolve relative to the source model's directory.
+  eval_graph.SetModelFileDirectory(graph.ModelFileDirectory());
+
+  std::vector<NodeArg*> input_args;
+  for (const auto* input_def : node.InputDefs()) {
+    if (!input_def->Exists()) {
+      input_args.push_back(&eval_graph.GetOrCreateNodeArg("", nullptr));
+      continue;
+    }
+    const ONNX_NAMESPACE::TensorProto* tensor_proto = nullptr;
+    ONNXRUNTIME_ENFORCE(graph.GetInitializedTensor(input_def->Name(), tensor_proto));
+    eval_graph.AddInitializedTensor(*tensor_proto);
+    input_args.push_back(&eval_graph.GetOrCreateNodeArg(input_def->Name(), input_def->TypeAsProto()));
+  }
+
+  std::vector<NodeArg*> output_args;
+  std::vector<std::string> output_names;
+  for (const auto* output_def : node.OutputDefs()) {
+    output_args.push_back(&eval_graph.GetOrCreateNodeArg(output_def->Name(), output_def->TypeAsProto()));
+    output_names.push_back(output_def->Name());
+  }
+
+  eval_graph.AddNode(node.Name(), node.OpType(), node.Description(), input_args, output_args,
+                     &node.GetAttributes(), node.Domain());
+  ONNXRUNTIME_RETURN_IF_ERROR(eval_graph.Resolve());
+
+  ExecutionProviders execution_providers;
+  ONNXRUNTIME_RETURN_IF_ERROR(execution_providers.Add(
+      kCpuExecutionProvider, std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo())));
+
+  KernelRegistryManager kernel_registry_manager;
+  kernel_registry_manager.RegisterKernels(execution_providers);
+
+  SessionState session_state{execution_providers};
+  SessionStateInitializer initializer{eval_graph, session_state, execution_providers,
+                                      kernel_registry_manager, session_state.Logger()};
+
+  GraphTransformerManager empty_transformer_manager{1};
+  InsertCastTransformer cast_transformer{"CastFloat16Transformer"};
+  cast_transformer.AddKernelRegistries(kernel_registry_manager.GetAllKernelRegistries());
+  ONNXRUNTIME_RETURN_IF_ERROR(initializer.CreatePlan(empty_transformer_manager, cast_transformer, {},
+                                                     true /*enable_sequential_execution*/,
+                                                     true /*skip_graph_transformations*/));
+
+  std::map<ONNXRuntimeAllocatorInfo, BufferUniquePtr> weights_buffers;
+  ONNXRUNTIME_RETURN_IF_ERROR(initializer.InitializeAndSave(false /*enable_memory_pattern*/,
+                                                            false /*enable_zero_copy_weights*/,
+                                                            std::string(),
+                                                            false /*enable_numa_weight_replication*/,
+                                                            weights_buffers));
+
+  NameMLValMap feeds;
+  std::vector<MLValue> fetches;
+  SequentialExecutor executor;
+  ONNXRUNTIME_RETURN_IF_ERROR(executor.Execute(session_state, feeds, output_names, fetches,
+                                               session_state.Logger()));
+
+  for (size_t i = 0; i < fetches.size(); ++i) {
+    if (!fetches[i].IsTensor()) {
+      return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, "Can only fold nodes with tensor outputs.");
+    }
+    const Tensor& tensor = fetches[i].Get<Tensor>();
+    if (tensor.DataType() == DataTypeImpl::GetType<std::string>()) {
+      // string tensors cannot be stored as raw data in a TensorProto
+      return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, "Cannot fold nodes with string tensor outputs.");
+    }
+
+    ONNX_NAMESPACE::TensorProto folded_output;
+    folded_output.set_name(output_names[i]);
+    folded_output.set_data_type(utils::GetTensorProtoType(tensor));
+    for (auto dim : tensor.Shape().GetDims()) {
+      folded_output.add_dims(dim);
+    }
+    folded_output.set_raw_data(tensor.DataRaw(), tensor.Size());
+
+    folded_outputs.push_back(std::move(folded_output));
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
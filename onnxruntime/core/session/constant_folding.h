@@ -0,0 +1,41 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/graph/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@class ConstantFolding
+
+Transformer that evaluates nodes whose inputs are all initializers using the
+CPU execution provider's kernels and replaces them with the computed
+initializers, so constant subgraphs such as Shape->Gather->Unsqueeze->Concat
+chains over static shapes run once at session initialization instead of on
+every Run.
+
+Nodes are skipped when their outputs are graph outputs, when they consume an
+initializer that can be overridden by a graph input, when the op is
+non-deterministic, or when no CPU kernel can evaluate them.
+
+The transformer lives in core/session rather than core/graph because
+evaluating a node requires the CPU execution provider and the kernel
+execution machinery, which the graph library cannot depend on.
+*/
+class ConstantFolding : public onnxruntime::GraphTransformer {
+ public:
+  ConstantFolding() noexcept : onnxruntime::GraphTransformer("ConstantFolding", "Fold constant subgraphs into initializers") {}
+  Status Apply(onnxruntime::Graph& graph, bool& modified) const override;
+
+ private:
+  // Evaluates a single node whose inputs are all initializers with the CPU
+  // execution provider and appends its output tensors to folded_outputs.
+  // A failure status means the node cannot be folded, not that the graph is
+  // broken; the caller simply leaves such nodes in place.
+  Status EvaluateNode(const onnxruntime::Graph& graph, const onnxruntime::Node& node,
+                      std::vector<ONNX_NAMESPACE::TensorProto>& folded_outputs) const;
+};
+
+}  // namespace onnxruntime
@@ -3,6 +3,12 @@
 
 #include "core/session/inference_session.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
 #include <memory>
 #include <mutex>
 #include <sstream>
@@ -11,14 +17,19 @@
 
 #include "core/common/logging/logging.h"
 #include "core/common/task_thread_pool.h"
+#include "core/common/work_stealing_thread_pool.h"
+#include "core/graph/graph_cleanup.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/graph_transformer.h"
 #include "core/graph/graph_transformer_mgr.h"
+#include "core/graph/zipmap_elision.h"
 #include "core/graph/model.h"
 #include "core/framework/allocatormgr.h"
+#include "core/framework/bfc_arena.h"
 #include "core/framework/customregistry.h"
 #include "core/framework/environment.h"
 #include "core/framework/execution_frame.h"
+#include "core/framework/float16_conversion_transformer.h"
 #include "core/framework/graph_partitioner.h"
 #include "core/framework/insert_cast_transformer.h"
 #include "core/framework/kernel_def_builder.h"
@@ -26,23 +37,37 @@
 #include "core/framework/ml_value_patterns_planner.h"
 #include "core/framework/mldata_type_utils.h"
 #include "core/framework/mlvalue_name_idx_map.h"
+#include "core/framework/run_cancellation.h"
 #include "core/framework/sequential_executor.h"
 #include "core/framework/parallel_executor.h"
+#include "core/framework/hybrid_executor.h"
+#include "core/framework/pipeline_executor.h"
 #include "core/framework/session_state.h"
 #include "core/framework/session_state_initializer.h"
+#include "core/framework/weights_cache.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/tensorutils.h"
 #include "core/framework/transformer_memcpy.h"
 #include "core/framework/utils.h"
+#include "core/platform/denormal.h"
 #include "core/platform/notification.h"
+#include "core/platform/thread_affinity.h"
 #include "core/providers/cpu/cpu_execution_provider.h"
 #include "core/session/CustomOpsLoader.h"
 #include "core/session/IOBinding.h"
+#include "core/session/run_context.h"
 
 using namespace ONNX_NAMESPACE;
 
 namespace onnxruntime {
 
+// microseconds elapsed since start; used for the telemetry phase timers.
+static int64_t ElapsedMicroseconds(const std::chrono::steady_clock::time_point& start) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
 class InferenceSession::Impl {
  public:
   Impl(const SessionOptions& session_options, logging::LoggingManager* logging_manager)
@@ -56,24 +81,88 @@ class InferenceSession::Impl {
 
     InitLogger(logging_manager);
 
-    // currently the threadpool is used by the parallel executor only and hence
-    // there is no point creating it when only sequential execution is enabled.
-    if (!session_options.enable_sequential_execution) {
-      int pool_size = session_options_.session_thread_pool_size == 0
-                          ? std::thread::hardware_concurrency() / 2
-                          : session_options_.session_thread_pool_size;
-      thread_pool_ = std::make_unique<TaskThreadPool>(pool_size);
+    // effective executor choice starts at the configured flags; auto-tuning
+    // overwrites it once a calibration decision is made.
+    run_sequential_execution_ = session_options_.enable_sequential_execution;
+    run_hybrid_execution_ = session_options_.enable_hybrid_execution;
+
+    if (session_options.enable_denormal_as_zero) {
+      // flip the process-wide flag before any pool spins up so the workers
+      // flush denormals from their first task; this thread builds the
+      // kernels and may run the sequential executor, so set it here too.
+      DenormalFlushForPoolThreads().store(true, std::memory_order_relaxed);
+      if (!SetDenormalAsZero(true)) {
+        LOGS(*session_logger_, WARNING) << "Denormal flushing requested but not supported on this architecture.";
+      }
+    }
+
+    int pool_size = session_options_.session_thread_pool_size == 0
+                        ? std::thread::hardware_concurrency() / 2
+                        : session_options_.session_thread_pool_size;
+    if (!session_options_.session_group.empty()) {
+      // sessions in a group share the Environment-owned pool regardless of
+      // execution mode: RunAsync requests and initializer deserialization run
+      // there too, scheduled under the group's priority classes.
+      group_thread_pool_ = &Environment::GetSessionGroupThreadPool(session_options_.session_group,
+                                                                   pool_size,
+                                                                   ResolveThreadAffinityMasks());
+    } else if (!session_options.enable_sequential_execution || session_options.enable_hybrid_execution ||
+               session_options.enable_auto_tuning) {
+      // outside a group the threadpool is used by the parallel and hybrid
+      // executors only and hence there is no point creating it when only
+      // sequential execution is enabled. auto-tuning tries those executors
+      // during calibration, so it needs the pool regardless of the flags.
+      thread_pool_ = std::make_unique<WorkStealingThreadPool>(pool_size, ResolveThreadAffinityMasks());
     }
 
-    session_state_.SetThreadPool(thread_pool_.get());
+    session_state_.SetThreadPool(group_thread_pool_ != nullptr ? group_thread_pool_ : thread_pool_.get());
+    session_state_.SetThreadPoolTaskPriority(SessionTaskPriority());
     session_state_.SetEnableMemoryPattern(session_options.enable_mem_pattern);
+    session_state_.SetMemoryPatternShapeBucketSize(session_options.memory_pattern_bucket_size);
+    session_state_.SetEnableSubgraphMemoization(session_options.enable_subgraph_memoization);
     session_profiler_.Initialize(session_logger_);
     session_state_.SetProfiler(session_profiler_);
+    if (session_options.enable_hardware_counter_profiling) {
+      session_profiler_.EnableHardwareCounters();
+    }
     if (session_options.enable_profiling) {
       StartProfiling(session_options.profile_file_prefix);
     }
   }
 
+  ~Impl() {
+    if (owns_shared_weights_ref_) {
+      WeightsCache::Instance().ReleaseSession(session_options_.shared_weights_key);
+    }
+  }
+
+  // Priority class of this session's tasks on a shared group pool. Any
+  // positive session_priority maps to the high class.
+  TaskPriority SessionTaskPriority() const {
+    return session_options_.session_priority > 0 ? TaskPriority::kHigh : TaskPriority::kNormal;
+  }
+
+  // Worker affinity masks for the session's thread pools. Explicit masks win;
+  // otherwise a NUMA node binding is translated into one mask covering the
+  // node's logical processors so every worker stays on that node.
+  std::vector<uint64_t> ResolveThreadAffinityMasks() const {
+    if (!session_options_.thread_pool_affinity_masks.empty()) {
+      return session_options_.thread_pool_affinity_masks;
+    }
+
+    if (session_options_.thread_pool_numa_node >= 0) {
+      uint64_t node_mask = GetNumaNodeAffinityMask(session_options_.thread_pool_numa_node);
+      if (node_mask != 0) {
+        return std::vector<uint64_t>{node_mask};
+      }
+      LOGS(*session_logger_, WARNING) << "Could not resolve the processors of NUMA node "
+                                      << session_options_.thread_pool_numa_node
+                                      << "; session worker threads will run unpinned.";
+    }
+
+    return std::vector<uint64_t>{};
+  }
+
   common::Status RegisterExecutionProvider(std::unique_ptr<IExecutionProvider> p_exec_provider) {
     if (p_exec_provider == nullptr) {
       return Status(common::ONNXRUNTIME, common::FAIL, "Received nullptr for exec provider");
@@ -272,6 +361,9 @@ class InferenceSession::Impl {
           // create SessionState for executing subgraph
           subgraph_info.session_state = std::make_unique<SessionState>(execution_providers_);
           subgraph_info.session_state->SetProfiler(session_profiler_);
+          // the kernels owning a subgraph only see the subgraph's SessionState,
+          // so the memoization switch has to travel with it.
+          subgraph_info.session_state->SetEnableSubgraphMemoization(session_options_.enable_subgraph_memoization);
 
           // setup everything required to execute the subgraph and save it in subgraph_session_state
           SessionStateInitializer initializer{*subgraph, *subgraph_info.session_state,
@@ -280,9 +372,15 @@ class InferenceSession::Impl {
           ONNXRUNTIME_RETURN_IF_ERROR(
               initializer.CreatePlan(graph_transformation_mgr_, insert_cast_transformer_,
                                      node.ImplicitInputDefs(),
-                                     session_options_.enable_sequential_execution));
+                                     session_options_.enable_sequential_execution,
+                                     session_options_.skip_graph_transformations));
 
+          // subgraph initializer names are only unique within their graph, so
+          // subgraphs do not participate in cross-session weight sharing.
           ONNXRUNTIME_RETURN_IF_ERROR(initializer.InitializeAndSave(session_state_.GetEnableMemoryPattern(),
+                                                                    session_options_.enable_zero_copy_weights,
+                                                                    std::string(),
+                                                                    session_options_.enable_numa_weight_replication,
                                                                     subgraph_info.weights_buffers));
 
           // add the subgraph SessionState instance to the parent graph SessionState so it can be retrieved
@@ -344,18 +442,115 @@ class InferenceSession::Impl {
 
       insert_cast_transformer_.AddKernelRegistries(kernel_registry_manager_.GetAllKernelRegistries());
 
+      // drop unreachable compute and duplicate weight payloads before the
+      // other transformers see the graph, so fusions and the allocation plan
+      // only deal with what actually runs.
+      ONNXRUNTIME_RETURN_IF_ERROR(
+          graph_transformation_mgr_.Register(std::make_unique<GraphCleanup>()));
+
+      // Convert the graph to float16 with the other transformers, before
+      // partitioning, so the providers negotiate kernels for the final types.
+      // Any float16 node that ends up without a kernel is moved back to
+      // float32 on CPU by insert_cast_transformer_.
+      if (session_options_.enable_float16_execution &&
+          execution_providers_.Get(onnxruntime::kCudaExecutionProvider) != nullptr) {
+        ONNXRUNTIME_RETURN_IF_ERROR(
+            graph_transformation_mgr_.Register(std::make_unique<Float16ConversionTransformer>()));
+      }
+
+      // replace graph output ZipMap nodes with label/score tensor pairs when
+      // the caller opted out of the dictionary outputs.
+      if (session_options_.elide_zipmap_outputs) {
+        ONNXRUNTIME_RETURN_IF_ERROR(
+            graph_transformation_mgr_.Register(std::make_unique<ZipMapElision>()));
+      }
+
+      // pipeline execution and micro batching reshape the Run pattern the
+      // auto-tuning calibration would measure, so tuning stands down for them.
+      const bool auto_tuning_applies = session_options_.enable_auto_tuning &&
+                                       !session_options_.enable_pipeline_execution &&
+                                       !session_options_.enable_micro_batching;
+      bool auto_tuning_pending = false;
+      if (auto_tuning_applies) {
+        if (LoadAutoTuningDecision()) {
+          LOGS(*session_logger_, INFO) << "Auto-tuning: applied cached executor choice '"
+                                       << AutoTuningModeName(auto_tuning_choice_) << "' from "
+                                       << session_options_.auto_tuning_cache_filepath;
+        } else {
+          auto_tuning_pending = true;
+        }
+      }
+
+      // the parallel executor needs the allocation plan without buffer reuse,
+      // so plan for it whenever it is the chosen executor or still a
+      // calibration candidate; the other executors run that plan safely.
+      bool plan_for_parallel = !session_options_.enable_sequential_execution;
+      if (auto_tuning_pending) {
+        plan_for_parallel = true;
+      } else if (auto_tuning_applies) {
+        plan_for_parallel = auto_tuning_choice_ == kAutoTuneParallel;
+      }
+
       SessionStateInitializer session_initializer{graph, session_state_, execution_providers_,
                                                   kernel_registry_manager_, *session_logger_};
 
+      // the recompute schedule is only honored by the sequential executor, so
+      // the activation memory budget stands down whenever another executor
+      // may run the plan.
+      int64_t activation_memory_budget = session_options_.activation_memory_budget;
+      if (activation_memory_budget > 0 &&
+          (plan_for_parallel || auto_tuning_applies ||
+           session_options_.enable_hybrid_execution ||
+           session_options_.enable_pipeline_execution ||
+           session_options_.enable_micro_batching)) {
+        LOGS(*session_logger_, WARNING) << "activation_memory_budget ignored: it requires the sequential executor.";
+        activation_memory_budget = 0;
+      }
+
       ONNXRUNTIME_RETURN_IF_ERROR(session_initializer.CreatePlan(graph_transformation_mgr_, insert_cast_transformer_,
-                                                                 {}, session_options_.enable_sequential_execution));
+                                                                 {}, !plan_for_parallel,
+                                                                 session_options_.skip_graph_transformations,
+                                                                 session_options_.partition_cache_filepath,
+                                                                 activation_memory_budget,
+                                                                 session_options_.enable_memory_aware_scheduling));
+
+      // save the transformed model so future sessions can load it with
+      // skip_graph_transformations and avoid re-running the transformers.
+      if (!session_options_.optimized_model_filepath.empty()) {
+        ONNXRUNTIME_RETURN_IF_ERROR(onnxruntime::Model::Save(*model_, session_options_.optimized_model_filepath));
+      }
+
+      if (!session_options_.shared_weights_key.empty()) {
+        WeightsCache::Instance().AddSessionRef(session_options_.shared_weights_key);
+        owns_shared_weights_ref_ = true;
+      }
 
       ONNXRUNTIME_RETURN_IF_ERROR(session_initializer.InitializeAndSave(session_state_.GetEnableMemoryPattern(),
+                                                                        session_options_.enable_zero_copy_weights,
+                                                                        session_options_.shared_weights_key,
+                                                                        session_options_.enable_numa_weight_replication,
                                                                         weights_buffers_));
 
       // handle any subgraphs
       ONNXRUNTIME_RETURN_IF_ERROR(InitializeSubgraphSessions(graph, session_state_));
 
+      // split the finalized plan into cost-balanced pipeline stages so
+      // concurrent Run calls can stream through them. main graph only:
+      // subgraphs run nested inside a stage.
+      if (session_options_.enable_pipeline_execution) {
+        session_state_.BuildPipelineStages(session_options_.pipeline_stage_count);
+      }
+
+      // resolve the per-feed and per-fetch copy plans so the per-Run copy
+      // decisions stop re-deriving node and provider metadata.
+      ONNXRUNTIME_RETURN_IF_ERROR(BuildFeedFetchCopyPlans());
+
+      ONNXRUNTIME_RETURN_IF_ERROR(ValidateRetainedStatePairs());
+
+      if (auto_tuning_pending) {
+        auto_tuning_active_.store(true, std::memory_order_release);
+      }
+
       is_inited_ = true;
 
       LOGS(*session_logger_, INFO) << "Session successfully initialized.";
@@ -466,10 +661,50 @@ class InferenceSession::Impl {
     return Status::OK();
   }
 
+  // A compact signature of a feed set: the feed names paired with the value
+  // types (element type for tensors), sorted by name so that the iteration
+  // order of the unordered feed map does not matter.
+  using FeedSignature = std::vector<std::pair<std::string, MLDataType>>;
+
+  static FeedSignature MakeFeedSignature(const NameMLValMap& feeds) {
+    FeedSignature signature;
+    signature.reserve(feeds.size());
+    for (const auto& pair : feeds) {
+      auto& input_ml_value = pair.second;
+      MLDataType type = input_ml_value.IsTensor()
+                            ? input_ml_value.Get<Tensor>().DataType()
+                            : input_ml_value.Type();
+      signature.emplace_back(pair.first, type);
+    }
+    std::sort(signature.begin(), signature.end());
+    return signature;
+  }
+
   common::Status ValidateInputs(const NameMLValMap& feeds) {
+    // A feed set whose signature matched an earlier Run has already passed
+    // the name and type walks, so repeat Runs with the same inputs collapse
+    // to building the signature and one vector comparison.
+    FeedSignature signature = MakeFeedSignature(feeds);
+    {
+      std::lock_guard<std::mutex> l(validated_feed_signatures_mutex_);
+      for (const auto& cached : validated_feed_signatures_) {
+        if (cached == signature) {
+          return Status::OK();
+        }
+      }
+    }
+
     ONNXRUNTIME_RETURN_IF_ERROR(ValidateInputNames(feeds));
     //TODO: It should also validate the input shapes?
     ONNXRUNTIME_RETURN_IF_ERROR(ValidateInputTypes(feeds));
+
+    // Bound the cache so a caller cycling through many distinct feed sets
+    // cannot grow it without limit; entries past the cap just re-validate.
+    constexpr size_t kMaxCachedFeedSignatures = 16;
+    std::lock_guard<std::mutex> l(validated_feed_signatures_mutex_);
+    if (validated_feed_signatures_.size() < kMaxCachedFeedSignatures) {
+      validated_feed_signatures_.push_back(std::move(signature));
+    }
     return Status::OK();
   }
 
@@ -519,24 +754,177 @@ class InferenceSession::Impl {
     return common::Status::OK();
   }
 
+  // Where a feed has to land for one of its consuming nodes, resolved once
+  // at initialization: which provider the node wants the input on, whether
+  // the kernel pins it to CPU, and the allocator a copy would go through.
+  struct FeedCopyTarget {
+    bool input_on_cpu;
+    ProviderType required_provider_type;
+    const IExecutionProvider* provider;
+    AllocatorPtr allocator;
+  };
+
+  // Which node (or folded weight) produces a fetchable output, resolved once
+  // at initialization so MatchOutputsWithProviders does not rescan the graph
+  // per Run.
+  struct FetchSourceInfo {
+    ProviderType node_provider_type;
+    bool is_weight = false;
+    MLValue weight;
+  };
+
+  // Resolves the per-feed and per-fetch copy plans. The node and provider
+  // metadata behind the cross-device copy decisions is immutable once the
+  // session is initialized, so the per-Run path only has to inspect the
+  // runtime tensor locations against these records.
+  common::Status BuildFeedFetchCopyPlans() {
+    const int target_device_id = 0;  // TODO: make it configurable
+
+    for (const auto& pair : session_state_.GetInputNodeInfoMap()) {
+      std::vector<FeedCopyTarget> targets;
+      for (const auto& node_info : pair.second) {
+        const auto& node = *node_info.p_node;
+        const KernelCreateInfo* kci = node_info.kci;
+        const auto* node_input_mem_types = (kci != nullptr) ? &kci->kernel_def->InputMemoryType() : nullptr;
+
+        FeedCopyTarget target;
+        target.input_on_cpu = node_input_mem_types && MemTypeOnCpuExplicitly(*node_input_mem_types, node_info.index);
+        target.required_provider_type = target.input_on_cpu ? onnxruntime::kCpuExecutionProvider
+                                                            : node.GetExecutionProviderType();
+        target.provider = execution_providers_.Get(target.required_provider_type);
+        ONNXRUNTIME_RETURN_IF_NOT(target.provider != nullptr,
+                                  "Missing execution provider for input ", pair.first, ": ",
+                                  target.required_provider_type);
+        target.allocator = target.provider->GetAllocator(target_device_id, ONNXRuntimeMemTypeDefault);
+        ONNXRUNTIME_RETURN_IF_NOT(target.allocator != nullptr,
+                                  "Missing default allocator for provider ", target.required_provider_type);
+        targets.push_back(std::move(target));
+      }
+      feed_copy_plan_.emplace(pair.first, std::move(targets));
+    }
+
+    auto p_graph = session_state_.GetGraphViewer();
+    ONNXRUNTIME_ENFORCE(p_graph);
+    for (auto& node : p_graph->Nodes()) {
+      for (auto* arg : node.OutputDefs()) {
+        if (!arg->Exists() || arg->Name().empty()) {
+          continue;
+        }
+        FetchSourceInfo info;
+        info.node_provider_type = node.GetExecutionProviderType();
+        fetch_source_plan_.emplace(arg->Name(), std::move(info));
+      }
+    }
+
+    // a constant output folded into a weight never shows up in an OutputDef;
+    // the weight has already been placed on the appropriate device.
+    auto& mlvalue_name_idx_map = session_state_.GetMLValueNameIdxMap();
+    auto& weights = session_state_.GetInitializedTensors();
+    for (auto& one_def : p_graph->GetOutputs()) {
+      if (!one_def->Exists() || one_def->Name().empty() || fetch_source_plan_.count(one_def->Name())) {
+        continue;
+      }
+      int mlvalue_idx;
+      if (!mlvalue_name_idx_map.GetIdx(one_def->Name(), mlvalue_idx).IsOK()) {
+        continue;
+      }
+      auto weight_it = weights.find(mlvalue_idx);
+      if (weight_it == weights.end()) {
+        continue;
+      }
+      FetchSourceInfo info;
+      info.is_weight = true;
+      info.weight = weight_it->second;
+      fetch_source_plan_.emplace(one_def->Name(), std::move(info));
+    }
+
+    return Status::OK();
+  }
+
+  // Moves one feed to where its consumers want it, driven by the targets
+  // resolved at initialization. Mirrors IOBinding::CopyOneInputAcrossDevices
+  // minus the node and provider metadata lookups.
+  common::Status CopyOneInputWithPlan(const std::vector<FeedCopyTarget>& targets,
+                                      const MLValue& orig_mlvalue,
+                                      MLValue& new_mlvalue) {
+    for (const auto& target : targets) {
+      if (!orig_mlvalue.IsTensor()) {
+        // copying not supported for non-tensor types
+        new_mlvalue = orig_mlvalue;
+        return Status::OK();
+      }
+
+      auto& input_tensor = orig_mlvalue.Get<Tensor>();
+      auto& input_tensor_loc = input_tensor.Location();
+      auto* p_input_provider = execution_providers_.Get(input_tensor_loc);
+      if (!p_input_provider) {
+        p_input_provider = execution_providers_.Get(onnxruntime::kCpuExecutionProvider);
+        ONNXRUNTIME_ENFORCE(p_input_provider);
+      }
+
+      if (p_input_provider->Type() == target.required_provider_type &&
+          input_tensor_loc.mem_type == ONNXRuntimeMemTypeDefault) {
+        new_mlvalue = orig_mlvalue;
+        return Status::OK();
+      }
+
+      // if the node requires the input on cpu and it is already in pinned
+      // memory, don't copy
+      if (target.input_on_cpu &&
+          (input_tensor_loc.mem_type == ONNXRuntimeMemTypeCPU ||
+           input_tensor_loc.mem_type == ONNXRuntimeMemTypeCPUOutput)) {
+        new_mlvalue = orig_mlvalue;
+        return Status::OK();
+      }
+
+      void* buffer = nullptr;
+      if (input_tensor.Shape().Size() != 0) {
+        buffer = target.allocator->Alloc(input_tensor.Size());
+        if (!buffer)
+          return Status(common::ONNXRUNTIME, common::FAIL, "invalid buffer");
+      }
+      std::unique_ptr<Tensor> p_tensor = std::make_unique<Tensor>(input_tensor.DataType(),
+                                                                  input_tensor.Shape(),
+                                                                  buffer,
+                                                                  target.allocator->Info(),
+                                                                  target.allocator);
+      new_mlvalue.Init(p_tensor.release(),
+                       DataTypeImpl::GetType<Tensor>(),
+                       DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+      auto* new_tensor = new_mlvalue.GetMutable<Tensor>();
+
+      // our CPU exec provider doesn't support copy from GPU->CPU
+      if (target.required_provider_type != onnxruntime::kCpuExecutionProvider) {
+        ONNXRUNTIME_RETURN_IF_ERROR(target.provider->CopyTensor(input_tensor, *new_tensor));
+      } else {
+        ONNXRUNTIME_RETURN_IF_ERROR(p_input_provider->CopyTensor(input_tensor, *new_tensor));
+      }
+    }
+
+    return Status::OK();
+  }
+
   // copies inputs across devices only if required
-  common::Status CopyInputsAcrossDevices(const SessionState& session_state,
-                                         const NameMLValMap& orig_feeds,
+  common::Status CopyInputsAcrossDevices(const NameMLValMap& orig_feeds,
                                          NameMLValMap& new_feeds) {
     for (auto& pair : orig_feeds) {
       MLValue new_mlvalue;
       auto& input_name = pair.first;
       auto& orig_mlvalue = pair.second;
-      ONNXRUNTIME_RETURN_IF_ERROR(IOBinding::CopyOneInputAcrossDevices(session_state,
-                                                                       input_name,
-                                                                       orig_mlvalue,
-                                                                       new_mlvalue));
+      auto plan_it = feed_copy_plan_.find(input_name);
+      if (plan_it == feed_copy_plan_.end()) {
+        return Status(common::ONNXRUNTIME, common::FAIL,
+                      "Failed to find input name in the mapping: " + input_name);
+      }
+      ONNXRUNTIME_RETURN_IF_ERROR(CopyOneInputWithPlan(plan_it->second, orig_mlvalue, new_mlvalue));
       new_feeds[input_name] = new_mlvalue;
     }
     return Status::OK();
   }
 
-  // ensures pre-allocated outputs match the node providers.
+  // ensures pre-allocated outputs match the node providers, consulting the
+  // per-output source records resolved at initialization instead of
+  // rescanning the graph per Run.
   common::Status MatchOutputsWithProviders(const std::vector<std::string>& output_names,
                                            std::vector<MLValue>& fetches,
                                            std::vector<MLValue>& new_fetches) {
@@ -545,91 +933,40 @@ class InferenceSession::Impl {
     }
     new_fetches.resize(output_names.size());
 
-    std::set<std::string> seen_outputs;
-    auto p_graph = session_state_.GetGraphViewer();
-    ONNXRUNTIME_ENFORCE(p_graph);
-
-    std::pair<bool, size_t> found;
-    for (auto& node : p_graph->Nodes()) {  // TODO optimize this
-      if (seen_outputs.size() == fetches.size()) {
-        break;
+    for (size_t idx = 0, end = output_names.size(); idx < end; ++idx) {
+      auto source_it = fetch_source_plan_.find(output_names[idx]);
+      if (source_it == fetch_source_plan_.end()) {
+        return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, "No node or weight produces output ",
+                                       output_names[idx]);
       }
-      for (auto* arg : node.OutputDefs()) {
-        if (!arg->Exists() ||
-            arg->Name().empty() ||
-            !(found = Contains(output_names, arg->Name())).first) {
-          continue;
-        }
 
-        seen_outputs.insert(arg->Name());
-        size_t idx = found.second;
-        MLValue orig_mlvalue = fetches[idx];
-        if (orig_mlvalue.IsAllocated()) {
-          if (!orig_mlvalue.IsTensor()) {
-            new_fetches[idx] = fetches[idx];
-            continue;
-          }
-
-          auto& node_provider_type = node.GetExecutionProviderType();
-          auto& orig_tensor = orig_mlvalue.Get<Tensor>();
-          auto& orig_tensor_loc = orig_tensor.Location();
-          auto* tensor_provider = execution_providers_.Get(orig_tensor_loc);
-          if (!tensor_provider) {
-            tensor_provider = execution_providers_.Get(onnxruntime::kCpuExecutionProvider);
-          }
-
-          auto tensor_provider_type = tensor_provider->Type();
-          if (node_provider_type == tensor_provider_type) {
-            new_fetches[idx] = fetches[idx];
-            continue;
-          }
-          // leave the new_fetches[idx] as it is since it'll get allocated on the appropriate
-          // provider by the op kernel context when requested.
-          continue;
-
-        } else {
-          new_fetches[idx] = fetches[idx];
-          continue;
-        }
+      const FetchSourceInfo& source = source_it->second;
+      if (source.is_weight) {
+        // a constant output folded into a weight; assume the weight has
+        // already been placed on the appropriate device.
+        new_fetches[idx] = source.weight;
+        continue;
       }
-    }
 
-    // If we've already seen all the outputs requested just return.
-    if (seen_outputs.size() == output_names.size()) {
-      return Status::OK();
-    }
-
-    // Handle the case when a constant is an output but has been folded into a weight
-    // and hence it doesn't show up in any of the OutputDefs before.
-    // assume that the weight has already been placed in the appropriate device before
-    auto& defs = p_graph->GetOutputs();
-    auto& mlvalue_name_idx_map{session_state_.GetMLValueNameIdxMap()};
-    auto& weights = session_state_.GetInitializedTensors();
-
-    for (auto& one_def : defs) {
-      if (!one_def->Exists() ||
-          one_def->Name().empty() ||
-          seen_outputs.count(one_def->Name()) ||
-          !(found = Contains(output_names, one_def->Name())).first) {
+      MLValue orig_mlvalue = fetches[idx];
+      if (!orig_mlvalue.IsAllocated() || !orig_mlvalue.IsTensor()) {
+        new_fetches[idx] = fetches[idx];
         continue;
       }
 
-      auto& def_name = one_def->Name();
-      size_t idx = found.second;
-      int mlvalue_idx;
-      ONNXRUNTIME_RETURN_IF_ERROR(mlvalue_name_idx_map.GetIdx(def_name, mlvalue_idx));
-      if (!weights.count(mlvalue_idx)) {
-        LOGS(*session_logger_, INFO) << "Output with name " << def_name << " is not a weight.";
-        continue;
+      auto& orig_tensor = orig_mlvalue.Get<Tensor>();
+      auto& orig_tensor_loc = orig_tensor.Location();
+      auto* tensor_provider = execution_providers_.Get(orig_tensor_loc);
+      if (!tensor_provider) {
+        tensor_provider = execution_providers_.Get(onnxruntime::kCpuExecutionProvider);
       }
-      seen_outputs.insert(def_name);
-      const auto& weight = weights.at(mlvalue_idx);
-      new_fetches[idx] = weight;
-    }
 
-    if (seen_outputs.size() != output_names.size())  // make sure we've seen all outputs
-      return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, "output size mismatch, expected ", output_names.size(),
-                                     " got ", seen_outputs.size());
+      if (source.node_provider_type == tensor_provider->Type()) {
+        new_fetches[idx] = fetches[idx];
+      }
+      // otherwise leave new_fetches[idx] as it is since it'll get allocated on
+      // the appropriate provider by the op kernel context when requested.
+    }
 
     return Status::OK();
   }
@@ -666,7 +1003,9 @@ class InferenceSession::Impl {
   }
 
   // copies outputs across devices only if required
-  common::Status CopyOutputsAcrossDevices(std::vector<MLValue>& fetches,
+  common::Status CopyOutputsAcrossDevices(const RunOptions& run_options,
+                                          const std::vector<std::string>& output_names,
+                                          std::vector<MLValue>& fetches,
                                           std::vector<MLValue>& user_fetches) {
     for (size_t idx = 0, end = fetches.size(); idx < end; ++idx) {
       auto& fetched_mlvalue = fetches[idx];
@@ -675,6 +1014,17 @@ class InferenceSession::Impl {
         continue;
       }
 
+      // a fetch the caller pinned to the device skips the copy entirely; it
+      // can be brought to the host later through CopyFetchToHost.
+      if (!run_options.fetch_locations.empty() && idx < output_names.size()) {
+        auto location_it = run_options.fetch_locations.find(output_names[idx]);
+        if (location_it != run_options.fetch_locations.end() &&
+            location_it->second == RunOptions::kFetchLocationDevice) {
+          user_fetches[idx] = fetched_mlvalue;
+          continue;
+        }
+      }
+
       auto& fetched_tensor = fetched_mlvalue.Get<Tensor>();
       auto& fetched_tensor_location = fetched_tensor.Location();
       auto* p_fetched_provider = execution_providers_.Get(fetched_tensor_location);
@@ -723,12 +1073,335 @@ class InferenceSession::Impl {
     return Status::OK();
   }
 
+  // brings a fetch returned under kFetchLocationDevice to CPU memory on first
+  // host access; values already in host memory pass through without a copy.
+  common::Status CopyFetchToHost(const MLValue& fetch, MLValue& host_fetch) {
+    if (!fetch.IsTensor()) {
+      host_fetch = fetch;
+      return Status::OK();
+    }
+
+    auto& fetched_tensor = fetch.Get<Tensor>();
+    auto* p_fetched_provider = execution_providers_.Get(fetched_tensor.Location());
+    if (!p_fetched_provider || p_fetched_provider->Type() == onnxruntime::kCpuExecutionProvider ||
+        fetched_tensor.Location().mem_type == ONNXRuntimeMemTypeCPUOutput) {
+      host_fetch = fetch;
+      return Status::OK();
+    }
+
+    MLValue host_mlvalue;
+    ONNXRUNTIME_RETURN_IF_ERROR(AllocateHelper(onnxruntime::kCpuExecutionProvider, 0,
+                                               fetched_tensor, host_mlvalue));
+    Tensor* p_host_tensor = host_mlvalue.GetMutable<Tensor>();
+    ONNXRUNTIME_RETURN_IF_ERROR(p_fetched_provider->CopyTensor(fetched_tensor, *p_host_tensor));
+    host_fetch = host_mlvalue;
+    return Status::OK();
+  }
+
   Status Run(const RunOptions& run_options,
              const NameMLValMap& feeds,
              const std::vector<std::string>& output_names,
              std::vector<MLValue>* p_fetches) {
+    if (!session_options_.retained_state_pairs.empty()) {
+      return RunStateful(run_options, feeds, output_names, p_fetches);
+    }
+
+    if (session_options_.enable_micro_batching) {
+      common::Status status;
+      if (TryRunMicroBatched(run_options, feeds, output_names, p_fetches, status)) {
+        return status;
+      }
+    }
+
+    return RunImpl(run_options, feeds, output_names, p_fetches);
+  }
+
+  // Checks the retained-state declaration against the loaded model: every
+  // pair must name an existing graph output and the graph input it feeds.
+  common::Status ValidateRetainedStatePairs() const {
+    for (const auto& pair : session_options_.retained_state_pairs) {
+      if (model_output_names_.find(pair.first) == model_output_names_.end()) {
+        return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                                       "retained_state_pairs names unknown model output: ", pair.first);
+      }
+      if (model_input_names_.find(pair.second) == model_input_names_.end()) {
+        return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                                       "retained_state_pairs names unknown model input: ", pair.second);
+      }
+    }
+    return common::Status::OK();
+  }
+
+  // Run with the session-retained states injected: states kept from the
+  // previous call feed their paired inputs (unless the caller feeds them
+  // explicitly, which overrides), and the state outputs are fetched
+  // alongside the requested outputs and retained for the next call. The
+  // retained MLValues stay wherever the producing kernels left them, so a
+  // device-resident state never round-trips through the caller.
+  common::Status RunStateful(const RunOptions& run_options,
+                             const NameMLValMap& feeds,
+                             const std::vector<std::string>& output_names,
+                             std::vector<MLValue>* p_fetches) {
+    NameMLValMap stateful_feeds = feeds;
+    {
+      std::lock_guard<std::mutex> lock(retained_states_mutex_);
+      for (const auto& state : retained_states_) {
+        if (stateful_feeds.find(state.first) == stateful_feeds.end()) {
+          stateful_feeds[state.first] = state.second;
+        }
+      }
+    }
+
+    // fetch the state outputs the caller did not ask for, so their updated
+    // values can be captured after the run
+    std::vector<std::string> stateful_output_names = output_names;
+    for (const auto& pair : session_options_.retained_state_pairs) {
+      if (std::find(output_names.begin(), output_names.end(), pair.first) == output_names.end()) {
+        stateful_output_names.push_back(pair.first);
+      }
+    }
+
+    std::vector<MLValue> stateful_fetches = *p_fetches;
+    if (!stateful_fetches.empty()) {
+      stateful_fetches.resize(stateful_output_names.size());
+    }
+
+    ONNXRUNTIME_RETURN_IF_ERROR(RunImpl(run_options, stateful_feeds, stateful_output_names, &stateful_fetches));
+
+    {
+      std::lock_guard<std::mutex> lock(retained_states_mutex_);
+      for (const auto& pair : session_options_.retained_state_pairs) {
+        for (size_t i = 0; i < stateful_output_names.size(); ++i) {
+          if (stateful_output_names[i] == pair.first) {
+            retained_states_[pair.second] = stateful_fetches[i];
+            break;
+          }
+        }
+      }
+    }
+
+    stateful_fetches.resize(output_names.size());
+    *p_fetches = std::move(stateful_fetches);
+    return common::Status::OK();
+  }
+
+  common::Status ResetRetainedStates() {
+    std::lock_guard<std::mutex> lock(retained_states_mutex_);
+    retained_states_.clear();
+    return common::Status::OK();
+  }
+
+  // A recycled bundle of the structures every Run builds before any kernel
+  // executes: the device-copied feeds map, the matched fetches vector and,
+  // under sequential execution, the execution frame itself. Checked out at
+  // the top of RunImpl and returned at the end, so steady-state Runs reuse
+  // the containers' existing capacity instead of constructing them afresh.
+  struct RunScope {
+    NameMLValMap copied_feeds;
+    std::vector<MLValue> fetches;
+    std::unique_ptr<ExecutionFrame> frame;
+    RunScope* next = nullptr;  // freelist link; the node is owned by run_scope_storage_
+  };
+
+  RunScope* AcquireRunScope() {
+    // detach the whole freelist in one exchange rather than popping the head
+    // with a compare-and-swap: no other thread can observe the detached
+    // nodes, which sidesteps the ABA hazard of a Treiber-stack pop.
+    RunScope* head = run_scope_free_list_.exchange(nullptr, std::memory_order_acquire);
+    if (head == nullptr) {
+      auto scope = std::make_unique<RunScope>();
+      RunScope* raw = scope.get();
+      std::lock_guard<std::mutex> lock(run_scope_storage_mutex_);
+      run_scope_storage_.push_back(std::move(scope));
+      return raw;
+    }
+
+    if (head->next != nullptr) {
+      PushRunScopeChain(head->next);
+      head->next = nullptr;
+    }
+
+    return head;
+  }
+
+  void ReleaseRunScope(RunScope* scope) {
+    // drop the MLValue references so a pooled scope does not pin input and
+    // output tensors between runs; the containers keep their capacity and
+    // the cached frame keeps its planned allocations.
+    scope->copied_feeds.clear();
+    scope->fetches.clear();
+    scope->next = nullptr;
+    PushRunScopeChain(scope);
+  }
+
+  void PushRunScopeChain(RunScope* chain) {
+    RunScope* tail = chain;
+    while (tail->next != nullptr) {
+      tail = tail->next;
+    }
+
+    RunScope* head = run_scope_free_list_.load(std::memory_order_relaxed);
+    do {
+      tail->next = head;
+    } while (!run_scope_free_list_.compare_exchange_weak(head, chain,
+                                                         std::memory_order_release,
+                                                         std::memory_order_relaxed));
+  }
+
+  // Candidate executors tried by auto-tuning, in calibration order (see
+  // SessionOptions::enable_auto_tuning).
+  enum AutoTuningMode : int {
+    kAutoTuneSequential = 0,
+    kAutoTuneHybrid = 1,
+    kAutoTuneParallel = 2,
+    kAutoTuneModeCount = 3,
+  };
+
+  static const char* AutoTuningModeName(int mode) {
+    switch (mode) {
+      case kAutoTuneSequential:
+        return "sequential";
+      case kAutoTuneHybrid:
+        return "hybrid";
+      case kAutoTuneParallel:
+        return "parallel";
+      default:
+        return "unknown";
+    }
+  }
+
+  // Point the effective executor choice at one candidate. Called from
+  // Initialize under session_mutex_ or from RunImpl under auto_tuning_mutex_,
+  // so no concurrent Run sees a half-switched pair of flags.
+  void ApplyAutoTuningChoice(int mode) {
+    run_sequential_execution_ = mode == kAutoTuneSequential;
+    run_hybrid_execution_ = mode == kAutoTuneHybrid;
+  }
+
+  // Replay a persisted executor decision. Returns true when a valid decision
+  // was read and applied; a missing or unrecognized file means calibration
+  // runs from scratch.
+  bool LoadAutoTuningDecision() {
+    if (session_options_.auto_tuning_cache_filepath.empty()) {
+      return false;
+    }
+
+    std::ifstream decision_file(session_options_.auto_tuning_cache_filepath);
+    if (!decision_file) {
+      return false;
+    }
+
+    std::string mode_name;
+    decision_file >> mode_name;
+    for (int mode = 0; mode < kAutoTuneModeCount; ++mode) {
+      if (mode_name == AutoTuningModeName(mode)) {
+        auto_tuning_choice_ = mode;
+        ApplyAutoTuningChoice(mode);
+        return true;
+      }
+    }
+
+    LOGS(*session_logger_, WARNING) << "Auto-tuning: ignoring unrecognized cached decision '" << mode_name
+                                    << "' in " << session_options_.auto_tuning_cache_filepath;
+    return false;
+  }
+
+  void SaveAutoTuningDecision(int mode) {
+    if (session_options_.auto_tuning_cache_filepath.empty()) {
+      return;
+    }
+
+    std::ofstream decision_file(session_options_.auto_tuning_cache_filepath, std::ios::trunc);
+    if (!decision_file) {
+      LOGS(*session_logger_, WARNING) << "Auto-tuning: could not persist the executor decision to "
+                                      << session_options_.auto_tuning_cache_filepath;
+      return;
+    }
+    decision_file << AutoTuningModeName(mode) << "\n";
+  }
+
+  // Credit a finished calibration run to its candidate and advance the
+  // schedule; the last run locks in the fastest candidate. Called with
+  // auto_tuning_mutex_ held.
+  void RecordAutoTuningRun(const std::chrono::steady_clock::time_point& start, const Status& run_status) {
+    if (!run_status.IsOK()) {
+      // a failed run says nothing about executor speed; retry the slot.
+      return;
+    }
+
+    auto_tuning_totals_ns_[auto_tuning_config_] +=
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    if (++auto_tuning_runs_done_ < std::max(1, session_options_.auto_tuning_runs_per_config)) {
+      return;
+    }
+
+    auto_tuning_runs_done_ = 0;
+    if (++auto_tuning_config_ < kAutoTuneModeCount) {
+      return;
+    }
+
+    int best = kAutoTuneSequential;
+    for (int mode = best + 1; mode < kAutoTuneModeCount; ++mode) {
+      if (auto_tuning_totals_ns_[mode] < auto_tuning_totals_ns_[best]) {
+        best = mode;
+      }
+    }
+
+    auto_tuning_choice_ = best;
+    ApplyAutoTuningChoice(best);
+    SaveAutoTuningDecision(best);
+    // the release store publishes the executor flags to later runs, which
+    // read auto_tuning_active_ with acquire ordering and skip the mutex.
+    auto_tuning_active_.store(false, std::memory_order_release);
+    LOGS(*session_logger_, INFO) << "Auto-tuning: selected the " << AutoTuningModeName(best)
+                                 << " executor from the calibration runs.";
+  }
+
+  Status RunImpl(const RunOptions& run_options,
+                 const NameMLValMap& feeds,
+                 const std::vector<std::string>& output_names,
+                 std::vector<MLValue>* p_fetches,
+                 RunContext* run_context = nullptr,
+                 const std::unordered_map<std::string, AllocatorPtr>* donated_output_allocators = nullptr) {
     auto tp = session_profiler_.StartTime();
     Status retval = Status::OK();
+    RunScope* run_scope = nullptr;
+
+    // terminate flag plus the absolute deadline derived from the run timeout;
+    // checked cooperatively by the executors, the control flow kernels and
+    // the threaded math kernels.
+    const RunCancellation cancellation = RunCancellation::FromRunOptions(run_options);
+
+    // per-run thread cap: while this scope is active, parallel sections run
+    // on at most the requested number of pool lanes, and tasks this run
+    // schedules onto the pool inherit the cap, so a background run cannot
+    // starve latency-critical runs sharing the process-wide pool.
+    const ParallelismCapScope parallelism_cap{
+        run_options.max_intra_op_parallelism > 0
+            ? static_cast<std::size_t>(run_options.max_intra_op_parallelism)
+            : 0};
+
+    // calibration runs are serialized under auto_tuning_mutex_ so the
+    // executor choice can be switched per run; once the decision is locked
+    // in, auto_tuning_active_ reads false and runs proceed unserialized.
+    std::unique_lock<std::mutex> auto_tuning_lock;
+    std::chrono::steady_clock::time_point auto_tuning_start;
+    bool auto_tuning_timed = false;
+    if (run_context == nullptr && auto_tuning_active_.load(std::memory_order_acquire)) {
+      auto_tuning_lock = std::unique_lock<std::mutex>(auto_tuning_mutex_);
+      if (auto_tuning_active_.load(std::memory_order_relaxed)) {
+        if (donated_output_allocators != nullptr && !donated_output_allocators->empty()) {
+          // output donation constrains the executor choice, so run this one
+          // sequentially and keep it out of the measurements.
+          ApplyAutoTuningChoice(kAutoTuneSequential);
+        } else {
+          ApplyAutoTuningChoice(auto_tuning_config_);
+          auto_tuning_timed = true;
+          auto_tuning_start = std::chrono::steady_clock::now();
+        }
+      }
+    }
 
     try {
       {
@@ -739,10 +1412,12 @@ class InferenceSession::Impl {
         }
       }
 
+      const auto validation_start = std::chrono::steady_clock::now();
       ONNXRUNTIME_CHECK_AND_SET_RETVAL(ValidateInputs(feeds));
 
       // if the output vector is non-empty, ensure that its the same size as the output_names
       ONNXRUNTIME_CHECK_AND_SET_RETVAL(ValidateOutputs(output_names, p_fetches));
+      telemetry_.RecordPhase(SessionTelemetry::kValidation, ElapsedMicroseconds(validation_start));
 
       if (!run_options.run_tag.empty()) {
         LOGS(*session_logger_, INFO) << "Running with tag: " << run_options.run_tag;
@@ -762,24 +1437,127 @@ class InferenceSession::Impl {
       for (auto& xp : execution_providers_)
         ONNXRUNTIME_CHECK_AND_SET_RETVAL(xp->OnRunStart());
 
-      NameMLValMap copied_feeds;
-      ONNXRUNTIME_CHECK_AND_SET_RETVAL(CopyInputsAcrossDevices(session_state_, feeds, copied_feeds));
+      // a RunContext carries its own cached structures; every other Run
+      // checks a recycled scope out of the freelist.
+      if (run_context == nullptr) {
+        run_scope = AcquireRunScope();
+      }
+
+      NameMLValMap local_feeds;
+      std::vector<MLValue> local_fetches;
+      NameMLValMap& copied_feeds = run_scope != nullptr ? run_scope->copied_feeds : local_feeds;
+      std::vector<MLValue>& new_fetches = run_scope != nullptr ? run_scope->fetches : local_fetches;
 
-      std::vector<MLValue> new_fetches;
+      ONNXRUNTIME_CHECK_AND_SET_RETVAL(CopyInputsAcrossDevices(feeds, copied_feeds));
       ONNXRUNTIME_CHECK_AND_SET_RETVAL(MatchOutputsWithProviders(output_names, *p_fetches, new_fetches));
 
-      std::unique_ptr<IExecutor> p_exec;
+      const bool has_donations = donated_output_allocators != nullptr && !donated_output_allocators->empty();
+
+      // resolve the donated output names against the frame once it exists;
+      // the frame validates each donation against the allocation plan.
+      auto apply_output_donations = [&](ExecutionFrame& frame) -> Status {
+        if (!has_donations)
+          return Status::OK();
+        const auto& mlvalue_idx_map = session_state_.GetMLValueNameIdxMap();
+        for (const auto& donation : *donated_output_allocators) {
+          int mlvalue_idx;
+          ONNXRUNTIME_RETURN_IF_ERROR(mlvalue_idx_map.GetIdx(donation.first, mlvalue_idx));
+          ONNXRUNTIME_RETURN_IF_ERROR(frame.SetDonatedOutputAllocator(mlvalue_idx, donation.second));
+        }
+        return Status::OK();
+      };
+
+      if (has_donations && (run_context != nullptr ||
+                            (!session_options_.enable_pipeline_execution &&
+                             !run_hybrid_execution_ &&
+                             !run_sequential_execution_))) {
+        // the parallel executor and a RunContext build their frames
+        // internally, so there is no seam to hand the donations through.
+        ONNXRUNTIME_CHECK_AND_SET_RETVAL(ONNXRUNTIME_MAKE_STATUS(
+            ONNXRUNTIME, INVALID_ARGUMENT,
+            "Output donation requires pipeline, hybrid or sequential execution."));
+      }
 
-      if (retval.IsOK()) {
-        if (session_options_.enable_sequential_execution) {
-          p_exec = std::unique_ptr<IExecutor>(new SequentialExecutor(run_options.terminate));
-        } else {
-          p_exec = std::unique_ptr<IExecutor>(new ParallelExecutor(session_state_, run_options.terminate));
+      const auto execution_start = std::chrono::steady_clock::now();
+      if (run_context != nullptr) {
+        // the context owns a cached execution frame and runs it sequentially.
+        ONNXRUNTIME_CHECK_AND_SET_RETVAL(run_context->Execute(copied_feeds, output_names, new_fetches,
+                                                              cancellation, run_options.run_tag, run_logger));
+      } else if (session_options_.enable_pipeline_execution) {
+        // stage-by-stage execution on the scope's cached frame: each stage
+        // runs behind its own lock, so concurrent Run calls stream through
+        // the plan. scopes come off a freelist, which gives every in-flight
+        // frame its own buffers for the values crossing stage boundaries.
+        if (retval.IsOK()) {
+          if (!run_scope->frame) {
+            run_scope->frame = std::make_unique<ExecutionFrame>(copied_feeds, output_names, new_fetches,
+                                                                session_state_);
+          } else {
+            retval = run_scope->frame->Reuse(copied_feeds, output_names, new_fetches);
+          }
         }
+
+        ONNXRUNTIME_CHECK_AND_SET_RETVAL(apply_output_donations(*run_scope->frame));
+
+        if (retval.IsOK()) {
+          PipelineExecutor executor(cancellation, run_options.run_tag);
+          retval = executor.Execute(session_state_, *run_scope->frame, copied_feeds, output_names,
+                                    new_fetches, run_logger);
+        }
+      } else if (run_hybrid_execution_) {
+        // region-by-region scheduling on the scope's cached frame: wide
+        // regions of independent nodes dispatch to the thread pool, the
+        // sequential stretches run inline.
+        if (retval.IsOK()) {
+          if (!run_scope->frame) {
+            run_scope->frame = std::make_unique<ExecutionFrame>(copied_feeds, output_names, new_fetches,
+                                                                session_state_);
+          } else {
+            retval = run_scope->frame->Reuse(copied_feeds, output_names, new_fetches);
+          }
+        }
+
+        ONNXRUNTIME_CHECK_AND_SET_RETVAL(apply_output_donations(*run_scope->frame));
+
+        if (retval.IsOK()) {
+          HybridExecutor executor(cancellation, run_options.run_tag);
+          retval = executor.Execute(session_state_, *run_scope->frame, copied_feeds, output_names,
+                                    new_fetches, run_logger);
+        }
+      } else if (run_sequential_execution_) {
+        // drive the scope's cached frame directly, mirroring
+        // RunContext::Execute, so the frame's vectors are rebuilt in place.
+        if (retval.IsOK()) {
+          if (!run_scope->frame) {
+            run_scope->frame = std::make_unique<ExecutionFrame>(copied_feeds, output_names, new_fetches,
+                                                                session_state_);
+          } else {
+            retval = run_scope->frame->Reuse(copied_feeds, output_names, new_fetches);
+          }
+        }
+
+        ONNXRUNTIME_CHECK_AND_SET_RETVAL(apply_output_donations(*run_scope->frame));
+
+        if (retval.IsOK()) {
+          SequentialExecutor executor(cancellation, run_options.run_tag);
+          retval = executor.Execute(session_state_, *run_scope->frame, copied_feeds, output_names,
+                                    new_fetches, run_logger);
+        }
+      } else {
+        // the parallel executor builds its own frame; the scope still
+        // recycles the feeds and fetches containers.
+        ParallelExecutor executor(session_state_, cancellation, run_options.run_tag);
+        if (run_options.output_ready_callback) {
+          executor.SetOutputReadyCallback(run_options.output_ready_callback);
+        }
+        ONNXRUNTIME_CHECK_AND_SET_RETVAL(executor.Execute(session_state_, copied_feeds, output_names,
+                                                          new_fetches, run_logger));
       }
+      telemetry_.RecordPhase(SessionTelemetry::kExecution, ElapsedMicroseconds(execution_start));
 
-      ONNXRUNTIME_CHECK_AND_SET_RETVAL(p_exec->Execute(session_state_, copied_feeds, output_names, new_fetches, run_logger));
-      ONNXRUNTIME_CHECK_AND_SET_RETVAL(CopyOutputsAcrossDevices(new_fetches, *p_fetches));
+      const auto fetch_copy_start = std::chrono::steady_clock::now();
+      ONNXRUNTIME_CHECK_AND_SET_RETVAL(CopyOutputsAcrossDevices(run_options, output_names, new_fetches, *p_fetches));
+      telemetry_.RecordPhase(SessionTelemetry::kFetchCopy, ElapsedMicroseconds(fetch_copy_start));
 
     } catch (const std::exception& e) {
       retval = Status(common::ONNXRUNTIME, common::FAIL, e.what());
@@ -787,15 +1565,343 @@ class InferenceSession::Impl {
       retval = Status(common::ONNXRUNTIME, common::RUNTIME_EXCEPTION, "Encountered unknown exception in Run()");
     }
 
+    if (run_scope != nullptr) {
+      ReleaseRunScope(run_scope);
+    }
+
     // info all execution providers InferenceSession:Run ended
     for (auto& xp : execution_providers_)
       ONNXRUNTIME_CHECK_AND_SET_RETVAL(xp->OnRunEnd());
 
+    if (auto_tuning_timed) {
+      RecordAutoTuningRun(auto_tuning_start, retval);
+    }
+
     --current_num_runs_;
+    telemetry_.RecordRunEnd(retval.IsOK());
     session_profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "model_run", tp);
     return retval;
   }
 
+  // A Run call participating in a micro batch. Lives on the caller's stack;
+  // the leader fills in status and fetches before setting done.
+  struct MicroBatchRequest {
+    const NameMLValMap* feeds = nullptr;
+    std::vector<MLValue> fetches;
+    common::Status status;
+    bool done = false;
+    int64_t batch_size = 0;
+  };
+
+  // A group of compatible requests executed as one combined run. Lives on the
+  // leader's stack while open_micro_batch_ points at it.
+  struct MicroBatch {
+    std::vector<MicroBatchRequest*> requests;
+    std::vector<std::string> output_names;
+    int64_t total_batch_size = 0;
+    bool executing = false;
+  };
+
+  // Checks whether a request can participate in a micro batch: all inputs
+  // must be non-string CPU tensors sharing the same batch dimension, and the
+  // outputs must not be pre-allocated as they cannot alias the combined run.
+  bool IsMicroBatchable(const NameMLValMap& feeds,
+                        const std::vector<MLValue>* p_fetches,
+                        int64_t& batch_size) const {
+    for (const auto& fetch : *p_fetches) {
+      if (fetch.IsAllocated()) {
+        return false;
+      }
+    }
+
+    batch_size = -1;
+    for (const auto& feed : feeds) {
+      if (!feed.second.IsTensor()) {
+        return false;
+      }
+      const Tensor& tensor = feed.second.Get<Tensor>();
+      if (tensor.DataType() == DataTypeImpl::GetType<std::string>()) {
+        return false;
+      }
+      if (strcmp(tensor.Location().name, CPU) != 0) {
+        return false;
+      }
+      if (tensor.Shape().NumDimensions() < 1) {
+        return false;
+      }
+      if (batch_size == -1) {
+        batch_size = tensor.Shape()[0];
+      } else if (batch_size != tensor.Shape()[0]) {
+        return false;
+      }
+    }
+
+    return batch_size >= 1;
+  }
+
+  // Two feed sets are batch compatible when they bind the same inputs with
+  // the same element types and shapes, the batch dimension aside.
+  static bool AreFeedsBatchCompatible(const NameMLValMap& lhs, const NameMLValMap& rhs) {
+    if (lhs.size() != rhs.size()) {
+      return false;
+    }
+
+    for (const auto& feed : lhs) {
+      auto it = rhs.find(feed.first);
+      if (it == rhs.end()) {
+        return false;
+      }
+      const Tensor& lhs_tensor = feed.second.Get<Tensor>();
+      const Tensor& rhs_tensor = it->second.Get<Tensor>();
+      if (lhs_tensor.DataType() != rhs_tensor.DataType()) {
+        return false;
+      }
+      const auto& lhs_dims = lhs_tensor.Shape().GetDims();
+      const auto& rhs_dims = rhs_tensor.Shape().GetDims();
+      if (lhs_dims.size() != rhs_dims.size()) {
+        return false;
+      }
+      for (size_t i = 1; i < lhs_dims.size(); ++i) {
+        if (lhs_dims[i] != rhs_dims[i]) {
+          return false;
+        }
+      }
+    }
+
+    return true;
+  }
+
+  // Concatenates the inputs of all requests in the batch along dimension 0.
+  // This is the degenerate axis-0 case of the Concat operator, which on a
+  // contiguous layout reduces to appending the per-request buffers.
+  common::Status ConcatenateFeeds(const MicroBatch& batch, NameMLValMap& merged_feeds) {
+    AllocatorPtr cpu_allocator =
+        execution_providers_.Get(onnxruntime::kCpuExecutionProvider)->GetAllocator(0, ONNXRuntimeMemTypeDefault);
+
+    for (const auto& feed : *batch.requests.front()->feeds) {
+      const Tensor& first = feed.second.Get<Tensor>();
+      std::vector<int64_t> dims = first.Shape().GetDims();
+      dims[0] = batch.total_batch_size;
+      TensorShape merged_shape(dims);
+
+      auto element_type = first.DataType();
+      void* buffer = cpu_allocator->Alloc(element_type->Size() * merged_shape.Size());
+      std::unique_ptr<Tensor> merged = std::make_unique<Tensor>(element_type, merged_shape, buffer,
+                                                                cpu_allocator->Info(), cpu_allocator);
+
+      char* output = static_cast<char*>(merged->MutableDataRaw());
+      for (const auto* request : batch.requests) {
+        const Tensor& tensor = request->feeds->at(feed.first).Get<Tensor>();
+        size_t bytes = element_type->Size() * tensor.Shape().Size();
+        memcpy(output, tensor.DataRaw(), bytes);
+        output += bytes;
+      }
+
+      MLValue value;
+      value.Init(merged.release(),
+                 DataTypeImpl::GetType<Tensor>(),
+                 DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+      merged_feeds.insert(std::make_pair(feed.first, value));
+    }
+
+    return common::Status::OK();
+  }
+
+  // Splits each combined output back into per-request tensors along dimension 0.
+  common::Status SplitFetches(MicroBatch& batch, const std::vector<MLValue>& merged_fetches) {
+    AllocatorPtr cpu_allocator =
+        execution_providers_.Get(onnxruntime::kCpuExecutionProvider)->GetAllocator(0, ONNXRuntimeMemTypeDefault);
+
+    for (const auto& fetched : merged_fetches) {
+      if (!fetched.IsTensor()) {
+        return common::Status(common::ONNXRUNTIME, common::FAIL,
+                              "Micro-batching requires tensor outputs.");
+      }
+      const Tensor& merged = fetched.Get<Tensor>();
+      if (merged.DataType() == DataTypeImpl::GetType<std::string>()) {
+        return common::Status(common::ONNXRUNTIME, common::FAIL,
+                              "Micro-batching does not support string outputs.");
+      }
+      const TensorShape& merged_shape = merged.Shape();
+      if (merged_shape.NumDimensions() < 1 || merged_shape[0] != batch.total_batch_size) {
+        return common::Status(common::ONNXRUNTIME, common::FAIL,
+                              "Output is not batched along dimension 0 so the combined run cannot be split. "
+                              "Disable enable_micro_batching for this model.");
+      }
+
+      auto element_type = merged.DataType();
+      size_t row_bytes = element_type->Size() * merged_shape.SizeFromDimension(1);
+      const char* input = static_cast<const char*>(merged.DataRaw());
+      for (auto* request : batch.requests) {
+        std::vector<int64_t> dims = merged_shape.GetDims();
+        dims[0] = request->batch_size;
+        TensorShape split_shape(dims);
+
+        void* buffer = cpu_allocator->Alloc(element_type->Size() * split_shape.Size());
+        std::unique_ptr<Tensor> split = std::make_unique<Tensor>(element_type, split_shape, buffer,
+                                                                 cpu_allocator->Info(), cpu_allocator);
+        size_t bytes = row_bytes * request->batch_size;
+        memcpy(split->MutableDataRaw(), input, bytes);
+        input += bytes;
+
+        MLValue value;
+        value.Init(split.release(),
+                   DataTypeImpl::GetType<Tensor>(),
+                   DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+        request->fetches.push_back(value);
+      }
+    }
+
+    return common::Status::OK();
+  }
+
+  // Runs all requests gathered into the batch as one combined run.
+  void ExecuteMicroBatch(const RunOptions& run_options, MicroBatch& batch) {
+    if (batch.requests.size() == 1) {
+      // the window expired without company; skip the concat/split round trip.
+      auto* request = batch.requests.front();
+      request->status = RunImpl(run_options, *request->feeds, batch.output_names, &request->fetches);
+      return;
+    }
+
+    NameMLValMap merged_feeds;
+    std::vector<MLValue> merged_fetches;
+    common::Status status = ConcatenateFeeds(batch, merged_feeds);
+    if (status.IsOK()) {
+      status = RunImpl(run_options, merged_feeds, batch.output_names, &merged_fetches);
+    }
+    if (status.IsOK()) {
+      status = SplitFetches(batch, merged_fetches);
+    }
+
+    if (!status.IsOK()) {
+      for (auto* request : batch.requests) {
+        request->status = status;
+      }
+    }
+  }
+
+  // Gathers compatible concurrent requests into one run. The first request in
+  // a window becomes the leader and blocks until the window closes; followers
+  // join the open batch and wait for the leader to execute it. Returns false
+  // when the request cannot be batched and should run standalone.
+  bool TryRunMicroBatched(const RunOptions& run_options,
+                          const NameMLValMap& feeds,
+                          const std::vector<std::string>& output_names,
+                          std::vector<MLValue>* p_fetches,
+                          common::Status& status) {
+    int64_t batch_size;
+    if (!IsMicroBatchable(feeds, p_fetches, batch_size)) {
+      return false;
+    }
+
+    MicroBatchRequest request;
+    request.feeds = &feeds;
+    request.batch_size = batch_size;
+
+    const int max_size = std::max(session_options_.micro_batch_max_size, 1);
+
+    std::unique_lock<std::mutex> lock(micro_batch_mutex_);
+
+    MicroBatch* open_batch = open_micro_batch_;
+    if (open_batch != nullptr && !open_batch->executing &&
+        static_cast<int>(open_batch->requests.size()) < max_size &&
+        open_batch->output_names == output_names &&
+        AreFeedsBatchCompatible(*open_batch->requests.front()->feeds, feeds)) {
+      // join as a follower and wait for the leader to run the combined batch.
+      open_batch->requests.push_back(&request);
+      open_batch->total_batch_size += batch_size;
+      telemetry_.AddMicroBatchDepth(1);
+      if (static_cast<int>(open_batch->requests.size()) == max_size) {
+        // the batch is full; wake the leader before its window expires.
+        micro_batch_cv_.notify_all();
+      }
+      micro_batch_cv_.wait(lock, [&request] { return request.done; });
+    } else {
+      // start a new batch and become its leader.
+      MicroBatch batch;
+      batch.requests.push_back(&request);
+      batch.output_names = output_names;
+      batch.total_batch_size = batch_size;
+      open_micro_batch_ = &batch;
+      telemetry_.AddMicroBatchDepth(1);
+
+      auto deadline = std::chrono::steady_clock::now() +
+                      std::chrono::microseconds(session_options_.micro_batch_timeout_microseconds);
+      micro_batch_cv_.wait_until(lock, deadline, [&batch, max_size] {
+        return static_cast<int>(batch.requests.size()) >= max_size;
+      });
+
+      batch.executing = true;
+      if (open_micro_batch_ == &batch) {
+        open_micro_batch_ = nullptr;
+      }
+      telemetry_.AddMicroBatchDepth(-static_cast<int64_t>(batch.requests.size()));
+
+      lock.unlock();
+      ExecuteMicroBatch(run_options, batch);
+      lock.lock();
+
+      for (auto* batched_request : batch.requests) {
+        batched_request->done = true;
+      }
+      micro_batch_cv_.notify_all();
+    }
+
+    status = request.status;
+    *p_fetches = std::move(request.fetches);
+    return true;
+  }
+
+  common::Status RunAsync(const RunOptions& run_options,
+                          const NameMLValMap& feeds,
+                          const std::vector<std::string>& output_names,
+                          std::vector<MLValue> fetches,
+                          InferenceSession::RunAsyncCallback callback) {
+    if (!callback) {
+      return common::Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "callback must not be empty");
+    }
+
+    {
+      std::lock_guard<std::mutex> l(session_mutex_);
+      if (!is_inited_) {
+        LOGS(*session_logger_, ERROR) << "Session was not initialized";
+        return common::Status(common::ONNXRUNTIME, common::FAIL, "Session not initialized.");
+      }
+
+      // lazily create the pool so sessions that only use the synchronous Run
+      // don't pay for idle threads. Group sessions skip it: their async runs
+      // are scheduled on the shared group pool under the session's priority.
+      if (group_thread_pool_ == nullptr && !async_run_pool_) {
+        int pool_size = session_options_.session_thread_pool_size == 0
+                            ? std::thread::hardware_concurrency() / 2
+                            : session_options_.session_thread_pool_size;
+        if (pool_size < 1)
+          pool_size = 1;
+        async_run_pool_ = std::make_unique<TaskThreadPool>(pool_size, ResolveThreadAffinityMasks());
+      }
+    }
+
+    // run_options is not copyable as the terminate mechanism relies on all
+    // users sharing one instance, so the caller must keep it alive until the
+    // callback fires.
+    const RunOptions* p_run_options = &run_options;
+    telemetry_.OnAsyncRunQueued();
+    std::packaged_task<void()> task{
+        [this, p_run_options, feeds, output_names, fetches = std::move(fetches), callback]() mutable {
+          auto status = Run(*p_run_options, feeds, output_names, &fetches);
+          telemetry_.OnAsyncRunCompleted();
+          callback(status, fetches);
+        }};
+
+    if (group_thread_pool_ != nullptr) {
+      group_thread_pool_->RunTask(std::move(task), SessionTaskPriority());
+    } else {
+      async_run_pool_->RunTask(std::move(task));
+    }
+    return common::Status::OK();
+  }
+
   std::pair<common::Status, const ModelMetadata*> GetModelMetadata() const {
     {
       std::lock_guard<std::mutex> l(session_mutex_);
@@ -835,6 +1941,201 @@ class InferenceSession::Impl {
     return std::make_pair(common::Status::OK(), &output_def_list_);
   }
 
+  common::Status InferOutputShapes(const std::vector<std::pair<std::string, std::vector<int64_t>>>& input_shapes,
+                                   const std::vector<std::string>& output_names,
+                                   std::vector<std::vector<int64_t>>* p_output_shapes) {
+    if (p_output_shapes == nullptr) {
+      return common::Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "p_output_shapes cannot be null");
+    }
+    {
+      std::lock_guard<std::mutex> l(session_mutex_);
+      if (!is_inited_) {
+        LOGS(*session_logger_, ERROR) << "Session was not initialized";
+        return common::Status(common::ONNXRUNTIME, common::FAIL, "Session not initialized.");
+      }
+    }
+
+    p_output_shapes->clear();
+    p_output_shapes->reserve(output_names.size());
+
+    std::map<std::string, TensorShape> named_input_shapes;
+    for (const auto& input : input_shapes) {
+      named_input_shapes[input.first] = TensorShape(input.second);
+    }
+
+    // exact answer when a run with these input shapes already populated the
+    // shape binding cache with the fetched output shapes.
+    auto bindings = session_state_.FindShapeBindingsByNamedInputs(named_input_shapes);
+    if (bindings != nullptr) {
+      bool all_outputs_recorded = true;
+      for (const auto& name : output_names) {
+        auto it = bindings->output_shapes.find(name);
+        if (it == bindings->output_shapes.end()) {
+          all_outputs_recorded = false;
+          break;
+        }
+        p_output_shapes->push_back(it->second.GetDims());
+      }
+      if (all_outputs_recorded) {
+        return common::Status::OK();
+      }
+      p_output_shapes->clear();
+    }
+
+    // fall back to the statically inferred shapes, resolving the symbolic
+    // dimensions the model shares between an input and an output (e.g. a
+    // "batch" dim_param) against the given input shapes.
+    std::unordered_map<std::string, int64_t> symbolic_dims;
+    for (const auto* def : required_input_def_list_) {
+      auto it = named_input_shapes.find(def->Name());
+      const ONNX_NAMESPACE::TensorShapeProto* shape_proto = def->Shape();
+      if (it == named_input_shapes.end() || shape_proto == nullptr ||
+          static_cast<size_t>(shape_proto->dim_size()) != it->second.NumDimensions()) {
+        continue;
+      }
+      for (int i = 0; i < shape_proto->dim_size(); ++i) {
+        const auto& dim = shape_proto->dim(i);
+        if (dim.has_dim_param()) {
+          symbolic_dims[dim.dim_param()] = it->second[i];
+        }
+      }
+    }
+
+    for (const auto& name : output_names) {
+      const onnxruntime::NodeArg* def = nullptr;
+      for (const auto* output_def : output_def_list_) {
+        if (output_def->Name() == name) {
+          def = output_def;
+          break;
+        }
+      }
+      if (def == nullptr) {
+        return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "'", name, "' is not a model output.");
+      }
+
+      const ONNX_NAMESPACE::TensorShapeProto* shape_proto = def->Shape();
+      if (shape_proto == nullptr) {
+        return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, "The rank of output '", name,
+                                       "' is not known statically; run once with these input shapes "
+                                       "so the shape binding cache can answer exactly.");
+      }
+
+      std::vector<int64_t> dims(shape_proto->dim_size());
+      for (int i = 0; i < shape_proto->dim_size(); ++i) {
+        const auto& dim = shape_proto->dim(i);
+        if (dim.has_dim_value()) {
+          dims[i] = dim.dim_value();
+        } else if (dim.has_dim_param() && symbolic_dims.count(dim.dim_param()) != 0) {
+          dims[i] = symbolic_dims[dim.dim_param()];
+        } else {
+          dims[i] = -1;
+        }
+      }
+      p_output_shapes->push_back(std::move(dims));
+    }
+
+    return common::Status::OK();
+  }
+
+  SessionTelemetry::Snapshot GetTelemetrySnapshot() const {
+    return telemetry_.GetSnapshot();
+  }
+
+  common::Status GetMemoryStats(MemoryStats& stats) {
+    {
+      std::lock_guard<std::mutex> l(session_mutex_);
+      if (!is_inited_) {
+        LOGS(*session_logger_, ERROR) << "Session was not initialized";
+        return common::Status(common::ONNXRUNTIME, common::FAIL, "Session not initialized.");
+      }
+    }
+
+    stats.allocators.clear();
+    stats.nodes.clear();
+
+    // Per-allocator usage; arenas additionally expose fragmentation figures.
+    for (const auto& provider : execution_providers_) {
+      for (const auto& allocator : provider->GetAllocatorMap()) {
+        AllocatorMemoryStats allocator_stats;
+        allocator_stats.location = allocator->Info().name;
+        if (auto* arena = dynamic_cast<BFCArena*>(allocator.get())) {
+          allocator_stats.is_arena = true;
+          AllocatorStats arena_usage;
+          arena->GetStats(&arena_usage);
+          allocator_stats.bytes_in_use = arena_usage.bytes_in_use;
+          allocator_stats.total_allocated_bytes = arena_usage.total_allocated_bytes;
+          allocator_stats.max_bytes_in_use = arena_usage.max_bytes_in_use;
+          allocator_stats.num_allocs = arena_usage.num_allocs;
+          ArenaFragmentationStats fragmentation;
+          arena->GetFragmentationStats(&fragmentation);
+          allocator_stats.free_bytes = fragmentation.free_bytes;
+          allocator_stats.largest_free_chunk_bytes = fragmentation.largest_free_chunk_bytes;
+          allocator_stats.num_free_chunks = fragmentation.num_free_chunks;
+        }
+        stats.allocators.push_back(std::move(allocator_stats));
+      }
+    }
+
+    // Per-node planned allocations from the execution plan. Sizes are only
+    // known up front for outputs with fully static declared shapes; the rest
+    // are counted as dynamic.
+    const SequentialExecutionPlan* plan = session_state_.GetExecutionPlan();
+    const onnxruntime::GraphViewer* graph = session_state_.GetGraphViewer();
+    const auto& name_idx_map = session_state_.GetMLValueNameIdxMap();
+    if (plan != nullptr && graph != nullptr) {
+      for (const auto& step : plan->execution_plan) {
+        const auto* node = graph->GetNode(step.node_index);
+        if (node == nullptr) continue;
+        NodeMemoryStats node_stats;
+        node_stats.node_name = node->Name();
+        node_stats.op_type = node->OpType();
+        for (const auto* def : node->OutputDefs()) {
+          if (!def->Exists()) continue;
+          int idx = -1;
+          if (!name_idx_map.GetIdx(def->Name(), idx).IsOK()) continue;
+          const auto& value_plan = plan->allocation_plan[idx];
+          if (value_plan.alloc_kind == AllocKind::kReuse) {
+            node_stats.num_reused_buffers++;
+            continue;
+          }
+          if (value_plan.alloc_kind != AllocKind::kAllocate &&
+              value_plan.alloc_kind != AllocKind::kAllocateOutput) {
+            continue;
+          }
+          node_stats.num_planned_allocs++;
+          int64_t bytes = -1;
+          MLDataType ml_type = value_plan.value_type;
+          if (ml_type != nullptr && ml_type->IsTensorType()) {
+            const auto* shape = def->Shape();
+            if (shape != nullptr) {
+              int64_t elements = 1;
+              bool is_static = true;
+              for (const auto& dim : shape->dim()) {
+                if (!dim.has_dim_value()) {
+                  is_static = false;
+                  break;
+                }
+                elements *= dim.dim_value();
+              }
+              if (is_static) {
+                auto elem_type = static_cast<const TensorTypeBase*>(ml_type)->GetElementType();
+                bytes = elements * static_cast<int64_t>(elem_type->Size());
+              }
+            }
+          }
+          if (bytes >= 0) {
+            node_stats.planned_bytes += bytes;
+          } else {
+            node_stats.num_dynamic_allocs++;
+          }
+        }
+        stats.nodes.push_back(std::move(node_stats));
+      }
+    }
+
+    return common::Status::OK();
+  }
+
   common::Status NewIOBinding(std::unique_ptr<IOBinding>* io_binding) {
     {
       std::lock_guard<std::mutex> l(session_mutex_);
@@ -852,6 +2153,22 @@ class InferenceSession::Impl {
   common::Status Run(const RunOptions& run_options, IOBinding& io_binding) {
     // TODO should Run() call io_binding.SynchronizeInputs() or should it let the callers do it?
     // io_binding.SynchronizeInputs();
+    if (!io_binding.donated_output_allocators_.empty()) {
+      // a donated output gets a fresh block from its allocator every run, so
+      // a consumer can keep the previous fetch while the next run executes.
+      // Drop the previous run's values before they reach the frame as
+      // pre-allocated fetches.
+      for (size_t i = 0; i < io_binding.output_names_.size(); ++i) {
+        if (io_binding.donated_output_allocators_.count(io_binding.output_names_[i]) > 0) {
+          io_binding.outputs_[i] = MLValue();
+        }
+      }
+
+      // donated outputs go straight to RunImpl: micro batching merges the
+      // fetches of several callers and cannot honor a per-caller donation.
+      return RunImpl(run_options, io_binding.feeds_, io_binding.output_names_, &io_binding.outputs_,
+                     nullptr, &io_binding.donated_output_allocators_);
+    }
     return Run(run_options, io_binding.feeds_, io_binding.output_names_, &io_binding.outputs_);
   }
 
@@ -860,10 +2177,34 @@ class InferenceSession::Impl {
     return Run(run_options, io_binding);
   }
 
+  common::Status NewRunContext(std::unique_ptr<RunContext>* run_context) {
+    {
+      std::lock_guard<std::mutex> l(session_mutex_);
+      if (!is_inited_) {
+        LOGS(*session_logger_, ERROR) << "Session was not initialized";
+        return common::Status(common::ONNXRUNTIME, common::FAIL, "Session not initialized.");
+      }
+    }
+
+    // private constructor, can't use make_unique
+    *run_context = std::unique_ptr<RunContext>(new RunContext(session_state_));
+    return Status::OK();
+  }
+
+  common::Status Run(const RunOptions& run_options,
+                     const NameMLValMap& feeds,
+                     const std::vector<std::string>& output_names,
+                     std::vector<MLValue>* p_fetches,
+                     RunContext& run_context) {
+    // the context owns a dedicated execution frame, so this path never
+    // participates in micro batching.
+    return RunImpl(run_options, feeds, output_names, p_fetches, &run_context);
+  }
+
   void StartProfiling(const std::string& file_prefix) {
     std::ostringstream ss;
     ss << file_prefix << "_" << GetCurrentTimeString() << ".json";
-    session_profiler_.StartProfiling(ss.str());
+    session_profiler_.StartProfiling(ss.str(), session_options_.enable_lightweight_profiling);
   }
 
   void StartProfiling(const logging::Logger* logger_ptr) {
@@ -878,16 +2219,58 @@ class InferenceSession::Impl {
     return std::string();
   }
 
- private:
-  static std::pair<bool, size_t> Contains(const std::vector<std::string>& output_names,
-                                          const std::string& name) {
-    auto it = std::find(std::begin(output_names), std::end(output_names), name);
-    if (it == output_names.end()) {
-      return {false, 0};
+  std::string GetProfileSummary() {
+    return session_profiler_.GetSummary();
+  }
+
+  common::Status WarmUp(const std::vector<NameMLValMap>& representative_feeds) {
+    {
+      std::lock_guard<std::mutex> l(session_mutex_);
+      if (!is_inited_) {
+        LOGS(*session_logger_, ERROR) << "Session was not initialized";
+        return common::Status(common::ONNXRUNTIME, common::FAIL, "Session not initialized.");
+      }
+    }
+
+    // touch one byte per page of every initializer so the first request does
+    // not fault the weights in on its critical path.
+    constexpr size_t kPageSize = 4096;
+    size_t prefaulted_bytes = 0;
+    volatile unsigned char sink = 0;
+    for (const auto& entry : session_state_.GetInitializedTensors()) {
+      const MLValue& value = entry.second;
+      if (!value.IsTensor()) continue;
+      const Tensor& weight = value.Get<Tensor>();
+      if (weight.DataType() == DataTypeImpl::GetType<std::string>()) continue;
+      const auto* data = static_cast<const unsigned char*>(weight.DataRaw());
+      size_t bytes = weight.Size();
+      if (data == nullptr || bytes == 0) continue;
+      for (size_t offset = 0; offset < bytes; offset += kPageSize) {
+        sink += data[offset];
+      }
+      sink += data[bytes - 1];
+      prefaulted_bytes += bytes;
     }
-    return {true, it - output_names.begin()};
+    ONNXRUNTIME_UNUSED_PARAMETER(sink);
+
+    // run each representative feed set end to end with the outputs discarded,
+    // populating the memory pattern cache and any provider-side caches (e.g.
+    // conv algorithm selections) for exactly the shapes production will send.
+    std::vector<std::string> output_names(model_output_names_.begin(), model_output_names_.end());
+    for (const auto& feeds : representative_feeds) {
+      RunOptions run_options;
+      run_options.run_tag = "warmup";
+      std::vector<MLValue> fetches;
+      ONNXRUNTIME_RETURN_IF_ERROR(Run(run_options, feeds, output_names, &fetches));
+    }
+
+    LOGS(*session_logger_, INFO) << "Session warmup complete: pre-faulted " << prefaulted_bytes
+                                 << " bytes of initializers and ran " << representative_feeds.size()
+                                 << " representative feed set(s).";
+    return common::Status::OK();
   }
 
+ private:
   bool HasLocalSchema() const {
     return !custom_schema_registries_.empty();
   }
@@ -1031,6 +2414,10 @@ class InferenceSession::Impl {
   // Profiler for this session.
   profiling::Profiler session_profiler_;
 
+  // rolling run telemetry; snapshots are read lock-free by monitoring
+  // threads, see core/framework/session_telemetry.h.
+  SessionTelemetry telemetry_;
+
   ExecutionProviders execution_providers_;
 
   KernelRegistryManager kernel_registry_manager_;
@@ -1057,8 +2444,23 @@ class InferenceSession::Impl {
   // names of model inputs and outputs used for quick validation.
   std::unordered_set<std::string> required_model_input_names_;
   std::unordered_set<std::string> model_input_names_;
+
+  // state tensors retained across Run calls, keyed by the input they feed
+  // next call; see SessionOptions.retained_state_pairs
+  NameMLValMap retained_states_;
+  std::mutex retained_states_mutex_;
   std::unordered_set<std::string> model_output_names_;
 
+  // feed signatures that already passed input validation; later Runs with a
+  // matching signature skip the per-Run name and type walks.
+  std::vector<FeedSignature> validated_feed_signatures_;  // GUARDED_BY(validated_feed_signatures_mutex_)
+  mutable std::mutex validated_feed_signatures_mutex_;
+
+  // cross-device copy plans resolved once by BuildFeedFetchCopyPlans; both
+  // are immutable after Initialize so Run reads them without locking.
+  std::unordered_map<std::string, std::vector<FeedCopyTarget>> feed_copy_plan_;
+  std::unordered_map<std::string, FetchSourceInfo> fetch_source_plan_;
+
   // Environment for this session
   // not used now; we'll need it when we introduce threadpool
   // statically allocated pointer, no need to manage its lifetime.
@@ -1066,11 +2468,30 @@ class InferenceSession::Impl {
 
   // Threadpool for this session
   //thread::ThreadPool thread_pool_; // not used for now; will add it later when implementing RunAsync
-  std::unique_ptr<TaskThreadPool> thread_pool_;
+  std::unique_ptr<WorkStealingThreadPool> thread_pool_;
+
+  // Shared pool of this session's group, owned by the Environment. Non-null
+  // when session_options_.session_group is set, in which case thread_pool_
+  // and async_run_pool_ stay null.
+  WorkStealingThreadPool* group_thread_pool_ = nullptr;
 
   // Number of concurrently running executors
   std::atomic<int> current_num_runs_;
 
+  // Effective executor choice read by RunImpl. Mirrors the SessionOptions
+  // flags until auto-tuning calibration locks in a faster candidate.
+  bool run_sequential_execution_ = true;
+  bool run_hybrid_execution_ = false;
+
+  // Auto-tuning calibration state. auto_tuning_active_ gates the RunImpl
+  // hook; the rest is GUARDED_BY(auto_tuning_mutex_).
+  std::atomic<bool> auto_tuning_active_{false};
+  std::mutex auto_tuning_mutex_;
+  int auto_tuning_config_ = kAutoTuneSequential;
+  int auto_tuning_runs_done_ = 0;
+  int auto_tuning_choice_ = kAutoTuneSequential;
+  int64_t auto_tuning_totals_ns_[kAutoTuneModeCount] = {};
+
   mutable std::mutex session_mutex_;  // to ensure only one thread can invoke Load/Initialize
   bool is_model_loaded_ = false;      // GUARDED_BY(session_mutex_)
   bool is_inited_ = false;            // GUARDED_BY(session_mutex_)
@@ -1078,8 +2499,31 @@ class InferenceSession::Impl {
   std::map<ONNXRuntimeAllocatorInfo, BufferUniquePtr> weights_buffers_;
   InsertCastTransformer insert_cast_transformer_;
 
+  // true once this session holds a reference on WeightsCache for
+  // session_options_.shared_weights_key
+  bool owns_shared_weights_ref_ = false;
+
   // memory allocations for any subgraphs
   std::vector<SubgraphMemory> subgraph_memory_;
+
+  // lock-free freelist of recycled per-Run structures. The storage vector
+  // owns the nodes, so freelist links stay valid until the session is
+  // destroyed; the mutex only guards the cold path that grows the storage.
+  std::atomic<RunScope*> run_scope_free_list_{nullptr};
+  std::mutex run_scope_storage_mutex_;
+  std::vector<std::unique_ptr<RunScope>> run_scope_storage_;  // GUARDED_BY(run_scope_storage_mutex_)
+
+  // micro-batching state. open_micro_batch_ points at the batch currently
+  // accepting requests; the batch itself lives on its leader's stack.
+  std::mutex micro_batch_mutex_;
+  std::condition_variable micro_batch_cv_;
+  MicroBatch* open_micro_batch_ = nullptr;  // GUARDED_BY(micro_batch_mutex_)
+
+  // Threadpool that drives RunAsync requests. Created on first use.
+  // Declared last so it is destroyed first and in-flight runs finish before
+  // the rest of the session state is torn down. Runs still queued when the
+  // session is destroyed are dropped without invoking their callbacks.
+  std::unique_ptr<TaskThreadPool> async_run_pool_;  // creation GUARDED_BY(session_mutex_)
 };  // namespace onnxruntime
 
 //
@@ -1121,6 +2565,14 @@ common::Status InferenceSession::Run(const RunOptions& run_options,
   return impl_->Run(run_options, feeds, output_names, p_fetches);
 }
 
+common::Status InferenceSession::RunAsync(const RunOptions& run_options,
+                                          const NameMLValMap& feeds,
+                                          const std::vector<std::string>& output_names,
+                                          std::vector<MLValue> fetches,
+                                          RunAsyncCallback callback) {
+  return impl_->RunAsync(run_options, feeds, output_names, std::move(fetches), std::move(callback));
+}
+
 std::pair<common::Status, const ModelMetadata*> InferenceSession::GetModelMetadata() const {
   return impl_->GetModelMetadata();
 }
@@ -1133,6 +2585,21 @@ std::pair<common::Status, const OutputDefList*> InferenceSession::GetModelOutput
   return impl_->GetModelOutputs();
 }
 
+common::Status InferenceSession::InferOutputShapes(
+    const std::vector<std::pair<std::string, std::vector<int64_t>>>& input_shapes,
+    const std::vector<std::string>& output_names,
+    std::vector<std::vector<int64_t>>* p_output_shapes) {
+  return impl_->InferOutputShapes(input_shapes, output_names, p_output_shapes);
+}
+
+common::Status InferenceSession::GetMemoryStats(MemoryStats& stats) {
+  return impl_->GetMemoryStats(stats);
+}
+
+SessionTelemetry::Snapshot InferenceSession::GetTelemetrySnapshot() const {
+  return impl_->GetTelemetrySnapshot();
+}
+
 int InferenceSession::GetCurrentNumRuns() {
   return impl_->GetCurrentNumRuns();
 }
@@ -1149,6 +2616,18 @@ std::string InferenceSession::EndProfiling() {
   return impl_->EndProfiling();
 }
 
+std::string InferenceSession::GetProfileSummary() {
+  return impl_->GetProfileSummary();
+}
+
+common::Status InferenceSession::WarmUp(const std::vector<NameMLValMap>& representative_feeds) {
+  return impl_->WarmUp(representative_feeds);
+}
+
+common::Status InferenceSession::ResetRetainedStates() {
+  return impl_->ResetRetainedStates();
+}
+
 common::Status InferenceSession::RegisterExecutionProvider(std::unique_ptr<IExecutionProvider> p_exec_provider) {
   return impl_->RegisterExecutionProvider(std::move(p_exec_provider));
 }
@@ -1181,6 +2660,22 @@ common::Status InferenceSession::Run(IOBinding& io_binding) {
   return impl_->Run(io_binding);
 }
 
+common::Status InferenceSession::NewRunContext(std::unique_ptr<RunContext>* run_context) {
+  return impl_->NewRunContext(run_context);
+}
+
+common::Status InferenceSession::Run(const RunOptions& run_options,
+                                     const NameMLValMap& feeds,
+                                     const std::vector<std::string>& output_names,
+                                     std::vector<MLValue>* p_fetches,
+                                     RunContext& run_context) {
+  return impl_->Run(run_options, feeds, output_names, p_fetches, run_context);
+}
+
+common::Status InferenceSession::CopyFetchToHost(const MLValue& fetch, MLValue& host_fetch) {
+  return impl_->CopyFetchToHost(fetch, host_fetch);
+}
+
 common::Status InferenceSession::LoadCustomOps(const std::vector<std::string>& dso_list) {
   return impl_->LoadCustomOps(dso_list);
 }
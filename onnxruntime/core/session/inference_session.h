@@ -3,12 +3,16 @@
 
 #pragma once
 
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "core/common/common.h"
 #include "core/common/status.h"
 #include "core/framework/framework_common.h"
+#include "core/framework/session_telemetry.h"
 #include "core/graph/basic_types.h"
 #include "core/common/logging/logging.h"
 
@@ -23,6 +27,7 @@ class ModelProto;
 namespace onnxruntime {
 class IExecutionProvider;  // forward decl
 class IOBinding;
+class RunContext;
 
 class CustomRegistry;
 
@@ -37,15 +42,127 @@ struct SessionOptions {
   //int num_threads; // not used now until we re-introduce threadpools for async execution
   bool enable_sequential_execution = true;  // TODO: should we default to sequential execution?
 
+  // Pick the executor per region of the graph instead of once for the whole
+  // graph: at Initialize the execution plan is grouped into regions of
+  // mutually independent nodes, and at Run regions wide enough to cover the
+  // dispatch overhead go to the thread pool while the rest runs inline.
+  // Suits graphs with a wide parallel section and a long sequential tail,
+  // where neither executor alone wins. Takes precedence over
+  // enable_sequential_execution.
+  bool enable_hybrid_execution = false;
+
+  // Partition the execution plan into pipeline stages at Initialize and run
+  // each stage behind its own lock: when several Run calls are in flight,
+  // stage i of one frame overlaps stage i-1 of the next, so a stream of
+  // frames submitted from a couple of caller threads approaches stage-count
+  // times the single-run throughput without changing per-frame latency.
+  // Suits running one model over a stream of inputs (e.g. video frames);
+  // a single caller thread sees plain sequential behavior. Takes precedence
+  // over enable_hybrid_execution and enable_sequential_execution.
+  bool enable_pipeline_execution = false;
+
+  // Number of pipeline stages to split the plan into. Stages are balanced by
+  // estimated node cost; plans too short to split fall back to sequential
+  // execution. Only meaningful when enable_pipeline_execution is true.
+  int pipeline_stage_count = 2;
+
+  // Pick the executor from timed calibration runs instead of from the flags
+  // above: the first auto_tuning_runs_per_config Run calls execute the
+  // sequential executor, the next batch the hybrid executor and the next the
+  // parallel executor, each serialized and wall-clock timed; the mode with
+  // the lowest total time then serves every later Run. Calibration should
+  // therefore see representative traffic. When auto_tuning_cache_filepath is
+  // set the decision is persisted there and a valid file is replayed at
+  // Initialize, skipping calibration — place it next to the
+  // optimized_model_filepath artifact so the model ships with its
+  // configuration. Not applied when enable_pipeline_execution or
+  // enable_micro_batching is set; those modes reshape the Run pattern itself.
+  bool enable_auto_tuning = false;
+  int auto_tuning_runs_per_config = 3;
+  std::string auto_tuning_cache_filepath;
+
   // enable profiling for this session.
   bool enable_profiling = false;
 
+  // Record profile events into lock-free per-thread ring buffers instead of
+  // a mutex protected vector, keeping the recording overhead low enough to
+  // leave profiling enabled on live traffic. Only the most recent events of
+  // each thread are kept and event arguments are not recorded.
+  // Only meaningful when enable_profiling is true.
+  bool enable_lightweight_profiling = false;
+
+  // Attribute hardware performance counters (CPU cycles, retired
+  // instructions, last-level cache misses and the backend stall ratio) to
+  // each node span in the profile, so a slow kernel can be classified as
+  // memory-bound or FLOP-bound from the trace alone. Uses Linux perf_event;
+  // silently falls back to wall time only where counters are unavailable
+  // (other platforms, or restrictive kernel.perf_event_paranoid settings).
+  // Counters are read on the thread that launches the kernel, so spans of
+  // nodes that run asynchronously on a device measure only the host-side
+  // launch. Only meaningful when enable_profiling is true; not recorded in
+  // the lightweight mode, which keeps no event arguments.
+  bool enable_hardware_counter_profiling = false;
+
+  // Flush denormal floats to zero (FTZ/DAZ) on the session's compute
+  // threads. Denormal operands — decaying RNN states are a reliable source —
+  // drop the SSE units into an assist path costing 10-100x a normal
+  // multiply; with this set they round to zero instead. This is a fast-math
+  // contract: kernels may assume denormal inputs and results read as zero,
+  // so bit-exact IEEE gradual underflow is given up. The mode is applied to
+  // the thread creating the session and to every pool worker (the executors
+  // and the MLAS workers run on those pools); it is process-wide, so it also
+  // affects other sessions sharing the process, and threads the application
+  // itself calls Run from keep their own floating point environment.
+  bool enable_denormal_as_zero = false;
+
   // enable the memory pattern optimization.
   // The idea is if the input shapes are the same, we could trace the internal memory allocation
   // and generate a memory pattern for future request. So next time we could just do one allocation
   // with a big chunk for all the internal memory allocation.
   bool enable_mem_pattern = true;
 
+  // Bucket granularity for the memory pattern cache. When zero (the default)
+  // patterns are cached per exact input shapes, so models fed dynamic shapes
+  // (e.g. variable sequence lengths) rarely hit the cache. When set to N, the
+  // input dimensions are rounded up to the next multiple of N for the cache
+  // lookup, so all shapes in a bucket share one pattern planned for the
+  // largest shapes seen so far in that bucket. Only meaningful when
+  // enable_mem_pattern is true.
+  int64_t memory_pattern_bucket_size = 0;
+
+  // Byte budget for peak activation memory under the sequential executor.
+  // When the planner's modeled peak (from statically known shapes) exceeds
+  // the budget, outputs of cheap nodes (Relu, BatchNormalization, ...) are
+  // freed right after their first use and the producing node is re-executed
+  // before each later use, trading a little recompute for footprint. 0 (the
+  // default) disables the mode. Values with symbolic shapes are neither
+  // modeled nor dropped, and the mode stands down when any executor other
+  // than the sequential one may run the plan. Most effective with
+  // enable_mem_pattern disabled, since a memory pattern preallocates the
+  // whole footprint in one block.
+  int64_t activation_memory_budget = 0;
+
+  // Order the execution plan with a lifetime-aware heuristic that minimizes
+  // modeled peak memory instead of the graph's default topological order:
+  // whenever several nodes are ready, the one whose execution grows live
+  // memory the least runs first, so large activations (e.g. skip
+  // connections) are consumed and freed as early as the dependencies allow.
+  // Any valid topological order is equivalent in results, so this is safe
+  // with every executor; the modeling relies on statically known shapes and
+  // degenerates to the default order for fully symbolic graphs.
+  bool enable_memory_aware_scheduling = false;
+
+  // Memoize the results of 'If' branch executions across Run calls. When the
+  // taken branch receives byte-identical inputs to its previous execution the
+  // cached branch outputs are copied into the If outputs instead of
+  // re-executing the branch. Pays off when a predicate and the values feeding
+  // the heavy branch are constant across requests (e.g. config-driven
+  // pre/post-processing); the cache holds the last result per branch and
+  // stores private copies, so cached data is never aliased by downstream
+  // kernels. Values that cannot be byte-compared (string tensors, non-CPU or
+  // non-tensor values) bypass the cache.
+  bool enable_subgraph_memoization = false;
+
   // enable the memory arena on CPU
   // Arena may pre-allocate memory for future usage.
   // set this option to false if you don't want it.
@@ -61,6 +178,123 @@ struct SessionOptions {
 
   // How many threads in the session thread pool.
   int session_thread_pool_size = 0;
+
+  // Pin the session's worker threads to logical processors. Entry i is the
+  // affinity bitmask for worker i (bit k set => logical processor k); when
+  // the pool has more workers than entries the masks are reused round-robin,
+  // so a single entry pins every worker to the same processor set. Empty
+  // (the default) leaves the workers unpinned.
+  std::vector<uint64_t> thread_pool_affinity_masks;
+
+  // Confine the session's worker threads to the logical processors of one
+  // NUMA node, keeping them close to memory the session allocates there.
+  // -1 (the default) means no binding. Ignored when
+  // thread_pool_affinity_masks is non-empty, and when the node's processor
+  // set cannot be resolved the workers run unpinned.
+  int thread_pool_numa_node = -1;
+
+  // Replicate large read-only CPU weights onto every NUMA node and serve each
+  // run from the replica local to the thread that starts it, so multi-socket
+  // hosts read weights through their own memory controllers instead of the
+  // socket interconnect. Costs one extra copy of the replicated weights per
+  // node; no effect on single-node hosts. Weights shared across sessions via
+  // shared_weights_key are still replicated per session.
+  bool enable_numa_weight_replication = false;
+
+  // Replace each ZipMap node whose output leaves the graph with plain
+  // parallel arrays: for a map output named "Z" the session instead exposes
+  // "Z_labels" (the class labels from the ZipMap attributes) and "Z_scores"
+  // (the raw score tensor). Skips the per-sample std::map construction the
+  // seq(map) output type requires, which dominates the post-processing cost
+  // of large-batch sklearn classifiers. Callers must fetch the new output
+  // names and pair labels with scores by position.
+  bool elide_zipmap_outputs = false;
+
+  // Path to save the model to after graph transformations have been applied during
+  // Initialize. Processes that restart frequently can load the saved model with
+  // skip_graph_transformations set and avoid re-running the transformers every time.
+  std::string optimized_model_filepath;
+
+  // Path where the graph partitioner persists its node-to-provider assignment,
+  // typically placed next to the model file. When the file exists and its key
+  // (graph contents plus provider list) matches, a warm startup replays the
+  // stored assignment instead of re-running every provider's capability
+  // negotiation; a stale or mismatched file is ignored. Only the main graph
+  // participates, subgraphs are always partitioned from scratch.
+  std::string partition_cache_filepath;
+
+  // Coalesce concurrent Run calls into one larger batch. Requests whose
+  // inputs differ only in the batch dimension (dimension 0) are gathered until
+  // micro_batch_max_size requests are queued or micro_batch_timeout_microseconds
+  // elapse, concatenated along dimension 0, executed once and the outputs
+  // split per request. Only valid for models where every input and output is
+  // batched along dimension 0; a batch runs under the RunOptions of its first
+  // request. Off by default.
+  bool enable_micro_batching = false;
+  int micro_batch_max_size = 16;
+  int micro_batch_timeout_microseconds = 1000;
+
+  // Skip the graph transformers during Initialize. Intended for models produced via
+  // optimized_model_filepath, which have already been transformed. Partitioning,
+  // copy/cast node insertion and planning still run as their results are not
+  // captured in the model file.
+  bool skip_graph_transformations = false;
+
+  // If non-empty, immutable CPU weight tensors are shared across all sessions
+  // created with the same key via a process-wide cache, so N sessions serving one
+  // model keep a single copy of its initializers. Use a key that uniquely
+  // identifies the model content, e.g. path plus deployment version. Takes
+  // precedence over the weights part of enable_mem_pattern since shared tensors
+  // must own standalone buffers.
+  std::string shared_weights_key;
+
+  // Let CPU weight tensors alias the initializer bytes owned by the loaded model
+  // instead of copying them into separately allocated buffers. Halves peak memory
+  // and removes the copy during load for large models. The model is kept in memory
+  // for the session lifetime (it is today regardless).
+  bool enable_zero_copy_weights = false;
+
+  // Convert the model from float32 to float16 during Initialize so it runs
+  // in half precision on the CUDA execution provider (tensor cores on Volta
+  // and later), without re-exporting the model. Weights are converted at
+  // load time; graph inputs and outputs keep their float32 types with casts
+  // inserted at the boundaries, and numerically sensitive ops (softmax,
+  // reductions) keep computing in float32. Ignored when no CUDA execution
+  // provider is registered. Expect some accuracy loss; validate the model
+  // output before enabling in production.
+  bool enable_float16_execution = false;
+
+  // Keep the named state tensors inside the session across Run calls, for
+  // streaming models that carry recurrent state (e.g. LSTM h/c) from one
+  // frame to the next. Each pair names {state output, state input it feeds
+  // on the next call}. After every Run the session retains the state
+  // outputs' MLValues — wherever the producing kernel left them, so device
+  // resident states stay device resident — and injects them as the paired
+  // inputs of the next Run, so per-frame calls supply only the new frame
+  // without fetch/feed round trips for the states. The first Run of a
+  // sequence must feed the initial states; call
+  // InferenceSession::ResetRetainedStates to start a new sequence. Retained
+  // states are shared session state: concurrent Runs of independent
+  // sequences need separate sessions. Not compatible with
+  // enable_micro_batching.
+  std::vector<std::pair<std::string, std::string>> retained_state_pairs;
+
+  // Name of the session group this session belongs to. Sessions sharing a
+  // non-empty group name run on one scheduler/thread pool owned by the
+  // Environment instead of each creating their own, so co-hosted models share
+  // a bounded set of worker threads. The first session created in a group
+  // fixes the pool size and worker affinity (from session_thread_pool_size
+  // and the affinity options above); those settings are ignored for later
+  // sessions in the group. Empty (the default) keeps per-session pools.
+  std::string session_group;
+
+  // Priority class of this session's tasks on the group pool: 0 (the
+  // default) is normal, any positive value is high. Workers pick up queued
+  // high priority tasks before normal ones, so a request to a high priority
+  // model overtakes a background model's queued work at the next task
+  // boundary instead of waiting behind it; a task already running is never
+  // interrupted. Only meaningful when session_group is set.
+  int session_priority = 0;
 };
 
 /**
@@ -196,6 +430,31 @@ class InferenceSession {
                      const std::vector<std::string>& output_names,
                      std::vector<MLValue>* p_fetches);
 
+  /**
+    * Callback invoked when an asynchronous run completes. The status of the
+    * run and the fetched outputs are passed to the callback on a worker
+    * thread owned by the session.
+    */
+  using RunAsyncCallback = std::function<void(common::Status status, std::vector<MLValue>& fetches)>;
+
+  /**
+    * Run a pre-loaded and pre-initialized model asynchronously. The request is
+    * queued on the session's worker pool and this call returns immediately;
+    * the callback fires once the run completes. feeds, output_names and
+    * fetches are copied, so the caller may release its copies as soon as this
+    * call returns. run_options is shared, not copied, and must stay alive
+    * until the callback fires so the terminate mechanism keeps working.
+    * @param fetches output values in the order specified by output_names.
+    *        Pass an empty vector to let the session allocate all outputs, or
+    *        pre-allocated values to reuse their buffers.
+    * @return OK if the request was queued.
+    */
+  common::Status RunAsync(const RunOptions& run_options,
+                          const NameMLValMap& feeds,
+                          const std::vector<std::string>& output_names,
+                          std::vector<MLValue> fetches,
+                          RunAsyncCallback callback);
+
   /**
   * Creates a new binding object for binding inputs and outputs.
   * @param provider_type specifies the location where the inputs need to be potentially copied. 
@@ -206,6 +465,34 @@ class InferenceSession {
   common::Status Run(const RunOptions& run_options, IOBinding& io_binding);
   common::Status Run(IOBinding& io_binding);
 
+  /**
+  * Creates a reusable run context. A context caches the execution frame, the
+  * preallocated planned buffer and the feed/fetch index resolution across the
+  * Run calls routed through it, so repeated Runs with the same feed/output
+  * names and input shapes perform no per-run setup allocations.
+  * See RunContext class for more info.
+  */
+  common::Status NewRunContext(std::unique_ptr<RunContext>* run_context);
+
+  /**
+    * See Run(const RunOptions& run_options, const NameMLValMap& feeds,
+    * const std::vector<std::string>& output_names, std::vector<MLValue>* p_fetches)
+    * for details. This overload executes through the given reusable run context.
+    */
+  common::Status Run(const RunOptions& run_options,
+                     const NameMLValMap& feeds,
+                     const std::vector<std::string>& output_names,
+                     std::vector<MLValue>* p_fetches,
+                     RunContext& run_context);
+
+  /**
+    * Copies a fetch returned under RunOptions::kFetchLocationDevice to CPU
+    * memory. Values already in host memory (including non-tensor values) pass
+    * through without a copy, so callers can apply it unconditionally on first
+    * host access.
+    */
+  common::Status CopyFetchToHost(const MLValue& fetch, MLValue& host_fetch);
+
   /**
     * @return pair.first = OK; FAIL otherwise. pair.second is non-NULL when pair.first = OK.
     * @note lifetime of the returned pointer is valid as long as the Session object is live.
@@ -227,6 +514,80 @@ class InferenceSession {
     */
   std::pair<common::Status, const OutputDefList*> GetModelOutputs() const;
 
+  /**
+    * Infer the shapes of the requested outputs for the given input shapes
+    * without running the model. When a previous run with exactly these input
+    * shapes has populated the shape binding cache, the recorded output shapes
+    * are returned and every dimension is concrete. Otherwise the statically
+    * inferred shapes from the model are returned, with symbolic dimensions
+    * resolved against the given input shapes where the model names them and
+    * reported as -1 where they stay unknown. Intended for callers that
+    * preallocate output buffers and pass them to Run as fetches, which the
+    * execution frame then writes into directly.
+    * @param input_shapes name and dimensions of every model input.
+    * @param output_names the outputs to infer; must name model outputs.
+    * @param p_output_shapes receives one dimension vector per output name.
+    * @return OK if the shapes were resolved; FAIL when an output's rank is
+    *         not even statically known, in which case running once with these
+    *         shapes populates the cache and makes the query exact.
+    */
+  common::Status InferOutputShapes(const std::vector<std::pair<std::string, std::vector<int64_t>>>& input_shapes,
+                                   const std::vector<std::string>& output_names,
+                                   std::vector<std::vector<int64_t>>* p_output_shapes);
+
+  /**
+    * Current usage of one allocator. The fragmentation figures are only
+    * filled in when the allocator is an arena.
+    */
+  struct AllocatorMemoryStats {
+    std::string location;                 // allocator location name, e.g. "Cpu"
+    bool is_arena{false};
+    int64_t bytes_in_use{0};              // live allocations
+    int64_t total_allocated_bytes{0};     // reserved from the device allocator
+    int64_t max_bytes_in_use{0};          // peak of bytes_in_use
+    int64_t num_allocs{0};
+    int64_t free_bytes{0};                // bytes in the arena's free chunks
+    int64_t largest_free_chunk_bytes{0};  // biggest single allocation servable without growing
+    int64_t num_free_chunks{0};
+  };
+
+  /**
+    * Allocations the execution plan assigns to one node's outputs.
+    * planned_bytes only covers outputs whose declared shape is fully static;
+    * shape-dependent allocations are counted in num_dynamic_allocs instead.
+    */
+  struct NodeMemoryStats {
+    std::string node_name;
+    std::string op_type;
+    int64_t planned_bytes{0};
+    int64_t num_planned_allocs{0};  // outputs given fresh buffers by the plan
+    int64_t num_reused_buffers{0};  // outputs reusing another value's buffer
+    int64_t num_dynamic_allocs{0};
+  };
+
+  struct MemoryStats {
+    std::vector<AllocatorMemoryStats> allocators;
+    std::vector<NodeMemoryStats> nodes;  // in execution order
+  };
+
+  /**
+    * Take a snapshot of per-allocator memory usage and the planned per-node
+    * allocation sizes. Can only be called after the session is initialized,
+    * and is safe to call while Run calls are in flight.
+    * @return OK if success.
+    */
+  common::Status GetMemoryStats(MemoryStats& stats);
+
+  /**
+    * Take a snapshot of the session's rolling run telemetry: per-phase
+    * latency percentiles over a window of recent runs, run counters and the
+    * queue depths of the async and micro-batching paths. The snapshot reads
+    * atomic counters only, so it is safe and cheap to poll periodically from
+    * a monitoring thread while Run calls are in flight.
+    * See SessionTelemetry for the field semantics.
+    */
+  SessionTelemetry::Snapshot GetTelemetrySnapshot() const;
+
   /**
     * Get the current number of in-progress concurrent Run calls.
     */
@@ -252,6 +613,41 @@ class InferenceSession {
     */
   std::string EndProfiling();
 
+  /**
+    * Produce a compact JSON summary of the profile events recorded so far:
+    * per-op-type count, total, mean, approximate P99 and max kernel time,
+    * kernel time share per execution provider, and per-node invocation
+    * counts. Unlike EndProfiling this leaves profiling running, so it can
+    * be polled at any time. Summaries from two runs can be compared with
+    * profiling::Profiler::CompareSummaries to flag regressed ops.
+    @return the summary as a JSON string.
+    */
+  std::string GetProfileSummary();
+
+  /**
+    * Warm up a pre-loaded and pre-initialized session so the first real
+    * request runs at steady state latency instead of paying for lazily
+    * faulted weight pages and cold caches. Touches every page of every
+    * initializer, then runs each feed set in representative_feeds through
+    * the full pipeline with outputs discarded, which populates the memory
+    * pattern cache and any provider-side caches for those shapes. Returns
+    * only once warmup completes, so callers can hold traffic until then.
+    * @param representative_feeds complete feed sets covering the input
+    *        shapes expected in production. Pass an empty vector to only
+    *        pre-fault the weights.
+    * @return OK if the weights were pre-faulted and every warmup run succeeded.
+    */
+  common::Status WarmUp(const std::vector<NameMLValMap>& representative_feeds);
+
+  /**
+    * Drop the state tensors retained across Run calls (see
+    * SessionOptions.retained_state_pairs), so the next Run starts a fresh
+    * sequence from caller-supplied initial states. Thread-safe, but callers
+    * must not reset concurrently with Runs of the sequence being dropped.
+    * @return OK if success.
+    */
+  common::Status ResetRetainedStates();
+
  protected:
   /**
     * Load an ONNX model.
@@ -12,6 +12,7 @@
 
 #include "core/common/logging/logging.h"
 #include "core/common/logging/sinks/clog_sink.h"
+#include "core/common/profiler.h"
 #include "core/common/status.h"
 #include "core/graph/graph.h"
 #include "core/framework/allocator.h"
@@ -456,6 +457,81 @@ ONNXRUNTIME_API_STATUS_IMPL(ONNXRuntimeRunInference, _In_ ONNXSession* sess,
   API_IMPL_END
 }
 
+ONNXRUNTIME_API_STATUS_IMPL(ONNXRuntimeRunInferenceAsync, _In_ ONNXSession* sess,
+                            _In_ ONNXRuntimeRunOptions* run_options,
+                            _In_ const char* const* input_names, _In_ const ONNXValue* const* input, size_t input_len,
+                            _In_ const char* const* output_names1, size_t output_names_len, _Inout_ ONNXValue** output,
+                            _In_ ONNXRuntimeRunAsyncCallback callback, _In_opt_ void* user_data) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  if (callback == nullptr) {
+    return CreateONNXStatus(ONNXRUNTIME_INVALID_ARGUMENT, "callback cannot be NULL");
+  }
+  ::onnxruntime::NameMLValMap in;
+  const int queue_id = 0;
+  for (size_t i = 0; i != input_len; ++i) {
+    auto kvp = in.insert(std::make_pair(std::string(input_names[i]),
+                                        *reinterpret_cast<const ::onnxruntime::MLValue*>(input[i])));
+    if (!kvp.second) {
+      return CreateONNXStatus(ONNXRUNTIME_INVALID_ARGUMENT, "duplicated input name");
+    }
+    ::onnxruntime::MLValue& value = kvp.first->second;
+    if (value.Fence())
+      value.Fence()->BeforeUsingAsInput(onnxruntime::kCpuExecutionProvider, queue_id);
+  }
+  // Create output feed
+  std::vector<std::string> output_names(output_names_len);
+  for (size_t i = 0; i != output_names_len; ++i) {
+    if (output_names1[i] == nullptr || output_names1[i][0] == '\0') {
+      return CreateONNXStatus(ONNXRUNTIME_INVALID_ARGUMENT, "output name cannot be empty");
+    }
+    output_names[i] = output_names1[i];
+  }
+
+  std::vector<MLValue> fetches(output_names_len);
+  for (size_t i = 0; i != output_names_len; ++i) {
+    if (output[i] != nullptr) {
+      ::onnxruntime::MLValue& value = *reinterpret_cast<::onnxruntime::MLValue*>(output[i]);
+      if (value.Fence())
+        value.Fence()->BeforeUsingAsOutput(onnxruntime::kCpuExecutionProvider, queue_id);
+      fetches[i] = value;
+    }
+  }
+
+  // keep the run options alive until the run completes; supply defaults when
+  // the caller passed none.
+  if (run_options != nullptr) {
+    ONNXRuntimeAddRefToObject(run_options);
+  } else {
+    run_options = new ONNXRuntimeRunOptions();
+  }
+
+  Status status = session->RunAsync(
+      *run_options, in, output_names, std::move(fetches),
+      [run_options, output, output_names_len, callback, user_data](Status run_status,
+                                                                   std::vector<MLValue>& run_fetches) {
+        if (run_status.IsOK()) {
+          for (size_t i = 0; i != output_names_len; ++i) {
+            ::onnxruntime::MLValue& value = run_fetches[i];
+            if (value.Fence())
+              value.Fence()->BeforeUsingAsInput(onnxruntime::kCpuExecutionProvider, 0);
+            if (output[i] == nullptr) {
+              output[i] = reinterpret_cast<ONNXValue*>(new MLValue(value));
+            }
+          }
+        }
+        callback(user_data, output, output_names_len, run_status.IsOK() ? nullptr : ToONNXStatus(run_status));
+        ONNXRuntimeReleaseObject(run_options);
+      });
+
+  if (!status.IsOK()) {
+    ONNXRuntimeReleaseObject(run_options);
+    return ToONNXStatus(status);
+  }
+  return nullptr;
+  API_IMPL_END
+}
+
 ONNXRUNTIME_API_STATUS_IMPL(ONNXRuntimeGetTensorMutableData, _In_ ONNXValue* value, _Out_ void** output) {
   TENSOR_READWRITE_API_BEGIN
   //TODO: test if it's a string tensor
@@ -590,6 +666,112 @@ static ONNXStatus* GetInputOutputNameImpl(_In_ const ONNXSession* sess, size_t i
   return nullptr;
 }
 
+ONNXRUNTIME_API_STATUS_IMPL(ONNXRuntimeInferenceSessionGetMemoryStats, _In_ ONNXSession* sess,
+                            _Out_ ONNXRuntimeMemoryStats** out) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  auto stats = std::make_unique<::onnxruntime::InferenceSession::MemoryStats>();
+  Status st = session->GetMemoryStats(*stats);
+  if (!st.IsOK())
+    return ToONNXStatus(st);
+  *out = reinterpret_cast<ONNXRuntimeMemoryStats*>(stats.release());
+  return nullptr;
+  API_IMPL_END
+}
+
+ONNXRUNTIME_API(size_t, ONNXRuntimeMemoryStatsGetAllocatorCount, _In_ const ONNXRuntimeMemoryStats* stats) {
+  return reinterpret_cast<const ::onnxruntime::InferenceSession::MemoryStats*>(stats)->allocators.size();
+}
+
+ONNXRUNTIME_API_STATUS_IMPL(ONNXRuntimeMemoryStatsGetAllocatorStats, _In_ const ONNXRuntimeMemoryStats* stats,
+                            size_t index, _Out_ ONNXRuntimeAllocatorMemoryStats* out,
+                            _Out_opt_ const char** location) {
+  API_IMPL_BEGIN
+  auto real_stats = reinterpret_cast<const ::onnxruntime::InferenceSession::MemoryStats*>(stats);
+  if (index >= real_stats->allocators.size())
+    return CreateONNXStatus(ONNXRUNTIME_FAIL, "index out of range");
+  const auto& allocator = real_stats->allocators[index];
+  out->bytes_in_use = allocator.bytes_in_use;
+  out->total_allocated_bytes = allocator.total_allocated_bytes;
+  out->max_bytes_in_use = allocator.max_bytes_in_use;
+  out->num_allocs = allocator.num_allocs;
+  out->is_arena = allocator.is_arena ? 1 : 0;
+  out->free_bytes = allocator.free_bytes;
+  out->largest_free_chunk_bytes = allocator.largest_free_chunk_bytes;
+  out->num_free_chunks = allocator.num_free_chunks;
+  if (location != nullptr)
+    *location = allocator.location.c_str();
+  return nullptr;
+  API_IMPL_END
+}
+
+ONNXRUNTIME_API(size_t, ONNXRuntimeMemoryStatsGetNodeCount, _In_ const ONNXRuntimeMemoryStats* stats) {
+  return reinterpret_cast<const ::onnxruntime::InferenceSession::MemoryStats*>(stats)->nodes.size();
+}
+
+ONNXRUNTIME_API_STATUS_IMPL(ONNXRuntimeMemoryStatsGetNodeStats, _In_ const ONNXRuntimeMemoryStats* stats,
+                            size_t index, _Out_ ONNXRuntimeNodeMemoryStats* out,
+                            _Out_opt_ const char** node_name, _Out_opt_ const char** op_type) {
+  API_IMPL_BEGIN
+  auto real_stats = reinterpret_cast<const ::onnxruntime::InferenceSession::MemoryStats*>(stats);
+  if (index >= real_stats->nodes.size())
+    return CreateONNXStatus(ONNXRUNTIME_FAIL, "index out of range");
+  const auto& node = real_stats->nodes[index];
+  out->planned_bytes = node.planned_bytes;
+  out->num_planned_allocs = node.num_planned_allocs;
+  out->num_reused_buffers = node.num_reused_buffers;
+  out->num_dynamic_allocs = node.num_dynamic_allocs;
+  if (node_name != nullptr)
+    *node_name = node.node_name.c_str();
+  if (op_type != nullptr)
+    *op_type = node.op_type.c_str();
+  return nullptr;
+  API_IMPL_END
+}
+
+ONNXRUNTIME_API_STATUS_IMPL(ONNXRuntimeInferenceSessionGetTelemetry, _In_ ONNXSession* sess,
+                            _Out_ ONNXRuntimeSessionTelemetry* out) {
+  API_IMPL_BEGIN
+  static_assert(::onnxruntime::SessionTelemetry::kPhaseCount == ONNXRUNTIME_TELEMETRY_PHASE_COUNT,
+                "C API phase count is out of sync with SessionTelemetry");
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  const auto snapshot = session->GetTelemetrySnapshot();
+  out->run_count = snapshot.run_count;
+  out->failed_run_count = snapshot.failed_run_count;
+  out->async_queue_depth = snapshot.async_queue_depth;
+  out->micro_batch_queue_depth = snapshot.micro_batch_queue_depth;
+  for (int phase = 0; phase < ONNXRUNTIME_TELEMETRY_PHASE_COUNT; ++phase) {
+    out->phase_count[phase] = snapshot.phases[phase].count;
+    out->phase_average_microseconds[phase] = snapshot.phases[phase].average_microseconds;
+    out->phase_p50_microseconds[phase] = snapshot.phases[phase].p50_microseconds;
+    out->phase_p90_microseconds[phase] = snapshot.phases[phase].p90_microseconds;
+    out->phase_p99_microseconds[phase] = snapshot.phases[phase].p99_microseconds;
+  }
+  return nullptr;
+  API_IMPL_END
+}
+
+ONNXRUNTIME_API_STATUS_IMPL(ONNXRuntimeInferenceSessionGetProfileSummary, _In_ ONNXSession* sess,
+                            _Inout_ ONNXRuntimeAllocator* allocator, _Out_ char** out) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  *out = StrDup(session->GetProfileSummary(), allocator);
+  return nullptr;
+  API_IMPL_END
+}
+
+ONNXRUNTIME_API_STATUS_IMPL(ONNXRuntimeCompareProfileSummaries, _In_ const char* baseline_summary,
+                            _In_ const char* current_summary, double threshold,
+                            _Inout_ ONNXRuntimeAllocator* allocator, _Out_ char** out) {
+  API_IMPL_BEGIN
+  if (baseline_summary == nullptr || current_summary == nullptr)
+    return CreateONNXStatus(ONNXRUNTIME_INVALID_ARGUMENT, "summaries must not be null");
+  *out = StrDup(::onnxruntime::profiling::Profiler::CompareSummaries(baseline_summary, current_summary, threshold),
+                allocator);
+  return nullptr;
+  API_IMPL_END
+}
+
 ONNXRUNTIME_API(int, ONNXRuntimeIsTensor, _In_ const ONNXValue* value) {
   auto v = reinterpret_cast<const ::onnxruntime::MLValue*>(value);
   return v->IsTensor() ? 1 : 0;
@@ -632,8 +814,56 @@ ONNXRUNTIME_API_STATUS_IMPL(ONNXRuntimeInferenceSessionGetOutputName, _In_ const
   API_IMPL_END
 }
 
+ONNXRUNTIME_API_STATUS_IMPL(ONNXRuntimeInferenceSessionInferOutputShapes, _In_ ONNXSession* sess,
+                            _In_ const char* const* input_names,
+                            _In_ const struct ONNXRuntimeTensorTypeAndShapeInfo* const* input_shapes, size_t input_len,
+                            _In_ const char* const* output_names1, size_t output_names_len,
+                            _Out_ struct ONNXRuntimeTensorTypeAndShapeInfo** output_shapes) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+
+  std::vector<std::pair<std::string, std::vector<int64_t>>> in_shapes(input_len);
+  for (size_t i = 0; i != input_len; ++i) {
+    if (input_names[i] == nullptr || input_names[i][0] == '\0') {
+      return CreateONNXStatus(ONNXRUNTIME_INVALID_ARGUMENT, "input name cannot be empty");
+    }
+    in_shapes[i].first = input_names[i];
+    in_shapes[i].second.resize(ONNXRuntimeGetNumOfDimensions(input_shapes[i]));
+    ONNXRuntimeGetDimensions(input_shapes[i], in_shapes[i].second.data(), in_shapes[i].second.size());
+  }
+
+  std::vector<std::string> output_names(output_names_len);
+  for (size_t i = 0; i != output_names_len; ++i) {
+    if (output_names1[i] == nullptr || output_names1[i][0] == '\0') {
+      return CreateONNXStatus(ONNXRUNTIME_INVALID_ARGUMENT, "output name cannot be empty");
+    }
+    output_names[i] = output_names1[i];
+  }
+
+  std::vector<std::vector<int64_t>> out_shapes;
+  Status status = session->InferOutputShapes(in_shapes, output_names, &out_shapes);
+  if (!status.IsOK())
+    return ToONNXStatus(status);
+
+  for (size_t i = 0; i != output_names_len; ++i) {
+    ONNXRuntimeTensorTypeAndShapeInfo* info = ONNXRuntimeCreateTensorTypeAndShapeInfo();
+    ONNXStatus* set_status = ONNXRuntimeSetDims(info, out_shapes[i].data(), out_shapes[i].size());
+    if (set_status != nullptr) {
+      ONNXRuntimeReleaseObject(info);
+      for (size_t j = 0; j != i; ++j) {
+        ONNXRuntimeReleaseObject(output_shapes[j]);
+      }
+      return set_status;
+    }
+    output_shapes[i] = info;
+  }
+  return nullptr;
+  API_IMPL_END
+}
+
 DEFINE_RELEASE_ONNX_RUNTIME_OBJECT_FUNCTION(ONNXValue, MLValue)
 DEFINE_RELEASE_ONNX_RUNTIME_OBJECT_FUNCTION(ONNXSession, ::onnxruntime::InferenceSession)
+DEFINE_RELEASE_ONNX_RUNTIME_OBJECT_FUNCTION(ONNXRuntimeMemoryStats, ::onnxruntime::InferenceSession::MemoryStats)
 DEFINE_RELEASE_ONNX_RUNTIME_OBJECT_FUNCTION_FOR_ARRAY(ONNXStatus, char)
 
 ONNXRUNTIME_API(void, ReleaseONNXEnv, ONNXRuntimeEnv* env) {
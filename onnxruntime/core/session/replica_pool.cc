@@ -0,0 +1,82 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/replica_pool.h"
+
+#include <sstream>
+
+namespace onnxruntime {
+
+ReplicaPool::ReplicaPool(const SessionOptions& base_options, size_t num_replicas,
+                         logging::LoggingManager* logging_manager)
+    : in_flight_(num_replicas) {
+  ONNXRUNTIME_ENFORCE(num_replicas > 0, "A replica pool needs at least one replica.");
+
+  SessionOptions options = base_options;
+  // default the replicas onto one weight store and one scheduler pool. the
+  // pool's address keys both, so two pools in one process never collide.
+  std::ostringstream tag;
+  tag << "replica_pool_" << static_cast<const void*>(this);
+  if (options.shared_weights_key.empty()) {
+    options.shared_weights_key = tag.str();
+  }
+  if (options.session_group.empty()) {
+    options.session_group = tag.str();
+  }
+
+  replicas_.reserve(num_replicas);
+  for (size_t i = 0; i < num_replicas; ++i) {
+    SessionOptions replica_options = options;
+    if (!replica_options.session_logid.empty()) {
+      replica_options.session_logid += ".replica" + std::to_string(i);
+    }
+    replicas_.push_back(std::make_unique<InferenceSession>(replica_options, logging_manager));
+    in_flight_[i].store(0);
+  }
+}
+
+common::Status ReplicaPool::Load(const std::string& model_uri) {
+  for (auto& replica : replicas_) {
+    ONNXRUNTIME_RETURN_IF_ERROR(replica->Load(model_uri));
+  }
+  return common::Status::OK();
+}
+
+common::Status ReplicaPool::Initialize() {
+  for (auto& replica : replicas_) {
+    ONNXRUNTIME_RETURN_IF_ERROR(replica->Initialize());
+  }
+  return common::Status::OK();
+}
+
+size_t ReplicaPool::PickReplica() {
+  // scan the in-flight counts, starting at a rotating offset so ties on an
+  // idle pool still spread work across the devices instead of piling onto
+  // replica 0. the counts can move under us; a near-least-loaded pick is fine.
+  const size_t count = replicas_.size();
+  const size_t start = round_robin_.fetch_add(1) % count;
+  size_t best = start;
+  int best_load = in_flight_[start].load();
+  for (size_t i = 1; i < count; ++i) {
+    const size_t candidate = (start + i) % count;
+    const int load = in_flight_[candidate].load();
+    if (load < best_load) {
+      best = candidate;
+      best_load = load;
+    }
+  }
+  return best;
+}
+
+common::Status ReplicaPool::Run(const RunOptions& run_options,
+                                const NameMLValMap& feeds,
+                                const std::vector<std::string>& output_names,
+                                std::vector<MLValue>* p_fetches) {
+  const size_t replica = PickReplica();
+  in_flight_[replica].fetch_add(1);
+  auto status = replicas_[replica]->Run(run_options, feeds, output_names, p_fetches);
+  in_flight_[replica].fetch_sub(1);
+  return status;
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,68 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/status.h"
+#include "core/session/inference_session.h"
+
+namespace onnxruntime {
+
+/**
+  * Serves one model from several device-pinned replicas inside a single
+  * process, replacing the one-process-per-device sharding pattern.
+  *
+  * Each replica is an InferenceSession. Pin a replica to its device by
+  * registering a device-specific execution provider on it (e.g. one CUDA
+  * provider per device id) via Replica() before Load; the provider brings its
+  * own device arena, so each replica gets a device-pinned arena for free.
+  * Unless the caller sets them explicitly, the pool gives all replicas a
+  * common shared_weights_key and session_group, so the host copy of the
+  * weights is shared through the process-wide WeightsCache and all replicas
+  * run on one scheduler pool: an extra replica costs the device memory of its
+  * weights and arena, not another host copy of the model.
+  *
+  * Run dispatches each request to the replica with the fewest requests in
+  * flight, so a slow device or a burst on one queue shifts traffic to the
+  * others. Run is thread-safe, like InferenceSession::Run.
+  */
+class ReplicaPool {
+ public:
+  ReplicaPool(const SessionOptions& base_options, size_t num_replicas,
+              logging::LoggingManager* logging_manager = nullptr);
+
+  size_t NumReplicas() const { return replicas_.size(); }
+
+  /// Access replica `index`, e.g. to register its device-pinned execution
+  /// provider before Load.
+  InferenceSession& Replica(size_t index) { return *replicas_.at(index); }
+
+  /// Load the model into every replica.
+  common::Status Load(const std::string& model_uri);
+
+  /// Initialize every replica.
+  common::Status Initialize();
+
+  /// Run on the replica with the fewest requests in flight.
+  common::Status Run(const RunOptions& run_options,
+                     const NameMLValMap& feeds,
+                     const std::vector<std::string>& output_names,
+                     std::vector<MLValue>* p_fetches);
+
+ private:
+  ONNXRUNTIME_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ReplicaPool);
+
+  size_t PickReplica();
+
+  std::vector<std::unique_ptr<InferenceSession>> replicas_;
+  std::vector<std::atomic<int>> in_flight_;
+  std::atomic<size_t> round_robin_{0};
+};
+
+}  // namespace onnxruntime
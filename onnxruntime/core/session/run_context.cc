@@ -0,0 +1,33 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/run_context.h"
+#include "core/framework/execution_frame.h"
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/framework/sequential_executor.h"
+#include "core/framework/session_state.h"
+
+namespace onnxruntime {
+RunContext::RunContext(const SessionState& session_state) : session_state_(session_state) {
+}
+
+RunContext::~RunContext() = default;
+
+common::Status RunContext::Execute(const NameMLValMap& feeds,
+                                   const std::vector<std::string>& output_names,
+                                   std::vector<MLValue>& fetches,
+                                   const RunCancellation& cancellation,
+                                   const std::string& run_tag,
+                                   const logging::Logger& logger) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (!frame_) {
+    frame_ = std::make_unique<ExecutionFrame>(feeds, output_names, fetches, session_state_);
+  } else {
+    ONNXRUNTIME_RETURN_IF_ERROR(frame_->Reuse(feeds, output_names, fetches));
+  }
+
+  SequentialExecutor executor(cancellation, run_tag);
+  return executor.Execute(session_state_, *frame_, feeds, output_names, fetches, logger, &node_contexts_);
+}
+}  // namespace onnxruntime
@@ -0,0 +1,78 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "core/common/status.h"
+#include "core/framework/framework_common.h"
+#include "core/framework/ml_value.h"
+#include "core/framework/run_cancellation.h"
+#include "core/session/inference_session.h"
+#include "core/common/logging/logging.h"
+
+namespace onnxruntime {
+class ExecutionFrame;
+class OpKernelContextInternal;
+class SessionState;
+
+/**
+  * Reusable run context for repeated Run calls over the same feed and output
+  * names, e.g. fixed-shape vision models. Usage is as follows:
+  *
+  * InferenceSession session;
+  * session.Load();
+  * session.Initialize();
+  * ...
+  * unique_ptr<RunContext> run_context;
+  * session.NewRunContext(&run_context);
+  * while (...) {
+  *   session.Run(run_options, feeds, output_names, &fetches, *run_context);
+  * }
+  *
+  * The first Run through a context builds the execution frame as usual.
+  * Later Runs reuse the frame: the feed/fetch mlvalue indices resolved from
+  * the MLValueNameIdxMap, the per-node value tables and, as long as the
+  * cached memory pattern matches the input shapes, the preallocated planned
+  * buffer are all carried over, so a steady-state Run does not rebuild any
+  * per-run metadata and does not allocate.
+  *
+  * A context serializes the Runs routed through it; for concurrent Runs use
+  * one context per thread. Execution through a context is always sequential.
+  */
+class RunContext {
+ public:
+  ~RunContext();
+
+ private:
+  friend InferenceSession;
+
+  RunContext(const SessionState& session_state);
+
+  // Executes one run on the cached frame, creating the frame on first use.
+  common::Status Execute(const NameMLValMap& feeds,
+                         const std::vector<std::string>& output_names,
+                         std::vector<MLValue>& fetches,
+                         const RunCancellation& cancellation,
+                         const std::string& run_tag,
+                         const logging::Logger& logger);
+
+  const SessionState& session_state_;
+
+  // frame kept warm across Runs; guarded by mutex_ as a frame can only serve
+  // one run at a time.
+  std::unique_ptr<ExecutionFrame> frame_;
+
+  // per-plan-step kernel contexts kept warm alongside the frame. The first
+  // run constructs them; later runs re-point them at the frame by pointer
+  // swap, so per-node dispatch does no per-run setup.
+  std::vector<std::unique_ptr<OpKernelContextInternal>> node_contexts_;
+
+  std::mutex mutex_;
+
+  ONNXRUNTIME_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(RunContext);
+};
+}  // namespace onnxruntime
@@ -0,0 +1,91 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/session_slot.h"
+
+#include <sstream>
+
+#include "core/framework/weights_cache.h"
+
+namespace onnxruntime {
+
+SessionSlot::SessionSlot(const SessionOptions& base_options,
+                         logging::LoggingManager* logging_manager)
+    : options_(base_options), logging_manager_(logging_manager) {
+  // default every version onto one weight store. the slot's address keys it,
+  // so two slots in one process never collide.
+  if (options_.shared_weights_key.empty()) {
+    std::ostringstream tag;
+    tag << "session_slot_" << static_cast<const void*>(this);
+    options_.shared_weights_key = tag.str();
+  }
+}
+
+SessionSlot::~SessionSlot() = default;
+
+common::Status SessionSlot::LoadVersion(const std::string& model_uri,
+                                        std::shared_ptr<InferenceSession>& session) {
+  session = std::make_shared<InferenceSession>(options_, logging_manager_);
+  ONNXRUNTIME_RETURN_IF_ERROR(session->Load(model_uri));
+  return session->Initialize();
+}
+
+common::Status SessionSlot::Load(const std::string& model_uri) {
+  std::shared_ptr<InferenceSession> session;
+  ONNXRUNTIME_RETURN_IF_ERROR(LoadVersion(model_uri, session));
+
+  std::lock_guard<std::mutex> lock(active_mutex_);
+  active_ = std::move(session);
+  return common::Status::OK();
+}
+
+common::Status SessionSlot::Swap(const std::string& model_uri) {
+  // a new cache generation: the new version's initialization re-touches every
+  // weight it shares with the old one, so after the switch the untouched
+  // entries are exactly the old version's unique weights.
+  WeightsCache::Instance().BeginSwap(options_.shared_weights_key);
+
+  std::shared_ptr<InferenceSession> session;
+  common::Status status = LoadVersion(model_uri, session);
+  if (!status.IsOK()) {
+    // the failed load may have published some of its weights before dying.
+    // drop every entry rather than leak them; the active version keeps its
+    // tensors alive through its own references, and the next swap simply
+    // re-deserializes what the cache no longer holds.
+    WeightsCache::Instance().BeginSwap(options_.shared_weights_key);
+    WeightsCache::Instance().EndSwap(options_.shared_weights_key);
+    return status;
+  }
+
+  std::shared_ptr<InferenceSession> retired;
+  {
+    std::lock_guard<std::mutex> lock(active_mutex_);
+    retired = std::move(active_);
+    active_ = std::move(session);
+  }
+
+  WeightsCache::Instance().EndSwap(options_.shared_weights_key);
+
+  // the retired version drains here: destroyed now if idle, otherwise when
+  // the last Run still holding it returns.
+  retired.reset();
+  return common::Status::OK();
+}
+
+common::Status SessionSlot::Run(const RunOptions& run_options,
+                                const NameMLValMap& feeds,
+                                const std::vector<std::string>& output_names,
+                                std::vector<MLValue>* p_fetches) {
+  std::shared_ptr<InferenceSession> session = ActiveSession();
+  if (!session) {
+    return common::Status(common::ONNXRUNTIME, common::FAIL, "No model is loaded into this session slot.");
+  }
+  return session->Run(run_options, feeds, output_names, p_fetches);
+}
+
+std::shared_ptr<InferenceSession> SessionSlot::ActiveSession() {
+  std::lock_guard<std::mutex> lock(active_mutex_);
+  return active_;
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,75 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/status.h"
+#include "core/session/inference_session.h"
+
+namespace onnxruntime {
+
+/**
+  * Serves one logical model whose version can be replaced in place while
+  * requests keep flowing, replacing the build-a-second-session-and-repoint
+  * deployment pattern.
+  *
+  * The slot holds the active InferenceSession behind a shared_ptr. Run grabs
+  * that pointer and releases the slot immediately, so a Swap never waits on
+  * in-flight requests and requests never wait on a Swap: the old session
+  * drains naturally and is destroyed when its last in-flight Run returns.
+  *
+  * Swap loads and initializes the new version on the calling thread — invoke
+  * it from a background thread to keep serving at full rate — and then
+  * switches the active session atomically between Runs. Unless the caller
+  * sets one explicitly, the slot gives every version a common
+  * shared_weights_key, so initializers the new version carries over unchanged
+  * are picked up from the process-wide WeightsCache by content hash instead
+  * of being deserialized again; after the switch the cache entries only the
+  * old version used are dropped, so swap-time memory grows by the changed
+  * weights rather than a full second copy of the model.
+  */
+class SessionSlot {
+ public:
+  explicit SessionSlot(const SessionOptions& base_options,
+                       logging::LoggingManager* logging_manager = nullptr);
+  ~SessionSlot();
+
+  /// Load and initialize the first model version; the slot serves it until
+  /// the next Swap.
+  common::Status Load(const std::string& model_uri);
+
+  /// Load and initialize a new model version, then make it the active session
+  /// for subsequent Runs. In-flight Runs finish on the version they started
+  /// on. Not thread-safe against other Load/Swap calls; Run stays safe
+  /// throughout.
+  common::Status Swap(const std::string& model_uri);
+
+  /// Run on the currently active model version.
+  common::Status Run(const RunOptions& run_options,
+                     const NameMLValMap& feeds,
+                     const std::vector<std::string>& output_names,
+                     std::vector<MLValue>* p_fetches);
+
+  /// The active session, e.g. for metadata queries. The returned pointer
+  /// keeps its version alive even across a concurrent Swap.
+  std::shared_ptr<InferenceSession> ActiveSession();
+
+ private:
+  ONNXRUNTIME_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SessionSlot);
+
+  common::Status LoadVersion(const std::string& model_uri,
+                             std::shared_ptr<InferenceSession>& session);
+
+  SessionOptions options_;
+  logging::LoggingManager* logging_manager_;
+  std::mutex active_mutex_;
+  std::shared_ptr<InferenceSession> active_;
+};
+
+}  // namespace onnxruntime
@@ -207,6 +207,25 @@ void GemmEx(
     const int ldc,
     Provider* provider);
 
+// GemmBatch runs a batch of independent gemms sharing the same dimensions,
+// given arrays of A/B/C addresses. The float specialization dispatches the
+// whole batch to the math library in one call so the threading and setup
+// cost is paid once instead of once per gemm.
+template <typename T, class Provider>
+void GemmBatch(
+    const CBLAS_TRANSPOSE TransA,
+    const CBLAS_TRANSPOSE TransB,
+    const int64_t M,
+    const int64_t N,
+    const int64_t K,
+    const float alpha,
+    const T* const* A_array,
+    const T* const* B_array,
+    const float beta,
+    T* const* C_array,
+    const int64_t batch,
+    Provider* provider);
+
 // GemmBatched provides a simple abstraction into library routines
 template <typename T, class Provider>
 void GemmBatched(
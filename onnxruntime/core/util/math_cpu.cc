@@ -470,6 +470,46 @@ void GemmBatched<float, CPUMathUtil>(
   }
 }
 
+template <>
+void GemmBatch<float, CPUMathUtil>(
+    const CBLAS_TRANSPOSE TransA,
+    const CBLAS_TRANSPOSE TransB,
+    const int64_t M,
+    const int64_t N,
+    const int64_t K,
+    const float alpha,
+    const float* const* A_array,
+    const float* const* B_array,
+    const float beta,
+    float* const* C_array,
+    const int64_t batch,
+    CPUMathUtil* provider) {
+#if defined(USE_MLAS) && !defined(USE_MKLDNN)
+  ONNXRUNTIME_UNUSED_PARAMETER(provider);
+  size_t lda = static_cast<size_t>((TransA == CblasNoTrans) ? K : M);
+  size_t ldb = static_cast<size_t>((TransB == CblasNoTrans) ? N : K);
+  MlasSgemmBatch(TransA, TransB, static_cast<size_t>(M), static_cast<size_t>(N), static_cast<size_t>(K),
+                 alpha, A_array, lda, B_array, ldb, beta, C_array, static_cast<size_t>(N),
+                 static_cast<size_t>(batch));
+#else
+  // loop over matrices in the batch
+  for (int64_t i = 0; i < batch; ++i) {
+    math::Gemm<float, CPUMathUtil>(
+        TransA,
+        TransB,
+        M,
+        N,
+        K,
+        alpha,
+        A_array[i],
+        B_array[i],
+        beta,
+        C_array[i],
+        provider);
+  }
+#endif
+}
+
 // MKL will be implmenet as an execution provider
 ////////////////////////////////////////////////////////////////////////////////
 // MKL VML alternatives.
@@ -75,6 +75,44 @@ bool PyObjectCheck_Array(PyObject* o) {
   return PyObject_HasAttrString(o, "__array_finalize__");
 }
 
+namespace {
+// Pins the numpy array whose buffer an input Tensor aliases. Alloc is never
+// called; Free runs when the Tensor is destroyed and drops the array
+// reference so numpy can release the memory.
+class NumpyArrayAllocator : public IAllocator {
+ public:
+  // Takes ownership of a reference to <array>.
+  explicit NumpyArrayAllocator(PyObject* array) : array_(array) {}
+
+  ~NumpyArrayAllocator() override {
+    // Free is skipped when the Tensor was never constructed, e.g. when its
+    // allocation threw. Drop the reference here in that case.
+    if (array_ != nullptr) {
+      Free(nullptr);
+    }
+  }
+
+  void* Alloc(size_t) override { return nullptr; }
+
+  void Free(void*) override {
+    // the tensor can be released from a worker thread once the session is
+    // done with it, so take the GIL for the reference drop.
+    PyGILState_STATE state = PyGILState_Ensure();
+    Py_XDECREF(array_);
+    array_ = nullptr;
+    PyGILState_Release(state);
+  }
+
+  const ONNXRuntimeAllocatorInfo& Info() const override {
+    static ONNXRuntimeAllocatorInfo info(CPU, ONNXRuntimeDeviceAllocator);
+    return info;
+  }
+
+ private:
+  PyObject* array_;
+};
+}  // namespace
+
 void CreateTensorMLValue(AllocatorPtr alloc, const std::string& name_input, PyArrayObject* pyObject, MLValue* p_mlvalue) {
   PyArrayObject* darray = PyArray_GETCONTIGUOUS(pyObject);
   if (darray == NULL) {
@@ -94,6 +132,28 @@ void CreateTensorMLValue(AllocatorPtr alloc, const std::string& name_input, PyAr
 
     TensorShape shape(dims);
     auto element_type = NumpyToOnnxRuntimeTensorType(npy_type);
+
+    // The common numeric case aliases the array memory instead of copying
+    // it: darray is contiguous (either the caller's own array or the fresh
+    // copy made above) and the tensor pins it through the deleter, so the
+    // buffer outlives the MLValue. String-like types still need the
+    // per-element conversions below.
+    if (npy_type != NPY_UNICODE && npy_type != NPY_STRING &&
+        npy_type != NPY_OBJECT && npy_type != NPY_VOID) {
+      auto array_pin = std::make_shared<NumpyArrayAllocator>(reinterpret_cast<PyObject*>(darray));
+      dref = true;  // the reference taken above is now owned by the pin
+
+      std::unique_ptr<Tensor> p_tensor = std::make_unique<Tensor>(element_type,
+                                                                  shape,
+                                                                  static_cast<void*>(PyArray_DATA(darray)),
+                                                                  alloc->Info(), array_pin);
+
+      p_mlvalue->Init(p_tensor.release(),
+                      DataTypeImpl::GetType<Tensor>(),
+                      DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+      return;
+    }
+
     void* buffer = alloc->Alloc(element_type->Size() * shape.Size());
 
     if (npy_type != NPY_UNICODE && npy_type != NPY_OBJECT) {
@@ -51,6 +51,9 @@
 #ifdef USE_MKLDNN
 #include "core/providers/mkldnn/mkldnn_provider_factory.h"
 #endif
+#ifdef USE_OPENCL
+#include "core/providers/opencl/opencl_provider_factory.h"
+#endif
 #ifdef USE_NUPHAR
 #include "core/providers/nuphar/nuphar_provider_factory.h"
 #endif
@@ -121,6 +124,10 @@ void AddNonTensorAsPyObj(onnxruntime::MLValue& val, vector<py::object>& pyobjs)
   }
 }
 
+static void DeleteMLValueCapsule(PyObject* capsule) {
+  delete static_cast<MLValue*>(PyCapsule_GetPointer(capsule, nullptr));
+}
+
 void AddTensorAsPyObj(onnxruntime::MLValue& val, vector<py::object>& pyobjs) {
   const Tensor& rtensor = val.Get<Tensor>();
   std::vector<npy_intp> npy_dims;
@@ -132,6 +139,30 @@ void AddTensorAsPyObj(onnxruntime::MLValue& val, vector<py::object>& pyobjs) {
 
   MLDataType dtype = rtensor.DataType();
   const int numpy_type = OnnxRuntimeTensorToNumpyType(dtype);
+
+  // CPU outputs are returned as arrays aliasing the tensor buffer: a capsule
+  // holding a copy of the MLValue becomes the array's base object and keeps
+  // the buffer alive for as long as the array, so no bytes are copied.
+  // String tensors and non-CPU buffers fall through to the copying path.
+  if (numpy_type != NPY_OBJECT && strcmp(rtensor.Location().name, CPU) == 0) {
+    py::object aliased = py::reinterpret_steal<py::object>(PyArray_SimpleNewFromData(
+        shape.NumDimensions(), npy_dims.data(), numpy_type,
+        const_cast<void*>(rtensor.DataRaw(dtype))));
+
+    if (aliased.ptr() != nullptr) {
+      MLValue* buffer_owner = new MLValue(val);
+      PyObject* capsule = PyCapsule_New(buffer_owner, nullptr, DeleteMLValueCapsule);
+      if (capsule == nullptr) {
+        delete buffer_owner;
+      } else if (PyArray_SetBaseObject(reinterpret_cast<PyArrayObject*>(aliased.ptr()), capsule) == 0) {
+        // the capsule reference was stolen by the array; on failure it was
+        // stolen too and its destructor released the MLValue copy.
+        pyobjs.push_back(aliased);
+        return;
+      }
+    }
+  }
+
   py::object obj = py::reinterpret_steal<py::object>(PyArray_SimpleNew(
       shape.NumDimensions(), npy_dims.data(), numpy_type));
 
@@ -205,6 +236,15 @@ void InitializeSession(InferenceSession* sess) {
     FACTORY_PTR_HOLDER;
   }
 #endif
+#ifdef USE_OPENCL
+  {
+    const bool enable_cpu_mem_arena = true;
+    ONNXRuntimeProviderFactoryInterface** f;
+    ONNXRUNTIME_THROW_ON_ERROR(ONNXRuntimeCreateOpenCLExecutionProviderFactory(enable_cpu_mem_arena ? 1 : 0, &f));
+    RegisterExecutionProvider(sess, f);
+    FACTORY_PTR_HOLDER;
+  }
+#endif
 #if 0  //USE_NUPHAR
   {
     ONNXRuntimeProviderFactoryInterface** f;
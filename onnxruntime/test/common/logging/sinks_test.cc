@@ -3,6 +3,7 @@
 
 #include "core/common/logging/capture.h"
 #include "core/common/logging/logging.h"
+#include "core/common/logging/sinks/async_sink.h"
 #include "core/common/logging/sinks/cerr_sink.h"
 #include "core/common/logging/sinks/clog_sink.h"
 #include "core/common/logging/sinks/composite_sink.h"
@@ -125,6 +126,35 @@ TEST(LoggingTests, TestFileSink) {
 /// <summary>
 /// Tests that a composite_sink works correctly.
 /// </summary>
+/// <summary>
+/// Tests that the async sink writes queued messages to the stream, draining
+/// anything still queued when it is destroyed.
+/// </summary>
+TEST(LoggingTests, TestAsyncSink) {
+  const std::string logid{"AsyncSink"};
+  const std::string message{"Test async message"};
+  const Severity min_log_level = Severity::kWARNING;
+
+  std::ostringstream out;
+
+  // create scoped manager so the sink gets destroyed (and drained) once done
+  {
+    LoggingManager manager{std::unique_ptr<ISink>{new AsyncSink{&out}}, min_log_level, false,
+                           InstanceType::Temporal};
+
+    auto logger = manager.CreateLogger(logid);
+
+    for (int i = 0; i < 100; ++i) {
+      LOGS(*logger, WARNING) << message << " " << i;
+    }
+  }
+
+  const std::string content = out.str();
+  EXPECT_NE(content.find(message + " 0"), std::string::npos);
+  EXPECT_NE(content.find(message + " 99"), std::string::npos);
+  EXPECT_NE(content.find(logid), std::string::npos);
+}
+
 TEST(LoggingTests, TestCompositeSink) {
   const std::string logid{"TestCompositeSink"};
   const Severity min_log_level = Severity::kWARNING;
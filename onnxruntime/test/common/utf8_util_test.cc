@@ -2,6 +2,9 @@
 // Licensed under the MIT License.
 
 #include "core/common/utf8_util.h"
+
+#include <cctype>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -42,5 +45,63 @@ TEST(Utf8UtilTest, Validate) {
   }
 }
 
+TEST(Utf8UtilTest, ValidateBlockFastPath) {
+  using namespace utf8_util;
+  // long ASCII runs exercise the block-at-a-time path, including lengths
+  // around the 16 and 8 byte block boundaries
+  for (size_t ascii_len : {7u, 8u, 15u, 16u, 17u, 31u, 32u, 100u}) {
+    std::string s(ascii_len, 'x');
+    size_t utf8_len = 0;
+    ASSERT_TRUE(utf8_validate(reinterpret_cast<const unsigned char*>(s.data()), s.size(), utf8_len));
+    ASSERT_EQ(ascii_len, utf8_len);
+
+    // a multi-byte character after the ASCII run still counts as one
+    std::string mixed = s + "\xc3\xb1" + s;
+    ASSERT_TRUE(utf8_validate(reinterpret_cast<const unsigned char*>(mixed.data()), mixed.size(), utf8_len));
+    ASSERT_EQ(2 * ascii_len + 1, utf8_len);
+
+    // an invalid byte after the ASCII run is still caught
+    std::string invalid = s + "\xc3\x28";
+    ASSERT_FALSE(utf8_validate(reinterpret_cast<const unsigned char*>(invalid.data()), invalid.size(), utf8_len));
+  }
+}
+
+TEST(Utf8UtilTest, AllAscii) {
+  using namespace utf8_util;
+  std::string ascii(50, 'a');
+  ASSERT_TRUE(utf8_all_ascii(reinterpret_cast<const unsigned char*>(ascii.data()), ascii.size()));
+  ASSERT_TRUE(utf8_all_ascii(reinterpret_cast<const unsigned char*>(ascii.data()), 0));
+
+  // a high byte anywhere flips the answer, wherever it falls in a block
+  for (size_t pos : {0u, 7u, 15u, 16u, 49u}) {
+    std::string s = ascii;
+    s[pos] = '\xc3';
+    ASSERT_FALSE(utf8_all_ascii(reinterpret_cast<const unsigned char*>(s.data()), s.size())) << "pos " << pos;
+  }
+}
+
+TEST(Utf8UtilTest, AsciiCaseConversion) {
+  using namespace utf8_util;
+  // cover every ASCII byte and enough length for the block path plus a tail
+  std::string input;
+  for (int round = 0; round < 2; ++round) {
+    for (int ch = 0; ch < 0x80; ++ch) {
+      input.push_back(static_cast<char>(ch));
+    }
+  }
+  input += "MiXeD case TAIL";
+
+  std::string lower = input;
+  utf8_ascii_to_lower(&lower[0], lower.size());
+  std::string upper = input;
+  utf8_ascii_to_upper(&upper[0], upper.size());
+
+  for (size_t i = 0; i < input.size(); ++i) {
+    const auto ch = static_cast<unsigned char>(input[i]);
+    ASSERT_EQ(static_cast<char>(::tolower(ch)), lower[i]) << "byte " << i;
+    ASSERT_EQ(static_cast<char>(::toupper(ch)), upper[i]) << "byte " << i;
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -0,0 +1,172 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/work_stealing_thread_pool.h"
+
+#include <atomic>
+#include <stdexcept>
+
+#include "core/platform/denormal.h"
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(WorkStealingThreadPoolTest, WorkersFlushDenormalsWhenOptedIn) {
+  // probe for FTZ/DAZ support; architectures without the control can't flush
+  if (!SetDenormalAsZero(false)) {
+    return;
+  }
+
+  DenormalFlushForPoolThreads().store(true);
+  float result = 1.0f;
+  {
+    WorkStealingThreadPool pool{1};
+    std::packaged_task<void()> task{[&result]() {
+      // with denormals-are-zero set, the denormal operand reads as zero
+      volatile float denormal = 1e-39f;
+      volatile float one = 1.0f;
+      result = denormal * one;
+    }};
+    auto task_result = task.get_future();
+    pool.RunTask(std::move(task));
+    task_result.get();
+  }
+  DenormalFlushForPoolThreads().store(false);
+
+  ASSERT_EQ(0.0f, result);
+}
+
+TEST(WorkStealingThreadPoolTest, RunTasksAndWait) {
+  WorkStealingThreadPool pool{4};
+
+  constexpr int num_tasks = 1000;
+  std::atomic<int> counter{0};
+
+  for (int i = 0; i < num_tasks; ++i) {
+    std::packaged_task<void()> task{[&counter]() { ++counter; }};
+    pool.RunTask(std::move(task));
+  }
+
+  pool.WaitWorkComplete();
+  ASSERT_EQ(num_tasks, counter.load());
+}
+
+TEST(WorkStealingThreadPoolTest, TaskExceptionPropagatesThroughFuture) {
+  WorkStealingThreadPool pool{2};
+
+  std::packaged_task<void()> task{[]() { throw std::runtime_error("failure in task"); }};
+  auto result = task.get_future();
+  pool.RunTask(std::move(task));
+
+  ASSERT_THROW(result.get(), std::runtime_error);
+  pool.WaitWorkComplete();
+}
+
+TEST(WorkStealingThreadPoolTest, RunTaskWithIDProvidesValidWorkerIndex) {
+  constexpr std::size_t num_threads = 4;
+  WorkStealingThreadPool pool{num_threads};
+
+  constexpr int num_tasks = 100;
+  std::atomic<int> bad_indices{0};
+
+  for (int i = 0; i < num_tasks; ++i) {
+    std::packaged_task<void(std::size_t)> task{[&bad_indices](std::size_t index) {
+      if (index >= num_threads) ++bad_indices;
+    }};
+    pool.RunTaskWithID(std::move(task));
+  }
+
+  pool.WaitWorkComplete();
+  ASSERT_EQ(0, bad_indices.load());
+}
+
+TEST(WorkStealingThreadPoolTest, ExecuteInParallelCoversAllIterations) {
+  WorkStealingThreadPool pool{4};
+
+  constexpr std::size_t iterations = 64;
+  std::vector<std::atomic<int>> hits(iterations);
+  for (auto& hit : hits) hit = 0;
+
+  pool.ExecuteInParallel([&hits](std::size_t i) { ++hits[i]; }, iterations);
+
+  for (std::size_t i = 0; i < iterations; ++i) {
+    ASSERT_EQ(1, hits[i].load()) << "iteration " << i;
+  }
+}
+
+TEST(WorkStealingThreadPoolTest, ParallelismCapLimitsConcurrency) {
+  WorkStealingThreadPool pool{4};
+
+  constexpr std::size_t cap = 2;
+  constexpr std::size_t iterations = 64;
+  std::vector<std::atomic<int>> hits(iterations);
+  for (auto& hit : hits) hit = 0;
+  std::atomic<int> active{0};
+  std::atomic<int> max_active{0};
+
+  {
+    ParallelismCapScope scope{cap};
+    pool.ExecuteInParallel(
+        [&](std::size_t i) {
+          const int now = ++active;
+          int seen = max_active.load();
+          while (now > seen && !max_active.compare_exchange_weak(seen, now)) {
+          }
+          ++hits[i];
+          --active;
+        },
+        iterations);
+  }
+
+  for (std::size_t i = 0; i < iterations; ++i) {
+    ASSERT_EQ(1, hits[i].load()) << "iteration " << i;
+  }
+  ASSERT_LE(max_active.load(), static_cast<int>(cap));
+}
+
+TEST(WorkStealingThreadPoolTest, ParallelismCapInheritedBySubmittedTasks) {
+  WorkStealingThreadPool pool{4};
+
+  // a task submitted under a cap carries it, so parallel work it starts on a
+  // worker thread is capped the same way
+  std::size_t cap_seen_in_task = 0;
+  {
+    ParallelismCapScope scope{3};
+    std::packaged_task<void()> task{[&cap_seen_in_task]() {
+      cap_seen_in_task = CurrentThreadMaxParallelism();
+    }};
+    auto task_result = task.get_future();
+    pool.RunTask(std::move(task));
+    task_result.get();
+  }
+
+  ASSERT_EQ(static_cast<std::size_t>(3), cap_seen_in_task);
+  ASSERT_EQ(static_cast<std::size_t>(0), CurrentThreadMaxParallelism());
+}
+
+TEST(WorkStealingThreadPoolTest, ConcurrentSubmitters) {
+  WorkStealingThreadPool pool{4};
+
+  constexpr int num_submitters = 8;
+  constexpr int tasks_per_submitter = 500;
+  std::atomic<int> counter{0};
+
+  std::vector<std::thread> submitters;
+  for (int i = 0; i < num_submitters; ++i) {
+    submitters.emplace_back([&pool, &counter]() {
+      for (int j = 0; j < tasks_per_submitter; ++j) {
+        std::packaged_task<void()> task{[&counter]() { ++counter; }};
+        pool.RunTask(std::move(task));
+      }
+    });
+  }
+
+  for (auto& t : submitters) t.join();
+  pool.WaitWorkComplete();
+
+  ASSERT_EQ(num_submitters * tasks_per_submitter, counter.load());
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,69 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+// single timestep so the recurrent contribution is exactly zero, and the
+// input values are multiples of the dynamic scale (amax 1.27 -> scale 0.01)
+// so the per-timestep quantization of X is lossless
+TEST(DynamicQuantizeLSTMTest, ForwardSingleStep) {
+  OpTester test("DynamicQuantizeLSTM", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("hidden_size", 2);
+
+  test.AddInput<float>("X", {1, 1, 2}, {0.5f, 1.27f});
+
+  // iofc gate order, two rows per gate
+  test.AddInput<int8_t>("W", {8, 2},
+                        {10, -10,
+                         20, 5,
+                         5, 5,
+                         -5, 10,
+                         15, 0,
+                         0, 15,
+                         10, 10,
+                         -20, 20});
+  test.AddInput<int8_t>("R", {8, 2},
+                        {0, 0, 0, 0, 0, 0, 0, 0,
+                         0, 0, 0, 0, 0, 0, 0, 0});
+  test.AddInput<float>("W_scale", {4}, {0.01f, 0.01f, 0.01f, 0.01f});
+  test.AddInput<float>("R_scale", {4}, {0.02f, 0.02f, 0.02f, 0.02f});
+  test.AddInput<float>("B", {16},
+                       {0.1f, -0.1f, 0.2f, -0.2f, 0.3f, -0.3f, 0.0f, 0.1f,
+                        0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f});
+
+  test.AddOutput<float>("Y", {1, 1, 1, 2}, {0.050511f, 0.060669f});
+  test.AddOutput<float>("Y_h", {1, 1, 2}, {0.050511f, 0.060669f});
+  test.AddOutput<float>("Y_c", {1, 1, 2}, {0.088594f, 0.128284f});
+
+  test.Run();
+}
+
+TEST(DynamicQuantizeLSTMTest, StateCarriesAcrossSteps) {
+  OpTester test("DynamicQuantizeLSTM", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("hidden_size", 1);
+
+  // W and R scaled to zero so every gate pre-activation is 0: the gates are
+  // sigmoid(0) = 0.5 and the cell candidate tanh(0) = 0, which gives the
+  // closed forms c_t = 0.5 * c_{t-1} and h_t = 0.5 * tanh(c_t)
+  test.AddInput<float>("X", {3, 1, 1}, {1.0f, -1.0f, 0.5f});
+  test.AddInput<int8_t>("W", {4, 1}, {0, 0, 0, 0});
+  test.AddInput<int8_t>("R", {4, 1}, {0, 0, 0, 0});
+  test.AddInput<float>("W_scale", {4}, {0.1f, 0.1f, 0.1f, 0.1f});
+  test.AddInput<float>("R_scale", {4}, {0.1f, 0.1f, 0.1f, 0.1f});
+  test.AddMissingOptionalInput<float>();  // no bias
+  test.AddMissingOptionalInput<float>();  // no initial_h
+  test.AddInput<float>("initial_c", {1, 1}, {1.0f});
+
+  test.AddOutput<float>("Y", {3, 1, 1, 1}, {0.231059f, 0.122459f, 0.062350f});
+  test.AddOutput<float>("Y_h", {1, 1, 1}, {0.062350f});
+  test.AddOutput<float>("Y_c", {1, 1, 1}, {0.125f});
+
+  test.Run();
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,51 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+// table rows are {row, row/2} so the reductions are easy to read off
+static std::vector<float> MakeTable(int64_t rows) {
+  std::vector<float> table;
+  for (int64_t r = 0; r < rows; ++r) {
+    table.push_back(static_cast<float>(r));
+    table.push_back(static_cast<float>(r) * 0.5f);
+  }
+  return table;
+}
+
+TEST(EmbedBagTest, SumKeepDims) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::string>("mode", "sum");
+  test.AddAttribute<int64_t>("keepdims", 1);
+  test.AddInput<float>("data", {6, 2}, MakeTable(6));
+  test.AddInput<int64_t>("indices", {2, 3}, {0, 2, 5, 1, 1, 4});
+  test.AddOutput<float>("output", {2, 1, 2}, {7.0f, 3.5f, 6.0f, 3.0f});
+  test.Run();
+}
+
+TEST(EmbedBagTest, MeanInt32Indices) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::string>("mode", "mean");
+  test.AddAttribute<int64_t>("keepdims", 0);
+  test.AddInput<float>("data", {4, 2}, MakeTable(4));
+  test.AddInput<int32_t>("indices", {2, 2}, {0, 2, 3, 3});
+  test.AddOutput<float>("output", {2, 2}, {1.0f, 0.5f, 3.0f, 1.5f});
+  test.Run();
+}
+
+TEST(EmbedBagTest, IndexOutOfBounds) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("data", {3, 2}, MakeTable(3));
+  test.AddInput<int64_t>("indices", {1, 2}, {0, 3});
+  test.AddOutput<float>("output", {1, 1, 2}, {0.0f, 0.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "indices element out of data bounds");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
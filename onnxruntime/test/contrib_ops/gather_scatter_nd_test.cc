@@ -0,0 +1,56 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(GatherNDTest, FloatSliceGather) {
+  // index tuples of length 1 address whole rows of a 2D tensor
+  OpTester test("GatherND", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("data", {3, 2}, {0.0f, 0.1f, 1.0f, 1.1f, 2.0f, 2.1f});
+  test.AddInput<int64_t>("indices", {2, 1}, {2, 0});
+  test.AddOutput<float>("output", {2, 2}, {2.0f, 2.1f, 0.0f, 0.1f});
+  test.Run();
+}
+
+TEST(GatherNDTest, ElementGatherWithNegativeIndices) {
+  // index tuples of length 2 address single elements of a 2D tensor
+  OpTester test("GatherND", 1, onnxruntime::kMSDomain);
+  test.AddInput<int32_t>("data", {2, 3}, {0, 1, 2, 3, 4, 5});
+  test.AddInput<int64_t>("indices", {3, 2}, {0, 0, 1, 2, -1, -3});
+  test.AddOutput<int32_t>("output", {3}, {0, 5, 3});
+  test.Run();
+}
+
+TEST(GatherNDTest, BatchedIndices3D) {
+  OpTester test("GatherND", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("data", {2, 2}, {0.0f, 1.0f, 2.0f, 3.0f});
+  test.AddInput<int64_t>("indices", {2, 1, 2}, {0, 1, 1, 0});
+  test.AddOutput<float>("output", {2, 1}, {1.0f, 2.0f});
+  test.Run();
+}
+
+TEST(ScatterNDTest, FloatSliceScatter) {
+  // overwrite two rows of a 3x2 tensor
+  OpTester test("ScatterND", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("data", {3, 2}, {0.0f, 0.1f, 1.0f, 1.1f, 2.0f, 2.1f});
+  test.AddInput<int64_t>("indices", {2, 1}, {2, 0});
+  test.AddInput<float>("updates", {2, 2}, {8.0f, 8.1f, 9.0f, 9.1f});
+  test.AddOutput<float>("output", {3, 2}, {9.0f, 9.1f, 1.0f, 1.1f, 8.0f, 8.1f});
+  test.Run();
+}
+
+TEST(ScatterNDTest, ElementScatter) {
+  OpTester test("ScatterND", 1, onnxruntime::kMSDomain);
+  test.AddInput<int32_t>("data", {2, 3}, {0, 1, 2, 3, 4, 5});
+  test.AddInput<int64_t>("indices", {2, 2}, {0, 1, 1, 2});
+  test.AddInput<int32_t>("updates", {2}, {10, 20});
+  test.AddOutput<int32_t>("output", {2, 3}, {0, 10, 2, 3, 4, 20});
+  test.Run();
+}
+
+}  // namespace test
+}  // namespace onnxruntime
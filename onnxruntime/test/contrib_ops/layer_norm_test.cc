@@ -0,0 +1,85 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+// straightforward per-row reference for the fused kernel
+std::vector<float> LayerNormReference(const std::vector<float>& x,
+                                      const std::vector<float>& scale,
+                                      const std::vector<float>* bias,
+                                      int64_t rows, int64_t row_size,
+                                      float epsilon) {
+  std::vector<float> y(x.size());
+  for (int64_t row = 0; row < rows; ++row) {
+    const float* in = x.data() + row * row_size;
+    double mean = 0.0;
+    for (int64_t i = 0; i < row_size; ++i) mean += in[i];
+    mean /= row_size;
+    double variance = 0.0;
+    for (int64_t i = 0; i < row_size; ++i) variance += (in[i] - mean) * (in[i] - mean);
+    variance /= row_size;
+    const double inv_std = 1.0 / std::sqrt(variance + epsilon);
+    for (int64_t i = 0; i < row_size; ++i) {
+      double value = (in[i] - mean) * inv_std * scale[i];
+      if (bias != nullptr) value += (*bias)[i];
+      y[row * row_size + i] = static_cast<float>(value);
+    }
+  }
+  return y;
+}
+}  // namespace
+
+TEST(LayerNormTest, ScaleAndBias) {
+  std::vector<float> x{0.0f, 1.0f, 2.0f, 3.0f,
+                       -1.0f, 0.5f, 4.0f, -2.5f};
+  std::vector<float> scale{0.5f, 1.0f, 2.0f, -1.0f};
+  std::vector<float> bias{0.1f, -0.2f, 0.0f, 0.3f};
+
+  OpTester test("LayerNormalization", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<float>("epsilon", 1e-5f);
+  test.AddInput<float>("X", {2, 4}, x);
+  test.AddInput<float>("scale", {4}, scale);
+  test.AddInput<float>("B", {4}, bias);
+  test.AddOutput<float>("Y", {2, 4}, LayerNormReference(x, scale, &bias, 2, 4, 1e-5f));
+  test.Run();
+}
+
+TEST(LayerNormTest, NoBiasExplicitAxis) {
+  // axis 2 of a rank 3 input normalizes the same trailing span as axis -1
+  std::vector<float> x{1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f,
+                       -3.0f, 0.0f, 3.0f, 2.0f, 2.0f, 2.0f};
+  std::vector<float> scale{1.0f, 2.0f, 3.0f};
+
+  OpTester test("LayerNormalization", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("axis", 2);
+  test.AddInput<float>("X", {2, 2, 3}, x);
+  test.AddInput<float>("scale", {3}, scale);
+  test.AddOutput<float>("Y", {2, 2, 3}, LayerNormReference(x, scale, nullptr, 4, 3, 1e-5f));
+  test.Run();
+}
+
+TEST(LayerNormTest, ConstantRowIsFiniteThroughEpsilon)  {
+  // zero variance must not divide by zero; epsilon keeps the output finite
+  std::vector<float> x{5.0f, 5.0f, 5.0f, 5.0f};
+  std::vector<float> scale{1.0f, 1.0f, 1.0f, 1.0f};
+  std::vector<float> bias{2.0f, 2.0f, 2.0f, 2.0f};
+
+  OpTester test("LayerNormalization", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<float>("epsilon", 1e-5f);
+  test.AddInput<float>("X", {1, 4}, x);
+  test.AddInput<float>("scale", {4}, scale);
+  test.AddInput<float>("B", {4}, bias);
+  test.AddOutput<float>("Y", {1, 4}, {2.0f, 2.0f, 2.0f, 2.0f});
+  test.Run();
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,41 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(MatMulIntegerOpTest, MatMulInteger_Uint8Uint8) {
+  OpTester test("MatMulInteger", 1, onnxruntime::kMSDomain);
+  test.AddInput<uint8_t>("A", {2, 3},
+                         {1, 2, 3,
+                          4, 5, 6});
+  test.AddInput<uint8_t>("B", {3, 2},
+                         {1, 2,
+                          3, 4,
+                          5, 6});
+  test.AddOutput<uint32_t>("Y", {2, 2},
+                           {22, 28,
+                            49, 64});
+  test.Run();
+}
+
+TEST(MatMulIntegerOpTest, MatMulInteger_Uint8Int8) {
+  OpTester test("MatMulInteger", 1, onnxruntime::kMSDomain);
+  test.AddInput<uint8_t>("A", {2, 3},
+                         {1, 2, 3,
+                          4, 5, 6});
+  test.AddInput<int8_t>("B", {3, 2},
+                        {-1, 2,
+                         3, -4,
+                         5, -6});
+  test.AddOutput<int32_t>("Y", {2, 2},
+                          {20, -24,
+                           41, -48});
+  test.Run();
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -62,6 +62,17 @@ TEST(MurmurHash3OpTest, NonZeroSeedUIntResult) {
   test.Run();
 }
 
+// two full interleaved lane groups plus a scalar remainder
+TEST(MurmurHash3OpTest, IntKeyBatch) {
+  OpTester test("MurmurHash3", 1, onnxruntime::kMSDomain);
+  test.AddInput<int32_t>("X", {9}, {1L, 2L, 3L, 4L, 5L, 6L, 7L, 8L, 9L});
+  test.AddAttribute<int64_t>("seed", 0LL);
+  test.AddOutput<int32_t>("Y", {9},
+                          {-68075478L, 1085422463L, 847579505L, 1889779975L, 236698494L,
+                           -975490194L, 1343918321L, -1822472975L, 101886131L});
+  test.Run();
+}
+
 TEST(MurmurHash3OpTest, StringKeyIntResult) {
   OpTester test("MurmurHash3", 1, onnxruntime::kMSDomain);
   test.AddInput<std::string>("X", {1}, {"foo"});
@@ -94,5 +105,19 @@ TEST(MurmurHash3OpTest, StringKeyUIntWithSeed42) {
   test.Run();
 }
 
+// mixed lengths: one length bucket fills an interleaved lane group, the
+// others fall through to the scalar path, and each hash must land back at its
+// key's original position despite the length ordering
+TEST(MurmurHash3OpTest, StringKeyMixedLengthBatch) {
+  OpTester test("MurmurHash3", 1, onnxruntime::kMSDomain);
+  test.AddInput<std::string>("X", {10},
+                             {"a", "bb", "ccc", "dd", "e", "ffff", "gg", "hhh", "i", "jj"});
+  test.AddAttribute<int64_t>("seed", 0LL);
+  test.AddOutput<int32_t>("Y", {10},
+                          {1009084850L, 855411159L, 735026264L, -435791956L, 1701593959L,
+                           -1665165387L, 1895304471L, 977784817L, -2128973781L, 1463225595L});
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
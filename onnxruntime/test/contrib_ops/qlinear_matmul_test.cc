@@ -0,0 +1,53 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+// per-tensor scales and zero points
+TEST(QLinearMatMulOpTest, QLinearMatMul_Uint8Uint8) {
+  OpTester test("QLinearMatMul", 1, onnxruntime::kMSDomain);
+  test.AddInput<uint8_t>("a", {2, 2},
+                         {2, 4,
+                          6, 8});
+  test.AddInput<float>("a_scale", {}, {1.0f});
+  test.AddInput<uint8_t>("a_zero_point", {}, {1});
+  test.AddInput<uint8_t>("b", {2, 2},
+                         {1, 2,
+                          3, 4});
+  test.AddInput<float>("b_scale", {}, {1.0f});
+  test.AddInput<uint8_t>("b_zero_point", {}, {2});
+  test.AddInput<float>("y_scale", {}, {2.0f});
+  test.AddInput<uint8_t>("y_zero_point", {}, {3});
+  test.AddOutput<uint8_t>("y", {2, 2},
+                          {4, 6,
+                           4, 10});
+  test.Run();
+}
+
+// signed weights with a per-column scale
+TEST(QLinearMatMulOpTest, QLinearMatMul_PerColumnScale) {
+  OpTester test("QLinearMatMul", 1, onnxruntime::kMSDomain);
+  test.AddInput<uint8_t>("a", {2, 2},
+                         {2, 4,
+                          6, 8});
+  test.AddInput<float>("a_scale", {}, {1.0f});
+  test.AddInput<uint8_t>("a_zero_point", {}, {0});
+  test.AddInput<int8_t>("b", {2, 2},
+                        {1, 2,
+                         3, 4});
+  test.AddInput<float>("b_scale", {2}, {1.0f, 0.5f});
+  test.AddInput<int8_t>("b_zero_point", {}, {0});
+  test.AddInput<float>("y_scale", {}, {1.0f});
+  test.AddInput<uint8_t>("y_zero_point", {}, {0});
+  test.AddOutput<uint8_t>("y", {2, 2},
+                          {14, 10,
+                           30, 22});
+  test.Run();
+}
+
+}  // namespace test
+}  // namespace onnxruntime
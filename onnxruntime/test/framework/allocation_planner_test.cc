@@ -124,15 +124,19 @@ typedef std::unordered_map<const onnxruntime::NodeArg*, TensorShapeProto*> Shape
 
 class SequentialPlannerTestContext : public ISequentialPlannerContext {
  public:
-  SequentialPlannerTestContext(ShapeMap* shape_map) : shape_map_(shape_map) {}
+  SequentialPlannerTestContext(ShapeMap* shape_map, bool reorder_execution_for_memory = false)
+      : shape_map_(shape_map), reorder_execution_for_memory_(reorder_execution_for_memory) {}
 
   virtual TensorShapeProto* GetShape(const onnxruntime::NodeArg& arg) const override {
     auto iter = shape_map_->find(&arg);
     return (shape_map_->end() != iter) ? iter->second : nullptr;
   }
 
+  bool ReorderExecutionForMemory() const override { return reorder_execution_for_memory_; }
+
  private:
   ShapeMap* shape_map_;
+  bool reorder_execution_for_memory_{false};
 };
 
 class PlannerTest : public ::testing::Test {
@@ -149,6 +153,7 @@ class PlannerTest : public ::testing::Test {
 
   std::unique_ptr<::onnxruntime::KernelDef> std_kernel_;       // a unary kernel with no-aliasing and no-in-place
   std::unique_ptr<::onnxruntime::KernelDef> in_place_kernel_;  // a unary kernel with in-place
+  std::unique_ptr<::onnxruntime::KernelDef> slice_kernel_;     // Slice; aliasing is decided by the planner per-node
 
   std::unordered_map<std::string, onnxruntime::NodeArg*> name_to_arg_;
   std::vector<std::unique_ptr<UnaryNode>> nodes_;
@@ -157,12 +162,14 @@ class PlannerTest : public ::testing::Test {
   ExecutionProviders execution_providers_;
   SessionState state_;
   ShapeMap shape_map_;
+  bool reorder_execution_for_memory_ = false;
   std::unique_ptr<SequentialExecutionPlan> plan_;
 
  public:
   PlannerTest() : model_("test"), graph_{model_.MainGraph()}, state_{execution_providers_} {
     std_kernel_ = KernelDefBuilder().SetName("Transpose").Build();
     in_place_kernel_ = KernelDefBuilder().SetName("Clip").MayInplace(0, 0).Build();
+    slice_kernel_ = KernelDefBuilder().SetName("Slice").Build();
     CPUExecutionProviderInfo epi;
     auto execution_provider = std::make_unique<CPUExecutionProvider>(epi);
     execution_providers_.Add("CPUExecutionProvider", std::move(execution_provider));
@@ -193,6 +200,14 @@ class PlannerTest : public ::testing::Test {
     return AddNode(*in_place_kernel_, input, output);
   }
 
+  onnxruntime::Node* AddSliceNode(std::string& input, std::string& output,
+                                  const std::vector<int64_t>& starts, const std::vector<int64_t>& ends) {
+    auto* p_node = AddNode(*slice_kernel_, input, output);
+    p_node->AddAttribute("starts", starts);
+    p_node->AddAttribute("ends", ends);
+    return p_node;
+  }
+
   void BindKernel(onnxruntime::Node* p_node, ::onnxruntime::KernelDef& kernel_def) {
     auto info = std::make_unique<OpKernelInfo>(*p_node, kernel_def, *execution_providers_.Get(*p_node), state_);
     auto dummy = std::make_unique<DummyOpKernel>(*info);
@@ -232,7 +247,7 @@ class PlannerTest : public ::testing::Test {
     ExecutionProviders execution_providers;
     execution_providers.Add(onnxruntime::kCpuExecutionProvider, std::move(cpu_execution_provider));
 
-    SequentialPlannerTestContext test_context(&shape_map_);
+    SequentialPlannerTestContext test_context(&shape_map_, reorder_execution_for_memory_);
     auto status = SequentialPlanner::CreatePlan(
         graph_, outer_scope_node_args, execution_providers, kernel_registry_manager,
         mlvalue_name_idx_map, test_context, plan_);
@@ -247,6 +262,15 @@ class PlannerTest : public ::testing::Test {
     EXPECT_EQ(plan_->allocation_plan[id].alloc_kind, kind) << "Error in allocation kind for " << name;
   }
 
+  void CheckReusedBuffer(const std::string& name, const std::string& underlying) {
+    int id;
+    int underlying_id;
+    index(name, id);
+    index(underlying, underlying_id);
+    EXPECT_EQ(plan_->allocation_plan[id].reused_buffer, underlying_id)
+        << "Error in reused buffer for " << name;
+  }
+
   void CheckFreed(int step_number, std::initializer_list<std::string> freed_items) {
     // create set and check equality
     std::unordered_set<int> expected;
@@ -266,6 +290,7 @@ class PlannerTest : public ::testing::Test {
   Graph& GetGraph() { return graph_; }
   const SequentialExecutionPlan& GetPlan() const { return *plan_; }
   const SessionState& GetState() const { return state_; }
+  void EnableMemoryAwareSchedule() { reorder_execution_for_memory_ = true; }
 };
 
 TEST_F(PlannerTest, ChainTest) {
@@ -374,6 +399,48 @@ TEST_F(PlannerTest, InPlaceTest) {
   CheckFreed(2, {X2});
 }
 
+// InPlaceChainTest: Check that in-place reuse chains across consecutive
+// unary in-place ops: the whole chain collapses onto the first temporary's
+// buffer, which stays alive until the chain's last consumer.
+TEST_F(PlannerTest, InPlaceChainTest) {
+  // tensor variables:
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4"), X5("X5"), X6("X6");
+
+  // graph structure:
+  AddNormalNode(X1, X2);   // no in-place operator; X1: input; X2: temporary
+  AddInplaceNode(X2, X3);  // may-in-place operator; X3: temporary
+  AddInplaceNode(X3, X4);  // may-in-place operator; X4: temporary
+  AddInplaceNode(X4, X5);  // may-in-place operator; X5: temporary
+  AddNormalNode(X5, X6);   // no in-place operator; X6: output
+
+  // simulate shape-inference results:
+  Shape shape1{"M", "N"};
+  auto shape = &shape1.value;
+  SetShape({{X1, shape}, {X2, shape}, {X3, shape}, {X4, shape}, {X5, shape}, {X6, shape}});
+
+  CreatePlan();
+
+  // check allocation kind:
+  CheckAllocKind(X1, AllocKind::kPreExisting);
+  CheckAllocKind(X2, AllocKind::kAllocate);
+  CheckAllocKind(X3, AllocKind::kReuse);
+  CheckAllocKind(X4, AllocKind::kReuse);
+  CheckAllocKind(X5, AllocKind::kReuse);
+  CheckAllocKind(X6, AllocKind::kAllocateOutput);
+
+  // every link of the chain resolves to X2's buffer, not its direct input
+  CheckReusedBuffer(X3, X2);
+  CheckReusedBuffer(X4, X2);
+  CheckReusedBuffer(X5, X2);
+
+  // the shared buffer is freed only after the chain's last consumer
+  CheckFreed(0, {});
+  CheckFreed(1, {});
+  CheckFreed(2, {});
+  CheckFreed(3, {});
+  CheckFreed(4, {X2});
+}
+
 // InPlaceSizeMismatchTest: Check that Inplace reuse is not allowed when sizes don't match.
 // Also tests reuse of disjoint lifetime tensors.
 TEST_F(PlannerTest, InPlaceSizeMismatchTest) {
@@ -409,6 +476,32 @@ TEST_F(PlannerTest, InPlaceSizeMismatchTest) {
   CheckFreed(3, {X2});
 }
 
+// SliceViewTest: Check that a Slice selecting one contiguous run of its input
+// aliases the input buffer, while a strided Slice gets its own allocation.
+TEST_F(PlannerTest, SliceViewTest) {
+  // tensor variables:
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4"), X5("X5");
+
+  // declare the Slice input with a concrete shape so contiguity can be proven:
+  Type shaped_type({4, 3});
+  GetGraph().GetOrCreateNodeArg(X1, &shaped_type.value);
+
+  // graph structure:
+  AddSliceNode(X1, X2, {1, 0}, {3, 3});  // rows [1,3): one contiguous run
+  AddSliceNode(X1, X3, {0, 1}, {4, 3});  // columns [1,3): strided
+  AddNormalNode(X2, X4);                 // keep the slices from being graph outputs
+  AddNormalNode(X3, X5);
+
+  CreatePlan();
+
+  // check allocation kind:
+  CheckAllocKind(X1, AllocKind::kPreExisting);
+  CheckAllocKind(X2, AllocKind::kReuse);
+  CheckAllocKind(X3, AllocKind::kAllocate);
+  CheckAllocKind(X4, AllocKind::kAllocateOutput);
+  CheckAllocKind(X5, AllocKind::kAllocateOutput);
+}
+
 // Test operator<< to output details of an allocation & execution plan.
 TEST_F(PlannerTest, PlanOutputTest) {
   // tensor variables:
@@ -437,5 +530,34 @@ TEST_F(PlannerTest, PlanOutputTest) {
   }
 }
 
+/* MemoryAwareOrderTest: two independent producers each create a large value
+   read once by a small consumer. The default order runs both producers first
+   and keeps both large values live at once; the memory-aware schedule runs
+   each consumer right after its producer, so only one large value is ever
+   live. */
+TEST_F(PlannerTest, MemoryAwareOrderTest) {
+  std::string X("X"), Big1("Big1"), Big2("Big2"), Small1("Small1"), Small2("Small2");
+
+  auto* produce1 = AddNormalNode(X, Big1);
+  auto* produce2 = AddNormalNode(X, Big2);
+  auto* consume1 = AddNormalNode(Big1, Small1);
+  auto* consume2 = AddNormalNode(Big2, Small2);
+
+  Shape big_shape{1000, 1000};
+  Shape small_shape{1};
+  SetShape({{Big1, &big_shape.value}, {Big2, &big_shape.value}});
+  SetShape({{Small1, &small_shape.value}, {Small2, &small_shape.value}});
+
+  EnableMemoryAwareSchedule();
+  CreatePlan();
+
+  const auto& execution_plan = GetPlan().execution_plan;
+  ASSERT_EQ(execution_plan.size(), 4u);
+  EXPECT_EQ(execution_plan[0].node_index, produce1->Index());
+  EXPECT_EQ(execution_plan[1].node_index, consume1->Index());
+  EXPECT_EQ(execution_plan[2].node_index, produce2->Index());
+  EXPECT_EQ(execution_plan[3].node_index, consume2->Index());
+}
+
 }  // namespace test
 }  // namespace onnxruntime
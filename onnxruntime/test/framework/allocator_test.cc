@@ -26,6 +26,42 @@ TEST(AllocatorTest, CPUAllocatorTest) {
   //todo: test the used / max api.
 }
 
+TEST(AllocatorTest, SharedArenaRegistryTest) {
+  DeviceAllocatorRegistrationInfo device_info({ONNXRuntimeMemTypeDefault, [](int) {
+        return std::make_unique<CPUAllocator>(); }, std::numeric_limits<size_t>::max()});
+
+  // the same (name, device) pair must resolve to the same arena across sessions
+  auto arena = SharedArenaRegistry::Instance().GetOrCreateArena("SharedArenaTest", device_info);
+  auto arena2 = SharedArenaRegistry::Instance().GetOrCreateArena("SharedArenaTest", device_info);
+  EXPECT_EQ(arena.get(), arena2.get());
+
+  // a different device gets its own arena
+  auto arena_dev1 = SharedArenaRegistry::Instance().GetOrCreateArena("SharedArenaTest", device_info, 1);
+  EXPECT_NE(arena.get(), arena_dev1.get());
+
+  // per-session accounting: each accountant only sees its own allocations
+  SessionArenaAccountant session_a(arena);
+  SessionArenaAccountant session_b(arena);
+
+  void* p1 = session_a.Alloc(1024);
+  void* p2 = session_a.Alloc(512);
+  void* p3 = session_b.Alloc(256);
+  EXPECT_TRUE(p1 && p2 && p3);
+
+  EXPECT_EQ(session_a.SessionUsed(), 1536u);
+  EXPECT_EQ(session_b.SessionUsed(), 256u);
+
+  session_a.Free(p2);
+  EXPECT_EQ(session_a.SessionUsed(), 1024u);
+  EXPECT_EQ(session_a.SessionPeak(), 1536u);
+
+  session_a.Free(p1);
+  session_b.Free(p3);
+  EXPECT_EQ(session_a.SessionUsed(), 0u);
+  EXPECT_EQ(session_b.SessionUsed(), 0u);
+  EXPECT_EQ(session_b.SessionPeak(), 256u);
+}
+
 // helper class to validate values in Alloc and Free calls made via IAllocator::MakeUniquePtr
 class TestAllocator : public IAllocator {
  public:
@@ -2,8 +2,11 @@
 // Licensed under the MIT License.
 
 #include "core/framework/bfc_arena.h"
+#include "core/framework/environment.h"
 #include "gtest/gtest.h"
 #include <cstdlib>
+#include <cstring>
+#include <thread>
 
 namespace onnxruntime {
 namespace test {
@@ -221,6 +224,32 @@ TEST(BFCArenaTest, AllocationsAndDeallocationsWithGrowth) {
   }
 }
 
+TEST(BFCArenaTest, ThreadCacheReuse) {
+  BFCArena a(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 30);
+
+  void* first = a.Alloc(4096);
+  a.Free(first);
+
+  // Repeated alloc/free pairs of the same size on one thread are served from the
+  // thread cache and hand back the same chunk, but still count as allocations.
+  for (int i = 0; i < 10; ++i) {
+    void* p = a.Alloc(4096);
+    EXPECT_EQ(first, p);
+    a.Free(p);
+  }
+  CheckStats(&a, 11, 0, 4096, 4096);
+
+  // A free from another thread hands the chunk back to the bins, where it
+  // coalesces with the rest of the region.
+  void* p = a.Alloc(4096);
+  std::thread other_thread([&a, p]() { a.Free(p); });
+  other_thread.join();
+
+  void* q = a.Alloc(4096);
+  EXPECT_EQ(first, q);
+  a.Free(q);
+}
+
 TEST(BFCArenaTest, TestReserve) {
   // Configure a 1MiB byte limit
   BFCArena a(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 30);
@@ -234,5 +263,85 @@ TEST(BFCArenaTest, TestReserve) {
   a.GetStats(&stats);
   EXPECT_EQ(stats.total_allocated_bytes, 1048576);
 }
+
+TEST(BFCArenaTest, ShrinkToFitReleasesFreeRegions) {
+  BFCArena a(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 30);
+
+  std::vector<void*> ptrs;
+  for (int i = 0; i < 4; i++) {
+    ptrs.push_back(a.Alloc(1 << 20));
+  }
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  const int64_t reserved = stats.total_allocated_bytes;
+  ASSERT_GE(reserved, 4 << 20);
+
+  for (void* p : ptrs) {
+    a.Free(p);
+  }
+
+  // Every region has coalesced back into one free chunk, so the trim hands
+  // all of them to the device allocator.
+  EXPECT_EQ(static_cast<size_t>(reserved), a.ShrinkToFit());
+  a.GetStats(&stats);
+  EXPECT_EQ(0, stats.total_allocated_bytes);
+  EXPECT_EQ(0, stats.bytes_in_use);
+
+  // The arena just re-extends on the next request.
+  void* p = a.Alloc(1 << 20);
+  EXPECT_NE(nullptr, p);
+  a.Free(p);
+}
+
+TEST(BFCArenaTest, ShrinkToFitKeepsLiveRegions) {
+  BFCArena a(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 30);
+
+  // The first region is sized for exactly this allocation; the second region
+  // goes in fully freed.
+  void* live = a.Alloc(1 << 20);
+  void* dead = a.Alloc(1 << 20);
+  a.Free(dead);
+
+  EXPECT_GT(a.ShrinkToFit(), 0);
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(1 << 20, stats.bytes_in_use);
+  EXPECT_EQ(1 << 20, stats.total_allocated_bytes);
+
+  // The pinned region is still usable memory.
+  memset(live, 0xab, 1 << 20);
+  a.Free(live);
+}
+
+TEST(BFCArenaTest, FreeRegionTrimThreshold) {
+  BFCArena a(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 30);
+  a.SetFreeRegionTrimThreshold(1 << 20);
+
+  void* p = a.Alloc(1 << 20);
+  a.Free(p);
+
+  // The free itself crossed the threshold and released the region; no
+  // explicit ShrinkToFit call.
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(0, stats.total_allocated_bytes);
+}
+
+TEST(BFCArenaTest, MemoryPressureNotificationTrims) {
+  BFCArena a(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 30);
+
+  void* p = a.Alloc(1 << 20);
+  a.Free(p);
+
+  // The arena registered its own handler on construction, so a host agent's
+  // notification reaches it without any explicit wiring here.
+  Environment::NotifyMemoryPressure();
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(0, stats.total_allocated_bytes);
+}
 }  // namespace test
 }  // namespace onnxruntime
@@ -543,5 +543,16 @@ TEST_F(DataTypeTest, DataUtilsTest) {
   }
 }
 
+TEST_F(DataTypeTest, TensorTypesForTest) {
+  const auto& types = DataTypeImpl::TensorTypesFor<float, double>();
+  ASSERT_EQ(2, types.size());
+  EXPECT_EQ(DataTypeImpl::GetTensorType<float>(), types[0]);
+  EXPECT_EQ(DataTypeImpl::GetTensorType<double>(), types[1]);
+
+  // One static vector per list: repeat calls hand back the same instance.
+  EXPECT_EQ(&types, &(DataTypeImpl::TensorTypesFor<float, double>()));
+  EXPECT_NE(&types, &(DataTypeImpl::TensorTypesFor<float>()));
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -161,6 +161,71 @@ TEST(ExecutionFrameTest, FeedInDataTest) {
   EXPECT_EQ(p_tensor_arg_0->template MutableData<float>(), buffer);
 }
 
+TEST(ExecutionFrameTest, ReuseTest) {
+  onnxruntime::Model model("test");
+  onnxruntime::Graph& graph = model.MainGraph();
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  onnxruntime::NodeArg input_def("X", &tensor_float), output_def("Y", &tensor_float);
+
+  graph.AddNode("node1", "Clip", "Clip operator", ArgMap{&input_def}, ArgMap{&output_def});
+  graph.Resolve();
+  auto cpu_allocator = TestCPUExecutionProvider()->GetAllocator(0, ONNXRuntimeMemTypeDefault);
+
+  MLValue value, value2;
+  CreateMLValue<float>(cpu_allocator,
+                       std::vector<int64_t>{3, 2},
+                       std::vector<float>(6, 1.0f), &value);
+  CreateMLValue<float>(cpu_allocator,
+                       std::vector<int64_t>{3, 2},
+                       std::vector<float>(6, 2.0f), &value2);
+
+  auto cpu_xp = CreateCPUExecutionProvider();
+  auto xp_typ = cpu_xp->Type();
+
+  KernelRegistryManager kernel_registry_manager;
+  kernel_registry_manager.RegisterKernelRegistry(cpu_xp->GetKernelRegistry(), KernelRegistryPriority::LowPriority);
+
+  ExecutionProviders execution_providers;
+  execution_providers.Add("", std::move(cpu_xp));
+
+  SessionState state{execution_providers};
+  state.SetGraphViewer(std::make_unique<GraphViewer>(graph));
+
+  MLValueNameIdxMap& mlvalue_name_idx_map{state.GetMLValueNameIdxMap()};
+  mlvalue_name_idx_map.Add("X");
+  mlvalue_name_idx_map.Add("Y");
+
+  vector<MLValue> outputs;
+  ExecutionFrame frame(std::unordered_map<std::string, MLValue>{{"X", value}},
+                       std::vector<std::string>{},
+                       outputs,
+                       state);
+
+  MLValue* p_ml_value = frame.GetMutableNodeInputOrOutputMLValue(0);
+  EXPECT_TRUE(p_ml_value);
+  EXPECT_EQ(p_ml_value->GetMutable<Tensor>()->template MutableData<float>(),
+            value.GetMutable<Tensor>()->template MutableData<float>());
+
+  // reuse the frame with a new feed; the new value must be visible through
+  // the node args without rebuilding any of the frame's metadata.
+  Status status = frame.Reuse(std::unordered_map<std::string, MLValue>{{"X", value2}},
+                              std::vector<std::string>{},
+                              outputs);
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  p_ml_value = frame.GetMutableNodeInputOrOutputMLValue(0);
+  EXPECT_TRUE(p_ml_value);
+  EXPECT_EQ(p_ml_value->GetMutable<Tensor>()->template MutableData<float>(),
+            value2.GetMutable<Tensor>()->template MutableData<float>());
+
+  // a frame can only be reused with the feed names it was created with.
+  status = frame.Reuse(std::unordered_map<std::string, MLValue>{{"Z", value2}},
+                       std::vector<std::string>{},
+                       outputs);
+  EXPECT_FALSE(status.IsOK());
+}
+
 TEST(ExecutionFrameTest, MemPatternTest) {
   auto cpu_xp = CreateCPUExecutionProvider();
   auto xp_type = cpu_xp->Type();
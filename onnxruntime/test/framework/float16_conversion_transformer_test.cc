@@ -0,0 +1,107 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/data_types.h"
+#include "core/framework/float16_conversion_transformer.h"
+#include "core/graph/model.h"
+#include "core/util/math.h"
+#include "gtest/gtest.h"
+
+using namespace ONNX_NAMESPACE;
+namespace onnxruntime {
+namespace test {
+
+static bool IsTensorOfType(const onnxruntime::NodeArg* arg, MLDataType type) {
+  return arg->Type() != nullptr && DataTypeImpl::TypeFromProto(*arg->TypeAsProto()) == type;
+}
+
+TEST(TransformerTest, Float16ConversionTest) {
+  // x (input) --\
+  //              Mul --> m --> Softmax --> s --\
+  // w (init)  --/------------------------------ Add --> y
+  // Mul and Add convert to float16 along with w; Softmax keeps float32 and
+  // x/y keep their float32 graph interface, all via inserted casts.
+  auto model = std::make_shared<onnxruntime::Model>("test");
+  onnxruntime::Graph& graph = model->MainGraph();
+
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  tensor_float.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+  TensorProto initializer_w;
+  initializer_w.set_name("w");
+  initializer_w.set_data_type(TensorProto_DataType_FLOAT);
+  initializer_w.add_dims(2);
+  initializer_w.add_float_data(1.5f);
+  initializer_w.add_float_data(-2.0f);
+  graph.AddInitializedTensor(initializer_w);
+
+  auto& arg_x = graph.GetOrCreateNodeArg("x", &tensor_float);
+  auto& arg_w = graph.GetOrCreateNodeArg("w", &tensor_float);
+  auto& arg_m = graph.GetOrCreateNodeArg("m", &tensor_float);
+  auto& arg_s = graph.GetOrCreateNodeArg("s", &tensor_float);
+  auto& arg_y = graph.GetOrCreateNodeArg("y", &tensor_float);
+
+  graph.AddNode("mul", "Mul", "float16 eligible", {&arg_x, &arg_w}, {&arg_m});
+  graph.AddNode("softmax", "Softmax", "kept in float32", {&arg_m}, {&arg_s});
+  graph.AddNode("add", "Add", "float16 eligible", {&arg_s, &arg_w}, {&arg_y});
+
+  auto status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  Float16ConversionTransformer transformer;
+  bool modified = false;
+  status = transformer.Apply(graph, modified);
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+  ASSERT_TRUE(modified);
+
+  // one cast each for x into mul, m into softmax, s into add and the add
+  // result back into y
+  int num_casts = 0;
+  for (auto& node : graph.Nodes()) {
+    if (node.OpType() == "Cast") {
+      ++num_casts;
+    }
+  }
+  EXPECT_EQ(num_casts, 4);
+  EXPECT_EQ(graph.NumberOfNodes(), 7);
+
+  // the weight was converted in place, so no cast runs on it at inference time
+  const TensorProto* converted_w = nullptr;
+  ASSERT_TRUE(graph.GetInitializedTensor("w", converted_w));
+  EXPECT_EQ(converted_w->data_type(), TensorProto_DataType_FLOAT16);
+  ASSERT_EQ(converted_w->raw_data().size(), 2 * sizeof(uint16_t));
+  const uint16_t* half_values = reinterpret_cast<const uint16_t*>(converted_w->raw_data().data());
+  EXPECT_EQ(math::halfToFloat(half_values[0]), 1.5f);
+  EXPECT_EQ(math::halfToFloat(half_values[1]), -2.0f);
+
+  auto float16_type = DataTypeImpl::GetTensorType<MLFloat16>();
+  auto float_type = DataTypeImpl::GetTensorType<float>();
+  EXPECT_TRUE(IsTensorOfType(graph.GetNodeArg("w"), float16_type));
+  EXPECT_TRUE(IsTensorOfType(graph.GetNodeArg("m"), float16_type));
+
+  // the graph interface and the softmax boundary stay float32
+  EXPECT_TRUE(IsTensorOfType(graph.GetNodeArg("x"), float_type));
+  EXPECT_TRUE(IsTensorOfType(graph.GetNodeArg("s"), float_type));
+  EXPECT_TRUE(IsTensorOfType(graph.GetNodeArg("y"), float_type));
+
+  for (auto& node : graph.Nodes()) {
+    if (node.OpType() == "Mul" || node.OpType() == "Add") {
+      for (auto input : node.InputDefs()) {
+        EXPECT_TRUE(IsTensorOfType(input, float16_type)) << node.Name();
+      }
+    } else if (node.OpType() == "Softmax") {
+      EXPECT_TRUE(IsTensorOfType(node.InputDefs()[0], float_type));
+      EXPECT_TRUE(IsTensorOfType(node.OutputDefs()[0], float_type));
+    }
+  }
+
+  // a second application finds nothing left to convert
+  modified = false;
+  status = transformer.Apply(graph, modified);
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+  EXPECT_FALSE(modified);
+  EXPECT_EQ(graph.NumberOfNodes(), 7);
+}
+}  // namespace test
+}  // namespace onnxruntime
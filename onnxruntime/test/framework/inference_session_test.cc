@@ -4,8 +4,12 @@
 #include "core/session/inference_session.h"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <functional>
+#include <future>
 #include <iterator>
+#include <mutex>
 #include <thread>
 #include <fstream>
 
@@ -19,6 +23,7 @@
 #include "core/framework/compute_capability.h"
 #include "core/graph/model.h"
 #include "core/graph/op.h"
+#include "core/platform/perf_counters.h"
 #include "core/providers/cpu/cpu_execution_provider.h"
 #include "core/providers/cpu/math/element_wise_ops.h"
 #include "core/framework/tensorprotoutils.h"
@@ -207,10 +212,14 @@ void RunModelWithBindingMatMul(InferenceSession& session_object,
                                const RunOptions& run_options,
                                ProviderType bind_provider_type,
                                bool is_preallocate_output_vec = false,
-                               ProviderType allocation_provider = kCpuExecutionProvider) {
+                               ProviderType allocation_provider = kCpuExecutionProvider,
+                               bool enable_input_prefetch = false) {
   unique_ptr<IOBinding> io_binding;
   Status st = session_object.NewIOBinding(&io_binding);
   ASSERT_TRUE(st.IsOK());
+  if (enable_input_prefetch) {
+    io_binding->EnableInputPrefetch(true);
+  }
   auto input_allocator = io_binding->GetCPUAllocator(0, bind_provider_type);
 
   // prepare inputs
@@ -309,6 +318,285 @@ TEST(InferenceSessionTests, NoTimeout) {
   RunModel(session_object, run_options);
 }
 
+TEST(InferenceSessionTests, DeviceResidentFetch) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.DeviceResidentFetch";
+
+  InferenceSession session_object{so, &DefaultLoggingManager()};
+  ASSERT_TRUE(session_object.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  // pin the output to the producing device; on the CPU provider the fetch is
+  // already host memory, so the run behaves exactly as the default and
+  // CopyFetchToHost passes the value through without a copy.
+  RunOptions run_options;
+  run_options.run_tag = "device resident fetch";
+  run_options.fetch_locations["Y"] = RunOptions::kFetchLocationDevice;
+  RunModel(session_object, run_options);
+
+  std::vector<int64_t> dims_mul_x = {3, 2};
+  std::vector<float> values_mul_x = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  MLValue ml_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, ONNXRuntimeMemTypeDefault),
+                       dims_mul_x, values_mul_x, &ml_value);
+  std::vector<MLValue> fetches;
+  ASSERT_TRUE(session_object.Run(run_options, {{"X", ml_value}}, {"Y"}, &fetches).IsOK());
+
+  MLValue host_fetch;
+  ASSERT_TRUE(session_object.CopyFetchToHost(fetches[0], host_fetch).IsOK());
+  ASSERT_EQ(host_fetch.Get<Tensor>().Data<float>(), fetches[0].Get<Tensor>().Data<float>());
+  VerifyOutputs({host_fetch}, {3, 2}, {1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f});
+}
+
+TEST(InferenceSessionTests, GetMemoryStats) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.GetMemoryStats";
+
+  InferenceSession session_object{so, &DefaultLoggingManager()};
+
+  // not available before initialization
+  InferenceSession::MemoryStats stats;
+  ASSERT_FALSE(session_object.GetMemoryStats(stats).IsOK());
+
+  ASSERT_TRUE(session_object.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  RunOptions run_options;
+  run_options.run_tag = "one session/memory stats";
+  RunModel(session_object, run_options);
+
+  ASSERT_TRUE(session_object.GetMemoryStats(stats).IsOK());
+  ASSERT_FALSE(stats.allocators.empty());
+  bool found_arena = false;
+  for (const auto& allocator_stats : stats.allocators) {
+    if (allocator_stats.is_arena) {
+      found_arena = true;
+      ASSERT_GE(allocator_stats.max_bytes_in_use, allocator_stats.bytes_in_use);
+      ASSERT_GE(allocator_stats.largest_free_chunk_bytes, 0);
+    }
+  }
+  ASSERT_TRUE(found_arena);
+
+  // mul_1.pb is a single Mul node with a statically shaped 3x2 float output
+  ASSERT_EQ(1u, stats.nodes.size());
+  ASSERT_EQ("Mul", stats.nodes[0].op_type);
+  ASSERT_EQ(1, stats.nodes[0].num_planned_allocs);
+  ASSERT_EQ(24, stats.nodes[0].planned_bytes);
+  ASSERT_EQ(0, stats.nodes[0].num_dynamic_allocs);
+}
+
+TEST(InferenceSessionTests, WarmUp) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.WarmUp";
+
+  InferenceSession session_object{so, &DefaultLoggingManager()};
+
+  // not available before initialization
+  ASSERT_FALSE(session_object.WarmUp({}).IsOK());
+
+  ASSERT_TRUE(session_object.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  // weights-only warmup
+  ASSERT_TRUE(session_object.WarmUp({}).IsOK());
+
+  // warmup through the full pipeline with a representative feed set
+  std::vector<int64_t> dims_mul_x = {3, 2};
+  std::vector<float> values_mul_x = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  MLValue ml_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, ONNXRuntimeMemTypeDefault), dims_mul_x, values_mul_x, &ml_value);
+  NameMLValMap feeds;
+  feeds.insert(std::make_pair("X", ml_value));
+  common::Status st = session_object.WarmUp({feeds});
+  ASSERT_TRUE(st.IsOK()) << st.ErrorMessage();
+
+  // the session still serves regular requests afterwards.
+  RunOptions run_options;
+  run_options.run_tag = "one session/after warmup";
+  RunModel(session_object, run_options);
+}
+
+TEST(InferenceSessionTests, RetainedStateAcrossRuns) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.RetainedStateAcrossRuns";
+  // mul_1 computes Y = X * W; feeding Y back as X makes each Run one step
+  // of a sequence.
+  so.retained_state_pairs = {{"Y", "X"}};
+
+  InferenceSession session_object{so, &DefaultLoggingManager()};
+  ASSERT_TRUE(session_object.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  // unknown names are rejected at initialization
+  {
+    SessionOptions bad_so;
+    bad_so.session_logid = "InferenceSessionTests.RetainedStateAcrossRuns.Bad";
+    bad_so.retained_state_pairs = {{"Y", "NotAnInput"}};
+    InferenceSession bad_session{bad_so, &DefaultLoggingManager()};
+    ASSERT_TRUE(bad_session.Load(MODEL_URI).IsOK());
+    ASSERT_FALSE(bad_session.Initialize().IsOK());
+  }
+
+  // the first call of a sequence feeds the initial state
+  std::vector<int64_t> dims = {3, 2};
+  std::vector<float> values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  MLValue ml_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, ONNXRuntimeMemTypeDefault), dims, values, &ml_value);
+  NameMLValMap feeds;
+  feeds.insert(std::make_pair("X", ml_value));
+  std::vector<std::string> output_names{"Y"};
+  RunOptions run_options;
+
+  std::vector<MLValue> fetches;
+  ASSERT_TRUE(session_object.Run(run_options, feeds, output_names, &fetches).IsOK());
+  VerifyOutputs(fetches, dims, {1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f});
+
+  // the retained Y feeds X on the next call; the caller supplies nothing
+  fetches.clear();
+  ASSERT_TRUE(session_object.Run(run_options, NameMLValMap{}, output_names, &fetches).IsOK());
+  VerifyOutputs(fetches, dims, {1.0f, 8.0f, 27.0f, 64.0f, 125.0f, 216.0f});
+
+  // resetting drops the state so a fresh sequence starts from the feeds
+  ASSERT_TRUE(session_object.ResetRetainedStates().IsOK());
+  fetches.clear();
+  ASSERT_TRUE(session_object.Run(run_options, feeds, output_names, &fetches).IsOK());
+  VerifyOutputs(fetches, dims, {1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f});
+}
+
+TEST(InferenceSessionTests, MicroBatching) {
+  SessionOptions so;
+
+  so.session_logid = "InferenceSessionTests.MicroBatching";
+  so.enable_micro_batching = true;
+  so.micro_batch_max_size = 2;
+  so.micro_batch_timeout_microseconds = 100 * 1000;
+
+  InferenceSession session_object{so, &DefaultLoggingManager()};
+  ASSERT_TRUE(session_object.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  // each request must get its own slice of the combined run back.
+  auto run_one = [&session_object](float start) {
+    std::vector<int64_t> dims = {3, 2};
+    std::vector<float> values(6);
+    std::vector<float> expected(6);
+    for (int i = 0; i < 6; ++i) {
+      values[i] = start + i;
+      expected[i] = values[i] * values[i];
+    }
+
+    MLValue ml_value;
+    CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, ONNXRuntimeMemTypeDefault), dims, values, &ml_value);
+    NameMLValMap feeds;
+    feeds.insert(std::make_pair("X", ml_value));
+
+    std::vector<std::string> output_names{"Y"};
+    std::vector<MLValue> fetches;
+    RunOptions run_options;
+    common::Status st = session_object.Run(run_options, feeds, output_names, &fetches);
+    EXPECT_TRUE(st.IsOK()) << st.ErrorMessage();
+    VerifyOutputs(fetches, dims, expected);
+  };
+
+  std::thread thread_one(run_one, 1.0f);
+  std::thread thread_two(run_one, 11.0f);
+  thread_one.join();
+  thread_two.join();
+}
+
+TEST(InferenceSessionTests, RunAsync) {
+  SessionOptions so;
+
+  so.session_logid = "InferenceSessionTests.RunAsync";
+
+  InferenceSession session_object{so, &DefaultLoggingManager()};
+  ASSERT_TRUE(session_object.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  // prepare inputs
+  std::vector<int64_t> dims_mul_x = {3, 2};
+  std::vector<float> values_mul_x = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  MLValue ml_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, ONNXRuntimeMemTypeDefault), dims_mul_x, values_mul_x, &ml_value);
+  NameMLValMap feeds;
+  feeds.insert(std::make_pair("X", ml_value));
+
+  std::vector<std::string> output_names{"Y"};
+
+  // queue several runs and wait for all the callbacks.
+  const int num_requests = 4;
+  std::atomic<int> num_completed{0};
+  std::promise<void> all_done;
+  RunOptions run_options;
+  run_options.run_tag = "RunAsync";
+
+  for (int i = 0; i < num_requests; ++i) {
+    common::Status st = session_object.RunAsync(
+        run_options, feeds, output_names, {},
+        [&num_completed, &all_done](common::Status status, std::vector<MLValue>& fetches) {
+          EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+          VerifyOutputs(fetches, {3, 2}, {1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f});
+          if (++num_completed == num_requests) {
+            all_done.set_value();
+          }
+        });
+    ASSERT_TRUE(st.IsOK()) << st.ErrorMessage();
+  }
+
+  ASSERT_EQ(all_done.get_future().wait_for(std::chrono::minutes(1)), std::future_status::ready);
+  ASSERT_EQ(num_completed.load(), num_requests);
+}
+
+TEST(InferenceSessionTests, ThreadAffinity) {
+  SessionOptions so;
+
+  so.session_logid = "InferenceSessionTests.ThreadAffinity";
+  // pin the parallel executor's workers to processor 0; whether pinning is
+  // supported or not the run must still succeed.
+  so.enable_sequential_execution = false;
+  so.session_thread_pool_size = 2;
+  so.thread_pool_affinity_masks = {0x1};
+
+  InferenceSession session_object{so, &DefaultLoggingManager()};
+  ASSERT_TRUE(session_object.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  RunOptions run_options;
+  run_options.run_tag = "ThreadAffinity";
+  RunModel(session_object, run_options);
+}
+
+TEST(InferenceSessionTests, StreamingFetches) {
+  SessionOptions so;
+
+  so.session_logid = "InferenceSessionTests.StreamingFetches";
+  // streamed delivery rides on the parallel executor's per-node completion
+  so.enable_sequential_execution = false;
+
+  InferenceSession session_object{so, &DefaultLoggingManager()};
+  ASSERT_TRUE(session_object.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  std::mutex streamed_mutex;
+  std::vector<std::string> streamed_names;
+  std::vector<MLValue> streamed_values;
+
+  RunOptions run_options;
+  run_options.run_tag = "StreamingFetches";
+  run_options.output_ready_callback = [&](const std::string& name, const MLValue& value) {
+    std::lock_guard<std::mutex> lock(streamed_mutex);
+    streamed_names.push_back(name);
+    streamed_values.push_back(value);
+  };
+
+  RunModel(session_object, run_options);
+
+  // the output was delivered through the callback as well as the fetches
+  ASSERT_EQ(streamed_names.size(), 1);
+  EXPECT_EQ(streamed_names[0], "Y");
+  VerifyOutputs(streamed_values, {3, 2}, {1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f});
+}
+
 TEST(InferenceSessionTests, DisableCPUArena) {
   SessionOptions so;
 
@@ -485,6 +773,83 @@ TEST(InferenceSessionTests, CheckRunProfilerWithSessionOptions) {
   }
 }
 
+TEST(InferenceSessionTests, CheckRunProfilerWithHardwareCounters) {
+  SessionOptions so;
+
+  so.session_logid = "CheckRunProfilerWithHardwareCounters";
+  so.enable_profiling = true;
+  so.enable_hardware_counter_profiling = true;
+  so.profile_file_prefix = "onnxprofile_profile_hwc_test";
+
+  InferenceSession session_object(so);
+  ASSERT_TRUE(session_object.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  RunOptions run_options;
+  run_options.run_tag = "RunTag";
+
+  RunModel(session_object, run_options);
+  std::string profile_file = session_object.EndProfiling();
+
+  std::ifstream profile(profile_file);
+  ASSERT_TRUE(profile);
+
+  bool kernel_event_seen = false;
+  bool counters_seen = false;
+  std::string line;
+  while (std::getline(profile, line)) {
+    if (line.find("_kernel_time") != string::npos) {
+      kernel_event_seen = true;
+      if (line.find("cycles") != string::npos &&
+          line.find("instructions") != string::npos &&
+          line.find("llc_misses") != string::npos) {
+        counters_seen = true;
+      }
+    }
+  }
+  ASSERT_TRUE(kernel_event_seen);
+
+  // counter sampling is not available everywhere (platform or
+  // perf_event_paranoid); the profile must degrade to wall time only then.
+  if (PerfCounters::IsAvailable()) {
+    ASSERT_TRUE(counters_seen);
+  }
+}
+
+TEST(InferenceSessionTests, CheckRunProfilerRunTagCorrelation) {
+  SessionOptions so;
+
+  so.session_logid = "CheckRunProfiler";
+  so.enable_profiling = true;
+  so.profile_file_prefix = "onnxprofile_profile_run_tag_test";
+
+  InferenceSession session_object(so);
+  ASSERT_TRUE(session_object.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  RunOptions run_options;
+  run_options.run_tag = "my-trace-tag-42";
+
+  RunModel(session_object, run_options);
+  std::string profile_file = session_object.EndProfiling();
+
+  std::ifstream profile(profile_file);
+  ASSERT_TRUE(profile);
+  std::string line;
+
+  // the kernel time spans of the run must carry the run tag, so a slow
+  // request can be attributed to its nodes.
+  bool kernel_event_has_run_tag = false;
+  while (std::getline(profile, line)) {
+    if (line.find("kernel_time") != string::npos &&
+        line.find("run_tag") != string::npos &&
+        line.find(run_options.run_tag) != string::npos) {
+      kernel_event_has_run_tag = true;
+    }
+  }
+  ASSERT_TRUE(kernel_event_has_run_tag);
+}
+
 TEST(InferenceSessionTests, CheckRunProfilerWithStartProfile) {
   SessionOptions so;
 
@@ -518,10 +883,89 @@ TEST(InferenceSessionTests, CheckRunProfilerWithStartProfile) {
     }
 
     if (count == 1) {
-      ASSERT_TRUE(line.find("mul_1_fence_before") != string::npos);
+      // fence events are skipped for nodes without fences, so the first
+      // event after StartProfiling is the kernel time.
+      ASSERT_TRUE(line.find("mul_1_kernel_time") != string::npos);
+    }
+    count++;
+  }
+}
+
+TEST(InferenceSessionTests, CheckRunProfilerWithLightweightMode) {
+  SessionOptions so;
+
+  so.session_logid = "CheckRunProfiler";
+  so.enable_profiling = true;
+  so.enable_lightweight_profiling = true;
+  so.profile_file_prefix = "onnxprofile_profile_lightweight_test";
+
+  InferenceSession session_object(so);
+  ASSERT_TRUE(session_object.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  RunOptions run_options;
+  run_options.run_tag = "RunTag";
+
+  RunModel(session_object, run_options);
+  std::string profile_file = session_object.EndProfiling();
+
+  std::ifstream profile(profile_file);
+  ASSERT_TRUE(profile);
+  std::string line;
+
+  std::vector<std::string> tags = {"pid", "dur", "ts", "ph", "X", "name"};
+  int count = 0;
+  bool have_model_loading_event = false;
+  while (std::getline(profile, line)) {
+    if (count == 0) {
+      ASSERT_TRUE(line.find("[") != string::npos);
+    } else if (line.find("]") == string::npos) {
+      for (auto& s : tags) {
+        ASSERT_TRUE(line.find(s) != string::npos);
+      }
+      // event arguments are not recorded in the lightweight mode
+      ASSERT_TRUE(line.find("\"args\" : {}") != string::npos);
+      if (line.find("model_loading_uri") != string::npos) {
+        have_model_loading_event = true;
+      }
     }
     count++;
   }
+  ASSERT_TRUE(have_model_loading_event);
+  ASSERT_GT(count, 3);
+}
+
+TEST(InferenceSessionTests, CheckProfileSummary) {
+  SessionOptions so;
+
+  so.session_logid = "CheckProfileSummary";
+  so.enable_profiling = true;
+  so.profile_file_prefix = "onnxprofile_profile_summary_test";
+
+  InferenceSession session_object(so);
+  ASSERT_TRUE(session_object.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  RunOptions run_options;
+  run_options.run_tag = "RunTag";
+  RunModel(session_object, run_options);
+
+  // the summary is available while profiling keeps running.
+  std::string summary = session_object.GetProfileSummary();
+  ASSERT_TRUE(summary.find("\"op\":\"Mul\"") != string::npos);
+  ASSERT_TRUE(summary.find(kCpuExecutionProvider) != string::npos);
+  ASSERT_TRUE(summary.find("\"name\":\"mul_1\",\"count\":1") != string::npos);
+
+  // a second run doubles the invocation counts.
+  RunModel(session_object, run_options);
+  std::string second_summary = session_object.GetProfileSummary();
+  ASSERT_TRUE(second_summary.find("\"name\":\"mul_1\",\"count\":2") != string::npos);
+
+  // an impossible threshold flags nothing between consecutive summaries.
+  std::string comparison = profiling::Profiler::CompareSummaries(summary, second_summary, 1e9);
+  ASSERT_TRUE(comparison.find("\"regressions\":[]") != string::npos);
+
+  session_object.EndProfiling();
 }
 
 TEST(InferenceSessionTests, MultipleSessionsNoTimeout) {
@@ -548,6 +992,44 @@ TEST(InferenceSessionTests, MultipleSessionsNoTimeout) {
   thread2.join();
 }
 
+TEST(InferenceSessionTests, PipelineExecution) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.PipelineExecution";
+  so.enable_pipeline_execution = true;
+
+  InferenceSession session_object{so, &DefaultLoggingManager()};
+  ASSERT_TRUE(session_object.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  // single caller: the mode must behave like plain sequential execution.
+  // mul_1.pb is a one-node plan, so this also covers the too-short-to-split
+  // fallback.
+  RunOptions run_options;
+  run_options.run_tag = "pipeline/single";
+  RunModel(session_object, run_options);
+
+  // a stream of frames from two caller threads; every run must still see
+  // its own outputs.
+  std::thread thread1{[&session_object]() {
+    RunOptions thread_run_options;
+    thread_run_options.run_tag = "pipeline/thread 1";
+    for (int i = 0; i < 4; ++i) {
+      RunModel(session_object, thread_run_options);
+    }
+  }};
+
+  std::thread thread2{[&session_object]() {
+    RunOptions thread_run_options;
+    thread_run_options.run_tag = "pipeline/thread 2";
+    for (int i = 0; i < 4; ++i) {
+      RunModel(session_object, thread_run_options);
+    }
+  }};
+
+  thread1.join();
+  thread2.join();
+}
+
 TEST(InferenceSessionTests, PreAllocateOutputVector) {
   SessionOptions so;
 
@@ -648,7 +1130,8 @@ static void TestBindHelper(const std::string& log_str,
                            ProviderType bind_provider_type,
                            ProviderType run_provider_type,
                            bool preallocate_output,
-                           ProviderType allocation_provider = kCpuExecutionProvider) {
+                           ProviderType allocation_provider = kCpuExecutionProvider,
+                           bool enable_input_prefetch = false) {
   SessionOptions so;
 
   so.session_logid = "InferenceSessionTests." + log_str;
@@ -679,7 +1162,8 @@ static void TestBindHelper(const std::string& log_str,
                             run_options,
                             bind_provider_type,
                             preallocate_output,
-                            allocation_provider);
+                            allocation_provider,
+                            enable_input_prefetch);
 }
 
 TEST(InferenceSessionTests, TestBindCpu) {
@@ -689,6 +1173,17 @@ TEST(InferenceSessionTests, TestBindCpu) {
                  false /* don't preallocate output */);
 }
 
+TEST(InferenceSessionTests, TestBindCpuWithInputPrefetch) {
+  // on CPU the allocator creates no fence, so prefetch mode must quietly
+  // fall back to the synchronous copy
+  TestBindHelper("TestBindCpuWithInputPrefetch",
+                 kCpuExecutionProvider,
+                 kCpuExecutionProvider,
+                 false /* don't preallocate output */,
+                 kCpuExecutionProvider,
+                 true /* enable input prefetch */);
+}
+
 TEST(InferenceSessionTests, TestIOBindingReuse) {
   SessionOptions so;
   InferenceSession session_object(so);
@@ -726,6 +1221,113 @@ TEST(InferenceSessionTests, TestIOBindingReuse) {
   }
 }
 
+TEST(InferenceSessionTests, TestIOBindingExternalBuffer) {
+  SessionOptions so;
+  InferenceSession session_object(so);
+  std::unique_ptr<Model> p_model;
+  CreateMatMulModel(p_model, kCpuExecutionProvider);
+
+  std::stringstream s1;
+  p_model->ToProto().SerializeToOstream(&s1);
+  ASSERT_TRUE(session_object.Load(s1).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+  unique_ptr<IOBinding> io_binding;
+  Status st = session_object.NewIOBinding(&io_binding);
+  ASSERT_TRUE(st.IsOK());
+
+  // caller owned buffers standing in for externally managed frame memory
+  std::vector<float> values_mul_x = {0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f, 10.0f, 11.0f};
+  std::vector<float> zeros(values_mul_x.size(), 0.0f);
+
+  auto location = io_binding->GetCPUAllocator(0, kCpuExecutionProvider)->Info();
+  size_t index_a = 0;
+  size_t index_b = 0;
+  ASSERT_TRUE(io_binding->BindExternalInput("A", DataTypeImpl::GetType<float>(), TensorShape({3, 4}),
+                                            values_mul_x.data(), location, &index_a)
+                  .IsOK());
+  ASSERT_TRUE(io_binding->BindExternalInput("B", DataTypeImpl::GetType<float>(), TensorShape({4, 3}),
+                                            values_mul_x.data(), location, &index_b)
+                  .IsOK());
+
+  // the bound tensors must alias the external memory, not a copy of it
+  ASSERT_EQ(values_mul_x.data(), io_binding->GetInputs().at("A").Get<Tensor>().Data<float>());
+
+  MLValue output_ml_value;
+  io_binding->BindOutput("Y", output_ml_value);
+
+  RunOptions run_options;
+  run_options.run_tag = "one session/external binding";
+  st = session_object.Run(run_options, *io_binding.get());
+  ASSERT_TRUE(st.IsOK()) << st.ErrorMessage();
+
+  std::vector<int64_t> expected_output_dims = {3, 3};
+  std::vector<float> expected_values_mul_y = {42, 48, 54, 114, 136, 158, 186, 224, 262};
+  VerifyOutputs(io_binding->GetOutputs(), expected_output_dims, expected_values_mul_y);
+
+  // swap the buffer behind "A" without a name lookup or copy and run again
+  ASSERT_TRUE(io_binding->RebindInput(index_a, zeros.data()).IsOK());
+  ASSERT_EQ(zeros.data(), io_binding->GetInputs().at("A").Get<Tensor>().Data<float>());
+
+  st = session_object.Run(run_options, *io_binding.get());
+  ASSERT_TRUE(st.IsOK()) << st.ErrorMessage();
+  VerifyOutputs(io_binding->GetOutputs(), expected_output_dims, std::vector<float>(9, 0.0f));
+
+  // rebinding an index that was never bound must fail
+  ASSERT_FALSE(io_binding->RebindInput(2, zeros.data()).IsOK());
+}
+
+TEST(InferenceSessionTests, TestIOBindingOutputDonation) {
+  SessionOptions so;
+  InferenceSession session_object(so);
+  std::unique_ptr<Model> p_model;
+  CreateMatMulModel(p_model, kCpuExecutionProvider);
+
+  std::stringstream s1;
+  p_model->ToProto().SerializeToOstream(&s1);
+  ASSERT_TRUE(session_object.Load(s1).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+  unique_ptr<IOBinding> io_binding;
+  Status st = session_object.NewIOBinding(&io_binding);
+  ASSERT_TRUE(st.IsOK());
+
+  std::vector<float> values_mul_x = {0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f, 10.0f, 11.0f};
+  auto cpu_allocator = TestCPUExecutionProvider()->GetAllocator(0, ONNXRuntimeMemTypeDefault);
+
+  MLValue input_ml_value_A;
+  CreateMLValue<float>(cpu_allocator, {3, 4}, values_mul_x, &input_ml_value_A);
+  MLValue input_ml_value_B;
+  CreateMLValue<float>(cpu_allocator, {4, 3}, values_mul_x, &input_ml_value_B);
+  io_binding->BindInput("A", input_ml_value_A);
+  io_binding->BindInput("B", input_ml_value_B);
+
+  // donate the output's memory: the session constructs the fetch directly in
+  // this allocator, as a consumer binding its inputs over it would need.
+  ASSERT_TRUE(io_binding->BindOutput("Y", cpu_allocator).IsOK());
+
+  RunOptions run_options;
+  run_options.run_tag = "one session/output donation";
+  st = session_object.Run(run_options, *io_binding.get());
+  ASSERT_TRUE(st.IsOK()) << st.ErrorMessage();
+
+  std::vector<int64_t> expected_output_dims = {3, 3};
+  std::vector<float> expected_values_mul_y = {42, 48, 54, 114, 136, 158, 186, 224, 262};
+  VerifyOutputs(io_binding->GetOutputs(), expected_output_dims, expected_values_mul_y);
+
+  // each run constructs a fresh fetch so a consumer can hold the previous
+  // one; keep a reference across the second run and check both.
+  MLValue first_fetch = io_binding->GetOutputs()[0];
+  const float* first_data = first_fetch.Get<Tensor>().Data<float>();
+
+  st = session_object.Run(run_options, *io_binding.get());
+  ASSERT_TRUE(st.IsOK()) << st.ErrorMessage();
+  VerifyOutputs(io_binding->GetOutputs(), expected_output_dims, expected_values_mul_y);
+  ASSERT_NE(first_data, io_binding->GetOutputs()[0].Get<Tensor>().Data<float>());
+  VerifyOutputs({first_fetch}, expected_output_dims, expected_values_mul_y);
+
+  // a donated allocator must be non-null
+  ASSERT_FALSE(io_binding->BindOutput("Y", AllocatorPtr()).IsOK());
+}
+
 TEST(InferenceSessionTests, InvalidInputTypeOfTensorElement) {
   SessionOptions so;
 
@@ -0,0 +1,64 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/kernel_def_builder.h"
+
+#include "core/framework/data_types.h"
+#include "core/graph/onnx_protobuf.h"
+#include "gtest/gtest.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+namespace test {
+
+TEST(KernelDefBuilderTest, TensorConstraintGetsDenseMask) {
+  auto def = KernelDefBuilder()
+                 .SetName("TestOp")
+                 .TypeConstraint("T", DataTypeImpl::TensorTypesFor<float, double>())
+                 .Build();
+
+  const auto& masks = def->TypeConstraintTensorMasks();
+  auto it = masks.find("T");
+  ASSERT_NE(masks.end(), it);
+  EXPECT_EQ((uint64_t{1} << TensorProto_DataType_FLOAT) |
+                (uint64_t{1} << TensorProto_DataType_DOUBLE),
+            it->second);
+}
+
+TEST(KernelDefBuilderTest, SingleTypeConstraintGetsDenseMask) {
+  auto def = KernelDefBuilder()
+                 .SetName("TestOp")
+                 .TypeConstraint("T", DataTypeImpl::GetTensorType<int32_t>())
+                 .Build();
+
+  const auto& masks = def->TypeConstraintTensorMasks();
+  auto it = masks.find("T");
+  ASSERT_NE(masks.end(), it);
+  EXPECT_EQ(uint64_t{1} << TensorProto_DataType_INT32, it->second);
+}
+
+TEST(KernelDefBuilderTest, NonTensorConstraintHasNoMask) {
+  auto def = KernelDefBuilder()
+                 .SetName("TestOp")
+                 .TypeConstraint("T", DataTypeImpl::GetType<MapStringToInt64>())
+                 .Build();
+
+  // No mask entry, so VerifyKernelDef falls back to the MLDataType scan.
+  EXPECT_EQ(0, def->TypeConstraintTensorMasks().count("T"));
+}
+
+TEST(KernelDefBuilderTest, RedefiningConstraintReplacesMask) {
+  auto def = KernelDefBuilder()
+                 .SetName("TestOp")
+                 .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+                 .TypeConstraint("T", DataTypeImpl::GetType<MapStringToInt64>())
+                 .Build();
+
+  // The second constraint is not maskable; the stale float mask must not
+  // survive, or VerifyKernelDef would accept types the constraint rejects.
+  EXPECT_EQ(0, def->TypeConstraintTensorMasks().count("T"));
+}
+
+}  // namespace test
+}  // namespace onnxruntime
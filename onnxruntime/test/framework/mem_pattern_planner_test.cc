@@ -34,5 +34,50 @@ TEST(MemPatternPlannerTest, TraceAllocaitonTest) {
   EXPECT_EQ(pattern.GetBlock(5)->offset_, 1024 + 256 + 512);
   EXPECT_EQ(pattern.GetBlock(6)->offset_, 1024);
 }
+
+TEST(MemPatternPlannerTest, TraceReplayReportsSavings) {
+  MemPatternPlanner planner;
+  planner.TraceAllocation(0, 1024);
+  planner.TraceAllocation(1, 256);
+  planner.TraceFree(1);
+  planner.TraceAllocation(2, 256);
+  planner.TraceFree(0);
+  planner.TraceAllocation(3, 512);
+
+  auto pattern = planner.GenerateMemPattern();
+  MemPatternValidationReport report;
+  auto status = ReplayAllocationTrace(planner.GetAllocationTrace(), pattern, report);
+  EXPECT_TRUE(status.IsOK());
+
+  // value 2 reuses value 1's slot and value 3 reuses value 0's, so the trace
+  // that allocates 2048 bytes in total fits in the 1280-byte planned peak
+  EXPECT_EQ(report.overlap_violations, 0u);
+  EXPECT_EQ(report.peak_size, 1024u + 256u);
+  EXPECT_EQ(report.no_reuse_bytes, 1024u + 256u + 256u + 512u);
+  EXPECT_EQ(report.saved_bytes, report.no_reuse_bytes - report.peak_size);
+  EXPECT_EQ(report.max_live_bytes, 1024u + 256u);
+}
+
+TEST(MemPatternPlannerTest, TraceReplayDetectsOverlap) {
+  MemPatternPlanner planner;
+  planner.TraceAllocation(0, 1024);
+  planner.TraceFree(0);
+  planner.TraceAllocation(1, 512);
+
+  auto pattern = planner.GenerateMemPattern();
+
+  // replay a trace where value 0 stays live past value 1's allocation, the
+  // way an in-place alias extends a tensor's lifetime behind the planner's
+  // back: the planned blocks now overlap while both are live
+  std::vector<AllocationTraceEntry> trace{{0, 1024, false}, {1, 512, false}};
+  MemPatternValidationReport report;
+  auto status = ReplayAllocationTrace(trace, pattern, report);
+  EXPECT_TRUE(status.IsOK());
+  EXPECT_EQ(report.overlap_violations, 1u);
+
+  // a trace referencing a value the pattern never planned is rejected
+  trace.emplace_back(42, 64, false);
+  EXPECT_FALSE(ReplayAllocationTrace(trace, pattern, report).IsOK());
+}
 }  // namespace test
 }  // namespace onnxruntime
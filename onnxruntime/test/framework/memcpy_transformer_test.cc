@@ -161,5 +161,62 @@ TEST(TransformerTest, MemcpyTransformerTestCudaFirst) {
   ExpectSame(node2, node4, 1);
 }
 
+TEST(TransformerTest, MemcpyTransformerBatchesSmallTransfers) {
+  auto model = std::make_shared<onnxruntime::Model>("test");
+  onnxruntime::Graph& graph = model->MainGraph();
+
+  // small statically-shaped tensors qualify for a batched copy
+  TypeProto small_tensor_float_type;
+  small_tensor_float_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  small_tensor_float_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+  small_tensor_float_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+
+  onnxruntime::NodeArg i1_def("I1", &small_tensor_float_type),
+      i2_def("I2", &small_tensor_float_type),
+      i3_def("I3", &small_tensor_float_type),
+      i4_def("I4", &small_tensor_float_type),
+      o1_def("O1", &small_tensor_float_type),
+      o2_def("O2", &small_tensor_float_type),
+      o3_def("O3", &small_tensor_float_type);
+
+  auto& node1 = graph.AddNode("node1", "MatMul", "cpu operator1", ArgMap{&i1_def, &i2_def}, ArgMap{&o1_def});
+  node1.SetExecutionProviderType(onnxruntime::kCpuExecutionProvider);
+  auto& node2 = graph.AddNode("node2", "MatMul", "cpu operator2", ArgMap{&i3_def, &i4_def}, ArgMap{&o2_def});
+  node2.SetExecutionProviderType(onnxruntime::kCpuExecutionProvider);
+  auto& node3 = graph.AddNode("node3", "MatMul", "gpu operator1", ArgMap{&o1_def, &o2_def}, ArgMap{&o3_def});
+  node3.SetExecutionProviderType(onnxruntime::kCudaExecutionProvider);
+
+  auto status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  auto cpu_execution_provider = TestCPUExecutionProvider();
+  KernelRegistryManager test_registry_manager;
+  test_registry_manager.RegisterKernelRegistry(cpu_execution_provider->GetKernelRegistry(),
+                                               KernelRegistryPriority::LowPriority);
+
+  TransformerMemcpyImpl transformer(graph, onnxruntime::kCudaExecutionProvider);
+
+  bool modified = transformer.ModifyGraph(test_registry_manager);
+  EXPECT_TRUE(modified);
+
+  status = graph.Resolve();
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  // Expect: a single batched copy carrying both small tensors from cpu to gpu
+  const onnxruntime::Node* batched_node = nullptr;
+  for (auto& node : graph.Nodes()) {
+    if (node.OpType() == "BatchedMemcpyFromHost") {
+      EXPECT_TRUE(batched_node == nullptr) << "Expected a single batched copy node";
+      batched_node = &node;
+    }
+  }
+  ASSERT_TRUE(batched_node != nullptr) << "Batched copy node expected but not found";
+  ASSERT_EQ(batched_node->InputDefs().size(), 2);
+  EXPECT_EQ(batched_node->InputDefs()[0], node1.OutputDefs()[0]);
+  EXPECT_EQ(batched_node->InputDefs()[1], node2.OutputDefs()[0]);
+  EXPECT_EQ(batched_node->OutputDefs()[0], node3.InputDefs()[0]);
+  EXPECT_EQ(batched_node->OutputDefs()[1], node3.InputDefs()[1]);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
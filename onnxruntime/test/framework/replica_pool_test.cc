@@ -0,0 +1,86 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/replica_pool.h"
+
+#include <thread>
+#include <vector>
+
+#include "core/framework/ml_value.h"
+#include "test/test_environment.h"
+#include "test_utils.h"
+#include "gtest/gtest.h"
+
+using namespace ::onnxruntime::logging;
+
+namespace onnxruntime {
+namespace test {
+
+static const std::string REPLICA_MODEL_URI = "testdata/mul_1.pb";
+
+namespace {
+void RunOnPool(ReplicaPool& pool) {
+  std::vector<int64_t> dims_mul_x = {3, 2};
+  std::vector<float> values_mul_x = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  MLValue ml_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, ONNXRuntimeMemTypeDefault),
+                       dims_mul_x, values_mul_x, &ml_value);
+  NameMLValMap feeds;
+  feeds.insert(std::make_pair("X", ml_value));
+
+  std::vector<std::string> output_names{"Y"};
+  std::vector<MLValue> fetches;
+
+  RunOptions run_options;
+  common::Status st = pool.Run(run_options, feeds, output_names, &fetches);
+  ASSERT_TRUE(st.IsOK()) << st.ErrorMessage();
+
+  std::vector<float> expected_values_mul_y = {1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f};
+  ASSERT_EQ(1, fetches.size());
+  auto& rtensor = fetches.front().Get<Tensor>();
+  ASSERT_EQ(TensorShape(dims_mul_x), rtensor.Shape());
+  const std::vector<float> found(rtensor.Data<float>(),
+                                 rtensor.Data<float>() + expected_values_mul_y.size());
+  ASSERT_EQ(expected_values_mul_y, found);
+}
+}  // namespace
+
+TEST(ReplicaPoolTests, RunsAcrossReplicas) {
+  SessionOptions so;
+  so.session_logid = "ReplicaPoolTests.RunsAcrossReplicas";
+
+  ReplicaPool pool{so, 3, &DefaultLoggingManager()};
+  ASSERT_EQ(pool.NumReplicas(), 3u);
+  ASSERT_TRUE(pool.Load(REPLICA_MODEL_URI).IsOK());
+  ASSERT_TRUE(pool.Initialize().IsOK());
+
+  // more requests than replicas, so the rotating least-loaded pick has to
+  // route through every replica queue
+  for (int i = 0; i < 7; ++i) {
+    RunOnPool(pool);
+  }
+}
+
+TEST(ReplicaPoolTests, ConcurrentRuns) {
+  SessionOptions so;
+  so.session_logid = "ReplicaPoolTests.ConcurrentRuns";
+
+  ReplicaPool pool{so, 2, &DefaultLoggingManager()};
+  ASSERT_TRUE(pool.Load(REPLICA_MODEL_URI).IsOK());
+  ASSERT_TRUE(pool.Initialize().IsOK());
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&pool]() {
+      for (int i = 0; i < 5; ++i) {
+        RunOnPool(pool);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+}  // namespace test
+}  // namespace onnxruntime
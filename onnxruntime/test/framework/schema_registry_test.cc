@@ -0,0 +1,66 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/graph/schema_registry.h"
+
+#include "gtest/gtest.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+namespace test {
+
+static OpSchema CreateTestSchema(const char* name, int since_version) {
+  OpSchema schema(name, "unknown", 0);
+  schema.Input(0, "X", "input", "T");
+  schema.Output(0, "Y", "output", "T");
+  schema.TypeConstraint("T", {"tensor(float)"}, "float tensors only.");
+  schema.SinceVersion(since_version);
+  return schema;
+}
+
+TEST(SchemaRegistryManagerTest, CachedLookupMatchesFirstResolution) {
+  auto registry = std::make_shared<OnnxRuntimeOpSchemaRegistry>();
+  std::vector<OpSchema> schemas = {CreateTestSchema("CacheTestOp", 6)};
+  ASSERT_TRUE(registry->RegisterOpSet(schemas, kOnnxDomain, 5, 7).IsOK());
+
+  SchemaRegistryManager manager;
+  manager.RegisterRegistry(registry);
+
+  const OpSchema* first = nullptr;
+  int first_earliest = std::numeric_limits<int>::max();
+  manager.GetSchemaAndHistory("CacheTestOp", 7, kOnnxDomain, &first, &first_earliest);
+  ASSERT_NE(nullptr, first);
+  EXPECT_EQ(6, first->SinceVersion());
+
+  // The second lookup is served from the hydrated snapshot and must resolve
+  // to the identical schema instance and history.
+  const OpSchema* second = nullptr;
+  int second_earliest = std::numeric_limits<int>::max();
+  manager.GetSchemaAndHistory("CacheTestOp", 7, kOnnxDomain, &second, &second_earliest);
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(first_earliest, second_earliest);
+}
+
+TEST(SchemaRegistryManagerTest, RegisterRegistryInvalidatesCachedMiss) {
+  SchemaRegistryManager manager;
+
+  // First resolution fails and the miss is cached.
+  const OpSchema* schema = nullptr;
+  int earliest = std::numeric_limits<int>::max();
+  manager.GetSchemaAndHistory("LateRegisteredOp", 7, kOnnxDomain, &schema, &earliest);
+  EXPECT_EQ(nullptr, schema);
+
+  // Adding a registry that provides the op must drop the cached miss.
+  auto registry = std::make_shared<OnnxRuntimeOpSchemaRegistry>();
+  std::vector<OpSchema> schemas = {CreateTestSchema("LateRegisteredOp", 6)};
+  ASSERT_TRUE(registry->RegisterOpSet(schemas, kOnnxDomain, 5, 7).IsOK());
+  manager.RegisterRegistry(registry);
+
+  manager.GetSchemaAndHistory("LateRegisteredOp", 7, kOnnxDomain, &schema, &earliest);
+  ASSERT_NE(nullptr, schema);
+  EXPECT_EQ(6, schema->SinceVersion());
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,99 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/session_slot.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "core/framework/ml_value.h"
+#include "test/test_environment.h"
+#include "test_utils.h"
+#include "gtest/gtest.h"
+
+using namespace ::onnxruntime::logging;
+
+namespace onnxruntime {
+namespace test {
+
+static const std::string SLOT_MODEL_URI = "testdata/mul_1.pb";
+
+namespace {
+void RunOnSlot(SessionSlot& slot) {
+  std::vector<int64_t> dims_mul_x = {3, 2};
+  std::vector<float> values_mul_x = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  MLValue ml_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, ONNXRuntimeMemTypeDefault),
+                       dims_mul_x, values_mul_x, &ml_value);
+  NameMLValMap feeds;
+  feeds.insert(std::make_pair("X", ml_value));
+
+  std::vector<std::string> output_names{"Y"};
+  std::vector<MLValue> fetches;
+
+  RunOptions run_options;
+  common::Status st = slot.Run(run_options, feeds, output_names, &fetches);
+  ASSERT_TRUE(st.IsOK()) << st.ErrorMessage();
+
+  std::vector<float> expected_values_mul_y = {1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f};
+  ASSERT_EQ(1, fetches.size());
+  auto& rtensor = fetches.front().Get<Tensor>();
+  ASSERT_EQ(TensorShape(dims_mul_x), rtensor.Shape());
+  const std::vector<float> found(rtensor.Data<float>(),
+                                 rtensor.Data<float>() + expected_values_mul_y.size());
+  ASSERT_EQ(expected_values_mul_y, found);
+}
+}  // namespace
+
+TEST(SessionSlotTests, SwapBetweenRuns) {
+  SessionOptions so;
+  so.session_logid = "SessionSlotTests.SwapBetweenRuns";
+
+  SessionSlot slot{so, &DefaultLoggingManager()};
+  ASSERT_FALSE(slot.Run(RunOptions{}, {}, {"Y"}, nullptr).IsOK());
+
+  ASSERT_TRUE(slot.Load(SLOT_MODEL_URI).IsOK());
+  RunOnSlot(slot);
+
+  // "new version" with the same content: every weight is carried over through
+  // the shared cache and the retired session drains out.
+  auto before = slot.ActiveSession();
+  ASSERT_TRUE(slot.Swap(SLOT_MODEL_URI).IsOK());
+  ASSERT_NE(before.get(), slot.ActiveSession().get());
+  RunOnSlot(slot);
+
+  // a failed swap leaves the active version serving.
+  ASSERT_FALSE(slot.Swap("testdata/does_not_exist.pb").IsOK());
+  RunOnSlot(slot);
+}
+
+TEST(SessionSlotTests, SwapWhileServing) {
+  SessionOptions so;
+  so.session_logid = "SessionSlotTests.SwapWhileServing";
+
+  SessionSlot slot{so, &DefaultLoggingManager()};
+  ASSERT_TRUE(slot.Load(SLOT_MODEL_URI).IsOK());
+
+  std::atomic<bool> stop{false};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 2; ++t) {
+    threads.emplace_back([&slot, &stop]() {
+      while (!stop) {
+        RunOnSlot(slot);
+      }
+    });
+  }
+
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_TRUE(slot.Swap(SLOT_MODEL_URI).IsOK());
+  }
+
+  stop = true;
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+}  // namespace test
+}  // namespace onnxruntime
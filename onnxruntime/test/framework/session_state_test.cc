@@ -4,6 +4,7 @@
 #include <iostream>
 
 #include "core/framework/execution_providers.h"
+#include "core/framework/mem_pattern_planner.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/session_state.h"
 #include "core/graph/graph_viewer.h"
@@ -11,6 +12,7 @@
 #include "core/graph/op.h"
 #include "core/providers/cpu/cpu_execution_provider.h"
 #include "gtest/gtest.h"
+#include "test_utils.h"
 
 using namespace ONNX_NAMESPACE;
 using namespace std;
@@ -65,5 +67,37 @@ TEST(SessionStateTest, AddGetKernelTest) {
   std::cout << "orig: " << orig_num_outputs << " new: " << test_kernel->Node().OutputDefs().size() << std::endl;
   EXPECT_EQ(orig_num_outputs, test_kernel->Node().OutputDefs().size());
 }
+
+TEST(SessionStateTest, MemoryPatternShapeBucketingTest) {
+  ExecutionProviders execution_providers;
+  SessionState s{execution_providers};
+  s.SetMemoryPatternShapeBucketSize(32);
+
+  auto& cpu_allocator = *TestCPUExecutionProvider()->GetAllocator(0, ONNXRuntimeMemTypeDefault);
+  auto make_group = [&cpu_allocator](size_t size) {
+    auto group = std::make_unique<MemoryPatternGroup>();
+    group->locations.push_back(cpu_allocator.Info());
+    MemPatternPlanner planner;
+    planner.TraceAllocation(0, size);
+    group->patterns.push_back(planner.GenerateMemPattern());
+    return group;
+  };
+
+  // all shapes in a bucket share one cached pattern.
+  ASSERT_TRUE(s.UpdateMemoryPatternGroupCache({TensorShape({1, 100})}, make_group(100)).IsOK());
+  EXPECT_NE(s.GetMemoryPatternGroup({TensorShape({1, 97})}), nullptr);
+  EXPECT_EQ(s.GetMemoryPatternGroup({TensorShape({1, 129})}), nullptr);
+
+  // a pattern planned for larger shapes in the bucket replaces the cached one.
+  auto cached = s.GetMemoryPatternGroup({TensorShape({1, 128})});
+  ASSERT_TRUE(s.UpdateMemoryPatternGroupCache({TensorShape({1, 128})}, make_group(128)).IsOK());
+  auto replaced = s.GetMemoryPatternGroup({TensorShape({1, 128})});
+  EXPECT_NE(cached.get(), replaced.get());
+  EXPECT_EQ(replaced->patterns[0].PeakSize(), 128u);
+
+  // a smaller pattern does not evict the larger one.
+  ASSERT_TRUE(s.UpdateMemoryPatternGroupCache({TensorShape({1, 100})}, make_group(100)).IsOK());
+  EXPECT_EQ(s.GetMemoryPatternGroup({TensorShape({1, 128})}).get(), replaced.get());
+}
 }  // namespace test
 }  // namespace onnxruntime
@@ -0,0 +1,79 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/session_telemetry.h"
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(SessionTelemetryTest, EmptySnapshot) {
+  SessionTelemetry telemetry;
+  const auto snapshot = telemetry.GetSnapshot();
+  EXPECT_EQ(0u, snapshot.run_count);
+  EXPECT_EQ(0u, snapshot.failed_run_count);
+  EXPECT_EQ(0, snapshot.async_queue_depth);
+  EXPECT_EQ(0, snapshot.micro_batch_queue_depth);
+  for (int phase = 0; phase < SessionTelemetry::kPhaseCount; ++phase) {
+    EXPECT_EQ(0u, snapshot.phases[phase].count);
+    EXPECT_EQ(0, snapshot.phases[phase].p99_microseconds);
+  }
+}
+
+TEST(SessionTelemetryTest, PhasePercentiles) {
+  SessionTelemetry telemetry;
+  // 100 samples of 1..100us fill the window partially
+  for (int64_t us = 1; us <= 100; ++us) {
+    telemetry.RecordPhase(SessionTelemetry::kExecution, us);
+  }
+  auto snapshot = telemetry.GetSnapshot();
+  const auto& execution = snapshot.phases[SessionTelemetry::kExecution];
+  EXPECT_EQ(100u, execution.count);
+  EXPECT_EQ(50, execution.average_microseconds);  // 5050 / 100
+  EXPECT_EQ(51, execution.p50_microseconds);
+  EXPECT_EQ(91, execution.p90_microseconds);
+  EXPECT_EQ(100, execution.p99_microseconds);
+
+  // other phases are untouched
+  EXPECT_EQ(0u, snapshot.phases[SessionTelemetry::kValidation].count);
+  EXPECT_EQ(0u, snapshot.phases[SessionTelemetry::kFetchCopy].count);
+}
+
+TEST(SessionTelemetryTest, RollingWindowKeepsRecentSamples) {
+  SessionTelemetry telemetry;
+  // 200 samples of 1..200us wrap the 128 entry ring, leaving 73..200
+  for (int64_t us = 1; us <= 200; ++us) {
+    telemetry.RecordPhase(SessionTelemetry::kValidation, us);
+  }
+  const auto snapshot = telemetry.GetSnapshot();
+  const auto& validation = snapshot.phases[SessionTelemetry::kValidation];
+  EXPECT_EQ(200u, validation.count);
+  EXPECT_EQ(100, validation.average_microseconds);  // lifetime average
+  // percentiles come from the windowed samples only
+  EXPECT_EQ(73 + 128 * 50 / 100, validation.p50_microseconds);
+  EXPECT_EQ(73 + 128 * 90 / 100, validation.p90_microseconds);
+  EXPECT_EQ(73 + 128 * 99 / 100, validation.p99_microseconds);
+}
+
+TEST(SessionTelemetryTest, RunCountsAndQueueDepths) {
+  SessionTelemetry telemetry;
+  telemetry.RecordRunEnd(true);
+  telemetry.RecordRunEnd(false);
+  telemetry.RecordRunEnd(true);
+
+  telemetry.OnAsyncRunQueued();
+  telemetry.OnAsyncRunQueued();
+  telemetry.OnAsyncRunCompleted();
+
+  telemetry.AddMicroBatchDepth(3);
+  telemetry.AddMicroBatchDepth(-2);
+
+  const auto snapshot = telemetry.GetSnapshot();
+  EXPECT_EQ(3u, snapshot.run_count);
+  EXPECT_EQ(1u, snapshot.failed_run_count);
+  EXPECT_EQ(1, snapshot.async_queue_depth);
+  EXPECT_EQ(1, snapshot.micro_batch_queue_depth);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -216,5 +216,31 @@ TEST(TensorTest, Int64PtrConstructor) {
   EXPECT_THAT(shape.GetDims(), testing::ElementsAre(2, 3));
 }
 
+TEST(TensorTest, ShapeMovesAdoptDimsBuffer) {
+  // constructing from an rvalue vector and moving shapes around must reuse
+  // the same dims buffer instead of reallocating it.
+  std::vector<int64_t> dims{2, 3, 4};
+  const int64_t* buffer = dims.data();
+
+  TensorShape shape(std::move(dims));
+  EXPECT_EQ(shape.GetDims().data(), buffer);
+
+  TensorShape moved(std::move(shape));
+  EXPECT_EQ(moved.GetDims().data(), buffer);
+
+  TensorShape assigned;
+  assigned = std::move(moved);
+  EXPECT_EQ(assigned.GetDims().data(), buffer);
+  EXPECT_THAT(assigned.GetDims(), testing::ElementsAre(2, 3, 4));
+
+  // the tensor constructor takes the shape by value, so an rvalue shape
+  // carries its buffer all the way into the tensor.
+  auto alloc = TestCPUExecutionProvider()->GetAllocator(0, ONNXRuntimeMemTypeDefault);
+  auto data = alloc->Alloc(sizeof(float) * assigned.Size());
+  Tensor t(DataTypeImpl::GetType<float>(), std::move(assigned), data, alloc->Info());
+  EXPECT_EQ(t.Shape().GetDims().data(), buffer);
+  alloc->Free(data);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
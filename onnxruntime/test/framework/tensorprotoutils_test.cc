@@ -4,9 +4,13 @@
 #include "core/platform/env.h"
 #include "core/framework/tensor.h"
 #include "core/graph/onnx_protobuf.h"
+#include "core/framework/external_data_loader.h"
 #include "core/framework/tensorprotoutils.h"
+#include "core/framework/string_tensor_arena.h"
 #include "gtest/gtest.h"
 #include <google/protobuf/io/zero_copy_stream_impl.h>
+#include <cstdio>
+#include <fstream>
 #include <sstream>
 
 namespace onnxruntime {
@@ -27,5 +31,85 @@ TEST(TensorProtoUtilsTest, test1) {
   ASSERT_TRUE(st.IsOK());
 }
 #endif
+
+TEST(TensorProtoUtilsTest, StringTensorArenaBacking) {
+  ONNX_NAMESPACE::TensorProto proto;
+  proto.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_STRING);
+  proto.add_dims(4);
+  proto.add_string_data("a");
+  proto.add_string_data("");
+  proto.add_string_data("feature=hash");
+  proto.add_string_data("a string long enough to defeat the small string optimization");
+
+  std::unique_ptr<Tensor> tensor;
+  ::onnxruntime::AllocatorPtr cpu_allocator = std::make_shared<::onnxruntime::CPUAllocator>();
+  common::Status st = ::onnxruntime::utils::GetTensorFromTensorProto(proto, &tensor, cpu_allocator);
+  ASSERT_TRUE(st.IsOK()) << st.ErrorMessage();
+
+  // the std::string compatibility view holds the expected values
+  const std::string* data = tensor->Data<std::string>();
+  EXPECT_EQ(data[0], "a");
+  EXPECT_EQ(data[1], "");
+  EXPECT_EQ(data[2], "feature=hash");
+
+  // the arena view holds the same values in one contiguous character pool
+  const StringTensorArena* arena = tensor->StringArena();
+  ASSERT_TRUE(arena != nullptr);
+  ASSERT_EQ(arena->Count(), static_cast<size_t>(4));
+  size_t total_chars = 0;
+  for (size_t i = 0; i < arena->Count(); ++i) {
+    EXPECT_EQ(std::string(arena->Data(i), arena->Length(i)), data[i]);
+    total_chars += arena->Length(i);
+  }
+  EXPECT_EQ(arena->CharacterPool().size(), total_chars);
+}
+
+TEST(TensorProtoUtilsTest, ExternalDataTensor) {
+  const char* payload_file = "tensorprotoutils_external_data_test.bin";
+  const std::vector<float> values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  const size_t payload_offset = 16;  // payload starts past a leading pad
+  {
+    std::ofstream stream(payload_file, std::ios::binary);
+    const std::vector<char> pad(payload_offset, '\0');
+    stream.write(pad.data(), static_cast<std::streamsize>(pad.size()));
+    stream.write(reinterpret_cast<const char*>(values.data()),
+                 static_cast<std::streamsize>(values.size() * sizeof(float)));
+  }
+
+  ONNX_NAMESPACE::TensorProto proto;
+  proto.set_name("external_weight");
+  proto.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  proto.add_dims(2);
+  proto.add_dims(3);
+  proto.set_data_location(ONNX_NAMESPACE::TensorProto_DataLocation_EXTERNAL);
+  auto add_entry = [&proto](const char* key, const std::string& value) {
+    auto* entry = proto.add_external_data();
+    entry->set_key(key);
+    entry->set_value(value);
+  };
+  add_entry("location", payload_file);
+  add_entry("offset", std::to_string(payload_offset));
+  add_entry("length", std::to_string(values.size() * sizeof(float)));
+
+  ASSERT_TRUE(::onnxruntime::utils::HasExternalData(proto));
+
+  std::unique_ptr<Tensor> tensor;
+  ::onnxruntime::AllocatorPtr cpu_allocator = std::make_shared<::onnxruntime::CPUAllocator>();
+  common::Status st = ::onnxruntime::utils::GetTensorFromTensorProto(proto, &tensor, cpu_allocator,
+                                                                     nullptr, 0, ".");
+  ASSERT_TRUE(st.IsOK()) << st.ErrorMessage();
+  ASSERT_EQ(tensor->Shape().Size(), 6);
+  const std::vector<float> found(tensor->Data<float>(), tensor->Data<float>() + values.size());
+  EXPECT_EQ(values, found);
+
+  // a location reaching outside the model directory is rejected
+  proto.mutable_external_data(0)->set_value("../outside.bin");
+  std::unique_ptr<Tensor> rejected;
+  EXPECT_FALSE(::onnxruntime::utils::GetTensorFromTensorProto(proto, &rejected, cpu_allocator,
+                                                              nullptr, 0, ".")
+                   .IsOK());
+
+  std::remove(payload_file);
+}
 }  // namespace test
 }  // namespace onnxruntime
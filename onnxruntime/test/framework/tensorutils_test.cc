@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/framework/tensorutils.h"
+#include "core/framework/weight_compression.h"
 #include "core/graph/onnx_protobuf.h"
 #include "gtest/gtest.h"
 
@@ -63,5 +64,39 @@ TEST(TensorParseTest, TensorUtilsTest) {
   status = TensorUtils::UnpackTensor(bool_tensor_proto, string_data, 2);
   EXPECT_FALSE(status.IsOK());
 }
+
+TEST(TensorParseTest, CompressedWeightPayload) {
+  // repetitive data so the LZ77 codec actually shrinks it
+  std::vector<float> weights(4096);
+  for (size_t i = 0; i < weights.size(); ++i) {
+    weights[i] = static_cast<float>(i % 16) * 0.5f;
+  }
+  const size_t raw_bytes = weights.size() * sizeof(float);
+
+  std::string payload;
+  auto status = CompressWeightPayload(weights.data(), raw_bytes, payload);
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+  EXPECT_TRUE(HasCompressedWeightPayload(payload));
+  EXPECT_LT(payload.size(), raw_bytes);
+
+  TensorProto tensor_proto;
+  tensor_proto.set_data_type(TensorProto_DataType_FLOAT);
+  tensor_proto.set_raw_data(payload);
+
+  std::vector<float> unpacked(weights.size());
+  status = TensorUtils::UnpackTensor(tensor_proto, unpacked.data(), unpacked.size());
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+  EXPECT_EQ(weights, unpacked);
+
+  // a truncated payload must fail cleanly, not write short
+  tensor_proto.set_raw_data(payload.substr(0, payload.size() - 8));
+  status = TensorUtils::UnpackTensor(tensor_proto, unpacked.data(), unpacked.size());
+  EXPECT_FALSE(status.IsOK());
+
+  // a payload for a different element count must be rejected
+  tensor_proto.set_raw_data(payload);
+  status = TensorUtils::UnpackTensor(tensor_proto, unpacked.data(), unpacked.size() - 1);
+  EXPECT_FALSE(status.IsOK());
+}
 }  // namespace test
 }  // namespace onnxruntime
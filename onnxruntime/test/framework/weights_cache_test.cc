@@ -0,0 +1,89 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/weights_cache.h"
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+common::Status CreateIntValue(int value, MLValue& mlvalue) {
+  mlvalue.Init(new int(value),
+               DataTypeImpl::GetType<int>(),
+               DataTypeImpl::GetType<int>()->GetDeleteFunc());
+  return common::Status::OK();
+}
+}  // namespace
+
+TEST(WeightsCacheTest, SecondLookupReturnsCachedValue) {
+  auto& cache = WeightsCache::Instance();
+  cache.AddSessionRef("model_a");
+
+  int create_calls = 0;
+  auto create_fn = [&create_calls](MLValue& v) {
+    ++create_calls;
+    return CreateIntValue(42, v);
+  };
+
+  MLValue first;
+  ASSERT_TRUE(cache.GetOrCreate("model_a", "weight", create_fn, first).IsOK());
+  MLValue second;
+  ASSERT_TRUE(cache.GetOrCreate("model_a", "weight", create_fn, second).IsOK());
+
+  EXPECT_EQ(1, create_calls);
+  // both values share the same underlying buffer
+  EXPECT_EQ(&first.Get<int>(), &second.Get<int>());
+  EXPECT_EQ(42, second.Get<int>());
+
+  cache.ReleaseSession("model_a");
+}
+
+TEST(WeightsCacheTest, KeysAreIsolated) {
+  auto& cache = WeightsCache::Instance();
+  cache.AddSessionRef("model_b");
+  cache.AddSessionRef("model_c");
+
+  MLValue b, c;
+  ASSERT_TRUE(cache.GetOrCreate("model_b", "weight", [](MLValue& v) { return CreateIntValue(1, v); }, b).IsOK());
+  ASSERT_TRUE(cache.GetOrCreate("model_c", "weight", [](MLValue& v) { return CreateIntValue(2, v); }, c).IsOK());
+
+  EXPECT_EQ(1, b.Get<int>());
+  EXPECT_EQ(2, c.Get<int>());
+
+  cache.ReleaseSession("model_b");
+  cache.ReleaseSession("model_c");
+}
+
+TEST(WeightsCacheTest, EntriesDroppedWhenLastSessionReleases) {
+  auto& cache = WeightsCache::Instance();
+  cache.AddSessionRef("model_d");
+  cache.AddSessionRef("model_d");
+
+  int create_calls = 0;
+  auto create_fn = [&create_calls](MLValue& v) {
+    ++create_calls;
+    return CreateIntValue(7, v);
+  };
+
+  MLValue value;
+  ASSERT_TRUE(cache.GetOrCreate("model_d", "weight", create_fn, value).IsOK());
+
+  // still one session holding the key: the weight stays cached
+  cache.ReleaseSession("model_d");
+  MLValue again;
+  ASSERT_TRUE(cache.GetOrCreate("model_d", "weight", create_fn, again).IsOK());
+  EXPECT_EQ(1, create_calls);
+
+  // last session gone: the weight is dropped and recreated on next use
+  cache.ReleaseSession("model_d");
+  cache.AddSessionRef("model_d");
+  MLValue recreated;
+  ASSERT_TRUE(cache.GetOrCreate("model_d", "weight", create_fn, recreated).IsOK());
+  EXPECT_EQ(2, create_calls);
+  cache.ReleaseSession("model_d");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
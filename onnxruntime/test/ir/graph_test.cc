@@ -740,6 +740,60 @@ TEST(ResolvingGraphTest, GraphConstruction_TypeInference) {
   EXPECT_EQ("node_4_out_1", graph_proto.output(0).name());
 }
 
+TEST(ResolvingGraphTest, GraphConstruction_ScopedReResolve) {
+  ASSERT_TRUE(kSchemasRegistered);
+
+  Model model("graph_scoped_resolve");
+  auto& graph = model.MainGraph();
+
+  TypeProto tensor_int32;
+  tensor_int32.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT32);
+  tensor_int32.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+  std::vector<NodeArg*> inputs;
+  std::vector<NodeArg*> outputs;
+
+  auto& input_arg = graph.GetOrCreateNodeArg("node_1_in_1", &tensor_int32);
+  inputs.push_back(&input_arg);
+  auto& output_arg = graph.GetOrCreateNodeArg("node_1_out_1", &tensor_int32);
+  outputs.push_back(&output_arg);
+  graph.AddNode("node_1", "Variable2_Fake", "node 1", inputs, outputs);
+
+  inputs.clear();
+  inputs.push_back(&output_arg);
+  auto& output_arg2 = graph.GetOrCreateNodeArg("node_2_out_1", &tensor_int32);
+  outputs.clear();
+  outputs.push_back(&output_arg2);
+  graph.AddNode("node_2", "Variable2_Fake", "node 2", inputs, outputs);
+
+  auto status = graph.Resolve();
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+  EXPECT_EQ(1, graph.GetOutputs().size());
+  EXPECT_EQ("node_2_out_1", graph.GetOutputs()[0]->Name());
+
+  // a node-scoped change after the first resolve: append a consumer of the
+  // current graph output. the re-resolve only re-verifies the new node and
+  // anything downstream, but must still move the graph output.
+  inputs.clear();
+  inputs.push_back(&output_arg2);
+  auto& output_arg3 = graph.GetOrCreateNodeArg("node_3_out_1", nullptr);
+  outputs.clear();
+  outputs.push_back(&output_arg3);
+  graph.AddNode("node_3", "Variable2_Fake", "node 3", inputs, outputs);
+
+  status = graph.Resolve();
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+  EXPECT_EQ(1, graph.GetOutputs().size());
+  EXPECT_EQ("node_3_out_1", graph.GetOutputs()[0]->Name());
+  // type inference must have run for the appended node.
+  ASSERT_TRUE(output_arg3.Type() != nullptr);
+  EXPECT_EQ("tensor(int32)", *output_arg3.Type());
+
+  // a resolve with nothing marked is a no-op.
+  status = graph.Resolve();
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+}
+
 TEST(TestAddAttribute, AddTensorAttribute) {
   OPERATOR_SCHEMA(__Constant)
       .SetDoc("Constant Op.")
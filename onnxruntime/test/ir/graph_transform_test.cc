@@ -11,6 +11,18 @@
 #include "core/graph/conv_mul_fusion.h"
 #include "core/graph/conv_add_fusion.h"
 #include "core/graph/conv_activation_fusion.h"
+#include "core/graph/matmul_add_fusion.h"
+#include "core/graph/gemm_activation_fusion.h"
+#include "core/graph/elementwise_fusion.h"
+#include "core/graph/gru_fusion.h"
+#include "core/graph/layer_norm_fusion.h"
+#include "core/graph/embed_bag_fusion.h"
+#include "core/graph/qlinear_matmul_fusion.h"
+#include "core/graph/graph_cleanup.h"
+#include "core/graph/space_to_depth_conv_fusion.h"
+#include "core/graph/index_narrowing.h"
+#include "core/graph/zipmap_elision.h"
+#include "core/session/constant_folding.h"
 #include "core/platform/env.h"
 
 #include "test/capturing_sink.h"
@@ -194,5 +206,784 @@ TEST(GraphTransformationTests, FuseConvAddMul3D) {
   ASSERT_TRUE(session_object.Initialize().IsOK());
 }
 
+TEST(GraphTransformationTests, GemmFusion) {
+  // x --\
+  //      MatMul --> Add --> Relu --> Identity --> y
+  // w --/           /
+  //           bias /
+  // MatMul+Add fuse into Gemm, then the Relu epilogue fuses into FusedGemm.
+  Model model("GemmFusionTest");
+  auto& graph = model.MainGraph();
+
+  TypeProto matrix_2x3;
+  matrix_2x3.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  matrix_2x3.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  matrix_2x3.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+
+  TypeProto matrix_3x4;
+  matrix_3x4.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  matrix_3x4.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+  matrix_3x4.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+
+  TypeProto vector_4;
+  vector_4.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  vector_4.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+
+  auto& arg_x = graph.GetOrCreateNodeArg("x", &matrix_2x3);
+  auto& arg_w = graph.GetOrCreateNodeArg("w", &matrix_3x4);
+  auto& arg_bias = graph.GetOrCreateNodeArg("bias", &vector_4);
+  auto& arg_mm = graph.GetOrCreateNodeArg("mm_out", nullptr);
+  auto& arg_add = graph.GetOrCreateNodeArg("add_out", nullptr);
+  auto& arg_relu = graph.GetOrCreateNodeArg("relu_out", nullptr);
+  auto& arg_y = graph.GetOrCreateNodeArg("y", nullptr);
+
+  graph.AddNode("mm", "MatMul", "matmul", {&arg_x, &arg_w}, {&arg_mm});
+  graph.AddNode("add", "Add", "bias add", {&arg_mm, &arg_bias}, {&arg_add});
+  graph.AddNode("relu", "Relu", "activation", {&arg_add}, {&arg_relu});
+  graph.AddNode("out", "Identity", "output", {&arg_relu}, {&arg_y});
+  ASSERT_TRUE(graph.Resolve().IsOK());
+  ASSERT_EQ(graph.NumberOfNodes(), 4);
+
+  MatMulAddFusion matmul_add_fusion;
+  bool modified = false;
+  ASSERT_TRUE(matmul_add_fusion.Apply(graph, modified).IsOK());
+  ASSERT_TRUE(modified);
+  ASSERT_EQ(graph.NumberOfNodes(), 3);
+
+  const Node* gemm_node = nullptr;
+  for (const auto& node : graph.Nodes()) {
+    if (node.OpType() == "Gemm") {
+      gemm_node = &node;
+    }
+  }
+  ASSERT_TRUE(gemm_node != nullptr);
+  ASSERT_EQ(gemm_node->InputDefs().size(), 3);
+  ASSERT_EQ(gemm_node->InputDefs()[2]->Name(), "bias");
+
+  GemmActivationFusion gemm_activation_fusion;
+  modified = false;
+  ASSERT_TRUE(gemm_activation_fusion.Apply(graph, modified).IsOK());
+  ASSERT_TRUE(modified);
+  ASSERT_EQ(graph.NumberOfNodes(), 2);
+
+  const Node* fused_gemm_node = nullptr;
+  for (const auto& node : graph.Nodes()) {
+    if (node.OpType() == "FusedGemm") {
+      fused_gemm_node = &node;
+    }
+  }
+  ASSERT_TRUE(fused_gemm_node != nullptr);
+  ASSERT_EQ(fused_gemm_node->Domain(), "com.microsoft");
+  const auto& attrs = fused_gemm_node->GetAttributes();
+  auto activation_attr = attrs.find("activation");
+  ASSERT_TRUE(activation_attr != attrs.end());
+  ASSERT_EQ(activation_attr->second.s(), "Relu");
+}
+
+TEST(GraphTransformationTests, FuseElementwiseChain) {
+  // x --\
+  //      Add --> Mul --> Sigmoid --> Mul --> y
+  // b --/       /                   /
+  //          c /                 d /
+  // the whole chain collapses into one FusedElementwise node.
+  Model model("ElementwiseFusionTest");
+  auto& graph = model.MainGraph();
+
+  TypeProto matrix_2x3;
+  matrix_2x3.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  matrix_2x3.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  matrix_2x3.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+
+  auto& arg_x = graph.GetOrCreateNodeArg("x", &matrix_2x3);
+  auto& arg_b = graph.GetOrCreateNodeArg("b", &matrix_2x3);
+  auto& arg_c = graph.GetOrCreateNodeArg("c", &matrix_2x3);
+  auto& arg_d = graph.GetOrCreateNodeArg("d", &matrix_2x3);
+  auto& arg_add = graph.GetOrCreateNodeArg("add_out", &matrix_2x3);
+  auto& arg_mul = graph.GetOrCreateNodeArg("mul_out", &matrix_2x3);
+  auto& arg_sig = graph.GetOrCreateNodeArg("sig_out", &matrix_2x3);
+  auto& arg_y = graph.GetOrCreateNodeArg("y", &matrix_2x3);
+
+  graph.AddNode("add", "Add", "add", {&arg_x, &arg_b}, {&arg_add});
+  graph.AddNode("mul", "Mul", "scale", {&arg_add, &arg_c}, {&arg_mul});
+  graph.AddNode("sig", "Sigmoid", "activation", {&arg_mul}, {&arg_sig});
+  graph.AddNode("mul2", "Mul", "gate", {&arg_sig, &arg_d}, {&arg_y});
+  ASSERT_TRUE(graph.Resolve().IsOK());
+  ASSERT_EQ(graph.NumberOfNodes(), 4);
+
+  ElementwiseFusion elementwise_fusion;
+  bool modified = false;
+  ASSERT_TRUE(elementwise_fusion.Apply(graph, modified).IsOK());
+  ASSERT_TRUE(modified);
+  ASSERT_EQ(graph.NumberOfNodes(), 1);
+
+  const Node* fused_node = nullptr;
+  for (const auto& node : graph.Nodes()) {
+    if (node.OpType() == "FusedElementwise") {
+      fused_node = &node;
+    }
+  }
+  ASSERT_TRUE(fused_node != nullptr);
+  ASSERT_EQ(fused_node->Domain(), "com.microsoft");
+  ASSERT_EQ(fused_node->InputDefs().size(), 4);
+  ASSERT_EQ(fused_node->InputDefs()[0]->Name(), "x");
+  ASSERT_EQ(fused_node->InputDefs()[1]->Name(), "b");
+  ASSERT_EQ(fused_node->InputDefs()[2]->Name(), "c");
+  ASSERT_EQ(fused_node->InputDefs()[3]->Name(), "d");
+  ASSERT_EQ(fused_node->OutputDefs()[0]->Name(), "y");
+
+  const auto& attrs = fused_node->GetAttributes();
+  auto ops_attr = attrs.find("ops");
+  ASSERT_TRUE(ops_attr != attrs.end());
+  ASSERT_EQ(ops_attr->second.strings_size(), 4);
+  ASSERT_EQ(ops_attr->second.strings(0), "Add");
+  ASSERT_EQ(ops_attr->second.strings(1), "Mul");
+  ASSERT_EQ(ops_attr->second.strings(2), "Sigmoid");
+  ASSERT_EQ(ops_attr->second.strings(3), "Mul");
+}
+
+TEST(GraphTransformationTests, FuseQLinearMatMul) {
+  // a --> DequantizeLinear --\
+  //                           MatMul --> QuantizeLinear --> y
+  // b --> DequantizeLinear --/
+  // the sandwich collapses into one QLinearMatMul node.
+  Model model("QLinearMatMulFusionTest");
+  auto& graph = model.MainGraph();
+
+  TypeProto uint8_2x3;
+  uint8_2x3.mutable_tensor_type()->set_elem_type(TensorProto_DataType_UINT8);
+  uint8_2x3.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  uint8_2x3.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+
+  TypeProto uint8_3x4;
+  uint8_3x4.mutable_tensor_type()->set_elem_type(TensorProto_DataType_UINT8);
+  uint8_3x4.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+  uint8_3x4.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+
+  TypeProto float_scalar;
+  float_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_scalar.mutable_tensor_type()->mutable_shape();
+
+  TypeProto uint8_scalar;
+  uint8_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_UINT8);
+  uint8_scalar.mutable_tensor_type()->mutable_shape();
+
+  auto& arg_a = graph.GetOrCreateNodeArg("a", &uint8_2x3);
+  auto& arg_a_scale = graph.GetOrCreateNodeArg("a_scale", &float_scalar);
+  auto& arg_a_zp = graph.GetOrCreateNodeArg("a_zp", &uint8_scalar);
+  auto& arg_b = graph.GetOrCreateNodeArg("b", &uint8_3x4);
+  auto& arg_b_scale = graph.GetOrCreateNodeArg("b_scale", &float_scalar);
+  auto& arg_b_zp = graph.GetOrCreateNodeArg("b_zp", &uint8_scalar);
+  auto& arg_y_scale = graph.GetOrCreateNodeArg("y_scale", &float_scalar);
+  auto& arg_y_zp = graph.GetOrCreateNodeArg("y_zp", &uint8_scalar);
+  auto& arg_a_f = graph.GetOrCreateNodeArg("a_float", nullptr);
+  auto& arg_b_f = graph.GetOrCreateNodeArg("b_float", nullptr);
+  auto& arg_mm = graph.GetOrCreateNodeArg("mm_out", nullptr);
+  auto& arg_y = graph.GetOrCreateNodeArg("y", nullptr);
+
+  graph.AddNode("dq_a", "DequantizeLinear", "dequantize a",
+                {&arg_a, &arg_a_scale, &arg_a_zp}, {&arg_a_f}, nullptr, kMSDomain);
+  graph.AddNode("dq_b", "DequantizeLinear", "dequantize b",
+                {&arg_b, &arg_b_scale, &arg_b_zp}, {&arg_b_f}, nullptr, kMSDomain);
+  graph.AddNode("mm", "MatMul", "matmul", {&arg_a_f, &arg_b_f}, {&arg_mm});
+  graph.AddNode("q_y", "QuantizeLinear", "quantize the product",
+                {&arg_mm, &arg_y_scale, &arg_y_zp}, {&arg_y}, nullptr, kMSDomain);
+  ASSERT_TRUE(graph.Resolve().IsOK());
+  ASSERT_EQ(graph.NumberOfNodes(), 4);
+
+  QLinearMatMulFusion qlinear_fusion;
+  bool modified = false;
+  ASSERT_TRUE(qlinear_fusion.Apply(graph, modified).IsOK());
+  ASSERT_TRUE(modified);
+  ASSERT_EQ(graph.NumberOfNodes(), 1);
+
+  const Node* fused_node = nullptr;
+  for (const auto& node : graph.Nodes()) {
+    if (node.OpType() == "QLinearMatMul") {
+      fused_node = &node;
+    }
+  }
+  ASSERT_TRUE(fused_node != nullptr);
+  ASSERT_EQ(fused_node->Domain(), "com.microsoft");
+  ASSERT_EQ(fused_node->InputDefs().size(), 8);
+  ASSERT_EQ(fused_node->InputDefs()[0]->Name(), "a");
+  ASSERT_EQ(fused_node->InputDefs()[3]->Name(), "b");
+  ASSERT_EQ(fused_node->InputDefs()[6]->Name(), "y_scale");
+  ASSERT_EQ(fused_node->InputDefs()[7]->Name(), "y_zp");
+  ASSERT_EQ(fused_node->OutputDefs()[0]->Name(), "y");
+}
+
+TEST(GraphTransformationTests, FuseLayerNorm) {
+  // x --> ReduceMean --> Sub --> Pow --> ReduceMean --> Add(eps) --> Sqrt
+  //        \------------/   \---------------------------------------> Div
+  // --> Mul(scale) --> Add(bias) --> y
+  // the nine-op cluster collapses into one LayerNormalization node.
+  Model model("LayerNormFusionTest");
+  auto& graph = model.MainGraph();
+
+  TypeProto float_2x4;
+  float_2x4.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_2x4.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  float_2x4.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+
+  TypeProto float_4;
+  float_4.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_4.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+
+  TypeProto float_scalar;
+  float_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_scalar.mutable_tensor_type()->mutable_shape();
+
+  auto& arg_x = graph.GetOrCreateNodeArg("x", &float_2x4);
+  auto& arg_scale = graph.GetOrCreateNodeArg("scale", &float_4);
+  auto& arg_bias = graph.GetOrCreateNodeArg("bias", &float_4);
+  auto& arg_two = graph.GetOrCreateNodeArg("two", &float_scalar);
+  auto& arg_eps = graph.GetOrCreateNodeArg("eps", &float_scalar);
+  auto& arg_mean = graph.GetOrCreateNodeArg("mean", nullptr);
+  auto& arg_d = graph.GetOrCreateNodeArg("d", nullptr);
+  auto& arg_sq = graph.GetOrCreateNodeArg("sq", nullptr);
+  auto& arg_var = graph.GetOrCreateNodeArg("var", nullptr);
+  auto& arg_var_eps = graph.GetOrCreateNodeArg("var_eps", nullptr);
+  auto& arg_std = graph.GetOrCreateNodeArg("std", nullptr);
+  auto& arg_norm = graph.GetOrCreateNodeArg("norm", nullptr);
+  auto& arg_scaled = graph.GetOrCreateNodeArg("scaled", nullptr);
+  auto& arg_y = graph.GetOrCreateNodeArg("y", nullptr);
+
+  TensorProto two_tensor;
+  two_tensor.set_name("two");
+  two_tensor.set_data_type(TensorProto_DataType_FLOAT);
+  two_tensor.add_float_data(2.0f);
+  graph.AddInitializedTensor(two_tensor);
+
+  TensorProto eps_tensor;
+  eps_tensor.set_name("eps");
+  eps_tensor.set_data_type(TensorProto_DataType_FLOAT);
+  eps_tensor.add_float_data(1e-5f);
+  graph.AddInitializedTensor(eps_tensor);
+
+  auto& rm1 = graph.AddNode("rm1", "ReduceMean", "mean", {&arg_x}, {&arg_mean});
+  rm1.AddAttribute("axes", std::vector<int64_t>{-1});
+  graph.AddNode("sub", "Sub", "center", {&arg_x, &arg_mean}, {&arg_d});
+  graph.AddNode("pow", "Pow", "square", {&arg_d, &arg_two}, {&arg_sq});
+  auto& rm2 = graph.AddNode("rm2", "ReduceMean", "variance", {&arg_sq}, {&arg_var});
+  rm2.AddAttribute("axes", std::vector<int64_t>{-1});
+  graph.AddNode("add_eps", "Add", "stabilize", {&arg_var, &arg_eps}, {&arg_var_eps});
+  graph.AddNode("sqrt", "Sqrt", "stddev", {&arg_var_eps}, {&arg_std});
+  graph.AddNode("div", "Div", "normalize", {&arg_d, &arg_std}, {&arg_norm});
+  graph.AddNode("mul", "Mul", "scale", {&arg_norm, &arg_scale}, {&arg_scaled});
+  graph.AddNode("add_bias", "Add", "shift", {&arg_scaled, &arg_bias}, {&arg_y});
+  ASSERT_TRUE(graph.Resolve().IsOK());
+  ASSERT_EQ(graph.NumberOfNodes(), 9);
+
+  LayerNormFusion layer_norm_fusion;
+  bool modified = false;
+  ASSERT_TRUE(layer_norm_fusion.Apply(graph, modified).IsOK());
+  ASSERT_TRUE(modified);
+  ASSERT_EQ(graph.NumberOfNodes(), 1);
+
+  const Node* fused_node = nullptr;
+  for (const auto& node : graph.Nodes()) {
+    if (node.OpType() == "LayerNormalization") {
+      fused_node = &node;
+    }
+  }
+  ASSERT_TRUE(fused_node != nullptr);
+  ASSERT_EQ(fused_node->Domain(), "com.microsoft");
+  ASSERT_EQ(fused_node->InputDefs().size(), 3);
+  ASSERT_EQ(fused_node->InputDefs()[0]->Name(), "x");
+  ASSERT_EQ(fused_node->InputDefs()[1]->Name(), "scale");
+  ASSERT_EQ(fused_node->InputDefs()[2]->Name(), "bias");
+  ASSERT_EQ(fused_node->OutputDefs()[0]->Name(), "y");
+  ASSERT_EQ(fused_node->GetAttributes().at("axis").i(), -1);
+  ASSERT_FLOAT_EQ(fused_node->GetAttributes().at("epsilon").f(), 1e-5f);
+}
+
+TEST(GraphTransformationTests, FuseEmbedBag) {
+  // table, indices --> Gather --> ReduceSum(axes={bag axis}) --> y
+  // collapses into one EmbeddingBag node carrying the reduce's keepdims.
+  Model model("EmbedBagFusionTest");
+  auto& graph = model.MainGraph();
+
+  TypeProto float_6x2;
+  float_6x2.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_6x2.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(6);
+  float_6x2.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+  TypeProto int64_2x3;
+  int64_2x3.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+  int64_2x3.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  int64_2x3.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+
+  auto& arg_table = graph.GetOrCreateNodeArg("table", &float_6x2);
+  auto& arg_indices = graph.GetOrCreateNodeArg("indices", &int64_2x3);
+  auto& arg_gathered = graph.GetOrCreateNodeArg("gathered", nullptr);
+  auto& arg_y = graph.GetOrCreateNodeArg("y", nullptr);
+
+  graph.AddNode("gather", "Gather", "lookup", {&arg_table, &arg_indices}, {&arg_gathered});
+  auto& reduce = graph.AddNode("reduce", "ReduceSum", "bag sum", {&arg_gathered}, {&arg_y});
+  reduce.AddAttribute("axes", std::vector<int64_t>{1});
+  reduce.AddAttribute("keepdims", static_cast<int64_t>(0));
+  ASSERT_TRUE(graph.Resolve().IsOK());
+  ASSERT_EQ(graph.NumberOfNodes(), 2);
+
+  EmbedBagFusion embed_bag_fusion;
+  bool modified = false;
+  ASSERT_TRUE(embed_bag_fusion.Apply(graph, modified).IsOK());
+  ASSERT_TRUE(modified);
+  ASSERT_EQ(graph.NumberOfNodes(), 1);
+
+  const Node* fused_node = nullptr;
+  for (const auto& node : graph.Nodes()) {
+    if (node.OpType() == "EmbeddingBag") {
+      fused_node = &node;
+    }
+  }
+  ASSERT_TRUE(fused_node != nullptr);
+  ASSERT_EQ(fused_node->Domain(), "com.microsoft");
+  ASSERT_EQ(fused_node->InputDefs().size(), 2);
+  ASSERT_EQ(fused_node->InputDefs()[0]->Name(), "table");
+  ASSERT_EQ(fused_node->InputDefs()[1]->Name(), "indices");
+  ASSERT_EQ(fused_node->OutputDefs()[0]->Name(), "y");
+  ASSERT_EQ(fused_node->GetAttributes().at("mode").s(), "sum");
+  ASSERT_EQ(fused_node->GetAttributes().at("keepdims").i(), 0);
+}
+
+TEST(GraphTransformationTests, ElideZipMapOutput) {
+  // scores --> ZipMap --> Z (seq of maps, graph output)
+  // becomes a "Z_labels" initializer output plus an Identity producing
+  // "Z_scores", with the ZipMap node gone.
+  Model model("ZipMapElisionTest");
+  auto& graph = model.MainGraph();
+
+  TypeProto matrix_2x3;
+  matrix_2x3.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  matrix_2x3.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  matrix_2x3.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+
+  TypeProto seq_map_int64_float;
+  auto* map_type = seq_map_int64_float.mutable_sequence_type()->mutable_elem_type()->mutable_map_type();
+  map_type->set_key_type(TensorProto_DataType_INT64);
+  map_type->mutable_value_type()->mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+
+  auto& arg_scores = graph.GetOrCreateNodeArg("scores", &matrix_2x3);
+  auto& arg_z = graph.GetOrCreateNodeArg("Z", &seq_map_int64_float);
+
+  auto& zipmap_node = graph.AddNode("zipmap", "ZipMap", "label the scores",
+                                    {&arg_scores}, {&arg_z}, nullptr, kMLDomain);
+  zipmap_node.AddAttribute("classlabels_int64s", std::vector<int64_t>{10, 20, 30});
+  ASSERT_TRUE(graph.Resolve().IsOK());
+
+  // the elision rewrites the declared graph outputs, which is only supported
+  // for graphs loaded from a model file, so round-trip through the proto.
+  auto model_proto = model.ToProto();
+  Model loaded_model(model_proto);
+  auto& loaded_graph = loaded_model.MainGraph();
+  ASSERT_TRUE(loaded_graph.Resolve().IsOK());
+
+  ZipMapElision zipmap_elision;
+  bool modified = false;
+  ASSERT_TRUE(zipmap_elision.Apply(loaded_graph, modified).IsOK());
+  ASSERT_TRUE(modified);
+  ASSERT_TRUE(loaded_graph.Resolve().IsOK());
+
+  for (const auto& node : loaded_graph.Nodes()) {
+    ASSERT_NE(node.OpType(), "ZipMap");
+  }
+
+  const auto& outputs = loaded_graph.GetOutputs();
+  ASSERT_EQ(outputs.size(), 2);
+  ASSERT_EQ(outputs[0]->Name(), "Z_labels");
+  ASSERT_EQ(outputs[1]->Name(), "Z_scores");
+
+  const TensorProto* labels_tensor = nullptr;
+  ASSERT_TRUE(loaded_graph.GetInitializedTensor("Z_labels", labels_tensor));
+  ASSERT_EQ(labels_tensor->data_type(), TensorProto_DataType_INT64);
+  ASSERT_EQ(labels_tensor->int64_data_size(), 3);
+  ASSERT_EQ(labels_tensor->int64_data(0), 10);
+  ASSERT_EQ(labels_tensor->int64_data(2), 30);
+
+  const Node* identity_node = nullptr;
+  for (const auto& node : loaded_graph.Nodes()) {
+    if (node.OpType() == "Identity") {
+      identity_node = &node;
+    }
+  }
+  ASSERT_TRUE(identity_node != nullptr);
+  ASSERT_EQ(identity_node->InputDefs()[0]->Name(), "scores");
+  ASSERT_EQ(identity_node->OutputDefs()[0]->Name(), "Z_scores");
+}
+
+TEST(GraphTransformationTests, FuseGruStack) {
+  // x --> GRU --> Squeeze(axes=[1]) --> GRU --> y
+  // two stacked forward GRU layers collapse into one FusedGru node.
+  Model model("GruFusionTest");
+  auto& graph = model.MainGraph();
+
+  auto make_float_type = [](std::initializer_list<int64_t> dims) {
+    TypeProto type;
+    type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+    for (auto dim : dims) {
+      type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+    }
+    return type;
+  };
+
+  // seq_length = 4, batch_size = 2, input_size = 3, hidden sizes 5 then 4
+  TypeProto type_x = make_float_type({4, 2, 3});
+  TypeProto type_w1 = make_float_type({1, 15, 3});
+  TypeProto type_r1 = make_float_type({1, 15, 5});
+  TypeProto type_b1 = make_float_type({1, 30});
+  TypeProto type_y1 = make_float_type({4, 1, 2, 5});
+  TypeProto type_sq = make_float_type({4, 2, 5});
+  TypeProto type_w2 = make_float_type({1, 12, 5});
+  TypeProto type_r2 = make_float_type({1, 12, 4});
+  TypeProto type_b2 = make_float_type({1, 24});
+  TypeProto type_y = make_float_type({4, 1, 2, 4});
+
+  auto& arg_x = graph.GetOrCreateNodeArg("x", &type_x);
+  auto& arg_w1 = graph.GetOrCreateNodeArg("w1", &type_w1);
+  auto& arg_r1 = graph.GetOrCreateNodeArg("r1", &type_r1);
+  auto& arg_b1 = graph.GetOrCreateNodeArg("b1", &type_b1);
+  auto& arg_y1 = graph.GetOrCreateNodeArg("y1", &type_y1);
+  auto& arg_sq = graph.GetOrCreateNodeArg("sq_out", &type_sq);
+  auto& arg_w2 = graph.GetOrCreateNodeArg("w2", &type_w2);
+  auto& arg_r2 = graph.GetOrCreateNodeArg("r2", &type_r2);
+  auto& arg_b2 = graph.GetOrCreateNodeArg("b2", &type_b2);
+  auto& arg_y = graph.GetOrCreateNodeArg("y", &type_y);
+
+  auto& gru1 = graph.AddNode("gru1", "GRU", "first layer",
+                             {&arg_x, &arg_w1, &arg_r1, &arg_b1}, {&arg_y1});
+  gru1.AddAttribute("hidden_size", static_cast<int64_t>(5));
+
+  auto& squeeze = graph.AddNode("squeeze", "Squeeze", "drop num_directions",
+                                {&arg_y1}, {&arg_sq});
+  squeeze.AddAttribute("axes", std::vector<int64_t>{1});
+
+  auto& gru2 = graph.AddNode("gru2", "GRU", "second layer",
+                             {&arg_sq, &arg_w2, &arg_r2, &arg_b2}, {&arg_y});
+  gru2.AddAttribute("hidden_size", static_cast<int64_t>(4));
+
+  ASSERT_TRUE(graph.Resolve().IsOK());
+  ASSERT_EQ(graph.NumberOfNodes(), 3);
+
+  GruFusion gru_fusion;
+  bool modified = false;
+  ASSERT_TRUE(gru_fusion.Apply(graph, modified).IsOK());
+  ASSERT_TRUE(modified);
+  ASSERT_EQ(graph.NumberOfNodes(), 1);
+
+  const Node* fused_node = nullptr;
+  for (const auto& node : graph.Nodes()) {
+    if (node.OpType() == "FusedGru") {
+      fused_node = &node;
+    }
+  }
+  ASSERT_TRUE(fused_node != nullptr);
+  ASSERT_EQ(fused_node->Domain(), "com.microsoft");
+  ASSERT_EQ(fused_node->InputDefs().size(), 7);
+  ASSERT_EQ(fused_node->InputDefs()[0]->Name(), "x");
+  ASSERT_EQ(fused_node->InputDefs()[1]->Name(), "w1");
+  ASSERT_EQ(fused_node->InputDefs()[4]->Name(), "w2");
+  ASSERT_EQ(fused_node->OutputDefs()[0]->Name(), "y");
+
+  const auto& attrs = fused_node->GetAttributes();
+  auto num_layers_attr = attrs.find("num_layers");
+  ASSERT_TRUE(num_layers_attr != attrs.end());
+  ASSERT_EQ(num_layers_attr->second.i(), 2);
+}
+
+TEST(GraphTransformationTests, ConstantFolding) {
+  // a (initializer) --\
+  //                    Add --> c --\
+  // b (initializer) --/             Mul --> y
+  //                    x (input) --/
+  // the Add node is constant and should be folded into an initializer for c.
+  Model model("ConstantFoldingTest");
+  auto& graph = model.MainGraph();
+
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  tensor_float.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+  TensorProto initializer_a;
+  initializer_a.set_name("a");
+  initializer_a.set_data_type(TensorProto_DataType_FLOAT);
+  initializer_a.add_dims(2);
+  initializer_a.add_float_data(1.0f);
+  initializer_a.add_float_data(2.0f);
+  graph.AddInitializedTensor(initializer_a);
+
+  TensorProto initializer_b(initializer_a);
+  initializer_b.set_name("b");
+  initializer_b.set_float_data(0, 4.0f);
+  initializer_b.set_float_data(1, 5.0f);
+  graph.AddInitializedTensor(initializer_b);
+
+  auto& arg_a = graph.GetOrCreateNodeArg("a", &tensor_float);
+  auto& arg_b = graph.GetOrCreateNodeArg("b", &tensor_float);
+  auto& arg_c = graph.GetOrCreateNodeArg("c", &tensor_float);
+  auto& arg_x = graph.GetOrCreateNodeArg("x", &tensor_float);
+  auto& arg_y = graph.GetOrCreateNodeArg("y", &tensor_float);
+
+  graph.AddNode("add", "Add", "constant add", {&arg_a, &arg_b}, {&arg_c});
+  graph.AddNode("mul", "Mul", "non-constant mul", {&arg_c, &arg_x}, {&arg_y});
+  ASSERT_TRUE(graph.Resolve().IsOK());
+  ASSERT_EQ(graph.NumberOfNodes(), 2);
+
+  ConstantFolding transformer;
+  bool modified = false;
+  ASSERT_TRUE(transformer.Apply(graph, modified).IsOK());
+  ASSERT_TRUE(modified);
+
+  // the Add node is gone and c became an initializer holding a + b
+  ASSERT_EQ(graph.NumberOfNodes(), 1);
+  const TensorProto* folded = nullptr;
+  ASSERT_TRUE(graph.GetInitializedTensor("c", folded));
+  ASSERT_EQ(folded->data_type(), TensorProto_DataType_FLOAT);
+  ASSERT_EQ(folded->dims_size(), 1);
+  ASSERT_EQ(folded->dims(0), 2);
+  float folded_values[2];
+  ASSERT_EQ(folded->raw_data().size(), sizeof(folded_values));
+  memcpy(folded_values, folded->raw_data().data(), sizeof(folded_values));
+  ASSERT_EQ(folded_values[0], 5.0f);
+  ASSERT_EQ(folded_values[1], 7.0f);
+
+  // a second application has nothing left to fold
+  modified = false;
+  ASSERT_TRUE(transformer.Apply(graph, modified).IsOK());
+  ASSERT_FALSE(modified);
+}
+
+TEST(GraphTransformationTests, GraphCleanupDeadNodesAndDuplicateInitializers) {
+  // X --Add--> Y --Mul(W1)--> Z    (graph output)
+  //            Y --Mul(W2)--> Z2   (graph output, W2 duplicates W1)
+  //            Y --Mul(W3)--> D    (feeds nothing; dead)
+  ModelProto model_proto;
+  model_proto.set_ir_version(3);
+  auto* opset = model_proto.add_opset_import();
+  opset->set_domain("");
+  opset->set_version(7);
+
+  auto* graph_proto = model_proto.mutable_graph();
+  graph_proto->set_name("cleanup_test");
+
+  auto add_value_info = [](ValueInfoProto* value_info, const std::string& name) {
+    value_info->set_name(name);
+    auto* tensor_type = value_info->mutable_type()->mutable_tensor_type();
+    tensor_type->set_elem_type(TensorProto_DataType_FLOAT);
+    tensor_type->mutable_shape()->add_dim()->set_dim_value(2);
+  };
+  add_value_info(graph_proto->add_input(), "X");
+  add_value_info(graph_proto->add_output(), "Z");
+  add_value_info(graph_proto->add_output(), "Z2");
+
+  for (const auto* name : {"W1", "W2", "W3"}) {
+    auto* initializer = graph_proto->add_initializer();
+    initializer->set_name(name);
+    initializer->set_data_type(onnx::TensorProto_DataType_FLOAT);
+    initializer->add_dims(2);
+    initializer->add_float_data(1.0f);
+    initializer->add_float_data(2.0f);
+  }
+
+  auto add_node = [](GraphProto* proto, const std::string& name, const std::string& op_type,
+                     const std::vector<std::string>& inputs, const std::string& output) {
+    auto* node = proto->add_node();
+    node->set_name(name);
+    node->set_op_type(op_type);
+    for (const auto& input : inputs) node->add_input(input);
+    node->add_output(output);
+  };
+  add_node(graph_proto, "add", "Add", {"X", "X"}, "Y");
+  add_node(graph_proto, "mul1", "Mul", {"Y", "W1"}, "Z");
+  add_node(graph_proto, "mul2", "Mul", {"Y", "W2"}, "Z2");
+  add_node(graph_proto, "dead", "Mul", {"Y", "W3"}, "D");
+
+  Model model(model_proto);
+  Graph& graph = model.MainGraph();
+  ASSERT_TRUE(graph.Resolve().IsOK());
+  ASSERT_EQ(graph.NumberOfNodes(), 4);
+
+  GraphCleanup transformer;
+  bool modified = false;
+  ASSERT_TRUE(transformer.Apply(graph, modified).IsOK());
+  ASSERT_TRUE(modified);
+
+  // the dead Mul is gone, W2 was collapsed onto W1 and W3 became unused
+  ASSERT_EQ(graph.NumberOfNodes(), 3);
+  ASSERT_EQ(graph.GetAllInitializedTensors().size(), 1);
+  const TensorProto* kept = nullptr;
+  ASSERT_TRUE(graph.GetInitializedTensor("W1", kept));
+
+  const Node* mul2 = nullptr;
+  for (const auto& node : graph.Nodes()) {
+    if (node.Name() == "mul2") mul2 = &node;
+    ASSERT_NE(node.Name(), "dead");
+  }
+  ASSERT_NE(mul2, nullptr);
+  ASSERT_EQ(mul2->InputDefs()[1]->Name(), "W1");
+
+  // a second application finds nothing left to clean
+  modified = false;
+  ASSERT_TRUE(transformer.Apply(graph, modified).IsOK());
+  ASSERT_FALSE(modified);
+}
+
+TEST(GraphTransformationTests, FuseSpaceToDepthConvStride) {
+  // x (1x1x4x4) --> SpaceToDepth(blocksize=2) --> Conv(W 1x4x1x1, stride 1) --> y
+  // the rearrangement folds into a stride-2 Conv with a 2x2 kernel over x.
+  Model model("SpaceToDepthConvFusionTest");
+  auto& graph = model.MainGraph();
+
+  TypeProto input_type;
+  input_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  for (const int64_t dim : {1, 1, 4, 4}) {
+    input_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+  }
+
+  TypeProto weight_type;
+  weight_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  for (const int64_t dim : {1, 4, 1, 1}) {
+    weight_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+  }
+
+  TensorProto weight_tensor;
+  weight_tensor.set_name("W");
+  weight_tensor.set_data_type(TensorProto_DataType_FLOAT);
+  for (const int64_t dim : {1, 4, 1, 1}) weight_tensor.add_dims(dim);
+  for (const float value : {10.0f, 20.0f, 30.0f, 40.0f}) weight_tensor.add_float_data(value);
+  graph.AddInitializedTensor(weight_tensor);
+
+  auto& arg_x = graph.GetOrCreateNodeArg("x", &input_type);
+  auto& arg_w = graph.GetOrCreateNodeArg("W", &weight_type);
+  auto& arg_s2d = graph.GetOrCreateNodeArg("s2d_out", nullptr);
+  auto& arg_y = graph.GetOrCreateNodeArg("y", nullptr);
+
+  auto& s2d = graph.AddNode("s2d", "SpaceToDepth", "block rearrangement", {&arg_x}, {&arg_s2d});
+  s2d.AddAttribute("blocksize", static_cast<int64_t>(2));
+  graph.AddNode("conv", "Conv", "pointwise conv", {&arg_s2d, &arg_w}, {&arg_y});
+  ASSERT_TRUE(graph.Resolve().IsOK());
+  ASSERT_EQ(graph.NumberOfNodes(), 2);
+
+  SpaceToDepthConvFusion transformer;
+  bool modified = false;
+  ASSERT_TRUE(transformer.Apply(graph, modified).IsOK());
+  ASSERT_TRUE(modified);
+
+  // the SpaceToDepth node is gone and the Conv reads x directly with stride 2
+  ASSERT_EQ(graph.NumberOfNodes(), 1);
+  const Node* conv = nullptr;
+  for (const auto& node : graph.Nodes()) {
+    if (node.OpType() == "Conv") conv = &node;
+  }
+  ASSERT_NE(conv, nullptr);
+  ASSERT_EQ(conv->InputDefs()[0]->Name(), "x");
+
+  const auto& attrs = conv->GetAttributes();
+  auto strides_attr = attrs.find("strides");
+  ASSERT_TRUE(strides_attr != attrs.end());
+  ASSERT_EQ(strides_attr->second.ints_size(), 2);
+  ASSERT_EQ(strides_attr->second.ints(0), 2);
+  ASSERT_EQ(strides_attr->second.ints(1), 2);
+
+  // the folded kernel is 1x1x2x2 and each input channel's 1x1 tap landed at
+  // its (by, bx) offset within the stride window
+  const TensorProto* folded = nullptr;
+  ASSERT_TRUE(graph.GetInitializedTensor(conv->InputDefs()[1]->Name(), folded));
+  ASSERT_EQ(folded->dims_size(), 4);
+  ASSERT_EQ(folded->dims(0), 1);
+  ASSERT_EQ(folded->dims(1), 1);
+  ASSERT_EQ(folded->dims(2), 2);
+  ASSERT_EQ(folded->dims(3), 2);
+  float folded_values[4];
+  ASSERT_EQ(folded->raw_data().size(), sizeof(folded_values));
+  memcpy(folded_values, folded->raw_data().data(), sizeof(folded_values));
+  ASSERT_EQ(folded_values[0], 10.0f);
+  ASSERT_EQ(folded_values[1], 20.0f);
+  ASSERT_EQ(folded_values[2], 30.0f);
+  ASSERT_EQ(folded_values[3], 40.0f);
+
+  // a second application has nothing left to fold
+  modified = false;
+  ASSERT_TRUE(transformer.Apply(graph, modified).IsOK());
+  ASSERT_FALSE(modified);
+}
+
+TEST(GraphTransformationTests, NarrowGatherIndices) {
+  // two Gathers over the same data: one fed int64 indices through a Cast
+  // from int32, one fed an int64 indices initializer whose values fit int32.
+  Model model("IndexNarrowingTest");
+  auto& graph = model.MainGraph();
+
+  TypeProto data_type;
+  data_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  for (const int64_t dim : {10, 4}) {
+    data_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+  }
+
+  TypeProto idx32_type;
+  idx32_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT32);
+  idx32_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(5);
+
+  TypeProto idx64_init_type;
+  idx64_init_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+  idx64_init_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+
+  TensorProto indices_tensor;
+  indices_tensor.set_name("const_indices");
+  indices_tensor.set_data_type(TensorProto_DataType_INT64);
+  indices_tensor.add_dims(3);
+  for (const int64_t value : {1, 7, 2}) indices_tensor.add_int64_data(value);
+  graph.AddInitializedTensor(indices_tensor);
+
+  auto& arg_data = graph.GetOrCreateNodeArg("data", &data_type);
+  auto& arg_idx32 = graph.GetOrCreateNodeArg("idx32", &idx32_type);
+  auto& arg_idx64 = graph.GetOrCreateNodeArg("idx64", nullptr);
+  auto& arg_const_indices = graph.GetOrCreateNodeArg("const_indices", &idx64_init_type);
+  auto& arg_y0 = graph.GetOrCreateNodeArg("y0", nullptr);
+  auto& arg_y1 = graph.GetOrCreateNodeArg("y1", nullptr);
+
+  auto& cast = graph.AddNode("cast", "Cast", "widen indices", {&arg_idx32}, {&arg_idx64});
+  cast.AddAttribute("to", static_cast<int64_t>(TensorProto_DataType_INT64));
+  graph.AddNode("gather0", "Gather", "casted indices", {&arg_data, &arg_idx64}, {&arg_y0});
+  graph.AddNode("gather1", "Gather", "constant indices", {&arg_data, &arg_const_indices}, {&arg_y1});
+  ASSERT_TRUE(graph.Resolve().IsOK());
+  ASSERT_EQ(graph.NumberOfNodes(), 3);
+
+  IndexNarrowing transformer;
+  bool modified = false;
+  ASSERT_TRUE(transformer.Apply(graph, modified).IsOK());
+  ASSERT_TRUE(modified);
+
+  // the Cast is gone and gather0 reads the int32 values directly
+  ASSERT_EQ(graph.NumberOfNodes(), 2);
+  const Node* gather0 = nullptr;
+  const Node* gather1 = nullptr;
+  for (const auto& node : graph.Nodes()) {
+    if (node.Name() == "gather0") gather0 = &node;
+    if (node.Name() == "gather1") gather1 = &node;
+  }
+  ASSERT_NE(gather0, nullptr);
+  ASSERT_EQ(gather0->InputDefs()[1]->Name(), "idx32");
+
+  // gather1 reads an int32 copy of the initializer with the same values
+  ASSERT_NE(gather1, nullptr);
+  const std::string narrowed_name = gather1->InputDefs()[1]->Name();
+  ASSERT_NE(narrowed_name, "const_indices");
+  const TensorProto* narrowed = nullptr;
+  ASSERT_TRUE(graph.GetInitializedTensor(narrowed_name, narrowed));
+  ASSERT_EQ(narrowed->data_type(), TensorProto_DataType_INT32);
+  ASSERT_EQ(narrowed->dims_size(), 1);
+  ASSERT_EQ(narrowed->dims(0), 3);
+  ASSERT_EQ(narrowed->int32_data_size(), 3);
+  ASSERT_EQ(narrowed->int32_data(0), 1);
+  ASSERT_EQ(narrowed->int32_data(1), 7);
+  ASSERT_EQ(narrowed->int32_data(2), 2);
+
+  // a second application finds only int32 index dataflow
+  modified = false;
+  ASSERT_TRUE(transformer.Apply(graph, modified).IsOK());
+  ASSERT_FALSE(modified);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -0,0 +1,148 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/graph/shape_functions.h"
+#include "core/graph/model.h"
+#include "gtest/gtest.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+NodeAttributes MakeIntAttrs(const std::vector<std::pair<std::string, int64_t>>& ints) {
+  NodeAttributes attributes;
+  for (const auto& attr : ints) {
+    AttributeProto proto;
+    proto.set_name(attr.first);
+    proto.set_type(AttributeProto_AttributeType_INT);
+    proto.set_i(attr.second);
+    attributes[attr.first] = proto;
+  }
+  return attributes;
+}
+
+void AddIntsAttr(NodeAttributes& attributes, const std::string& name, const std::vector<int64_t>& values) {
+  AttributeProto proto;
+  proto.set_name(name);
+  proto.set_type(AttributeProto_AttributeType_INTS);
+  for (int64_t v : values) {
+    proto.add_ints(v);
+  }
+  attributes[name] = proto;
+}
+
+}  // namespace
+
+TEST(ShapeFunctionsTest, Find) {
+  EXPECT_NE(nullptr, shape_functions::Find("Gemm", ""));
+  EXPECT_NE(nullptr, shape_functions::Find("MatMul", "ai.onnx"));
+  EXPECT_NE(nullptr, shape_functions::Find("Conv", ""));
+  EXPECT_EQ(nullptr, shape_functions::Find("NotAnOp", ""));
+  EXPECT_EQ(nullptr, shape_functions::Find("Gemm", "com.microsoft"));
+}
+
+TEST(ShapeFunctionsTest, Gemm) {
+  auto fn = shape_functions::Find("Gemm", "");
+  ASSERT_NE(nullptr, fn);
+
+  std::vector<std::vector<int64_t>> outputs;
+  ASSERT_TRUE(fn({{3, 4}, {4, 5}}, NodeAttributes(), outputs).IsOK());
+  ASSERT_EQ(1U, outputs.size());
+  EXPECT_EQ(std::vector<int64_t>({3, 5}), outputs[0]);
+
+  // transposed operands
+  ASSERT_TRUE(fn({{4, 3}, {5, 4}}, MakeIntAttrs({{"transA", 1}, {"transB", 1}}), outputs).IsOK());
+  EXPECT_EQ(std::vector<int64_t>({3, 5}), outputs[0]);
+
+  // K mismatch is rejected
+  EXPECT_FALSE(fn({{3, 4}, {5, 6}}, NodeAttributes(), outputs).IsOK());
+}
+
+TEST(ShapeFunctionsTest, MatMul) {
+  auto fn = shape_functions::Find("MatMul", "");
+  ASSERT_NE(nullptr, fn);
+
+  std::vector<std::vector<int64_t>> outputs;
+  ASSERT_TRUE(fn({{3, 4}, {4, 5}}, NodeAttributes(), outputs).IsOK());
+  EXPECT_EQ(std::vector<int64_t>({3, 5}), outputs[0]);
+
+  // batch dimensions broadcast
+  ASSERT_TRUE(fn({{2, 1, 3, 4}, {5, 4, 6}}, NodeAttributes(), outputs).IsOK());
+  EXPECT_EQ(std::vector<int64_t>({2, 5, 3, 6}), outputs[0]);
+
+  // 1D operands are promoted and the promoted dimension squeezed
+  ASSERT_TRUE(fn({{4}, {4, 5}}, NodeAttributes(), outputs).IsOK());
+  EXPECT_EQ(std::vector<int64_t>({5}), outputs[0]);
+  ASSERT_TRUE(fn({{4}, {4}}, NodeAttributes(), outputs).IsOK());
+  EXPECT_TRUE(outputs[0].empty());  // scalar
+
+  EXPECT_FALSE(fn({{3, 4}, {5, 6}}, NodeAttributes(), outputs).IsOK());
+}
+
+TEST(ShapeFunctionsTest, Conv) {
+  auto fn = shape_functions::Find("Conv", "");
+  ASSERT_NE(nullptr, fn);
+
+  // kernel shape comes from W when the attribute is absent
+  std::vector<std::vector<int64_t>> outputs;
+  ASSERT_TRUE(fn({{1, 3, 8, 8}, {16, 3, 3, 3}}, NodeAttributes(), outputs).IsOK());
+  EXPECT_EQ(std::vector<int64_t>({1, 16, 6, 6}), outputs[0]);
+
+  // explicit pads and strides
+  NodeAttributes attributes;
+  AddIntsAttr(attributes, "pads", {1, 1, 1, 1});
+  AddIntsAttr(attributes, "strides", {2, 2});
+  ASSERT_TRUE(fn({{1, 3, 8, 8}, {16, 3, 3, 3}}, attributes, outputs).IsOK());
+  EXPECT_EQ(std::vector<int64_t>({1, 16, 4, 4}), outputs[0]);
+
+  // SAME_UPPER pads to ceil(in / stride)
+  attributes.clear();
+  {
+    AttributeProto proto;
+    proto.set_name("auto_pad");
+    proto.set_type(AttributeProto_AttributeType_STRING);
+    proto.set_s("SAME_UPPER");
+    attributes["auto_pad"] = proto;
+  }
+  AddIntsAttr(attributes, "strides", {2, 2});
+  ASSERT_TRUE(fn({{1, 3, 7, 7}, {16, 3, 3, 3}}, attributes, outputs).IsOK());
+  EXPECT_EQ(std::vector<int64_t>({1, 16, 4, 4}), outputs[0]);
+
+  // channel mismatch against the group count is rejected
+  EXPECT_FALSE(fn({{1, 4, 8, 8}, {16, 3, 3, 3}}, NodeAttributes(), outputs).IsOK());
+}
+
+// Graph::Resolve picks up the registered shape function for fully known
+// input shapes and still produces the expected output NodeArg shapes.
+TEST(ShapeFunctionsTest, ResolveUsesShapeFunction) {
+  Model model("ShapeFunctionGraph");
+  auto& graph = model.MainGraph();
+
+  TypeProto float_2d;
+  float_2d.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_2d.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+  float_2d.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+  TypeProto float_2d_rhs;
+  float_2d_rhs.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_2d_rhs.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+  float_2d_rhs.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(5);
+
+  auto& input_a = graph.GetOrCreateNodeArg("a", &float_2d);
+  auto& input_b = graph.GetOrCreateNodeArg("b", &float_2d_rhs);
+  auto& output = graph.GetOrCreateNodeArg("y", nullptr);
+  graph.AddNode("matmul", "MatMul", "matmul node", {&input_a, &input_b}, {&output});
+
+  ASSERT_TRUE(graph.Resolve().IsOK());
+
+  const auto* shape = output.Shape();
+  ASSERT_NE(nullptr, shape);
+  ASSERT_EQ(2, shape->dim_size());
+  EXPECT_EQ(3, shape->dim(0).dim_value());
+  EXPECT_EQ(5, shape->dim(1).dim_value());
+}
+
+}  // namespace test
+}  // namespace onnxruntime
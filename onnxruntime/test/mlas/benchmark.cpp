@@ -0,0 +1,461 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    benchmark.cpp
+
+Abstract:
+
+    This module implements a throughput benchmark of the MLAS library.
+
+    The benchmark sweeps GEMM shapes, convolution configurations and pooling
+    configurations over a range of thread counts and reports GFLOPS per
+    configuration. The kernels exercised are the ones MlasPlatform dispatch
+    selects for the host processor, so running the benchmark before and after
+    a platform.cpp or kernel change on the same machine shows the throughput
+    effect of the change.
+
+--*/
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <mlas.h>
+
+#if !defined(_countof)
+#define _countof(_Array) (sizeof(_Array) / sizeof(_Array[0]))
+#endif
+
+//
+// Minimum wall clock time to spend per measured configuration.
+//
+
+constexpr double BenchmarkSeconds = 0.5;
+
+class BenchmarkThreadPool;
+
+static BenchmarkThreadPool* ActiveThreadPool = nullptr;
+
+class BenchmarkThreadPool
+{
+public:
+    BenchmarkThreadPool(int32_t ThreadCount) : _ThreadCount(ThreadCount)
+    {
+        for (int32_t i = 0; i < ThreadCount; i++) {
+            _Workers.emplace_back(&BenchmarkThreadPool::WorkerLoop, this);
+        }
+    }
+
+    ~BenchmarkThreadPool(void)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_Mutex);
+            _Shutdown = true;
+        }
+        _StartCondition.notify_all();
+        for (auto& Worker : _Workers) {
+            Worker.join();
+        }
+    }
+
+    void Execute(MLAS_THREADED_ROUTINE* ThreadedRoutine, void* Context, int32_t Iterations)
+    {
+        std::unique_lock<std::mutex> lock(_Mutex);
+
+        _Routine = ThreadedRoutine;
+        _Context = Context;
+        _Iterations = Iterations;
+        _NextIndex.store(0, std::memory_order_relaxed);
+        _ActiveWorkers = _ThreadCount;
+        _Generation++;
+
+        _StartCondition.notify_all();
+        _DoneCondition.wait(lock, [this]() { return _ActiveWorkers == 0; });
+    }
+
+    static void ExecuteOnActivePool(MLAS_THREADED_ROUTINE* ThreadedRoutine, void* Context, int32_t Iterations)
+    {
+        ActiveThreadPool->Execute(ThreadedRoutine, Context, Iterations);
+    }
+
+private:
+    void WorkerLoop(void)
+    {
+        uint64_t LastGeneration = 0;
+
+        for (;;) {
+
+            {
+                std::unique_lock<std::mutex> lock(_Mutex);
+                _StartCondition.wait(lock, [&]() { return _Shutdown || _Generation != LastGeneration; });
+                if (_Shutdown) {
+                    return;
+                }
+                LastGeneration = _Generation;
+            }
+
+            for (;;) {
+                int32_t Index = _NextIndex.fetch_add(1, std::memory_order_relaxed);
+                if (Index >= _Iterations) {
+                    break;
+                }
+                _Routine(_Context, Index);
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(_Mutex);
+                _ActiveWorkers--;
+            }
+            _DoneCondition.notify_all();
+        }
+    }
+
+private:
+    const int32_t _ThreadCount;
+    std::vector<std::thread> _Workers;
+    std::mutex _Mutex;
+    std::condition_variable _StartCondition;
+    std::condition_variable _DoneCondition;
+    uint64_t _Generation{0};
+    int32_t _ActiveWorkers{0};
+    bool _Shutdown{false};
+    MLAS_THREADED_ROUTINE* _Routine{nullptr};
+    void* _Context{nullptr};
+    int32_t _Iterations{0};
+    std::atomic<int32_t> _NextIndex{0};
+};
+
+float*
+AllocateFilledBuffer(
+    std::vector<std::unique_ptr<float[]>>& Buffers,
+    size_t Elements
+    )
+{
+    float* Buffer = new float[Elements];
+
+    const int MinimumFillValue = -23;
+    const int MaximumFillValue = 23;
+
+    int FillValue = MinimumFillValue;
+
+    for (size_t i = 0; i < Elements; i++) {
+        Buffer[i] = (float)FillValue / 16.0f;
+        if (++FillValue > MaximumFillValue) {
+            FillValue = MinimumFillValue;
+        }
+    }
+
+    Buffers.emplace_back(Buffer);
+
+    return Buffer;
+}
+
+template<typename KernelRoutine>
+double
+MeasureGigaflops(
+    double OperationsPerCall,
+    KernelRoutine Kernel
+    )
+/*++
+
+Routine Description:
+
+    This routine measures the throughput of the supplied kernel invocation.
+
+    The kernel is invoked twice to warm caches and the dispatch path, then
+    repeatedly until the minimum benchmark time has elapsed.
+
+Return Value:
+
+    Returns the measured throughput in GFLOPS.
+
+--*/
+{
+    Kernel();
+    Kernel();
+
+    size_t Calls = 0;
+    auto Start = std::chrono::steady_clock::now();
+    double ElapsedSeconds;
+
+    for (;;) {
+        Kernel();
+        Calls++;
+        ElapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+        if (ElapsedSeconds >= BenchmarkSeconds) {
+            break;
+        }
+    }
+
+    return OperationsPerCall * double(Calls) / ElapsedSeconds / 1e9;
+}
+
+void
+BenchmarkSgemm(
+    void
+    )
+{
+    static const struct {
+        CBLAS_TRANSPOSE TransA;
+        CBLAS_TRANSPOSE TransB;
+        size_t M;
+        size_t N;
+        size_t K;
+    } Shapes[] = {
+        { CblasNoTrans, CblasNoTrans, 64, 64, 64 },
+        { CblasNoTrans, CblasNoTrans, 128, 128, 128 },
+        { CblasNoTrans, CblasNoTrans, 256, 256, 256 },
+        { CblasNoTrans, CblasNoTrans, 512, 512, 512 },
+        { CblasNoTrans, CblasNoTrans, 1024, 1024, 1024 },
+        { CblasNoTrans, CblasTrans, 256, 256, 256 },
+        { CblasTrans, CblasNoTrans, 256, 256, 256 },
+        { CblasNoTrans, CblasNoTrans, 1, 1024, 1024 },
+        { CblasNoTrans, CblasNoTrans, 1024, 1024, 32 },
+    };
+
+    std::vector<std::unique_ptr<float[]>> Buffers;
+
+    for (size_t s = 0; s < _countof(Shapes); s++) {
+
+        size_t M = Shapes[s].M;
+        size_t N = Shapes[s].N;
+        size_t K = Shapes[s].K;
+
+        size_t lda = (Shapes[s].TransA == CblasNoTrans) ? K : M;
+        size_t ldb = (Shapes[s].TransB == CblasNoTrans) ? N : K;
+
+        const float* A = AllocateFilledBuffer(Buffers, M * K);
+        const float* B = AllocateFilledBuffer(Buffers, K * N);
+        float* C = AllocateFilledBuffer(Buffers, M * N);
+
+        double Operations = 2.0 * double(M) * double(N) * double(K);
+
+        double Gigaflops = MeasureGigaflops(Operations, [=]() {
+            MlasSgemm(Shapes[s].TransA, Shapes[s].TransB, M, N, K, 1.0f, A, lda, B, ldb, 0.0f, C, N);
+        });
+
+        printf("SGEMM,%s%s,M=%zd,N=%zd,K=%zd,%.2f GFLOPS\n",
+            (Shapes[s].TransA == CblasNoTrans) ? "N" : "T",
+            (Shapes[s].TransB == CblasNoTrans) ? "N" : "T",
+            M, N, K, Gigaflops);
+
+        //
+        // Also measure the pre-packed B variant for the plain layouts.
+        //
+
+        if (Shapes[s].TransA == CblasNoTrans && Shapes[s].TransB == CblasNoTrans) {
+
+            std::unique_ptr<uint8_t[]> PackedB(new uint8_t[MlasSgemmPackBSize(N, K)]);
+            MlasSgemmPackB(CblasNoTrans, N, K, B, ldb, PackedB.get());
+            const void* PackedBBuffer = PackedB.get();
+
+            Gigaflops = MeasureGigaflops(Operations, [=]() {
+                MlasSgemm(CblasNoTrans, M, N, K, 1.0f, A, lda, PackedBBuffer, 0.0f, C, N);
+            });
+
+            printf("SGEMM,NN-packed,M=%zd,N=%zd,K=%zd,%.2f GFLOPS\n", M, N, K, Gigaflops);
+        }
+    }
+}
+
+void
+BenchmarkConv(
+    void
+    )
+{
+    static const struct {
+        const char* Name;
+        size_t GroupCount;
+        size_t InputChannels;
+        size_t InputShape[2];
+        size_t KernelShape[2];
+        size_t Padding[2];
+        size_t StrideShape[2];
+        size_t FilterCount;
+    } Configs[] = {
+        { "3x3s1", 1, 64, { 56, 56 }, { 3, 3 }, { 1, 1 }, { 1, 1 }, 64 },
+        { "3x3s2", 1, 128, { 28, 28 }, { 3, 3 }, { 1, 1 }, { 2, 2 }, 256 },
+        { "1x1s1", 1, 256, { 28, 28 }, { 1, 1 }, { 0, 0 }, { 1, 1 }, 64 },
+        { "5x5s1", 1, 32, { 28, 28 }, { 5, 5 }, { 2, 2 }, { 1, 1 }, 64 },
+        { "7x7s2", 1, 3, { 224, 224 }, { 7, 7 }, { 3, 3 }, { 2, 2 }, 64 },
+        { "dw3x3s1", 128, 128, { 28, 28 }, { 3, 3 }, { 1, 1 }, { 1, 1 }, 128 },
+    };
+
+    std::vector<std::unique_ptr<float[]>> Buffers;
+
+    for (size_t c = 0; c < _countof(Configs); c++) {
+
+        size_t GroupCount = Configs[c].GroupCount;
+        size_t InputChannelsPerGroup = Configs[c].InputChannels / GroupCount;
+        size_t FilterCountPerGroup = Configs[c].FilterCount / GroupCount;
+
+        int64_t InputShape[2];
+        int64_t KernelShape[2];
+        int64_t DilationShape[2] = { 1, 1 };
+        int64_t Padding[4];
+        int64_t StrideShape[2];
+        int64_t OutputShape[2];
+
+        for (size_t d = 0; d < 2; d++) {
+            InputShape[d] = int64_t(Configs[c].InputShape[d]);
+            KernelShape[d] = int64_t(Configs[c].KernelShape[d]);
+            Padding[d] = int64_t(Configs[c].Padding[d]);
+            Padding[d + 2] = int64_t(Configs[c].Padding[d]);
+            StrideShape[d] = int64_t(Configs[c].StrideShape[d]);
+            OutputShape[d] = (InputShape[d] + Padding[d] + Padding[d + 2] -
+                (DilationShape[d] * (KernelShape[d] - 1) + 1)) / StrideShape[d] + 1;
+        }
+
+        MLAS_CONV_PARAMETERS Parameters;
+        size_t WorkingBufferSize;
+
+        MlasConvPrepare(&Parameters, 2, 1, GroupCount, InputChannelsPerGroup,
+            InputShape, KernelShape, DilationShape, Padding, StrideShape,
+            OutputShape, FilterCountPerGroup, &WorkingBufferSize);
+
+        const float* Input = AllocateFilledBuffer(Buffers,
+            GroupCount * InputChannelsPerGroup * Parameters.InputSize);
+        const float* Filter = AllocateFilledBuffer(Buffers,
+            GroupCount * FilterCountPerGroup * InputChannelsPerGroup *
+            size_t(KernelShape[0]) * size_t(KernelShape[1]));
+        const float* Bias = AllocateFilledBuffer(Buffers, GroupCount * FilterCountPerGroup);
+        float* WorkingBuffer = (WorkingBufferSize > 0) ?
+            AllocateFilledBuffer(Buffers, WorkingBufferSize) : nullptr;
+        float* Output = AllocateFilledBuffer(Buffers,
+            GroupCount * FilterCountPerGroup * Parameters.OutputSize);
+
+        double Operations = 2.0 * double(GroupCount) * double(FilterCountPerGroup) *
+            double(Parameters.OutputSize) * double(Parameters.K);
+
+        const MLAS_CONV_PARAMETERS* ParametersPointer = &Parameters;
+
+        double Gigaflops = MeasureGigaflops(Operations, [=]() {
+            MlasConv(ParametersPointer, Input, Filter, Bias, WorkingBuffer, Output);
+        });
+
+        printf("CONV,%s,g=%zd,ic=%zd,i=%zdx%zd,fc=%zd,algo=%d,%.2f GFLOPS\n",
+            Configs[c].Name, GroupCount, Configs[c].InputChannels,
+            size_t(InputShape[0]), size_t(InputShape[1]), Configs[c].FilterCount,
+            int(Parameters.Algorithm), Gigaflops);
+    }
+}
+
+void
+BenchmarkPool(
+    void
+    )
+{
+    static const struct {
+        const char* Name;
+        MLAS_POOLING_KIND PoolingKind;
+        size_t KernelShape[2];
+        size_t StrideShape[2];
+    } Configs[] = {
+        { "max2x2s2", MlasMaximumPooling, { 2, 2 }, { 2, 2 } },
+        { "max3x3s2", MlasMaximumPooling, { 3, 3 }, { 2, 2 } },
+        { "avg2x2s2", MlasAveragePoolingExcludePad, { 2, 2 }, { 2, 2 } },
+        { "avg3x3s2", MlasAveragePoolingIncludePad, { 3, 3 }, { 2, 2 } },
+    };
+
+    const size_t Channels = 64;
+    const size_t InputHeight = 112;
+    const size_t InputWidth = 112;
+
+    std::vector<std::unique_ptr<float[]>> Buffers;
+
+    const float* Input = AllocateFilledBuffer(Buffers, Channels * InputHeight * InputWidth);
+
+    for (size_t c = 0; c < _countof(Configs); c++) {
+
+        int64_t InputShape[4] = { 1, int64_t(Channels), int64_t(InputHeight), int64_t(InputWidth) };
+        int64_t KernelShape[2] = { int64_t(Configs[c].KernelShape[0]), int64_t(Configs[c].KernelShape[1]) };
+        int64_t Padding[4] = { 0, 0, 0, 0 };
+        int64_t StrideShape[2] = { int64_t(Configs[c].StrideShape[0]), int64_t(Configs[c].StrideShape[1]) };
+        int64_t OutputShape[4];
+
+        OutputShape[0] = InputShape[0];
+        OutputShape[1] = InputShape[1];
+        for (size_t d = 0; d < 2; d++) {
+            OutputShape[2 + d] = (InputShape[2 + d] - KernelShape[d]) / StrideShape[d] + 1;
+        }
+
+        float* Output = AllocateFilledBuffer(Buffers,
+            Channels * size_t(OutputShape[2]) * size_t(OutputShape[3]));
+
+        //
+        // Count one operation (compare or add) per kernel element per output.
+        //
+
+        double Operations = double(Channels) * double(OutputShape[2]) * double(OutputShape[3]) *
+            double(KernelShape[0]) * double(KernelShape[1]);
+
+        double Gigaflops = MeasureGigaflops(Operations, [&]() {
+            MlasPool(Configs[c].PoolingKind, 2, InputShape, KernelShape, Padding,
+                StrideShape, OutputShape, Input, Output);
+        });
+
+        printf("POOL,%s,c=%zd,i=%zdx%zd,%.2f GFLOPS\n",
+            Configs[c].Name, Channels, InputHeight, InputWidth, Gigaflops);
+    }
+}
+
+void
+RunBenchmarks(
+    void
+    )
+{
+    BenchmarkSgemm();
+    BenchmarkConv();
+    BenchmarkPool();
+}
+
+int
+#if defined(_WIN32)
+__cdecl
+#endif
+main(
+    void
+    )
+{
+    //
+    // Sweep over the default threading backend first, then over explicit
+    // thread counts using a private thread pool executor.
+    //
+
+    printf("threads=default\n");
+    RunBenchmarks();
+
+    int32_t MaximumThreadCount = int32_t(std::thread::hardware_concurrency());
+    if (MaximumThreadCount < 1) {
+        MaximumThreadCount = 1;
+    }
+
+    for (int32_t ThreadCount = 1; ThreadCount <= MaximumThreadCount; ThreadCount *= 2) {
+
+        printf("threads=%d\n", int(ThreadCount));
+
+        BenchmarkThreadPool ThreadPool(ThreadCount);
+        ActiveThreadPool = &ThreadPool;
+        MlasSetParallelExecutor(BenchmarkThreadPool::ExecuteOnActivePool, ThreadCount);
+
+        RunBenchmarks();
+
+        MlasSetParallelExecutor(nullptr, 0);
+        ActiveThreadPool = nullptr;
+    }
+
+    printf("Done.\n");
+
+    return 0;
+}
@@ -597,6 +597,21 @@ ExecuteConvTests(
         TrialConv2D(b, 1, 64, 11, 11, 128, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1);
     }
 
+    for (unsigned i = 8; i <= 9; i++) {
+        TrialConv2D(1, 1, 8, i, i, 8, 3, 3, 0, 0, 0, 0, 1, 1, 1, 1);
+        TrialConv2D(1, 1, 8, i, i, 8, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1);
+        TrialConv2D(2, 2, 8, i, i, 8, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1);
+    }
+
+    for (unsigned g = 1; g <= 48; g += 47) {
+        TrialConv2D(1, g, 1, 19, 23, 1, 3, 3, 0, 0, 0, 0, 1, 1, 1, 1);
+        TrialConv2D(1, g, 1, 19, 23, 1, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1);
+        TrialConv2D(1, g, 1, 19, 23, 1, 3, 3, 1, 1, 1, 1, 1, 1, 2, 2);
+        TrialConv2D(1, g, 1, 19, 23, 1, 3, 3, 2, 2, 2, 2, 2, 2, 1, 1);
+        TrialConv2D(1, g, 1, 19, 23, 1, 5, 5, 2, 2, 2, 2, 1, 1, 1, 1);
+        TrialConv2D(2, g, 1, 19, 23, 1, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1);
+    }
+
     for (unsigned ic = 0; ic < _countof(cs); ic++) {
         for (unsigned ih = 0; ih < _countof(is); ih++) {
             for (unsigned iw = 0; iw < _countof(is); iw++) {
@@ -37,6 +37,7 @@
 #pragma warning(disable : 4996) /*The compiler encountered a deprecated declaration.*/
 #endif
 #include <google/protobuf/util/delimited_message_util.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
 #include <google/protobuf/text_format.h>
 #include "tml.pb.h"
 #ifdef __GNUC__
@@ -159,6 +160,34 @@ static int ExtractFileNo(const std::basic_string<CHAR_T>& name) {
 }
 typedef std::basic_string<PATH_CHAR_TYPE> PATH_STRING_TYPE;
 
+// Maps a whole file read-only and releases the mapping on destruction. Test
+// data files are parsed once straight out of the page cache, which avoids the
+// read syscalls and buffer copies of a FileInputStream. Callers fall back to
+// regular file reads when mapping fails (e.g. zero-length files).
+class MappedFile {
+ public:
+  MappedFile() = default;
+
+  Status Open(const PATH_STRING_TYPE& path) {
+    return Env::Default().MapFileIntoMemory(path, base_, length_);
+  }
+
+  ~MappedFile() {
+    if (base_ != nullptr) {
+      (void)Env::Default().UnmapFileFromMemory(base_, length_);
+    }
+  }
+
+  const void* data() const { return base_; }
+  size_t length() const { return length_; }
+
+  ONNXRUNTIME_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(MappedFile);
+
+ private:
+  const void* base_ = nullptr;
+  size_t length_ = 0;
+};
+
 template <typename PATH_CHAR_TYPE>
 static Status SortTensorFileNames(std::vector<std::basic_string<PATH_CHAR_TYPE>>& input_pb_files) {
   if (input_pb_files.size() <= 1) return Status::OK();
@@ -179,10 +208,8 @@ static Status SortTensorFileNames(std::vector<std::basic_string<PATH_CHAR_TYPE>>
   return Status::OK();
 }
 
-Status LoopDataFile(int test_data_pb_fd, ONNXRuntimeAllocator* env,
+Status LoopDataFile(google::protobuf::io::ZeroCopyInputStream& f, ONNXRuntimeAllocator* env,
                     const std::vector<onnx::ValueInfoProto> value_info, std::unordered_map<std::string, ONNXValue*>& name_data_map, std::ostringstream& oss) {
-  google::protobuf::io::FileInputStream f(test_data_pb_fd);
-  f.SetCloseOnDelete(true);
   google::protobuf::io::CodedInputStream coded_input(&f);
   bool clean_eof = false;
   Status st;
@@ -337,15 +364,22 @@ class OnnxTestCase : public ITestCase {
 };
 
 Status OnnxTestCase::loadModelFile(const PATH_CHAR_TYPE* model_url, ONNX_NAMESPACE::ModelProto** model_pb) {
-  int model_fd;
-  ONNXRUNTIME_RETURN_IF_ERROR(Env::Default().FileOpenRd(model_url, model_fd));
-  google::protobuf::io::FileInputStream f(model_fd);
-  f.SetCloseOnDelete(true);
-  ONNX_NAMESPACE::ModelProto* ret = new ONNX_NAMESPACE::ModelProto();
-  if (!ret->ParseFromZeroCopyStream(&f)) {
-    return Status(ONNXRUNTIME, INVALID_PROTOBUF, "Failed to load model because protobuf parsing failed.");
+  std::unique_ptr<ONNX_NAMESPACE::ModelProto> ret = std::make_unique<ONNX_NAMESPACE::ModelProto>();
+  MappedFile mapping;
+  if (mapping.Open(model_url).IsOK()) {
+    if (!ret->ParseFromArray(mapping.data(), static_cast<int>(mapping.length()))) {
+      return Status(ONNXRUNTIME, INVALID_PROTOBUF, "Failed to load model because protobuf parsing failed.");
+    }
+  } else {
+    int model_fd;
+    ONNXRUNTIME_RETURN_IF_ERROR(Env::Default().FileOpenRd(model_url, model_fd));
+    google::protobuf::io::FileInputStream f(model_fd);
+    f.SetCloseOnDelete(true);
+    if (!ret->ParseFromZeroCopyStream(&f)) {
+      return Status(ONNXRUNTIME, INVALID_PROTOBUF, "Failed to load model because protobuf parsing failed.");
+    }
   }
-  *model_pb = ret;
+  *model_pb = ret.release();
   return Status::OK();
 }
 ITestCase* CreateOnnxTestCase(ONNXRuntimeAllocator* ptr, const std::string& test_case_name) {
@@ -449,14 +483,21 @@ template <typename PATH_STRING_TYPE>
 static Status LoadTensors(const std::vector<PATH_STRING_TYPE>& pb_files,
                           std::vector<ONNX_NAMESPACE::TensorProto>* input_pbs) {
   for (size_t i = 0; i != pb_files.size(); ++i) {
-    int tensor_fd;
-    auto st = Env::Default().FileOpenRd(pb_files.at(i), tensor_fd);
-    ONNXRUNTIME_RETURN_IF_ERROR(st);
-    google::protobuf::io::FileInputStream f(tensor_fd);
-    f.SetCloseOnDelete(true);
     ONNX_NAMESPACE::TensorProto tensor;
-    if (!tensor.ParseFromZeroCopyStream(&f)) {
-      return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, "parse file '", ToMBString(pb_files.at(i)), "' failed");
+    MappedFile mapping;
+    if (mapping.Open(pb_files.at(i)).IsOK()) {
+      if (!tensor.ParseFromArray(mapping.data(), static_cast<int>(mapping.length()))) {
+        return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, "parse file '", ToMBString(pb_files.at(i)), "' failed");
+      }
+    } else {
+      int tensor_fd;
+      auto st = Env::Default().FileOpenRd(pb_files.at(i), tensor_fd);
+      ONNXRUNTIME_RETURN_IF_ERROR(st);
+      google::protobuf::io::FileInputStream f(tensor_fd);
+      f.SetCloseOnDelete(true);
+      if (!tensor.ParseFromZeroCopyStream(&f)) {
+        return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, "parse file '", ToMBString(pb_files.at(i)), "' failed");
+      }
     }
     input_pbs->emplace_back(tensor);
   }
@@ -473,15 +514,26 @@ Status OnnxTestCase::LoadTestData(ONNXSession* session, size_t id, std::unordere
 
   PATH_STRING_TYPE test_data_pb = ConcatPathComponent<PATH_CHAR_TYPE>(
       test_data_dirs_[id], (is_input ? ONNXRUNTIME_TSTR("inputs.pb") : ONNXRUNTIME_TSTR("outputs.pb")));
-  int test_data_pb_fd;
-  st = Env::Default().FileOpenRd(test_data_pb, test_data_pb_fd);
+  MappedFile mapping;
+  int test_data_pb_fd = -1;
+  st = mapping.Open(test_data_pb);
+  if (!st.IsOK()) {
+    st = Env::Default().FileOpenRd(test_data_pb, test_data_pb_fd);
+  }
   if (st.IsOK()) {  //has an all-in-one input file
     std::ostringstream oss;
     {
       std::lock_guard<std::mutex> l(m_);
       oss << debuginfo_strings[id];
     }
-    st = LoopDataFile(test_data_pb_fd, allocator, is_input ? input_value_info_ : output_value_info_, name_data_map, oss);
+    if (mapping.data() != nullptr) {
+      google::protobuf::io::ArrayInputStream f(mapping.data(), static_cast<int>(mapping.length()));
+      st = LoopDataFile(f, allocator, is_input ? input_value_info_ : output_value_info_, name_data_map, oss);
+    } else {
+      google::protobuf::io::FileInputStream f(test_data_pb_fd);
+      f.SetCloseOnDelete(true);
+      st = LoopDataFile(f, allocator, is_input ? input_value_info_ : output_value_info_, name_data_map, oss);
+    }
     {
       std::lock_guard<std::mutex> l(m_);
       debuginfo_strings[id] = oss.str();
@@ -0,0 +1,111 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// onnxruntime dependencies
+#include <core/common/logging/sinks/clog_sink.h>
+#include <core/common/logging/logging.h>
+#include <core/framework/environment.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+#include "op_benchmark_runner.h"
+
+using namespace onnxruntime;
+
+namespace {
+
+void ShowUsage() {
+  std::cout << "onnxruntime_op_benchmark -s <spec_file> [-o <baseline_file>] "
+               "[-r <measured_runs>] [-w <warmup_runs>] [-c]\n"
+               "  -s  benchmark spec file, one case per line (see opbench/README.md)\n"
+               "  -o  write machine-readable baselines (JSON lines) to this file; default stdout\n"
+               "  -r  measured runs per case, default 100\n"
+               "  -w  warmup runs per case, default 10\n"
+               "  -c  also report registered CPU kernels with no benchmark case\n";
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::string default_logger_id{"Default"};
+  logging::LoggingManager default_logging_manager{std::unique_ptr<logging::ISink>{new logging::CLogSink{}},
+                                                  logging::Severity::kWARNING, false,
+                                                  logging::LoggingManager::InstanceType::Default,
+                                                  &default_logger_id};
+
+  std::unique_ptr<Environment> env;
+  auto status = Environment::Create(env);
+  if (!status.IsOK()) {
+    LOGF_DEFAULT(ERROR, "failed to create environment:%s", status.ErrorMessage().c_str());
+    return -1;
+  }
+
+  std::string spec_path;
+  std::string baseline_path;
+  size_t measured_runs = 100;
+  size_t warmup_runs = 10;
+  bool report_coverage = false;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "-c") {
+      report_coverage = true;
+    } else if (i + 1 < argc && (arg == "-s" || arg == "-o" || arg == "-r" || arg == "-w")) {
+      const std::string value = argv[++i];
+      if (arg == "-s")
+        spec_path = value;
+      else if (arg == "-o")
+        baseline_path = value;
+      else if (arg == "-r")
+        measured_runs = static_cast<size_t>(strtoul(value.c_str(), nullptr, 10));
+      else
+        warmup_runs = static_cast<size_t>(strtoul(value.c_str(), nullptr, 10));
+    } else {
+      ShowUsage();
+      return -1;
+    }
+  }
+
+  if (spec_path.empty() || measured_runs == 0) {
+    ShowUsage();
+    return -1;
+  }
+
+  std::vector<opbench::BenchmarkCase> cases;
+  status = opbench::OpBenchmarkRunner::LoadSpec(spec_path, cases);
+  if (!status.IsOK()) {
+    LOGF_DEFAULT(ERROR, "failed to load spec:%s", status.ErrorMessage().c_str());
+    return -1;
+  }
+
+  opbench::OpBenchmarkRunner runner(warmup_runs, measured_runs);
+  std::vector<opbench::BenchmarkResult> results;
+  int failed = 0;
+  for (const auto& benchmark_case : cases) {
+    opbench::BenchmarkResult result;
+    status = runner.Run(benchmark_case, result);
+    if (!status.IsOK()) {
+      LOGF_DEFAULT(ERROR, "case '%s' failed:%s", benchmark_case.op_type.c_str(),
+                   status.ErrorMessage().c_str());
+      ++failed;
+      continue;
+    }
+    std::cerr << result.case_id << ": mean " << result.mean_ns << " ns, p50 " << result.p50_ns
+              << " ns over " << result.repeat << " runs" << std::endl;
+    results.push_back(result);
+  }
+
+  if (baseline_path.empty()) {
+    opbench::OpBenchmarkRunner::WriteBaseline(results, std::cout);
+  } else {
+    std::ofstream baseline(baseline_path);
+    opbench::OpBenchmarkRunner::WriteBaseline(results, baseline);
+  }
+
+  if (report_coverage)
+    opbench::OpBenchmarkRunner::ReportCoverage(cases, std::cerr);
+
+  return failed == 0 ? 0 : -1;
+}
@@ -0,0 +1,284 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "op_benchmark_runner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+
+#include "core/framework/allocator.h"
+#include "core/framework/ml_value.h"
+#include "core/graph/constants.h"
+#include "core/graph/model.h"
+#include "core/providers/cpu/cpu_execution_provider.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+namespace opbench {
+
+namespace {
+
+// "64x128" -> {64, 128}
+Status ParseShape(const std::string& token, std::vector<int64_t>& shape) {
+  shape.clear();
+  std::stringstream stream(token);
+  std::string dim;
+  while (std::getline(stream, dim, 'x')) {
+    char* end = nullptr;
+    int64_t value = strtoll(dim.c_str(), &end, 10);
+    if (end == dim.c_str() || *end != '\0' || value < 0)
+      return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "invalid shape token: " + token);
+    shape.push_back(value);
+  }
+  if (shape.empty())
+    return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "empty shape token: " + token);
+  return Status::OK();
+}
+
+// "axis=i:1" attribute tokens carry a type tag so the node gets the right
+// AttributeProto kind.
+Status ApplyAttribute(Node& node, const std::string& name, const std::string& value) {
+  if (value.size() < 2 || value.find(':') == std::string::npos)
+    return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "invalid attribute value: " + value);
+  const std::string tag = value.substr(0, value.find(':'));
+  const std::string payload = value.substr(value.find(':') + 1);
+
+  if (tag == "i") {
+    node.AddAttribute(name, static_cast<int64_t>(strtoll(payload.c_str(), nullptr, 10)));
+  } else if (tag == "f") {
+    node.AddAttribute(name, strtof(payload.c_str(), nullptr));
+  } else if (tag == "s") {
+    node.AddAttribute(name, payload);
+  } else if (tag == "is" || tag == "fs") {
+    std::vector<int64_t> ints;
+    std::vector<float> floats;
+    std::stringstream stream(payload);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+      if (tag == "is")
+        ints.push_back(strtoll(item.c_str(), nullptr, 10));
+      else
+        floats.push_back(strtof(item.c_str(), nullptr));
+    }
+    if (tag == "is")
+      node.AddAttribute(name, ints);
+    else
+      node.AddAttribute(name, floats);
+  } else {
+    return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "unknown attribute type tag: " + tag);
+  }
+  return Status::OK();
+}
+
+std::string MakeCaseId(const BenchmarkCase& benchmark_case) {
+  std::ostringstream id;
+  id << benchmark_case.op_type;
+  if (!benchmark_case.domain.empty())
+    id << '(' << benchmark_case.domain << ')';
+  for (size_t i = 0; i < benchmark_case.input_shapes.size(); ++i) {
+    id << (i == 0 ? ':' : ';');
+    const auto& shape = benchmark_case.input_shapes[i];
+    for (size_t d = 0; d < shape.size(); ++d) {
+      if (d != 0) id << 'x';
+      id << shape[d];
+    }
+  }
+  for (const auto& attr : benchmark_case.attributes)
+    id << ' ' << attr.first << '=' << attr.second;
+  return id.str();
+}
+
+// Deterministic non-constant fill so data-dependent kernels (e.g. branchy
+// activations) see a realistic value mix run over run.
+void FillInput(float* data, int64_t count) {
+  uint32_t state = 0x9e3779b9;
+  for (int64_t i = 0; i < count; ++i) {
+    state = state * 1664525 + 1013904223;
+    data[i] = static_cast<float>(static_cast<int32_t>(state >> 16) % 512 - 256) * 0.0078125f;
+  }
+}
+
+Status BuildModel(const BenchmarkCase& benchmark_case, std::unique_ptr<Model>& model,
+                  std::vector<std::string>& input_names) {
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[kOnnxDomain] = benchmark_case.opset;
+  if (!benchmark_case.domain.empty())
+    domain_to_version[benchmark_case.domain] = benchmark_case.opset;
+
+  model = std::make_unique<Model>("opbench", true, ModelMetaData(), IOnnxRuntimeOpSchemaRegistryList(),
+                                  domain_to_version);
+  Graph& graph = model->MainGraph();
+
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+
+  std::vector<NodeArg*> input_defs;
+  for (size_t i = 0; i < benchmark_case.input_shapes.size(); ++i) {
+    std::string name = "I" + std::to_string(i);
+    TypeProto input_type(tensor_float);
+    auto* shape_proto = input_type.mutable_tensor_type()->mutable_shape();
+    for (int64_t dim : benchmark_case.input_shapes[i])
+      shape_proto->add_dim()->set_dim_value(dim);
+    input_defs.push_back(&graph.GetOrCreateNodeArg(name, &input_type));
+    input_names.push_back(name);
+  }
+
+  std::vector<NodeArg*> output_defs{&graph.GetOrCreateNodeArg("O0", &tensor_float)};
+
+  Node& node = graph.AddNode("bench_node", benchmark_case.op_type, "op under benchmark",
+                             input_defs, output_defs, nullptr, benchmark_case.domain);
+  for (const auto& attr : benchmark_case.attributes)
+    ONNXRUNTIME_RETURN_IF_ERROR(ApplyAttribute(node, attr.first, attr.second));
+
+  return graph.Resolve();
+}
+
+}  // namespace
+
+Status OpBenchmarkRunner::LoadSpec(const std::string& path, std::vector<BenchmarkCase>& cases) {
+  std::ifstream spec(path);
+  if (!spec)
+    return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "cannot open spec file: " + path);
+
+  std::string line;
+  int line_number = 0;
+  while (std::getline(spec, line)) {
+    ++line_number;
+    const size_t comment = line.find('#');
+    if (comment != std::string::npos)
+      line.resize(comment);
+
+    std::stringstream stream(line);
+    BenchmarkCase benchmark_case;
+    std::string domain_token, shapes_token;
+    if (!(stream >> benchmark_case.op_type))
+      continue;  // blank line
+    if (!(stream >> domain_token >> benchmark_case.opset >> shapes_token))
+      return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                    "spec line " + std::to_string(line_number) + " needs: op domain opset shapes");
+    if (domain_token != "-")
+      benchmark_case.domain = domain_token;
+
+    std::stringstream shape_stream(shapes_token);
+    std::string shape_token;
+    while (std::getline(shape_stream, shape_token, ';')) {
+      std::vector<int64_t> shape;
+      ONNXRUNTIME_RETURN_IF_ERROR(ParseShape(shape_token, shape));
+      benchmark_case.input_shapes.push_back(std::move(shape));
+    }
+
+    std::string attr_token;
+    while (stream >> attr_token) {
+      const size_t eq = attr_token.find('=');
+      if (eq == std::string::npos || eq == 0)
+        return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                      "spec line " + std::to_string(line_number) + " invalid attribute: " + attr_token);
+      benchmark_case.attributes.emplace_back(attr_token.substr(0, eq), attr_token.substr(eq + 1));
+    }
+
+    cases.push_back(std::move(benchmark_case));
+  }
+  return Status::OK();
+}
+
+Status OpBenchmarkRunner::Run(const BenchmarkCase& benchmark_case, BenchmarkResult& result) const {
+  std::unique_ptr<Model> model;
+  std::vector<std::string> input_names;
+  ONNXRUNTIME_RETURN_IF_ERROR(BuildModel(benchmark_case, model, input_names));
+
+  SessionOptions session_options;
+  session_options.session_logid = "opbench";
+  InferenceSession session(session_options);
+
+  std::stringstream model_stream;
+  model->ToProto().SerializeToOstream(&model_stream);
+  ONNXRUNTIME_RETURN_IF_ERROR(session.Load(model_stream));
+  ONNXRUNTIME_RETURN_IF_ERROR(session.Initialize());
+
+  AllocatorPtr allocator = std::make_shared<CPUAllocator>();
+  NameMLValMap feeds;
+  for (size_t i = 0; i < benchmark_case.input_shapes.size(); ++i) {
+    TensorShape shape(benchmark_case.input_shapes[i]);
+    auto element_type = DataTypeImpl::GetType<float>();
+    void* buffer = allocator->Alloc(element_type->Size() * shape.Size());
+    FillInput(static_cast<float*>(buffer), shape.Size());
+    std::unique_ptr<Tensor> tensor = std::make_unique<Tensor>(element_type, shape, buffer,
+                                                              allocator->Info(), allocator);
+    MLValue value;
+    value.Init(tensor.release(), DataTypeImpl::GetType<Tensor>(),
+               DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+    feeds[input_names[i]] = value;
+  }
+
+  std::vector<std::string> output_names{"O0"};
+  std::vector<MLValue> fetches;
+
+  for (size_t i = 0; i < warmup_runs_; ++i) {
+    fetches.clear();
+    ONNXRUNTIME_RETURN_IF_ERROR(session.Run(feeds, output_names, &fetches));
+  }
+
+  std::vector<double> timings_ns(measured_runs_);
+  for (size_t i = 0; i < measured_runs_; ++i) {
+    fetches.clear();
+    auto start = std::chrono::high_resolution_clock::now();
+    ONNXRUNTIME_RETURN_IF_ERROR(session.Run(feeds, output_names, &fetches));
+    auto end = std::chrono::high_resolution_clock::now();
+    timings_ns[i] = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+  }
+
+  std::sort(timings_ns.begin(), timings_ns.end());
+  double total = 0;
+  for (double t : timings_ns) total += t;
+
+  result.case_id = MakeCaseId(benchmark_case);
+  result.repeat = measured_runs_;
+  result.mean_ns = total / static_cast<double>(measured_runs_);
+  result.min_ns = timings_ns.front();
+  result.p50_ns = timings_ns[measured_runs_ / 2];
+  result.max_ns = timings_ns.back();
+  return Status::OK();
+}
+
+void OpBenchmarkRunner::ReportCoverage(const std::vector<BenchmarkCase>& cases, std::ostream& out) {
+  CPUExecutionProvider provider{CPUExecutionProviderInfo{}};
+  auto registry = provider.GetKernelRegistry();
+  auto registered = registry->GetAllRegisteredOpNames();
+  std::set<std::string> registered_ops(registered.begin(), registered.end());
+
+  std::set<std::string> covered_ops;
+  for (const auto& benchmark_case : cases)
+    covered_ops.insert(benchmark_case.op_type);
+
+  std::vector<std::string> uncovered;
+  for (const auto& op : registered_ops) {
+    if (covered_ops.count(op) == 0)
+      uncovered.push_back(op);
+  }
+
+  out << "kernel coverage: " << covered_ops.size() << " of " << registered_ops.size()
+      << " registered CPU ops have benchmark cases" << std::endl;
+  if (!uncovered.empty()) {
+    out << "uncovered ops:";
+    for (const auto& op : uncovered)
+      out << ' ' << op;
+    out << std::endl;
+  }
+}
+
+void OpBenchmarkRunner::WriteBaseline(const std::vector<BenchmarkResult>& results, std::ostream& out) {
+  for (const auto& result : results) {
+    out << "{\"case\":\"" << result.case_id << "\",\"repeat\":" << result.repeat
+        << ",\"mean_ns\":" << result.mean_ns << ",\"min_ns\":" << result.min_ns
+        << ",\"p50_ns\":" << result.p50_ns << ",\"max_ns\":" << result.max_ns << "}" << std::endl;
+  }
+}
+
+}  // namespace opbench
+}  // namespace onnxruntime
@@ -0,0 +1,70 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+// onnxruntime dependencies
+#include <core/common/common.h>
+#include <core/common/status.h>
+#include <core/session/inference_session.h>
+
+namespace onnxruntime {
+namespace opbench {
+
+// One benchmark case: a single-node model built around the op under test.
+// Input shapes come from the spec file (one case per shape point of the
+// distribution we care about), so the same op appears once per shape.
+struct BenchmarkCase {
+  std::string op_type;
+  std::string domain;  // empty means the default ONNX domain
+  int opset{9};
+  std::vector<std::vector<int64_t>> input_shapes;
+  // raw attribute tokens from the spec, e.g. "axis=i:1" or "alpha=f:0.5"
+  std::vector<std::pair<std::string, std::string>> attributes;
+};
+
+struct BenchmarkResult {
+  std::string case_id;  // op plus shapes, stable across runs for diffing
+  size_t repeat{0};
+  double mean_ns{0};
+  double min_ns{0};
+  double p50_ns{0};
+  double max_ns{0};
+};
+
+// Runs benchmark cases through a real InferenceSession so each measured
+// iteration goes through the production OpKernelContext/Compute path, and
+// reports which registered CPU kernels have no case at all.
+class OpBenchmarkRunner {
+ public:
+  OpBenchmarkRunner(size_t warmup_runs, size_t measured_runs)
+      : warmup_runs_(warmup_runs), measured_runs_(measured_runs) {}
+
+  // Parse the spec file. Line format (whitespace separated, '#' comments):
+  //   <op> <domain or -> <opset> <shape>[;<shape>...] [attr=i:v|f:v|is:v,v|fs:v,v|s:v ...]
+  // e.g.  MatMul - 9 64x128;128x256
+  //       Softmax - 9 32x1000 axis=i:1
+  static common::Status LoadSpec(const std::string& path, std::vector<BenchmarkCase>& cases);
+
+  common::Status Run(const BenchmarkCase& benchmark_case, BenchmarkResult& result) const;
+
+  // List registered CPU op names that no case covers, so gaps in the shape
+  // distributions are visible alongside the baselines.
+  static void ReportCoverage(const std::vector<BenchmarkCase>& cases, std::ostream& out);
+
+  // One JSON object per line; a line-diff against the previous baseline file
+  // is the regression check.
+  static void WriteBaseline(const std::vector<BenchmarkResult>& results, std::ostream& out);
+
+ private:
+  size_t warmup_runs_;
+  size_t measured_runs_;
+};
+
+}  // namespace opbench
+}  // namespace onnxruntime
@@ -31,6 +31,8 @@ namespace perftest {
       "\t-r [repeated_times]: Specifies the repeated times if running in 'times' test mode.Default:1000.\n"
       "\t-t [seconds_to_run]: Specifies the seconds to run for 'duration' mode. Default:600.\n"
       "\t-p [profile_file]: Specifies the profile name to enable profiling and dump the profile data to the file.\n"
+      "\t-c [concurrent_clients]: Specifies the number of concurrent callers issuing requests in a closed loop over one session. Default:1.\n"
+      "\t-w [warmup_iterations]: Specifies the number of warmup iterations to run before collecting statistics. Default:1.\n"
       "\t-s: Show statistics result, like P75, P90.\n"
       "\t-v: Show verbose information.\n"
       "\t-x: Use parallel executor, default (without -x): sequential executor.\n"
@@ -39,7 +41,7 @@ namespace perftest {
 
 /*static*/ bool CommandLineParser::ParseArguments(PerformanceTestConfig& test_config, int argc, char* argv[]) {
   int ch;
-  while ((ch = getopt(argc, argv, "m:e:r:t:p:xvhs")) != -1) {
+  while ((ch = getopt(argc, argv, "m:e:r:t:p:c:w:xvhs")) != -1) {
     switch (ch) {
       case 'm':
         if (!strcmp(optarg, "duration")) {
@@ -78,6 +80,15 @@ namespace perftest {
           return false;
         }
         break;
+      case 'c':
+        test_config.run_config.concurrent_clients = static_cast<int>(strtol(optarg, nullptr, 10));
+        if (test_config.run_config.concurrent_clients <= 0) {
+          return false;
+        }
+        break;
+      case 'w':
+        test_config.run_config.warmup_iterations = static_cast<int>(strtol(optarg, nullptr, 10));
+        break;
       case 's':
         test_config.run_config.f_dump_statistics = true;
         break;
@@ -2,6 +2,8 @@
 // Licensed under the MIT License.
 
 #include "performance_runner.h"
+#include <atomic>
+#include <thread>
 #include "TestCase.h"
 #include <experimental/filesystem>
 #ifdef _MSC_VER
@@ -22,22 +24,28 @@ Status PerformanceRunner::Run() {
     return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, "failed to initialize.");
   }
 
-  // warm up
-  RunOneIteration(true /*isWarmup*/);
+  // warm up, excluded from the statistics
+  for (size_t ite = 0; ite < performance_test_config_.run_config.warmup_iterations; ite++) {
+    RunOneIteration(true /*isWarmup*/);
+  }
 
   if (!performance_test_config_.run_config.profile_file.empty())
     session_object_->StartProfiling(performance_test_config_.run_config.profile_file);
 
   std::unique_ptr<utils::ICPUUsage> p_ICPUUsage = utils::CreateICPUUsage();
-  switch (performance_test_config_.run_config.test_mode) {
-    case TestMode::kFixDurationMode:
-      ONNXRUNTIME_RETURN_IF_ERROR(RunFixDuration());
-      break;
-    case TestMode::KFixRepeatedTimesMode:
-      ONNXRUNTIME_RETURN_IF_ERROR(RunRepeatedTimes());
-      break;
-    default:
-      return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, "unknown test mode.");
+  if (performance_test_config_.run_config.concurrent_clients > 1) {
+    ONNXRUNTIME_RETURN_IF_ERROR(RunParallel());
+  } else {
+    switch (performance_test_config_.run_config.test_mode) {
+      case TestMode::kFixDurationMode:
+        ONNXRUNTIME_RETURN_IF_ERROR(RunFixDuration());
+        break;
+      case TestMode::KFixRepeatedTimesMode:
+        ONNXRUNTIME_RETURN_IF_ERROR(RunRepeatedTimes());
+        break;
+      default:
+        return ONNXRUNTIME_MAKE_STATUS(ONNXRUNTIME, FAIL, "unknown test mode.");
+    }
   }
   performance_result_.average_CPU_usage = p_ICPUUsage->GetUsage();
   performance_result_.peak_workingset_size = utils::GetPeakWorkingSetSize();
@@ -48,6 +56,58 @@ Status PerformanceRunner::Run() {
   std::cout << "Total time cost:" << performance_result_.total_time_cost << std::endl
             << "Total iterations:" << performance_result_.time_costs.size() << std::endl
             << "Average time cost:" << performance_result_.total_time_cost / performance_result_.time_costs.size() * 1000 << " ms" << std::endl;
+  if (performance_test_config_.run_config.f_dump_statistics) {
+    performance_result_.DumpStatistics(std::cout);
+  }
+  return Status::OK();
+}
+
+Status PerformanceRunner::RunParallel() {
+  const size_t client_count = performance_test_config_.run_config.concurrent_clients;
+  const bool fixed_times = performance_test_config_.run_config.test_mode == TestMode::KFixRepeatedTimesMode;
+  // the iteration budget is shared between the clients in 'times' mode
+  std::atomic<long long> remaining_iterations{
+      static_cast<long long>(performance_test_config_.run_config.repeated_times)};
+  const auto deadline = std::chrono::high_resolution_clock::now() +
+                        std::chrono::seconds(performance_test_config_.run_config.duration_in_seconds);
+
+  std::vector<std::vector<double>> client_time_costs(client_count);
+  std::vector<Status> client_status(client_count, Status::OK());
+  std::vector<std::thread> clients;
+  for (size_t i = 0; i < client_count; i++) {
+    clients.emplace_back([this, i, fixed_times, deadline, &remaining_iterations,
+                          &client_time_costs, &client_status]() {
+      IOBinding& io_binding = *io_bindings_[i];
+      auto& time_costs = client_time_costs[i];
+      while (true) {
+        if (fixed_times) {
+          if (remaining_iterations.fetch_sub(1) <= 0) break;
+        } else if (std::chrono::high_resolution_clock::now() >= deadline) {
+          break;
+        }
+        auto start = std::chrono::high_resolution_clock::now();
+        Status status = session_object_->Run(io_binding);
+        auto end = std::chrono::high_resolution_clock::now();
+        if (!status.IsOK()) {
+          client_status[i] = status;
+          break;
+        }
+        std::chrono::duration<double> duration_seconds = end - start;
+        time_costs.emplace_back(duration_seconds.count());
+      }
+    });
+  }
+  for (auto& client : clients) {
+    client.join();
+  }
+
+  for (size_t i = 0; i < client_count; i++) {
+    ONNXRUNTIME_RETURN_IF_ERROR(client_status[i]);
+    for (double time_cost : client_time_costs[i]) {
+      performance_result_.time_costs.emplace_back(time_cost);
+      performance_result_.total_time_cost += time_cost;
+    }
+  }
   return Status::OK();
 }
 
@@ -82,10 +142,15 @@ bool PerformanceRunner::Initialize() {
 
   sf.create(session_object_, test_case->GetModelUrl(), test_case->GetTestCaseName());
 
-  // Initialize IO Binding
-  if (!session_object_->NewIOBinding(&io_binding_).IsOK()) {
-    LOGF_DEFAULT(ERROR, "Failed to init session and IO binding");
-    return false;
+  // Initialize IO Bindings, one per concurrent client
+  size_t client_count = performance_test_config_.run_config.concurrent_clients;
+  if (client_count < 1) client_count = 1;
+  io_bindings_.resize(client_count);
+  for (size_t i = 0; i < client_count; i++) {
+    if (!session_object_->NewIOBinding(&io_bindings_[i]).IsOK()) {
+      LOGF_DEFAULT(ERROR, "Failed to init session and IO binding");
+      return false;
+    }
   }
 
   auto provider_type = performance_test_config_.machine_config.provider_type_name;
@@ -94,7 +159,7 @@ bool PerformanceRunner::Initialize() {
   if (provider_type == onnxruntime::kMklDnnExecutionProvider) {
     provider_type = onnxruntime::kCpuExecutionProvider;
   }
-  AllocatorPtr cpu_allocator = io_binding_->GetCPUAllocator(0, provider_type);
+  AllocatorPtr cpu_allocator = io_bindings_[0]->GetCPUAllocator(0, provider_type);
   test_case->SetAllocator(cpu_allocator);
 
   if (test_case->GetDataCount() <= 0) {
@@ -104,9 +169,6 @@ bool PerformanceRunner::Initialize() {
 
   std::unordered_map<std::string, ::onnxruntime::MLValue> feeds;
   test_case->LoadTestData(0 /* id */, feeds, true);
-  for (auto feed : feeds) {
-    io_binding_->BindInput(feed.first, feed.second);
-  }
   auto outputs = session_object_->GetModelOutputs();
   auto status = outputs.first;
   if (!outputs.first.IsOK()) {
@@ -116,11 +178,18 @@ bool PerformanceRunner::Initialize() {
     return false;
   }
 
-  std::vector<MLValue> output_mlvalues(outputs.second->size());
-  for (size_t i_output = 0; i_output < outputs.second->size(); ++i_output) {
-    auto output = outputs.second->at(i_output);
-    if (!output) continue;
-    io_binding_->BindOutput(output->Name(), output_mlvalues[i_output]);
+  // the clients share the input tensors but each binds its own outputs
+  for (auto& io_binding : io_bindings_) {
+    for (auto feed : feeds) {
+      io_binding->BindInput(feed.first, feed.second);
+    }
+
+    std::vector<MLValue> output_mlvalues(outputs.second->size());
+    for (size_t i_output = 0; i_output < outputs.second->size(); ++i_output) {
+      auto output = outputs.second->at(i_output);
+      if (!output) continue;
+      io_binding->BindOutput(output->Name(), output_mlvalues[i_output]);
+    }
   }
 
   return true;
@@ -30,6 +30,49 @@ struct PerformanceResult {
   std::vector<double> time_costs;
   std::string model_name;
 
+  // Write latency percentiles and a histogram of the collected time costs.
+  void DumpStatistics(std::ostream& out) const {
+    if (time_costs.empty()) return;
+
+    std::vector<double> sorted_time = time_costs;
+
+    size_t total = sorted_time.size();
+    size_t n50 = static_cast<size_t>(total * 0.5);
+    size_t n90 = static_cast<size_t>(total * 0.9);
+    size_t n95 = static_cast<size_t>(total * 0.95);
+    size_t n99 = static_cast<size_t>(total * 0.99);
+    size_t n999 = static_cast<size_t>(total * 0.999);
+
+    std::sort(sorted_time.begin(), sorted_time.end());
+
+    out << "P50 Latency is " << sorted_time[n50] << "sec" << std::endl;
+    out << "P90 Latency is " << sorted_time[n90] << "sec" << std::endl;
+    out << "P95 Latency is " << sorted_time[n95] << "sec" << std::endl;
+    out << "P99 Latency is " << sorted_time[n99] << "sec" << std::endl;
+    out << "P999 Latency is " << sorted_time[n999] << "sec" << std::endl;
+
+    out << std::endl
+        << "Latency histogram:" << std::endl;
+    constexpr size_t histogram_buckets = 20;
+    double min_time = sorted_time.front();
+    double max_time = sorted_time.back();
+    double bucket_width = (max_time - min_time) / histogram_buckets;
+    if (bucket_width <= 0.0) {
+      out << min_time << " : " << total << std::endl;
+    } else {
+      std::vector<size_t> counts(histogram_buckets, 0);
+      for (double t : sorted_time) {
+        size_t bucket = static_cast<size_t>((t - min_time) / bucket_width);
+        if (bucket >= histogram_buckets) bucket = histogram_buckets - 1;
+        counts[bucket]++;
+      }
+      for (size_t bucket = 0; bucket < histogram_buckets; bucket++) {
+        out << min_time + bucket * bucket_width << " - "
+            << min_time + (bucket + 1) * bucket_width << " : " << counts[bucket] << std::endl;
+      }
+    }
+  }
+
   void DumpToFile(const std::string& path, bool f_include_statistics = false) const {
     std::ofstream outfile;
     outfile.open(path, std::ofstream::out | std::ofstream::app);
@@ -43,23 +86,8 @@ struct PerformanceResult {
     }
 
     if (time_costs.size() > 0 && f_include_statistics) {
-      std::vector<double> sorted_time = time_costs;
-
-      size_t total = sorted_time.size();
-      size_t n50 = static_cast<size_t>(total * 0.5);
-      size_t n90 = static_cast<size_t>(total * 0.9);
-      size_t n95 = static_cast<size_t>(total * 0.95);
-      size_t n99 = static_cast<size_t>(total * 0.99);
-      size_t n999 = static_cast<size_t>(total * 0.999);
-
-      std::sort(sorted_time.begin(), sorted_time.end());
-
       outfile << std::endl;
-      outfile << "P50 Latency is " << sorted_time[n50] << "sec" << std::endl;
-      outfile << "P90 Latency is " << sorted_time[n90] << "sec" << std::endl;
-      outfile << "P95 Latency is " << sorted_time[n95] << "sec" << std::endl;
-      outfile << "P99 Latency is " << sorted_time[n99] << "sec" << std::endl;
-      outfile << "P999 Latency is " << sorted_time[n999] << "sec" << std::endl;
+      DumpStatistics(outfile);
     }
 
     outfile.close();
@@ -81,7 +109,7 @@ class PerformanceRunner {
 
   inline Status RunOneIteration(bool isWarmup = false) {
     auto start = std::chrono::high_resolution_clock::now();
-    ONNXRUNTIME_RETURN_IF_ERROR(session_object_->Run(*io_binding_));
+    ONNXRUNTIME_RETURN_IF_ERROR(session_object_->Run(*io_bindings_[0]));
     auto end = std::chrono::high_resolution_clock::now();
 
     if (!isWarmup) {
@@ -110,12 +138,20 @@ class PerformanceRunner {
     return Status::OK();
   }
 
+  // Closed-loop concurrent mode: run_config.concurrent_clients threads each
+  // issue back-to-back requests against the shared session through their own
+  // IO binding. Handles both test modes; in 'times' mode the repeated_times
+  // budget is shared between the clients, in 'duration' mode every client
+  // runs until the wall clock deadline.
+  Status RunParallel();
+
  private:
   PerformanceResult performance_result_;
   PerformanceTestConfig performance_test_config_;
 
   std::shared_ptr<::onnxruntime::InferenceSession> session_object_;
-  std::unique_ptr<IOBinding> io_binding_;
+  // one binding per concurrent client so callers do not race on the bound outputs
+  std::vector<std::unique_ptr<IOBinding>> io_bindings_;
 };
 }  // namespace perftest
 }  // namespace onnxruntime
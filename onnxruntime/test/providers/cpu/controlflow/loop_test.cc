@@ -462,5 +462,76 @@ TEST(Loop, InfiniteLoopTermination) {
   terminator_thread.join();
 }
 
+TEST(Loop, InfiniteLoopDeadline) {
+  // same infinite subgraph as InfiniteLoopTermination, but abandoned by the
+  // run deadline instead of an external terminate thread.
+  auto create_subgraph = [](const RunOptions&) {
+    Model model("Infinite Loop subgraph");
+    auto& graph = model.MainGraph();
+
+    std::vector<NodeArg*> inputs;
+    std::vector<NodeArg*> outputs;
+
+    TypeProto int64_scalar;
+    int64_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+    int64_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+    TypeProto bool_scalar;
+    bool_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_BOOL);
+    bool_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+    TypeProto float_tensor;
+    float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+    float_tensor.mutable_tensor_type()->mutable_shape()->add_dim();
+
+    auto& iter_num_in = graph.GetOrCreateNodeArg("iter_num_in", &int64_scalar);
+    auto& cond_in = graph.GetOrCreateNodeArg("cond_in", &bool_scalar);
+
+    auto& outer_scope_0 = graph.GetOrCreateNodeArg("outer_scope_0", &float_tensor);
+    graph.AddOuterScopeNodeArg("outer_scope_0");
+
+    auto& cond_out = graph.GetOrCreateNodeArg("cond_out", &bool_scalar);
+    auto& loop_var_0_out = graph.GetOrCreateNodeArg("loop_var_0_out", &float_tensor);
+
+    // cond_in -> cond_out, so the loop never finishes on its own
+    {
+      inputs = {&cond_in};
+      outputs = {&cond_out};
+
+      graph.AddNode("cond_in_identity", "Identity", "Forward cond_in to cond_out", inputs, outputs);
+    }
+
+    {
+      inputs = {&outer_scope_0};
+      outputs = {&loop_var_0_out};
+
+      graph.AddNode("loop_var_out", "Identity", "Forward outer_scope_0 to loop_var_0_out", inputs, outputs);
+    }
+
+    graph.SetInputOrder({&iter_num_in, &cond_in, &outer_scope_0});
+    graph.SetOutputOrder({&cond_out, &loop_var_0_out});
+
+    auto status = graph.Resolve();
+    EXPECT_EQ(status, Status::OK());
+
+    return graph.ToGraphProto();
+  };
+
+  LoopOpTester test{{}, create_subgraph};
+
+  test.AddInput<int64_t>("M", {1}, {INT64_MAX});
+  test.AddInput<bool>("cond", {1}, {true});
+  test.AddInput<float>("fake", {1}, {0.f});
+
+  test.AddOutput<float>("loop_var_0_final", {1}, {0.f});
+
+  ONNXRuntimeRunOptions session_run_options;
+  session_run_options.run_tag = "Loop.InfiniteLoopDeadline";
+  session_run_options.run_timeout_in_milliseconds = 500;
+
+  test.Run(OpTester::ExpectResult::kExpectFailure, "Exiting due to the run deadline being exceeded", {},
+           &session_run_options);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -403,6 +403,23 @@ TEST(MathOpTest, Pow_Broadcast_Scalar1) {
   test.Run();
 }
 
+// a constant-initializer scalar exponent takes the specialized fast path
+// selected at kernel construction.
+TEST(MathOpTest, Pow_Constant_Exponent) {
+  for (float exponent : {2.0f, 3.0f, 0.5f, -0.5f, -1.0f, 1.3f}) {
+    OpTester test("Pow");
+    std::vector<int64_t> dims{4};
+    std::vector<float> x{1.0f, 2.0f, 4.0f, 9.0f};
+    std::vector<float> z;
+    for (float v : x) z.push_back(std::pow(v, exponent));
+    test.AddInput<float>("X", dims, x);
+    test.AddInput<float>("Y", {}, {exponent}, /*is_initializer*/ true);
+    test.AddOutput<float>("Z", dims, z);
+    test.SetOutputRelErr("Z", 1e-6f);
+    test.Run();
+  }
+}
+
 TEST(MathOpTest, Exp) {
   OpTester test("Exp");
   std::vector<int64_t> dims{2, 2};
@@ -161,5 +161,45 @@ TEST(MathOpTest, GemmFalseBroadcast) {
   test.Run();
 }
 
+TEST(MathOpTest, GemmConstantWeight) {
+  // B as a constant initializer exercises the pre-packed weight path.
+  OpTester test("Gemm");
+
+  test.AddAttribute("transA", (int64_t)0);
+  test.AddAttribute("transB", (int64_t)0);
+  test.AddAttribute("alpha", 1.0f);
+  test.AddAttribute("beta", 1.0f);
+
+  test.AddInput<float>("A", {2, 4},
+                       {1.0f, 2.0f, 3.0f, 4.0f,
+                        -1.0f, -2.0f, -3.0f, -4.0f});
+  test.AddInput<float>("B", {4, 3}, std::vector<float>(12, 1.0f), /*is_initializer*/ true);
+  test.AddInput<float>("C", {2, 3}, std::vector<float>(6, 1.0f));
+  test.AddOutput<float>("Y", {2, 3},
+                        {11.0f, 11.0f, 11.0f,
+                         -9.0f, -9.0f, -9.0f});
+  test.Run();
+}
+
+TEST(MathOpTest, GemmConstantWeightTransB) {
+  // A transposed constant B is packed in its transposed form.
+  OpTester test("Gemm");
+
+  test.AddAttribute("transA", (int64_t)0);
+  test.AddAttribute("transB", (int64_t)1);
+  test.AddAttribute("alpha", 1.0f);
+  test.AddAttribute("beta", 1.0f);
+
+  test.AddInput<float>("A", {2, 4},
+                       {1.0f, 2.0f, 3.0f, 4.0f,
+                        -1.0f, -2.0f, -3.0f, -4.0f});
+  test.AddInput<float>("B", {3, 4}, std::vector<float>(12, 1.0f), /*is_initializer*/ true);
+  test.AddInput<float>("C", {3}, std::vector<float>{1.0f, 2.0f, 3.0f});
+  test.AddOutput<float>("Y", {2, 3},
+                        {11.0f, 12.0f, 13.0f,
+                         -9.0f, -8.0f, -7.0f});
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
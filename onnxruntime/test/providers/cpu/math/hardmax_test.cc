@@ -135,6 +135,24 @@ TEST(HardmaxOperator, ThreeDimsAxis2) {
   RunTest(x_vals_3dims, expected_vals, three_dimensions, /*axis*/ 2);
 }
 
+TEST(HardmaxOperator, WideRowsWithTies) {
+  // rows wider than the SIMD width; the maximum falls in different lanes, in
+  // the scalar tail, and tied (the one must land on the first occurrence)
+  std::vector<int64_t> dimensions = {3, 13};
+  std::vector<float> x_vals(3 * 13, 0.0f);
+  x_vals[0 * 13 + 5] = 1.0f;
+  x_vals[1 * 13 + 12] = 1.0f;
+  x_vals[2 * 13 + 3] = 1.0f;
+  x_vals[2 * 13 + 9] = 1.0f;
+
+  std::vector<float> expected_vals(3 * 13, 0.0f);
+  expected_vals[0 * 13 + 5] = 1.0f;
+  expected_vals[1 * 13 + 12] = 1.0f;
+  expected_vals[2 * 13 + 3] = 1.0f;
+
+  RunTest(x_vals, expected_vals, dimensions);
+}
+
 TEST(HardmaxOperator, InvalidAxis) {
   std::vector<float> x_vals = {-1.0f, 0.0f, 1.0f};
   std::vector<float> expected_vals = {0.0f, 0.0f, 0.0f};
@@ -1,6 +1,10 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 #include "core/providers/cpu/math/logsoftmax.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -54,6 +58,36 @@ TEST(LogSoftmaxOperator, LargeNumber) {
   RunTest(x_vals, expected_vals, dimensions);
 }
 
+TEST(LogSoftmaxOperator, LargeMatrixParallelRows) {
+  // big enough to take the row-block parallel path in SoftmaxCPU; the
+  // expected values come from the textbook formula in double precision
+  const int64_t N = 64;
+  const int64_t D = 2048;
+
+  std::vector<float> x_vals(N * D);
+  std::vector<float> expected_vals(N * D);
+
+  for (int64_t i = 0; i < N; ++i) {
+    double max_val = std::numeric_limits<double>::lowest();
+    for (int64_t j = 0; j < D; ++j) {
+      x_vals[i * D + j] = static_cast<float>((i * 7 + j * 13) % 31 - 15) * 0.25f;
+      max_val = std::max(max_val, static_cast<double>(x_vals[i * D + j]));
+    }
+
+    double sum = 0.0;
+    for (int64_t j = 0; j < D; ++j) {
+      sum += std::exp(x_vals[i * D + j] - max_val);
+    }
+
+    const double offset = max_val + std::log(sum);
+    for (int64_t j = 0; j < D; ++j) {
+      expected_vals[i * D + j] = static_cast<float>(x_vals[i * D + j] - offset);
+    }
+  }
+
+  RunTest(x_vals, expected_vals, {N, D});
+}
+
 //np.random.seed(123)   # Use a seed so we can replicate the input and expected values here and in python
 //x = np.abs(np.random.randn(3, 4, 5).astype(np.float32))
 static std::vector<int64_t> three_dimensions = {3, 4, 5};
@@ -77,5 +77,48 @@ TEST(MathOpTest, MatMul) {
   }
 }
 
+TEST(MathOpTest, MatMulConstantWeight) {
+  // B as a constant initializer exercises the pre-packed weight path.
+  OpTester test("MatMul");
+
+  test.AddInput<float>("A", {2, 4},
+                       {0.0f, 1.0f, 2.0f, 3.0f,
+                        4.0f, 5.0f, 6.0f, 7.0f});
+  test.AddInput<float>("B", {4, 3},
+                       {0.0f, 1.0f, 2.0f,
+                        3.0f, 4.0f, 5.0f,
+                        6.0f, 7.0f, 8.0f,
+                        9.0f, 10.0f, 11.0f},
+                       /*is_initializer*/ true);
+  test.AddOutput<float>("Y", {2, 3},
+                        {42.0f, 48.0f, 54.0f,
+                         114.0f, 136.0f, 158.0f});
+  test.Run();
+}
+
+TEST(MathOpTest, MatMulSparseConstantWeight) {
+  // A constant B where only one of the four 4x4 blocks is non-zero exercises
+  // the block-sparse weight path.
+  OpTester test("MatMul");
+
+  test.AddInput<float>("A", {2, 8},
+                       {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f,
+                        9.0f, 10.0f, 11.0f, 12.0f, 13.0f, 14.0f, 15.0f, 16.0f});
+  test.AddInput<float>("B", {8, 8},
+                       {1.0f, 2.0f, 3.0f, 4.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+                        5.0f, 6.0f, 7.0f, 8.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+                        9.0f, 10.0f, 11.0f, 12.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+                        13.0f, 14.0f, 15.0f, 16.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+                        0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+                        0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+                        0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+                        0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f},
+                       /*is_initializer*/ true);
+  test.AddOutput<float>("Y", {2, 8},
+                        {90.0f, 100.0f, 110.0f, 120.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+                         314.0f, 356.0f, 398.0f, 440.0f, 0.0f, 0.0f, 0.0f, 0.0f});
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
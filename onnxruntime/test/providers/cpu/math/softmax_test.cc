@@ -1,6 +1,10 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 #include "core/providers/cpu/math/softmax_shared.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -50,6 +54,36 @@ TEST(SoftmaxOperator, LargeNumber) {
   RunTest(x_vals, expected_vals, dimensions);
 }
 
+TEST(SoftmaxOperator, WideRowsParallelBlocks) {
+  // decoder-shaped batch: few rows, wide vocabulary axis. N * D is large
+  // enough to take the row-block parallel path in SoftmaxCPU; the expected
+  // values come from the textbook formula in double precision
+  const int64_t N = 16;
+  const int64_t D = 8192;
+
+  std::vector<float> x_vals(N * D);
+  std::vector<float> expected_vals(N * D);
+
+  for (int64_t i = 0; i < N; ++i) {
+    double max_val = std::numeric_limits<double>::lowest();
+    for (int64_t j = 0; j < D; ++j) {
+      x_vals[i * D + j] = static_cast<float>((i * 7 + j * 13) % 31 - 15) * 0.25f;
+      max_val = std::max(max_val, static_cast<double>(x_vals[i * D + j]));
+    }
+
+    double sum = 0.0;
+    for (int64_t j = 0; j < D; ++j) {
+      sum += std::exp(x_vals[i * D + j] - max_val);
+    }
+
+    for (int64_t j = 0; j < D; ++j) {
+      expected_vals[i * D + j] = static_cast<float>(std::exp(x_vals[i * D + j] - max_val) / sum);
+    }
+  }
+
+  RunTest(x_vals, expected_vals, {N, D});
+}
+
 //np.random.seed(123)   # Use a seed so we can replicate the input and expected values here and in python
 //x = np.abs(np.random.randn(3, 4, 5).astype(np.float32))
 static std::vector<int64_t> three_dimensions = {3, 4, 5};
@@ -187,46 +221,16 @@ TEST(SoftmaxOperator, InvalidAxis) {
           "-10 is not in valid range [-2,1]");
 }
 
-TEST(SoftmaxOperator, TestInputTooLarge) {
+TEST(SoftmaxOperator, TestInvalidDimensions) {
   float* ignored = nullptr;
 
-  // N > INT32_MAX
-  int64_t N = int64_t(INT32_MAX) + 1;
-  int64_t D = 1;
-  auto status = SoftmaxCPU(N, D, ignored, ignored, ignored, ignored, true, ignored);
-  EXPECT_EQ(status.Code(), common::INVALID_ARGUMENT);
-
-  // D > INT32_MAX
-  N = 1;
-  D = int64_t(INT32_MAX) + 1;
-  status = SoftmaxCPU(N, D, ignored, ignored, ignored, ignored, true, ignored);
+  // N < 0
+  auto status = SoftmaxCPU(-1, 1, ignored, ignored, true);
   EXPECT_EQ(status.Code(), common::INVALID_ARGUMENT);
 
-  // N * D > INT32_MAX
-  N = int64_t(INT32_MAX) / 2;
-  D = 3;
-  status = SoftmaxCPU(N, D, ignored, ignored, ignored, ignored, true, ignored);
+  // D < 0
+  status = SoftmaxCPU(1, -1, ignored, ignored, true);
   EXPECT_EQ(status.Code(), common::INVALID_ARGUMENT);
-
-  /*
-    common::Status SoftmaxCPU(const int64_t N,
-                              const int64_t D,
-                              const float* Xdata,
-                              float* Ydata,
-                              float* scale,
-                              const float* sum_multiplier,
-                              bool logarithmic,
-                              float* rowmax)
-    {
-        // the Math functions SoftmaxCPU uses only support int32_t as input, so enforce that
-        if (N * D > INT32_MAX || N > INT32_MAX || D > INT32_MAX)
-        {
-            std::ostringstream ss;
-            ss << "SoftmaxCPU inputs N, D and N * D must be < " << INT32_MAX << ". N=" << N << ", D=" << D;
-            std::string msg = ss.str();
-
-            return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, msg);
-        }*/
 }
 }  // namespace test
 }  // namespace onnxruntime
@@ -140,6 +140,37 @@ TEST(ConvTest, Conv1D_Bias) {
   TestConvOp(attrs, {X, W, B}, {X_shape, W_shape, B_shape}, expected_vals, Y_shape);
 }
 
+// covers the pointwise (1x1 kernel, unit stride/dilation, no pad) fast path
+// with multiple images and groups plus a bias, so the batched gemm that reads
+// X directly is exercised rather than the im2col route.
+TEST(ConvTest, Conv1D_Pointwise) {
+  ConvOpAttributes attrs = {
+      "",                     // auto_pad
+      vector<int64_t>{1},     // dilations
+      2,                      // group
+      vector<int64_t>{1},     // kernel_shape
+      vector<int64_t>{0, 0},  // pads
+      vector<int64_t>{1}      // strides
+  };
+
+  vector<float> X = {-0.5f, 1.25f, 0.25f, -0.75f, 1.0f, 0.0f, -1.0f, 0.75f, -0.25f, -1.25f,
+                     0.5f, -0.5f, 1.25f, 0.25f, -0.75f, 1.0f, 0.0f, -1.0f, 0.75f, -0.25f,
+                     -1.25f, 0.5f, -0.5f, 1.25f, 0.25f, -0.75f, 1.0f, 0.0f, -1.0f, 0.75f,
+                     -0.25f, -1.25f, 0.5f, -0.5f, 1.25f, 0.25f, -0.75f, 1.0f, 0.0f, -1.0f};
+  vector<int64_t> X_shape = {2, 4, 5};
+  vector<float> W = {-0.5f, -1.5f, 1.0f, 0.0f, -1.0f, 1.5f, 0.5f, -0.5f};
+  vector<int64_t> W_shape = {4, 2, 1};
+  vector<float> B = {0.5f, -0.25f, 0.125f, -0.5f};
+  vector<int64_t> B_shape = {4};
+  vector<int64_t> Y_shape = {2, 4, 5};
+  auto expected_vals = {0.75f, 1.375f, -0.75f, 1.25f, 1.875f, -0.75f, 1.0f, 0.0f, -1.0f, 0.75f,
+                        1.125f, 0.625f, -2.625f, 1.0f, 0.5f, -0.75f, -0.75f, 0.625f, -0.75f, -0.75f,
+                        2.25f, -1.25f, 0.75f, 1.375f, -0.75f, -1.5f, 0.25f, -0.75f, 1.0f, 0.0f,
+                        0.75f, 0.25f, 1.125f, 0.625f, -2.625f, -0.75f, -0.75f, -0.75f, -0.75f, 0.625f};
+
+  TestConvOp(attrs, {X, W, B}, {X_shape, W_shape, B_shape}, expected_vals, Y_shape);
+}
+
 // Conv47
 TEST(ConvTest, Conv2D_1) {
   ConvOpAttributes attrs = {
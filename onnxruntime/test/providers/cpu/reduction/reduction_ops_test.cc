@@ -1103,5 +1103,35 @@ TEST(ReductionOpTest, ArgMin_int32) {
   test.Run();
 }
 
+TEST(ReductionOpTest, ArgMax_LastAxisWideRow) {
+  // rows wider than the SIMD width with maxima in different lanes, in the
+  // scalar tail, and tied (the first occurrence must win)
+  OpTester test("ArgMax");
+  test.AddAttribute("axis", (int64_t)1);
+  test.AddAttribute("keepdims", (int64_t)0);
+  std::vector<float> data(3 * 13, 0.0f);
+  data[0 * 13 + 5] = 1.0f;
+  data[1 * 13 + 12] = 1.0f;
+  data[2 * 13 + 3] = 1.0f;
+  data[2 * 13 + 9] = 1.0f;
+  test.AddInput<float>("data", {3, 13}, data);
+  test.AddOutput<int64_t>("reduced", {3}, {5, 12, 3});
+  test.Run();
+}
+
+TEST(ReductionOpTest, ArgMin_LastAxisWideRow) {
+  OpTester test("ArgMin");
+  test.AddAttribute("axis", (int64_t)1);
+  test.AddAttribute("keepdims", (int64_t)0);
+  std::vector<float> data(3 * 13, 0.0f);
+  data[0 * 13 + 5] = -1.0f;
+  data[1 * 13 + 12] = -1.0f;
+  data[2 * 13 + 3] = -1.0f;
+  data[2 * 13 + 9] = -1.0f;
+  test.AddInput<float>("data", {3, 13}, data);
+  test.AddOutput<int64_t>("reduced", {3}, {5, 12, 3});
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
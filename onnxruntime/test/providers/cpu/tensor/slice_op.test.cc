@@ -134,6 +134,41 @@ TEST(SliceTest, Slice3D) {
   test.Run();
 }
 
+// trailing axes are taken whole, so the copy folds them into contiguous runs
+TEST(SliceTest, Slice4D_ContiguousInnerAxes) {
+  OpTester test("Slice");
+
+  test.AddAttribute("axes", std::vector<int64_t>{0, 1});
+  test.AddAttribute("starts", std::vector<int64_t>{1, 1});
+  test.AddAttribute("ends", std::vector<int64_t>{2, 3});
+
+  std::vector<float> input;
+  for (int i = 0; i < 2 * 3 * 2 * 2; ++i)
+    input.push_back(static_cast<float>(i));
+  test.AddInput<float>("data", {2, 3, 2, 2}, input);
+  test.AddOutput<float>("output", {1, 2, 2, 2},
+                        {16.0f, 17.0f, 18.0f, 19.0f,
+                         20.0f, 21.0f, 22.0f, 23.0f});
+  test.Run();
+}
+
+// effective rank exceeds the unrolled specializations; exercises the fallback
+TEST(SliceTest, Slice6D) {
+  OpTester test("Slice");
+
+  test.AddAttribute("starts", std::vector<int64_t>{0, 1, 0, 1, 0, 1});
+  test.AddAttribute("ends", std::vector<int64_t>{2, 2, 2, 2, 2, 2});
+
+  std::vector<float> input;
+  for (int i = 0; i < 64; ++i)
+    input.push_back(static_cast<float>(i));
+  test.AddInput<float>("data", {2, 2, 2, 2, 2, 2}, input);
+  test.AddOutput<float>("output", {2, 1, 2, 1, 2, 1},
+                        {21.0f, 23.0f, 29.0f, 31.0f,
+                         53.0f, 55.0f, 61.0f, 63.0f});
+  test.Run();
+}
+
 TEST(SliceTest, Slice1D_Int) {
   OpTester test("Slice");
 
@@ -64,5 +64,27 @@ TEST(TensorOpTest, Tile3D) {
   test.Run();
 }
 
+TEST(TensorOpTest, Tile3D_AllAxes) {
+  OpTester test("Tile");
+
+  test.AddInput<float>("input", {2, 1, 2},
+                       {1.0f, 2.0f,
+                        3.0f, 4.0f});
+  test.AddInput<int64_t>("repeats", {3}, {2, 2, 2});
+  test.AddOutput<float>("output", {4, 2, 4},
+                        {1.0f, 2.0f, 1.0f, 2.0f,
+                         1.0f, 2.0f, 1.0f, 2.0f,
+
+                         3.0f, 4.0f, 3.0f, 4.0f,
+                         3.0f, 4.0f, 3.0f, 4.0f,
+
+                         1.0f, 2.0f, 1.0f, 2.0f,
+                         1.0f, 2.0f, 1.0f, 2.0f,
+
+                         3.0f, 4.0f, 3.0f, 4.0f,
+                         3.0f, 4.0f, 3.0f, 4.0f});
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -291,6 +291,7 @@ void OpTester::Run(ExpectResult expect_result,
         kCpuExecutionProvider,
         kCudaExecutionProvider,
         kMklDnnExecutionProvider,
+        kOpenCLExecutionProvider,
         kNupharExecutionProvider,
         kBrainSliceExecutionProvider,
     };
@@ -313,6 +314,8 @@ void OpTester::Run(ExpectResult expect_result,
         execution_provider = DefaultCudaExecutionProvider();
       else if (provider_type == onnxruntime::kMklDnnExecutionProvider)
         execution_provider = DefaultMkldnnExecutionProvider();
+      else if (provider_type == onnxruntime::kOpenCLExecutionProvider)
+        execution_provider = DefaultOpenCLExecutionProvider();
       else if (provider_type == onnxruntime::kNupharExecutionProvider)
         execution_provider = DefaultNupharExecutionProvider();
       else if (provider_type == onnxruntime::kBrainSliceExecutionProvider)
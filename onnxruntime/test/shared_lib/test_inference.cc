@@ -199,6 +199,51 @@ TEST_F(CApiTest, create_tensor_with_data) {
   ONNXRuntimeReleaseObject(type_info);
 }
 
+TEST_F(CApiTest, infer_output_shapes_and_prebind_output) {
+  SessionOptionsWrapper sf(env);
+  std::unique_ptr<ONNXSession, decltype(&ReleaseONNXSession)> inference_session(
+      sf.ONNXRuntimeCreateInferenceSession(MODEL_URI), ReleaseONNXSession);
+
+  // query the output shape for 3x2 inputs without running
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+  ONNXRuntimeTensorTypeAndShapeInfo* input_shape = ONNXRuntimeCreateTensorTypeAndShapeInfo();
+  const int64_t input_dims[] = {3, 2};
+  ONNXRUNTIME_THROW_ON_ERROR(ONNXRuntimeSetDims(input_shape, input_dims, 2));
+  const ONNXRuntimeTensorTypeAndShapeInfo* input_shapes[] = {input_shape};
+  ONNXRuntimeTensorTypeAndShapeInfo* output_shape = nullptr;
+  ONNXRUNTIME_THROW_ON_ERROR(ONNXRuntimeInferenceSessionInferOutputShapes(
+      inference_session.get(), input_names, input_shapes, 1, output_names, 1, &output_shape));
+  ONNXRuntimeReleaseObject(input_shape);
+  ASSERT_NE(output_shape, nullptr);
+  ASSERT_EQ(2, ONNXRuntimeGetNumOfDimensions(output_shape));
+  std::vector<int64_t> output_dims(2);
+  ONNXRuntimeGetDimensions(output_shape, output_dims.data(), output_dims.size());
+  ONNXRuntimeReleaseObject(output_shape);
+  ASSERT_EQ(std::vector<int64_t>({3, 2}), output_dims);
+
+  // run into a caller-owned output buffer sized from the query
+  float input_values[] = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  float output_values[6] = {0};
+  ONNXRuntimeAllocatorInfo* info;
+  ONNXRUNTIME_THROW_ON_ERROR(ONNXRuntimeCreateAllocatorInfo("Cpu", ONNXRuntimeDeviceAllocator, 0, ONNXRuntimeMemTypeDefault, &info));
+  std::vector<size_t> dims = {3, 2};
+  std::unique_ptr<ONNXValue, decltype(&ReleaseONNXValue)> input_tensor(
+      ONNXRuntimeCreateTensorWithDataAsONNXValue(info, input_values, sizeof(input_values), dims, ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT), ReleaseONNXValue);
+  std::unique_ptr<ONNXValue, decltype(&ReleaseONNXValue)> output_tensor(
+      ONNXRuntimeCreateTensorWithDataAsONNXValue(info, output_values, sizeof(output_values), dims, ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT), ReleaseONNXValue);
+  ReleaseONNXRuntimeAllocatorInfo(info);
+
+  ONNXValue* inputs[] = {input_tensor.get()};
+  ONNXValue* output = output_tensor.get();
+  ONNXRUNTIME_THROW_ON_ERROR(ONNXRuntimeRunInference(inference_session.get(), NULL, input_names, inputs, 1, output_names, 1, &output));
+  ASSERT_EQ(output, output_tensor.get());
+  const float expected_values[] = {1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f};
+  for (size_t i = 0; i != 6; ++i) {
+    ASSERT_EQ(expected_values[i], output_values[i]);
+  }
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -45,6 +45,20 @@ std::unique_ptr<IExecutionProvider> DefaultMkldnnExecutionProvider(bool enable_a
 #endif
 }
 
+std::unique_ptr<IExecutionProvider> DefaultOpenCLExecutionProvider(bool enable_arena) {
+#ifdef USE_OPENCL
+  ONNXRuntimeProviderFactoryInterface** f;
+  ONNXRUNTIME_THROW_ON_ERROR(ONNXRuntimeCreateOpenCLExecutionProviderFactory(enable_arena ? 1 : 0, &f));
+  FACTORY_PTR_HOLDER;
+  ONNXRuntimeProvider* out;
+  ONNXRUNTIME_THROW_ON_ERROR((*f)->CreateProvider(f, &out));
+  return std::unique_ptr<IExecutionProvider>((IExecutionProvider*)out);
+#else
+  ONNXRUNTIME_UNUSED_PARAMETER(enable_arena);
+  return nullptr;
+#endif
+}
+
 std::unique_ptr<IExecutionProvider> DefaultNupharExecutionProvider() {
 #ifdef USE_NUPHAR
   ONNXRuntimeProviderFactoryInterface** f;